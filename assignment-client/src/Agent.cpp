@@ -11,6 +11,8 @@
 
 #include "Agent.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
 #include <QtCore/QStandardPaths>
@@ -19,6 +21,9 @@
 #include <QtNetwork/QNetworkReply>
 #include <QThread>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <AssetClient.h>
 #include <AvatarHashMap.h>
 #include <AudioInjectorManager.h>
@@ -51,6 +56,10 @@
 
 static const int RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES = 10;
 
+// the bots are encoded on several threads once there are this many, in ranges of this many
+static const int MIN_HOSTED_AVATARS_TO_ENCODE_IN_PARALLEL = 16;
+static const int HOSTED_AVATARS_PER_PARALLEL_RANGE = 4;
+
 Agent::Agent(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _receivedAudioStream(RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES, RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES) {
@@ -64,6 +73,8 @@ Agent::Agent(ReceivedMessage& message) :
     DependencyManager::set<SoundCache>();
     DependencyManager::set<AudioScriptingInterface>();
     DependencyManager::set<AudioInjectorManager>();
+    // the sounds of the scripts played at the same place are sent to the mixer as one stream
+    DependencyManager::get<AudioInjectorManager>()->setPremixInjectors(true);
     DependencyManager::set<recording::Deck>();
     DependencyManager::set<recording::Recorder>();
     DependencyManager::set<RecordingScriptingInterface>();
@@ -583,6 +594,129 @@ void Agent::processAgentAvatar() {
 
         nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
     }
+
+    if (!_scriptEngine->isFinished() && !_hostedAvatars.empty()) {
+        sendHostedAvatars();
+    }
+}
+
+QObject* Agent::createAvatar() {
+    if (QThread::currentThread() != thread()) {
+        QObject* result = nullptr;
+        QMetaObject::invokeMethod(this, "createAvatar", Qt::BlockingQueuedConnection, Q_RETURN_ARG(QObject*, result));
+        return result;
+    }
+    if (!_scriptEngine || _scriptEngine->isFinished()) {
+        return nullptr;
+    }
+
+    QSharedPointer<ScriptableAvatar> avatar(new ScriptableAvatar(), &QObject::deleteLater);
+    avatar->setSessionUUID(QUuid::createUuid());
+    avatar->setForceFaceTrackerConnected(true);
+    avatar->setSkeletonModelURL(QUrl());
+    connect(_scriptEngine.get(), SIGNAL(update(float)), avatar.data(), SLOT(update(float)), Qt::ConnectionType::QueuedConnection);
+    _hostedAvatars.push_back({ avatar, 0 });
+
+    // the identity announces the bot to the avatar mixer, which drops its data until then
+    avatar->sendIdentityPacket();
+    return avatar.data();
+}
+
+void Agent::removeAvatar(QObject* avatar) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "removeAvatar", Q_ARG(QObject*, avatar));
+        return;
+    }
+    auto it = std::find_if(_hostedAvatars.begin(), _hostedAvatars.end(), [&](const HostedAvatar& hostedAvatar) {
+        return hostedAvatar.avatar.data() == avatar;
+    });
+    if (it != _hostedAvatars.end()) {
+        sendKillAvatar(it->avatar->getSessionUUID());
+        _hostedAvatars.erase(it);
+    }
+}
+
+void Agent::removeAllAvatars() {
+    for (const auto& hostedAvatar : _hostedAvatars) {
+        sendKillAvatar(hostedAvatar.avatar->getSessionUUID());
+    }
+    _hostedAvatars.clear();
+}
+
+void Agent::sendKillAvatar(const QUuid& avatarID) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+        packet->write(avatarID.toRfc4122());
+        packet->writePrimitive(KillAvatarReason::NoReason);
+        nodeList->sendPacket(std::move(packet), *avatarMixer);
+    }
+}
+
+void Agent::sendHostedAvatars() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (!avatarMixer || !avatarMixer->getActiveSocket()) {
+        return;
+    }
+
+    // the identities are sent again from time to time, as for the avatar of the agent, in case the mixer restarted
+    quint64 now = usecTimestampNow();
+    if (now - _lastHostedIdentitiesTime >= AVATAR_IDENTITY_PACKET_SEND_INTERVAL_MSECS * USECS_PER_MSEC) {
+        for (const auto& hostedAvatar : _hostedAvatars) {
+            hostedAvatar.avatar->sendIdentityPacket();
+        }
+        _lastHostedIdentitiesTime = now;
+    }
+
+    // each bot is encoded on its own, so many of them are spread over the cores
+    const int numAvatars = (int)_hostedAvatars.size();
+    std::vector<AvatarData::AvatarDataDetail> details(numAvatars);
+    for (auto& detail : details) {
+        detail = (randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO) ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    }
+    std::vector<QByteArray> avatarData(numAvatars);
+    auto encode = [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            const auto& avatar = _hostedAvatars[i].avatar;
+            avatarData[i] = avatar->toByteArrayStateful(details[i]);
+            avatar->doneEncoding(true);
+        }
+    };
+    if (numAvatars < MIN_HOSTED_AVATARS_TO_ENCODE_IN_PARALLEL) {
+        encode(0, numAvatars);
+    } else {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numAvatars, HOSTED_AVATARS_PER_PARALLEL_RANGE),
+                          [&](const tbb::blocked_range<int>& range) {
+            encode(range.begin(), range.end());
+        });
+    }
+
+    // and they are batched into as few packets as they fit in
+    std::unique_ptr<NLPacket> packet;
+    for (int i = 0; i < numAvatars; i++) {
+        const QByteArray& data = avatarData[i];
+        qint64 segmentSize = AvatarDataPacket::HOSTED_AVATAR_HEADER_SIZE + data.size();
+        if (packet && packet->bytesAvailableForWrite() < segmentSize) {
+            nodeList->sendPacket(std::move(packet), *avatarMixer);
+        }
+        if (!packet) {
+            packet = NLPacket::create(PacketType::HostedAvatarData);
+            if (packet->bytesAvailableForWrite() < segmentSize) {
+                qWarning() << "The data of the bot" << _hostedAvatars[i].avatar->getSessionUUID()
+                    << "does not fit in a packet:" << data.size() << "bytes";
+                continue;
+            }
+        }
+        packet->write(_hostedAvatars[i].avatar->getSessionUUID().toRfc4122());
+        packet->writePrimitive(_hostedAvatars[i].sequenceNumber++);
+        packet->writePrimitive((uint16_t)data.size());
+        packet->write(data);
+    }
+    if (packet && packet->getPayloadSize() > 0) {
+        nodeList->sendPacket(std::move(packet), *avatarMixer);
+    }
 }
 
 void Agent::encodeFrameOfZeros(QByteArray& encodedZeros) {
@@ -736,6 +870,7 @@ void Agent::processAgentAvatarAudio() {
 
 void Agent::aboutToFinish() {
     setIsAvatar(false);// will stop timers for sending identity packets
+    removeAllAvatars();
 
     if (_scriptEngine) {
         _scriptEngine->stop();
@@ -62,6 +62,11 @@ public:
 
     virtual void aboutToFinish() override;
 
+    /// Adds a bot to this agent: an avatar of its own, with a new session id, that the script moves and animates like
+    /// the avatar of the agent. The data of all the bots is sent to the avatar mixer in a few packets per frame.
+    Q_INVOKABLE QObject* createAvatar();
+    Q_INVOKABLE void removeAvatar(QObject* avatar);
+
 public slots:
     void run() override;
     void playAvatarSound(SharedSoundPointer avatarSound);
@@ -101,6 +106,10 @@ private:
 
     void sendAvatarIdentityPacket();
 
+    void sendHostedAvatars();
+    void removeAllAvatars();
+    void sendKillAvatar(const QUuid& avatarID);
+
     QString _scriptContents;
     QTimer* _scriptRequestTimeout { nullptr };
     ResourceRequest* _pendingScriptRequest { nullptr };
@@ -111,6 +120,13 @@ private:
     QTimer* _avatarIdentityTimer = nullptr;
     QHash<QUuid, quint16> _outgoingScriptAudioSequenceNumbers;
 
+    struct HostedAvatar {
+        QSharedPointer<ScriptableAvatar> avatar;
+        AvatarDataSequenceNumber sequenceNumber;
+    };
+    std::vector<HostedAvatar> _hostedAvatars;
+    quint64 _lastHostedIdentitiesTime { 0 };
+
     AudioNoiseGate _noiseGate;
     bool _isNoiseGateEnabled { false };
 
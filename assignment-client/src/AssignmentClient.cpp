@@ -24,12 +24,15 @@
 #include <LogHandler.h>
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
+#include <Metrics.h>
 #include <NodeList.h>
+#include <plugins/PluginManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
 #include <SoundCache.h>
 #include <ResourceScriptingInterface.h>
+#include <StartupTimeline.h>
 
 #include "AssignmentFactory.h"
 #include "AssignmentActionFactory.h"
@@ -37,35 +40,42 @@
 #include "AssignmentClient.h"
 #include "AssignmentClientLogging.h"
 #include "avatars/ScriptableAvatar.h"
+#include <SamplingProfiler.h>
 #include <Trace.h>
 #include <StatTracker.h>
 
 const QString ASSIGNMENT_CLIENT_TARGET_NAME = "assignment-client";
 const long long ASSIGNMENT_REQUEST_INTERVAL_MSECS = 1 * 1000;
+const uint64_t BYTES_PER_MEGABYTE = 1024 * 1024;
 
 AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                                    quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                                    quint16 assignmentServerPort, quint16 assignmentMonitorPort) :
     _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME)
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    DependencyManager::set<StartupTimeline>(startupTimer);
+
     LogUtils::init();
 
-    DependencyManager::set<tracing::Tracer>();
+    // the flight recorder stays on, so that a stall of an assignment can be dumped along with what led to it
+    DependencyManager::set<tracing::Tracer>()->setFlightRecorderEnabled(true);
     DependencyManager::set<StatTracker>();
+    DependencyManager::set<MetricsRegistry>();
+    DependencyManager::set<SamplingProfiler>()->startFromEnvironment();
     DependencyManager::set<AccountManager>();
 
-    auto scriptableAvatar = DependencyManager::set<ScriptableAvatar>();
     auto addressManager = DependencyManager::set<AddressManager>();
 
     // create a NodeList as an unassigned client, must be after addressManager
     auto nodeList = DependencyManager::set<NodeList>(NodeType::Unassigned, listenPort);
 
-    auto animationCache = DependencyManager::set<AnimationCache>();
-    auto entityScriptingInterface = DependencyManager::set<EntityScriptingInterface>(false);
-
+    // the services of the entities and the scripts are only set up for the assignments that use them
     DependencyManager::registerInheritance<EntityActionFactoryInterface, AssignmentActionFactory>();
-    auto actionFactory = DependencyManager::set<AssignmentActionFactory>();
-    DependencyManager::set<ResourceScriptingInterface>();
+    if (usesEntityServices(requestAssignmentType)) {
+        setUpEntityServices();
+    }
 
     // setup a thread for the NodeList and its PacketReceiver
     QThread* nodeThread = new QThread(this);
@@ -116,6 +126,18 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     connect(&_requestTimer, SIGNAL(timeout()), SLOT(sendAssignmentRequest()));
     _requestTimer.start(ASSIGNMENT_REQUEST_INTERVAL_MSECS);
 
+    // ask right away once the event loop runs instead of a full interval from now
+    QTimer::singleShot(0, this, SLOT(sendAssignmentRequest()));
+
+    if (usesCodecs(requestAssignmentType)) {
+        // load the codecs while we wait for an assignment, the mixer and the script runners need them when they start.
+        // An assignment-client of any type loads them once it knows it needs them, and the display and input plugins
+        // are never loaded by an assignment-client.
+        QTimer::singleShot(0, [] {
+            PluginManager::getInstance()->getCodecPlugins();
+        });
+    }
+
     // connections to AccountManager for authentication
     connect(DependencyManager::get<AccountManager>().data(), &AccountManager::authRequired,
             this, &AssignmentClient::handleAuthenticationRequest);
@@ -132,10 +154,59 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
 
         // Hook up a timer to send this child's status to the Monitor once per second
         setUpStatusToMonitor();
+
+        // and let the monitor count us as a spare as soon as we are up
+        QTimer::singleShot(0, this, &AssignmentClient::sendStatusPacketToACM);
     }
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::CreateAssignment, this, "handleCreateAssignmentPacket");
     packetReceiver.registerListener(PacketType::StopNode, this, "handleStopNodePacket");
+
+    DependencyManager::get<StartupTimeline>()->mark("constructed");
+}
+
+bool AssignmentClient::usesEntityServices(Assignment::Type type) {
+    return type == Assignment::AgentType || type == Assignment::EntityServerType
+        || type == Assignment::EntityScriptServerType;
+}
+
+bool AssignmentClient::usesCodecs(Assignment::Type type) {
+    return type == Assignment::AudioMixerType || type == Assignment::AgentType
+        || type == Assignment::EntityScriptServerType;
+}
+
+void AssignmentClient::setUpEntityServices() {
+    if (DependencyManager::isSet<EntityScriptingInterface>()) {
+        return;
+    }
+    StartupTimeline::Phase phase("entity services");
+
+    DependencyManager::set<ScriptableAvatar>();
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<EntityScriptingInterface>(false);
+    DependencyManager::set<AssignmentActionFactory>();
+    DependencyManager::set<ResourceScriptingInterface>();
+}
+
+// logs and exports how long an assignment took to start and how much memory it took, by its type
+static void reportAssignmentStarted(const QString& typeName) {
+    auto startupTimeline = DependencyManager::get<StartupTimeline>();
+    qint64 startupMsecs = startupTimeline->elapsed();
+    startupTimeline->finish(typeName + " running");
+
+    MemoryInfo memoryInfo;
+    if (!getMemoryInfo(memoryInfo)) {
+        memoryInfo.processUsedMemoryBytes = 0;
+    }
+    qCInfo(assignment_client) << typeName << "started" << startupMsecs << "ms after the assignment-client, using"
+        << memoryInfo.processUsedMemoryBytes / BYTES_PER_MEGABYTE << "MB";
+
+    auto metrics = DependencyManager::get<MetricsRegistry>();
+    QString labels = QString("type=\"%1\"").arg(typeName);
+    metrics->gauge("hifi_assignment_startup_milliseconds",
+        "The time from the start of the assignment-client to the assignment running", labels).set(startupMsecs);
+    metrics->gauge("hifi_assignment_startup_resident_bytes",
+        "The memory of the assignment-client once the assignment is running", labels).set(memoryInfo.processUsedMemoryBytes);
 }
 
 void AssignmentClient::stopAssignmentClient() {
@@ -194,10 +265,16 @@ void AssignmentClient::sendStatusPacketToACM() {
         assignmentType = _currentAssignment->getType();
     }
 
-    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus, sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID);
+    qint64 processID = QCoreApplication::applicationPid();
+
+    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus,
+                                         sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID + sizeof(processID));
 
     statusPacket->write(_childAssignmentUUID.toRfc4122());
     statusPacket->writePrimitive(assignmentType);
+
+    // so the monitor can match this status with the process it spawned
+    statusPacket->writePrimitive(processID);
     
     nodeList->sendPacket(std::move(statusPacket), _assignmentClientMonitorSocket);
 }
@@ -236,6 +313,17 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         return;
     }
 
+    // the services the assignment uses are set up before it is constructed
+    quint8 packedType;
+    message->peekPrimitive(&packedType);
+    Assignment::Type assignmentType = (Assignment::Type)packedType;
+    if (usesEntityServices(assignmentType)) {
+        setUpEntityServices();
+    }
+    if (usesCodecs(assignmentType)) {
+        PluginManager::getInstance()->getCodecPlugins();
+    }
+
     // construct the deployed assignment from the packet data
     _currentAssignment = AssignmentFactory::unpackAssignment(*message);
 
@@ -257,6 +345,11 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         workerThread->setObjectName("ThreadedAssignment Worker");
 
         connect(workerThread, &QThread::started, _currentAssignment.data(), &ThreadedAssignment::run);
+        QString typeName = _currentAssignment->getTypeName();
+        _assignmentTypeName = typeName;
+        connect(workerThread, &QThread::started, _currentAssignment.data(), [typeName] {
+            reportAssignmentStarted(typeName);
+        });
 
         // Once the ThreadedAssignment says it is finished - we ask it to deleteLater
         // This is a queued connection so that it is put into the event loop to be processed by the worker
@@ -340,6 +433,15 @@ void AssignmentClient::assignmentCompleted() {
     nodeList->setOwnerType(NodeType::Unassigned);
     nodeList->reset();
     nodeList->resetNodeInterestSet();
+
+    // the metrics were the previous assignment's
+    DependencyManager::get<MetricsRegistry>()->clear();
+
+    MemoryInfo memoryInfo;
+    if (getMemoryInfo(memoryInfo)) {
+        qCInfo(assignment_client) << _assignmentTypeName << "used at most"
+            << memoryInfo.processPeakUsedMemoryBytes / BYTES_PER_MEGABYTE << "MB";
+    }
     
     _isAssigned = false;
 }
@@ -45,9 +45,15 @@ private slots:
 private:
     void setUpStatusToMonitor();
 
+    static bool usesEntityServices(Assignment::Type type);
+    static bool usesCodecs(Assignment::Type type);
+    // the entity scripting, animation and action services, set up once by the first assignment that uses them
+    void setUpEntityServices();
+
     Assignment _requestAssignment;
     QPointer<ThreadedAssignment> _currentAssignment;
     bool _isAssigned { false };
+    QString _assignmentTypeName;
     QString _assignmentServerHostname;
     HifiSockAddr _assignmentServerSocket;
     QTimer _requestTimer; // timer for requesting and assignment
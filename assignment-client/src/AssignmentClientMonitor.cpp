@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <memory>
 #include <signal.h>
 
@@ -17,6 +18,7 @@
 
 #include <AddressManager.h>
 #include <LogHandler.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 
 #include "AssignmentClientMonitor.h"
@@ -28,6 +30,27 @@
 const QString ASSIGNMENT_CLIENT_MONITOR_TARGET_NAME = "assignment-client-monitor";
 const int WAIT_FOR_CHILD_MSECS = 1000;
 
+// the spares kept ready cover the assignments taken in the last minute, up to a few
+const quint64 ASSIGNMENT_DEMAND_WINDOW_USECS = 60 * USECS_PER_SECOND;
+const unsigned int MAX_TARGET_SPARE_COUNT = 4;
+
+// a child that has not reported in this long after its spawn no longer counts as starting
+const quint64 CHILD_STARTUP_TIMEOUT_USECS = 10 * USECS_PER_SECOND;
+
+void AssignmentClientMonitor::DurationStats::update(quint64 duration) {
+    count++;
+    total += duration;
+    max = std::max(max, duration);
+}
+
+QJsonObject AssignmentClientMonitor::DurationStats::toJson() const {
+    QJsonObject stats;
+    stats["count"] = (qint64)count;
+    stats["average"] = count > 0 ? (double)total / (double)count / USECS_PER_MSEC : 0.0;
+    stats["max"] = (double)max / USECS_PER_MSEC;
+    return stats;
+}
+
 AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmentClientForks,
                                                  const unsigned int minAssignmentClientForks,
                                                  const unsigned int maxAssignmentClientForks,
@@ -94,6 +117,9 @@ void AssignmentClientMonitor::simultaneousWaitOnChildren(int waitMsecs) {
 void AssignmentClientMonitor::childProcessFinished(qint64 pid) {
     if (_childProcesses.remove(pid)) {
         qDebug() << "Child process" << pid << "has finished. Removed from internal map.";
+
+        // replace it right away rather than at the next check
+        QTimer::singleShot(0, this, &AssignmentClientMonitor::checkSpares);
     }
 }
 
@@ -223,10 +249,27 @@ void AssignmentClientMonitor::spawnChildClient() {
 
         qDebug() << "Spawned a child client with PID" << assignmentClient->processId();
 
-        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath });
+        ACProcess child;
+        child.process = assignmentClient;
+        child.logStdoutPath = stdoutPath;
+        child.logStderrPath = stderrPath;
+        child.spawnTime = usecTimestampNow();
+        _childProcesses.insert(pid, child);
     }
 }
 
+unsigned int AssignmentClientMonitor::getTargetSpareCount() {
+    quint64 now = usecTimestampNow();
+    while (!_recentAssignmentTimes.isEmpty() && now - _recentAssignmentTimes.first() > ASSIGNMENT_DEMAND_WINDOW_USECS) {
+        _recentAssignmentTimes.removeFirst();
+    }
+    unsigned int target = std::max(1u, std::min((unsigned int)_recentAssignmentTimes.size(), MAX_TARGET_SPARE_COUNT));
+    if (_maxAssignmentClientForks) {
+        target = std::min(target, _maxAssignmentClientForks);
+    }
+    return target;
+}
+
 void AssignmentClientMonitor::checkSpares() {
     auto nodeList = DependencyManager::get<NodeList>();
     QUuid aSpareId = "";
@@ -244,15 +287,36 @@ void AssignmentClientMonitor::checkSpares() {
         }
     });
 
+    // the children still starting up will be spares soon, don't spawn more for them
+    quint64 now = usecTimestampNow();
+    unsigned int startingCount = 0;
+    for (auto& ac : _childProcesses) {
+        if (ac.startupTime == 0 && now - ac.spawnTime < CHILD_STARTUP_TIMEOUT_USECS) {
+            ++startingCount;
+        }
+    }
+    totalCount += startingCount;
+
+    unsigned int targetSpareCount = getTargetSpareCount();
+
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
-        }
+    unsigned int spawnCount = 0;
+    if (spareCount + startingCount < targetSpareCount) {
+        spawnCount = targetSpareCount - spareCount - startingCount;
+    }
+    if (totalCount + spawnCount < _minAssignmentClientForks) {
+        spawnCount = _minAssignmentClientForks - totalCount;
+    }
+    if (_maxAssignmentClientForks) {
+        spawnCount = totalCount < _maxAssignmentClientForks ?
+            std::min(spawnCount, _maxAssignmentClientForks - totalCount) : 0;
+    }
+    for (unsigned int i = 0; i < spawnCount; i++) {
+        spawnChildClient();
     }
 
-    if (spareCount > 1) {
+    if (spareCount > targetSpareCount) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
@@ -286,9 +350,10 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
                 matchingNode = DependencyManager::get<LimitedNodeList>()->addOrUpdateNode(senderID, NodeType::Unassigned,
                                                                                           senderSockAddr, senderSockAddr);
 
-                auto childData = std::unique_ptr<AssignmentClientChildData>
+                auto newChildData = std::unique_ptr<AssignmentClientChildData>
                     { new AssignmentClientChildData(Assignment::Type::AllTypes) };
-                matchingNode->setLinkedData(std::move(childData));
+                childData = newChildData.get();
+                matchingNode->setLinkedData(std::move(newChildData));
             } else {
                 // tell unknown assignment-client child to exit.
                 qDebug() << "Asking unknown child at" << senderSockAddr << "to exit.";
@@ -314,10 +379,41 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
         childData->setChildType(Assignment::Type(assignmentType));
 
         // note when this child talked
-        matchingNode->setLastHeardMicrostamp(usecTimestampNow());
+        quint64 now = usecTimestampNow();
+        matchingNode->setLastHeardMicrostamp(now);
+
+        // the process ID of the child follows, to time its startup and its assignments
+        if (message->getBytesLeftToRead() >= (qint64)sizeof(qint64)) {
+            qint64 processID;
+            message->readPrimitive(&processID);
+            auto it = _childProcesses.find(processID);
+            if (it != _childProcesses.end()) {
+                updateChildProcess(it.value(), Assignment::Type(assignmentType), now);
+            }
+        }
     }
 }
 
+void AssignmentClientMonitor::updateChildProcess(ACProcess& child, Assignment::Type type, quint64 now) {
+    if (child.startupTime == 0) {
+        child.startupTime = std::max(now - child.spawnTime, (quint64)1);
+        child.spareSince = now;
+        _startupStats.update(child.startupTime);
+        qDebug() << "Child" << child.process->processId() << "started in" << child.startupTime / USECS_PER_MSEC << "ms";
+    }
+
+    if (child.type == Assignment::AllTypes && type != Assignment::AllTypes) {
+        // a spare was consumed, replace it now rather than at the next check
+        _timeToAssignmentStats.update(now - child.spawnTime);
+        _spareWaitStats.update(now - child.spareSince);
+        _recentAssignmentTimes.append(now);
+        QTimer::singleShot(0, this, &AssignmentClientMonitor::checkSpares);
+    } else if (child.type != Assignment::AllTypes && type == Assignment::AllTypes) {
+        child.spareSince = now;
+    }
+    child.type = type;
+}
+
 bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
     if (url.path() == "/status") {
         QByteArray response;
@@ -330,12 +426,24 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
             server["pid"] = ac.process->processId();
             server["logStdout"] = ac.logStdoutPath;
             server["logStderr"] = ac.logStderrPath;
+            server["type"] = (int)ac.type;
+            if (ac.startupTime > 0) {
+                server["startupMsecs"] = (double)ac.startupTime / USECS_PER_MSEC;
+            }
 
             servers[QString::number(ac.process->processId())] = server;
         }
 
         status["servers"] = servers;
 
+        QJsonObject spares;
+        spares["target"] = (int)getTargetSpareCount();
+        spares["recentAssignments"] = _recentAssignmentTimes.size();
+        spares["startup"] = _startupStats.toJson();
+        spares["timeToAssignment"] = _timeToAssignmentStats.toJson();
+        spares["spareWait"] = _spareWaitStats.toJson();
+        status["spares"] = spares;
+
         QJsonDocument document { status };
 
         connection->respond(HTTPConnection::StatusCode200, document.toJson());
@@ -16,6 +16,8 @@
 #include <QtCore/qpointer.h>
 #include <QtCore/QProcess>
 #include <QtCore/QDateTime>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
 #include <QDir>
 
 #include <Assignment.h>
@@ -27,9 +29,14 @@
 extern const char* NUM_FORKS_PARAMETER;
 
 struct ACProcess {
-    QProcess* process; // looks like a dangling pointer, but is parented by the AssignmentClientMonitor 
+    QProcess* process { nullptr }; // looks like a dangling pointer, but is parented by the AssignmentClientMonitor
     QString logStdoutPath;
     QString logStderrPath;
+
+    quint64 spawnTime { 0 }; // usecs
+    quint64 startupTime { 0 }; // from the spawn to the first status, 0 until the child reports
+    quint64 spareSince { 0 }; // when the child last became a spare
+    Assignment::Type type { Assignment::AllTypes };
 };
 
 class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
@@ -53,9 +60,24 @@ public slots:
     void aboutToQuit();
 
 private:
+    struct DurationStats {
+        quint64 count { 0 };
+        quint64 total { 0 };
+        quint64 max { 0 };
+
+        void update(quint64 duration);
+        QJsonObject toJson() const; // in msecs
+    };
+
     void spawnChildClient();
     void simultaneousWaitOnChildren(int waitMsecs);
 
+    // the spares to keep ready: as many as the assignments taken in the recent window, with at least one
+    unsigned int getTargetSpareCount();
+
+    // notes the startup and the assignments of a child from its status
+    void updateChildProcess(ACProcess& child, Assignment::Type type, quint64 now);
+
     QTimer _checkSparesTimer; // every few seconds see if it need fewer or more spare children
 
     QDir _logDirectory;
@@ -74,6 +96,11 @@ private:
 
     QMap<qint64, ACProcess> _childProcesses;
 
+    QList<quint64> _recentAssignmentTimes; // when the spares took their assignments, oldest first
+    DurationStats _startupStats;
+    DurationStats _timeToAssignmentStats; // from the spawn of the child to its assignment
+    DurationStats _spareWaitStats; // from the child becoming a spare to its assignment
+
     bool _wantsChildFileLogging { false };
 };
 
@@ -0,0 +1,104 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
+// a file written this recently may still be being uploaded, it is sent from but not kept
+static const qint64 MIN_CACHED_FILE_AGE_MSECS = 10 * 1000;
+
+bool MappedAssetFile::map() {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        // an empty file can't be mapped, but has no bytes to send either
+        return true;
+    }
+    _data = _file.map(0, _size);
+    // the mapping stays valid after the file is closed, until the file is destroyed
+    _file.close();
+    return _data != nullptr;
+}
+
+AssetFileCache::AssetFileCache(const QDir& filesDirectory, qint64 maxMappedBytes) :
+    _filesDirectory(filesDirectory),
+    _maxMappedBytes(maxMappedBytes)
+{
+}
+
+MappedAssetFilePointer AssetFileCache::get(const QString& hexHash) {
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stats.requests++;
+        auto itr = _entries.find(hexHash);
+        if (itr != _entries.end()) {
+            _stats.hits++;
+            _lru.splice(_lru.begin(), _lru, itr->lruPosition);
+            return itr->file;
+        }
+    }
+
+    // map the file without the lock, other tasks may be mapping it too and the first one in keeps its mapping
+    QString filePath = _filesDirectory.filePath(hexHash);
+    auto file = std::make_shared<MappedAssetFile>(filePath);
+    if (!file->map()) {
+        return nullptr;
+    }
+    QFileInfo fileInfo { filePath };
+    if (file->getSize() > _maxMappedBytes ||
+            fileInfo.lastModified().msecsTo(QDateTime::currentDateTime()) < MIN_CACHED_FILE_AGE_MSECS) {
+        return file;
+    }
+
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(hexHash);
+    if (itr != _entries.end()) {
+        return itr->file;
+    }
+    _lru.push_front(hexHash);
+    _entries.insert(hexHash, { file, _lru.begin() });
+    _stats.numFiles++;
+    _stats.mappedBytes += file->getSize();
+    evictLocked();
+    return file;
+}
+
+void AssetFileCache::remove(const QString& hexHash) {
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _entries.find(hexHash);
+    if (itr != _entries.end()) {
+        _stats.numFiles--;
+        _stats.mappedBytes -= itr->file->getSize();
+        _lru.erase(itr->lruPosition);
+        _entries.erase(itr);
+    }
+}
+
+AssetFileCache::Stats AssetFileCache::getStats() const {
+    std::lock_guard<std::mutex> guard(_lock);
+    return _stats;
+}
+
+void AssetFileCache::evictLocked() {
+    // the least recently requested files are unmapped first, the tasks still sending from one keep it mapped until they finish
+    while (_stats.mappedBytes > _maxMappedBytes && _lru.size() > 1) {
+        auto itr = _entries.find(_lru.back());
+        _stats.numFiles--;
+        _stats.mappedBytes -= itr->file->getSize();
+        _stats.evictions++;
+        _entries.erase(itr);
+        _lru.pop_back();
+    }
+}
@@ -0,0 +1,85 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+/// An asset file mapped into memory, unmapped once the last task sending from it is done
+class MappedAssetFile {
+public:
+    MappedAssetFile(const QString& filePath) : _file(filePath) { }
+
+    bool map();
+
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+};
+using MappedAssetFilePointer = std::shared_ptr<const MappedAssetFile>;
+
+/// The most recently requested asset files, kept mapped so that the send tasks write packets from their pages without
+/// opening and reading the file each time.
+///
+/// The assets are named by the hash of their contents and don't change, so a mapping stays valid until its file is deleted
+/// or overwritten, when the asset server removes it. Can be used from several threads at once.
+class AssetFileCache {
+public:
+    struct Stats {
+        uint64_t requests { 0 };
+        uint64_t hits { 0 };
+        uint64_t evictions { 0 };
+        int numFiles { 0 };
+        qint64 mappedBytes { 0 };
+    };
+
+    static const qint64 DEFAULT_MAX_MAPPED_BYTES = 1024LL * 1024 * 1024;
+
+    AssetFileCache(const QDir& filesDirectory, qint64 maxMappedBytes = DEFAULT_MAX_MAPPED_BYTES);
+
+    /// the mapped file of the asset, or null when it isn't in the files directory
+    MappedAssetFilePointer get(const QString& hexHash);
+
+    /// drops the mapping of an asset whose file is about to be deleted or written
+    void remove(const QString& hexHash);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        MappedAssetFilePointer file;
+        std::list<QString>::iterator lruPosition;
+    };
+
+    void evictLocked();
+
+    const QDir _filesDirectory;
+    const qint64 _maxMappedBytes;
+
+    mutable std::mutex _lock;
+    QHash<QString, Entry> _entries;
+    std::list<QString> _lru; // most recently requested first
+    Stats _stats;
+};
+
+#endif // hifi_AssetFileCache_h
@@ -21,14 +21,21 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QRegExp>
 #include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtGui/QImageReader>
 
+#include <HTTPConnection.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
 
+#include "AssetFileCache.h"
+#include "BakeTextureTask.h"
 #include "NetworkLogging.h"
 #include "NodeType.h"
 #include "SendAssetTask.h"
+#include "UploadAssetChunkTask.h"
 #include "UploadAssetTask.h"
 #include <ClientServerUtils.h>
 
@@ -74,7 +81,14 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
-    _taskPool(this)
+    _taskPool(this),
+    _bakingPool(this),
+    _getRequestsMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_asset_server_requests_total",
+        "The requests received", "type=\"get\"")),
+    _getInfoRequestsMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_asset_server_requests_total",
+        "The requests received", "type=\"get_info\"")),
+    _uploadRequestsMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_asset_server_requests_total",
+        "The requests received", "type=\"upload_chunk\""))
 {
 
     // Most of the work will be I/O bound, reading from disk and constructing packet objects,
@@ -82,10 +96,15 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     static const int TASK_POOL_THREAD_COUNT = 50;
     _taskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
 
+    // Baking is CPU bound, leave half the cores to the sends and uploads.
+    _bakingPool.setMaxThreadCount(std::max(QThread::idealThreadCount() / 2, 1));
+
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
     packetReceiver.registerListener(PacketType::AssetGetInfo, this, "handleAssetGetInfo");
     packetReceiver.registerListener(PacketType::AssetUpload, this, "handleAssetUpload");
+    packetReceiver.registerListener(PacketType::AssetUploadStatus, this, "handleAssetUploadStatus");
+    packetReceiver.registerListener(PacketType::AssetUploadChunk, this, "handleAssetUploadChunk");
     packetReceiver.registerListener(PacketType::AssetMappingOperation, this, "handleAssetMappingOperation");
     
 #ifdef Q_OS_WIN
@@ -116,6 +135,8 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_UPLOADS_SUBDIR = "uploads";
+static const int UPLOAD_EXPIRY_SECS = 24 * 60 * 60;
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -177,8 +198,37 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _uploadsDirectory = _resourcesDirectory;
+    if (!_resourcesDirectory.mkpath(ASSET_UPLOADS_SUBDIR) || !_uploadsDirectory.cd(ASSET_UPLOADS_SUBDIR)) {
+        qCritical() << "Unable to create upload directory for asset-server files. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+    cleanupExpiredUploads();
+
+    static const QString MAPPED_FILES_CACHE_SIZE_OPTION = "mapped_files_cache_size";
+    const int BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto mappedFilesCacheSize = assetServerObject[MAPPED_FILES_CACHE_SIZE_OPTION].toDouble(-1);
+    qint64 maxMappedBytes = mappedFilesCacheSize >= 0.0 ? (qint64)(mappedFilesCacheSize * BYTES_PER_MEGABYTE) :
+        AssetFileCache::DEFAULT_MAX_MAPPED_BYTES;
+    _fileCache = std::make_shared<AssetFileCache>(_filesDirectory, maxMappedBytes);
+    qInfo() << "Keeping up to" << maxMappedBytes / BYTES_PER_MEGABYTE << "MB of asset files mapped.";
+
+    static const QString HTTP_PORT_OPTION = "http_port";
+    int httpPort = assetServerObject[HTTP_PORT_OPTION].toInt(0);
+    if (httpPort > 0) {
+        _httpManager = new HTTPManager(QHostAddress::AnyIPv4, httpPort, QString(), this, this);
+        qInfo() << "Serving asset files over HTTP on port" << httpPort;
+    }
+
+    static const QString BAKE_TEXTURES_OPTION = "bake_textures";
+    _bakeTextures = assetServerObject[BAKE_TEXTURES_OPTION].toBool(false);
+    if (_bakeTextures) {
+        qInfo() << "Baking the textures of image assets.";
+    }
+
     // load whatever mappings we currently have from the local file
-    if (loadMappingsFromFile()) {
+    if (loadMappingsFromFile() && loadBakedTexturesFromFile()) {
         qInfo() << "Serving files from: " << _filesDirectory.path();
 
         // Check the asset directory to output some information about what we have
@@ -201,6 +251,18 @@ void AssetServer::completeSetup() {
 
 }
 
+void AssetServer::cleanupExpiredUploads() {
+    // the directory of an upload is modified with each chunk it receives
+    auto expiry = QDateTime::currentDateTime().addSecs(-UPLOAD_EXPIRY_SECS);
+
+    for (const auto& uploadInfo : _uploadsDirectory.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (uploadInfo.lastModified() < expiry) {
+            qDebug() << "Deleting the chunks of the expired upload of" << uploadInfo.fileName();
+            QDir(uploadInfo.absoluteFilePath()).removeRecursively();
+        }
+    }
+}
+
 void AssetServer::cleanupUnmappedFiles() {
     QRegExp hashFileRegex { "^[a-f0-9]{" + QString::number(SHA256_HASH_HEX_LENGTH) + "}" };
 
@@ -211,11 +273,25 @@ void AssetServer::cleanupUnmappedFiles() {
 
     qInfo() << "Performing unmapped asset cleanup.";
 
+    // forget the textures baked from assets that are no longer mapped, the ones baked from mapped assets are kept
+    QSet<AssetHash> unmappedSourceHashes;
+    for (auto it = _bakedTextures.cbegin(); it != _bakedTextures.cend(); ++it) {
+        if (!mappedHashes.contains(it.key())) {
+            unmappedSourceHashes << it.key();
+        }
+    }
+    removeBakedTextures(unmappedSourceHashes);
+    auto bakedHashes = getBakedTextureHashes();
+
     for (const auto& fileInfo : files) {
-        if (hashFileRegex.exactMatch(fileInfo.fileName())) {
-            if (!mappedHashes.contains(fileInfo.fileName())) {
+        if (fileInfo.suffix() == "part") {
+            // left by a bake that was interrupted
+            QFile::remove(fileInfo.absoluteFilePath());
+        } else if (hashFileRegex.exactMatch(fileInfo.fileName())) {
+            if (!mappedHashes.contains(fileInfo.fileName()) && !bakedHashes.contains(fileInfo.fileName())) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
+                _fileCache->remove(fileInfo.fileName());
 
                 if (removeableFile.remove()) {
                     qDebug() << "\tDeleted" << fileInfo.fileName() << "from asset files directory since it is unmapped.";
@@ -227,6 +303,180 @@ void AssetServer::cleanupUnmappedFiles() {
     }
 }
 
+// the value of a request header, whatever the case of its name
+static QByteArray requestHeader(HTTPConnection* connection, const QByteArray& name) {
+    const auto& headers = connection->requestHeaders();
+    for (auto it = headers.constBegin(); it != headers.constEnd(); ++it) {
+        if (it.key().compare(name, Qt::CaseInsensitive) == 0) {
+            return it.value();
+        }
+    }
+    return QByteArray();
+}
+
+// parses a single range "bytes=<first>-<last>", "bytes=<first>-" or "bytes=-<suffix length>" of a file of size bytes,
+// returns false if it is not satisfiable
+static bool parseRangeHeader(const QByteArray& range, qint64 size, qint64& first, qint64& last) {
+    QRegExp rangeRegex { "^bytes=(\\d*)-(\\d*)$" };
+    if (!rangeRegex.exactMatch(QString(range).trimmed()) || (rangeRegex.cap(1).isEmpty() && rangeRegex.cap(2).isEmpty())) {
+        return false;
+    }
+
+    if (rangeRegex.cap(1).isEmpty()) {
+        qint64 suffixLength = rangeRegex.cap(2).toLongLong();
+        first = std::max(size - suffixLength, (qint64)0);
+        last = size - 1;
+        return suffixLength > 0 && size > 0;
+    }
+
+    first = rangeRegex.cap(1).toLongLong();
+    last = rangeRegex.cap(2).isEmpty() ? size - 1 : std::min(rangeRegex.cap(2).toLongLong(), size - 1);
+    return first <= last;
+}
+
+bool AssetServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    auto operation = connection->requestOperation();
+    if (operation != QNetworkAccessManager::GetOperation && operation != QNetworkAccessManager::HeadOperation) {
+        Headers allowHeader;
+        allowHeader.insert("Allow", "GET, HEAD");
+        connection->respond(HTTPConnection::StatusCode405, "Only GET and HEAD are supported.",
+                            HTTPConnection::DefaultContentType, allowHeader);
+        return true;
+    }
+
+    // the extension atp:<hash>.<ext> urls may have doesn't matter
+    auto hash = url.path().mid(1).section('.', 0, 0).toLower();
+    QFileInfo fileInfo { _filesDirectory.filePath(hash) };
+    if (!isValidHash(hash) || !fileInfo.isFile()) {
+        connection->respond(HTTPConnection::StatusCode404, "Asset not found.");
+        return true;
+    }
+
+    // an asset is named by the hash of its content, so it never changes and can be cached for good
+    Headers headers;
+    headers.insert("Cache-Control", "public, max-age=31536000, immutable");
+    headers.insert("ETag", "\"" + hash.toLatin1() + "\"");
+    headers.insert("Accept-Ranges", "bytes");
+
+    if (requestHeader(connection, "If-None-Match").contains(hash.toLatin1())) {
+        connection->respond(HTTPConnection::StatusCode304, QByteArray(), HTTPConnection::DefaultContentType, headers);
+        return true;
+    }
+
+    qint64 size = fileInfo.size();
+    qint64 first = 0;
+    qint64 last = size - 1;
+    const char* code = HTTPConnection::StatusCode200;
+
+    // the requests for several ranges at once get the whole asset
+    auto range = requestHeader(connection, "Range");
+    if (!range.isEmpty() && !range.contains(',')) {
+        if (!parseRangeHeader(range, size, first, last)) {
+            headers.insert("Content-Range", "bytes */" + QByteArray::number(size));
+            connection->respond(HTTPConnection::StatusCode416, "Range not satisfiable.",
+                                HTTPConnection::DefaultContentType, headers);
+            return true;
+        }
+        code = HTTPConnection::StatusCode206;
+        headers.insert("Content-Range", QString("bytes %1-%2/%3").arg(first).arg(last).arg(size).toLatin1());
+    }
+
+    static const char* ASSET_CONTENT_TYPE = "application/octet-stream";
+    qint64 length = last - first + 1;
+    if (operation == QNetworkAccessManager::HeadOperation) {
+        headers.insert("Content-Length", QByteArray::number(length));
+        headers.insert("Content-Type", ASSET_CONTENT_TYPE);
+        connection->respond(code, QByteArray(), ASSET_CONTENT_TYPE, headers);
+        return true;
+    }
+
+    std::unique_ptr<QFile> file { new QFile(fileInfo.absoluteFilePath()) };
+    if (!file->open(QIODevice::ReadOnly) || !file->seek(first)) {
+        connection->respond(HTTPConnection::StatusCode500, "Failed to read the asset.");
+        return true;
+    }
+    connection->respondWithDevice(code, std::move(file), length, ASSET_CONTENT_TYPE, headers);
+    return true;
+}
+
+void AssetServer::handleAssetUploadStatus(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    MessageID messageID;
+
+    if (message->getSize() < qint64(sizeof(messageID) + SHA256_HASH_LENGTH + sizeof(uint64_t))) {
+        qDebug() << "ERROR bad upload status request";
+        return;
+    }
+
+    message->readPrimitive(&messageID);
+    auto assetHash = message->read(SHA256_HASH_LENGTH);
+    uint64_t size;
+    message->readPrimitive(&size);
+
+    auto replyPacket = NLPacketList::create(PacketType::AssetUploadStatusReply, QByteArray(), true, true);
+    replyPacket->writePrimitive(messageID);
+
+    QString hexHash = assetHash.toHex();
+
+    if (!senderNode->getCanWriteToAssetServer()) {
+        replyPacket->writePrimitive(AssetServerError::PermissionDenied);
+    } else if (size > MAX_UPLOAD_SIZE) {
+        replyPacket->writePrimitive(AssetServerError::AssetTooLarge);
+    } else if (_filesDirectory.exists(hexHash)) {
+        replyPacket->writePrimitive(AssetServerError::NoError);
+        replyPacket->writePrimitive((uint8_t)true);
+        replyPacket->writePrimitive((uint32_t)0);
+    } else {
+        // this is a good time to drop the uploads that were abandoned, another one is starting or resuming
+        cleanupExpiredUploads();
+
+        std::vector<uint32_t> stagedChunks;
+        QDir uploadDirectory = _uploadsDirectory;
+        if (uploadDirectory.cd(hexHash)) {
+            uint32_t numChunks = (uint32_t)((size + ASSET_CHUNK_SIZE - 1) / ASSET_CHUNK_SIZE);
+            for (const auto& chunkName : uploadDirectory.entryList(QDir::Files)) {
+                bool isIndex = false;
+                uint32_t index = chunkName.toUInt(&isIndex);
+                if (isIndex && index < numChunks) {
+                    stagedChunks.push_back(index);
+                }
+            }
+        }
+
+        qDebug() << "Upload of" << hexHash << "from" << uuidStringWithoutCurlyBraces(senderNode->getUUID())
+            << "has" << stagedChunks.size() << "chunks already";
+
+        replyPacket->writePrimitive(AssetServerError::NoError);
+        replyPacket->writePrimitive((uint8_t)false);
+        replyPacket->writePrimitive((uint32_t)stagedChunks.size());
+        for (auto index : stagedChunks) {
+            replyPacket->writePrimitive(index);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->sendPacketList(std::move(replyPacket), *senderNode);
+}
+
+void AssetServer::handleAssetUploadChunk(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    _uploadRequestsMetric.increment();
+    if (senderNode->getCanWriteToAssetServer()) {
+        auto task = new UploadAssetChunkTask(message, senderNode, _filesDirectory, _uploadsDirectory);
+        _taskPool.start(task);
+    } else {
+        auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadChunkReply,
+                                                      sizeof(MessageID) + sizeof(AssetServerError), true);
+
+        MessageID messageID;
+        message->readPrimitive(&messageID);
+
+        permissionErrorPacket->writePrimitive(messageID);
+        permissionErrorPacket->writePrimitive(AssetServerError::PermissionDenied);
+
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->sendPacket(std::move(permissionErrorPacket), *senderNode);
+    }
+}
+
 void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     MessageID messageID;
     message->readPrimitive(&messageID);
@@ -267,6 +517,19 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
 void AssetServer::handleGetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
     QString assetPath = message.readString();
 
+    QString usage;
+    QString source;
+    if (parseBakedAssetPath(assetPath, usage, source)) {
+        auto bakedHash = getBakedTexture(usage, source);
+        if (!bakedHash.isEmpty()) {
+            replyPacket.writePrimitive(AssetServerError::NoError);
+            replyPacket.write(QByteArray::fromHex(bakedHash.toUtf8()));
+        } else {
+            replyPacket.writePrimitive(AssetServerError::AssetNotFound);
+        }
+        return;
+    }
+
     auto it = _fileMappings.find(assetPath);
     if (it != _fileMappings.end()) {
         auto assetHash = it->toString();
@@ -343,6 +606,8 @@ void AssetServer::handleRenameMappingOperation(ReceivedMessage& message, SharedN
 }
 
 void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    _getInfoRequestsMetric.increment();
+
     QByteArray assetHash;
     MessageID messageID;
 
@@ -379,6 +644,7 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
 }
 
 void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    _getRequestsMetric.increment();
 
     auto minSize = qint64(sizeof(MessageID) + SHA256_HASH_LENGTH + sizeof(DataOffset) + sizeof(DataOffset));
 
@@ -388,7 +654,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _fileCache);
     _taskPool.start(task);
 }
 
@@ -397,7 +663,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (senderNode->getCanWriteToAssetServer()) {
         qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _fileCache);
         _taskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -484,6 +750,24 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    if (_bakeTextures) {
+        QJsonObject bakingStats;
+        bakingStats["1. Baked"] = getBakedTextureHashes().size();
+        bakingStats["2. In Progress"] = _pendingTextureBakes.size();
+        serverStats["Texture Baking"] = bakingStats;
+    }
+
+    if (_fileCache) {
+        auto cacheStats = _fileCache->getStats();
+        QJsonObject fileCacheStats;
+        fileCacheStats["1. Requests"] = (double)cacheStats.requests;
+        fileCacheStats["2. Hit Rate (%)"] = cacheStats.requests > 0 ? 100.0 * cacheStats.hits / cacheStats.requests : 0.0;
+        fileCacheStats["3. Evictions"] = (double)cacheStats.evictions;
+        fileCacheStats["4. Mapped Files"] = cacheStats.numFiles;
+        fileCacheStats["5. Mapped (MB)"] = (double)cacheStats.mappedBytes / (1024 * 1024);
+        serverStats["Mapped Files Cache"] = fileCacheStats;
+    }
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -509,7 +793,7 @@ bool AssetServer::loadMappingsFromFile() {
                 while (it != _fileMappings.end()) {
                     bool shouldDrop = false;
 
-                    if (!isValidFilePath(it.key())) {
+                    if (!isValidFilePath(it.key()) || it.key().startsWith(BAKED_ASSETS_FOLDER)) {
                         qWarning() << "Will not keep mapping for" << it.key() << "since it is not a valid path.";
                         shouldDrop = true;
                     }
@@ -574,6 +858,11 @@ bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
         return false;
     }
 
+    if (path.startsWith(BAKED_ASSETS_FOLDER)) {
+        qWarning() << "Cannot set a mapping in the folder of baked assets:" << path << "=>" << hash;
+        return false;
+    }
+
     // remember what the old mapping was in case persistence fails
     auto oldMapping = _fileMappings.value(path).toString();
 
@@ -584,6 +873,13 @@ bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
     if (writeMappingsToFile()) {
         // persistence succeeded, we are good to go
         qDebug() << "Set mapping:" << path << "=>" << hash;
+
+        // uploads don't name their asset, images are baked for the usage most textures are loaded for when they are
+        // mapped - the other usages are baked when they are first requested
+        auto extension = QFileInfo(path).suffix().toLower();
+        if (_bakeTextures && QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
+            bakeTexture(hash, extension, NetworkTexture::getTextureUsage(NetworkTexture::ALBEDO_TEXTURE));
+        }
         return true;
     } else {
         // failed to persist this mapping to file - put back the old one in our in-memory representation
@@ -666,10 +962,13 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
             }
         }
 
-        // we now have a set of hashes that are unmapped - we will delete those asset files
+        // we now have a set of hashes that are unmapped - we will delete those asset files, and what was baked from them
+        removeBakedTextures(hashesToCheckForDeletion);
+
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
+            _fileCache->remove(hash);
 
             if (removeableFile.remove()) {
                 qDebug() << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
@@ -700,6 +999,12 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
         return false;
     }
 
+    if (oldPath.startsWith(BAKED_ASSETS_FOLDER) || newPath.startsWith(BAKED_ASSETS_FOLDER)) {
+        qWarning() << "Cannot rename mappings in the folder of baked assets:" << oldPath << "=>" << newPath;
+
+        return false;
+    }
+
     // figure out if this rename is for a file or folder
     if (pathIsFolder(oldPath)) {
         if (!pathIsFolder(newPath)) {
@@ -785,3 +1090,169 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
         }
     }
 }
+
+static const QString BAKED_TEXTURES_FILE_NAME = "baked.json";
+
+bool AssetServer::loadBakedTexturesFromFile() {
+    auto bakedFilePath = _resourcesDirectory.absoluteFilePath(BAKED_TEXTURES_FILE_NAME);
+
+    QFile bakedFile { bakedFilePath };
+    if (!bakedFile.exists()) {
+        return true;
+    }
+
+    if (bakedFile.open(QIODevice::ReadOnly)) {
+        QJsonParseError error;
+        auto jsonDocument = QJsonDocument::fromJson(bakedFile.readAll(), &error);
+
+        if (error.error == QJsonParseError::NoError) {
+            auto jsonObject = jsonDocument.object();
+            for (auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); ++it) {
+                if (!isValidHash(it.key())) {
+                    continue;
+                }
+
+                auto usages = it.value().toObject();
+                for (auto usage = usages.constBegin(); usage != usages.constEnd(); ++usage) {
+                    auto bakedHash = usage.value().toString();
+                    // an empty hash records that the source can't be baked
+                    if (bakedHash.isEmpty() || (isValidHash(bakedHash) && _filesDirectory.exists(bakedHash))) {
+                        _bakedTextures[it.key()][usage.key()] = bakedHash;
+                    }
+                }
+            }
+
+            qInfo() << "Loaded the textures baked from" << _bakedTextures.size() << "assets from" << bakedFilePath;
+            return true;
+        }
+    }
+
+    qCritical() << "Failed to read baked textures file at" << bakedFilePath;
+    return false;
+}
+
+bool AssetServer::writeBakedTexturesToFile() {
+    auto bakedFilePath = _resourcesDirectory.absoluteFilePath(BAKED_TEXTURES_FILE_NAME);
+
+    QJsonObject jsonObject;
+    for (auto it = _bakedTextures.cbegin(); it != _bakedTextures.cend(); ++it) {
+        QJsonObject usages;
+        for (auto usage = it.value().cbegin(); usage != it.value().cend(); ++usage) {
+            usages[usage.key()] = usage.value();
+        }
+        jsonObject[it.key()] = usages;
+    }
+
+    QFile bakedFile { bakedFilePath };
+    if (bakedFile.open(QIODevice::WriteOnly) && bakedFile.write(QJsonDocument(jsonObject).toJson()) != -1) {
+        return true;
+    }
+
+    qWarning() << "Failed to write baked textures to file at" << bakedFilePath;
+    return false;
+}
+
+AssetHash AssetServer::getBakedTexture(const QString& usage, const QString& source) {
+    NetworkTexture::Type type;
+    if (!_bakeTextures || !NetworkTexture::getTextureTypeForUsage(usage, type)) {
+        return AssetHash();
+    }
+
+    AssetHash sourceHash = _fileMappings.value("/" + source).toString();
+    if (sourceHash.isEmpty()) {
+        QRegExp hashRegex { "^([a-f0-9]{" + QString::number(SHA256_HASH_HEX_LENGTH) + "})(\\.[\\w]+)?$" };
+        if (!hashRegex.exactMatch(source) || !_filesDirectory.exists(hashRegex.cap(1))) {
+            return AssetHash();
+        }
+        sourceHash = hashRegex.cap(1);
+    }
+
+    auto bakedTextures = _bakedTextures.value(sourceHash);
+    auto it = bakedTextures.find(usage);
+    if (it != bakedTextures.end()) {
+        return it.value();
+    }
+
+    bakeTexture(sourceHash, QFileInfo(source).suffix().toLower(), usage);
+    return AssetHash();
+}
+
+void AssetServer::bakeTexture(const AssetHash& sourceHash, const QString& sourceExtension, const QString& usage) {
+    NetworkTexture::Type type;
+    if (!NetworkTexture::getTextureTypeForUsage(usage, type) || _bakedTextures.value(sourceHash).contains(usage)) {
+        return;
+    }
+
+    auto bakeKey = sourceHash + "/" + usage;
+    if (!_pendingTextureBakes.contains(bakeKey)) {
+        _pendingTextureBakes.insert(bakeKey);
+        _bakingPool.start(new BakeTextureTask(this, _filesDirectory, sourceHash, sourceExtension, type));
+    }
+}
+
+void AssetServer::handleCompletedTextureBake(QString sourceHash, QString usage, QString bakedHash) {
+    _pendingTextureBakes.remove(sourceHash + "/" + usage);
+
+    if (!_filesDirectory.exists(sourceHash)) {
+        // the source was deleted while it was baked
+        if (!bakedHash.isEmpty() && !getBakedTextureHashes().contains(bakedHash) &&
+            !_fileMappings.values().contains(bakedHash)) {
+            _fileCache->remove(bakedHash);
+            QFile::remove(_filesDirectory.absoluteFilePath(bakedHash));
+        }
+        return;
+    }
+
+    _bakedTextures[sourceHash][usage] = bakedHash;
+    writeBakedTexturesToFile();
+}
+
+void AssetServer::removeBakedTextures(const QSet<AssetHash>& sourceHashes) {
+    QSet<AssetHash> bakedHashes;
+    bool removedAny = false;
+    for (auto& sourceHash : sourceHashes) {
+        auto it = _bakedTextures.find(sourceHash);
+        if (it != _bakedTextures.end()) {
+            for (auto& bakedHash : it.value()) {
+                if (!bakedHash.isEmpty()) {
+                    bakedHashes << bakedHash;
+                }
+            }
+            _bakedTextures.erase(it);
+            removedAny = true;
+        }
+    }
+
+    if (!removedAny) {
+        return;
+    }
+    writeBakedTexturesToFile();
+
+    // the same texture can be baked from two sources, or be uploaded as an asset of its own
+    bakedHashes -= getBakedTextureHashes();
+    for (auto& hashVariant : _fileMappings) {
+        bakedHashes.remove(hashVariant.toString());
+    }
+
+    for (auto& bakedHash : bakedHashes) {
+        _fileCache->remove(bakedHash);
+
+        if (QFile::remove(_filesDirectory.absoluteFilePath(bakedHash))) {
+            qDebug() << "\tDeleted baked texture" << bakedHash << "since its source is now unmapped.";
+        } else {
+            qDebug() << "\tAttempt to delete baked texture" << bakedHash << "failed";
+        }
+    }
+}
+
+QSet<AssetHash> AssetServer::getBakedTextureHashes() const {
+    QSet<AssetHash> bakedHashes;
+    for (auto& bakedTextures : _bakedTextures) {
+        for (auto& bakedHash : bakedTextures) {
+            if (!bakedHash.isEmpty()) {
+                bakedHashes << bakedHash;
+            }
+        }
+    }
+    return bakedHashes;
+}
@@ -12,19 +12,28 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QThreadPool>
 
+#include <HTTPManager.h>
+#include <Metrics.h>
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
-class AssetServer : public ThreadedAssignment {
+class AssetFileCache;
+
+class AssetServer : public ThreadedAssignment, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssetServer(ReceivedMessage& message);
 
+    /// Serves the asset files by hash, at /<hash> with an optional extension, for a CDN in front of the asset-server
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
 public slots:
     void run() override;
 
@@ -34,12 +43,17 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetUploadStatus(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
+    void handleAssetUploadChunk(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
+    void handleCompletedTextureBake(QString sourceHash, QString usage, QString bakedHash);
+
     void sendStatsPacket() override;
 
 private:
     using Mappings = QVariantHash;
+    using BakedTextures = QHash<AssetHash, QHash<QString, AssetHash>>;
 
     void handleGetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
@@ -63,11 +77,42 @@ private:
     // deletes any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
+    // deletes the chunks of the uploads that were not resumed for a while
+    void cleanupExpiredUploads();
+
+    bool loadBakedTexturesFromFile();
+    bool writeBakedTexturesToFile();
+
+    /// Returns the hash of the KTX baked for usage from source - the path of a mapping without its leading slash or a hash
+    /// with an extension - if there is one, else starts baking it and returns an empty hash
+    AssetHash getBakedTexture(const QString& usage, const QString& source);
+
+    /// Bakes the asset for usage if it wasn't already
+    void bakeTexture(const AssetHash& sourceHash, const QString& sourceExtension, const QString& usage);
+
+    /// Forgets the textures baked from the sources and deletes their files
+    void removeBakedTextures(const QSet<AssetHash>& sourceHashes);
+
+    QSet<AssetHash> getBakedTextureHashes() const;
+
     Mappings _fileMappings;
 
+    bool _bakeTextures { false };
+    BakedTextures _bakedTextures; // usage => baked hash by source hash, the hash is empty when the source can't be baked
+    QSet<QString> _pendingTextureBakes; // source hash and usage of the bakes in progress
+
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    QDir _uploadsDirectory; // a directory of chunks for each asset uploaded in chunks, until it has all of them
+    std::shared_ptr<AssetFileCache> _fileCache; // of the files the send tasks read, shared with them
     QThreadPool _taskPool;
+    QThreadPool _bakingPool;
+
+    HTTPManager* _httpManager { nullptr }; // when the asset files are also served over HTTP
+
+    MetricCounter& _getRequestsMetric;
+    MetricCounter& _getInfoRequestsMetric;
+    MetricCounter& _uploadRequestsMetric;
 };
 
 #endif
@@ -0,0 +1,92 @@
+//
+//  BakeTextureTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeTextureTask.h"
+
+#include <QtCore/QFile>
+#include <QtGui/QImage>
+
+#include <ktx/KTX.h>
+
+#include "AssetServer.h"
+
+BakeTextureTask::BakeTextureTask(AssetServer* server, const QDir& filesDirectory, const AssetHash& sourceHash,
+                                 const QString& sourceExtension, NetworkTexture::Type type) :
+    _server(server),
+    _filesDirectory(filesDirectory),
+    _sourceHash(sourceHash),
+    _sourceExtension(sourceExtension),
+    _type(type)
+{
+
+}
+
+void BakeTextureTask::run() {
+    auto bakedHash = bake();
+
+    QMetaObject::invokeMethod(_server, "handleCompletedTextureBake", Qt::QueuedConnection,
+                              Q_ARG(QString, _sourceHash), Q_ARG(QString, NetworkTexture::getTextureUsage(_type)),
+                              Q_ARG(QString, bakedHash));
+}
+
+AssetHash BakeTextureTask::bake() {
+    auto usage = NetworkTexture::getTextureUsage(_type);
+
+    QFile sourceFile { _filesDirectory.filePath(_sourceHash) };
+    if (!sourceFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open" << _sourceHash << "to bake it for" << usage;
+        return AssetHash();
+    }
+
+    // like ImageReader, help the loader with the extension of the file, some tga can't be read without it
+    QImage image = QImage::fromData(sourceFile.readAll(), _sourceExtension.isEmpty() ? nullptr :
+                                    _sourceExtension.toLatin1().constData());
+    sourceFile.close();
+    if (image.isNull()) {
+        qDebug() << "Not baking" << _sourceHash << "for" << usage << "since it is not an image.";
+        return AssetHash();
+    }
+
+    auto loader = NetworkTexture::getTextureLoaderForType(_type);
+    std::unique_ptr<gpu::Texture> texture { loader(image, _sourceHash.toStdString()) };
+    auto ktx = texture ? gpu::Texture::serialize(*texture) : ktx::KTXUniquePointer();
+    if (!ktx) {
+        qWarning() << "Failed to bake" << _sourceHash << "for" << usage;
+        return AssetHash();
+    }
+
+    QByteArray bakedData { reinterpret_cast<const char*>(ktx->getStorage()->data()), (int)ktx->getStorage()->size() };
+    AssetHash bakedHash = hashData(bakedData).toHex();
+    if (_filesDirectory.exists(bakedHash)) {
+        return bakedHash;
+    }
+
+    // written next to the files and renamed, so the file is never read while it is only partly written
+    QFile bakedFile { _filesDirectory.filePath(bakedHash + "." + usage + ".part") };
+    if (!bakedFile.open(QIODevice::WriteOnly) || bakedFile.write(bakedData) != bakedData.size()) {
+        qWarning() << "Failed to write the baked" << usage << "of" << _sourceHash;
+        bakedFile.remove();
+        return AssetHash();
+    }
+    bakedFile.close();
+
+    if (!bakedFile.rename(_filesDirectory.filePath(bakedHash))) {
+        // fails too when another bake wrote the same KTX first
+        bakedFile.remove();
+        if (!_filesDirectory.exists(bakedHash)) {
+            qWarning() << "Failed to write the baked" << usage << "of" << _sourceHash;
+            return AssetHash();
+        }
+    }
+
+    qDebug() << "Baked" << _sourceHash << "for" << usage << "into" << bakedHash << "-" << bakedData.size() << "bytes";
+    return bakedHash;
+}
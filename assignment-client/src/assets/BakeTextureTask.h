@@ -0,0 +1,47 @@
+//
+//  BakeTextureTask.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BakeTextureTask_h
+#define hifi_BakeTextureTask_h
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QString>
+
+#include <model-networking/TextureCache.h>
+
+#include "AssetUtils.h"
+
+class AssetServer;
+
+/// Bakes an image asset into the KTX of the texture clients load it as for a texture type, with its mips,
+/// the way NetworkTexture does. The KTX is written to the files directory under its own hash and the server is
+/// told with handleCompletedTextureBake, with an empty hash if the asset could not be baked.
+class BakeTextureTask : public QRunnable {
+public:
+    BakeTextureTask(AssetServer* server, const QDir& filesDirectory, const AssetHash& sourceHash,
+                    const QString& sourceExtension, NetworkTexture::Type type);
+
+    void run() override;
+
+private:
+    AssetHash bake();
+
+    AssetServer* _server;
+    QDir _filesDirectory;
+    AssetHash _sourceHash;
+    QString _sourceExtension;
+    NetworkTexture::Type _type;
+};
+
+#endif // hifi_BakeTextureTask_h
@@ -11,8 +11,6 @@
 
 #include "SendAssetTask.h"
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -23,11 +21,12 @@
 #include "AssetUtils.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                             std::shared_ptr<AssetFileCache> fileCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _fileCache(fileCache)
 {
     
 }
@@ -59,25 +58,22 @@ void SendAssetTask::run() {
     if (end <= start) {
         replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        // the range is written into the packets straight from the pages of the mapped file
+        MappedAssetFilePointer file = _fileCache->get(QString(hexHash));
 
-        if (file.open(QIODevice::ReadOnly)) {
-            if (file.size() < end) {
+        if (file) {
+            if (file->getSize() < end) {
                 replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " " << start << ":" << end;
             } else {
                 auto size = end - start;
-                file.seek(start);
                 replyPacketList->writePrimitive(AssetServerError::NoError);
                 replyPacketList->writePrimitive(size);
-                replyPacketList->write(file.read(size));
+                replyPacketList->write(file->getData() + start, size);
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+            qCDebug(networking) << "Asset not found: " << hexHash;
             replyPacketList->writePrimitive(AssetServerError::AssetNotFound);
         }
     }
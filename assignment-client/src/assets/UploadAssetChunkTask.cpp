@@ -0,0 +1,166 @@
+//
+//  UploadAssetChunkTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadAssetChunkTask.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include <AssetUtils.h>
+#include <NodeList.h>
+
+#include "ClientServerUtils.h"
+
+UploadAssetChunkTask::UploadAssetChunkTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
+                                           const QDir& filesDirectory, const QDir& uploadsDirectory) :
+    _receivedMessage(receivedMessage),
+    _senderNode(senderNode),
+    _filesDirectory(filesDirectory),
+    _uploadsDirectory(uploadsDirectory)
+{
+
+}
+
+void UploadAssetChunkTask::run() {
+    MessageID messageID;
+    _receivedMessage->readPrimitive(&messageID);
+
+    auto replyPacket = NLPacket::create(PacketType::AssetUploadChunkReply, -1, true);
+    replyPacket->writePrimitive(messageID);
+
+    auto minSize = qint64(sizeof(MessageID) + SHA256_HASH_LENGTH + sizeof(uint64_t) + sizeof(uint32_t) + SHA256_HASH_LENGTH);
+    if (_receivedMessage->getSize() < minSize) {
+        qDebug() << "ERROR bad upload chunk from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
+        replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
+        DependencyManager::get<NodeList>()->sendPacket(std::move(replyPacket), *_senderNode);
+        return;
+    }
+
+    auto hash = _receivedMessage->read(SHA256_HASH_LENGTH);
+    uint64_t size;
+    _receivedMessage->readPrimitive(&size);
+    uint32_t index;
+    _receivedMessage->readPrimitive(&index);
+    auto chunkHash = _receivedMessage->read(SHA256_HASH_LENGTH);
+    auto chunk = _receivedMessage->readAll();
+
+    QString hexHash = hash.toHex();
+    uint32_t numChunks = (uint32_t)((size + ASSET_CHUNK_SIZE - 1) / ASSET_CHUNK_SIZE);
+    uint64_t chunkSize = index < numChunks ? std::min(ASSET_CHUNK_SIZE, size - index * ASSET_CHUNK_SIZE) : 0;
+
+    if (size > MAX_UPLOAD_SIZE) {
+        replyPacket->writePrimitive(AssetServerError::AssetTooLarge);
+    } else if (index >= numChunks || (uint64_t)chunk.size() != chunkSize) {
+        qWarning() << "Chunk" << index << "of the upload of" << hexHash << "doesn't fit an asset of" << size << "bytes";
+        replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
+    } else if (_filesDirectory.exists(hexHash)) {
+        // another upload of the same asset completed first
+        replyPacket->writePrimitive(AssetServerError::NoError);
+        replyPacket->writePrimitive((uint8_t)true);
+    } else if (hashData(chunk) != chunkHash) {
+        // not kept, the client sends it again when it asks which chunks are missing
+        qWarning() << "Chunk" << index << "of the upload of" << hexHash << "doesn't match its hash, dropping it";
+        replyPacket->writePrimitive(AssetServerError::NoError);
+        replyPacket->writePrimitive((uint8_t)false);
+    } else {
+        QDir uploadDirectory = _uploadsDirectory;
+        auto chunkName = QString::number(index);
+
+        // written next to the chunks and renamed, so a chunk is never joined while it is only partly written
+        QFile chunkFile;
+        bool written = uploadDirectory.mkpath(hexHash) && uploadDirectory.cd(hexHash);
+        if (written) {
+            chunkFile.setFileName(uploadDirectory.filePath(chunkName + ".part"));
+            written = chunkFile.open(QIODevice::WriteOnly) && chunkFile.write(chunk) == chunk.size();
+            chunkFile.close();
+            if (written && !chunkFile.rename(uploadDirectory.filePath(chunkName))) {
+                // fails too when the chunk was sent again and the other copy was kept first
+                chunkFile.remove();
+                written = uploadDirectory.exists(chunkName);
+            }
+        }
+
+        if (!written) {
+            qWarning() << "Failed to write chunk" << index << "of the upload of" << hexHash;
+            if (chunkFile.exists()) {
+                chunkFile.remove();
+            }
+            replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
+        } else {
+            bool complete = true;
+            for (uint32_t i = 0; i < numChunks && complete; ++i) {
+                complete = uploadDirectory.exists(QString::number(i));
+            }
+
+            if (complete && !writeAsset(hash, size, numChunks, index)) {
+                replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
+            } else {
+                replyPacket->writePrimitive(AssetServerError::NoError);
+                replyPacket->writePrimitive((uint8_t)complete);
+            }
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+}
+
+bool UploadAssetChunkTask::writeAsset(const QByteArray& hash, uint64_t size, uint32_t numChunks, uint32_t index) {
+    QString hexHash = hash.toHex();
+    QDir uploadDirectory = _uploadsDirectory;
+    uploadDirectory.cd(hexHash);
+
+    // named after the chunk that completed the asset, in case two chunks complete it at once
+    QFile assetFile { _filesDirectory.filePath(hexHash + "." + QString::number(index) + ".part") };
+    if (!assetFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write the uploaded file" << hexHash;
+        return false;
+    }
+
+    QCryptographicHash assetHash { QCryptographicHash::Sha256 };
+    bool written = true;
+    for (uint32_t i = 0; i < numChunks && written; ++i) {
+        QFile chunkFile { uploadDirectory.filePath(QString::number(i)) };
+        written = chunkFile.open(QIODevice::ReadOnly);
+        if (written) {
+            auto chunk = chunkFile.readAll();
+            assetHash.addData(chunk);
+            written = assetFile.write(chunk) == chunk.size();
+        }
+    }
+    assetFile.close();
+
+    if (!written || (uint64_t)assetFile.size() != size || assetHash.result() != hash) {
+        assetFile.remove();
+        if (_filesDirectory.exists(hexHash)) {
+            // joined by the other chunk that completed it, which also removed the chunks
+            return true;
+        }
+
+        qWarning() << "The chunks uploaded for" << hexHash << "don't make the asset, dropping them";
+        uploadDirectory.removeRecursively();
+        return false;
+    }
+
+    if (!assetFile.rename(_filesDirectory.filePath(hexHash))) {
+        assetFile.remove();
+        if (!_filesDirectory.exists(hexHash)) {
+            qWarning() << "Failed to write the uploaded file" << hexHash;
+            return false;
+        }
+    }
+
+    uploadDirectory.removeRecursively();
+    qDebug() << "Wrote file" << hexHash << "from" << numChunks << "uploaded chunks. Upload complete";
+    return true;
+}
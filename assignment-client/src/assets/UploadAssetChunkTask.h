@@ -0,0 +1,44 @@
+//
+//  UploadAssetChunkTask.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_UploadAssetChunkTask_h
+#define hifi_UploadAssetChunkTask_h
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include "ReceivedMessage.h"
+
+class Node;
+
+/// Keeps a chunk of an asset uploaded in chunks in the directory of its upload, once its hash is checked. The chunk
+/// that completes the asset has the chunks joined into the asset's file, which is checked against the asset's hash.
+class UploadAssetChunkTask : public QRunnable {
+public:
+    UploadAssetChunkTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                         const QDir& filesDirectory, const QDir& uploadsDirectory);
+
+    void run() override;
+
+private:
+    /// Writes the asset from its uploaded chunks, returns false if they could not be read or don't make the asset
+    bool writeAsset(const QByteArray& hash, uint64_t size, uint32_t numChunks, uint32_t index);
+
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    QSharedPointer<Node> _senderNode;
+    QDir _filesDirectory;
+    QDir _uploadsDirectory;
+};
+
+#endif // hifi_UploadAssetChunkTask_h
@@ -18,14 +18,16 @@
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetFileCache.h"
 #include "ClientServerUtils.h"
 
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir) :
+                                 const QDir& resourcesDir, std::shared_ptr<AssetFileCache> fileCache) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache)
 {
     
 }
@@ -75,6 +77,10 @@ void UploadAssetTask::run() {
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
                 file.close();
+
+                // the file is replaced rather than truncated, the tasks still sending from its mapping keep the old pages
+                _fileCache->remove(QString(hexHash));
+                file.remove();
             }
         }
 
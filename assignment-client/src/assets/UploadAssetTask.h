@@ -14,6 +14,8 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
@@ -21,12 +23,14 @@
 
 #include "ReceivedMessage.h"
 
+class AssetFileCache;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir);
+    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir,
+                    std::shared_ptr<AssetFileCache> fileCache);
 
     void run() override;
 
@@ -34,6 +38,7 @@ private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<AssetFileCache> _fileCache;
 };
 
 #endif // hifi_UploadAssetTask_h
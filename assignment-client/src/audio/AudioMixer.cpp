@@ -28,6 +28,7 @@
 #include <StDev.h>
 #include <UUID.h>
 #include <CPUDetect.h>
+#include <Profile.h>
 
 #include "AudioHelpers.h"
 #include "AudioRingBuffer.h"
@@ -47,6 +48,10 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 int AudioMixer::_numStaticJitterFrames{ -1 };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
+float AudioMixer::_audibleRadius{ 0.0f };
+AudioMixer::ClusterSettings AudioMixer::_clusterSettings;
+float AudioMixer::_farFieldRadius{ 0.0f };
+float AudioMixer::_farFieldCellSize{ 10.0f };
 std::map<QString, std::shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
@@ -67,7 +72,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto& packetReceiver = nodeList->getPacketReceiver();
 
     // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // (and are only queued for the slaves, so that can happen right on the NodeList thread)
+    packetReceiver.registerDirectListenerForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
@@ -94,7 +100,7 @@ void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, Share
         _numSilentPackets++;
     }
 
-    getOrCreateClientData(node.data())->queuePacket(message, node);
+    getOrCreateClientData(node.data())->queuePacket(message);
 }
 
 void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -235,6 +241,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == -1;
 
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["slave_steals_per_frame"] = (float)_stats.slaveSteals / (float)_numStatFrames;
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
@@ -263,6 +270,47 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_eventsTiming, "events");
     addTiming(_packetsTiming, "packets");
 
+    // stage latency percentiles, over every frame (or listener) since the last stats packet
+    QJsonObject latencyStats;
+
+    auto addPercentiles = [&](const AudioMixerHistogram& histogram, std::string name) {
+        latencyStats[("us_" + name + "_p50").c_str()] = (float)histogram.getPercentile(0.5f) / (float)NSECS_PER_USEC;
+        latencyStats[("us_" + name + "_p99").c_str()] = (float)histogram.getPercentile(0.99f) / (float)NSECS_PER_USEC;
+        latencyStats[("us_" + name + "_p999").c_str()] = (float)histogram.getPercentile(0.999f) / (float)NSECS_PER_USEC;
+    };
+
+    addPercentiles(_frameTiming.getHistogram(), "frame");
+    addPercentiles(_packetsTiming.getHistogram(), "packets");
+    addPercentiles(_prepareTiming.getHistogram(), "prepare");
+    addPercentiles(_mixTiming.getHistogram(), "mix");
+    addPercentiles(_stats.hrtfTime, "listener_hrtf");
+    addPercentiles(_stats.limiterTime, "listener_limiter");
+    addPercentiles(_stats.encodeTime, "listener_encode");
+    addPercentiles(_stats.sendTime, "listener_send");
+
+    // frames whose work did not fit in the frame budget
+    int frameOverruns = _frameTiming.getOverruns();
+    timingStats["frames_over_budget"] = frameOverruns;
+    timingStats["%_frames_over_budget"] = 100.0f * (float)frameOverruns / (float)_numStatFrames;
+    timingStats["latency_percentiles"] = latencyStats;
+
+    counter(trace_app(), "AudioMixerFrame", {
+        { "p50", (double)_frameTiming.getHistogram().getPercentile(0.5f) / (double)NSECS_PER_USEC },
+        { "p99", (double)_frameTiming.getHistogram().getPercentile(0.99f) / (double)NSECS_PER_USEC },
+        { "overruns", frameOverruns }
+    });
+
+    _frameTiming.resetHistogram();
+    _packetsTiming.resetHistogram();
+    _prepareTiming.resetHistogram();
+    _mixTiming.resetHistogram();
+
+    timingStats["us_per_queued_packet"] = _stats.packetsProcessed > 0 ?
+        (float)_stats.packetQueueTime / (float)_stats.packetsProcessed : 0.0f;
+
+    // idle time is summed across slaves, so report it per slave
+    timingStats["us_per_slave_idle"] = (qint64)(_stats.slaveIdleTime / _numStatFrames / _slavePool.numThreads());
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -276,9 +324,18 @@ void AudioMixer::sendStatsPacket() {
     mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
     mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(_stats.hrtfSilentRenders);
     mixStats["%_hrtf_throttle_mixes"] = percentageForMixStats(_stats.hrtfThrottleRenders);
+    mixStats["%_panned_mixes"] = percentageForMixStats(_stats.pannedRenders);
+    mixStats["%_far_field_mixes"] = percentageForMixStats(_stats.farFieldMixes);
+    mixStats["%_hrtf_culled_mixes"] = percentageForMixStats(_stats.hrtfCulledRenders);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
 
+    mixStats["far_field_renders_per_frame"] = (float)_stats.farFieldRenders / (float)_numStatFrames;
+    mixStats["far_field_cells_per_render"] = _stats.farFieldRenders > 0 ?
+        (float)_stats.farFieldCells / (float)_stats.farFieldRenders : 0.0f;
+    mixStats["cluster_mixes_per_frame"] = (float)_stats.clusterMixes / (float)_numStatFrames;
+    mixStats["shared_mixes_per_frame"] = (float)_stats.sharedMixes / (float)_numStatFrames;
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
@@ -351,6 +408,24 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    // the metrics of the frames, around the frame budget
+    auto metrics = DependencyManager::get<MetricsRegistry>();
+    const std::vector<double> FRAME_SECONDS_BOUNDS { 0.0005, 0.001, 0.002, 0.004, 0.006, 0.008,
+        (double)AudioConstants::NETWORK_FRAME_USECS / USECS_PER_SECOND, 0.015, 0.02, 0.05 };
+    _frameTiming.setMetric(&metrics->histogram("hifi_audio_mixer_frame_seconds",
+        "The time to prepare and mix a frame", FRAME_SECONDS_BOUNDS));
+    _prepareTiming.setMetric(&metrics->histogram("hifi_audio_mixer_stage_seconds",
+        "The time of each stage of a frame", FRAME_SECONDS_BOUNDS, "stage=\"prepare\""));
+    _mixTiming.setMetric(&metrics->histogram("hifi_audio_mixer_stage_seconds",
+        "The time of each stage of a frame", FRAME_SECONDS_BOUNDS, "stage=\"mix\""));
+    _packetsTiming.setMetric(&metrics->histogram("hifi_audio_mixer_stage_seconds",
+        "The time of each stage of a frame", FRAME_SECONDS_BOUNDS, "stage=\"packets\""));
+    _framesMetric = &metrics->counter("hifi_audio_mixer_frames_total", "The frames mixed");
+
+    // a frame this late is a stall, whose trace is dumped
+    const std::chrono::microseconds STALL_FRAME_DURATION(5 * AudioConstants::NETWORK_FRAME_USECS);
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+
     // mix state
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
@@ -365,18 +440,19 @@ void AudioMixer::start() {
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto frameStart = p_high_resolution_clock::now();
 
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
-            // prepare frames; pop off any new audio from their streams
+            // prepare frames across slave threads; pop off and decode any new audio from their streams
             {
+                PROFILE_RANGE(app, "AudioMixer::prepareFrames");
                 auto prepareTimer = _prepareTiming.timer();
-                std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
-                    _stats.sumStreams += prepareFrame(node, frame);
-                });
+                _slavePool.prepareFrames(cbegin, cend);
             }
 
             // mix across slave threads
             {
+                PROFILE_RANGE(app, "AudioMixer::mix");
                 auto mixTimer = _mixTiming.timer();
                 _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
             }
@@ -390,6 +466,7 @@ void AudioMixer::start() {
 
         ++frame;
         ++_numStatFrames;
+        _framesMetric->increment();
 
         // process queued events (networking, global audio packets, &c.)
         {
@@ -401,12 +478,18 @@ void AudioMixer::start() {
             // process (node-isolated) audio packets across slave threads
             {
                 nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                    PROFILE_RANGE(app, "AudioMixer::processPackets");
                     auto packetsTimer = _packetsTiming.timer();
                     _slavePool.processPackets(cbegin, cend);
                 });
             }
         }
 
+        auto frameWork = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - frameStart);
+        if (frameWork > STALL_FRAME_DURATION) {
+            tracer->reportStall("audio-mixer", frameWork.count());
+        }
+
         if (_isFinished) {
             // alert qt eventing that this is finished
             QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
@@ -481,15 +564,6 @@ void AudioMixer::throttle(std::chrono::microseconds duration, int frame) {
     }
 }
 
-int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame) {
-    AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
-    if (data == nullptr) {
-        return 0;
-    }
-
-    return data->checkBuffersBeforeFrameSend();
-}
-
 void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
     qDebug() << "AVX2 Support:" << (cpuSupportsAVX2() ? "enabled" : "disabled");
 
@@ -591,6 +665,67 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString AUDIBLE_RADIUS = "audible_radius";
+        if (audioEnvGroupObject[AUDIBLE_RADIUS].isString()) {
+            bool ok = false;
+            float audibleRadius = audioEnvGroupObject[AUDIBLE_RADIUS].toString().toFloat(&ok);
+            if (ok && audibleRadius >= 0.0f) {
+                _audibleRadius = audibleRadius;
+                qDebug() << "Audible radius changed to" << _audibleRadius;
+            }
+        }
+
+        const QString FAR_FIELD_RADIUS = "far_field_radius";
+        if (audioEnvGroupObject[FAR_FIELD_RADIUS].isString()) {
+            bool ok = false;
+            float farFieldRadius = audioEnvGroupObject[FAR_FIELD_RADIUS].toString().toFloat(&ok);
+            if (ok && farFieldRadius >= 0.0f) {
+                _farFieldRadius = farFieldRadius;
+                qDebug() << "Far field radius changed to" << _farFieldRadius;
+            }
+        }
+
+        const QString FAR_FIELD_CELL_SIZE = "far_field_cell_size";
+        if (audioEnvGroupObject[FAR_FIELD_CELL_SIZE].isString()) {
+            bool ok = false;
+            float farFieldCellSize = audioEnvGroupObject[FAR_FIELD_CELL_SIZE].toString().toFloat(&ok);
+            if (ok && farFieldCellSize > 0.0f) {
+                _farFieldCellSize = farFieldCellSize;
+                qDebug() << "Far field cell size changed to" << _farFieldCellSize;
+            }
+        }
+
+        const QString ENABLE_CLUSTER_MIXING = "enable_cluster_mixing";
+        _clusterSettings.enabled = audioEnvGroupObject[ENABLE_CLUSTER_MIXING].toBool();
+        if (_clusterSettings.enabled) {
+            bool ok = false;
+
+            const QString CLUSTER_POSITION_TOLERANCE = "cluster_position_tolerance";
+            float positionTolerance = audioEnvGroupObject[CLUSTER_POSITION_TOLERANCE].toString().toFloat(&ok);
+            if (ok && positionTolerance > 0.0f) {
+                _clusterSettings.positionTolerance = positionTolerance;
+            }
+
+            const QString CLUSTER_ORIENTATION_TOLERANCE = "cluster_orientation_tolerance";
+            float orientationTolerance = audioEnvGroupObject[CLUSTER_ORIENTATION_TOLERANCE].toString().toFloat(&ok);
+            if (ok && orientationTolerance >= 0.0f) {
+                _clusterSettings.orientationTolerance = orientationTolerance;
+            }
+
+            const QString CLUSTER_NEAR_FIELD_RADIUS = "cluster_near_field_radius";
+            float nearFieldRadius = audioEnvGroupObject[CLUSTER_NEAR_FIELD_RADIUS].toString().toFloat(&ok);
+            if (ok && nearFieldRadius > 0.0f) {
+                _clusterSettings.nearFieldRadius = nearFieldRadius;
+            }
+
+            // listeners in a cluster must all be in the near field of its representative
+            _clusterSettings.nearFieldRadius = std::max(_clusterSettings.nearFieldRadius,
+                    2.0f * _clusterSettings.positionTolerance);
+
+            qDebug() << "Cluster mixing enabled (tolerance:" << _clusterSettings.positionTolerance << "m,"
+                << _clusterSettings.orientationTolerance << "deg, near field:" << _clusterSettings.nearFieldRadius << "m)";
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -710,12 +845,24 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
     }
 }
 
-AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
+AudioMixer::Timer::Timing::Timing(Timer& timer) : _timer(timer) {
     _timing = p_high_resolution_clock::now();
 }
 
 AudioMixer::Timer::Timing::~Timing() {
-    _sum += std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
+    _timer.record(std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - _timing).count());
+}
+
+void AudioMixer::Timer::record(uint64_t nanoseconds) {
+    uint64_t microseconds = nanoseconds / NSECS_PER_USEC;
+    _sum += microseconds;
+    _histogram.record(nanoseconds);
+    if (_budget > 0 && microseconds > _budget) {
+        ++_overruns;
+    }
+    if (_metric) {
+        _metric->observe((double)nanoseconds / (double)(NSECS_PER_USEC * USECS_PER_SECOND));
+    }
 }
 
 void AudioMixer::Timer::get(uint64_t& timing, uint64_t& trailing) {
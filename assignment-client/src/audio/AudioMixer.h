@@ -12,9 +12,12 @@
 #ifndef hifi_AudioMixer_h
 #define hifi_AudioMixer_h
 
+#include <atomic>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <Metrics.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -42,10 +45,20 @@ public:
         float reverbTime;
         float wetLevel;
     };
+    struct ClusterSettings {
+        bool enabled { false };
+        float positionTolerance { 0.5f };       // meters
+        float orientationTolerance { 15.0f };   // degrees
+        float nearFieldRadius { 5.0f };         // meters
+    };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
+    static float getAudibleRadius() { return _audibleRadius; }
+    static const ClusterSettings& getClusterSettings() { return _clusterSettings; }
+    static float getFarFieldRadius() { return _farFieldRadius; }
+    static float getFarFieldCellSize() { return _farFieldCellSize; }
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
@@ -70,9 +83,6 @@ private:
     // mixing helpers
     std::chrono::microseconds timeFrame(p_high_resolution_clock::time_point& timestamp);
     void throttle(std::chrono::microseconds frameDuration, int frame);
-    // pop a frame from any streams on the node
-    // returns the number of available streams
-    int prepareFrame(const SharedNodePointer& node, unsigned int frame);
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
@@ -83,7 +93,7 @@ private:
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
 
-    int _numSilentPackets { 0 };
+    std::atomic<int> _numSilentPackets { 0 }; // counted on the NodeList thread
 
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
@@ -94,18 +104,36 @@ private:
     public:
         class Timing{
         public:
-            Timing(uint64_t& sum);
+            Timing(Timer& timer);
             ~Timing();
         private:
             p_high_resolution_clock::time_point _timing;
-            uint64_t& _sum;
+            Timer& _timer;
         };
 
-        Timing timer() { return Timing(_sum); }
+        // timings longer than budgetUsecs are counted as overruns (0 disables counting)
+        Timer(uint64_t budgetUsecs = 0) : _budget(budgetUsecs) {}
+
+        Timing timer() { return Timing(*this); }
         void get(uint64_t& timing, uint64_t& trailing);
+
+        // histogram (and overruns) of each timing since the last reset
+        const AudioMixerHistogram& getHistogram() const { return _histogram; }
+        int getOverruns() const { return _overruns; }
+        void resetHistogram() { _histogram.reset(); _overruns = 0; }
+
+        // also records each timing in seconds to the metric
+        void setMetric(MetricHistogram* metric) { _metric = metric; }
     private:
         static const int TIMER_TRAILING_SECONDS = 10;
 
+        void record(uint64_t nanoseconds);
+
+        AudioMixerHistogram _histogram;
+        uint64_t _budget { 0 };
+        int _overruns { 0 };
+        MetricHistogram* _metric { nullptr };
+
         uint64_t _sum { 0 };
         uint64_t _trailing { 0 };
         uint64_t _history[TIMER_TRAILING_SECONDS] {};
@@ -113,15 +141,21 @@ private:
     };
     Timer _ticTiming;
     Timer _sleepTiming;
-    Timer _frameTiming;
+    Timer _frameTiming { AudioConstants::NETWORK_FRAME_USECS };
     Timer _prepareTiming;
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
 
+    MetricCounter* _framesMetric { nullptr };
+
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
+    static float _audibleRadius; // 0 denotes no culling by distance
+    static ClusterSettings _clusterSettings;
+    static float _farFieldRadius; // 0 denotes no far field
+    static float _farFieldCellSize;
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
     static QHash<QString, AABox> _audioZones;
@@ -48,20 +48,18 @@ AudioMixerClientData::~AudioMixerClientData() {
     }
 }
 
-void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
-    }
+void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message) {
     _packetQueue.push(message);
 }
 
-void AudioMixerClientData::processPackets() {
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
+int AudioMixerClientData::processPackets(const SharedNodePointer& node, uint64_t& queueTime) {
+    int packetsProcessed = 0;
+    auto now = p_high_resolution_clock::now();
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    QSharedPointer<ReceivedMessage> packet;
+    while (_packetQueue.try_pop(packet)) {
+        packetsProcessed++;
+        queueTime += std::chrono::duration_cast<std::chrono::microseconds>(now - packet->getFirstPacketReceiveTime()).count();
 
         switch (packet->getType()) {
             case PacketType::MicrophoneAudioNoEcho:
@@ -91,10 +89,9 @@ void AudioMixerClientData::processPackets() {
             default:
                 Q_UNREACHABLE();
         }
-
-        _packetQueue.pop();
     }
-    assert(_packetQueue.empty());
+
+    return packetsProcessed;
 }
 
 void AudioMixerClientData::negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node) {
@@ -124,6 +121,7 @@ void AudioMixerClientData::parsePerAvatarGainSet(ReceivedMessage& message, const
     message.readPrimitive(&packedGain);
     float gain = unpackFloatGainFromByte(packedGain);
     hrtfForStream(avatarUuid, QUuid()).setGainAdjustment(gain);
+    _hasPerAvatarGains = true;
     qDebug() << "Setting gain adjustment for hrtf[" << uuid << "][" << avatarUuid << "] to " << gain;
 }
 
@@ -285,6 +283,9 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
 
         if (stream->popFrames(1, true) > 0) {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
+
+            // decode once here, rather than once per listener
+            stream->decodeLastPopOutput();
         }
 
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
@@ -463,22 +464,40 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
-void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
-    static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+int AudioMixerClientData::encode(const int16_t* samples, char* encodedBuffer, int maxEncodedSize) {
+    const char* decodedBuffer = reinterpret_cast<const char*>(samples);
+    const int decodedSize = AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+
+    int encodedSize;
+    if (_encoder) {
+        encodedSize = _encoder->encodeInto(decodedBuffer, decodedSize, encodedBuffer, maxEncodedSize);
+    } else if (decodedSize <= maxEncodedSize) {
+        memcpy(encodedBuffer, decodedBuffer, decodedSize);
+        encodedSize = decodedSize;
+    } else {
+        encodedSize = -1;
+    }
+
+    // once you have encoded, you need to flush eventually.
+    _shouldFlushEncoder = true;
+    return encodedSize;
+}
+
+int AudioMixerClientData::encodeFrameOfZeros(char* encodedBuffer, int maxEncodedSize) {
+    static const int16_t zeros[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = {};
+    int encodedSize = 0;
     if (_shouldFlushEncoder) {
-        if (_encoder) {
-            _encoder->encode(zeros, encodedZeros);
-        } else {
-            encodedZeros = zeros;
-        }
+        encodedSize = encode(zeros, encodedBuffer, maxEncodedSize);
     }
     _shouldFlushEncoder = false;
+    return encodedSize;
 }
 
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+    _selectedCodecNameUtf8 = codecName.toUtf8();
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
@@ -12,11 +12,12 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
-#include <queue>
-
 #include <QtCore/QJsonObject>
 
+#include <tbb/concurrent_queue.h>
+
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -27,6 +28,8 @@
 #include "AvatarAudioStream.h"
 
 
+struct AudioMixerCluster;
+
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -36,11 +39,20 @@ public:
     using SharedStreamPointer = std::shared_ptr<PositionalAudioStream>;
     using AudioStreamMap = std::unordered_map<QUuid, SharedStreamPointer>;
 
-    void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
-    void processPackets();
+    // called on the NodeList thread
+    void queuePacket(QSharedPointer<ReceivedMessage> packet);
+    // called by a slave; returns number of packets processed, and adds the usecs they spent queued to queueTime
+    int processPackets(const SharedNodePointer& node, uint64_t& queueTime);
 
     // locks the mutex to make a copy
     AudioStreamMap getAudioStreams() { QReadLocker readLock { &_streamsLock }; return _audioStreams; }
+    // visit each stream under the read lock, without copying the map (for the mix, which runs once per listener)
+    template <typename F> void forEachAudioStream(F functor) {
+        QReadLocker readLock { &_streamsLock };
+        for (auto& streamPair : _audioStreams) {
+            functor(*streamPair.second);
+        }
+    }
     AvatarAudioStream* getAvatarAudioStream();
 
     // returns whether self (this data's node) should ignore node, memoized by frame
@@ -88,24 +100,41 @@ public:
 
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
-        if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = decodedBuffer;
-        }
-        // once you have encoded, you need to flush eventually.
-        _shouldFlushEncoder = true;
-    }
-    void encodeFrameOfZeros(QByteArray& encodedZeros);
+    // encode a stereo frame into encodedBuffer, returning the encoded size (or -1 if it exceeds maxEncodedSize)
+    int encode(const int16_t* samples, char* encodedBuffer, int maxEncodedSize);
+    int encodeFrameOfZeros(char* encodedBuffer, int maxEncodedSize);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
+    // the frame last encoded is one the decoder of the listener fills in by itself
+    bool isEncoderDiscontinuous() const { return _encoder && _encoder->isDiscontinuous(); }
+    // cap the bitrate of the mix, for the bandwidth budget of the listener
+    void setMaxMixBitrate(int bitsPerSecond) { if (_encoder) { _encoder->setMaxBitrate(bitsPerSecond); } }
 
     QString getCodecName() { return _selectedCodecName; }
+    // the codec name as written on the wire, cached to avoid converting it for every packet
+    const QByteArray& getCodecNameUtf8() const { return _selectedCodecNameUtf8; }
 
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
     glm::vec3 getPosition() { return getAvatarAudioStream() ? getAvatarAudioStream()->getPosition() : glm::vec3(0); }
     bool getRequestsDomainListData() { return _requestsDomainListData; }
+
+    // the time (in ns) spent mixing for this listener in the last frame, used to schedule mixes
+    uint64_t getLastMixCost() const { return _lastMixCost; }
+    void setLastMixCost(uint64_t cost) { _lastMixCost = cost; }
+
+    // the cluster sharing this listener's far-field mix, if any (set by the slave pool each frame)
+    AudioMixerCluster* getMixCluster() const { return _mixCluster; }
+    void setMixCluster(AudioMixerCluster* cluster) { _mixCluster = cluster; }
+    bool wasClusterRepresentative() const { return _wasClusterRepresentative; }
+    void setWasClusterRepresentative(bool wasRepresentative) { _wasClusterRepresentative = wasRepresentative; }
+
+    // listeners with per-avatar gains hear a mix that cannot be shared
+    bool hasPerAvatarGains() const { return _hasPerAvatarGains; }
+
+    // renders the far field (see AudioMixerFarField) for this listener
+    AudioFOA& getFarFieldFOA() { return _farFieldFOA; }
+    bool wasFarFieldRendered() const { return _wasFarFieldRendered; }
+    void setFarFieldRendered(bool rendered) { _wasFarFieldRendered = rendered; }
     void setRequestsDomainListData(bool requesting) { _requestsDomainListData = requesting; }
 
 signals:
@@ -116,10 +145,8 @@ public slots:
     void sendSelectAudioFormat(SharedNodePointer node, const QString& selectedCodecName);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
-        QWeakPointer<Node> node;
-    };
-    PacketQueue _packetQueue;
+    // pushed by the NodeList thread and popped by a slave, possibly at the same time
+    tbb::concurrent_queue<QSharedPointer<ReceivedMessage>> _packetQueue;
 
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
@@ -174,6 +201,7 @@ private:
 
     CodecPluginPointer _codec;
     QString _selectedCodecName;
+    QByteArray _selectedCodecNameUtf8;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
     Decoder* _decoder{ nullptr }; // for mic stream
 
@@ -181,6 +209,15 @@ private:
 
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
+
+    uint64_t _lastMixCost { 0 };
+
+    AudioMixerCluster* _mixCluster { nullptr };
+    bool _wasClusterRepresentative { false };
+    bool _hasPerAvatarGains { false };
+
+    AudioFOA _farFieldFOA;
+    bool _wasFarFieldRendered { false };
 };
 
 #endif // hifi_AudioMixerClientData_h
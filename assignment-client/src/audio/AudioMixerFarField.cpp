@@ -0,0 +1,138 @@
+//
+//  AudioMixerFarField.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <assert.h>
+#include <cstring>
+
+#include <AudioHelpers.h>
+#include <Node.h>
+#include <NumericalConstants.h>
+#include <PositionalAudioStream.h>
+
+#include "AudioMixer.h"
+#include "AudioMixerSpatialGrid.h"
+
+#include "AudioMixerFarField.h"
+
+bool AudioMixerFarField::isEligible(const Node& node, const PositionalAudioStream& stream) {
+    // only avatar microphones: injectors may be echoes of the listener's own node
+    if (stream.getType() != PositionalAudioStream::Microphone || stream.isStereo()) {
+        return false;
+    }
+
+    if (node.hasIgnoredNodes() || node.isIgnoreRadiusEnabled()) {
+        return false;
+    }
+
+    // zone attenuation depends on the listener
+    auto& audioZones = AudioMixer::getAudioZones();
+    for (auto& zoneSettings : AudioMixer::getZoneSettings()) {
+        if (audioZones.value(zoneSettings.source).contains(stream.getPosition())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AudioMixerFarField::reset(float cellSize, float radius) {
+    assert(cellSize > 0.0f);
+    _cellSize = cellSize;
+    _inverseCellSize = 1.0f / cellSize;
+    _radius = radius;
+    _numCells = 0;
+    _cellIndices.clear();
+}
+
+void AudioMixerFarField::insert(const PositionalAudioStream& stream) {
+    if (!stream.lastPopSucceeded() || stream.getLastPopOutputLoudness() == 0.0f) {
+        // nothing to hear
+        return;
+    }
+
+    glm::ivec3 coordinates = cellCoordinates(stream.getPosition());
+    auto result = _cellIndices.emplace(AudioMixerSpatialGrid::cellKey(coordinates), _numCells);
+    if (result.second) {
+        if (_numCells == (int)_cells.size()) {
+            _cells.emplace_back();
+        }
+        auto& cell = _cells[_numCells++];
+        cell.coordinates = coordinates;
+        cell.positionSum = glm::vec3(0.0f);
+        cell.numStreams = 0;
+        memset(cell.samples, 0, sizeof(cell.samples));
+    }
+
+    auto& cell = _cells[result.first->second];
+    cell.positionSum += stream.getPosition();
+    ++cell.numStreams;
+
+    // mono frame, decoded once for all listeners (see AudioMixerSlavePool::prepareFrames)
+    const float* samples = stream.getLastPopOutputSamples();
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        cell.samples[i] += samples[i];
+    }
+}
+
+void AudioMixerFarField::finalize() {
+    for (int i = 0; i < _numCells; ++i) {
+        auto& cell = _cells[i];
+        cell.centroid = cell.positionSum / (float)cell.numStreams;
+    }
+}
+
+float AudioMixerFarField::distanceToCell(const glm::vec3& position, const glm::ivec3& cell) const {
+    glm::vec3 cellMin = glm::vec3(cell) * _cellSize;
+    glm::vec3 closest = glm::clamp(position, cellMin, cellMin + glm::vec3(_cellSize));
+    return glm::length(position - closest);
+}
+
+int AudioMixerFarField::encode(const glm::vec3& listenerPosition, float maxDistance,
+        float attenuationPerDoublingInDistance, float* bFormat[4]) const {
+    // translate the attenuation to gain per log2(distance) (see computeGain in AudioMixerSlave)
+    const float ATTENUATION_START_DISTANCE = 1.0f;
+    float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, EPSILON, 1.0f);
+    float log2g = fastLog2f(g);
+
+    int numEncoded = 0;
+    for (int i = 0; i < _numCells; ++i) {
+        auto& cell = _cells[i];
+        float cellDistance = distanceToCell(listenerPosition, cell.coordinates);
+        if (cellDistance <= _radius || (maxDistance > 0.0f && cellDistance > maxDistance)) {
+            continue;
+        }
+
+        glm::vec3 relativePosition = cell.centroid - listenerPosition;
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        glm::vec3 direction = relativePosition / distance;
+
+        float gain = 1.0f;
+        if (distance >= ATTENUATION_START_DISTANCE) {
+            gain = fastExp2f(log2g * fastLog2f(distance / ATTENUATION_START_DISTANCE));
+        }
+
+        // convert from Y-up (OpenGL) to X-front, Y-left, Z-up (Ambisonic) coordinates
+        float x = -direction.z * gain;
+        float y = -direction.x * gain;
+        float z = direction.y * gain;
+
+        for (int j = 0; j < NUM_FRAMES; j++) {
+            float sample = cell.samples[j];
+            bFormat[0][j] += sample * gain;
+            bFormat[1][j] += sample * x;
+            bFormat[2][j] += sample * y;
+            bFormat[3][j] += sample * z;
+        }
+        ++numEncoded;
+    }
+
+    return numEncoded;
+}
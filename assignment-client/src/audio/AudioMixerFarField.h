@@ -0,0 +1,85 @@
+//
+//  AudioMixerFarField.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerFarField_h
+#define hifi_AudioMixerFarField_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+
+class Node;
+class PositionalAudioStream;
+
+// Far-field streams, downmixed to mono per spatial cell once per mix frame, and shared (read-only) by every slave
+//   A listener encodes each cell that is entirely beyond the far-field radius into a first-order ambisonic bed,
+//   from the direction of the cell's centroid, and decodes the bed with a single AudioFOA render.
+//   This makes the cost of distant streams proportional to the number of cells, rather than of streams.
+class AudioMixerFarField {
+public:
+    static const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    // returns true if the stream may be mixed through the far field
+    //   streams subject to per-listener treatment (ignores, zone attenuation, injector echo) are always mixed directly
+    static bool isEligible(const Node& node, const PositionalAudioStream& stream);
+
+    // clear the far field for the coming frame
+    void reset(float cellSize, float radius);
+
+    // add the last popped frame of an eligible stream
+    void insert(const PositionalAudioStream& stream);
+
+    // compute the centroids; must be called after the last insert and before any encode
+    void finalize();
+
+    // returns true if the cell of a stream at position is beyond the far-field radius of the listener
+    bool isFar(const glm::vec3& listenerPosition, const glm::vec3& streamPosition) const {
+        return isFar(listenerPosition, cellCoordinates(streamPosition));
+    }
+
+    // accumulate the cells that are far from the listener (and within maxDistance, if set) into bFormat
+    //   bFormat is deinterleaved W, X, Y, Z (SN3D, in world axes), each of NUM_FRAMES samples
+    //   returns the number of encoded cells
+    int encode(const glm::vec3& listenerPosition, float maxDistance, float attenuationPerDoublingInDistance,
+            float* bFormat[4]) const;
+
+    float getRadius() const { return _radius; }
+
+private:
+    struct Cell {
+        glm::ivec3 coordinates;
+        glm::vec3 positionSum;
+        glm::vec3 centroid;
+        int numStreams { 0 };
+        float samples[NUM_FRAMES];
+    };
+
+    glm::ivec3 cellCoordinates(const glm::vec3& position) const {
+        return glm::ivec3(glm::floor(position * _inverseCellSize));
+    }
+    float distanceToCell(const glm::vec3& position, const glm::ivec3& cell) const;
+    bool isFar(const glm::vec3& listenerPosition, const glm::ivec3& cell) const {
+        return distanceToCell(listenerPosition, cell) > _radius;
+    }
+
+    std::vector<Cell> _cells; // reused across frames, only the first _numCells are valid
+    int _numCells { 0 };
+    std::unordered_map<uint64_t, int> _cellIndices;
+    float _cellSize { 1.0f };
+    float _inverseCellSize { 1.0f };
+    float _radius { 0.0f };
+};
+
+#endif // hifi_AudioMixerFarField_h
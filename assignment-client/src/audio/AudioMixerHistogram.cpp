@@ -0,0 +1,84 @@
+//
+//  AudioMixerHistogram.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AudioMixerHistogram.h"
+
+void AudioMixerHistogram::reset() {
+    memset(_counts, 0, sizeof(_counts));
+    _count = 0;
+}
+
+void AudioMixerHistogram::accumulate(const AudioMixerHistogram& otherHistogram) {
+    if (otherHistogram._count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        _counts[i] += otherHistogram._counts[i];
+    }
+    _count += otherHistogram._count;
+}
+
+uint64_t AudioMixerHistogram::getPercentile(float percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    // the rank of the sample at the percentile, in [1, _count]
+    uint64_t rank = (uint64_t)std::ceil((double)percentile * (double)_count);
+    rank = std::max<uint64_t>(1, std::min(rank, _count));
+
+    uint64_t sum = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        sum += _counts[i];
+        if (sum >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+
+    return bucketUpperBound(NUM_BUCKETS - 1);
+}
+
+int AudioMixerHistogram::bucketIndex(uint64_t value) {
+    // small values are counted exactly
+    if (value < (uint64_t)SUB_BUCKETS) {
+        return (int)value;
+    }
+
+    // find the most significant bit
+    int msb = 0;
+    for (int step = 32; step > 0; step >>= 1) {
+        if (value >> (msb + step)) {
+            msb += step;
+        }
+    }
+
+    // the bits below the msb select the linear sub-bucket
+    int shift = msb - SUB_BUCKET_BITS;
+    int subBucket = (int)(value >> shift) & (SUB_BUCKETS - 1);
+    int index = (shift + 1) * SUB_BUCKETS + subBucket;
+
+    return std::min(index, NUM_BUCKETS - 1);
+}
+
+uint64_t AudioMixerHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+
+    int shift = index / SUB_BUCKETS - 1;
+    uint64_t lowerBound = (uint64_t)(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lowerBound + ((uint64_t)1 << shift) - 1;
+}
@@ -0,0 +1,46 @@
+//
+//  AudioMixerHistogram.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerHistogram_h
+#define hifi_AudioMixerHistogram_h
+
+#include <cstdint>
+
+// Fixed-size, log-bucketed histogram of durations (in ns)
+//   Each power of two is split into SUB_BUCKETS linear buckets, so any percentile is within 1/SUB_BUCKETS
+//   of the recorded value. Recording never allocates, and histograms from several slaves merge by addition.
+class AudioMixerHistogram {
+public:
+    void record(uint64_t nanoseconds) { ++_counts[bucketIndex(nanoseconds)]; ++_count; }
+
+    void reset();
+    void accumulate(const AudioMixerHistogram& otherHistogram);
+
+    uint64_t getCount() const { return _count; }
+
+    // returns the (upper bound of the bucket) value below which the given fraction of recorded durations fall,
+    // or 0 if nothing was recorded
+    uint64_t getPercentile(float percentile) const;
+
+private:
+    static const int SUB_BUCKET_BITS = 3;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_VALUE_BITS = 36; // ~68s; anything longer lands in the last bucket
+    static const int NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+    uint32_t _counts[NUM_BUCKETS] {};
+    uint64_t _count { 0 };
+};
+
+#endif // hifi_AudioMixerHistogram_h
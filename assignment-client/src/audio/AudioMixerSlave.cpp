@@ -19,6 +19,7 @@
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
+#include <NumericalConstants.h>
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
@@ -38,12 +39,13 @@
 
 using AudioStreamMap = AudioMixerClientData::AudioStreamMap;
 
+static const int HRTF_DATASET_INDEX = 1;
+static const float silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+
 // packet helpers
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+NLPacket& resetAudioPacket(std::unique_ptr<NLPacket>& packet, PacketType type, int size, quint16 sequence,
+        const QByteArray& codec);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
-void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
@@ -56,15 +58,29 @@ inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
-        data->processPackets();
+        stats.packetsProcessed += data->processPackets(node, stats.packetQueueTime);
+    }
+}
+
+void AudioMixerSlave::prepareFrame(const SharedNodePointer& node) {
+    AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+    if (data) {
+        // pop (and decode) a frame from each stream
+        stats.sumStreams += data->checkBuffersBeforeFrameSend();
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        const AudioMixerSpatialGrid* spatialGrid, float audibleRadius, float clusterNearFieldRadius,
+        const AudioMixerFarField* farField) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _spatialGrid = spatialGrid;
+    _audibleRadius = audibleRadius;
+    _clusterNearFieldRadius = clusterNearFieldRadius;
+    _farField = farField;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -89,22 +105,14 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
+        auto mixStart = p_high_resolution_clock::now();
+
         // mix the audio
         bool mixHasAudio = prepareMix(node);
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
-
-            sendMixPacket(node, *data, encodedBuffer);
+            sendMixPacket(node, *data, mixHasAudio);
         } else {
             ++stats.sumListenersSilent;
             sendSilentPacket(node, *data);
@@ -118,34 +126,65 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
             data->sendAudioStreamStatsPackets(node);
         }
+
+        // remember how expensive this listener was, so the pool can schedule it early next frame
+        auto mixCost = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - mixStart);
+        data->setLastMixCost(mixCost.count());
     }
 }
 
-bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
+void AudioMixerSlave::mixStreams(const SharedNodePointer& listener, MixFilter filter) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
-    // zero out the mix for this listener
-    memset(_mixSamples, 0, sizeof(_mixSamples));
+    // with cluster mixing, streams are split between the shared mix (far from the cluster) and each listener's own mix
+    AudioMixerCluster* cluster = listenerData->getMixCluster();
+    float nearFieldRadiusSquared = _clusterNearFieldRadius * _clusterNearFieldRadius;
+    auto isFiltered = [&](const SharedNodePointer& node, const PositionalAudioStream& nodeStream) {
+        if (filter == MixFilter::All) {
+            return false;
+        }
+
+        // streams subject to per-listener ignores cannot be shared
+        bool isShared = *node != *cluster->representative &&
+            !node->hasIgnoredNodes() && !node->isIgnoreRadiusEnabled() &&
+            glm::distance2(nodeStream.getPosition(), cluster->position) >= nearFieldRadiusSquared;
+        return (filter == MixFilter::Shared) != isShared;
+    };
 
     bool isThrottling = _throttlingRatio > 0.0f;
-    std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
+    _throttledNodes.clear();
+
+    // far streams are heard through the shared far field, unless the listener has personal mix adjustments
+    bool useFarField = _farField && filter != MixFilter::Unshared &&
+        !listener->hasIgnoredNodes() && !listener->isIgnoreRadiusEnabled() && !listenerData->hasPerAvatarGains();
+    auto isInFarField = [&](const SharedNodePointer& node, const PositionalAudioStream& nodeStream) {
+        return useFarField && _farField->isFar(listenerAudioStream->getPosition(), nodeStream.getPosition()) &&
+            AudioMixerFarField::isEligible(*node, nodeStream);
+    };
+
+    // streams beyond the audible radius skip the gain computation and only keep their HRTF state current
+    float audibleRadiusSquared = _audibleRadius * _audibleRadius;
+    auto isCulled = [&](const PositionalAudioStream& nodeStream) {
+        return _spatialGrid &&
+            glm::distance2(nodeStream.getPosition(), listenerAudioStream->getPosition()) > audibleRadiusSquared;
+    };
 
     typedef void (AudioMixerSlave::*MixFunctor)(
             AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
     auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
         auto nodeID = node->getUUID();
-        for (auto& streamPair : nodeData->getAudioStreams()) {
-            auto nodeStream = streamPair.second;
-            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
-        }
+        nodeData->forEachAudioStream([&](const PositionalAudioStream& nodeStream) {
+            if (isFiltered(node, nodeStream)) {
+                return;
+            }
+            auto functor = isInFarField(node, nodeStream) ? &AudioMixerSlave::farFieldStream :
+                isCulled(nodeStream) ? &AudioMixerSlave::cullStream : mixFunctor;
+            (this->*functor)(*listenerData, nodeID, *listenerAudioStream, nodeStream);
+        });
     };
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
-    auto mixStart = p_high_resolution_clock::now();
-#endif
-
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+    auto prepareNode = [&](const SharedNodePointer& node) {
         AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
         if (!nodeData) {
             return;
@@ -153,12 +192,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
         if (*node == *listener) {
             // only mix the echo, if requested
-            for (auto& streamPair : nodeData->getAudioStreams()) {
-                auto nodeStream = streamPair.second;
-                if (nodeStream->shouldLoopbackForNode()) {
-                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *nodeStream);
+            nodeData->forEachAudioStream([&](const PositionalAudioStream& nodeStream) {
+                if (nodeStream.shouldLoopbackForNode() && !isFiltered(node, nodeStream)) {
+                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, nodeStream);
                 }
-            }
+            });
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
             if (!isThrottling) {
                 forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
@@ -166,59 +204,173 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 auto nodeID = node->getUUID();
 
                 // compute the node's max relative volume
-                float nodeVolume;
-                for (auto& streamPair : nodeData->getAudioStreams()) {
-                    auto nodeStream = streamPair.second;
+                float nodeVolume = 0.0f;
+                bool hasDirectStreams = false;
+                nodeData->forEachAudioStream([&](const PositionalAudioStream& nodeStream) {
+                    if (isFiltered(node, nodeStream) || isInFarField(node, nodeStream)) {
+                        return;
+                    }
+                    hasDirectStreams = true;
+                    if (isCulled(nodeStream)) {
+                        return;
+                    }
 
                     // approximate the gain
-                    glm::vec3 relativePosition = nodeStream->getPosition() - listenerAudioStream->getPosition();
-                    float gain = approximateGain(*listenerAudioStream, *nodeStream, relativePosition);
+                    glm::vec3 relativePosition = nodeStream.getPosition() - listenerAudioStream->getPosition();
+                    float gain = approximateGain(*listenerAudioStream, nodeStream, relativePosition);
 
                     // modify by hrtf gain adjustment
-                    auto& hrtf = listenerData->hrtfForStream(nodeID, nodeStream->getStreamIdentifier());
+                    auto& hrtf = listenerData->hrtfForStream(nodeID, nodeStream.getStreamIdentifier());
                     gain *= hrtf.getGainAdjustment();
 
-                    auto streamVolume = nodeStream->getLastPopOutputTrailingLoudness() * gain;
+                    auto streamVolume = nodeStream.getLastPopOutputTrailingLoudness() * gain;
                     nodeVolume = std::max(streamVolume, nodeVolume);
+                });
+
+                if (!hasDirectStreams) {
+                    // the far field is cheap, so it is never throttled
+                    forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+                    return;
                 }
 
                 // max-heapify the nodes by relative volume
-                throttledNodes.push_back(std::make_pair(nodeVolume, node));
-                if (!throttledNodes.empty()) {
-                    std::push_heap(throttledNodes.begin(), throttledNodes.end());
+                _throttledNodes.push_back(std::make_pair(nodeVolume, node));
+                if (!_throttledNodes.empty()) {
+                    std::push_heap(_throttledNodes.begin(), _throttledNodes.end());
                 }
             }
         }
-    });
+    };
+
+    int numNodes;
+    if (_spatialGrid) {
+        // the listener always hears its own echo, regardless of where its streams are
+        prepareNode(listener);
+
+        // only visit nodes with streams near the listener; the rest are inaudible
+        _nearbyNodes.clear();
+        _spatialGrid->query(listenerAudioStream->getPosition(), _audibleRadius, _nearbyNodes);
+        for (int index : _nearbyNodes) {
+            auto& node = *(_begin + index);
+            if (*node != *listener) {
+                prepareNode(node);
+            }
+        }
+
+        numNodes = (int)_nearbyNodes.size();
+    } else {
+        std::for_each(_begin, _end, prepareNode);
+        numNodes = (int)std::distance(_begin, _end);
+    }
 
     if (isThrottling) {
         // pop the loudest nodes off the heap and mix their streams
-        int numToRetain = (int)(std::distance(_begin, _end) * (1 - _throttlingRatio));
+        int numToRetain = (int)(numNodes * (1 - _throttlingRatio));
         for (int i = 0; i < numToRetain; i++) {
-            if (throttledNodes.empty()) {
+            if (_throttledNodes.empty()) {
                 break;
             }
 
-            std::pop_heap(throttledNodes.begin(), throttledNodes.end());
+            std::pop_heap(_throttledNodes.begin(), _throttledNodes.end());
 
-            auto& node = throttledNodes.back().second;
+            auto& node = _throttledNodes.back().second;
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
             forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
 
-            throttledNodes.pop_back();
+            _throttledNodes.pop_back();
+        }
+
+        // pan the next loudest nodes' streams, in the same ratio
+        int numToPan = (int)(((int)_throttledNodes.size()) * (1 - _throttlingRatio));
+        for (int i = 0; i < numToPan; i++) {
+            std::pop_heap(_throttledNodes.begin(), _throttledNodes.end());
+
+            auto& node = _throttledNodes.back().second;
+            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            forAllStreams(node, nodeData, &AudioMixerSlave::panStream);
+
+            _throttledNodes.pop_back();
         }
 
         // throttle the remaining nodes' streams
-        for (const std::pair<float, SharedNodePointer>& nodePair : throttledNodes) {
+        for (const std::pair<float, SharedNodePointer>& nodePair : _throttledNodes) {
             auto& node = nodePair.second;
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
             forAllStreams(node, nodeData, &AudioMixerSlave::throttleStream);
         }
     }
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+    if (useFarField) {
+        mixFarField(*listenerData, *listenerAudioStream);
+    }
+
+    // render any remaining HRTF sources
+    flushHRTFBatch();
+}
+
+void AudioMixerSlave::mixFarField(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream) {
+    memset(_farFieldSamples, 0, sizeof(_farFieldSamples));
+    float* bFormat[4] = { _farFieldSamples[0], _farFieldSamples[1], _farFieldSamples[2], _farFieldSamples[3] };
+
+    // beyond the audible radius, cells are culled like streams
+    int numCells = _farField->encode(listenerStream.getPosition(), _spatialGrid ? _audibleRadius : 0.0f,
+            AudioMixer::getAttenuationPerDoublingInDistance(), bFormat);
+
+    // render one more (silent) block after the last cell, to flush the FOA state
+    if (numCells > 0 || listenerData.wasFarFieldRendered()) {
+        // rotate the (world aligned) bed to the listener, converting from Y-up (OpenGL) to Z-up (Ambisonic)
+        glm::quat relativeOrientation = glm::inverse(listenerStream.getOrientation());
+        float qw = relativeOrientation.w;
+        float qx = -relativeOrientation.z;
+        float qy = -relativeOrientation.x;
+        float qz = relativeOrientation.y;
+
+        listenerData.getFarFieldFOA().render(bFormat, _mixSamples, HRTF_DATASET_INDEX,
+                qw, qx, qy, qz, 1.0f, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        ++stats.farFieldRenders;
+        stats.farFieldCells += numCells;
+    }
+    listenerData.setFarFieldRendered(numCells > 0);
+}
+
+void AudioMixerSlave::mixCluster(const SharedNodePointer& representative) {
+    AudioMixerClientData* data = static_cast<AudioMixerClientData*>(representative->getLinkedData());
+    AudioMixerCluster* cluster = data ? data->getMixCluster() : nullptr;
+    if (!cluster) {
+        return;
+    }
+
+    // mix the shared streams once, with the representative's HRTFs
+    memset(_mixSamples, 0, sizeof(_mixSamples));
+    mixStreams(representative, MixFilter::Shared);
+    memcpy(cluster->mixSamples, _mixSamples, sizeof(_mixSamples));
+
+    ++stats.clusterMixes;
+}
+
+bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
+    AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
+    AudioMixerCluster* cluster = listenerData->getMixCluster();
+
+    auto mixStart = p_high_resolution_clock::now();
+
+    if (cluster) {
+        // start from the cluster's shared mix, and add this listener's own streams
+        memcpy(_mixSamples, cluster->mixSamples, sizeof(_mixSamples));
+        mixStreams(listener, MixFilter::Unshared);
+
+        ++stats.sharedMixes;
+    } else {
+        // zero out the mix for this listener
+        memset(_mixSamples, 0, sizeof(_mixSamples));
+        mixStreams(listener, MixFilter::All);
+    }
+
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
+    stats.hrtfTime.record(mixTime.count());
+#ifdef HIFI_AUDIO_MIXER_DEBUG
     stats.mixTime += mixTime.count();
 #endif
 
@@ -233,24 +385,67 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     }
 
     // use the per listener AudioLimiter to render the mixed data
+    auto limiterStart = p_high_resolution_clock::now();
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    auto limiterTime = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - limiterStart);
+    stats.limiterTime.record(limiterTime.count());
 
     return hasAudio;
 }
 
 void AudioMixerSlave::throttleStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
-    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, true);
+    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, MixTier::Muted);
+}
+
+void AudioMixerSlave::panStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
+        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, MixTier::Panned);
 }
 
 void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
-    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, false);
+    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, MixTier::HRTF);
+}
+
+void AudioMixerSlave::cullStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
+        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+    ++stats.totalMixes;
+
+    // stereo and echo sources do not go through the HRTF, so there is no state to maintain
+    if (streamToAdd.isStereo() || &streamToAdd == &listeningNodeStream) {
+        return;
+    }
+
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float azimuth = computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+
+    // render silent with a silent block and a gain of 0.0f to fade out the tail of the last mixed block
+    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+    queueHRTF(hrtf, silentMonoBlock, azimuth, distance, 0.0f, true);
+
+    ++stats.hrtfCulledRenders;
+}
+
+void AudioMixerSlave::farFieldStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
+        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+    ++stats.totalMixes;
+
+    // the stream is heard through the far field (see mixFarField), so only fade out and maintain its HRTF state
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float azimuth = computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+
+    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+    queueHRTF(hrtf, streamToAdd.getLastPopOutputSamples(), azimuth, distance, 0.0f, true);
+
+    ++stats.farFieldMixes;
 }
 
 void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        bool throttle) {
+        MixTier tier) {
     ++stats.totalMixes;
 
     // to reduce artifacts we call the HRTF functor for every source, even if throttled or silent
@@ -264,7 +459,6 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
-    const int HRTF_DATASET_INDEX = 1;
 
     if (!streamToAdd.lastPopSucceeded()) {
         bool forceSilentBlock = true;
@@ -292,9 +486,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
                 // get the existing listener-source HRTF object, or create a new one
                 auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                queueHRTF(hrtf, silentMonoBlock, azimuth, distance, gain, true);
 
                 ++stats.hrtfSilentRenders;
             }
@@ -303,13 +495,13 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
         }
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+    // grab the stream's frame, decoded once for all listeners (see AudioMixerSlavePool::prepareFrames)
+    const float* streamPopOutput = streamToAdd.getLastPopOutputSamples();
 
     // stereo sources are not passed through HRTF
     if (streamToAdd.isStereo()) {
         for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-            _mixSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+            _mixSamples[i] += streamPopOutput[i] * gain;
         }
 
         ++stats.manualStereoMixes;
@@ -319,7 +511,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     // echo sources are not passed through HRTF
     if (isEcho) {
         for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
-            auto monoSample = float(streamPopOutput[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+            auto monoSample = streamPopOutput[i / 2] * gain;
             _mixSamples[i] += monoSample;
             _mixSamples[i + 1] += monoSample;
         }
@@ -331,66 +523,132 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     // get the existing listener-source HRTF object, or create a new one
     auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
 
-    streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
     if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
         // call renderSilent to reduce artifacts
-        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        queueHRTF(hrtf, streamPopOutput, azimuth, distance, gain, true);
 
         ++stats.hrtfSilentRenders;
         return;
     }
 
-    if (throttle) {
+    if (tier != MixTier::HRTF) {
         // call renderSilent with actual frame data and a gain of 0.0f to reduce artifacts
-        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
-                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        queueHRTF(hrtf, streamPopOutput, azimuth, distance, 0.0f, true);
+
+        if (tier == MixTier::Panned) {
+            // approximate the HRTF with a constant-power pan on the (clockwise) azimuth
+            float theta = (sinf(azimuth) + 1.0f) * (PI / 4.0f);
+            float leftGain = cosf(theta) * gain;
+            float rightGain = sinf(theta) * gain;
+            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
+                auto monoSample = streamPopOutput[i / 2];
+                _mixSamples[i] += monoSample * leftGain;
+                _mixSamples[i + 1] += monoSample * rightGain;
+            }
 
-        ++stats.hrtfThrottleRenders;
+            ++stats.pannedRenders;
+        } else {
+            ++stats.hrtfThrottleRenders;
+        }
         return;
     }
 
-    hrtf.render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    queueHRTF(hrtf, streamPopOutput, azimuth, distance, gain, false);
 
     ++stats.hrtfRenders;
 }
 
-std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
-    auto audioPacket = NLPacket::create(type, size);
-    audioPacket->writePrimitive(sequence);
-    audioPacket->writeString(codec);
-    return audioPacket;
+void AudioMixerSlave::queueHRTF(AudioHRTF& hrtf, const float* input, float azimuth, float distance, float gain, bool silent) {
+    if (_hrtfBatchSize == MAX_HRTF_BATCH) {
+        flushHRTFBatch();
+    }
+    _hrtfBatch[_hrtfBatchSize++] = { &hrtf, input, azimuth, distance, gain, silent };
+}
+
+void AudioMixerSlave::flushHRTFBatch() {
+    if (_hrtfBatchSize > 0) {
+        AudioHRTF::renderBatch(_hrtfBatch, _hrtfBatchSize, _mixSamples, HRTF_DATASET_INDEX,
+                               AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        _hrtfBatchSize = 0;
+    }
+}
+
+NLPacket& resetAudioPacket(std::unique_ptr<NLPacket>& packet, PacketType type, int size, quint16 sequence,
+        const QByteArray& codec) {
+    if (!packet) {
+        packet = NLPacket::create(type, size);
+    } else {
+        // the packet was sent synchronously, so it is free to be rewritten
+        packet->reset();
+    }
+
+    packet->writePrimitive(sequence);
+
+    // same format as BasePacket::writeString, without converting the codec name every time
+    packet->writePrimitive((uint32_t)codec.size());
+    packet->write(codec.constData(), codec.size());
+
+    return *packet;
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+void AudioMixerSlave::sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, bool mixHasAudio) {
     const int MIX_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
     quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
+    auto& mixPacket = resetAudioPacket(_mixPacket, PacketType::MixedAudio, MIX_PACKET_SIZE,
+            sequence, data.getCodecNameUtf8());
+
+    // fit the mix and its packet headers in this mixer's share of what the listener can receive
+    if (node->getBandwidthBudgetKbps() > 0) {
+        int headerBytes = NLPacket::totalHeaderSize(PacketType::MixedAudio) + (int)mixPacket.pos();
+        int headerBitsPerSecond = (int)(headerBytes * BITS_IN_BYTE * AudioConstants::NETWORK_FRAMES_PER_SEC);
+        data.setMaxMixBitrate(node->getBandwidthBudgetKbps() * BYTES_PER_KILOBIT * BITS_IN_BYTE - headerBitsPerSecond);
+    }
 
-    // pack samples
-    mixPacket->write(buffer.constData(), buffer.size());
+    // encode samples straight into the packet
+    char* encodedBuffer = mixPacket.getPayload() + mixPacket.pos();
+    int maxEncodedSize = (int)mixPacket.bytesAvailableForWrite();
+    int encodedSize;
+    auto encodeStart = p_high_resolution_clock::now();
+    if (mixHasAudio) {
+        encodedSize = data.encode(_bufferSamples, encodedBuffer, maxEncodedSize);
+    } else {
+        // time to flush (resets shouldFlush until the next encode)
+        encodedSize = data.encodeFrameOfZeros(encodedBuffer, maxEncodedSize);
+    }
+    auto encodeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - encodeStart);
+    stats.encodeTime.record(encodeTime.count());
+
+    if (encodedSize < 0) {
+        qDebug() << "Encoded mix for" << node->getUUID() << "exceeds the packet size - not sending";
+        return;
+    }
+    if (data.isEncoderDiscontinuous()) {
+        sendSilentPacket(node, data);
+        return;
+    }
+    mixPacket.setPayloadSize(mixPacket.pos() + encodedSize);
 
     // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    auto sendStart = p_high_resolution_clock::now();
+    DependencyManager::get<NodeList>()->sendUnreliablePacket(mixPacket, *node);
+    auto sendTime = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - sendStart);
+    stats.sendTime.record(sendTime.count());
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+void AudioMixerSlave::sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     const int SILENT_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
     quint16 sequence = data.getOutgoingSequenceNumber();
-    QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::SilentAudioFrame, SILENT_PACKET_SIZE, sequence, codec);
+    auto& mixPacket = resetAudioPacket(_silentPacket, PacketType::SilentAudioFrame, SILENT_PACKET_SIZE,
+            sequence, data.getCodecNameUtf8());
 
     // pack number of samples
-    mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    mixPacket.writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
     // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    DependencyManager::get<NodeList>()->sendUnreliablePacket(mixPacket, *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
@@ -402,7 +660,7 @@ void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     data.setShouldMuteClient(false);
 }
 
-void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+void AudioMixerSlave::sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     bool hasReverb = false;
     float reverbTime, wetLevel;
 
@@ -440,26 +698,27 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     bool sendData = dataChanged || (randFloat() < CHANCE_OF_SEND);
 
     if (sendData) {
-        // size the packet
+        // size the packet for the largest environment, so that it can be reused
         unsigned char bitset = 0;
-        int packetSize = sizeof(bitset);
-        if (hasReverb) {
-            packetSize += sizeof(reverbTime) + sizeof(wetLevel);
-        }
+        const int MAX_ENVIRONMENT_PACKET_SIZE = sizeof(bitset) + sizeof(reverbTime) + sizeof(wetLevel);
 
         // write the packet
-        auto envPacket = NLPacket::create(PacketType::AudioEnvironment, packetSize);
+        if (!_environmentPacket) {
+            _environmentPacket = NLPacket::create(PacketType::AudioEnvironment, MAX_ENVIRONMENT_PACKET_SIZE);
+        } else {
+            _environmentPacket->reset();
+        }
         if (hasReverb) {
             setAtBit(bitset, HAS_REVERB_BIT);
         }
-        envPacket->writePrimitive(bitset);
+        _environmentPacket->writePrimitive(bitset);
         if (hasReverb) {
-            envPacket->writePrimitive(reverbTime);
-            envPacket->writePrimitive(wetLevel);
+            _environmentPacket->writePrimitive(reverbTime);
+            _environmentPacket->writePrimitive(wetLevel);
         }
 
         // send the packet
-        DependencyManager::get<NodeList>()->sendPacket(std::move(envPacket), *node);
+        DependencyManager::get<NodeList>()->sendUnreliablePacket(*_environmentPacket, *node);
     }
 }
 
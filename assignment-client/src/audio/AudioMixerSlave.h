@@ -19,13 +19,24 @@
 #include <UUIDHasher.h>
 #include <NodeList.h>
 
+#include "AudioMixerFarField.h"
 #include "AudioMixerStats.h"
+#include "AudioMixerSpatialGrid.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
 class AudioHRTF;
 class AudioMixerClientData;
 
+// Listeners at nearly the same position and orientation share the mix of their far-field streams
+struct AudioMixerCluster {
+    SharedNodePointer representative; // its HRTFs render the shared mix
+    glm::vec3 position;
+    glm::quat orientation;
+    int numListeners { 0 };
+    float mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+};
+
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
@@ -33,8 +44,21 @@ public:
     // process packets for a given node (requires no configuration)
     void processPackets(const SharedNodePointer& node);
 
+    // pop and decode a frame from each stream of a given node (requires no configuration)
+    //   the decoded frames are shared, read-only, by every listener's mix
+    void prepareFrame(const SharedNodePointer& node);
+
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    //   if spatialGrid is set, only streams within the audibleRadius of each listener are mixed
+    //   if clusterNearFieldRadius is set, streams beyond it may be shared by a cluster of listeners
+    //   if farField is set, eligible streams in its far cells are mixed through an ambisonic bed
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            const AudioMixerSpatialGrid* spatialGrid = nullptr, float audibleRadius = 0.0f,
+            float clusterNearFieldRadius = 0.0f, const AudioMixerFarField* farField = nullptr);
+
+    // mix the shared streams of the cluster represented by the node (requires configuration using configureMix, above)
+    // must be called for every cluster before mixing any listener in it
+    void mixCluster(const SharedNodePointer& representative);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -43,25 +67,74 @@ public:
     AudioMixerStats stats;
 
 private:
+    enum class MixFilter {
+        All,        // every stream
+        Shared,     // streams shared by the listener's cluster
+        Unshared    // streams not shared by the listener's cluster
+    };
+
+    // quality at which a stream is mixed, from most to least expensive (see throttling, in mixStreams)
+    enum class MixTier {
+        HRTF,       // full HRTF
+        Panned,     // stereo panning, keeping the HRTF state current
+        Muted       // silent, keeping the HRTF state current
+    };
+
     // create mix, returns true if mix has audio
     bool prepareMix(const SharedNodePointer& listener);
+    // accumulate the listener's streams that pass the filter into the mix
+    void mixStreams(const SharedNodePointer& listener, MixFilter filter);
     void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    void panStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
+            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    void cullStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
+            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    void farFieldStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
+            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    // encode the far field for the listener, and render it into the mix
+    void mixFarField(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream);
     void addStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
-            bool throttle);
+            MixTier tier);
+
+    // packets are written into the slave's reusable packets, so sending does not allocate
+    void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, bool mixHasAudio);
+    void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+    void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+
+    // batched HRTF rendering, flushed when full and at the end of each mix
+    void queueHRTF(AudioHRTF& hrtf, const float* input, float azimuth, float distance, float gain, bool silent);
+    void flushHRTFBatch();
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _farFieldSamples[4][AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    // outbound packets
+    std::unique_ptr<NLPacket> _mixPacket;
+    std::unique_ptr<NLPacket> _silentPacket;
+    std::unique_ptr<NLPacket> _environmentPacket;
+
+    // HRTF batch
+    static const int MAX_HRTF_BATCH = 16;
+    AudioHRTF::Source _hrtfBatch[MAX_HRTF_BATCH];
+    int _hrtfBatchSize { 0 };
 
     // frame state
     ConstIter _begin;
     ConstIter _end;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    const AudioMixerSpatialGrid* _spatialGrid { nullptr };
+    float _audibleRadius { 0.0f };
+    float _clusterNearFieldRadius { 0.0f };
+    const AudioMixerFarField* _farField { nullptr };
+    std::vector<int> _nearbyNodes;
+    std::vector<std::pair<float, SharedNodePointer>> _throttledNodes; // reused across listeners
 };
 
 #endif // hifi_AudioMixerSlave_h
@@ -12,6 +12,11 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <glm/gtx/norm.hpp>
+
+#include "AudioMixer.h"
+#include "AudioMixerClientData.h"
+
 #include "AudioMixerSlavePool.h"
 
 void AudioMixerSlaveThread::run() {
@@ -61,7 +66,56 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    if (_queue.pop(node)) {
+        return true;
+    }
+
+    // out of work - steal from the other slaves, starting with the next one
+    int numSlaves = (int)_pool._slaves.size();
+    for (int i = 1; i < numSlaves; ++i) {
+        auto& slave = _pool._slaves[(_index + i) % numSlaves];
+        if (slave->_queue.steal(node)) {
+            ++stats.slaveSteals;
+            return true;
+        }
+    }
+
+    _finishTime = p_high_resolution_clock::now();
+    return false;
+}
+
+bool AudioMixerSlaveQueue::pop(SharedNodePointer& node) {
+    uint64_t bounds = _bounds.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t front = (uint32_t)(bounds >> 32);
+        uint32_t back = (uint32_t)bounds;
+        if (front >= back) {
+            return false;
+        }
+
+        // on failure, bounds is updated to the current value, so retry
+        if (_bounds.compare_exchange_weak(bounds, pack(front + 1, back), std::memory_order_acq_rel)) {
+            node = _nodes[front];
+            return true;
+        }
+    }
+}
+
+bool AudioMixerSlaveQueue::steal(SharedNodePointer& node) {
+    uint64_t bounds = _bounds.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t front = (uint32_t)(bounds >> 32);
+        uint32_t back = (uint32_t)bounds;
+        if (front >= back) {
+            return false;
+        }
+
+        // on failure, bounds is updated to the current value, so retry
+        if (_bounds.compare_exchange_weak(bounds, pack(front, back - 1), std::memory_order_acq_rel)) {
+            node = _nodes[back - 1];
+            return true;
+        }
+    }
 }
 
 #ifdef AUDIO_SINGLE_THREADED
@@ -71,34 +125,67 @@ static AudioMixerSlave slave;
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
+    _begin = begin;
+    _end = end;
+    run(begin, end);
+}
+
+void AudioMixerSlavePool::prepareFrames(ConstIter begin, ConstIter end) {
+    _function = &AudioMixerSlave::prepareFrame;
+    _configure = [](AudioMixerSlave& slave) {};
+    _begin = begin;
+    _end = end;
     run(begin, end);
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
-    _function = &AudioMixerSlave::mix;
     _configure = [&](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, _frame, _throttlingRatio);
+        slave.configureMix(_begin, _end, _frame, _throttlingRatio,
+                _audibleRadius > 0.0f ? &_spatialGrid : nullptr, _audibleRadius, _clusterNearFieldRadius,
+                _farFieldRadius > 0.0f ? &_farField : nullptr);
     };
+    _begin = begin;
+    _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _audibleRadius = AudioMixer::getAudibleRadius();
 
-    run(begin, end);
-}
+    if (_audibleRadius > 0.0f) {
+        buildSpatialGrid(begin, end, _audibleRadius);
+    }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
-    _begin = begin;
-    _end = end;
+    _farFieldRadius = AudioMixer::getFarFieldRadius();
+    if (_farFieldRadius > 0.0f) {
+        buildFarField(begin, end, AudioMixer::getFarFieldCellSize(), _farFieldRadius);
+    }
+
+    const auto& clusterSettings = AudioMixer::getClusterSettings();
+    _clusterNearFieldRadius = clusterSettings.enabled ? clusterSettings.nearFieldRadius : 0.0f;
+    _representatives.clear();
+    if (clusterSettings.enabled) {
+        buildClusters(begin, end, clusterSettings.positionTolerance, clusterSettings.orientationTolerance);
+    }
+
+    // mix the shared far field of each cluster before any of its listeners
+    if (!_representatives.empty()) {
+        _function = &AudioMixerSlave::mixCluster;
+        run(_representatives.cbegin(), _representatives.cend());
+    }
 
+    // listener costs vary widely, so schedule the most expensive first
+    _function = &AudioMixerSlave::mix;
+    run(begin, end, true);
+}
+
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, bool sortByCost) {
 #ifdef AUDIO_SINGLE_THREADED
     _configure(slave);
     std::for_each(begin, end, [&](const SharedNodePointer& node) {
         _function(slave, node);
     });
 #else
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.emplace(node);
-    });
+    // fill the queues
+    fillQueues(begin, end, sortByCost);
 
     {
         Lock lock(_mutex);
@@ -116,10 +203,176 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    accumulateIdleTime();
 #endif
 }
 
+void AudioMixerSlavePool::fillQueues(ConstIter begin, ConstIter end, bool sortByCost) {
+    for (auto& slave : _slaves) {
+        slave->_queue.clear();
+    }
+
+    int numSlaves = (int)_slaves.size();
+    int index = 0;
+
+    if (sortByCost) {
+        _costs.clear();
+        std::for_each(begin, end, [&](const SharedNodePointer& node) {
+            AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            _costs.emplace_back(data ? data->getLastMixCost() : 0, &node);
+        });
+
+        std::sort(_costs.begin(), _costs.end(),
+            [](const std::pair<uint64_t, const SharedNodePointer*>& a, const std::pair<uint64_t, const SharedNodePointer*>& b) {
+                return a.first > b.first;
+            });
+
+        // deal round-robin, so each queue starts with its most expensive node
+        for (auto& cost : _costs) {
+            _slaves[index++ % numSlaves]->_queue.push(*cost.second);
+        }
+    } else {
+        std::for_each(begin, end, [&](const SharedNodePointer& node) {
+            _slaves[index++ % numSlaves]->_queue.push(node);
+        });
+    }
+
+    for (auto& slave : _slaves) {
+        slave->_queue.seal();
+    }
+}
+
+void AudioMixerSlavePool::accumulateIdleTime() {
+    auto lastFinishTime = p_high_resolution_clock::time_point::min();
+    for (auto& slave : _slaves) {
+        lastFinishTime = std::max(lastFinishTime, slave->_finishTime);
+    }
+
+    for (auto& slave : _slaves) {
+        auto idleTime = std::chrono::duration_cast<std::chrono::microseconds>(lastFinishTime - slave->_finishTime);
+        slave->stats.slaveIdleTime += idleTime.count();
+    }
+}
+
+void AudioMixerSlavePool::buildSpatialGrid(ConstIter begin, ConstIter end, float audibleRadius) {
+    // cells the size of the radius bound a query to the 27 cells around the listener
+    _spatialGrid.reset(audibleRadius);
+
+    int index = 0;
+    for (auto it = begin; it != end; ++it, ++index) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>((*it)->getLinkedData());
+        if (!data) {
+            continue;
+        }
+
+        data->forEachAudioStream([&](const PositionalAudioStream& stream) {
+            _spatialGrid.insert(stream.getPosition(), index);
+        });
+    }
+
+    _spatialGrid.finalize();
+}
+
+void AudioMixerSlavePool::buildFarField(ConstIter begin, ConstIter end, float cellSize, float radius) {
+    _farField.reset(cellSize, radius);
+
+    for (auto it = begin; it != end; ++it) {
+        const Node& node = **it;
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node.getLinkedData());
+        if (!data) {
+            continue;
+        }
+
+        data->forEachAudioStream([&](const PositionalAudioStream& stream) {
+            if (AudioMixerFarField::isEligible(node, stream)) {
+                _farField.insert(stream);
+            }
+        });
+    }
+
+    _farField.finalize();
+}
+
+static bool isClusterable(const SharedNodePointer& node, AudioMixerClientData& data) {
+    // listeners with personal mix adjustments cannot share a mix
+    return node->getType() == NodeType::Agent && node->getActiveSocket() && data.getAvatarAudioStream() &&
+        !node->hasIgnoredNodes() && !node->isIgnoreRadiusEnabled() && !data.hasPerAvatarGains();
+}
+
+void AudioMixerSlavePool::buildClusters(ConstIter begin, ConstIter end,
+        float positionTolerance, float orientationTolerance) {
+    _numClusters = 0;
+    _clusterCells.clear();
+
+    // orientations are within tolerance when the angle between them, 2 * acos(|dot|), is
+    const float positionToleranceSquared = positionTolerance * positionTolerance;
+    const float minOrientationDot = cosf(glm::radians(orientationTolerance) / 2.0f);
+
+    auto addListener = [&](const SharedNodePointer& node, AudioMixerClientData& data) {
+        auto stream = data.getAvatarAudioStream();
+        const glm::vec3& position = stream->getPosition();
+        const glm::quat& orientation = stream->getOrientation();
+
+        // only clusters in the same cell are candidates, which may split some clusters but never oversizes one
+        auto key = AudioMixerSpatialGrid::cellKey(glm::ivec3(glm::floor(position / positionTolerance)));
+        auto& cell = _clusterCells[key];
+        for (int index : cell) {
+            auto& cluster = *_clusters[index];
+            if (glm::distance2(cluster.position, position) <= positionToleranceSquared &&
+                    fabsf(glm::dot(cluster.orientation, orientation)) >= minOrientationDot) {
+                ++cluster.numListeners;
+                data.setMixCluster(&cluster);
+                return;
+            }
+        }
+
+        // start a new cluster, represented by this listener
+        if (_numClusters == (int)_clusters.size()) {
+            _clusters.emplace_back(new AudioMixerCluster);
+        }
+        auto& cluster = *_clusters[_numClusters];
+        cluster.representative = node;
+        cluster.position = position;
+        cluster.orientation = orientation;
+        cluster.numListeners = 1;
+        data.setMixCluster(&cluster);
+        cell.push_back(_numClusters++);
+    };
+
+    // seed with last frame's representatives, so that clusters (and their HRTF state) are stable across frames
+    for (auto it = begin; it != end; ++it) {
+        auto data = static_cast<AudioMixerClientData*>((*it)->getLinkedData());
+        if (!data) {
+            continue;
+        }
+
+        data->setMixCluster(nullptr);
+        if (data->wasClusterRepresentative() && isClusterable(*it, *data)) {
+            addListener(*it, *data);
+        }
+        data->setWasClusterRepresentative(false);
+    }
+
+    for (auto it = begin; it != end; ++it) {
+        auto data = static_cast<AudioMixerClientData*>((*it)->getLinkedData());
+        if (data && !data->getMixCluster() && isClusterable(*it, *data)) {
+            addListener(*it, *data);
+        }
+    }
+
+    // a cluster of one gains nothing from a shared mix
+    for (int i = 0; i < _numClusters; ++i) {
+        auto& cluster = *_clusters[i];
+        auto data = static_cast<AudioMixerClientData*>(cluster.representative->getLinkedData());
+        if (cluster.numListeners > 1) {
+            data->setWasClusterRepresentative(true);
+            _representatives.push_back(cluster.representative);
+        } else {
+            data->setMixCluster(nullptr);
+        }
+    }
+}
+
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
 #ifdef AUDIO_SINGLE_THREADED
     functor(slave);
@@ -163,7 +416,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this);
+            auto slave = new AudioMixerSlaveThread(*this, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -12,18 +12,41 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
-#include <tbb/concurrent_queue.h>
-
 #include <QThread>
 
+#include <PortableHighResolutionClock.h>
+
 #include "AudioMixerSlave.h"
+#include "AudioMixerSpatialGrid.h"
 
 class AudioMixerSlavePool;
 
+// Work queue of a single slave, filled by the pool before each run
+//   The owning slave pops from the front, and idle slaves steal from the back.
+//   Both ends are packed into a single atomic, so neither requires a lock.
+class AudioMixerSlaveQueue {
+public:
+    // not thread-safe; only call from the pool, while the slaves are waiting
+    void clear() { _nodes.clear(); _bounds = 0; }
+    void push(const SharedNodePointer& node) { _nodes.push_back(node); }
+    void seal() { _bounds = pack(0, (uint32_t)_nodes.size()); }
+
+    bool pop(SharedNodePointer& node);
+    bool steal(SharedNodePointer& node);
+
+private:
+    static uint64_t pack(uint32_t front, uint32_t back) { return ((uint64_t)front << 32) | back; }
+
+    std::vector<SharedNodePointer> _nodes;
+    std::atomic<uint64_t> _bounds { 0 };
+};
+
 class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     Q_OBJECT
     using ConstIter = NodeList::const_iterator;
@@ -31,7 +54,7 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool) : _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, int index) : _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -43,6 +66,9 @@ private:
     bool try_pop(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
+    AudioMixerSlaveQueue _queue;
+    int _index;
+    p_high_resolution_clock::time_point _finishTime;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
 };
@@ -50,7 +76,6 @@ private:
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -64,6 +89,9 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
+    // pop and decode frames on slave threads
+    void prepareFrames(ConstIter begin, ConstIter end);
+
     // mix on slave threads
     void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
 
@@ -74,9 +102,22 @@ public:
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, bool sortByCost = false);
     void resize(int numThreads);
 
+    // distribute the nodes across the slave queues
+    //   if sortByCost, the most expensive nodes (by last mix) are dealt first, to balance the queues
+    void fillQueues(ConstIter begin, ConstIter end, bool sortByCost);
+    // accumulate the time each slave spent waiting on the slowest slave
+    void accumulateIdleTime();
+
+    // index the positions of all streams in the frame, for culling by audible radius
+    void buildSpatialGrid(ConstIter begin, ConstIter end, float audibleRadius);
+    // downmix far-field streams per cell, to be shared by every listener
+    void buildFarField(ConstIter begin, ConstIter end, float cellSize, float radius);
+    // group co-located listeners to share their far-field mix
+    void buildClusters(ConstIter begin, ConstIter end, float positionTolerance, float orientationTolerance);
+
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
@@ -95,9 +136,18 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    std::vector<std::pair<uint64_t, const SharedNodePointer*>> _costs;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    float _audibleRadius { 0.0f };
+    AudioMixerSpatialGrid _spatialGrid;
+    AudioMixerFarField _farField;
+    float _farFieldRadius { 0.0f };
+    float _clusterNearFieldRadius { 0.0f };
+    std::vector<std::unique_ptr<AudioMixerCluster>> _clusters; // reused across frames
+    int _numClusters { 0 };
+    std::unordered_map<uint64_t, std::vector<int>> _clusterCells;
+    std::vector<SharedNodePointer> _representatives;
     ConstIter _begin;
     ConstIter _end;
 };
@@ -0,0 +1,80 @@
+//
+//  AudioMixerSpatialGrid.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <assert.h>
+#include <algorithm>
+
+#include "AudioMixerSpatialGrid.h"
+
+// cells are packed into 21 bits per axis
+static const int CELL_BITS = 21;
+static const int CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int CELL_MIN = -CELL_OFFSET;
+static const int CELL_MAX = CELL_OFFSET - 1;
+
+// queries spanning more cells than this fall back to returning everything
+static const int MAX_QUERY_CELLS = 512;
+
+void AudioMixerSpatialGrid::reset(float cellSize) {
+    assert(cellSize > 0.0f);
+    _inverseCellSize = 1.0f / cellSize;
+    _entries.clear();
+}
+
+void AudioMixerSpatialGrid::finalize() {
+    std::sort(_entries.begin(), _entries.end());
+}
+
+glm::ivec3 AudioMixerSpatialGrid::cellCoordinates(const glm::vec3& position) const {
+    glm::vec3 cell = glm::floor(position * _inverseCellSize);
+    cell = glm::clamp(cell, glm::vec3((float)CELL_MIN), glm::vec3((float)CELL_MAX));
+    return glm::ivec3(cell);
+}
+
+AudioMixerSpatialGrid::Key AudioMixerSpatialGrid::cellKey(const glm::ivec3& cell) {
+    const Key MASK = (1 << CELL_BITS) - 1;
+    return (((Key)(cell.x + CELL_OFFSET) & MASK) << (2 * CELL_BITS)) |
+        (((Key)(cell.y + CELL_OFFSET) & MASK) << CELL_BITS) |
+        ((Key)(cell.z + CELL_OFFSET) & MASK);
+}
+
+void AudioMixerSpatialGrid::query(const glm::vec3& center, float radius, std::vector<int>& indices) const {
+    auto begin = indices.size();
+
+    glm::ivec3 minCell = cellCoordinates(center - glm::vec3(radius));
+    glm::ivec3 maxCell = cellCoordinates(center + glm::vec3(radius));
+    glm::ivec3 span = maxCell - minCell + glm::ivec3(1);
+
+    if ((int64_t)span.x * span.y * span.z > MAX_QUERY_CELLS) {
+        // the sphere covers too many cells to search individually
+        for (auto& entry : _entries) {
+            indices.push_back(entry.index);
+        }
+    } else {
+        for (int x = minCell.x; x <= maxCell.x; ++x) {
+            for (int y = minCell.y; y <= maxCell.y; ++y) {
+                // cells are contiguous along z, so search for the whole row at once
+                Entry first { cellKey(glm::ivec3(x, y, minCell.z)), 0 };
+                Entry last { cellKey(glm::ivec3(x, y, maxCell.z)), 0 };
+
+                auto it = std::lower_bound(_entries.cbegin(), _entries.cend(), first);
+                while (it != _entries.cend() && it->key <= last.key) {
+                    indices.push_back(it->index);
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // a node with several streams may appear more than once
+    std::sort(indices.begin() + begin, indices.end());
+    indices.erase(std::unique(indices.begin() + begin, indices.end()), indices.end());
+}
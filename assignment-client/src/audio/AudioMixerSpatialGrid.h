@@ -0,0 +1,57 @@
+//
+//  AudioMixerSpatialGrid.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSpatialGrid_h
+#define hifi_AudioMixerSpatialGrid_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Uniform grid of streamer positions, rebuilt once per mix frame and queried (read-only) by every slave
+//   Entries are stored sorted by cell so that building the grid does not allocate after the first few frames,
+//   and a query is a handful of binary searches over a contiguous array.
+class AudioMixerSpatialGrid {
+public:
+    // clear the grid and set the cell size for the coming frame
+    void reset(float cellSize);
+
+    // add a stream position for the node at index (within the frame's node range)
+    void insert(const glm::vec3& position, int index) { _entries.push_back({ cellKey(position), index }); }
+
+    // sort the inserted entries; must be called after the last insert and before any query
+    void finalize();
+
+    // append the (unique, ascending) indices of all nodes with a stream in a cell touched by the sphere
+    // results are conservative: callers must still check the distance of each stream
+    void query(const glm::vec3& center, float radius, std::vector<int>& indices) const;
+
+    bool isEmpty() const { return _entries.empty(); }
+
+    using Key = uint64_t;
+    static Key cellKey(const glm::ivec3& cell);
+
+private:
+    struct Entry {
+        Key key;
+        int index;
+        bool operator<(const Entry& other) const { return key < other.key; }
+    };
+
+    glm::ivec3 cellCoordinates(const glm::vec3& position) const;
+    Key cellKey(const glm::vec3& position) const { return cellKey(cellCoordinates(position)); }
+
+    std::vector<Entry> _entries;
+    float _inverseCellSize { 1.0f };
+};
+
+#endif // hifi_AudioMixerSpatialGrid_h
@@ -19,8 +19,23 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfSilentRenders = 0;
     hrtfThrottleRenders = 0;
+    pannedRenders = 0;
+    farFieldMixes = 0;
+    farFieldRenders = 0;
+    farFieldCells = 0;
+    hrtfCulledRenders = 0;
     manualStereoMixes = 0;
     manualEchoMixes = 0;
+    clusterMixes = 0;
+    sharedMixes = 0;
+    packetsProcessed = 0;
+    packetQueueTime = 0;
+    slaveSteals = 0;
+    slaveIdleTime = 0;
+    hrtfTime.reset();
+    limiterTime.reset();
+    encodeTime.reset();
+    sendTime.reset();
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -34,8 +49,23 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfSilentRenders += otherStats.hrtfSilentRenders;
     hrtfThrottleRenders += otherStats.hrtfThrottleRenders;
+    pannedRenders += otherStats.pannedRenders;
+    farFieldMixes += otherStats.farFieldMixes;
+    farFieldRenders += otherStats.farFieldRenders;
+    farFieldCells += otherStats.farFieldCells;
+    hrtfCulledRenders += otherStats.hrtfCulledRenders;
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
+    clusterMixes += otherStats.clusterMixes;
+    sharedMixes += otherStats.sharedMixes;
+    packetsProcessed += otherStats.packetsProcessed;
+    packetQueueTime += otherStats.packetQueueTime;
+    slaveSteals += otherStats.slaveSteals;
+    slaveIdleTime += otherStats.slaveIdleTime;
+    hrtfTime.accumulate(otherStats.hrtfTime);
+    limiterTime.accumulate(otherStats.limiterTime);
+    encodeTime.accumulate(otherStats.encodeTime);
+    sendTime.accumulate(otherStats.sendTime);
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
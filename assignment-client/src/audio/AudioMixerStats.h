@@ -12,9 +12,9 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
+
+#include "AudioMixerHistogram.h"
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -26,10 +26,30 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfSilentRenders { 0 };
     int hrtfThrottleRenders { 0 };
+    int pannedRenders { 0 };
+    int farFieldMixes { 0 };
+    int farFieldRenders { 0 };
+    int farFieldCells { 0 };
+    int hrtfCulledRenders { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int clusterMixes { 0 };
+    int sharedMixes { 0 };
+
+    int packetsProcessed { 0 };
+    uint64_t packetQueueTime { 0 }; // us from the socket read to the slave, summed over packetsProcessed
+
+    int slaveSteals { 0 };
+    uint64_t slaveIdleTime { 0 }; // us spent waiting on other slaves to finish
+
+    // per listener stage durations
+    AudioMixerHistogram hrtfTime;
+    AudioMixerHistogram limiterTime;
+    AudioMixerHistogram encodeTime;
+    AudioMixerHistogram sendTime;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
@@ -14,6 +14,7 @@
 #include <memory>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
@@ -25,8 +26,10 @@
 #include <AABox.h>
 #include <AvatarLogging.h>
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
+#include <Profile.h>
 #include <SharedUtil.h>
 #include <UUID.h>
 #include <TryLocker.h>
@@ -45,7 +48,9 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::nodeKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData, this, "queueIncomingPacket");
+    // avatar data is only queued for the slaves, so that can happen right on the NodeList thread
+    packetReceiver.registerDirectListener(PacketType::AvatarData, this, "queueIncomingPacket");
+    packetReceiver.registerDirectListener(PacketType::HostedAvatarData, this, "queueIncomingPacket");
     packetReceiver.registerListener(PacketType::AdjustAvatarSorting, this, "handleAdjustAvatarSorting");
     packetReceiver.registerListener(PacketType::ViewFrustum, this, "handleViewFrustumPacket");
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "handleAvatarIdentityPacket");
@@ -60,7 +65,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
 
 void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     auto start = usecTimestampNow();
-    getOrCreateClientData(node)->queuePacket(message, node);
+    getOrCreateClientData(node.data())->queuePacket(message);
     auto end = usecTimestampNow();
     _queueIncomingPacketElapsedTime += (end - start);
 }
@@ -107,6 +112,17 @@ void AvatarMixer::start() {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
+    auto metrics = DependencyManager::get<MetricsRegistry>();
+    const std::vector<double> BROADCAST_SECONDS_BOUNDS = MetricHistogram::exponentialBounds(0.0005, 2.0, 8);
+    auto& framesMetric = metrics->counter("hifi_avatar_mixer_frames_total", "The frames broadcast");
+    auto& broadcastMetric = metrics->histogram("hifi_avatar_mixer_broadcast_seconds",
+        "The time to broadcast the avatar data of a frame", BROADCAST_SECONDS_BOUNDS);
+    auto& nodesMetric = metrics->gauge("hifi_avatar_mixer_nodes", "The nodes the avatar data is broadcast to");
+
+    // a frame this late is a stall, whose trace is dumped
+    const quint64 STALL_FRAME_USECS = 5 * USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
@@ -116,9 +132,11 @@ void AvatarMixer::start() {
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
 
         int lockWait, nodeTransform, functor;
+        auto frameStart = usecTimestampNow();
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            PROFILE_RANGE(app, "AvatarMixer::processIncomingPackets");
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -140,6 +158,7 @@ void AvatarMixer::start() {
                     manageDisplayName(node);
                     ++_sumListeners;
                 });
+                nodesMetric.set((double)std::distance(cbegin, cend));
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _displayNameManagementElapsedTime += (end - start);
@@ -147,23 +166,32 @@ void AvatarMixer::start() {
 
         // this is where we need to put the real work...
         {
+            PROFILE_RANGE(app, "AvatarMixer::broadcastAvatarData");
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio,
+                    _scheduleAvatarUpdates);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
+            broadcastMetric.observe((double)(end - start) / USECS_PER_SECOND);
 
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
+        quint64 frameWork = usecTimestampNow() - frameStart;
+        if (frameWork > STALL_FRAME_USECS) {
+            tracer->reportStall("avatar-mixer", frameWork);
+        }
+
         ++frame;
         ++_numTightLoopFrames;
+        framesMetric.increment();
         _loopRate.increment();
 
         // play nice with qt event-looping
@@ -190,12 +218,18 @@ void AvatarMixer::start() {
 // is guarenteed to not be accessed by other thread
 void AvatarMixer::manageDisplayName(const SharedNodePointer& node) {
     AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
-    if (nodeData && nodeData->getAvatarSessionDisplayNameMustChange()) {
-        AvatarData& avatar = nodeData->getAvatar();
-        const QString& existingBaseDisplayName = nodeData->getBaseDisplayName();
-        if (--_sessionDisplayNames[existingBaseDisplayName].second <= 0) {
-            _sessionDisplayNames.remove(existingBaseDisplayName);
+    if (nodeData) {
+        manageDisplayName(node, nodeData);
+        for (const auto& hostedAvatar : nodeData->getHostedAvatars()) {
+            manageDisplayName(node, hostedAvatar.second.get());
         }
+    }
+}
+
+void AvatarMixer::manageDisplayName(const SharedNodePointer& node, AvatarMixerClientData* nodeData) {
+    if (nodeData->getAvatarSessionDisplayNameMustChange()) {
+        AvatarData& avatar = nodeData->getAvatar();
+        releaseSessionDisplayName(nodeData);
 
         QString baseName = avatar.getDisplayName().trimmed();
         const QRegularExpression curses { "fuck|shit|damn|cock|cunt" }; // POC. We may eventually want something much more elaborate (subscription?).
@@ -215,8 +249,20 @@ void AvatarMixer::manageDisplayName(const SharedNodePointer& node) {
         soFar.second++; // refcount
         nodeData->flagIdentityChange();
         nodeData->setAvatarSessionDisplayNameMustChange(false);
-        sendIdentityPacket(nodeData, node); // Tell node whose name changed about its new session display name.
-        qCDebug(avatars) << "Giving session display name" << sessionDisplayName << "to node with ID" << node->getUUID();
+        if (nodeData == node->getLinkedData()) {
+            // Tell node whose name changed about its new session display name.
+            // (hosted avatars are not, their hosts would take them for the avatar of another node)
+            sendIdentityPacket(nodeData, node);
+        }
+        qCDebug(avatars) << "Giving session display name" << sessionDisplayName << "to avatar with ID" << nodeData->getNodeID();
+    }
+}
+
+void AvatarMixer::releaseSessionDisplayName(AvatarMixerClientData* avatarData) {
+    const QString& baseDisplayName = avatarData->getBaseDisplayName();
+    // No sense guarding against very rare case of a node with no entry, as this will work without the guard and do one less lookup in the common case.
+    if (--_sessionDisplayNames[baseDisplayName].second <= 0) {
+        _sessionDisplayNames.remove(baseDisplayName);
     }
 }
 
@@ -277,11 +323,17 @@ void AvatarMixer::nodeKilled(SharedNodePointer killedNode) {
         {  // decrement sessionDisplayNames table and possibly remove
            QMutexLocker nodeDataLocker(&killedNode->getLinkedData()->getMutex());
            AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(killedNode->getLinkedData());
-           const QString& baseDisplayName = nodeData->getBaseDisplayName();
-           // No sense guarding against very rare case of a node with no entry, as this will work without the guard and do one less lookup in the common case.
-           if (--_sessionDisplayNames[baseDisplayName].second <= 0) {
-               _sessionDisplayNames.remove(baseDisplayName);
-           }
+           releaseSessionDisplayName(nodeData);
+        }
+
+        // the avatars it hosted leave with it
+        auto killedNodeData = dynamic_cast<AvatarMixerClientData*>(killedNode->getLinkedData());
+        std::vector<QUuid> hostedAvatarIDs;
+        for (const auto& hostedAvatar : killedNodeData->getHostedAvatars()) {
+            hostedAvatarIDs.push_back(hostedAvatar.first);
+        }
+        for (const auto& avatarID : hostedAvatarIDs) {
+            killHostedAvatar(killedNode, avatarID);
         }
 
         // this was an avatar we were sending to other people
@@ -339,7 +391,7 @@ void AvatarMixer::handleAdjustAvatarSorting(QSharedPointer<ReceivedMessage> mess
 
 void AvatarMixer::handleViewFrustumPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
-    getOrCreateClientData(senderNode);
+    getOrCreateClientData(senderNode.data());
 
     if (senderNode->getLinkedData()) {
         AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
@@ -355,7 +407,7 @@ void AvatarMixer::handleViewFrustumPacket(QSharedPointer<ReceivedMessage> messag
 void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
 
-    getOrCreateClientData(senderNode);
+    getOrCreateClientData(senderNode.data());
 
     if (senderNode->getLinkedData()) {
         AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
@@ -382,7 +434,7 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
                     // ...For those nodes, reset the lastBroadcastTime to 0
                     // so that the AvatarMixer will send Identity data to us
                     [&](const SharedNodePointer& node) {
-                    nodeData->setLastBroadcastTime(node->getUUID(), 0);
+                    nodeData->resetLastBroadcastTime(node->getUUID());
                 }
                 );
             }
@@ -395,16 +447,22 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
 void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
     auto nodeList = DependencyManager::get<NodeList>();
-    getOrCreateClientData(senderNode);
+    getOrCreateClientData(senderNode.data());
 
     if (senderNode->getLinkedData()) {
         AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
+
+        // parse the identity packet and update the change timestamp if appropriate
+        AvatarData::Identity identity;
+        AvatarData::parseAvatarIdentityPacket(message->getMessage(), identity);
+
+        // an identity sent with an id other than the sender's is that of an avatar it hosts, and announces it
+        if (nodeData && !identity.uuid.isNull() && identity.uuid != senderNode->getUUID()) {
+            nodeData = getOrCreateHostedAvatar(senderNode, identity.uuid);
+        }
         if (nodeData != nullptr) {
             AvatarData& avatar = nodeData->getAvatar();
 
-            // parse the identity packet and update the change timestamp if appropriate
-            AvatarData::Identity identity;
-            AvatarData::parseAvatarIdentityPacket(message->getMessage(), identity);
             bool identityChanged = false;
             bool displayNameChanged = false;
             avatar.processAvatarIdentity(identity, identityChanged, displayNameChanged);
@@ -421,9 +479,15 @@ void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> mes
     _handleAvatarIdentityPacketElapsedTime += (end - start);
 }
 
-void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message) {
+void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
-    DependencyManager::get<NodeList>()->processKillNode(*message);
+    QUuid avatarID = QUuid::fromRfc4122(message->peek(NUM_BYTES_RFC4122_UUID));
+    if (!avatarID.isNull() && _hostedAvatarHosts.value(avatarID) == senderNode->getUUID()) {
+        // the host removes one of its avatars
+        killHostedAvatar(senderNode, avatarID);
+    } else {
+        DependencyManager::get<NodeList>()->processKillNode(*message);
+    }
     auto end = usecTimestampNow();
     _handleKillAvatarPacketElapsedTime += (end - start);
 }
@@ -440,14 +504,17 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
         // Reset the lastBroadcastTime for the ignored avatar to 0
         // so the AvatarMixer knows it'll have to send identity data about the ignored avatar
         // to the ignorer if the ignorer unignores.
-        nodeData->setLastBroadcastTime(ignoredUUID, 0);
+        nodeData->resetLastBroadcastTime(ignoredUUID);
 
         // Reset the lastBroadcastTime for the ignorer (FROM THE PERSPECTIVE OF THE IGNORED) to 0
         // so the AvatarMixer knows it'll have to send identity data about the ignorer
         // to the ignored if the ignorer unignores.
+        // (hosted avatars are not sent anything, and there is no node for them)
         auto ignoredNode = nodeList->nodeWithUUID(ignoredUUID);
-        AvatarMixerClientData* ignoredNodeData = reinterpret_cast<AvatarMixerClientData*>(ignoredNode->getLinkedData());
-        ignoredNodeData->setLastBroadcastTime(senderNode->getUUID(), 0);
+        if (ignoredNode && ignoredNode->getLinkedData()) {
+            AvatarMixerClientData* ignoredNodeData = reinterpret_cast<AvatarMixerClientData*>(ignoredNode->getLinkedData());
+            ignoredNodeData->resetLastBroadcastTime(senderNode->getUUID());
+        }
 
         if (addToIgnore) {
             senderNode->addIgnoredNode(ignoredUUID);
@@ -538,6 +605,8 @@ void AvatarMixer::sendStatsPacket() {
         slave.harvestStats(stats);
         slaveObject["recevied_1_nodesProcessed"] = TIGHT_LOOP_STAT(stats.nodesProcessed);
         slaveObject["received_2_numPacketsReceived"] = TIGHT_LOOP_STAT(stats.packetsProcessed);
+        slaveObject["received_3_usecsQueuedPerPacket"] = stats.packetsProcessed ?
+            (float)stats.packetQueueElapsedTime / (float)stats.packetsProcessed : 0.0f;
 
         slaveObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(stats.nodesBroadcastedTo);
         slaveObject["sent_2_numBytesSent"] = TIGHT_LOOP_STAT(stats.numBytesSent);
@@ -554,6 +623,15 @@ void AvatarMixer::sendStatsPacket() {
         float averageOverBudgetAvatars = averageNodes ? stats.overBudgetAvatars / averageNodes : 0.0f;
         slaveObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
 
+        float averageSharedEncodings = averageNodes ? stats.numSharedEncodings / averageNodes : 0.0f;
+        slaveObject["sent_8_averageSharedEncodings"] = TIGHT_LOOP_STAT(averageSharedEncodings);
+
+        float averageScheduledSkips = averageNodes ? stats.numScheduledSkips / averageNodes : 0.0f;
+        slaveObject["sent_9_averageScheduledSkips"] = TIGHT_LOOP_STAT(averageScheduledSkips);
+
+        slaveObject["sent_10_numIdentitiesSent"] = TIGHT_LOOP_STAT(stats.numIdentitiesSent);
+        slaveObject["sent_11_numIdentitiesDeferred"] = TIGHT_LOOP_STAT(stats.numIdentitiesDeferred);
+
         slaveObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(stats.processIncomingPacketsElapsedTime);
         slaveObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(stats.ignoreCalculationElapsedTime);
         slaveObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(stats.toByteArrayElapsedTime);
@@ -571,6 +649,8 @@ void AvatarMixer::sendStatsPacket() {
 
     slavesAggregatObject["recevied_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
     slavesAggregatObject["received_2_numPacketsReceived"] = TIGHT_LOOP_STAT(aggregateStats.packetsProcessed);
+    slavesAggregatObject["received_3_usecsQueuedPerPacket"] = aggregateStats.packetsProcessed ?
+        (float)aggregateStats.packetQueueElapsedTime / (float)aggregateStats.packetsProcessed : 0.0f;
 
     slavesAggregatObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo);
     slavesAggregatObject["sent_2_numBytesSent"] = TIGHT_LOOP_STAT(aggregateStats.numBytesSent);
@@ -587,6 +667,15 @@ void AvatarMixer::sendStatsPacket() {
     float averageOverBudgetAvatars = averageNodes ? aggregateStats.overBudgetAvatars / averageNodes : 0.0f;
     slavesAggregatObject["sent_7_averageOverBudgetAvatars"] = TIGHT_LOOP_STAT(averageOverBudgetAvatars);
 
+    float averageSharedEncodings = averageNodes ? aggregateStats.numSharedEncodings / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageSharedEncodings"] = TIGHT_LOOP_STAT(averageSharedEncodings);
+
+    float averageScheduledSkips = averageNodes ? aggregateStats.numScheduledSkips / averageNodes : 0.0f;
+    slavesAggregatObject["sent_9_averageScheduledSkips"] = TIGHT_LOOP_STAT(averageScheduledSkips);
+
+    slavesAggregatObject["sent_10_numIdentitiesSent"] = TIGHT_LOOP_STAT(aggregateStats.numIdentitiesSent);
+    slavesAggregatObject["sent_11_numIdentitiesDeferred"] = TIGHT_LOOP_STAT(aggregateStats.numIdentitiesDeferred);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
@@ -677,7 +766,7 @@ void AvatarMixer::run() {
 
 }
 
-AvatarMixerClientData* AvatarMixer::getOrCreateClientData(SharedNodePointer node) {
+AvatarMixerClientData* AvatarMixer::getOrCreateClientData(Node* node) {
     auto clientData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
 
     if (!clientData) {
@@ -691,10 +780,57 @@ AvatarMixerClientData* AvatarMixer::getOrCreateClientData(SharedNodePointer node
     return clientData;
 }
 
+AvatarMixerClientData* AvatarMixer::getOrCreateHostedAvatar(const SharedNodePointer& host, const QUuid& avatarID) {
+    AvatarMixerClientData* hostData = getOrCreateClientData(host.data());
+    AvatarMixerClientData* avatarData = hostData->getHostedAvatar(avatarID);
+    if (!avatarData) {
+        // an avatar is only hosted by one node, and never takes the id of a node
+        if (_hostedAvatarHosts.contains(avatarID) || DependencyManager::get<NodeList>()->nodeWithUUID(avatarID) ||
+                hostData->getHostedAvatars().size() >= (size_t)AvatarMixerClientData::MAX_HOSTED_AVATARS) {
+            return nullptr;
+        }
+        avatarData = hostData->addHostedAvatar(avatarID);
+        auto& avatar = avatarData->getAvatar();
+        avatar.setDomainMinimumScale(_domainMinimumScale);
+        avatar.setDomainMaximumScale(_domainMaximumScale);
+        _hostedAvatarHosts.insert(avatarID, host->getUUID());
+        qCDebug(avatars) << "Node" << host->getUUID() << "hosts the avatar with ID" << avatarID;
+    }
+    return avatarData;
+}
+
+void AvatarMixer::killHostedAvatar(const SharedNodePointer& host, const QUuid& avatarID) {
+    AvatarMixerClientData* hostData = dynamic_cast<AvatarMixerClientData*>(host->getLinkedData());
+    AvatarMixerClientData* avatarData = hostData ? hostData->getHostedAvatar(avatarID) : nullptr;
+    if (!avatarData) {
+        return;
+    }
+    releaseSessionDisplayName(avatarData);
+    hostData->removeHostedAvatar(avatarID);
+    _hostedAvatarHosts.remove(avatarID);
+
+    // tell the other nodes, as for the avatar of a node that left
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
+    killPacket->write(avatarID.toRfc4122());
+    killPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
+    nodeList->broadcastToNodes(std::move(killPacket), NodeSet() << NodeType::Agent);
+
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        if (node->getLinkedData() && node != host) {
+            QMetaObject::invokeMethod(node->getLinkedData(), "cleanupKilledNode", Qt::AutoConnection,
+                                      Q_ARG(const QUuid&, avatarID));
+        }
+    });
+}
+
 void AvatarMixer::domainSettingsRequestComplete() {
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 
+    // create the client data as nodes are added, so that the NodeList thread never races us to it
+    nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
+
     // parse the settings to pull out the values we need
     parseDomainServerSettings(nodeList->getDomainHandler().getSettingsObject());
     
@@ -732,6 +868,10 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
     _maxKbpsPerNode = nodeBandwidthValue.toDouble(DEFAULT_NODE_SEND_BANDWIDTH) * KILO_PER_MEGA;
     qCDebug(avatars) << "The maximum send bandwidth per node is" << _maxKbpsPerNode << "kbps.";
 
+    const QString SCHEDULE_AVATAR_UPDATES_KEY = "schedule_avatar_updates";
+    _scheduleAvatarUpdates = avatarMixerGroupObject[SCHEDULE_AVATAR_UPDATES_KEY].toBool(false);
+    qCDebug(avatars) << "Distance based avatar update scheduling is" << (_scheduleAvatarUpdates ? "enabled." : "disabled.");
+
     const QString AUTO_THREADS = "auto_threads";
     bool autoThreads = avatarMixerGroupObject[AUTO_THREADS].toBool();
     if (!autoThreads) {
@@ -15,6 +15,8 @@
 #ifndef hifi_AvatarMixer_h
 #define hifi_AvatarMixer_h
 
+#include <atomic>
+
 #include <shared/RateCounter.h>
 #include <PortableHighResolutionClock.h>
 
@@ -42,7 +44,7 @@ private slots:
     void handleAdjustAvatarSorting(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleViewFrustumPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
-    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -52,7 +54,10 @@ private slots:
 
 
 private:
-    AvatarMixerClientData* getOrCreateClientData(SharedNodePointer node);
+    AvatarMixerClientData* getOrCreateClientData(Node* node);
+    AvatarMixerClientData* getOrCreateHostedAvatar(const SharedNodePointer& host, const QUuid& avatarID);
+    void killHostedAvatar(const SharedNodePointer& host, const QUuid& avatarID);
+    void releaseSessionDisplayName(AvatarMixerClientData* avatarData);
     std::chrono::microseconds timeFrame(p_high_resolution_clock::time_point& timestamp);
     void throttle(std::chrono::microseconds duration, int frame);
 
@@ -60,6 +65,7 @@ private:
     void sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
 
     void manageDisplayName(const SharedNodePointer& node);
+    void manageDisplayName(const SharedNodePointer& node, AvatarMixerClientData* avatarData);
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
@@ -74,6 +80,7 @@ private:
     int _sumIdentityPackets { 0 };
 
     float _maxKbpsPerNode = 0.0f;
+    bool _scheduleAvatarUpdates { false };
 
     float _domainMinimumScale { MIN_AVATAR_SCALE };
     float _domainMaximumScale { MAX_AVATAR_SCALE };
@@ -81,6 +88,7 @@ private:
     RateCounter<> _broadcastRate;
     p_high_resolution_clock::time_point _lastDebugMessage;
     QHash<QString, QPair<int, int>> _sessionDisplayNames;
+    QHash<QUuid, QUuid> _hostedAvatarHosts; // the node hosting each hosted avatar, by avatar id
 
     quint64 _displayNameManagementElapsedTime { 0 }; // total time spent in broadcastAvatarData/display name management... since last stats window
     quint64 _ignoreCalculationElapsedTime { 0 };
@@ -105,7 +113,7 @@ private:
 
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
-    quint64 _queueIncomingPacketElapsedTime { 0 };
+    std::atomic<quint64> _queueIncomingPacketElapsedTime { 0 }; // accumulated on the NodeList thread
     quint64 _lastStatsTime { usecTimestampNow() };
 
     RateCounter<> _loopRate; // this is the rate that the main thread tight loop runs
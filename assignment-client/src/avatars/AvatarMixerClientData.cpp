@@ -16,36 +16,32 @@
 
 #include "AvatarMixerClientData.h"
 
+const int AvatarMixerClientData::MAX_HOSTED_AVATARS;
 
-
-void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
-    }
+void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message) {
     _packetQueue.push(message);
 }
 
-int AvatarMixerClientData::processPackets() {
+int AvatarMixerClientData::processPackets(quint64& queueTime) {
     int packetsProcessed = 0;
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
-
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    auto now = p_high_resolution_clock::now();
 
+    QSharedPointer<ReceivedMessage> packet;
+    while (_packetQueue.try_pop(packet)) {
         packetsProcessed++;
+        queueTime += std::chrono::duration_cast<std::chrono::microseconds>(now - packet->getFirstPacketReceiveTime()).count();
 
         switch (packet->getType()) {
             case PacketType::AvatarData:
                 parseData(*packet);
                 break;
+            case PacketType::HostedAvatarData:
+                parseHostedAvatarData(*packet);
+                break;
             default:
                 Q_UNREACHABLE();
         }
-        _packetQueue.pop();
     }
-    assert(_packetQueue.empty());
 
     return packetsProcessed;
 }
@@ -56,15 +52,117 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     uint16_t sequenceNumber;
 
     message.readPrimitive(&sequenceNumber);
-    
+
+    // compute the offset to the data payload
+    return parseAvatarData(sequenceNumber, message.readWithoutCopy(message.getBytesLeftToRead()));
+}
+
+int AvatarMixerClientData::parseAvatarData(uint16_t sequenceNumber, const QByteArray& buffer) {
     if (sequenceNumber < _lastReceivedSequenceNumber && _lastReceivedSequenceNumber != UINT16_MAX) {
         incrementNumOutOfOrderSends();
     }
     _lastReceivedSequenceNumber = sequenceNumber;
+    _hasReceivedAvatarData = true;
 
-    // compute the offset to the data payload
-    return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
+    // invalidate any shared encodings of the previous data
+    ++_avatarDataVersion;
+
+    return _avatar->parseDataFromBuffer(buffer);
+}
+
+void AvatarMixerClientData::parseHostedAvatarData(ReceivedMessage& message) {
+    while (message.getBytesLeftToRead() >= (qint64)AvatarDataPacket::HOSTED_AVATAR_HEADER_SIZE) {
+        QUuid avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        uint16_t sequenceNumber;
+        message.readPrimitive(&sequenceNumber);
+        uint16_t size;
+        message.readPrimitive(&size);
+        if (size > message.getBytesLeftToRead()) {
+            break;
+        }
+        QByteArray buffer = message.readWithoutCopy(size);
+
+        // the data of avatars that were not announced by an identity yet, or were removed, is dropped
+        AvatarMixerClientData* hostedAvatar = getHostedAvatar(avatarID);
+        if (hostedAvatar) {
+            hostedAvatar->parseAvatarData(sequenceNumber, buffer);
+        }
+    }
+}
+
+AvatarMixerClientData* AvatarMixerClientData::getHostedAvatar(const QUuid& avatarID) const {
+    auto it = _hostedAvatars.find(avatarID);
+    return it != _hostedAvatars.end() ? it->second.get() : nullptr;
+}
+
+AvatarMixerClientData* AvatarMixerClientData::addHostedAvatar(const QUuid& avatarID) {
+    auto& hostedAvatar = _hostedAvatars[avatarID];
+    if (!hostedAvatar) {
+        hostedAvatar.reset(new AvatarMixerClientData(avatarID));
+        hostedAvatar->getAvatar().setSessionUUID(avatarID);
+    }
+    return hostedAvatar.get();
+}
+static int sharedDetailIndex(AvatarData::AvatarDataDetail detail) {
+    switch (detail) {
+        case AvatarData::NoData:
+            return 0;
+        case AvatarData::PALMinimum:
+            return 1;
+        case AvatarData::SendAllData:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+bool AvatarMixerClientData::isSharedDetail(AvatarData::AvatarDataDetail detail) {
+    return sharedDetailIndex(detail) != -1;
+}
+
+QByteArray AvatarMixerClientData::getSharedAvatarData(AvatarData::AvatarDataDetail detail,
+        AvatarDataPacket::HasFlags& hasFlagsOut, bool& wasCached) const {
+    int index = sharedDetailIndex(detail);
+    assert(index != -1);
+    SharedAvatarData& shared = _sharedAvatarData[index];
+
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    wasCached = (shared.version == _avatarDataVersion);
+    if (!wasCached) {
+        // these details ignore the receiver's baseline (SendAllData only needs it to cover every joint)
+        QVector<JointData> baseline(_avatar->getRawJointData().size());
+        shared.bytes = _avatar->toByteArray(detail, 0, baseline, shared.hasFlags, false, false, glm::vec3(0), nullptr);
+        shared.version = _avatarDataVersion;
+    }
+
+    hasFlagsOut = shared.hasFlags;
+    return shared.bytes;
+}
+
+QByteArray AvatarMixerClientData::getIdentityData() const {
+    std::lock_guard<std::mutex> lock(_identityDataMutex);
+    if (_identityDataVersion != _identityVersion) {
+        _identityData = _avatar->identityByteArray();
+        _identityData.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        _identityDataVersion = _identityVersion;
+    }
+    return _identityData;
+}
+
+float AvatarMixerClientData::updateSpeed(const glm::vec3& position, quint64 now) {
+    if (_speedTimestamp > 0 && now > _speedTimestamp) {
+        float deltaTime = (float)(now - _speedTimestamp) / (float)USECS_PER_SECOND;
+        float speed = glm::distance(position, _speedPosition) / deltaTime;
+
+        // smooth over a few frames, since senders update at a lower rate than we broadcast
+        const float SPEED_SMOOTHING = 0.2f;
+        _speed += SPEED_SMOOTHING * (speed - _speed);
+    }
+    _speedPosition = position;
+    _speedTimestamp = now;
+    return _speed;
 }
+
 uint64_t AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastTimes.find(nodeUUID);
@@ -74,6 +172,14 @@ uint64_t AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) cons
     return 0;
 }
 
+uint64_t AvatarMixerClientData::getLastIdentitySendTime(const QUuid& nodeUUID) const {
+    auto nodeMatch = _lastIdentitySendTimes.find(nodeUUID);
+    if (nodeMatch != _lastIdentitySendTimes.end()) {
+        return nodeMatch->second;
+    }
+    return 0;
+}
+
 uint16_t AvatarMixerClientData::getLastBroadcastSequenceNumber(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastSequenceNumbers.find(nodeUUID);
@@ -93,7 +199,7 @@ void AvatarMixerClientData::ignoreOther(SharedNodePointer self, SharedNodePointe
         } else {
             killPacket->writePrimitive(KillAvatarReason::YourAvatarEnteredTheirBubble);
         }
-        setLastBroadcastTime(other->getUUID(), 0);
+        resetLastBroadcastTime(other->getUUID());
         DependencyManager::get<NodeList>()->sendUnreliablePacket(*killPacket, *self);
     }
 }
@@ -115,6 +221,10 @@ bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
     return _currentViewFrustum.boxIntersectsKeyhole(otherAvatarBox);
 }
 
+void AvatarMixerClientData::otherAvatarsInView(const ViewFrustum::Boxes& otherAvatarBoxes, uint32_t* inView) const {
+    _currentViewFrustum.boxesIntersectKeyhole(otherAvatarBoxes, inView);
+}
+
 void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["display_name"] = _avatar->getDisplayName();
     jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
@@ -128,4 +238,5 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
     jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
     jsonObject["recent_other_av_out_of_view"] = _recentOtherAvatarsOutOfView;
+    jsonObject["num_hosted_avatars"] = (int)_hostedAvatars.size();
 }
@@ -14,13 +14,17 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
-#include <queue>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QUrl>
 
+#include <tbb/concurrent_queue.h>
+
 #include <AvatarData.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -41,10 +45,19 @@ public:
     using HRCTime = p_high_resolution_clock::time_point;
 
     int parseData(ReceivedMessage& message) override;
+    int parseAvatarData(uint16_t sequenceNumber, const QByteArray& buffer);
+    bool hasReceivedAvatarData() const { return _hasReceivedAvatarData; }
     AvatarData& getAvatar() { return *_avatar; }
     const AvatarData* getConstAvatarData() const { return _avatar.get(); }
     AvatarSharedPointer getAvatarSharedPointer() const { return _avatar; }
 
+    // Serialize this avatar at a detail that does not depend on the receiver (NoData, PALMinimum or SendAllData)
+    //   Every receiver gets the same bytes at these details, so each is encoded once per parsed avatar data packet
+    //   and shared by all the receivers (on any slave thread) that ask for it. Sets wasCached if it was already encoded.
+    static bool isSharedDetail(AvatarData::AvatarDataDetail detail);
+    QByteArray getSharedAvatarData(AvatarData::AvatarDataDetail detail, AvatarDataPacket::HasFlags& hasFlagsOut,
+        bool& wasCached) const;
+
     uint16_t getLastBroadcastSequenceNumber(const QUuid& nodeUUID) const;
     void setLastBroadcastSequenceNumber(const QUuid& nodeUUID, uint16_t sequenceNumber)
         { _lastBroadcastSequenceNumbers[nodeUUID] = sequenceNumber; }
@@ -54,15 +67,30 @@ public:
     void setLastBroadcastTime(const QUuid& nodeUUID, uint64_t broadcastTime) { _lastBroadcastTimes[nodeUUID] = broadcastTime; }
     Q_INVOKABLE void removeLastBroadcastTime(const QUuid& nodeUUID) { _lastBroadcastTimes.erase(nodeUUID); }
 
+    // forget what was sent about this other node, so that its identity and avatar data are sent again
+    void resetLastBroadcastTime(const QUuid& nodeUUID) {
+        setLastBroadcastTime(nodeUUID, 0);
+        _lastIdentitySendTimes.erase(nodeUUID);
+    }
+
+    // the last time identity data about this other node was queued for this receiver
+    uint64_t getLastIdentitySendTime(const QUuid& nodeUUID) const;
+    void setLastIdentitySendTime(const QUuid& nodeUUID, uint64_t sendTime) { _lastIdentitySendTimes[nodeUUID] = sendTime; }
+
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID) {
         removeLastBroadcastSequenceNumber(nodeUUID);
         removeLastBroadcastTime(nodeUUID);
+        _lastIdentitySendTimes.erase(nodeUUID);
     }
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
-    void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); }
+    void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); ++_identityVersion; }
+
+    // Serialize this avatar's identity, as sent to other nodes
+    //   The identity is encoded once per change and shared by all the receivers (on any slave thread).
+    QByteArray getIdentityData() const;
     bool getAvatarSessionDisplayNameMustChange() const { return _avatarSessionDisplayNameMustChange; }
     void setAvatarSessionDisplayNameMustChange(bool set = true) { _avatarSessionDisplayNameMustChange = set; }
 
@@ -90,6 +118,9 @@ public:
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getPosition() : glm::vec3(0); }
+
+    // estimate (and return) the avatar's speed from its position at each broadcast frame
+    float updateSpeed(const glm::vec3& position, quint64 now);
     glm::vec3 getGlobalBoundingBoxCorner() const { return _avatar ? _avatar->getGlobalBoundingBoxCorner() : glm::vec3(0); }
     bool isRadiusIgnoring(const QUuid& other) const { return _radiusIgnoredOthers.find(other) != _radiusIgnoredOthers.end(); }
     void addToRadiusIgnoringSet(const QUuid& other) { _radiusIgnoredOthers.insert(other); }
@@ -99,6 +130,8 @@ public:
     void readViewFrustumPacket(const QByteArray& message);
 
     bool otherAvatarInView(const AABox& otherAvatarBox);
+    // batch version, of the boxes of all the other avatars at once (see ViewFrustum::boxesIntersectKeyhole)
+    void otherAvatarsInView(const ViewFrustum::Boxes& otherAvatarBoxes, uint32_t* inView) const;
 
     void resetInViewStats() { _recentOtherAvatarsInView = _recentOtherAvatarsOutOfView = 0; }
     void incrementAvatarInView() { _recentOtherAvatarsInView++; }
@@ -124,27 +157,61 @@ public:
         return _lastOtherAvatarSentJoints[otherAvatar];
     }
 
-    void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
-    int processPackets(); // returns number of packets processed
+    // the avatars hosted by this node, like the bots of an agent, each sent to the other nodes as an avatar of its own
+    //   They are added and removed by the mixer between frames, and their data is parsed by the slave of the node.
+    using HostedAvatars = std::map<QUuid, std::unique_ptr<AvatarMixerClientData>>;
+    static const int MAX_HOSTED_AVATARS = 256;
+    const HostedAvatars& getHostedAvatars() const { return _hostedAvatars; }
+    AvatarMixerClientData* getHostedAvatar(const QUuid& avatarID) const;
+    AvatarMixerClientData* addHostedAvatar(const QUuid& avatarID);
+    void removeHostedAvatar(const QUuid& avatarID) { _hostedAvatars.erase(avatarID); }
+
+    // called on the NodeList thread
+    void queuePacket(QSharedPointer<ReceivedMessage> message);
+    // called by a slave; returns number of packets processed, and adds the usecs they spent queued to queueTime
+    int processPackets(quint64& queueTime);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
-        QWeakPointer<Node> node;
-    };
-    PacketQueue _packetQueue;
+    void parseHostedAvatarData(ReceivedMessage& message);
+
+    // pushed by the NodeList thread and popped by a slave, possibly at the same time
+    tbb::concurrent_queue<QSharedPointer<ReceivedMessage>> _packetQueue;
 
     AvatarSharedPointer _avatar { new AvatarData() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
+    bool _hasReceivedAvatarData { false };
     std::unordered_map<QUuid, uint16_t> _lastBroadcastSequenceNumbers;
     std::unordered_map<QUuid, uint64_t> _lastBroadcastTimes;
+    std::unordered_map<QUuid, uint64_t> _lastIdentitySendTimes;
+
+    // shared encodings of this avatar, indexed by detail
+    struct SharedAvatarData {
+        std::mutex mutex;
+        uint32_t version { 0 }; // the _avatarDataVersion that bytes encodes
+        QByteArray bytes;
+        AvatarDataPacket::HasFlags hasFlags { 0 };
+    };
+    static const int NUM_SHARED_DETAILS = 3;
+    mutable SharedAvatarData _sharedAvatarData[NUM_SHARED_DETAILS];
+    uint32_t _avatarDataVersion { 1 }; // incremented for each parsed avatar data packet
+
+    glm::vec3 _speedPosition;
+    quint64 _speedTimestamp { 0 };
+    float _speed { 0.0f }; // m/s
 
     // this is a map of the last time we encoded an "other" avatar for
     // sending to "this" node
     std::unordered_map<QUuid, quint64> _lastOtherAvatarEncodeTime;
     std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
 
-    uint64_t _identityChangeTimestamp;
+    uint64_t _identityChangeTimestamp { 0 };
+    uint32_t _identityVersion { 1 }; // incremented for each identity change
+
+    // shared encoding of this avatar's identity
+    mutable std::mutex _identityDataMutex;
+    mutable uint32_t _identityDataVersion { 0 }; // the _identityVersion that _identityData encodes
+    mutable QByteArray _identityData;
     bool _avatarSessionDisplayNameMustChange{ false };
 
     int _numAvatarsSentLastFrame = 0;
@@ -162,6 +229,8 @@ private:
     int _recentOtherAvatarsOutOfView { 0 };
     QString _baseDisplayName{}; // The santized key used in determinging unique sessionDisplayName, so that we can remove from dictionary.
     bool _requestsDomainListData { false };
+
+    HostedAvatars _hostedAvatars;
 };
 
 #endif // hifi_AvatarMixerClientData_h
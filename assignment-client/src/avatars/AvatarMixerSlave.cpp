@@ -10,6 +10,7 @@
 //
 
 #include <algorithm>
+#include <functional>
 #include <random>
 
 #include <glm/glm.hpp>
@@ -40,12 +41,17 @@ void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
 
 void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, 
                                 p_high_resolution_clock::time_point lastFrameTimestamp,
-                                float maxKbpsPerNode, float throttlingRatio) {
+                                float maxKbpsPerNode, float throttlingRatio, bool scheduleUpdates,
+                                const std::vector<AvatarMixerSnapshot>* snapshots,
+                                const AvatarMixerSnapshotBounds* snapshotBounds) {
     _begin = begin;
     _end = end;
     _lastFrameTimestamp = lastFrameTimestamp;
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
+    _scheduleUpdates = scheduleUpdates;
+    _snapshots = snapshots;
+    _snapshotBounds = snapshotBounds;
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
@@ -59,37 +65,47 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
         _stats.nodesProcessed++;
-        _stats.packetsProcessed += nodeData->processPackets();
+        _stats.packetsProcessed += nodeData->processPackets(_stats.packetQueueElapsedTime);
     }
     auto end = usecTimestampNow();
     _stats.processIncomingPacketsElapsedTime += (end - start);
 }
 
 
-int AvatarMixerSlave::sendIdentityPacket(const AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
-    int bytesSent = 0;
-    QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray();
-    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
-    individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
-    bytesSent += individualData.size();
-    identityPacket->write(individualData);
-    DependencyManager::get<NodeList>()->sendPacket(std::move(identityPacket), *destinationNode);
-    _stats.numIdentityPackets++;
-    return bytesSent;
-}
-
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// identities beyond this many bytes per receiver per frame are deferred to the next frame
+// (at least one identity is always sent, so a large one cannot stall the others)
+static const int MAX_IDENTITY_BYTES_PER_FRAME = 8 * 1024;
+
+// update rate scheduling: avatars that appear small to the receiver are sent less often
+static const float NEAR_APPARENT_SIZE = 0.2f; // about a 2m avatar within 10m; sent every frame
+static const float MID_APPARENT_SIZE = 0.05f; // about a 2m avatar within 40m
+static const quint64 MID_UPDATE_INTERVAL = USECS_PER_SECOND / 15;
+static const quint64 FAR_UPDATE_INTERVAL = USECS_PER_SECOND / 2;
+static const float MOVING_AVATAR_SPEED = 1.0f; // m/s; moving avatars are promoted one tier
+
+static quint64 scheduledUpdateInterval(float apparentSize, float speed) {
+    int tier = apparentSize >= NEAR_APPARENT_SIZE ? 0 : (apparentSize >= MID_APPARENT_SIZE ? 1 : 2);
+    if (speed >= MOVING_AVATAR_SPEED && tier > 0) {
+        --tier;
+    }
+
+    switch (tier) {
+        case 0:
+            return 0;
+        case 1:
+            return MID_UPDATE_INTERVAL;
+        default:
+            return FAR_UPDATE_INTERVAL;
+    }
+}
+
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    // setup for distributed random floating point values
-    std::random_device randomDevice;
-    std::mt19937 generator(randomDevice());
-    std::uniform_real_distribution<float> distribution;
-
     if (node->getLinkedData() && (node->getType() == NodeType::Agent) && node->getActiveSocket()) {
         _stats.nodesBroadcastedTo++;
 
@@ -100,9 +116,6 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         const AvatarData& avatar = nodeData->getAvatar();
         glm::vec3 myPosition = avatar.getClientGlobalPosition();
 
-        // reset the internal state for correct random number distribution
-        distribution.reset();
-
         // reset the number of sent avatars
         nodeData->resetNumAvatarsSentLastFrame();
 
@@ -113,8 +126,12 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         int numAvatarDataBytes = 0;
         int identityBytesSent = 0;
 
-        // max number of avatarBytes per frame
-        auto maxAvatarBytesPerFrame = (_maxKbpsPerNode * BYTES_PER_KILOBIT) / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+        // max number of avatarBytes per frame, within this mixer's share of what the node can receive
+        float maxKbps = _maxKbpsPerNode;
+        if (node->getBandwidthBudgetKbps() > 0) {
+            maxKbps = std::min(maxKbps, (float)node->getBandwidthBudgetKbps());
+        }
+        auto maxAvatarBytesPerFrame = (maxKbps * BYTES_PER_KILOBIT) / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
 
         // FIXME - find a way to not send the sessionID for every avatar
         int minimumBytesPerAvatar = AvatarDataPacket::AVATAR_HAS_FLAGS_SIZE + NUM_BYTES_RFC4122_UUID;
@@ -143,6 +160,9 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         // setup a PacketList for the avatarPackets
         auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
 
+        // identity changes for this receiver are coalesced into one reliable PacketList, created when first needed
+        std::unique_ptr<NLPacketList> identityPacketList;
+
         // Define the minimum bubble size
         static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
         // Define the scale of the box for the current node
@@ -157,163 +177,200 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         nodeBox.embiggen(4.0f);
 
 
-        // setup list of AvatarData as well as maps to map betweeen the AvatarData and the original nodes
-        // for calling the AvatarData::sortAvatars() function and getting our sorted list of client nodes
-        QList<AvatarSharedPointer> avatarList;
-        std::unordered_map<AvatarSharedPointer, SharedNodePointer> avatarDataToNodes;
-
-        std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
-            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
-
-            // theoretically it's possible for a Node to be in the NodeList (and therefore end up here),
-            // but not have yet sent data that's linked to the node. Check for that case and don't
-            // consider those nodes.
-            if (otherNodeData) {
-                AvatarSharedPointer otherAvatar = otherNodeData->getAvatarSharedPointer();
-                avatarList << otherAvatar;
-                avatarDataToNodes[otherAvatar] = otherNode;
+        const std::vector<AvatarMixerSnapshot>& snapshots = *_snapshots;
+        ViewFrustum cameraView = nodeData->getViewFrustom();
+        glm::vec3 frustumCenter = cameraView.getPosition();
+        const glm::vec3& forward = cameraView.getDirection();
+        uint64_t now = usecTimestampNow();
+
+        // test the bounds of all the snapshots against the view at once
+        int numInViewWords = ViewFrustum::getNumInViewWords((int)snapshots.size());
+        _spheresInView.resize(numInViewWords);
+        _boxesInKeyhole.resize(numInViewWords);
+        cameraView.spheresIntersectFrustum(_snapshotBounds->spheres, _spheresInView.data());
+        nodeData->otherAvatarsInView(_snapshotBounds->boxes, _boxesInKeyhole.data());
+
+        // filter the shared snapshots down to the avatars this receiver should hear about, and prioritize them
+        _sortedAvatars.clear();
+        for (int i = 0; i < (int)snapshots.size(); ++i) {
+            const AvatarMixerSnapshot& other = snapshots[i];
+            if (other.data == nodeData || other.node == node) {
+                continue; // ignore ourselves, and the avatars we host
             }
-        });
 
-        AvatarSharedPointer thisAvatar = nodeData->getAvatarSharedPointer();
-        ViewFrustum cameraView = nodeData->getViewFrustom();
-        std::priority_queue<AvatarPriority> sortedAvatars;
-        AvatarData::sortAvatars(avatarList, cameraView, sortedAvatars,
-
-                [&](AvatarSharedPointer avatar)->uint64_t{
-                    auto avatarNode = avatarDataToNodes[avatar];
-                    assert(avatarNode); // we can't have gotten here without the avatarData being a valid key in the map
-                    return nodeData->getLastBroadcastTime(avatarNode->getUUID());
-                },
-
-                [&](AvatarSharedPointer avatar)->float{
-                    glm::vec3 nodeBoxHalfScale = (avatar->getPosition() - avatar->getGlobalBoundingBoxCorner());
-                    return glm::max(nodeBoxHalfScale.x, glm::max(nodeBoxHalfScale.y, nodeBoxHalfScale.z));
-                },
-
-                [&](AvatarSharedPointer avatar)->bool{
-                    if (avatar == thisAvatar) {
-                        return true; // ignore ourselves...
-                    }
+            const SharedNodePointer& avatarNode = other.node;
+            bool shouldIgnore = false;
+
+            // We will also ignore other nodes for a couple of different reasons:
+            //   1) ignore bubbles and ignore specific node
+            //   2) the node hasn't really updated it's frame data recently, this can
+            //      happen if for example the avatar is connected on a desktop and sending
+            //      updates at ~30hz. So every 3 frames we skip a frame.
+            quint64 startIgnoreCalculation = usecTimestampNow();
+
+            // make sure that it isn't the same node, and isn't an avatar that the viewing node has ignored
+            // or that has ignored the viewing node
+            if (other.id == node->getUUID()
+                || (node->isIgnoringNodeWithID(other.id) && !PALIsOpen)
+                || (avatarNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
+                shouldIgnore = true;
+            } else {
 
-                    bool shouldIgnore = false;
-
-                    // We will also ignore other nodes for a couple of different reasons:
-                    //   1) ignore bubbles and ignore specific node
-                    //   2) the node hasn't really updated it's frame data recently, this can
-                    //      happen if for example the avatar is connected on a desktop and sending
-                    //      updates at ~30hz. So every 3 frames we skip a frame.
-                    auto avatarNode = avatarDataToNodes[avatar];
-
-                    assert(avatarNode); // we can't have gotten here without the avatarData being a valid key in the map
-
-                    const AvatarMixerClientData* avatarNodeData = reinterpret_cast<const AvatarMixerClientData*>(avatarNode->getLinkedData());
-                    assert(avatarNodeData); // we can't have gotten here without avatarNode having valid data
-                    quint64 startIgnoreCalculation = usecTimestampNow();
-
-                    // make sure we have data for this avatar, that it isn't the same node,
-                    // and isn't an avatar that the viewing node has ignored
-                    // or that has ignored the viewing node
-                    if (!avatarNode->getLinkedData()
-                        || avatarNode->getUUID() == node->getUUID()
-                        || (node->isIgnoringNodeWithID(avatarNode->getUUID()) && !PALIsOpen)
-                        || (avatarNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
-                        shouldIgnore = true;
-                    } else {
-
-                        // Check to see if the space bubble is enabled
-                        // Don't bother with these checks if the other avatar has their bubble enabled and we're gettingAnyIgnored
-                        if (node->isIgnoreRadiusEnabled() || (avatarNode->isIgnoreRadiusEnabled() && !getsAnyIgnored)) {
-
-                            // Define the scale of the box for the current other node
-                            glm::vec3 otherNodeBoxScale = (avatarNodeData->getPosition() - avatarNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                            // Set up the bounding box for the current other node
-                            AABox otherNodeBox(avatarNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
-                                otherNodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Quadruple the scale of both bounding boxes
-                            otherNodeBox.embiggen(4.0f);
-
-                            // Perform the collision check between the two bounding boxes
-                            if (nodeBox.touches(otherNodeBox)) {
-                                nodeData->ignoreOther(node, avatarNode);
-                                shouldIgnore = !getsAnyIgnored;
-                            }
-                        }
-                        // Not close enough to ignore
-                        if (!shouldIgnore) {
-                            nodeData->removeFromRadiusIgnoringSet(node, avatarNode->getUUID());
-                        }
+                // Check to see if the space bubble is enabled
+                // Don't bother with these checks if the other avatar has their bubble enabled and we're gettingAnyIgnored
+                // (the bubble ignores nodes, so it does not apply to the avatars they host)
+                bool isHostedAvatar = other.id != avatarNode->getUUID();
+                if (!isHostedAvatar &&
+                    (node->isIgnoreRadiusEnabled() || (avatarNode->isIgnoreRadiusEnabled() && !getsAnyIgnored))) {
+
+                    // Define the scale of the box for the current other node
+                    glm::vec3 otherNodeBoxScale = (other.position - other.boundingBoxCorner) * 2.0f;
+                    // Set up the bounding box for the current other node
+                    AABox otherNodeBox(other.boundingBoxCorner, otherNodeBoxScale);
+                    // Clamp the size of the bounding box to a minimum scale
+                    if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
+                        otherNodeBox.setScaleStayCentered(minBubbleSize);
                     }
-                    quint64 endIgnoreCalculation = usecTimestampNow();
-                    _stats.ignoreCalculationElapsedTime += (endIgnoreCalculation - startIgnoreCalculation);
-
-                    if (!shouldIgnore) {
-                        AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(avatarNode->getUUID());
-                        AvatarDataSequenceNumber lastSeqFromSender = avatarNodeData->getLastReceivedSequenceNumber();
-
-                        // FIXME - This code does appear to be working. But it seems brittle.
-                        //         It supports determining if the frame of data for this "other"
-                        //         avatar has already been sent to the reciever. This has been
-                        //         verified to work on a desktop display that renders at 60hz and
-                        //         therefore sends to mixer at 30hz. Each second you'd expect to
-                        //         have 15 (45hz-30hz) duplicate frames. In this case, the stat
-                        //         avg_other_av_skips_per_second does report 15.
-                        //
-                        // make sure we haven't already sent this data from this sender to this receiver
-                        // or that somehow we haven't sent
-                        if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                            ++numAvatarsHeldBack;
-                            shouldIgnore = true;
-                        } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                            // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                            ++numAvatarsWithSkippedFrames;
-                        }
+                    // Quadruple the scale of both bounding boxes
+                    otherNodeBox.embiggen(4.0f);
+
+                    // Perform the collision check between the two bounding boxes
+                    if (nodeBox.touches(otherNodeBox)) {
+                        nodeData->ignoreOther(node, avatarNode);
+                        shouldIgnore = !getsAnyIgnored;
                     }
-                    return shouldIgnore;
-                });
+                }
+                // Not close enough to ignore
+                if (!shouldIgnore) {
+                    nodeData->removeFromRadiusIgnoringSet(node, other.id);
+                }
+            }
+            quint64 endIgnoreCalculation = usecTimestampNow();
+            _stats.ignoreCalculationElapsedTime += (endIgnoreCalculation - startIgnoreCalculation);
+
+            if (shouldIgnore) {
+                continue;
+            }
+
+            glm::vec3 offset = other.position - frustumCenter;
+            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+            float apparentSize = 2.0f * other.boundingRadius / distance;
+            uint64_t lastBroadcastTime = nodeData->getLastBroadcastTime(other.id);
+
+            // hold back avatars that are not yet due an update at their scheduled rate
+            if (_scheduleUpdates && lastBroadcastTime > 0) {
+                // allow half a frame of slack, since sends are quantized to broadcast frames
+                const quint64 HALF_FRAME_USECS = USECS_PER_SECOND / (2 * AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+                quint64 interval = scheduledUpdateInterval(apparentSize, other.speed);
+                if (now - lastBroadcastTime + HALF_FRAME_USECS < interval) {
+                    _stats.numScheduledSkips++;
+                    continue;
+                }
+            }
+
+            AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(other.id);
+            AvatarDataSequenceNumber lastSeqFromSender = other.lastReceivedSequenceNumber;
+
+            // FIXME - This code does appear to be working. But it seems brittle.
+            //         It supports determining if the frame of data for this "other"
+            //         avatar has already been sent to the reciever. This has been
+            //         verified to work on a desktop display that renders at 60hz and
+            //         therefore sends to mixer at 30hz. Each second you'd expect to
+            //         have 15 (45hz-30hz) duplicate frames. In this case, the stat
+            //         avg_other_av_skips_per_second does report 15.
+            //
+            // make sure we haven't already sent this data from this sender to this receiver
+            // or that somehow we haven't sent
+            if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+                ++numAvatarsHeldBack;
+                continue;
+            } else if (lastSeqFromSender - lastSeqToReceiver > 1 && !_scheduleUpdates) {
+                // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+                // (scheduled avatars skip sender frames by design, so they are not counted)
+                ++numAvatarsWithSkippedFrames;
+            }
+
+            // priority = weighted linear combination of (as in AvatarData::sortAvatars):
+            //   (a) apparentSize
+            //   (b) proximity to center of view
+            //   (c) time since last update
+            float cosineAngle = glm::dot(offset, forward) / distance;
+            float age = (float)(now - lastBroadcastTime) / (float)(USECS_PER_SECOND);
+
+            float priority = AvatarData::_avatarSortCoefficientSize * apparentSize
+                + AvatarData::_avatarSortCoefficientCenter * cosineAngle
+                + AvatarData::_avatarSortCoefficientAge * age;
+
+            // decrement priority of avatars outside keyhole
+            if (distance > cameraView.getCenterRadius()) {
+                if (!ViewFrustum::isInView(_spheresInView.data(), i)) {
+                    priority += AvatarData::OUT_OF_VIEW_PENALTY;
+                }
+            }
+
+            _sortedAvatars.push_back({ priority, i });
+        }
 
         // loop through our sorted avatars and allocate our bandwidth to them accordingly
         int avatarRank = 0;
 
         // this is overly conservative, because it includes some avatars we might not consider
-        int remainingAvatars = (int)sortedAvatars.size(); 
+        int remainingAvatars = (int)_sortedAvatars.size();
 
-        while (!sortedAvatars.empty()) {
-            AvatarPriority sortData = sortedAvatars.top();
-            sortedAvatars.pop();
-            const auto& avatarData = sortData.avatar;
-            avatarRank++;
-            remainingAvatars--;
+        // the avatars are only sorted as far as they are consumed within budget:
+        // once over budget, every remaining avatar gets the same (minimal) detail, so their order does not matter
+        static const int MIN_SORTED_AVATARS = 16;
+        int numSortedAvatars = 0;
 
-            auto otherNode = avatarDataToNodes[avatarData];
-            assert(otherNode); // we can't have gotten here without the avatarData being a valid key in the map
+        while (avatarRank < (int)_sortedAvatars.size()) {
+            remainingAvatars--;
 
             // NOTE: Here's where we determine if we are over budget and drop to bare minimum data
             int minimRemainingAvatarBytes = minimumBytesPerAvatar * remainingAvatars;
             bool overBudget = (identityBytesSent + numAvatarDataBytes + minimRemainingAvatarBytes) > maxAvatarBytesPerFrame;
 
+            if (avatarRank == numSortedAvatars && !overBudget) {
+                // sort the next (growing) batch of highest priority avatars into place
+                numSortedAvatars = std::min((int)_sortedAvatars.size(), std::max(2 * numSortedAvatars, MIN_SORTED_AVATARS));
+                std::partial_sort(_sortedAvatars.begin() + avatarRank, _sortedAvatars.begin() + numSortedAvatars,
+                    _sortedAvatars.end(), std::greater<SortedAvatar>());
+            }
+
+            int otherIndex = _sortedAvatars[avatarRank].index;
+            const AvatarMixerSnapshot& other = snapshots[otherIndex];
+            avatarRank++;
+
             quint64 startAvatarDataPacking = usecTimestampNow();
 
             ++numOtherAvatars;
 
-            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
+            const AvatarMixerClientData* otherNodeData = other.data;
 
             // If the time that the mixer sent AVATAR DATA about Avatar B to Avatar A is BEFORE OR EQUAL TO
             // the time that Avatar B flagged an IDENTITY DATA change, send IDENTITY DATA about Avatar B to Avatar A.
-            if (nodeData->getLastBroadcastTime(otherNode->getUUID()) <= otherNodeData->getIdentityChangeTimestamp()) {
-                identityBytesSent += sendIdentityPacket(otherNodeData, node);
+            // Avatars that are not sent any data (out of view, over budget) would otherwise have their identity resent
+            // every frame, so it is only sent once per change.
+            uint64_t identityChangeTimestamp = otherNodeData->getIdentityChangeTimestamp();
+            bool identityDeferred = false;
+            if (nodeData->getLastBroadcastTime(other.id) <= identityChangeTimestamp &&
+                nodeData->getLastIdentitySendTime(other.id) <= identityChangeTimestamp) {
+                if (identityBytesSent >= MAX_IDENTITY_BYTES_PER_FRAME) {
+                    identityDeferred = true;
+                    _stats.numIdentitiesDeferred++;
+                } else {
+                    if (!identityPacketList) {
+                        identityPacketList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
+                    }
+                    identityBytesSent += identityPacketList->write(otherNodeData->getIdentityData());
+                    nodeData->setLastIdentitySendTime(other.id, now);
+                    _stats.numIdentitiesSent++;
+                }
             }
 
             const AvatarData* otherAvatar = otherNodeData->getConstAvatarData();
-            glm::vec3 otherPosition = otherAvatar->getClientGlobalPosition();
 
             // determine if avatar is in view, to determine how much data to include...
-            glm::vec3 otherNodeBoxScale = (otherPosition - otherNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-            AABox otherNodeBox(otherNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-            bool isInView = nodeData->otherAvatarInView(otherNodeBox);
+            bool isInView = ViewFrustum::isInView(_boxesInKeyhole.data(), otherIndex);
 
             // start a new segment in the PacketList for this avatar
             avatarPacketList->startSegment();
@@ -328,22 +385,32 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                 detail = PALIsOpen ? AvatarData::PALMinimum : AvatarData::NoData;
                 nodeData->incrementAvatarOutOfView();
             } else {
-                detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO
+                detail = _distribution(_generator) < AVATAR_SEND_FULL_UPDATE_RATIO
                     ? AvatarData::SendAllData : AvatarData::CullSmallData;
                 nodeData->incrementAvatarInView();
             }
 
             bool includeThisAvatar = true;
-            auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID());
-            QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(otherNode->getUUID());
+            auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(other.id);
+            QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(other.id);
             bool distanceAdjust = true;
             glm::vec3 viewerPosition = myPosition;
             AvatarDataPacket::HasFlags hasFlagsOut; // the result of the toByteArray
             bool dropFaceTracking = false;
 
             quint64 start = usecTimestampNow();
-            QByteArray bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther, 
+            QByteArray bytes;
+            if (AvatarMixerClientData::isSharedDetail(detail)) {
+                // identical for every receiver, so serialize once and share
+                bool wasCached;
+                bytes = otherNodeData->getSharedAvatarData(detail, hasFlagsOut, wasCached);
+                if (wasCached) {
+                    _stats.numSharedEncodings++;
+                }
+            } else {
+                bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
                                             hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+            }
             quint64 end = usecTimestampNow();
             _stats.toByteArrayElapsedTime += (end - start);
 
@@ -368,7 +435,7 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
             }
 
             if (includeThisAvatar) {
-                numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
+                numAvatarDataBytes += avatarPacketList->write(other.id.toRfc4122());
                 numAvatarDataBytes += avatarPacketList->write(bytes);
 
                 if (detail != AvatarData::NoData) {
@@ -378,11 +445,14 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
                     nodeData->incrementNumAvatarsSentLastFrame();
 
                     // set the last sent sequence number for this sender on the receiver
-                    nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(), 
+                    nodeData->setLastBroadcastSequenceNumber(other.id, 
                                     otherNodeData->getLastReceivedSequenceNumber());
 
                     // remember the last time we sent details about this other node to the receiver
-                    nodeData->setLastBroadcastTime(otherNode->getUUID(), start);
+                    // (unless its identity is still owed, which the next frame will check for against this time)
+                    if (!identityDeferred) {
+                        nodeData->setLastBroadcastTime(other.id, start);
+                    }
                 }
             }
 
@@ -394,6 +464,13 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
         quint64 startPacketSending = usecTimestampNow();
 
+        // send the identities first, so that the receiver can (usually) resolve the avatars before their data
+        if (identityPacketList) {
+            identityPacketList->closeCurrentPacket();
+            _stats.numIdentityPackets += (int)identityPacketList->getNumPackets();
+            nodeList->sendPacketList(std::move(identityPacketList), *node);
+        }
+
         // close the current packet so that we're always sending something
         avatarPacketList->closeCurrentPacket(true);
 
@@ -12,20 +12,58 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+#include <ViewFrustum.h>
+
 class AvatarMixerClientData;
 
+// Per-frame copy of the sender state that every receiver sorts and filters on
+//   The pool builds one contiguous array of these before broadcasting, so receivers do not rebuild
+//   lists and maps of all the other avatars (or chase their shared pointers) for every node.
+struct AvatarMixerSnapshot {
+    SharedNodePointer node;
+    const AvatarMixerClientData* data;
+    QUuid id;
+    glm::vec3 position;
+    glm::vec3 boundingBoxCorner;
+    float boundingRadius;
+    float speed;
+    uint16_t lastReceivedSequenceNumber;
+};
+
+// The bounds of the snapshots, in their order, tested against the view of each receiver in one batch
+struct AvatarMixerSnapshotBounds {
+    ViewFrustum::Spheres spheres; // bounding spheres, that rank the avatars out of the view after the others
+    ViewFrustum::Boxes boxes; // bounding boxes, that send no data of the avatars out of the keyhole
+
+    void clear() {
+        spheres.clear();
+        boxes.clear();
+    }
+};
+
 class AvatarMixerSlaveStats {
 public:
     int nodesProcessed { 0 };
     int packetsProcessed { 0 };
     quint64 processIncomingPacketsElapsedTime { 0 };
+    quint64 packetQueueElapsedTime { 0 }; // from the socket read to the slave, summed over packetsProcessed
 
     int nodesBroadcastedTo { 0 };
     int numPacketsSent { 0 };
     int numBytesSent { 0 };
     int numIdentityPackets { 0 };
+    int numIdentitiesSent { 0 };
+    int numIdentitiesDeferred { 0 };
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
+    int numSharedEncodings { 0 };
+    int numScheduledSkips { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -38,14 +76,19 @@ public:
         nodesProcessed = 0;
         packetsProcessed = 0;
         processIncomingPacketsElapsedTime = 0;
+        packetQueueElapsedTime = 0;
 
         // sending job stats
         nodesBroadcastedTo = 0;
         numPacketsSent = 0;
         numBytesSent = 0;
         numIdentityPackets = 0;
+        numIdentitiesSent = 0;
+        numIdentitiesDeferred = 0;
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
+        numSharedEncodings = 0;
+        numScheduledSkips = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -58,13 +101,18 @@ public:
         nodesProcessed += rhs.nodesProcessed;
         packetsProcessed += rhs.packetsProcessed;
         processIncomingPacketsElapsedTime += rhs.processIncomingPacketsElapsedTime;
+        packetQueueElapsedTime += rhs.packetQueueElapsedTime;
 
         nodesBroadcastedTo += rhs.nodesBroadcastedTo;
         numPacketsSent += rhs.numPacketsSent;
         numBytesSent += rhs.numBytesSent;
         numIdentityPackets += rhs.numIdentityPackets;
+        numIdentitiesSent += rhs.numIdentitiesSent;
+        numIdentitiesDeferred += rhs.numIdentitiesDeferred;
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
+        numSharedEncodings += rhs.numSharedEncodings;
+        numScheduledSkips += rhs.numScheduledSkips;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -83,7 +131,8 @@ public:
     void configure(ConstIter begin, ConstIter end);
     void configureBroadcast(ConstIter begin, ConstIter end, 
                     p_high_resolution_clock::time_point lastFrameTimestamp, 
-                    float maxKbpsPerNode, float throttlingRatio);
+                    float maxKbpsPerNode, float throttlingRatio, bool scheduleUpdates,
+                    const std::vector<AvatarMixerSnapshot>* snapshots, const AvatarMixerSnapshotBounds* snapshotBounds);
 
     void processIncomingPackets(const SharedNodePointer& node);
     void broadcastAvatarData(const SharedNodePointer& node);
@@ -91,8 +140,6 @@ public:
     void harvestStats(AvatarMixerSlaveStats& stats);
 
 private:
-    int sendIdentityPacket(const AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode);
-
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -100,6 +147,25 @@ private:
     p_high_resolution_clock::time_point _lastFrameTimestamp;
     float _maxKbpsPerNode { 0.0f };
     float _throttlingRatio { 0.0f };
+    bool _scheduleUpdates { false };
+    const std::vector<AvatarMixerSnapshot>* _snapshots { nullptr };
+    const AvatarMixerSnapshotBounds* _snapshotBounds { nullptr };
+
+    // the snapshots in the view of the receiver, reused across receivers
+    std::vector<uint32_t> _spheresInView;
+    std::vector<uint32_t> _boxesInKeyhole;
+
+    // sort state, reused across receivers
+    struct SortedAvatar {
+        float priority;
+        int index; // into _snapshots
+        bool operator>(const SortedAvatar& other) const { return priority > other.priority; }
+    };
+    std::vector<SortedAvatar> _sortedAvatars;
+
+    // seeded once per slave; only used to pick the occasional full update, so a small fast generator suffices
+    std::minstd_rand _generator { std::random_device()() };
+    std::uniform_real_distribution<float> _distribution;
 
     AvatarMixerSlaveStats _stats;
 };
@@ -12,6 +12,8 @@
 #include <assert.h>
 #include <algorithm>
 
+#include "AvatarMixerClientData.h"
+
 #include "AvatarMixerSlavePool.h"
 
 void AvatarMixerSlaveThread::run() {
@@ -19,9 +21,9 @@ void AvatarMixerSlaveThread::run() {
         wait();
 
         // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        ConstIter node;
+        while (try_claim(node)) {
+            (this->*_function)(*node);
         }
 
         bool stopping = _stop;
@@ -59,8 +61,14 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+bool AvatarMixerSlaveThread::try_claim(ConstIter& node) {
+    // one node at a time, since their costs vary a lot
+    auto index = _pool._nextIndex.fetch_add(1, std::memory_order_relaxed);
+    if (index >= _pool._numNodes) {
+        return false;
+    }
+    node = _pool._begin + index;
+    return true;
 }
 
 #ifdef AVATAR_SINGLE_THREADED
@@ -77,12 +85,55 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                      p_high_resolution_clock::time_point lastFrameTimestamp, 
-                                     float maxKbpsPerNode, float throttlingRatio) {
+                                     float maxKbpsPerNode, float throttlingRatio, bool scheduleUpdates) {
+    // snapshot every sender once, for all receivers to share
+    quint64 now = usecTimestampNow();
+    auto addSnapshot = [&](const SharedNodePointer& node, AvatarMixerClientData* avatarData, const QUuid& id) {
+        glm::vec3 position = avatarData->getPosition();
+        glm::vec3 boundingBoxCorner = avatarData->getGlobalBoundingBoxCorner();
+        glm::vec3 boxHalfScale = position - boundingBoxCorner;
+        float boundingRadius = glm::max(boxHalfScale.x, glm::max(boxHalfScale.y, boxHalfScale.z));
+        float speed = avatarData->updateSpeed(position, now);
+
+        _snapshots.push_back({ node, avatarData, id, position, boundingBoxCorner, boundingRadius, speed,
+            avatarData->getLastReceivedSequenceNumber() });
+
+        // the box of the detail sent is around the position the client sent, as AvatarMixerClientData::otherAvatarInView
+        glm::vec3 clientPosition = avatarData->getConstAvatarData()->getClientGlobalPosition();
+        _snapshotBounds.spheres.push_back(position, boundingRadius);
+        _snapshotBounds.boxes.push_back(AABox(boundingBoxCorner, (clientPosition - boundingBoxCorner) * 2.0f));
+    };
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+
+        // theoretically it's possible for a Node to be in the NodeList (and therefore end up here),
+        // but not have yet sent data that's linked to the node. Check for that case and don't
+        // consider those nodes.
+        if (nodeData) {
+            // an agent that only hosts bots is not an avatar itself
+            if (nodeData->hasReceivedAvatarData() || nodeData->getHostedAvatars().empty()) {
+                addSnapshot(node, nodeData, node->getUUID());
+            }
+
+            // the hosted avatars are sent to the others like the avatars of nodes, by the id they were announced with
+            for (const auto& hostedAvatar : nodeData->getHostedAvatars()) {
+                if (hostedAvatar.second->hasReceivedAvatarData()) {
+                    addSnapshot(node, hostedAvatar.second.get(), hostedAvatar.first);
+                }
+            }
+        }
+    });
+
     _function = &AvatarMixerSlave::broadcastAvatarData;
     _configure = [&](AvatarMixerSlave& slave) { 
-        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio);
+        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio, scheduleUpdates,
+            &_snapshots, &_snapshotBounds);
    };
     run(begin, end);
+
+    // release the node references (but keep the capacity) until the next frame
+    _snapshots.clear();
+    _snapshotBounds.clear();
 }
 
 void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
@@ -95,10 +146,9 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         _function(slave, node);
 });
 #else
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.emplace(node);
-    });
+    // the range is a snapshot of the nodes, so the slaves share it by index instead of through a queue
+    _numNodes = std::distance(_begin, _end);
+    _nextIndex = 0;
 
     {
         Lock lock(_mutex);
@@ -116,7 +166,7 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    assert(_nextIndex >= _numNodes);
 #endif
 }
 
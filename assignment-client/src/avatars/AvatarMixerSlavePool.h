@@ -12,12 +12,11 @@
 #ifndef hifi_AvatarMixerSlavePool_h
 #define hifi_AvatarMixerSlavePool_h
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
 
-#include <tbb/concurrent_queue.h>
-
 #include <QThread>
 
 #include <NodeList.h>
@@ -42,7 +41,7 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    bool try_claim(ConstIter& node);
 
     AvatarMixerSlavePool& _pool;
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
@@ -52,7 +51,6 @@ private:
 // Slave pool for audio mixers
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -66,7 +64,8 @@ public:
     // Jobs the slave pool can do...
     void processIncomingPackets(ConstIter begin, ConstIter end);
     void broadcastAvatarData(ConstIter begin, ConstIter end, 
-                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio);
+                    p_high_resolution_clock::time_point lastFrameTimestamp, float maxKbpsPerNode, float throttlingRatio,
+                    bool scheduleUpdates);
 
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
@@ -82,7 +81,7 @@ private:
 
     friend void AvatarMixerSlaveThread::wait();
     friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AvatarMixerSlaveThread::try_claim(ConstIter& node);
 
     // synchronization state
     Mutex _mutex;
@@ -96,9 +95,12 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
     ConstIter _begin;
     ConstIter _end;
+    size_t _numNodes { 0 };
+    std::atomic<size_t> _nextIndex { 0 }; // the slaves claim the nodes of [_begin, _end) by index
+    std::vector<AvatarMixerSnapshot> _snapshots;
+    AvatarMixerSnapshotBounds _snapshotBounds;
 };
 
 #endif // hifi_AvatarMixerSlavePool_h
@@ -16,6 +16,9 @@
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <EntityEditFilters.h>
+#include <EntityEditPacketSender.h>
+#include <UUID.h>
+#include <shared/FixedSizePool.h>
 
 #include "AssignmentParentFinder.h"
 #include "EntityNodeData.h"
@@ -36,8 +39,11 @@ EntityServer::EntityServer(ReceivedMessage& message) :
     DependencyManager::set<ScriptCache>();
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::EntityAdd, PacketType::EntityEdit, PacketType::EntityErase, PacketType::EntityPhysics },
+    packetReceiver.registerListenerForTypes({ PacketType::EntityAdd, PacketType::EntityEdit, PacketType::EntityErase,
+                                              PacketType::EntityPhysics, PacketType::EntityPhysicsPacked },
                                             this, "handleEntityPacket");
+    packetReceiver.registerListener(PacketType::Jurisdiction, this, "handleJurisdictionPacket");
+    packetReceiver.registerListener(PacketType::EntityServerDirectory, this, "handleEntityServerDirectoryPacket");
 }
 
 EntityServer::~EntityServer() {
@@ -46,6 +52,23 @@ EntityServer::~EntityServer() {
         _pruneDeletedEntitiesTimer->deleteLater();
     }
 
+    if (_sharePeerEntitiesTimer) {
+        _sharePeerEntitiesTimer->stop();
+        _sharePeerEntitiesTimer->deleteLater();
+    }
+
+    if (_peerJurisdictionListener) {
+        _peerJurisdictionListener->terminating();
+        _peerJurisdictionListener->terminate();
+        _peerJurisdictionListener->deleteLater();
+    }
+
+    if (_migrationPacketSender) {
+        _migrationPacketSender->terminating();
+        _migrationPacketSender->terminate();
+        _migrationPacketSender->deleteLater();
+    }
+
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     tree->removeNewlyCreatedHook(this);
 }
@@ -56,6 +79,12 @@ void EntityServer::handleEntityPacket(QSharedPointer<ReceivedMessage> message, S
     }
 }
 
+void EntityServer::handleJurisdictionPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (_peerJurisdictionListener) {
+        _peerJurisdictionListener->queueReceivedPacket(message, senderNode);
+    }
+}
+
 std::unique_ptr<OctreeQueryNode> EntityServer::createOctreeQueryNode() {
     return std::unique_ptr<OctreeQueryNode> { new EntityNodeData() };
 }
@@ -64,6 +93,9 @@ OctreePointer EntityServer::createTree() {
     EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
+
+    // lets the send threads of clients with an unchanged view send only what changed
+    tree->setWantChangeLog(true);
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
         simpleSimulation->setEntityTree(tree);
@@ -87,6 +119,29 @@ void EntityServer::beforeRun() {
     connect(_pruneDeletedEntitiesTimer, SIGNAL(timeout()), this, SLOT(pruneDeletedEntities()));
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
     _pruneDeletedEntitiesTimer->start(PRUNE_DELETED_MODELS_INTERVAL_MSECS);
+
+    // with a jurisdiction this is one of several entity servers, each owning the entities in its part of the domain
+    if (_jurisdiction) {
+        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+        tree->setJurisdiction(*_jurisdiction);
+
+        DependencyManager::get<NodeList>()->addNodeTypeToInterestSet(NodeType::EntityServer);
+
+        _peerJurisdictionListener = new JurisdictionListener(NodeType::EntityServer);
+        _peerJurisdictionListener->initialize(true);
+
+        _migrationPacketSender = new EntityEditPacketSender();
+        _migrationPacketSender->initialize(true);
+
+        // the entities this server owns, for the directories of its peers
+        connect(tree.get(), &EntityTree::addingEntity, this, &EntityServer::ownedEntityAdded, Qt::DirectConnection);
+        connect(tree.get(), &EntityTree::deletingEntity, this, &EntityServer::ownedEntityDeleting, Qt::DirectConnection);
+
+        _sharePeerEntitiesTimer = new QTimer();
+        connect(_sharePeerEntitiesTimer, &QTimer::timeout, this, &EntityServer::sharePeerEntities);
+        const int SHARE_PEER_ENTITIES_INTERVAL_MSECS = 1 * 1000; // once every second
+        _sharePeerEntitiesTimer->start(SHARE_PEER_ENTITIES_INTERVAL_MSECS);
+    }
 }
 
 void EntityServer::entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
@@ -213,6 +268,7 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
                     // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
                     deletesPacket->write(entityID.toRfc4122());
                     ++numberOfIDs;
+                    nodeData->forgetSentEntity(entityID);
 
                     #ifdef EXTRA_ERASE_DEBUGGING
                         qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
@@ -329,11 +385,147 @@ void EntityServer::nodeAdded(SharedNodePointer node) {
 
 void EntityServer::nodeKilled(SharedNodePointer node) {
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    if (node->getType() == NodeType::EntityServer) {
+        tree->forgetPeerEntityOwners(node->getUUID());
+        _peersWithDirectory.remove(node->getUUID());
+        if (_peerJurisdictionListener) {
+            _peerJurisdictionListener->nodeKilled(node);
+        }
+    }
     tree->deleteDescendantsOfAvatar(node->getUUID());
     tree->forgetAvatarID(node->getUUID());
     OctreeServer::nodeKilled(node);
 }
 
+void EntityServer::ownedEntityAdded(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> locker(_ownedEntityChangesLock);
+    _removedOwnedEntityIDs.remove(entityID);
+    _addedOwnedEntityIDs.insert(entityID);
+}
+
+void EntityServer::ownedEntityDeleting(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> locker(_ownedEntityChangesLock);
+    _addedOwnedEntityIDs.remove(entityID);
+    _removedOwnedEntityIDs.insert(entityID);
+}
+
+bool EntityServer::isOwnedByPeer(const glm::vec3& position) {
+    bool isOwned = false;
+    NodeToJurisdictionMap& jurisdictions = *_peerJurisdictionListener->getJurisdictions();
+    jurisdictions.withReadLock([&] {
+        for (auto it = jurisdictions.constBegin(); it != jurisdictions.constEnd() && !isOwned; ++it) {
+            isOwned = it.value().isMyJurisdiction(position);
+        }
+    });
+    return isOwned;
+}
+
+void EntityServer::sendEntityServerDirectory(const SharedNodePointer& node, bool isFullList,
+                                             const QVector<EntityItemID>& added, const QVector<EntityItemID>& removed) {
+    auto directoryPacketList = NLPacketList::create(PacketType::EntityServerDirectory, QByteArray(), true, true);
+    directoryPacketList->writePrimitive(isFullList);
+    for (const auto& entityIDs : { &added, &removed }) {
+        directoryPacketList->writePrimitive((quint32)entityIDs->size());
+        for (const auto& entityID : *entityIDs) {
+            directoryPacketList->write(entityID.toRfc4122());
+        }
+    }
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(directoryPacketList), *node);
+}
+
+void EntityServer::handleEntityServerDirectoryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (!_jurisdiction || senderNode->getType() != NodeType::EntityServer) {
+        return;
+    }
+
+    bool isFullList;
+    message->readPrimitive(&isFullList);
+    QVector<EntityItemID> entityIDs[2]; // added, removed
+    for (auto& ids : entityIDs) {
+        quint32 numIDs = 0;
+        message->readPrimitive(&numIDs);
+        numIDs = std::min(numIDs, (quint32)(message->getBytesLeftToRead() / NUM_BYTES_RFC4122_UUID));
+        ids.reserve(numIDs);
+        for (quint32 i = 0; i < numIDs; ++i) {
+            ids.push_back(QUuid::fromRfc4122(message->read(NUM_BYTES_RFC4122_UUID)));
+        }
+    }
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    tree->updatePeerEntityOwners(senderNode->getUUID(), entityIDs[0], entityIDs[1], isFullList);
+}
+
+void EntityServer::sharePeerEntities() {
+    migrateEntities();
+
+    QVector<EntityItemID> added;
+    QVector<EntityItemID> removed;
+    {
+        std::lock_guard<std::mutex> locker(_ownedEntityChangesLock);
+        added = _addedOwnedEntityIDs.toList().toVector();
+        removed = _removedOwnedEntityIDs.toList().toVector();
+        _addedOwnedEntityIDs.clear();
+        _removedOwnedEntityIDs.clear();
+    }
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        if (node->getType() != NodeType::EntityServer || !node->getActiveSocket()) {
+            return;
+        }
+        if (!_peersWithDirectory.contains(node->getUUID())) {
+            // a new peer starts with the whole list of what we own, and gets the changes from then on
+            _peersWithDirectory.insert(node->getUUID());
+            sendEntityServerDirectory(node, true, tree->getEntityIDs(), QVector<EntityItemID>());
+        } else if (!added.isEmpty() || !removed.isEmpty()) {
+            sendEntityServerDirectory(node, false, added, removed);
+        }
+    });
+}
+
+void EntityServer::migrateEntities() {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+
+    // an entity goes out as an add, the peer that owns its position or its parent keeps it and the others ignore it
+    QVector<EntityItemID> migratedIDs;
+    tree->withReadLock([&] {
+        QVector<EntityItemID> entityIDs = tree->findEntitiesToMigrate([this](const glm::vec3& position) {
+            return isOwnedByPeer(position);
+        });
+        for (const auto& entityID : entityIDs) {
+            EntityItemPointer entity = tree->findEntityByEntityItemID(entityID);
+            if (!entity) {
+                continue;
+            }
+            EntityItemProperties properties = entity->getProperties();
+            properties.markAllChanged();
+
+            QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityAdd), 0);
+            if (EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entityID, properties, bufferOut)) {
+                _migrationPacketSender->queueOctreeEditMessage(PacketType::EntityAdd, bufferOut);
+                migratedIDs.push_back(entityID);
+            } else {
+                qDebug() << "Entity" << entityID << "doesn't fit an edit packet, it stays on this server";
+            }
+        }
+    });
+    if (migratedIDs.isEmpty()) {
+        return;
+    }
+    _migrationPacketSender->releaseQueuedMessages();
+
+    tree->withWriteLock([&] {
+        tree->removeMigratedEntities(migratedIDs);
+    });
+    qDebug() << "Handed" << migratedIDs.size() << "entities over to other entity servers";
+
+    // the peer that has them now tells the others, and until it does they still find them listed under this server
+    std::lock_guard<std::mutex> locker(_ownedEntityChangesLock);
+    for (const auto& entityID : migratedIDs) {
+        _removedOwnedEntityIDs.remove(entityID);
+    }
+}
+
 // FIXME - this stats tracking is somewhat temporary to debug the Whiteboard issues. It's not a bad
 // set of stats to have, but we'd probably want a different data structure if we keep it very long.
 // Since this version uses a single shared QMap for all senders, there could be some lock contention 
@@ -359,6 +551,36 @@ QString EntityServer::serverSubclassStats() {
     statsString += "<b>Entity Server Memory Statistics</b>\r\n";
     statsString += QString().sprintf("EntityTreeElement size... %ld bytes\r\n", sizeof(EntityTreeElement));
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
+    statsString += "\r\n";
+
+    // the pools the entities and the elements of the tree are allocated from
+    statsString += "----- Pool ------------------------------------------------    Block Size      Used  Capacity\r\n";
+    for (const auto& pool : FixedSizePool::getAllStats()) {
+        statsString += QString("%1 %2 %3 %4\r\n")
+            .arg(QString(pool.name), -60)
+            .arg(pool.blockSize, 13)
+            .arg(pool.used, 9)
+            .arg(pool.capacity, 9);
+    }
+    statsString += "\r\n\r\n";
+
+    // the edit filter scripts, the null zone ID is the domain's filter
+    statsString += "<b>Entity Edit Filter Statistics</b>\r\n";
+    statsString += "----- Zone ID --------------------------    Engines      Calls  Avg usecs  Max usecs   Rejected"
+                   "  Rule Passes  Rule Rejects\r\n";
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    for (const auto& filter : entityEditFilters->getStats()) {
+        statsString += QString("%1 %2 %3 %4 %5 %6 %7 %8    %9\r\n")
+            .arg(filter.entityID.toString(), -40)
+            .arg(filter.numEngines, 10)
+            .arg(filter.calls, 10)
+            .arg(filter.calls > 0 ? filter.totalUsecs / filter.calls : 0, 10)
+            .arg(filter.maxUsecs, 10)
+            .arg(filter.rejected, 10)
+            .arg(filter.passedByRules, 12)
+            .arg(filter.rejectedByRules, 13)
+            .arg(filter.url);
+    }
     statsString += "\r\n\r\n";
 
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
@@ -15,6 +15,9 @@
 #include "../octree/OctreeServer.h"
 
 #include <memory>
+#include <mutex>
+
+#include <JurisdictionListener.h>
 
 #include "EntityItem.h"
 #include "EntityServerConsts.h"
@@ -27,6 +30,7 @@ struct ViewerSendingStats {
     quint64 lastEdited;
 };
 
+class EntityEditPacketSender;
 class SimpleEntitySimulation;
 using SimpleEntitySimulationPointer = std::shared_ptr<SimpleEntitySimulation>;
 
@@ -71,11 +75,30 @@ protected:
 
 private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleJurisdictionPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleEntityServerDirectoryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void ownedEntityAdded(const EntityItemID& entityID);
+    void ownedEntityDeleting(const EntityItemID& entityID);
+    void sharePeerEntities();
 
 private:
+    bool isOwnedByPeer(const glm::vec3& position);
+    void sendEntityServerDirectory(const SharedNodePointer& node, bool isFullList,
+                                   const QVector<EntityItemID>& added, const QVector<EntityItemID>& removed);
+    void migrateEntities();
+
     SimpleEntitySimulationPointer _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
+    // with a jurisdiction, the other entity servers of the domain and what they own
+    JurisdictionListener* _peerJurisdictionListener { nullptr };
+    EntityEditPacketSender* _migrationPacketSender { nullptr }; // hands entities over to the peer that owns them now
+    QTimer* _sharePeerEntitiesTimer { nullptr };
+    std::mutex _ownedEntityChangesLock;
+    QSet<EntityItemID> _addedOwnedEntityIDs; // since the peers were last told
+    QSet<EntityItemID> _removedOwnedEntityIDs;
+    QSet<QUuid> _peersWithDirectory; // the peers that have been sent the whole list
+
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 };
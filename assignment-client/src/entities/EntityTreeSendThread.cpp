@@ -130,3 +130,37 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
 }
 
 
+
+bool EntityTreeSendThread::addChangesToElementBag(OctreeQueryNode* nodeData, bool canSendChangesOnly) {
+    auto entityNodeData = static_cast<EntityNodeData*>(nodeData);
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+
+    // this scene covers every change logged up to here, whichever way it is sent
+    uint64_t sequence = entityTree->getChangeLogSequence();
+    bool hadCursor = entityNodeData->hasChangeLogCursor();
+    uint64_t cursor = entityNodeData->getChangeLogCursor();
+    entityNodeData->setChangeLogCursor(sequence);
+
+    // JSON filters can match entities that didn't change, so filtered nodes keep traversing the tree
+    if (!canSendChangesOnly || !hadCursor || !entityNodeData->getJSONParameters().isEmpty()) {
+        return false;
+    }
+
+    QSet<EntityItemID> changedEntityIDs;
+    if (!entityTree->getEntityChangesSince(cursor, changedEntityIDs)) {
+        // more changed than the log holds since our last scene
+        return false;
+    }
+
+    // deleted entities are no longer found here, they are sent by EntityServer::sendSpecialPackets
+    entityTree->withReadLock([&] {
+        foreach(const EntityItemID& entityID, changedEntityIDs) {
+            auto entity = entityTree->findEntityByEntityItemID(entityID);
+            if (entity && entity->getElement()) {
+                nodeData->elementBag.insert(entity->getElement());
+            }
+        }
+    });
+
+    return true;
+}
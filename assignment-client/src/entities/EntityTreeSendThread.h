@@ -24,6 +24,8 @@ public:
 
 protected:
     virtual void preDistributionProcessing() override;
+    virtual bool addChangesToElementBag(OctreeQueryNode* nodeData, bool canSendChangesOnly) override;
+    virtual bool tracksSentData() const override { return true; } // in EntityNodeData
 
 private:
     // the following two methods return booleans to indicate if any extra flagged entities were new additions to set
@@ -24,6 +24,7 @@ int main(int argc, char* argv[]) {
     QCoreApplication::setApplicationVersion(BuildInfo::VERSION);
 
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
+    LogHandler::getInstance().setupFromEnvironment();
     qInfo() << "Starting.";
 
     AssignmentClientApp app(argc, argv);
@@ -15,12 +15,21 @@
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 #include "MessagesMixer.h"
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 
-MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
+MessagesMixer::MessagesMixer(ReceivedMessage& message) :
+    ThreadedAssignment(message),
+    _messagesReceivedMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_messages_mixer_messages_received_total",
+        "The messages received")),
+    _messagesSentMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_messages_mixer_messages_sent_total",
+        "The messages forwarded to the subscribers")),
+    _bytesSentMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_messages_mixer_bytes_sent_total",
+        "The bytes of the messages forwarded to the subscribers"))
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -30,40 +39,74 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto nodeChannels = _nodeChannels.take(killedNode->getUUID());
+    for (auto& channelName : nodeChannels) {
+        unsubscribe(channelName, killedNode->getUUID());
+    }
+}
+
+void MessagesMixer::unsubscribe(const QString& channelName, const QUuid& nodeID) {
+    auto it = _channels.find(channelName);
+    if (it != _channels.end()) {
+        // an empty channel is kept until its stats are sent
+        it->subscribers.remove(nodeID);
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    QString channelName = MessagesClient::decodeMessagesChannel(receivedMessage);
+    _messagesReceivedMetric.increment();
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto it = _channels.find(channelName);
+    if (it == _channels.end() || it->subscribers.isEmpty()) {
+        return;
+    }
+    Channel& channel = *it;
+    channel.messagesReceived++;
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
+    if (_maxChannelMessagesPerSecond > 0) {
+        quint64 now = usecTimestampNow();
+        if (now - channel.rateWindowStart >= USECS_PER_SECOND) {
+            channel.rateWindowStart = now;
+            channel.rateWindowMessages = 0;
+        }
+        if (channel.rateWindowMessages >= _maxChannelMessagesPerSecond) {
+            channel.messagesDropped++;
+            return;
+        }
+        channel.rateWindowMessages++;
+    }
+
+    // the mixer forwards the message as it was encoded by the sender, each subscriber gets a copy of the same payload
+    QByteArray payload = receivedMessage->getMessage();
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto& node : channel.subscribers) {
+        if (!node->getActiveSocket()) {
+            continue;
+        }
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        packetList->write(payload);
         nodeList->sendPacketList(std::move(packetList), *node);
-    });
+        channel.messagesSent++;
+        channel.bytesSent += payload.size();
+        _messagesSentMetric.increment();
+        _bytesSentMetric.increment(payload.size());
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    QString channelName = QString::fromUtf8(message->getMessage());
+    _channels[channelName].subscribers.insert(senderNode->getUUID(), senderNode);
+    _nodeChannels[senderNode->getUUID()].insert(channelName);
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    QString channelName = QString::fromUtf8(message->getMessage());
+    unsubscribe(channelName, senderNode->getUUID());
+    auto it = _nodeChannels.find(senderNode->getUUID());
+    if (it != _nodeChannels.end()) {
+        it->remove(channelName);
     }
 }
 
@@ -80,11 +123,54 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for each channel, and forget the channels left without subscribers
+    QJsonObject channelsObject;
+    for (auto it = _channels.begin(); it != _channels.end();) {
+        Channel& channel = *it;
+        QJsonObject channelStats;
+        channelStats["subscribers"] = channel.subscribers.size();
+        channelStats["messages_received"] = channel.messagesReceived;
+        channelStats["messages_dropped"] = channel.messagesDropped;
+        channelStats["messages_sent"] = channel.messagesSent;
+        channelStats["bytes_sent"] = (double)channel.bytesSent;
+        channelsObject[it.key()] = channelStats;
+
+        channel.messagesReceived = 0;
+        channel.messagesDropped = 0;
+        channel.messagesSent = 0;
+        channel.bytesSent = 0;
+
+        if (channel.subscribers.isEmpty()) {
+            it = _channels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void MessagesMixer::run() {
+    // the settings only tune the mixer, which starts forwarding before they arrive
+    DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::settingsReceived, this, &MessagesMixer::domainSettingsRequestComplete);
+
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 }
+
+void MessagesMixer::domainSettingsRequestComplete() {
+    const QString MESSAGES_MIXER_SETTINGS_KEY = "messages_mixer";
+    QJsonObject messagesMixerGroupObject =
+        DependencyManager::get<NodeList>()->getDomainHandler().getSettingsObject()[MESSAGES_MIXER_SETTINGS_KEY].toObject();
+
+    const QString MAX_CHANNEL_MESSAGES_PER_SECOND_KEY = "max_channel_messages_per_second";
+    _maxChannelMessagesPerSecond = std::max(messagesMixerGroupObject[MAX_CHANNEL_MESSAGES_PER_SECOND_KEY].toVariant().toInt(), 0);
+    if (_maxChannelMessagesPerSecond > 0) {
+        qDebug() << "Messages mixer will forward at most" << _maxChannelMessagesPerSecond << "messages per second on each channel.";
+    } else {
+        qDebug() << "Messages mixer will not limit the message rate of the channels.";
+    }
+}
@@ -15,6 +15,7 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <Metrics.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -29,12 +30,36 @@ public slots:
     void sendStatsPacket() override;
 
 private slots:
+    void domainSettingsRequestComplete();
     void handleMessages(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    struct Channel {
+        QHash<QUuid, SharedNodePointer> subscribers;
+
+        // the messages forwarded in the current second, for the rate limit
+        quint64 rateWindowStart { 0 };
+        int rateWindowMessages { 0 };
+
+        // since the last stats packet
+        int messagesReceived { 0 };
+        int messagesDropped { 0 };
+        int messagesSent { 0 };
+        qint64 bytesSent { 0 };
+    };
+
+    void unsubscribe(const QString& channelName, const QUuid& nodeID);
+
+    QHash<QString, Channel> _channels;
+    QHash<QUuid, QSet<QString>> _nodeChannels; // the channels each node subscribed to
+
+    int _maxChannelMessagesPerSecond { 0 }; // 0 for no limit
+
+    MetricCounter& _messagesReceivedMetric;
+    MetricCounter& _messagesSentMetric;
+    MetricCounter& _bytesSentMetric;
 };
 
 #endif // hifi_MessagesMixer_h
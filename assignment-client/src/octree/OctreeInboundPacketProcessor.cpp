@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <limits>
 
 #include <NumericalConstants.h>
@@ -31,7 +32,13 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalElementsInPacket(0),
     _totalPackets(0),
     _lastNackTime(usecTimestampNow()),
-    _shuttingDown(false)
+    _shuttingDown(false),
+    _editPacketsMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_octree_server_edit_packets_total",
+        "The edit packets applied")),
+    _editsMetric(DependencyManager::get<MetricsRegistry>()->counter("hifi_octree_server_edits_total",
+        "The edits applied")),
+    _processSecondsMetric(DependencyManager::get<MetricsRegistry>()->histogram("hifi_octree_server_edit_packet_seconds",
+        "The time to apply an edit packet", MetricHistogram::exponentialBounds(0.00001, 4.0, 8)))
 {
 }
 
@@ -212,6 +219,170 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+// at most this many packets are applied under one acquisition of the write lock, so the send threads still get to read
+const int MAX_PACKETS_PER_DECODED_BATCH = 32;
+
+class OctreeInboundPacketProcessor::DecodeTask : public QRunnable {
+public:
+    DecodeTask(OctreePointer tree, DecodedPacket& packet, QSemaphore& decoded) :
+        _tree(tree), _packet(packet), _decoded(decoded) { }
+
+    void run() override {
+        quint64 startDecode = usecTimestampNow();
+
+        // read the edits without moving the message, which belongs to the processing thread
+        ReceivedMessage& message = *_packet.message;
+        PacketType packetType = message.getType();
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(message.getRawMessage());
+        qint64 position = message.getPosition();
+        qint64 size = message.getSize();
+
+        while (position < size) {
+            OctreeDecodedEditPointer decodedEdit;
+            int editDataBytesRead = _tree->decodeEditPacketData(packetType, data + position, (int)(size - position),
+                                                                _packet.sendingNode, decodedEdit);
+            if (decodedEdit) {
+                _packet.edits.push_back(std::move(decodedEdit));
+            }
+            if (editDataBytesRead <= 0) {
+                break;
+            }
+            position += editDataBytesRead;
+        }
+
+        _packet.decodeTime = usecTimestampNow() - startDecode;
+        _decoded.release();
+    }
+
+private:
+    OctreePointer _tree;
+    DecodedPacket& _packet;
+    QSemaphore& _decoded;
+};
+
+void OctreeInboundPacketProcessor::setNumDecodeThreads(int numThreads) {
+    _numDecodeThreads = std::max(numThreads, 0);
+    if (_numDecodeThreads > 0) {
+        _decodePool.setMaxThreadCount(_numDecodeThreads);
+        qDebug() << "Decoding inbound edits with" << _numDecodeThreads << "threads";
+    }
+}
+
+void OctreeInboundPacketProcessor::processPackets(std::list<NodeSharedReceivedMessagePair>& packets) {
+    if (_numDecodeThreads == 0 || _shuttingDown) {
+        ReceivedPacketProcessor::processPackets(packets);
+        return;
+    }
+
+    // Each batch is decoded on the pool while the one before it is applied. The batches, the packets in them and
+    // the edits in those are applied in the order they were received, so each entity still sees its edits in order.
+    auto packetIt = packets.begin();
+    auto batch = startDecodingBatch(packetIt, packets.end());
+    while (batch) {
+        auto nextBatch = startDecodingBatch(packetIt, packets.end());
+        applyBatch(*batch);
+        batch = std::move(nextBatch);
+    }
+}
+
+std::unique_ptr<OctreeInboundPacketProcessor::DecodedBatch> OctreeInboundPacketProcessor::startDecodingBatch(
+        std::list<NodeSharedReceivedMessagePair>::iterator& packetIt,
+        std::list<NodeSharedReceivedMessagePair>::iterator packetsEnd) {
+    if (packetIt == packetsEnd) {
+        return nullptr;
+    }
+
+    auto tree = _myServer->getOctree();
+    std::unique_ptr<DecodedBatch> batch { new DecodedBatch() };
+    batch->packets.reserve(MAX_PACKETS_PER_DECODED_BATCH);
+
+    for (; packetIt != packetsEnd && (int)batch->packets.size() < MAX_PACKETS_PER_DECODED_BATCH; ++packetIt) {
+        auto& message = packetIt->second;
+        if (!tree->handlesEditPacketType(message->getType())) {
+            qDebug("unknown packet ignored... packetType=%hhu", (unsigned char)message->getType());
+            _lastWindowProcessedPackets++;
+            continue;
+        }
+
+        DecodedPacket packet;
+        packet.message = message;
+        packet.sendingNode = packetIt->first;
+        packet.isDecoded = tree->decodesEditPacketType(message->getType());
+
+        message->readPrimitive(&packet.sequence);
+
+        quint64 sentAt;
+        message->readPrimitive(&sentAt);
+        quint64 arrivedAt = usecTimestampNow();
+        packet.transitTime = sentAt > arrivedAt ? 0 : arrivedAt - sentAt;
+
+        batch->packets.push_back(std::move(packet));
+    }
+
+    // the packets don't move once the tasks have started
+    for (auto& packet : batch->packets) {
+        if (packet.isDecoded) {
+            batch->numDecoding++;
+            _decodePool.start(new DecodeTask(tree, packet, batch->decoded));
+        }
+    }
+
+    return batch;
+}
+
+void OctreeInboundPacketProcessor::applyBatch(DecodedBatch& batch) {
+    batch.decoded.acquire(batch.numDecoding);
+
+    auto tree = _myServer->getOctree();
+    std::vector<quint64> processTimes(batch.packets.size(), 0);
+    std::vector<int> editsInPackets(batch.packets.size(), 0);
+
+    quint64 startLock = usecTimestampNow();
+    quint64 lockWaitTime = 0;
+    tree->withWriteLock([&] {
+        lockWaitTime = usecTimestampNow() - startLock;
+
+        for (size_t i = 0; i < batch.packets.size(); ++i) {
+            auto& packet = batch.packets[i];
+            ReceivedMessage& message = *packet.message;
+            quint64 startProcess = usecTimestampNow();
+
+            if (packet.isDecoded) {
+                for (auto& decodedEdit : packet.edits) {
+                    tree->processDecodedEdit(message.getType(), *decodedEdit, packet.sendingNode);
+                }
+                editsInPackets[i] = (int)packet.edits.size();
+            } else {
+                while (message.getBytesLeftToRead() > 0) {
+                    auto editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+                    int editDataBytesRead = tree->processEditPacketData(message, editData,
+                                                                        (int)message.getBytesLeftToRead(), packet.sendingNode);
+                    editsInPackets[i]++;
+                    if (editDataBytesRead <= 0) {
+                        break;
+                    }
+                    message.seek(message.getPosition() + editDataBytesRead);
+                }
+            }
+
+            processTimes[i] = packet.decodeTime + usecTimestampNow() - startProcess;
+        }
+    });
+
+    for (size_t i = 0; i < batch.packets.size(); ++i) {
+        auto& packet = batch.packets[i];
+        _receivedPacketCount++;
+        _lastWindowProcessedPackets++;
+
+        QUuid nodeUUID = packet.sendingNode ? packet.sendingNode->getUUID() : QUuid();
+        // only the first packet of the batch waited for the lock
+        trackInboundPacket(nodeUUID, packet.sequence, packet.transitTime, editsInPackets[i], processTimes[i],
+                           i == 0 ? lockWaitTime : 0);
+    }
+
+    midProcess();
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
@@ -221,6 +392,10 @@ void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, uns
     _totalElementsInPacket += editsInPacket;
     _totalPackets++;
 
+    _editPacketsMetric.increment();
+    _editsMetric.increment(editsInPacket);
+    _processSecondsMetric.observe((double)processTime / USECS_PER_SECOND);
+
     QWriteLocker locker(&_senderStatsLock);
 
     // find the individual senders stats and track them there too...
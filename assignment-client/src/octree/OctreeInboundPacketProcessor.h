@@ -14,6 +14,14 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <memory>
+#include <vector>
+
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+
+#include <Metrics.h>
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -76,9 +84,14 @@ public:
 
     virtual void terminating() override { _shuttingDown = true; ReceivedPacketProcessor::terminating(); }
 
+    /// decodes the edits of the queued packets on this many threads while the previous ones are applied, and applies them
+    /// in batches under one write lock - 0 decodes and applies each edit in turn, under its own lock
+    void setNumDecodeThreads(int numThreads);
+
 protected:
 
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets) override;
 
     virtual unsigned long getMaxWait() const override;
     virtual void preProcess() override;
@@ -88,6 +101,28 @@ private:
     int sendNackPackets();
 
 private:
+    class DecodeTask;
+
+    struct DecodedPacket {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sendingNode;
+        bool isDecoded { false }; // or applied as it is read, with processEditPacketData()
+        unsigned short int sequence { 0 };
+        quint64 transitTime { 0 };
+        quint64 decodeTime { 0 };
+        std::vector<OctreeDecodedEditPointer> edits;
+    };
+
+    struct DecodedBatch {
+        std::vector<DecodedPacket> packets;
+        int numDecoding { 0 };
+        QSemaphore decoded; // released once by each packet decoded on the pool
+    };
+
+    std::unique_ptr<DecodedBatch> startDecodingBatch(std::list<NodeSharedReceivedMessagePair>::iterator& packetIt,
+                                                     std::list<NodeSharedReceivedMessagePair>::iterator packetsEnd);
+    void applyBatch(DecodedBatch& batch);
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
@@ -105,5 +140,12 @@ private:
 
     std::atomic<uint64_t> _lastNackTime;
     bool _shuttingDown;
+
+    int _numDecodeThreads { 0 };
+    QThreadPool _decodePool;
+
+    MetricCounter& _editPacketsMetric;
+    MetricCounter& _editsMetric;
+    MetricHistogram& _processSecondsMetric;
 };
 #endif // hifi_OctreeInboundPacketProcessor_h
@@ -0,0 +1,144 @@
+//
+//  OctreeSendScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QtCore/QDebug>
+#include <QtCore/QProcessEnvironment>
+
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+int OctreeSendScheduler::getDefaultNumThreads() {
+    static const QString NUM_THREADS_ENV = "HIFI_OCTREE_SEND_THREADS";
+
+    bool ok = false;
+    int numThreads = QProcessEnvironment::systemEnvironment().value(NUM_THREADS_ENV).toInt(&ok);
+    if (!ok || numThreads <= 0) {
+        numThreads = std::max(QThread::idealThreadCount() - 1, 1);
+    }
+    return numThreads;
+}
+
+OctreeSendScheduler::OctreeSendScheduler(int numThreads) {
+    qDebug() << "Sending to octree clients with" << numThreads << "threads";
+
+    for (int i = 0; i < numThreads; ++i) {
+        _workers.emplace_back(new Worker(*this, i));
+        _workers.back()->start();
+    }
+}
+
+OctreeSendScheduler::~OctreeSendScheduler() {
+    {
+        std::lock_guard<std::mutex> locker(_lock);
+        _isStopping = true;
+        _wakeCondition.notify_all();
+    }
+
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+}
+
+void OctreeSendScheduler::add(OctreeSendThread* sendThread) {
+    std::lock_guard<std::mutex> locker(_lock);
+
+    auto& scheduledSend = _sends[sendThread];
+    schedule(sendThread, scheduledSend, usecTimestampNow());
+}
+
+void OctreeSendScheduler::remove(OctreeSendThread* sendThread) {
+    std::unique_lock<std::mutex> locker(_lock);
+
+    _processedCondition.wait(locker, [&] {
+        auto it = _sends.find(sendThread);
+        return it == _sends.end() || !it->second.isBeingProcessed;
+    });
+
+    // any entry left in the heap for this client is stale now, and will be skipped
+    _sends.erase(sendThread);
+}
+
+void OctreeSendScheduler::schedule(OctreeSendThread* sendThread, ScheduledSend& scheduledSend, quint64 deadline) {
+    // bumping the generation invalidates whatever entry the client already had in the heap
+    scheduledSend.generation = _nextGeneration++;
+    _heap.push({ deadline, sendThread, scheduledSend.generation });
+    _wakeCondition.notify_one();
+}
+
+void OctreeSendScheduler::work() {
+    std::unique_lock<std::mutex> locker(_lock);
+    while (!_isStopping) {
+        if (_heap.empty()) {
+            _wakeCondition.wait(locker);
+            continue;
+        }
+
+        auto now = usecTimestampNow();
+        auto entry = _heap.top();
+        if (entry.deadline > now) {
+            // sleep until the earliest deadline, or until an earlier one is scheduled
+            _wakeCondition.wait_for(locker, std::chrono::microseconds(entry.deadline - now));
+            continue;
+        }
+        _heap.pop();
+
+        auto it = _sends.find(entry.sendThread);
+        if (it == _sends.end() || it->second.generation != entry.generation) {
+            // removed since this entry was pushed
+            continue;
+        }
+        it->second.isBeingProcessed = true;
+
+        // process without the lock, so the other workers can take the next deadlines meanwhile
+        locker.unlock();
+
+        quint64 start = usecTimestampNow();
+        bool shouldContinue = entry.sendThread->process();
+        if (!shouldContinue) {
+            // queued to the server, the send thread is still alive since remove waits for this pass
+            emit entry.sendThread->finished();
+        }
+        quint64 end = usecTimestampNow();
+
+        locker.lock();
+
+        // remove waits for the pass to be done, so the client is still here
+        auto& scheduledSend = _sends[entry.sendThread];
+        scheduledSend.isBeingProcessed = false;
+
+        if (shouldContinue) {
+            // the next pass is due one send interval after this one started, or right away if this one overran
+            quint64 deadline = std::max(start + OCTREE_SEND_INTERVAL_USECS, end);
+            OctreeSendThread::_usleepTime += deadline - end;
+            OctreeSendThread::_usleepCalls++;
+
+            schedule(entry.sendThread, scheduledSend, deadline);
+        } else {
+            _sends.erase(entry.sendThread);
+        }
+
+        _processedCondition.notify_all();
+    }
+}
+
+OctreeSendScheduler::Worker::Worker(OctreeSendScheduler& scheduler, int index) :
+    _scheduler(scheduler)
+{
+    // set our QThread object name so we can identify this thread while debugging
+    setObjectName("Octree Send Worker " + QString::number(index));
+}
@@ -0,0 +1,93 @@
+//
+//  OctreeSendScheduler.h
+//  assignment-client/src/octree
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendScheduler_h
+#define hifi_OctreeSendScheduler_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QThread>
+
+class OctreeSendThread;
+
+/// Runs the send passes of every client of an octree server on a fixed pool of worker threads, earliest deadline first.
+/// Each client's OctreeSendThread is due once per send interval; a pass sends at most its packet budget and returns,
+/// so no more than one pass per worker holds the tree's read lock at a time, however many clients are connected.
+class OctreeSendScheduler {
+public:
+    // threads from HIFI_OCTREE_SEND_THREADS, or one less than the cores so the server's own threads still get one
+    static int getDefaultNumThreads();
+
+    OctreeSendScheduler(int numThreads = getDefaultNumThreads());
+    ~OctreeSendScheduler();
+
+    /// starts the send passes of a client, the first one right away
+    void add(OctreeSendThread* sendThread);
+
+    /// stops the send passes of a client, blocks until its current pass is done - it is never touched again once this returns
+    /// must not be called from a worker thread
+    void remove(OctreeSendThread* sendThread);
+
+    int getNumThreads() const { return (int)_workers.size(); }
+
+private:
+    class Worker;
+
+    struct ScheduledSend {
+        uint64_t generation { 0 }; // only the heap entry with the current generation is live
+        bool isBeingProcessed { false };
+    };
+
+    struct HeapEntry {
+        quint64 deadline;
+        OctreeSendThread* sendThread;
+        uint64_t generation;
+
+        // std::priority_queue is a max-heap, so order by latest deadline to process the earliest first
+        bool operator<(const HeapEntry& other) const { return deadline > other.deadline; }
+    };
+
+    OctreeSendScheduler(const OctreeSendScheduler& other) = delete;
+    OctreeSendScheduler& operator=(const OctreeSendScheduler& other) = delete;
+
+    void work();
+    void schedule(OctreeSendThread* sendThread, ScheduledSend& scheduledSend, quint64 deadline);
+
+    std::mutex _lock; // Protects everything below
+    std::condition_variable _wakeCondition; // new work, or an earlier deadline
+    std::condition_variable _processedCondition; // a send pass is done
+
+    std::unordered_map<OctreeSendThread*, ScheduledSend> _sends;
+    std::priority_queue<HeapEntry> _heap; // stale entries are skipped when popped
+    uint64_t _nextGeneration { 1 }; // never reused, so a stale entry can't match a new client at the same address
+    bool _isStopping { false };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+class OctreeSendScheduler::Worker : public QThread {
+public:
+    Worker(OctreeSendScheduler& scheduler, int index);
+
+protected:
+    void run() override { _scheduler.work(); }
+
+private:
+    OctreeSendScheduler& _scheduler;
+};
+
+#endif // hifi_OctreeSendScheduler_h
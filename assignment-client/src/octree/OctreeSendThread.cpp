@@ -9,15 +9,13 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
-#include <chrono>
-#include <thread>
-
 #include <NodeList.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
 
 #include "OctreeQueryNode.h"
+#include "OctreeSendScheduler.h"
 #include "OctreeSendThread.h"
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
@@ -33,7 +31,7 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
 {
     QString safeServerName("Octree");
 
-    // set our QThread object name so we can identify this thread while debugging
+    // set our object name so we can identify this client while debugging
     setObjectName(QString("Octree Send Thread (%1)").arg(uuidStringWithoutCurlyBraces(_nodeUuid)));
 
     if (_myServer) {
@@ -48,7 +46,12 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
 
 OctreeSendThread::~OctreeSendThread() {
     setIsShuttingDown();
-    
+
+    // wait for a pass that is under way, it exits early now that we're shutting down
+    if (_scheduler) {
+        _scheduler->remove(this);
+    }
+
     QString safeServerName("Octree");
     if (_myServer) {
         safeServerName = _myServer->getMyServerName();
@@ -65,6 +68,11 @@ void OctreeSendThread::setIsShuttingDown() {
     _isShuttingDown = true;
 }
 
+void OctreeSendThread::startSending(OctreeSendScheduler& scheduler) {
+    _scheduler = &scheduler;
+    _scheduler->add(this);
+}
+
 
 bool OctreeSendThread::process() {
     if (_isShuttingDown) {
@@ -73,8 +81,6 @@ bool OctreeSendThread::process() {
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
@@ -94,29 +100,8 @@ bool OctreeSendThread::process() {
         }
     }
 
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
-    }
-
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
-
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
-
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
-
-    }
-
-    return isStillRunning();  // keep running till they terminate us
+    // the scheduler has us do the next set of octree elements one send interval from now
+    return !_isShuttingDown;
 }
 
 AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
@@ -319,6 +304,12 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
     int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
 
+    // and within this server's share of what the node can receive
+    if (node->getBandwidthBudgetKbps() > 0) {
+        int budgetPacketsPerSecond = node->getBandwidthBudgetKbps() * BYTES_PER_KILOBIT / udt::MAX_PACKET_SIZE;
+        maxPacketsPerInterval = std::min(maxPacketsPerInterval, std::max(1, budgetPacketsPerSecond / INTERVALS_PER_SECOND));
+    }
+
     int truePacketsSent = 0;
     int trueBytesSent = 0;
     int packetsSentThisInterval = 0;
@@ -331,9 +322,15 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         // we aren't forcing a full scene, check if something else suggests we should
         isFullScene = nodeData->haveJSONParametersChanged() ||
             (nodeData->getUsesFrustum()
-             && ((!viewFrustumChanged && nodeData->getViewFrustumJustStoppedChanging()) || nodeData->hasLodChanged()));
+             && ((!viewFrustumChanged && nodeData->getViewFrustumJustStoppedChanging() && !tracksSentData())
+                 || nodeData->hasLodChanged()));
     }
 
+    // Once the view stops changing we make one more pass at full resolution, for what was skipped at the lower one
+    // used while it moved. When what was sent is tracked, this pass walks the whole view but only sends what's missing.
+    bool isSettlingView = !isFullScene && tracksSentData() && nodeData->getUsesFrustum() &&
+        !viewFrustumChanged && nodeData->getViewFrustumJustStoppedChanging();
+
     bool somethingToSend = true; // assume we have something
 
     // If our packet already has content in it, then we must use the color choice of the waiting packet.
@@ -392,13 +389,17 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                                      _myServer->getOctree()->getRoot(), _myServer->getJurisdiction());
 
         // This is the start of "resending" the scene.
-        bool dontRestartSceneOnMove = false; // this is experimental
-        if (dontRestartSceneOnMove) {
-            if (nodeData->elementBag.isEmpty()) {
+        // When the view is unchanged, only the elements holding what changed since the last scene may need to be sent
+        bool canSendChangesOnly = !isFullScene && !viewFrustumChanged && !isSettlingView;
+        if (!addChangesToElementBag(nodeData, canSendChangesOnly)) {
+            bool dontRestartSceneOnMove = false; // this is experimental
+            if (dontRestartSceneOnMove) {
+                if (nodeData->elementBag.isEmpty()) {
+                    nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
+                }
+            } else {
                 nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
             }
-        } else {
-            nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
         }
     }
 
@@ -442,8 +443,10 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                     int boundaryLevelAdjust = boundaryLevelAdjustClient +
                                               (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
 
+                    // while settling there is no last view to skip what was in, so nothing is skipped as unchanged
+                    bool useDeltaView = viewFrustumChanged || isSettlingView;
                     EncodeBitstreamParams params(INT_MAX, WANT_EXISTS_BITS, DONT_CHOP,
-                                                 viewFrustumChanged,
+                                                 useDeltaView,
                                                  boundaryLevelAdjust, octreeSizeScale,
                                                  nodeData->getLastTimeBagEmpty(),
                                                  isFullScene, &nodeData->stats, _myServer->getJurisdiction(),
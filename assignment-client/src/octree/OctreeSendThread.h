@@ -5,7 +5,7 @@
 //  Created by Brad Hefta-Gaub on 8/21/13.
 //  Copyright 2013 High Fidelity, Inc.
 //
-//  Threaded or non-threaded object for sending octree data packets to a client
+//  Object for sending octree data packets to a client, run by the server's OctreeSendScheduler
 //
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
@@ -16,22 +16,32 @@
 
 #include <atomic>
 
-#include <GenericThread.h>
+#include <QtCore/QObject>
+
 #include <Node.h>
 #include <OctreePacketData.h>
 
 class OctreeQueryNode;
+class OctreeSendScheduler;
 class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
-class OctreeSendThread : public GenericThread {
+/// Processor for sending octree packets to a single client
+/// Its passes run on the worker threads of an OctreeSendScheduler, which the client shares with all the others.
+class OctreeSendThread : public QObject {
     Q_OBJECT
 public:
     OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
     virtual ~OctreeSendThread();
 
+    /// Has scheduler run our passes, until one returns false or we're destroyed
+    void startSending(OctreeSendScheduler& scheduler);
+
+    /// Sends this interval's packets to the client, returns false once there's nothing more to send to it
+    /// Called from a scheduler worker thread, once per send interval
+    bool process();
+
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
     
@@ -44,16 +54,25 @@ public:
     static AtomicUIntStat _totalSpecialBytes;
     static AtomicUIntStat _totalSpecialPackets;
 
+    // time the clients spent waiting on the scheduler for their next send interval
     static AtomicUIntStat _usleepTime;
     static AtomicUIntStat _usleepCalls;
 
-protected:
-    /// Implements generic processing behavior for this thread.
-    virtual bool process() override;
+signals:
+    void finished();
 
+protected:
     /// Called before a packetDistributor pass to allow for pre-distribution processing
     virtual void preDistributionProcessing() {};
 
+    /// Called as each scene starts, may fill the element bag with just what changed since the last scene
+    /// Returns false when the scene must traverse the whole tree, which it must when canSendChangesOnly is false
+    virtual bool addChangesToElementBag(OctreeQueryNode* nodeData, bool canSendChangesOnly) { return false; }
+
+    /// Whether the encoded data tracks what each node was sent, so that a changed view only needs what is new to the node
+    /// instead of a full scene once the view stops changing
+    virtual bool tracksSentData() const { return false; }
+
     OctreeServer* _myServer { nullptr };
     QWeakPointer<Node> _node;
 
@@ -67,7 +86,9 @@ private:
     OctreePacketData _packetData;
 
     int _nodeMissingCount { 0 };
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
+
+    OctreeSendScheduler* _scheduler { nullptr };
 };
 
 #endif // hifi_OctreeSendThread_h
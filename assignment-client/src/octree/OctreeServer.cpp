@@ -223,6 +223,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _statusPort(0),
     _packetsPerClientPerInterval(10),
     _packetsTotalPerInterval(DEFAULT_PACKETS_PER_INTERVAL),
+    _editDecodeThreads(0),
     _tree(NULL),
     _wantPersist(true),
     _debugSending(false),
@@ -319,9 +320,12 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             showStats = true;
         } else if ((url.path() == PERSIST_FILE_DOWNLOAD_PATH) || (url.path() == PERSIST_FILE_DOWNLOAD_PATH + "/")) {
             if (_persistFileDownload) {
-                QByteArray persistFileContents = getPersistFileContents();
-                if (persistFileContents.length() > 0) {
-                    connection->respond(HTTPConnection::StatusCode200, persistFileContents, qPrintable(getPersistFileMimeType()));
+                // the file is streamed as the socket drains rather than read into memory first
+                std::unique_ptr<QIODevice> persistFile = openPersistFile();
+                if (persistFile && persistFile->size() > 0) {
+                    qint64 size = persistFile->size();
+                    connection->respondWithDevice(HTTPConnection::StatusCode200, std::move(persistFile), size,
+                                                  qPrintable(getPersistFileMimeType()));
                 } else {
                     connection->respond(HTTPConnection::StatusCode500, HTTPConnection::StatusCode500);
                 }
@@ -370,6 +374,18 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             statsString += getFileLoadTime();
             statsString += "\r\n";
 
+            if (isPersistEnabled()) {
+                statsString += QString("Last Save Took %1 msecs, Stalled Edits For %2 msecs (Most Ever %3 msecs)\r\n")
+                    .arg(getLastPersistTime() / USECS_PER_MSEC)
+                    .arg(getLastPersistStallTime() / (float)USECS_PER_MSEC, 0, 'f', 3)
+                    .arg(getMaxPersistStallTime() / (float)USECS_PER_MSEC, 0, 'f', 3);
+
+                float backupProgress = getBackupProgress();
+                if (backupProgress >= 0.0f) {
+                    statsString += QString("Backing Up Persist File... %1%\r\n").arg((int)(backupProgress * 100.0f));
+                }
+            }
+
             if (_persistFileDownload) {
                 statsString += QString("Persist file: <a href='%1'>Click to Download</a>\r\n").arg(PERSIST_FILE_DOWNLOAD_PATH);
             } else {
@@ -879,8 +895,13 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
     auto sendThread = newSendThread(node);
     
     // we want to be notified when the thread finishes
-    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    connect(sendThread.get(), &OctreeSendThread::finished, this, &OctreeServer::removeSendThread);
+
+    // every client shares the same pool of send workers, so the workers are only started with the first one
+    if (!_sendScheduler) {
+        _sendScheduler.reset(new OctreeSendScheduler());
+    }
+    sendThread->startSending(*_sendScheduler);
 
     return sendThread;
 }
@@ -1060,6 +1081,15 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString("persistFileType", settingsSectionObject, persistFileType)) {
+            if (persistFileType == "json.gz" || persistFileType == "bin") {
+                _persistAsFileType = persistFileType;
+            } else {
+                qWarning() << "Ignoring unsupported persistFileType" << persistFileType;
+            }
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1114,6 +1144,9 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    readOptionInt(QString("editDecodeThreads"), settingsSectionObject, _editDecodeThreads);
+    qDebug("editDecodeThreads=%d", _editDecodeThreads);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1278,6 +1311,7 @@ void OctreeServer::domainSettingsRequestComplete() {
     
     // set up our OctreeServerPacketProcessor
     _octreeInboundPacketProcessor = new OctreeInboundPacketProcessor(this);
+    _octreeInboundPacketProcessor->setNumDecodeThreads(_editDecodeThreads);
     _octreeInboundPacketProcessor->initialize(true);
     
     // Convert now to tm struct for local timezone
@@ -1355,9 +1389,10 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
     }
     
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Clear will destruct all the unique_ptr to OctreeSendThreads, each of which waits on its current
+    // pass on the send scheduler to be done before returning
     _sendThreads.clear(); // Cleans up all the send threads.
+    _sendScheduler.reset();
 
     if (_persistThread) {
         _persistThread->aboutToFinish();
@@ -1482,6 +1517,9 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["4. persistFileLoadTime"] = getFileLoadTime();
     statsArray1["5. clients"] = getCurrentClientCount();
     statsArray1["6. threads"] = threadsStats;
+    statsArray1["7. persistStallTime"] = (double)getLastPersistStallTime();
+    statsArray1["8. maxPersistStallTime"] = (double)getMaxPersistStallTime();
+    statsArray1["9. backupProgress"] = (double)getBackupProgress();
     
     // Octree Stats
     QJsonObject octreeStats;
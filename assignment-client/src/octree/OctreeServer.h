@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendScheduler.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -60,9 +61,15 @@ public:
     bool isInitialLoadComplete() const { return (_persistThread) ? _persistThread->isInitialLoadComplete() : true; }
     bool isPersistEnabled() const { return (_persistThread) ? true : false; }
     quint64 getLoadElapsedTime() const { return (_persistThread) ? _persistThread->getLoadElapsedTime() : 0; }
+    quint64 getLastPersistStallTime() const { return (_persistThread) ? _persistThread->getLastPersistStallTime() : 0; }
+    quint64 getMaxPersistStallTime() const { return (_persistThread) ? _persistThread->getMaxPersistStallTime() : 0; }
+    quint64 getLastPersistTime() const { return (_persistThread) ? _persistThread->getLastPersistTime() : 0; }
     QString getPersistFilename() const { return (_persistThread) ? _persistThread->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistThread) ? _persistThread->getPersistFileMimeType() : "text/plain"; }
-    QByteArray getPersistFileContents() const { return (_persistThread) ? _persistThread->getPersistFileContents() : QByteArray(); }
+    std::unique_ptr<QIODevice> openPersistFile() const {
+        return (_persistThread) ? _persistThread->openPersistFile() : std::unique_ptr<QIODevice>();
+    }
+    float getBackupProgress() const { return (_persistThread) ? _persistThread->getBackupProgress() : -1.0f; }
 
     // Subclasses must implement these methods
     virtual std::unique_ptr<OctreeQueryNode> createOctreeQueryNode() = 0;
@@ -176,6 +183,7 @@ protected:
     QString _backupDirectoryPath;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    int _editDecodeThreads;
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
@@ -198,6 +206,7 @@ protected:
     quint64 _startedUSecs;
     QString _safeServerName;
     
+    std::unique_ptr<OctreeSendScheduler> _sendScheduler; // declared before the send threads, which use it until destroyed
     SendThreads _sendThreads;
 
     static int _clientCount;
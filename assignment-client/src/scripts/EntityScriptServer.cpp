@@ -11,6 +11,7 @@
 
 #include "EntityScriptServer.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <AudioConstants.h>
@@ -38,6 +39,13 @@ using Lock = std::lock_guard<Mutex>;
 static std::mutex logBufferMutex;
 static std::string logBuffer;
 
+// only an engine busy for more than this fraction of the time gives away scripts
+static const float MIN_MIGRATION_LOAD = 0.5f;
+// a script stays at least this long on its engine and the scripts move at most this often, the smoothed load of a
+// script is only known after a while
+static const quint64 MIN_TIME_BEFORE_MIGRATION = 10 * USECS_PER_SECOND;
+static const int NUM_TOP_SCRIPTS_IN_STATS = 10;
+
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
     auto logMessage = LogHandler::getInstance().printMessage((LogMsgType) type, context, message);
 
@@ -63,6 +71,8 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     DependencyManager::set<ResourceCacheSharedItems>();
     DependencyManager::set<SoundCache>();
     DependencyManager::set<AudioInjectorManager>();
+    // the sounds of the scripts played at the same place are sent to the mixer as one stream
+    DependencyManager::get<AudioInjectorManager>()->setPremixInjectors(true);
 
     DependencyManager::set<ScriptCache>();
     DependencyManager::set<ScriptEngines>(ScriptEngine::ENTITY_SERVER_SCRIPT);
@@ -104,7 +114,10 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
 
         if (_entityViewer.getTree() && !_shuttingDown) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            auto engine = getEntitiesScriptEngine(entityID);
+            if (engine) {
+                engine->unloadEntityScript(entityID);
+            }
             checkAndCallPreload(entityID, true);
         }
     }
@@ -122,7 +135,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = getEntitiesScriptEngine(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -153,6 +167,37 @@ void EntityScriptServer::handleSettings() {
 
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
+    static const QString SCRIPT_ENGINES_OPTION = "script_engines";
+    static const QString SCRIPT_TIME_SLICE_OPTION = "script_time_slice";
+    static const QString SUSPEND_RUNAWAY_SCRIPTS_OPTION = "suspend_runaway_scripts";
+
+    if (entityScriptServerSettings.contains(SCRIPT_TIME_SLICE_OPTION)) {
+        _scriptTimeSlice = (quint64)std::max(0, entityScriptServerSettings[SCRIPT_TIME_SLICE_OPTION].toInt()) * USECS_PER_MSEC;
+    }
+    _suspendRunawayScripts = entityScriptServerSettings[SUSPEND_RUNAWAY_SCRIPTS_OPTION].toBool();
+    for (const auto& engine : _entitiesScriptEngines) {
+        engine->setEntityScriptTimeSlice(_scriptTimeSlice, _suspendRunawayScripts);
+    }
+
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINES_OPTION)) {
+        int numEngines = glm::clamp(entityScriptServerSettings[SCRIPT_ENGINES_OPTION].toInt(), 0, MAX_ENTITIES_SCRIPT_ENGINES);
+        if (numEngines != _numEntitiesScriptEngines) {
+            _numEntitiesScriptEngines = numEngines;
+            if (!_entitiesScriptEngines.empty() && !_shuttingDown) {
+                // restart the scripts on the new pool
+                QList<EntityItemID> entityIDs;
+                {
+                    std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+                    entityIDs = _entityScriptAssignments.keys();
+                }
+                stopEntitiesScriptEngines();
+                resetEntitiesScriptEngines();
+                for (const auto& entityID : entityIDs) {
+                    checkAndCallPreload(entityID);
+                }
+            }
+        }
+    }
 
     if (!entityScriptServerSettings.contains(MAX_ENTITY_PPS_OPTION) || !entityScriptServerSettings.contains(ENTITY_PPS_PER_SCRIPT)) {
         qWarning() << "Received settings from the domain-server with no max_total_entity_pps or entity_pps_per_script properties.";
@@ -167,7 +212,10 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    for (const auto& engine : _entitiesScriptEngines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplaction would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -254,8 +302,9 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(this);
 
     // we need to make sure that init has been called for our EntityScriptingInterface
     // so that it actually has a jurisdiction listener when we ask it for it next
@@ -414,7 +463,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+QSharedPointer<ScriptEngine> EntityScriptServer::createEntitiesScriptEngine(bool updatesEntityTree) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = QSharedPointer<ScriptEngine>(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName),
                                                   &ScriptEngine::deleteLater);
@@ -431,82 +480,291 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+    // the engines share the tree, one of them keeps it up to date
+    if (updatesEntityTree) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->update();
+        });
+    }
 
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
 
+    newEngine->setEntityScriptTimeSlice(_scriptTimeSlice, _suspendRunawayScripts);
     newEngine->runInThread();
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngine.data());
-
-    disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    return newEngine;
 }
 
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    int numEngines = _numEntitiesScriptEngines;
+    if (numEngines == 0) {
+        numEngines = glm::clamp(QThread::idealThreadCount(), 1, DEFAULT_MAX_ENTITIES_SCRIPT_ENGINES);
+    }
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    std::vector<QSharedPointer<ScriptEngine>> newEngines;
+    for (int i = 0; i < numEngines; i++) {
+        newEngines.push_back(createEntitiesScriptEngine(i == 0));
+    }
+
+    std::vector<QSharedPointer<ScriptEngine>> oldEngines;
+    {
+        std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+        oldEngines.swap(_entitiesScriptEngines);
+        _entitiesScriptEngines.swap(newEngines);
+        _entityScriptAssignments.clear();
+        _entitiesScriptEngineLoads.assign(numEngines, 0.0f);
+    }
+    for (const auto& engine : oldEngines) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+}
+
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    for (const auto& engine : _entitiesScriptEngines) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
+        engine->unloadAllEntityScripts();
+        engine->stop();
     }
+}
+
+void EntityScriptServer::clear() {
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& engine : _entitiesScriptEngines) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
     clear(); // always clear() on shutdown
 }
 
+QSharedPointer<ScriptEngine> EntityScriptServer::getEntitiesScriptEngine(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+    auto it = _entityScriptAssignments.constFind(entityID);
+    if (it == _entityScriptAssignments.constEnd()) {
+        return QSharedPointer<ScriptEngine>();
+    }
+    return _entitiesScriptEngines[it->engine];
+}
+
+QSharedPointer<ScriptEngine> EntityScriptServer::assignEntitiesScriptEngine(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+    if (_entitiesScriptEngines.empty()) {
+        return QSharedPointer<ScriptEngine>();
+    }
+    auto it = _entityScriptAssignments.constFind(entityID);
+    if (it != _entityScriptAssignments.constEnd()) {
+        return _entitiesScriptEngines[it->engine];
+    }
+
+    // the least loaded engine, or the one with the fewest scripts while nothing is measured
+    std::vector<int> numScripts(_entitiesScriptEngines.size(), 0);
+    for (const auto& assignment : _entityScriptAssignments) {
+        numScripts[assignment.engine]++;
+    }
+    int leastLoaded = 0;
+    for (int i = 1; i < (int)_entitiesScriptEngines.size(); i++) {
+        float load = _entitiesScriptEngineLoads[i];
+        float leastLoad = _entitiesScriptEngineLoads[leastLoaded];
+        if (load < leastLoad || (load == leastLoad && numScripts[i] < numScripts[leastLoaded])) {
+            leastLoaded = i;
+        }
+    }
+    _entityScriptAssignments[entityID] = { leastLoaded, 0.0f, usecTimestampNow() };
+    return _entitiesScriptEngines[leastLoaded];
+}
+
+void EntityScriptServer::unloadEntityScript(const EntityItemID& entityID) {
+    QSharedPointer<ScriptEngine> engine;
+    {
+        std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+        auto it = _entityScriptAssignments.find(entityID);
+        if (it == _entityScriptAssignments.end()) {
+            return;
+        }
+        engine = _entitiesScriptEngines[it->engine];
+        _entityScriptAssignments.erase(it);
+    }
+    engine->unloadEntityScript(entityID, true);
+}
+
+void EntityScriptServer::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params) {
+    auto engine = getEntitiesScriptEngine(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params);
+    }
+}
+
+QVariantList EntityScriptServer::getTopEntityScripts(int maxCount) {
+    QHash<EntityItemID, EntityScriptCost> costs;
+    std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+    for (const auto& engine : _entitiesScriptEngines) {
+        costs.unite(engine->getEntityScriptCosts());
+    }
+    return ScriptEngine::topEntityScriptsToVariant(costs, maxCount);
+}
+
+QFuture<QVariant> EntityScriptServer::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEntitiesScriptEngine(entityID);
+    if (!engine) {
+        // any engine reports the details as unavailable
+        std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+        if (_entitiesScriptEngines.empty()) {
+            return QFuture<QVariant>();
+        }
+        engine = _entitiesScriptEngines.front();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
+
 void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
     checkAndCallPreload(entityID);
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        unloadEntityScript(entityID);
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, const bool reload) {
     if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+        unloadEntityScript(entityID);
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && !_entitiesScriptEngines.empty()) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto engine = getEntitiesScriptEngine(entityID);
+        bool notRunning = !engine || !engine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = ResourceManager::normalizeURL(scriptUrl);
-                qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, reload);
+                if (!engine) {
+                    engine = assignEntitiesScriptEngine(entityID);
+                }
+                qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID
+                    << "on" << engine->getFilename();
+                engine->loadEntityScript(entityID, scriptUrl, reload);
+            }
+        }
+    }
+}
+
+void EntityScriptServer::updateEntitiesScriptEngineLoads() {
+    std::vector<QHash<EntityItemID, EntityScriptCost>> costs;
+    for (const auto& engine : _entitiesScriptEngines) {
+        costs.push_back(engine->getEntityScriptCosts());
+    }
+
+    std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+    std::fill(_entitiesScriptEngineLoads.begin(), _entitiesScriptEngineLoads.end(), 0.0f);
+    for (auto it = _entityScriptAssignments.begin(); it != _entityScriptAssignments.end(); ++it) {
+        auto cost = costs[it->engine].constFind(it.key());
+        if (cost != costs[it->engine].constEnd()) {
+            it->load = cost->cpuShare;
+        }
+        _entitiesScriptEngineLoads[it->engine] += it->load;
+    }
+}
+
+void EntityScriptServer::migrateHottestEntityScript() {
+    EntityItemID entityID;
+    QSharedPointer<ScriptEngine> fromEngine;
+    {
+        std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+        if (_entitiesScriptEngines.size() < 2) {
+            return;
+        }
+        auto loads = std::minmax_element(_entitiesScriptEngineLoads.begin(), _entitiesScriptEngineLoads.end());
+        int leastLoaded = (int)(loads.first - _entitiesScriptEngineLoads.begin());
+        int mostLoaded = (int)(loads.second - _entitiesScriptEngineLoads.begin());
+        float loadDifference = *loads.second - *loads.first;
+        quint64 now = usecTimestampNow();
+        if (*loads.second < MIN_MIGRATION_LOAD || now - _lastMigrationTime < MIN_TIME_BEFORE_MIGRATION) {
+            return;
+        }
+
+        // the hottest script which leaves both engines less loaded than the busiest one was
+        float hottestLoad = 0.0f;
+        for (auto it = _entityScriptAssignments.begin(); it != _entityScriptAssignments.end(); ++it) {
+            if (it->engine == mostLoaded && it->load > hottestLoad && it->load < loadDifference &&
+                    now - it->assignedTime > MIN_TIME_BEFORE_MIGRATION) {
+                entityID = it.key();
+                hottestLoad = it->load;
             }
         }
+        if (entityID.isNull()) {
+            return;
+        }
+
+        // the load moves with the script, until the new engine has measured it
+        _lastMigrationTime = now;
+        auto& assignment = _entityScriptAssignments[entityID];
+        assignment.engine = leastLoaded;
+        assignment.assignedTime = now;
+        _entitiesScriptEngineLoads[mostLoaded] -= hottestLoad;
+        _entitiesScriptEngineLoads[leastLoaded] += hottestLoad;
+        fromEngine = _entitiesScriptEngines[mostLoaded];
     }
+
+    qCDebug(entity_script_server) << "Moving the entity server script of" << entityID << "from" << fromEngine->getFilename();
+    fromEngine->unloadEntityScript(entityID, true);
+    checkAndCallPreload(entityID, false);
 }
 
 void EntityScriptServer::sendStatsPacket() {
+    updateEntitiesScriptEngineLoads();
+
+    QJsonObject statsObject, enginesObject;
+    {
+        std::lock_guard<std::mutex> lock(_entitiesScriptEnginesMutex);
+        std::vector<int> numScripts(_entitiesScriptEngines.size(), 0);
+        for (const auto& assignment : _entityScriptAssignments) {
+            numScripts[assignment.engine]++;
+        }
+        for (size_t i = 0; i < _entitiesScriptEngines.size(); i++) {
+            QJsonObject engineStats;
+            engineStats["assigned_scripts"] = numScripts[i];
+            engineStats["running_scripts"] = _entitiesScriptEngines[i]->getNumRunningEntityScripts();
+            engineStats["cpu_percent"] = 100.0f * _entitiesScriptEngineLoads[i];
+            enginesObject[_entitiesScriptEngines[i]->getFilename()] = engineStats;
+        }
+    }
+    statsObject["script_engines"] = enginesObject;
+
+    QJsonObject topScriptsObject;
+    for (const auto& script : getTopEntityScripts(NUM_TOP_SCRIPTS_IN_STATS)) {
+        auto scriptMap = script.toMap();
+        QJsonObject scriptStats;
+        scriptStats["cpu_percent"] = scriptMap["cpuShare"].toDouble();
+        scriptStats["longest_call_ms"] = scriptMap["longestCall"].toDouble();
+        scriptStats["overruns"] = scriptMap["overruns"].toInt();
+        scriptStats["suspended"] = scriptMap["suspended"].toBool();
+        topScriptsObject[scriptMap["entityID"].toString()] = scriptStats;
+    }
+    statsObject["top_scripts"] = topScriptsObject;
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 
+    if (!_shuttingDown && _entityViewer.getTree()) {
+        migrateHottestEntityScript();
+    }
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -554,6 +812,7 @@ void EntityScriptServer::aboutToFinish() {
 
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(nullptr);
 
     ResourceManager::cleanup();
 
@@ -12,22 +12,32 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <mutex>
 #include <set>
 #include <vector>
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QUuid>
 
+#include <EntitiesScriptEngineProvider.h>
 #include <EntityEditPacketSender.h>
 #include <EntityTreeHeadlessViewer.h>
+#include <NumericalConstants.h>
 #include <plugins/CodecPlugin.h>
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
-
-class EntityScriptServer : public ThreadedAssignment {
+static const int DEFAULT_MAX_ENTITIES_SCRIPT_ENGINES = 4;
+static const int MAX_ENTITIES_SCRIPT_ENGINES = 16;
+static const quint64 DEFAULT_SCRIPT_TIME_SLICE = USECS_PER_SECOND;
+
+// The entity scripts run in a pool of script engines, each on its own thread. A new script goes to the least loaded
+// engine, and every stats interval the hottest script of a busy engine moves to the least loaded one when that makes
+// the busiest engine less busy. The engines share the entity tree view of the server.
+class EntityScriptServer : public ThreadedAssignment, public EntitiesScriptEngineProvider {
     Q_OBJECT
 
 public:
@@ -36,6 +46,12 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // routed to the engine running the script of the entity
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+    QVariantList getTopEntityScripts(int maxCount) override;
+
 public slots:
     void run() override;
     void nodeActivated(SharedNodePointer activatedNode);
@@ -61,10 +77,21 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    QSharedPointer<ScriptEngine> createEntitiesScriptEngine(bool updatesEntityTree);
+    void resetEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
+    // the engine running the script of the entity, null if none
+    QSharedPointer<ScriptEngine> getEntitiesScriptEngine(const EntityItemID& entityID) const;
+    // the engine running the script of the entity, or the least loaded one which it is assigned to
+    QSharedPointer<ScriptEngine> assignEntitiesScriptEngine(const EntityItemID& entityID);
+    void unloadEntityScript(const EntityItemID& entityID);
+
+    void updateEntitiesScriptEngineLoads();
+    void migrateHottestEntityScript();
+
     void addingEntity(const EntityItemID& entityID);
     void deletingEntity(const EntityItemID& entityID);
     void entityServerScriptChanging(const EntityItemID& entityID, const bool reload);
@@ -74,8 +101,22 @@ private:
 
     bool _shuttingDown { false };
 
+    struct EntityScriptAssignment {
+        int engine;
+        float load; // the cpu share of the script measured by its engine
+        quint64 assignedTime;
+    };
+
     static int _entitiesScriptEngineCount;
-    QSharedPointer<ScriptEngine> _entitiesScriptEngine;
+    int _numEntitiesScriptEngines { 0 }; // 0 for one per core, up to DEFAULT_MAX_ENTITIES_SCRIPT_ENGINES
+    mutable std::mutex _entitiesScriptEnginesMutex;
+    std::vector<QSharedPointer<ScriptEngine>> _entitiesScriptEngines;
+    QHash<EntityItemID, EntityScriptAssignment> _entityScriptAssignments;
+    std::vector<float> _entitiesScriptEngineLoads;
+    quint64 _lastMigrationTime { 0 };
+
+    quint64 _scriptTimeSlice { DEFAULT_SCRIPT_TIME_SLICE };
+    bool _suspendRunawayScripts { false };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
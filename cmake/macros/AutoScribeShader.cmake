@@ -44,6 +44,8 @@ function(AUTOSCRIBE_SHADER SHADER_FILE)
     set(SHADER_TARGET ${SHADER_TARGET}_frag.h)
   elseif(${SHADER_EXT} STREQUAL .slg)
     set(SHADER_TARGET ${SHADER_TARGET}_geom.h)
+  elseif(${SHADER_EXT} STREQUAL .slc)
+    set(SHADER_TARGET ${SHADER_TARGET}_comp.h)
   endif()
 
   set(SHADER_TARGET "${SHADERS_DIR}/${SHADER_TARGET}")
@@ -105,7 +107,7 @@ macro(AUTOSCRIBE_SHADER_LIB)
   #message("${TARGET_NAME} ${HIFI_LIBRARIES_SHADER_INCLUDE_FILES}")
 
   file(GLOB_RECURSE SHADER_INCLUDE_FILES src/*.slh)
-  file(GLOB_RECURSE SHADER_SOURCE_FILES src/*.slv src/*.slf src/*.slg)
+  file(GLOB_RECURSE SHADER_SOURCE_FILES src/*.slv src/*.slf src/*.slg src/*.slc)
 
   #make the shader folder
   set(SHADERS_DIR "${CMAKE_CURRENT_BINARY_DIR}/shaders/${TARGET_NAME}")
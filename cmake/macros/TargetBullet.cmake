@@ -15,4 +15,8 @@ macro(TARGET_BULLET)
       target_include_directories(${TARGET_NAME} SYSTEM PRIVATE ${BULLET_INCLUDE_DIRS})
     endif()
     target_link_libraries(${TARGET_NAME} ${BULLET_LIBRARIES})
+    # a Bullet 2.88 or newer built with BT_THREADSAFE, for the multithreaded dynamics world
+    if (BULLET_THREADSAFE)
+      target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+    endif()
 endmacro()
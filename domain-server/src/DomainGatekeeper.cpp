@@ -11,22 +11,106 @@
 
 #include "DomainGatekeeper.h"
 
+#include <algorithm>
+
 #include <openssl/err.h>
 #include <openssl/rsa.h>
 #include <openssl/x509.h>
 
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QRunnable>
+
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <NumericalConstants.h>
+#include <PathUtils.h>
+#include <SharedUtil.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+const QString USER_CACHE_FILENAME = "user-cache.json";
+const int USER_CACHE_SAVE_DELAY_MSECS = 10 * MSECS_PER_SECOND;
+const int MAX_CACHED_USERS = 1000;
+
+// public keys rarely change, and a key that no longer matches is fetched again right away
+const quint64 PUBLIC_KEY_CACHE_TTL = 24 * SECS_PER_HOUR * USECS_PER_SECOND;
+
+// the group ranks of the connected users are refreshed with the groups cache, at most once per TTL
+const quint64 GROUP_RANKS_CACHE_TTL = SECS_PER_MINUTE * USECS_PER_SECOND;
+
+// the most recent users whose stale keys and ranks are fetched at startup, they are the likely first joiners
+const int NUM_PREFETCHED_RECENT_USERS = 100;
+
+enum SignatureResult {
+    SignatureMatch,
+    SignatureMismatch,
+    InvalidPublicKey
+};
+
+// checks that a username signature was made with the user's key, on the verification pool
+class SignatureVerificationJob : public QRunnable {
+public:
+    SignatureVerificationJob(QObject* receiver, const QString& lowerUsername, const QByteArray& publicKey,
+                             const QUuid& connectionToken, const QByteArray& usernameSignature) :
+        _receiver(receiver),
+        _lowerUsername(lowerUsername),
+        _publicKey(publicKey),
+        _connectionToken(connectionToken),
+        _usernameSignature(usernameSignature) {}
+
+    void run() override {
+        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(_publicKey.constData());
+
+        // first load up the public key into an RSA struct
+        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, _publicKey.size());
+
+        int result = InvalidPublicKey;
+        if (rsaPublicKey) {
+            QByteArray lowercaseUsernameUTF8 = _lowerUsername.toUtf8();
+            QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(_connectionToken.toRfc4122()),
+                                                                    QCryptographicHash::Sha256);
+
+            int decryptResult = RSA_verify(NID_sha256,
+                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                           usernameWithToken.size(),
+                                           reinterpret_cast<const unsigned char*>(_usernameSignature.constData()),
+                                           _usernameSignature.size(),
+                                           rsaPublicKey);
+            result = decryptResult == 1 ? SignatureMatch : SignatureMismatch;
+
+            RSA_free(rsaPublicKey);
+        }
+
+        QMetaObject::invokeMethod(_receiver, "signatureVerified", Qt::QueuedConnection,
+                                  Q_ARG(QString, _lowerUsername), Q_ARG(QByteArray, _usernameSignature), Q_ARG(int, result));
+    }
+
+private:
+    QObject* _receiver;
+    QString _lowerUsername;
+    QByteArray _publicKey;
+    QUuid _connectionToken;
+    QByteArray _usernameSignature;
+};
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
+    // write the cache once a burst of changes is over
+    _userCacheSaveTimer.setSingleShot(true);
+    _userCacheSaveTimer.setInterval(USER_CACHE_SAVE_DELAY_MSECS);
+    connect(&_userCacheSaveTimer, &QTimer::timeout, this, &DomainGatekeeper::saveUserCache);
+}
 
+DomainGatekeeper::~DomainGatekeeper() {
+    if (_userCacheSaveTimer.isActive()) {
+        saveUserCache();
+    }
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -104,10 +188,16 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         node = processAgentConnectRequest(nodeConnection, username, usernameSignature);
     }
 
+    finishConnectRequest(node, nodeConnection);
+}
+
+void DomainGatekeeper::finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection) {
     if (node) {
+        _admissionStats.admitted++;
+
         // set the sending sock addr and node interest set on this node
         DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
+        nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
 
         // guard against patched agents asking to hear about other agents
         auto safeInterestSet = nodeConnection.interestList.toSet();
@@ -119,14 +209,16 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         nodeData->setPlaceName(nodeConnection.placeName);
 
         qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID())
-            << "on" << message->getSenderSockAddr() << "with MAC" << nodeConnection.hardwareAddress
+            << "on" << nodeConnection.senderSockAddr << "with MAC" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
 
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node);
     } else {
-        qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
+        _admissionStats.refused++;
+
+        qDebug() << "Refusing connection from node at" << nodeConnection.senderSockAddr
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint;
     }
@@ -249,8 +341,8 @@ NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QStrin
 
 void DomainGatekeeper::updateNodePermissions() {
     // If the permissions were changed on the domain-server webpage (and nothing else was), a restart isn't required --
-    // we reprocess the permissions map and update the nodes here.  The node list is frequently sent out to all
-    // the connected nodes, so these changes are propagated to other nodes.
+    // we reprocess the permissions map and update the nodes here.  Every node gets a full node list at its next
+    // check-in, so these changes are propagated to other nodes.
 
     QList<SharedNodePointer> nodesToKill;
 
@@ -293,6 +385,12 @@ void DomainGatekeeper::updateNodePermissions() {
 
         node->setPermissions(userPerms);
 
+        DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (nodeData) {
+            // the permissions decide which nodes the others may hear about
+            nodeData->setNeedsFullDomainList(true);
+        }
+
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
             // hang up on this node
@@ -391,13 +489,21 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             qDebug() << "stalling login because we have no username-signature:" << username;
 #endif
             return SharedNodePointer();
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
+        }
+
+        SignatureCheck check = verifyUserSignature(nodeConnection, username, usernameSignature);
+        if (check == SignatureCheck::Verified) {
             // they sent us a username and the signature verifies it
             getGroupMemberships(username);
             verifiedUsername = username;
+        } else if (check == SignatureCheck::Pending) {
+            // this request is processed again once the verification pool has checked the signature
+#ifdef WANT_DEBUG
+            qDebug() << "stalling login while the signature is verified:" << username;
+#endif
+            return SharedNodePointer();
         } else {
             // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
 #ifdef WANT_DEBUG
             qDebug() << "stalling login because signature verification failed:" << username;
 #endif
@@ -472,6 +578,12 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
     nodeData->addOverrideForKey(USERNAME_UUID_REPLACEMENT_STATS_KEY,
                                 uuidStringWithoutCurlyBraces(newNode->getUUID()), username);
 
+    if (!verifiedUsername.isEmpty()) {
+        // remember who connects, they are the first whose keys are refreshed when the domain-server starts
+        _userCache[verifiedUsername.toLower()].lastConnectTime = usecTimestampNow();
+        scheduleUserCacheSave();
+    }
+
 #ifdef WANT_DEBUG
     qDebug() << "accepting login:" << username;
 #endif
@@ -510,72 +622,86 @@ SharedNodePointer DomainGatekeeper::addVerifiedNodeFromConnectRequest(const Node
     return newNode;
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureCheck DomainGatekeeper::verifyUserSignature(const NodeConnectionData& nodeConnection,
+                                                                       const QString& username,
+                                                                       const QByteArray& usernameSignature) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    QByteArray publicKeyArray = _userPublicKeys.value(lowerUsername);
-
-    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
-
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
-
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
+    const HifiSockAddr& senderSockAddr = nodeConnection.senderSockAddr;
+
+    auto resultIt = _signatureResults.find(lowerUsername);
+    if (resultIt != _signatureResults.end() && resultIt->first == usernameSignature) {
+        int result = resultIt->second;
+        _signatureResults.erase(resultIt);
+
+        if (result == SignatureMatch) {
+            qDebug() << "Username signature matches for" << username;
+
+            // remove the connection token now that it was used
+            _connectionTokenHash.remove(lowerUsername);
+            return SignatureCheck::Verified;
+        } else if (result == SignatureMismatch) {
+            qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
+            sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        } else {
+            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+            qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginError);
+        }
 
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+        // our cached key may be outdated, get the current one for the next attempt
+        requestUserPublicKey(username, true);
+        return SignatureCheck::Failed;
+    }
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+    QByteArray publicKeyArray = _userCache.value(lowerUsername).publicKey;
+    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+    if (publicKeyArray.isEmpty() || connectionToken.isNull()) {
+        qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+        requestUserPublicKey(username); // no joy.  maybe next time?
+        return SignatureCheck::Failed;
+    }
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+    // the connect request replaces the one already waiting, it is retried if the client didn't hear back
+    bool isVerifying = _pendingVerifications.contains(lowerUsername)
+        && _pendingVerifications[lowerUsername].usernameSignature == usernameSignature;
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+    PendingVerification& pending = _pendingVerifications[lowerUsername];
+    pending.nodeConnection = nodeConnection;
+    pending.username = username;
+    pending.usernameSignature = usernameSignature;
 
-                return true;
+    if (!isVerifying) {
+        pending.startTime = usecTimestampNow();
+        _verificationPool.start(new SignatureVerificationJob(this, lowerUsername, publicKeyArray,
+                                                             connectionToken, usernameSignature));
+    }
 
-            } else {
-                if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting username signature for " << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginError);
-                }
+    return SignatureCheck::Pending;
+}
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
-            }
+void DomainGatekeeper::signatureVerified(QString username, QByteArray usernameSignature, int result) {
+    auto pendingIt = _pendingVerifications.find(username);
+    if (pendingIt == _pendingVerifications.end() || pendingIt->usernameSignature != usernameSignature) {
+        // a newer connect request with another signature is being verified
+        return;
+    }
 
-        } else {
+    PendingVerification pending = *pendingIt;
+    _pendingVerifications.erase(pendingIt);
 
-            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-            if (!senderSockAddr.isNull()) {
-                qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
-                sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
-                    DomainHandler::ConnectionRefusedReason::LoginError);
-            }
-        }
-    } else {
-        if (!senderSockAddr.isNull()) {
-            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
-        }
-    }
+    quint64 verificationTime = usecTimestampNow() - pending.startTime;
+    _admissionStats.verifications++;
+    _admissionStats.totalVerificationTime += verificationTime;
+    _admissionStats.maxVerificationTime = std::max(_admissionStats.maxVerificationTime, verificationTime);
 
-    requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    // process the connect request again, this time with the result of the check
+    _signatureResults[username] = { usernameSignature, result };
+    SharedNodePointer node = processAgentConnectRequest(pending.nodeConnection, pending.username, pending.usernameSignature);
+    finishConnectRequest(node, pending.nodeConnection);
 }
 
 bool DomainGatekeeper::isWithinMaxCapacity() {
@@ -600,6 +726,8 @@ bool DomainGatekeeper::isWithinMaxCapacity() {
 
 
 void DomainGatekeeper::preloadAllowedUserPublicKeys() {
+    loadUserCache();
+
     QStringList allowedUsers = _server->_settingsManager.getAllNames();
 
     if (allowedUsers.size() > 0) {
@@ -609,9 +737,24 @@ void DomainGatekeeper::preloadAllowedUserPublicKeys() {
             requestUserPublicKey(username);
         }
     }
+
+    // the users who connected last are likely to be back soon
+    QList<QPair<quint64, QString>> recentUsers;
+    for (auto it = _userCache.constBegin(); it != _userCache.constEnd(); ++it) {
+        if (it->lastConnectTime > 0) {
+            recentUsers.append({ it->lastConnectTime, it.key() });
+        }
+    }
+    std::sort(recentUsers.begin(), recentUsers.end(), [](const QPair<quint64, QString>& a, const QPair<quint64, QString>& b) {
+        return a.first > b.first;
+    });
+    for (int i = 0; i < recentUsers.size() && i < NUM_PREFETCHED_RECENT_USERS; i++) {
+        requestUserPublicKey(recentUsers[i].second);
+        getGroupMemberships(recentUsers[i].second);
+    }
 }
 
-void DomainGatekeeper::requestUserPublicKey(const QString& username) {
+void DomainGatekeeper::requestUserPublicKey(const QString& username, bool force) {
     // don't request public keys for the standard psuedo-account-names
     if (NodePermissions::standardNames.contains(username, Qt::CaseInsensitive)) {
         return;
@@ -622,9 +765,18 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username) {
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    auto cachedIt = _userCache.find(lowerUsername);
+    if (!force && cachedIt != _userCache.end() && !cachedIt->publicKey.isEmpty()
+        && usecTimestampNow() - cachedIt->publicKeyTime < PUBLIC_KEY_CACHE_TTL) {
+        _admissionStats.publicKeyCacheHits++;
+        return;
+    }
+
     _inFlightPublicKeyRequests += lowerUsername;
+    _admissionStats.publicKeyRequests++;
 
-    // even if we have a public key for them right now, request a new one in case it has just changed
+    // even if we have a stale public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
     callbackParams.jsonCallbackReceiver = this;
     callbackParams.jsonCallbackMethod = "publicKeyJSONCallback";
@@ -661,8 +813,11 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply& requestReply) {
         const QString JSON_DATA_KEY = "data";
         const QString JSON_PUBLIC_KEY_KEY = "public_key";
 
-        _userPublicKeys[username.toLower()] =
+        CachedUser& cachedUser = _userCache[username.toLower()];
+        cachedUser.publicKey =
             QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8());
+        cachedUser.publicKeyTime = usecTimestampNow();
+        scheduleUserCacheSave();
     }
 
     _inFlightPublicKeyRequests.remove(username);
@@ -819,7 +974,7 @@ void DomainGatekeeper::processICEPingReplyPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
-void DomainGatekeeper::getGroupMemberships(const QString& username) {
+void DomainGatekeeper::getGroupMemberships(const QString& username, bool force) {
     // loop through the groups mentioned on the settings page and ask if this user is in each.  The replies
     // will be received asynchronously and permissions will be updated as the answers come in.
 
@@ -844,7 +999,16 @@ void DomainGatekeeper::getGroupMemberships(const QString& username) {
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    auto cachedIt = _userCache.find(lowerUsername);
+    if (!force && cachedIt != _userCache.end() && cachedIt->groupRanksTime > 0
+        && usecTimestampNow() - cachedIt->groupRanksTime < GROUP_RANKS_CACHE_TTL) {
+        _admissionStats.groupCacheHits++;
+        return;
+    }
+
     _inFlightGroupMembershipsRequests += lowerUsername;
+    _admissionStats.groupRequests++;
 
 
     JSONCallbackParameters callbackParams;
@@ -895,12 +1059,21 @@ void DomainGatekeeper::getIsGroupMemberJSONCallback(QNetworkReply& requestReply)
         QJsonObject groups = data["groups"].toObject();
         QString username = data["username"].toString();
         _server->_settingsManager.clearGroupMemberships(username);
+
+        CachedUser& cachedUser = _userCache[username.toLower()];
+        cachedUser.groupRanks.clear();
+        cachedUser.groupRanksTime = usecTimestampNow();
+
         foreach (auto groupID, groups.keys()) {
             QJsonObject group = groups[groupID].toObject();
             QJsonObject rank = group["rank"].toObject();
             QUuid rankID = QUuid(rank["id"].toString());
             _server->_settingsManager.recordGroupMembership(username, groupID, rankID);
+            if (!rankID.isNull()) {
+                cachedUser.groupRanks[QUuid(groupID)] = rankID;
+            }
         }
+        scheduleUserCacheSave();
     } else {
         qDebug() << "getIsGroupMember api call returned:" << QJsonDocument(jsonObject).toJson(QJsonDocument::Compact);
     }
@@ -982,3 +1155,99 @@ void DomainGatekeeper::refreshGroupsCache() {
     _server->_settingsManager.debugDumpGroupsState();
 #endif
 }
+
+QJsonObject DomainGatekeeper::getAdmissionStats() const {
+    QJsonObject stats;
+    stats["pending_verifications"] = _pendingVerifications.size();
+    stats["in_flight_public_key_requests"] = _inFlightPublicKeyRequests.size();
+    stats["in_flight_group_requests"] = _inFlightGroupMembershipsRequests.size();
+    stats["cached_users"] = _userCache.size();
+    stats["admitted"] = (double)_admissionStats.admitted;
+    stats["refused"] = (double)_admissionStats.refused;
+    stats["verifications"] = (double)_admissionStats.verifications;
+    stats["average_verification_msecs"] = _admissionStats.verifications > 0 ?
+        (double)_admissionStats.totalVerificationTime / (double)(_admissionStats.verifications * USECS_PER_MSEC) : 0.0;
+    stats["max_verification_msecs"] = (double)_admissionStats.maxVerificationTime / (double)USECS_PER_MSEC;
+    stats["public_key_requests"] = (double)_admissionStats.publicKeyRequests;
+    stats["public_key_cache_hits"] = (double)_admissionStats.publicKeyCacheHits;
+    stats["group_requests"] = (double)_admissionStats.groupRequests;
+    stats["group_cache_hits"] = (double)_admissionStats.groupCacheHits;
+    return stats;
+}
+
+void DomainGatekeeper::loadUserCache() {
+    QFile cacheFile(PathUtils::getAppDataFilePath(USER_CACHE_FILENAME));
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonObject users = QJsonDocument::fromJson(cacheFile.readAll()).object()["users"].toObject();
+    for (auto it = users.constBegin(); it != users.constEnd(); ++it) {
+        QJsonObject userObject = it.value().toObject();
+
+        CachedUser& cachedUser = _userCache[it.key()];
+        cachedUser.publicKey = QByteArray::fromBase64(userObject["public_key"].toString().toUtf8());
+        cachedUser.publicKeyTime = (quint64)userObject["public_key_time"].toDouble();
+        cachedUser.groupRanksTime = (quint64)userObject["group_ranks_time"].toDouble();
+        cachedUser.lastConnectTime = (quint64)userObject["last_connect_time"].toDouble();
+
+        // the ranks are used for the permissions until they are refreshed
+        QJsonObject groupRanks = userObject["group_ranks"].toObject();
+        for (auto rankIt = groupRanks.constBegin(); rankIt != groupRanks.constEnd(); ++rankIt) {
+            QUuid groupID(rankIt.key());
+            QUuid rankID(rankIt.value().toString());
+            cachedUser.groupRanks[groupID] = rankID;
+            _server->_settingsManager.recordGroupMembership(it.key(), groupID, rankID);
+        }
+    }
+
+    qDebug() << "Loaded" << _userCache.size() << "cached users from" << cacheFile.fileName();
+}
+
+void DomainGatekeeper::scheduleUserCacheSave() {
+    if (!_userCacheSaveTimer.isActive()) {
+        _userCacheSaveTimer.start();
+    }
+}
+
+void DomainGatekeeper::saveUserCache() {
+    _userCacheSaveTimer.stop();
+
+    // keep the users who connected last, followed by the allowed users who never connected
+    QList<QPair<quint64, QString>> users;
+    for (auto it = _userCache.constBegin(); it != _userCache.constEnd(); ++it) {
+        users.append({ it->lastConnectTime, it.key() });
+    }
+    std::sort(users.begin(), users.end(), [](const QPair<quint64, QString>& a, const QPair<quint64, QString>& b) {
+        return a.first > b.first;
+    });
+
+    QJsonObject usersObject;
+    for (int i = 0; i < users.size() && i < MAX_CACHED_USERS; i++) {
+        const CachedUser& cachedUser = _userCache[users[i].second];
+
+        QJsonObject userObject;
+        userObject["public_key"] = QString::fromUtf8(cachedUser.publicKey.toBase64());
+        userObject["public_key_time"] = (double)cachedUser.publicKeyTime;
+        userObject["group_ranks_time"] = (double)cachedUser.groupRanksTime;
+        userObject["last_connect_time"] = (double)cachedUser.lastConnectTime;
+
+        QJsonObject groupRanks;
+        for (auto rankIt = cachedUser.groupRanks.constBegin(); rankIt != cachedUser.groupRanks.constEnd(); ++rankIt) {
+            groupRanks[uuidStringWithoutCurlyBraces(rankIt.key())] = uuidStringWithoutCurlyBraces(rankIt.value());
+        }
+        userObject["group_ranks"] = groupRanks;
+
+        usersObject[users[i].second] = userObject;
+    }
+
+    QJsonObject root;
+    root["users"] = usersObject;
+
+    QFile cacheFile(PathUtils::getAppDataFilePath(USER_CACHE_FILENAME));
+    if (!cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Could not write the user cache to" << cacheFile.fileName();
+        return;
+    }
+    cacheFile.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
@@ -16,7 +16,10 @@
 
 #include <unordered_map>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 
 #include <DomainHandler.h>
@@ -34,12 +37,18 @@ class DomainGatekeeper : public QObject {
     Q_OBJECT
 public:
     DomainGatekeeper(DomainServer* server);
+    ~DomainGatekeeper();
     
     void addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
                                 const QUuid& walletUUID, const QString& nodeVersion);
     QUuid assignmentUUIDForPendingAssignment(const QUuid& tempUUID);
     
+    // loads the cache of user public keys and group ranks, then refreshes the stale keys of the allowed users and of
+    // the users who connected most recently
     void preloadAllowedUserPublicKeys();
+
+    // the connect requests waiting on a signature check, the metaverse API requests in flight and the cache hits
+    QJsonObject getAdmissionStats() const;
     
     void removeICEPeer(const QUuid& peerUUID) { _icePeers.remove(peerUUID); }
 
@@ -70,7 +79,15 @@ public slots:
 
 private slots:
     void handlePeerPingTimeout();
+    void saveUserCache();
+    void signatureVerified(QString username, QByteArray usernameSignature, int result);
 private:
+    enum class SignatureCheck {
+        Verified,
+        Pending, // the connect request is processed again once the signature is checked on the verification pool
+        Failed
+    };
+
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
@@ -79,8 +96,9 @@ private:
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection,
                                                         QUuid nodeID = QUuid());
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    SignatureCheck verifyUserSignature(const NodeConnectionData& nodeConnection, const QString& username,
+                                       const QByteArray& usernameSignature);
+    void finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection);
     bool isWithinMaxCapacity();
     
     bool shouldAllowConnectionFromNode(const QString& username, const QByteArray& usernameSignature,
@@ -93,7 +111,11 @@ private:
     
     void pingPunchForConnectingPeer(const SharedNetworkPeer& peer);
     
-    void requestUserPublicKey(const QString& username);
+    // unless forced, a key fetched within the cache TTL is not requested again
+    void requestUserPublicKey(const QString& username, bool force = false);
+
+    void loadUserCache();
+    void scheduleUserCacheSave();
     
     DomainServer* _server;
     
@@ -102,7 +124,41 @@ private:
     QHash<QUuid, SharedNetworkPeer> _icePeers;
     
     QHash<QString, QUuid> _connectionTokenHash;
-    QHash<QString, QByteArray> _userPublicKeys;
+
+    // what the metaverse API told us about a user, kept across restarts. The stale entries are still used until they
+    // are refreshed: a key that stopped matching the user's signatures is fetched again at once.
+    struct CachedUser {
+        QByteArray publicKey;
+        quint64 publicKeyTime { 0 }; // usecTimestampNow() when it was fetched
+        QHash<QUuid, QUuid> groupRanks; // group ID to rank ID
+        quint64 groupRanksTime { 0 };
+        quint64 lastConnectTime { 0 };
+    };
+    QHash<QString, CachedUser> _userCache; // by lower case username
+    QTimer _userCacheSaveTimer;
+
+    struct PendingVerification {
+        NodeConnectionData nodeConnection;
+        QString username;
+        QByteArray usernameSignature;
+        quint64 startTime { 0 }; // usecs
+    };
+    QHash<QString, PendingVerification> _pendingVerifications; // by lower case username
+    QHash<QString, QPair<QByteArray, int>> _signatureResults; // the signature checked and its result
+
+    struct AdmissionStats {
+        quint64 admitted { 0 };
+        quint64 refused { 0 }; // connect requests not admitted yet, including the ones waiting on a key or a check
+        quint64 verifications { 0 };
+        quint64 totalVerificationTime { 0 }; // usecs, queueing on the pool included
+        quint64 maxVerificationTime { 0 };
+        quint64 publicKeyRequests { 0 };
+        quint64 publicKeyCacheHits { 0 };
+        quint64 groupRequests { 0 };
+        quint64 groupCacheHits { 0 };
+    };
+    AdmissionStats _admissionStats;
+
     QSet<QString> _inFlightPublicKeyRequests; // keep track of which we've already asked for
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
@@ -110,9 +166,13 @@ private:
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, const QHostAddress& senderAddress, 
                                           const QString& hardwareAddress, const QUuid& machineFingerprint);
 
-    void getGroupMemberships(const QString& username);
+    // unless forced, ranks fetched within the cache TTL are not requested again
+    void getGroupMemberships(const QString& username, bool force = false);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
     void getDomainOwnerFriendsList();
+
+    // RSA checks run here rather than on the domain-server thread, last so it is destroyed (and waited on) first
+    QThreadPool _verificationPool;
 };
 
 
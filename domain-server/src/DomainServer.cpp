@@ -31,6 +31,7 @@
 #include <HifiConfigVariantMap.h>
 #include <HTTPConnection.h>
 #include <LogUtils.h>
+#include <Metrics.h>
 #include <NetworkingConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SettingHandle.h>
@@ -39,6 +40,7 @@
 #include <UUID.h>
 #include <LogHandler.h>
 #include <PathUtils.h>
+#include <SamplingProfiler.h>
 #include <NumericalConstants.h>
 
 #include "DomainServerNodeData.h"
@@ -48,6 +50,28 @@
 
 int const DomainServer::EXIT_CODE_REBOOT = 234923;
 
+const int DOMAIN_LIST_UPDATE_INTERVAL_MSECS = 250;
+
+// a check-in that crossed a delta on its way still carries the previous version, only resync when it is older than this
+const quint64 DOMAIN_LIST_RESYNC_DELAY_USECS = USECS_PER_SECOND;
+
+// the mixers resize their sends to the budgets of the agents at this interval
+const int BANDWIDTH_BUDGET_INTERVAL_MSECS = 1000;
+
+// what an agent can receive is split between the servers sending to it, in these shares,
+// with some left over for the asset server and the other traffic
+const float BANDWIDTH_BUDGET_HEADROOM = 0.8f;
+const std::vector<std::pair<NodeType_t, float>> BANDWIDTH_BUDGET_SHARES {
+    { NodeType::AudioMixer, 0.15f },
+    { NodeType::AvatarMixer, 0.45f },
+    { NodeType::EntityServer, 0.4f }
+};
+
+const QString MAX_CLIENT_BANDWIDTH_KEYPATH = "metaverse.max_client_bandwidth";
+const float DEFAULT_MAX_CLIENT_BANDWIDTH = 10.0f; // Mbps
+
+const int NUM_HTTP_WORKER_THREADS = 2;
+
 #if USE_STABLE_GLOBAL_SERVICES
 const QString ICE_SERVER_DEFAULT_HOSTNAME = "ice.highfidelity.com";
 #else
@@ -77,6 +101,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
 
     DependencyManager::set<tracing::Tracer>();
     DependencyManager::set<StatTracker>();
+    DependencyManager::set<SamplingProfiler>()->startFromEnvironment();
 
     LogUtils::init();
     Setting::init();
@@ -98,6 +123,9 @@ DomainServer::DomainServer(int argc, char* argv[]) :
 
     _settingsManager.setupConfigMap(args);
 
+    // read the requests and stream the responses of the web interface away from the main loop
+    _httpManager.setWorkerThreads(NUM_HTTP_WORKER_THREADS);
+
     // setup a shutdown event listener to handle SIGTERM or WM_CLOSE for us
 #ifdef _WIN32
     installNativeEventFilter(&ShutdownEventListener::getInstance());
@@ -293,6 +321,7 @@ bool DomainServer::optionallyReadX509KeyAndCertificate() {
         QSslKey privateKey(&keyFile, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey, keyPassphraseString.toUtf8());
 
         _httpsManager = new HTTPSManager(QHostAddress::AnyIPv4, DOMAIN_SERVER_HTTPS_PORT, sslCertificate, privateKey, QString(), this, this);
+        _httpsManager->setWorkerThreads(NUM_HTTP_WORKER_THREADS);
 
         qDebug() << "TCP server listening for HTTPS connections on" << DOMAIN_SERVER_HTTPS_PORT;
 
@@ -543,6 +572,16 @@ void DomainServer::setupNodeListAndAssignments() {
     packetReceiver.registerListener(PacketType::ICEServerHeartbeatDenied, this, "processICEServerHeartbeatDenialPacket");
     packetReceiver.registerListener(PacketType::ICEServerHeartbeatACK, this, "processICEServerHeartbeatACK");
 
+    // the churn of a burst of joins and leaves goes out to the other nodes once per interval
+    _domainListUpdateTimer = new QTimer { this };
+    connect(_domainListUpdateTimer, &QTimer::timeout, this, &DomainServer::sendDomainListUpdates);
+    _domainListUpdateTimer->start(DOMAIN_LIST_UPDATE_INTERVAL_MSECS);
+
+    // the mixers all size their sends to the agents from the same measure of each agent's bandwidth
+    _bandwidthBudgetTimer = new QTimer { this };
+    connect(_bandwidthBudgetTimer, &QTimer::timeout, this, &DomainServer::sendBandwidthBudgets);
+    _bandwidthBudgetTimer->start(BANDWIDTH_BUDGET_INTERVAL_MSECS);
+
     // add whatever static assignments that have been parsed to the queue
     addStaticAssignmentsToQueue();
 
@@ -847,12 +886,30 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
+    bool interestSetChanged = safeInterestSet != nodeData->getNodeInterestSet();
     nodeData->setNodeInterestSet(safeInterestSet);
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    // the version of the domain list this node has applied
+    quint32 listVersion = 0;
+    packetStream >> listVersion;
+
+    // and what it can receive, for the bandwidth budgets
+    quint32 receiveKbps = 0;
+    packetStream >> receiveKbps;
+    nodeData->setReceiveKbps(receiveKbps);
+
+    bool isMissingUpdates = listVersion != nodeData->getDomainListVersion()
+        && usecTimestampNow() - nodeData->getDomainListVersionTime() > DOMAIN_LIST_RESYNC_DELAY_USECS;
+
+    if (interestSetChanged || isMissingUpdates || nodeData->needsFullDomainList()) {
+        sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    } else {
+        // the node is up to date (or about to be), reply with an empty delta
+        sendDomainListDeltaToNode(sendingNode, QList<SharedNodePointer>(), QList<SharedNodePointer>());
+    }
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -963,7 +1020,7 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
 }
 
 void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2 + sizeof(quint32);
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -976,13 +1033,18 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
 
-    auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // the deltas sent after this list build on its version
+    extendedHeaderStream << nodeData->advanceDomainListVersion();
+    nodeData->setNeedsFullDomainList(false);
+
+    // reliable, since the deltas that follow only add to it
+    auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader, true);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
@@ -1016,6 +1078,127 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
 }
 
+void DomainServer::sendDomainListDeltaToNode(const SharedNodePointer& node, const QList<SharedNodePointer>& addedNodes,
+                                             const QList<SharedNodePointer>& removedNodes) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // an empty delta only acknowledges the check-in and leaves the version as it is
+    quint32 baseVersion = nodeData->getDomainListVersion();
+    quint32 version = (addedNodes.isEmpty() && removedNodes.isEmpty()) ? baseVersion : nodeData->advanceDomainListVersion();
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // like the full list, every packet of the delta starts with the header
+    QByteArray extendedHeader;
+    QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
+    extendedHeaderStream << limitedNodeList->getSessionUUID();
+    extendedHeaderStream << node->getUUID();
+    extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << baseVersion << version;
+
+    auto deltaPackets = NLPacketList::create(PacketType::DomainListDelta, extendedHeader, true);
+    QDataStream deltaStream(deltaPackets.get());
+
+    for (auto& addedNode : addedNodes) {
+        deltaPackets->startSegment();
+        deltaStream << (quint8)DomainListChange::AddedNode;
+        deltaStream << *addedNode.data();
+        deltaStream << connectionSecretForNodes(node, addedNode);
+        deltaPackets->endSegment();
+    }
+
+    for (auto& removedNode : removedNodes) {
+        deltaPackets->startSegment();
+        deltaStream << (quint8)DomainListChange::RemovedNode;
+        deltaStream << removedNode->getUUID();
+        deltaPackets->endSegment();
+    }
+
+    deltaPackets->closeCurrentPacket(true);
+
+    limitedNodeList->sendPacketList(std::move(deltaPackets), *node);
+}
+
+void DomainServer::sendBandwidthBudgets() {
+    float maxClientKbps = _settingsManager.valueOrDefaultValueForKeyPath(MAX_CLIENT_BANDWIDTH_KEYPATH)
+        .toFloat() * KILO_PER_MEGA;
+    if (maxClientKbps <= 0.0f) {
+        maxClientKbps = DEFAULT_MAX_CLIENT_BANDWIDTH * KILO_PER_MEGA;
+    }
+
+    // budget the agents that measured what they can receive, the others are left to the mixers' own limits
+    QList<QPair<QUuid, float>> budgets;
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+    limitedNodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (node->getType() == NodeType::Agent && nodeData && nodeData->getReceiveKbps() > 0) {
+            float budgetKbps = std::min(nodeData->getReceiveKbps() * BANDWIDTH_BUDGET_HEADROOM, maxClientKbps);
+            budgets << qMakePair(node->getUUID(), budgetKbps);
+        }
+    });
+
+    if (budgets.isEmpty()) {
+        return;
+    }
+
+    // each mixer gets its share of every budget
+    limitedNodeList->eachNode([&](const SharedNodePointer& node) {
+        auto shareIt = std::find_if(BANDWIDTH_BUDGET_SHARES.cbegin(), BANDWIDTH_BUDGET_SHARES.cend(),
+            [&](const std::pair<NodeType_t, float>& share) { return share.first == node->getType(); });
+        if (shareIt == BANDWIDTH_BUDGET_SHARES.cend() || !node->getActiveSocket()) {
+            return;
+        }
+
+        auto budgetsPacketList = NLPacketList::create(PacketType::NodeBandwidthBudgets);
+        QDataStream budgetsStream(budgetsPacketList.get());
+        for (auto& budget : budgets) {
+            budgetsPacketList->startSegment();
+            budgetsStream << budget.first << (quint32)(budget.second * shareIt->second);
+            budgetsPacketList->endSegment();
+        }
+        limitedNodeList->sendPacketList(*budgetsPacketList, *node);
+    });
+}
+
+void DomainServer::sendDomainListUpdates() {
+    if (_pendingAddedNodes.isEmpty() && _pendingRemovedNodes.isEmpty()) {
+        return;
+    }
+
+    QList<SharedNodePointer> addedNodes;
+    QList<SharedNodePointer> removedNodes;
+    addedNodes.swap(_pendingAddedNodes);
+    removedNodes.swap(_pendingRemovedNodes);
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+    limitedNodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+        // the nodes without an active socket get the full list once they check in
+        if (!nodeData || !node->getActiveSocket() || !nodeData->isAuthenticated()) {
+            return;
+        }
+
+        QList<SharedNodePointer> nodeAddedNodes;
+        for (auto& addedNode : addedNodes) {
+            if (addedNode != node && isInInterestSet(node, addedNode)) {
+                nodeAddedNodes << addedNode;
+            }
+        }
+
+        QList<SharedNodePointer> nodeRemovedNodes;
+        for (auto& removedNode : removedNodes) {
+            if (removedNode != node && isInInterestSet(node, removedNode)) {
+                nodeRemovedNodes << removedNode;
+            }
+        }
+
+        if (!nodeAddedNodes.isEmpty() || !nodeRemovedNodes.isEmpty()) {
+            sendDomainListDeltaToNode(node, nodeAddedNodes, nodeRemovedNodes);
+        }
+    });
+}
+
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     DomainServerNodeData* nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
     DomainServerNodeData* nodeBData = static_cast<DomainServerNodeData*>(nodeB->getLinkedData());
@@ -1038,39 +1221,8 @@ QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, con
 }
 
 void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
-
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
-    auto addNodePacket = NLPacket::create(PacketType::DomainServerAddedNode);
-
-    // setup the add packet for this new node
-    QDataStream addNodeStream(addNodePacket.get());
-
-    addNodeStream << *addedNode.data();
-
-    int connectionSecretIndex = addNodePacket->pos();
-
-    limitedNodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-            if (node->getLinkedData() && node->getActiveSocket() && node != addedNode) {
-                // is the added Node in this node's interest list?
-                return isInInterestSet(node, addedNode);
-            } else {
-                return false;
-            }
-        },
-        [&](const SharedNodePointer& node) {
-            addNodePacket->seek(connectionSecretIndex);
-
-            QByteArray rfcConnectionSecret = connectionSecretForNodes(node, addedNode).toRfc4122();
-
-            // replace the bytes at the end of the packet for the connection secret between these nodes
-            addNodePacket->write(rfcConnectionSecret);
-
-            // send off this packet to the node
-            limitedNodeList->sendUnreliablePacket(*addNodePacket, *node);
-        }
-    );
+    // the other nodes hear about it with the next domain list update
+    _pendingAddedNodes << addedNode;
 }
 
 void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> message) {
@@ -1774,6 +1926,36 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             QJsonDocument transactionsDocument(rootObject);
             connection->respond(HTTPConnection::StatusCode200, transactionsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == "/admission.json") {
+            // the state of the connect requests waiting on the gatekeeper
+            QJsonDocument admissionDocument(_gatekeeper.getAdmissionStats());
+            connection->respond(HTTPConnection::StatusCode200, admissionDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
+            return true;
+        } else if (url.path() == "/metrics") {
+            // the metrics of the assignments in the Prometheus text format, labelled with the node of each
+            QVector<QPair<QByteArray, QString>> metricsTexts;
+            nodeList->eachNode([&metricsTexts](const SharedNodePointer& node) {
+                auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+                if (nodeData && !nodeData->getMetricsText().isEmpty()) {
+                    QString nodeType = NodeType::getNodeTypeName(node->getType()).toLower().replace(' ', '-');
+                    QString labels = QString("node_type=\"%1\",node_id=\"%2\"")
+                        .arg(nodeType).arg(uuidStringWithoutCurlyBraces(node->getUUID()));
+                    metricsTexts.append({ nodeData->getMetricsText(), labels });
+                }
+            });
+
+            const QString PROMETHEUS_MIME_TYPE = "text/plain; version=0.0.4";
+            connection->respond(HTTPConnection::StatusCode200, MetricsRegistry::mergePrometheusText(metricsTexts),
+                                qPrintable(PROMETHEUS_MIME_TYPE));
+
+            return true;
+        } else if (url.path() == "/profile") {
+            // the stacks sampled in the domain-server, when started with SAMPLING_PROFILER_ENV
+            connection->respond(HTTPConnection::StatusCode200, DependencyManager::get<SamplingProfiler>()->getFoldedStacks(),
+                                "text/plain");
+
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
             // setup the JSON
@@ -1824,6 +2006,21 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
                 return false;
             }
+
+            // check if this is for the sampled stacks of a node
+            const QString NODE_PROFILE_REGEX_STRING = QString("\\%1\\/(%2)\\/profile\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING);
+            QRegExp nodeProfileRegex(NODE_PROFILE_REGEX_STRING);
+
+            if (nodeProfileRegex.indexIn(url.path()) != -1) {
+                SharedNodePointer matchingNode = nodeList->nodeWithUUID(QUuid(nodeProfileRegex.cap(1)));
+                if (matchingNode) {
+                    auto nodeData = static_cast<DomainServerNodeData*>(matchingNode->getLinkedData());
+                    connection->respond(HTTPConnection::StatusCode200, nodeData->getSampledStacks(), "text/plain");
+                    return true;
+                }
+
+                return false;
+            }
         }
     } else if (connection->requestOperation() == QNetworkAccessManager::PostOperation) {
         if (url.path() == URI_ASSIGNMENT) {
@@ -2191,6 +2388,10 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.removeICEPeer(node->getUUID());
 
+    // tell the other nodes that still know about it, the ones that got a full list since it connected included
+    _pendingAddedNodes.removeAll(node);
+    _pendingRemovedNodes << node;
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
@@ -2407,20 +2608,8 @@ void DomainServer::handleKillNode(SharedNodePointer nodeToKill) {
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
     const QUuid& nodeUUID = nodeToKill->getUUID();
 
+    // nodeKilled queues the removal for the next domain list update
     limitedNodeList->killNodeWithUUID(nodeUUID);
-
-    static auto removedNodePacket = NLPacket::create(PacketType::DomainServerRemovedNode, NUM_BYTES_RFC4122_UUID);
-
-    removedNodePacket->reset();
-    removedNodePacket->write(nodeUUID.toRfc4122());
-
-    // broadcast out the DomainServerRemovedNode message
-    limitedNodeList->eachMatchingNode([this, &nodeToKill](const SharedNodePointer& otherNode) -> bool {
-        // only send the removed node packet to nodes that care about the type of node this was
-        return isInInterestSet(otherNode, nodeToKill);
-    }, [&limitedNodeList](const SharedNodePointer& otherNode){
-        limitedNodeList->sendUnreliablePacket(*removedNodePacket, *otherNode);
-    });
 }
 
 void DomainServer::processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message) {
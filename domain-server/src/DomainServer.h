@@ -83,6 +83,8 @@ private slots:
     void sendHeartbeatToIceServer();
 
     void handleConnectedNode(SharedNodePointer newNode);
+    void sendDomainListUpdates();
+    void sendBandwidthBudgets();
 
     void handleTempDomainSuccess(QNetworkReply& requestReply);
     void handleTempDomainError(QNetworkReply& requestReply);
@@ -131,6 +133,8 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
 
     void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    void sendDomainListDeltaToNode(const SharedNodePointer& node, const QList<SharedNodePointer>& addedNodes,
+                                   const QList<SharedNodePointer>& removedNodes);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -196,6 +200,12 @@ private:
     QTimer* _iceHeartbeatTimer { nullptr };
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
+    QTimer* _domainListUpdateTimer { nullptr };
+    QTimer* _bandwidthBudgetTimer { nullptr };
+
+    // the nodes added and removed since the last domain list update, sent out together as one delta per node
+    QList<SharedNodePointer> _pendingAddedNodes;
+    QList<SharedNodePointer> _pendingRemovedNodes;
 
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
@@ -15,6 +15,8 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QVariant>
 
+#include <SharedUtil.h>
+#include <ThreadedAssignment.h>
 #include <udt/PacketHeaders.h>
 
 #include "DomainServerNodeData.h"
@@ -25,10 +27,21 @@ DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
+quint32 DomainServerNodeData::advanceDomainListVersion() {
+    _domainListVersionTime = usecTimestampNow();
+    return ++_domainListVersion;
+}
+
 void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
     auto document = QJsonDocument::fromBinaryData(statsByteArray);
     Q_ASSERT(document.isObject());
-    _statsJSONObject = overrideValuesIfNeeded(document.object());
+    auto statsObject = document.object();
+
+    // the metrics are served apart, in their own format
+    _metricsText = statsObject.take(METRICS_STATS_KEY).toString().toUtf8();
+    _sampledStacks = statsObject.take(SAMPLED_STACKS_STATS_KEY).toString().toUtf8();
+
+    _statsJSONObject = overrideValuesIfNeeded(statsObject);
 }
 
 QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
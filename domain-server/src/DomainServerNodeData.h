@@ -26,6 +26,8 @@ public:
     DomainServerNodeData();
 
     const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
+    const QByteArray& getMetricsText() const { return _metricsText; }
+    const QByteArray& getSampledStacks() const { return _sampledStacks; }
 
     void updateJSONStats(QByteArray statsByteArray);
 
@@ -68,6 +70,19 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // the version of the domain list last sent to this node, and when it was sent
+    quint32 getDomainListVersion() const { return _domainListVersion; }
+    quint64 getDomainListVersionTime() const { return _domainListVersionTime; }
+    quint32 advanceDomainListVersion();
+
+    // set when a change not tracked by the deltas (like permissions) calls for a full list at the next check-in
+    bool needsFullDomainList() const { return _needsFullDomainList; }
+    void setNeedsFullDomainList(bool needsFullDomainList) { _needsFullDomainList = needsFullDomainList; }
+
+    // what the node measures it can receive at, sent with its check-ins, 0 if it has no measure yet
+    quint32 getReceiveKbps() const { return _receiveKbps; }
+    void setReceiveKbps(quint32 receiveKbps) { _receiveKbps = receiveKbps; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -81,6 +96,8 @@ private:
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
     QJsonObject _statsJSONObject;
+    QByteArray _metricsText;
+    QByteArray _sampledStacks;
     static StringPairHash _overrideHash;
     
     HifiSockAddr _sendingSockAddr;
@@ -93,6 +110,11 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    quint32 _domainListVersion { 0 };
+    quint32 _receiveKbps { 0 };
+    quint64 _domainListVersionTime { 0 };
+    bool _needsFullDomainList { false };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -13,6 +13,7 @@
 
 #include <openssl/x509.h>
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
@@ -22,17 +23,244 @@
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
 #include <udt/PacketHeaders.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+const quint16 ICE_SERVER_MONITORING_PORT = 40110;
+
+// a client queries again every few hundred msecs while it waits for a domain, more is a misbehaving or hostile peer
+const int MAX_QUERIES_PER_WINDOW = 10;
+const quint64 QUERY_WINDOW_USECS = USECS_PER_SECOND;
+
+// bounds the delay of a packet queued while its worker goes to sleep
+const uint32_t WORKER_MAX_WAIT_MSECS = 10;
+
+int IceServerWorker::getQueueSize() {
+    lock();
+    int size = _items.size();
+    unlock();
+    return size;
+}
+
+uint32_t IceServerWorker::getMaxWait() {
+    return WORKER_MAX_WAIT_MSECS;
+}
+
+bool IceServerWorker::processQueueItems(const Queue& packets) {
+    _stats.batches++;
+    if ((quint64)packets.size() > _stats.maxBatchSize) {
+        _stats.maxBatchSize = packets.size();
+    }
+
+    // answer the newest heartbeat of each domain and each query once per batch
+    QSet<QUuid> heartbeatingPeers;
+    QSet<QPair<QUuid, QUuid>> answeredQueries;
+    for (auto it = packets.rbegin(); it != packets.rend(); ++it) {
+        NLPacket& packet = **it;
+        if (packet.getType() == PacketType::ICEServerHeartbeat) {
+            QUuid senderID = QUuid::fromRfc4122(QByteArray::fromRawData(packet.getPayload(), NUM_BYTES_RFC4122_UUID));
+            if (!heartbeatingPeers.contains(senderID)) {
+                heartbeatingPeers.insert(senderID);
+                processHeartbeat(packet);
+            }
+        } else if (packet.getType() == PacketType::ICEServerQuery) {
+            processQuery(packet, answeredQueries);
+        }
+    }
+
+    removeStaleEntries(usecTimestampNow());
+
+    return isStillRunning();
+}
+
+void IceServerWorker::processHeartbeat(NLPacket& packet) {
+    _stats.heartbeats++;
+
+    // pull the UUID, public and private sock addrs for this peer
+    QUuid senderUUID;
+    HifiSockAddr publicSocket, localSocket;
+    QByteArray signature;
+
+    QDataStream heartbeatStream(&packet);
+    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+
+    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeatStream >> signature;
+
+    // make sure this is a verified heartbeat before performing any more processing
+    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
+        _server.addOrUpdateHeartbeatingPeer(senderUUID, publicSocket, localSocket, packet.getSenderSockAddr());
+
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        // one per worker, writing a packet stamps its sequence number
+        static thread_local auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+        _server._serverSocket.writePacket(*ackPacket, packet.getSenderSockAddr());
+    } else {
+        _stats.deniedHeartbeats++;
+
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        static thread_local auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+        _server._serverSocket.writePacket(*deniedPacket, packet.getSenderSockAddr());
+    }
+}
+
+void IceServerWorker::processQuery(NLPacket& packet, QSet<QPair<QUuid, QUuid>>& answeredQueries) {
+    _stats.queries++;
+
+    QDataStream heartbeatStream(&packet);
+
+    // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
+    QUuid senderUUID;
+    heartbeatStream >> senderUUID;
+
+    // pull the public and private sock addrs for this peer
+    HifiSockAddr publicSocket, localSocket;
+    heartbeatStream >> publicSocket >> localSocket;
+
+    // check if this node also included a UUID that they would like to connect to
+    QUuid connectRequestID;
+    heartbeatStream >> connectRequestID;
+
+    auto query = qMakePair(senderUUID, connectRequestID);
+    if (answeredQueries.contains(query)) {
+        _stats.duplicateQueries++;
+        return;
+    }
+    answeredQueries.insert(query);
+
+    if (isRateLimited(senderUUID, usecTimestampNow())) {
+        _stats.rateLimitedQueries++;
+        return;
+    }
+
+    // copy what we need of the matching peer, its heartbeats update it from another worker
+    QByteArray matchingPeerBytes;
+    HifiSockAddr matchingPeerSocket;
+    {
+        auto& shard = _server.shardForPeer(connectRequestID);
+        QReadLocker locker(&shard.lock);
+        SharedNetworkPeer matchingPeer = shard.peers.value(connectRequestID);
+        if (matchingPeer && matchingPeer->getActiveSocket()) {
+            matchingPeerBytes = matchingPeer->toByteArray();
+            matchingPeerSocket = *matchingPeer->getActiveSocket();
+        }
+    }
+
+    if (!matchingPeerBytes.isEmpty()) {
+        qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
+
+        // we have the peer they want to connect to - send them pack the information for that peer
+        _server.sendPeerInformationPacket(matchingPeerBytes, packet.getSenderSockAddr());
+
+        // we also need to send them to the active peer they are hoping to connect to
+        // create a dummy peer object we can pass to sendPeerInformationPacket
+        NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
+        _server.sendPeerInformationPacket(dummyPeer.toByteArray(), matchingPeerSocket);
+
+        _stats.peerInformationSent += 2;
+    } else {
+        qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
+    }
+}
+
+bool IceServerWorker::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
+    bool isPending = false;
+    auto rsaPublicKey = _server.getDomainPublicKey(domainID, isPending);
+
+    // make sure we're not already waiting for a public key for this domain-server
+    if (isPending) {
+        return false;
+    }
+
+    if (rsaPublicKey) {
+        // the same heartbeat signed with the same key needs no new verification
+        auto cached = _verifiedHeartbeats.find(domainID);
+        if (cached != _verifiedHeartbeats.end() && cached->second.publicKey == rsaPublicKey &&
+                cached->second.signature == signature && cached->second.plaintext == plaintext) {
+            cached->second.lastUsed = usecTimestampNow();
+            _stats.cachedVerifications++;
+            return true;
+        }
+
+        // attempt to verify the signature for this heartbeat
+        _stats.signatureVerifications++;
+        auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+        int verificationResult = RSA_verify(NID_sha256,
+                                            reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                            hashedPlaintext.size(),
+                                            reinterpret_cast<const unsigned char*>(signature.constData()),
+                                            signature.size(),
+                                            rsaPublicKey.get());
+
+        if (verificationResult == 1) {
+            // this is the only success case - we return true here to indicate that the heartbeat is verified
+            // the plaintext points into the packet, keep a deep copy
+            _verifiedHeartbeats[domainID] = { rsaPublicKey, QByteArray(plaintext.constData(), plaintext.size()),
+                                              signature, usecTimestampNow() };
+            return true;
+        } else {
+            qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
+        }
+    }
+
+    // we could not verify this heartbeat (missing public key, bad actor)
+    // ask the metaverse API for the right public key and return false to indicate that this is not verified
+    _verifiedHeartbeats.erase(domainID);
+    QMetaObject::invokeMethod(&_server, "requestDomainPublicKey", Q_ARG(QUuid, domainID));
+
+    return false;
+}
+
+bool IceServerWorker::isRateLimited(const QUuid& senderID, quint64 now) {
+    auto& window = _queryWindows[senderID];
+    if (now - window.start > QUERY_WINDOW_USECS) {
+        window.start = now;
+        window.count = 0;
+    }
+    return ++window.count > MAX_QUERIES_PER_WINDOW;
+}
+
+void IceServerWorker::removeStaleEntries(quint64 now) {
+    if (now - _lastStaleEntriesCheck < CLEAR_INACTIVE_PEERS_INTERVAL_MSECS * USECS_PER_MSEC) {
+        return;
+    }
+    _lastStaleEntriesCheck = now;
+
+    for (auto it = _verifiedHeartbeats.begin(); it != _verifiedHeartbeats.end();) {
+        if (now - it->second.lastUsed > PEER_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC) {
+            it = _verifiedHeartbeats.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = _queryWindows.begin(); it != _queryWindows.end();) {
+        if (now - it->second.start > QUERY_WINDOW_USECS) {
+            it = _queryWindows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
     _serverSocket(0, false),
-    _activePeers()
+    _httpManager(QHostAddress::AnyIPv4, ICE_SERVER_MONITORING_PORT, QString("%1/web/").arg(QCoreApplication::applicationDirPath()), this)
 {
+    // the socket thread only reads and dispatches, leave it a core
+    int numWorkers = std::max(QThread::idealThreadCount() - 1, 1);
+    for (int i = 0; i < numWorkers; i++) {
+        _workers.emplace_back(new IceServerWorker(*this));
+        _workers.back()->setObjectName(QString("IceServerWorker %1").arg(i));
+        _workers.back()->initialize();
+    }
+    qDebug() << "ice-server is processing packets on" << numWorkers << "worker threads";
+
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
     _serverSocket.bind(QHostAddress::AnyIPv4, ICE_SERVER_DEFAULT_PORT);
@@ -54,6 +282,12 @@ IceServer::IceServer(int argc, char* argv[]) :
     connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServer::publicKeyReplyFinished);
 }
 
+IceServer::~IceServer() {
+    for (auto& worker : _workers) {
+        worker->terminate();
+    }
+}
+
 bool IceServer::packetVersionMatch(const udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
@@ -66,145 +300,68 @@ bool IceServer::packetVersionMatch(const udt::Packet& packet) {
 }
 
 void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
+    _packetsReceived++;
 
     auto nlPacket = NLPacket::fromBase(std::move(packet));
     
     // make sure that this packet at least looks like something we can read
-    if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
-        
-        if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
-        } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
-            QDataStream heartbeatStream(nlPacket.get());
-            
-            // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
-            QUuid senderUUID;
-            heartbeatStream >> senderUUID;
-            
-            // pull the public and private sock addrs for this peer
-            HifiSockAddr publicSocket, localSocket;
-            heartbeatStream >> publicSocket >> localSocket;
-            
-            // check if this node also included a UUID that they would like to connect to
-            QUuid connectRequestID;
-            heartbeatStream >> connectRequestID;
-            
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
-            
-            if (matchingPeer) {
-                
-                qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
-                
-                // we have the peer they want to connect to - send them pack the information for that peer
-                sendPeerInformationPacket(*matchingPeer, &nlPacket->getSenderSockAddr());
-                
-                // we also need to send them to the active peer they are hoping to connect to
-                // create a dummy peer object we can pass to sendPeerInformationPacket
-                
-                NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
-                sendPeerInformationPacket(dummyPeer, matchingPeer->getActiveSocket());
-            } else {
-                qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
-            }
-        }
+    if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)
+            && nlPacket->getPayloadSize() >= NUM_BYTES_RFC4122_UUID
+            && (nlPacket->getType() == PacketType::ICEServerHeartbeat || nlPacket->getType() == PacketType::ICEServerQuery)) {
+
+        // both start with the UUID of the sender, which picks the worker
+        uint senderHash = qHash(QByteArray::fromRawData(nlPacket->getPayload(), NUM_BYTES_RFC4122_UUID));
+        auto& worker = _workers[senderHash % _workers.size()];
+        worker->queueItem(SharedNLPacket(nlPacket.release()));
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
-
-    // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    HifiSockAddr publicSocket, localSocket;
-    QByteArray signature;
-
-    QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
-
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+void IceServer::addOrUpdateHeartbeatingPeer(const QUuid& peerID, const HifiSockAddr& publicSocket,
+                                            const HifiSockAddr& localSocket, const HifiSockAddr& senderSockAddr) {
+    auto& shard = shardForPeer(peerID);
+    QWriteLocker locker(&shard.lock);
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
-
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+    // make sure we have this sender in our peer hash
+    SharedNetworkPeer matchingPeer = shard.peers.value(peerID);
 
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
-        }
+    if (!matchingPeer) {
+        // if we don't have this sender we need to create them now
+        matchingPeer = QSharedPointer<NetworkPeer>::create(peerID, publicSocket, localSocket);
+        shard.peers.insert(peerID, matchingPeer);
 
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
+        qDebug() << "Added a new network peer" << *matchingPeer;
     } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+        // we already had the peer so just potentially update their sockets
+        matchingPeer->setPublicSocket(publicSocket);
+        matchingPeer->setLocalSocket(localSocket);
     }
+
+    // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+    matchingPeer->activateMatchingOrNewSymmetricSocket(senderSockAddr);
+
+    // update our last heard microstamp for this network peer to now
+    matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+std::shared_ptr<RSA> IceServer::getDomainPublicKey(const QUuid& domainID, bool& isPending) {
+    QReadLocker locker(&_domainPublicKeysLock);
+    isPending = _pendingPublicKeyRequests.contains(domainID);
+    auto it = _domainPublicKeys.find(domainID);
+    return it != _domainPublicKeys.end() ? it->second : std::shared_ptr<RSA>();
+}
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
-            }
+void IceServer::requestDomainPublicKey(const QUuid& domainID) {
+    {
+        // the workers may ask for the same key a few times before the request is pending
+        QWriteLocker locker(&_domainPublicKeysLock);
+        if (_pendingPublicKeyRequests.contains(domainID)) {
+            return;
         }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+        // add this to the set of pending public key requests
+        _pendingPublicKeyRequests.insert(domainID);
     }
 
-    return false;
-}
-
-void IceServer::requestDomainPublicKey(const QUuid& domainID) {
     // send a request to the metaverse API for the public key for this domain
     auto& networkAccessManager = NetworkAccessManager::getInstance();
 
@@ -218,9 +375,6 @@ void IceServer::requestDomainPublicKey(const QUuid& domainID) {
 
     qDebug() << "Requesting public key for domain with ID" << domainID;
 
-    // add this to the set of pending public key requests
-    _pendingPublicKeyRequests.insert(domainID);
-
     networkAccessManager.get(publicKeyRequest);
 }
 
@@ -253,7 +407,8 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    QWriteLocker locker(&_domainPublicKeysLock);
+                    _domainPublicKeys[domainID] = std::shared_ptr<RSA>(rsaPublicKey, RSA_free);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -274,38 +429,115 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
     }
 
     // remove this domain ID from the list of pending public key requests
-    _pendingPublicKeyRequests.remove(domainID);
+    {
+        QWriteLocker locker(&_domainPublicKeysLock);
+        _pendingPublicKeyRequests.remove(domainID);
+    }
 
     reply->deleteLater();
 }
 
-void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr) {
+void IceServer::sendPeerInformationPacket(const QByteArray& peerBytes, const HifiSockAddr& destinationSockAddr) {
     auto peerPacket = NLPacket::create(PacketType::ICEServerPeerInformation);
 
     // get the byte array for this peer
-    peerPacket->write(peer.toByteArray());
+    peerPacket->write(peerBytes);
     
     // write the current packet
-    _serverSocket.writePacket(*peerPacket, *destinationSockAddr);
+    _serverSocket.writePacket(*peerPacket, destinationSockAddr);
 }
 
 void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+    for (auto& shard : _peerShards) {
+        QWriteLocker locker(&shard.lock);
+        NetworkPeerHash::iterator peerItem = shard.peers.begin();
 
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
+        while (peerItem != shard.peers.end()) {
+            SharedNetworkPeer peer = peerItem.value();
 
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
+            if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
+                qDebug() << "Removing peer from memory for inactivity -" << *peer;
 
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
+                // if we had a public key for this domain, remove it now
+                {
+                    QWriteLocker keysLocker(&_domainPublicKeysLock);
+                    _domainPublicKeys.erase(peer->getUUID());
+                }
 
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
+                // remove the peer object
+                peerItem = shard.peers.erase(peerItem);
+            } else {
+                // we didn't kill this peer, push the iterator forwards
+                ++peerItem;
+            }
         }
     }
+
+    // the timer fires every second, the change of the totals is the throughput
+    updateThroughput();
+}
+
+void IceServer::updateThroughput() {
+    quint64 totals[10] {};
+    for (auto& worker : _workers) {
+        auto& stats = worker->getStats();
+        totals[0] += stats.heartbeats;
+        totals[1] += stats.cachedVerifications;
+        totals[2] += stats.signatureVerifications;
+        totals[3] += stats.deniedHeartbeats;
+        totals[4] += stats.queries;
+        totals[5] += stats.duplicateQueries;
+        totals[6] += stats.rateLimitedQueries;
+        totals[7] += stats.peerInformationSent;
+        totals[8] += stats.batches;
+    }
+    totals[9] = _packetsReceived;
+
+    static const char* NAMES[] = { "heartbeats", "cachedVerifications", "signatureVerifications", "deniedHeartbeats",
+        "queries", "duplicateQueries", "rateLimitedQueries", "peerInformationSent", "batches", "packetsReceived" };
+
+    QJsonObject totalsObject;
+    QJsonObject throughput;
+    for (int i = 0; i < 10; i++) {
+        totalsObject[NAMES[i]] = (double)totals[i];
+        throughput[NAMES[i]] = (double)totals[i] - _lastTotals[NAMES[i]].toDouble();
+    }
+    _lastTotals = totalsObject;
+    _throughput = throughput;
+}
+
+bool IceServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    if (url.path() == "/status") {
+        QJsonObject status;
+
+        int numPeers = 0;
+        for (auto& shard : _peerShards) {
+            QReadLocker locker(&shard.lock);
+            numPeers += shard.peers.size();
+        }
+        status["peers"] = numPeers;
+        {
+            QReadLocker locker(&_domainPublicKeysLock);
+            status["publicKeys"] = (int)_domainPublicKeys.size();
+            status["pendingPublicKeyRequests"] = _pendingPublicKeyRequests.size();
+        }
+
+        QJsonArray workers;
+        for (auto& worker : _workers) {
+            QJsonObject workerObject;
+            workerObject["queueSize"] = worker->getQueueSize();
+            workerObject["maxBatchSize"] = (double)worker->getStats().maxBatchSize;
+            workers.append(workerObject);
+        }
+        status["workers"] = workers;
+
+        status["totals"] = _lastTotals;
+        status["perSecond"] = _throughput;
+
+        connection->respond(HTTPConnection::StatusCode200, QJsonDocument(status).toJson(),
+                            "application/json");
+    } else {
+        connection->respond(HTTPConnection::StatusCode404);
+    }
+    return true;
 }
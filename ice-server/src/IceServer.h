@@ -12,7 +12,14 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QJsonObject>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSharedPointer>
 #include <QUdpSocket>
 
@@ -20,6 +27,7 @@
 
 #include <UUIDHasher.h>
 
+#include <GenericQueueThread.h>
 #include <NetworkPeer.h>
 #include <HTTPConnection.h>
 #include <HTTPManager.h>
@@ -27,35 +35,120 @@
 #include <udt/Socket.h>
 
 class QNetworkReply;
+class IceServer;
+
+using SharedNLPacket = std::shared_ptr<NLPacket>;
+
+// Processes the packets of a subset of the peers, picked by the sender UUID, so a domain always heartbeats to the
+// same worker and the state kept per sender stays on one thread.
+class IceServerWorker : public GenericQueueThread<SharedNLPacket> {
+    Q_OBJECT
+public:
+    struct Stats {
+        std::atomic<quint64> heartbeats { 0 };
+        std::atomic<quint64> cachedVerifications { 0 };
+        std::atomic<quint64> signatureVerifications { 0 };
+        std::atomic<quint64> deniedHeartbeats { 0 };
+        std::atomic<quint64> queries { 0 };
+        std::atomic<quint64> duplicateQueries { 0 };
+        std::atomic<quint64> rateLimitedQueries { 0 };
+        std::atomic<quint64> peerInformationSent { 0 };
+        std::atomic<quint64> batches { 0 };
+        std::atomic<quint64> maxBatchSize { 0 };
+    };
+
+    IceServerWorker(IceServer& server) : _server(server) {}
+
+    const Stats& getStats() const { return _stats; }
+    int getQueueSize();
+
+protected:
+    bool processQueueItems(const Queue& packets) override;
+    uint32_t getMaxWait() override;
+
+private:
+    struct VerifiedHeartbeat {
+        std::shared_ptr<RSA> publicKey;
+        QByteArray plaintext;
+        QByteArray signature;
+        quint64 lastUsed;
+    };
+
+    struct QueryWindow {
+        quint64 start;
+        int count;
+    };
+
+    void processHeartbeat(NLPacket& packet);
+    void processQuery(NLPacket& packet, QSet<QPair<QUuid, QUuid>>& answeredQueries);
+
+    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
+    bool isRateLimited(const QUuid& senderID, quint64 now);
+    void removeStaleEntries(quint64 now);
+
+    IceServer& _server;
+    Stats _stats;
+
+    // the last verified heartbeat of each domain, a domain sends the same one until its sockets change
+    std::unordered_map<QUuid, VerifiedHeartbeat> _verifiedHeartbeats;
+    std::unordered_map<QUuid, QueryWindow> _queryWindows;
+    quint64 _lastStaleEntriesCheck { 0 };
+};
 
-class IceServer : public QCoreApplication {
+class IceServer : public QCoreApplication, public HTTPRequestHandler {
     Q_OBJECT
 public:
     IceServer(int argc, char* argv[]);
+    ~IceServer();
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void requestDomainPublicKey(const QUuid& domainID);
+
 private:
+    friend class IceServerWorker;
+
+    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
+    struct PeerShard {
+        QReadWriteLock lock;
+        NetworkPeerHash peers;
+    };
+
+    static const int NUM_PEER_SHARDS = 16;
+
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
-    void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
-    void requestDomainPublicKey(const QUuid& domainID);
+    PeerShard& shardForPeer(const QUuid& peerID) { return _peerShards[qHash(peerID) % NUM_PEER_SHARDS]; }
+    void addOrUpdateHeartbeatingPeer(const QUuid& peerID, const HifiSockAddr& publicSocket,
+                                     const HifiSockAddr& localSocket, const HifiSockAddr& senderSockAddr);
+    void sendPeerInformationPacket(const QByteArray& peerBytes, const HifiSockAddr& destinationSockAddr);
+
+    // the public key for the domain, null when it is not known yet
+    std::shared_ptr<RSA> getDomainPublicKey(const QUuid& domainID, bool& isPending);
+
+    void updateThroughput();
 
     QUuid _id;
     udt::Socket _serverSocket;
+    HTTPManager _httpManager;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
+    std::array<PeerShard, NUM_PEER_SHARDS> _peerShards;
+    std::vector<std::unique_ptr<IceServerWorker>> _workers;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    QReadWriteLock _domainPublicKeysLock;
+    using DomainPublicKeyHash = std::unordered_map<QUuid, std::shared_ptr<RSA>>;
     DomainPublicKeyHash _domainPublicKeys;
-
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    std::atomic<quint64> _packetsReceived { 0 };
+
+    // the totals of the last second, to report the rates
+    QJsonObject _lastTotals;
+    QJsonObject _throughput;
 };
 
 #endif // hifi_IceServer_h
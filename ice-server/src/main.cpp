@@ -21,6 +21,7 @@ int main(int argc, char* argv[]) {
 #endif
 
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
+    LogHandler::getInstance().setupFromEnvironment();
     qInfo() << "Starting.";
     
     IceServer iceServer(argc, argv);
@@ -73,6 +73,14 @@ Item {
                         text: "Stutter Rate: " + root.stutterrate.toFixed(3);
                         visible: root.stutterrate != -1;
                     }
+                    StatText {
+                        text: "Pose Latency: " + root.poseLatency.toFixed(1) + " ms";
+                        visible: root.poseLatency != -1;
+                    }
+                    StatText {
+                        text: "Latched Pose Latency: " + root.latchedPoseLatency.toFixed(1) + " ms";
+                        visible: root.latchedPoseLatency != -1;
+                    }
                     StatText {
                         text: "Simrate: " + root.simrate
                     }
@@ -111,7 +119,7 @@ Item {
                     }
                     StatText {
                         visible: root.expanded
-                        text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
+                        text: "Avatars Deferred: " + root.notUpdatedAvatarCount
                     }
                 }
             }
@@ -211,6 +219,10 @@ Item {
                         text: "Downloads: " + root.downloads + "/" + root.downloadLimit +
                               ", Pending: " + root.downloadsPending;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Physics Shapes Pending: " + root.physicsShapesPending;
+                    }
                     StatText {
                         visible: root.expanded && root.downloadUrls.length > 0;
                         text: "Download URLs:"
@@ -255,6 +267,12 @@ Item {
                     StatText {
                         text: "     Avatar: " + root.avatarSimulationTime.toFixed(1) + " ms"
                     }
+                    StatText {
+                        text: "     Joints: " + root.avatarJointsTime.toFixed(1) + " ms"
+                    }
+                    StatText {
+                        text: "         IK: " + root.ikTime.toFixed(2) + " ms / " + root.ikLoops + " loops"
+                    }
                     StatText {
                         text: "Triangles: " + root.triangles +
                             " / Material Switches: " + root.materialSwitches
@@ -299,12 +317,25 @@ Item {
                     StatText {
                         text: "  Memory: " + root.gpuBufferMemory;
                     }
+                    StatText {
+                        text: "Memory Budget: ";
+                    }
+                    StatText {
+                        text: "  Pressure: " + root.memoryBudgetPressureState;
+                    }
+                    StatText {
+                        text: root.memoryBudgetStats;
+                    }
                     StatText {
                         text: "GL Swapchain Memory: " + root.glContextSwapchainMemory + " MB";
                     }
                     StatText {
                         text: "QML Texture Memory: " + root.qmlTextureMemory + " MB";
                     }
+                    StatText {
+                        text: "QML Surfaces: " + root.qmlActiveSurfaces + " rendering " +
+                              root.qmlRenderCost.toFixed(1) + " ms/s";
+                    }
                     StatText {
                         visible: root.expanded;
                         text: "Items rendered / considered: " +
@@ -20,6 +20,7 @@
 
 #include <QtCore/QAbstractNativeEventFilter>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QDirIterator>
 #include <QtCore/QMimeData>
 #include <QtCore/QThreadPool>
 
@@ -83,6 +84,7 @@
 #include <LogHandler.h>
 #include <MainWindow.h>
 #include <MappingRequest.h>
+#include <MemoryBudget.h>
 #include <MessagesClient.h>
 #include <ModelEntityItem.h>
 #include <NetworkAccessManager.h>
@@ -97,11 +99,14 @@
 #include <PerfStat.h>
 #include <PhysicsEngine.h>
 #include <PhysicsHelpers.h>
+#include <SamplingProfiler.h>
+#include <ShapeCache.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <plugins/PluginUtils.h>
 #include <plugins/SteamClientPlugin.h>
 #include <RecordingScriptingInterface.h>
+#include <RenderableParticleEffectEntityItem.h>
 #include <RenderableWebEntityItem.h>
 #include <RenderShadowTask.h>
 #include <render/RenderFetchCullSortTask.h>
@@ -113,6 +118,7 @@
 #include <ScriptEngines.h>
 #include <ScriptCache.h>
 #include <SoundCache.h>
+#include <StartupTimeline.h>
 #include <TabletScriptingInterface.h>
 #include <Tooltip.h>
 #include <udt/PacketHeaders.h>
@@ -232,6 +238,8 @@ static const float PHYSICS_READY_RANGE = 3.0f; // how far from avatar to check f
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
 Setting::Handle<int> maxOctreePacketsPerSecond("maxOctreePPS", DEFAULT_MAX_OCTREE_PPS);
+// Steps the physics on its own thread, a frame behind, while the rest of the frame runs
+Setting::Handle<bool> physicsThread { "physicsThread", false };
 
 static const QString MARKETPLACE_CDN_HOSTNAME = "mpassets.highfidelity.com";
 
@@ -421,11 +429,32 @@ static const QString STATE_ADVANCED_MOVEMENT_CONTROLS = "AdvancedMovement";
 static const QString STATE_GROUNDED = "Grounded";
 static const QString STATE_NAV_FOCUSED = "NavigationFocused";
 
-bool setupEssentials(int& argc, char** argv) {
+// reads the QML of the UI ahead of its creation, so that its compilation on the main thread doesn't wait on the disk
+static void prefetchQml() {
+    QDirIterator it(PathUtils::resourcesPath() + "qml", QStringList() << "*.qml" << "*.js", QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFile file(it.next());
+        if (file.open(QIODevice::ReadOnly)) {
+            file.readAll();
+        }
+    }
+}
+
+bool setupEssentials(int& argc, char** argv, const QElapsedTimer& startupTimer) {
     const char** constArgv = const_cast<const char**>(argv);
     const char* portStr = getCmdOption(argc, constArgv, "--listenPort");
     const int listenPort = portStr ? atoi(portStr) : INVALID_PORT;
 
+    // the independent parts of the startup run on the thread pool while the main thread goes on, each subsystem waits
+    // for its part where it needs it: the plugins are created from their libraries, the caches wait for their index
+    auto startupTimeline = DependencyManager::set<StartupTimeline>(startupTimer);
+    startupTimeline->mark("setupEssentials");
+    startupTimeline->runTask("loadPluginLibraries", [] {
+        PluginManager::getInstance()->loadPluginLibraries();
+    });
+    startupTimeline->runTask("prefetchQml", prefetchQml);
+
     Setting::init();
 
     if (auto steamClient = PluginManager::getInstance()->getSteamClientPlugin()) {
@@ -433,6 +462,7 @@ bool setupEssentials(int& argc, char** argv) {
     }
 
     DependencyManager::set<tracing::Tracer>();
+    DependencyManager::set<SamplingProfiler>()->startFromEnvironment();
     PROFILE_SET_THREAD_NAME("Main Thread");
 
 #if defined(Q_OS_WIN)
@@ -458,6 +488,8 @@ bool setupEssentials(int& argc, char** argv) {
     // Set dependencies
     DependencyManager::set<AccountManager>(std::bind(&Application::getUserAgent, qApp));
     DependencyManager::set<StatTracker>();
+    // before the caches, which register with it
+    DependencyManager::set<MemoryBudget>();
     DependencyManager::set<ScriptEngines>(ScriptEngine::CLIENT_SCRIPT);
     DependencyManager::set<Preferences>();
     DependencyManager::set<recording::Deck>();
@@ -517,6 +549,7 @@ bool setupEssentials(int& argc, char** argv) {
     DependencyManager::set<OffscreenQmlSurfaceCache>();
     DependencyManager::set<EntityScriptClient>();
     DependencyManager::set<EntityScriptServerLogClient>();
+    startupTimeline->mark("essentialsSetUp");
     return previousSessionCrashed;
 }
 
@@ -553,7 +586,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     _runningMarker(this, RUNNING_MARKER_FILENAME),
     _window(new MainWindow(desktop())),
     _sessionRunTimer(startupTimer),
-    _previousSessionCrashed(setupEssentials(argc, argv)),
+    _previousSessionCrashed(setupEssentials(argc, argv, startupTimer)),
     _undoStackScriptingInterface(&_undoStack),
     _entitySimulation(new PhysicalEntitySimulation()),
     _physicsEngine(new PhysicsEngine(Vectors::ZERO)),
@@ -728,9 +761,10 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     });
 
     audioIO->moveToThread(audioThread);
+    // the audio frames go straight from the playback thread to the audio thread
     recording::Frame::registerFrameHandler(AudioConstants::getAudioFrameName(), [=](recording::Frame::ConstPointer frame) {
-        audioIO->handleRecordedAudioInput(frame->data);
-    });
+        QMetaObject::invokeMethod(audioIO.data(), "handleRecordedAudioInput", Q_ARG(const QByteArray&, frame->data));
+    }, true);
 
     connect(audioIO.data(), &AudioClient::inputReceived, [](const QByteArray& audio){
         static auto recorder = DependencyManager::get<recording::Recorder>();
@@ -1420,6 +1454,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
 
     connect(this, &Application::applicationStateChanged, this, &Application::activeChanged);
     qCDebug(interfaceapp, "Startup time: %4.2f seconds.", (double)startupTimer.elapsed() / 1000.0);
+    DependencyManager::get<StartupTimeline>()->mark("constructed");
 
     auto textureCache = DependencyManager::get<TextureCache>();
 
@@ -1783,6 +1818,9 @@ Application::~Application() {
     _entityClipboard->eraseAllOctreeElements();
     _entityClipboard.reset();
 
+    if (_physicsThread) {
+        _physicsThread->wait();
+    }
     EntityTreePointer tree = getEntities()->getTree();
     tree->setSimulation(nullptr);
 
@@ -1861,21 +1899,38 @@ void Application::initializeGL() {
     // we need to restore primary rendering context
     _glWidget->makeCurrent();
 
+    {
+        auto memoryBudget = DependencyManager::get<MemoryBudget>();
+        memoryBudget->registerClient(gpu::Texture::getMemoryBudgetClient());
+        memoryBudget->setFreeGPUMemoryQuery([] { return (qint64)gpu::Context::getFreeGPUMemory(); });
+        memoryBudget->start();
+    }
+
     initDisplay();
     qCDebug(interfaceapp, "Initialized Display.");
+    DependencyManager::get<StartupTimeline>()->mark("displayInitialized");
 
     // Set up the render engine
     render::CullFunctor cullFunctor = LODManager::shouldRender;
-    _renderEngine->addJob<RenderShadowTask>("RenderShadowTask", cullFunctor);
+    auto lodManager = DependencyManager::get<LODManager>();
+    render::CullFunctor shadowCullFunctor = [lodManager](const RenderArgs* args, const AABox& bounds) {
+        return lodManager->shouldRenderShadow(args, bounds);
+    };
+    _renderEngine->addJob<BlendModelVertices>("BlendModelVertices");
+    _renderEngine->addJob<SimulateGPUParticles>("SimulateGPUParticles");
+    _renderEngine->addJob<RenderShadowTask>("RenderShadowTask", shadowCullFunctor);
     const auto items = _renderEngine->addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor);
     assert(items.canCast<RenderFetchCullSortTask::Output>());
+    // Both tasks are built, the active display plugin picks the one rendering each frame;
+    // the deferred task comes first so the configs looked up by name are still its own
     static const QString RENDER_FORWARD = "HIFI_RENDER_FORWARD";
-    if (QProcessEnvironment::systemEnvironment().contains(RENDER_FORWARD)) {
-        _renderEngine->addJob<RenderForwardTask>("Forward", items.get<RenderFetchCullSortTask::Output>());
-    } else {
-        _renderEngine->addJob<RenderDeferredTask>("RenderDeferredTask", items.get<RenderFetchCullSortTask::Output>());
-    }
+    _forceForwardRendering = QProcessEnvironment::systemEnvironment().contains(RENDER_FORWARD);
+    _renderEngine->addJob<RenderDeferredTask>("RenderDeferredTask", items.get<RenderFetchCullSortTask::Output>());
+    _renderEngine->addJob<RenderForwardTask>("Forward", items.get<RenderFetchCullSortTask::Output>());
     _renderEngine->load();
+    // Spread the scene changes of a domain loading over a few frames rather than stalling one
+    static const size_t MAX_SCENE_CHANGES_PER_FRAME = 10000;
+    _main3DScene->setMaxChangesPerFrame(MAX_SCENE_CHANGES_PER_FRAME);
     _renderEngine->registerScene(_main3DScene);
 
     // The UI can't be created until the primary OpenGL
@@ -1884,6 +1939,7 @@ void Application::initializeGL() {
     // Needs to happen AFTER the render engine initialization to access its configuration
     initializeUi();
     qCDebug(interfaceapp, "Initialized Offscreen UI.");
+    DependencyManager::get<StartupTimeline>()->mark("uiInitialized");
     _glWidget->makeCurrent();
 
 
@@ -1893,6 +1949,7 @@ void Application::initializeGL() {
 
     init();
     qCDebug(interfaceapp, "init() complete.");
+    DependencyManager::get<StartupTimeline>()->mark("initialized");
 
     // create thread for parsing of octree data independent of the main network and rendering threads
     _octreeProcessor.initialize(_enableProcessOctreeThread);
@@ -2273,6 +2330,17 @@ void Application::paintGL() {
             });
             renderArgs._context->setStereoProjections(eyeProjections);
             renderArgs._context->setStereoViews(eyeOffsets);
+
+            // Center the full rate region on where the user looks when the eyes are tracked, on the lenses otherwise
+            renderArgs._foveationRadius = displayPlugin->getFoveationRadius();
+            if (renderArgs._foveationRadius > 0.0f) {
+                auto eyeTracker = DependencyManager::get<EyeTracker>();
+                vec3 gazeDirection = eyeTracker->isTracking() ? glm::normalize(eyeTracker->getLookAtPosition()) : vec3(0.0f, 0.0f, -1.0f);
+                for_each_eye([&](Eye eye) {
+                    vec4 gazeClip = eyeProjections[eye] * vec4(gazeDirection, 0.0f);
+                    renderArgs._foveationCenters[eye] = (gazeClip.w > 0.0f) ? vec2(gazeClip) / gazeClip.w : vec2(0.0f);
+                });
+            }
         }
         renderArgs._blitFramebuffer = finalFramebuffer;
         displaySide(&renderArgs, _myCamera);
@@ -2303,6 +2371,14 @@ void Application::paintGL() {
 
     uint64_t lastPaintDuration = usecTimestampNow() - lastPaintBegin;
     _frameTimingsScriptingInterface.addValue(lastPaintDuration);
+    lodManager->setRenderTime((float)lastPaintDuration / USECS_PER_MSEC);
+
+    auto startupTimeline = DependencyManager::get<StartupTimeline>();
+    if (!startupTimeline->isFinished() && startupTimeline->finish("firstFrame")) {
+        QJsonObject details = startupTimeline->toJson();
+        details["version"] = BuildInfo::VERSION;
+        UserActivityLogger::getInstance().logAction("startup_timeline", details);
+    }
 }
 
 void Application::runTests() {
@@ -2460,7 +2536,25 @@ bool Application::event(QEvent* event) {
     // Presentation/painting logic
     // TODO: Decouple presentation and painting loops
     static bool isPaintingThrottled = false;
+    static bool isFramePaced = false;
     if ((int)event->type() == (int)Present) {
+        // Start the frame as late as the display plugin can still present it on time, for the most recent pose
+        if (!isFramePaced) {
+            const int64_t MIN_FRAME_START_DELAY_USECS = USECS_PER_MSEC;
+            int64_t frameStartDelay = getActiveDisplayPlugin()->getFrameStartDelayUsecs();
+            if (frameStartDelay >= MIN_FRAME_START_DELAY_USECS) {
+                isFramePaced = true;
+                QTimer::singleShot((int)(frameStartDelay / USECS_PER_MSEC), Qt::PreciseTimer, this, [this] {
+                    // unless a present came first
+                    if (isFramePaced) {
+                        postEvent(this, new QEvent(static_cast<QEvent::Type>(Present)), Qt::HighEventPriority);
+                    }
+                });
+                return true;
+            }
+        }
+        isFramePaced = false;
+
         if (isPaintingThrottled) {
             // If painting (triggered by presentation) is hogging the main thread,
             // repost as low priority to avoid hanging the GUI.
@@ -3513,7 +3607,9 @@ void Application::idle(float nsecsElapsed) {
         PerformanceTimer perfTimer("update");
         PerformanceWarning warn(showWarnings, "Application::idle()... update()");
         static const float BIGGEST_DELTA_TIME_SECS = 0.25f;
+        quint64 updateBegin = usecTimestampNow();
         update(glm::clamp(secondsSinceLastUpdate, 0.0f, BIGGEST_DELTA_TIME_SECS));
+        DependencyManager::get<LODManager>()->setUpdateTime((float)(usecTimestampNow() - updateBegin) / USECS_PER_MSEC);
     }
 
 
@@ -3844,6 +3940,8 @@ void Application::init() {
     DependencyManager::get<NodeList>()->sendDomainServerCheckIn();
 
     getEntities()->init();
+    // the entity packets are decoded on the octree processing thread, and read into the tree here in update()
+    getEntities()->setAppliesDecodedPackets(true);
     {
         QMutexLocker viewLocker(&_viewMutex);
         getEntities()->setViewFrustum(_viewFrustum);
@@ -3861,8 +3959,12 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    _shapeManager.setShapeCache(std::make_shared<ShapeCache>(ShapeCache::DIRNAME, ShapeCache::EXT));
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
+    if (physicsThread.get()) {
+        _physicsThread.reset(new PhysicsThread());
+    }
 
     EntityTreePointer tree = getEntities()->getTree();
     _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
@@ -3904,10 +4006,12 @@ void Application::init() {
 void Application::updateLOD() const {
     PerformanceTimer perfTimer("LOD");
     // adjust it unless we were asked to disable this feature, or if we're currently in throttleRendering mode
+    auto lodManager = DependencyManager::get<LODManager>();
     if (!isThrottleRendering()) {
-        DependencyManager::get<LODManager>()->autoAdjustLOD(_frameCounter.rate());
+        lodManager->setGPUTime((float)_gpuContext->getFrameTimerGPUAverage());
+        lodManager->autoAdjustLOD(_frameCounter.rate());
     } else {
-        DependencyManager::get<LODManager>()->resetLODAdjust();
+        lodManager->resetLODAdjust();
     }
 }
 
@@ -4242,6 +4346,9 @@ void Application::updateDialogs(float deltaTime) const {
 
 static bool domainLoadingInProgress = false;
 
+// the time each frame may hold the entity tree's write lock to read the decoded entity packets into it
+static const quint64 MAX_ENTITY_PACKETS_APPLY_USECS = 2 * USECS_PER_MSEC;
+
 void Application::update(float deltaTime) {
 
     PROFILE_RANGE_EX(app, __FUNCTION__, 0xffff0000, (uint64_t)_frameCount + 1);
@@ -4251,6 +4358,11 @@ void Application::update(float deltaTime) {
 
     updateLOD();
 
+    {
+        PerformanceTimer perfTimer("entityPackets");
+        getEntities()->applyDecodedPackets(MAX_ENTITY_PACKETS_APPLY_USECS);
+    }
+
     if (!_physicsEnabled) {
         if (!domainLoadingInProgress) {
             PROFILE_ASYNC_BEGIN(app, "Scene Loading", "");
@@ -4266,7 +4378,9 @@ void Application::update(float deltaTime) {
             timeout = true;
         }
 
-        if (timeout || _fullSceneReceivedCounter > _fullSceneCounterAtLastPhysicsCheck) {
+        // the scene isn't all there while some of its packets are still to be read into the tree
+        bool hasEntityPacketsToApply = getEntities()->hasDecodedPackets();
+        if ((timeout || _fullSceneReceivedCounter > _fullSceneCounterAtLastPhysicsCheck) && !hasEntityPacketsToApply) {
             // we've received a new full-scene octree stats packet, or it's been long enough to try again anyway
             _lastPhysicsCheckTime = now;
             _fullSceneCounterAtLastPhysicsCheck = _fullSceneReceivedCounter;
@@ -4386,7 +4500,7 @@ void Application::update(float deltaTime) {
 
         PerformanceTimer perfTimer("physics");
 
-        {
+        auto updateStates = [&] {
             PROFILE_RANGE_EX(simulation_physics, "UpdateStats", 0xffffff00, (uint64_t)getActiveDisplayPlugin()->presentCount());
 
             PerformanceTimer perfTimer("updateStates)");
@@ -4401,6 +4515,8 @@ void Application::update(float deltaTime) {
 
             });
             getEntities()->getTree()->withReadLock([&] {
+                _entitySimulation->setPhysicsLODCenter(getMyAvatar()->getPosition());
+                _entitySimulation->updatePhysicsLOD();
                 _entitySimulation->getObjectsToChange(motionStates);
                 VectorOfMotionStates stillNeedChange = _physicsEngine->changeObjects(motionStates);
                 _entitySimulation->setObjectsToChange(stillNeedChange);
@@ -4419,15 +4535,14 @@ void Application::update(float deltaTime) {
             _physicsEngine->forEachAction([&](EntityActionPointer action) {
                 action->prepareForPhysicsSimulation();
             });
-        }
-        {
-            PROFILE_RANGE_EX(simulation_physics, "StepSimulation", 0xffff8000, (uint64_t)getActiveDisplayPlugin()->presentCount());
-            PerformanceTimer perfTimer("stepSimulation");
+        };
+        auto stepSimulation = [this] {
+            PROFILE_RANGE(simulation_physics, "StepSimulation");
             getEntities()->getTree()->withWriteLock([&] {
                 _physicsEngine->stepSimulation();
             });
-        }
-        {
+        };
+        auto harvestChanges = [&] {
             PROFILE_RANGE_EX(simulation_physics, "HarvestChanges", 0xffffff00, (uint64_t)getActiveDisplayPlugin()->presentCount());
             PerformanceTimer perfTimer("harvestChanges");
             if (_physicsEngine->hasOutgoingChanges()) {
@@ -4467,6 +4582,25 @@ void Application::update(float deltaTime) {
                 // NOTE: the PhysicsEngine stats are written to stdout NOT to Qt log framework
                 _physicsEngine->dumpStatsIfNecessary();
             }
+        };
+
+        if (_physicsThread) {
+            // The step handed over last frame ran alongside the rest of that frame and its rendering: collect its
+            // results, queue this frame's changes and hand over the next step before moving on.
+            {
+                PerformanceTimer perfTimer("waitForSimulation");
+                _physicsThread->wait();
+            }
+            harvestChanges();
+            updateStates();
+            _physicsThread->start(stepSimulation);
+        } else {
+            updateStates();
+            {
+                PerformanceTimer perfTimer("stepSimulation");
+                stepSimulation();
+            }
+            harvestChanges();
         }
     }
 
@@ -4503,6 +4637,8 @@ void Application::update(float deltaTime) {
     {
         QMutexLocker viewLocker(&_viewMutex);
         loadViewFrustum(_myCamera, _viewFrustum);
+        // the models that are loading follow the view
+        getEntities()->setViewFrustum(_viewFrustum);
     }
 
     quint64 now = usecTimestampNow();
@@ -5092,6 +5228,11 @@ void Application::displaySide(RenderArgs* renderArgs, Camera& theCamera, bool se
         }
         _renderEngine->getRenderContext()->args = renderArgs;
 
+        bool forwardRendered = _forceForwardRendering || getActiveDisplayPlugin()->isForwardRendered();
+        auto renderConfig = _renderEngine->getConfiguration();
+        renderConfig->getConfig<RenderForwardTask>("Forward")->setEnabled(forwardRendered);
+        renderConfig->getConfig<RenderDeferredTask>("RenderDeferredTask")->setEnabled(!forwardRendered);
+
         // Before the deferred pass, let's try to use the render engine
         _renderEngine->run();
     }
@@ -6356,6 +6497,9 @@ void Application::checkSkeleton() const {
 
         getMyAvatar()->useFullAvatarURL(AvatarData::defaultFullAvatarModelUrl(), DEFAULT_FULL_AVATAR_MODEL_NAME);
     } else {
+        if (_physicsThread) {
+            _physicsThread->wait();
+        }
         _physicsEngine->setCharacterController(getMyAvatar()->getCharacterController());
     }
 }
@@ -35,6 +35,7 @@
 #include <OctreeQuery.h>
 #include <PhysicalEntitySimulation.h>
 #include <PhysicsEngine.h>
+#include <PhysicsThread.h>
 #include <plugins/Forward.h>
 #include <plugins/DisplayPlugin.h>
 #include <ui-plugins/PluginContainer.h>
@@ -536,6 +537,7 @@ private:
     ShapeManager _shapeManager;
     PhysicalEntitySimulationPointer _entitySimulation;
     PhysicsEnginePointer _physicsEngine;
+    std::unique_ptr<PhysicsThread> _physicsThread;
 
     EntityTreeRenderer _entityClipboardRenderer;
     EntityTreePointer _entityClipboard;
@@ -616,6 +618,7 @@ private:
 
     render::ScenePointer _main3DScene{ new render::Scene(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE) };
     render::EnginePointer _renderEngine{ new render::Engine() };
+    bool _forceForwardRendering { false };
     gpu::ContextPointer _gpuContext; // initialized during window creation
 
     Overlays _overlays;
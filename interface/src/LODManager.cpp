@@ -11,6 +11,7 @@
 
 #include <SettingHandle.h>
 #include <OctreeUtils.h>
+#include <RenderableParticleEffectEntityItem.h>
 #include <Util.h>
 
 #include "Application.h"
@@ -22,7 +23,21 @@
 Setting::Handle<float> desktopLODDecreaseFPS("desktopLODDecreaseFPS", DEFAULT_DESKTOP_LOD_DOWN_FPS);
 Setting::Handle<float> hmdLODDecreaseFPS("hmdLODDecreaseFPS", DEFAULT_HMD_LOD_DOWN_FPS);
 
+// the number of details each controller lowers, in order
+static const int NUM_GPU_DETAILS = 3; // shadows, particles, render LOD
+static const int NUM_RENDER_DETAILS = 2; // shadows, render LOD
+static const int NUM_UPDATE_DETAILS = 2; // animation LOD, particles
+
 LODManager::LODManager() {
+    // the controllers compute how much detail to take away, none until a stage is over budget
+    for (auto controller : { &_gpuController, &_renderController, &_updateController }) {
+        controller->setKP(-FRAME_COST_KP);
+        controller->setKI(-FRAME_COST_KI);
+        controller->setControlledValueLowLimit(0.0f);
+    }
+    _gpuController.setControlledValueHighLimit((float)NUM_GPU_DETAILS);
+    _renderController.setControlledValueHighLimit((float)NUM_RENDER_DETAILS);
+    _updateController.setControlledValueHighLimit((float)NUM_UPDATE_DETAILS);
 }
 
 float LODManager::getLODDecreaseFPS() {
@@ -40,6 +55,90 @@ float LODManager::getLODIncreaseFPS() {
 }
 
 void LODManager::autoAdjustLOD(float currentFPS) {
+    quint64 now = usecTimestampNow();
+    float deltaTime = (_lastFrameCostAdjust > 0 ? (float)(now - _lastFrameCostAdjust) / USECS_PER_SECOND : 0.0f);
+    _lastFrameCostAdjust = now;
+
+    if (_renderTime > 0.0f && _gpuTime > 0.0f && _updateTime > 0.0f) {
+        autoAdjustLODFromFrameCost(deltaTime);
+    } else {
+        autoAdjustLODFromFPS(currentFPS);
+    }
+}
+
+// the detail lowered by a controller, each one only once the ones before it are at their lowest
+static float getControlledDetail(float controlledValue, int detail, int numDetails) {
+    float value = glm::clamp(controlledValue - (float)(numDetails - 1 - detail), 0.0f, 1.0f);
+    return glm::round(value * FRAME_COST_DETAIL_STEPS) / FRAME_COST_DETAIL_STEPS;
+}
+
+float LODManager::updateFrameCostController(PIDController& controller, float measuredTime, float budget, int numDetails,
+                                            float deltaTime) {
+    // the accumulated error is enough to go across all the details, but no more, so it turns back as soon as the cost does
+    controller.setMeasuredValueSetpoint(budget);
+    controller.setAntiWindupFactor((float)numDetails / (FRAME_COST_KI * budget));
+    return (float)numDetails - controller.update(measuredTime, deltaTime, _resetFrameCostControllers);
+}
+
+void LODManager::autoAdjustLODFromFrameCost(float deltaTime) {
+    // NOTE: like the frame rates, the costs of the first frames are all over the place
+    const int IGNORE_THESE_SAMPLES = 100;
+    if (_frameCostSampleCount < IGNORE_THESE_SAMPLES) {
+        _frameCostSampleCount++;
+        return;
+    }
+    if (!_automaticLODAdjust) {
+        return;
+    }
+
+    const float MIN_DELTA_TIME = 0.001f;
+    const float MAX_DELTA_TIME = 0.25f;
+    deltaTime = glm::clamp(deltaTime, MIN_DELTA_TIME, MAX_DELTA_TIME);
+    float frameTime = (float)MSECS_PER_SECOND / getLODIncreaseFPS();
+
+    float gpuValue = updateFrameCostController(_gpuController, _gpuTime, GPU_FRAME_BUDGET * frameTime,
+                                               NUM_GPU_DETAILS, deltaTime);
+    float renderValue = updateFrameCostController(_renderController, _renderTime, RENDER_FRAME_BUDGET * frameTime,
+                                                  NUM_RENDER_DETAILS, deltaTime);
+    float updateValue = updateFrameCostController(_updateController, _updateTime, UPDATE_FRAME_BUDGET * frameTime,
+                                                  NUM_UPDATE_DETAILS, deltaTime);
+    _resetFrameCostControllers = false;
+
+    // each detail is as low as the most loaded stage it relieves asks for
+    float shadowDetail = glm::min(getControlledDetail(gpuValue, 0, NUM_GPU_DETAILS),
+                                  getControlledDetail(renderValue, 0, NUM_RENDER_DETAILS));
+    float particleDetail = glm::min(getControlledDetail(gpuValue, 1, NUM_GPU_DETAILS),
+                                    getControlledDetail(updateValue, 1, NUM_UPDATE_DETAILS));
+    float renderDetail = glm::min(getControlledDetail(gpuValue, 2, NUM_GPU_DETAILS),
+                                  getControlledDetail(renderValue, 1, NUM_RENDER_DETAILS));
+    float animationDetail = getControlledDetail(updateValue, 0, NUM_UPDATE_DETAILS);
+
+    _shadowLODFraction = glm::mix(MIN_SHADOW_LOD_FRACTION, 1.0f, shadowDetail);
+    _animationLODFraction = glm::mix(MIN_ANIMATION_LOD_FRACTION, 1.0f, animationDetail);
+    _particleBudget = glm::mix(MIN_PARTICLE_BUDGET, 1.0f, particleDetail);
+    RenderableParticleEffectEntityItem::setParticleBudget(_particleBudget);
+
+    float octreeSizeScale = glm::mix(ADJUST_LOD_MIN_SIZE_SCALE, ADJUST_LOD_MAX_SIZE_SCALE, renderDetail);
+    if (octreeSizeScale != _octreeSizeScale) {
+        bool decreased = octreeSizeScale < _octreeSizeScale;
+        _octreeSizeScale = octreeSizeScale;
+        qCDebug(interfaceapp) << "adjusting LOD" << (decreased ? "DOWN" : "UP") << "from the frame cost..."
+                              << "gpu:" << _gpuTime << "render:" << _renderTime << "update:" << _updateTime
+                              << "budget:" << frameTime << " NEW _octreeSizeScale=" << _octreeSizeScale;
+        if (decreased) {
+            emit LODDecreased();
+        } else {
+            emit LODIncreased();
+        }
+
+        auto lodToolsDialog = DependencyManager::get<DialogsManager>()->getLodToolsDialog();
+        if (lodToolsDialog) {
+            lodToolsDialog->reloadSliders();
+        }
+    }
+}
+
+void LODManager::autoAdjustLODFromFPS(float currentFPS) {
     
     // NOTE: our first ~100 samples at app startup are completely all over the place, and we don't
     // really want to count them in our average, so we will ignore the real frame rates and stuff
@@ -174,6 +273,7 @@ void LODManager::resetLODAdjust() {
     _fpsAverageUpWindow.reset();
     _lastUpShift = _lastDownShift = usecTimestampNow();
     _isDownshifting = false;
+    _resetFrameCostControllers = true;
 }
 
 QString LODManager::getLODFeedbackText() {
@@ -221,6 +321,12 @@ bool LODManager::shouldRender(const RenderArgs* args, const AABox& bounds) {
     return (renderAccuracy > 0.0f);
 };
 
+bool LODManager::shouldRenderShadow(const RenderArgs* args, const AABox& bounds) const {
+    float sizeScale = args->_sizeScale * _shadowLODFraction;
+    float renderAccuracy = calculateRenderAccuracy(args->getViewFrustum().getPosition(), bounds, sizeScale, args->_boundaryLevelAdjust);
+    return (renderAccuracy > 0.0f);
+}
+
 void LODManager::setOctreeSizeScale(float sizeScale) {
     _octreeSizeScale = sizeScale;
 }
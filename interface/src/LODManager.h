@@ -12,6 +12,8 @@
 #ifndef hifi_LODManager_h
 #define hifi_LODManager_h
 
+#include <atomic>
+
 #include <DependencyManager.h>
 #include <NumericalConstants.h>
 #include <OctreeConstants.h>
@@ -45,6 +47,22 @@ const float ADJUST_LOD_MAX_SIZE_SCALE = DEFAULT_OCTREE_SIZE_SCALE;
 // This controls how low the auto-adjust LOD will go. We want a minimum vision of ~20:500 or 0.04 of default
 const float ADJUST_LOD_MIN_SIZE_SCALE = DEFAULT_OCTREE_SIZE_SCALE * 0.04f;
 
+// When the cost of the stages of the frames is measured, each stage is kept within its share of the frame time at
+// getLODIncreaseFPS(), by lowering the detail that relieves it: shadows, then particles, then the render LOD for the gpu,
+// shadows then the render LOD for the rendering on the cpu, the avatar animation LOD then particles for the updates.
+const float GPU_FRAME_BUDGET = 1.0f; // the gpu works alongside the cpu, on the whole frame
+const float RENDER_FRAME_BUDGET = 0.6f;
+const float UPDATE_FRAME_BUDGET = 0.4f;
+
+const float FRAME_COST_KP = 0.02f; // detail per millisecond over budget
+const float FRAME_COST_KI = 0.2f; // detail per millisecond over budget for a second
+const int FRAME_COST_DETAIL_STEPS = 20; // the details change by steps, not to query and reset on each frame
+
+// the lowest details, as a fraction of the full one
+const float MIN_SHADOW_LOD_FRACTION = 0.1f; // of the render LOD
+const float MIN_ANIMATION_LOD_FRACTION = 0.04f; // of the render LOD
+const float MIN_PARTICLE_BUDGET = 0.1f; // of the max particles of each effect
+
 class RenderArgs;
 class AABox;
 
@@ -75,7 +93,20 @@ public:
     Q_INVOKABLE float getLODDecreaseFPS();
     Q_INVOKABLE float getLODIncreaseFPS();
     
+    // The details lowered to keep the frames within their budget, along with the render LOD
+    Q_INVOKABLE float getShadowLODFraction() const { return _shadowLODFraction; }
+    Q_INVOKABLE float getAnimationSizeScale() const { return _octreeSizeScale * _animationLODFraction; }
+    Q_INVOKABLE float getParticleBudget() const { return _particleBudget; }
+
     static bool shouldRender(const RenderArgs* args, const AABox& bounds);
+    bool shouldRenderShadow(const RenderArgs* args, const AABox& bounds) const;
+
+    // The measured cost of the stages of the last frame, in milliseconds. Until they are all known the LOD is adjusted
+    // from the frame rate alone.
+    void setRenderTime(float renderTime) { _renderTime = renderTime; }
+    void setGPUTime(float gpuTime) { _gpuTime = gpuTime; }
+    void setUpdateTime(float updateTime) { _updateTime = updateTime; }
+
     void autoAdjustLOD(float currentFPS);
     
     void loadSettings();
@@ -88,6 +119,11 @@ signals:
     
 private:
     LODManager();
+
+    void autoAdjustLODFromFPS(float currentFPS);
+    void autoAdjustLODFromFrameCost(float deltaTime);
+    float updateFrameCostController(PIDController& controller, float measuredTime, float budget, int numDetails,
+                                    float deltaTime);
     
     bool _automaticLODAdjust = true;
     float _desktopLODDecreaseFPS = DEFAULT_DESKTOP_LOD_DOWN_FPS;
@@ -104,6 +140,20 @@ private:
     SimpleMovingAverage _fpsAverageStartWindow = START_DELAY_SAMPLES_OF_FRAMES;
     SimpleMovingAverage _fpsAverageDownWindow = DOWN_SHIFT_SAMPLES_OF_FRAMES;
     SimpleMovingAverage _fpsAverageUpWindow = UP_SHIFT_SAMPLES_OF_FRAMES;
+
+    float _renderTime { 0.0f };
+    float _gpuTime { 0.0f };
+    float _updateTime { 0.0f };
+    int _frameCostSampleCount { 0 };
+    quint64 _lastFrameCostAdjust { 0 };
+    bool _resetFrameCostControllers { false };
+    PIDController _gpuController;
+    PIDController _renderController;
+    PIDController _updateController;
+
+    std::atomic<float> _shadowLODFraction { 1.0f }; // read by the culling of the shadows
+    float _animationLODFraction { 1.0f };
+    float _particleBudget { 1.0f };
 };
 
 #endif // hifi_LODManager_h
@@ -9,9 +9,12 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QDateTime>
+#include <QFile>
 #include <QFileDialog>
 #include <QMenuBar>
 #include <QShortcut>
+#include <QStandardPaths>
 
 #include <thread>
 
@@ -21,6 +24,7 @@
 #include <DependencyManager.h>
 #include <display-plugins/DisplayPlugin.h>
 #include <PathUtils.h>
+#include <SamplingProfiler.h>
 #include <SettingHandle.h>
 #include <UserActivityLogger.h>
 #include <VrMenu.h>
@@ -397,6 +401,18 @@ Menu::Menu() {
     // Developer > Render > LOD Tools
     addActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::LodTools, 0, dialogsManager.data(), SLOT(lodTools()));
 
+    // Developer > Render > Capture GPU Frame
+    {
+        auto action = addActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::CaptureGPUFrame);
+        connect(action, &QAction::triggered, [] {
+            // the next frame, for the gpu-frame-player tool
+            QString fileName = QString("hifi-frame-%1.hfgf").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"));
+            QString path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/" + fileName;
+            qApp->getGPUContext()->captureFrame(path.toStdString());
+            qCDebug(interfaceapp) << "Capturing the next frame to" << path;
+        });
+    }
+
     // HACK enable texture decimation
     {
         auto action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, "Decimate Textures");
@@ -588,6 +604,33 @@ Menu::Menu() {
     addCheckableActionToQMenuAndActionHash(timingMenu, MenuOption::PipelineWarnings);
     addCheckableActionToQMenuAndActionHash(timingMenu, MenuOption::LogExtraTimings);
     addCheckableActionToQMenuAndActionHash(timingMenu, MenuOption::SuppressShortTimings);
+    {
+        auto profiler = DependencyManager::get<SamplingProfiler>();
+        auto action = addCheckableActionToQMenuAndActionHash(timingMenu, MenuOption::SamplingProfiler, 0,
+                                                             profiler->isSampling());
+        connect(action, &QAction::triggered, [](bool checked) {
+            auto profiler = DependencyManager::get<SamplingProfiler>();
+            if (checked) {
+                profiler->reset();
+                profiler->start();
+            } else {
+                profiler->stop();
+            }
+        });
+    }
+    action = addActionToQMenuAndActionHash(timingMenu, MenuOption::DumpSampledStacks);
+    connect(action, &QAction::triggered, [] {
+        // the folded stacks, for flamegraph.pl or speedscope
+        QString fileName = QString("hifi-sampled-stacks-%1.txt").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"));
+        QString path = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/" + fileName;
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(DependencyManager::get<SamplingProfiler>()->getFoldedStacks());
+            qCDebug(interfaceapp) << "Wrote the sampled stacks to" << path;
+        } else {
+            qCWarning(interfaceapp) << "Could not write the sampled stacks to" << path;
+        }
+    });
 
 
     // Developer > Audio >>>
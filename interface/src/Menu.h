@@ -52,6 +52,7 @@ namespace MenuOption {
     const QString BookmarkLocation = "Bookmark Location";
     const QString Bookmarks = "Bookmarks";
     const QString CalibrateCamera = "Calibrate Camera";
+    const QString CaptureGPUFrame = "Capture GPU Frame";
     const QString CameraEntityMode = "Entity Mode";
     const QString CenterPlayerInView = "Center Player In View";
     const QString Chat = "Chat...";
@@ -91,6 +92,7 @@ namespace MenuOption {
     const QString DisplayDebugTimingDetails = "Display Timing Details";
     const QString DontDoPrecisionPicking = "Don't Do Precision Picking";
     const QString DontRenderEntitiesAsScene = "Don't Render Entities as Scene";
+    const QString DumpSampledStacks = "Dump Sampled Stacks";
     const QString EchoLocalAudio = "Echo Local Audio";
     const QString EchoServerAudio = "Echo Server Audio";
     const QString EnableCharacterController = "Enable avatar collisions";
@@ -166,6 +168,7 @@ namespace MenuOption {
     const QString RunningScripts = "Running Scripts...";
     const QString RunClientScriptTests = "Run Client Script Tests";
     const QString RunTimingTests = "Run Timing Tests";
+    const QString SamplingProfiler = "Sampling Profiler";
     const QString ScriptedMotorControl = "Enable Scripted Motor Control";
     const QString SendWrongDSConnectVersion = "Send wrong DS connect version";
     const QString SendWrongProtocolVersion = "Send wrong protocol version";
@@ -104,6 +104,9 @@ Avatar::Avatar(RigPointer rig) :
 
     setScale(glm::vec3(1.0f)); // avatar scale is uniform
 
+    // the joints received for the remote avatars play through the jitter buffer, MyAvatar does not receive any
+    _bufferJointData = true;
+
     // give the pointer to our head to inherited _headData variable from AvatarData
     _headData = static_cast<HeadData*>(new Head(this));
 
@@ -346,10 +349,12 @@ void Avatar::simulate(float deltaTime, bool inView) {
     PerformanceTimer perfTimer("simulate");
     {
         PROFILE_RANGE(simulation, "updateJoints");
-        if (inView && _hasNewJointData) {
-            _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
-            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-            _skeletonModel->getRig()->computeExternalPoses(rootTransform);
+        if (inView && hasNewJointData() && isJointUpdateDue()) {
+            _lastJointUpdateTime = usecTimestampNow();
+            if (!_jointsPrepared) {
+                prepareJoints();
+            }
+            _jointsPrepared = false;
             _jointDataSimulationRate.increment();
 
             _skeletonModel->simulate(deltaTime, true);
@@ -394,6 +399,7 @@ void Avatar::simulate(float deltaTime, bool inView) {
         measureMotionDerivatives(deltaTime);
         simulateAttachments(deltaTime);
         updatePalms();
+        updateJointCaches();
     }
     {
         PROFILE_RANGE(simulation, "entities");
@@ -401,6 +407,58 @@ void Avatar::simulate(float deltaTime, bool inView) {
     }
 }
 
+// the angular radius below which the joints are updated at a lower rate, at the default LOD
+static const float HALF_RATE_ANIMATION_LOD_ANGULAR_SIZE = 0.04f;
+static const float LOW_RATE_ANIMATION_LOD_ANGULAR_SIZE = 0.015f;
+static const uint64_t JOINT_UPDATE_INTERVALS[] = { 0, USECS_PER_SECOND / 30, USECS_PER_SECOND / 8 };
+
+void Avatar::updateAnimationLOD(const glm::vec3& viewPosition, float sizeScale) {
+    float distance = glm::distance(viewPosition, getPosition());
+    if (distance < EPSILON || sizeScale < EPSILON) {
+        _animationLOD = 0;
+        return;
+    }
+    // a lower render LOD shrinks the size scale, so the avatars must look bigger to keep their full rate
+    float angularSize = sizeScale * getBoundingRadius() / distance;
+    if (angularSize < LOW_RATE_ANIMATION_LOD_ANGULAR_SIZE) {
+        _animationLOD = 2;
+    } else if (angularSize < HALF_RATE_ANIMATION_LOD_ANGULAR_SIZE) {
+        _animationLOD = 1;
+    } else {
+        _animationLOD = 0;
+    }
+}
+
+bool Avatar::isJointUpdateDue() const {
+    return usecTimestampNow() - _lastJointUpdateTime >= JOINT_UPDATE_INTERVALS[_animationLOD];
+}
+
+void Avatar::prepareJoints() {
+    uint64_t start = usecTimestampNow();
+    if (_bufferJointData && _jointDataBuffer.sample(start, _sampledJointData)) {
+        _skeletonModel->getRig()->copyJointsFromJointData(_sampledJointData);
+    } else {
+        // the network thread may write the joint data meanwhile
+        QReadLocker readLock(&_jointDataLock);
+        _skeletonModel->getRig()->copyJointsFromJointData(_jointData);
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig()->computeExternalPoses(rootTransform);
+    _jointsPrepared = true;
+    _jointsPrepareTime = usecTimestampNow() - start;
+}
+
+bool Avatar::hasNewJointData() const {
+    return _hasNewJointData || (_bufferJointData && _jointDataBuffer.isPlaying(usecTimestampNow()));
+}
+
+void Avatar::extrapolate(float deltaTime) {
+    PROFILE_RANGE(simulation, "extrapolate");
+    _skeletonModel->updateAttitude();
+    _skeletonModel->simulate(deltaTime, false);
+    measureMotionDerivatives(deltaTime);
+}
+
 float Avatar::getSimulationRate(const QString& rateName) const {
     if (rateName == "") {
         return _simulationRate.rate();
@@ -1014,35 +1072,27 @@ glm::vec3 Avatar::getAbsoluteJointTranslationInObjectFrame(int index) const {
 }
 
 int Avatar::getJointIndex(const QString& name) const {
-    if (QThread::currentThread() != thread()) {
-        int result;
-        QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointIndex", Qt::BlockingQueuedConnection,
-            Q_RETURN_ARG(int, result), Q_ARG(const QString&, name));
-        return result;
-    }
     int result = getFauxJointIndex(name);
     if (result != -1) {
         return result;
     }
+    if (QThread::currentThread() != thread()) {
+        return _jointIndicesCache.get().value(name) - 1;
+    }
     return _skeletonModel->isActive() ? _skeletonModel->getFBXGeometry().getJointIndex(name) : -1;
 }
 
 QStringList Avatar::getJointNames() const {
     if (QThread::currentThread() != thread()) {
-        QStringList result;
-        QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointNames", Qt::BlockingQueuedConnection,
-            Q_RETURN_ARG(QStringList, result));
-        return result;
+        return _jointNamesCache.get();
     }
     return _skeletonModel->isActive() ? _skeletonModel->getFBXGeometry().getJointNames() : QStringList();
 }
 
 glm::vec3 Avatar::getJointPosition(int index) const {
     if (QThread::currentThread() != thread()) {
-        glm::vec3 position;
-        QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointPosition", Qt::BlockingQueuedConnection,
-                                  Q_RETURN_ARG(glm::vec3, position), Q_ARG(const int, index));
-        return position;
+        QVector<glm::vec3> positions = _jointPositionsCache.get();
+        return index >= 0 && index < positions.size() ? positions[index] : glm::vec3();
     }
     glm::vec3 position;
     _skeletonModel->getJointPositionInWorldFrame(index, position);
@@ -1050,15 +1100,25 @@ glm::vec3 Avatar::getJointPosition(int index) const {
 }
 
 glm::vec3 Avatar::getJointPosition(const QString& name) const {
+    return getJointPosition(getJointIndex(name));
+}
+
+QVector<glm::vec3> Avatar::getJointPositions(const QStringList& names) const {
+    QVector<glm::vec3> result;
+    result.reserve(names.size());
     if (QThread::currentThread() != thread()) {
-        glm::vec3 position;
-        QMetaObject::invokeMethod(const_cast<Avatar*>(this), "getJointPosition", Qt::BlockingQueuedConnection,
-                                  Q_RETURN_ARG(glm::vec3, position), Q_ARG(const QString&, name));
-        return position;
+        QHash<QString, int> indices = _jointIndicesCache.get();
+        QVector<glm::vec3> positions = _jointPositionsCache.get();
+        for (const auto& name : names) {
+            int index = indices.value(name) - 1;
+            result.push_back(index >= 0 && index < positions.size() ? positions[index] : glm::vec3());
+        }
+        return result;
     }
-    glm::vec3 position;
-    _skeletonModel->getJointPositionInWorldFrame(getJointIndex(name), position);
-    return position;
+    for (const auto& name : names) {
+        result.push_back(getJointPosition(name));
+    }
+    return result;
 }
 
 void Avatar::scaleVectorRelativeToPosition(glm::vec3 &positionToScale) const {
@@ -1361,6 +1421,24 @@ void Avatar::updatePalms() {
     _rightPalmPositionCache.set(getUncachedRightPalmPosition());
 }
 
+void Avatar::updateJointCaches() {
+    PerformanceTimer perfTimer("jointCaches");
+    // the names only change with the model
+    Geometry::Pointer geometry = _skeletonModel->isActive() ? _skeletonModel->getGeometry() : Geometry::Pointer();
+    if (geometry != _jointCachesGeometry) {
+        _jointCachesGeometry = geometry;
+        _jointNamesCache.set(geometry ? geometry->getFBXGeometry().getJointNames() : QStringList());
+        _jointIndicesCache.set(geometry ? geometry->getFBXGeometry().jointIndices : QHash<QString, int>());
+    }
+
+    int numJoints = _skeletonModel->getJointStateCount();
+    QVector<glm::vec3> positions(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        _skeletonModel->getJointPositionInWorldFrame(i, positions[i]);
+    }
+    _jointPositionsCache.set(positions);
+}
+
 void Avatar::setParentID(const QUuid& parentID) {
     if (!isMyAvatar()) {
         return;
@@ -79,6 +79,21 @@ public:
 
     void updateRenderItem(render::PendingChanges& pendingChanges);
 
+    // The animation LOD lowers the rate of the joint updates of the avatars which look small on screen:
+    // level 0 updates them on every frame, level 1 at a half rate and level 2 at a low rate, and between the updates the
+    // last pose is carried along with the avatar. sizeScale is the one of the LODManager relative to its default.
+    void updateAnimationLOD(const glm::vec3& viewPosition, float sizeScale);
+    int getAnimationLOD() const { return _animationLOD; }
+    bool isJointUpdateDue() const;
+
+    // copies the joint data received from the network into the poses of the rig, which simulate() does when it was not
+    // done beforehand. It only touches this avatar, so the AvatarManager runs it for several avatars on worker threads.
+    void prepareJoints();
+    uint64_t getJointsPrepareTime() const { return _jointsPrepareTime; } // usecs, last call
+
+    // a cheap substitute for simulate when the joint update is deferred: moves the last pose along with the avatar
+    void extrapolate(float deltaTime);
+
     virtual void postUpdate(float deltaTime);
 
     //setters
@@ -133,8 +148,11 @@ public:
     Q_INVOKABLE glm::vec3 getSkeletonOffset() { return _skeletonOffset; }
     virtual glm::vec3 getSkeletonPosition() const;
 
+    // called from a script thread, the joint getters read the joints published after the last simulation
     Q_INVOKABLE glm::vec3 getJointPosition(int index) const;
     Q_INVOKABLE glm::vec3 getJointPosition(const QString& name) const;
+    // the positions of the named joints, all from the same simulation
+    Q_INVOKABLE QVector<glm::vec3> getJointPositions(const QStringList& names) const;
     Q_INVOKABLE glm::vec3 getNeckPosition() const;
 
     Q_INVOKABLE glm::vec3 getAcceleration() const { return _acceleration; }
@@ -183,7 +201,8 @@ public:
 
     Q_INVOKABLE float getSimulationRate(const QString& rateName = QString("")) const;
 
-    bool hasNewJointData() const { return _hasNewJointData; }
+    // true when joint data was received, or while the joints buffered are still playing
+    bool hasNewJointData() const;
 
 public slots:
 
@@ -251,6 +270,7 @@ protected:
     virtual void fixupModelsInScene();
 
     virtual void updatePalms();
+    void updateJointCaches();
 
     render::ItemID _renderItemID{ render::Item::INVALID_ITEM_ID };
 
@@ -259,6 +279,12 @@ protected:
     ThreadSafeValueCache<glm::vec3> _rightPalmPositionCache { glm::vec3() };
     ThreadSafeValueCache<glm::quat> _rightPalmRotationCache { glm::quat() };
 
+    // the joints as the script threads see them, so that they do not wait for the main thread
+    Geometry::Pointer _jointCachesGeometry; // the geometry whose joint names are cached
+    ThreadSafeValueCache<QStringList> _jointNamesCache;
+    ThreadSafeValueCache<QHash<QString, int>> _jointIndicesCache; // 1-based, like FBXGeometry::jointIndices
+    ThreadSafeValueCache<QVector<glm::vec3>> _jointPositionsCache; // in the world frame
+
     void addToScene(AvatarSharedPointer self);
     void ensureInScene(AvatarSharedPointer self);
 
@@ -268,6 +294,13 @@ protected:
     RateCounter<> _skeletonModelSimulationRate;
     RateCounter<> _jointDataSimulationRate;
 
+    int _animationLOD { 0 };
+    uint64_t _lastJointUpdateTime { 0 };
+
+    bool _jointsPrepared { false };
+    uint64_t _jointsPrepareTime { 0 };
+    QVector<JointData> _sampledJointData; // the joints played from the jitter buffer, by prepareJoints()
+
 
 private:
     class AvatarEntityDataHash {
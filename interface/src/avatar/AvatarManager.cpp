@@ -12,6 +12,8 @@
 #include <string>
 
 #include <QScriptEngine>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
 
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -37,6 +39,7 @@
 #include "Avatar.h"
 #include "AvatarManager.h"
 #include "InterfaceLogging.h"
+#include "LODManager.h"
 #include "Menu.h"
 #include "MyAvatar.h"
 #include "SceneScriptingInterface.h"
@@ -47,6 +50,10 @@
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 static const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
 
+// time spent each frame on full (joint and animation) updates of other avatars
+static const int DEFAULT_AVATAR_UPDATE_BUDGET = 2000; // usec
+Setting::Handle<int> avatarUpdateBudget("avatarUpdateBudget", DEFAULT_AVATAR_UPDATE_BUDGET);
+
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
@@ -95,6 +102,7 @@ AvatarManager::~AvatarManager() {
 
 void AvatarManager::init() {
     _myAvatar->init();
+    _updateBudget = std::max(avatarUpdateBudget.get(), 0);
     {
         QWriteLocker locker(&_hashLock);
         _avatarHash.insert(MY_AVATAR_KEY, _myAvatar);
@@ -194,72 +202,133 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     render::PendingChanges pendingChanges;
     uint64_t startTime = usecTimestampNow();
-    const uint64_t UPDATE_BUDGET = 2000; // usec
-    uint64_t updateExpiry = startTime + UPDATE_BUDGET;
+    uint64_t updateExpiry = startTime + (uint64_t)std::max(_updateBudget, 0);
 
+    // the avatars by decreasing priority
+    std::vector<AvatarPriority> avatarsToUpdate;
+    avatarsToUpdate.reserve(sortedAvatars.size());
+    while (!sortedAvatars.empty()) {
+        avatarsToUpdate.push_back(sortedAvatars.top());
+        sortedAvatars.pop();
+    }
+
+    // The joints of the avatars in view are copied into their rigs a batch at a time on the thread pool, since each copy
+    // only touches its own avatar, the rest of their simulation follows on this thread. The records of the PerformanceTimer
+    // are not thread safe so they are copied here while they are on.
+    bool prepareJointsInParallel = !PerformanceTimer::isActive();
+    const size_t BATCH_SIZE = (size_t)std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+    std::vector<Avatar*> avatarsToPrepare;
+    avatarsToPrepare.reserve(BATCH_SIZE);
+    std::vector<QFuture<void>> preparations;
+    preparations.reserve(BATCH_SIZE);
+    uint64_t jointsPrepareTime = 0;
+
+    // the animation LOD follows the render LOD, lowered further when the updates go over their budget
+    glm::vec3 viewPosition = cameraView.getPosition();
+    float lodSizeScale = DependencyManager::get<LODManager>()->getAnimationSizeScale() / DEFAULT_OCTREE_SIZE_SCALE;
+
+    const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
     int numAvatarsUpdated = 0;
     int numAVatarsNotUpdated = 0;
-    while (!sortedAvatars.empty()) {
-        const AvatarPriority& sortData = sortedAvatars.top();
-        const auto& avatar = std::static_pointer_cast<Avatar>(sortData.avatar);
-
-        // for ALL avatars...
-        avatar->ensureInScene(avatar);
-        if (!avatar->getMotionState()) {
-            ShapeInfo shapeInfo;
-            avatar->computeShapeInfo(shapeInfo);
-            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
-            if (shape) {
-                // don't add to the simulation now, instead put it on a list to be added later
-                AvatarMotionState* motionState = new AvatarMotionState(avatar.get(), shape);
-                avatar->setMotionState(motionState);
-                _motionStatesToAddToPhysics.insert(motionState);
-                _motionStatesThatMightUpdate.insert(motionState);
+    size_t batchStart = 0;
+    while (batchStart < avatarsToUpdate.size()) {
+        size_t batchEnd = std::min(batchStart + BATCH_SIZE, avatarsToUpdate.size());
+        for (size_t i = batchStart; i < batchEnd; i++) {
+            const auto& avatar = std::static_pointer_cast<Avatar>(avatarsToUpdate[i].avatar);
+
+            // for ALL avatars...
+            avatar->ensureInScene(avatar);
+            if (!avatar->getMotionState()) {
+                ShapeInfo shapeInfo;
+                avatar->computeShapeInfo(shapeInfo);
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                if (shape) {
+                    // don't add to the simulation now, instead put it on a list to be added later
+                    AvatarMotionState* motionState = new AvatarMotionState(avatar.get(), shape);
+                    avatar->setMotionState(motionState);
+                    _motionStatesToAddToPhysics.insert(motionState);
+                    _motionStatesThatMightUpdate.insert(motionState);
+                }
+            }
+            avatar->animateScaleChanges(deltaTime);
+            if (avatarsToUpdate[i].priority > OUT_OF_VIEW_THRESHOLD) {
+                avatar->updateAnimationLOD(viewPosition, lodSizeScale);
             }
         }
-        avatar->animateScaleChanges(deltaTime);
 
-        const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
         uint64_t now = usecTimestampNow();
         if (now < updateExpiry) {
             // we're within budget
-            bool inView = sortData.priority > OUT_OF_VIEW_THRESHOLD;
-            if (inView && avatar->hasNewJointData()) {
-                numAvatarsUpdated++;
+            if (prepareJointsInParallel) {
+                for (size_t i = batchStart; i < batchEnd; i++) {
+                    const auto& avatar = std::static_pointer_cast<Avatar>(avatarsToUpdate[i].avatar);
+                    if (avatarsToUpdate[i].priority > OUT_OF_VIEW_THRESHOLD && avatar->hasNewJointData() &&
+                            avatar->isJointUpdateDue()) {
+                        avatarsToPrepare.push_back(avatar.get());
+                    }
+                }
+                // this thread takes the first one rather than waiting idle
+                for (size_t i = 1; i < avatarsToPrepare.size(); i++) {
+                    Avatar* avatar = avatarsToPrepare[i];
+                    preparations.push_back(QtConcurrent::run([avatar] { avatar->prepareJoints(); }));
+                }
+                if (!avatarsToPrepare.empty()) {
+                    avatarsToPrepare[0]->prepareJoints();
+                }
+                for (auto& preparation : preparations) {
+                    preparation.waitForFinished();
+                }
+                for (auto avatar : avatarsToPrepare) {
+                    jointsPrepareTime += avatar->getJointsPrepareTime();
+                }
+                avatarsToPrepare.clear();
+                preparations.clear();
+            }
+
+            for (size_t i = batchStart; i < batchEnd; i++) {
+                const auto& avatar = std::static_pointer_cast<Avatar>(avatarsToUpdate[i].avatar);
+                bool inView = avatarsToUpdate[i].priority > OUT_OF_VIEW_THRESHOLD;
+                if (inView && avatar->hasNewJointData() && avatar->isJointUpdateDue()) {
+                    numAvatarsUpdated++;
+                    if (!prepareJointsInParallel) {
+                        avatar->prepareJoints();
+                        jointsPrepareTime += avatar->getJointsPrepareTime();
+                    }
+                }
+                avatar->simulate(deltaTime, inView);
+                avatar->updateRenderItem(pendingChanges);
+                avatar->setLastRenderUpdateTime(startTime);
             }
-            avatar->simulate(deltaTime, inView);
-            avatar->updateRenderItem(pendingChanges);
-            avatar->setLastRenderUpdateTime(startTime);
         } else {
-            // we've spent our full time budget --> bail on the rest of the avatar updates
-            // --> more avatars may freeze until their priority trickles up
+            // we've spent our full time budget --> defer the joint updates of the remaining avatars
+            // --> their priority grows with the time since their last update, so they get one on a later frame
+            // --> meanwhile their last pose is carried along with their position and orientation
             // --> some scale or fade animations may glitch
             // --> some avatar velocity measurements may be a little off
-
-            // no time simulate, but we take the time to count how many were tragically missed
-            bool inView = sortData.priority > OUT_OF_VIEW_THRESHOLD;
-            if (!inView) {
-                break;
-            }
-            if (inView && avatar->hasNewJointData()) {
-                numAVatarsNotUpdated++;
-            }
-            sortedAvatars.pop();
-            while (inView && !sortedAvatars.empty()) {
-                const AvatarPriority& newSortData = sortedAvatars.top();
-                const auto& newAvatar = std::static_pointer_cast<Avatar>(newSortData.avatar);
-                inView = newSortData.priority > OUT_OF_VIEW_THRESHOLD;
-                if (inView && newAvatar->hasNewJointData()) {
+            bool outOfView = false;
+            for (size_t i = batchStart; i < batchEnd; i++) {
+                const auto& avatar = std::static_pointer_cast<Avatar>(avatarsToUpdate[i].avatar);
+                bool inView = avatarsToUpdate[i].priority > OUT_OF_VIEW_THRESHOLD;
+                if (!inView) {
+                    // the out of view penalty sorts the rest of the avatars after this one
+                    outOfView = true;
+                    break;
+                }
+                if (avatar->hasNewJointData()) {
                     numAVatarsNotUpdated++;
                 }
-                sortedAvatars.pop();
+                avatar->extrapolate(deltaTime);
+                avatar->updateRenderItem(pendingChanges);
+            }
+            if (outOfView) {
+                break;
             }
-            break;
         }
-        sortedAvatars.pop();
+        batchStart = batchEnd;
     }
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
+    _avatarJointsTime = (float)jointsPrepareTime / (float)USECS_PER_MSEC;
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAVatarsNotUpdated;
     qApp->getMain3DScene()->enqueuePendingChanges(pendingChanges);
@@ -577,6 +646,11 @@ RayToAvatarIntersectionResult AvatarManager::findRayIntersection(const PickRay&
 }
 
 // HACK
+void AvatarManager::setAvatarUpdateBudget(int budget) {
+    _updateBudget = std::max(budget, 0);
+    avatarUpdateBudget.set(_updateBudget);
+}
+
 float AvatarManager::getAvatarSortCoefficient(const QString& name) {
     if (name == "size") {
         return AvatarData::_avatarSortCoefficientSize;
@@ -46,6 +46,7 @@ public:
     int getNumAvatarsUpdated() const { return _numAvatarsUpdated; }
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    float getAvatarJointsTime() const { return _avatarJointsTime; } // summed over the avatars, on all the threads
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -81,6 +82,10 @@ public:
                                                                   const QScriptValue& avatarIdsToInclude = QScriptValue(),
                                                                   const QScriptValue& avatarIdsToDiscard = QScriptValue());
 
+    // the time (in usecs) other avatars may spend on full updates each frame, the rest are deferred to later frames
+    Q_INVOKABLE int getAvatarUpdateBudget() const { return _updateBudget; }
+    Q_INVOKABLE void setAvatarUpdateBudget(int budget);
+
     // TODO: remove this HACK once we settle on optimal default sort coefficients
     Q_INVOKABLE float getAvatarSortCoefficient(const QString& name);
     Q_INVOKABLE void setAvatarSortCoefficient(const QString& name, const QScriptValue& value);
@@ -123,6 +128,8 @@ private:
     int _numAvatarsUpdated { 0 };
     int _numAvatarsNotUpdated { 0 };
     float _avatarSimulationTime { 0.0f };
+    float _avatarJointsTime { 0.0f };
+    int _updateBudget { 0 }; // usecs, loaded from settings in init()
 };
 
 Q_DECLARE_METATYPE(AvatarManager::LocalLight)
@@ -32,6 +32,11 @@ void CauterizedMeshPartPayload::bindTransform(gpu::Batch& batch, const render::S
     SkeletonModel* skeleton = static_cast<SkeletonModel*>(_model);
     bool useCauterizedMesh = (renderMode != RenderArgs::RenderMode::SHADOW_RENDER_MODE) && skeleton->getEnableCauterization();
 
+    // the cauterized models upload the cluster matrices of their meshes
+    if (locations->skinJointStrideLocation >= 0) {
+        batch._glUniform1i(locations->skinJointStrideLocation, 0);
+    }
+
     if (useCauterizedMesh) {
         if (_cauterizedClusterBuffer) {
             batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _cauterizedClusterBuffer);
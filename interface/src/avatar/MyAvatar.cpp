@@ -172,6 +172,7 @@ MyAvatar::MyAvatar(RigPointer rig) :
     connect(recorder.data(), &Recorder::recordingStateChanged, [=] {
         if (recorder->isRecording()) {
             setRecordingBasis();
+            _lastRecordingKeyframeTime = 0;
         } else {
             clearRecordingBasis();
         }
@@ -528,7 +529,14 @@ void MyAvatar::simulate(float deltaTime) {
     auto recorder = DependencyManager::get<recording::Recorder>();
     if (recorder->isRecording()) {
         static const recording::FrameType FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
-        recorder->recordFrame(FRAME_TYPE, toFrame(*this));
+        quint64 now = usecTimestampNow();
+        bool isKeyframe = now - _lastRecordingKeyframeTime >= RECORDING_KEYFRAME_INTERVAL ||
+            getSkeletonModelURL() != _lastRecordingKeyframeSkeletonModelURL;
+        if (isKeyframe) {
+            _lastRecordingKeyframeTime = now;
+            _lastRecordingKeyframeSkeletonModelURL = getSkeletonModelURL();
+        }
+        recorder->recordFrame(FRAME_TYPE, toFrame(*this, isKeyframe));
     }
 
     locationChanged();
@@ -2261,6 +2269,7 @@ void driveKeysFromScriptValue(const QScriptValue& object, MyAvatar::DriveKeys& d
 
 void MyAvatar::lateUpdatePalms() {
     Avatar::updatePalms();
+    updateJointCaches();
 }
 
 
@@ -2596,6 +2605,18 @@ float MyAvatar::getIKErrorOnLastSolve() const {
     return _rig->getIKErrorOnLastSolve();
 }
 
+int MyAvatar::getIKLoopsOnLastSolve() const {
+    return _rig->getIKLoopsOnLastSolve();
+}
+
+float MyAvatar::getIKTimeOnLastSolve() const {
+    return _rig->getIKTimeOnLastSolve();
+}
+
+void MyAvatar::setMaxIKLoops(int maxLoops) {
+    _rig->setMaxIKLoops(maxLoops);
+}
+
 // thread-safe
 void MyAvatar::addHoldAction(AvatarActionHold* holdAction) {
     std::lock_guard<std::mutex> guard(_holdActionsMutex);
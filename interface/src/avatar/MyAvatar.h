@@ -237,6 +237,9 @@ public:
     Q_INVOKABLE bool clearPinOnJoint(int index);
 
     Q_INVOKABLE float getIKErrorOnLastSolve() const;
+    Q_INVOKABLE int getIKLoopsOnLastSolve() const;
+    Q_INVOKABLE float getIKTimeOnLastSolve() const;
+    Q_INVOKABLE void setMaxIKLoops(int maxLoops);
 
     Q_INVOKABLE void useFullAvatarURL(const QUrl& fullAvatarURL, const QString& modelName = QString());
     Q_INVOKABLE QUrl getFullAvatarURLFromPreferences() const { return _fullAvatarURLFromPreferences; }
@@ -430,6 +433,10 @@ private:
     MyCharacterController _characterController;
     bool _wasCharacterControllerEnabled { true };
 
+    // the last avatar keyframe of the recording
+    quint64 _lastRecordingKeyframeTime { 0 };
+    QUrl _lastRecordingKeyframeSkeletonModelURL;
+
     AvatarWeakPointer _lookAtTargetAvatar;
     glm::vec3 _targetAvatarPosition;
     bool _shouldRender;
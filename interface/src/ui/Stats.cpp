@@ -21,6 +21,8 @@
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <MemoryBudget.h>
+#include <ObjectMotionState.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
@@ -139,6 +141,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(presentnewrate, displayPlugin->newFramePresentRate());
         STAT_UPDATE(presentdroprate, displayPlugin->droppedFrameRate());
         STAT_UPDATE(stutterrate, displayPlugin->stutterRate());
+        STAT_UPDATE(poseLatency, displayPlugin->poseToPhotonLatency());
+        STAT_UPDATE(latchedPoseLatency, displayPlugin->latchedPoseToPhotonLatency());
     } else {
         STAT_UPDATE(appdropped, -1);
         STAT_UPDATE(longrenders, -1);
@@ -146,6 +150,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(presentrate, -1);
         STAT_UPDATE(presentnewrate, -1);
         STAT_UPDATE(presentdroprate, -1);
+        STAT_UPDATE(poseLatency, -1);
+        STAT_UPDATE(latchedPoseLatency, -1);
     }
     STAT_UPDATE(simrate, (int)qApp->getAverageSimsPerSecond());
     STAT_UPDATE(avatarSimrate, (int)qApp->getAvatarSimrate());
@@ -246,6 +252,7 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloads, loadingRequests.size());
         STAT_UPDATE(downloadLimit, ResourceCache::getRequestLimit())
         STAT_UPDATE(downloadsPending, ResourceCache::getPendingRequestCount());
+        STAT_UPDATE(physicsShapesPending, ObjectMotionState::getShapeManager()->getNumPendingShapes());
 
         // See if the active download urls have changed
         bool shouldUpdateUrls = _downloads != _downloadUrls.size();
@@ -332,6 +339,9 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(gpuFrameTime, (float)gpuContext->getFrameTimerGPUAverage());
     STAT_UPDATE(batchFrameTime, (float)gpuContext->getFrameTimerBatchAverage());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarJointsTime, (float)avatarManager->getAvatarJointsTime());
+    STAT_UPDATE(ikLoops, avatarManager->getMyAvatar()->getIKLoopsOnLastSolve());
+    STAT_UPDATE(ikTime, avatarManager->getMyAvatar()->getIKTimeOnLastSolve());
     
 
     STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -342,6 +352,8 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(glContextSwapchainMemory, (int)BYTES_TO_MB(gl::Context::getSwapchainMemoryUsage()));
 
     STAT_UPDATE(qmlTextureMemory, (int)BYTES_TO_MB(OffscreenQmlSurface::getUsedTextureMemory()));
+    STAT_UPDATE(qmlActiveSurfaces, OffscreenQmlSurface::getActiveSurfaceCount());
+    STAT_UPDATE(qmlRenderCost, OffscreenQmlSurface::getTotalRenderCost());
     STAT_UPDATE(texturePendingTransfers, (int)BYTES_TO_MB(gpu::Texture::getTextureTransferPendingSize()));
     STAT_UPDATE(gpuTextureMemory, (int)BYTES_TO_MB(gpu::Texture::getTextureGPUMemoryUsage()));
     STAT_UPDATE(gpuTextureVirtualMemory, (int)BYTES_TO_MB(gpu::Texture::getTextureGPUVirtualMemoryUsage()));
@@ -350,6 +362,19 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(gpuTextureMemoryPressureState, getTextureMemoryPressureModeString());
     STAT_UPDATE(gpuSparseTextureEnabled, gpuContext->getBackend()->isTextureManagementSparseEnabled() ? 1 : 0);
     STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemory()));
+    {
+        auto memoryBudget = DependencyManager::get<MemoryBudget>();
+        QString pressureState = "None";
+        if (memoryBudget->isUnderCPUPressure() && memoryBudget->isUnderGPUPressure()) {
+            pressureState = "CPU and GPU";
+        } else if (memoryBudget->isUnderCPUPressure()) {
+            pressureState = "CPU";
+        } else if (memoryBudget->isUnderGPUPressure()) {
+            pressureState = "GPU";
+        }
+        STAT_UPDATE(memoryBudgetPressureState, pressureState);
+        STAT_UPDATE(memoryBudgetStats, memoryBudget->getStatsText());
+    }
     STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
     STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
 
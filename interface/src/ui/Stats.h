@@ -46,6 +46,9 @@ class Stats : public QQuickItem {
 
     STATS_PROPERTY(float, presentnewrate, 0)
     STATS_PROPERTY(float, presentdroprate, 0)
+    // From the sampling of the pose to the present, in milliseconds
+    STATS_PROPERTY(float, poseLatency, 0)
+    STATS_PROPERTY(float, latchedPoseLatency, 0)
     STATS_PROPERTY(int, simrate, 0)
     STATS_PROPERTY(int, avatarSimrate, 0)
     STATS_PROPERTY(int, avatarCount, 0)
@@ -87,6 +90,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, downloads, 0)
     STATS_PROPERTY(int, downloadLimit, 0)
     STATS_PROPERTY(int, downloadsPending, 0)
+    STATS_PROPERTY(int, physicsShapesPending, 0)
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, triangles, 0)
     STATS_PROPERTY(int, quads, 0)
@@ -117,6 +121,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuTexturesSparse, 0)
     STATS_PROPERTY(int, glContextSwapchainMemory, 0)
     STATS_PROPERTY(int, qmlTextureMemory, 0)
+    STATS_PROPERTY(int, qmlActiveSurfaces, 0)
+    STATS_PROPERTY(float, qmlRenderCost, 0)
     STATS_PROPERTY(int, texturePendingTransfers, 0)
     STATS_PROPERTY(int, gpuTextureMemory, 0)
     STATS_PROPERTY(int, gpuTextureVirtualMemory, 0)
@@ -125,9 +131,14 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuSparseTextureEnabled, 0)
     STATS_PROPERTY(QString, gpuTextureMemoryPressureState, QString())
     STATS_PROPERTY(int, gpuFreeMemory, 0)
+    STATS_PROPERTY(QString, memoryBudgetPressureState, QString())
+    STATS_PROPERTY(QString, memoryBudgetStats, QString())
     STATS_PROPERTY(float, gpuFrameTime, 0)
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarJointsTime, 0)
+    STATS_PROPERTY(int, ikLoops, 0)
+    STATS_PROPERTY(float, ikTime, 0)
 
 public:
     static Stats* getInstance();
@@ -169,6 +180,8 @@ signals:
     void presentrateChanged();
     void presentnewrateChanged();
     void presentdroprateChanged();
+    void poseLatencyChanged();
+    void latchedPoseLatencyChanged();
     void stutterrateChanged();
     void simrateChanged();
     void avatarSimrateChanged();
@@ -234,6 +247,8 @@ signals:
     void timingStatsChanged();
     void glContextSwapchainMemoryChanged();
     void qmlTextureMemoryChanged();
+    void qmlActiveSurfacesChanged();
+    void qmlRenderCostChanged();
     void texturePendingTransfersChanged();
     void gpuBuffersChanged();
     void gpuBufferMemoryChanged();
@@ -246,9 +261,14 @@ signals:
     void gpuTextureMemoryPressureStateChanged();
     void gpuSparseTextureEnabledChanged();
     void gpuFreeMemoryChanged();
+    void memoryBudgetPressureStateChanged();
+    void memoryBudgetStatsChanged();
     void gpuFrameTimeChanged();
     void batchFrameTimeChanged();
     void avatarSimulationTimeChanged();
+    void avatarJointsTimeChanged();
+    void ikLoopsChanged();
+    void ikTimeChanged();
     void rectifiedTextureCountChanged();
     void decimatedTextureCountChanged();
 
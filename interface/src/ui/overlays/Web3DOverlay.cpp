@@ -123,6 +123,11 @@ void Web3DOverlay::update(float deltatime) {
     if (_webSurface) {
         // update globalPosition
         _webSurface->getRootContext()->setContextProperty("globalPosition", vec3toVariant(getPosition()));
+
+        // hidden, there is no need to keep rendering it
+        if (!(_visible && getParentVisible()) && !_webSurface->isPaused()) {
+            _webSurface->pause();
+        }
     }
 }
 
@@ -242,6 +247,10 @@ void Web3DOverlay::render(RenderArgs* args) {
         _webEventReceivedConnection = connect(_webSurface.data(), &OffscreenQmlSurface::webEventReceived, this, &Web3DOverlay::webEventReceived);
     }
 
+    if (_webSurface->isPaused()) {
+        _webSurface->resume();
+    }
+
     vec2 halfSize = getSize() / 2.0f;
     vec4 color(toGlm(getColor()), getAlpha());
 
@@ -64,8 +64,8 @@ protected:
 
     float _phase = 0.0f;
 
-    QString _alphaVar;
-    QString _desiredSpeedVar;
+    AnimVariantKey _alphaVar;
+    AnimVariantKey _desiredSpeedVar;
 
     std::vector<float> _characteristicSpeeds;
 
@@ -8,6 +8,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QThread>
+
 #include "GLMHelpers.h"
 #include "AnimClip.h"
 #include "AnimationLogging.h"
@@ -24,7 +26,12 @@ AnimClip::AnimClip(const QString& id, const QString& url, float startFrame, floa
     _mirrorFlag(mirrorFlag),
     _frame(startFrame)
 {
-    loadURL(url);
+    // the AnimNodeLoader builds its clips on a worker, getAnimation() would block it until the thread of the cache
+    // answers, so these clips request their animation once they are back on that thread
+    _url = url;
+    if (QThread::currentThread() == DependencyManager::get<AnimationCache>()->thread()) {
+        loadURL(url);
+    }
 }
 
 AnimClip::~AnimClip() {
@@ -50,12 +57,13 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
         _networkAnim.reset();
     }
 
-    if (_anim.size()) {
+    if (_data && _data->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        if (_mirrorFlag && !_mirrorData) {
+            _mirrorData = _data->getMirror(*_skeleton);
         }
+        const AnimClipData& data = _mirrorFlag ? *_mirrorData : *_data;
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -67,20 +75,29 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, float dt,
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = data.getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        data.getFrame(prevIndex, _prevFrame);
+        if (nextIndex != prevIndex) {
+            data.getFrame(nextIndex, _nextFrame);
+            float alpha = glm::fract(_frame);
+            ::blend(_poses.size(), &_prevFrame[0], &_nextFrame[0], alpha, &_poses[0]);
+        } else {
+            _poses = _prevFrame;
+        }
     }
 
     return _poses;
 }
 
+void AnimClip::requestAnimation() {
+    if (!_networkAnim && !_data) {
+        loadURL(_url);
+    }
+}
+
 void AnimClip::loadURL(const QString& url) {
     auto animCache = DependencyManager::get<AnimationCache>();
     _networkAnim = animCache->getAnimation(url);
@@ -96,95 +113,17 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
-
-    // build a mapping from animation joint indices to skeleton joint indices.
-    // by matching joints with the same name.
-    const FBXGeometry& geom = _networkAnim->getGeometry();
-    AnimSkeleton animSkeleton(geom);
-    const auto animJointCount = animSkeleton.getNumJoints();
-    const auto skeletonJointCount = _skeleton->getNumJoints();
-    std::vector<int> jointMap;
-    jointMap.reserve(animJointCount);
-    for (int i = 0; i < animJointCount; i++) {
-        int skeletonJoint = _skeleton->nameToJointIndex(animSkeleton.getJointName(i));
-        if (skeletonJoint == -1) {
-            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << _url;
-        }
-        jointMap.push_back(skeletonJoint);
-    }
 
-    const int frameCount = geom.animationFrames.size();
-    _anim.resize(frameCount);
+    // the frames re-targeted to this skeleton are shared with the other clips playing this animation on the same one
+    _data = AnimClipData::get(_url, _networkAnim->getGeometry(), *_skeleton, usePreAndPostPoseFromAnim);
 
-    for (int frame = 0; frame < frameCount; frame++) {
-
-        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
-
-        // init all joints in animation to default pose
-        // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
-        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
-        }
-
-        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
-            int skeletonJoint = jointMap[animJoint];
-
-            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
-            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
-
-            // skip joints that are in the animation but not in the skeleton.
-            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
-
-                AnimPose preRot, postRot;
-                if (usePreAndPostPoseFromAnim) {
-                    preRot = animSkeleton.getPreRotationPose(animJoint);
-                    postRot = animSkeleton.getPostRotationPose(animJoint);
-                } else {
-                    // In order to support Blender, which does not have preRotation FBX support, we use the models defaultPose as the reference frame for the animations.
-                    preRot = AnimPose(glm::vec3(1.0f), _skeleton->getRelativeBindPose(skeletonJoint).rot(), glm::vec3());
-                    postRot = AnimPose::identity;
-                }
-
-                // cancel out scale
-                preRot.scale() = glm::vec3(1.0f);
-                postRot.scale() = glm::vec3(1.0f);
-
-                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
-
-                // adjust translation offsets, so large translation animatons on the reference skeleton
-                // will be adjusted when played on a skeleton with short limbs.
-                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
-                const AnimPose& relDefaultPose = _skeleton->getRelativeDefaultPose(skeletonJoint);
-                float boneLengthScale = 1.0f;
-                const float EPSILON = 0.0001f;
-                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
-                    boneLengthScale = glm::length(relDefaultPose.trans()) / glm::length(fbxZeroTrans);
-                }
-
-                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
-
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
-            }
-        }
-    }
-
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
+    // mirrorData will be re-built on demand, if needed.
+    _mirrorData.reset();
 
+    const int skeletonJointCount = _skeleton->getNumJoints();
     _poses.resize(skeletonJointCount);
-}
-
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
-
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+    _prevFrame.resize(skeletonJointCount);
+    _nextFrame.resize(skeletonJointCount);
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
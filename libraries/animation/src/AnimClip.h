@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -54,12 +55,15 @@ public:
     void setMirrorFlag(bool mirrorFlag) { _mirrorFlag = mirrorFlag; }
 
     void loadURL(const QString& url);
+    const QString& getURL() const { return _url; }
+
+    // requests the animation of the url given at construction, if it wasn't requested then
+    void requestAnimation();
 protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
-    void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -67,9 +71,12 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    AnimClipData::ConstPointer _data;
+    AnimClipData::ConstPointer _mirrorData;
+
+    // the two frames blended by evaluate(), decompressed from _data or _mirrorData
+    AnimPoseVec _prevFrame;
+    AnimPoseVec _nextFrame;
 
     QString _url;
     float _startFrame;
@@ -79,12 +86,12 @@ protected:
     bool _mirrorFlag;
     float _frame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVariantKey _startFrameVar;
+    AnimVariantKey _endFrameVar;
+    AnimVariantKey _timeScaleVar;
+    AnimVariantKey _loopFlagVar;
+    AnimVariantKey _mirrorFlagVar;
+    AnimVariantKey _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
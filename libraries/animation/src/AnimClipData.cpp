@@ -0,0 +1,207 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <map>
+
+#include <QtCore/QCryptographicHash>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLogging.h"
+
+static const int BYTES_PER_ROTATION = 6;
+
+// the re-targeting only depends on these, so the skeletons of two models made from the same rig share their clips
+static QByteArray computeSkeletonSignature(const AnimSkeleton& skeleton, bool usePreAndPostPoseFromAnim) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(usePreAndPostPoseFromAnim ? "1" : "0");
+    for (int i = 0; i < skeleton.getNumJoints(); i++) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        const AnimPose& defaultPose = skeleton.getRelativeDefaultPose(i);
+        hash.addData((const char*)&defaultPose.scale(), sizeof(glm::vec3));
+        hash.addData((const char*)&defaultPose.rot(), sizeof(glm::quat));
+        hash.addData((const char*)&defaultPose.trans(), sizeof(glm::vec3));
+        hash.addData((const char*)&skeleton.getRelativeBindPose(i).rot(), sizeof(glm::quat));
+    }
+    return hash.result();
+}
+
+static std::vector<AnimPoseVec> retargetFrames(const QString& url, const FBXGeometry& geom, const AnimSkeleton& skeleton,
+                                               bool usePreAndPostPoseFromAnim) {
+    // build a mapping from animation joint indices to skeleton joint indices.
+    // by matching joints with the same name.
+    AnimSkeleton animSkeleton(geom);
+    const auto animJointCount = animSkeleton.getNumJoints();
+    const auto skeletonJointCount = skeleton.getNumJoints();
+    std::vector<int> jointMap;
+    jointMap.reserve(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        int skeletonJoint = skeleton.nameToJointIndex(animSkeleton.getJointName(i));
+        if (skeletonJoint == -1) {
+            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << url;
+        }
+        jointMap.push_back(skeletonJoint);
+    }
+
+    const int frameCount = geom.animationFrames.size();
+    std::vector<AnimPoseVec> frames(frameCount);
+
+    for (int frame = 0; frame < frameCount; frame++) {
+
+        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
+
+        // init all joints in animation to default pose
+        // this will give us a resonable result for bones in the model skeleton but not in the animation.
+        frames[frame] = skeleton.getRelativeDefaultPoses();
+
+        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
+            int skeletonJoint = jointMap[animJoint];
+
+            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
+            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
+
+            // skip joints that are in the animation but not in the skeleton.
+            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
+
+                AnimPose preRot, postRot;
+                if (usePreAndPostPoseFromAnim) {
+                    preRot = animSkeleton.getPreRotationPose(animJoint);
+                    postRot = animSkeleton.getPostRotationPose(animJoint);
+                } else {
+                    // In order to support Blender, which does not have preRotation FBX support, we use the models defaultPose as the reference frame for the animations.
+                    preRot = AnimPose(glm::vec3(1.0f), skeleton.getRelativeBindPose(skeletonJoint).rot(), glm::vec3());
+                    postRot = AnimPose::identity;
+                }
+
+                // cancel out scale
+                preRot.scale() = glm::vec3(1.0f);
+                postRot.scale() = glm::vec3(1.0f);
+
+                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
+
+                // adjust translation offsets, so large translation animatons on the reference skeleton
+                // will be adjusted when played on a skeleton with short limbs.
+                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
+                const AnimPose& relDefaultPose = skeleton.getRelativeDefaultPose(skeletonJoint);
+                float boneLengthScale = 1.0f;
+                const float EPSILON = 0.0001f;
+                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
+                    boneLengthScale = glm::length(relDefaultPose.trans()) / glm::length(fbxZeroTrans);
+                }
+
+                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
+
+                frames[frame][skeletonJoint] = trans * preRot * rot * postRot;
+            }
+        }
+    }
+    return frames;
+}
+
+AnimClipData::ConstPointer AnimClipData::get(const QString& url, const FBXGeometry& geometry, const AnimSkeleton& skeleton,
+                                             bool usePreAndPostPoseFromAnim) {
+    static std::mutex cacheMutex;
+    static std::map<QByteArray, std::weak_ptr<const AnimClipData>> cache;
+
+    QByteArray key = url.toUtf8() + computeSkeletonSignature(skeleton, usePreAndPostPoseFromAnim);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto itr = cache.find(key);
+        if (itr != cache.end()) {
+            ConstPointer data = itr->second.lock();
+            if (data) {
+                return data;
+            }
+        }
+    }
+
+    // built outside of the lock, in the rare case where two clips build the same data the last one is kept
+    ConstPointer data = std::make_shared<AnimClipData>(retargetFrames(url, geometry, skeleton, usePreAndPostPoseFromAnim));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto itr = cache.begin(); itr != cache.end();) {
+        if (itr->second.expired()) {
+            itr = cache.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    cache[key] = data;
+    return data;
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& frames) :
+    _numFrames((int)frames.size())
+{
+    if (frames.empty()) {
+        return;
+    }
+    _constantPoses = frames[0];
+    const int numJoints = (int)_constantPoses.size();
+
+    // the joints whose rotation or translation differs from the first frame on any of the others
+    for (int joint = 0; joint < numJoints; joint++) {
+        bool rotationChanges = false;
+        bool translationChanges = false;
+        for (int frame = 1; frame < _numFrames && !(rotationChanges && translationChanges); frame++) {
+            rotationChanges = rotationChanges || frames[frame][joint].rot() != _constantPoses[joint].rot();
+            translationChanges = translationChanges || frames[frame][joint].trans() != _constantPoses[joint].trans();
+        }
+        if (rotationChanges) {
+            _rotationJoints.push_back(joint);
+        }
+        if (translationChanges) {
+            _translationJoints.push_back(joint);
+        }
+    }
+
+    _rotations.resize(_numFrames * _rotationJoints.size() * BYTES_PER_ROTATION);
+    _translations.reserve(_numFrames * _translationJoints.size());
+    uint8_t* rotation = _rotations.data();
+    for (int frame = 0; frame < _numFrames; frame++) {
+        for (auto joint : _rotationJoints) {
+            rotation += packOrientationQuatToSixBytes(rotation, frames[frame][joint].rot());
+        }
+        for (auto joint : _translationJoints) {
+            _translations.push_back(frames[frame][joint].trans());
+        }
+    }
+}
+
+void AnimClipData::getFrame(int frame, AnimPoseVec& posesOut) const {
+    assert(frame >= 0 && frame < _numFrames);
+    assert(posesOut.size() == _constantPoses.size());
+
+    std::copy(_constantPoses.begin(), _constantPoses.end(), posesOut.begin());
+    const uint8_t* rotation = _rotations.data() + frame * _rotationJoints.size() * BYTES_PER_ROTATION;
+    for (auto joint : _rotationJoints) {
+        rotation += unpackOrientationQuatFromSixBytes(rotation, posesOut[joint].rot());
+    }
+    const glm::vec3* translation = _translations.data() + frame * _translationJoints.size();
+    for (auto joint : _translationJoints) {
+        posesOut[joint].trans() = *translation++;
+    }
+}
+
+AnimClipData::ConstPointer AnimClipData::getMirror(const AnimSkeleton& skeleton) const {
+    std::lock_guard<std::mutex> lock(_mirrorMutex);
+    if (!_mirror) {
+        std::vector<AnimPoseVec> frames(_numFrames, _constantPoses);
+        for (int frame = 0; frame < _numFrames; frame++) {
+            getFrame(frame, frames[frame]);
+            skeleton.mirrorRelativePoses(frames[frame]);
+        }
+        _mirror = std::make_shared<AnimClipData>(frames);
+    }
+    return _mirror;
+}
@@ -0,0 +1,66 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "AnimSkeleton.h"
+
+// The frames of an animation re-targeted to a skeleton, shared by all the AnimClips which play that animation on a
+// skeleton with the same joints. The rotations which change are packed into six bytes, the translations which change
+// are kept as they are, and the joints which don't change keep their pose of the first frame.
+class AnimClipData {
+public:
+    using ConstPointer = std::shared_ptr<const AnimClipData>;
+
+    // the data of the animation at url re-targeted to skeleton, built from geometry unless another clip holds it already
+    static ConstPointer get(const QString& url, const FBXGeometry& geometry, const AnimSkeleton& skeleton,
+                            bool usePreAndPostPoseFromAnim);
+
+    // frames[frame][joint]
+    explicit AnimClipData(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_constantPoses.size(); }
+
+    // posesOut must have getNumJoints() poses
+    void getFrame(int frame, AnimPoseVec& posesOut) const;
+
+    // the mirrored frames, built on the first call
+    ConstPointer getMirror(const AnimSkeleton& skeleton) const;
+
+protected:
+    int _numFrames { 0 };
+    AnimPoseVec _constantPoses;
+
+    std::vector<int> _rotationJoints;
+    std::vector<int> _translationJoints;
+
+    // [frame][index in _rotationJoints], six bytes each
+    std::vector<uint8_t> _rotations;
+    // [frame][index in _translationJoints]
+    std::vector<glm::vec3> _translations;
+
+    mutable std::mutex _mirrorMutex;
+    mutable ConstPointer _mirror;
+
+    // no copies
+    AnimClipData(const AnimClipData&) = delete;
+    AnimClipData& operator=(const AnimClipData&) = delete;
+};
+
+#endif // hifi_AnimClipData_h
@@ -135,6 +135,8 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
 }
 
 void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<IKTarget>& targets) {
+    uint64_t startTime = usecTimestampNow();
+
     // compute absolute poses that correspond to relative target poses
     AnimPoseVec absolutePoses;
     absolutePoses.resize(_relativePoses.size());
@@ -145,12 +147,17 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
         accumulator.clearAndClean();
     }
 
+    // the solve starts from the relaxed solution of the previous frame, so it usually converges in a few loops.
+    // It also stops when a loop barely reduces the error, which happens when the constraints keep a target out of reach.
     float maxError = FLT_MAX;
+    float previousMaxError = FLT_MAX;
     int numLoops = 0;
-    const int MAX_IK_LOOPS = 16;
     const float MAX_ERROR_TOLERANCE = 0.1f; // cm
-    while (maxError > MAX_ERROR_TOLERANCE && numLoops < MAX_IK_LOOPS) {
+    const float MIN_ERROR_REDUCTION = 0.995f;
+    while (maxError > MAX_ERROR_TOLERANCE && numLoops < _maxSolveLoops &&
+            (numLoops < 2 || maxError < MIN_ERROR_REDUCTION * previousMaxError)) {
         ++numLoops;
+        previousMaxError = maxError;
 
         // solve all targets
         int lowestMovedIndex = (int)_relativePoses.size();
@@ -190,6 +197,7 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
         }
     }
     _maxErrorOnLastSolve = maxError;
+    _numLoopsOnLastSolve = numLoops;
 
     // finally set the relative rotation of each tip to agree with absolute target rotation
     for (auto& target: targets) {
@@ -211,6 +219,7 @@ void AnimInverseKinematics::solveWithCyclicCoordinateDescent(const std::vector<I
             absolutePoses[tipIndex].rot() = targetRotation;
         }
     }
+    _timeOnLastSolve = usecTimestampNow() - startTime;
 }
 
 int AnimInverseKinematics::solveTargetWithCCD(const IKTarget& target, AnimPoseVec& absolutePoses) {
@@ -12,6 +12,7 @@
 
 #include <string>
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -24,6 +25,7 @@ class RotationConstraint;
 
 class AnimInverseKinematics : public AnimNode {
 public:
+    static const int DEFAULT_MAX_SOLVE_LOOPS = 16;
 
     explicit AnimInverseKinematics(const QString& id);
     virtual ~AnimInverseKinematics() override;
@@ -42,6 +44,12 @@ public:
     void setMaxHipsOffsetLength(float maxLength);
 
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
+    int getNumLoopsOnLastSolve() const { return _numLoopsOnLastSolve; }
+    uint64_t getTimeOnLastSolve() const { return _timeOnLastSolve; } // usecs
+
+    // the budget of cyclic coordinate descent loops per solve
+    void setMaxSolveLoops(int maxLoops) { _maxSolveLoops = std::max(maxLoops, 1); }
+    int getMaxSolveLoops() const { return _maxSolveLoops; }
 
 protected:
     void computeTargets(const AnimVariantMap& animVars, std::vector<IKTarget>& targets, const AnimPoseVec& underPoses);
@@ -72,9 +80,9 @@ protected:
             jointIndex(-1)
         {}
 
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
+        AnimVariantKey positionVar;
+        AnimVariantKey rotationVar;
+        AnimVariantKey typeVar;
         QString jointName;
         int jointIndex; // cached joint index
     };
@@ -97,6 +105,9 @@ protected:
     int _maxTargetIndex { 0 };
 
     float _maxErrorOnLastSolve { FLT_MAX };
+    int _numLoopsOnLastSolve { 0 };
+    uint64_t _timeOnLastSolve { 0 };
+    int _maxSolveLoops { DEFAULT_MAX_SOLVE_LOOPS };
 };
 
 #endif // hifi_AnimInverseKinematics_h
@@ -8,10 +8,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <mutex>
+
+#include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFile>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "AnimNode.h"
 #include "AnimClip.h"
@@ -578,19 +582,46 @@ AnimNodeLoader::AnimNodeLoader(const QUrl& url) :
     _resource->setSelf(_resource);
     connect(_resource.data(), &Resource::loaded, this, &AnimNodeLoader::onRequestDone);
     connect(_resource.data(), &Resource::failed, this, &AnimNodeLoader::onRequestError);
+    connect(&_loadWatcher, &QFutureWatcher<AnimNode::Pointer>::finished, this, &AnimNodeLoader::onLoadDone);
     _resource->ensureLoading();
 }
 
-AnimNode::Pointer AnimNodeLoader::load(const QByteArray& contents, const QUrl& jsonUrl) {
+// The avatars which use the same graph share its parsed json, each of them still builds its own nodes from it since
+// the nodes hold the state of the animation of their rig.
+static bool parseJson(const QByteArray& contents, const QUrl& jsonUrl, QJsonObject& objOut) {
+    static std::mutex parsedGraphsMutex;
+    static QHash<QByteArray, QJsonObject> parsedGraphs;
+
+    QByteArray key = jsonUrl.toEncoded() + QCryptographicHash::hash(contents, QCryptographicHash::Md5);
+    {
+        std::lock_guard<std::mutex> lock(parsedGraphsMutex);
+        auto itr = parsedGraphs.find(key);
+        if (itr != parsedGraphs.end()) {
+            objOut = itr.value();
+            return true;
+        }
+    }
 
     // convert string into a json doc
     QJsonParseError error;
     auto doc = QJsonDocument::fromJson(contents, &error);
     if (error.error != QJsonParseError::NoError) {
         qCCritical(animation) << "AnimNodeLoader, failed to parse json, error =" << error.errorString() << ", url =" << jsonUrl.toDisplayString();
+        return false;
+    }
+    objOut = doc.object();
+
+    std::lock_guard<std::mutex> lock(parsedGraphsMutex);
+    parsedGraphs.insert(key, objOut);
+    return true;
+}
+
+AnimNode::Pointer AnimNodeLoader::load(const QByteArray& contents, const QUrl& jsonUrl) {
+
+    QJsonObject obj;
+    if (!parseJson(contents, jsonUrl, obj)) {
         return nullptr;
     }
-    QJsonObject obj = doc.object();
 
     // version
     QJsonValue versionVal = obj.value("version");
@@ -617,8 +648,19 @@ AnimNode::Pointer AnimNodeLoader::load(const QByteArray& contents, const QUrl& j
 }
 
 void AnimNodeLoader::onRequestDone(const QByteArray data) {
-    auto node = load(data, _url);
+    _loadWatcher.setFuture(QtConcurrent::run(&AnimNodeLoader::load, data, _url));
+}
+
+void AnimNodeLoader::onLoadDone() {
+    auto node = _loadWatcher.result();
     if (node) {
+        node->traverse([](AnimNode::Pointer child) {
+            auto clip = std::dynamic_pointer_cast<AnimClip>(child);
+            if (clip) {
+                clip->requestAnimation();
+            }
+            return true;
+        });
         emit success(node);
     } else {
         emit error(0, "json parse error");
@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include <QFutureWatcher>
 #include <QNetworkReply>
 #include <QString>
 #include <QUrl>
@@ -32,17 +33,21 @@ signals:
     void error(int error, QString str);
 
 protected:
-    // synchronous
+    // synchronous, thread safe
     static AnimNode::Pointer load(const QByteArray& contents, const QUrl& jsonUrl);
 
 protected slots:
     void onRequestDone(const QByteArray data);
     void onRequestError(QNetworkReply::NetworkError error);
+    void onLoadDone();
 
 protected:
     QUrl _url;
     QSharedPointer<Resource> _resource;
 
+    // the graph is built on the global thread pool, success or error are emitted back on the thread of the loader
+    QFutureWatcher<AnimNode::Pointer> _loadWatcher;
+
 private:
 
     // no copies
@@ -60,8 +60,8 @@ public:
     float _alpha;
     std::vector<float> _boneSetVec;
 
-    QString _boneSetVar;
-    QString _alphaVar;
+    AnimVariantKey _boneSetVar;
+    AnimVariantKey _alphaVar;
 
     void buildFullBodyBoneSet();
     void buildUpperBodyBoneSet();
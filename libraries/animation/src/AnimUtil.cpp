@@ -11,25 +11,84 @@
 #include "AnimUtil.h"
 #include "GLMHelpers.h"
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define ANIM_UTIL_SSE2 1
+#endif
+
+static void blendPose(const AnimPose& aPose, const AnimPose& bPose, float alpha, AnimPose& result) {
+    // adjust signs if necessary
+    const glm::quat& q1 = aPose.rot();
+    glm::quat q2 = bPose.rot();
+    float dot = glm::dot(q1, q2);
+    if (dot < 0.0f) {
+        q2 = -q2;
+    }
+
+    result.scale() = lerp(aPose.scale(), bPose.scale(), alpha);
+    result.rot() = glm::normalize(glm::lerp(aPose.rot(), q2, alpha));
+    result.trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+}
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
-    for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
+    size_t i = 0;
+#if ANIM_UTIL_SSE2
+    // the rotations of four poses at a time, with a register per component, where the sign flips and
+    // the normalizations are the bulk of the work
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 bWeight = _mm_set1_ps(alpha);
+    const __m128 aWeight = _mm_set1_ps(1.0f - alpha);
+    float x[4], y[4], z[4], w[4];
+    for (; i + 4 <= numPoses; i += 4) {
+        const AnimPose* aPoses = a + i;
+        const AnimPose* bPoses = b + i;
+        __m128 ax = _mm_set_ps(aPoses[3].rot().x, aPoses[2].rot().x, aPoses[1].rot().x, aPoses[0].rot().x);
+        __m128 ay = _mm_set_ps(aPoses[3].rot().y, aPoses[2].rot().y, aPoses[1].rot().y, aPoses[0].rot().y);
+        __m128 az = _mm_set_ps(aPoses[3].rot().z, aPoses[2].rot().z, aPoses[1].rot().z, aPoses[0].rot().z);
+        __m128 aw = _mm_set_ps(aPoses[3].rot().w, aPoses[2].rot().w, aPoses[1].rot().w, aPoses[0].rot().w);
+        __m128 bx = _mm_set_ps(bPoses[3].rot().x, bPoses[2].rot().x, bPoses[1].rot().x, bPoses[0].rot().x);
+        __m128 by = _mm_set_ps(bPoses[3].rot().y, bPoses[2].rot().y, bPoses[1].rot().y, bPoses[0].rot().y);
+        __m128 bz = _mm_set_ps(bPoses[3].rot().z, bPoses[2].rot().z, bPoses[1].rot().z, bPoses[0].rot().z);
+        __m128 bw = _mm_set_ps(bPoses[3].rot().w, bPoses[2].rot().w, bPoses[1].rot().w, bPoses[0].rot().w);
 
         // adjust signs if necessary
-        const glm::quat& q1 = aPose.rot();
-        glm::quat q2 = bPose.rot();
-        float dot = glm::dot(q1, q2);
-        if (dot < 0.0f) {
-            q2 = -q2;
-        }
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+        bx = _mm_xor_ps(bx, flip);
+        by = _mm_xor_ps(by, flip);
+        bz = _mm_xor_ps(bz, flip);
+        bw = _mm_xor_ps(bw, flip);
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = glm::normalize(glm::lerp(aPose.rot(), q2, alpha));
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+        // same as glm::lerp()
+        __m128 rx = _mm_add_ps(_mm_mul_ps(ax, aWeight), _mm_mul_ps(bx, bWeight));
+        __m128 ry = _mm_add_ps(_mm_mul_ps(ay, aWeight), _mm_mul_ps(by, bWeight));
+        __m128 rz = _mm_add_ps(_mm_mul_ps(az, aWeight), _mm_mul_ps(bz, bWeight));
+        __m128 rw = _mm_add_ps(_mm_mul_ps(aw, aWeight), _mm_mul_ps(bw, bWeight));
+
+        // same as glm::normalize(), which returns the identity for a zero length
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                               _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw))));
+        __m128 valid = _mm_cmpgt_ps(length, zero);
+        __m128 inverseLength = _mm_and_ps(_mm_div_ps(one, length), valid);
+        _mm_storeu_ps(x, _mm_mul_ps(rx, inverseLength));
+        _mm_storeu_ps(y, _mm_mul_ps(ry, inverseLength));
+        _mm_storeu_ps(z, _mm_mul_ps(rz, inverseLength));
+        _mm_storeu_ps(w, _mm_or_ps(_mm_mul_ps(rw, inverseLength), _mm_andnot_ps(valid, one)));
+
+        for (size_t j = 0; j < 4; j++) {
+            AnimPose& pose = result[i + j];
+            pose.scale() = lerp(aPoses[j].scale(), bPoses[j].scale(), alpha);
+            pose.rot() = glm::quat(w[j], x[j], y[j], z[j]);
+            pose.trans() = lerp(aPoses[j].trans(), bPoses[j].trans(), alpha);
+        }
+    }
+#endif
+    for (; i < numPoses; i++) {
+        blendPose(a[i], b[i], alpha, result[i]);
     }
 }
 
@@ -9,6 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <mutex>
+
+#include <QHash>
 #include <QScriptEngine>
 #include <QScriptValueIterator>
 #include <QThread>
@@ -17,6 +20,51 @@
 
 const AnimVariant AnimVariant::False = AnimVariant();
 
+namespace {
+    // built on first use, the keys of the Rig are statics
+    struct AnimVariantKeys {
+        std::mutex mutex;
+        QHash<QString, int> indices;
+        std::vector<QString> names;
+    };
+
+    AnimVariantKeys& getKeys() {
+        static AnimVariantKeys keys;
+        return keys;
+    }
+}
+
+int AnimVariantKey::intern(const QString& name) {
+    if (name.isEmpty()) {
+        return -1;
+    }
+    auto& keys = getKeys();
+    std::lock_guard<std::mutex> lock(keys.mutex);
+    auto itr = keys.indices.find(name);
+    if (itr != keys.indices.end()) {
+        return itr.value();
+    }
+    int index = (int)keys.names.size();
+    keys.names.push_back(name);
+    keys.indices.insert(name, index);
+    return index;
+}
+
+int AnimVariantKey::find(const QString& name) {
+    if (name.isEmpty()) {
+        return -1;
+    }
+    auto& keys = getKeys();
+    std::lock_guard<std::mutex> lock(keys.mutex);
+    return keys.indices.value(name, -1);
+}
+
+QString AnimVariantKey::getName(int index) {
+    auto& keys = getKeys();
+    std::lock_guard<std::mutex> lock(keys.mutex);
+    return (index >= 0 && index < (int)keys.names.size()) ? keys.names[index] : QString();
+}
+
 QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
         qCWarning(animation) << "Cannot create Javacript object from non-script thread" << QThread::currentThread();
@@ -51,24 +99,28 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
+            int index = AnimVariantKey::find(name);
+            if (isSet(index)) {
+                setOne(name, _values[index]);
+            } else if (index >= 0 && isTrigger(index)) {
                 target.setProperty(name, true);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
-            setOne(pair.first, pair.second);
+        for (int i = 0; i < (int)_values.size(); i++) {
+            if (_isSet[i]) {
+                setOne(AnimVariantKey::getName(i), _values[i]);
+            }
         }
     }
     return target;
 }
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
+    for (int i = 0; i < (int)other._values.size(); i++) {
+        if (other._isSet[i]) {
+            set(i, other._values[i]);
+        }
     }
 }
 
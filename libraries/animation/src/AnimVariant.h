@@ -11,12 +11,12 @@
 #ifndef hifi_AnimVariant_h
 #define hifi_AnimVariant_h
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
-#include <map>
-#include <set>
+#include <vector>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,93 +114,91 @@ protected:
     } _val;
 };
 
-class AnimVariantMap {
+// The name of an animation variable interned into an index, the same for all the maps. The nodes keep the keys of the
+// variables they read, so their lookups index the values of the map rather than search it by name.
+class AnimVariantKey {
 public:
+    AnimVariantKey() {}
+    AnimVariantKey(const QString& name) : _name(name), _index(intern(name)) {}
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
-        }
-    }
+    const QString& getName() const { return _name; }
+    int getIndex() const { return _index; }
+    bool isEmpty() const { return _index < 0; }
 
-    int lookup(const QString& key, int defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
-        }
-    }
+    // -1 for the empty name
+    static int intern(const QString& name);
+    // -1 when the name was never interned
+    static int find(const QString& name);
+    static QString getName(int index);
 
-    float lookup(const QString& key, float defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
-        }
-    }
+protected:
+    QString _name;
+    int _index { -1 };
+};
+
+class AnimVariantMap {
+public:
 
+    bool lookup(const QString& key, bool defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
+    int lookup(const QString& key, int defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
+    float lookup(const QString& key, float defaultValue) const { return lookup(AnimVariantKey::find(key), defaultValue); }
     const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
-        }
+        return lookupRaw(AnimVariantKey::find(key), defaultValue);
     }
-
     glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+        return lookupRigToGeometry(AnimVariantKey::find(key), defaultValue);
     }
-
     const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
-        }
+        return lookupRaw(AnimVariantKey::find(key), defaultValue);
     }
-
     glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
-        }
+        return lookupRigToGeometry(AnimVariantKey::find(key), defaultValue);
     }
-
     const QString& lookup(const QString& key, const QString& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
-        }
+        return lookup(AnimVariantKey::find(key), defaultValue);
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    bool lookup(const AnimVariantKey& key, bool defaultValue) const { return lookup(key.getIndex(), defaultValue); }
+    int lookup(const AnimVariantKey& key, int defaultValue) const { return lookup(key.getIndex(), defaultValue); }
+    float lookup(const AnimVariantKey& key, float defaultValue) const { return lookup(key.getIndex(), defaultValue); }
+    const glm::vec3& lookupRaw(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        return lookupRaw(key.getIndex(), defaultValue);
+    }
+    glm::vec3 lookupRigToGeometry(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        return lookupRigToGeometry(key.getIndex(), defaultValue);
+    }
+    const glm::quat& lookupRaw(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        return lookupRaw(key.getIndex(), defaultValue);
+    }
+    glm::quat lookupRigToGeometry(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        return lookupRigToGeometry(key.getIndex(), defaultValue);
+    }
+    const QString& lookup(const AnimVariantKey& key, const QString& defaultValue) const {
+        return lookup(key.getIndex(), defaultValue);
+    }
 
-    void setTrigger(const QString& key) { _triggers.insert(key); }
+    void set(const QString& key, bool value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, int value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, float value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const glm::vec3& value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const glm::quat& value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const QString& value) { set(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void unset(const QString& key) { unset(AnimVariantKey::find(key)); }
+
+    void set(const AnimVariantKey& key, bool value) { set(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVariantKey& key, int value) { set(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVariantKey& key, float value) { set(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::vec3& value) { set(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::quat& value) { set(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const QString& value) { set(key.getIndex(), AnimVariant(value)); }
+    void unset(const AnimVariantKey& key) { unset(key.getIndex()); }
+
+    void setTrigger(const QString& key) {
+        int index = AnimVariantKey::intern(key);
+        if (index >= 0 && !isTrigger(index)) {
+            _triggers.push_back(index);
+        }
+    }
     void clearTriggers() { _triggers.clear(); }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
@@ -208,16 +206,12 @@ public:
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    void clearMap() { _isSet.assign(_isSet.size(), false); }
+    bool hasKey(const QString& key) const { return isSet(AnimVariantKey::find(key)); }
 
     const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
-        }
+        int index = AnimVariantKey::find(key);
+        return isSet(index) ? _values[index] : AnimVariant::False;
     }
 
     // Answer a Plain Old Javascript Object (for the given engine) all of our values set as properties.
@@ -229,25 +223,29 @@ public:
 #ifdef NDEBUG
     void dump() const {
         qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
-            switch (pair.second.getType()) {
+        for (int i = 0; i < (int)_values.size(); i++) {
+            if (!_isSet[i]) {
+                continue;
+            }
+            const AnimVariant& value = _values[i];
+            switch (value.getType()) {
             case AnimVariant::Type::Bool:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getBool();
                 break;
             case AnimVariant::Type::Int:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getInt();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getInt();
                 break;
             case AnimVariant::Type::Float:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getFloat();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getFloat();
                 break;
             case AnimVariant::Type::Vec3:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getVec3();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getVec3();
                 break;
             case AnimVariant::Type::Quat:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getQuat();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getQuat();
                 break;
             case AnimVariant::Type::String:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getString();
+                qCDebug(animation) << "    " << AnimVariantKey::getName(i) << "=" << value.getString();
                 break;
             default:
                 assert(("invalid AnimVariant::Type", false));
@@ -257,8 +255,57 @@ public:
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    bool isSet(int index) const { return index >= 0 && index < (int)_isSet.size() && _isSet[index]; }
+    bool isTrigger(int index) const { return std::find(_triggers.begin(), _triggers.end(), index) != _triggers.end(); }
+
+    bool lookup(int index, bool defaultValue) const {
+        if (index < 0) {
+            return defaultValue;
+        } else if (isTrigger(index)) {
+            return true;
+        } else {
+            return isSet(index) ? _values[index].getBool() : defaultValue;
+        }
+    }
+    int lookup(int index, int defaultValue) const { return isSet(index) ? _values[index].getInt() : defaultValue; }
+    float lookup(int index, float defaultValue) const { return isSet(index) ? _values[index].getFloat() : defaultValue; }
+    const glm::vec3& lookupRaw(int index, const glm::vec3& defaultValue) const {
+        return isSet(index) ? _values[index].getVec3() : defaultValue;
+    }
+    glm::vec3 lookupRigToGeometry(int index, const glm::vec3& defaultValue) const {
+        return isSet(index) ? transformPoint(_rigToGeometryMat, _values[index].getVec3()) : defaultValue;
+    }
+    const glm::quat& lookupRaw(int index, const glm::quat& defaultValue) const {
+        return isSet(index) ? _values[index].getQuat() : defaultValue;
+    }
+    glm::quat lookupRigToGeometry(int index, const glm::quat& defaultValue) const {
+        return isSet(index) ? _rigToGeometryRot * _values[index].getQuat() : defaultValue;
+    }
+    const QString& lookup(int index, const QString& defaultValue) const {
+        return isSet(index) ? _values[index].getString() : defaultValue;
+    }
+
+    void set(int index, const AnimVariant& value) {
+        if (index < 0) {
+            return;
+        }
+        if (index >= (int)_values.size()) {
+            _values.resize(index + 1);
+            _isSet.resize(index + 1, false);
+        }
+        _values[index] = value;
+        _isSet[index] = true;
+    }
+    void unset(int index) {
+        if (isSet(index)) {
+            _isSet[index] = false;
+        }
+    }
+
+    // by the index of their key
+    std::vector<AnimVariant> _values;
+    std::vector<bool> _isSet;
+    std::vector<int> _triggers;
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
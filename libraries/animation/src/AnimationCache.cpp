@@ -25,7 +25,16 @@ AnimationCache::AnimationCache(QObject* parent) :
 {
     const qint64 ANIMATION_DEFAULT_UNUSED_MAX_SIZE = 50 * BYTES_PER_MEGABYTES;
     setUnusedResourceCacheSize(ANIMATION_DEFAULT_UNUSED_MAX_SIZE);
+    const float ANIMATION_REBUILD_COST = 2.0f;
+    setRebuildCost(ANIMATION_REBUILD_COST);
     setObjectName("AnimationCache");
+
+    const int MAX_ANIMATION_READER_THREADS = 2;
+    _animationReaderPool.setMaxThreadCount(MAX_ANIMATION_READER_THREADS);
+}
+
+AnimationCache::~AnimationCache() {
+    _animationReaderPool.waitForDone();
 }
 
 AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
@@ -127,7 +136,7 @@ void Animation::downloadFinished(const QByteArray& data) {
     AnimationReader* animationReader = new AnimationReader(_url, data);
     connect(animationReader, SIGNAL(onSuccess(FBXGeometry::Pointer)), SLOT(animationParseSuccess(FBXGeometry::Pointer)));
     connect(animationReader, SIGNAL(onError(int, QString)), SLOT(animationParseError(int, QString)));
-    QThreadPool::globalInstance()->start(animationReader);
+    DependencyManager::get<AnimationCache>()->startReader(animationReader);
 }
 
 void Animation::animationParseSuccess(FBXGeometry::Pointer geometry) {
@@ -13,6 +13,7 @@
 #define hifi_AnimationCache_h
 
 #include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
 
@@ -45,14 +46,19 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // parses an animation on the threads of the cache
+    void startReader(QRunnable* reader) { _animationReaderPool.start(reader); }
+
 protected:
 
     virtual QSharedPointer<Resource> createResource(const QUrl& url, const QSharedPointer<Resource>& fallback,
         const void* extra) override;
 private:
     explicit AnimationCache(QObject* parent = NULL);
-    virtual ~AnimationCache() { }
+    virtual ~AnimationCache();
 
+    // its own few threads, so a crowd of avatars arriving at once doesn't fill the global pool with fbx parsing
+    QThreadPool _animationReaderPool;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -42,6 +42,51 @@ static bool isEqual(const glm::quat& p, const glm::quat& q) {
 
 #define ASSERT(cond) assert(cond)
 
+// the names of the anim vars written every frame, interned once
+static const AnimVariantKey USER_ANIM_NONE_VAR("userAnimNone");
+static const AnimVariantKey USER_ANIM_A_VAR("userAnimA");
+static const AnimVariantKey USER_ANIM_B_VAR("userAnimB");
+static const AnimVariantKey SINE_VAR("sine");
+static const AnimVariantKey MOVE_FORWARD_SPEED_VAR("moveForwardSpeed");
+static const AnimVariantKey MOVE_FORWARD_ALPHA_VAR("moveForwardAlpha");
+static const AnimVariantKey MOVE_BACKWARD_SPEED_VAR("moveBackwardSpeed");
+static const AnimVariantKey MOVE_BACKWARD_ALPHA_VAR("moveBackwardAlpha");
+static const AnimVariantKey MOVE_LATERAL_SPEED_VAR("moveLateralSpeed");
+static const AnimVariantKey MOVE_LATERAL_ALPHA_VAR("moveLateralAlpha");
+static const AnimVariantKey IS_MOVING_FORWARD_VAR("isMovingForward");
+static const AnimVariantKey IS_MOVING_BACKWARD_VAR("isMovingBackward");
+static const AnimVariantKey IS_MOVING_RIGHT_VAR("isMovingRight");
+static const AnimVariantKey IS_MOVING_LEFT_VAR("isMovingLeft");
+static const AnimVariantKey IS_NOT_MOVING_VAR("isNotMoving");
+static const AnimVariantKey IS_TURNING_LEFT_VAR("isTurningLeft");
+static const AnimVariantKey IS_TURNING_RIGHT_VAR("isTurningRight");
+static const AnimVariantKey IS_NOT_TURNING_VAR("isNotTurning");
+static const AnimVariantKey IS_FLYING_VAR("isFlying");
+static const AnimVariantKey IS_NOT_FLYING_VAR("isNotFlying");
+static const AnimVariantKey IS_TAKEOFF_STAND_VAR("isTakeoffStand");
+static const AnimVariantKey IS_TAKEOFF_RUN_VAR("isTakeoffRun");
+static const AnimVariantKey IS_NOT_TAKEOFF_VAR("isNotTakeoff");
+static const AnimVariantKey IS_IN_AIR_STAND_VAR("isInAirStand");
+static const AnimVariantKey IS_IN_AIR_RUN_VAR("isInAirRun");
+static const AnimVariantKey IS_NOT_IN_AIR_VAR("isNotInAir");
+static const AnimVariantKey IN_AIR_ALPHA_VAR("inAirAlpha");
+static const AnimVariantKey IK_OVERLAY_ALPHA_VAR("ikOverlayAlpha");
+static const AnimVariantKey IS_TALKING_VAR("isTalking");
+static const AnimVariantKey NOT_IS_TALKING_VAR("notIsTalking");
+static const AnimVariantKey HEAD_POSITION_VAR("headPosition");
+static const AnimVariantKey HEAD_ROTATION_VAR("headRotation");
+static const AnimVariantKey HEAD_TYPE_VAR("headType");
+static const AnimVariantKey NECK_POSITION_VAR("neckPosition");
+static const AnimVariantKey NECK_ROTATION_VAR("neckRotation");
+static const AnimVariantKey NECK_TYPE_VAR("neckType");
+static const AnimVariantKey HEAD_AND_NECK_TYPE_VAR("headAndNeckType");
+static const AnimVariantKey LEFT_HAND_POSITION_VAR("leftHandPosition");
+static const AnimVariantKey LEFT_HAND_ROTATION_VAR("leftHandRotation");
+static const AnimVariantKey LEFT_HAND_TYPE_VAR("leftHandType");
+static const AnimVariantKey RIGHT_HAND_POSITION_VAR("rightHandPosition");
+static const AnimVariantKey RIGHT_HAND_ROTATION_VAR("rightHandRotation");
+static const AnimVariantKey RIGHT_HAND_TYPE_VAR("rightHandType");
+
 // 2 meter tall dude
 const glm::vec3 DEFAULT_RIGHT_EYE_POS(-0.3f, 0.9f, 0.0f);
 const glm::vec3 DEFAULT_LEFT_EYE_POS(0.3f, 0.9f, 0.0f);
@@ -82,9 +127,9 @@ void Rig::overrideAnimation(const QString& url, float fps, bool loop, float firs
     _userAnimState = { clipNodeEnum, url, fps, loop, firstFrame, lastFrame };
 
     // notify the userAnimStateMachine the desired state.
-    _animVars.set("userAnimNone", false);
-    _animVars.set("userAnimA", clipNodeEnum == UserAnimState::A);
-    _animVars.set("userAnimB", clipNodeEnum == UserAnimState::B);
+    _animVars.set(USER_ANIM_NONE_VAR, false);
+    _animVars.set(USER_ANIM_A_VAR, clipNodeEnum == UserAnimState::A);
+    _animVars.set(USER_ANIM_B_VAR, clipNodeEnum == UserAnimState::B);
 }
 
 void Rig::restoreAnimation() {
@@ -92,9 +137,9 @@ void Rig::restoreAnimation() {
         _userAnimState.clipNodeEnum = UserAnimState::None;
 
         // notify the userAnimStateMachine the desired state.
-        _animVars.set("userAnimNone", true);
-        _animVars.set("userAnimA", false);
-        _animVars.set("userAnimB", false);
+        _animVars.set(USER_ANIM_NONE_VAR, true);
+        _animVars.set(USER_ANIM_A_VAR, false);
+        _animVars.set(USER_ANIM_B_VAR, false);
     }
 }
 
@@ -352,6 +397,49 @@ float Rig::getIKErrorOnLastSolve() const {
     return result;
 }
 
+int Rig::getIKLoopsOnLastSolve() const {
+    int result = 0;
+
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            auto ikNode = std::dynamic_pointer_cast<AnimInverseKinematics>(node);
+            if (ikNode) {
+                result = ikNode->getNumLoopsOnLastSolve();
+            }
+            return true;
+        });
+    }
+    return result;
+}
+
+float Rig::getIKTimeOnLastSolve() const {
+    uint64_t result = 0;
+
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            auto ikNode = std::dynamic_pointer_cast<AnimInverseKinematics>(node);
+            if (ikNode) {
+                result = ikNode->getTimeOnLastSolve();
+            }
+            return true;
+        });
+    }
+    return (float)result / (float)USECS_PER_MSEC;
+}
+
+void Rig::setMaxIKLoops(int maxLoops) {
+    _maxIKLoops = maxLoops;
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            auto ikNode = std::dynamic_pointer_cast<AnimInverseKinematics>(node);
+            if (ikNode) {
+                ikNode->setMaxSolveLoops(maxLoops);
+            }
+            return true;
+        });
+    }
+}
+
 int Rig::getJointParentIndex(int childIndex) const {
     if (_animSkeleton && isIndexValid(childIndex)) {
         return _animSkeleton->getParentIndex(childIndex);
@@ -574,7 +662,7 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
 
         // sine wave LFO var for testing.
         static float t = 0.0f;
-        _animVars.set("sine", 2.0f * 0.5f * sinf(t) + 0.5f);
+        _animVars.set(SINE_VAR, 2.0f * 0.5f * sinf(t) + 0.5f);
 
         float moveForwardAlpha = 0.0f;
         float moveBackwardAlpha = 0.0f;
@@ -585,14 +673,14 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
         calcAnimAlpha(-_averageForwardSpeed.getAverage(), BACKWARD_SPEEDS, &moveBackwardAlpha);
         calcAnimAlpha(fabsf(_averageLateralSpeed.getAverage()), LATERAL_SPEEDS, &moveLateralAlpha);
 
-        _animVars.set("moveForwardSpeed", _averageForwardSpeed.getAverage());
-        _animVars.set("moveForwardAlpha", moveForwardAlpha);
+        _animVars.set(MOVE_FORWARD_SPEED_VAR, _averageForwardSpeed.getAverage());
+        _animVars.set(MOVE_FORWARD_ALPHA_VAR, moveForwardAlpha);
 
-        _animVars.set("moveBackwardSpeed", -_averageForwardSpeed.getAverage());
-        _animVars.set("moveBackwardAlpha", moveBackwardAlpha);
+        _animVars.set(MOVE_BACKWARD_SPEED_VAR, -_averageForwardSpeed.getAverage());
+        _animVars.set(MOVE_BACKWARD_ALPHA_VAR, moveBackwardAlpha);
 
-        _animVars.set("moveLateralSpeed", fabsf(_averageLateralSpeed.getAverage()));
-        _animVars.set("moveLateralAlpha", moveLateralAlpha);
+        _animVars.set(MOVE_LATERAL_SPEED_VAR, fabsf(_averageLateralSpeed.getAverage()));
+        _animVars.set(MOVE_LATERAL_ALPHA_VAR, moveLateralAlpha);
 
         const float MOVE_ENTER_SPEED_THRESHOLD = 0.2f; // m/sec
         const float MOVE_EXIT_SPEED_THRESHOLD = 0.07f;  // m/sec
@@ -673,180 +761,180 @@ void Rig::computeMotionAnimationState(float deltaTime, const glm::vec3& worldPos
                 if (fabsf(forwardSpeed) > 0.5f * fabsf(lateralSpeed)) {
                     if (forwardSpeed > 0.0f) {
                         // forward
-                        _animVars.set("isMovingForward", true);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, true);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
 
                     } else {
                         // backward
-                        _animVars.set("isMovingBackward", true);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, true);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                        _animVars.set(IS_MOVING_LEFT_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     }
                 } else {
                     if (lateralSpeed > 0.0f) {
                         // right
-                        _animVars.set("isMovingRight", true);
-                        _animVars.set("isMovingLeft", false);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, true);
+                        _animVars.set(IS_MOVING_LEFT_VAR, false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     } else {
                         // left
-                        _animVars.set("isMovingLeft", true);
-                        _animVars.set("isMovingRight", false);
-                        _animVars.set("isMovingForward", false);
-                        _animVars.set("isMovingBackward", false);
-                        _animVars.set("isNotMoving", false);
+                        _animVars.set(IS_MOVING_LEFT_VAR, true);
+                        _animVars.set(IS_MOVING_RIGHT_VAR, false);
+                        _animVars.set(IS_MOVING_FORWARD_VAR, false);
+                        _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+                        _animVars.set(IS_NOT_MOVING_VAR, false);
                     }
                 }
             }
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
 
         } else if (_state == RigRole::Turn) {
             if (turningSpeed > 0.0f) {
                 // turning right
-                _animVars.set("isTurningRight", true);
-                _animVars.set("isTurningLeft", false);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(IS_TURNING_RIGHT_VAR, true);
+                _animVars.set(IS_TURNING_LEFT_VAR, false);
+                _animVars.set(IS_NOT_TURNING_VAR, false);
             } else {
                 // turning left
-                _animVars.set("isTurningLeft", true);
-                _animVars.set("isTurningRight", false);
-                _animVars.set("isNotTurning", false);
+                _animVars.set(IS_TURNING_LEFT_VAR, true);
+                _animVars.set(IS_TURNING_RIGHT_VAR, false);
+                _animVars.set(IS_NOT_TURNING_VAR, false);
             }
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
 
         } else if (_state == RigRole::Idle ) {
             // default anim vars to notMoving and notTurning
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
 
         } else if (_state == RigRole::Hover) {
             // flying.
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", true);
-            _animVars.set("isNotFlying", false);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, true);
+            _animVars.set(IS_NOT_FLYING_VAR, false);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, true);
 
         } else if (_state == RigRole::Takeoff) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
 
             bool takeOffRun = forwardSpeed > 0.1f;
             if (takeOffRun) {
-                _animVars.set("isTakeoffStand", false);
-                _animVars.set("isTakeoffRun", true);
+                _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+                _animVars.set(IS_TAKEOFF_RUN_VAR, true);
             } else {
-                _animVars.set("isTakeoffStand", true);
-                _animVars.set("isTakeoffRun", false);
+                _animVars.set(IS_TAKEOFF_STAND_VAR, true);
+                _animVars.set(IS_TAKEOFF_RUN_VAR, false);
             }
 
-            _animVars.set("isNotTakeoff", false);
-            _animVars.set("isInAirStand", false);
-            _animVars.set("isInAirRun", false);
-            _animVars.set("isNotInAir", false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, false);
+            _animVars.set(IS_IN_AIR_STAND_VAR, false);
+            _animVars.set(IS_IN_AIR_RUN_VAR, false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, false);
 
         } else if (_state == RigRole::InAir) {
             // jumping in-air
-            _animVars.set("isMovingForward", false);
-            _animVars.set("isMovingBackward", false);
-            _animVars.set("isMovingLeft", false);
-            _animVars.set("isMovingRight", false);
-            _animVars.set("isNotMoving", true);
-            _animVars.set("isTurningLeft", false);
-            _animVars.set("isTurningRight", false);
-            _animVars.set("isNotTurning", true);
-            _animVars.set("isFlying", false);
-            _animVars.set("isNotFlying", true);
-            _animVars.set("isTakeoffStand", false);
-            _animVars.set("isTakeoffRun", false);
-            _animVars.set("isNotTakeoff", true);
+            _animVars.set(IS_MOVING_FORWARD_VAR, false);
+            _animVars.set(IS_MOVING_BACKWARD_VAR, false);
+            _animVars.set(IS_MOVING_LEFT_VAR, false);
+            _animVars.set(IS_MOVING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_MOVING_VAR, true);
+            _animVars.set(IS_TURNING_LEFT_VAR, false);
+            _animVars.set(IS_TURNING_RIGHT_VAR, false);
+            _animVars.set(IS_NOT_TURNING_VAR, true);
+            _animVars.set(IS_FLYING_VAR, false);
+            _animVars.set(IS_NOT_FLYING_VAR, true);
+            _animVars.set(IS_TAKEOFF_STAND_VAR, false);
+            _animVars.set(IS_TAKEOFF_RUN_VAR, false);
+            _animVars.set(IS_NOT_TAKEOFF_VAR, true);
 
             bool inAirRun = forwardSpeed > 0.1f;
             if (inAirRun) {
-                _animVars.set("isInAirStand", false);
-                _animVars.set("isInAirRun", true);
+                _animVars.set(IS_IN_AIR_STAND_VAR, false);
+                _animVars.set(IS_IN_AIR_RUN_VAR, true);
             } else {
-                _animVars.set("isInAirStand", true);
-                _animVars.set("isInAirRun", false);
+                _animVars.set(IS_IN_AIR_STAND_VAR, true);
+                _animVars.set(IS_IN_AIR_RUN_VAR, false);
             }
-            _animVars.set("isNotInAir", false);
+            _animVars.set(IS_NOT_IN_AIR_VAR, false);
 
             // compute blend based on velocity
             const float JUMP_SPEED = 3.5f;
             float alpha = glm::clamp(-_lastVelocity.y / JUMP_SPEED, -1.0f, 1.0f) + 1.0f;
-            _animVars.set("inAirAlpha", alpha);
+            _animVars.set(IN_AIR_ALPHA_VAR, alpha);
         }
 
         t += deltaTime;
 
         if (_enableInverseKinematics != _lastEnableInverseKinematics) {
             if (_enableInverseKinematics) {
-                _animVars.set("ikOverlayAlpha", 1.0f);
+                _animVars.set(IK_OVERLAY_ALPHA_VAR, 1.0f);
             } else {
-                _animVars.set("ikOverlayAlpha", 0.0f);
+                _animVars.set(IK_OVERLAY_ALPHA_VAR, 0.0f);
             }
         }
         _lastEnableInverseKinematics = _enableInverseKinematics;
@@ -933,7 +1021,7 @@ void Rig::updateAnimationStateHandlers() { // called on avatar update thread (wh
 
         // Gather results in (likely from an earlier update).
         // Note: the behavior is undefined if a handler (re-)sets a trigger. Scripts should not be doing that.
-        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registgered wins. (_map preserves order).
+        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registgered wins. (copies in handler order).
     }
 }
 
@@ -1020,8 +1108,8 @@ glm::quat Rig::getJointDefaultRotationInParentFrame(int jointIndex) {
 void Rig::updateFromHeadParameters(const HeadParameters& params, float dt) {
     updateNeckJoint(params.neckJointIndex, params);
 
-    _animVars.set("isTalking", params.isTalking);
-    _animVars.set("notIsTalking", !params.isTalking);
+    _animVars.set(IS_TALKING_VAR, params.isTalking);
+    _animVars.set(NOT_IS_TALKING_VAR, !params.isTalking);
 }
 
 void Rig::updateFromEyeParameters(const EyeParameters& params) {
@@ -1090,21 +1178,21 @@ void Rig::updateNeckJoint(int index, const HeadParameters& params) {
             DebugDraw::getInstance().addMyAvatarMarker("neckTarget", neckPose.rot, neckPose.trans, green);
 #endif
 
-            _animVars.set("headPosition", headPos);
-            _animVars.set("headRotation", headRot);
-            _animVars.set("headType", (int)IKTarget::Type::HmdHead);
-            _animVars.set("neckPosition", neckPos);
-            _animVars.set("neckRotation", neckRot);
-            _animVars.set("neckType", (int)IKTarget::Type::Unknown); // 'Unknown' disables the target
+            _animVars.set(HEAD_POSITION_VAR, headPos);
+            _animVars.set(HEAD_ROTATION_VAR, headRot);
+            _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::HmdHead);
+            _animVars.set(NECK_POSITION_VAR, neckPos);
+            _animVars.set(NECK_ROTATION_VAR, neckRot);
+            _animVars.set(NECK_TYPE_VAR, (int)IKTarget::Type::Unknown); // 'Unknown' disables the target
 
         } else {
-            _animVars.unset("headPosition");
-            _animVars.set("headRotation", params.rigHeadOrientation * yFlip180);
-            _animVars.set("headAndNeckType", (int)IKTarget::Type::RotationOnly);
-            _animVars.set("headType", (int)IKTarget::Type::RotationOnly);
-            _animVars.unset("neckPosition");
-            _animVars.unset("neckRotation");
-            _animVars.set("neckType", (int)IKTarget::Type::RotationOnly);
+            _animVars.unset(HEAD_POSITION_VAR);
+            _animVars.set(HEAD_ROTATION_VAR, params.rigHeadOrientation * yFlip180);
+            _animVars.set(HEAD_AND_NECK_TYPE_VAR, (int)IKTarget::Type::RotationOnly);
+            _animVars.set(HEAD_TYPE_VAR, (int)IKTarget::Type::RotationOnly);
+            _animVars.unset(NECK_POSITION_VAR);
+            _animVars.unset(NECK_ROTATION_VAR);
+            _animVars.set(NECK_TYPE_VAR, (int)IKTarget::Type::RotationOnly);
         }
     }
 }
@@ -1169,13 +1257,13 @@ void Rig::updateFromHandParameters(const HandParameters& params, float dt) {
                 handPosition -= displacement;
             }
 
-            _animVars.set("leftHandPosition", handPosition);
-            _animVars.set("leftHandRotation", params.leftOrientation);
-            _animVars.set("leftHandType", (int)IKTarget::Type::RotationAndPosition);
+            _animVars.set(LEFT_HAND_POSITION_VAR, handPosition);
+            _animVars.set(LEFT_HAND_ROTATION_VAR, params.leftOrientation);
+            _animVars.set(LEFT_HAND_TYPE_VAR, (int)IKTarget::Type::RotationAndPosition);
         } else {
-            _animVars.unset("leftHandPosition");
-            _animVars.unset("leftHandRotation");
-            _animVars.set("leftHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+            _animVars.unset(LEFT_HAND_POSITION_VAR);
+            _animVars.unset(LEFT_HAND_ROTATION_VAR);
+            _animVars.set(LEFT_HAND_TYPE_VAR, (int)IKTarget::Type::HipsRelativeRotationAndPosition);
         }
 
         if (params.isRightEnabled) {
@@ -1187,13 +1275,13 @@ void Rig::updateFromHandParameters(const HandParameters& params, float dt) {
                 handPosition -= displacement;
             }
 
-            _animVars.set("rightHandPosition", handPosition);
-            _animVars.set("rightHandRotation", params.rightOrientation);
-            _animVars.set("rightHandType", (int)IKTarget::Type::RotationAndPosition);
+            _animVars.set(RIGHT_HAND_POSITION_VAR, handPosition);
+            _animVars.set(RIGHT_HAND_ROTATION_VAR, params.rightOrientation);
+            _animVars.set(RIGHT_HAND_TYPE_VAR, (int)IKTarget::Type::RotationAndPosition);
         } else {
-            _animVars.unset("rightHandPosition");
-            _animVars.unset("rightHandRotation");
-            _animVars.set("rightHandType", (int)IKTarget::Type::HipsRelativeRotationAndPosition);
+            _animVars.unset(RIGHT_HAND_POSITION_VAR);
+            _animVars.unset(RIGHT_HAND_ROTATION_VAR);
+            _animVars.set(RIGHT_HAND_TYPE_VAR, (int)IKTarget::Type::HipsRelativeRotationAndPosition);
         }
     }
 }
@@ -1208,6 +1296,7 @@ void Rig::initAnimGraph(const QUrl& url) {
     connect(_animLoader.get(), &AnimNodeLoader::success, [this](AnimNode::Pointer nodeIn) {
         _animNode = nodeIn;
         _animNode->setSkeleton(_animSkeleton);
+        setMaxIKLoops(_maxIKLoops);
 
         if (_userAnimState.clipNodeEnum != UserAnimState::None) {
             // restore the user animation we had before reset.
@@ -108,6 +108,12 @@ public:
     float getMaxHipsOffsetLength() const;
 
     float getIKErrorOnLastSolve() const;
+    int getIKLoopsOnLastSolve() const;
+    float getIKTimeOnLastSolve() const; // msecs
+
+    // the budget of IK solver loops per frame for this rig, kept when the anim graph is reloaded
+    void setMaxIKLoops(int maxLoops);
+    int getMaxIKLoops() const { return _maxIKLoops; }
 
     int getJointParentIndex(int childIndex) const;
 
@@ -324,6 +330,7 @@ protected:
 
     mutable uint32_t _jointNameWarningCount { 0 };
     float _maxHipsOffsetLength { 1.0f };
+    int _maxIKLoops { 16 }; // AnimInverseKinematics::DEFAULT_MAX_SOLVE_LOOPS
     float _maxErrorOnLastSolve { 0.0f };
 
 private:
@@ -32,6 +32,7 @@
 #endif
 
 #include <QtCore/QBuffer>
+#include <QtCore/QMetaMethod>
 #include <QtMultimedia/QAudioInput>
 #include <QtMultimedia/QAudioOutput>
 
@@ -53,6 +54,12 @@ const int AudioClient::MAX_BUFFER_FRAMES = 20;
 
 static const int RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES = 100;
 
+// network frames of received audio waiting for the reverb bus
+static const int REVERB_SEND_CAPACITY_FRAMES = 10;
+
+// reverb changes, as when walking into another zone, glide over this time instead of switching at once
+static const int REVERB_GLIDE_FRAMES = AudioConstants::SAMPLE_RATE / 4;
+
 static const auto DEFAULT_POSITION_GETTER = []{ return Vectors::ZERO; };
 static const auto DEFAULT_ORIENTATION_GETTER = [] { return Quaternions::IDENTITY; };
 
@@ -160,7 +167,7 @@ AudioClient::AudioClient() :
     _loopbackAudioOutput(NULL),
     _loopbackOutputDevice(NULL),
     _inputRingBuffer(0),
-    _localInjectorsStream(0, 1),
+    _localInjectorsStream(0),
     _receivedAudioStream(RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES),
     _isStereoInput(false),
     _outputStarveDetectionStartTimeMsec(0),
@@ -176,6 +183,7 @@ AudioClient::AudioClient() :
     _isNoiseGateEnabled(true),
     _reverb(false),
     _reverbOptions(&_scriptReverbOptions),
+    _networkReverbSend(REVERB_SEND_CAPACITY_FRAMES * AudioConstants::NETWORK_FRAME_SAMPLES_STEREO),
     _inputToNetworkResampler(NULL),
     _networkToOutputResampler(NULL),
     _localToOutputResampler(NULL),
@@ -186,9 +194,6 @@ AudioClient::AudioClient() :
     _stats(&_receivedAudioStream),
     _positionGetter(DEFAULT_POSITION_GETTER),
     _orientationGetter(DEFAULT_ORIENTATION_GETTER) {
-    // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
-
     // deprecate legacy settings
     {
         Setting::Handle<int>::Deprecated("maxFramesOverDesired", InboundAudioStream::MAX_FRAMES_OVER_DESIRED);
@@ -205,10 +210,8 @@ AudioClient::AudioClient() :
 
     connect(&_receivedAudioStream, &InboundAudioStream::mismatchedAudioCodec, this, &AudioClient::handleMismatchAudioFormat);
 
-    _inputDevices = getDeviceNames(QAudio::AudioInput);
-    _outputDevices = getDeviceNames(QAudio::AudioOutput);
-
-    // start a thread to detect any device changes
+    // start a thread to detect any device changes, the devices are first enumerated there rather than as the
+    // client is created at startup
     _checkDevicesThread = new CheckDevicesThread(this);
     _checkDevicesThread->setObjectName("CheckDevices Thread");
     _checkDevicesThread->setPriority(QThread::LowPriority);
@@ -254,8 +257,7 @@ void AudioClient::reset() {
     _receivedAudioStream.reset();
     _stats.reset();
     _sourceReverb.reset();
-    _listenerReverb.reset();
-    _localReverb.reset();
+    _reverbBusResetPending = true;
 }
 
 void AudioClient::audioMixerKilled() {
@@ -811,8 +813,14 @@ void AudioClient::configureReverb() {
     p.lateMixRight = _reverbOptions->getLateMixRight();
     p.wetDryMix = _reverbOptions->getWetDryMix();
 
-    _listenerReverb.setParameters(&p);
-    _localReverb.setParameters(&p);
+    {
+        // the bus renders the wet signal only, the wet and dry levels are applied as it is mixed
+        Lock lock(_reverbBusMutex);
+        _reverbBusParameters = p;
+        _reverbBusParameters.wetDryMix = 100.0f;
+        _reverbBusWetLevel = glm::clamp(p.wetDryMix / 100.0f, 0.0f, 1.0f);
+        _reverbBusChanged = true;
+    }
 
     // used only for adding self-reverb to loopback audio
     p.sampleRate = _outputFormat.sampleRate();
@@ -856,10 +864,9 @@ void AudioClient::updateReverbOptions() {
 void AudioClient::setReverb(bool reverb) {
     _reverb = reverb;
 
+    // the bus is left to ring out, it stops once its tail has decayed
     if (!_reverb) {
         _sourceReverb.reset();
-        _listenerReverb.reset();
-        _localReverb.reset();
     }
 }
 
@@ -893,7 +900,7 @@ void AudioClient::setReverbOptions(const AudioEffectOptions* options) {
     }
 }
 
-void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
+void AudioClient::handleLocalEchoAndReverb(const int16_t* inputSamples, int numInputSamples) {
     // If there is server echo, reverb will be applied to the recieved audio stream so no need to have it here.
     bool hasReverb = _reverb || _receivedAudioStream.hasReverb();
     if (_muted || !_audioOutput || (!_shouldEchoLocally && !hasReverb)) {
@@ -925,12 +932,10 @@ void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
 
     static QByteArray loopBackByteArray;
 
-    int numInputSamples = inputByteArray.size() / AudioConstants::SAMPLE_SIZE;
     int numLoopbackSamples = (numInputSamples * OUTPUT_CHANNEL_COUNT) / _inputFormat.channelCount();
 
     loopBackByteArray.resize(numLoopbackSamples * AudioConstants::SAMPLE_SIZE);
 
-    int16_t* inputSamples = reinterpret_cast<int16_t*>(inputByteArray.data());
     int16_t* loopbackSamples = reinterpret_cast<int16_t*>(loopBackByteArray.data());
 
     // upmix mono to stereo
@@ -949,7 +954,7 @@ void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
     int deviceChannelCount = _outputFormat.channelCount();
     if (deviceChannelCount == OUTPUT_CHANNEL_COUNT) {
 
-        _loopbackOutputDevice->write(loopBackByteArray);
+        _loopbackOutputDevice->write(loopBackByteArray.constData(), loopBackByteArray.size());
 
     } else {
 
@@ -966,7 +971,7 @@ void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
         } else {
             channelDownmix(loopbackSamples, deviceSamples, numLoopbackSamples);
         }
-        _loopbackOutputDevice->write(deviceByteArray);
+        _loopbackOutputDevice->write(deviceByteArray.constData(), deviceByteArray.size());
     }
 }
 
@@ -1006,7 +1011,11 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
             _timeSinceLastClip += (float)numSamples / (float)AudioConstants::SAMPLE_RATE;
         }
 
-        emit inputReceived({ audioBuffer.data(), numSamples });
+        // the copy for the listeners is only made when there are some
+        static const QMetaMethod inputReceivedSignal = QMetaMethod::fromSignal(&AudioClient::inputReceived);
+        if (isSignalConnected(inputReceivedSignal)) {
+            emit inputReceived({ audioBuffer.data(), numSamples });
+        }
 
         if (_noiseGate.openedInLastBlock()) {
             emit noiseGateOpened();
@@ -1030,14 +1039,20 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
     audioTransform.setTranslation(_positionGetter());
     audioTransform.setRotation(_orientationGetter());
 
-    QByteArray encodedBuffer;
+    // the raw frame goes out as it is, without sharing the buffer that the next frame is written to
+    const QByteArray* packetBuffer = &audioBuffer;
     if (_encoder) {
-        _encoder->encode(audioBuffer, encodedBuffer);
-    } else {
-        encodedBuffer = audioBuffer;
+        _encoder->encode(audioBuffer, _encodedBuffer);
+        packetBuffer = &_encodedBuffer;
+
+        // a frame the decoder fills in by itself goes out as a silent packet, sized by the raw frame
+        if (_encoder->isDiscontinuous() && packetType != PacketType::SilentAudioFrame) {
+            packetType = PacketType::SilentAudioFrame;
+            packetBuffer = &audioBuffer;
+        }
     }
 
-    emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber,
+    emitAudioPacket(packetBuffer->constData(), packetBuffer->size(), _outgoingAvatarAudioSequenceNumber,
             audioTransform, avatarBoundingBoxCorner, avatarBoundingBoxScale,
             packetType, _selectedCodecName);
     _stats.sentPacket();
@@ -1053,14 +1068,26 @@ void AudioClient::handleMicAudioInput() {
                                       _inputToNetworkResampler->getMinInput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) :
                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) * _inputFormat.channelCount();
 
-    const auto inputAudioSamples = std::unique_ptr<int16_t[]>(new int16_t[inputSamplesRequired]);
-    QByteArray inputByteArray = _inputDevice->readAll();
-
-    handleLocalEchoAndReverb(inputByteArray);
+    // The buffers only grow, to the sizes of the largest device, so that reading a frame never allocates. The
+    // device is read straight into them instead of through a new QByteArray.
+    if ((int)_inputScratchBuffer.size() < inputSamplesRequired) {
+        _inputScratchBuffer.resize(inputSamplesRequired);
+    }
+    int readSamples = std::max(_numInputCallbackBytes / AudioConstants::SAMPLE_SIZE, inputSamplesRequired);
+    if ((int)_inputReadBuffer.size() < readSamples) {
+        _inputReadBuffer.resize(readSamples);
+    }
 
-    _inputRingBuffer.writeData(inputByteArray.data(), inputByteArray.size());
+    qint64 inputBytesRead = 0;
+    qint64 bytesRead;
+    while ((bytesRead = _inputDevice->read(reinterpret_cast<char*>(_inputReadBuffer.data()),
+                                           _inputReadBuffer.size() * AudioConstants::SAMPLE_SIZE)) > 0) {
+        handleLocalEchoAndReverb(_inputReadBuffer.data(), (int)(bytesRead / AudioConstants::SAMPLE_SIZE));
+        _inputRingBuffer.writeData(reinterpret_cast<char*>(_inputReadBuffer.data()), bytesRead);
+        inputBytesRead += bytesRead;
+    }
 
-    float audioInputMsecsRead = inputByteArray.size() / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
+    float audioInputMsecsRead = inputBytesRead / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
     _stats.updateInputMsRead(audioInputMsecsRead);
 
     const int numNetworkBytes = _isStereoInput
@@ -1070,15 +1097,17 @@ void AudioClient::handleMicAudioInput() {
         ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
         : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
 
-    static int16_t networkAudioSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    // the network frame is resampled in place in the buffer that is encoded and sent
+    _networkAudioBuffer.resize(numNetworkBytes);
+    int16_t* networkAudioSamples = reinterpret_cast<int16_t*>(_networkAudioBuffer.data());
 
     while (_inputRingBuffer.samplesAvailable() >= inputSamplesRequired) {
         if (_muted) {
             _inputRingBuffer.shiftReadPosition(inputSamplesRequired);
         } else {
-            _inputRingBuffer.readSamples(inputAudioSamples.get(), inputSamplesRequired);
+            _inputRingBuffer.readSamples(_inputScratchBuffer.data(), inputSamplesRequired);
             possibleResampling(_inputToNetworkResampler,
-                inputAudioSamples.get(), networkAudioSamples,
+                _inputScratchBuffer.data(), networkAudioSamples,
                 inputSamplesRequired, numNetworkSamples,
                 _inputFormat.channelCount(), _desiredInputFormat.channelCount());
         }
@@ -1086,8 +1115,7 @@ void AudioClient::handleMicAudioInput() {
         float msecsInInputRingBuffer = bytesInInputRingBuffer / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
         _stats.updateInputMsUnplayed(msecsInInputRingBuffer);
 
-        QByteArray audioBuffer(reinterpret_cast<char*>(networkAudioSamples), numNetworkBytes);
-        handleAudioInput(audioBuffer);
+        handleAudioInput(_networkAudioBuffer);
     }
 }
 
@@ -1103,8 +1131,7 @@ void AudioClient::prepareLocalAudioInjectors() {
 
     int bufferCapacity = _localInjectorsStream.getSampleCapacity();
     if (_localToOutputResampler) {
-        // avoid overwriting the buffer,
-        // instead of failing on writes because the buffer is used as a lock-free pipe
+        // leave room for a whole resampled frame, as writes to the lock-free pipe are truncated when full
         bufferCapacity -=
             _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) *
             AudioConstants::STEREO;
@@ -1113,24 +1140,27 @@ void AudioClient::prepareLocalAudioInjectors() {
 
     int samplesNeeded = std::numeric_limits<int>::max();
     while (samplesNeeded > 0) {
-        // lock for every write to avoid locking out the device callback
-        // this lock is intentional - the buffer is only lock-free in its use in the device callback
+        // lock out device switches (which clear and resize the buffer) for every write
+        // the device callback never takes this lock, so mixing here does not delay it
         RecursiveLock lock(_localAudioMutex);
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
+        samplesNeeded = bufferCapacity - _localInjectorsStream.samplesAvailable();
         if (samplesNeeded <= 0) {
             break;
         }
 
-        // get a network frame of local injectors' audio
-        if (!mixLocalAudioInjectors(_localMixBuffer)) {
-            break;
+        // get a network frame of local injectors' audio, and of what they send to the reverb
+        bool hasInjectors = mixLocalAudioInjectors(_localMixBuffer, _localSendBuffer);
+        if (!hasInjectors) {
+            if (!isReverbBusActive()) {
+                break;
+            }
+            memset(_localMixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
+            memset(_localSendBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
         }
 
-        // reverb
-        if (_reverb) {
-            _localReverb.render(_localMixBuffer, _localMixBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-        }
+        // reverb of the local injectors and of the received audio, rendered once for both
+        mixReverbBus(_localMixBuffer, _localSendBuffer, hasInjectors && _reverb);
 
         int samples;
         if (_localToOutputResampler) {
@@ -1149,12 +1179,72 @@ void AudioClient::prepareLocalAudioInjectors() {
                 AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
 
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
         samplesNeeded -= samples;
     }
 }
 
-bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
+void AudioClient::updateReverbBus() {
+    if (_reverbBusResetPending.exchange(false)) {
+        _reverbBus.reset();
+        _networkReverbSend.skipSamples(_networkReverbSend.samplesAvailable());
+        _reverbTailFrames = 0;
+    }
+
+    if (!_reverbBusChanged.exchange(false)) {
+        return;
+    }
+
+    ReverbParameters parameters;
+    {
+        Lock lock(_reverbBusMutex);
+        parameters = _reverbBusParameters;
+        _reverbTargetWetLevel = _reverbBusWetLevel;
+    }
+
+    if (_isReverbBusConfigured && _reverbTailFrames > 0) {
+        _reverbBus.glideParameters(&parameters, REVERB_GLIDE_FRAMES);
+    } else {
+        // nothing is ringing, so there is nothing to glide
+        _reverbBus.setParameters(&parameters);
+        _reverbWetLevel = _reverbTargetWetLevel;
+        _isReverbBusConfigured = true;
+    }
+
+    // network frames until the tail has decayed by 60 dB
+    float tailSeconds = parameters.reverbTime + parameters.preDelay / 1000.0f + parameters.lateDelay / 1000.0f;
+    _reverbTailLength = (int)ceilf(tailSeconds * AudioConstants::SAMPLE_RATE / AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+}
+
+void AudioClient::mixReverbBus(float* mixBuffer, float* sendBuffer, bool hasLocalSend) {
+    updateReverbBus();
+
+    // add the received audio sent to the bus, as much of it as has arrived
+    int networkSamples = _networkReverbSend.appendSamples(sendBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+    if (networkSamples > 0 || hasLocalSend) {
+        _reverbTailFrames = _reverbTailLength;
+    } else if (_reverbTailFrames > 0) {
+        _reverbTailFrames--;
+    } else {
+        return;
+    }
+
+    _reverbBus.render(sendBuffer, _reverbWetBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    // move the wet level toward its target at the rate of the parameter glide
+    float wetLevel = _reverbWetLevel.load(std::memory_order_relaxed);
+    const float MAX_WET_LEVEL_STEP = (float)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL / REVERB_GLIDE_FRAMES;
+    wetLevel += glm::clamp(_reverbTargetWetLevel - wetLevel, -MAX_WET_LEVEL_STEP, MAX_WET_LEVEL_STEP);
+    _reverbWetLevel.store(wetLevel, std::memory_order_relaxed);
+
+    // the received audio was already brought to its dry level as it was sent
+    float localDryLevel = hasLocalSend ? 1.0f - wetLevel : 1.0f;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        mixBuffer[i] = mixBuffer[i] * localDryLevel + _reverbWetBuffer[i] * wetLevel;
+    }
+}
+
+bool AudioClient::mixLocalAudioInjectors(float* mixBuffer, float* sendBuffer) {
 
     QVector<AudioInjector*> injectorsToRemove;
     
@@ -1166,10 +1256,19 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
     }
 
     memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
+    memset(sendBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
 
     for (AudioInjector* injector : _activeLocalAudioInjectors) {
         if (injector->getLocalBuffer()) {
 
+            // an injector sending to the reverb is rendered on its own first, to be added to both mixes
+            float send = _reverb ? injector->getReverbSend() : 0.0f;
+            float* injectorBuffer = mixBuffer;
+            if (send > 0.0f) {
+                injectorBuffer = _localInjectorBuffer;
+                memset(injectorBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
+            }
+
             static const int HRTF_DATASET_INDEX = 1;
 
             int numChannels = injector->isAmbisonic() ? AudioConstants::AMBISONIC : (injector->isStereo() ? AudioConstants::STEREO : AudioConstants::MONO);
@@ -1196,16 +1295,16 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
                     float qy = -relativeOrientation.x;
                     float qz = relativeOrientation.y;
 
-                    // Ambisonic gets spatialized into mixBuffer
-                    injector->getLocalFOA().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
+                    // Ambisonic gets spatialized into injectorBuffer
+                    injector->getLocalFOA().render(_localScratchBuffer, injectorBuffer, HRTF_DATASET_INDEX,
                                                    qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
                 } else if (injector->isStereo()) {
 
-                    // stereo gets directly mixed into mixBuffer
+                    // stereo gets directly mixed into injectorBuffer
                     float gain = injector->getVolume();
                     for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
-                        mixBuffer[i] += convertToFloat(_localScratchBuffer[i]) * gain;
+                        injectorBuffer[i] += convertToFloat(_localScratchBuffer[i]) * gain;
                     }
                     
                 } else {
@@ -1216,10 +1315,17 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
                     float gain = gainForSource(distance, injector->getVolume()); 
                     float azimuth = azimuthForSource(relativePosition);
                 
-                    // mono gets spatialized into mixBuffer
-                    injector->getLocalHRTF().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX, 
+                    // mono gets spatialized into injectorBuffer
+                    injector->getLocalHRTF().render(_localScratchBuffer, injectorBuffer, HRTF_DATASET_INDEX, 
                                                     azimuth, distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
                 }
+
+                if (injectorBuffer != mixBuffer) {
+                    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+                        mixBuffer[i] += injectorBuffer[i];
+                        sendBuffer[i] += injectorBuffer[i] * send;
+                    }
+                }
             
             } else {
                 
@@ -1254,11 +1360,19 @@ void AudioClient::processReceivedSamples(const QByteArray& decodedBuffer, QByteA
 
     bool hasReverb = _reverb || _receivedAudioStream.hasReverb();
 
-    // apply stereo reverb
+    // send to the reverb bus, which mixes the wet signal with the local injectors, and keep the dry signal here
     if (hasReverb) {
         updateReverbOptions();
-        int16_t* reverbSamples = _networkToOutputResampler ? _networkScratchBuffer : outputSamples;
-        _listenerReverb.render(decodedSamples, reverbSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+            _networkSendBuffer[i] = convertToFloat(decodedSamples[i]);
+        }
+        _networkReverbSend.writeSamples(_networkSendBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+        float dryLevel = 1.0f - _reverbWetLevel.load(std::memory_order_relaxed);
+        int16_t* drySamples = _networkToOutputResampler ? _networkScratchBuffer : outputSamples;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+            drySamples[i] = (int16_t)(decodedSamples[i] * dryLevel);
+        }
     }
 
     // resample to output sample rate
@@ -1453,7 +1567,7 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
     bool supportedFormat = false;
 
     RecursiveLock lock(_localAudioMutex);
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
+    _localInjectorsStream.clear();
 
     // cleanup any previously initialized device
     if (_audioOutput) {
@@ -1530,7 +1644,10 @@ bool AudioClient::switchOutputToAudioDevice(const QAudioDeviceInfo& outputDevice
                     _networkPeriod = _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
                     _localOutputMixBuffer = new float[_networkPeriod];
                     int localPeriod = _outputPeriod * 2;
-                    _localInjectorsStream.resizeForFrameSize(localPeriod);
+                    {
+                        RecursiveLock lock(_localAudioMutex);
+                        _localInjectorsStream.resize(localPeriod);
+                    }
 
                     int bufferSize = _audioOutput->bufferSize();
                     int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
@@ -1679,13 +1796,16 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
         samplesRequested = networkSamplesPopped;
     }
 
+    // the local injectors' stream is a lock-free pipe, so the callback never waits on the local audio thread
     int injectorSamplesPopped = 0;
     {
-        RecursiveLock lock(_audio->_localAudioMutex);
         bool append = networkSamplesPopped > 0;
-        samplesRequested = std::min(samplesRequested, _audio->_localSamplesAvailable.load(std::memory_order_acquire));
-        if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
+        if (append) {
+            injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested);
+        } else {
+            injectorSamplesPopped = _localInjectorsStream.readSamples(mixBuffer, samplesRequested);
+        }
+        if (injectorSamplesPopped > 0) {
             qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
         }
     }
@@ -1735,7 +1855,11 @@ void AudioClient::checkDevices() {
     QVector<QString> inputDevices = getDeviceNames(QAudio::AudioInput);
     QVector<QString> outputDevices = getDeviceNames(QAudio::AudioOutput);
 
-    if (inputDevices != _inputDevices || outputDevices != _outputDevices) {
+    if (!_hasCheckedDevices) {
+        _hasCheckedDevices = true;
+        _inputDevices = inputDevices;
+        _outputDevices = outputDevices;
+    } else if (inputDevices != _inputDevices || outputDevices != _outputDevices) {
         _inputDevices = inputDevices;
         _outputDevices = outputDevices;
 
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioClient_h
 #define hifi_AudioClient_h
 
+#include <atomic>
 #include <fstream>
 #include <memory>
 #include <vector>
@@ -46,6 +47,7 @@
 #include <AudioLimiter.h>
 #include <AudioConstants.h>
 #include <AudioNoiseGate.h>
+#include <AudioSPSCRingBuffer.h>
 
 #include <shared/RateCounter.h>
 
@@ -88,7 +90,7 @@ class AudioClient : public AbstractAudioInterface, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
-    using LocalInjectorsStream = AudioMixRingBuffer;
+    using LocalInjectorsStream = AudioMixSPSCRingBuffer;
 public:
     static const int MIN_BUFFER_FRAMES;
     static const int MAX_BUFFER_FRAMES;
@@ -251,7 +253,7 @@ protected:
 private:
     void outputFormatChanged();
     void handleAudioInput(QByteArray& audioBuffer);
-    bool mixLocalAudioInjectors(float* mixBuffer);
+    bool mixLocalAudioInjectors(float* mixBuffer, float* sendBuffer);
     float azimuthForSource(const glm::vec3& relativePosition);
     float gainForSource(float distance, float volume);
 
@@ -295,10 +297,13 @@ private:
     QAudioOutput* _loopbackAudioOutput;
     QIODevice* _loopbackOutputDevice;
     AudioRingBuffer _inputRingBuffer;
+    // preallocated for the capture, from the device read to the encoded packet
+    std::vector<int16_t> _inputReadBuffer;
+    std::vector<int16_t> _inputScratchBuffer;
+    QByteArray _networkAudioBuffer;
+    QByteArray _encodedBuffer;
+    // lock-free pipe from the local audio thread (producer) to the device callback (consumer)
     LocalInjectorsStream _localInjectorsStream;
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples
-    std::atomic<int> _localSamplesAvailable { 0 };
     MixedProcessedAudioStream _receivedAudioStream;
     bool _isStereoInput;
 
@@ -328,8 +333,21 @@ private:
     AudioEffectOptions _zoneReverbOptions;
     AudioEffectOptions* _reverbOptions;
     AudioReverb _sourceReverb { AudioConstants::SAMPLE_RATE };
-    AudioReverb _listenerReverb { AudioConstants::SAMPLE_RATE };
-    AudioReverb _localReverb { AudioConstants::SAMPLE_RATE };
+
+    // the reverb send bus, rendered once per network frame on the local audio thread: the received audio and the
+    // local injectors each send to it at their own level, and it is mixed into the local injectors' stream
+    AudioReverb _reverbBus { AudioConstants::SAMPLE_RATE };
+    AudioMixSPSCRingBuffer _networkReverbSend; // lock-free pipe from the network audio thread to the bus
+    Mutex _reverbBusMutex;
+    ReverbParameters _reverbBusParameters; // guarded by the mutex, as set by configureReverb
+    float _reverbBusWetLevel { 0.0f };
+    std::atomic<bool> _reverbBusChanged { false };
+    std::atomic<bool> _reverbBusResetPending { false };
+    std::atomic<float> _reverbWetLevel { 0.0f }; // the current wet level of the bus, for the dry level of its sources
+    float _reverbTargetWetLevel { 0.0f };
+    bool _isReverbBusConfigured { false };
+    int _reverbTailFrames { 0 };
+    int _reverbTailLength { 0 };
 
     // possible streams needed for resample
     AudioSRC* _inputToNetworkResampler;
@@ -338,10 +356,14 @@ private:
 
     // for network audio (used by network audio thread)
     int16_t _networkScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+    float _networkSendBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
     // for local audio (used by audio injectors thread)
     int _networkPeriod { 0 };
     float _localMixBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _localSendBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _localInjectorBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float _reverbWetBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _localScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
     float* _localOutputMixBuffer { NULL };
     AudioInjectorsThread _localAudioThread;
@@ -357,8 +379,11 @@ private:
     // Adds Reverb
     void configureReverb();
     void updateReverbOptions();
+    void updateReverbBus();
+    bool isReverbBusActive() const { return _reverbTailFrames > 0 || _networkReverbSend.samplesAvailable() > 0; }
+    void mixReverbBus(float* mixBuffer, float* sendBuffer, bool hasLocalSend);
 
-    void handleLocalEchoAndReverb(QByteArray& inputByteArray);
+    void handleLocalEchoAndReverb(const int16_t* inputSamples, int numInputSamples);
 
     bool switchInputToAudioDevice(const QAudioDeviceInfo& inputDeviceInfo);
     bool switchOutputToAudioDevice(const QAudioDeviceInfo& outputDeviceInfo);
@@ -383,6 +408,7 @@ private:
 
     QVector<QString> _inputDevices;
     QVector<QString> _outputDevices;
+    bool _hasCheckedDevices { false }; // of the devices thread only
 
     bool _hasReceivedFirstPacket { false };
 
@@ -113,6 +113,7 @@ void AudioIOStats::publish() {
     // update the interface
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
     _interface->updateClientStream(stats);
+    _interface->updateLatency();
 
     // prepare a packet to the mixer
     int statsPacketSize = sizeof(appendFlag) + sizeof(numStreamStatsToPack) + sizeof(stats);
@@ -182,6 +183,12 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     sentTimegapMsAvgWindow(timegaps.getWindowAverage() / USECS_PER_MSEC);
 }
 
+void AudioStatsInterface::updateLatency() {
+    // the network is crossed twice, up to the mixer and down from it, which is the ping
+    mouthToEarMsMax(inputReadMsMax() + inputUnplayedMsMax() + pingMs() +
+        _mixer->unplayedMsMax() + _client->unplayedMsMax() + outputUnplayedMsMax());
+}
+
 void AudioStatsInterface::updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats) {
     // Get existing injectors
     auto injectorIds = _injectors->dynamicPropertyNames();
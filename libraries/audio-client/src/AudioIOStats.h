@@ -74,6 +74,9 @@ class AudioStatsInterface : public QObject {
     AUDIO_PROPERTY(float, inputUnplayedMsMax);
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
 
+    // from the microphone of a speaker to the ear of a listener, through the mixer: the sum of the buffers on the way
+    AUDIO_PROPERTY(float, mouthToEarMsMax);
+
     AUDIO_PROPERTY(quint64, sentTimegapMsMax);
     AUDIO_PROPERTY(quint64, sentTimegapMsAvg);
     AUDIO_PROPERTY(quint64, sentTimegapMsMaxWindow);
@@ -95,6 +98,7 @@ public:
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
     void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
+    void updateLatency();
 
 signals:
     void mixerStreamChanged();
@@ -1041,16 +1041,47 @@ void AudioFOA::render(int16_t* input, float* output, int index, float qw, float
     assert(index < FOA_TABLES);
     assert(numFrames == FOA_BLOCK);
 
-    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
-    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
     ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
 
     float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
-    float rotation[3][3];
 
     // convert input to deinterleaved float
     convertInput(input, in, FOA_GAIN * gain, FOA_BLOCK);
 
+    renderBFormat(in, output, index, qw, qx, qy, qz);
+}
+
+void AudioFOA::render(const float* const input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < FOA_TABLES);
+    assert(numFrames == FOA_BLOCK);
+
+    ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
+
+    float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
+
+    // apply gain, and convert W from SN3D to the internal normalization (see convertInput)
+    const float scaleW = FOA_GAIN * gain * SQRT1_2; // -3dB
+    const float scale = FOA_GAIN * gain;
+
+    for (int i = 0; i < FOA_BLOCK; i++) {
+        in[0][i] = input[0][i] * scaleW;
+        in[1][i] = input[1][i] * scale;
+        in[2][i] = input[2][i] * scale;
+        in[3][i] = input[3][i] * scale;
+    }
+
+    renderBFormat(in, output, index, qw, qx, qy, qz);
+}
+
+void AudioFOA::renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz) {
+
+    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
+    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
+
+    float rotation[3][3];
+
     // convert quaternion to 3x3 rotation
     quatToMatrix_3x3(qw, qx, qy, qz, rotation);
 
@@ -45,7 +45,16 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // input: deinterleaved First-Order Ambisonic source (W, X, Y, Z channels, SN3D normalization)
+    // otherwise, as above
+    //
+    void render(const float* const input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
+
 private:
+    // render B-format buffers (modified in place), in the internal channel order and normalization
+    void renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz);
+
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
@@ -389,6 +389,61 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     }
 }
 
+// crossfade 2x4 inputs into 2 outputs with accumulation (interleaved)
+static void crossfade_4x2x2_SSE(float* src0, float* src1, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 f0 = _mm_loadu_ps(&win[i]);
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        float* src[2] = { src0, src1 };
+        for (int j = 0; j < 2; j++) {
+
+            __m128 x0 = _mm_loadu_ps(&src[j][4*i+0]);
+            __m128 x1 = _mm_loadu_ps(&src[j][4*i+4]);
+            __m128 x2 = _mm_loadu_ps(&src[j][4*i+8]);
+            __m128 x3 = _mm_loadu_ps(&src[j][4*i+12]);
+
+            // deinterleave (4x4 matrix transpose)
+            __m128 t0 = _mm_unpacklo_ps(x0, x1);
+            __m128 t2 = _mm_unpacklo_ps(x2, x3);
+            __m128 t1 = _mm_unpackhi_ps(x0, x1);
+            __m128 t3 = _mm_unpackhi_ps(x2, x3);
+
+            x0 = _mm_movelh_ps(t0, t2);
+            x1 = _mm_movehl_ps(t2, t0);
+            x2 = _mm_movelh_ps(t1, t3);
+            x3 = _mm_movehl_ps(t3, t1);
+
+            // crossfade
+            x0 = _mm_sub_ps(x0, x2);
+            x1 = _mm_sub_ps(x1, x3);
+            x2 = _mm_add_ps(x2, _mm_mul_ps(f0, x0));
+            x3 = _mm_add_ps(x3, _mm_mul_ps(f0, x1));
+
+            // interleave and accumulate
+            y0 = _mm_add_ps(y0, _mm_unpacklo_ps(x2, x3));
+            y1 = _mm_add_ps(y1, _mm_unpackhi_ps(x2, x3));
+        }
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
+void crossfade_4x2x2_AVX2(float* src0, float* src1, float* dst, const float* win, int numFrames);
+
+static void crossfade_4x2x2(float* src0, float* src1, float* dst, const float* win, int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? crossfade_4x2x2_AVX2 : crossfade_4x2x2_SSE;
+    (*f)(src0, src1, dst, win, numFrames); // dispatch
+}
+
 // linear interpolation with gain
 static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
 
@@ -669,6 +724,20 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     }
 }
 
+// crossfade 2x4 inputs into 2 outputs with accumulation (interleaved)
+static void crossfade_4x2x2(float* src0, float* src1, float* dst, const float* win, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float frac = win[i];
+
+        dst[2*i+0] += src0[4*i+2] + frac * (src0[4*i+0] - src0[4*i+2]) +
+                      src1[4*i+2] + frac * (src1[4*i+0] - src1[4*i+2]);
+        dst[2*i+1] += src0[4*i+3] + frac * (src0[4*i+1] - src0[4*i+3]) +
+                      src1[4*i+3] + frac * (src1[4*i+1] - src1[4*i+3]);
+    }
+}
+
 // linear interpolation with gain
 static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
 
@@ -848,17 +917,12 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     bqCoef[4][channel+5] = a2;
 }
 
-void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
-
-    assert(index >= 0);
-    assert(index < HRTF_TABLES);
-    assert(numFrames == HRTF_BLOCK);
+void AudioHRTF::renderChannels(const float* input, float* bqBuffer, int index, float azimuth, float distance, float gain) {
 
     ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
     ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
     ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
     ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
-    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
     int delay[4];                                           // 4-channel (interleaved)
 
     // apply global and local gain adjustment
@@ -875,10 +939,8 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _distanceState = distance;
     _gainState = gain;
 
-    // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
+    // mono input
+    memcpy(&in[HRTF_TAPS], input, HRTF_BLOCK * sizeof(float));
 
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
@@ -929,6 +991,23 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _bqState[0][R2] = _bqState[0][R3];
     _bqState[1][R2] = _bqState[1][R3];
     _bqState[2][R2] = _bqState[2][R3];
+}
+
+void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[HRTF_BLOCK];                           // mono
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
+
+    // convert mono input to float
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        in[i] = (float)input[i] * (1/32768.0f);
+    }
+
+    renderChannels(in, bqBuffer, index, azimuth, distance, gain);
 
     // crossfade old/new output and accumulate
     crossfade_4x2(bqBuffer, output, crossfadeTable, HRTF_BLOCK);
@@ -950,3 +1029,39 @@ void AudioHRTF::renderSilent(int16_t* input, float* output, int index, float azi
 
     _silentState = true;
 }
+
+void AudioHRTF::renderBatch(Source* sources, int numSources, float* output, int index, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float bqBuffer[2][4 * HRTF_BLOCK];              // 4-channel (interleaved), for a pair of sources
+    int numPending = 0;
+
+    for (int i = 0; i < numSources; i++) {
+        Source& source = sources[i];
+        AudioHRTF& hrtf = *source.hrtf;
+
+        if (source.silent && hrtf._silentState) {
+            // already flushed, so only the parameters change (see renderSilent)
+            hrtf._azimuthState = source.azimuth;
+            hrtf._distanceState = source.distance;
+            hrtf._gainState = source.gain;
+            continue;
+        }
+
+        hrtf.renderChannels(source.input, bqBuffer[numPending], index, source.azimuth, source.distance, source.gain);
+        hrtf._silentState = source.silent;
+
+        // crossfade old/new output and accumulate, a pair at a time
+        if (++numPending == 2) {
+            crossfade_4x2x2(bqBuffer[0], bqBuffer[1], output, crossfadeTable, HRTF_BLOCK);
+            numPending = 0;
+        }
+    }
+
+    if (numPending == 1) {
+        crossfade_4x2(bqBuffer[0], output, crossfadeTable, HRTF_BLOCK);
+    }
+}
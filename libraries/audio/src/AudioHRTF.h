@@ -44,6 +44,21 @@ public:
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Batched render of many sources into the same output buffer.
+    // Sources are rendered in pairs, so each pass over the output accumulates two sources.
+    // Equivalent to calling render (or renderSilent, if silent) for each source in turn.
+    //
+    struct Source {
+        AudioHRTF* hrtf;
+        const float* input;     // mono source, in [-1.0, 1.0)
+        float azimuth;
+        float distance;
+        float gain;
+        bool silent;
+    };
+    static void renderBatch(Source* sources, int numSources, float* output, int index, int numFrames);
+
     //
     // HRTF local gain adjustment in amplitude (1.0 == unity)
     //
@@ -54,6 +69,9 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // render the old/new filters to 4-channel (interleaved) output, and update state
+    void renderChannels(const float* input, float* bqBuffer, int index, float azimuth, float distance, float gain);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
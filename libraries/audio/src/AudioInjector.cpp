@@ -24,7 +24,6 @@
 #include "AudioRingBuffer.h"
 #include "AudioLogging.h"
 #include "SoundCache.h"
-#include "AudioSRC.h"
 #include "AudioHelpers.h"
 
 int audioInjectorPtrMetaTypeId = qRegisterMetaType<AudioInjector*>();
@@ -222,8 +221,8 @@ int64_t AudioInjector::injectNextFrame() {
             _currentSendOffset = 0;
         }
 
-        // make sure we actually have samples downloaded to inject
-        if (_audioData.size()) {
+        // make sure we actually have samples downloaded to inject, or injectors to mix
+        if (_audioData.size() || _isMix) {
 
             int sampleSize = (_options.stereo ? 2 : 1) * sizeof(AudioConstants::AudioSample);
             auto numSamples = static_cast<int>(_audioData.size() / sampleSize);
@@ -305,19 +304,17 @@ int64_t AudioInjector::injectNextFrame() {
         _frameTimer->restart();
     }
 
-    int totalBytesLeftToCopy = (_options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
-    if (!_options.loop) {
-        // If we aren't looping, let's make sure we don't read past the end
-        totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
-    }
-
-    //  Measure the loudness of this frame
-    _loudness = 0.0f;
-    for (int i = 0; i < totalBytesLeftToCopy; i += sizeof(int16_t)) {
-        _loudness += abs(*reinterpret_cast<int16_t*>(_audioData.data() + ((_currentSendOffset + i) % _audioData.size()))) /
-            (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+    // the samples of the frame, of the sound or of the injectors mixed in
+    QByteArray decodedAudio;
+    if (_isMix) {
+        if (!mixNextFrame(decodedAudio)) {
+            // the injectors mixed in have all finished
+            finishNetworkInjection();
+            return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+        }
+    } else {
+        readNextFrame(decodedAudio);
     }
-    _loudness /= (float)(totalBytesLeftToCopy/ sizeof(int16_t));
 
     _currentPacket->seek(0);
 
@@ -337,19 +334,6 @@ int64_t AudioInjector::injectNextFrame() {
 
     _currentPacket->seek(audioDataOffset);
 
-    // This code is copying bytes from the _audioData directly into the packet, handling looping appropriately.
-    // Might be a reasonable place to do the encode step here.
-    QByteArray decodedAudio;
-    while (totalBytesLeftToCopy > 0) {
-        int bytesToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
-
-        decodedAudio.append(_audioData.data() + _currentSendOffset, bytesToCopy);
-        _currentSendOffset += bytesToCopy;
-        totalBytesLeftToCopy -= bytesToCopy;
-        if (_options.loop && _currentSendOffset >= _audioData.size()) {
-            _currentSendOffset = 0;
-        }
-    }
     // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
     // codec to use... possible through AbstractAudioInterface.
     QByteArray encodedAudio = decodedAudio;
@@ -368,7 +352,7 @@ int64_t AudioInjector::injectNextFrame() {
         _outgoingSequenceNumber++;
     }
 
-    if (_currentSendOffset >= _audioData.size() && !_options.loop) {
+    if (_isMix ? _mixedInjectors.empty() : hasSentAllFrames()) {
         finishNetworkInjection();
         return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
     }
@@ -388,7 +372,10 @@ int64_t AudioInjector::injectNextFrame() {
         // If we are falling behind by more frames than our threshold, let's skip the frames ahead
         qCDebug(audio)  << this << "injectNextFrame() skipping ahead, fell behind by " << (currentFrameBasedOnElapsedTime - _nextFrame) << " frames";
         _nextFrame = currentFrameBasedOnElapsedTime;
-        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (_options.stereo ? 2 : 1) % _audioData.size();
+        // the injectors mixed in just carry on from where they were
+        if (!_isMix) {
+            _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (_options.stereo ? 2 : 1) % _audioData.size();
+        }
     }
 
     int64_t playNextFrameAt = ++_nextFrame * AudioConstants::NETWORK_FRAME_USECS;
@@ -396,6 +383,108 @@ int64_t AudioInjector::injectNextFrame() {
     return std::max(INT64_C(0), playNextFrameAt - currentTime);
 }
 
+void AudioInjector::readNextFrame(QByteArray& frame) {
+    int totalBytesLeftToCopy = (_options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+    if (!_options.loop) {
+        // If we aren't looping, let's make sure we don't read past the end
+        totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
+    }
+
+    //  Measure the loudness of this frame
+    _loudness = 0.0f;
+    for (int i = 0; i < totalBytesLeftToCopy; i += sizeof(int16_t)) {
+        _loudness += abs(*reinterpret_cast<int16_t*>(_audioData.data() + ((_currentSendOffset + i) % _audioData.size()))) /
+            (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+    }
+    _loudness /= (float)(totalBytesLeftToCopy/ sizeof(int16_t));
+
+    // This code is copying bytes from the _audioData directly into the frame, handling looping appropriately.
+    while (totalBytesLeftToCopy > 0) {
+        int bytesToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
+
+        frame.append(_audioData.data() + _currentSendOffset, bytesToCopy);
+        _currentSendOffset += bytesToCopy;
+        totalBytesLeftToCopy -= bytesToCopy;
+        if (_options.loop && _currentSendOffset >= _audioData.size()) {
+            _currentSendOffset = 0;
+        }
+    }
+}
+
+AudioInjector* AudioInjector::createMix(const AudioInjectorOptions& options) {
+    AudioInjectorOptions mixOptions;
+    mixOptions.position = options.position;
+    mixOptions.orientation = options.orientation;
+    mixOptions.stereo = options.stereo;
+    mixOptions.ignorePenumbra = options.ignorePenumbra;
+
+    AudioInjector* mix = new AudioInjector(QByteArray(), mixOptions);
+    mix->_isMix = true;
+
+    // a mix is never played locally, and is deleted once the last injector mixed in has been sent
+    mix->_state |= AudioInjectorState::LocalInjectionFinished;
+    mix->_state |= AudioInjectorState::PendingDelete;
+    return mix;
+}
+
+bool AudioInjector::canMix(const AudioInjector* injector) const {
+    // sources this close are heard in the same place, so their sum spatializes as they each would
+    const float MAX_MIX_DISTANCE = 0.25f; // meters
+    return injector->_options.stereo == _options.stereo &&
+        injector->_options.ignorePenumbra == _options.ignorePenumbra &&
+        glm::length(injector->_options.position - _options.position) < MAX_MIX_DISTANCE;
+}
+
+bool AudioInjector::mixNextFrame(QByteArray& frame) {
+    int numFrameSamples = (_options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    _mixBuffer.assign(numFrameSamples, 0.0f);
+
+    bool hasMixed = false;
+    for (auto it = _mixedInjectors.begin(); it != _mixedInjectors.end(); ) {
+        AudioInjector* injector = it->data();
+        if (!injector || injector->isFinished()) {
+            it = _mixedInjectors.erase(it);
+            continue;
+        }
+        if (!canMix(injector)) {
+            // it moved away, and is sent on its own from now on
+            _unmixedInjectors.push_back(*it);
+            it = _mixedInjectors.erase(it);
+            continue;
+        }
+
+        // the volume of each injector is applied here, the stream of the mix is sent at full volume
+        _mixedFrame.resize(0);
+        injector->readNextFrame(_mixedFrame);
+        const int16_t* samples = reinterpret_cast<const int16_t*>(_mixedFrame.constData());
+        int numSamples = std::min((int)(_mixedFrame.size() / sizeof(int16_t)), numFrameSamples);
+        float gain = injector->getVolume();
+        for (int i = 0; i < numSamples; i++) {
+            _mixBuffer[i] += samples[i] * gain;
+        }
+        hasMixed = true;
+
+        if (injector->hasSentAllFrames()) {
+            injector->finishNetworkInjection();
+            it = _mixedInjectors.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!hasMixed) {
+        return false;
+    }
+
+    frame.resize(numFrameSamples * sizeof(int16_t));
+    int16_t* mixedSamples = reinterpret_cast<int16_t*>(frame.data());
+    for (int i = 0; i < numFrameSamples; i++) {
+        mixedSamples[i] = (int16_t)glm::clamp(_mixBuffer[i], (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                              (float)AudioConstants::MAX_SAMPLE_VALUE);
+    }
+    return true;
+}
+
 void AudioInjector::stop() {
     // trigger a call on the injector's thread to change state to finished
     QMetaObject::invokeMethod(this, "finish");
@@ -430,27 +519,8 @@ AudioInjector* AudioInjector::playSound(SharedSoundPointer sound, const float vo
     options.position = position;
     options.volume = volume;
 
-    QByteArray samples = sound->getByteArray();
-    if (stretchFactor == 1.0f) {
-        return playSoundAndDelete(samples, options);
-    }
-
-    const int standardRate = AudioConstants::SAMPLE_RATE;
-    const int resampledRate = standardRate * stretchFactor;
-    const int channelCount = sound->isStereo() ? 2 : 1;
-
-    AudioSRC resampler(standardRate, resampledRate, channelCount);
-
-    const int nInputFrames = samples.size() / (channelCount * sizeof(int16_t));
-    const int maxOutputFrames = resampler.getMaxOutput(nInputFrames);
-    QByteArray resampled(maxOutputFrames * channelCount * sizeof(int16_t), '\0');
-
-    int nOutputFrames = resampler.render(reinterpret_cast<const int16_t*>(samples.data()),
-                                         reinterpret_cast<int16_t*>(resampled.data()),
-                                         nInputFrames);
-
-    Q_UNUSED(nOutputFrames);
-    return playSoundAndDelete(resampled, options);
+    // the resampled samples are kept by the sound, for the next time it is played with this stretch
+    return playSoundAndDelete(sound->getStretchedByteArray(stretchFactor), options);
 }
 
 AudioInjector* AudioInjector::playSoundAndDelete(const QByteArray& buffer, const AudioInjectorOptions options) {
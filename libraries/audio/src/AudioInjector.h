@@ -13,9 +13,11 @@
 #define hifi_AudioInjector_h
 
 #include <memory>
+#include <vector>
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
 
@@ -68,6 +70,7 @@ public:
     glm::quat getOrientation() const { return _options.orientation; }
     bool isStereo() const { return _options.stereo; }
     bool isAmbisonic() const { return _options.ambisonic; }
+    float getReverbSend() const { return _options.reverbSend; }
 
     bool stateHas(AudioInjectorState state) const ;
     static void setLocalAudioInterface(AbstractAudioInterface* audioInterface) { _localAudioInterface = audioInterface; }
@@ -96,9 +99,22 @@ signals:
     void restarting();
     
 private:
+    using InjectorQPointer = QPointer<AudioInjector>;
+
     int64_t injectNextFrame();
     bool inject(bool(AudioInjectorManager::*injection)(AudioInjector*));
     bool injectLocally();
+
+    // appends the next network frame of the sound, and measures its loudness
+    void readNextFrame(QByteArray& frame);
+    bool hasSentAllFrames() const { return _currentSendOffset >= _audioData.size() && !_options.loop; }
+
+    // a mix is an injector without a sound of its own, sending the sum of the injectors mixed into it as one stream
+    static AudioInjector* createMix(const AudioInjectorOptions& options);
+    bool isMix() const { return _isMix; }
+    bool canMix(const AudioInjector* injector) const;
+    void addMixedInjector(AudioInjector* injector) { _mixedInjectors.push_back(injector); }
+    bool mixNextFrame(QByteArray& frame);
     
     static AbstractAudioInterface* _localAudioInterface;
 
@@ -115,6 +131,12 @@ private:
     std::unique_ptr<QElapsedTimer> _frameTimer { nullptr };
     quint16 _outgoingSequenceNumber { 0 };
     
+    bool _isMix { false };
+    std::vector<InjectorQPointer> _mixedInjectors;
+    std::vector<InjectorQPointer> _unmixedInjectors; // moved away from the mix, to be sent on their own again
+    std::vector<float> _mixBuffer;
+    QByteArray _mixedFrame;
+
     // when the injector is local, we need this
     AudioHRTF _localHRTF;
     AudioFOA _localFOA;
@@ -11,6 +11,8 @@
 
 #include "AudioInjectorManager.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 
 #include <SharedUtil.h>
@@ -34,6 +36,18 @@ AudioInjectorManager::~AudioInjectorManager() {
         
         _injectors.pop();
     }
+
+    // and the injectors mixed into the mixes
+    for (auto& mix : _mixes) {
+        if (mix) {
+            for (auto& injector : mix->_mixedInjectors) {
+                if (injector) {
+                    injector->stopAndDeleteLater();
+                }
+            }
+        }
+    }
+    _mixes.clear();
     
     // get rid of the lock now that we've stopped all living injectors
     lock.unlock();
@@ -99,6 +113,14 @@ void AudioInjectorManager::run() {
                             // enqueue the injector with the correct timing in our holding queue
                             heldInjectors.emplace(heldInjectors.end(), usecTimestampNow() + nextCallDelta, injector);
                         }
+
+                        // the injectors that moved away from a mix are sent on their own, starting now
+                        if (injector && injector->isMix()) {
+                            for (auto& unmixedInjector : injector->_unmixedInjectors) {
+                                heldInjectors.emplace(heldInjectors.end(), usecTimestampNow(), unmixedInjector);
+                            }
+                            injector->_unmixedInjectors.clear();
+                        }
                     }
                     
                     if (_injectors.size() > 0) {
@@ -129,6 +151,7 @@ void AudioInjectorManager::run() {
 }
 
 static const int MAX_INJECTORS_PER_THREAD = 40; // calculated based on AudioInjector time to send frame, with sufficient padding
+static const size_t MAX_INJECTORS_PER_MIX = 16;
 
 bool AudioInjectorManager::wouldExceedLimits() { // Should be called inside of a lock.
     if (_injectors.size() >= MAX_INJECTORS_PER_THREAD) {
@@ -157,14 +180,8 @@ bool AudioInjectorManager::threadInjector(AudioInjector* injector) {
         
         // move the injector to the QThread
         injector->moveToThread(_thread);
-        
-        // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), InjectorQPointer { injector });
-        
-        // notify our wait condition so we can inject two frames for this injector immediately
-        _injectorReady.notify_one();
-        
-        return true;
+
+        return queueInjector(injector);
     }
 }
 
@@ -177,14 +194,46 @@ bool AudioInjectorManager::restartFinishedInjector(AudioInjector* injector) {
     // guard the injectors vector with a mutex
     Lock lock(_injectorsMutex);
 
+    return queueInjector(injector);
+}
+
+bool AudioInjectorManager::queueInjector(AudioInjector* injector) {
+    if (_premixInjectors && !injector->isAmbisonic() && injector->_audioData.size() > 0) {
+        _mixes.erase(std::remove_if(_mixes.begin(), _mixes.end(), [](const InjectorQPointer& mix) {
+            return mix.isNull() || mix->isFinished();
+        }), _mixes.end());
+
+        // join a mix at the same place, if there is one with room
+        for (auto& mix : _mixes) {
+            if (mix->canMix(injector) && mix->_mixedInjectors.size() < MAX_INJECTORS_PER_MIX) {
+                mix->addMixedInjector(injector);
+                return true;
+            }
+        }
+
+        if (wouldExceedLimits()) {
+            return false;
+        }
+
+        AudioInjector* mix = AudioInjector::createMix(injector->getOptions());
+        mix->moveToThread(_thread);
+        mix->addMixedInjector(injector);
+        _mixes.emplace_back(mix);
+
+        // the mix is sent from now on, starting with the first frame of the injector
+        _injectors.emplace(usecTimestampNow(), InjectorQPointer { mix });
+        _injectorReady.notify_one();
+        return true;
+    }
+
     if (wouldExceedLimits()) {
         return false;
-    } else {
-        // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), InjectorQPointer { injector });
-        
-        // notify our wait condition so we can inject two frames for this injector immediately
-        _injectorReady.notify_one();
     }
+
+    // add the injector to the queue with a send timestamp of now
+    _injectors.emplace(usecTimestampNow(), InjectorQPointer { injector });
+
+    // notify our wait condition so we can inject two frames for this injector immediately
+    _injectorReady.notify_one();
     return true;
 }
@@ -17,6 +17,7 @@
 #include <condition_variable>
 #include <queue>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QPointer>
 #include <QtCore/QThread>
@@ -30,6 +31,11 @@ class AudioInjectorManager : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 public:
     ~AudioInjectorManager();
+
+    // premix the network injectors playing at the same place into one stream each, for the many sounds of scripts
+    // on a server, rather than sending a stream for every injector
+    void setPremixInjectors(bool premixInjectors) { _premixInjectors = premixInjectors; }
+
 private slots:
     void run();
 private:
@@ -51,6 +57,7 @@ private:
     
     bool threadInjector(AudioInjector* injector);
     bool restartFinishedInjector(AudioInjector* injector);
+    bool queueInjector(AudioInjector* injector); // should be called inside of a lock
     void notifyInjectorReadyCondition() { _injectorReady.notify_one(); }
     bool wouldExceedLimits();
     
@@ -63,6 +70,8 @@ private:
     QThread* _thread { nullptr };
     bool _shouldStop { false };
     InjectorQueue _injectors;
+    std::vector<InjectorQPointer> _mixes;
+    bool _premixInjectors { false };
     Mutex _injectorsMutex;
     std::condition_variable _injectorReady;
     
@@ -26,7 +26,8 @@ AudioInjectorOptions::AudioInjectorOptions() :
     ambisonic(false),
     ignorePenumbra(false),
     localOnly(false),
-    secondOffset(0.0f)
+    secondOffset(0.0f),
+    reverbSend(1.0f)
 {
 
 }
@@ -40,6 +41,7 @@ QScriptValue injectorOptionsToScriptValue(QScriptEngine* engine, const AudioInje
     obj.setProperty("ignorePenumbra", injectorOptions.ignorePenumbra);
     obj.setProperty("localOnly", injectorOptions.localOnly);
     obj.setProperty("secondOffset", injectorOptions.secondOffset);
+    obj.setProperty("reverbSend", injectorOptions.reverbSend);
     return obj;
 }
 
@@ -87,6 +89,12 @@ void injectorOptionsFromScriptValue(const QScriptValue& object, AudioInjectorOpt
             } else {
                 qCWarning(audio) << "Audio injector options: secondOffset is not a number";
             }
+        } else if (it.name() == "reverbSend") {
+            if (it.value().isNumber()) {
+                injectorOptions.reverbSend = glm::clamp((float)it.value().toNumber(), 0.0f, 1.0f);
+            } else {
+                qCWarning(audio) << "Audio injector options: reverbSend is not a number";
+            }
         } else {
             qCWarning(audio) << "Unknown audio injector option:" << it.name();
         }
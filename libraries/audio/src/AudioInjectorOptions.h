@@ -29,6 +29,7 @@ public:
     bool ignorePenumbra;
     bool localOnly;
     float secondOffset;
+    float reverbSend; // the level sent to the local reverb, [0, 1]
 };
 
 Q_DECLARE_METATYPE(AudioInjectorOptions);
@@ -1781,9 +1781,41 @@ AudioReverb::~AudioReverb() {
 
 void AudioReverb::setParameters(ReverbParameters *p) {
     _params = *p;
+    _glideFrames = 0;
     _impl->setParameters(p);
 };
 
+void AudioReverb::glideParameters(ReverbParameters *p, int numFrames) {
+    if (numFrames <= 0 || p->sampleRate != _params.sampleRate) {
+        setParameters(p);
+        return;
+    }
+    _targetParams = *p;
+    _glideFrames = numFrames;
+}
+
+// step the parameters toward the target, once per block
+void AudioReverb::updateGlide(int numFrames) {
+    if (_glideFrames <= 0) {
+        return;
+    }
+    float alpha = MIN((float)numFrames / _glideFrames, 1.0f);
+
+    // all parameters are floats, so step them as an array
+    const int NUM_PARAMETERS = sizeof(ReverbParameters) / sizeof(float);
+    float* current = (float*)&_params;
+    const float* target = (const float*)&_targetParams;
+    for (int i = 0; i < NUM_PARAMETERS; i++) {
+        current[i] += (target[i] - current[i]) * alpha;
+    }
+
+    _glideFrames -= numFrames;
+    if (_glideFrames <= 0) {
+        _params = _targetParams;
+    }
+    _impl->setParameters(&_params);
+}
+
 void AudioReverb::getParameters(ReverbParameters *p) {
     *p = _params;
 };
@@ -1793,6 +1825,7 @@ void AudioReverb::reset() {
 }
 
 void AudioReverb::render(float** inputs, float** outputs, int numFrames) {
+    updateGlide(numFrames);
     _impl->process(inputs, outputs, numFrames);
 }
 
@@ -2013,6 +2046,8 @@ void AudioReverb::render(const int16_t* input, int16_t* output, int numFrames) {
 
         int n = MIN(numFrames, REVERB_BLOCK);
 
+        updateGlide(n);
+
         convertInput(input, _inout, n);
 
         _impl->process(_inout, _inout, n);
@@ -2034,6 +2069,8 @@ void AudioReverb::render(const float* input, float* output, int numFrames) {
 
         int n = MIN(numFrames, REVERB_BLOCK);
 
+        updateGlide(n);
+
         convertInput(input, _inout, n);
 
         _impl->process(_inout, _inout, n);
@@ -58,6 +58,10 @@ public:
     void getParameters(ReverbParameters *p);
     void reset();
 
+    // move from the current parameters to p over the next numFrames rendered, rather than at once,
+    // so that a change of room does not click or restart the tail
+    void glideParameters(ReverbParameters *p, int numFrames);
+
     // deinterleaved float input/output (native format)
     void render(float** inputs, float** outputs, int numFrames);
 
@@ -71,8 +75,13 @@ private:
     ReverbImpl *_impl;
     ReverbParameters _params;
 
+    ReverbParameters _targetParams;
+    int _glideFrames = 0;
+
     float* _inout[2];
 
+    void updateGlide(int numFrames);
+
     void convertInput(const int16_t* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, int16_t* output, int numFrames);
 
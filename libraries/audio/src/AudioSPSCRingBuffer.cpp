@@ -0,0 +1,153 @@
+//
+//  AudioSPSCRingBuffer.cpp
+//  libraries/audio/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <assert.h>
+#include <algorithm>
+#include <cstring>
+
+#include "AudioSPSCRingBuffer.h"
+
+template <class T>
+AudioSPSCRingBufferTemplate<T>::AudioSPSCRingBufferTemplate(int sampleCapacity) {
+    resize(sampleCapacity);
+}
+
+template <class T>
+AudioSPSCRingBufferTemplate<T>::~AudioSPSCRingBufferTemplate() {
+    delete[] _buffer;
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::clear() {
+    _writeIndex.store(0, std::memory_order_release);
+    _readIndex.store(0, std::memory_order_release);
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::resize(int sampleCapacity) {
+    assert(sampleCapacity >= 0);
+    delete[] _buffer;
+    _buffer = nullptr;
+    _sampleCapacity = sampleCapacity;
+    _mask = 0;
+
+    if (sampleCapacity > 0) {
+        // a power of two length lets the indices wrap with a mask
+        Index bufferLength = 1;
+        while (bufferLength < (Index)sampleCapacity) {
+            bufferLength <<= 1;
+        }
+        _mask = bufferLength - 1;
+
+        _buffer = new Sample[bufferLength];
+        memset(_buffer, 0, bufferLength * SampleSize);
+    }
+
+    clear();
+}
+
+template <class T>
+void AudioSPSCRingBufferTemplate<T>::runsAt(Index index, int numSamples, int& firstRun, int& secondRun) const {
+    int position = (int)(index & _mask);
+    int samplesToEnd = (int)(_mask + 1) - position;
+    firstRun = std::min(numSamples, samplesToEnd);
+    secondRun = numSamples - firstRun;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::writeSamples(const Sample* source, int maxSamples) {
+    int numSamples = std::min(maxSamples, samplesFree());
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    Index writeIndex = _writeIndex.load(std::memory_order_relaxed);
+    int firstRun, secondRun;
+    runsAt(writeIndex, numSamples, firstRun, secondRun);
+    memcpy(_buffer + (writeIndex & _mask), source, firstRun * SampleSize);
+    memcpy(_buffer, source + firstRun, secondRun * SampleSize);
+
+    // publish the samples to the consumer
+    _writeIndex.store(writeIndex + numSamples, std::memory_order_release);
+    return numSamples;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::addSilentSamples(int maxSamples) {
+    int numSamples = std::min(maxSamples, samplesFree());
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    Index writeIndex = _writeIndex.load(std::memory_order_relaxed);
+    int firstRun, secondRun;
+    runsAt(writeIndex, numSamples, firstRun, secondRun);
+    memset(_buffer + (writeIndex & _mask), 0, firstRun * SampleSize);
+    memset(_buffer, 0, secondRun * SampleSize);
+
+    _writeIndex.store(writeIndex + numSamples, std::memory_order_release);
+    return numSamples;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::readSamples(Sample* destination, int maxSamples) {
+    int numSamples = std::min(maxSamples, samplesAvailable());
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    Index readIndex = _readIndex.load(std::memory_order_relaxed);
+    int firstRun, secondRun;
+    runsAt(readIndex, numSamples, firstRun, secondRun);
+    memcpy(destination, _buffer + (readIndex & _mask), firstRun * SampleSize);
+    memcpy(destination + firstRun, _buffer, secondRun * SampleSize);
+
+    // release the space to the producer
+    _readIndex.store(readIndex + numSamples, std::memory_order_release);
+    return numSamples;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::appendSamples(Sample* destination, int maxSamples) {
+    int numSamples = std::min(maxSamples, samplesAvailable());
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    Index readIndex = _readIndex.load(std::memory_order_relaxed);
+    int firstRun, secondRun;
+    runsAt(readIndex, numSamples, firstRun, secondRun);
+    const Sample* first = _buffer + (readIndex & _mask);
+    for (int i = 0; i < firstRun; i++) {
+        destination[i] += first[i];
+    }
+    for (int i = 0; i < secondRun; i++) {
+        destination[firstRun + i] += _buffer[i];
+    }
+
+    _readIndex.store(readIndex + numSamples, std::memory_order_release);
+    return numSamples;
+}
+
+template <class T>
+int AudioSPSCRingBufferTemplate<T>::skipSamples(int maxSamples) {
+    int numSamples = std::min(maxSamples, samplesAvailable());
+    if (numSamples <= 0) {
+        return 0;
+    }
+
+    _readIndex.fetch_add(numSamples, std::memory_order_release);
+    return numSamples;
+}
+
+// explicit instantiations for network/mix buffers
+template class AudioSPSCRingBufferTemplate<int16_t>;
+template class AudioSPSCRingBufferTemplate<float>;
@@ -0,0 +1,101 @@
+//
+//  AudioSPSCRingBuffer.h
+//  libraries/audio/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSPSCRingBuffer_h
+#define hifi_AudioSPSCRingBuffer_h
+
+#include <atomic>
+#include <cstdint>
+
+// Single-producer/single-consumer lock-free ring buffer of samples
+//   One thread may write (writeSamples, addSilentSamples) while another reads (readSamples, appendSamples, skipSamples).
+//   Unlike AudioRingBuffer, a write never overwrites unread samples: it is truncated to the free space instead.
+//   Each side only stores to its own index, and the indices live on separate cache lines.
+template <class T>
+class AudioSPSCRingBufferTemplate {
+    using Sample = T;
+    static const int SampleSize = sizeof(Sample);
+
+public:
+    AudioSPSCRingBufferTemplate(int sampleCapacity);
+    ~AudioSPSCRingBufferTemplate();
+
+    // disallow copying
+    AudioSPSCRingBufferTemplate(const AudioSPSCRingBufferTemplate&) = delete;
+    AudioSPSCRingBufferTemplate(AudioSPSCRingBufferTemplate&&) = delete;
+    AudioSPSCRingBufferTemplate& operator=(const AudioSPSCRingBufferTemplate&) = delete;
+
+    // IMPORTANT: clear and resize are not lock-free; neither side may be running during either call
+
+    /// Invalidate any data in the buffer
+    void clear();
+
+    /// Resize the buffer to hold sampleCapacity samples (discards any data in the buffer)
+    void resize(int sampleCapacity);
+
+    // producer
+
+    /// Write up to maxSamples from source (will only write up to samplesFree())
+    /// Returns number of written samples
+    int writeSamples(const Sample* source, int maxSamples);
+
+    /// Write up to maxSamples silent samples (will only write up to samplesFree())
+    /// Returns number of written silent samples
+    int addSilentSamples(int maxSamples);
+
+    int samplesFree() const { return _sampleCapacity - samplesAvailable(); }
+
+    // consumer
+
+    /// Read up to maxSamples into destination (will only read up to samplesAvailable())
+    /// Returns number of read samples
+    int readSamples(Sample* destination, int maxSamples);
+
+    /// Add up to maxSamples into destination (will only read up to samplesAvailable())
+    /// Returns number of appended samples
+    int appendSamples(Sample* destination, int maxSamples);
+
+    /// Skip up to maxSamples (will only skip up to samplesAvailable())
+    /// Returns number of skipped samples
+    int skipSamples(int maxSamples);
+
+    // either side
+
+    int samplesAvailable() const {
+        // indices increase monotonically, so their (wrapping) difference is the fill level
+        return (int)(_writeIndex.load(std::memory_order_acquire) - _readIndex.load(std::memory_order_acquire));
+    }
+
+    int getSampleCapacity() const { return _sampleCapacity; }
+
+private:
+    using Index = uint32_t;
+    static const int CACHE_LINE_SIZE = 64;
+
+    // returns the contiguous runs of samples at index, with the second run wrapping to the start of the buffer
+    void runsAt(Index index, int numSamples, int& firstRun, int& secondRun) const;
+
+    Sample* _buffer { nullptr };
+    int _sampleCapacity { 0 };
+    Index _mask { 0 }; // _buffer length is a power of two, at least _sampleCapacity
+
+    char _padding0[CACHE_LINE_SIZE];
+    std::atomic<Index> _writeIndex { 0 }; // stored by the producer only
+    char _padding1[CACHE_LINE_SIZE - sizeof(std::atomic<Index>)];
+    std::atomic<Index> _readIndex { 0 }; // stored by the consumer only
+    char _padding2[CACHE_LINE_SIZE - sizeof(std::atomic<Index>)];
+};
+
+// expose explicit instantiations for network/mix buffers
+using AudioSPSCRingBuffer = AudioSPSCRingBufferTemplate<int16_t>;
+using AudioMixSPSCRingBuffer = AudioSPSCRingBufferTemplate<float>;
+
+#endif // hifi_AudioSPSCRingBuffer_h
@@ -141,7 +141,17 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
             int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            lostAudioData(packetsDropped);
+
+            // the last lost frame may be recovered from the redundancy this packet carries
+            if (message.getType() != PacketType::SilentAudioFrame && codecInPacket == _selectedCodecName) {
+                int audioPosition = message.getPosition();
+                _recoveryPacket = message.readWithoutCopy(message.getBytesLeftToRead());
+                lostAudioData(packetsDropped);
+                _recoveryPacket.clear();
+                message.seek(audioPosition);
+            } else {
+                lostAudioData(packetsDropped);
+            }
 
             // fall through to OnTime case
         }
@@ -224,7 +234,7 @@ int InboundAudioStream::lostAudioData(int numPackets) {
 
     while (numPackets--) {
         if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
+            decodeLostFrame(decodedBuffer, numPackets == 0);
         } else {
             decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
             memset(decodedBuffer.data(), 0, decodedBuffer.size());
@@ -234,6 +244,14 @@ int InboundAudioStream::lostAudioData(int numPackets) {
     return 0;
 }
 
+void InboundAudioStream::decodeLostFrame(QByteArray& decodedBuffer, bool isLastLostFrame) {
+    if (isLastLostFrame && !_recoveryPacket.isEmpty()) {
+        _decoder->recoverLostFrame(_recoveryPacket, decodedBuffer);
+    } else {
+        _decoder->lostFrame(decodedBuffer);
+    }
+}
+
 int InboundAudioStream::parseAudioData(PacketType type, const QByteArray& packetAfterStreamProperties) {
     QByteArray decodedBuffer;
     if (_decoder) {
@@ -135,6 +135,9 @@ protected:
     /// produces audio data for lost network packets.
     virtual int lostAudioData(int numPackets);
 
+    /// decodes a lost frame, the last one lost from the redundancy of the packet that came after it when there is one
+    void decodeLostFrame(QByteArray& decodedBuffer, bool isLastLostFrame);
+
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
     
@@ -186,6 +189,9 @@ protected:
     CodecPluginPointer _codec;
     QString _selectedCodecName;
     Decoder* _decoder { nullptr };
+
+    // the audio of the packet that ended a loss, while the frames lost before it are decoded
+    QByteArray _recoveryPacket;
 };
 
 float calculateRepeatedFrameFadeFactor(int indexOfRepeat);
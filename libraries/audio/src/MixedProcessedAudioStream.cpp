@@ -37,7 +37,7 @@ int MixedProcessedAudioStream::lostAudioData(int numPackets) {
 
     while (numPackets--) {
         if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
+            decodeLostFrame(decodedBuffer, numPackets == 0);
         } else {
             decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
             memset(decodedBuffer.data(), 0, decodedBuffer.size());
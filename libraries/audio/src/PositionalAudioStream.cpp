@@ -72,6 +72,23 @@ void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
     }
 }
 
+void PositionalAudioStream::decodeLastPopOutput() {
+    if (_lastPopOutput.isNull()) {
+        return;
+    }
+
+    const float SAMPLE_SCALE = 1.0f / 32768.0f;
+    int numSamples = _isStereo ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    AudioConstants::AudioSample samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    AudioRingBuffer::ConstIterator lastPopOutput = _lastPopOutput;
+    lastPopOutput.readSamples(samples, numSamples);
+
+    for (int i = 0; i < numSamples; ++i) {
+        _lastPopOutputSamples[i] = (float)samples[i] * SAMPLE_SCALE;
+    }
+}
+
 int PositionalAudioStream::parsePositionalData(const QByteArray& positionalByteArray) {
     QDataStream packetStream(positionalByteArray);
 
@@ -37,6 +37,12 @@ public:
     virtual AudioStreamStats getAudioStreamStats() const override;
 
     void updateLastPopOutputLoudnessAndTrailingLoudness();
+
+    // decode the last popped frame to float, so that it can be shared by every mix of this stream
+    void decodeLastPopOutput();
+    // the last decoded frame, in [-1.0, 1.0) (interleaved if stereo)
+    const float* getLastPopOutputSamples() const { return _lastPopOutputSamples; }
+
     float getLastPopOutputTrailingLoudness() const { return _lastPopOutputTrailingLoudness; }
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
     float getQuietestFrameLoudness() const { return _quietestFrameLoudness; }
@@ -75,6 +81,8 @@ protected:
     float _quietestTrailingFrameLoudness;
     float _quietestFrameLoudness;
     int _frameCounter;
+
+    alignas(16) float _lastPopOutputSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] {};
 };
 
 #endif // hifi_PositionalAudioStream_h
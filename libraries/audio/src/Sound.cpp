@@ -87,6 +87,44 @@ void Sound::downloadFinished(const QByteArray& data) {
     emit ready();
 }
 
+QByteArray Sound::getStretchedByteArray(float stretchFactor) {
+    // a percent of stretch is below what is heard, and keeps the number of versions small
+    int stretchPercent = (int)(stretchFactor * 100.0f + 0.5f);
+    if (stretchPercent == 100 || stretchPercent <= 0 || !_isReady) {
+        return _byteArray;
+    }
+
+    const int MAX_STRETCHED_VERSIONS = 16;
+    {
+        std::lock_guard<std::mutex> lock(_stretchedMutex);
+        auto it = _stretchedByteArrays.find(stretchPercent);
+        if (it != _stretchedByteArrays.end()) {
+            return it.value();
+        }
+    }
+
+    const int standardRate = AudioConstants::SAMPLE_RATE;
+    const int resampledRate = standardRate * stretchPercent / 100;
+    const int channelCount = _isAmbisonic ? AudioConstants::AMBISONIC : (_isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
+
+    AudioSRC resampler(standardRate, resampledRate, channelCount);
+
+    const int numInputFrames = _byteArray.size() / (channelCount * sizeof(AudioConstants::AudioSample));
+    const int maxOutputFrames = resampler.getMaxOutput(numInputFrames);
+    QByteArray resampled(maxOutputFrames * channelCount * sizeof(AudioConstants::AudioSample), '\0');
+
+    int numOutputFrames = resampler.render(reinterpret_cast<const int16_t*>(_byteArray.data()),
+                                           reinterpret_cast<int16_t*>(resampled.data()),
+                                           numInputFrames);
+    resampled.resize(numOutputFrames * channelCount * sizeof(AudioConstants::AudioSample));
+
+    std::lock_guard<std::mutex> lock(_stretchedMutex);
+    if (_stretchedByteArrays.size() < MAX_STRETCHED_VERSIONS) {
+        _stretchedByteArrays.insert(stretchPercent, resampled);
+    }
+    return resampled;
+}
+
 void Sound::downSample(const QByteArray& rawAudioByteArray, int sampleRate) {
 
     // we want to convert it to the format that the audio-mixer wants
@@ -12,6 +12,9 @@
 #ifndef hifi_Sound_h
 #define hifi_Sound_h
 
+#include <mutex>
+
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtNetwork/QNetworkReply>
 #include <QtScript/qscriptengine.h>
@@ -32,6 +35,10 @@ public:
  
     const QByteArray& getByteArray() const { return _byteArray; }
 
+    // the samples played faster or slower by stretchFactor, resampled once for each factor and kept with the sound,
+    // so that sounds played again and again at a few pitches (as collisions are) are ready to send
+    QByteArray getStretchedByteArray(float stretchFactor);
+
 signals:
     void ready();
     
@@ -41,6 +48,9 @@ private:
     bool _isAmbisonic;
     bool _isReady;
     float _duration; // In seconds
+
+    std::mutex _stretchedMutex;
+    QHash<int, QByteArray> _stretchedByteArrays; // by stretch factor in percent
     
     void downSample(const QByteArray& rawAudioByteArray, int sampleRate);
     int interpretAsWav(const QByteArray& inputAudioByteArray, QByteArray& outputAudioByteArray);
@@ -63,6 +73,9 @@ public:
     bool isReady() const { return _sound->isReady(); }
     float getDuration() { return _sound->getDuration(); }
 
+    // the 16-bit PCM samples, which reach the script as an ArrayBuffer sharing them
+    Q_INVOKABLE QByteArray getSamples() const { return _sound->isReady() ? _sound->getByteArray() : QByteArray(); }
+
 signals:
     void ready();
 
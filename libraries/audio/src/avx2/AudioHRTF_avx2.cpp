@@ -91,4 +91,54 @@ void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3
     _mm256_zeroupper();
 }
 
+// crossfade 2x4 inputs into 2 outputs with accumulation (interleaved)
+// the two sources are processed in parallel, one per 128-bit lane
+void crossfade_4x2x2_AVX2(float* src0, float* src1, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m256 f0 = _mm256_broadcast_ps((const __m128*)&win[i]);
+
+        __m256 x0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&src0[4*i+0])), _mm_loadu_ps(&src1[4*i+0]), 1);
+        __m256 x1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&src0[4*i+4])), _mm_loadu_ps(&src1[4*i+4]), 1);
+        __m256 x2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&src0[4*i+8])), _mm_loadu_ps(&src1[4*i+8]), 1);
+        __m256 x3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&src0[4*i+12])), _mm_loadu_ps(&src1[4*i+12]), 1);
+
+        // deinterleave (4x4 matrix transpose, per lane)
+        __m256 t0 = _mm256_unpacklo_ps(x0, x1);
+        __m256 t2 = _mm256_unpacklo_ps(x2, x3);
+        __m256 t1 = _mm256_unpackhi_ps(x0, x1);
+        __m256 t3 = _mm256_unpackhi_ps(x2, x3);
+
+        x0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        x1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        x2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        x3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+        // crossfade
+        x0 = _mm256_sub_ps(x0, x2);
+        x1 = _mm256_sub_ps(x1, x3);
+        x2 = _mm256_fmadd_ps(f0, x0, x2);
+        x3 = _mm256_fmadd_ps(f0, x1, x3);
+
+        // interleave
+        x0 = _mm256_unpacklo_ps(x2, x3);
+        x1 = _mm256_unpackhi_ps(x2, x3);
+
+        // sum the sources, and accumulate
+        __m128 y0 = _mm_add_ps(_mm256_castps256_ps128(x0), _mm256_extractf128_ps(x0, 1));
+        __m128 y1 = _mm_add_ps(_mm256_castps256_ps128(x1), _mm256_extractf128_ps(x1, 1));
+
+        y0 = _mm_add_ps(y0, _mm_loadu_ps(&dst[2*i+0]));
+        y1 = _mm_add_ps(y1, _mm_loadu_ps(&dst[2*i+4]));
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
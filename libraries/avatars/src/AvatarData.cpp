@@ -521,12 +521,41 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             *destinationBuffer++ = validity;
         }
 
+        // joint rotation precision bits -- one per valid rotation, set if it is packed coarsely
+        {
+            unsigned char precision = 0;
+            int precisionBit = 0;
+            for (int i = 0; i < _jointData.size(); i++) {
+                if (validityPosition[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE))) {
+                    if (isCoarseJointRotation(i)) {
+                        precision |= (1 << precisionBit);
+                    }
+                    if (++precisionBit == BITS_IN_BYTE) {
+                        *destinationBuffer++ = precision;
+                        precisionBit = precision = 0;
+                    }
+                }
+            }
+            if (precisionBit != 0) {
+                *destinationBuffer++ = precision;
+            }
+        }
+
+        const int FINE_QUATERNION_SIZE = 6;
+        int coarseBytesSaved = 0;
+
         validityBit = 0;
         validity = *validityPosition++;
         for (int i = 0; i < _jointData.size(); i++) {
             const JointData& data = _jointData[i];
             if (validity & (1 << validityBit)) {
-                destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                if (isCoarseJointRotation(i)) {
+                    int numBytes = packOrientationQuatToFourBytes(destinationBuffer, data.rotation);
+                    destinationBuffer += numBytes;
+                    coarseBytesSaved += FINE_QUATERNION_SIZE - numBytes;
+                } else {
+                    destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                }
             }
             if (++validityBit == BITS_IN_BYTE) {
                 validityBit = 0;
@@ -621,6 +650,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         int numBytes = destinationBuffer - startSection;
         if (outboundDataRateOut) {
             outboundDataRateOut->jointDataRate.increment(numBytes);
+            outboundDataRateOut->jointDataSavedRate.increment(coarseBytesSaved);
         }
     }
 
@@ -702,7 +732,10 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     const unsigned char* endPosition = startPosition + buffer.size();
     const unsigned char* sourceBuffer = startPosition;
 
+    quint64 now = usecTimestampNow();
+
     // read the packet flags
+    PACKET_READ_CHECK(HasFlags, sizeof(packetStateFlags));
     memcpy(&packetStateFlags, sourceBuffer, sizeof(packetStateFlags));
     sourceBuffer += sizeof(packetStateFlags);
 
@@ -721,8 +754,6 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasFaceTrackerInfo      = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO);
     bool hasJointData            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
 
-    quint64 now = usecTimestampNow();
-
     if (hasAvatarGlobalPosition) {
         auto startSection = sourceBuffer;
 
@@ -915,9 +946,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         auto parentInfo = reinterpret_cast<const AvatarDataPacket::ParentInfo*>(sourceBuffer);
         sourceBuffer += sizeof(AvatarDataPacket::ParentInfo);
 
-        QByteArray byteArray((const char*)parentInfo->parentUUID, NUM_BYTES_RFC4122_UUID);
-
-        auto newParentID = QUuid::fromRfc4122(byteArray);
+        auto newParentID = QUuid::fromRfc4122(QByteArray::fromRawData((const char*)parentInfo->parentUUID, NUM_BYTES_RFC4122_UUID));
 
         if ((getParentID() != newParentID) || (getParentJointIndex() != parentInfo->parentJointIndex)) {
             SpatiallyNestable::setParentID(newParentID);
@@ -984,9 +1013,13 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
         PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
 
+        // the joint count is a single byte, so the per joint bits are unpacked on the stack rather than the heap
+        const int MAX_NUM_JOINTS = 256;
+        bool validRotations[MAX_NUM_JOINTS];
+        bool coarseRotations[MAX_NUM_JOINTS];
+        bool validTranslations[MAX_NUM_JOINTS];
+
         int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
         { // rotation validity bits
             unsigned char validity = 0;
             int validityBit = 0;
@@ -1003,16 +1036,50 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
-        // each joint rotation is stored in 6 bytes.
+        // get rotation precision bits -- these indicate which of the valid rotations were packed coarsely
+        const int bytesOfPrecision = (int)ceil((float)numValidJointRotations / (float)BITS_IN_BYTE);
+        PACKET_READ_CHECK(JointRotationPrecisionBits, bytesOfPrecision);
+
+        int numCoarseJointRotations = 0;
+        { // rotation precision bits
+            unsigned char precision = 0;
+            int precisionBit = 0;
+            for (int i = 0; i < numJoints; i++) {
+                if (!validRotations[i]) {
+                    coarseRotations[i] = false;
+                    continue;
+                }
+                if (precisionBit == 0) {
+                    precision = *sourceBuffer++;
+                }
+                bool coarse = (bool)(precision & (1 << precisionBit));
+                if (coarse) {
+                    ++numCoarseJointRotations;
+                }
+                coarseRotations[i] = coarse;
+                precisionBit = (precisionBit + 1) % BITS_IN_BYTE;
+            }
+        }
+
+        // each joint rotation is stored in 6 bytes, or 4 if coarse.
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
+        _coarseJointRotations.resize(numJoints);
 
         const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+        const int COARSE_COMPRESSED_QUATERNION_SIZE = 4;
+        PACKET_READ_CHECK(JointRotations, (numValidJointRotations - numCoarseJointRotations) * COMPRESSED_QUATERNION_SIZE +
+            numCoarseJointRotations * COARSE_COMPRESSED_QUATERNION_SIZE);
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                if (coarseRotations[i]) {
+                    sourceBuffer += unpackOrientationQuatFromFourBytes(sourceBuffer, data.rotation);
+                } else {
+                    sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                }
+                // keep the sender's choice of precision when relaying this avatar
+                _coarseJointRotations[i] = coarseRotations[i];
                 _hasNewJointData = true;
                 data.rotationSet = true;
             }
@@ -1022,8 +1089,6 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
 
         // get translation validity bits -- these indicate which translations were packed
         int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
         { // translation validity bits
             unsigned char validity = 0;
             int validityBit = 0;
@@ -1053,6 +1118,10 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
+        if (_bufferJointData) {
+            _jointDataBuffer.push(usecTimestampNow(), _jointData);
+        }
+
 #ifdef WANT_DEBUG
         if (numValidJointRotations > 15) {
             qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
@@ -1061,6 +1130,8 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         }
 #endif
         // faux joints
+        const int FAUX_JOINT_SIZE = COMPRESSED_QUATERNION_SIZE + COMPRESSED_TRANSLATION_SIZE;
+        PACKET_READ_CHECK(FauxJoints, 2 * FAUX_JOINT_SIZE);
         sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerLeftHandMatrixCache);
         sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerRightHandMatrixCache);
 
@@ -1129,6 +1200,8 @@ float AvatarData::getDataRate(const QString& rateName) const {
         return _outboundDataRate.faceTrackerRate.rate() / BYTES_PER_KILOBIT;
     } else if (rateName == "jointDataOutbound") {
         return _outboundDataRate.jointDataRate.rate() / BYTES_PER_KILOBIT;
+    } else if (rateName == "jointDataSavedOutbound") {
+        return _outboundDataRate.jointDataSavedRate.rate() / BYTES_PER_KILOBIT;
     }
     return 0.0f;
 }
@@ -1457,8 +1530,12 @@ QStringList AvatarData::getJointNames() const {
 
 void AvatarData::parseAvatarIdentityPacket(const QByteArray& data, Identity& identityOut) {
     QDataStream packetStream(data);
+    parseAvatarIdentity(packetStream, identityOut);
+}
 
+bool AvatarData::parseAvatarIdentity(QDataStream& packetStream, Identity& identityOut) {
     packetStream >> identityOut.uuid >> identityOut.skeletonModelURL >> identityOut.attachmentData >> identityOut.displayName >> identityOut.sessionDisplayName >> identityOut.avatarEntityData;
+    return packetStream.status() == QDataStream::Ok;
 }
 
 static const QUrl emptyURL("");
@@ -1650,6 +1727,12 @@ void AvatarData::setJointMappingsFromNetworkReply() {
         for (int i = 0; i < _jointNames.size(); i++) {
             _jointIndices.insert(_jointNames.at(i), i + 1);
         }
+
+        QWriteLocker writeLock(&_jointDataLock);
+        _coarseJointRotations.resize(_jointNames.size());
+        for (int i = 0; i < _jointNames.size(); i++) {
+            _coarseJointRotations[i] = isCoarseJointName(_jointNames.at(i));
+        }
     }
 
     networkReply->deleteLater();
@@ -1693,12 +1776,21 @@ void AvatarData::sendIdentityPacket() {
     _avatarEntityDataLocallyEdited = false;
 }
 
+bool AvatarData::isCoarseJointName(const QString& jointName) {
+    // finger joints (LeftHandThumb1, RightHandIndex4, ...) are small on screen and can be sent with less precision
+    static const QString LEFT_HAND = "LeftHand";
+    static const QString RIGHT_HAND = "RightHand";
+    return (jointName.startsWith(LEFT_HAND) && jointName.size() > LEFT_HAND.size()) ||
+        (jointName.startsWith(RIGHT_HAND) && jointName.size() > RIGHT_HAND.size());
+}
+
 void AvatarData::updateJointMappings() {
     {
         QWriteLocker writeLock(&_jointDataLock);
         _jointIndices.clear();
         _jointNames.clear();
         _jointData.clear();
+        _coarseJointRotations.clear();
     }
 
     if (_skeletonModelURL.fileName().toLower().endsWith(".fst")) {
@@ -1895,11 +1987,7 @@ JointData jointDataFromJsonValue(const QJsonValue& json) {
     return result;
 }
 
-QJsonObject AvatarData::toJson() const {
-    QJsonObject root;
-
-    root[JSON_AVATAR_VERSION] = JSON_AVATAR_JOINT_ROTATIONS_IN_ABSOLUTE_FRAME_VERSION;
-
+void AvatarData::identityToJson(QJsonObject& root) const {
     if (!getSkeletonModelURL().isEmpty()) {
         root[JSON_AVATAR_BODY_MODEL] = getSkeletonModelURL().toString();
     }
@@ -1926,6 +2014,39 @@ QJsonObject AvatarData::toJson() const {
             root[JSON_AVATAR_ENTITIES] = avatarEntityJson;
         }
     });
+}
+
+void AvatarData::identityFromJson(const QJsonObject& json, bool useFrameSkeleton) {
+    if (json.contains(JSON_AVATAR_BODY_MODEL)) {
+        auto bodyModelURL = json[JSON_AVATAR_BODY_MODEL].toString();
+        if (useFrameSkeleton && bodyModelURL != getSkeletonModelURL().toString()) {
+            setSkeletonModelURL(bodyModelURL);
+        }
+    }
+    if (json.contains(JSON_AVATAR_DISPLAY_NAME)) {
+        auto newDisplayName = json[JSON_AVATAR_DISPLAY_NAME].toString();
+        if (newDisplayName != getDisplayName()) {
+            setDisplayName(newDisplayName);
+        }
+    }
+    if (json.contains(JSON_AVATAR_ATTACHMENTS) && json[JSON_AVATAR_ATTACHMENTS].isArray()) {
+        QJsonArray attachmentsJson = json[JSON_AVATAR_ATTACHMENTS].toArray();
+        QVector<AttachmentData> attachments;
+        for (auto attachmentJson : attachmentsJson) {
+            AttachmentData attachment;
+            attachment.fromJson(attachmentJson.toObject());
+            attachments.push_back(attachment);
+        }
+        setAttachmentData(attachments);
+    }
+}
+
+QJsonObject AvatarData::toJson() const {
+    QJsonObject root;
+
+    root[JSON_AVATAR_VERSION] = JSON_AVATAR_JOINT_ROTATIONS_IN_ABSOLUTE_FRAME_VERSION;
+
+    identityToJson(root);
 
     auto recordingBasis = getRecordingBasis();
     bool success;
@@ -1987,18 +2108,7 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
         _headData->fromJson(json[JSON_AVATAR_HEAD].toObject());
     }
 
-    if (json.contains(JSON_AVATAR_BODY_MODEL)) {
-        auto bodyModelURL = json[JSON_AVATAR_BODY_MODEL].toString();
-        if (useFrameSkeleton && bodyModelURL != getSkeletonModelURL().toString()) {
-            setSkeletonModelURL(bodyModelURL);
-        }
-    }
-    if (json.contains(JSON_AVATAR_DISPLAY_NAME)) {
-        auto newDisplayName = json[JSON_AVATAR_DISPLAY_NAME].toString();
-        if (newDisplayName != getDisplayName()) {
-            setDisplayName(newDisplayName);
-        }
-    }
+    identityFromJson(json, useFrameSkeleton);
 
     auto currentBasis = getRecordingBasis();
     if (!currentBasis) {
@@ -2027,16 +2137,6 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
         setTargetScale((float)json[JSON_AVATAR_SCALE].toDouble());
     }
 
-    if (json.contains(JSON_AVATAR_ATTACHMENTS) && json[JSON_AVATAR_ATTACHMENTS].isArray()) {
-        QJsonArray attachmentsJson = json[JSON_AVATAR_ATTACHMENTS].toArray();
-        QVector<AttachmentData> attachments;
-        for (auto attachmentJson : attachmentsJson) {
-            AttachmentData attachment;
-            attachment.fromJson(attachmentJson.toObject());
-            attachments.push_back(attachment);
-        }
-        setAttachmentData(attachments);
-    }
 
     // if (json.contains(JSON_AVATAR_ENTITIES) && json[JSON_AVATAR_ENTITIES].isArray()) {
     //     QJsonArray attachmentsJson = json[JSON_AVATAR_ATTACHMENTS].toArray();
@@ -2069,24 +2169,222 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+const quint64 AvatarData::RECORDING_KEYFRAME_INTERVAL = USECS_PER_SECOND;
+
+// The compact frames start with a tag that binary JSON documents never start with, so the frames recorded as JSON still
+// play. The joints are packed as in the avatar data packets, and the rest is either floats or binary JSON.
+static const QByteArray COMPACT_FRAME_TAG = QByteArrayLiteral("hfar");
+static const uint8_t COMPACT_FRAME_VERSION = 1;
+
+static const uint8_t COMPACT_FRAME_KEYFRAME = 1U << 0;
+static const uint8_t COMPACT_FRAME_HAS_BASIS = 1U << 1;
+static const uint8_t COMPACT_FRAME_HAS_SCALE = 1U << 2;
+static const uint8_t COMPACT_FRAME_HAS_HEAD = 1U << 3;
+
+static const int COMPACT_JOINT_SIZE = 6 + 6; // a six byte rotation and a two byte fixed point translation
+
+template <typename T>
+static void appendToFrame(QByteArray& frame, const T& value) {
+    frame.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendToFrame(QByteArray& frame, const Transform& transform) {
+    appendToFrame(frame, transform.getTranslation());
+    appendToFrame(frame, transform.getRotation());
+    appendToFrame(frame, transform.getScale());
+}
+
+static void appendToFrame(QByteArray& frame, const QJsonObject& json) {
+    QByteArray jsonData = QJsonDocument(json).toBinaryData();
+    appendToFrame(frame, (quint32)jsonData.size());
+    frame.append(jsonData);
+}
+
+// reads a compact frame, each read fails once the frame is cut short
+class CompactFrameReader {
+public:
+    CompactFrameReader(const QByteArray& frame) : _frame(frame) {}
+
+    const uchar* read(int size) {
+        if (size < 0 || _frame.size() - _offset < size) {
+            return nullptr;
+        }
+        auto data = reinterpret_cast<const uchar*>(_frame.constData()) + _offset;
+        _offset += size;
+        return data;
+    }
+
+    template <typename T>
+    bool read(T& value) {
+        auto data = read(sizeof(T));
+        if (data) {
+            memcpy(&value, data, sizeof(T));
+        }
+        return data != nullptr;
+    }
+
+    bool read(Transform& transform) {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+        if (!read(translation) || !read(rotation) || !read(scale)) {
+            return false;
+        }
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+        return true;
+    }
+
+    bool read(QJsonObject& json) {
+        quint32 size;
+        auto data = read(size) ? read((int)size) : nullptr;
+        if (data) {
+            json = QJsonDocument::fromBinaryData(QByteArray::fromRawData(reinterpret_cast<const char*>(data), size)).object();
+        }
+        return data != nullptr;
+    }
+
+private:
+    const QByteArray& _frame;
+    int _offset { 0 };
+};
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
 // avatar
-QByteArray AvatarData::toFrame(const AvatarData& avatar) {
-    QJsonObject root = avatar.toJson();
-#ifdef WANT_JSON_DEBUG
-    {
-        QJsonObject obj = root;
-        obj.remove(JSON_AVATAR_JOINT_ARRAY);
-        qCDebug(avatars).noquote() << QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Indented);
+QByteArray AvatarData::toFrame(const AvatarData& avatar, bool isKeyframe) {
+    auto recordingBasis = avatar.getRecordingBasis();
+    QJsonObject headJson;
+    const HeadData* head = avatar.getHeadData();
+    if (head) {
+        headJson = head->toJson();
     }
-#endif
-    return QJsonDocument(root).toBinaryData();
+    auto scale = avatar.getDomainLimitedScale();
+
+    uint8_t flags = 0;
+    flags |= isKeyframe ? COMPACT_FRAME_KEYFRAME : 0;
+    flags |= recordingBasis ? COMPACT_FRAME_HAS_BASIS : 0;
+    flags |= scale != 1.0f ? COMPACT_FRAME_HAS_SCALE : 0;
+    flags |= !headJson.isEmpty() ? COMPACT_FRAME_HAS_HEAD : 0;
+
+    QByteArray frame;
+    frame.append(COMPACT_FRAME_TAG);
+    appendToFrame(frame, COMPACT_FRAME_VERSION);
+    appendToFrame(frame, flags);
+
+    if (isKeyframe) {
+        QJsonObject identityJson;
+        avatar.identityToJson(identityJson);
+        appendToFrame(frame, identityJson);
+    }
+
+    bool success;
+    Transform avatarTransform = avatar.getTransform(success);
+    if (!success) {
+        qCWarning(avatars) << "Warning -- AvatarData::toFrame couldn't get avatar transform";
+    }
+    avatarTransform.setScale(scale);
+    if (recordingBasis) {
+        appendToFrame(frame, *recordingBasis);
+        appendToFrame(frame, recordingBasis->relativeTransform(avatarTransform));
+    } else {
+        appendToFrame(frame, avatarTransform);
+    }
+    if (flags & COMPACT_FRAME_HAS_SCALE) {
+        appendToFrame(frame, scale);
+    }
+    if (flags & COMPACT_FRAME_HAS_HEAD) {
+        appendToFrame(frame, headJson);
+    }
+
+    // Skeleton pose
+    auto jointData = avatar.getRawJointData();
+    appendToFrame(frame, (quint16)jointData.size());
+    int jointsOffset = frame.size();
+    frame.resize(jointsOffset + jointData.size() * COMPACT_JOINT_SIZE);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(frame.data()) + jointsOffset;
+    for (const auto& joint : jointData) {
+        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, joint.rotation);
+        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, joint.translation,
+            TRANSLATION_COMPRESSION_RADIX);
+    }
+    return frame;
 }
 
+void AvatarData::fromCompactFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    CompactFrameReader reader(frameData);
+    reader.read(COMPACT_FRAME_TAG.size());
+
+    uint8_t version;
+    uint8_t flags;
+    if (!reader.read(version) || !reader.read(flags) || version > COMPACT_FRAME_VERSION) {
+        qCWarning(avatars) << "Unsupported avatar recording frame";
+        return;
+    }
+
+    QJsonObject identityJson;
+    Transform basis;
+    Transform relativeTransform;
+    float scale { 1.0f };
+    QJsonObject headJson;
+    quint16 numJoints { 0 };
+    bool valid = (!(flags & COMPACT_FRAME_KEYFRAME) || reader.read(identityJson)) &&
+        (!(flags & COMPACT_FRAME_HAS_BASIS) || reader.read(basis)) &&
+        reader.read(relativeTransform) &&
+        (!(flags & COMPACT_FRAME_HAS_SCALE) || reader.read(scale)) &&
+        (!(flags & COMPACT_FRAME_HAS_HEAD) || reader.read(headJson)) &&
+        reader.read(numJoints);
+    const uchar* sourceBuffer = valid ? reader.read(numJoints * COMPACT_JOINT_SIZE) : nullptr;
+    if (!sourceBuffer) {
+        qCWarning(avatars) << "Truncated avatar recording frame";
+        return;
+    }
+
+    // as in fromJson, the head goes first
+    if (flags & COMPACT_FRAME_HAS_HEAD) {
+        if (!result._headData) {
+            result._headData = new HeadData(&result);
+        }
+        result._headData->fromJson(headJson);
+    }
+
+    if (flags & COMPACT_FRAME_KEYFRAME) {
+        result.identityFromJson(identityJson, useFrameSkeleton);
+    }
+
+    auto currentBasis = result.getRecordingBasis();
+    if (!currentBasis) {
+        currentBasis = std::make_shared<Transform>(basis);
+    }
+    auto worldTransform = currentBasis->worldTransform(relativeTransform);
+    result.setPosition(worldTransform.getTranslation());
+    result.setOrientation(worldTransform.getRotation());
+
+    if (flags & COMPACT_FRAME_HAS_SCALE) {
+        result.setTargetScale(scale);
+    }
+
+    QVector<JointData> jointArray;
+    jointArray.resize(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        JointData& joint = jointArray[i];
+        sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, joint.rotation);
+        sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, joint.translation, TRANSLATION_COMPRESSION_RADIX);
+        joint.rotationSet = true;
+        joint.translationSet = false;
+        result.setJointData(i, joint.rotation, joint.translation);
+    }
+    result.setRawJointData(jointArray);
+}
 
 void AvatarData::fromFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    if (frameData.startsWith(COMPACT_FRAME_TAG)) {
+        fromCompactFrame(frameData, result, useFrameSkeleton);
+        return;
+    }
+
     QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
 
 #ifdef WANT_JSON_DEBUG
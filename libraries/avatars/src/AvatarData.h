@@ -63,6 +63,7 @@ typedef unsigned long long quint64;
 #include <ViewFrustum.h>
 
 #include "AABox.h"
+#include "AvatarJointBuffer.h"
 #include "HeadData.h"
 #include "PathUtils.h"
 
@@ -234,11 +235,22 @@ namespace AvatarDataPacket {
     struct JointData {
         uint8_t numJoints;
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
+        uint8_t rotationPrecisionBits[ceil(numValidRotations / 8)]; // one bit per valid rotation, if true it is coarse.
+        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes(),
+                                                               // or in four bytes by packOrientationQuatToFourBytes() if coarse
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
         SixByteTrans translation[numValidTranslations];        // encodeded and compressed by packFloatVec3ToSignedTwoByteFixed()
     };
     */
+
+    // HostedAvatarData packets carry the avatar data of several avatars hosted by the sending node (the bots of an agent),
+    // as a sequence of these headers each followed by size bytes of avatar data.
+    PACKED_BEGIN struct HostedAvatarHeader {
+        uint8_t avatarUUID[16];           // rfc 4122 encoded
+        uint16_t sequenceNumber;
+        uint16_t size;
+    } PACKED_END;
+    const size_t HOSTED_AVATAR_HEADER_SIZE = 20;
 }
 
 static const float MAX_AVATAR_SCALE = 1000.0f;
@@ -307,6 +319,7 @@ public:
     RateCounter<> parentInfoRate;
     RateCounter<> faceTrackerRate;
     RateCounter<> jointDataRate;
+    RateCounter<> jointDataSavedRate; // bytes saved by coarse joint rotations
 };
 
 class AvatarPriority {
@@ -359,8 +372,12 @@ public:
 
     static const QString FRAME_NAME;
 
+    // a recorder writes a keyframe each RECORDING_KEYFRAME_INTERVAL, the frames in between only hold the transform, the
+    // head and the joints, quantized as in the avatar data packets, and leave the skeleton, display name and attachments
+    static const quint64 RECORDING_KEYFRAME_INTERVAL; // usecs
+
     static void fromFrame(const QByteArray& frameData, AvatarData& avatar, bool useFrameSkeleton = true);
-    static QByteArray toFrame(const AvatarData& avatar);
+    static QByteArray toFrame(const AvatarData& avatar, bool isKeyframe = true);
 
     AvatarData();
     virtual ~AvatarData();
@@ -523,6 +540,8 @@ public:
     };
 
     static void parseAvatarIdentityPacket(const QByteArray& data, Identity& identityOut);
+    // parse the next of (possibly) several concatenated identities, returns false if the stream held no complete identity
+    static bool parseAvatarIdentity(QDataStream& packetStream, Identity& identityOut);
 
     // identityChanged returns true if identity has changed, false otherwise.
     // displayNameChanged returns true if displayName has changed, false otherwise.
@@ -664,6 +683,10 @@ protected:
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    // the joint data received, kept for the remote avatars which render it a little in the past
+    bool _bufferJointData { false };
+    AvatarJointBuffer _jointDataBuffer;
+
     // key state
     KeyState _keyState;
 
@@ -685,6 +708,10 @@ protected:
 
     QHash<QString, int> _jointIndices; ///< 1-based, since zero is returned for missing keys
     QStringList _jointNames; ///< in order of depth-first traversal
+    QVector<bool> _coarseJointRotations; ///< joints whose rotations are sent with less precision, guarded by _jointDataLock
+
+    static bool isCoarseJointName(const QString& jointName);
+    bool isCoarseJointRotation(int index) const { return index < _coarseJointRotations.size() && _coarseJointRotations[index]; }
 
     quint64 _errorLogExpiry; ///< time in future when to log an error
 
@@ -766,6 +793,10 @@ protected:
     int getFauxJointIndex(const QString& name) const;
 
 private:
+    void identityToJson(QJsonObject& root) const;
+    void identityFromJson(const QJsonObject& json, bool useFrameSkeleton);
+    static void fromCompactFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton);
+
     friend void avatarStateFromFrame(const QByteArray& frameData, AvatarData* _avatar);
     static QUrl _defaultFullAvatarModelUrl;
     // privatize the copy constructor and assignment operator so they cannot be called
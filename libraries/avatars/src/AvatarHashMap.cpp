@@ -128,9 +128,19 @@ void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> mess
 }
 
 void AvatarHashMap::processAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
-    AvatarData::Identity identity;
-    AvatarData::parseAvatarIdentityPacket(message->getMessage(), identity);
+    // the avatar mixer coalesces the identity changes it sends us each frame into one message
+    QDataStream packetStream(message->getMessage());
+    while (!packetStream.atEnd()) {
+        AvatarData::Identity identity;
+        if (!AvatarData::parseAvatarIdentity(packetStream, identity)) {
+            qCWarning(avatars) << "Failed to parse identity packet from" << sendingNode->getUUID();
+            break;
+        }
+        processAvatarIdentity(identity, sendingNode);
+    }
+}
 
+void AvatarHashMap::processAvatarIdentity(AvatarData::Identity& identity, const SharedNodePointer& sendingNode) {
     // make sure this isn't for an ignored avatar
     auto nodeList = DependencyManager::get<NodeList>();
     static auto EMPTY = QUuid();
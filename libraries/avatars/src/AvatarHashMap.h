@@ -59,6 +59,8 @@ private slots:
     void processExitingSpaceBubble(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 protected:
+    void processAvatarIdentity(AvatarData::Identity& identity, const SharedNodePointer& sendingNode);
+
     AvatarHashMap();
 
     virtual AvatarSharedPointer newSharedAvatar();
@@ -0,0 +1,176 @@
+//
+//  AvatarJointBuffer.cpp
+//  libraries/avatars/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarJointBuffer.h"
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+const quint64 AvatarJointBuffer::INITIAL_DELAY = 50 * USECS_PER_MSEC;
+const quint64 AvatarJointBuffer::MAX_DELAY = 300 * USECS_PER_MSEC;
+const quint64 AvatarJointBuffer::MAX_EXTRAPOLATION = 100 * USECS_PER_MSEC;
+
+// the sampling clock runs up to 10% faster or slower while the delay moves to its target
+static const float DELAY_ADJUSTMENT_RATE = 0.1f;
+
+// more than enough frames to cover the largest delay at the usual rate
+static const size_t MAX_FRAMES = 32;
+
+void AvatarJointBuffer::push(quint64 arrivalTime, const QVector<JointData>& joints) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_frames.empty()) {
+        if (arrivalTime <= _frames.back().time) {
+            // two frames in the same tick, the last one wins
+            _frames.back().joints = joints;
+            return;
+        }
+        quint64 gap = arrivalTime - _frames.back().time;
+        _gapStats.update(gap);
+
+        // a gap larger than the delay would have run out of frames, cover it at once
+        if (gap > _targetDelay) {
+            _targetDelay = std::min(gap, MAX_DELAY);
+        }
+
+        // shrink to the largest gap of the window once it is filled
+        if (_gapStats.getNewStatsAvailableFlag()) {
+            if (_gapStats.isWindowFilled() && _gapStats.getWindowMax() < _targetDelay) {
+                _targetDelay = _gapStats.getWindowMax();
+            }
+            _gapStats.clearNewStatsAvailableFlag();
+        }
+    }
+
+    _frames.push_back({ arrivalTime, joints });
+    if (_frames.size() > MAX_FRAMES) {
+        _frames.pop_front();
+    }
+}
+
+bool AvatarJointBuffer::sample(quint64 now, QVector<JointData>& jointsOut) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_frames.empty()) {
+        return false;
+    }
+
+    if (_lastSampleTime > 0 && now > _lastSampleTime) {
+        quint64 maxAdjustment = (quint64)(DELAY_ADJUSTMENT_RATE * (float)(now - _lastSampleTime));
+        if (_delay < _targetDelay) {
+            _delay = std::min(_delay + maxAdjustment, _targetDelay);
+        } else {
+            _delay = std::max(_delay - std::min(maxAdjustment, _delay), _targetDelay);
+        }
+    }
+    _lastSampleTime = now;
+
+    quint64 playTime = now > _delay ? now - _delay : 0;
+
+    // drop the frames older than the one before the play time
+    while (_frames.size() > 2 && _frames[1].time <= playTime) {
+        _frames.pop_front();
+    }
+
+    if (playTime <= _frames.front().time || _frames.size() == 1) {
+        jointsOut = _frames.front().joints;
+        return true;
+    }
+    for (size_t i = 0; i + 1 < _frames.size(); i++) {
+        const Frame& from = _frames[i];
+        const Frame& to = _frames[i + 1];
+        if (playTime < to.time) {
+            float alpha = (float)(playTime - from.time) / (float)(to.time - from.time);
+            interpolate(from, to, alpha, jointsOut);
+            return true;
+        }
+    }
+    extrapolate(_frames[_frames.size() - 2], _frames.back(), playTime, jointsOut);
+    return true;
+}
+
+bool AvatarJointBuffer::isPlaying(quint64 now) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_frames.size() < 2) {
+        return false;
+    }
+    quint64 playTime = now > _delay ? now - _delay : 0;
+    return playTime < _frames.back().time + MAX_EXTRAPOLATION;
+}
+
+quint64 AvatarJointBuffer::getDelay() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _delay;
+}
+
+quint64 AvatarJointBuffer::getTargetDelay() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _targetDelay;
+}
+
+int AvatarJointBuffer::getNumFrames() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_frames.size();
+}
+
+void AvatarJointBuffer::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _frames.clear();
+    _gapStats.reset();
+    _targetDelay = INITIAL_DELAY;
+    _delay = INITIAL_DELAY;
+    _lastSampleTime = 0;
+}
+
+void AvatarJointBuffer::interpolate(const Frame& from, const Frame& to, float alpha, QVector<JointData>& jointsOut) {
+    jointsOut = to.joints;
+    if (from.joints.size() != to.joints.size()) {
+        // the skeleton changed
+        return;
+    }
+    for (int i = 0; i < jointsOut.size(); i++) {
+        const JointData& fromJoint = from.joints[i];
+        JointData& joint = jointsOut[i];
+        if (fromJoint.rotationSet && joint.rotationSet) {
+            joint.rotation = safeMix(fromJoint.rotation, joint.rotation, alpha);
+        }
+        if (fromJoint.translationSet && joint.translationSet) {
+            joint.translation = glm::mix(fromJoint.translation, joint.translation, alpha);
+        }
+    }
+}
+
+void AvatarJointBuffer::extrapolate(const Frame& previous, const Frame& last, quint64 time, QVector<JointData>& jointsOut) {
+    jointsOut = last.joints;
+    if (previous.joints.size() != last.joints.size()) {
+        return;
+    }
+    // continue the motion between the last two frames for a while, then hold it
+    const float MAX_RATIO = 2.0f;
+    float ratio = std::min((float)std::min(time - last.time, MAX_EXTRAPOLATION) / (float)(last.time - previous.time), MAX_RATIO);
+    const float MIN_ANGLE = 0.0001f; // radians
+    for (int i = 0; i < jointsOut.size(); i++) {
+        const JointData& previousJoint = previous.joints[i];
+        JointData& joint = jointsOut[i];
+        if (previousJoint.rotationSet && joint.rotationSet) {
+            glm::quat previousRotation = glm::dot(previousJoint.rotation, joint.rotation) < 0.0f ?
+                -previousJoint.rotation : previousJoint.rotation;
+            glm::quat delta = joint.rotation * glm::inverse(previousRotation);
+            float angle = glm::angle(delta);
+            if (angle > MIN_ANGLE) {
+                joint.rotation = glm::normalize(glm::angleAxis(angle * ratio, glm::axis(delta)) * joint.rotation);
+            }
+        }
+        if (previousJoint.translationSet && joint.translationSet) {
+            joint.translation += (joint.translation - previousJoint.translation) * ratio;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  AvatarJointBuffer.h
+//  libraries/avatars/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarJointBuffer_h
+#define hifi_AvatarJointBuffer_h
+
+#include <deque>
+#include <mutex>
+
+#include <QtCore/QVector>
+
+#include <JointData.h>
+#include <MovingMinMaxAvg.h>
+
+// A jitter buffer of the joint data received for a remote avatar. The frames are stamped with their arrival time and
+// the joints are sampled a delay in the past, interpolating between the buffered frames, and extrapolating for a short
+// while when the next frame is late. Like the dynamic jitter buffer of InboundAudioStream, the delay grows at once to
+// the largest gap between two frames and shrinks to the largest gap of the recent window, and the sampling clock runs
+// slightly faster or slower to reach it so the motion never jumps. The frames are pushed by the network thread and
+// sampled by the simulation.
+class AvatarJointBuffer {
+public:
+    static const quint64 INITIAL_DELAY; // usecs
+    static const quint64 MAX_DELAY;
+    static const quint64 MAX_EXTRAPOLATION;
+
+    void push(quint64 arrivalTime, const QVector<JointData>& joints);
+
+    // the joints at now minus the delay, false when nothing was received
+    bool sample(quint64 now, QVector<JointData>& jointsOut);
+
+    // true while sample() still returns a changing pose, the buffered frames are not played or extrapolated to the end
+    bool isPlaying(quint64 now) const;
+
+    quint64 getDelay() const; // usecs
+    quint64 getTargetDelay() const;
+    int getNumFrames() const;
+
+    void reset();
+
+private:
+    struct Frame {
+        quint64 time;
+        QVector<JointData> joints;
+    };
+
+    static void interpolate(const Frame& from, const Frame& to, float alpha, QVector<JointData>& jointsOut);
+    static void extrapolate(const Frame& previous, const Frame& last, quint64 time, QVector<JointData>& jointsOut);
+
+    // the gaps of the last 300 frames, about 7 seconds at the usual rate
+    static const int GAPS_PER_INTERVAL = 15;
+    static const int WINDOW_INTERVALS = 20;
+
+    mutable std::mutex _mutex;
+    std::deque<Frame> _frames;
+
+    MovingMinMaxAvg<quint64> _gapStats { GAPS_PER_INTERVAL, WINDOW_INTERVALS };
+    quint64 _targetDelay { INITIAL_DELAY };
+    quint64 _delay { INITIAL_DELAY };
+    quint64 _lastSampleTime { 0 };
+};
+
+#endif // hifi_AvatarJointBuffer_h
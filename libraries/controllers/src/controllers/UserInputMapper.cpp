@@ -8,6 +8,7 @@
 
 #include "UserInputMapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include <QtCore/QThread>
@@ -93,6 +94,7 @@ void UserInputMapper::registerDevice(InputDevice::Pointer device) {
     }
 
     _registeredDevices[deviceID] = device;
+    _routesChanged = true;
 
     auto mapping = loadMappings(device->getDefaultMappingConfigs());
     if (mapping) {
@@ -134,6 +136,7 @@ void UserInputMapper::removeDevice(int deviceID) {
     }
 
     _registeredDevices.erase(proxyEntry);
+    _routesChanged = true;
 
     emit hardwareChanged();
 }
@@ -281,17 +284,16 @@ void UserInputMapper::update(float deltaTime) {
         // TODO: emit signal for pose changes
     }
 
-    auto standardInputs = getStandardInputs();
-    if ((int)_lastStandardStates.size() != standardInputs.size()) {
-        _lastStandardStates.resize(standardInputs.size());
+    if (_lastStandardStates.size() != _compiledStandardInputs.size()) {
+        _lastStandardStates.resize(_compiledStandardInputs.size());
         for (auto& lastValue : _lastStandardStates) {
             lastValue = 0;
         }
     }
 
-    for (int i = 0; i < standardInputs.size(); ++i) {
-        const auto& input = standardInputs[i].first;
-        float value = getValue(input);
+    for (size_t i = 0; i < _compiledStandardInputs.size(); ++i) {
+        const auto& input = _compiledStandardInputs[i];
+        float value = input.endpoint->value();
         float& oldValue = _lastStandardStates[i];
         if (value != oldValue) {
             oldValue = value;
@@ -445,7 +447,51 @@ static auto debugRoutes = false;
 static auto debuggableRoutes = false;
 static const auto DEBUG_INTERVAL = USECS_PER_SECOND;
 
+void UserInputMapper::compileRoutes(const Route::List& routes, std::vector<CompiledRoute>& compiledRoutes) {
+    compiledRoutes.clear();
+    compiledRoutes.reserve(routes.size());
+    for (const auto& route : routes) {
+        if (!route) {
+            continue;
+        }
+        CompiledRoute compiledRoute;
+        compiledRoute.route = route.get();
+        compiledRoute.source = route->source.get();
+        compiledRoute.destination = route->destination.get();
+        compiledRoute.conditional = route->conditional.get();
+        compiledRoute.firstFilter = (uint32)_compiledFilters.size();
+        for (const auto& filter : route->filters) {
+            _compiledFilters.push_back(filter.get());
+        }
+        compiledRoute.filterCount = (uint32)_compiledFilters.size() - compiledRoute.firstFilter;
+        compiledRoute.standardSource = route->source->getInput().device == STANDARD_DEVICE;
+        compiledRoutes.push_back(compiledRoute);
+    }
+}
+
+void UserInputMapper::compileRoutes() {
+    _compiledFilters.clear();
+    compileRoutes(_deviceRoutes, _compiledDeviceRoutes);
+    compileRoutes(_standardRoutes, _compiledStandardRoutes);
+    _deferredRoutes.reserve(std::max(_compiledDeviceRoutes.size(), _compiledStandardRoutes.size()));
+
+    _compiledEndpoints.clear();
+    _compiledEndpoints.reserve(_endpointsByInput.size());
+    _compiledStandardInputs.clear();
+    for (const auto& endpointEntry : _endpointsByInput) {
+        _compiledEndpoints.push_back(endpointEntry.second.get());
+        if (endpointEntry.first.device == STANDARD_DEVICE) {
+            _compiledStandardInputs.push_back({ endpointEntry.first.id, endpointEntry.second.get() });
+        }
+    }
+    _routesChanged = false;
+}
+
 void UserInputMapper::runMappings() {
+    if (_routesChanged) {
+        compileRoutes();
+    }
+
     auto now = usecTimestampNow();
     if (debuggableRoutes && now - lastDebugTime > DEBUG_INTERVAL) {
         lastDebugTime = now;
@@ -455,20 +501,20 @@ void UserInputMapper::runMappings() {
     if (debugRoutes) {
         qCDebug(controllers) << "Beginning mapping frame";
     }
-    for (auto endpointEntry : this->_endpointsByInput) {
-        endpointEntry.second->reset();
+    for (auto endpoint : _compiledEndpoints) {
+        endpoint->reset();
     }
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing device routes";
     }
     // Now process the current values for each level of the stack
-    applyRoutes(_deviceRoutes);
+    applyRoutes(_compiledDeviceRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing standard routes";
     }
-    applyRoutes(_standardRoutes);
+    applyRoutes(_compiledStandardRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Done with mappings";
@@ -477,50 +523,46 @@ void UserInputMapper::runMappings() {
 }
 
 // Encapsulate the logic that routes should not be read before they are written
-void UserInputMapper::applyRoutes(const Route::List& routes) {
-    Route::List deferredRoutes;
+void UserInputMapper::applyRoutes(const std::vector<CompiledRoute>& routes) {
+    _deferredRoutes.clear();
 
     for (const auto& route : routes) {
-        if (!route) {
-            continue;
-        }
-
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        _deferredRoutes.erase(std::remove_if(_deferredRoutes.begin(), _deferredRoutes.end(), [this](const CompiledRoute* route) {
+            return applyRoute(*route);
+        }), _deferredRoutes.end());
 
         if (!applyRoute(route)) {
-            deferredRoutes.push_back(route);
+            _deferredRoutes.push_back(&route);
         }
     }
 
     bool force = true;
-    for (const auto& route : deferredRoutes) {
-        UserInputMapper::applyRoute(route, force);
+    for (const auto& route : _deferredRoutes) {
+        applyRoute(*route, force);
     }
 }
 
 
-bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
-    if (debugRoutes && route->debug) {
-        qCDebug(controllers) << "Applying route " << route->json;
+bool UserInputMapper::applyRoute(const CompiledRoute& route, bool force) {
+    bool debug = debugRoutes && route.route->debug;
+    if (debug) {
+        qCDebug(controllers) << "Applying route " << route.route->json;
     }
 
     // If the source hasn't been written yet, defer processing of this route
-    auto source = route->source;
-    auto sourceInput = source->getInput();
-    if (sourceInput.device == STANDARD_DEVICE && !force && source->writeable()) {
-        if (debugRoutes && route->debug) {
+    auto source = route.source;
+    if (route.standardSource && !force && source->writeable()) {
+        if (debug) {
             qCDebug(controllers) << "Source not yet written, deferring";
         }
         return false;
     }
 
-    if (route->conditional) {
+    if (route.conditional) {
         // FIXME for endpoint conditionals we need to check if they've been written
-        if (!route->conditional->satisfied()) {
-            if (debugRoutes && route->debug) {
+        if (!route.conditional->satisfied()) {
+            if (debug) {
                 qCDebug(controllers) << "Conditional failed";
             }
             return true;
@@ -533,25 +575,26 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
     // and someone else wires it to CONTEXT_MENU, I don't want both to occur when 
     // I press the button.  The exception is if I'm wiring a control back to itself
     // in order to adjust my interface, like inverting the Y axis on an analog stick
-    if (!route->peek && !source->readable()) {
-        if (debugRoutes && route->debug) {
+    bool peek = route.route->peek;
+    if (!peek && !source->readable()) {
+        if (debug) {
             qCDebug(controllers) << "Source unreadable";
         }
         return true;
     }
 
-    auto destination = route->destination;
+    auto destination = route.destination;
     // THis could happen if the route destination failed to create
     // FIXME: Maybe do not create the route if the destination failed and avoid this case ?
     if (!destination) {
-        if (debugRoutes && route->debug) {
+        if (debug) {
             qCDebug(controllers) << "Bad Destination";
         }
         return true;
     }
 
     if (!destination->writeable()) {
-        if (debugRoutes && route->debug) {
+        if (debug) {
             qCDebug(controllers) << "Destination unwritable";
         }
         return true;
@@ -559,9 +602,9 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
 
     // Fetch the value, may have been overriden by previous loopback routes
     if (source->isPose()) {
-        Pose value = getPose(source, route->peek);
+        Pose value = peek ? source->peekPose() : source->pose();
         static const Pose IDENTITY_POSE { vec3(), quat() };
-        if (debugRoutes && route->debug) {
+        if (debug) {
             if (!value.valid) {
                 qCDebug(controllers) << "Applying invalid pose";
             } else if (value == IDENTITY_POSE) {
@@ -571,24 +614,26 @@ bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
             }
         }
         // no filters yet for pose
-        destination->apply(value, source);
+        destination->apply(value, route.route->source);
     } else {
         // Fetch the value, may have been overriden by previous loopback routes
-        float value = getValue(source, route->peek);
+        float value = peek ? source->peek() : source->value();
 
-        if (debugRoutes && route->debug) {
+        if (debug) {
             qCDebug(controllers) << "Value was " << value;
         }
         // Apply each of the filters.
-        for (const auto& filter : route->filters) {
-            value = filter->apply(value);
+        auto filter = _compiledFilters.data() + route.firstFilter;
+        auto filtersEnd = filter + route.filterCount;
+        for (; filter != filtersEnd; ++filter) {
+            value = (*filter)->apply(value);
         }
 
-        if (debugRoutes && route->debug) {
+        if (debug) {
             qCDebug(controllers) << "Filtered value was " << value;
         }
 
-        destination->apply(value, source);
+        destination->apply(value, route.route->source);
     }
     return true;
 }
@@ -1163,6 +1208,7 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    _routesChanged = true;
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -1179,6 +1225,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    _routesChanged = true;
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
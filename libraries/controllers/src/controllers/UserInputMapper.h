@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtQml/QJSValue>
 #include <QtScript/QScriptValue>
@@ -151,8 +152,26 @@ namespace controller {
 
         void runMappings();
 
-        static void applyRoutes(const RouteList& route);
-        static bool applyRoute(const RoutePointer& route, bool force = false);
+        // The enabled routes, flattened into arrays of plain pointers that the mappings run through each frame without
+        // allocating or copying shared pointers.  They are compiled again whenever the routes or the devices change.
+        struct CompiledRoute {
+            const Route* route;
+            Endpoint* source;
+            Endpoint* destination;
+            Conditional* conditional;
+            uint32 firstFilter;
+            uint32 filterCount;
+            bool standardSource; // not read until it is written, or all the other routes have run
+        };
+        struct CompiledInput {
+            int id;
+            Endpoint* endpoint;
+        };
+
+        void compileRoutes();
+        void compileRoutes(const RouteList& routes, std::vector<CompiledRoute>& compiledRoutes);
+        void applyRoutes(const std::vector<CompiledRoute>& routes);
+        bool applyRoute(const CompiledRoute& route, bool force = false);
         void enableMapping(const MappingPointer& mapping);
         void disableMapping(const MappingPointer& mapping);
         EndpointPointer endpointFor(const QJSValue& endpoint);
@@ -187,6 +206,14 @@ namespace controller {
 
         QSet<QString> _loadedRouteJsonFiles;
 
+        bool _routesChanged { true };
+        std::vector<CompiledRoute> _compiledDeviceRoutes;
+        std::vector<CompiledRoute> _compiledStandardRoutes;
+        std::vector<const Filter*> _compiledFilters;
+        std::vector<Endpoint*> _compiledEndpoints; // reset before each run
+        std::vector<CompiledInput> _compiledStandardInputs;
+        std::vector<const CompiledRoute*> _deferredRoutes;
+
         mutable std::recursive_mutex _lock;
     };
 
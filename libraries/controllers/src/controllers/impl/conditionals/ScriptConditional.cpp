@@ -19,9 +19,13 @@ bool ScriptConditional::satisfied() {
 
 void ScriptConditional::updateValue() {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        // the mappings run every frame, a slow script only needs the latest call
+        if (!_updatePending.exchange(true)) {
+            QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        }
         return;
     }
 
+    _updatePending = false;
     _lastValue = _callable.call().toBool();
 }
@@ -10,6 +10,8 @@
 #ifndef hifi_Controllers_ScriptConditional_h
 #define hifi_Controllers_ScriptConditional_h
 
+#include <atomic>
+
 #include <QtCore/QObject>
 
 #include <QtScript/QScriptValue>
@@ -28,6 +30,7 @@ protected:
 private:
     QScriptValue _callable;
     bool _lastValue { false };
+    std::atomic<bool> _updatePending { false }; // at most one queued call of the script
 };
 
 }
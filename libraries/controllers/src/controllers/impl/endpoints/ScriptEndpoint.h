@@ -10,6 +10,8 @@
 #ifndef hifi_Controllers_ScriptEndpoint_h
 #define hifi_Controllers_ScriptEndpoint_h
 
+#include <atomic>
+
 #include <QtScript/QScriptValue>
 
 #include "../Endpoint.h"
@@ -47,6 +49,10 @@ private:
     bool _returnPose { false };
     Pose _lastPoseRead;
     Pose _lastPoseWritten;
+
+    // at most one queued read of the script at a time
+    std::atomic<bool> _valueUpdatePending { false };
+    std::atomic<bool> _poseUpdatePending { false };
 };
 
 }
@@ -23,6 +23,7 @@
 #include <NumericalConstants.h>
 #include <DependencyManager.h>
 #include <GLMHelpers.h>
+#include <SharedUtil.h>
 
 #include <gl/QOpenGLContextWrapper.h>
 #include <gl/GLWidget.h>
@@ -72,6 +73,13 @@ void main(void) {
 
 extern QThread* RENDER_THREAD;
 
+static const QString FRAME_PACING = "Frame Pacing";
+
+// How far ahead of the next present the paced frames are submitted, at the least
+static const int64_t MIN_FRAME_PACING_MARGIN_USECS = 2 * USECS_PER_MSEC;
+// The margin grows by this much when a present misses its frame and shrinks back a hundredth as fast
+static const int64_t FRAME_PACING_MARGIN_STEP_USECS = 2 * USECS_PER_MSEC;
+
 class PresentThread : public QThread, public Dependency {
     using Mutex = std::mutex;
     using Condition = std::condition_variable;
@@ -291,6 +299,17 @@ bool OpenGLDisplayPlugin::activate() {
     if (!RENDER_THREAD) {
         RENDER_THREAD = _presentThread;
     }
+
+    // Per plugin, by default only the HMDs pace their frames to sample the pose as late as they can
+    const QString framePacingSetting = getName() + "/framePacing";
+    _framePacing = _container->getBoolSetting(framePacingSetting, isHmd());
+    _framePacingMargin = MIN_FRAME_PACING_MARGIN_USECS;
+    _frameStartDelayUsecs = 0;
+    _container->addMenuItem(PluginType::DISPLAY_PLUGIN, MENU_PATH(), FRAME_PACING,
+        [this, framePacingSetting](bool clicked) {
+        _framePacing = clicked;
+        _container->setBoolSetting(framePacingSetting, clicked);
+    }, true, _framePacing);
     
     // Child classes may override this in order to do things like initialize
     // libraries, etc
@@ -480,6 +499,11 @@ bool OpenGLDisplayPlugin::eventFilter(QObject* receiver, QEvent* event) {
 }
 
 void OpenGLDisplayPlugin::submitFrame(const gpu::FramePointer& newFrame) {
+    if (_framePacing) {
+        // The time from the present that started the frame, less the time the frame waited to start
+        int64_t frameCost = (int64_t)(usecTimestampNow() - _lastPresentStart) - _frameStartDelayUsecs;
+        _frameCostAverage.updateAverage((float)std::max(frameCost, (int64_t)0));
+    }
     withNonPresentThreadLock([&] {
         _newFrameQueue.push(newFrame);
     });
@@ -607,6 +631,8 @@ void OpenGLDisplayPlugin::present() {
         PROFILE_RANGE_EX(render, "updateFrameData", 0xff00ff00, frameId)
         updateFrameData();
     }
+    bool isNewFrame = _currentFrame && _currentFrame.get() != _lastFrame;
+    updateFramePacing(isNewFrame);
     incrementPresentCount();
 
     {
@@ -640,10 +666,58 @@ void OpenGLDisplayPlugin::present() {
             internalPresent();
         }
 
+        // The frame is on its way to the display once presented, the latency to the photons is measured up to here
+        uint64_t presentEnd = usecTimestampNow();
+        if (isNewFrame) {
+            uint64_t poseSampleTime = 0;
+            uint32_t frameIndex = _currentFrame->frameIndex;
+            withPresentThreadLock([&] {
+                auto itr = _poseSampleTimes.find(frameIndex);
+                if (itr != _poseSampleTimes.end()) {
+                    poseSampleTime = itr->second;
+                }
+                _poseSampleTimes.erase(_poseSampleTimes.begin(), _poseSampleTimes.upper_bound(frameIndex));
+            });
+            if (poseSampleTime > 0) {
+                _poseToPhotonLatency.updateAverage((float)(presentEnd - poseSampleTime) / USECS_PER_MSEC);
+            }
+        }
+        if (_poseLatchTime > 0) {
+            _latchedPoseToPhotonLatency.updateAverage((float)(presentEnd - _poseLatchTime) / USECS_PER_MSEC);
+            _poseLatchTime = 0;
+        }
+
         gpu::Backend::setFreeGPUMemory(gpu::gl::getFreeDedicatedMemory());
     }
 }
 
+void OpenGLDisplayPlugin::updateFramePacing(bool isNewFrame) {
+    int64_t frameStartDelay = 0;
+    float targetFrameRate = getTargetFrameRate();
+    if (_framePacing && targetFrameRate > 1.0f) {
+        int64_t framePeriod = (int64_t)(USECS_PER_SECOND / targetFrameRate);
+        // A paced frame that misses its present starts earlier from then on
+        if (!isNewFrame && _frameStartDelayUsecs > 0) {
+            _framePacingMargin = std::min(_framePacingMargin + FRAME_PACING_MARGIN_STEP_USECS, framePeriod);
+        } else {
+            const int64_t MARGIN_DECAY_USECS = FRAME_PACING_MARGIN_STEP_USECS / 100;
+            _framePacingMargin = std::max(_framePacingMargin - MARGIN_DECAY_USECS, MIN_FRAME_PACING_MARGIN_USECS);
+        }
+        frameStartDelay = framePeriod - (int64_t)_frameCostAverage.getAverage() - _framePacingMargin;
+        frameStartDelay = std::max(frameStartDelay, (int64_t)0);
+    }
+    _frameStartDelayUsecs = frameStartDelay;
+    _lastPresentStart = usecTimestampNow();
+}
+
+float OpenGLDisplayPlugin::poseToPhotonLatency() const {
+    return _poseToPhotonLatency.getSampleCount() > 0 ? _poseToPhotonLatency.getAverage() : -1.0f;
+}
+
+float OpenGLDisplayPlugin::latchedPoseToPhotonLatency() const {
+    return _latchedPoseToPhotonLatency.getSampleCount() > 0 ? _latchedPoseToPhotonLatency.getAverage() : -1.0f;
+}
+
 float OpenGLDisplayPlugin::newFramePresentRate() const {
     return _newFrameRate.rate();
 }
@@ -733,8 +807,11 @@ void OpenGLDisplayPlugin::assertIsPresentThread() const {
 }
 
 bool OpenGLDisplayPlugin::beginFrameRender(uint32_t frameIndex) {
+    // The plugins sample the pose of the frame before calling this
+    uint64_t poseSampleTime = usecTimestampNow();
     withNonPresentThreadLock([&] {
         _compositeOverlayAlpha = _overlayAlpha;
+        _poseSampleTimes[frameIndex] = poseSampleTime;
     });
     return Parent::beginFrameRender(frameIndex);
 }
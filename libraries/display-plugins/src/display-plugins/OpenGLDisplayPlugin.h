@@ -10,7 +10,9 @@
 #include "DisplayPlugin.h"
 #include <gl/Config.h>
 
+#include <atomic>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <queue>
 
@@ -67,6 +69,12 @@ public:
 
     float renderRate() const override;
 
+    float poseToPhotonLatency() const override;
+
+    float latchedPoseToPhotonLatency() const override;
+
+    int64_t getFrameStartDelayUsecs() const override { return _frameStartDelayUsecs; }
+
     bool beginFrameRender(uint32_t frameIndex) override;
 
     virtual bool wantVsync() const { return true; }
@@ -108,6 +116,7 @@ protected:
     void withMainThreadContext(std::function<void()> f) const;
 
     void present();
+    void updateFramePacing(bool isNewFrame);
     virtual void swapBuffers();
     ivec4 eyeViewport(Eye eye) const;
 
@@ -140,6 +149,21 @@ protected:
     std::map<uint16_t, CursorData> _cursorsData;
     bool _lockCurrentTexture { false };
 
+    // Set on the presentation thread by the plugins that late-latch the pose, when they sample it
+    uint64_t _poseLatchTime { 0 };
+
+    // The frames start late enough that they are submitted just before the next present. The main thread measures what
+    // it takes to submit a frame from a present, the margin over that grows when a present misses its new frame.
+    std::atomic<bool> _framePacing { false };
+    std::atomic<uint64_t> _lastPresentStart { 0 };
+    std::atomic<int64_t> _frameStartDelayUsecs { 0 };
+    SimpleMovingAverage _frameCostAverage;
+    int64_t _framePacingMargin { 0 };
+
+    std::map<uint32_t, uint64_t> _poseSampleTimes; // by frame index, serialized through the present mutex
+    SimpleMovingAverage _poseToPhotonLatency;
+    SimpleMovingAverage _latchedPoseToPhotonLatency;
+
     void assertNotPresentThread() const;
     void assertIsPresentThread() const;
 
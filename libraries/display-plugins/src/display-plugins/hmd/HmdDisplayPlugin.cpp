@@ -19,6 +19,7 @@
 #include <QtWidgets/QWidget>
 
 #include <GLMHelpers.h>
+#include <SharedUtil.h>
 #include <ui-plugins/PluginContainer.h>
 #include <CursorManager.h>
 #include <gl/GLWidget.h>
@@ -37,9 +38,11 @@
 
 static const QString MONO_PREVIEW = "Mono Preview";
 static const QString DISABLE_PREVIEW = "Disable Preview";
+static const QString FOVEATED_RENDERING = "Foveated Rendering";
 static const QString FRAMERATE = DisplayPlugin::MENU_PATH() + ">Framerate";
 static const QString DEVELOPER_MENU_PATH = "Developer>" + DisplayPlugin::MENU_PATH();
 static const bool DEFAULT_MONO_VIEW = true;
+static const bool DEFAULT_FOVEATED_RENDERING = false;
 #if !defined(Q_OS_MAC)
 static const bool DEFAULT_DISABLE_PREVIEW = false;
 #endif
@@ -97,6 +100,15 @@ bool HmdDisplayPlugin::internalActivate() {
         _container->setBoolSetting("monoPreview", _monoPreview);
     }, true, _monoPreview);
 
+    // Per plugin, the plugins have their own foveation
+    const QString foveatedRenderingSetting = getName() + "/foveatedRendering";
+    _foveatedRendering = _container->getBoolSetting(foveatedRenderingSetting, DEFAULT_FOVEATED_RENDERING);
+    _container->addMenuItem(PluginType::DISPLAY_PLUGIN, MENU_PATH(), FOVEATED_RENDERING,
+        [this, foveatedRenderingSetting](bool clicked) {
+        _foveatedRendering = clicked;
+        _container->setBoolSetting(foveatedRenderingSetting, _foveatedRendering);
+    }, true, _foveatedRendering);
+
 #if defined(Q_OS_MAC)
     _disablePreview = true;
 #else
@@ -123,6 +135,14 @@ void HmdDisplayPlugin::customizeContext() {
     Parent::customizeContext();
     _overlayRenderer.build();
 
+    // The pose is sampled again right before the frame is executed, the frame and everything composited on top of it
+    // use that pose rather than the one it was rendered with
+    _gpuContext->setPoseLatch([this](const gpu::Frame& frame) {
+        updatePresentPose();
+        _poseLatchTime = usecTimestampNow();
+        return _currentPresentFrameInfo.presentPose;
+    });
+
     {
         auto state = std::make_shared<gpu::State>();
         auto VS = gpu::Shader::createVertex(std::string(glowLine_vert));
@@ -160,6 +180,7 @@ void HmdDisplayPlugin::uncustomizeContext() {
     _handLaserUniforms[1].reset();
     _extraLaserUniforms.reset();
     _glowLinePipeline.reset();
+    _gpuContext->setPoseLatch(nullptr);
     Parent::uncustomizeContext();
 }
 
@@ -370,14 +391,7 @@ void HmdDisplayPlugin::updateFrameData() {
         });
     }
 
-    updatePresentPose();
-
-    if (_currentFrame) {
-        auto batchPose = _currentFrame->pose;
-        auto currentPose = _currentPresentFrameInfo.presentPose;
-        auto correction = glm::inverse(batchPose) * currentPose;
-        getGLBackend()->setCameraCorrection(correction);
-    }
+    // The present pose is latched right before the frame is executed, see customizeContext
 
     withPresentThreadLock([&] {
         _presentHandLasers = _handLasers;
@@ -36,6 +36,7 @@ public:
     QRect getRecommendedOverlayRect() const override final;
 
     virtual glm::mat4 getHeadPose() const override;
+    float getFoveationRadius() const override { return _foveatedRendering ? _foveationRadius : 0.0f; }
 
     bool setHandLaser(uint32_t hands, HandLaserMode mode, const vec4& color, const vec3& direction) override;
     bool setExtraLaser(HandLaserMode mode, const vec4& color, const glm::vec3& sensorSpaceStart, const vec3& sensorSpaceDirection) override;
@@ -96,6 +97,8 @@ protected:
     mat4 _cullingProjection;
     uvec2 _renderTargetSize;
     float _ipd { 0.064f };
+    // Around the center of the lenses, the plugins fit it to their HMD
+    float _foveationRadius { 0.6f };
 
     struct FrameInfo {
         mat4 renderPose;
@@ -117,6 +120,7 @@ private:
 
     bool _disablePreviewItemAdded { false };
     bool _monoPreview { true };
+    bool _foveatedRendering { false };
     bool _clearPreviewFlag { false };
     std::array<gpu::BufferPointer, 2> _handLaserUniforms;
     gpu::BufferPointer _extraLaserUniforms;
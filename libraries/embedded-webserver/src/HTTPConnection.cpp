@@ -9,27 +9,34 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <limits>
 
 #include <QBuffer>
 #include <QCryptographicHash>
 #include <QTcpSocket>
+#include <QThread>
 
 #include "HTTPConnection.h"
 #include "EmbeddedWebserverLogging.h"
 #include "HTTPManager.h"
 
 const char* HTTPConnection::StatusCode200 = "200 OK";
+const char* HTTPConnection::StatusCode206 = "206 Partial Content";
 const char* HTTPConnection::StatusCode301 = "301 Moved Permanently";
 const char* HTTPConnection::StatusCode302 = "302 Found";
+const char* HTTPConnection::StatusCode304 = "304 Not Modified";
 const char* HTTPConnection::StatusCode400 = "400 Bad Request";
 const char* HTTPConnection::StatusCode401 = "401 Unauthorized";
 const char* HTTPConnection::StatusCode403 = "403 Forbidden";
 const char* HTTPConnection::StatusCode404 = "404 Not Found";
+const char* HTTPConnection::StatusCode405 = "405 Method Not Allowed";
+const char* HTTPConnection::StatusCode416 = "416 Range Not Satisfiable";
 const char* HTTPConnection::StatusCode500 = "500 Internal server error";
 const char* HTTPConnection::DefaultContentType = "text/plain; charset=ISO-8859-1";
 
-HTTPConnection::HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager) :
-    QObject(parentManager),
+HTTPConnection::HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager, QObject* parent) :
+    QObject(parent ? parent : parentManager),
     _parentManager(parentManager),
     _socket(socket),
     _stream(socket),
@@ -40,8 +47,8 @@ HTTPConnection::HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager)
 
     // connect initial slots
     connect(socket, SIGNAL(readyRead()), SLOT(readRequest()));
-    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(deleteLater()));
-    connect(socket, SIGNAL(disconnected()), SLOT(deleteLater()));
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(socketClosed()));
+    connect(socket, SIGNAL(disconnected()), SLOT(socketClosed()));
 }
 
 HTTPConnection::~HTTPConnection() {
@@ -109,12 +116,99 @@ QList<FormData> HTTPConnection::parseFormData() const {
 }
 
 void HTTPConnection::respond(const char* code, const QByteArray& content, const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        queueResponse(code, content, nullptr, content.size(), contentType, headers);
+        return;
+    }
+
+    writeResponseHeaders(code, content.size(), contentType, headers);
+
+    if (content.size() > 0) {
+        _socket->write(content);
+    }
+
+    finishResponse();
+}
+
+void HTTPConnection::respondWithDevice(const char* code, std::unique_ptr<QIODevice> device, qint64 size,
+                                       const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        // the device is read from the connection's thread
+        device->moveToThread(thread());
+        queueResponse(code, QByteArray(), std::move(device), size, contentType, headers);
+        return;
+    }
+
+    writeResponseHeaders(code, size, contentType, headers);
+
+    // make sure we receive no further read notifications
+    _socket->disconnect(SIGNAL(readyRead()), this);
+
+    _responseDevice = std::move(device);
+    _isResponseChunked = size < 0;
+    _responseBytesLeft = _isResponseChunked ? std::numeric_limits<qint64>::max() : size;
+    connect(_socket, SIGNAL(bytesWritten(qint64)), SLOT(writeResponseContent()));
+    if (_isResponseChunked && _responseDevice->isSequential()) {
+        // more content may come later
+        connect(_responseDevice.get(), SIGNAL(readyRead()), SLOT(writeResponseContent()));
+    }
+    writeResponseContent();
+}
+
+void HTTPConnection::queueResponse(const char* code, const QByteArray& content, std::unique_ptr<QIODevice> device,
+                                   qint64 size, const char* contentType, const Headers& headers) {
+    // the code and the content type may not outlive this call, keep copies
+    _queuedResponse.code = code;
+    _queuedResponse.content = content;
+    _queuedResponse.device = std::move(device);
+    _queuedResponse.size = size;
+    _queuedResponse.contentType = contentType;
+    _queuedResponse.headers = headers;
+    QMetaObject::invokeMethod(this, "writeQueuedResponse", Qt::QueuedConnection);
+}
+
+void HTTPConnection::writeQueuedResponse() {
+    _isDispatched = false;
+
+    QueuedResponse response;
+    std::swap(response, _queuedResponse);
+    if (response.device) {
+        respondWithDevice(response.code.constData(), std::move(response.device), response.size,
+                          response.contentType.constData(), response.headers);
+    } else {
+        respond(response.code.constData(), response.content, response.contentType.constData(), response.headers);
+    }
+
+    if (_isSocketClosed) {
+        deleteLater();
+    }
+}
+
+void HTTPConnection::socketClosed() {
+    if (_isDispatched) {
+        // the manager's thread still has the connection, it goes once the response is given
+        _isSocketClosed = true;
+    } else {
+        deleteLater();
+    }
+}
+
+void HTTPConnection::dispatchRequest(const QUrl& url) {
+    if (thread() == _parentManager->thread() || _parentManager->getDispatchMode() == HTTPManager::DispatchMode::WorkerThread) {
+        _parentManager->handleHTTPRequest(this, url);
+    } else {
+        _isDispatched = true;
+        QMetaObject::invokeMethod(_parentManager, "handleDispatchedRequest", Qt::QueuedConnection,
+                                  Q_ARG(QObject*, this), Q_ARG(QUrl, url));
+    }
+}
+
+void HTTPConnection::writeResponseHeaders(const char* code, qint64 contentLength, const char* contentType,
+                                          const Headers& headers) {
     _socket->write("HTTP/1.1 ");
     _socket->write(code);
     _socket->write("\r\n");
 
-    int csize = content.size();
-
     for (Headers::const_iterator it = headers.constBegin(), end = headers.constEnd();
             it != end; it++) {
         _socket->write(it.key());
@@ -122,9 +216,13 @@ void HTTPConnection::respond(const char* code, const QByteArray& content, const
         _socket->write(it.value());
         _socket->write("\r\n");
     }
-    if (csize > 0) {
-        _socket->write("Content-Length: ");
-        _socket->write(QByteArray::number(csize));
+    if (contentLength != 0) {
+        if (contentLength > 0) {
+            _socket->write("Content-Length: ");
+            _socket->write(QByteArray::number(contentLength));
+        } else {
+            _socket->write("Transfer-Encoding: chunked");
+        }
         _socket->write("\r\n");
 
         _socket->write("Content-Type: ");
@@ -132,11 +230,48 @@ void HTTPConnection::respond(const char* code, const QByteArray& content, const
         _socket->write("\r\n");
     }
     _socket->write("Connection: close\r\n\r\n");
+}
 
-    if (csize > 0) {
-        _socket->write(content);
+void HTTPConnection::writeResponseContent() {
+    // the socket is kept a few reads ahead of the network, rather than buffering the whole content
+    const qint64 MAX_BYTES_TO_WRITE = 256 * 1024;
+    const qint64 READ_SIZE = 64 * 1024;
+
+    while (_responseBytesLeft > 0 && _socket->bytesToWrite() < MAX_BYTES_TO_WRITE) {
+        QByteArray content = _responseDevice->read(std::min(READ_SIZE, _responseBytesLeft));
+        if (content.isEmpty()) {
+            if (_isResponseChunked && _responseDevice->atEnd()) {
+                // the last chunk
+                _socket->write("0\r\n\r\n");
+                _responseBytesLeft = 0;
+                break;
+            } else if (_isResponseChunked && _responseDevice->isSequential()) {
+                // wait for the device to have more
+                return;
+            }
+            qWarning() << "Failed to read the content of the response." << _address;
+            _socket->abort();
+            return;
+        }
+        if (_isResponseChunked) {
+            _socket->write(QByteArray::number(content.size(), 16));
+            _socket->write("\r\n");
+            _socket->write(content);
+            _socket->write("\r\n");
+        } else {
+            _socket->write(content);
+            _responseBytesLeft -= content.size();
+        }
+    }
+
+    if (_responseBytesLeft == 0 && _responseDevice) {
+        _socket->disconnect(SIGNAL(bytesWritten(qint64)), this);
+        _responseDevice.reset();
+        finishResponse();
     }
+}
 
+void HTTPConnection::finishResponse() {
     // make sure we receive no further read notifications
     _socket->disconnect(SIGNAL(readyRead()), this);
 
@@ -189,7 +324,7 @@ void HTTPConnection::readHeaders() {
 
             QByteArray clength = _requestHeaders.value("Content-Length");
             if (clength.isEmpty()) {
-                _parentManager->handleHTTPRequest(this, _requestUrl);
+                dispatchRequest(_requestUrl);
 
             } else {
                 _requestContent.resize(clength.toInt());
@@ -221,12 +356,16 @@ void HTTPConnection::readHeaders() {
 }
 
 void HTTPConnection::readContent() {
+    // read the content as it arrives rather than letting the socket buffer all of it
     int size = _requestContent.size();
-    if (_socket->bytesAvailable() < size) {
+    qint64 bytesRead = _socket->read(_requestContent.data() + _requestContentRead, size - _requestContentRead);
+    if (bytesRead > 0) {
+        _requestContentRead += (int)bytesRead;
+    }
+    if (_requestContentRead < size) {
         return;
     }
-    _socket->read(_requestContent.data(), size);
     _socket->disconnect(this, SLOT(readContent()));
 
-    _parentManager->handleHTTPRequest(this, _requestUrl.path());
+    dispatchRequest(_requestUrl.path());
 }
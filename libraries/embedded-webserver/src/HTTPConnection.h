@@ -16,6 +16,8 @@
 #ifndef hifi_HTTPConnection_h
 #define hifi_HTTPConnection_h
 
+#include <memory>
+
 #include <QDataStream>
 #include <QHash>
 #include <QtNetwork/QHostAddress>
@@ -43,20 +45,24 @@ class HTTPConnection : public QObject {
 
 public:
     static const char* StatusCode200;
+    static const char* StatusCode206;
     static const char* StatusCode301;
     static const char* StatusCode302;
+    static const char* StatusCode304;
     static const char* StatusCode400;
     static const char* StatusCode401;
     static const char* StatusCode403;
     static const char* StatusCode404;
+    static const char* StatusCode405;
+    static const char* StatusCode416;
     static const char* StatusCode500;
     static const char* DefaultContentType;
 
     /// WebSocket close status codes.
     enum ReasonCode { NoReason = 0, NormalClosure = 1000, GoingAway = 1001 };
 
-    /// Initializes the connection.
-    HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager);
+    /// Initializes the connection, parented to the manager unless it is given the worker that owns it.
+    HTTPConnection (QTcpSocket* socket, HTTPManager* parentManager, QObject* parent = nullptr);
 
     /// Destroys the connection.
     virtual ~HTTPConnection ();
@@ -79,11 +85,18 @@ public:
     /// Parses the request content as form data, returning a list of header/content pairs.
     QList<FormData> parseFormData () const;
 
-    /// Sends a response and closes the connection.
+    /// Sends a response and closes the connection. Called from another thread than the connection's, the response is
+    /// written from the connection's thread.
     void respond (const char* code, const QByteArray& content = QByteArray(),
         const char* contentType = DefaultContentType,
         const Headers& headers = Headers());
 
+    /// Sends a response whose content is read from the device as the socket drains, for content too large to be
+    /// copied into the socket's buffer at once, and closes the connection once size bytes are sent. A negative size
+    /// sends the content chunked until the end of the device. The device must have no parent.
+    void respondWithDevice(const char* code, std::unique_ptr<QIODevice> device, qint64 size,
+        const char* contentType = DefaultContentType, const Headers& headers = Headers());
+
 protected slots:
 
     /// Reads the request line.
@@ -95,8 +108,30 @@ protected slots:
     /// Reads the content.
     void readContent ();
 
+    /// Writes the next part of the content of a response sent from a device.
+    void writeResponseContent ();
+
+    /// Writes the response given from another thread.
+    void writeQueuedResponse ();
+
+    /// Deletes the connection once no other thread is handling its request.
+    void socketClosed ();
+
 protected:
 
+    /// Hands the request to the manager, on the manager's thread unless its handler is thread-safe.
+    void dispatchRequest (const QUrl& url);
+
+    /// Keeps a response given from another thread until the connection's thread writes it.
+    void queueResponse (const char* code, const QByteArray& content, std::unique_ptr<QIODevice> device, qint64 size,
+        const char* contentType, const Headers& headers);
+
+    /// Writes the status line and the headers of a response.
+    void writeResponseHeaders (const char* code, qint64 contentLength, const char* contentType, const Headers& headers);
+
+    /// Stops reading the request and closes the connection once the response is sent.
+    void finishResponse ();
+
     /// The parent HTTP manager
     HTTPManager* _parentManager;
 
@@ -121,8 +156,29 @@ protected:
     /// The last request header processed (used for continuations).
     QByteArray _lastRequestHeader;
 
-    /// The content of the request.
+    /// The content of the request, and the number of its bytes read so far.
     QByteArray _requestContent;
+    int _requestContentRead { 0 };
+
+    /// The device the content of the response is read from, and the number of its bytes left to send.
+    std::unique_ptr<QIODevice> _responseDevice;
+    qint64 _responseBytesLeft { 0 };
+    bool _isResponseChunked { false };
+
+    /// Whether the manager's thread is handling the request, and whether the socket closed meanwhile.
+    bool _isDispatched { false };
+    bool _isSocketClosed { false };
+
+    /// A response given from another thread.
+    struct QueuedResponse {
+        QByteArray code;
+        QByteArray content;
+        std::unique_ptr<QIODevice> device;
+        qint64 size { 0 };
+        QByteArray contentType;
+        Headers headers;
+    };
+    QueuedResponse _queuedResponse;
 };
 
 #endif // hifi_HTTPConnection_h
@@ -37,16 +37,63 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _isListeningTimer->start(SOCKET_CHECK_INTERVAL_IN_MS);
 }
 
+HTTPManager::~HTTPManager() {
+    for (int i = 0; i < _workerThreads.size(); i++) {
+        _workerThreads[i]->quit();
+        _workerThreads[i]->wait();
+
+        // the thread is stopped, its connections can go from here
+        delete _workers[i];
+    }
+}
+
+void HTTPManager::setWorkerThreads(int numThreads, DispatchMode dispatchMode) {
+    qRegisterMetaType<qintptr>("qintptr");
+
+    _dispatchMode = dispatchMode;
+    for (int i = _workerThreads.size(); i < numThreads; i++) {
+        QThread* thread = new QThread(this);
+        thread->setObjectName(QString("HTTP Worker %1").arg(_port));
+
+        HTTPWorker* worker = new HTTPWorker(this);
+        worker->moveToThread(thread);
+        thread->start();
+
+        _workerThreads.append(thread);
+        _workers.append(worker);
+    }
+}
+
+void HTTPWorker::addConnection(qintptr socketDescriptor) {
+    _manager->createConnection(socketDescriptor, this);
+}
+
 void HTTPManager::incomingConnection(qintptr socketDescriptor) {
-    QTcpSocket* socket = new QTcpSocket(this);
+    if (_workers.isEmpty()) {
+        createConnection(socketDescriptor, this);
+    } else {
+        // the socket is created on the worker thread, which will read it
+        HTTPWorker* worker = _workers[_nextWorker];
+        _nextWorker = (_nextWorker + 1) % _workers.size();
+        QMetaObject::invokeMethod(worker, "addConnection", Qt::QueuedConnection, Q_ARG(qintptr, socketDescriptor));
+    }
+}
+
+HTTPConnection* HTTPManager::createConnection(qintptr socketDescriptor, QObject* parent) {
+    QTcpSocket* socket = new QTcpSocket(parent);
     
     if (socket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPConnection(socket, this);
+        return new HTTPConnection(socket, this, parent);
     } else {
         delete socket;
+        return nullptr;
     }
 }
 
+void HTTPManager::handleDispatchedRequest(QObject* connection, QUrl url) {
+    handleHTTPRequest(static_cast<HTTPConnection*>(connection), url);
+}
+
 bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
     if (!skipSubHandler && requestHandledByRequestHandler(connection, url)) {
         // this request was handled by our request handler object
@@ -98,12 +145,25 @@ bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url,
             // file exists, serve it
             static QMimeDatabase mimeDatabase;
             
+            QFileInfo localFileInfo(filePath);
+
+            if (localFileInfo.suffix() != "shtml") {
+                // stream the file from the connection's thread rather than reading it all in memory
+                std::unique_ptr<QFile> streamedFile { new QFile(filePath) };
+                if (streamedFile->open(QIODevice::ReadOnly)) {
+                    qint64 size = streamedFile->size();
+                    connection->respondWithDevice(HTTPConnection::StatusCode200, std::move(streamedFile), size,
+                                                  qPrintable(mimeDatabase.mimeTypeForFile(filePath).name()));
+                } else {
+                    connection->respond(HTTPConnection::StatusCode500, "Could not read the resource.");
+                }
+                return true;
+            }
+
             QFile localFile(filePath);
             localFile.open(QIODevice::ReadOnly);
             QByteArray localFileData = localFile.readAll();
             
-            QFileInfo localFileInfo(filePath);
-            
             if (localFileInfo.completeSuffix() == "shtml") {
                 // this is a file that may have some SSI statements
                 // the only thing we support is the include directive, but check the contents for that
@@ -147,13 +207,8 @@ bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url,
                 localFileData = localFileString.toLocal8Bit();
             }
 
-            // if this is an shtml file just make the MIME type match HTML so browsers aren't confused
-            // otherwise use the mimeDatabase to look it up
-            auto mimeType = localFileInfo.suffix() == "shtml"
-                ? QString { "text/html" }
-                : mimeDatabase.mimeTypeForFile(filePath).name();
-
-            connection->respond(HTTPConnection::StatusCode200, localFileData, qPrintable(mimeType));
+            // this is an shtml file, just make the MIME type match HTML so browsers aren't confused
+            connection->respond(HTTPConnection::StatusCode200, localFileData, "text/html");
             
             return true;
         }
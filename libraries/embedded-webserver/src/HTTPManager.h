@@ -17,10 +17,13 @@
 #define hifi_HTTPManager_h
 
 #include <QtNetwork/QTcpServer>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
 
 class HTTPConnection;
 class HTTPSConnection;
+class HTTPManager;
 
 class HTTPRequestHandler {
 public:
@@ -28,32 +31,70 @@ public:
     virtual bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) = 0;
 };
 
+/// Owns the connections handed to one of the worker threads of an HTTPManager.
+class HTTPWorker : public QObject {
+    Q_OBJECT
+public:
+    HTTPWorker(HTTPManager* manager) : _manager(manager) {}
+
+public slots:
+    void addConnection(qintptr socketDescriptor);
+
+private:
+    HTTPManager* _manager;
+};
+
 /// Handles HTTP connections
 class HTTPManager : public QTcpServer, public HTTPRequestHandler {
    Q_OBJECT
 public:
+    /// Where the request handler is called once a request is read by a worker thread.
+    enum class DispatchMode {
+        OwningThread, // on the thread of the manager, the responses are written back from the worker thread
+        WorkerThread // on the worker thread itself, for request handlers that are thread-safe
+    };
+
     /// Initializes the manager.
     HTTPManager(const QHostAddress& listenAddress, quint16 port, const QString& documentRoot, HTTPRequestHandler* requestHandler = NULL, QObject* parent = 0);
+    ~HTTPManager();
+
+    /// Moves the connections accepted from now on to numThreads worker threads, which parse the requests, read their
+    /// content and stream the responses, so slow clients and large transfers don't hold the thread of the manager.
+    void setWorkerThreads(int numThreads, DispatchMode dispatchMode = DispatchMode::OwningThread);
+    DispatchMode getDispatchMode() const { return _dispatchMode; }
     
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
 private slots:
     void isTcpServerListening();
     void queuedExit(QString errorMessage);
+
+    /// Handles a request read by a worker thread, on the thread of the manager.
+    void handleDispatchedRequest(QObject* connection, QUrl url);
     
 private:
+    friend class HTTPWorker;
+
     bool bindSocket();
     
 protected:
     /// Accepts all pending connections
     virtual void incomingConnection(qintptr socketDescriptor) override;
     virtual bool requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url);
+
+    /// Creates the connection for an accepted socket on the current thread, null if the socket can't be used.
+    virtual HTTPConnection* createConnection(qintptr socketDescriptor, QObject* parent);
     
     QHostAddress _listenAddress;
     QString _documentRoot;
     HTTPRequestHandler* _requestHandler;
     QTimer* _isListeningTimer;
     const quint16 _port;
+
+    QVector<QThread*> _workerThreads;
+    QVector<HTTPWorker*> _workers;
+    int _nextWorker { 0 };
+    DispatchMode _dispatchMode { DispatchMode::OwningThread };
 };
 
 #endif // hifi_HTTPManager_h
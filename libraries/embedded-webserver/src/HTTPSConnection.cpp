@@ -12,8 +12,8 @@
 #include "EmbeddedWebserverLogging.h"
 #include "HTTPSConnection.h"
 
-HTTPSConnection::HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager) :
-    HTTPConnection(sslSocket, parentManager)
+HTTPSConnection::HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager, QObject* parent) :
+    HTTPConnection(sslSocket, parentManager, parent)
 {
     connect(sslSocket, SIGNAL(sslErrors(const QList<QSslError>&)), this, SLOT(handleSSLErrors(const QList<QSslError>&)));
     sslSocket->startServerEncryption();
@@ -18,7 +18,7 @@
 class HTTPSConnection : public HTTPConnection {
     Q_OBJECT
 public:
-    HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager);
+    HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager, QObject* parent = nullptr);
 protected slots:
     void handleSSLErrors(const QList<QSslError>& errors);
 };
@@ -25,17 +25,18 @@ HTTPSManager::HTTPSManager(QHostAddress listenAddress, quint16 port, const QSslC
     
 }
 
-void HTTPSManager::incomingConnection(qintptr socketDescriptor) {
-    QSslSocket* sslSocket = new QSslSocket(this);
+HTTPConnection* HTTPSManager::createConnection(qintptr socketDescriptor, QObject* parent) {
+    QSslSocket* sslSocket = new QSslSocket(parent);
     
     sslSocket->setLocalCertificate(_certificate);
     sslSocket->setPrivateKey(_privateKey);
     sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
     
     if (sslSocket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPSConnection(sslSocket, this);
+        return new HTTPSConnection(sslSocket, this, parent);
     } else {
         delete sslSocket;
+        return nullptr;
     }
 }
 
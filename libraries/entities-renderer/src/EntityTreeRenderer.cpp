@@ -76,6 +76,9 @@ EntityTreeRenderer::EntityTreeRenderer(bool wantScripts, AbstractViewStateInterf
 EntityTreeRenderer::~EntityTreeRenderer() {
     // NOTE: We don't need to delete _entitiesScriptEngine because
     //       it is registered with ScriptEngines, which will call deleteLater for us.
+    if (_tree && _zonePropertiesSubscription != -1) {
+        std::static_pointer_cast<EntityTree>(_tree)->unsubscribeFromPropertyChanges(_zonePropertiesSubscription);
+    }
 }
 
 int EntityTreeRenderer::_entitiesScriptEngineCount = 0;
@@ -139,6 +142,9 @@ void EntityTreeRenderer::clear() {
 
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
+    _containingZoneIDs.clear();
+    _zoneCellCandidates.clear();
+    invalidateZoneCell();
     applyZoneAndHasSkybox(nullptr);
 
     OctreeRenderer::clear();
@@ -169,6 +175,26 @@ void EntityTreeRenderer::init() {
     connect(entityTree.get(), &EntityTree::addingEntity, this, &EntityTreeRenderer::addingEntity, Qt::QueuedConnection);
     connect(entityTree.get(), &EntityTree::entityScriptChanging,
             this, &EntityTreeRenderer::entityScriptChanging, Qt::QueuedConnection);
+
+    // every property but those only scripts and editors read, an edit of nothing else leaves the zones as they are
+    EntityPropertyFlags zoneProperties;
+    for (int property = PROP_PAGED_PROPERTY; property < PROP_AFTER_LAST_ITEM; property++) {
+        zoneProperties += (EntityPropertyList)property;
+    }
+    zoneProperties -= PROP_SCRIPT;
+    zoneProperties -= PROP_SCRIPT_TIMESTAMP;
+    zoneProperties -= PROP_SERVER_SCRIPTS;
+    zoneProperties -= PROP_NAME;
+    zoneProperties -= PROP_DESCRIPTION;
+    zoneProperties -= PROP_HREF;
+    zoneProperties -= PROP_MARKETPLACE_ID;
+    zoneProperties -= PROP_LOCKED;
+    zoneProperties -= PROP_LAST_EDITED_BY;
+    zoneProperties -= PROP_COLLISION_SOUND_URL;
+    _zonePropertiesSubscription = entityTree->subscribeToPropertyChanges(zoneProperties,
+        [this](const EntityPropertyChanges& changes) {
+            zonePropertiesChanged(changes);
+        });
 }
 
 void EntityTreeRenderer::shutdown() {
@@ -210,52 +236,99 @@ void EntityTreeRenderer::update() {
             _entitiesScriptEngine->callEntityScriptMethod(_currentClickingOnEntityID, "holdingClickOnEntity", _lastPointerEvent);
         }
 
+        updateLoadingModels();
     }
     deleteReleasedModels();
 }
 
+void EntityTreeRenderer::updateLoadingModels() {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    tree->withReadLock([&] {
+        for (auto it = _entityModels.begin(); it != _entityModels.end();) {
+            auto model = it.value().lock();
+            EntityItemPointer entity = model ? tree->findEntityByEntityItemID(it.key()) : EntityItemPointer();
+            if (!entity) {
+                it = _entityModels.erase(it);
+                continue;
+            }
+
+            if (!model->isLoaded()) {
+                bool success;
+                AABox box = entity->getAABox(success);
+                if (!success || _viewFrustum.boxIntersectsKeyhole(box)) {
+                    model->setLoadingPriority(getEntityLoadingPriority(*entity));
+                } else {
+                    model->cancelLoading();
+                }
+            }
+            it++;
+        }
+    });
+}
+
+bool EntityTreeRenderer::isZoneCellCandidate(const EntityItemPointer& entity) const {
+    // only zones and entities with scripts can have events fired on them
+    // FIXME - this could be optimized further by determining if the script is loaded
+    // and if it has either an enterEntity or leaveEntity method
+    return entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty();
+}
+
 bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar) {
     bool didUpdate = false;
-    float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<EntityItemPointer> foundEntities;
 
-    // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
+        glm::ivec3 cell = glm::ivec3(glm::floor(_avatarPosition / ZONE_CELL_SIZE));
+        quint64 now = usecTimestampNow();
+        if (!_isZoneCellValid || cell != _zoneCell || now - _lastZoneCellRefresh > ZONE_CELL_REFRESH_INTERVAL) {
+            QVector<EntityItemPointer> foundEntities;
+            std::static_pointer_cast<EntityTree>(_tree)->findEntities(AACube(glm::vec3(cell) * ZONE_CELL_SIZE, ZONE_CELL_SIZE),
+                                                                      foundEntities);
+            _zoneCellCandidates.clear();
+            for (auto& entity : foundEntities) {
+                if (isZoneCellCandidate(entity)) {
+                    _zoneCellCandidates.push_back(entity);
+                }
+            }
+            _zoneCell = cell;
+            _isZoneCellValid = true;
+            _lastZoneCellRefresh = now;
+        }
 
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        std::static_pointer_cast<EntityTree>(_tree)->findEntities(_avatarPosition, radius, foundEntities);
-
-        LayeredZones oldLayeredZones(std::move(_layeredZones));
-        _layeredZones.clear();
-
-        // create a list of entities that actually contain the avatar's position
-        for (auto& entity : foundEntities) {
-            auto isZone = entity->getType() == EntityTypes::Zone;
-            auto hasScript = !entity->getScript().isEmpty();
-
-            // only consider entities that are zones or have scripts, all other entities can
-            // be ignored because they can have events fired on them.
-            // FIXME - this could be optimized further by determining if the script is loaded
-            // and if it has either an enterEntity or leaveEntity method
-            if (isZone || hasScript) {
-                // now check to see if the point contains our entity, this can be expensive if
-                // the entity has a collision hull
-                if (entity->contains(_avatarPosition)) {
-                    if (entitiesContainingAvatar) {
-                        *entitiesContainingAvatar << entity->getEntityItemID();
-                    }
+        // the candidates that actually contain the avatar's position
+        std::set<LayeredZone> containingZones;
+        for (auto& entity : _zoneCellCandidates) {
+            // this can be expensive if the entity has a collision hull
+            if (entity->contains(_avatarPosition)) {
+                if (entitiesContainingAvatar) {
+                    *entitiesContainingAvatar << entity->getEntityItemID();
+                }
 
-                    // if this entity is a zone and visible, determine if it is the bestZone
-                    if (isZone && entity->getVisible()) {
-                        auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
-                        _layeredZones.insert(zone);
-                    }
+                // if this entity is a zone and visible, it is a layer of the zones
+                if (entity->getType() == EntityTypes::Zone && entity->getVisible()) {
+                    containingZones.insert(std::static_pointer_cast<ZoneEntityItem>(entity));
                 }
             }
         }
 
-        // check if our layered zones have changed
+        // nothing to apply while the same zones contain the avatar, their edits are applied as they come
+        QVector<EntityItemID> containingZoneIDs;
+        containingZoneIDs.reserve((int)containingZones.size());
+        for (auto& layer : containingZones) {
+            containingZoneIDs.push_back(layer.id);
+        }
+        if (containingZoneIDs == _containingZoneIDs) {
+            return;
+        }
+        _containingZoneIDs = containingZoneIDs;
+
+        LayeredZones oldLayeredZones(std::move(_layeredZones));
+        _layeredZones.clear();
+        for (auto& layer : containingZones) {
+            _layeredZones.insert(layer);
+        }
+
+        // check if the layers that are applied have changed
         if (_layeredZones.empty()) {
             if (oldLayeredZones.empty()) {
                 return;
@@ -538,7 +611,16 @@ ModelPointer EntityTreeRenderer::getModelForEntityItem(EntityItemPointer entityI
 }
 
 void EntityTreeRenderer::processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode) {
-    std::static_pointer_cast<EntityTree>(_tree)->processEraseMessage(message, sourceNode);
+    // erased after the entity packets that came before it, which could otherwise add the entities back
+    const int ERASE_HEADER_BYTES = sizeof(OCTREE_PACKET_FLAGS) + sizeof(OCTREE_PACKET_SEQUENCE) + sizeof(OCTREE_PACKET_SENT_TIME);
+    if (message.getSize() < ERASE_HEADER_BYTES + (int)sizeof(uint16_t)) {
+        return;
+    }
+    QByteArray erasedIDs(message.getRawMessage() + ERASE_HEADER_BYTES, message.getSize() - ERASE_HEADER_BYTES);
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    applyInOrder([tree, erasedIDs, sourceNode] {
+        tree->processEraseMessageDetails(erasedIDs, sourceNode);
+    });
 }
 
 ModelPointer EntityTreeRenderer::allocateModel(const QString& url, float loadingPriority, SpatiallyNestable* spatiallyNestableOverride) {
@@ -557,6 +639,9 @@ ModelPointer EntityTreeRenderer::allocateModel(const QString& url, float loading
     model->setLoadingPriority(loadingPriority);
     model->init();
     model->setURL(QUrl(url));
+    if (spatiallyNestableOverride) {
+        _entityModels.insert(spatiallyNestableOverride->getID(), model);
+    }
     return model;
 }
 
@@ -945,6 +1030,12 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
     }
 
     forceRecheckEntities(); // reset our state to force checking our inside/outsideness of entities
+    for (auto& candidate : _zoneCellCandidates) {
+        if (candidate->getEntityItemID() == entityID) {
+            invalidateZoneCell();
+            break;
+        }
+    }
 
     // here's where we remove the entity payload from the scene
     if (_entitiesInScene.contains(entityID)) {
@@ -965,6 +1056,9 @@ void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
     checkAndCallPreload(entityID);
     auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
     if (entity) {
+        if (isZoneCellCandidate(entity)) {
+            invalidateZoneCell();
+        }
         addEntityToScene(entity);
     }
 }
@@ -985,6 +1079,9 @@ void EntityTreeRenderer::addEntityToScene(EntityItemPointer entity) {
 
 
 void EntityTreeRenderer::entityScriptChanging(const EntityItemID& entityID, const bool reload) {
+    // an entity with a script may have gained or lost it
+    invalidateZoneCell();
+    forceRecheckEntities();
     checkAndCallPreload(entityID, reload, true);
 }
 
@@ -1095,6 +1192,35 @@ void EntityTreeRenderer::updateEntityRenderStatus(bool shouldRenderEntities) {
     }
 }
 
+void EntityTreeRenderer::zonePropertiesChanged(const EntityPropertyChanges& changes) {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    for (const auto& change : changes) {
+        auto entity = tree->findEntityByEntityItemID(change.entityID);
+        if (!entity || !isZoneCellCandidate(entity)) {
+            continue;
+        }
+        // the edit may have moved it into the cell of the avatar or out of it, or changed what contains the avatar
+        invalidateZoneCell();
+        forceRecheckEntities();
+
+        auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
+        if (!zone) {
+            continue;
+        }
+        // the user data of a zone is only rendered as the code of its procedural skybox
+        EntityPropertyFlags renderedProperties = change.changedProperties;
+        if (zone->getBackgroundMode() != BACKGROUND_MODE_SKYBOX) {
+            renderedProperties -= PROP_USER_DATA;
+        }
+        if (!renderedProperties) {
+            continue;
+        }
+        if (zone->contains(_avatarPosition)) {
+            _layeredZones.update(zone);
+        }
+    }
+}
+
 void EntityTreeRenderer::updateZone(const EntityItemID& id) {
     // Get in the zone!
     auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(getTree()->findEntityByEntityItemID(id));
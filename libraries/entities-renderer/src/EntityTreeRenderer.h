@@ -138,6 +138,7 @@ protected:
     virtual OctreePointer createTree() override {
         EntityTreePointer newTree = EntityTreePointer(new EntityTree(true));
         newTree->createRootElement();
+        newTree->setWantSpatialIndex(true); // the picks and finds of scripts are served from the index
         return newTree;
     }
 
@@ -147,13 +148,19 @@ private:
     void addEntityToScene(EntityItemPointer entity);
     bool findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar = nullptr);
 
+    // re-applies the zones whose rendered properties were edited
+    void zonePropertiesChanged(const EntityPropertyChanges& changes);
     bool applyZoneAndHasSkybox(const std::shared_ptr<ZoneEntityItem>& zone);
     bool layerZoneAndHasSkybox(const std::shared_ptr<ZoneEntityItem>& zone);
     bool applySkyboxAndHasAmbient();
 
     void checkAndCallPreload(const EntityItemID& entityID, const bool reload = false, const bool unloadFirst = false);
 
+    // refreshes the loading priorities of the models that are loading from the view, and cancels those out of it
+    void updateLoadingModels();
+
     QList<ModelPointer> _releasedModels;
+    QHash<EntityItemID, ModelWeakPointer> _entityModels; // of the models allocated for entities
     RayToEntityIntersectionResult findRayIntersectionWorker(const PickRay& ray, Octree::lockType lockType,
                                                                 bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude = QVector<EntityItemID>(),
                                                                 const QVector<EntityItemID>& entityIdsToDiscard = QVector<EntityItemID>(), bool visibleOnly=false,
@@ -166,10 +173,21 @@ private:
     bool checkEnterLeaveEntities();
     void leaveAllEntities();
     void forceRecheckEntities();
+    // the zones and scripted entities near the avatar are to be found again, their set or their volumes changed
+    void invalidateZoneCell() { _isZoneCellValid = false; }
+    bool isZoneCellCandidate(const EntityItemPointer& entity) const;
 
     glm::vec3 _avatarPosition { 0.0f };
     QVector<EntityItemID> _currentEntitiesInside;
 
+    // The zones and scripted entities whose bounds touch the cell the avatar is in, so that the checks while it stays in
+    // the cell only test whether those contain it. Found again when the avatar leaves the cell or one of them is edited.
+    glm::ivec3 _zoneCell;
+    bool _isZoneCellValid { false };
+    quint64 _lastZoneCellRefresh { 0 };
+    QVector<EntityItemPointer> _zoneCellCandidates;
+    QVector<EntityItemID> _containingZoneIDs; // the visible zones containing the avatar as last layered, in layer order
+
     bool _wantScripts;
     QSharedPointer<ScriptEngine> _entitiesScriptEngine;
 
@@ -230,6 +248,7 @@ private:
     };
 
     LayeredZones _layeredZones;
+    int _zonePropertiesSubscription { -1 };
     QString _zoneUserData;
     NetworkTexturePointer _ambientTexture;
     NetworkTexturePointer _skyboxTexture;
@@ -241,6 +260,9 @@ private:
     quint64 _lastZoneCheck { 0 };
     const quint64 ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
+    const float ZONE_CELL_SIZE = 4.0f; // meters
+    // entities can also move into the cell without an edit, following a parent or their local simulation
+    const quint64 ZONE_CELL_REFRESH_INTERVAL = USECS_PER_SECOND;
 
     QHash<EntityItemID, EntityItemPointer> _entitiesInScene;
     // For Scene.shouldRenderEntities
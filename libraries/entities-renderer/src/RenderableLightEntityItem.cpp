@@ -18,7 +18,7 @@
 #include "RenderableLightEntityItem.h"
 
 EntityItemPointer RenderableLightEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableLightEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableLightEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
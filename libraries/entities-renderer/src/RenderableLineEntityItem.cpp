@@ -19,7 +19,7 @@
 #include "RenderableLineEntityItem.h"
 
 EntityItemPointer RenderableLineEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableLineEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableLineEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
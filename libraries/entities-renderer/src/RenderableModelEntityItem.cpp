@@ -33,7 +33,8 @@ static CollisionRenderMeshCache collisionMeshCache;
 
 
 EntityItemPointer RenderableModelEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableModelEntityItem(entityID, properties.getDimensionsInitialized()) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableModelEntityItem>(entityID,
+        properties.getDimensionsInitialized());
     entity->setProperties(properties);
     return entity;
 }
@@ -8,6 +8,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <glm/gtx/quaternion.hpp>
 
 #include <DependencyManager.h>
@@ -22,6 +24,122 @@
 #include "untextured_particle_frag.h"
 #include "textured_particle_vert.h"
 #include "textured_particle_frag.h"
+#include "particle_simulation_comp.h"
+
+// Must match the local size in particle_simulation.slc
+static const uint32_t PARTICLE_SIMULATION_GROUP_SIZE = 64;
+// The size of a particle in the simulation buffer, the position and lifetime then the seed are where the particle
+// shaders read them as for the particles simulated on the CPU
+static const size_t GPU_PARTICLE_SIZE = 3 * sizeof(glm::vec4);
+
+static const int PARTICLE_SIMULATION_PARTICLES_SLOT = 0;
+static const int PARTICLE_SIMULATION_EMITTER_SLOT = 0;
+static const int PARTICLE_SIMULATION_STEP_SLOT = 1;
+
+std::atomic<bool> GPUParticleSimulation::_isSupported { false };
+GPUParticleSimulation::Mutex GPUParticleSimulation::_mutex;
+std::vector<GPUParticleSimulation::Pointer> GPUParticleSimulation::_simulationsWithPendingSteps;
+gpu::PipelinePointer GPUParticleSimulation::_pipeline;
+
+void GPUParticleSimulation::queueStep(const Pointer& simulation, const Step& step) {
+    Lock lock(_mutex);
+    if (simulation->_pendingSteps.empty()) {
+        _simulationsWithPendingSteps.push_back(simulation);
+    }
+    simulation->_pendingSteps.push_back(step);
+}
+
+void GPUParticleSimulation::recordSteps(gpu::Batch& batch, bool supportsComputeShaders) {
+    _isSupported = supportsComputeShaders;
+
+    std::vector<std::pair<Pointer, std::vector<Step>>> simulations;
+    {
+        Lock lock(_mutex);
+        for (auto& simulation : _simulationsWithPendingSteps) {
+            simulations.emplace_back(simulation, std::move(simulation->_pendingSteps));
+            simulation->_pendingSteps.clear();
+        }
+        _simulationsWithPendingSteps.clear();
+    }
+    if (simulations.empty() || !supportsComputeShaders) {
+        return;
+    }
+
+    if (!_pipeline) {
+        auto cs = gpu::Shader::createCompute(std::string(particle_simulation_comp));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(cs);
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("emitterBuffer"), PARTICLE_SIMULATION_EMITTER_SLOT));
+        slotBindings.insert(gpu::Shader::Binding(std::string("stepBuffer"), PARTICLE_SIMULATION_STEP_SLOT));
+        gpu::Shader::makeProgram(*program, slotBindings);
+        _pipeline = gpu::Pipeline::create(program, std::make_shared<gpu::State>());
+    }
+
+    for (const auto& simulation : simulations) {
+        simulation.first->recordDispatches(batch, _pipeline, simulation.second);
+    }
+    batch.setResourceBuffer(PARTICLE_SIMULATION_PARTICLES_SLOT, nullptr);
+}
+
+void GPUParticleSimulation::recordDispatches(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const std::vector<Step>& steps) {
+    batch.setPipeline(pipeline);
+    for (size_t i = 0; i < steps.size(); i++) {
+        const auto& step = steps[i];
+
+        // The ring is restarted when its size changes, the particles alive were all emitted since
+        uint32_t numParticles = step.uniforms.emission.z;
+        if (!_particlesBuffer || numParticles != _numParticles) {
+            _particlesBuffer = std::make_shared<gpu::Buffer>();
+            _particlesBuffer->resize(numParticles * GPU_PARTICLE_SIZE);
+            _numParticles = numParticles;
+        }
+        if (step.hasEmitterChanged || !_emitterBuffer._buffer) {
+            if (!_emitterBuffer._buffer) {
+                EmitterUniforms emitter;
+                _emitterBuffer = std::make_shared<gpu::Buffer>(sizeof(EmitterUniforms), (const gpu::Byte*)&emitter);
+            }
+            _emitterBuffer.edit<EmitterUniforms>() = step.emitter;
+        }
+        if (i >= _stepBuffers.size()) {
+            _stepBuffers.push_back(std::make_shared<gpu::Buffer>());
+        }
+        _stepBuffers[i]->setData(sizeof(StepUniforms), (const gpu::Byte*)&step.uniforms);
+
+        _firstAlive = step.firstAlive;
+        _numAlive = step.numAlive;
+        if (numParticles == 0) {
+            continue;
+        }
+
+        batch.setResourceBuffer(PARTICLE_SIMULATION_PARTICLES_SLOT, _particlesBuffer);
+        batch.setUniformBuffer(PARTICLE_SIMULATION_EMITTER_SLOT, _emitterBuffer);
+        batch.setUniformBuffer(PARTICLE_SIMULATION_STEP_SLOT, _stepBuffers[i], 0, sizeof(StepUniforms));
+        batch.dispatch((numParticles + PARTICLE_SIMULATION_GROUP_SIZE - 1) / PARTICLE_SIMULATION_GROUP_SIZE);
+    }
+}
+
+void GPUParticleSimulation::render(gpu::Batch& batch) const {
+    if (!_particlesBuffer || _numAlive == 0) {
+        return;
+    }
+
+    // The live particles wrap around the end of the ring
+    static const uint32_t VERTEX_PER_PARTICLE = 4;
+    uint32_t numFirstParticles = std::min(_numAlive, _numParticles - _firstAlive);
+    batch.setInputBuffer(0, _particlesBuffer, _firstAlive * GPU_PARTICLE_SIZE, GPU_PARTICLE_SIZE);
+    batch.drawInstanced(numFirstParticles, gpu::TRIANGLE_STRIP, VERTEX_PER_PARTICLE);
+    if (numFirstParticles < _numAlive) {
+        batch.setInputBuffer(0, _particlesBuffer, 0, GPU_PARTICLE_SIZE);
+        batch.drawInstanced(_numAlive - numFirstParticles, gpu::TRIANGLE_STRIP, VERTEX_PER_PARTICLE);
+    }
+}
+
+void SimulateGPUParticles::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext) {
+    RenderArgs* args = renderContext->args;
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        GPUParticleSimulation::recordSteps(batch, args->_context->supportsComputeShaders());
+    });
+}
 
 
 class ParticlePayloadData {
@@ -89,6 +207,9 @@ public:
 
     bool getVisibleFlag() const { return _visibleFlag; }
     void setVisibleFlag(bool visibleFlag) { _visibleFlag = visibleFlag; }
+
+    // When set, the particles are drawn from it rather than from the particle buffer
+    void setGPUSimulation(const GPUParticleSimulation::Pointer& simulation) { _gpuSimulation = simulation; }
     
     void render(RenderArgs* args) const {
         assert(_pipeline);
@@ -103,6 +224,10 @@ public:
         batch.setModelTransform(_modelTransform);
         batch.setUniformBuffer(0, _uniformBuffer);
         batch.setInputFormat(_vertexFormat);
+        if (_gpuSimulation) {
+            _gpuSimulation->render(batch);
+            return;
+        }
         batch.setInputBuffer(0, _particleBuffer, 0, sizeof(ParticlePrimitive));
 
         auto numParticles = _particleBuffer->getSize() / sizeof(ParticlePrimitive);
@@ -118,6 +243,7 @@ protected:
     BufferView _uniformBuffer;
     TexturePointer _texture;
     bool _visibleFlag = true;
+    GPUParticleSimulation::Pointer _gpuSimulation;
 };
 
 namespace render {
@@ -147,7 +273,7 @@ namespace render {
 
 EntityItemPointer RenderableParticleEffectEntityItem::factory(const EntityItemID& entityID,
                                                               const EntityItemProperties& properties) {
-    auto entity = std::make_shared<RenderableParticleEffectEntityItem>(entityID);
+    auto entity = EntityTypes::allocateEntityItem<RenderableParticleEffectEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -184,7 +310,22 @@ void RenderableParticleEffectEntityItem::removeFromScene(EntityItemPointer self,
 };
 
 void RenderableParticleEffectEntityItem::update(const quint64& now) {
-    ParticleEffectEntityItem::update(now);
+    if (isGPUSimulated()) {
+        // same time step as ParticleEffectEntityItem::update
+        if (now < _lastSimulated) {
+            _lastSimulated = now;
+        } else {
+            float deltaTime = (float)(now - _lastSimulated) / (float)USECS_PER_SECOND;
+            _lastSimulated = now;
+            stepGPUSimulation(deltaTime);
+        }
+        EntityItem::update(now);
+    } else {
+        if (!_gpuParticleBirths.empty()) {
+            resetGPUSimulation();
+        }
+        ParticleEffectEntityItem::update(now);
+    }
 
     if (_texturesChangedFlag) {
         if (_textures.isEmpty()) {
@@ -200,6 +341,98 @@ void RenderableParticleEffectEntityItem::update(const quint64& now) {
     updateRenderItem();
 }
 
+bool RenderableParticleEffectEntityItem::isGPUSimulated() const {
+    return getGPUSimulation() && GPUParticleSimulation::isSupported();
+}
+
+std::atomic<float> RenderableParticleEffectEntityItem::_particleBudget { 1.0f };
+
+uint32_t RenderableParticleEffectEntityItem::getBudgetedMaxParticles() const {
+    return std::max((uint32_t)1, (uint32_t)glm::round(_maxParticles * _particleBudget));
+}
+
+void RenderableParticleEffectEntityItem::resetGPUSimulation() {
+    _gpuParticleBirths.clear();
+    _gpuParticleHead = 0;
+    _gpuSimulationTime = 0.0;
+}
+
+void RenderableParticleEffectEntityItem::stepGPUSimulation(float deltaTime) {
+    if (!_gpuSimulation) {
+        _gpuSimulation = std::make_shared<GPUParticleSimulation>();
+    }
+    if (!_particles.empty()) {
+        _particles.clear();
+    }
+    uint32_t maxParticles = getBudgetedMaxParticles();
+    if (_gpuNumParticles != maxParticles) {
+        // effectively clear all particles, as when the max is set
+        resetGPUSimulation();
+        _gpuNumParticles = maxParticles;
+    }
+
+    // Only the emission times are tracked here, all the particles live as long so the live ones follow each other
+    _gpuSimulationTime += deltaTime;
+    while (!_gpuParticleBirths.empty() && _gpuSimulationTime - _gpuParticleBirths.front() >= _lifespan) {
+        _gpuParticleBirths.pop_front();
+    }
+
+    // Same emission as ParticleEffectEntityItem::stepSimulation
+    uint32_t numEmitted = 0;
+    float firstEmitTime = 0.0f;
+    float emitInterval = (_emitRate > 0.0f ? 1.0f / _emitRate : 0.0f);
+    if (getIsEmitting() && _emitRate > 0.0f && _lifespan > 0.0f && _polarStart <= _polarFinish) {
+        float timeLeftInFrame = deltaTime;
+        while (_timeUntilNextEmit < timeLeftInFrame) {
+            float emitTime = deltaTime - timeLeftInFrame + _timeUntilNextEmit;
+            if (numEmitted == 0) {
+                firstEmitTime = emitTime;
+            }
+            numEmitted++;
+            _gpuParticleBirths.push_back(_gpuSimulationTime - deltaTime + emitTime);
+
+            timeLeftInFrame -= _timeUntilNextEmit;
+            _timeUntilNextEmit = emitInterval;
+        }
+        _timeUntilNextEmit -= timeLeftInFrame;
+    }
+
+    // Newer particles are a higher priority
+    if (numEmitted > _gpuNumParticles) {
+        firstEmitTime += (numEmitted - _gpuNumParticles) * emitInterval;
+        numEmitted = _gpuNumParticles;
+    }
+    while (_gpuParticleBirths.size() > _gpuNumParticles) {
+        _gpuParticleBirths.pop_front();
+    }
+
+    GPUParticleSimulation::Step step;
+    step.emitter.rotation = glm::mat4_cast(_emitOrientation);
+    step.emitter.dimensionsAndRadiusStart = glm::vec4(_emitDimensions, _emitRadiusStart);
+    step.emitter.accelerationAndSpeed = glm::vec4(_emitAcceleration, _emitSpeed);
+    step.emitter.accelerationSpreadAndSpeedSpread = glm::vec4(_accelerationSpread, _speedSpread);
+    step.emitter.polarAndAzimuth = glm::vec4(_polarStart, _polarFinish, _azimuthStart, _azimuthFinish);
+    step.emitter.shouldTrail = glm::vec4(getEmitterShouldTrail() ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f);
+    step.hasEmitterChanged = (memcmp(&step.emitter, &_gpuEmitter, sizeof(_gpuEmitter)) != 0);
+    if (step.hasEmitterChanged) {
+        _gpuEmitter = step.emitter;
+    }
+
+    auto position = getPosition();
+    step.uniforms.previousPositionAndDeltaTime = glm::vec4(_previousPosition, deltaTime);
+    step.uniforms.positionAndFirstEmitTime = glm::vec4(position, firstEmitTime);
+    step.uniforms.emission = glm::uvec4(_gpuParticleHead, numEmitted, _gpuNumParticles,
+        qHash(getEntityItemID()) ^ (uint32_t)(++_gpuStepCount * 2654435761u));
+    step.uniforms.emitInterval = glm::vec4(emitInterval, 0.0f, 0.0f, 0.0f);
+
+    _gpuParticleHead = (_gpuNumParticles > 0 ? (_gpuParticleHead + numEmitted) % _gpuNumParticles : 0);
+    step.numAlive = (uint32_t)_gpuParticleBirths.size();
+    step.firstAlive = (_gpuNumParticles > 0 ? (_gpuParticleHead + _gpuNumParticles - step.numAlive) % _gpuNumParticles : 0);
+    GPUParticleSimulation::queueStep(_gpuSimulation, step);
+
+    _previousPosition = position;
+}
+
 void RenderableParticleEffectEntityItem::updateRenderItem() {
     // this 2 tests are synonyms for this class, but we would like to get rid of the _scene pointer ultimately
     if (!_scene || !render::Item::isValidID(_renderItemId)) { 
@@ -231,10 +464,14 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     particleUniforms.color.spread = glm::vec4(getColorSpreadRGB(), getAlphaSpread());
     particleUniforms.lifespan = getLifespan();
     
-    // Build particle primitives
+    // Build particle primitives, none when they are simulated on the GPU
+    auto gpuSimulation = (isGPUSimulated() ? _gpuSimulation : nullptr);
     auto particlePrimitives = std::make_shared<ParticlePrimitives>();
-    particlePrimitives->reserve(_particles.size()); // Reserve space
-    for (auto& particle : _particles) {
+    // over the budget, draw particles spread across the ring, not only the oldest ones
+    size_t numDrawn = std::min(_particles.size(), (size_t)getBudgetedMaxParticles());
+    particlePrimitives->reserve(numDrawn); // Reserve space
+    for (size_t i = 0; i < numDrawn; i++) {
+        auto& particle = _particles[i * _particles.size() / numDrawn];
         particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
     }
 
@@ -259,15 +496,19 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         
         // Update particle uniforms
         memcpy(&payload.editParticleUniforms(), &particleUniforms, sizeof(ParticleUniforms));
+
+        payload.setGPUSimulation(gpuSimulation);
         
         // Update particle buffer
         auto particleBuffer = payload.getParticleBuffer();
         size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
         particleBuffer->resize(numBytes);
-        if (numBytes == 0) {
+        if (numBytes == 0 && !gpuSimulation) {
             return;
         }
-        particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
+        if (numBytes > 0) {
+            particleBuffer->setData(numBytes, (const gpu::Byte*)particlePrimitives->data());
+        }
 
         // Update transform and bounds
         payload.setModelTransform(transform);
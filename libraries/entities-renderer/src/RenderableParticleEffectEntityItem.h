@@ -11,10 +11,73 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
+#include <gpu/Batch.h>
+#include <render/Engine.h>
 #include "RenderableEntityItem.h"
 
+// The particles of an emitter simulated on the GPU, in a ring buffer which persists there. The entity queues the
+// simulation steps on the main thread, SimulateGPUParticles records them on the render thread.
+class GPUParticleSimulation {
+public:
+    struct EmitterUniforms {
+        glm::mat4 rotation;
+        glm::vec4 dimensionsAndRadiusStart;
+        glm::vec4 accelerationAndSpeed;
+        glm::vec4 accelerationSpreadAndSpeedSpread;
+        glm::vec4 polarAndAzimuth;
+        glm::vec4 shouldTrail;
+    };
+    struct StepUniforms {
+        glm::vec4 previousPositionAndDeltaTime;
+        glm::vec4 positionAndFirstEmitTime;
+        glm::uvec4 emission; // first emitted particle, number emitted, number of particles, random seed
+        glm::vec4 emitInterval;
+    };
+    struct Step {
+        bool hasEmitterChanged { false };
+        EmitterUniforms emitter;
+        StepUniforms uniforms;
+        // The live particles after the step, from the oldest
+        uint32_t firstAlive { 0 };
+        uint32_t numAlive { 0 };
+    };
+    using Pointer = std::shared_ptr<GPUParticleSimulation>;
+
+    static bool isSupported() { return _isSupported; }
+
+    static void queueStep(const Pointer& simulation, const Step& step);
+    static void recordSteps(gpu::Batch& batch, bool supportsComputeShaders);
+
+    void render(gpu::Batch& batch) const;
+
+protected:
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+    void recordDispatches(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const std::vector<Step>& steps);
+
+    std::vector<Step> _pendingSteps; // guarded by _mutex
+
+    // Used on the render thread only
+    gpu::BufferPointer _particlesBuffer;
+    uint32_t _numParticles { 0 };
+    uint32_t _firstAlive { 0 };
+    uint32_t _numAlive { 0 };
+    gpu::BufferView _emitterBuffer;
+    gpu::Buffers _stepBuffers; // one per step recorded in a frame, the frame only captures the last content of a buffer
+
+    static std::atomic<bool> _isSupported;
+    static Mutex _mutex;
+    static std::vector<Pointer> _simulationsWithPendingSteps;
+    static gpu::PipelinePointer _pipeline;
+};
+
 class RenderableParticleEffectEntityItem : public ParticleEffectEntityItem  {
     friend class ParticlePayloadData;
 public:
@@ -23,8 +86,15 @@ public:
 
     virtual void update(const quint64& now) override;
 
+    // Simulated on the GPU when the entity asks for it and the renderer supports it, on the CPU otherwise
+    bool isGPUSimulated() const;
+
     void updateRenderItem();
 
+    // The fraction of the max particles of each effect that is simulated on the GPU and drawn, lowered under load
+    static void setParticleBudget(float budget) { _particleBudget = budget; }
+    static float getParticleBudget() { return _particleBudget; }
+
     virtual bool addToScene(EntityItemPointer self, render::ScenePointer scene, render::PendingChanges& pendingChanges) override;
     virtual void removeFromScene(EntityItemPointer self, render::ScenePointer scene, render::PendingChanges& pendingChanges) override;
 
@@ -35,6 +105,11 @@ protected:
     void notifyBoundChanged();
 
     void createPipelines();
+
+    uint32_t getBudgetedMaxParticles() const;
+
+    void stepGPUSimulation(float deltaTime);
+    void resetGPUSimulation();
     
     render::ScenePointer _scene;
     render::ItemID _renderItemId{ render::Item::INVALID_ITEM_ID };
@@ -42,6 +117,25 @@ protected:
     NetworkTexturePointer _texture;
     gpu::PipelinePointer _untexturedPipeline;
     gpu::PipelinePointer _texturedPipeline;
+
+    // The ring of particles simulated on the GPU, only their emission times are tracked here
+    GPUParticleSimulation::Pointer _gpuSimulation;
+    std::deque<double> _gpuParticleBirths;
+    double _gpuSimulationTime { 0.0 };
+    uint32_t _gpuParticleHead { 0 };
+    uint32_t _gpuNumParticles { 0 };
+    uint32_t _gpuStepCount { 0 };
+    GPUParticleSimulation::EmitterUniforms _gpuEmitter;
+
+    static std::atomic<float> _particleBudget;
+};
+
+/// Runs the simulation steps of the particles simulated on the GPU, before anything is drawn
+class SimulateGPUParticles {
+public:
+    using JobModel = render::Job::Model<SimulateGPUParticles>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext);
 };
 
 
@@ -30,7 +30,7 @@ struct PolyLineUniforms {
 
 
 EntityItemPointer RenderablePolyLineEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderablePolyLineEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderablePolyLineEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
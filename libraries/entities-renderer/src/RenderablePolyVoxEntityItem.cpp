@@ -10,9 +10,12 @@
 //
 
 #include <math.h>
+#include <algorithm>
+#include <mutex>
 #include <QObject>
 #include <QByteArray>
-#include <QtConcurrent/QtConcurrentRun>
+#include <QThread>
+#include <QThreadPool>
 #include <glm/gtx/transform.hpp>
 #include "ModelScriptingInterface.h"
 
@@ -21,6 +24,7 @@
 #pragma GCC diagnostic ignored "-Wdouble-promotion"
 #endif
 
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
 
@@ -55,9 +59,124 @@
 
 gpu::PipelinePointer RenderablePolyVoxEntityItem::_pipeline = nullptr;
 gpu::PipelinePointer RenderablePolyVoxEntityItem::_wireframePipeline = nullptr;
+const int RenderablePolyVoxEntityItem::CHUNK_SIZE;
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
+namespace {
+
+// The polyvox jobs of all the entities share a few workers, so that digging in a large terrain doesn't spawn a
+// thread per chunk.  The pending jobs are started nearest to the last view position first.
+class PolyVoxJobs {
+public:
+    static PolyVoxJobs& instance() {
+        static PolyVoxJobs* jobs = new PolyVoxJobs();
+        return *jobs;
+    }
+
+    void setViewPosition(const glm::vec3& viewPosition) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _viewPosition = viewPosition;
+    }
+
+    void start(const glm::vec3& position, std::function<void()> work) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingJobs.push_back({ position, work });
+        startPendingJobs();
+    }
+
+private:
+    PolyVoxJobs() {
+        // leave a core to the main and render threads
+        _pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 2));
+    }
+
+    class Job : public QRunnable {
+    public:
+        Job(std::function<void()> work) : _work(work) {}
+        void run() override {
+            _work();
+            PolyVoxJobs::instance().finishJob();
+        }
+
+    private:
+        std::function<void()> _work;
+    };
+
+    struct PendingJob {
+        glm::vec3 position;
+        std::function<void()> work;
+    };
+
+    void finishJob() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_numJobsInFlight;
+        startPendingJobs();
+    }
+
+    void startPendingJobs() { // with _mutex locked
+        while (!_pendingJobs.empty() && _numJobsInFlight < _pool.maxThreadCount()) {
+            // the view moves between the edits, so the nearest job is only looked for when a worker is free
+            auto nearest = _pendingJobs.begin();
+            float nearestDistance = glm::distance2(nearest->position, _viewPosition);
+            for (auto job = _pendingJobs.begin() + 1; job != _pendingJobs.end(); ++job) {
+                float distance = glm::distance2(job->position, _viewPosition);
+                if (distance < nearestDistance) {
+                    nearest = job;
+                    nearestDistance = distance;
+                }
+            }
+            auto work = nearest->work;
+            _pendingJobs.erase(nearest);
+            ++_numJobsInFlight;
+            _pool.start(new Job(work));
+        }
+    }
+
+    std::mutex _mutex;
+    QThreadPool _pool;
+    std::vector<PendingJob> _pendingJobs;
+    int _numJobsInFlight { 0 };
+    glm::vec3 _viewPosition;
+};
+
+// converts a polyvox surface to a mesh, the normals interleaved with the positions
+model::MeshPointer makeMesh(const std::vector<PolyVox::PositionMaterialNormal>& vecVertices,
+                            const std::vector<uint32_t>& vecIndices) {
+    model::MeshPointer mesh(new model::Mesh());
+
+    auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
+                                                     (gpu::Byte*)vecIndices.data());
+    auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
+    gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
+    mesh->setIndexBuffer(indexBufferView);
+
+    auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
+                                                      (gpu::Byte*)vecVertices.data());
+    auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
+    gpu::BufferView vertexBufferView(vertexBufferPtr, 0,
+                                     vertexBufferPtr->getSize(),
+                                     sizeof(PolyVox::PositionMaterialNormal),
+                                     gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
+    mesh->setVertexBuffer(vertexBufferView);
+    mesh->addAttribute(gpu::Stream::NORMAL,
+                       gpu::BufferView(vertexBufferPtr, sizeof(float) * 3,
+                                       vertexBufferPtr->getSize() ,
+                                       sizeof(PolyVox::PositionMaterialNormal),
+                                       gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
+
+    std::vector<model::Mesh::Part> parts;
+    parts.emplace_back(model::Mesh::Part((model::Index)0, // startIndex
+                                         (model::Index)vecIndices.size(), // numIndices
+                                         (model::Index)0, // baseVertex
+                                         model::Mesh::TRIANGLES)); // topology
+    mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(model::Mesh::Part),
+                                                        (gpu::Byte*) parts.data()), gpu::Element::PART_DRAWCALL));
+    return mesh;
+}
+
+}
+
 
 /*
   A PolyVoxEntity has several interdependent parts:
@@ -81,12 +200,17 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   is set, isReadyToComputeShape() gets called and _shape is created either from _volData or _shape, depending on
   the surface style.
 
+  The mesh is extracted in chunks of CHUNK_SIZE voxels a side.  setVoxelInternal marks the chunks whose surface can
+  change with the voxel in _dirtyChunks, and recomputeMesh only extracts those again.  Once all the chunks it started
+  are in, _mesh is rebuilt from the chunk meshes for the collision shape.  render draws the chunk meshes themselves.
+
   When a script changes _volData, compressVolumeDataAndSendEditPacket is called to update _voxelData and to
   send a packet to the entity-server.
 
   decompressVolumeData, recomputeMesh, computeShapeInfoWorker, and compressVolumeDataAndSendEditPacket are too expensive
-  to run on a thread that has other things to do.  These use QtConcurrent::run to spawn a thread.  As each thread
-  finishes, it adjusts the dirty flags so that the next call to render() will kick off the next step.
+  to run on a thread that has other things to do.  These are queued to a few workers shared by all the polyvoxes,
+  which take the jobs nearest to the camera first.  As each job finishes, it adjusts the dirty flags so that the next
+  call to render() will kick off the next step.
 
   polyvoxes are designed to seemlessly fit up against neighbors.  If voxels go right up to the edge of polyvox,
   the resulting mesh wont be closed -- the library assumes you'll have another polyvox next to it to continue the
@@ -107,7 +231,7 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
 
 EntityItemPointer RenderablePolyVoxEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderablePolyVoxEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderablePolyVoxEntityItem>(entityID);
     entity->setProperties(properties);
     std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->initializePolyVox();
     return entity;
@@ -182,6 +306,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
         } else {
             _volDataDirty = true;
             _voxelSurfaceStyle = voxelSurfaceStyle;
+            markAllChunksDirty();
         }
     });
 
@@ -694,17 +819,22 @@ void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
     assert(getType() == EntityTypes::PolyVox);
     Q_ASSERT(args->_batch);
 
+    if (args->hasViewFrustum()) {
+        PolyVoxJobs::instance().setViewPosition(args->getViewFrustum().getPosition());
+    }
     updateDependents();
 
-    model::MeshPointer mesh;
+    std::vector<model::MeshPointer> chunkMeshes;
     glm::vec3 voxelVolumeSize;
     withReadLock([&] {
-        mesh = _mesh;
+        chunkMeshes = _chunkMeshes;
         voxelVolumeSize = _voxelVolumeSize;
     });
 
-    if (!mesh ||
-        !mesh->getIndexBuffer()._buffer) {
+    chunkMeshes.erase(std::remove_if(chunkMeshes.begin(), chunkMeshes.end(), [](const model::MeshPointer& mesh) {
+        return !mesh || mesh->getNumIndices() == 0;
+    }), chunkMeshes.end());
+    if (chunkMeshes.empty()) {
         return;
     }
     
@@ -752,11 +882,6 @@ void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
     Transform transform(voxelToWorldMatrix());
     batch.setModelTransform(transform);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(gpu::Stream::POSITION, mesh->getVertexBuffer()._buffer,
-                         0,
-                         sizeof(PolyVox::PositionMaterialNormal));
-
-    batch.setIndexBuffer(gpu::UINT32, mesh->getIndexBuffer()._buffer, 0);
 
     if (!_xTextureURL.isEmpty() && !_xTexture) {
         _xTexture = DependencyManager::get<TextureCache>()->getTexture(_xTextureURL);
@@ -787,7 +912,13 @@ void RenderablePolyVoxEntityItem::render(RenderArgs* args) {
     int voxelVolumeSizeLocation = pipeline->getProgram()->getUniforms().findLocation("voxelVolumeSize");
     batch._glUniform3f(voxelVolumeSizeLocation, voxelVolumeSize.x, voxelVolumeSize.y, voxelVolumeSize.z);
 
-    batch.drawIndexed(gpu::TRIANGLES, (gpu::uint32)mesh->getNumIndices(), 0);
+    for (const auto& mesh : chunkMeshes) {
+        batch.setInputBuffer(gpu::Stream::POSITION, mesh->getVertexBuffer()._buffer,
+                             0,
+                             sizeof(PolyVox::PositionMaterialNormal));
+        batch.setIndexBuffer(gpu::UINT32, mesh->getIndexBuffer()._buffer, 0);
+        batch.drawIndexed(gpu::TRIANGLES, (gpu::uint32)mesh->getNumIndices(), 0);
+    }
 }
 
 bool RenderablePolyVoxEntityItem::addToScene(EntityItemPointer self,
@@ -908,6 +1039,8 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(glm::vec3 voxelVolumeSize)
 
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        resetChunks();
     });
 }
 
@@ -976,11 +1109,61 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(int x, int y, int z, uint8_t
         _neighborsNeedUpdate = true;
     }
 
+    if (result) {
+        if (isEdged(_voxelSurfaceStyle)) {
+            markChunksDirtyAt(x + 1, y + 1, z + 1);
+        } else {
+            markChunksDirtyAt(x, y, z);
+        }
+    }
+
     _volDataDirty |= result;
 
     return result;
 }
 
+void RenderablePolyVoxEntityItem::resetChunks() {
+    // the chunks are of cells, between the voxels of the enclosing region, so neighboring chunks share a layer
+    glm::ivec3 numCells(_volData->getWidth() - 1, _volData->getHeight() - 1, _volData->getDepth() - 1);
+    _numChunks = glm::max((numCells + glm::ivec3(CHUNK_SIZE - 1)) / CHUNK_SIZE, glm::ivec3(1));
+    int numChunks = _numChunks.x * _numChunks.y * _numChunks.z;
+
+    _chunkMeshes.assign(numChunks, model::MeshPointer());
+    _chunksInFlight.assign(numChunks, false);
+    _numChunksInFlight = 0;
+    _meshGeneration++;
+    markAllChunksDirty();
+}
+
+void RenderablePolyVoxEntityItem::markAllChunksDirty() {
+    _dirtyChunks.assign(_chunkMeshes.size(), true);
+    _volDataDirty = true;
+}
+
+void RenderablePolyVoxEntityItem::markChunksDirtyAt(int x, int y, int z) {
+    // a voxel is a corner of the cells on either side of it, and the marching cubes normals are the gradients
+    // at the corners, which reach a cell further
+    glm::ivec3 low = glm::max(glm::ivec3(x, y, z) - glm::ivec3(2), glm::ivec3(0)) / CHUNK_SIZE;
+    glm::ivec3 high = glm::min((glm::ivec3(x, y, z) + glm::ivec3(1)) / CHUNK_SIZE, _numChunks - glm::ivec3(1));
+    for (int chunkZ = low.z; chunkZ <= high.z; chunkZ++) {
+        for (int chunkY = low.y; chunkY <= high.y; chunkY++) {
+            for (int chunkX = low.x; chunkX <= high.x; chunkX++) {
+                _dirtyChunks[chunkX + _numChunks.x * (chunkY + _numChunks.y * chunkZ)] = true;
+            }
+        }
+    }
+}
+
+PolyVox::Region RenderablePolyVoxEntityItem::getChunkRegion(int chunkIndex) const {
+    glm::ivec3 chunk(chunkIndex % _numChunks.x, (chunkIndex / _numChunks.x) % _numChunks.y,
+                     chunkIndex / (_numChunks.x * _numChunks.y));
+    PolyVox::Vector3DInt32 enclosingUpper = _volData->getEnclosingRegion().getUpperCorner();
+    glm::ivec3 low = chunk * CHUNK_SIZE;
+    glm::ivec3 high = glm::min(low + glm::ivec3(CHUNK_SIZE),
+                               glm::ivec3(enclosingUpper.getX(), enclosingUpper.getY(), enclosingUpper.getZ()));
+    return PolyVox::Region(PolyVox::Vector3DInt32(low.x, low.y, low.z), PolyVox::Vector3DInt32(high.x, high.y, high.z));
+}
+
 
 bool RenderablePolyVoxEntityItem::updateOnCount(int x, int y, int z, uint8_t toValue) {
     // keep _onCount up to date
@@ -1014,7 +1197,7 @@ void RenderablePolyVoxEntityItem::decompressVolumeData() {
         voxelData = _voxelData;
     });
 
-    QtConcurrent::run([=] {
+    PolyVoxJobs::instance().start(getPosition(), [=] {
         QDataStream reader(voxelData);
         quint16 voxelXSize, voxelYSize, voxelZSize;
         reader >> voxelXSize;
@@ -1082,7 +1265,7 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
     EntityTreeElementPointer element = getElement();
     EntityTreePointer tree = element ? element->getTree() : nullptr;
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity, tree] {
+    PolyVoxJobs::instance().start(getPosition(), [voxelXSize, voxelYSize, voxelZSize, entity, tree] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
 
@@ -1180,6 +1363,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int y = 0; y < _volData->getHeight(); y++) {
                 for (int z = 0; z < _volData->getDepth(); z++) {
                     uint8_t neighborValue = currentXPNeighbor->getVoxel(0, y, z);
+                    if (_volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
+                        markChunksDirtyAt(_volData->getWidth() - 1, y, z);
+                    }
                     if ((y == 0 || z == 0) && _volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
                         bonkNeighbors();
                     }
@@ -1195,6 +1381,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int x = 0; x < _volData->getWidth(); x++) {
                 for (int z = 0; z < _volData->getDepth(); z++) {
                     uint8_t neighborValue = currentYPNeighbor->getVoxel(x, 0, z);
+                    if (_volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
+                        markChunksDirtyAt(x, _volData->getHeight() - 1, z);
+                    }
                     if ((x == 0 || z == 0) && _volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
                         bonkNeighbors();
                     }
@@ -1210,6 +1399,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int x = 0; x < _volData->getWidth(); x++) {
                 for (int y = 0; y < _volData->getHeight(); y++) {
                     uint8_t neighborValue = currentZPNeighbor->getVoxel(x, y, 0);
+                    if (_volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
+                        markChunksDirtyAt(x, y, _volData->getDepth() - 1);
+                    }
                     _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
                     if ((x == 0 || y == 0) && _volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
                         bonkNeighbors();
@@ -1222,95 +1414,157 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
 }
 
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
-    PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
-        voxelSurfaceStyle = _voxelSurfaceStyle;
-    });
-
+    // use _volData to make a renderable mesh of each dirty chunk
     cacheNeighbors();
     copyUpperEdgesFromNeighbors();
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        model::MeshPointer mesh(new model::Mesh());
-
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    PolyVoxSurfaceStyle voxelSurfaceStyle;
+    int meshGeneration;
+    std::vector<std::pair<int, PolyVox::Region>> chunks;
+    withWriteLock([&] {
+        voxelSurfaceStyle = _voxelSurfaceStyle;
+        meshGeneration = _meshGeneration;
+        for (int chunkIndex = 0; chunkIndex < (int)_dirtyChunks.size(); chunkIndex++) {
+            if (!_dirtyChunks[chunkIndex]) {
+                continue;
+            }
+            if (_chunksInFlight[chunkIndex]) {
+                // wait for it to come in, so that an older extraction can't replace a newer one
+                _volDataDirty = true;
+                continue;
+            }
+            _dirtyChunks[chunkIndex] = false;
+            _chunksInFlight[chunkIndex] = true;
+            _numChunksInFlight++;
+            chunks.push_back({ chunkIndex, getChunkRegion(chunkIndex) });
+        }
+    });
 
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+    glm::mat4 voxelToWorld = voxelToWorldMatrix();
+    for (const auto& chunk : chunks) {
+        int chunkIndex = chunk.first;
+        PolyVox::Region region = chunk.second;
+        PolyVox::Vector3DInt32 lower = region.getLowerCorner();
+        PolyVox::Vector3DInt32 upper = region.getUpperCorner();
+        glm::vec3 regionCenter = 0.5f * glm::vec3(lower.getX() + upper.getX(), lower.getY() + upper.getY(),
+                                                  lower.getZ() + upper.getZ());
+        glm::vec3 chunkPosition(voxelToWorld * glm::vec4(regionCenter, 1.0f));
+
+        PolyVoxJobs::instance().start(chunkPosition, [entity, voxelSurfaceStyle, meshGeneration, chunkIndex, region] {
+            // A mesh object to hold the result of surface extraction
+            PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+
+            bool isStale = false;
+            entity->withReadLock([&] {
+                if (entity->getMeshGeneration() != meshGeneration) {
+                    // _volData was reallocated since, the region may not fit it
+                    isStale = true;
+                    return;
                 }
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+                PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
+                switch (voxelSurfaceStyle) {
+                    case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
+                        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                    case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                    case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
+                        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                    case PolyVoxEntityItem::SURFACE_CUBIC: {
+                        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
                 }
+            });
+            if (isStale) {
+                return;
             }
+
+            // the extracted positions are relative to the region, move them into the voxel-space of the entity
+            std::vector<PolyVox::PositionMaterialNormal> vecVertices = polyVoxMesh.getVertices();
+            PolyVox::Vector3DInt32 lowerCorner = region.getLowerCorner();
+            PolyVox::Vector3DFloat regionOffset((float)lowerCorner.getX(), (float)lowerCorner.getY(),
+                                                (float)lowerCorner.getZ());
+            for (auto& vertex : vecVertices) {
+                vertex.setPosition(vertex.getPosition() + regionOffset);
+            }
+
+            // convert PolyVox mesh to a Sam mesh
+            entity->setChunkMesh(meshGeneration, chunkIndex, makeMesh(vecVertices, polyVoxMesh.getIndices()));
         });
+    }
+}
 
-        // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
-        auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
-                                                         (gpu::Byte*)vecIndices.data());
-        auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
-        gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
-        mesh->setIndexBuffer(indexBufferView);
-
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getVertices();
-        auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
-                                                          (gpu::Byte*)vecVertices.data());
-        auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
-        gpu::BufferView vertexBufferView(vertexBufferPtr, 0,
-                                         vertexBufferPtr->getSize(),
-                                         sizeof(PolyVox::PositionMaterialNormal),
-                                         gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
-        mesh->setVertexBuffer(vertexBufferView);
-        mesh->addAttribute(gpu::Stream::NORMAL,
-                           gpu::BufferView(vertexBufferPtr, sizeof(float) * 3,
-                                           vertexBufferPtr->getSize() ,
-                                           sizeof(PolyVox::PositionMaterialNormal),
-                                           gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
-
-        std::vector<model::Mesh::Part> parts;
-        parts.emplace_back(model::Mesh::Part((model::Index)0, // startIndex
-                                             (model::Index)vecIndices.size(), // numIndices
-                                             (model::Index)0, // baseVertex
-                                             model::Mesh::TRIANGLES)); // topology
-        mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(model::Mesh::Part),
-                                                            (gpu::Byte*) parts.data()), gpu::Element::PART_DRAWCALL));
-        entity->setMesh(mesh);
+void RenderablePolyVoxEntityItem::setChunkMesh(int meshGeneration, int chunkIndex, model::MeshPointer mesh) {
+    // this catches the payload of each chunk from recomputeMesh
+    bool allChunksIn = false;
+    std::vector<model::MeshPointer> chunkMeshes;
+    int meshVersion;
+    withWriteLock([&] {
+        if (meshGeneration != _meshGeneration) {
+            // _volData was reallocated since, and its chunks restarted
+            return;
+        }
+        _chunkMeshes[chunkIndex] = mesh;
+        _chunksInFlight[chunkIndex] = false;
+        _numChunksInFlight--;
+        meshVersion = ++_chunkMeshesVersion;
+        allChunksIn = (_numChunksInFlight == 0);
+        if (allChunksIn) {
+            chunkMeshes = _chunkMeshes;
+        }
     });
+    if (!allChunksIn) {
+        return;
+    }
+
+    // the collision shape is made from all the chunks once they are in, rather than after each chunk
+    std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+    std::vector<uint32_t> vecIndices;
+    for (const auto& chunkMesh : chunkMeshes) {
+        if (!chunkMesh || chunkMesh->getNumIndices() == 0) {
+            continue;
+        }
+        uint32_t baseVertex = (uint32_t)vecVertices.size();
+        auto vertices = reinterpret_cast<const PolyVox::PositionMaterialNormal*>(chunkMesh->getVertexBuffer()._buffer->getData());
+        vecVertices.insert(vecVertices.end(), vertices, vertices + chunkMesh->getNumVertices());
+        auto indices = reinterpret_cast<const uint32_t*>(chunkMesh->getIndexBuffer()._buffer->getData());
+        for (size_t i = 0; i < chunkMesh->getNumIndices(); i++) {
+            vecIndices.push_back(baseVertex + indices[i]);
+        }
+    }
+    setMesh(makeMesh(vecVertices, vecIndices), meshVersion);
 }
 
-void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
-    // this catches the payload from recomputeMesh
+void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh, int meshVersion) {
+    // this catches the payload from setChunkMesh
     bool neighborsNeedUpdate;
     withWriteLock([&] {
+        if (meshVersion <= _meshVersion) {
+            // a mesh made from later chunks is already in
+            neighborsNeedUpdate = false;
+            return;
+        }
         if (!_collisionless) {
             _dirtyFlags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
         }
         _mesh = mesh;
+        _meshVersion = meshVersion;
         _meshDirty = true;
         _meshInitialized = true;
         neighborsNeedUpdate = _neighborsNeedUpdate;
@@ -1340,7 +1594,7 @@ void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
         mesh = _mesh;
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    PolyVoxJobs::instance().start(getPosition(), [entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
@@ -14,6 +14,7 @@
 
 #include <QSemaphore>
 #include <atomic>
+#include <vector>
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
@@ -134,10 +135,12 @@ public:
                            std::function<void(int, int, int, uint8_t)> thunk);
     QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
-    void setMesh(model::MeshPointer mesh);
+    void setMesh(model::MeshPointer mesh, int meshVersion);
+    void setChunkMesh(int meshGeneration, int chunkIndex, model::MeshPointer mesh);
     bool getMeshAsScriptValue(QScriptEngine *engine, QScriptValue& result) override;
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData; }
+    int getMeshGeneration() const { return _meshGeneration; }
 
     uint8_t getVoxelInternal(int x, int y, int z) const;
     bool setVoxelInternal(int x, int y, int z, uint8_t toValue);
@@ -154,7 +157,19 @@ private:
     // The PolyVoxEntityItem class has _voxelData which contains dimensions and compressed voxel data.  The dimensions
     // may not match _voxelVolumeSize.
 
+    // the volume is meshed in chunks of CHUNK_SIZE voxels a side, so that an edit only re-extracts the chunks around
+    // it.  _mesh is all the chunks in one, for the collision shape and the scripts.
+    static const int CHUNK_SIZE = 16;
+
     model::MeshPointer _mesh;
+    std::vector<model::MeshPointer> _chunkMeshes;
+    std::vector<bool> _dirtyChunks; // does the chunk need to be extracted again?
+    std::vector<bool> _chunksInFlight; // is the chunk being extracted?
+    int _numChunksInFlight { 0 };
+    glm::ivec3 _numChunks;
+    int _meshGeneration { 0 }; // bumped when _volData is reallocated, to drop the chunks of the previous volume
+    int _chunkMeshesVersion { 0 }; // bumped with each new chunk mesh
+    int _meshVersion { 0 }; // the _chunkMeshesVersion _mesh was made from
     gpu::Stream::FormatPointer _vertexFormat;
     bool _meshDirty { true }; // does collision-shape need to be recomputed?
     bool _meshInitialized { false };
@@ -177,6 +192,12 @@ private:
     bool _neighborsNeedUpdate { false };
 
     bool updateOnCount(int x, int y, int z, uint8_t toValue);
+
+    // these take _volData coordinates and assume the caller has write-locked the entity
+    void resetChunks();
+    void markAllChunksDirty();
+    void markChunksDirtyAt(int x, int y, int z);
+    PolyVox::Region getChunkRegion(int chunkIndex) const;
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
     // these are run off the main thread
@@ -41,7 +41,7 @@ static std::array<GeometryCache::Shape, entity::NUM_SHAPES> MAPPING { {
 } };
 
 RenderableShapeEntityItem::Pointer RenderableShapeEntityItem::baseFactory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    Pointer entity = std::make_shared<RenderableShapeEntityItem>(entityID);
+    Pointer entity = EntityTypes::allocateEntityItem<RenderableShapeEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
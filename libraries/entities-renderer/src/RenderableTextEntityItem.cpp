@@ -19,7 +19,7 @@
 #include "GLMHelpers.h"
 
 EntityItemPointer RenderableTextEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableTextEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableTextEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -34,14 +34,19 @@ static uint32_t _currentWebCount { 0 };
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
 // If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
 static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
+// If a web-view hasn't been rendered for a second, pause it until it is again
+static uint64_t MAX_NO_RENDER_BEFORE_PAUSE_INTERVAL = USECS_PER_SECOND;
 
 static int MAX_WINDOW_SIZE = 4096;
 static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
 static int DEFAULT_MAX_FPS = 10;
 static int YOUTUBE_MAX_FPS = 30;
+// A web-view appearing smaller than this, in meters per meter of distance, renders at a fraction of its max fps
+static float FULL_FPS_APPARENT_SIZE = 0.5f;
+static int MIN_MAX_FPS = 1;
 
 EntityItemPointer RenderableWebEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableWebEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableWebEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -113,9 +118,9 @@ bool RenderableWebEntityItem::buildWebSurface(QSharedPointer<EntityTreeRenderer>
     };
     _webSurface = QSharedPointer<OffscreenQmlSurface>(new OffscreenQmlSurface(), deleter);
 
-    // FIXME, the max FPS could be better managed by being dynamic (based on the number of current surfaces
-    // and the current rendering load)
-    _webSurface->setMaxFps(DEFAULT_MAX_FPS);
+    // The max FPS is lowered while rendering, for the web-views that appear small
+    _maxFps = DEFAULT_MAX_FPS;
+    _webSurface->setMaxFps(_maxFps);
 
     // The lifetime of the QML surface MUST be managed by the main thread
     // Additionally, we MUST use local variables copied by value, rather than
@@ -206,6 +211,18 @@ void RenderableWebEntityItem::render(RenderArgs* args) {
     }
 
     _lastRenderTime = usecTimestampNow();
+    if (_webSurface->isPaused()) {
+        _webSurface->resume();
+    }
+
+    if (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE) {
+        // The web-views far away, or otherwise small in the view, don't need to be as smooth
+        float distance = glm::distance(args->getViewFrustum().getPosition(), getPosition());
+        glm::vec3 dimensions = getDimensions();
+        float apparentSize = glm::max(dimensions.x, dimensions.y) / glm::max(distance, EPSILON);
+        float fpsScale = glm::min(apparentSize / FULL_FPS_APPARENT_SIZE, 1.0f);
+        _webSurface->setMaxFps((uint8_t)glm::max((int)(_maxFps * fpsScale), MIN_MAX_FPS));
+    }
 
     glm::vec2 windowSize = getWindowSize();
 
@@ -261,10 +278,11 @@ void RenderableWebEntityItem::loadSourceURL() {
 
         // We special case YouTube URLs since we know they are videos that we should play with at least 30 FPS.
         if (sourceUrl.host().endsWith("youtube.com", Qt::CaseInsensitive)) {
-            _webSurface->setMaxFps(YOUTUBE_MAX_FPS);
+            _maxFps = YOUTUBE_MAX_FPS;
         } else {
-            _webSurface->setMaxFps(DEFAULT_MAX_FPS);
+            _maxFps = DEFAULT_MAX_FPS;
         }
+        _webSurface->setMaxFps(_maxFps);
 
         _webSurface->load("WebView.qml", [&](QQmlContext* context, QObject* obj) {
             context->setContextProperty("eventBridgeJavaScriptToInject", QVariant(_javaScriptToInject));
@@ -426,6 +444,9 @@ void RenderableWebEntityItem::update(const quint64& now) {
     auto interval = now - _lastRenderTime;
     if (interval > MAX_NO_RENDER_INTERVAL) {
         destroyWebSurface();
+    } else if (interval > MAX_NO_RENDER_BEFORE_PAUSE_INTERVAL && _webSurface && !_webSurface->isPaused()) {
+        // out of view, or hidden, there is no need to keep rendering it
+        _webSurface->pause();
     }
 }
 
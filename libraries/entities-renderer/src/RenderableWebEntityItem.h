@@ -67,6 +67,7 @@ private:
     gpu::TexturePointer _texture;
     bool _pressed{ false };
     uint64_t _lastRenderTime{ 0 };
+    int _maxFps { 0 };
     QTouchDevice _touchDevice;
 
     QMetaObject::Connection _mousePressConnection;
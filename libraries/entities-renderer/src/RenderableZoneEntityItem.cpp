@@ -26,7 +26,7 @@
 static const float SPHERE_ENTITY_SCALE = 0.5f;
 
 EntityItemPointer RenderableZoneEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new RenderableZoneEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<RenderableZoneEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -63,10 +63,6 @@ bool RenderableZoneEntityItem::setProperties(const EntityItemProperties& propert
     return somethingChanged;
 }
 
-void RenderableZoneEntityItem::somethingChangedNotification() {
-    DependencyManager::get<EntityTreeRenderer>()->updateZone(_id);
-}
-
 int RenderableZoneEntityItem::readEntitySubclassDataFromBuffer(const unsigned char* data, int bytesLeftToRead,
                                                                 ReadBitstreamToTreeParams& args,
                                                                 EntityPropertyFlags& propertyFlags, bool overwriteLocalData,
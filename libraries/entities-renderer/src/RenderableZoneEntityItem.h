@@ -28,7 +28,6 @@ public:
     { }
     
     virtual bool setProperties(const EntityItemProperties& properties) override;
-    virtual void somethingChangedNotification() override;
 
     virtual int readEntitySubclassDataFromBuffer(const unsigned char* data, int bytesLeftToRead,
                                                  ReadBitstreamToTreeParams& args,
@@ -15,6 +15,7 @@
 #define hifi_EntitiesScriptEngineProvider_h
 
 #include <QtCore/QString>
+#include <QtCore/QVariant>
 #include <QFuture>
 #include "EntityItemID.h"
 
@@ -22,6 +23,7 @@ class EntitiesScriptEngineProvider {
 public:
     virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const QStringList& params = QStringList()) = 0;
     virtual QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) = 0;
+    virtual QVariantList getTopEntityScripts(int maxCount) = 0;
 };
 
 #endif // hifi_EntitiesScriptEngineProvider_h
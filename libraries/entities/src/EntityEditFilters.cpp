@@ -10,11 +10,154 @@
 //
 
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include <QUrl>
 
 #include <ResourceManager.h>
+#include <SharedUtil.h>
 #include "EntityEditFilters.h"
 
+// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
+// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
+static bool hasCorrectSyntax(const QScriptProgram& program) {
+    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
+    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
+        const auto error = syntaxCheck.errorMessage();
+        const auto line = QString::number(syntaxCheck.errorLineNumber());
+        const auto column = QString::number(syntaxCheck.errorColumnNumber());
+        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
+        qCritical() << qPrintable(message);
+        return false;
+    }
+    return true;
+}
+static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
+    if (engine.hasUncaughtException()) {
+        const auto backtrace = engine.uncaughtExceptionBacktrace();
+        const auto exception = engine.uncaughtException().toString();
+        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
+        engine.clearExceptions();
+
+        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
+        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
+        if (!backtrace.empty()) {
+            static const auto lineSeparator = "\n    ";
+            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
+        }
+        qCritical() << qPrintable(message);
+        return true;
+    }
+    return false;
+}
+
+
+// a filter script evaluated in an engine of its own
+struct FilterEngine {
+    std::unique_ptr<QScriptEngine> engine;
+    QScriptValue filterFn;
+};
+
+static std::unique_ptr<FilterEngine> createFilterEngine(const QString& scriptContents, const QString& urlString) {
+    std::unique_ptr<FilterEngine> filterEngine { new FilterEngine() };
+    filterEngine->engine.reset(new QScriptEngine());
+    QScriptEngine& engine = *filterEngine->engine;
+    engine.evaluate(scriptContents);
+    if (hadUncaughtExceptions(engine, urlString)) {
+        return nullptr;
+    }
+
+    // now get the filter function
+    auto global = engine.globalObject();
+    auto entitiesObject = engine.newObject();
+    entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+    entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+    entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+    global.setProperty("Entities", entitiesObject);
+    filterEngine->filterFn = global.property("filter");
+    return filterEngine;
+}
+
+// whether any of the properties is in the flags
+static bool hasAnyProperty(const EntityPropertyFlags& flags, const EntityPropertyFlags& properties) {
+    for (int property = (int)properties.firstFlag(); property <= (int)properties.lastFlag(); property++) {
+        if (properties.getHasProperty((EntityPropertyList)property) && flags.getHasProperty((EntityPropertyList)property)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// whether the flags have none but the properties
+static bool hasOnlyProperties(const EntityPropertyFlags& flags, const EntityPropertyFlags& properties) {
+    for (int property = (int)flags.firstFlag(); property <= (int)flags.lastFlag(); property++) {
+        if (flags.getHasProperty((EntityPropertyList)property) && !properties.getHasProperty((EntityPropertyList)property)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class EntityEditFilters::FilterScript {
+public:
+    FilterScript(const QString& url, const QString& contents) : url(url), contents(contents) { }
+
+    // an idle engine, or a new one when all of them are filtering edits - null if the script couldn't be evaluated
+    std::unique_ptr<FilterEngine> takeEngine() {
+        {
+            std::lock_guard<std::mutex> guard(_enginesLock);
+            if (!_idleEngines.empty()) {
+                std::unique_ptr<FilterEngine> engine = std::move(_idleEngines.back());
+                _idleEngines.pop_back();
+                return engine;
+            }
+        }
+        std::unique_ptr<FilterEngine> engine = createFilterEngine(contents, url);
+        if (engine && engine->filterFn.isFunction()) {
+            numEngines++;
+            return engine;
+        }
+        return nullptr;
+    }
+
+    void returnEngine(std::unique_ptr<FilterEngine> engine) {
+        std::lock_guard<std::mutex> guard(_enginesLock);
+        _idleEngines.push_back(std::move(engine));
+    }
+
+    // the rules are properties of the filter function, read once when the script is loaded
+    void readRules(const QScriptValue& filterFn) {
+        static const char* WANTS_TO_FILTER[] = { "wantsToFilterAdd", "wantsToFilterEdit", "wantsToFilterPhysics" };
+        for (int filterType = EntityTree::FilterType::Add; filterType <= EntityTree::FilterType::Physics; filterType++) {
+            QScriptValue wantsToFilter = filterFn.property(WANTS_TO_FILTER[filterType]);
+            wantsToFilterType[filterType] = !wantsToFilter.isBool() || wantsToFilter.toBool();
+        }
+        EntityItemProperties::entityPropertyFlagsFromScriptValue(filterFn.property("passProperties"), passProperties);
+        EntityItemProperties::entityPropertyFlagsFromScriptValue(filterFn.property("rejectProperties"), rejectProperties);
+    }
+
+    const QString url;
+    const QString contents;
+
+    bool wantsToFilterType[EntityTree::FilterType::Physics + 1] { true, true, true };
+    EntityPropertyFlags passProperties;
+    EntityPropertyFlags rejectProperties;
+
+    std::atomic<int> numEngines { 0 };
+    std::atomic<uint64_t> calls { 0 };
+    std::atomic<uint64_t> totalUsecs { 0 };
+    std::atomic<uint64_t> maxUsecs { 0 };
+    std::atomic<uint64_t> rejected { 0 };
+    std::atomic<uint64_t> passedByRules { 0 };
+    std::atomic<uint64_t> rejectedByRules { 0 };
+
+private:
+    std::mutex _enginesLock;
+    std::vector<std::unique_ptr<FilterEngine>> _idleEngines;
+};
+
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
     QList<EntityItemID> missingZones;
@@ -61,32 +204,64 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
             if (filterData.rejectAll) {
                 return false;
             }
-            auto oldProperties = propertiesIn.getDesiredProperties();
+            FilterScript& script = *filterData.script;
             auto specifiedProperties = propertiesIn.getChangedProperties();
-            propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
-            propertiesIn.setDesiredProperties(oldProperties);
 
-            auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
-            QScriptValueList args;
-            args << inputValues;
-            args << filterType;
+            // the rules of the filter decide most edits without calling it
+            if (!script.wantsToFilterType[filterType]) {
+                script.passedByRules++;
+                continue;
+            }
+            if (hasAnyProperty(specifiedProperties, script.rejectProperties)) {
+                script.rejectedByRules++;
+                return false;
+            }
+            if (!script.passProperties.isEmpty() && hasOnlyProperties(specifiedProperties, script.passProperties)) {
+                script.passedByRules++;
+                continue;
+            }
 
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
-            if (filterData.uncaughtExceptions()) {
+            std::unique_ptr<FilterEngine> engine = script.takeEngine();
+            if (!engine) {
                 return false;
             }
+            bool accepted = false;
+            {
+                // the values of the engine are gone before it is returned, for another thread to use
+                auto oldProperties = propertiesIn.getDesiredProperties();
+                propertiesIn.setDesiredProperties(specifiedProperties);
+                QScriptValue inputValues = propertiesIn.copyToScriptValue(engine->engine.get(), false, true, true);
+                propertiesIn.setDesiredProperties(oldProperties);
+
+                auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+                QScriptValueList args;
+                args << inputValues;
+                args << filterType;
+
+                quint64 startCall = usecTimestampNow();
+                QScriptValue result = engine->filterFn.call(QScriptValue(), args);
+                uint64_t callUsecs = usecTimestampNow() - startCall;
+                script.calls++;
+                script.totalUsecs += callUsecs;
+                uint64_t maxUsecs = script.maxUsecs;
+                while (callUsecs > maxUsecs && !script.maxUsecs.compare_exchange_weak(maxUsecs, callUsecs)) {
+                }
 
-            if (result.isObject()){
-                // make propertiesIn reflect the changes, for next filter...
-                propertiesIn.copyFromScriptValue(result, false);
+                if (!hadUncaughtExceptions(*engine->engine, script.url) && result.isObject()) {
+                    // make propertiesIn reflect the changes, for next filter...
+                    propertiesIn.copyFromScriptValue(result, false);
 
-                // and update propertiesOut too.  TODO: this could be more efficient...
-                propertiesOut.copyFromScriptValue(result, false);
-                // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
-                auto out = QJsonValue::fromVariant(result.toVariant());
-                wasChanged |= (in != out);
-            } else {
+                    // and update propertiesOut too.  TODO: this could be more efficient...
+                    propertiesOut.copyFromScriptValue(result, false);
+                    // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
+                    auto out = QJsonValue::fromVariant(result.toVariant());
+                    wasChanged |= (in != out);
+                    accepted = true;
+                }
+            }
+            script.returnEngine(std::move(engine));
+            if (!accepted) {
+                script.rejected++;
                 return false;
             }
         }
@@ -96,14 +271,34 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
+    // the engines of the script are deleted once the edits being filtered with it are done
     QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
-    }
     _filterDataMap.remove(entityID);
 }
 
+QVector<EntityEditFilters::FilterStats> EntityEditFilters::getStats() {
+    QVector<FilterStats> allStats;
+    QReadLocker readLock(&_lock);
+    for (auto itr = _filterDataMap.constBegin(); itr != _filterDataMap.constEnd(); ++itr) {
+        const FilterScriptPointer& script = itr.value().script;
+        if (!script) {
+            continue;
+        }
+        FilterStats stats;
+        stats.entityID = itr.key();
+        stats.url = script->url;
+        stats.numEngines = script->numEngines;
+        stats.calls = script->calls;
+        stats.totalUsecs = script->totalUsecs;
+        stats.maxUsecs = script->maxUsecs;
+        stats.rejected = script->rejected;
+        stats.passedByRules = script->passedByRules;
+        stats.rejectedByRules = script->rejectedByRules;
+        allStats.push_back(stats);
+    }
+    return allStats;
+}
+
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
 
     QUrl scriptURL(filterURL);
@@ -146,39 +341,6 @@ void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
     qDebug() << "script request sent for entity " << entityID;
 }
 
-// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
-// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
-static bool hasCorrectSyntax(const QScriptProgram& program) {
-    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
-    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
-        const auto error = syntaxCheck.errorMessage();
-        const auto line = QString::number(syntaxCheck.errorLineNumber());
-        const auto column = QString::number(syntaxCheck.errorColumnNumber());
-        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
-        qCritical() << qPrintable(message);
-        return false;
-    }
-    return true;
-}
-static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
-    if (engine.hasUncaughtException()) {
-        const auto backtrace = engine.uncaughtExceptionBacktrace();
-        const auto exception = engine.uncaughtException().toString();
-        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
-        engine.clearExceptions();
-
-        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
-        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
-        if (!backtrace.empty()) {
-            static const auto lineSeparator = "\n    ";
-            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
-        }
-        qCritical() << qPrintable(message);
-        return true;
-    }
-    return false;
-}
-
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -188,30 +350,19 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         qInfo() << "Downloaded script:" << scriptContents;
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->evaluate(scriptContents);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
+            // evaluate the script in its first engine, more are made as edits are filtered with it at once
+            auto script = std::make_shared<FilterScript>(urlString, scriptContents);
+            std::unique_ptr<FilterEngine> engine = createFilterEngine(scriptContents, urlString);
+            if (engine) {
                 FilterData filterData;
-                filterData.engine = engine;
                 filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [this, &engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+                if (engine->filterFn.isFunction()) {
+                    script->readRules(engine->filterFn);
+                    script->numEngines++;
+                    script->returnEngine(std::move(engine));
+                    filterData.script = script;
+                } else {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
                     filterData.rejectAll=true;
                 }
                
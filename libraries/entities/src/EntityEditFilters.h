@@ -18,22 +18,45 @@
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <memory>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 
+/// Runs the edit filter scripts of a domain and of its zones.
+///
+/// Edits are filtered on the threads that decode them, so each filter script is evaluated in a pool of engines, one
+/// per edit being filtered at once. A filter function can also declare rules that most edits are decided by without
+/// calling it:
+///     filter.wantsToFilterAdd, filter.wantsToFilterEdit, filter.wantsToFilterPhysics - false passes those edits
+///     filter.passProperties - names of properties, an edit of none but these is accepted as it is
+///     filter.rejectProperties - names of properties, an edit of any of these is rejected
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    /// The statistics of a filter script, since it was loaded
+    struct FilterStats {
+        EntityItemID entityID; // the zone of the filter, or the null ID for the domain's filter
+        QString url;
+        int numEngines { 0 };
+        uint64_t calls { 0 }; // of the filter function, with its total and longest time
+        uint64_t totalUsecs { 0 };
+        uint64_t maxUsecs { 0 };
+        uint64_t rejected { 0 }; // by the filter function
+        uint64_t passedByRules { 0 }; // decided without calling the filter function
+        uint64_t rejectedByRules { 0 };
+    };
+
+    class FilterScript;
+    using FilterScriptPointer = std::shared_ptr<FilterScript>;
+
     struct FilterData {
-        QScriptValue filterFn;
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
+        FilterScriptPointer script;
         bool rejectAll;
         
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        FilterData(): rejectAll(false) {};
+        bool valid() { return (rejectAll || script != nullptr); }
     };
 
     EntityEditFilters() {};
@@ -42,9 +65,12 @@ public:
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
 
+    // can be called from several threads at once
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID);
 
+    QVector<FilterStats> getStats();
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -56,7 +82,6 @@ private:
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
-    QScriptValue _nullObjectForFilter{};
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
@@ -19,6 +19,9 @@
 #include "EntityItem.h"
 #include "EntityItemProperties.h"
 
+// a script that edits an entity every frame sends its edits at this rate
+const quint64 EntityEditPacketSender::DEFAULT_EDIT_COALESCING_INTERVAL = USECS_PER_SECOND / 20;
+
 EntityEditPacketSender::EntityEditPacketSender() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerDirectListener(PacketType::EntityEditNack, this, "processEntityEditNackPacket");
@@ -29,7 +32,8 @@ void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<Received
 }
 
 void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) {
-    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
+    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics ||
+            type == PacketType::EntityPhysicsPacked) {
         EntityItem::adjustEditPacketForClockSkew(buffer, clockSkew);
     }
 }
@@ -87,8 +91,95 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return;
     }
 
+    if (_editCoalescingInterval == 0) {
+        sendEditEntityMessage(type, entityItemID, properties);
+        return;
+    }
+
+    QMutexLocker lock(&_coalescedEditsLock);
+    if (type != PacketType::EntityEdit && !_coalescedEdits.contains(entityItemID)) {
+        sendEditEntityMessage(type, entityItemID, properties);
+        return;
+    }
+    quint64 now = usecTimestampNow();
+    CoalescedEdit& edit = _coalescedEdits[entityItemID];
+    bool isExact = type != PacketType::EntityEdit || properties.simulationOwnerChanged() ||
+        properties.parentIDChanged() || properties.parentJointIndexChanged() || properties.actionDataChanged();
+    if (isExact) {
+        // the merged edits go first, so that this one isn't overtaken by older values
+        if (edit.hasProperties) {
+            sendEditEntityMessage(PacketType::EntityEdit, entityItemID, edit.properties);
+        }
+        sendEditEntityMessage(type, entityItemID, properties);
+        edit = CoalescedEdit();
+        edit.lastSent = now;
+        return;
+    }
+
+    if (edit.hasProperties) {
+        quint64 lastEdited = properties.getLastEdited();
+        edit.properties.merge(properties);
+        edit.properties.setLastEdited(lastEdited);
+    } else {
+        edit.properties = properties;
+        edit.hasProperties = true;
+    }
+    if (now >= edit.lastSent + _editCoalescingInterval) {
+        // the first edit after a quiet interval goes out at once
+        sendEditEntityMessage(PacketType::EntityEdit, entityItemID, edit.properties);
+        edit = CoalescedEdit();
+        edit.lastSent = now;
+    }
+}
+
+void EntityEditPacketSender::flushCoalescedEdits() {
+    if (flushCoalescedEdits(usecTimestampNow(), true)) {
+        releaseQueuedMessages();
+    }
+}
+
+bool EntityEditPacketSender::process() {
+    if (flushCoalescedEdits(usecTimestampNow(), false)) {
+        releaseQueuedMessages();
+    }
+    return OctreeEditPacketSender::process();
+}
+
+bool EntityEditPacketSender::flushCoalescedEdits(const quint64& now, bool all) {
+    QMutexLocker lock(&_coalescedEditsLock);
+    bool queued = false;
+    auto editItr = _coalescedEdits.begin();
+    while (editItr != _coalescedEdits.end()) {
+        CoalescedEdit& edit = editItr.value();
+        if (!all && now < edit.lastSent + _editCoalescingInterval) {
+            ++editItr;
+            continue;
+        }
+        if (!edit.hasProperties) {
+            // nothing was edited during the interval
+            editItr = _coalescedEdits.erase(editItr);
+            continue;
+        }
+        sendEditEntityMessage(PacketType::EntityEdit, editItr.key(), edit.properties);
+        queued = true;
+        edit = CoalescedEdit();
+        edit.lastSent = now;
+        ++editItr;
+    }
+    return queued;
+}
+
+void EntityEditPacketSender::sendEditEntityMessage(PacketType type, EntityItemID entityItemID,
+                                                   const EntityItemProperties& properties) {
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
 
+    if (type == PacketType::EntityPhysics &&
+            EntityItemProperties::encodeEntityPhysicsPackedPacket(entityItemID, properties, bufferOut)) {
+        // most physics updates are just the motion of an entity we simulate
+        queueOctreeEditMessage(PacketType::EntityPhysicsPacked, bufferOut);
+        return;
+    }
+
     bool success;
     if (properties.parentIDChanged() && properties.getParentID() == AVATAR_SELF_ID) {
         EntityItemProperties propertiesCopy = properties;
@@ -120,6 +211,12 @@ void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityI
         _myAvatar->clearAvatarEntity(entityItemID);
     }
 
+    {
+        // the edits not sent yet are moot
+        QMutexLocker lock(&_coalescedEditsLock);
+        _coalescedEdits.remove(entityItemID);
+    }
+
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
     if (EntityItemProperties::encodeEraseEntityMessage(entityItemID, bufferOut)) {
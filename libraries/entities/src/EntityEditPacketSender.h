@@ -12,6 +12,9 @@
 #ifndef hifi_EntityEditPacketSender_h
 #define hifi_EntityEditPacketSender_h
 
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
 #include <OctreeEditPacketSender.h>
 
 #include "EntityItem.h"
@@ -37,9 +40,25 @@ public:
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
+    /// The EntityEdit messages of an entity queued within this many usecs of the last one that was sent are merged, the
+    /// latest value of each property winning, and sent when the interval is over. Edits of the simulation owner, the
+    /// parent and the actions are sent as they are queued, after the merged edits before them. 0 turns merging off.
+    void setEditCoalescingInterval(quint64 interval) { _editCoalescingInterval = interval; }
+    quint64 getEditCoalescingInterval() const { return _editCoalescingInterval; }
+    static const quint64 DEFAULT_EDIT_COALESCING_INTERVAL;
+
+    /// queues the merged edits now, whether their interval is over or not
+    void flushCoalescedEdits();
+
+    /// sends the merged edits whose interval is over, along with the other queued messages
+    virtual bool process() override;
+
     // My server type is the model server
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
+    // the edits of an entity carry the root octal code rather than its position, and an entity server owns the entities
+    // in its jurisdiction, so every entity server gets every edit and keeps the ones for the entities it owns
+    virtual bool shouldSendToAllServers(PacketType type) const override { return true; }
 
 public slots:
     void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
@@ -48,8 +67,21 @@ private:
     void queueEditAvatarEntityMessage(PacketType type, EntityTreePointer entityTree,
                                       EntityItemID entityItemID, const EntityItemProperties& properties);
 
+    void sendEditEntityMessage(PacketType type, EntityItemID entityItemID, const EntityItemProperties& properties);
+    bool flushCoalescedEdits(const quint64& now, bool all); // returns true if it queued any
+
+    struct CoalescedEdit {
+        quint64 lastSent { 0 }; // the interval of the entity starts there
+        bool hasProperties { false };
+        EntityItemProperties properties; // the merged edits since then
+    };
+
 private:
     AvatarData* _myAvatar { nullptr };
     QScriptEngine _scriptEngine;
+
+    quint64 _editCoalescingInterval { DEFAULT_EDIT_COALESCING_INTERVAL };
+    QMutex _coalescedEditsLock;
+    QHash<EntityItemID, CoalescedEdit> _coalescedEdits;
 };
 #endif // hifi_EntityEditPacketSender_h
@@ -185,11 +185,30 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
+    bool isContinuation = entityTreeElementExtraEncodeData &&
+        entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+    if (isContinuation) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+    } else {
+        // a static entity sent to many clients encodes to the same bytes each time, so re-send the last encoding when it
+        // was made at the same times we'd encode at now
+        auto encodedData = std::atomic_load(&_encodedData);
+        if (encodedData && encodedData->lastEdited == getLastEdited() && encodedData->lastUpdated == getLastUpdated() &&
+                encodedData->lastSimulated == getLastSimulated() && encodedData->changedOnServer == _changedOnServer &&
+                encodedData->requestedProperties == requestedProperties &&
+                encodedData->data.size() <= packetData->getBytesAvailable()) {
+            LevelDetails encodedLevel = packetData->startLevel();
+            if (packetData->appendRawData(encodedData->data)) {
+                packetData->endLevel(encodedLevel);
+                params.trackSend(getID(), getLastEdited());
+                return OctreeElement::COMPLETED;
+            }
+            packetData->discardLevel(encodedLevel);
+        }
     }
 
     LevelDetails entityLevel = packetData->startLevel();
+    int startOfEntity = packetData->getUncompressedByteOffset();
 
     quint64 lastEdited = getLastEdited();
 
@@ -209,7 +228,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     bool successPropertyFlagsFits = false;
     int propertyFlagsOffset = 0;
     int oldPropertyFlagsLength = 0;
-    QByteArray encodedPropertyFlags;
+    uint8_t encodedPropertyFlags[EntityPropertyFlags::MAX_ENCODED_LENGTH];
     int propertyCount = 0;
 
     successIDFits = packetData->appendRawData(encodedID);
@@ -231,9 +250,8 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     if (successLastSimulatedFits) {
         propertyFlagsOffset = packetData->getUncompressedByteOffset();
-        encodedPropertyFlags = propertyFlags;
-        oldPropertyFlagsLength = encodedPropertyFlags.length();
-        successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags);
+        oldPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags, EntityPropertyFlags::MAX_ENCODED_LENGTH);
+        successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags, oldPropertyFlagsLength);
     }
 
     bool headerFits = successIDFits && successTypeFits && successCreatedFits && successLastEditedFits
@@ -304,10 +322,8 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     if (propertyCount > 0) {
         int endOfEntityItemData = packetData->getUncompressedByteOffset();
-        encodedPropertyFlags = propertyFlags;
-        int newPropertyFlagsLength = encodedPropertyFlags.length();
-        packetData->updatePriorBytes(propertyFlagsOffset,
-                (const unsigned char*)encodedPropertyFlags.constData(), encodedPropertyFlags.length());
+        int newPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags, EntityPropertyFlags::MAX_ENCODED_LENGTH);
+        packetData->updatePriorBytes(propertyFlagsOffset, encodedPropertyFlags, newPropertyFlagsLength);
 
         // if the size of the PropertyFlags shrunk, we need to shift everything down to front of packet.
         if (newPropertyFlagsLength < oldPropertyFlagsLength) {
@@ -340,6 +356,19 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         params.trackSend(getID(), getLastEdited());
     }
 
+    // keep a complete encoding for the next clients, unless it holds our session dependent AVATAR_SELF_ID conversion
+    if (appendState == OctreeElement::COMPLETED && !isContinuation && getParentID() != AVATAR_SELF_ID) {
+        auto encodedData = std::make_shared<EncodedData>();
+        encodedData->lastEdited = getLastEdited();
+        encodedData->lastUpdated = getLastUpdated();
+        encodedData->lastSimulated = getLastSimulated();
+        encodedData->changedOnServer = _changedOnServer;
+        encodedData->requestedProperties = requestedProperties;
+        encodedData->data = QByteArray((const char*)packetData->getUncompressedData(startOfEntity),
+                                       packetData->getUncompressedByteOffset() - startOfEntity);
+        std::atomic_store(&_encodedData, std::shared_ptr<const EncodedData>(encodedData));
+    }
+
     return appendState;
 }
 
@@ -872,6 +901,10 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
     // information.
     if (_element && _element->getTree()) {
         _element->getTree()->trackIncomingEntityLastEdited(lastEditedFromBufferAdjusted, bytesRead);
+        // the stream carries every property of the entity, not only those that were edited
+        if (overwriteLocalData) {
+            _element->getTree()->recordPropertyChanges(getEntityItemID(), propertyFlags);
+        }
     }
 
 
@@ -1027,6 +1060,8 @@ void EntityItem::simulate(const quint64& now) {
     _lastSimulated = now;
 }
 
+const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
+
 bool EntityItem::stepKinematicMotion(float timeElapsed) {
     // get all the data
     Transform transform;
@@ -1034,6 +1069,41 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
     glm::vec3 angularVelocity;
     getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
 
+    // acceleration is in world-frame but we need it in local-frame
+    glm::vec3 linearAcceleration = _acceleration;
+    if (glm::length2(linearVelocity) > 0.0f &&
+            glm::length2(linearAcceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        bool success;
+        Transform parentTransform = getParentTransform(success);
+        if (success) {
+            linearAcceleration = glm::inverse(parentTransform.getRotation()) * linearAcceleration;
+        }
+    }
+
+    glm::vec3 position = transform.getTranslation();
+    glm::quat rotation = transform.getRotation();
+    if (!integrateKinematicMotion(timeElapsed, _damping, _angularDamping, linearAcceleration,
+                                  position, rotation, linearVelocity, angularVelocity)) {
+        return false;
+    }
+    if (timeElapsed <= 0.0f) {
+        // someone gave us a useless time value so bail early
+        // but return 'true' because it is moving
+        return true;
+    }
+
+    if (rotation != transform.getRotation()) {
+        transform.setRotation(rotation);
+    }
+    transform.setTranslation(position);
+    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+    return true;
+}
+
+bool EntityItem::integrateKinematicMotion(float timeElapsed, float damping, float angularDamping,
+                                          const glm::vec3& linearAcceleration, glm::vec3& position, glm::quat& rotation,
+                                          glm::vec3& linearVelocity, glm::vec3& angularVelocity) {
     // find out if it is moving
     bool isSpinning = (glm::length2(angularVelocity) > 0.0f);
     float linearSpeedSquared = glm::length2(linearVelocity);
@@ -1044,8 +1114,6 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
     }
 
     if (timeElapsed <= 0.0f) {
-        // someone gave us a useless time value so bail early
-        // but return 'true' because it is moving
         return true;
     }
 
@@ -1057,8 +1125,8 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
 
     if (isSpinning) {
         // angular damping
-        if (_angularDamping > 0.0f) {
-            angularVelocity *= powf(1.0f - _angularDamping, timeElapsed);
+        if (angularDamping > 0.0f) {
+            angularVelocity *= powf(1.0f - angularDamping, timeElapsed);
         }
 
         const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
@@ -1068,38 +1136,27 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
         } else {
             // for improved agreement with the way Bullet integrates rotations we use an approximation
             // and break the integration into bullet-sized substeps
-            glm::quat rotation = transform.getRotation();
             float dt = timeElapsed;
             while (dt > 0.0f) {
                 glm::quat  dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
                 rotation = glm::normalize(dQ * rotation);
                 dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
             }
-            transform.setRotation(rotation);
         }
     }
 
-    glm::vec3 position = transform.getTranslation();
     const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
         KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
     if (isTranslating) {
         glm::vec3 deltaVelocity = Vectors::ZERO;
 
         // linear damping
-        if (_damping > 0.0f) {
-            deltaVelocity = (powf(1.0f - _damping, timeElapsed) - 1.0f) * linearVelocity;
+        if (damping > 0.0f) {
+            deltaVelocity = (powf(1.0f - damping, timeElapsed) - 1.0f) * linearVelocity;
         }
 
-        const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
-        if (glm::length2(_acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        if (glm::length2(linearAcceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
             // yes acceleration
-            // acceleration is in world-frame but we need it in local-frame
-            glm::vec3 linearAcceleration = _acceleration;
-            bool success;
-            Transform parentTransform = getParentTransform(success);
-            if (success) {
-                linearAcceleration = glm::inverse(parentTransform.getRotation()) * linearAcceleration;
-            }
             deltaVelocity += linearAcceleration * timeElapsed;
 
             if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
@@ -1126,9 +1183,6 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
         }
     }
 
-    transform.setTranslation(position);
-    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
-
     return true;
 }
 
@@ -1394,6 +1448,16 @@ void EntityItem::recordCreationTime() {
     _lastSimulated = now;
 }
 
+void EntityItem::markAsChangedOnServer() {
+    _changedOnServer = usecTimestampNow();
+    std::atomic_store(&_encodedData, std::shared_ptr<const EncodedData>());
+
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->logEntityChange(getEntityItemID());
+    }
+}
+
 const Transform EntityItem::getTransformToCenter(bool& success) const {
     Transform result = getTransform(success);
     if (getRegistrationPoint() != ENTITY_ITEM_HALF_VEC3) { // If it is not already centered, translate to center
@@ -122,7 +122,7 @@ public:
     quint64 getLastBroadcast() const { return _lastBroadcast; }
     void setLastBroadcast(quint64 lastBroadcast) { _lastBroadcast = lastBroadcast; }
 
-    void markAsChangedOnServer() { _changedOnServer = usecTimestampNow();  }
+    void markAsChangedOnServer(); // also logs the change with our tree, for the entity server to send
     quint64 getLastChangedOnServer() const { return _changedOnServer; }
 
     // TODO: eventually only include properties changed since the params.lastQuerySent time
@@ -167,8 +167,14 @@ public:
     // perform linear extrapolation for SimpleEntitySimulation
     void simulate(const quint64& now);
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
+    /// the motion of stepKinematicMotion on plain values, linearAcceleration in the parent's frame
+    static bool integrateKinematicMotion(float timeElapsed, float damping, float angularDamping,
+                                         const glm::vec3& linearAcceleration, glm::vec3& position, glm::quat& rotation,
+                                         glm::vec3& linearVelocity, glm::vec3& angularVelocity); // return 'true' if moving
 
     virtual bool needsToCallUpdate() const { return false; }
+    /// when update needs to be called next, after it was called at now - the default is the next simulation update
+    virtual quint64 getNextUpdateTime(const quint64& now) const { return now; }
 
     virtual void debugDump() const;
 
@@ -267,6 +273,10 @@ public:
     const QString& getCollisionSoundURL() const { return _collisionSoundURL; }
     void setCollisionSoundURL(const QString& value);
 
+    /// a script added a collisionWithEntity handler for this entity
+    bool hasCollisionHandler() const { return _hasCollisionHandler; }
+    void setHasCollisionHandler(bool value) { _hasCollisionHandler = value; }
+
     SharedSoundPointer getCollisionSound();
     void setCollisionSound(SharedSoundPointer sound) { _collisionSound = sound; }
 
@@ -496,6 +506,18 @@ protected:
     quint64 _created;
     quint64 _changedOnServer;
 
+    // the last complete encoding of this entity, sent as is to the next clients while none of the times it was encoded at
+    // have changed - the send threads encode concurrently, so it is only read and replaced with std::atomic_load/atomic_store
+    struct EncodedData {
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        quint64 changedOnServer;
+        EntityPropertyFlags requestedProperties;
+        QByteArray data;
+    };
+    mutable std::shared_ptr<const EncodedData> _encodedData;
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
@@ -529,6 +551,7 @@ protected:
     quint64 _loadedScriptTimestamp { ENTITY_ITEM_DEFAULT_SCRIPT_TIMESTAMP + 1 };
 
     QString _collisionSoundURL;
+    bool _hasCollisionHandler { false };
     SharedSoundPointer _collisionSound;
     glm::vec3 _registrationPoint;
     float _angularDamping;
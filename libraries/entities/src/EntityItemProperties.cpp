@@ -245,6 +245,7 @@ EntityPropertyFlags EntityItemProperties::getChangedProperties() const {
     CHECK_PROPERTY_CHANGE(PROP_ALPHA_START, alphaStart);
     CHECK_PROPERTY_CHANGE(PROP_ALPHA_FINISH, alphaFinish);
     CHECK_PROPERTY_CHANGE(PROP_EMITTER_SHOULD_TRAIL, emitterShouldTrail);
+    CHECK_PROPERTY_CHANGE(PROP_GPU_SIMULATION, gpuSimulation);
     CHECK_PROPERTY_CHANGE(PROP_MODEL_URL, modelURL);
     CHECK_PROPERTY_CHANGE(PROP_COMPOUND_SHAPE_URL, compoundShapeURL);
     CHECK_PROPERTY_CHANGE(PROP_VISIBLE, visible);
@@ -440,6 +441,7 @@ QScriptValue EntityItemProperties::copyToScriptValue(QScriptEngine* engine, bool
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_ALPHA_START, alphaStart);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_ALPHA_FINISH, alphaFinish);
         COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_EMITTER_SHOULD_TRAIL, emitterShouldTrail);
+        COPY_PROPERTY_TO_QSCRIPTVALUE(PROP_GPU_SIMULATION, gpuSimulation);
     }
 
     // Models only
@@ -629,6 +631,7 @@ void EntityItemProperties::copyFromScriptValue(const QScriptValue& object, bool
     COPY_PROPERTY_FROM_QSCRIPTVALUE(alphaStart, float, setAlphaStart);
     COPY_PROPERTY_FROM_QSCRIPTVALUE(alphaFinish, float, setAlphaFinish);
     COPY_PROPERTY_FROM_QSCRIPTVALUE(emitterShouldTrail , bool, setEmitterShouldTrail);
+    COPY_PROPERTY_FROM_QSCRIPTVALUE(gpuSimulation, bool, setGPUSimulation);
     COPY_PROPERTY_FROM_QSCRIPTVALUE(modelURL, QString, setModelURL);
     COPY_PROPERTY_FROM_QSCRIPTVALUE(compoundShapeURL, QString, setCompoundShapeURL);
     COPY_PROPERTY_FROM_QSCRIPTVALUE(localRenderAlpha, float, setLocalRenderAlpha);
@@ -757,6 +760,7 @@ void EntityItemProperties::merge(const EntityItemProperties& other) {
     COPY_PROPERTY_IF_CHANGED(lifetime);
     COPY_PROPERTY_IF_CHANGED(script);
     COPY_PROPERTY_IF_CHANGED(scriptTimestamp);
+    COPY_PROPERTY_IF_CHANGED(serverScripts);
     COPY_PROPERTY_IF_CHANGED(registrationPoint);
     COPY_PROPERTY_IF_CHANGED(angularVelocity);
     COPY_PROPERTY_IF_CHANGED(angularDamping);
@@ -770,6 +774,7 @@ void EntityItemProperties::merge(const EntityItemProperties& other) {
     COPY_PROPERTY_IF_CHANGED(alphaStart);
     COPY_PROPERTY_IF_CHANGED(alphaFinish);
     COPY_PROPERTY_IF_CHANGED(emitterShouldTrail);
+    COPY_PROPERTY_IF_CHANGED(gpuSimulation);
     COPY_PROPERTY_IF_CHANGED(modelURL);
     COPY_PROPERTY_IF_CHANGED(compoundShapeURL);
     COPY_PROPERTY_IF_CHANGED(localRenderAlpha);
@@ -936,6 +941,7 @@ void EntityItemProperties::entityPropertyFlagsFromScriptValue(const QScriptValue
         ADD_PROPERTY_TO_MAP(PROP_ALPHA_START, AlphaStart, alphaStart, float);
         ADD_PROPERTY_TO_MAP(PROP_ALPHA_FINISH, AlphaFinish, alphaFinish, float);
         ADD_PROPERTY_TO_MAP(PROP_EMITTER_SHOULD_TRAIL, EmitterShouldTrail, emitterShouldTrail, bool);
+        ADD_PROPERTY_TO_MAP(PROP_GPU_SIMULATION, GPUSimulation, gpuSimulation, bool);
         ADD_PROPERTY_TO_MAP(PROP_MODEL_URL, ModelURL, modelURL, QString);
         ADD_PROPERTY_TO_MAP(PROP_COMPOUND_SHAPE_URL, CompoundShapeURL, compoundShapeURL, QString);
         ADD_PROPERTY_TO_MAP(PROP_REGISTRATION_POINT, RegistrationPoint, registrationPoint, glm::vec3);
@@ -1162,9 +1168,9 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
         bool successLastUpdatedFits = packetData->appendRawData(encodedUpdateDelta);
 
         int propertyFlagsOffset = packetData->getUncompressedByteOffset();
-        QByteArray encodedPropertyFlags = propertyFlags;
-        int oldPropertyFlagsLength = encodedPropertyFlags.length();
-        bool successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags);
+        uint8_t encodedPropertyFlags[EntityPropertyFlags::MAX_ENCODED_LENGTH];
+        int oldPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags, EntityPropertyFlags::MAX_ENCODED_LENGTH);
+        bool successPropertyFlagsFits = packetData->appendRawData(encodedPropertyFlags, oldPropertyFlagsLength);
         int propertyCount = 0;
 
         bool headerFits = successIDFits && successTypeFits && successLastEditedFits
@@ -1276,6 +1282,7 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
                 APPEND_ENTITY_PROPERTY(PROP_ALPHA_START, properties.getAlphaStart());
                 APPEND_ENTITY_PROPERTY(PROP_ALPHA_FINISH, properties.getAlphaFinish());
                 APPEND_ENTITY_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, properties.getEmitterShouldTrail());
+                APPEND_ENTITY_PROPERTY(PROP_GPU_SIMULATION, properties.getGPUSimulation());
             }
 
             if (properties.getType() == EntityTypes::Zone) {
@@ -1342,10 +1349,8 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
         if (propertyCount > 0) {
             int endOfEntityItemData = packetData->getUncompressedByteOffset();
 
-            encodedPropertyFlags = propertyFlags;
-            int newPropertyFlagsLength = encodedPropertyFlags.length();
-            packetData->updatePriorBytes(propertyFlagsOffset,
-                                         (const unsigned char*)encodedPropertyFlags.constData(), encodedPropertyFlags.length());
+            int newPropertyFlagsLength = propertyFlags.encode(encodedPropertyFlags, EntityPropertyFlags::MAX_ENCODED_LENGTH);
+            packetData->updatePriorBytes(propertyFlagsOffset, encodedPropertyFlags, newPropertyFlagsLength);
 
             // if the size of the PropertyFlags shrunk, we need to shift everything down to front of packet.
             if (newPropertyFlagsLength < oldPropertyFlagsLength) {
@@ -1477,8 +1482,8 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     //quint64 lastUpdated = lastEdited + updateDelta; // don't adjust for clock skew since we already did that for lastEdited
 
     // Property Flags...
-    QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
-    EntityPropertyFlags propertyFlags = encodedPropertyFlags;
+    EntityPropertyFlags propertyFlags;
+    propertyFlags.decode(dataAt, bytesToRead - processedBytes);
     dataAt += propertyFlags.getEncodedLength();
     processedBytes += propertyFlags.getEncodedLength();
 
@@ -1577,6 +1582,7 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_ALPHA_START, float, setAlphaStart);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_ALPHA_FINISH, float, setAlphaFinish);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_EMITTER_SHOULD_TRAIL, bool, setEmitterShouldTrail);
+        READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_GPU_SIMULATION, bool, setGPUSimulation);
     }
 
     if (properties.getType() == EntityTypes::Zone) {
@@ -1668,6 +1674,161 @@ bool EntityItemProperties::encodeEraseEntityMessage(const EntityItemID& entityIt
     return true;
 }
 
+// An EntityPhysicsPacked message is the root octcode and the last edited time, as in an edit message so the sender can
+// adjust it for clock skew, then the ID, a byte of flags, the local position and the rotation and the derivatives that
+// are not zero, quantized. The messages can be lost, so each carries the full state rather than a delta.
+enum PhysicsPackedFlags : uint8_t {
+    PHYSICS_PACKED_HAS_VELOCITY = 0x01,
+    PHYSICS_PACKED_HAS_ANGULAR_VELOCITY = 0x02,
+    PHYSICS_PACKED_HAS_ACCELERATION = 0x04
+};
+const int PHYSICS_PACKED_VELOCITY_RADIX = 7; // +/- 256 m/s, to 8 mm/s
+const int PHYSICS_PACKED_ANGULAR_VELOCITY_RADIX = 9; // +/- 64 rad/s, to 2 mrad/s
+const int PHYSICS_PACKED_ACCELERATION_RADIX = 7;
+const int PHYSICS_PACKED_VEC3_BYTES = 3 * sizeof(int16_t);
+const int PHYSICS_PACKED_ROTATION_BYTES = 6;
+
+static bool fitsSignedTwoByteFixed(const glm::vec3& value, int radix) {
+    const float MAX_VALUE = (float)INT16_MAX / (float)(1 << radix);
+    return glm::all(glm::lessThan(glm::abs(value), glm::vec3(MAX_VALUE)));
+}
+
+bool EntityItemProperties::encodeEntityPhysicsPackedPacket(EntityItemID id, const EntityItemProperties& properties,
+                                                           QByteArray& buffer) {
+    EntityPropertyFlags otherProperties = properties.getChangedProperties();
+    otherProperties -= PROP_POSITION;
+    otherProperties -= PROP_ROTATION;
+    otherProperties -= PROP_VELOCITY;
+    otherProperties -= PROP_ANGULAR_VELOCITY;
+    otherProperties -= PROP_ACCELERATION;
+    // these only route the edit on our side
+    otherProperties -= PROP_CLIENT_ONLY;
+    otherProperties -= PROP_OWNING_AVATAR_ID;
+    if (!otherProperties.isEmpty() || !properties.positionChanged() || !properties.rotationChanged()) {
+        return false;
+    }
+
+    glm::vec3 velocity = properties.getVelocity();
+    glm::vec3 angularVelocity = properties.getAngularVelocity();
+    glm::vec3 acceleration = properties.getAcceleration();
+    if (!fitsSignedTwoByteFixed(velocity, PHYSICS_PACKED_VELOCITY_RADIX) ||
+        !fitsSignedTwoByteFixed(angularVelocity, PHYSICS_PACKED_ANGULAR_VELOCITY_RADIX) ||
+        !fitsSignedTwoByteFixed(acceleration, PHYSICS_PACKED_ACCELERATION_RADIX)) {
+        return false;
+    }
+    uint8_t flags = 0;
+    if (velocity != Vectors::ZERO) {
+        flags |= PHYSICS_PACKED_HAS_VELOCITY;
+    }
+    if (angularVelocity != Vectors::ZERO) {
+        flags |= PHYSICS_PACKED_HAS_ANGULAR_VELOCITY;
+    }
+    if (acceleration != Vectors::ZERO) {
+        flags |= PHYSICS_PACKED_HAS_ACCELERATION;
+    }
+
+    unsigned char* octcode = pointToOctalCode(0.0f, 0.0f, 0.0f, 0.5f);
+    int octcodeBytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(octcode));
+    const int MAX_PACKED_BYTES = octcodeBytes + sizeof(quint64) + NUM_BYTES_RFC4122_UUID + sizeof(flags) +
+        sizeof(glm::vec3) + PHYSICS_PACKED_ROTATION_BYTES + 3 * PHYSICS_PACKED_VEC3_BYTES;
+    if (buffer.size() < MAX_PACKED_BYTES) {
+        delete[] octcode;
+        return false;
+    }
+
+    unsigned char* copyAt = reinterpret_cast<unsigned char*>(buffer.data());
+    memcpy(copyAt, octcode, octcodeBytes);
+    copyAt += octcodeBytes;
+    delete[] octcode;
+
+    quint64 lastEdited = properties.getLastEdited();
+    memcpy(copyAt, &lastEdited, sizeof(lastEdited));
+    copyAt += sizeof(lastEdited);
+
+    memcpy(copyAt, id.toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+    copyAt += NUM_BYTES_RFC4122_UUID;
+
+    *copyAt++ = flags;
+
+    glm::vec3 position = properties.getPosition();
+    memcpy(copyAt, &position, sizeof(position));
+    copyAt += sizeof(position);
+    copyAt += packOrientationQuatToSixBytes(copyAt, properties.getRotation());
+
+    if (flags & PHYSICS_PACKED_HAS_VELOCITY) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, velocity, PHYSICS_PACKED_VELOCITY_RADIX);
+    }
+    if (flags & PHYSICS_PACKED_HAS_ANGULAR_VELOCITY) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, angularVelocity, PHYSICS_PACKED_ANGULAR_VELOCITY_RADIX);
+    }
+    if (flags & PHYSICS_PACKED_HAS_ACCELERATION) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, acceleration, PHYSICS_PACKED_ACCELERATION_RADIX);
+    }
+
+    buffer.resize((int)(copyAt - reinterpret_cast<unsigned char*>(buffer.data())));
+    return true;
+}
+
+bool EntityItemProperties::decodeEntityPhysicsPackedPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                           EntityItemID& entityID, EntityItemProperties& properties) {
+    processedBytes = 0;
+    if (bytesToRead < 1) {
+        return false;
+    }
+    int octcodeBytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(data, bytesToRead));
+    const int MIN_PACKED_BYTES = octcodeBytes + sizeof(quint64) + NUM_BYTES_RFC4122_UUID + sizeof(uint8_t) +
+        sizeof(glm::vec3) + PHYSICS_PACKED_ROTATION_BYTES;
+    if (bytesToRead < MIN_PACKED_BYTES) {
+        processedBytes = bytesToRead;
+        return false;
+    }
+    const unsigned char* dataAt = data + octcodeBytes;
+
+    quint64 lastEdited;
+    memcpy(&lastEdited, dataAt, sizeof(lastEdited));
+    dataAt += sizeof(lastEdited);
+    properties.setLastEdited(lastEdited);
+
+    entityID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt), NUM_BYTES_RFC4122_UUID));
+    dataAt += NUM_BYTES_RFC4122_UUID;
+
+    uint8_t flags = *dataAt++;
+    int numVectors = ((flags & PHYSICS_PACKED_HAS_VELOCITY) ? 1 : 0) + ((flags & PHYSICS_PACKED_HAS_ANGULAR_VELOCITY) ? 1 : 0) +
+        ((flags & PHYSICS_PACKED_HAS_ACCELERATION) ? 1 : 0);
+    if (bytesToRead < MIN_PACKED_BYTES + numVectors * PHYSICS_PACKED_VEC3_BYTES) {
+        processedBytes = bytesToRead;
+        return false;
+    }
+
+    glm::vec3 position;
+    memcpy(&position, dataAt, sizeof(position));
+    dataAt += sizeof(position);
+    properties.setPosition(position);
+
+    glm::quat rotation;
+    dataAt += unpackOrientationQuatFromSixBytes(dataAt, rotation);
+    properties.setRotation(rotation);
+
+    glm::vec3 velocity { Vectors::ZERO };
+    glm::vec3 angularVelocity { Vectors::ZERO };
+    glm::vec3 acceleration { Vectors::ZERO };
+    if (flags & PHYSICS_PACKED_HAS_VELOCITY) {
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, velocity, PHYSICS_PACKED_VELOCITY_RADIX);
+    }
+    if (flags & PHYSICS_PACKED_HAS_ANGULAR_VELOCITY) {
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, angularVelocity, PHYSICS_PACKED_ANGULAR_VELOCITY_RADIX);
+    }
+    if (flags & PHYSICS_PACKED_HAS_ACCELERATION) {
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, acceleration, PHYSICS_PACKED_ACCELERATION_RADIX);
+    }
+    properties.setVelocity(velocity);
+    properties.setAngularVelocity(angularVelocity);
+    properties.setAcceleration(acceleration);
+
+    processedBytes = (int)(dataAt - data);
+    return true;
+}
+
 void EntityItemProperties::markAllChanged() {
     _lastEditedByChanged = true;
     _simulationOwnerChanged = true;
@@ -1928,6 +2089,9 @@ QList<QString> EntityItemProperties::listChangedProperties() {
     if (emitterShouldTrailChanged()) {
         out += "emitterShouldTrail";
     }
+    if (gpuSimulationChanged()) {
+        out += "gpuSimulation";
+    }
     if (modelURLChanged()) {
         out += "modelURL";
     }
@@ -168,6 +168,7 @@ public:
     DEFINE_PROPERTY(PROP_RADIUS_START, RadiusStart, radiusStart, float, ParticleEffectEntityItem::DEFAULT_RADIUS_START);
     DEFINE_PROPERTY(PROP_RADIUS_FINISH, RadiusFinish, radiusFinish, float, ParticleEffectEntityItem::DEFAULT_RADIUS_FINISH);
     DEFINE_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, EmitterShouldTrail, emitterShouldTrail, bool, ParticleEffectEntityItem::DEFAULT_EMITTER_SHOULD_TRAIL);
+    DEFINE_PROPERTY(PROP_GPU_SIMULATION, GPUSimulation, gpuSimulation, bool, ParticleEffectEntityItem::DEFAULT_GPU_SIMULATION);
     DEFINE_PROPERTY_REF(PROP_MARKETPLACE_ID, MarketplaceID, marketplaceID, QString, ENTITY_ITEM_DEFAULT_MARKETPLACE_ID);
     DEFINE_PROPERTY_GROUP(KeyLight, keyLight, KeyLightPropertyGroup);
     DEFINE_PROPERTY_REF(PROP_VOXEL_VOLUME_SIZE, VoxelVolumeSize, voxelVolumeSize, glm::vec3, PolyVoxEntityItem::DEFAULT_VOXEL_VOLUME_SIZE);
@@ -249,6 +250,14 @@ public:
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
 
+    /// Packs the motion of an EntityPhysics edit in an EntityPhysicsPacked message, with quantized rotation and
+    /// derivatives. Returns false, leaving it to encodeEntityEditPacket(), when the edit carries anything else or its
+    /// derivatives are out of the quantized range.
+    static bool encodeEntityPhysicsPackedPacket(EntityItemID id, const EntityItemProperties& properties,
+                                                QByteArray& buffer);
+    static bool decodeEntityPhysicsPackedPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                EntityItemID& entityID, EntityItemProperties& properties);
+
     bool localRenderAlphaChanged() const { return _localRenderAlphaChanged; }
 
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
@@ -0,0 +1,177 @@
+//
+//  EntityKinematicStore.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityKinematicStore.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+
+// the integration is spread over threads once there are this many entities, in ranges of this many
+const int MIN_ENTITIES_TO_INTEGRATE_IN_PARALLEL = 1024;
+const int ENTITIES_PER_PARALLEL_RANGE = 256;
+
+bool EntityKinematicStore::canStore(const EntityItemPointer& entity) {
+    return !entity->getPhysicsInfo() && entity->isMovingRelativeToParent() && entity->getParentID().isNull();
+}
+
+void EntityKinematicStore::update(const EntityItemPointer& entity) {
+    auto indexIt = _indices.find(entity);
+    if (indexIt != _indices.end()) {
+        if (entity->getLastEdited() != _lastEdited[indexIt.value()]) {
+            read(indexIt.value());
+        }
+        return;
+    }
+
+    int index = size();
+    _indices.insert(entity, index);
+    _entities.push_back(entity);
+    _lastEdited.push_back(0);
+    _lastSimulated.push_back(0);
+    _positions.emplace_back();
+    _rotations.emplace_back();
+    _scales.emplace_back();
+    _linearVelocities.emplace_back();
+    _angularVelocities.emplace_back();
+    _accelerations.emplace_back();
+    _dampings.push_back(0.0f);
+    _angularDampings.push_back(0.0f);
+    _moving.push_back(0);
+    read(index);
+}
+
+void EntityKinematicStore::remove(const EntityItemPointer& entity) {
+    auto indexIt = _indices.find(entity);
+    if (indexIt != _indices.end()) {
+        removeAt(indexIt.value());
+    }
+}
+
+void EntityKinematicStore::clear() {
+    _entities.clear();
+    _lastEdited.clear();
+    _lastSimulated.clear();
+    _positions.clear();
+    _rotations.clear();
+    _scales.clear();
+    _linearVelocities.clear();
+    _angularVelocities.clear();
+    _accelerations.clear();
+    _dampings.clear();
+    _angularDampings.clear();
+    _moving.clear();
+    _indices.clear();
+}
+
+void EntityKinematicStore::step(const quint64& now, std::function<void(const EntityItemPointer&)> moved,
+                                std::function<void(const EntityItemPointer&)> released) {
+    // an entity edited since its state was read, without the simulation being told, is read again
+    for (int i = 0; i < size();) {
+        EntityItemPointer entity = _entities[i];
+        if (entity->getPhysicsInfo() || (entity->getLastEdited() != _lastEdited[i] && !canStore(entity))) {
+            removeAt(i);
+            released(entity);
+            continue;
+        }
+        if (entity->getLastEdited() != _lastEdited[i]) {
+            read(i);
+        }
+        ++i;
+    }
+
+    if (size() < MIN_ENTITIES_TO_INTEGRATE_IN_PARALLEL) {
+        integrate(0, size(), now);
+    } else {
+        tbb::parallel_for(tbb::blocked_range<int>(0, size(), ENTITIES_PER_PARALLEL_RANGE),
+                          [&](const tbb::blocked_range<int>& range) {
+            integrate(range.begin(), range.end(), now);
+        });
+    }
+
+    // the entities are written back one at a time, as that takes their locks and tells their parents and children
+    for (int i = 0; i < size(); ++i) {
+        const EntityItemPointer& entity = _entities[i];
+        entity->setLocalTransformAndVelocities(Transform(_rotations[i], _scales[i], _positions[i]),
+                                               _linearVelocities[i], _angularVelocities[i]);
+        entity->setLastSimulated(now);
+        moved(entity);
+    }
+
+    for (int i = 0; i < size();) {
+        bool stillMoving = glm::length2(_linearVelocities[i]) > 0.0f || glm::length2(_angularVelocities[i]) > 0.0f;
+        if (_moving[i] && stillMoving) {
+            ++i;
+        } else {
+            removeAt(i);
+        }
+    }
+}
+
+void EntityKinematicStore::read(int index) {
+    const EntityItemPointer& entity = _entities[index];
+    Transform transform;
+    entity->getLocalTransformAndVelocities(transform, _linearVelocities[index], _angularVelocities[index]);
+    _positions[index] = transform.getTranslation();
+    _rotations[index] = transform.getRotation();
+    _scales[index] = transform.getScale();
+    _accelerations[index] = entity->getAcceleration();
+    _dampings[index] = entity->getDamping();
+    _angularDampings[index] = entity->getAngularDamping();
+    _lastEdited[index] = entity->getLastEdited();
+    _lastSimulated[index] = entity->getLastSimulated() == 0 ? usecTimestampNow() : entity->getLastSimulated();
+}
+
+void EntityKinematicStore::integrate(int begin, int end, const quint64& now) {
+    for (int i = begin; i < end; ++i) {
+        float timeElapsed = (float)(now - _lastSimulated[i]) / (float)(USECS_PER_SECOND);
+        _moving[i] = EntityItem::integrateKinematicMotion(timeElapsed, _dampings[i], _angularDampings[i], _accelerations[i],
+                                                          _positions[i], _rotations[i],
+                                                          _linearVelocities[i], _angularVelocities[i]);
+        _lastSimulated[i] = now;
+    }
+}
+
+void EntityKinematicStore::removeAt(int index) {
+    // the last entity takes the place of the removed one
+    int last = size() - 1;
+    _indices.remove(_entities[index]);
+    if (index != last) {
+        _indices[_entities[last]] = index;
+        _entities[index] = std::move(_entities[last]);
+        _lastEdited[index] = _lastEdited[last];
+        _lastSimulated[index] = _lastSimulated[last];
+        _positions[index] = _positions[last];
+        _rotations[index] = _rotations[last];
+        _scales[index] = _scales[last];
+        _linearVelocities[index] = _linearVelocities[last];
+        _angularVelocities[index] = _angularVelocities[last];
+        _accelerations[index] = _accelerations[last];
+        _dampings[index] = _dampings[last];
+        _angularDampings[index] = _angularDampings[last];
+        _moving[index] = _moving[last];
+    }
+    _entities.pop_back();
+    _lastEdited.pop_back();
+    _lastSimulated.pop_back();
+    _positions.pop_back();
+    _rotations.pop_back();
+    _scales.pop_back();
+    _linearVelocities.pop_back();
+    _angularVelocities.pop_back();
+    _accelerations.pop_back();
+    _dampings.pop_back();
+    _angularDampings.pop_back();
+    _moving.pop_back();
+}
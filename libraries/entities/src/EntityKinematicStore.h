@@ -0,0 +1,73 @@
+//
+//  EntityKinematicStore.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityKinematicStore_h
+#define hifi_EntityKinematicStore_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QHash>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "EntityItem.h"
+
+/// The motion state of the simple kinematic entities of an EntitySimulation that have no parent, kept in dense arrays.
+///
+/// Stepping an entity through EntityItem::simulate reads its transform and velocities through their locks, and checks
+/// its ancestry, every frame. Here the state is read once when the entity is added, integrated for all the entities in
+/// one pass over the arrays, spread over threads when there are many, and each entity is written back with a single
+/// setLocalTransformAndVelocities. The state is read again whenever the entity is edited from outside the simulation.
+class EntityKinematicStore {
+public:
+    /// entities without a parent, non-physical and moving relative to their parent can be kept in the store
+    static bool canStore(const EntityItemPointer& entity);
+
+    /// adds the entity, or re-reads its state if it was edited since it was added
+    void update(const EntityItemPointer& entity);
+    void remove(const EntityItemPointer& entity);
+    void clear();
+
+    bool contains(const EntityItemPointer& entity) const { return _indices.contains(entity); }
+    int size() const { return (int)_entities.size(); }
+
+    /// integrates every entity up to now, writes its new state back and calls moved with it, then removes the entities
+    /// that stopped moving - an entity that can no longer be kept is removed first and given to released
+    void step(const quint64& now, std::function<void(const EntityItemPointer&)> moved,
+              std::function<void(const EntityItemPointer&)> released);
+
+private:
+    void read(int index);
+    void integrate(int begin, int end, const quint64& now);
+    void removeAt(int index);
+
+    // entity and the time of its last external edit, when its state was read
+    std::vector<EntityItemPointer> _entities;
+    std::vector<quint64> _lastEdited;
+    std::vector<quint64> _lastSimulated;
+
+    // local state
+    std::vector<glm::vec3> _positions;
+    std::vector<glm::quat> _rotations;
+    std::vector<glm::vec3> _scales;
+    std::vector<glm::vec3> _linearVelocities;
+    std::vector<glm::vec3> _angularVelocities;
+    std::vector<glm::vec3> _accelerations; // the same in the local frame, as these entities have no parent
+    std::vector<float> _dampings;
+    std::vector<float> _angularDampings;
+    std::vector<uint8_t> _moving; // set by integrate
+
+    QHash<EntityItemPointer, int> _indices;
+};
+
+#endif // hifi_EntityKinematicStore_h
@@ -28,3 +28,8 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+bool EntityNodeData::hasSentEntity(const QUuid& entityID, quint64 lastChangedOnServer) const {
+    auto it = _sentEntities.find(entityID);
+    return it != _sentEntities.end() && it.value() >= lastChangedOnServer;
+}
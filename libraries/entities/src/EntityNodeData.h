@@ -44,11 +44,25 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // where this node is in the tree's change log, from the start of the scene being sent - send thread only
+    bool hasChangeLogCursor() const { return _hasChangeLogCursor; }
+    uint64_t getChangeLogCursor() const { return _changeLogCursor; }
+    void setChangeLogCursor(uint64_t cursor) { _changeLogCursor = cursor; _hasChangeLogCursor = true; }
+
+    // the last changed on server time of each entity sent to this node, so that the scenes started as the view changes
+    // send only the entities that entered it or changed since they were sent - send thread only
+    bool hasSentEntity(const QUuid& entityID, quint64 lastChangedOnServer) const;
+    void trackSentEntity(const QUuid& entityID, quint64 lastChangedOnServer) { _sentEntities[entityID] = lastChangedOnServer; }
+    void forgetSentEntity(const QUuid& entityID) { _sentEntities.remove(entityID); }
+
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+    uint64_t _changeLogCursor { 0 };
+    bool _hasChangeLogCursor { false };
+    QHash<QUuid, quint64> _sentEntities;
 };
 
 #endif // hifi_EntityNodeData_h
@@ -0,0 +1,516 @@
+//
+//  EntityPersistFile.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPersistFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QJsonDocument>
+#include <QtScript/QScriptEngine>
+
+#include <OctreeConstants.h>
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+#include <VariantMapToScriptValue.h>
+
+#include "EntitiesLogging.h"
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+#include "EntityTreeElement.h"
+#include "EntityTypes.h"
+
+const QString EntityPersistFile::FILE_TYPE = "bin";
+
+// the file is written in host byte order, like the SVO files were
+static const quint32 FILE_MAGIC = 0x48464542; // "HFEB"
+static const quint32 FILE_FORMAT_VERSION = 1;
+static const quint32 SEGMENT_MAGIC = 0x5345474D; // "SEGM"
+
+// the regions a file is materialized by, an 8x8x8 grid over the cube of the tree
+static const int REGIONS_PER_AXIS = 8;
+static const int NUM_REGIONS = REGIONS_PER_AXIS * REGIONS_PER_AXIS * REGIONS_PER_AXIS;
+
+static const quint32 MAX_SEGMENTS_BEFORE_COMPACTION = 64;
+static const int ENCODE_BATCH_SIZE = 1000; // entities encoded per hold of the tree's read lock
+
+struct FileHeader {
+    quint32 magic;
+    quint32 formatVersion;
+    quint32 numSegments;
+    quint32 unused;
+    quint64 committedSize; // anything past this is an append that was cut short
+    quint64 numEntries; // across all segments, including superseded ones
+};
+static_assert(sizeof(FileHeader) == 32, "FileHeader is written as is");
+
+struct SegmentHeader {
+    quint32 magic;
+    quint32 numEntries;
+    quint64 blobsSize; // padded so the next segment's index table is 8 byte aligned
+};
+static_assert(sizeof(SegmentHeader) == 16, "SegmentHeader is written as is");
+
+struct EntityPersistFile::IndexEntry {
+    enum Kind : quint8 {
+        Deleted = 0,
+        Bitstream, // the chunks of EntityItem::appendEntityData, each prefixed with its quint16 size
+        JSON // the non default properties, for an entity with a property too big for a packet
+    };
+
+    quint8 id[NUM_BYTES_RFC4122_UUID];
+    quint64 lastEdited;
+    quint64 blobOffset; // from the start of the file
+    quint32 blobSize;
+    quint16 region;
+    quint8 kind;
+    quint8 bitstreamVersion; // of PacketType::EntityData, when the entry was written
+};
+
+struct EntityPersistFile::Blob {
+    EntityItemID id;
+    IndexEntry entry;
+    QByteArray data;
+};
+
+static quint16 regionForPosition(const glm::vec3& position) {
+    glm::vec3 cellPosition = glm::floor((position + glm::vec3((float)HALF_TREE_SCALE)) *
+                                        ((float)REGIONS_PER_AXIS / (float)TREE_SCALE));
+    glm::ivec3 cell = glm::clamp(glm::ivec3(cellPosition), glm::ivec3(0), glm::ivec3(REGIONS_PER_AXIS - 1));
+    return (quint16)((cell.x * REGIONS_PER_AXIS + cell.y) * REGIONS_PER_AXIS + cell.z);
+}
+
+// the entity as the entity server sends it, in as many packet sized chunks as it takes
+// returns an empty array when a single property doesn't fit in a packet
+static QByteArray encodeBitstream(const EntityItem& entity) {
+    QByteArray blob;
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+
+    OctreeElement::AppendState appendState;
+    do {
+        OctreePacketData packetData;
+        appendState = entity.appendEntityData(&packetData, params, extraEncodeData);
+        if (appendState == OctreeElement::NONE) {
+            // nothing more fit in an empty packet, so it never will
+            return QByteArray();
+        }
+
+        quint16 chunkSize = (quint16)packetData.getUncompressedSize();
+        blob.append(reinterpret_cast<const char*>(&chunkSize), sizeof(chunkSize));
+        blob.append(reinterpret_cast<const char*>(packetData.getUncompressedData()), chunkSize);
+    } while (appendState != OctreeElement::COMPLETED);
+
+    return blob;
+}
+
+static EntityItemPointer decodeBitstream(const unsigned char* data, int size, PacketVersion bitstreamVersion) {
+    ReadBitstreamToTreeParams args(NO_EXISTS_BITS, nullptr, QUuid(), SharedNodePointer(), false, bitstreamVersion);
+    EntityItemPointer entity;
+
+    while (size >= (int)sizeof(quint16)) {
+        quint16 chunkSize;
+        memcpy(&chunkSize, data, sizeof(chunkSize));
+        data += sizeof(chunkSize);
+        size -= sizeof(chunkSize);
+
+        if (chunkSize > size) {
+            return EntityItemPointer();
+        }
+
+        // the first chunk makes the entity, the others add the properties that didn't fit in it
+        if (!entity) {
+            entity = EntityTypes::constructEntityItem(data, chunkSize, args);
+            if (!entity) {
+                return EntityItemPointer();
+            }
+        }
+        entity->readEntityDataFromBuffer(data, chunkSize, args);
+
+        data += chunkSize;
+        size -= chunkSize;
+    }
+
+    return entity;
+}
+
+EntityPersistFile::EntityPersistFile(const QString& path) :
+    _path(path)
+{
+    static_assert(sizeof(IndexEntry) == 40, "IndexEntry is written and read in place as is");
+}
+
+EntityPersistFile::~EntityPersistFile() {
+    closeIndex();
+}
+
+bool EntityPersistFile::load(EntityTree& tree) {
+    if (!openIndex()) {
+        return false;
+    }
+
+    int numEntities = 0;
+    for (int region = 0; region < getNumRegions(); ++region) {
+        numEntities += materializeRegion(tree, region);
+    }
+    qCDebug(entities) << "Loaded" << numEntities << "entities from" << _numSegments << "segments of" << _path;
+
+    closeIndex();
+
+    // what we just added is what the file holds, only the changes from here on need saving
+    _changeLogCursor = tree.getChangeLogSequence();
+    _hasChangeLogCursor = true;
+    return true;
+}
+
+bool EntityPersistFile::openIndex() {
+    closeIndex();
+
+    _file.setFileName(_path);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(entities) << "Could not open entities file" << _path << "-" << _file.errorString();
+        return false;
+    }
+
+    _mappedSize = _file.size();
+    if (_mappedSize >= (qint64)sizeof(FileHeader)) {
+        _mappedData = _file.map(0, _mappedSize);
+    }
+
+    FileHeader header;
+    if (_mappedData) {
+        memcpy(&header, _mappedData, sizeof(header));
+    }
+    if (!_mappedData || header.magic != FILE_MAGIC || header.formatVersion != FILE_FORMAT_VERSION) {
+        qCWarning(entities) << _path << "is not a version" << FILE_FORMAT_VERSION << "entities file";
+        closeIndex();
+        return false;
+    }
+
+    quint64 committedSize = std::min(header.committedSize, (quint64)_mappedSize);
+    quint64 offset = sizeof(FileHeader);
+    _numSegments = 0;
+    _numEntries = 0;
+
+    // later segments supersede the entries of earlier ones
+    while (offset + sizeof(SegmentHeader) <= committedSize) {
+        SegmentHeader segment;
+        memcpy(&segment, _mappedData + offset, sizeof(segment));
+
+        quint64 entriesOffset = offset + sizeof(SegmentHeader);
+        quint64 blobsOffset = entriesOffset + (quint64)segment.numEntries * sizeof(IndexEntry);
+        quint64 endOffset = blobsOffset + segment.blobsSize;
+        if (segment.magic != SEGMENT_MAGIC || endOffset > committedSize) {
+            // keep the segments before it, the next save appends over it
+            qCWarning(entities) << "Entities file" << _path << "is corrupt after" << _numSegments << "segments";
+            break;
+        }
+
+        auto entries = reinterpret_cast<const IndexEntry*>(_mappedData + entriesOffset);
+        for (quint32 i = 0; i < segment.numEntries; ++i) {
+            const IndexEntry& entry = entries[i];
+            EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(entry.id),
+                                                                            NUM_BYTES_RFC4122_UUID)));
+            if (entry.kind == IndexEntry::Deleted) {
+                _entries.remove(entityID);
+            } else if (entry.blobOffset >= blobsOffset && entry.blobOffset + entry.blobSize <= endOffset &&
+                       entry.region < NUM_REGIONS) {
+                _entries[entityID] = &entry;
+            } else {
+                qCWarning(entities) << "Skipping corrupt entry of" << entityID << "in entities file" << _path;
+            }
+        }
+
+        _numEntries += segment.numEntries;
+        ++_numSegments;
+        offset = endOffset;
+    }
+    _committedSize = offset;
+
+    _regions.assign(NUM_REGIONS, std::vector<const IndexEntry*>());
+    _persistedEntityIDs.clear();
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        _regions[it.value()->region].push_back(it.value());
+        _persistedEntityIDs.insert(it.key());
+    }
+
+    return true;
+}
+
+int EntityPersistFile::materializeRegion(EntityTree& tree, int region) {
+    int numAdded = 0;
+    for (auto entry : _regions[region]) {
+        if (decode(tree, *entry)) {
+            ++numAdded;
+        }
+    }
+    return numAdded;
+}
+
+void EntityPersistFile::closeIndex() {
+    _entries.clear();
+    _regions.clear();
+
+    if (_mappedData) {
+        _file.unmap(_mappedData);
+        _mappedData = nullptr;
+    }
+    _mappedSize = 0;
+    _file.close();
+}
+
+EntityItemPointer EntityPersistFile::decode(EntityTree& tree, const IndexEntry& entry) {
+    EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(entry.id),
+                                                                    NUM_BYTES_RFC4122_UUID)));
+    const unsigned char* data = _mappedData + entry.blobOffset;
+
+    EntityItemPointer entity;
+    if (entry.kind == IndexEntry::Bitstream) {
+        if (entry.bitstreamVersion > versionForPacketType(PacketType::EntityData)) {
+            qCWarning(entities) << "Entity" << entityID << "was saved by a newer entity server, skipping it";
+            return EntityItemPointer();
+        }
+
+        entity = decodeBitstream(data, (int)entry.blobSize, entry.bitstreamVersion);
+        if (entity && !tree.addDecodedEntity(entity)) {
+            entity.reset();
+        }
+    } else if (entry.kind == IndexEntry::JSON) {
+        // QJsonDocument --> QVariantMap --> QScriptValue --> EntityItemProperties --> Entity, as EntityTree::readFromMap
+        QByteArray json = QByteArray::fromRawData(reinterpret_cast<const char*>(data), (int)entry.blobSize);
+        QVariantMap entityMap = QJsonDocument::fromJson(json).toVariant().toMap();
+        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, getScriptEngine());
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+        entity = tree.addEntity(entityID, properties);
+    }
+
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << entityID;
+    }
+    return entity;
+}
+
+bool EntityPersistFile::save(EntityTree& tree) {
+    // anything changed after this is saved again by the next save
+    uint64_t changeLogSequence = tree.getChangeLogSequence();
+
+    quint64 numLiveEntries = (quint64)_persistedEntityIDs.size();
+    bool isMostlySuperseded = _numEntries - numLiveEntries > numLiveEntries;
+
+    QSet<EntityItemID> changedEntityIDs;
+    bool canAppend = _hasChangeLogCursor && !isMostlySuperseded && _numSegments < MAX_SEGMENTS_BEFORE_COMPACTION &&
+        QFile::exists(_path) && tree.getEntityChangesSince(_changeLogCursor, changedEntityIDs);
+
+    bool success = canAppend ? append(tree, changedEntityIDs) : compact(tree);
+    if (success) {
+        _changeLogCursor = changeLogSequence;
+        _hasChangeLogCursor = true;
+    }
+    return success;
+}
+
+bool EntityPersistFile::compact(EntityTree& tree) {
+    std::vector<Blob> blobs;
+    encodeEntities(tree, tree.getEntityIDs(), blobs);
+
+    // entities deleted while we were encoding simply aren't in the new file
+    blobs.erase(std::remove_if(blobs.begin(), blobs.end(), [](const Blob& blob) {
+        return blob.entry.kind == IndexEntry::Deleted;
+    }), blobs.end());
+
+    // write the compacted file next to the current one, and only replace it once it is complete
+    QString compactedPath = _path + ".compacted";
+    QFile file(compactedPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(entities) << "Could not write entities file" << compactedPath << "-" << file.errorString();
+        return false;
+    }
+
+    quint64 offset = sizeof(FileHeader);
+    bool success = writeHeader(file, 0, 0, offset) && writeSegment(file, blobs, offset) &&
+        writeHeader(file, 1, blobs.size(), offset);
+    file.close();
+
+    if (!success) {
+        qCWarning(entities) << "Could not write entities file" << compactedPath << "-" << file.errorString();
+        QFile::remove(compactedPath);
+        return false;
+    }
+
+    QFile::remove(_path);
+    if (!QFile::rename(compactedPath, _path)) {
+        qCWarning(entities) << "Could not replace entities file" << _path << "with" << compactedPath;
+        return false;
+    }
+
+    _persistedEntityIDs.clear();
+    for (auto& blob : blobs) {
+        _persistedEntityIDs.insert(blob.id);
+    }
+    _numSegments = 1;
+    _numEntries = blobs.size();
+    _committedSize = offset;
+
+    qCDebug(entities) << "Compacted" << blobs.size() << "entities into" << _path;
+    return true;
+}
+
+bool EntityPersistFile::append(EntityTree& tree, const QSet<EntityItemID>& changedEntityIDs) {
+    if (changedEntityIDs.isEmpty()) {
+        return true;
+    }
+
+    std::vector<Blob> blobs;
+    encodeEntities(tree, changedEntityIDs.toList().toVector(), blobs);
+
+    // an entity added and deleted since the last save was never in the file
+    blobs.erase(std::remove_if(blobs.begin(), blobs.end(), [&](const Blob& blob) {
+        return blob.entry.kind == IndexEntry::Deleted && !_persistedEntityIDs.contains(blob.id);
+    }), blobs.end());
+
+    if (blobs.empty()) {
+        return true;
+    }
+
+    QFile file(_path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(entities) << "Could not append to entities file" << _path << "-" << file.errorString();
+        return false;
+    }
+
+    // drop whatever an append that was cut short left past the committed size, then only make the new segment part of
+    // the file once it is completely written
+    quint64 offset = _committedSize;
+    bool success = file.resize(offset) && writeSegment(file, blobs, offset) &&
+        writeHeader(file, _numSegments + 1, _numEntries + blobs.size(), offset);
+    file.close();
+
+    if (!success) {
+        qCWarning(entities) << "Could not append to entities file" << _path << "-" << file.errorString();
+        return false;
+    }
+
+    for (auto& blob : blobs) {
+        if (blob.entry.kind == IndexEntry::Deleted) {
+            _persistedEntityIDs.remove(blob.id);
+        } else {
+            _persistedEntityIDs.insert(blob.id);
+        }
+    }
+    ++_numSegments;
+    _numEntries += blobs.size();
+    _committedSize = offset;
+
+    return true;
+}
+
+void EntityPersistFile::encodeEntities(EntityTree& tree, const QVector<EntityItemID>& entityIDs,
+                                       std::vector<Blob>& blobs) {
+    PacketVersion bitstreamVersion = versionForPacketType(PacketType::EntityData);
+    blobs.reserve(entityIDs.size());
+
+    // encode in batches, so that edits still get the tree's write lock between them
+    for (int batchStart = 0; batchStart < entityIDs.size(); batchStart += ENCODE_BATCH_SIZE) {
+        int batchEnd = std::min(batchStart + ENCODE_BATCH_SIZE, entityIDs.size());
+
+        quint64 lockStart = usecTimestampNow();
+        tree.withReadLock([&] {
+            for (int i = batchStart; i < batchEnd; ++i) {
+                Blob blob;
+                blob.id = entityIDs[i];
+                memset(&blob.entry, 0, sizeof(blob.entry));
+                QByteArray encodedID = blob.id.toRfc4122();
+                memcpy(blob.entry.id, encodedID.constData(), NUM_BYTES_RFC4122_UUID);
+
+                EntityItemPointer entity = tree.findEntityByEntityItemID(blob.id);
+                if (entity) {
+                    blob.entry.lastEdited = entity->getLastEdited();
+                    blob.entry.region = regionForPosition(entity->getPosition());
+
+                    blob.data = encodeBitstream(*entity);
+                    if (!blob.data.isEmpty()) {
+                        blob.entry.kind = IndexEntry::Bitstream;
+                        blob.entry.bitstreamVersion = bitstreamVersion;
+                    } else {
+                        blob.data = encodeJSON(*entity);
+                        blob.entry.kind = IndexEntry::JSON;
+                    }
+                } else {
+                    blob.entry.kind = IndexEntry::Deleted;
+                }
+
+                blobs.push_back(blob);
+            }
+        });
+        tree.addSaveLockUsecs(usecTimestampNow() - lockStart);
+    }
+
+    // keep each region's blobs together, so materializing a region pages in as little of the file as possible
+    std::stable_sort(blobs.begin(), blobs.end(), [](const Blob& a, const Blob& b) {
+        return a.entry.region < b.entry.region;
+    });
+}
+
+QByteArray EntityPersistFile::encodeJSON(const EntityItem& entity) {
+    QScriptValue properties = EntityItemNonDefaultPropertiesToScriptValue(&getScriptEngine(), entity.getProperties());
+    return QJsonDocument::fromVariant(properties.toVariant()).toJson(QJsonDocument::Compact);
+}
+
+bool EntityPersistFile::writeSegment(QFile& file, const std::vector<Blob>& blobs, quint64& offset) {
+    quint64 blobsOffset = offset + sizeof(SegmentHeader) + blobs.size() * sizeof(IndexEntry);
+
+    std::vector<IndexEntry> entries;
+    entries.reserve(blobs.size());
+    quint64 blobOffset = blobsOffset;
+    for (auto& blob : blobs) {
+        IndexEntry entry = blob.entry;
+        entry.blobOffset = blobOffset;
+        entry.blobSize = (quint32)blob.data.size();
+        entries.push_back(entry);
+        blobOffset += blob.data.size();
+    }
+
+    // pad the blobs, so that the index table of a following segment can be read in place from the mapped file
+    const quint64 ALIGNMENT = 8;
+    quint64 padding = (ALIGNMENT - (blobOffset - blobsOffset) % ALIGNMENT) % ALIGNMENT;
+
+    SegmentHeader segment { SEGMENT_MAGIC, (quint32)entries.size(), blobOffset - blobsOffset + padding };
+    qint64 entriesSize = entries.size() * sizeof(IndexEntry);
+
+    bool success = file.seek(offset) &&
+        file.write(reinterpret_cast<const char*>(&segment), sizeof(segment)) == sizeof(segment) &&
+        file.write(reinterpret_cast<const char*>(entries.data()), entriesSize) == entriesSize;
+    for (auto& blob : blobs) {
+        success = success && file.write(blob.data) == blob.data.size();
+    }
+    success = success && file.write(QByteArray((int)padding, 0)) == (qint64)padding && file.flush();
+
+    if (success) {
+        offset = blobsOffset + segment.blobsSize;
+    }
+    return success;
+}
+
+bool EntityPersistFile::writeHeader(QFile& file, quint32 numSegments, quint64 numEntries, quint64 committedSize) {
+    FileHeader header { FILE_MAGIC, FILE_FORMAT_VERSION, numSegments, 0, committedSize, numEntries };
+    return file.seek(0) && file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header) &&
+        file.flush();
+}
+
+QScriptEngine& EntityPersistFile::getScriptEngine() {
+    if (!_scriptEngine) {
+        _scriptEngine.reset(new QScriptEngine());
+    }
+    return *_scriptEngine;
+}
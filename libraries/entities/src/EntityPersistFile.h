@@ -0,0 +1,99 @@
+//
+//  EntityPersistFile.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPersistFile_h
+#define hifi_EntityPersistFile_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "EntityItem.h"
+#include "EntityItemID.h"
+
+class EntityTree;
+class QScriptEngine;
+
+/// The binary persist format of an entity tree, an alternative to the json.gz file that loads without parsing JSON and
+/// saves without re-writing the whole world.
+///
+/// The file is a fixed header followed by segments, each an index table of fixed size entries and the blobs they point at.
+/// A blob is an entity in the same bitstream the entity server sends, split in chunks when it doesn't fit in one packet.
+/// A save appends one segment with the entities changed since the last one, and the whole file is compacted into a
+/// single segment once more than half of its entries are superseded. Loading maps the file, reads the index tables and
+/// materializes the entities region by region, so each region's blobs are only paged in when it is built.
+class EntityPersistFile {
+public:
+    static const QString FILE_TYPE; // the persist file type, and extension, of the format
+
+    EntityPersistFile(const QString& path);
+    ~EntityPersistFile();
+
+    const QString& getPath() const { return _path; }
+
+    /// adds the entities of the file to the tree, and remembers what is in the file so the next save can append to it
+    /// the caller holds the tree's write lock
+    bool load(EntityTree& tree);
+
+    /// maps the file and reads its index, once this returns the regions can be materialized in any order
+    bool openIndex();
+    int getNumRegions() const { return (int)_regions.size(); }
+    int getNumEntitiesInRegion(int region) const { return (int)_regions[region].size(); }
+    /// adds the entities of one region to the tree, returns how many were added
+    int materializeRegion(EntityTree& tree, int region);
+    void closeIndex();
+
+    /// appends the entities changed since the last load or save, or compacts the file when that isn't possible or
+    /// most of the file is superseded - takes the tree's read lock only while encoding
+    bool save(EntityTree& tree);
+
+private:
+    struct IndexEntry;
+    struct Blob;
+
+    bool compact(EntityTree& tree);
+    bool append(EntityTree& tree, const QSet<EntityItemID>& changedEntityIDs);
+
+    void encodeEntities(EntityTree& tree, const QVector<EntityItemID>& entityIDs, std::vector<Blob>& blobs);
+    QByteArray encodeJSON(const EntityItem& entity);
+    EntityItemPointer decode(EntityTree& tree, const IndexEntry& entry);
+
+    static bool writeSegment(QFile& file, const std::vector<Blob>& blobs, quint64& offset);
+    static bool writeHeader(QFile& file, quint32 numSegments, quint64 numEntries, quint64 committedSize);
+
+    QScriptEngine& getScriptEngine();
+
+    QString _path;
+
+    QFile _file;
+    uchar* _mappedData { nullptr };
+    qint64 _mappedSize { 0 };
+    QHash<EntityItemID, const IndexEntry*> _entries; // the live entry of each entity in the mapped file
+    std::vector<std::vector<const IndexEntry*>> _regions;
+
+    // what the file on disk holds, for the next save
+    bool _hasChangeLogCursor { false };
+    uint64_t _changeLogCursor { 0 };
+    QSet<EntityItemID> _persistedEntityIDs;
+    quint32 _numSegments { 0 };
+    quint64 _numEntries { 0 }; // including superseded ones
+    quint64 _committedSize { 0 };
+
+    std::unique_ptr<QScriptEngine> _scriptEngine; // for the entities that don't fit the bitstream, saved as JSON
+};
+
+#endif // hifi_EntityPersistFile_h
@@ -186,6 +186,8 @@ enum EntityPropertyList {
     PROP_SERVER_SCRIPTS,
 
     PROP_FILTER_URL,
+
+    PROP_GPU_SIMULATION,
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////
     // ATTENTION: add new properties to end of list just ABOVE this line
@@ -233,6 +235,11 @@ enum EntityPropertyList {
     // WARNING!!! DO NOT ADD PROPS_xxx here unless you really really meant to.... Add them UP above
 };
 
+// the flags of every entity are made, merged and tested on each encode and decode, so they are kept in fixed storage
+template<> struct PropertyFlagsTraits<EntityPropertyList> {
+    static const int NUM_FLAGS = PROP_AFTER_LAST_ITEM;
+};
+
 typedef PropertyFlags<EntityPropertyList> EntityPropertyFlags;
 
 // this is set at the top of EntityItemProperties.cpp to PROP_AFTER_LAST_ITEM - 1.  PROP_AFTER_LAST_ITEM is always
@@ -274,44 +274,80 @@ EntityItemProperties EntityScriptingInterface::getEntityProperties(QUuid identit
     EntityItemProperties results;
     if (_entityTree) {
         _entityTree->withReadLock([&] {
-            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(identity));
-            if (entity) {
-                if (desiredProperties.getHasProperty(PROP_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_ROTATION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
-                    desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
-                    // if we are explicitly getting position or rotation, we need parent information to make sense of them.
-                    desiredProperties.setHasProperty(PROP_PARENT_ID);
-                    desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
-                }
+            results = getEntityPropertiesInTree(EntityItemID(identity), desiredProperties);
+        });
+    }
 
-                if (desiredProperties.isEmpty()) {
-                    // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
-                    // don't end up in json saves, etc.  We still want them here, though.
-                    EncodeBitstreamParams params; // unknown
-                    desiredProperties = entity->getEntityProperties(params);
-                    desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
-                    desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
-                }
+    return convertLocationToScriptSemantics(results);
+}
 
-                results = entity->getProperties(desiredProperties);
+void EntityScriptingInterface::addCollisionHandler(const QUuid& entityID) {
+    if (_entityTree) {
+        _entityTree->withReadLock([&] {
+            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+            if (entity) {
+                entity->setHasCollisionHandler(true);
+            }
+        });
+    }
+}
 
-                // TODO: improve naturalDimensions in the future,
-                //       for now we've added this hack for setting natural dimensions of models
-                if (entity->getType() == EntityTypes::Model) {
-                    const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
-                    if (geometry) {
-                        Extents meshExtents = geometry->getUnscaledMeshExtents();
-                        results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
-                        results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
-                    }
-                }
+QVector<EntityItemProperties> EntityScriptingInterface::getEntitiesProperties(const QVector<QUuid>& entityIDs,
+                                                                             EntityPropertyFlags desiredProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
 
+    QVector<EntityItemProperties> results(entityIDs.size());
+    if (_entityTree) {
+        _entityTree->withReadLock([&] {
+            for (int i = 0; i < entityIDs.size(); i++) {
+                results[i] = getEntityPropertiesInTree(EntityItemID(entityIDs[i]), desiredProperties);
             }
         });
     }
 
-    return convertLocationToScriptSemantics(results);
+    for (auto& properties : results) {
+        properties = convertLocationToScriptSemantics(properties);
+    }
+    return results;
+}
+
+EntityItemProperties EntityScriptingInterface::getEntityPropertiesInTree(const EntityItemID& entityID,
+                                                                         EntityPropertyFlags desiredProperties) {
+    EntityItemProperties results;
+    EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+    if (entity) {
+        if (desiredProperties.getHasProperty(PROP_POSITION) ||
+            desiredProperties.getHasProperty(PROP_ROTATION) ||
+            desiredProperties.getHasProperty(PROP_LOCAL_POSITION) ||
+            desiredProperties.getHasProperty(PROP_LOCAL_ROTATION)) {
+            // if we are explicitly getting position or rotation, we need parent information to make sense of them.
+            desiredProperties.setHasProperty(PROP_PARENT_ID);
+            desiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+        }
+
+        if (desiredProperties.isEmpty()) {
+            // these are left out of EntityItem::getEntityProperties so that localPosition and localRotation
+            // don't end up in json saves, etc.  We still want them here, though.
+            EncodeBitstreamParams params; // unknown
+            desiredProperties = entity->getEntityProperties(params);
+            desiredProperties.setHasProperty(PROP_LOCAL_POSITION);
+            desiredProperties.setHasProperty(PROP_LOCAL_ROTATION);
+        }
+
+        results = entity->getProperties(desiredProperties);
+
+        // TODO: improve naturalDimensions in the future,
+        //       for now we've added this hack for setting natural dimensions of models
+        if (entity->getType() == EntityTypes::Model) {
+            const FBXGeometry* geometry = _entityTree->getGeometryForEntity(entity);
+            if (geometry) {
+                Extents meshExtents = geometry->getUnscaledMeshExtents();
+                results.setNaturalDimensions(meshExtents.maximum - meshExtents.minimum);
+                results.calculateNaturalPosition(meshExtents.minimum, meshExtents.maximum);
+            }
+        }
+    }
+    return results;
 }
 
 QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties& scriptSideProperties) {
@@ -319,46 +355,91 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
 
     _activityTracking.editedEntityCount++;
 
-    EntityItemProperties properties = scriptSideProperties;
-
-    auto dimensions = properties.getDimensions();
-    float volume = dimensions.x * dimensions.y * dimensions.z;
-    auto density = properties.getDensity();
-    auto newVelocity = properties.getVelocity().length();
-    float oldVelocity = { 0.0f };
-
     EntityItemID entityID(id);
     if (!_entityTree) {
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
+        return editEntityWithoutTree(entityID, scriptSideProperties) ? id : QUuid();
+    }
+    // If we have a local entity tree set, then also update it.
 
-        //if there is no local entity entity tree, no existing velocity, use 0.
-        float cost = calculateCost(density * volume, oldVelocity, newVelocity);
-        cost *= costMultiplier;
+    QVector<QPair<EntityItemID, EntityItemProperties>> messages;
+    _entityTree->withWriteLock([&] {
+        editEntityInTree(entityID, scriptSideProperties, messages);
+    });
+    for (const auto& message : messages) {
+        queueEntityMessage(PacketType::EntityEdit, message.first, message.second);
+    }
+    return id;
+}
 
-        if (cost > _currentAvatarEnergy) {
-            return QUuid();
-        } else {
-            //debit the avatar energy and continue
-            emit debitEnergySource(cost);
-        }
+QVector<QUuid> EntityScriptingInterface::editEntities(const QScriptValue& edits) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
 
-        return id;
+    QVector<QPair<EntityItemID, EntityItemProperties>> scriptSideEdits;
+    int length = edits.property("length").toInt32();
+    scriptSideEdits.reserve(length);
+    for (int i = 0; i < length; i++) {
+        QScriptValue edit = edits.property(i);
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueHonorReadOnly(edit.property("properties"), properties);
+        scriptSideEdits.push_back({ EntityItemID(QUuid(edit.property("id").toString())), properties });
     }
-    // If we have a local entity tree set, then also update it.
+    _activityTracking.editedEntityCount += scriptSideEdits.size();
 
-    bool updatedEntity = false;
-    _entityTree->withWriteLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
+    QVector<QUuid> results;
+    results.reserve(scriptSideEdits.size());
+    if (!_entityTree) {
+        for (const auto& edit : scriptSideEdits) {
+            results.push_back(editEntityWithoutTree(edit.first, edit.second) ? QUuid(edit.first) : QUuid());
         }
-
-        auto nodeList = DependencyManager::get<NodeList>();
-        if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
-            // don't edit other avatar's avatarEntities
-            return;
+    } else {
+        // the whole batch is applied under one lock, and its messages are packed together once it is released
+        QVector<QPair<EntityItemID, EntityItemProperties>> messages;
+        messages.reserve(scriptSideEdits.size());
+        _entityTree->withWriteLock([&] {
+            for (const auto& edit : scriptSideEdits) {
+                editEntityInTree(edit.first, edit.second, messages);
+                results.push_back(edit.first);
+            }
+        });
+        for (const auto& message : messages) {
+            queueEntityMessage(PacketType::EntityEdit, message.first, message.second);
         }
+    }
+    getEntityPacketSender()->releaseQueuedMessages();
+    return results;
+}
+
+bool EntityScriptingInterface::editEntityWithoutTree(const EntityItemID& entityID, const EntityItemProperties& properties) {
+    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
+
+    //if there is no local entity entity tree, no existing velocity, use 0.
+    auto dimensions = properties.getDimensions();
+    float volume = dimensions.x * dimensions.y * dimensions.z;
+    float cost = calculateCost(properties.getDensity() * volume, 0.0f, properties.getVelocity().length());
+    cost *= costMultiplier;
+
+    if (cost > _currentAvatarEnergy) {
+        return false;
+    }
+    //debit the avatar energy and continue
+    emit debitEnergySource(cost);
+    return true;
+}
 
+void EntityScriptingInterface::editEntityInTree(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                                                QVector<QPair<EntityItemID, EntityItemProperties>>& messages) {
+    EntityItemProperties properties = scriptSideProperties;
+
+    auto dimensions = properties.getDimensions();
+    float volume = dimensions.x * dimensions.y * dimensions.z;
+    auto density = properties.getDensity();
+    auto newVelocity = properties.getVelocity().length();
+    float oldVelocity = { 0.0f };
+
+    EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+    auto nodeList = DependencyManager::get<NodeList>();
+    // don't edit other avatar's avatarEntities
+    if (entity && (!entity->getClientOnly() || entity->getOwningAvatarID() == nodeList->getSessionUUID())) {
         if (scriptSideProperties.parentRelatedPropertyChanged()) {
             // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
             // If any of these changed, pull any missing properties from the entity.
@@ -386,16 +467,13 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
         float cost = calculateCost(density * volume, oldVelocity, newVelocity);
         cost *= costMultiplier;
 
-        if (cost > _currentAvatarEnergy) {
-            updatedEntity = false;
-        } else {
+        if (cost <= _currentAvatarEnergy) {
             //debit the avatar energy and continue
-            updatedEntity = _entityTree->updateEntity(entityID, properties);
-            if (updatedEntity) {
+            if (_entityTree->updateEntity(entityID, properties)) {
                 emit debitEnergySource(cost);
             }
         }
-    });
+    }
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
     // breaks avatar energy and entities that are parented.
@@ -403,68 +481,63 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
     // To handle cases where a script needs to edit an entity with a _known_ entity id but doesn't exist
     // in the local entity tree, we need to allow those edits to go through to the server.
     // if (!updatedEntity) {
-    //     return QUuid();
+    //     return;
     // }
 
-    _entityTree->withReadLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            // make sure the properties has a type, so that the encode can know which properties to include
-            properties.setType(entity->getType());
-            bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
-            bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
-            if (_bidOnSimulationOwnership && hasPhysicsChanges) {
-                auto nodeList = DependencyManager::get<NodeList>();
-                const QUuid myNodeID = nodeList->getSessionUUID();
-
-                if (entity->getSimulatorID() == myNodeID) {
-                    // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
-                    if (hasTerseUpdateChanges) {
-                        entity->getAllTerseUpdateProperties(properties);
-                    }
-                    // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
-                    // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
-                    // and instead let the physics simulation decide when to send a terse update.  This would remove
-                    // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
-                    // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
-                    // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
-                    // simulation.
-
-                    if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
-                        // we re-assert our simulation ownership at a higher priority
-                        properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    }
-                } else {
-                    // we make a bid for simulation ownership
+    if (entity) {
+        // make sure the properties has a type, so that the encode can know which properties to include
+        properties.setType(entity->getType());
+        bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
+        bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
+        if (_bidOnSimulationOwnership && hasPhysicsChanges) {
+            const QUuid myNodeID = nodeList->getSessionUUID();
+
+            if (entity->getSimulatorID() == myNodeID) {
+                // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
+                if (hasTerseUpdateChanges) {
+                    entity->getAllTerseUpdateProperties(properties);
+                }
+                // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
+                // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
+                // and instead let the physics simulation decide when to send a terse update.  This would remove
+                // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
+                // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
+                // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
+                // simulation.
+
+                if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
+                    // we re-assert our simulation ownership at a higher priority
                     properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    entity->pokeSimulationOwnership();
-                    entity->rememberHasSimulationOwnershipBid();
                 }
+            } else {
+                // we make a bid for simulation ownership
+                properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+                entity->pokeSimulationOwnership();
+                entity->rememberHasSimulationOwnershipBid();
             }
-            if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
-                properties.setQueryAACube(entity->getQueryAACube());
-            }
-            entity->setLastBroadcast(usecTimestampNow());
-            properties.setLastEdited(entity->getLastEdited());
-
-            // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-            // if they've changed.
-            entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                if (descendant->getNestableType() == NestableType::Entity) {
-                    if (descendant->computePuffedQueryAACube()) {
-                        EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                        EntityItemProperties newQueryCubeProperties;
-                        newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                        newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                        queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                        entityDescendant->setLastBroadcast(usecTimestampNow());
-                    }
-                }
-            });
         }
-    });
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+        if (properties.parentRelatedPropertyChanged() && entity->computePuffedQueryAACube()) {
+            properties.setQueryAACube(entity->getQueryAACube());
+        }
+        entity->setLastBroadcast(usecTimestampNow());
+        properties.setLastEdited(entity->getLastEdited());
+
+        // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+        // if they've changed.
+        entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+            if (descendant->getNestableType() == NestableType::Entity) {
+                if (descendant->computePuffedQueryAACube()) {
+                    EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                    EntityItemProperties newQueryCubeProperties;
+                    newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                    newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                    messages.push_back({ descendant->getID(), newQueryCubeProperties });
+                    entityDescendant->setLastBroadcast(usecTimestampNow());
+                }
+            }
+        });
+    }
+    messages.push_back({ entityID, properties });
 }
 
 void EntityScriptingInterface::deleteEntity(QUuid id) {
@@ -661,13 +734,18 @@ RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionBlock
 RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly) {
+    return findRayIntersectionInTree(_entityTree, ray, lockType, precisionPicking, entityIdsToInclude, entityIdsToDiscard,
+                                     visibleOnly, collidableOnly);
+}
 
-
+RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionInTree(EntityTreePointer tree,
+        const PickRay& ray, Octree::lockType lockType, bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly) {
     RayToEntityIntersectionResult result;
-    if (_entityTree) {
+    if (tree) {
         OctreeElementPointer element;
         EntityItemPointer intersectedEntity = NULL;
-        result.intersects = _entityTree->findRayIntersection(ray.origin, ray.direction,
+        result.intersects = tree->findRayIntersection(ray.origin, ray.direction,
             entityIdsToInclude, entityIdsToDiscard, visibleOnly, collidableOnly, precisionPicking,
             element, result.distance, result.face, result.surfaceNormal,
             (void**)&intersectedEntity, lockType, &result.accurate);
@@ -680,6 +758,81 @@ RayToEntityIntersectionResult EntityScriptingInterface::findRayIntersectionWorke
     return result;
 }
 
+bool EntityScriptingInterface::findRayIntersections(const QScriptValue& picks, QScriptValue scopeOrCallback,
+                                                    QScriptValue methodOrName) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    auto handler = makeScopedHandlerObject(scopeOrCallback, methodOrName);
+    QPointer<BaseScriptEngine> engine = dynamic_cast<BaseScriptEngine*>(handler.engine());
+    if (!engine) {
+        qCDebug(entities) << "findRayIntersections without detectable engine";
+        return false;
+    }
+    if (!handler.property("callback").isFunction()) {
+        engine->raiseException(engine->makeError("callback is not a function", "TypeError"));
+        return false;
+    }
+
+    struct Pick {
+        PickRay ray;
+        bool precisionPicking;
+        QVector<EntityItemID> entityIdsToInclude;
+        QVector<EntityItemID> entityIdsToDiscard;
+        bool visibleOnly;
+        bool collidableOnly;
+    };
+    // the script values are read here, on the script's thread
+    QVector<Pick> batch;
+    int length = picks.property("length").toInt32();
+    batch.reserve(length);
+    for (int i = 0; i < length; i++) {
+        QScriptValue pickValue = picks.property(i);
+        Pick pick;
+        pickRayFromScriptValue(pickValue, pick.ray);
+        pick.precisionPicking = pickValue.property("precisionPicking").toBool();
+        pick.entityIdsToInclude = qVectorEntityItemIDFromScriptValue(pickValue.property("entityIdsToInclude"));
+        pick.entityIdsToDiscard = qVectorEntityItemIDFromScriptValue(pickValue.property("entityIdsToDiscard"));
+        pick.visibleOnly = pickValue.property("visibleOnly").toBool();
+        pick.collidableOnly = pickValue.property("collidableOnly").toBool();
+        batch.push_back(pick);
+    }
+
+    using RayIntersectionsRequest = QFutureWatcher<QVector<RayToEntityIntersectionResult>>;
+    RayIntersectionsRequest* request = new RayIntersectionsRequest;
+    QObject::connect(request, &RayIntersectionsRequest::finished, engine, [=]() {
+        QVector<RayToEntityIntersectionResult> results = request->result();
+        request->deleteLater();
+        if (!engine) {
+            return;
+        }
+        QScriptValue resultsValue = engine->newArray(results.size());
+        for (int i = 0; i < results.size(); i++) {
+            resultsValue.setProperty(i, RayToEntityIntersectionResultToScriptValue(engine, results[i]));
+        }
+        callScopedHandlerObject(handler, QScriptValue(), resultsValue);
+    });
+
+    // the whole batch is traced under one read lock of the tree, off the script's thread
+    EntityTreePointer tree = _entityTree;
+    request->setFuture(QtConcurrent::run([tree, batch]() {
+        PROFILE_RANGE(script_entities, "findRayIntersections");
+        QVector<RayToEntityIntersectionResult> results;
+        results.reserve(batch.size());
+        if (!tree) {
+            results.resize(batch.size());
+            return results;
+        }
+        tree->withReadLock([&] {
+            for (const auto& pick : batch) {
+                results.push_back(findRayIntersectionInTree(tree, pick.ray, Octree::Lock, pick.precisionPicking,
+                    pick.entityIdsToInclude, pick.entityIdsToDiscard, pick.visibleOnly, pick.collidableOnly));
+            }
+        });
+        return results;
+    }));
+    return true;
+}
+
 bool EntityScriptingInterface::reloadServerScripts(QUuid entityID) {
     auto client = DependencyManager::get<EntityScriptClient>();
     return client->reloadServerScript(entityID);
@@ -810,6 +963,16 @@ bool EntityScriptingInterface::getServerScriptStatus(QUuid entityID, QScriptValu
     return true;
 }
 
+QVariantList EntityScriptingInterface::getTopEntityScripts(int maxCount) {
+    QVariantList topScripts;
+    withEntitiesScriptEngine([&](EntitiesScriptEngineProvider* entitiesScriptEngine) {
+        if (entitiesScriptEngine) {
+            topScripts = entitiesScriptEngine->getTopEntityScripts(maxCount);
+        }
+    });
+    return topScripts;
+}
+
 void EntityScriptingInterface::setLightsArePickable(bool value) {
     LightEntityItem::setLightsArePickable(value);
 }
@@ -105,6 +105,9 @@ public:
 
     void resetActivityTracking();
     ActivityTracking getActivityTracking() const { return _activityTracking; }
+
+    // the physics only reports the collisions of the entities that somebody listens to
+    void addCollisionHandler(const QUuid& entityID);
 public slots:
 
     /**jsdoc
@@ -161,6 +164,19 @@ public slots:
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid entityID);
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid identity, EntityPropertyFlags desiredProperties);
 
+    /**jsdoc
+     * Return the properties of several entities at once, under a single lock of the entity tree.
+     *
+     * @function Entities.getEntitiesProperties
+     * @param {EntityID[]} entityIDs The IDs of the entities.
+     * @param {EntityPropertyFlags} [desiredProperties=[]] Array containing the names of the properties you
+     *     would like to get. If the array is empty, all properties will be returned.
+     * @return {EntityItemProperties[]} The properties of each entity, in the order of `entityIDs`. The properties of
+     *     an entity that isn't known are empty.
+     */
+    Q_INVOKABLE QVector<EntityItemProperties> getEntitiesProperties(const QVector<QUuid>& entityIDs,
+                                                                    EntityPropertyFlags desiredProperties = EntityPropertyFlags());
+
     /**jsdoc
      * Updates an entity with the specified properties.
      *
@@ -169,6 +185,16 @@ public slots:
      */
     Q_INVOKABLE QUuid editEntity(QUuid entityID, const EntityItemProperties& properties);
 
+    /**jsdoc
+     * Updates several entities at once, under a single lock of the entity tree, and sends their edits to the server
+     * packed together.
+     *
+     * @function Entities.editEntities
+     * @param {Object[]} edits The edits, each an object with the `id` of an entity and the `properties` to set on it.
+     * @return {EntityID[]} For each edit, the EntityID of the entity if the edit was successful, otherwise the null {EntityID}.
+     */
+    Q_INVOKABLE QVector<QUuid> editEntities(const QScriptValue& edits);
+
     /**jsdoc
      * Deletes an entity.
      *
@@ -227,6 +253,19 @@ public slots:
     /// order to return an accurate result
     Q_INVOKABLE RayToEntityIntersectionResult findRayIntersectionBlocking(const PickRay& ray, bool precisionPicking = false, const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue());
 
+    /**jsdoc
+     * Find the ray intersections of several picks together, on a worker thread, without blocking the script.
+     *
+     * @function Entities.findRayIntersections
+     * @param {Object[]} picks Each with origin and direction, and optionally precisionPicking, entityIdsToInclude,
+     *     entityIdsToDiscard, visibleOnly and collidableOnly as for findRayIntersection.
+     * @param {Object} thisObject The scoping "this" context that callback will be executed within.
+     * @param {ResultCallback} callbackOrMethodName Executes thisObject[callbackOrMethodName](err, result) with the
+     *     array of the intersection results, in the order of the picks.
+     */
+    Q_INVOKABLE bool findRayIntersections(const QScriptValue& picks, QScriptValue scopeOrCallback,
+        QScriptValue methodOrName = QScriptValue());
+
     Q_INVOKABLE bool reloadServerScripts(QUuid entityID);
 
     /**jsdoc
@@ -250,6 +289,16 @@ public slots:
 
     Q_INVOKABLE bool getServerScriptStatus(QUuid entityID, QScriptValue callback);
 
+    /**jsdoc
+     * Get the entity scripts of this script context which take the largest share of the time of their script thread.
+     *
+     * @function Entities.getTopEntityScripts
+     * @param {number} [maxCount=10] The largest number of scripts reported.
+     * @returns {Object[]} Each with the entityID, the cpuShare in percent, the totalTime and longestCall in ms, the
+     *     number of overruns of the time slice and whether the script is suspended, the costliest first.
+     */
+    Q_INVOKABLE QVariantList getTopEntityScripts(int maxCount = 10);
+
     Q_INVOKABLE void setLightsArePickable(bool value);
     Q_INVOKABLE bool getLightsArePickable() const;
 
@@ -381,6 +430,13 @@ private:
     bool setPoints(QUuid entityID, std::function<bool(LineEntityItem&)> actor);
     void queueEntityMessage(PacketType packetType, EntityItemID entityID, const EntityItemProperties& properties);
 
+    // the caller holds the tree's read lock
+    EntityItemProperties getEntityPropertiesInTree(const EntityItemID& entityID, EntityPropertyFlags desiredProperties);
+    // the caller holds the tree's write lock, the edit messages to send are appended to messages
+    void editEntityInTree(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                          QVector<QPair<EntityItemID, EntityItemProperties>>& messages);
+    bool editEntityWithoutTree(const EntityItemID& entityID, const EntityItemProperties& properties);
+
     EntityItemPointer checkForTreeEntityAndTypeMatch(const QUuid& entityID,
                                                      EntityTypes::EntityType entityType = EntityTypes::Unknown);
 
@@ -389,6 +445,9 @@ private:
     RayToEntityIntersectionResult findRayIntersectionWorker(const PickRay& ray, Octree::lockType lockType,
         bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
         bool visibleOnly = false, bool collidableOnly = false);
+    static RayToEntityIntersectionResult findRayIntersectionInTree(EntityTreePointer tree, const PickRay& ray,
+        Octree::lockType lockType, bool precisionPicking, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly);
 
     EntityTreePointer _entityTree;
 
@@ -18,10 +18,10 @@
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _mortalEntities.clear();
-        _nextExpiry = quint64(-1);
         _entitiesToUpdate.clear();
         _entitiesToSort.clear();
         _simpleKinematicEntities.clear();
+        _kinematicStore.clear();
     }
     _entityTree = tree;
 }
@@ -55,6 +55,7 @@ void EntitySimulation::removeEntityInternal(EntityItemPointer entity) {
     _entitiesToUpdate.remove(entity);
     _entitiesToSort.remove(entity);
     _simpleKinematicEntities.remove(entity);
+    _kinematicStore.remove(entity);
     _allEntities.remove(entity);
     entity->setSimulated(false);
 }
@@ -93,29 +94,20 @@ void EntitySimulation::changeEntityInternal(EntityItemPointer entity) {
 
 // protected
 void EntitySimulation::expireMortalEntities(const quint64& now) {
-    if (now > _nextExpiry) {
-        // only search for expired entities if we expect to find one
-        _nextExpiry = quint64(-1);
-        QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
-            quint64 expiry = entity->getExpiry();
-            if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
-                entity->die();
-                prepareEntityForDelete(entity);
-            } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
-            }
-        }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
+    QMutexLocker lock(&_mutex);
+    VectorOfEntities expired;
+    _mortalEntities.takeDue(now, expired);
+    for (auto entity : expired) {
+        // an entity's lifetime is rescheduled when it changes, but check in case it changed without telling us
+        quint64 expiry = entity->getExpiry();
+        if (!entity->isMortal()) {
+            continue;
+        } else if (expiry > now) {
+            _mortalEntities.schedule(entity, expiry);
+            continue;
         }
+        entity->die();
+        prepareEntityForDelete(entity);
     }
 }
 
@@ -123,16 +115,14 @@ void EntitySimulation::expireMortalEntities(const quint64& now) {
 void EntitySimulation::callUpdateOnEntitiesThatNeedIt(const quint64& now) {
     PerformanceTimer perfTimer("updatingEntities");
     QMutexLocker lock(&_mutex);
-    SetOfEntities::iterator itemItr = _entitiesToUpdate.begin();
-    while (itemItr != _entitiesToUpdate.end()) {
-        EntityItemPointer entity = *itemItr;
+    VectorOfEntities due;
+    _entitiesToUpdate.takeDue(now, due);
+    for (auto entity : due) {
         // TODO: catch transition from needing update to not as a "change"
-        // so we don't have to scan for it here.
-        if (!entity->needsToCallUpdate()) {
-            itemItr = _entitiesToUpdate.erase(itemItr);
-        } else {
+        // so we don't have to check for it here.
+        if (entity->needsToCallUpdate()) {
             entity->update(now);
-            ++itemItr;
+            _entitiesToUpdate.schedule(entity, entity->getNextUpdateTime(now));
         }
     }
 }
@@ -172,14 +162,10 @@ void EntitySimulation::addEntity(EntityItemPointer entity) {
     assert(entity);
     entity->deserializeActions();
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        quint64 expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        _mortalEntities.schedule(entity, entity->getExpiry());
     }
     if (entity->needsToCallUpdate()) {
-        _entitiesToUpdate.insert(entity);
+        _entitiesToUpdate.schedule(entity, 0); // at the next update
     }
     addEntityInternal(entity);
 
@@ -220,21 +206,23 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
     if (!wasRemoved) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
-                _mortalEntities.insert(entity);
-                quint64 expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                _mortalEntities.schedule(entity, entity->getExpiry());
             } else {
                 _mortalEntities.remove(entity);
             }
             entity->clearDirtyFlags(Simulation::DIRTY_LIFETIME);
         }
         if (entity->needsToCallUpdate()) {
-            _entitiesToUpdate.insert(entity);
+            // an edit may change what the entity does on update, so it is updated on the next one
+            _entitiesToUpdate.schedule(entity, 0);
         } else {
             _entitiesToUpdate.remove(entity);
         }
+        // the entity goes back to _simpleKinematicEntities, if it is still kinematic, and its state is read again there
+        if (_kinematicStore.contains(entity)) {
+            _kinematicStore.remove(entity);
+            _simpleKinematicEntities.insert(entity);
+        }
         changeEntityInternal(entity);
     }
 }
@@ -242,10 +230,10 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
 void EntitySimulation::clearEntities() {
     QMutexLocker lock(&_mutex);
     _mortalEntities.clear();
-    _nextExpiry = quint64(-1);
     _entitiesToUpdate.clear();
     _entitiesToSort.clear();
     _simpleKinematicEntities.clear();
+    _kinematicStore.clear();
 
     clearEntitiesInternal();
 
@@ -262,6 +250,13 @@ void EntitySimulation::moveSimpleKinematics(const quint64& now) {
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
 
+        // entities without a parent are moved together by the store
+        if (EntityKinematicStore::canStore(entity)) {
+            _kinematicStore.update(entity);
+            itemItr = _simpleKinematicEntities.erase(itemItr);
+            continue;
+        }
+
         // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
         // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
         bool ancestryIsKnown;
@@ -277,6 +272,12 @@ void EntitySimulation::moveSimpleKinematics(const quint64& now) {
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+
+    _kinematicStore.step(now, [&](const EntityItemPointer& entity) {
+        _entitiesToSort.insert(entity);
+    }, [&](const EntityItemPointer& entity) {
+        _simpleKinematicEntities.insert(entity);
+    });
 }
 
 void EntitySimulation::addAction(EntityActionPointer action) {
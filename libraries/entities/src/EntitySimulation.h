@@ -20,6 +20,8 @@
 
 #include "EntityActionInterface.h"
 #include "EntityItem.h"
+#include "EntityKinematicStore.h"
+#include "EntityTimerQueue.h"
 #include "EntityTree.h"
 
 using EntitySimulationPointer = std::shared_ptr<EntitySimulation>;
@@ -45,7 +47,7 @@ const int DIRTY_SIMULATION_FLAGS =
 class EntitySimulation : public QObject, public std::enable_shared_from_this<EntitySimulation> {
 Q_OBJECT
 public:
-    EntitySimulation() : _mutex(QMutex::Recursive), _entityTree(NULL), _nextExpiry(quint64(-1)) { }
+    EntitySimulation() : _mutex(QMutex::Recursive), _entityTree(NULL) { }
     virtual ~EntitySimulation() { setEntityTree(NULL); }
 
     inline EntitySimulationPointer getThisPointer() const {
@@ -103,6 +105,7 @@ protected:
 
     SetOfEntities _entitiesToSort; // entities moved by simulation (and might need resort in EntityTree)
     SetOfEntities _simpleKinematicEntities; // entities undergoing non-colliding kinematic motion
+    EntityKinematicStore _kinematicStore; // the ones without a parent, moved there from _simpleKinematicEntities
     QList<EntityActionPointer> _actionsToAdd;
     QSet<QUuid> _actionsToRemove;
 
@@ -118,12 +121,8 @@ private:
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
     SetOfEntities _allEntities; // tracks all entities added the simulation
-    SetOfEntities _mortalEntities; // entities that have an expiry
-    quint64 _nextExpiry;
-
-
-    SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
-
+    EntityTimerQueue _mortalEntities; // entities that have an expiry, at their expiry
+    EntityTimerQueue _entitiesToUpdate; // entities that need to call EntityItem::update(), at their next update time
 };
 
 #endif // hifi_EntitySimulation_h
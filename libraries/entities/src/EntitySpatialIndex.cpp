@@ -0,0 +1,320 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <cassert>
+
+// the bounds of an entity are indexed grown by this part of its size, or at least by the minimum, on each side
+const float FAT_MARGIN_RATIO = 0.1f;
+const float MIN_FAT_MARGIN = 0.05f; // meters
+
+// an entity whose indexed bounds grew this much larger than it needs, as it shrinks, is re-inserted with tighter ones
+const float MAX_FAT_RATIO = 2.0f;
+
+EntitySpatialIndex::EntitySpatialIndex() {
+}
+
+void EntitySpatialIndex::update(const EntityItemPointer& entity, const AABox& bounds) {
+    float margin = std::max(bounds.getLargestDimension() * FAT_MARGIN_RATIO, MIN_FAT_MARGIN);
+    AABox fatBounds(bounds.getCorner() - glm::vec3(margin), bounds.getDimensions() + glm::vec3(2.0f * margin));
+
+    withWriteLock([&] {
+        int leaf;
+        auto leafIt = _leaves.find(entity->getEntityItemID());
+        if (leafIt != _leaves.end()) {
+            leaf = leafIt.value();
+            Node& node = _nodes[leaf];
+            node.entity = entity;
+            if (node.box.contains(bounds) &&
+                node.box.getLargestDimension() <= MAX_FAT_RATIO * fatBounds.getLargestDimension()) {
+                return; // still within its margin
+            }
+            removeLeaf(leaf);
+        } else {
+            leaf = allocateNode();
+            _nodes[leaf].entity = entity;
+            _leaves.insert(entity->getEntityItemID(), leaf);
+        }
+
+        _nodes[leaf].box = fatBounds;
+        insertLeaf(leaf);
+    });
+}
+
+void EntitySpatialIndex::remove(const EntityItemID& entityID) {
+    withWriteLock([&] {
+        auto leafIt = _leaves.find(entityID);
+        if (leafIt == _leaves.end()) {
+            return;
+        }
+        int leaf = leafIt.value();
+        _leaves.erase(leafIt);
+
+        removeLeaf(leaf);
+        freeNode(leaf);
+    });
+}
+
+void EntitySpatialIndex::clear() {
+    withWriteLock([&] {
+        _nodes.clear();
+        _root = NULL_NODE;
+        _freeList = NULL_NODE;
+        _leaves.clear();
+    });
+}
+
+int EntitySpatialIndex::getNumEntities() const {
+    int numEntities;
+    withReadLock([&] {
+        numEntities = _leaves.size();
+    });
+    return numEntities;
+}
+
+int EntitySpatialIndex::getHeight() const {
+    int height;
+    withReadLock([&] {
+        height = _root == NULL_NODE ? 0 : _nodes[_root].height;
+    });
+    return height;
+}
+
+AABox EntitySpatialIndex::merge(const AABox& a, const AABox& b) {
+    glm::vec3 minimum = glm::min(a.getMinimumPoint(), b.getMinimumPoint());
+    glm::vec3 maximum = glm::max(a.getMaximumPoint(), b.getMaximumPoint());
+    return AABox(minimum, maximum - minimum);
+}
+
+float EntitySpatialIndex::getSurfaceArea(const AABox& box) {
+    const glm::vec3& dimensions = box.getDimensions();
+    return 2.0f * (dimensions.x * dimensions.y + dimensions.y * dimensions.z + dimensions.z * dimensions.x);
+}
+
+bool EntitySpatialIndex::touchesSphere(const AABox& box, const glm::vec3& center, float radius) {
+    glm::vec3 closestPoint = glm::clamp(center, box.getMinimumPoint(), box.getMaximumPoint());
+    glm::vec3 offset = center - closestPoint;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+bool EntitySpatialIndex::findRayEntry(const AABox& box, const glm::vec3& origin, const glm::vec3& direction, float& entry) {
+    glm::vec3 minimum = box.getMinimumPoint();
+    glm::vec3 maximum = box.getMaximumPoint();
+
+    float entryDistance = 0.0f;
+    float exitDistance = FLT_MAX;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (direction[axis] == 0.0f) {
+            // parallel to this pair of faces, so the ray is between them everywhere or nowhere
+            if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        float inverse = 1.0f / direction[axis];
+        float t0 = (minimum[axis] - origin[axis]) * inverse;
+        float t1 = (maximum[axis] - origin[axis]) * inverse;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        entryDistance = std::max(entryDistance, t0);
+        exitDistance = std::min(exitDistance, t1);
+        if (entryDistance > exitDistance) {
+            return false;
+        }
+    }
+
+    entry = entryDistance; // 0 when the origin is inside
+    return true;
+}
+
+int EntitySpatialIndex::allocateNode() {
+    if (_freeList == NULL_NODE) {
+        _nodes.emplace_back();
+        return (int)_nodes.size() - 1;
+    }
+
+    int index = _freeList;
+    _freeList = _nodes[index].parent;
+    _nodes[index] = Node();
+    return index;
+}
+
+void EntitySpatialIndex::freeNode(int index) {
+    Node& node = _nodes[index];
+    node.entity.reset();
+    node.children[0] = node.children[1] = NULL_NODE;
+    node.height = -1;
+    node.parent = _freeList;
+    _freeList = index;
+}
+
+void EntitySpatialIndex::insertLeaf(int leaf) {
+    _nodes[leaf].children[0] = _nodes[leaf].children[1] = NULL_NODE;
+    _nodes[leaf].height = 0;
+
+    if (_root == NULL_NODE) {
+        _root = leaf;
+        _nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // find the sibling whose box grows the least, counting what every ancestor's box would grow too
+    AABox leafBox = _nodes[leaf].box;
+    int index = _root;
+    while (!_nodes[index].isLeaf()) {
+        const Node& node = _nodes[index];
+        float area = getSurfaceArea(node.box);
+        float combinedArea = getSurfaceArea(merge(node.box, leafBox));
+
+        // the cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+        // the minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        for (int i = 0; i < 2; ++i) {
+            const Node& child = _nodes[node.children[i]];
+            float childCombinedArea = getSurfaceArea(merge(leafBox, child.box));
+            childCosts[i] = (child.isLeaf() ? childCombinedArea : childCombinedArea - getSurfaceArea(child.box)) +
+                inheritanceCost;
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1]) {
+            break;
+        }
+        index = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+    }
+    int sibling = index;
+
+    int oldParent = _nodes[sibling].parent;
+    int newParent = allocateNode(); // may move the nodes, so no references are held across it
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = merge(leafBox, _nodes[sibling].box);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].children[0] = sibling;
+    _nodes[newParent].children[1] = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        _root = newParent;
+    } else if (_nodes[oldParent].children[0] == sibling) {
+        _nodes[oldParent].children[0] = newParent;
+    } else {
+        _nodes[oldParent].children[1] = newParent;
+    }
+
+    refit(_nodes[leaf].parent);
+}
+
+void EntitySpatialIndex::removeLeaf(int leaf) {
+    if (leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+
+    int parent = _nodes[leaf].parent;
+    int grandParent = _nodes[parent].parent;
+    int sibling = _nodes[parent].children[0] == leaf ? _nodes[parent].children[1] : _nodes[parent].children[0];
+
+    // the sibling takes the place of the parent
+    if (grandParent == NULL_NODE) {
+        _root = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    } else {
+        if (_nodes[grandParent].children[0] == parent) {
+            _nodes[grandParent].children[0] = sibling;
+        } else {
+            _nodes[grandParent].children[1] = sibling;
+        }
+        _nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refit(grandParent);
+    }
+    _nodes[leaf].parent = NULL_NODE;
+}
+
+void EntitySpatialIndex::refit(int index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = _nodes[index];
+        const Node& child0 = _nodes[node.children[0]];
+        const Node& child1 = _nodes[node.children[1]];
+        node.height = 1 + std::max(child0.height, child1.height);
+        node.box = merge(child0.box, child1.box);
+
+        index = node.parent;
+    }
+}
+
+int EntitySpatialIndex::balance(int indexA) {
+    Node& a = _nodes[indexA];
+    if (a.isLeaf() || a.height < 2) {
+        return indexA;
+    }
+
+    int indexB = a.children[0];
+    int indexC = a.children[1];
+    Node& b = _nodes[indexB];
+    Node& c = _nodes[indexC];
+    int heightDifference = c.height - b.height;
+    if (heightDifference >= -1 && heightDifference <= 1) {
+        return indexA;
+    }
+
+    // rotate the taller child up into the place of a, and a down in place of the shorter of its grandchildren
+    bool rotateC = heightDifference > 1;
+    int indexUp = rotateC ? indexC : indexB;
+    int indexStay = rotateC ? indexB : indexC; // the child of a that stays its child
+    Node& up = _nodes[indexUp];
+    Node& stay = _nodes[indexStay];
+
+    int indexF = up.children[0];
+    int indexG = up.children[1];
+    Node& f = _nodes[indexF];
+    Node& g = _nodes[indexG];
+
+    up.children[0] = indexA;
+    up.parent = a.parent;
+    a.parent = indexUp;
+
+    if (up.parent == NULL_NODE) {
+        _root = indexUp;
+    } else if (_nodes[up.parent].children[0] == indexA) {
+        _nodes[up.parent].children[0] = indexUp;
+    } else {
+        assert(_nodes[up.parent].children[1] == indexA);
+        _nodes[up.parent].children[1] = indexUp;
+    }
+
+    // the taller grandchild stays with the node that moved up, the other one goes under a
+    int indexKeep = f.height > g.height ? indexF : indexG;
+    int indexMove = f.height > g.height ? indexG : indexF;
+    Node& keep = _nodes[indexKeep];
+    Node& move = _nodes[indexMove];
+
+    up.children[1] = indexKeep;
+    a.children[rotateC ? 1 : 0] = indexMove;
+    move.parent = indexA;
+
+    a.box = merge(stay.box, move.box);
+    a.height = 1 + std::max(stay.height, move.height);
+    up.box = merge(a.box, keep.box);
+    up.height = 1 + std::max(a.height, keep.height);
+
+    return indexUp;
+}
@@ -0,0 +1,176 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <algorithm>
+#include <cfloat>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QHash>
+
+#include <AABox.h>
+#include <ViewFrustum.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+#include "EntityItemID.h"
+
+/// A dynamic bounding volume tree over the bounds of the entities of an EntityTree, for the find queries of the tree.
+///
+/// The octree keeps an entity in the smallest element that contains all of it, so a small entity that straddles the
+/// boundary between two large elements ends up near the root, and is tested by every query. Here each entity is a leaf
+/// with its own bounds, grown by a margin so that an entity that moves a little doesn't need to be re-inserted, and the
+/// leaves are grouped bottom up by surface area and kept balanced by rotations.
+///
+/// The queries only return the entities whose indexed bounds touch the query, the caller still does its exact test.
+class EntitySpatialIndex : public ReadWriteLockable {
+public:
+    EntitySpatialIndex();
+
+    /// adds the entity, or re-inserts it when its bounds have moved out of the margin it was indexed with
+    void update(const EntityItemPointer& entity, const AABox& bounds);
+    void remove(const EntityItemID& entityID);
+    void clear();
+
+    int getNumEntities() const;
+    int getHeight() const; // of the tree, 0 with a single entity
+
+    /// calls f with each entity whose indexed bounds touch the query
+    template <typename F> void findEntities(const glm::vec3& center, float radius, F f) const;
+    template <typename F> void findEntities(const AABox& box, F f) const;
+    template <typename F> void findEntities(const ViewFrustum& frustum, F f) const;
+
+    /// calls f with each entity whose indexed bounds the ray enters, the nearest first, f returns the distance of the
+    /// closest hit so far and the entities whose bounds the ray only enters beyond it are skipped
+    template <typename F> void findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, F f) const;
+
+private:
+    static const int NULL_NODE = -1;
+
+    struct Node {
+        AABox box;
+        int parent { NULL_NODE }; // or the next free node
+        int children[2] { NULL_NODE, NULL_NODE };
+        int height { 0 }; // 0 for leaves, -1 for free nodes
+        EntityItemPointer entity; // leaves only
+
+        bool isLeaf() const { return children[0] == NULL_NODE; }
+    };
+
+    static AABox merge(const AABox& a, const AABox& b);
+    static float getSurfaceArea(const AABox& box);
+    static bool touchesSphere(const AABox& box, const glm::vec3& center, float radius);
+    static bool findRayEntry(const AABox& box, const glm::vec3& origin, const glm::vec3& direction, float& entry);
+
+    template <typename Test, typename F> void query(Test test, F f) const;
+
+    int allocateNode();
+    void freeNode(int index);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    void refit(int index); // the heights and boxes from index up to the root
+    int balance(int index); // returns the node that took the place of index
+
+    std::vector<Node> _nodes;
+    int _root { NULL_NODE };
+    int _freeList { NULL_NODE };
+    QHash<EntityItemID, int> _leaves;
+};
+
+template <typename Test, typename F>
+void EntitySpatialIndex::query(Test test, F f) const {
+    withReadLock([&] {
+        if (_root == NULL_NODE) {
+            return;
+        }
+
+        std::vector<int> stack;
+        stack.reserve(64);
+        stack.push_back(_root);
+        while (!stack.empty()) {
+            const Node& node = _nodes[stack.back()];
+            stack.pop_back();
+            if (!test(node.box)) {
+                continue;
+            }
+            if (node.isLeaf()) {
+                f(node.entity);
+            } else {
+                stack.push_back(node.children[0]);
+                stack.push_back(node.children[1]);
+            }
+        }
+    });
+}
+
+template <typename F>
+void EntitySpatialIndex::findEntities(const glm::vec3& center, float radius, F f) const {
+    query([&](const AABox& box) { return touchesSphere(box, center, radius); }, f);
+}
+
+template <typename F>
+void EntitySpatialIndex::findEntities(const AABox& box, F f) const {
+    query([&](const AABox& nodeBox) { return nodeBox.touches(box); }, f);
+}
+
+template <typename F>
+void EntitySpatialIndex::findEntities(const ViewFrustum& frustum, F f) const {
+    query([&](const AABox& box) { return frustum.boxIntersectsFrustum(box) || frustum.boxIntersectsKeyhole(box); }, f);
+}
+
+template <typename F>
+void EntitySpatialIndex::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, F f) const {
+    withReadLock([&] {
+        float entry;
+        if (_root == NULL_NODE || !findRayEntry(_nodes[_root].box, origin, direction, entry)) {
+            return;
+        }
+
+        // the stack is kept with the nearer child on top, so the closest hits are found early and prune the rest
+        float closestDistance = FLT_MAX;
+        std::vector<std::pair<float, int>> stack;
+        stack.reserve(64);
+        stack.emplace_back(entry, _root);
+        while (!stack.empty()) {
+            auto entryAndIndex = stack.back();
+            stack.pop_back();
+            if (entryAndIndex.first > closestDistance) {
+                continue;
+            }
+
+            const Node& node = _nodes[entryAndIndex.second];
+            if (node.isLeaf()) {
+                closestDistance = f(node.entity);
+                continue;
+            }
+
+            float entries[2];
+            bool hits[2];
+            for (int i = 0; i < 2; ++i) {
+                hits[i] = findRayEntry(_nodes[node.children[i]].box, origin, direction, entries[i]) &&
+                    entries[i] <= closestDistance;
+            }
+            int nearer = (hits[0] && hits[1] && entries[1] < entries[0]) || !hits[0] ? 1 : 0;
+            int farther = 1 - nearer;
+            if (hits[farther]) {
+                stack.emplace_back(entries[farther], node.children[farther]);
+            }
+            if (hits[nearer]) {
+                stack.emplace_back(entries[nearer], node.children[nearer]);
+            }
+        }
+    });
+}
+
+#endif // hifi_EntitySpatialIndex_h
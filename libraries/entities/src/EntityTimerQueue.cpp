@@ -0,0 +1,89 @@
+//
+//  EntityTimerQueue.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTimerQueue.h"
+
+#include <algorithm>
+
+// the heap is rebuilt from the live schedule when it has this many times more entries, plus a few
+const int MAX_STALE_RATIO = 2;
+const int MIN_ENTRIES_TO_COMPACT = 64;
+
+void EntityTimerQueue::schedule(const EntityItemPointer& entity, quint64 time) {
+    auto timeItr = _times.find(entity);
+    if (timeItr != _times.end()) {
+        if (timeItr.value() == time) {
+            return;
+        }
+        timeItr.value() = time;
+    } else {
+        _times.insert(entity, time);
+    }
+
+    _heap.emplace_back(time, entity);
+    std::push_heap(_heap.begin(), _heap.end(), isLater);
+    if ((int)_heap.size() > MAX_STALE_RATIO * _times.size() + MIN_ENTRIES_TO_COMPACT) {
+        compact();
+    }
+}
+
+void EntityTimerQueue::remove(const EntityItemPointer& entity) {
+    // its entry is dropped from the heap later
+    _times.remove(entity);
+}
+
+void EntityTimerQueue::clear() {
+    _heap.clear();
+    _times.clear();
+}
+
+quint64 EntityTimerQueue::getNextTime() {
+    dropStaleTop();
+    return _heap.empty() ? quint64(-1) : _heap.front().first;
+}
+
+void EntityTimerQueue::takeDue(const quint64& now, QVector<EntityItemPointer>& due) {
+    dropStaleTop();
+    while (!_heap.empty() && _heap.front().first <= now) {
+        EntityItemPointer entity = _heap.front().second.lock();
+        std::pop_heap(_heap.begin(), _heap.end(), isLater);
+        _heap.pop_back();
+        if (entity) {
+            due.push_back(entity);
+            _times.remove(entity);
+        }
+        dropStaleTop();
+    }
+}
+
+void EntityTimerQueue::dropStaleTop() {
+    while (!_heap.empty()) {
+        const Entry& top = _heap.front();
+        EntityItemPointer entity = top.second.lock();
+        if (entity) {
+            auto timeItr = _times.find(entity);
+            if (timeItr != _times.end() && timeItr.value() == top.first) {
+                return;
+            }
+        }
+        std::pop_heap(_heap.begin(), _heap.end(), isLater);
+        _heap.pop_back();
+    }
+}
+
+void EntityTimerQueue::compact() {
+    _heap.clear();
+    _heap.reserve(_times.size());
+    for (auto timeItr = _times.begin(); timeItr != _times.end(); ++timeItr) {
+        _heap.emplace_back(timeItr.value(), timeItr.key());
+    }
+    std::make_heap(_heap.begin(), _heap.end(), isLater);
+}
@@ -0,0 +1,58 @@
+//
+//  EntityTimerQueue.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTimerQueue_h
+#define hifi_EntityTimerQueue_h
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "EntityItem.h"
+
+/// Entities ordered by the time at which the EntitySimulation next needs to do something with them, so that each update
+/// only touches the entities that are due instead of scanning all of them.
+///
+/// The entities are kept in a min-heap of times. Rescheduling or removing an entity leaves its old entry in the heap,
+/// and entries that no longer match the entity's scheduled time are dropped when they reach the top, or all at once
+/// when they outnumber the live ones.
+class EntityTimerQueue {
+public:
+    /// schedules the entity at time, replacing the time it was scheduled at before
+    void schedule(const EntityItemPointer& entity, quint64 time);
+    void remove(const EntityItemPointer& entity);
+    void clear();
+
+    bool contains(const EntityItemPointer& entity) const { return _times.contains(entity); }
+    int size() const { return _times.size(); }
+
+    /// the earliest time an entity is scheduled at, or quint64(-1) when there are none
+    quint64 getNextTime();
+
+    /// removes the entities scheduled at or before now and appends them to due, the earliest first
+    void takeDue(const quint64& now, QVector<EntityItemPointer>& due);
+
+private:
+    using Entry = std::pair<quint64, EntityItemWeakPointer>;
+
+    // Entry comparison for std::push_heap and friends, whose heap has the largest element on top
+    static bool isLater(const Entry& a, const Entry& b) { return a.first > b.first; }
+
+    void dropStaleTop();
+    void compact();
+
+    std::vector<Entry> _heap;
+    QHash<EntityItemPointer, quint64> _times; // the live schedule
+};
+
+#endif // hifi_EntityTimerQueue_h
@@ -25,6 +25,8 @@
 #include "RecurseOctreeToMapOperator.h"
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
+#include "EntityPersistFile.h"
+#include "EntitySpatialIndex.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
@@ -93,10 +95,23 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         }
         _entityToElementMap.clear();
     }
+    if (_spatialIndex) {
+        _spatialIndex->clear();
+    }
+    {
+        std::lock_guard<std::mutex> guard(_propertyChangesLock);
+        _pendingPropertyChanges.clear();
+    }
     Octree::eraseAllOctreeElements(createNewRoot);
 
     resetClientEditStats();
     clearDeletedEntities();
+
+    {
+        // the changes don't describe the new tree, so every client re-walks it
+        std::lock_guard<std::mutex> locker(_changeLogLock);
+        _oldestLoggedChange = _changeLogSequence;
+    }
 }
 
 bool EntityTree::handlesEditPacketType(PacketType packetType) const {
@@ -106,6 +121,7 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
         case PacketType::EntityEdit:
         case PacketType::EntityErase:
         case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsPacked:
             return true;
         default:
             return false;
@@ -126,6 +142,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    logEntityChange(entity->getEntityItemID());
     emit addingEntity(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
@@ -191,6 +208,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
                 UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, queryCube);
                 recurseTreeWithOperator(&theOperator);
                 entity->setProperties(tempProperties);
+                recordPropertyChanges(entity->getEntityItemID(), tempProperties.getChangedProperties());
                 _isDirty = true;
             }
         }
@@ -263,9 +281,10 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         } else {
             newQueryAACube = entity->getQueryAACube();
         }
-        UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
-        recurseTreeWithOperator(&theOperator);
+        updateEntityElement(containingElement, entity, newQueryAACube);
         entity->setProperties(properties);
+        recordPropertyChanges(entity->getEntityItemID(), properties.getChangedProperties());
+        updateEntityInSpatialIndex(entity);
 
         // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
         QQueue<SpatiallyNestablePointer> toProcess;
@@ -297,8 +316,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
                 _missingParent.append(childEntity);
             }
 
-            UpdateEntityOperator theChildOperator(getThisPointer(), containingElement, childEntity, queryCube);
-            recurseTreeWithOperator(&theChildOperator);
+            updateEntityElement(containingElement, childEntity, queryCube);
             foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
                 if (childChild && childChild->getNestableType() == NestableType::Entity) {
                     toProcess.enqueue(childChild);
@@ -336,9 +354,35 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         return false;
     }
 
+    logEntityChange(entity->getEntityItemID());
     return true;
 }
 
+void EntityTree::updateEntityElement(EntityTreeElementPointer containingElement, EntityItemPointer entity,
+                                     const AACube& newQueryAACube) {
+    // Most edits leave the entity in the element it is already in, which is where UpdateEntityOperator would end up
+    // after recursing from the root. All it would change then is the changed time of the path down to that element,
+    // so walk just that path instead.
+    if (entity->getElement() == containingElement && containingElement->bestFitBounds(entity->getQueryAACube()) &&
+        containingElement->bestFitBounds(newQueryAACube)) {
+        glm::vec3 containingCenter = containingElement->getAACube().calcCenter();
+        float containingScale = containingElement->getScale();
+
+        OctreeElementPointer element = _rootElement;
+        while (element && element->getScale() >= containingScale) {
+            element->markWithChangedTime();
+            if (element == containingElement) {
+                return;
+            }
+            element = element->getChildAtIndex(element->getMyChildContainingPoint(containingCenter));
+        }
+        // the element isn't where its cube says, let the operator sort it out
+    }
+
+    UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
+    recurseTreeWithOperator(&theOperator);
+}
+
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
     EntityItemPointer result = NULL;
     EntityItemProperties props = properties;
@@ -377,21 +421,39 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
         if (recordCreationTime) {
             result->recordCreationTime();
         }
-        // Recurse the tree and store the entity in the correct tree element
-        AddEntityOperator theOperator(getThisPointer(), result);
-        recurseTreeWithOperator(&theOperator);
-        if (result->getAncestorMissing()) {
-            // we added the entity, but didn't know about all its ancestors, so it went into the wrong place.
-            // add it to a list of entities needing to be fixed once their parents are known.
-            QWriteLocker locker(&_missingParentLock);
-            _missingParent.append(result);
-        }
-
-        postAddEntity(result);
+        insertEntity(result);
     }
     return result;
 }
 
+bool EntityTree::addDecodedEntity(EntityItemPointer entity) {
+    if (getContainingElement(entity->getEntityItemID())) {
+        qCDebug(entities) << "UNEXPECTED!!! ----- don't call addDecodedEntity() on existing entity items. entityID="
+                          << entity->getEntityItemID();
+        return false;
+    }
+
+    if (entity->getCreated() == UNKNOWN_CREATED_TIME) {
+        entity->recordCreationTime();
+    }
+    insertEntity(entity);
+    return true;
+}
+
+void EntityTree::insertEntity(EntityItemPointer entity) {
+    // Recurse the tree and store the entity in the correct tree element
+    AddEntityOperator theOperator(getThisPointer(), entity);
+    recurseTreeWithOperator(&theOperator);
+    if (entity->getAncestorMissing()) {
+        // we added the entity, but didn't know about all its ancestors, so it went into the wrong place.
+        // add it to a list of entities needing to be fixed once their parents are known.
+        QWriteLocker locker(&_missingParentLock);
+        _missingParent.append(entity);
+    }
+
+    postAddEntity(entity);
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -523,11 +585,14 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         }
 
         theEntity->die();
+        logEntityChange(theEntity->getEntityItemID());
 
         if (getIsServer()) {
-            // set up the deleted entities ID
-            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-            _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            // set up the deleted entities ID, unless it moved to another server which sends it to the clients now
+            if (!_migratingEntityIDs.contains(theEntity->getEntityItemID())) {
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            }
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -610,7 +675,22 @@ bool EntityTree::findRayIntersection(const glm::vec3& origin, const glm::vec3& d
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperation(findRayIntersectionOp, &args);
+        if (!_spatialIndex) {
+            recurseTreeWithOperation(findRayIntersectionOp, &args);
+            return;
+        }
+
+        _spatialIndex->findRayIntersection(origin, direction, [&](const EntityItemPointer& entity) {
+            OctreeElementPointer entityElement = entity->getElement();
+            bool keepSearching = true;
+            if (EntityTreeElement::findEntityRayIntersection(entity, origin, direction, keepSearching, entityElement,
+                    distance, face, surfaceNormal, entityIdsToInclude, entityIdsToDiscard, visibleOnly, collidableOnly,
+                    intersectedObject, precisionPicking)) {
+                element = entityElement;
+                args.found = true;
+            }
+            return distance;
+        });
     }, requireLock);
 
     if (accurateResult) {
@@ -624,6 +704,18 @@ bool EntityTree::findRayIntersection(const glm::vec3& origin, const glm::vec3& d
 EntityItemPointer EntityTree::findClosestEntity(glm::vec3 position, float targetRadius) {
     FindNearPointArgs args = { position, targetRadius, false, NULL, FLT_MAX };
     withReadLock([&] {
+        if (_spatialIndex) {
+            _spatialIndex->findEntities(position, targetRadius, [&](const EntityItemPointer& entity) {
+                float distanceFromPointToEntity = glm::distance(entity->getPosition(), position);
+                if (distanceFromPointToEntity <= targetRadius && distanceFromPointToEntity < args.closestEntityDistance) {
+                    args.closestEntity = entity;
+                    args.closestEntityDistance = distanceFromPointToEntity;
+                    args.found = true;
+                }
+            });
+            return;
+        }
+
         // NOTE: This should use recursion, since this is a spatial operation
         recurseTreeWithOperation(findNearPointOperation, &args);
     });
@@ -657,8 +749,16 @@ bool EntityTree::findInSphereOperation(OctreeElementPointer element, void* extra
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
     FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInSphereOperation, &args);
+    if (_spatialIndex) {
+        _spatialIndex->findEntities(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::entityIntersectsSphere(entity, center, radius)) {
+                args.entities.push_back(entity);
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInSphereOperation, &args);
+    }
 
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
@@ -687,8 +787,19 @@ bool EntityTree::findInCubeOperation(OctreeElementPointer element, void* extraDa
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
     FindEntitiesInCubeArgs args(cube);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    if (_spatialIndex) {
+        _spatialIndex->findEntities(AABox(cube), [&](const EntityItemPointer& entity) {
+            // the same test as EntityTreeElement::getEntities()
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success || entityBox.touches(cube)) {
+                args._foundEntities.push_back(entity);
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInCubeOperation, &args);
+    }
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args._foundEntities);
 }
@@ -716,8 +827,19 @@ bool EntityTree::findInBoxOperation(OctreeElementPointer element, void* extraDat
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
     FindEntitiesInBoxArgs args(box);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    if (_spatialIndex) {
+        _spatialIndex->findEntities(box, [&](const EntityItemPointer& entity) {
+            // the same test as EntityTreeElement::getEntities()
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success || entityBox.touches(box)) {
+                args._foundEntities.push_back(entity);
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInBoxOperation, &args);
+    }
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args._foundEntities);
 }
@@ -741,8 +863,19 @@ bool EntityTree::findInFrustumOperation(OctreeElementPointer element, void* extr
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
     FindInFrustumArgs args = { frustum, QVector<EntityItemPointer>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
+    if (_spatialIndex) {
+        _spatialIndex->findEntities(frustum, [&](const EntityItemPointer& entity) {
+            // the same test as EntityTreeElement::getEntities()
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (!success || frustum.boxIntersectsFrustum(entityBox) || frustum.boxIntersectsKeyhole(entityBox)) {
+                args.entities.push_back(entity);
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInFrustumOperation, &args);
+    }
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -947,6 +1080,71 @@ void EntityTree::bumpTimestamp(EntityItemProperties& properties) { //fixme put c
     properties.setLastEdited(properties.getLastEdited() + LAST_EDITED_SERVERSIDE_BUMP);
 }
 
+EntityItemPointer EntityDecodedBitstream::takeEntity(const unsigned char* data, int& bytesForEntity) {
+    auto it = entities.find(data);
+    if (it == entities.end()) {
+        return EntityItemPointer();
+    }
+    EntityItemPointer entity = std::move(it->second.entity);
+    bytesForEntity = it->second.bytes;
+    entities.erase(it);
+    return entity;
+}
+
+OctreeDecodedBitstreamPointer EntityTree::createDecodedBitstream() const {
+    return OctreeDecodedBitstreamPointer(new EntityDecodedBitstream());
+}
+
+int EntityTree::decodeElementData(bool isRoot, const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args,
+                                  OctreeDecodedBitstream& decoded) const {
+    // sized the way EntityTreeElement::readElementDataFromBuffer() reads it
+    if (isRoot && args.bitstreamVersion < VERSION_ROOT_ELEMENT_HAS_DATA) {
+        return 0;
+    }
+    if (args.bitstreamVersion < VERSION_ENTITIES_SUPPORT_SPLIT_MTU) {
+        // without IDs old streams can't be told apart from the tree, stop decoding and let them be read as they are
+        return bytesLeftToRead;
+    }
+
+    auto& decodedEntities = static_cast<EntityDecodedBitstream&>(decoded).entities;
+    const unsigned char* dataAt = data;
+    int bytesRead = 0;
+    uint16_t numberOfEntities = 0;
+
+    if (bytesLeftToRead >= (int)sizeof(numberOfEntities)) {
+        memcpy(&numberOfEntities, dataAt, sizeof(numberOfEntities));
+        dataAt += sizeof(numberOfEntities);
+        bytesLeftToRead -= (int)sizeof(numberOfEntities);
+        bytesRead += sizeof(numberOfEntities);
+
+        if (bytesLeftToRead >= (int)(numberOfEntities * EntityItem::expectedBytes())) {
+            for (uint16_t i = 0; i < numberOfEntities; i++) {
+                int bytesForThisEntity = 0;
+                EntityItemID entityItemID = EntityItemID::readEntityItemIDFromBuffer(dataAt, bytesLeftToRead);
+                EntityItemPointer entityItem = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                if (entityItem) {
+                    bytesForThisEntity = entityItem->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
+
+                    // an entity already in the tree reads its data itself once the bitstream is read into the tree,
+                    // it was only decoded to find where the next one starts
+                    bool isInTree;
+                    {
+                        QReadLocker locker(&_entityToElementLock);
+                        isInTree = _entityToElementMap.contains(entityItemID);
+                    }
+                    if (!isInTree) {
+                        decodedEntities[dataAt] = { entityItem, bytesForThisEntity };
+                    }
+                }
+                dataAt += bytesForThisEntity;
+                bytesLeftToRead -= bytesForThisEntity;
+                bytesRead += bytesForThisEntity;
+            }
+        }
+    }
+    return bytesRead;
+}
+
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                      const SharedNodePointer& senderNode) {
 
@@ -956,7 +1154,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -966,195 +1163,288 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
         case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsPacked:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
+            EntityDecodedEdit decodedEdit;
+            processedBytes = decodeEdit(message.getType(), editData, maxLength, senderNode, decodedEdit);
+            filterEdit(message.getType(), decodedEdit, senderNode);
+            applyEdit(message.getType(), decodedEdit, senderNode);
+            break;
+        }
 
-            bool suppressDisallowedScript = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-            _totalEditMessages++;
+bool EntityTree::decodesEditPacketType(PacketType packetType) const {
+    // erases are looked up in the tree as they are read, so only these are decoded on their own
+    switch (packetType) {
+        case PacketType::EntityAdd:
+        case PacketType::EntityEdit:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsPacked:
+            return true;
+        default:
+            return false;
+    }
+}
 
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
+int EntityTree::decodeEditPacketData(PacketType packetType, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode, OctreeDecodedEditPointer& decodedEdit) {
+    auto entityDecodedEdit = new EntityDecodedEdit();
+    decodedEdit.reset(entityDecodedEdit);
+    int processedBytes = decodeEdit(packetType, editData, maxLength, senderNode, *entityDecodedEdit);
+    // the filters run on the decoding threads too, so a slow filter script doesn't hold the tree lock
+    filterEdit(packetType, *entityDecodedEdit, senderNode);
+    return processedBytes;
+}
 
-            bool validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes,
-                                                                                entityItemID, properties);
-            endDecode = usecTimestampNow();
+void EntityTree::processDecodedEdit(PacketType packetType, OctreeDecodedEdit& decodedEdit,
+                                    const SharedNodePointer& senderNode) {
+    if (!getIsServer()) {
+        qCDebug(entities) << "UNEXPECTED!!! processDecodedEdit() should only be called on a server tree.";
+        return;
+    }
+    applyEdit(packetType, static_cast<EntityDecodedEdit&>(decodedEdit), senderNode);
+}
 
+int EntityTree::decodeEdit(PacketType packetType, const unsigned char* editData, int maxLength,
+                           const SharedNodePointer& senderNode, EntityDecodedEdit& decodedEdit) const {
+    int processedBytes = 0;
+    bool isAdd = packetType == PacketType::EntityAdd;
+    EntityItemProperties& properties = decodedEdit.properties;
+
+    quint64 startDecode = usecTimestampNow();
+    if (packetType == PacketType::EntityPhysicsPacked) {
+        // only the motion, nothing else to check
+        decodedEdit.isValid = EntityItemProperties::decodeEntityPhysicsPackedPacket(editData, maxLength, processedBytes,
+                                                                                  decodedEdit.entityItemID, properties);
+        decodedEdit.decodeTime = usecTimestampNow() - startDecode;
+        return processedBytes;
+    }
+    decodedEdit.isValid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes,
+                                                                     decodedEdit.entityItemID, properties);
+    decodedEdit.decodeTime = usecTimestampNow() - startDecode;
+
+    if (decodedEdit.isValid && !_entityScriptSourceWhitelist.isEmpty() && !properties.getScript().isEmpty()) {
+        bool passedWhiteList = false;
+
+        // grab a URL representation of the entity script so we can check the host for this script
+        auto entityScriptURL = QUrl::fromUserInput(properties.getScript());
+
+        for (const auto& whiteListedPrefix : _entityScriptSourceWhitelist) {
+            auto whiteListURL = QUrl::fromUserInput(whiteListedPrefix);
+
+            // check if this script URL matches the whitelist domain and, optionally, is beneath the path
+            if (entityScriptURL.host().compare(whiteListURL.host(), Qt::CaseInsensitive) == 0 &&
+                entityScriptURL.path().startsWith(whiteListURL.path(), Qt::CaseInsensitive)) {
+                passedWhiteList = true;
+                break;
+            }
+        }
+        if (!passedWhiteList) {
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] attempting to set entity script not on whitelist, edit rejected";
+            }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty() && !properties.getScript().isEmpty()) {
-                bool passedWhiteList = false;
+            // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+            if (isAdd) {
+                decodedEdit.isRejectedAdd = true;
+                decodedEdit.isValid = false;
+            } else {
+                decodedEdit.suppressDisallowedScript = true;
+            }
+        }
+    }
 
-                // grab a URL representation of the entity script so we can check the host for this script
-                auto entityScriptURL = QUrl::fromUserInput(properties.getScript());
+    if ((isAdd || properties.lifetimeChanged()) &&
+        !senderNode->getCanRez() && senderNode->getCanRezTmp()) {
+        // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+        if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+            properties.getLifetime() > _maxTmpEntityLifetime) {
+            properties.setLifetime(_maxTmpEntityLifetime);
+            bumpTimestamp(properties);
+        }
+    }
 
-                for (const auto& whiteListedPrefix : _entityScriptSourceWhitelist) {
-                    auto whiteListURL = QUrl::fromUserInput(whiteListedPrefix);
+    return processedBytes;
+}
 
-                    // check if this script URL matches the whitelist domain and, optionally, is beneath the path
-                    if (entityScriptURL.host().compare(whiteListURL.host(), Qt::CaseInsensitive) == 0 &&
-                        entityScriptURL.path().startsWith(whiteListURL.path(), Qt::CaseInsensitive)) {
-                        passedWhiteList = true;
-                        break;
-                    }
-                }
-                if (!passedWhiteList) {
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] attempting to set entity script not on whitelist, edit rejected";
-                    }
+void EntityTree::filterEdit(PacketType packetType, EntityDecodedEdit& decodedEdit, const SharedNodePointer& senderNode) {
+    bool isAdd = packetType == PacketType::EntityAdd;
+    bool isPhysics = packetType == PacketType::EntityPhysics || packetType == PacketType::EntityPhysicsPacked;
+    bool isMigration = isAdd && senderNode->getType() == NodeType::EntityServer;
+    // Having (un)lock rights bypasses the filter, unless it's a physics result.
+    if (!decodedEdit.isValid || isMigration || (!isPhysics && senderNode->isAllowedEditor())) {
+        return;
+    }
 
-                    // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                    if (isAdd) {
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                        validEditPacket = passedWhiteList;
-                    } else {
-                        suppressDisallowedScript = true;
-                    }
-                }
-            }
+    // the zones of an edit are those at the position of its entity now, which an edit of the same batch may still move
+    EntityItemPointer existingEntity = findEntityByEntityItemID(decodedEdit.entityItemID);
+    if (!existingEntity && !isAdd) {
+        return;
+    }
 
-            if ((isAdd || properties.lifetimeChanged()) &&
-                !senderNode->getCanRez() && senderNode->getCanRezTmp()) {
-                // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                    properties.getLifetime() > _maxTmpEntityLifetime) {
-                    properties.setLifetime(_maxTmpEntityLifetime);
-                    bumpTimestamp(properties);
-                }
+    quint64 startFilter = usecTimestampNow();
+    FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+    decodedEdit.isFilterAllowed = filterProperties(existingEntity, decodedEdit.properties, decodedEdit.properties,
+                                                   decodedEdit.wasChangedByFilter, filterType);
+    decodedEdit.isFiltered = true;
+    decodedEdit.filterTime = usecTimestampNow() - startFilter;
+}
+
+void EntityTree::applyEdit(PacketType packetType, EntityDecodedEdit& decodedEdit, const SharedNodePointer& senderNode) {
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    bool isAdd = packetType == PacketType::EntityAdd;
+    bool isPhysics = packetType == PacketType::EntityPhysics || packetType == PacketType::EntityPhysicsPacked;
+    // an add from another entity server is an entity it hands over to us, already checked when it was first added
+    bool isMigration = isAdd && senderNode->getType() == NodeType::EntityServer;
+    const EntityItemID& entityItemID = decodedEdit.entityItemID;
+    EntityItemProperties& properties = decodedEdit.properties;
+
+    _totalEditMessages++;
+
+    if (decodedEdit.isRejectedAdd) {
+        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+    }
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (decodedEdit.isValid) {
+
+        // search for the entity by EntityItemID
+        startLookup = usecTimestampNow();
+        EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
+        endLookup = usecTimestampNow();
+
+        // every entity server gets every edit, the others are for the entities of another server
+        if (_jurisdiction && !existingEntity && (!isAdd || !ownsNewEntity(properties))) {
+            _totalDecodeTime += decodedEdit.decodeTime;
+            return;
+        }
+
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        bool allowed = isMigration || (!isPhysics && senderNode->isAllowedEditor());
+        if (!allowed && decodedEdit.isFiltered) {
+            allowed = decodedEdit.isFilterAllowed;
+            wasChanged = decodedEdit.wasChangedByFilter;
+        } else if (!allowed) {
+            allowed = filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+        }
+        if (!allowed) {
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        if (existingEntity && (!isAdd || isMigration)) {
+
+            if (decodedEdit.suppressDisallowedScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
             }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
 
-                if (existingEntity && !isAdd) {
+            startUpdate = usecTimestampNow();
+            if (!isPhysics && !isMigration) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(entityItemID, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isMigration && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
+                                  << "] attempted to add an entity ID:" << entityItemID;
 
-                    if (suppressDisallowedScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+            } else {
+                // this is a new entity... assign a new entityID
+                properties.setCreated(properties.getLastEdited());
+                if (!isMigration) {
+                    properties.setLastEditedBy(senderNode->getUUID());
+                }
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
 
-                    // if the EntityItem exists, then update it
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(entityItemID, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
-                                          << "] attempted to add an entity ID:" << entityItemID;
-
-                    } else {
-                        // this is a new entity... assign a new entityID
-                        properties.setCreated(properties.getLastEdited());
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    static QString repeatedMessage =
-                        LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
-                    qCDebug(entities) << "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get();
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
-
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            static QString repeatedMessage =
+                LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
+            qCDebug(entities) << "Edit failed. [" << packetType <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get();
         }
-
-        default:
-            processedBytes = 0;
-            break;
     }
-    return processedBytes;
+
+    _totalDecodeTime += decodedEdit.decodeTime;
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += decodedEdit.filterTime + endFilter - startFilter;
 }
 
 
@@ -1194,6 +1484,96 @@ void EntityTree::entityChanged(EntityItemPointer entity) {
     }
 }
 
+int EntityTree::subscribeToPropertyChanges(const EntityPropertyFlags& properties, EntityPropertyChangesHandler handler) {
+    std::lock_guard<std::mutex> guard(_propertyChangesLock);
+    int subscriptionID = _nextPropertyChangesSubscriptionID++;
+    _propertyChangesSubscriptions.insert(subscriptionID, { properties, handler });
+    return subscriptionID;
+}
+
+void EntityTree::unsubscribeFromPropertyChanges(int subscriptionID) {
+    std::lock_guard<std::mutex> guard(_propertyChangesLock);
+    _propertyChangesSubscriptions.remove(subscriptionID);
+    if (_propertyChangesSubscriptions.isEmpty()) {
+        _pendingPropertyChanges.clear();
+    }
+}
+
+void EntityTree::recordPropertyChanges(const EntityItemID& entityID, const EntityPropertyFlags& changedProperties) {
+    if (!changedProperties) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_propertyChangesLock);
+    if (!_propertyChangesSubscriptions.isEmpty()) {
+        _pendingPropertyChanges[entityID] |= changedProperties;
+    }
+}
+
+void EntityTree::dispatchPropertyChanges() {
+    QHash<EntityItemID, EntityPropertyFlags> pendingChanges;
+    QHash<int, PropertyChangesSubscription> subscriptions;
+    {
+        std::lock_guard<std::mutex> guard(_propertyChangesLock);
+        if (_pendingPropertyChanges.isEmpty()) {
+            return;
+        }
+        pendingChanges.swap(_pendingPropertyChanges);
+        subscriptions = _propertyChangesSubscriptions;
+    }
+
+    // each observer gets the records of its properties only, and no call when none of them changed
+    EntityPropertyChanges changes;
+    changes.reserve(pendingChanges.size());
+    for (const auto& subscription : subscriptions) {
+        changes.clear();
+        for (auto itr = pendingChanges.constBegin(); itr != pendingChanges.constEnd(); ++itr) {
+            EntityPropertyFlags changedProperties = itr.value() & subscription.properties;
+            if (!changedProperties) {
+                continue;
+            }
+            changes.push_back({ itr.key(), changedProperties });
+        }
+        if (!changes.isEmpty()) {
+            subscription.handler(changes);
+        }
+    }
+}
+
+void EntityTree::logEntityChange(const EntityItemID& entityID) {
+    if (!_wantChangeLog) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> locker(_changeLogLock);
+    if (_changeLog.empty()) {
+        _changeLog.resize(CHANGE_LOG_SIZE);
+    }
+
+    _changeLog[_changeLogSequence % CHANGE_LOG_SIZE] = entityID;
+    ++_changeLogSequence;
+
+    if (_changeLogSequence - _oldestLoggedChange > CHANGE_LOG_SIZE) {
+        _oldestLoggedChange = _changeLogSequence - CHANGE_LOG_SIZE;
+    }
+}
+
+uint64_t EntityTree::getChangeLogSequence() const {
+    std::lock_guard<std::mutex> locker(_changeLogLock);
+    return _changeLogSequence;
+}
+
+bool EntityTree::getEntityChangesSince(uint64_t sequence, QSet<EntityItemID>& changedEntityIDs) const {
+    std::lock_guard<std::mutex> locker(_changeLogLock);
+    if (!_wantChangeLog || sequence < _oldestLoggedChange || sequence > _changeLogSequence) {
+        return false;
+    }
+
+    for (uint64_t i = sequence; i < _changeLogSequence; ++i) {
+        changedEntityIDs.insert(_changeLog[i % CHANGE_LOG_SIZE]);
+    }
+    return true;
+}
+
 void EntityTree::fixupMissingParents() {
     MovingEntitiesOperator moveOperator(getThisPointer());
 
@@ -1285,6 +1665,7 @@ void EntityTree::update() {
             }
         });
     }
+    dispatchPropertyChanges();
 }
 
 quint64 EntityTree::getAdjustedConsiderSince(quint64 sinceTime) {
@@ -1438,6 +1819,11 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
     return element;
 }
 
+QVector<EntityItemID> EntityTree::getEntityIDs() const {
+    QReadLocker locker(&_entityToElementLock);
+    return _entityToElementMap.keys().toVector();
+}
+
 void EntityTree::setContainingElement(const EntityItemID& entityItemID, EntityTreeElementPointer element) {
     QWriteLocker locker(&_entityToElementLock);
     if (element) {
@@ -1447,6 +1833,168 @@ void EntityTree::setContainingElement(const EntityItemID& entityItemID, EntityTr
     }
 }
 
+void EntityTree::setWantSpatialIndex(bool wantSpatialIndex) {
+    if (wantSpatialIndex == (bool)_spatialIndex) {
+        return;
+    }
+    if (!wantSpatialIndex) {
+        _spatialIndex.reset();
+        return;
+    }
+
+    _spatialIndex.reset(new EntitySpatialIndex());
+    withReadLock([&] {
+        QReadLocker locker(&_entityToElementLock);
+        for (auto it = _entityToElementMap.constBegin(); it != _entityToElementMap.constEnd(); ++it) {
+            EntityItemPointer entity = it.value()->getEntityWithEntityItemID(it.key());
+            if (entity) {
+                updateEntityInSpatialIndex(entity);
+            }
+        }
+    });
+}
+
+void EntityTree::updateEntityInSpatialIndex(const EntityItemPointer& entity) {
+    if (!_spatialIndex) {
+        return;
+    }
+
+    // index the cube the octree places the entity by, with the entity's own box in case it has outgrown the cube
+    bool success;
+    AABox bounds = entity->getQueryAACube(success);
+    if (success) {
+        bounds += entity->getAABox(success);
+    }
+    if (!success) {
+        // the octree includes the entities it can't bound whenever it visits their element, so index them by that
+        EntityTreeElementPointer element = entity->getElement();
+        if (!element) {
+            _spatialIndex->remove(entity->getEntityItemID());
+            return;
+        }
+        bounds = element->getAACube();
+    }
+    _spatialIndex->update(entity, bounds);
+}
+
+void EntityTree::removeEntityFromSpatialIndex(const EntityItemID& entityID) {
+    if (_spatialIndex) {
+        _spatialIndex->remove(entityID);
+    }
+}
+
+void EntityTree::setJurisdiction(const JurisdictionMap& jurisdiction) {
+    _jurisdiction.reset(new JurisdictionMap(jurisdiction));
+}
+
+bool EntityTree::isInJurisdiction(const glm::vec3& position) const {
+    return !_jurisdiction || _jurisdiction->isMyJurisdiction(position);
+}
+
+void EntityTree::updatePeerEntityOwners(const QUuid& serverID, const QVector<EntityItemID>& added,
+                                        const QVector<EntityItemID>& removed, bool isFullList) {
+    QWriteLocker locker(&_peerEntityOwnersLock);
+    if (isFullList) {
+        forgetPeerEntityOwnersLocked(serverID);
+    }
+    for (const auto& entityID : added) {
+        _peerEntityOwners[entityID] = serverID;
+    }
+    for (const auto& entityID : removed) {
+        // the entity may have been handed to another server, which has told us already
+        auto it = _peerEntityOwners.find(entityID);
+        if (it != _peerEntityOwners.end() && it.value() == serverID) {
+            _peerEntityOwners.erase(it);
+        }
+    }
+}
+
+void EntityTree::forgetPeerEntityOwners(const QUuid& serverID) {
+    QWriteLocker locker(&_peerEntityOwnersLock);
+    forgetPeerEntityOwnersLocked(serverID);
+}
+
+void EntityTree::forgetPeerEntityOwnersLocked(const QUuid& serverID) {
+    for (auto it = _peerEntityOwners.begin(); it != _peerEntityOwners.end();) {
+        if (it.value() == serverID) {
+            it = _peerEntityOwners.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QUuid EntityTree::getPeerEntityOwner(const QUuid& entityID) const {
+    QReadLocker locker(&_peerEntityOwnersLock);
+    return _peerEntityOwners.value(entityID);
+}
+
+bool EntityTree::ownsNewEntity(const EntityItemProperties& properties) {
+    if (!_jurisdiction) {
+        return true;
+    }
+
+    // children live on the server of their parent
+    QUuid parentID = properties.getParentID();
+    if (!parentID.isNull()) {
+        if (findEntityByID(parentID)) {
+            return true;
+        }
+        if (!getPeerEntityOwner(parentID).isNull()) {
+            return false;
+        }
+        // a parent no server has, or one that isn't an entity, leaves the entity to the server its position is in
+    }
+    return isInJurisdiction(properties.getPosition());
+}
+
+QVector<EntityItemID> EntityTree::findEntitiesToMigrate(std::function<bool(const glm::vec3&)> isOwnedByPeer) {
+    QVector<EntityItemID> entityIDs;
+    if (!_jurisdiction) {
+        return entityIDs;
+    }
+
+    QVector<EntityItemPointer> roots;
+    {
+        QReadLocker locker(&_entityToElementLock);
+        for (auto it = _entityToElementMap.constBegin(); it != _entityToElementMap.constEnd(); ++it) {
+            EntityItemPointer entity = it.value()->getEntityWithEntityItemID(it.key());
+            if (!entity || entity->getClientOnly()) {
+                continue;
+            }
+
+            QUuid parentID = entity->getParentID();
+            if (parentID.isNull()) {
+                glm::vec3 position = entity->getPosition();
+                if (!isInJurisdiction(position) && isOwnedByPeer(position)) {
+                    roots.push_back(entity);
+                }
+            } else if (!_entityToElementMap.contains(parentID) && !getPeerEntityOwner(parentID).isNull()) {
+                // its parent is on another server now, so it follows it there
+                roots.push_back(entity);
+            }
+        }
+    }
+
+    // an entity goes with its children, the parents before their children so each one finds its parent on arrival
+    for (const auto& entity : roots) {
+        entityIDs.push_back(entity->getEntityItemID());
+        entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+            if (descendant->getNestableType() == NestableType::Entity) {
+                entityIDs.push_back(descendant->getID());
+            }
+        });
+    }
+    return entityIDs;
+}
+
+void EntityTree::removeMigratedEntities(const QVector<EntityItemID>& entityIDs) {
+    // the clients see the entities arrive from their new server, so they aren't told these were deleted
+    _migratingEntityIDs = QSet<EntityItemID>::fromList(entityIDs.toList());
+    deleteEntities(_migratingEntityIDs, true, true);
+    _migratingEntityIDs.clear();
+}
+
 void EntityTree::debugDumpMap() {
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
     QReadLocker locker(&_entityToElementLock);
@@ -1632,9 +2180,69 @@ bool EntityTree::writeToMap(QVariantMap& entityDescription, OctreeElementPointer
     if (! entityDescription.contains("Entities")) {
         entityDescription["Entities"] = QVariantList();
     }
+
+    // Snapshot the entities under the read lock, copying the properties of only those that changed since the last
+    // snapshot, then convert them without it. Saving then stalls edits for not much more than a walk of the tree.
+    struct SnapshotEntity {
+        EntityItemID id;
+        SavedEntity saved;
+        bool isUnchanged;
+        EntityItemProperties properties;
+    };
+    std::vector<SnapshotEntity> snapshot;
+
+    std::lock_guard<std::mutex> savedEntitiesLocker(_savedEntitiesLock);
+    bool useSavedEntities = skipDefaultValues; // what the persist thread saves
+    quint64 lockStart = usecTimestampNow();
+    withReadLock([&] {
+        QVector<EntityItemPointer> entities;
+        RecurseOctreeToMapOperator theOperator(entities, element, skipThoseWithBadParents);
+        recurseTreeWithOperator(&theOperator);
+
+        snapshot.resize(entities.size());
+        for (int i = 0; i < entities.size(); ++i) {
+            auto& entity = entities[i];
+            auto& snapshotEntity = snapshot[i];
+            snapshotEntity.id = entity->getEntityItemID();
+            snapshotEntity.saved = { entity->getLastEdited(), entity->getLastUpdated(), entity->getLastSimulated(),
+                                     entity->getLastChangedOnServer(), QVariant() };
+
+            auto it = useSavedEntities ? _savedEntities.constFind(snapshotEntity.id) : _savedEntities.constEnd();
+            snapshotEntity.isUnchanged = it != _savedEntities.constEnd() && it->isSameVersion(snapshotEntity.saved);
+            if (snapshotEntity.isUnchanged) {
+                snapshotEntity.saved.variant = it->variant;
+            } else {
+                snapshotEntity.properties = entity->getProperties();
+            }
+        }
+    });
+    addSaveLockUsecs(usecTimestampNow() - lockStart);
+
     QScriptEngine scriptEngine;
-    RecurseOctreeToMapOperator theOperator(entityDescription, element, &scriptEngine, skipDefaultValues, skipThoseWithBadParents);
-    recurseTreeWithOperator(&theOperator);
+    QVariantList entitiesQList = entityDescription["Entities"].toList();
+    QHash<EntityItemID, SavedEntity> savedEntities;
+    for (auto& snapshotEntity : snapshot) {
+        if (!snapshotEntity.isUnchanged) {
+            QScriptValue qScriptValues;
+            if (skipDefaultValues) {
+                qScriptValues = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, snapshotEntity.properties);
+            } else {
+                qScriptValues = EntityItemPropertiesToScriptValue(&scriptEngine, snapshotEntity.properties);
+            }
+            snapshotEntity.saved.variant = qScriptValues.toVariant();
+        }
+        entitiesQList << snapshotEntity.saved.variant;
+
+        if (useSavedEntities) {
+            savedEntities.insert(snapshotEntity.id, snapshotEntity.saved);
+        }
+    }
+    entityDescription["Entities"] = entitiesQList;
+
+    // only keep what this snapshot saw, so deleted entities are dropped
+    if (useSavedEntities) {
+        _savedEntities.swap(savedEntities);
+    }
     return true;
 }
 
@@ -1675,6 +2283,20 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
+bool EntityTree::writeToBinaryFile(const char* fileName) {
+    if (!_persistFile || _persistFile->getPath() != fileName) {
+        _persistFile.reset(new EntityPersistFile(fileName));
+    }
+    return _persistFile->save(*this);
+}
+
+bool EntityTree::readFromBinaryFile(const QString& fileName) {
+    if (!_persistFile || _persistFile->getPath() != fileName) {
+        _persistFile.reset(new EntityPersistFile(fileName));
+    }
+    return _persistFile->load(*this);
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
@@ -12,6 +12,12 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <QSet>
 #include <QVector>
 
@@ -26,6 +32,8 @@ typedef std::shared_ptr<EntityTree> EntityTreePointer;
 #include "DeleteEntityOperator.h"
 
 class EntityEditFilters;
+class EntityPersistFile;
+class EntitySpatialIndex;
 class Model;
 using ModelPointer = std::shared_ptr<Model>;
 using ModelWeakPointer = std::weak_ptr<Model>;
@@ -57,6 +65,45 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+/// An add, edit or physics edit decoded off the tree lock by EntityTree::decodeEditPacketData()
+class EntityDecodedEdit : public OctreeDecodedEdit {
+public:
+    bool isValid { false };
+    bool isRejectedAdd { false }; // the add is refused, and the sender told the entity is deleted
+    bool suppressDisallowedScript { false };
+    EntityItemID entityItemID;
+    EntityItemProperties properties;
+    quint64 decodeTime { 0 };
+    bool isFiltered { false }; // by the edit filters as it was decoded, with their verdict below
+    bool isFilterAllowed { true };
+    bool wasChangedByFilter { false };
+    quint64 filterTime { 0 };
+};
+
+/// The entities new to the tree in a bitstream decoded off the tree lock by EntityTree::decodeBitstream(), by where their
+/// data starts in the bitstream
+class EntityDecodedBitstream : public OctreeDecodedBitstream {
+public:
+    struct DecodedEntity {
+        EntityItemPointer entity;
+        int bytes;
+    };
+
+    /// the entity decoded from the data, or null if it wasn't new when decoded
+    EntityItemPointer takeEntity(const unsigned char* data, int& bytesForEntity);
+
+    std::unordered_map<const unsigned char*, DecodedEntity> entities;
+};
+
+/// The properties of an entity changed by the edits since the change records were last dispatched
+class EntityPropertyChange {
+public:
+    EntityItemID entityID;
+    EntityPropertyFlags changedProperties;
+};
+using EntityPropertyChanges = QVector<EntityPropertyChange>;
+using EntityPropertyChangesHandler = std::function<void(const EntityPropertyChanges&)>;
+
 
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
@@ -98,6 +145,13 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool decodesEditPacketType(PacketType packetType) const override;
+    virtual int decodeEditPacketData(PacketType packetType, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode, OctreeDecodedEditPointer& decodedEdit) override;
+    virtual void processDecodedEdit(PacketType packetType, OctreeDecodedEdit& decodedEdit,
+                                    const SharedNodePointer& senderNode) override;
+    virtual bool decodesBitstream() const override { return true; }
+    virtual OctreeDecodedBitstreamPointer createDecodedBitstream() const override;
 
     virtual bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -123,6 +177,8 @@ public:
     void postAddEntity(EntityItemPointer entityItem);
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties);
+    // adds an entity that was read whole from its bitstream, returns false if it is already in the tree
+    bool addDecodedEntity(EntityItemPointer entity);
 
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
@@ -169,6 +225,29 @@ public:
     /// \param foundEntities[out] vector of EntityItemPointer
     void findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    // An index of the bounds of the entities that the find queries and ray picks use instead of recursing the octree,
+    // kept as entities are added, moved and deleted. Turning it on indexes the entities already in the tree.
+    void setWantSpatialIndex(bool wantSpatialIndex);
+    bool getWantSpatialIndex() const { return (bool)_spatialIndex; }
+    // called as an entity enters an element, or its bounds change, and as it leaves the tree
+    void updateEntityInSpatialIndex(const EntityItemPointer& entity);
+    void removeEntityFromSpatialIndex(const EntityItemID& entityID);
+
+    // With several entity servers in a domain each one owns the entities in its jurisdiction, and the children of the
+    // entities it owns. The edits for the entities of other servers are ignored, and a server keeps a directory of which
+    // of its peers owns what, so that a parent on another server can be told apart from a missing one.
+    void setJurisdiction(const JurisdictionMap& jurisdiction);
+    bool isInJurisdiction(const glm::vec3& position) const; // true for any position without a jurisdiction
+    void updatePeerEntityOwners(const QUuid& serverID, const QVector<EntityItemID>& added,
+                                const QVector<EntityItemID>& removed, bool isFullList);
+    void forgetPeerEntityOwners(const QUuid& serverID);
+    QUuid getPeerEntityOwner(const QUuid& entityID) const; // null when no peer has told us it owns the entity
+    // the entities whose position has moved to the jurisdiction of a peer, or whose parent is on a peer now, each
+    // followed by its descendants - the caller holds the read lock
+    QVector<EntityItemID> findEntitiesToMigrate(std::function<bool(const glm::vec3&)> isOwnedByPeer);
+    // deletes the entities a peer has been sent, without telling the clients - the caller holds the write lock
+    void removeMigratedEntities(const QVector<EntityItemID>& entityIDs);
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -187,6 +266,14 @@ public:
 
     void forgetEntitiesDeletedBefore(quint64 sinceTime);
 
+    // The entity server keeps a log of the IDs of recently added, edited and deleted entities, numbered in sequence,
+    // so that a client whose view hasn't changed is only sent what changed instead of re-walking the whole tree
+    void setWantChangeLog(bool wantChangeLog) { _wantChangeLog = wantChangeLog; }
+    void logEntityChange(const EntityItemID& entityID);
+    uint64_t getChangeLogSequence() const; // the sequence number of the next change
+    // adds the IDs changed from sequence on, returns false if the log has already dropped some of those changes
+    bool getEntityChangesSince(uint64_t sequence, QSet<EntityItemID>& changedEntityIDs) const;
+
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
 
@@ -200,6 +287,7 @@ public:
     }
 
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
+    QVector<EntityItemID> getEntityIDs() const;
     void setContainingElement(const EntityItemID& entityItemID, EntityTreeElementPointer element);
     void debugDumpMap();
     virtual void dumpTree() override;
@@ -210,6 +298,14 @@ public:
 
     void entityChanged(EntityItemPointer entity);
 
+    // an observer is given, once per update(), the entities edited since then in any of the properties it subscribed
+    // to, with only those properties in their records - the handler is called on the thread calling update(), without
+    // the tree lock, and an entity of a record may have been deleted since it was edited
+    int subscribeToPropertyChanges(const EntityPropertyFlags& properties, EntityPropertyChangesHandler handler);
+    void unsubscribeFromPropertyChanges(int subscriptionID);
+    void recordPropertyChanges(const EntityItemID& entityID, const EntityPropertyFlags& changedProperties);
+    void dispatchPropertyChanges();
+
     void emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload);
     void emitEntityServerScriptChanging(const EntityItemID& entityItemID, bool reload);
 
@@ -226,6 +322,9 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
 
+    virtual bool writeToBinaryFile(const char* fileName) override;
+    virtual bool readFromBinaryFile(const QString& fileName) override;
+
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
 
@@ -286,6 +385,8 @@ signals:
     void clearingEntities();
 
 protected:
+    virtual int decodeElementData(bool isRoot, const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args,
+                                  OctreeDecodedBitstream& decoded) const override;
 
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntityWithElement(EntityItemPointer entity, const EntityItemProperties& properties,
@@ -299,7 +400,19 @@ protected:
     static bool sendEntitiesOperation(OctreeElementPointer element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
 
+    int decodeEdit(PacketType packetType, const unsigned char* editData, int maxLength,
+                   const SharedNodePointer& senderNode, EntityDecodedEdit& decodedEdit) const;
+    // runs the edit filters on a decoded edit, off the tree lock, unless its entity may still be added by an edit before it
+    void filterEdit(PacketType packetType, EntityDecodedEdit& decodedEdit, const SharedNodePointer& senderNode);
+    void applyEdit(PacketType packetType, EntityDecodedEdit& decodedEdit, const SharedNodePointer& senderNode);
+
+    // moves an entity to the element its new query cube fits, or only marks the path to its element when it still fits there
+    void updateEntityElement(EntityTreeElementPointer containingElement, EntityItemPointer entity, const AACube& newQueryAACube);
+
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
+    bool ownsNewEntity(const EntityItemProperties& properties);
+    void forgetPeerEntityOwnersLocked(const QUuid& serverID);
+    void insertEntity(EntityItemPointer entity);
 
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
@@ -330,6 +443,48 @@ protected:
     bool _wantEditLogging = false;
     bool _wantTerseEditLogging = false;
 
+    static const uint64_t CHANGE_LOG_SIZE = 4096; // changes, a client further behind than this re-walks the tree
+    mutable std::mutex _changeLogLock; // Protects the change log
+    std::vector<EntityItemID> _changeLog; // ring buffer, sequence N is at N % CHANGE_LOG_SIZE
+    uint64_t _changeLogSequence { 0 }; // sequence number of the next change
+    uint64_t _oldestLoggedChange { 0 }; // sequence number of the oldest change still in the log
+    bool _wantChangeLog { false };
+
+    struct PropertyChangesSubscription {
+        EntityPropertyFlags properties;
+        EntityPropertyChangesHandler handler;
+    };
+    std::mutex _propertyChangesLock; // Protects the subscriptions and the pending property changes
+    QHash<int, PropertyChangesSubscription> _propertyChangesSubscriptions;
+    int _nextPropertyChangesSubscriptionID { 0 };
+    QHash<EntityItemID, EntityPropertyFlags> _pendingPropertyChanges; // none are kept while nothing is subscribed
+
+    std::unique_ptr<EntityPersistFile> _persistFile; // the binary file we were last loaded from or saved to
+
+    std::unique_ptr<EntitySpatialIndex> _spatialIndex;
+
+    std::unique_ptr<JurisdictionMap> _jurisdiction; // none when this is the only entity server
+    mutable QReadWriteLock _peerEntityOwnersLock;
+    QHash<EntityItemID, QUuid> _peerEntityOwners; // the entities of the other entity servers, by the ID of their server
+    QSet<EntityItemID> _migratingEntityIDs; // being deleted because they were sent to another server
+
+    // the converted properties of each entity the last writeToMap saved, re-used while none of its times change
+    // (the read only age they include may be stale, it is ignored when the file is loaded)
+    struct SavedEntity {
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        quint64 changedOnServer;
+        QVariant variant;
+
+        bool isSameVersion(const SavedEntity& other) const {
+            return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated &&
+                lastSimulated == other.lastSimulated && changedOnServer == other.changedOnServer;
+        }
+    };
+    std::mutex _savedEntitiesLock; // Protects _savedEntities, and keeps saves from taking snapshots at the same time
+    QHash<EntityItemID, SavedEntity> _savedEntities;
+
 
     // some performance tracking properties - only used in server trees
     int _totalEditMessages = 0;
@@ -30,6 +30,15 @@ EntityTreeElement::~EntityTreeElement() {
     _octreeMemoryUsage -= sizeof(EntityTreeElement);
 }
 
+void* EntityTreeElement::operator new(size_t size) {
+    assert(size == sizeof(EntityTreeElement));
+    return PoolAllocator<EntityTreeElement>::getPool().allocate();
+}
+
+void EntityTreeElement::operator delete(void* pointer) {
+    PoolAllocator<EntityTreeElement>::getPool().deallocate(pointer);
+}
+
 OctreeElementPointer EntityTreeElement::createNewElement(unsigned char* octalCode) {
     auto newChild = EntityTreeElementPointer(new EntityTreeElement(octalCode));
     newChild->setTree(_myTree);
@@ -279,6 +288,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
     int numberOfEntitiesOffset = 0;
     withReadLock([&] {
         QVector<uint16_t> indexesOfEntitiesToInclude;
+        auto entityNodeData = static_cast<EntityNodeData*>(params.nodeData);
         
         // It's possible that our element has been previous completed. In this case we'll simply not include any of our
         // entities for encoding. This is needed because we encode the element data at the "parent" level, and so we
@@ -286,7 +296,6 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
         if (!entityTreeElementExtraEncodeData->elementCompleted) {
 
             QJsonObject jsonFilters;
-            auto entityNodeData = static_cast<EntityNodeData*>(params.nodeData);
 
             if (entityNodeData) {
                 // we have an EntityNodeData instance
@@ -298,7 +307,13 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 EntityItemPointer entity = _entityItems[i];
                 bool includeThisEntity = true;
 
-                if (!params.forceSendScene && entity->getLastChangedOnServer() < params.lastQuerySent) {
+                if (params.forceSendScene) {
+                    // everything in view is sent
+                } else if (entityNodeData && jsonFilters.isEmpty()) {
+                    // send only what the node wasn't sent yet, or was sent an older version of, which covers both the
+                    // entities that changed and the ones that just entered a changed view
+                    includeThisEntity = !entityNodeData->hasSentEntity(entity->getID(), entity->getLastChangedOnServer());
+                } else if (entity->getLastChangedOnServer() < params.lastQuerySent) {
                     includeThisEntity = false;
                 }
 
@@ -414,6 +429,9 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 // If the entity item got completely appended, then we can remove it from the extra encode data
                 if (appendEntityState == OctreeElement::COMPLETED) {
                     entityTreeElementExtraEncodeData->entities.remove(entity->getEntityItemID());
+                    if (entityNodeData) {
+                        entityNodeData->trackSentEntity(entity->getID(), entity->getLastChangedOnServer());
+                    }
                 }
 
                 // If any part of the entity items didn't fit, then the element is considered partial
@@ -614,79 +632,89 @@ bool EntityTreeElement::findDetailedRayIntersection(const glm::vec3& origin, con
                                     bool visibleOnly, bool collidableOnly, void** intersectedObject, bool precisionPicking, float distanceToElementCube) {
 
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
-    int entityNumber = 0;
     bool somethingIntersected = false;
     forEachEntity([&](EntityItemPointer entity) {
-        if ( (visibleOnly && !entity->isVisible()) || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
-            || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
-            || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
+        if (findEntityRayIntersection(entity, origin, direction, keepSearching, element, distance, face, surfaceNormal,
+                entityIdsToInclude, entityIDsToDiscard, visibleOnly, collidableOnly, intersectedObject, precisionPicking)) {
+            somethingIntersected = true;
         }
+    });
+    return somethingIntersected;
+}
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success) {
-            return;
-        }
+bool EntityTreeElement::findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    bool visibleOnly, bool collidableOnly, void** intersectedObject, bool precisionPicking) {
+    if ( (visibleOnly && !entity->isVisible()) || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
+        || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
+        || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
+        return false;
+    }
 
-        float localDistance;
-        BoxFace localFace;
-        glm::vec3 localSurfaceNormal;
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success) {
+        return false;
+    }
 
-        // if the ray doesn't intersect with our cube, we can stop searching!
-        if (!entityBox.findRayIntersection(origin, direction, localDistance, localFace, localSurfaceNormal)) {
-            return;
-        }
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-        glm::mat4 translation = glm::translate(entity->getPosition());
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    // if the ray doesn't intersect with our cube, we can stop searching!
+    if (!entityBox.findRayIntersection(origin, direction, localDistance, localFace, localSurfaceNormal)) {
+        return false;
+    }
 
-        glm::vec3 dimensions = entity->getDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint);
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedRayIntersection()) {
-                    if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
-                        localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
-
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            *intersectedObject = (void*)entity.get();
-                            somethingIntersected = true;
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+    glm::mat4 translation = glm::translate(entity->getPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedRayIntersection()) {
+                if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
+                    localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
+
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
+                        surfaceNormal = localSurfaceNormal;
                         *intersectedObject = (void*)entity.get();
-                        somethingIntersected = true;
+                        return true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
+                    *intersectedObject = (void*)entity.get();
+                    return true;
+                }
             }
         }
-        entityNumber++;
-    });
-    return somethingIntersected;
+    }
+    return false;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
@@ -732,55 +760,62 @@ EntityItemPointer EntityTreeElement::getClosestEntity(glm::vec3 position) const
 // TODO: change this to use better bounding shape for entity than sphere
 void EntityTreeElement::getEntities(const glm::vec3& searchPosition, float searchRadius, QVector<EntityItemPointer>& foundEntities) const {
     forEachEntity([&](EntityItemPointer entity) {
+        if (entityIntersectsSphere(entity, searchPosition, searchRadius)) {
+            foundEntities.push_back(entity);
+        }
+    });
+}
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+bool EntityTreeElement::entityIntersectsSphere(const EntityItemPointer& entity, const glm::vec3& searchPosition,
+                                               float searchRadius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
-
-            glm::vec3 dimensions = entity->getDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably dull actuall hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
-                (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                if (findSphereSpherePenetration(searchPosition, searchRadius,
-                        entity->getCenterPosition(success), entityTrueRadius, penetration)) {
-                    if (success) {
-                        foundEntities.push_back(entity);
-                    }
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-                glm::mat4 translation = glm::translate(entity->getPosition());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || entityBox.findSpherePenetration(searchPosition, searchRadius, penetration)) {
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint);
+        glm::vec3 dimensions = entity->getDimensions();
+
+        // FIXME - consider allowing the entity to determine penetration so that
+        //         entities could presumably dull actuall hull testing if they wanted to
+        // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+        //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+        //         with centered registration points
+        if (entity->getShapeType() == SHAPE_TYPE_SPHERE &&
+            (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                AABox entityFrameBox(corner, dimensions);
+            // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+            //       maximum bounding sphere, which is actually larger than our actual radius
+            float entityTrueRadius = dimensions.x / 2.0f;
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
-                    foundEntities.push_back(entity);
+            bool success;
+            if (findSphereSpherePenetration(searchPosition, searchRadius,
+                    entity->getCenterPosition(success), entityTrueRadius, penetration)) {
+                if (success) {
+                    return true;
                 }
             }
+        } else {
+            // determine the worldToEntityMatrix that doesn't include scale because
+            // we're going to use the registration aware aa box in the entity frame
+            glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+            glm::mat4 translation = glm::translate(entity->getPosition());
+            glm::mat4 entityToWorldMatrix = translation * rotation;
+            glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+            glm::vec3 registrationPoint = entity->getRegistrationPoint();
+            glm::vec3 corner = -(dimensions * registrationPoint);
+
+            AABox entityFrameBox(corner, dimensions);
+
+            glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(searchPosition, 1.0f));
+            if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, searchRadius, penetration)) {
+                return true;
+            }
         }
-    });
+    }
+    return false;
 }
 
 void EntityTreeElement::getEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
@@ -886,6 +921,9 @@ bool EntityTreeElement::removeEntityWithEntityItemID(const EntityItemID& id) {
             }
         }
     });
+    if (foundEntity && _myTree) {
+        _myTree->removeEntityFromSpatialIndex(id);
+    }
     return foundEntity;
 }
 
@@ -897,6 +935,9 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity) {
     if (numEntries > 0) {
         assert(entity->_element.get() == this);
         entity->_element = NULL;
+        if (_myTree) {
+            _myTree->removeEntityFromSpatialIndex(entity->getEntityItemID());
+        }
         return true;
     }
     return false;
@@ -981,6 +1022,8 @@ int EntityTreeElement::readElementDataFromBuffer(const unsigned char* data, int
                             }
                         }
                     }
+                    // the entity may have moved or resized without changing elements
+                    _myTree->updateEntityInSpatialIndex(entityItem);
 
                     QString entityScriptAfter = entityItem->getScript();
                     QString entityServerScriptsAfter = entityItem->getServerScripts();
@@ -997,9 +1040,21 @@ int EntityTreeElement::readElementDataFromBuffer(const unsigned char* data, int
                     }
 
                 } else {
-                    entityItem = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                    // a new entity may have been decoded already, off the tree lock
+                    if (args.decodedBitstream) {
+                        entityItem = static_cast<EntityDecodedBitstream*>(args.decodedBitstream)->takeEntity(dataAt,
+                                                                                                         bytesForThisEntity);
+                        if (entityItem) {
+                            args.entitiesPerPacket++;
+                        }
+                    }
+                    if (!entityItem) {
+                        entityItem = EntityTypes::constructEntityItem(dataAt, bytesLeftToRead, args);
+                        if (entityItem) {
+                            bytesForThisEntity = entityItem->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
+                        }
+                    }
                     if (entityItem) {
-                        bytesForThisEntity = entityItem->readEntityDataFromBuffer(dataAt, bytesLeftToRead, args);
 
                         // don't add if we've recently deleted....
                         if (!_myTree->isDeletedEntity(entityItem->getID())) {
@@ -1036,6 +1091,9 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
         _entityItems.push_back(entity);
     });
     entity->_element = getThisPointer();
+    if (_myTree) {
+        _myTree->updateEntityInSpatialIndex(entity);
+    }
 }
 
 // will average a "common reduced LOD view" from the the child elements...
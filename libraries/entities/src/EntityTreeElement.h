@@ -86,6 +86,10 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
 public:
     virtual ~EntityTreeElement();
 
+    // elements are allocated next to each other, from their own FixedSizePool
+    static void* operator new(size_t size);
+    static void operator delete(void* pointer);
+
     // type safe versions of OctreeElement methods
     EntityTreeElementPointer getChildAtIndex(int index) const {
         return std::static_pointer_cast<EntityTreeElement>(OctreeElement::getChildAtIndex(index));
@@ -154,6 +158,12 @@ public:
                          BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                          const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
                          void** intersectedObject, bool precisionPicking, float distanceToElementCube);
+    /// the test findDetailedRayIntersection() does on each of the entities, returns true if the entity is hit closer than distance
+    static bool findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+                         bool& keepSearching, OctreeElementPointer& element, float& distance,
+                         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
+                         void** intersectedObject, bool precisionPicking);
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const override;
 
@@ -183,6 +193,8 @@ public:
     /// \param radius the radius of the query sphere
     /// \param entities[out] vector of const EntityItemPointer
     void getEntities(const glm::vec3& position, float radius, QVector<EntityItemPointer>& foundEntities) const;
+    /// the test getEntities() does on each of the entities for a sphere
+    static bool entityIntersectsSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
 
     /// finds all entities that touch a box
     /// \param box the query box
@@ -46,6 +46,7 @@ protected:
     virtual OctreePointer createTree() override {
         EntityTreePointer newTree = EntityTreePointer(new EntityTree(true));
         newTree->createRootElement();
+        newTree->setWantSpatialIndex(true); // the picks and finds of scripts are served from the index
         return newTree;
     }
 
@@ -13,11 +13,14 @@
 #define hifi_EntityTypes_h
 
 #include <stdint.h>
+#include <memory>
+#include <utility>
 
 #include <QHash>
 #include <QString>
 
 #include <OctreeRenderer.h> // for RenderArgs
+#include <shared/FixedSizePool.h>
 
 #include "EntitiesLogging.h"
 
@@ -60,6 +63,12 @@ public:
     static EntityItemPointer constructEntityItem(EntityType entityType, const EntityItemID& entityID, const EntityItemProperties& properties);
     static EntityItemPointer constructEntityItem(const unsigned char* data, int bytesToRead, ReadBitstreamToTreeParams& args);
 
+    /// for the factories: a new entity of type T, in one block with its shared pointer's count, from the pool of T
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> allocateEntityItem(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+
 private:
     static QMap<EntityType, QString> _typeToNameMap;
     static QMap<QString, EntityTypes::EntityType> _nameToTypeMap;
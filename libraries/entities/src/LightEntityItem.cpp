@@ -30,7 +30,7 @@ const float LightEntityItem::DEFAULT_CUTOFF = PI / 2.0f;
 bool LightEntityItem::_lightsArePickable = false;
 
 EntityItemPointer LightEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity { new LightEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<LightEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
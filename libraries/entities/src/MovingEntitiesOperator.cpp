@@ -73,6 +73,9 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
         return; // bail without adding.
     }
 
+    // the entity is re-indexed here even when it stays in its element, if it changes elements it's re-added as well
+    _tree->updateEntityInSpatialIndex(entity);
+
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
     if (!oldContainingElement->bestFitBounds(newCubeClamped)) {
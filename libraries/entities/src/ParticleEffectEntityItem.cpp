@@ -92,10 +92,11 @@ const float ParticleEffectEntityItem::DEFAULT_RADIUS_START = DEFAULT_PARTICLE_RA
 const float ParticleEffectEntityItem::DEFAULT_RADIUS_FINISH = DEFAULT_PARTICLE_RADIUS;
 const QString ParticleEffectEntityItem::DEFAULT_TEXTURES = "";
 const bool ParticleEffectEntityItem::DEFAULT_EMITTER_SHOULD_TRAIL = false;
+const bool ParticleEffectEntityItem::DEFAULT_GPU_SIMULATION = true;
 
 
 EntityItemPointer ParticleEffectEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity { new ParticleEffectEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<ParticleEffectEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -332,6 +333,7 @@ EntityItemProperties ParticleEffectEntityItem::getProperties(EntityPropertyFlags
     COPY_ENTITY_PROPERTY_TO_PROPERTIES(alphaFinish, getAlphaFinish);
     COPY_ENTITY_PROPERTY_TO_PROPERTIES(textures, getTextures);
     COPY_ENTITY_PROPERTY_TO_PROPERTIES(emitterShouldTrail, getEmitterShouldTrail);
+    COPY_ENTITY_PROPERTY_TO_PROPERTIES(gpuSimulation, getGPUSimulation);
 
 
     return properties;
@@ -370,6 +372,7 @@ bool ParticleEffectEntityItem::setProperties(const EntityItemProperties& propert
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(alphaFinish, setAlphaFinish);
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(textures, setTextures);
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(emitterShouldTrail, setEmitterShouldTrail);
+    SET_ENTITY_PROPERTY_FROM_PROPERTIES(gpuSimulation, setGPUSimulation);
 
     if (somethingChanged) {
         bool wantDebug = false;
@@ -465,6 +468,10 @@ int ParticleEffectEntityItem::readEntitySubclassDataFromBuffer(const unsigned ch
         READ_ENTITY_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, bool, setEmitterShouldTrail);
     }
 
+    if (args.bitstreamVersion >= VERSION_ENTITIES_PARTICLES_GPU_SIMULATION) {
+        READ_ENTITY_PROPERTY(PROP_GPU_SIMULATION, bool, setGPUSimulation);
+    }
+
     return bytesRead;
 }
 
@@ -503,6 +510,7 @@ EntityPropertyFlags ParticleEffectEntityItem::getEntityProperties(EncodeBitstrea
     requestedProperties += PROP_AZIMUTH_START;
     requestedProperties += PROP_AZIMUTH_FINISH;
     requestedProperties += PROP_EMITTER_SHOULD_TRAIL;
+    requestedProperties += PROP_GPU_SIMULATION;
 
     return requestedProperties;
 }
@@ -546,6 +554,7 @@ void ParticleEffectEntityItem::appendSubclassData(OctreePacketData* packetData,
     APPEND_ENTITY_PROPERTY(PROP_AZIMUTH_START, getAzimuthStart());
     APPEND_ENTITY_PROPERTY(PROP_AZIMUTH_FINISH, getAzimuthFinish());
     APPEND_ENTITY_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, getEmitterShouldTrail());
+    APPEND_ENTITY_PROPERTY(PROP_GPU_SIMULATION, getGPUSimulation());
 }
 
 bool ParticleEffectEntityItem::isEmittingParticles() const {
@@ -219,6 +219,11 @@ public:
         _emitterShouldTrail = emitterShouldTrail;
     }
 
+    // Simulated by the renderer on the GPU rather than in update, when it supports it
+    static const bool DEFAULT_GPU_SIMULATION;
+    bool getGPUSimulation() const { return _gpuSimulation; }
+    void setGPUSimulation(bool gpuSimulation) { _gpuSimulation = gpuSimulation; }
+
     virtual bool supportsDetailedRayIntersection() const override { return false; }
 
 protected:
@@ -287,6 +292,7 @@ protected:
 
     
     bool _emitterShouldTrail { DEFAULT_EMITTER_SHOULD_TRAIL };
+    bool _gpuSimulation { DEFAULT_GPU_SIMULATION };
 };
 
 #endif // hifi_ParticleEffectEntityItem_h
@@ -26,7 +26,7 @@ const int PolyLineEntityItem::MAX_POINTS_PER_LINE = 70;
 
 
 EntityItemPointer PolyLineEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity{ new PolyLineEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<PolyLineEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
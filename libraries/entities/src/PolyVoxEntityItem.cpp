@@ -32,7 +32,7 @@ const QString PolyVoxEntityItem::DEFAULT_Y_TEXTURE_URL = QString("");
 const QString PolyVoxEntityItem::DEFAULT_Z_TEXTURE_URL = QString("");
 
 EntityItemPointer PolyVoxEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    EntityItemPointer entity { new PolyVoxEntityItem(entityID) };
+    EntityItemPointer entity = EntityTypes::allocateEntityItem<PolyVoxEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
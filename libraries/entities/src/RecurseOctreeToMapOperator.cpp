@@ -11,18 +11,12 @@
 
 #include "RecurseOctreeToMapOperator.h"
 
-#include "EntityItemProperties.h"
-
-RecurseOctreeToMapOperator::RecurseOctreeToMapOperator(QVariantMap& map,
+RecurseOctreeToMapOperator::RecurseOctreeToMapOperator(QVector<EntityItemPointer>& entities,
                                                        OctreeElementPointer top,
-                                                       QScriptEngine* engine,
-                                                       bool skipDefaultValues,
                                                        bool skipThoseWithBadParents) :
         RecurseOctreeOperator(),
-        _map(map),
+        _entities(entities),
         _top(top),
-        _engine(engine),
-        _skipDefaultValues(skipDefaultValues),
         _skipThoseWithBadParents(skipThoseWithBadParents)
 {
     // if some element "top" was given, only save information for that element and its children.
@@ -42,28 +36,15 @@ bool RecurseOctreeToMapOperator::preRecursion(OctreeElementPointer element) {
 }
 
 bool RecurseOctreeToMapOperator::postRecursion(OctreeElementPointer element) {
-
-    EntityItemProperties defaultProperties;
-
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-    QVariantList entitiesQList = qvariant_cast<QVariantList>(_map["Entities"]);
 
     entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
         if (_skipThoseWithBadParents && !entityItem->isParentIDValid()) {
             return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
         }
-
-        EntityItemProperties properties = entityItem->getProperties();
-        QScriptValue qScriptValues;
-        if (_skipDefaultValues) {
-            qScriptValues = EntityItemNonDefaultPropertiesToScriptValue(_engine, properties);
-        } else {
-            qScriptValues = EntityItemPropertiesToScriptValue(_engine, properties);
-        }
-        entitiesQList << qScriptValues.toVariant();
+        _entities << entityItem;
     });
 
-    _map["Entities"] = entitiesQList;
     if (element == _top) {
         _withinTop = false;
     }
@@ -11,17 +11,15 @@
 
 #include "EntityTree.h"
 
+// Collects the entities to save, the caller converts them so that it can do that without holding the tree's lock
 class RecurseOctreeToMapOperator : public RecurseOctreeOperator {
 public:
-    RecurseOctreeToMapOperator(QVariantMap& map, OctreeElementPointer top, QScriptEngine* engine, bool skipDefaultValues,
-                               bool skipThoseWithBadParents);
+    RecurseOctreeToMapOperator(QVector<EntityItemPointer>& entities, OctreeElementPointer top, bool skipThoseWithBadParents);
     bool preRecursion(OctreeElementPointer element) override;
     bool postRecursion(OctreeElementPointer element) override;
  private:
-    QVariantMap& _map;
+    QVector<EntityItemPointer>& _entities;
     OctreeElementPointer _top;
-    QScriptEngine* _engine;
     bool _withinTop;
-    bool _skipDefaultValues;
     bool _skipThoseWithBadParents;
 };
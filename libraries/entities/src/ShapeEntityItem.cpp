@@ -52,7 +52,7 @@ namespace entity {
 }
 
 ShapeEntityItem::Pointer ShapeEntityItem::baseFactory(const EntityItemID& entityID, const EntityItemProperties& properties) {
-    Pointer entity { new ShapeEntityItem(entityID) };
+    Pointer entity = EntityTypes::allocateEntityItem<ShapeEntityItem>(entityID);
     entity->setProperties(properties);
     return entity;
 }
@@ -10,6 +10,7 @@
 //
 
 #include <iostream>
+#include <list>
 #include <QBuffer>
 #include <QDataStream>
 #include <QIODevice>
@@ -30,6 +31,7 @@
 #include <OctalCode.h>
 #include <gpu/Format.h>
 #include <LogHandler.h>
+#include <shared/WorkGroup.h>
 
 #include "FBXReader.h"
 #include "ModelFormatLogging.h"
@@ -587,10 +589,23 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                 }
             }
         } else if (child.name == "Objects") {
+            // the geometry meshes are extracted on other threads while the rest of the objects are read
+            WorkGroup geometryGroup;
+            std::list<ExtractedMesh> extractedGeometries;
+            QVector<QString> extractedGeometryIDs;
+
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex));
+                        extractedGeometries.emplace_back();
+                        extractedGeometryIDs.append(getID(object.properties));
+                        ExtractedMesh* extracted = &extractedGeometries.back();
+                        const FBXNode* geometryObject = &object;
+                        unsigned int geometryMeshIndex = meshIndex++;
+                        geometryGroup.run([this, extracted, geometryObject, geometryMeshIndex] {
+                            unsigned int index = geometryMeshIndex;
+                            *extracted = extractMesh(*geometryObject, index);
+                        });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1174,6 +1189,12 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
                 }
 #endif
             }
+
+            geometryGroup.wait();
+            auto extracted = extractedGeometries.begin();
+            for (const auto& geometryID : extractedGeometryIDs) {
+                meshes.insert(geometryID, *extracted++);
+            }
         } else if (child.name == "Connections") {
             static const QVariant OO = QByteArray("OO");
             static const QVariant OP = QByteArray("OP");
@@ -1504,6 +1525,7 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(_fbxMaterials, _textureFilenames, _connectionChildMap);
 
+    QVector<FBXMesh*> builtMeshes;
     for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
         ExtractedMesh& extracted = it.value();
 
@@ -1738,8 +1760,6 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
         }
         extracted.mesh.isEye = (maxJointIndex == geometry.leftEyeJointIndex || maxJointIndex == geometry.rightEyeJointIndex);
 
-        buildModelMesh(extracted.mesh, url);
-
         if (extracted.mesh.isEye) {
             if (maxJointIndex == geometry.leftEyeJointIndex) {
                 geometry.leftEyeSize = extracted.mesh.meshExtents.largestDimension() * offsetScale;
@@ -1748,11 +1768,20 @@ FBXGeometry* FBXReader::extractFBXGeometry(const QVariantHash& mapping, const QS
             }
         }
 
-        geometry.meshes.append(extracted.mesh);
-        int meshIndex = geometry.meshes.size() - 1;
+        builtMeshes.append(&extracted.mesh);
+        int meshIndex = builtMeshes.size() - 1;
         meshIDsToMeshIndices.insert(it.key(), meshIndex);
     }
 
+    // the levels of detail and the buffers of each mesh are built on threads of their own
+    WorkGroup::forEach(builtMeshes.size(), [&](int i) {
+        buildMeshLODs(*builtMeshes[i]);
+        buildModelMesh(*builtMeshes[i], url);
+    });
+    for (auto mesh : builtMeshes) {
+        geometry.meshes.append(*mesh);
+    }
+
     const float INV_SQRT_3 = 0.57735026918f;
     ShapeVertices cardinalDirections = {
         Vectors::UNIT_X,
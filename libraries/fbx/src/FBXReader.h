@@ -133,6 +133,9 @@ public:
     QVector<int> quadTrianglesIndices; // original indices from the FBX mesh of the quad converted as triangles
     QVector<int> triangleIndices; // original indices from the FBX mesh
 
+    // the triangles of the simplified levels of detail, from the finest, quads included
+    QVector<QVector<int>> lodTriangleIndices;
+
     QString materialID;
 };
 
@@ -410,6 +413,9 @@ public:
     QHash<QString, ExtractedMesh> meshes;
     static void buildModelMesh(FBXMesh& extractedMesh, const QString& url);
 
+    // Simplifies the triangles of the parts of the mesh into their levels of detail, keeping the vertices
+    static void buildMeshLODs(FBXMesh& extractedMesh);
+
     FBXTexture getTexture(const QString& textureID);
 
     QHash<QString, QString> _textureNames;
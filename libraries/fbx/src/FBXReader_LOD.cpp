@@ -0,0 +1,350 @@
+//
+//  FBXReader_LOD.cpp
+//  libraries/fbx/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "FBXReader.h"
+
+// The meshes with fewer triangles are drawn as they are at any distance
+static const int MIN_LOD_TRIANGLES = 512;
+static const int MAX_NUM_LODS = 3;
+
+// Each level keeps about this fraction of the triangles of the previous one
+static const float LOD_TRIANGLE_RATIO = 0.5f;
+
+// A level is kept only if it has at most this fraction of the triangles of the previous one
+static const float MIN_LOD_REDUCTION = 0.75f;
+
+// The largest distance the surface may move, as a fraction of the largest dimension of the mesh
+static const float MAX_LOD_ERROR = 0.02f;
+
+// A collapse is refused when it turns the normal of a triangle by more than about 75 degrees
+static const float MIN_LOD_NORMAL_DOT = 0.25f;
+
+namespace {
+
+// The sum of the squared distances to a set of planes
+class Quadric {
+public:
+    void addPlane(const glm::dvec3& normal, double distance) {
+        _xx += normal.x * normal.x; _xy += normal.x * normal.y; _xz += normal.x * normal.z; _xw += normal.x * distance;
+        _yy += normal.y * normal.y; _yz += normal.y * normal.z; _yw += normal.y * distance;
+        _zz += normal.z * normal.z; _zw += normal.z * distance;
+        _ww += distance * distance;
+    }
+
+    void add(const Quadric& other) {
+        _xx += other._xx; _xy += other._xy; _xz += other._xz; _xw += other._xw;
+        _yy += other._yy; _yz += other._yz; _yw += other._yw;
+        _zz += other._zz; _zw += other._zw;
+        _ww += other._ww;
+    }
+
+    double evaluate(const glm::dvec3& p) const {
+        return p.x * (_xx * p.x + 2.0 * (_xy * p.y + _xz * p.z + _xw)) +
+            p.y * (_yy * p.y + 2.0 * (_yz * p.z + _yw)) +
+            p.z * (_zz * p.z + 2.0 * _zw) + _ww;
+    }
+
+private:
+    double _xx { 0.0 }, _xy { 0.0 }, _xz { 0.0 }, _xw { 0.0 };
+    double _yy { 0.0 }, _yz { 0.0 }, _yw { 0.0 };
+    double _zz { 0.0 }, _zw { 0.0 };
+    double _ww { 0.0 };
+};
+
+// Moves the vertex from onto the vertex to, valid while neither changed since the collapse was queued
+class Collapse {
+public:
+    double cost;
+    int from;
+    int to;
+    int fromVersion;
+    int toVersion;
+
+    bool operator<(const Collapse& other) const { return cost > other.cost; }
+};
+
+class MeshSimplifier {
+public:
+    MeshSimplifier(const FBXMesh& mesh);
+
+    int getNumTriangles() const { return _numTriangles; }
+
+    // Collapses edges until there are at most targetTriangles left or the next collapse moves the surface too far
+    void simplify(int targetTriangles);
+
+    void extractParts(QVector<QVector<int>>& partIndices) const;
+
+private:
+    glm::dvec3 evalNormal(int a, int b, int c) const;
+    void addCollapse(int from, int to);
+    bool canCollapse(int from, int to) const;
+    void collapse(int from, int to);
+
+    std::vector<glm::dvec3> _positions;
+    std::vector<int> _indices;
+    std::vector<int> _triangleParts;
+    std::vector<bool> _removedTriangles;
+    std::vector<std::vector<int>> _vertexTriangles;
+    std::vector<Quadric> _quadrics;
+    std::vector<bool> _lockedVertices;
+    std::vector<bool> _collapsedVertices;
+    std::vector<int> _versions;
+    std::priority_queue<Collapse> _collapses;
+    int _numParts { 0 };
+    int _numTriangles { 0 };
+    double _maxCost { 0.0 };
+};
+
+MeshSimplifier::MeshSimplifier(const FBXMesh& mesh) :
+    _numParts(mesh.parts.size()) {
+
+    const int numVertices = mesh.vertices.size();
+    _positions.reserve(numVertices);
+    Extents extents;
+    for (const glm::vec3& vertex : mesh.vertices) {
+        _positions.push_back(glm::dvec3(vertex));
+        extents.addPoint(vertex);
+    }
+    double maxError = MAX_LOD_ERROR * extents.largestDimension();
+    _maxCost = maxError * maxError;
+
+    for (int partIndex = 0; partIndex < mesh.parts.size(); partIndex++) {
+        const FBXMeshPart& part = mesh.parts.at(partIndex);
+        for (const QVector<int>* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            for (int i = 0; i + 2 < indices->size(); i += 3) {
+                int a = indices->at(i);
+                int b = indices->at(i + 1);
+                int c = indices->at(i + 2);
+                if (a < 0 || b < 0 || c < 0 || a >= numVertices || b >= numVertices || c >= numVertices) {
+                    continue;
+                }
+                _indices.push_back(a);
+                _indices.push_back(b);
+                _indices.push_back(c);
+                _triangleParts.push_back(partIndex);
+            }
+        }
+    }
+    _numTriangles = (int)_triangleParts.size();
+    _removedTriangles.resize(_numTriangles, false);
+    _vertexTriangles.resize(numVertices);
+    _quadrics.resize(numVertices);
+    _lockedVertices.resize(numVertices, false);
+    _collapsedVertices.resize(numVertices, false);
+    _versions.resize(numVertices, 0);
+
+    for (int triangle = 0; triangle < _numTriangles; triangle++) {
+        const int* corners = &_indices[3 * triangle];
+        glm::dvec3 normal = evalNormal(corners[0], corners[1], corners[2]);
+        double length = glm::length(normal);
+        if (length > 0.0) {
+            normal /= length;
+        }
+        double distance = -glm::dot(normal, _positions[corners[0]]);
+        for (int corner = 0; corner < 3; corner++) {
+            _vertexTriangles[corners[corner]].push_back(triangle);
+            _quadrics[corners[corner]].addPlane(normal, distance);
+        }
+    }
+
+    // The vertices on the open edges, between the parts and on the seams of the attributes stay where they are, for
+    // the levels to have neither holes nor stretched texture coordinates
+    std::unordered_map<uint64_t, int> edgeTriangles;
+    for (int triangle = 0; triangle < _numTriangles; triangle++) {
+        for (int corner = 0; corner < 3; corner++) {
+            uint64_t a = (uint64_t)_indices[3 * triangle + corner];
+            uint64_t b = (uint64_t)_indices[3 * triangle + (corner + 1) % 3];
+            edgeTriangles[(std::min(a, b) << 32) | std::max(a, b)]++;
+        }
+    }
+    for (const auto& edge : edgeTriangles) {
+        if (edge.second != 2) {
+            _lockedVertices[(int)(edge.first >> 32)] = true;
+            _lockedVertices[(int)(edge.first & 0xFFFFFFFF)] = true;
+        }
+    }
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        const auto& triangles = _vertexTriangles[vertex];
+        for (int triangle : triangles) {
+            if (_triangleParts[triangle] != _triangleParts[triangles.front()]) {
+                _lockedVertices[vertex] = true;
+                break;
+            }
+        }
+    }
+    std::vector<int> sortedVertices(numVertices);
+    for (int vertex = 0; vertex < numVertices; vertex++) {
+        sortedVertices[vertex] = vertex;
+    }
+    auto positionLess = [&](int a, int b) {
+        const glm::dvec3& pa = _positions[a];
+        const glm::dvec3& pb = _positions[b];
+        return pa.x < pb.x || (pa.x == pb.x && (pa.y < pb.y || (pa.y == pb.y && pa.z < pb.z)));
+    };
+    std::sort(sortedVertices.begin(), sortedVertices.end(), positionLess);
+    for (int i = 1; i < numVertices; i++) {
+        if (_positions[sortedVertices[i]] == _positions[sortedVertices[i - 1]]) {
+            _lockedVertices[sortedVertices[i]] = true;
+            _lockedVertices[sortedVertices[i - 1]] = true;
+        }
+    }
+
+    for (int triangle = 0; triangle < _numTriangles; triangle++) {
+        for (int corner = 0; corner < 3; corner++) {
+            int a = _indices[3 * triangle + corner];
+            int b = _indices[3 * triangle + (corner + 1) % 3];
+            addCollapse(a, b);
+            addCollapse(b, a);
+        }
+    }
+}
+
+glm::dvec3 MeshSimplifier::evalNormal(int a, int b, int c) const {
+    return glm::cross(_positions[b] - _positions[a], _positions[c] - _positions[a]);
+}
+
+void MeshSimplifier::addCollapse(int from, int to) {
+    if (_lockedVertices[from]) {
+        return;
+    }
+    Quadric quadric = _quadrics[from];
+    quadric.add(_quadrics[to]);
+    double cost = std::max(quadric.evaluate(_positions[to]), 0.0);
+    if (cost <= _maxCost) {
+        _collapses.push({ cost, from, to, _versions[from], _versions[to] });
+    }
+}
+
+bool MeshSimplifier::canCollapse(int from, int to) const {
+    for (int triangle : _vertexTriangles[from]) {
+        if (_removedTriangles[triangle]) {
+            continue;
+        }
+        int corners[3] = { _indices[3 * triangle], _indices[3 * triangle + 1], _indices[3 * triangle + 2] };
+        if (corners[0] == to || corners[1] == to || corners[2] == to) {
+            continue; // removed by the collapse
+        }
+        glm::dvec3 oldNormal = evalNormal(corners[0], corners[1], corners[2]);
+        for (int& corner : corners) {
+            if (corner == from) {
+                corner = to;
+            }
+        }
+        glm::dvec3 newNormal = evalNormal(corners[0], corners[1], corners[2]);
+        double lengths = glm::length(oldNormal) * glm::length(newNormal);
+        if (lengths <= 0.0 || glm::dot(oldNormal, newNormal) < MIN_LOD_NORMAL_DOT * lengths) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshSimplifier::collapse(int from, int to) {
+    for (int triangle : _vertexTriangles[from]) {
+        if (_removedTriangles[triangle]) {
+            continue;
+        }
+        int* corners = &_indices[3 * triangle];
+        if (corners[0] == to || corners[1] == to || corners[2] == to) {
+            _removedTriangles[triangle] = true;
+            _numTriangles--;
+            continue;
+        }
+        for (int corner = 0; corner < 3; corner++) {
+            if (corners[corner] == from) {
+                corners[corner] = to;
+            }
+        }
+        _vertexTriangles[to].push_back(triangle);
+    }
+    _vertexTriangles[from].clear();
+    _quadrics[to].add(_quadrics[from]);
+    _collapsedVertices[from] = true;
+    _versions[from]++;
+    _versions[to]++;
+
+    // the costs of the edges around the vertex changed with its quadric
+    auto& triangles = _vertexTriangles[to];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [&](int triangle) {
+        return _removedTriangles[triangle];
+    }), triangles.end());
+    for (int triangle : triangles) {
+        for (int corner = 0; corner < 3; corner++) {
+            int neighbor = _indices[3 * triangle + corner];
+            if (neighbor != to) {
+                addCollapse(neighbor, to);
+                addCollapse(to, neighbor);
+            }
+        }
+    }
+}
+
+void MeshSimplifier::simplify(int targetTriangles) {
+    while (_numTriangles > targetTriangles && !_collapses.empty()) {
+        Collapse next = _collapses.top();
+        _collapses.pop();
+        if (_collapsedVertices[next.from] || _collapsedVertices[next.to] ||
+                _versions[next.from] != next.fromVersion || _versions[next.to] != next.toVersion) {
+            continue; // stale
+        }
+        if (canCollapse(next.from, next.to)) {
+            collapse(next.from, next.to);
+        }
+    }
+}
+
+void MeshSimplifier::extractParts(QVector<QVector<int>>& partIndices) const {
+    partIndices.resize(_numParts);
+    for (int triangle = 0; triangle < (int)_triangleParts.size(); triangle++) {
+        if (!_removedTriangles[triangle]) {
+            QVector<int>& indices = partIndices[_triangleParts[triangle]];
+            indices.append(_indices[3 * triangle]);
+            indices.append(_indices[3 * triangle + 1]);
+            indices.append(_indices[3 * triangle + 2]);
+        }
+    }
+}
+
+}
+
+void FBXReader::buildMeshLODs(FBXMesh& extractedMesh) {
+    for (FBXMeshPart& part : extractedMesh.parts) {
+        part.lodTriangleIndices.clear();
+    }
+
+    MeshSimplifier simplifier(extractedMesh);
+    int numTriangles = simplifier.getNumTriangles();
+    if (numTriangles < MIN_LOD_TRIANGLES) {
+        return;
+    }
+
+    // each level goes on from the previous one, so that the coarser levels are subsets of the collapses of the finer
+    for (int lod = 0; lod < MAX_NUM_LODS; lod++) {
+        simplifier.simplify((int)(numTriangles * LOD_TRIANGLE_RATIO));
+        int lodTriangles = simplifier.getNumTriangles();
+        if (lodTriangles > numTriangles * MIN_LOD_REDUCTION) {
+            break;
+        }
+
+        QVector<QVector<int>> partIndices;
+        simplifier.extractParts(partIndices);
+        for (int partIndex = 0; partIndex < extractedMesh.parts.size(); partIndex++) {
+            extractedMesh.parts[partIndex].lodTriangleIndices.append(partIndices.at(partIndex));
+        }
+        numTriangles = lodTriangles;
+    }
+}
@@ -24,6 +24,7 @@
 
 #include "FBXReader.h"
 
+#include <algorithm>
 #include <memory>
 
 
@@ -488,8 +489,13 @@ void FBXReader::buildModelMesh(FBXMesh& extractedMesh, const QString& url) {
 
 
     unsigned int totalIndices = 0;
+    int numLODs = 0;
     foreach(const FBXMeshPart& part, extractedMesh.parts) {
         totalIndices += (part.quadTrianglesIndices.size() + part.triangleIndices.size());
+        foreach(const QVector<int>& lodIndices, part.lodTriangleIndices) {
+            totalIndices += lodIndices.size();
+        }
+        numLODs = std::max(numLODs, part.lodTriangleIndices.size());
     }
 
     if (! totalIndices) {
@@ -531,6 +537,22 @@ void FBXReader::buildModelMesh(FBXMesh& extractedMesh, const QString& url) {
         parts.push_back(modelPart);
     }
 
+    // the levels of detail after all the parts, the parts of a level together
+    std::vector< model::Mesh::Part > lodParts;
+    for (int lod = 0; lod < numLODs; lod++) {
+        foreach(const FBXMeshPart& part, extractedMesh.parts) {
+            model::Mesh::Part modelPart(indexNum, 0, 0, model::Mesh::TRIANGLES);
+            if (lod < part.lodTriangleIndices.size() && part.lodTriangleIndices.at(lod).size()) {
+                const QVector<int>& lodIndices = part.lodTriangleIndices.at(lod);
+                indexBuffer->setSubData(offset, lodIndices.size() * sizeof(int), (gpu::Byte*) lodIndices.constData());
+                offset += lodIndices.size() * sizeof(int);
+                indexNum += lodIndices.size();
+                modelPart._numIndices += lodIndices.size();
+            }
+            lodParts.push_back(modelPart);
+        }
+    }
+
     gpu::BufferView indexBufferView(indexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
     mesh->setIndexBuffer(indexBufferView);
 
@@ -539,6 +561,12 @@ void FBXReader::buildModelMesh(FBXMesh& extractedMesh, const QString& url) {
         pb->setData(parts.size() * sizeof(model::Mesh::Part), (const gpu::Byte*) parts.data());
         gpu::BufferView pbv(pb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW));
         mesh->setPartBuffer(pbv);
+
+        if (lodParts.size()) {
+            auto lodpb = std::make_shared<gpu::Buffer>();
+            lodpb->setData(lodParts.size() * sizeof(model::Mesh::Part), (const gpu::Byte*) lodParts.data());
+            mesh->setLODPartBuffer(gpu::BufferView(lodpb, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW)));
+        }
     } else {
         qCDebug(modelformat) << "buildModelMesh failed -- no parts, url = " << url;
         return;
@@ -11,6 +11,7 @@
 
 #include "FBXReader.h"
 
+#include <atomic>
 #include <iostream>
 #include <QtCore/QBuffer>
 #include <QtCore/QDataStream>
@@ -21,7 +22,9 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <Gzip.h>
 #include <shared/NsightHelpers.h>
+#include <shared/WorkGroup.h>
 #include "ModelFormatLogging.h"
 
 template<class T> int streamSize() {
@@ -32,7 +35,16 @@ template<bool> int streamSize() {
     return 1;
 }
 
-template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
+// Inflates the large compressed arrays on other threads while the rest of the file is parsed.
+struct ArrayInflater {
+    std::atomic<bool> corrupt { false };
+    WorkGroup group;
+};
+
+// smaller arrays are not worth a task
+const int MIN_PARALLEL_INFLATE_SIZE = 64 * 1024;
+
+template<class T> QVariant readBinaryArray(QDataStream& in, int& position, ArrayInflater* inflater) {
     quint32 arrayLength;
     quint32 encoding;
     quint32 compressedLength;
@@ -44,28 +56,31 @@ template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
 
     QVector<T> values;
     if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
+        // the data goes straight into the array
         values.resize(arrayLength);
+        int arraySize = (int)(sizeof(T) * arrayLength);
+        char* arrayData = (char*)values.data();
         const unsigned int DEFLATE_ENCODING = 1;
-        QByteArray arrayData;
         if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            QByteArray compressed(compressedLength, Qt::Uninitialized);
+            in.readRawData(compressed.data(), compressedLength);
             position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+            if (arraySize == 0) {
+                // nothing to inflate
+            } else if (inflater && arraySize >= MIN_PARALLEL_INFLATE_SIZE) {
+                // The task holds a copy of the array, which shares its data with the copies in the node tree, and fills
+                // it in place. No one reads the tree before the tasks are done.
+                inflater->group.run([inflater, values, arrayData, arraySize, compressed] {
+                    if (!zlibInflate(compressed.constData(), compressed.size(), arrayData, arraySize)) {
+                        inflater->corrupt = true;
+                    }
+                });
+            } else if (!zlibInflate(compressed.constData(), compressed.size(), arrayData, arraySize)) {
                 throw QString("corrupt fbx file");
             }
         } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
-
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+            position += arraySize;
+            in.readRawData(arrayData, arraySize);
         }
     } else {
         values.reserve(arrayLength);
@@ -100,7 +115,7 @@ template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
+QVariant parseBinaryFBXProperty(QDataStream& in, int& position, ArrayInflater* inflater) {
     char ch;
     in.device()->getChar(&ch);
     position++;
@@ -142,19 +157,19 @@ QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
             return QVariant::fromValue(value);
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(in, position, inflater);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(in, position, inflater);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(in, position, inflater);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(in, position, inflater);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(in, position, inflater);
         }
         case 'S':
         case 'R': {
@@ -168,7 +183,7 @@ QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions, ArrayInflater* inflater) {
     qint64 endOffset;
     quint64 propertyCount;
     quint64 propertyListLength;
@@ -208,11 +223,11 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     position += nameLength;
 
     for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+        node.properties.append(parseBinaryFBXProperty(in, position, inflater));
     }
 
     while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions, inflater);
         if (child.name.isNull()) {
             return node;
 
@@ -388,17 +403,22 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
     bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
 
     // parse the top-level node
+    ArrayInflater inflater;
     FBXNode top;
     while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions, &inflater);
         if (next.name.isNull()) {
-            return top;
+            break;
 
         } else {
             top.children.append(next);
         }
     }
 
+    inflater.group.wait();
+    if (inflater.corrupt) {
+        throw QString("corrupt fbx file");
+    }
     return top;
 }
 
@@ -0,0 +1,585 @@
+//
+//  FBXSerializer.cpp
+//  libraries/fbx/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXSerializer.h"
+
+#include <cstring>
+#include <memory>
+
+#include "ModelFormatLogging.h"
+
+// bump the version whenever the layout below or the geometry produced by the readers changes, the geometries of the
+// other versions are read from their models again
+static const uint32_t GEOMETRY_MAGIC = 0x43474648; // "HFGC"
+static const uint32_t GEOMETRY_VERSION = 2;
+
+// the arrays start at this alignment in the data, for them to be aligned in a mapped file
+static const size_t ARRAY_ALIGNMENT = 16;
+
+namespace {
+
+class Writer {
+public:
+    template <typename T> void write(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(bool value) { write((uint8_t)value); }
+
+    void write(const QByteArray& value) {
+        write((uint32_t)value.size());
+        _data.append(value);
+    }
+
+    void write(const QString& value) { write(value.toUtf8()); }
+
+    void write(const Extents& extents) {
+        write(extents.minimum);
+        write(extents.maximum);
+    }
+
+    void write(const Transform& transform) {
+        write(transform.getTranslation());
+        write(transform.getRotation());
+        write(transform.getScale());
+    }
+
+    template <typename T> void writeArray(const QVector<T>& values) {
+        write((uint32_t)values.size());
+        _data.append(QByteArray((int)((ARRAY_ALIGNMENT - _data.size() % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT), 0));
+        _data.append(reinterpret_cast<const char*>(values.constData()), values.size() * (int)sizeof(T));
+    }
+
+    const QByteArray& getData() const { return _data; }
+
+private:
+    QByteArray _data;
+};
+
+// every read past the end of the data fails the reader, and reads zeros from then on
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    bool hasFailed() const { return _failed; }
+
+    template <typename T> void read(T& value) {
+        if (check(sizeof(T))) {
+            memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+        } else {
+            value = T();
+        }
+    }
+
+    void read(bool& value) {
+        uint8_t byte;
+        read(byte);
+        value = byte != 0;
+    }
+
+    void read(QByteArray& value) {
+        uint32_t size;
+        read(size);
+        if (check(size)) {
+            value = QByteArray(reinterpret_cast<const char*>(_data + _offset), (int)size);
+            _offset += size;
+        } else {
+            value = QByteArray();
+        }
+    }
+
+    void read(QString& value) {
+        QByteArray utf8;
+        read(utf8);
+        value = QString::fromUtf8(utf8);
+    }
+
+    void read(Extents& extents) {
+        read(extents.minimum);
+        read(extents.maximum);
+    }
+
+    void read(Transform& transform) {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+        read(translation);
+        read(rotation);
+        read(scale);
+        transform = Transform();
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+    }
+
+    template <typename T> void readArray(QVector<T>& values) {
+        uint32_t size;
+        read(size);
+        size_t padding = (ARRAY_ALIGNMENT - _offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT;
+        if (check(padding + (size_t)size * sizeof(T))) {
+            _offset += padding;
+            values.resize(size);
+            memcpy(values.data(), _data + _offset, size * sizeof(T));
+            _offset += size * sizeof(T);
+        } else {
+            values.clear();
+        }
+    }
+
+    // the number of elements of a list, that must fit in what is left of the data
+    int readCount() {
+        uint32_t count;
+        read(count);
+        if (!check(count)) {
+            return 0;
+        }
+        return (int)count;
+    }
+
+private:
+    bool check(size_t size) {
+        if (_failed || size > _size - _offset) {
+            _failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* _data;
+    size_t _size;
+    size_t _offset { 0 };
+    bool _failed { false };
+};
+
+}
+
+static void writeTexture(Writer& writer, const FBXTexture& texture) {
+    writer.write(texture.name);
+    writer.write(texture.filename);
+    writer.write(texture.content);
+    writer.write(texture.transform);
+    writer.write(texture.maxNumPixels);
+    writer.write(texture.texcoordSet);
+    writer.write(texture.texcoordSetName);
+    writer.write(texture.isBumpmap);
+}
+
+static void readTexture(Reader& reader, FBXTexture& texture) {
+    reader.read(texture.name);
+    reader.read(texture.filename);
+    reader.read(texture.content);
+    reader.read(texture.transform);
+    reader.read(texture.maxNumPixels);
+    reader.read(texture.texcoordSet);
+    reader.read(texture.texcoordSetName);
+    reader.read(texture.isBumpmap);
+}
+
+static void writeMaterial(Writer& writer, const FBXMaterial& material) {
+    writer.write(material.diffuseColor);
+    writer.write(material.diffuseFactor);
+    writer.write(material.specularColor);
+    writer.write(material.specularFactor);
+    writer.write(material.emissiveColor);
+    writer.write(material.emissiveFactor);
+    writer.write(material.shininess);
+    writer.write(material.opacity);
+    writer.write(material.metallic);
+    writer.write(material.roughness);
+    writer.write(material.emissiveIntensity);
+    writer.write(material.ambientFactor);
+    writer.write(material.materialID);
+    writer.write(material.name);
+    writer.write(material.shadingModel);
+
+    for (const FBXTexture* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+            &material.glossTexture, &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+            &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+            &material.lightmapTexture }) {
+        writeTexture(writer, *texture);
+    }
+    writer.write(material.lightmapParams);
+
+    writer.write(material.isPBSMaterial);
+    writer.write(material.useNormalMap);
+    writer.write(material.useAlbedoMap);
+    writer.write(material.useOpacityMap);
+    writer.write(material.useRoughnessMap);
+    writer.write(material.useSpecularMap);
+    writer.write(material.useMetallicMap);
+    writer.write(material.useEmissiveMap);
+    writer.write(material.useOcclusionMap);
+
+    // the values the readers gave the model material, its textures are set by the materials of the model cache
+    writer.write((bool)material._material);
+    if (material._material) {
+        const auto& modelMaterial = *material._material;
+        writer.write(modelMaterial.getEmissive(false));
+        writer.write(modelMaterial.getAlbedo(false));
+        writer.write(modelMaterial.getFresnel(false));
+        writer.write(modelMaterial.getRoughness());
+        writer.write(modelMaterial.getMetallic());
+        writer.write(modelMaterial.getScattering());
+        writer.write(modelMaterial.getOpacity());
+        writer.write(modelMaterial.isUnlit());
+    }
+}
+
+static void readMaterial(Reader& reader, FBXMaterial& material) {
+    reader.read(material.diffuseColor);
+    reader.read(material.diffuseFactor);
+    reader.read(material.specularColor);
+    reader.read(material.specularFactor);
+    reader.read(material.emissiveColor);
+    reader.read(material.emissiveFactor);
+    reader.read(material.shininess);
+    reader.read(material.opacity);
+    reader.read(material.metallic);
+    reader.read(material.roughness);
+    reader.read(material.emissiveIntensity);
+    reader.read(material.ambientFactor);
+    reader.read(material.materialID);
+    reader.read(material.name);
+    reader.read(material.shadingModel);
+
+    for (FBXTexture* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+            &material.glossTexture, &material.roughnessTexture, &material.specularTexture, &material.metallicTexture,
+            &material.emissiveTexture, &material.occlusionTexture, &material.scatteringTexture,
+            &material.lightmapTexture }) {
+        readTexture(reader, *texture);
+    }
+    reader.read(material.lightmapParams);
+
+    reader.read(material.isPBSMaterial);
+    reader.read(material.useNormalMap);
+    reader.read(material.useAlbedoMap);
+    reader.read(material.useOpacityMap);
+    reader.read(material.useRoughnessMap);
+    reader.read(material.useSpecularMap);
+    reader.read(material.useMetallicMap);
+    reader.read(material.useEmissiveMap);
+    reader.read(material.useOcclusionMap);
+
+    bool hasModelMaterial;
+    reader.read(hasModelMaterial);
+    if (hasModelMaterial) {
+        model::Material::Color emissive, albedo, fresnel;
+        float roughness, metallic, scattering, opacity;
+        bool unlit;
+        reader.read(emissive);
+        reader.read(albedo);
+        reader.read(fresnel);
+        reader.read(roughness);
+        reader.read(metallic);
+        reader.read(scattering);
+        reader.read(opacity);
+        reader.read(unlit);
+
+        material._material = std::make_shared<model::Material>();
+        material._material->setEmissive(emissive, false);
+        material._material->setAlbedo(albedo, false);
+        material._material->setFresnel(fresnel, false);
+        material._material->setRoughness(roughness);
+        material._material->setMetallic(metallic);
+        if (scattering > 0.0f) {
+            material._material->setScattering(scattering);
+        }
+        material._material->setOpacity(opacity);
+        material._material->setUnlit(unlit);
+    }
+}
+
+static void writeJoint(Writer& writer, const FBXJoint& joint) {
+    writer.writeArray(joint.shapeInfo.points);
+    writer.writeArray(joint.freeLineage);
+    writer.write(joint.isFree);
+    writer.write(joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.write(joint.name);
+    writer.write(joint.isSkeletonJoint);
+    writer.write(joint.bindTransformFoundInCluster);
+    writer.write(joint.hasGeometricOffset);
+    writer.write(joint.geometricTranslation);
+    writer.write(joint.geometricRotation);
+    writer.write(joint.geometricScaling);
+}
+
+static void readJoint(Reader& reader, FBXJoint& joint) {
+    reader.readArray(joint.shapeInfo.points);
+    reader.readArray(joint.freeLineage);
+    reader.read(joint.isFree);
+    reader.read(joint.parentIndex);
+    reader.read(joint.distanceToParent);
+    reader.read(joint.translation);
+    reader.read(joint.preTransform);
+    reader.read(joint.preRotation);
+    reader.read(joint.rotation);
+    reader.read(joint.postRotation);
+    reader.read(joint.postTransform);
+    reader.read(joint.transform);
+    reader.read(joint.rotationMin);
+    reader.read(joint.rotationMax);
+    reader.read(joint.inverseDefaultRotation);
+    reader.read(joint.inverseBindRotation);
+    reader.read(joint.bindTransform);
+    reader.read(joint.name);
+    reader.read(joint.isSkeletonJoint);
+    reader.read(joint.bindTransformFoundInCluster);
+    reader.read(joint.hasGeometricOffset);
+    reader.read(joint.geometricTranslation);
+    reader.read(joint.geometricRotation);
+    reader.read(joint.geometricScaling);
+}
+
+static void writeMesh(Writer& writer, const FBXMesh& mesh) {
+    writer.write((uint32_t)mesh.parts.size());
+    for (const FBXMeshPart& part : mesh.parts) {
+        writer.writeArray(part.quadIndices);
+        writer.writeArray(part.quadTrianglesIndices);
+        writer.writeArray(part.triangleIndices);
+        writer.write((uint32_t)part.lodTriangleIndices.size());
+        for (const QVector<int>& lodIndices : part.lodTriangleIndices) {
+            writer.writeArray(lodIndices);
+        }
+        writer.write(part.materialID);
+    }
+
+    writer.writeArray(mesh.vertices);
+    writer.writeArray(mesh.normals);
+    writer.writeArray(mesh.tangents);
+    writer.writeArray(mesh.colors);
+    writer.writeArray(mesh.texCoords);
+    writer.writeArray(mesh.texCoords1);
+    writer.writeArray(mesh.clusterIndices);
+    writer.writeArray(mesh.clusterWeights);
+
+    writer.write((uint32_t)mesh.clusters.size());
+    for (const FBXCluster& cluster : mesh.clusters) {
+        writer.write(cluster.jointIndex);
+        writer.write(cluster.inverseBindMatrix);
+    }
+
+    writer.write(mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+    writer.write(mesh.isEye);
+
+    writer.write((uint32_t)mesh.blendshapes.size());
+    for (const FBXBlendshape& blendshape : mesh.blendshapes) {
+        writer.writeArray(blendshape.indices);
+        writer.writeArray(blendshape.vertices);
+        writer.writeArray(blendshape.normals);
+    }
+
+    writer.write(mesh.meshIndex);
+}
+
+static void readMesh(Reader& reader, FBXMesh& mesh) {
+    mesh.parts.resize(reader.readCount());
+    for (FBXMeshPart& part : mesh.parts) {
+        reader.readArray(part.quadIndices);
+        reader.readArray(part.quadTrianglesIndices);
+        reader.readArray(part.triangleIndices);
+        part.lodTriangleIndices.resize(reader.readCount());
+        for (QVector<int>& lodIndices : part.lodTriangleIndices) {
+            reader.readArray(lodIndices);
+        }
+        reader.read(part.materialID);
+    }
+
+    reader.readArray(mesh.vertices);
+    reader.readArray(mesh.normals);
+    reader.readArray(mesh.tangents);
+    reader.readArray(mesh.colors);
+    reader.readArray(mesh.texCoords);
+    reader.readArray(mesh.texCoords1);
+    reader.readArray(mesh.clusterIndices);
+    reader.readArray(mesh.clusterWeights);
+
+    mesh.clusters.resize(reader.readCount());
+    for (FBXCluster& cluster : mesh.clusters) {
+        reader.read(cluster.jointIndex);
+        reader.read(cluster.inverseBindMatrix);
+    }
+
+    reader.read(mesh.meshExtents);
+    reader.read(mesh.modelTransform);
+    reader.read(mesh.isEye);
+
+    mesh.blendshapes.resize(reader.readCount());
+    for (FBXBlendshape& blendshape : mesh.blendshapes) {
+        reader.readArray(blendshape.indices);
+        reader.readArray(blendshape.vertices);
+        reader.readArray(blendshape.normals);
+    }
+
+    reader.read(mesh.meshIndex);
+}
+
+QByteArray serializeFBXGeometry(const FBXGeometry& geometry) {
+    Writer writer;
+    writer.write(GEOMETRY_MAGIC);
+    writer.write(GEOMETRY_VERSION);
+
+    writer.write(geometry.author);
+    writer.write(geometry.applicationName);
+
+    writer.write((uint32_t)geometry.joints.size());
+    for (const FBXJoint& joint : geometry.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.write((uint32_t)geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); ++it) {
+        writer.write(it.key());
+        writer.write(it.value());
+    }
+    writer.write(geometry.hasSkeletonJoints);
+
+    writer.write((uint32_t)geometry.meshes.size());
+    for (const FBXMesh& mesh : geometry.meshes) {
+        writeMesh(writer, mesh);
+    }
+
+    writer.write((uint32_t)geometry.materials.size());
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); ++it) {
+        writer.write(it.key());
+        writeMaterial(writer, it.value());
+    }
+
+    writer.write(geometry.offset);
+    for (int jointIndex : { geometry.leftEyeJointIndex, geometry.rightEyeJointIndex, geometry.neckJointIndex,
+            geometry.rootJointIndex, geometry.leanJointIndex, geometry.headJointIndex, geometry.leftHandJointIndex,
+            geometry.rightHandJointIndex, geometry.leftToeJointIndex, geometry.rightToeJointIndex }) {
+        writer.write(jointIndex);
+    }
+    writer.write(geometry.leftEyeSize);
+    writer.write(geometry.rightEyeSize);
+    writer.writeArray(geometry.humanIKJointIndices);
+    writer.write(geometry.palmDirection);
+    writer.write(geometry.neckPivot);
+    writer.write(geometry.bindExtents);
+    writer.write(geometry.meshExtents);
+
+    writer.write((uint32_t)geometry.animationFrames.size());
+    for (const FBXAnimationFrame& frame : geometry.animationFrames) {
+        writer.writeArray(frame.rotations);
+        writer.writeArray(frame.translations);
+    }
+
+    writer.write((uint32_t)geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); ++it) {
+        writer.write(it.key());
+        writer.write(it.value());
+    }
+
+    writer.write((uint32_t)geometry.blendshapeChannelNames.size());
+    for (const QString& name : geometry.blendshapeChannelNames) {
+        writer.write(name);
+    }
+
+    return writer.getData();
+}
+
+FBXGeometry* readSerializedFBXGeometry(const uint8_t* data, size_t size, const QString& url) {
+    Reader reader(data, size);
+    uint32_t magic, version;
+    reader.read(magic);
+    reader.read(version);
+    if (reader.hasFailed() || magic != GEOMETRY_MAGIC || version != GEOMETRY_VERSION) {
+        return nullptr;
+    }
+
+    std::unique_ptr<FBXGeometry> geometry { new FBXGeometry() };
+    geometry->originalURL = url;
+    reader.read(geometry->author);
+    reader.read(geometry->applicationName);
+
+    geometry->joints.resize(reader.readCount());
+    for (FBXJoint& joint : geometry->joints) {
+        readJoint(reader, joint);
+    }
+    for (int i = reader.readCount(); i > 0; --i) {
+        QString name;
+        int index;
+        reader.read(name);
+        reader.read(index);
+        geometry->jointIndices.insert(name, index);
+    }
+    reader.read(geometry->hasSkeletonJoints);
+
+    geometry->meshes.resize(reader.readCount());
+    for (FBXMesh& mesh : geometry->meshes) {
+        readMesh(reader, mesh);
+    }
+
+    for (int i = reader.readCount(); i > 0; --i) {
+        QString materialID;
+        reader.read(materialID);
+        readMaterial(reader, geometry->materials[materialID]);
+    }
+
+    reader.read(geometry->offset);
+    for (int* jointIndex : { &geometry->leftEyeJointIndex, &geometry->rightEyeJointIndex, &geometry->neckJointIndex,
+            &geometry->rootJointIndex, &geometry->leanJointIndex, &geometry->headJointIndex,
+            &geometry->leftHandJointIndex, &geometry->rightHandJointIndex, &geometry->leftToeJointIndex,
+            &geometry->rightToeJointIndex }) {
+        reader.read(*jointIndex);
+    }
+    reader.read(geometry->leftEyeSize);
+    reader.read(geometry->rightEyeSize);
+    reader.readArray(geometry->humanIKJointIndices);
+    reader.read(geometry->palmDirection);
+    reader.read(geometry->neckPivot);
+    reader.read(geometry->bindExtents);
+    reader.read(geometry->meshExtents);
+
+    geometry->animationFrames.resize(reader.readCount());
+    for (FBXAnimationFrame& frame : geometry->animationFrames) {
+        reader.readArray(frame.rotations);
+        reader.readArray(frame.translations);
+    }
+
+    for (int i = reader.readCount(); i > 0; --i) {
+        int meshIndex;
+        QString name;
+        reader.read(meshIndex);
+        reader.read(name);
+        geometry->meshIndicesToModelNames.insert(meshIndex, name);
+    }
+
+    for (int i = reader.readCount(); i > 0; --i) {
+        QString name;
+        reader.read(name);
+        geometry->blendshapeChannelNames.push_back(name);
+    }
+
+    if (reader.hasFailed()) {
+        qCWarning(modelformat) << "Truncated serialized geometry for" << url;
+        return nullptr;
+    }
+
+    for (FBXMesh& mesh : geometry->meshes) {
+        FBXReader::buildModelMesh(mesh, url);
+    }
+    return geometry.release();
+}
@@ -0,0 +1,29 @@
+//
+//  FBXSerializer.h
+//  libraries/fbx/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXSerializer_h
+#define hifi_FBXSerializer_h
+
+#include <QByteArray>
+#include <QString>
+
+#include "FBXReader.h"
+
+/// Writes the geometry read from a model in a binary form that is read back without parsing the model again: the
+/// vertex, index and cluster arrays are stored as they are in memory, aligned, so they are copied straight out of a
+/// mapped file. The model meshes and materials built from the geometry are not stored, they are built again on reading.
+QByteArray serializeFBXGeometry(const FBXGeometry& geometry);
+
+/// Reads a geometry written by serializeFBXGeometry, and builds its model meshes and materials.
+/// \return null if the data is truncated or was written by another version
+FBXGeometry* readSerializedFBXGeometry(const uint8_t* data, size_t size, const QString& url);
+
+#endif // hifi_FBXSerializer_h
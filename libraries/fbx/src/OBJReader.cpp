@@ -537,6 +537,7 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
             geometry.meshExtents.addPoint(vertex);
         }
 
+        FBXReader::buildMeshLODs(mesh);
         FBXReader::buildModelMesh(mesh, url.toString());
         // fbxDebugDump(geometry);
     } catch(const std::exception& e) {
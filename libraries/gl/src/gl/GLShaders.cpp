@@ -1,5 +1,17 @@
 #include "GLShaders.h"
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include <PathUtils.h>
+
 #include "GLLogging.h"
 
 namespace gl {
@@ -138,7 +150,8 @@ GLuint compileProgram(const std::vector<GLuint>& glshaders) {
         return 0;
     }
 
-    // glProgramParameteri(glprogram, GL_PROGRAM_, GL_TRUE);
+    // so that the linked program can be saved in the binary cache
+    glProgramParameteri(glprogram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     // Create the program from the sub shaders
     for (auto so : glshaders) {
         glAttachShader(glprogram, so);
@@ -186,4 +199,168 @@ GLuint compileProgram(const std::vector<GLuint>& glshaders) {
     return glprogram;
 }
 
+// The binaries of a driver are in a directory named by the hash of its vendor, renderer and version strings.  The
+// first use reads them all from the disk on another thread, ahead of the programs asking for them.
+class ProgramBinaryCache {
+public:
+    static ProgramBinaryCache& instance() {
+        static ProgramBinaryCache cache;
+        return cache;
+    }
+
+    GLuint load(const std::string& programHash) {
+        open();
+        if (!_enabled) {
+            return 0;
+        }
+
+        QByteArray data;
+        {
+            std::lock_guard<std::mutex> lock(_binaries->mutex);
+            auto found = _binaries->binaries.find(programHash);
+            if (found != _binaries->binaries.end()) {
+                data = found->second;
+                _binaries->binaries.erase(found);
+            }
+        }
+        QString path = _directory + QString::fromStdString(programHash) + BINARY_EXTENSION;
+        if (data.isEmpty()) {
+            QFile file(path);
+            if (!file.open(QIODevice::ReadOnly)) {
+                return 0;
+            }
+            data = file.readAll();
+        }
+
+        GLenum format;
+        if (data.size() <= (int)sizeof(format)) {
+            return 0;
+        }
+        memcpy(&format, data.constData(), sizeof(format));
+        GLuint glprogram = glCreateProgram();
+        glProgramBinary(glprogram, format, data.constData() + sizeof(format), data.size() - (int)sizeof(format));
+
+        GLint linked = 0;
+        glGetProgramiv(glprogram, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // the driver may still refuse a binary of its own, compile it again
+            qCDebug(glLogging) << "Program binary" << QString::fromStdString(programHash) << "was rejected";
+            glDeleteProgram(glprogram);
+            QFile::remove(path);
+            return 0;
+        }
+        return glprogram;
+    }
+
+    void save(const std::string& programHash, GLuint glprogram) {
+        open();
+        if (!_enabled || !glprogram) {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(glprogram, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+        GLenum format;
+        QByteArray data(sizeof(format) + length, Qt::Uninitialized);
+        glGetProgramBinary(glprogram, length, &length, &format, data.data() + sizeof(format));
+        memcpy(data.data(), &format, sizeof(format));
+        data.resize(sizeof(format) + length);
+
+        // written under a temporary name, so that another session never reads half a binary
+        QString path = _directory + QString::fromStdString(programHash) + BINARY_EXTENSION;
+        QFile file(path + ".tmp");
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data) != data.size()) {
+            return;
+        }
+        file.close();
+        QFile::remove(path);
+        file.rename(path);
+    }
+
+private:
+    static const char* BINARY_EXTENSION;
+
+    struct Binaries {
+        std::mutex mutex;
+        std::unordered_map<std::string, QByteArray> binaries;
+    };
+
+    void open() {
+        if (_opened) {
+            return;
+        }
+        _opened = true;
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        if (formats <= 0) {
+            qCDebug(glLogging) << "The driver doesn't support program binaries";
+            return;
+        }
+
+        QCryptographicHash driverHash(QCryptographicHash::Md5);
+        driverHash.addData((const char*)glGetString(GL_VENDOR));
+        driverHash.addData((const char*)glGetString(GL_RENDERER));
+        driverHash.addData((const char*)glGetString(GL_VERSION));
+        QString driverName = QString(driverHash.result().toHex());
+
+        // only the binaries of the current driver are kept
+        QDir cacheDir(PathUtils::getAppLocalDataPath() + "shaders");
+        for (const auto& name : cacheDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            if (name != driverName) {
+                QDir(cacheDir.filePath(name)).removeRecursively();
+            }
+        }
+        if (!cacheDir.mkpath(driverName)) {
+            qCWarning(glLogging) << "Could not create the program binary cache in" << cacheDir.path();
+            return;
+        }
+        _directory = cacheDir.filePath(driverName) + "/";
+        _enabled = true;
+
+        QThreadPool::globalInstance()->start(new Prefetch(_directory, _binaries));
+    }
+
+    class Prefetch : public QRunnable {
+    public:
+        Prefetch(const QString& directory, const std::shared_ptr<Binaries>& binaries) :
+            _directory(directory), _binaries(binaries) {}
+
+        void run() override {
+            QDir dir(_directory);
+            for (const auto& fileName : dir.entryList({ QString("*") + BINARY_EXTENSION }, QDir::Files)) {
+                QFile file(dir.filePath(fileName));
+                if (file.open(QIODevice::ReadOnly)) {
+                    QByteArray data = file.readAll();
+                    std::string programHash = fileName.left(fileName.size() - (int)strlen(BINARY_EXTENSION)).toStdString();
+                    std::lock_guard<std::mutex> lock(_binaries->mutex);
+                    _binaries->binaries.emplace(programHash, data);
+                }
+            }
+        }
+
+    private:
+        QString _directory;
+        std::shared_ptr<Binaries> _binaries;
+    };
+
+    bool _opened { false };
+    bool _enabled { false };
+    QString _directory;
+    std::shared_ptr<Binaries> _binaries { std::make_shared<Binaries>() }; // shared with the reading thread
+};
+
+const char* ProgramBinaryCache::BINARY_EXTENSION = ".bin";
+
+GLuint loadProgramBinary(const std::string& programHash) {
+    return ProgramBinaryCache::instance().load(programHash);
+}
+
+void saveProgramBinary(const std::string& programHash, GLuint glprogram) {
+    ProgramBinaryCache::instance().save(programHash, glprogram);
+}
+
 }
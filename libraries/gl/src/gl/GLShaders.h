@@ -24,6 +24,12 @@ namespace gl {
 
     GLuint compileProgram(const std::vector<GLuint>& glshaders);
 
+    // The linked programs are kept on disk, by a hash of all their sources and defines, and the next sessions load
+    // them instead of compiling them again.  The binaries of another driver, or another version of it, are discarded.
+    // Both must be called with the context current.
+    GLuint loadProgramBinary(const std::string& programHash);
+    void saveProgramBinary(const std::string& programHash, GLuint glprogram);
+
 }
 
 #endif
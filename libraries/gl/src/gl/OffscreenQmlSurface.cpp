@@ -8,6 +8,7 @@
 #include "OffscreenQmlSurface.h"
 #include "Config.h"
 
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -180,7 +181,13 @@ private:
                 destroy(textureAndFence);
                 continue;
             }
-            _textures[sizeKey].returnedTextures.push_back(textureAndFence);
+            // No more are kept than the surfaces of the size can have in use at once
+            auto& textureSet = _textures[sizeKey];
+            if (textureSet.returnedTextures.size() >= textureSet.count * GPU_RESOURCE_BUFFER_SIZE) {
+                destroy(textureAndFence);
+                continue;
+            }
+            textureSet.returnedTextures.push_back(textureAndFence);
         }
     }
 
@@ -282,6 +289,7 @@ void OffscreenQmlSurface::render() {
     }
 
     PROFILE_RANGE(render_qml_gl, __FUNCTION__)
+    uint64_t renderStart = usecTimestampNow();
     _canvas->makeCurrent();
 
     _renderControl->sync();
@@ -311,6 +319,7 @@ void OffscreenQmlSurface::render() {
 
     _quickWindow->resetOpenGLState();
     _lastRenderTime = usecTimestampNow();
+    _renderCost.increment(_lastRenderTime - renderStart);
     _canvas->doneCurrent();
 }
 
@@ -346,10 +355,44 @@ bool OffscreenQmlSurface::allowNewFrame(uint8_t fps) {
     return (lastInterval > minRenderInterval);
 }
 
+// All the surfaces, for their stats
+static std::mutex surfacesMutex;
+static std::unordered_set<OffscreenQmlSurface*> surfaces;
+
+int OffscreenQmlSurface::getActiveSurfaceCount() {
+    std::lock_guard<std::mutex> lock(surfacesMutex);
+    int count = 0;
+    for (auto surface : surfaces) {
+        if (!surface->isPaused()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+float OffscreenQmlSurface::getTotalRenderCost() {
+    std::lock_guard<std::mutex> lock(surfacesMutex);
+    float renderCost = 0.0f;
+    for (auto surface : surfaces) {
+        renderCost += surface->getRenderCost();
+    }
+    return renderCost;
+}
+
+float OffscreenQmlSurface::getRenderCost() const {
+    return _renderCost.rate() / USECS_PER_MSEC;
+}
+
 OffscreenQmlSurface::OffscreenQmlSurface() {
+    std::lock_guard<std::mutex> lock(surfacesMutex);
+    surfaces.insert(this);
 }
 
 OffscreenQmlSurface::~OffscreenQmlSurface() {
+    {
+        std::lock_guard<std::mutex> lock(surfacesMutex);
+        surfaces.erase(this);
+    }
     QObject::disconnect(&_updateTimer);
     QObject::disconnect(qApp);
 
@@ -617,11 +660,12 @@ QObject* OffscreenQmlSurface::finishQmlLoad(std::function<void(QQmlContext*, QOb
 void OffscreenQmlSurface::updateQuick() {
     offscreenTextures.report();
     // If we're
-    //   a) not set up
-    //   b) already rendering a frame
-    //   c) rendering too fast
+    //   a) paused
+    //   b) not set up
+    //   c) already rendering a frame
+    //   d) rendering too fast
     // then skip this
-    if (!allowNewFrame(_maxFps)) {
+    if (_paused || !allowNewFrame(_maxFps)) {
         return;
     }
 
@@ -746,11 +790,16 @@ bool OffscreenQmlSurface::eventFilter(QObject* originalDestination, QEvent* even
 
 void OffscreenQmlSurface::pause() {
     _paused = true;
+    // The latest frame won't be fetched until after the next one is rendered, on resume, so its texture can be reused
+    if (_latestTextureAndFence.first) {
+        offscreenTextures.releaseTexture(_latestTextureAndFence);
+        _latestTextureAndFence = { 0, 0 };
+    }
 }
 
 void OffscreenQmlSurface::resume() {
     _paused = false;
-    _render = true;
+    _render = _polish = true;
 
     if (getRootItem()) {
         getRootItem()->setProperty("eventBridge", QVariant::fromValue(this));
@@ -20,6 +20,7 @@
 
 #include <GLMHelpers.h>
 #include <ThreadHelpers.h>
+#include <shared/RateCounter.h>
 
 class QWindow;
 class QMyQuickRenderControl;
@@ -65,10 +66,14 @@ public:
     }
 
     bool isFocusText() const { return _focusText; }
+    // A paused surface neither renders nor polishes its items, the last frame it rendered stays in its consumer's texture
     void pause();
     void resume();
     bool isPaused() const;
 
+    // The time spent rendering the surface, in milliseconds per second
+    float getRenderCost() const;
+
     void setBaseUrl(const QUrl& baseUrl);
     QQuickItem* getRootItem();
     QQuickWindow* getWindow();
@@ -90,6 +95,9 @@ public:
 
     static std::function<void(uint32_t, void*)> getDiscardLambda();
     static size_t getUsedTextureMemory();
+    // Of all the surfaces, the number of those not paused, and the time they all spend rendering in milliseconds per second
+    static int getActiveSurfaceCount();
+    static float getTotalRenderCost();
 
 signals:
     void focusObjectChanged(QObject* newFocus);
@@ -143,6 +151,7 @@ private:
     uint32_t _fbo { 0 };
     uint32_t _depthStencil { 0 };
     uint64_t _lastRenderTime { 0 };
+    RateCounter<> _renderCost; // in usecs per second
     uvec2 _size;
 
     // Texture management
@@ -10,6 +10,7 @@
 //
 #include "GLBackend.h"
 
+#include <chrono>
 #include <mutex>
 #include <queue>
 #include <list>
@@ -84,6 +85,7 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
     (&::gpu::gl::GLBackend::do_drawIndexedInstanced),
     (&::gpu::gl::GLBackend::do_multiDrawIndirect),
     (&::gpu::gl::GLBackend::do_multiDrawIndexedIndirect),
+    (&::gpu::gl::GLBackend::do_dispatch),
 
     (&::gpu::gl::GLBackend::do_setInputFormat),
     (&::gpu::gl::GLBackend::do_setInputBuffer),
@@ -102,10 +104,14 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
 
     (&::gpu::gl::GLBackend::do_setUniformBuffer),
     (&::gpu::gl::GLBackend::do_setResourceTexture),
+    (&::gpu::gl::GLBackend::do_setResourceBuffer),
+    (&::gpu::gl::GLBackend::do_setResourceTextureTable),
+    (&::gpu::gl::GLBackend::do_setResourceTextureBuffer),
 
     (&::gpu::gl::GLBackend::do_setFramebuffer),
     (&::gpu::gl::GLBackend::do_clearFramebuffer),
     (&::gpu::gl::GLBackend::do_blit),
+    (&::gpu::gl::GLBackend::do_textureBarrier),
     (&::gpu::gl::GLBackend::do_generateTextureMips),
 
     (&::gpu::gl::GLBackend::do_beginQuery),
@@ -189,6 +195,7 @@ GLBackend::~GLBackend() {
 
     killInput();
     killTransform();
+    killResourceStage();
 }
 
 void GLBackend::renderPassTransfer(const Batch& batch) {
@@ -253,7 +260,12 @@ void GLBackend::renderPassDraw(const Batch& batch) {
     const size_t numCommands = batch.getCommands().size();
     const Batch::Commands::value_type* command = batch.getCommands().data();
     const Batch::CommandOffsets::value_type* offset = batch.getCommandOffsets().data();
+    const bool isTiming = _commandTimingEnabled;
+    std::chrono::high_resolution_clock::time_point commandStart;
     for (_commandIndex = 0; _commandIndex < numCommands; ++_commandIndex) {
+        if (isTiming) {
+            commandStart = std::chrono::high_resolution_clock::now();
+        }
         switch (*command) {
             // Ignore these commands on this pass, taken care of in the transfer pass
             // Note we allow COMMAND_setViewportTransform to occur in both passes
@@ -280,6 +292,14 @@ void GLBackend::renderPassDraw(const Batch& batch) {
                 (this->*(call))(batch, *offset);
                 break;
             }
+            case Batch::COMMAND_dispatch: {
+                // the compute program of the pipeline needs to be bound, there are no inputs or transforms
+                updatePipeline();
+
+                CommandCall call = _commandCalls[(*command)];
+                (this->*(call))(batch, *offset);
+                break;
+            }
             default: {
                 CommandCall call = _commandCalls[(*command)];
                 (this->*(call))(batch, *offset);
@@ -287,11 +307,23 @@ void GLBackend::renderPassDraw(const Batch& batch) {
             }
         }
 
+        if (isTiming) {
+            auto& timing = _commandTimings[*command];
+            timing.count++;
+            timing.nsecs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - commandStart).count();
+        }
+
         command++;
         offset++;
     }
 }
 
+void GLBackend::resetCommandTimings() {
+    _commandTimings.fill(CommandTiming());
+    _transferTiming = CommandTiming();
+}
+
 void GLBackend::render(const Batch& batch) {
     _transform._skybox = _stereo._skybox = batch.isSkyboxEnabled();
     // Allow the batch to override the rendering stereo settings
@@ -303,11 +335,21 @@ void GLBackend::render(const Batch& batch) {
     
     {
         PROFILE_RANGE(render_gpu_gl_detail, "Transfer");
-        renderPassTransfer(batch);
+        if (_commandTimingEnabled) {
+            auto transferStart = std::chrono::high_resolution_clock::now();
+            renderPassTransfer(batch);
+            _transferTiming.count++;
+            _transferTiming.nsecs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - transferStart).count();
+        } else {
+            renderPassTransfer(batch);
+        }
     }
 
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-    if (_stereo._enable) {
+    // the eyes are split by the clip distance, unless they are the views of the viewports
+    bool clipEyes = _stereo._enable && !supportsStereoViewRendering();
+    if (clipEyes) {
         glEnable(GL_CLIP_DISTANCE0);
     }
 #endif
@@ -316,7 +358,7 @@ void GLBackend::render(const Batch& batch) {
         renderPassDraw(batch);
     }
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-    if (_stereo._enable) {
+    if (clipEyes) {
         glDisable(GL_CLIP_DISTANCE0);
     }
 #endif
@@ -422,7 +464,7 @@ void GLBackend::do_glUniform1i(const Batch& batch, size_t paramOffset) {
     }
     updatePipeline();
 
-    glUniform1f(
+    glUniform1i(
         GET_UNIFORM_LOCATION(batch._params[paramOffset + 1]._int),
         batch._params[paramOffset + 0]._int);
     (void)CHECK_GL_ERROR();
@@ -68,7 +68,7 @@ public:
 
     ~GLBackend();
 
-    void setCameraCorrection(const Mat4& correction);
+    void setCameraCorrection(const Mat4& correction) override;
     void render(const Batch& batch) final override;
 
     // This call synchronize the Full Backend cache with the current GLState
@@ -96,6 +96,14 @@ public:
     static const int MAX_NUM_RESOURCE_TEXTURES = 16;
     size_t getMaxNumResourceTextures() const { return MAX_NUM_RESOURCE_TEXTURES; }
 
+    // The storage buffer bindings guaranteed by GL 4.3
+    static const int MAX_NUM_RESOURCE_BUFFERS = 8;
+    size_t getMaxNumResourceBuffers() const { return MAX_NUM_RESOURCE_BUFFERS; }
+
+    // True if a stereo draw covers both eyes with a single instance, the vertex shader positioning the right eye as the
+    // secondary view of GL_NV_stereo_view_rendering, rather than drawing each instance once per eye
+    virtual bool supportsStereoViewRendering() const { return false; }
+
     // Draw Stage
     virtual void do_draw(const Batch& batch, size_t paramOffset) = 0;
     virtual void do_drawIndexed(const Batch& batch, size_t paramOffset) = 0;
@@ -104,6 +112,9 @@ public:
     virtual void do_multiDrawIndirect(const Batch& batch, size_t paramOffset) = 0;
     virtual void do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) = 0;
 
+    // Compute Stage
+    virtual void do_dispatch(const Batch& batch, size_t paramOffset) = 0;
+
     // Input Stage
     virtual void do_setInputFormat(const Batch& batch, size_t paramOffset) final;
     virtual void do_setInputBuffer(const Batch& batch, size_t paramOffset) final;
@@ -123,6 +134,10 @@ public:
 
     // Resource Stage
     virtual void do_setResourceTexture(const Batch& batch, size_t paramOffset) final;
+    virtual void do_setResourceBuffer(const Batch& batch, size_t paramOffset) = 0;
+    // Binds the textures of the table to the texture units following the slot, the bindless backends override it
+    virtual void do_setResourceTextureTable(const Batch& batch, size_t paramOffset);
+    virtual void do_setResourceTextureBuffer(const Batch& batch, size_t paramOffset) final;
 
     // Pipeline Stage
     virtual void do_setPipeline(const Batch& batch, size_t paramOffset) final;
@@ -131,6 +146,7 @@ public:
     virtual void do_setFramebuffer(const Batch& batch, size_t paramOffset) final;
     virtual void do_clearFramebuffer(const Batch& batch, size_t paramOffset) final;
     virtual void do_blit(const Batch& batch, size_t paramOffset) = 0;
+    virtual void do_textureBarrier(const Batch& batch, size_t paramOffset) final;
 
     // Query section
     virtual void do_beginQuery(const Batch& batch, size_t paramOffset) final;
@@ -208,6 +224,20 @@ public:
 
     bool isTextureManagementSparseEnabled() const override { return (_textureManagement._sparseCapable && Texture::getEnableSparseTextures()); }
 
+    // The CPU time spent issuing each type of command, measured only while enabled, for the offline benchmarks
+    struct CommandTiming {
+        uint64_t count { 0 };
+        uint64_t nsecs { 0 };
+    };
+    using CommandTimings = std::array<CommandTiming, Batch::NUM_COMMANDS>;
+
+    void setCommandTimingEnabled(bool enabled) { _commandTimingEnabled = enabled; }
+    bool isCommandTimingEnabled() const { return _commandTimingEnabled; }
+    const CommandTimings& getCommandTimings() const { return _commandTimings; }
+    // The CPU time of the transfer passes, which upload the transforms and draw call infos of the batches
+    const CommandTiming& getTransferTiming() const { return _transferTiming; }
+    void resetCommandTimings();
+
 protected:
 
     void recycle() const override;
@@ -217,6 +247,10 @@ protected:
     int32_t _uboAlignment { 0 };
     int _currentDraw { -1 };
 
+    bool _commandTimingEnabled { false };
+    CommandTimings _commandTimings;
+    CommandTiming _transferTiming;
+
     std::list<std::string> profileRanges;
     mutable Mutex _trashMutex;
     mutable std::list<std::pair<GLuint, Size>> _buffersTrash;
@@ -323,6 +357,8 @@ protected:
         GLuint _drawCallInfoBuffer { 0 };
         GLuint _objectBufferTexture { 0 };
         size_t _cameraUboSize { 0 };
+        // Where the cameras of the batch start in the camera buffer, the backends streaming them into a shared buffer move it
+        size_t _cameraBufferOffset { 0 };
         bool _viewIsCamera{ false };
         bool _skybox { false };
         Transform _view;
@@ -360,12 +396,18 @@ protected:
     
     // update resource cache and do the gl unbind call with the current gpu::Texture cached at slot s
     void releaseResourceTexture(uint32_t slot);
+    void releaseResourceBuffer(uint32_t slot);
+    void bindResourceTexture(uint32_t slot, const TexturePointer& texture);
 
     void resetResourceStage();
+    void killResourceStage();
 
     struct ResourceStageState {
         std::array<TexturePointer, MAX_NUM_RESOURCE_TEXTURES> _textures;
         //Textures _textures { { MAX_NUM_RESOURCE_TEXTURES } };
+        std::array<BufferPointer, MAX_NUM_RESOURCE_BUFFERS> _buffers;
+        // The GL buffer textures of the texture slots, created on their first setResourceTextureBuffer
+        std::array<GLuint, MAX_NUM_RESOURCE_TEXTURES> _textureBuffers {};
         int findEmptyTextureSlot() const;
     } _resource;
 
@@ -137,6 +137,16 @@ void GLBackend::do_clearFramebuffer(const Batch& batch, size_t paramOffset) {
     (void) CHECK_GL_ERROR();
 }
 
+void GLBackend::do_textureBarrier(const Batch& batch, size_t paramOffset) {
+    // Core in 4.5, the NV extension is available on most of the 4.1 drivers
+    if (GLEW_VERSION_4_5) {
+        glTextureBarrier();
+    } else if (GLEW_NV_texture_barrier) {
+        glTextureBarrierNV();
+    }
+    (void) CHECK_GL_ERROR();
+}
+
 void GLBackend::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) {
     auto readFBO = getFramebufferID(srcFramebuffer);
     if (srcFramebuffer && readFBO) {
@@ -190,10 +190,31 @@ void GLBackend::releaseResourceTexture(uint32_t slot) {
     }
 }
 
+void GLBackend::releaseResourceBuffer(uint32_t slot) {
+    auto& buffer = _resource._buffers[slot];
+    if (buffer) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, 0); // RELEASE
+        (void) CHECK_GL_ERROR();
+        buffer.reset();
+    }
+}
+
 void GLBackend::resetResourceStage() {
     for (uint32_t i = 0; i < _resource._textures.size(); i++) {
         releaseResourceTexture(i);
     }
+    for (uint32_t i = 0; i < _resource._buffers.size(); i++) {
+        releaseResourceBuffer(i);
+    }
+}
+
+void GLBackend::killResourceStage() {
+    for (auto& texture : _resource._textureBuffers) {
+        if (texture) {
+            glDeleteTextures(1, &texture);
+            texture = 0;
+        }
+    }
 }
 
 void GLBackend::do_setResourceTexture(const Batch& batch, size_t paramOffset) {
@@ -203,8 +224,49 @@ void GLBackend::do_setResourceTexture(const Batch& batch, size_t paramOffset) {
         return;
     }
 
-    TexturePointer resourceTexture = batch._textures.get(batch._params[paramOffset + 0]._uint);
+    bindResourceTexture(slot, batch._textures.get(batch._params[paramOffset + 0]._uint));
+}
+
+void GLBackend::do_setResourceTextureTable(const Batch& batch, size_t paramOffset) {
+    const auto& textureTablePointer = batch._textureTables.get(batch._params[paramOffset]._uint);
+    if (!textureTablePointer) {
+        return;
+    }
+
+    GLuint slot = batch._params[paramOffset + 1]._uint;
+    const auto& textures = textureTablePointer->getTextures();
+    for (GLuint index = 0; index < textures.size() && (slot + index) < (GLuint)MAX_NUM_RESOURCE_TEXTURES; ++index) {
+        bindResourceTexture(slot + index, textures[index]);
+    }
+}
+
+void GLBackend::do_setResourceTextureBuffer(const Batch& batch, size_t paramOffset) {
+    GLuint slot = batch._params[paramOffset + 1]._uint;
+    if (slot >= (GLuint)MAX_NUM_RESOURCE_TEXTURES) {
+        return;
+    }
+
+    // the texture unit now samples the buffer, the next texture set on the slot is bound again
+    releaseResourceTexture(slot);
+
+    BufferPointer resourceBuffer = batch._buffers.get(batch._params[paramOffset + 0]._uint);
+    glActiveTexture(GL_TEXTURE0 + slot);
+    if (!resourceBuffer) {
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        (void)CHECK_GL_ERROR();
+        return;
+    }
+
+    GLuint& texture = _resource._textureBuffers[slot];
+    if (!texture) {
+        glGenTextures(1, &texture);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, getBufferID(*resourceBuffer));
+    (void)CHECK_GL_ERROR();
+}
 
+void GLBackend::bindResourceTexture(uint32_t slot, const TexturePointer& resourceTexture) {
     if (!resourceTexture) {
         releaseResourceTexture(slot);
         return;
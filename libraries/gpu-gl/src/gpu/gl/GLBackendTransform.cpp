@@ -36,6 +36,13 @@ void GLBackend::do_setViewportTransform(const Batch& batch, size_t paramOffset)
         ivec4& vp = _transform._viewport;
         glViewport(vp.x, vp.y, vp.z, vp.w);
 
+        if (_stereo._enable && supportsStereoViewRendering()) {
+            // the vertex shaders send the left eye view to the first viewport and the right eye one to the second
+            GLfloat eyeWidth = (GLfloat)(vp.z / 2);
+            glViewportIndexedf(0, (GLfloat)vp.x, (GLfloat)vp.y, eyeWidth, (GLfloat)vp.w);
+            glViewportIndexedf(1, (GLfloat)vp.x + eyeWidth, (GLfloat)vp.y, eyeWidth, (GLfloat)vp.w);
+        }
+
         // Where we assign the GL viewport
         if (_stereo._enable) {
             vp.z /= 2;
@@ -161,7 +168,7 @@ void GLBackend::TransformStageState::update(size_t commandIndex, const StereoSta
 
 void GLBackend::TransformStageState::bindCurrentCamera(int eye) const {
     if (_currentCameraOffset != INVALID_OFFSET) {
-        glBindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_CAMERA_SLOT, _cameraBuffer, _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
+        glBindBufferRange(GL_UNIFORM_BUFFER, TRANSFORM_CAMERA_SLOT, _cameraBuffer, _cameraBufferOffset + _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
     }
 }
 
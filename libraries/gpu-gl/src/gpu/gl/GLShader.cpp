@@ -6,6 +6,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "GLShader.h"
+
+#include <QtCore/QCryptographicHash>
+
 #include <gl/GLShaders.h>
 
 #include "GLBackend.h"
@@ -35,8 +38,13 @@ static const std::string glslVersion {
     "#version 410 core"
 };
 
+// Compute shaders need GLSL 4.30, only the backends supporting compute shaders compile them
+static const std::string glslComputeVersion {
+    "#version 430 core"
+};
+
 // Shader domain
-static const size_t NUM_SHADER_DOMAINS = 3;
+static const size_t NUM_SHADER_DOMAINS = 4;
 
 // GL Shader type enums
 // Must match the order of type specified in gpu::Shader::Type
@@ -44,6 +52,7 @@ static const std::array<GLenum, NUM_SHADER_DOMAINS> SHADER_DOMAINS { {
     GL_VERTEX_SHADER,
     GL_FRAGMENT_SHADER,
     GL_GEOMETRY_SHADER,
+    GL_COMPUTE_SHADER,
 } };
 
 // Domain specific defines
@@ -52,6 +61,7 @@ static const std::array<std::string, NUM_SHADER_DOMAINS> DOMAIN_DEFINES { {
     "#define GPU_VERTEX_SHADER",
     "#define GPU_PIXEL_SHADER",
     "#define GPU_GEOMETRY_SHADER",
+    "#define GPU_COMPUTE_SHADER",
 } };
 
 // Stereo specific defines
@@ -68,12 +78,56 @@ static const std::string stereoVersion {
 #endif
 };
 
+// Stereo specific defines when a draw covers both eyes, the right one as the secondary view.  The pixel shaders read
+// the eye from the viewport index.
+static const std::string stereoViewVersion {
+    "#define GPU_TRANSFORM_IS_STEREO\n#define GPU_TRANSFORM_STEREO_CAMERA\n#define GPU_TRANSFORM_STEREO_VIEW"
+};
+
+// Must match the order of type specified in gpu::Shader::Type
+static const std::array<std::string, NUM_SHADER_DOMAINS> STEREO_VIEW_EXTENSIONS { {
+    "#extension GL_NV_viewport_array2 : require\n#extension GL_NV_stereo_view_rendering : require",
+    "#extension GL_ARB_fragment_layer_viewport : require",
+    "",
+    "",
+} };
+
+// Texture tables, with the backends supporting bindless textures
+static const std::string bindlessTexturesDefines {
+    "#extension GL_ARB_bindless_texture : require\n#define GPU_BINDLESS_TEXTURES"
+};
+
 // Versions specific of the shader
 static const std::array<std::string, GLShader::NumVersions> VERSION_DEFINES { {
     "",
     stereoVersion
 } };
 
+static std::string getShaderDefines(GLBackend& backend, const Shader& shader, int version) {
+    const std::string& shaderVersion = (shader.getType() == Shader::COMPUTE ? glslComputeVersion : glslVersion);
+    std::string versionDefines = VERSION_DEFINES[version];
+    if (version == GLShader::Stereo && backend.supportsStereoViewRendering()) {
+        versionDefines = STEREO_VIEW_EXTENSIONS[shader.getType()] + "\n" + stereoViewVersion;
+    }
+    std::string shaderDefines = shaderVersion + "\n" + DOMAIN_DEFINES[shader.getType()] + "\n" + versionDefines;
+    if (backend.supportsBindlessTextures()) {
+        shaderDefines += "\n" + bindlessTexturesDefines;
+    }
+    return shaderDefines;
+}
+
+// The key of a program version in the binary cache, from everything its shaders are compiled from
+static std::string getProgramHash(GLBackend& backend, const Shader& program, int version) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (auto subShader : program.getShaders()) {
+        const std::string defines = getShaderDefines(backend, *subShader, version);
+        const std::string& source = subShader->getSource().getCode();
+        hash.addData(defines.data(), (int)defines.size() + 1);
+        hash.addData(source.data(), (int)source.size() + 1);
+    }
+    return hash.result().toHex().toStdString();
+}
+
 GLShader* compileBackendShader(GLBackend& backend, const Shader& shader) {
     // Any GLSLprogram ? normally yes...
     const std::string& shaderSource = shader.getSource().getCode();
@@ -83,7 +137,7 @@ GLShader* compileBackendShader(GLBackend& backend, const Shader& shader) {
     for (int version = 0; version < GLShader::NumVersions; version++) {
         auto& shaderObject = shaderObjects[version];
 
-        std::string shaderDefines = glslVersion + "\n" + DOMAIN_DEFINES[shader.getType()] + "\n" + VERSION_DEFINES[version];
+        std::string shaderDefines = getShaderDefines(backend, shader, version);
 
 #ifdef SEPARATE_PROGRAM
         bool result = ::gl::compileShader(shaderDomain, shaderSource, shaderDefines, shaderObject.glshader, shaderObject.glprogram);
@@ -112,6 +166,15 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
     for (int version = 0; version < GLShader::NumVersions; version++) {
         auto& programObject = programObjects[version];
 
+        // A program linked by an earlier session doesn't need its shaders
+        std::string programHash = getProgramHash(backend, program, version);
+        GLuint cachedProgram = ::gl::loadProgramBinary(programHash);
+        if (cachedProgram) {
+            programObject.glprogram = cachedProgram;
+            makeLinkedProgramBindings(programObject);
+            continue;
+        }
+
         // Let's go through every shaders and make sure they are ready to go
         std::vector< GLuint > shaderGLObjects;
         for (auto subShader : program.getShaders()) {
@@ -132,6 +195,7 @@ GLShader* compileBackendProgram(GLBackend& backend, const Shader& program) {
         programObject.glprogram = glprogram;
 
         makeProgramBindings(programObject);
+        ::gl::saveProgramBinary(programHash, glprogram);
     }
 
     // So far so good, the program versions have all been created successfully
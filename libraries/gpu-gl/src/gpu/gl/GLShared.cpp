@@ -439,7 +439,7 @@ ElementResource getFormatFromGLUniform(GLenum gltype) {
         //    {GL_SAMPLER_1D_SHADOW    sampler1DShadow},
         //   {GL_SAMPLER_1D_ARRAY_SHADOW    sampler1DArrayShadow},
 
-        //    {GL_SAMPLER_BUFFER    samplerBuffer},
+    case GL_SAMPLER_BUFFER: return ElementResource(Element(SCALAR, gpu::FLOAT, SAMPLER), Resource::TEXTURE_BUFFER);
         //    {GL_SAMPLER_2D_RECT    sampler2DRect},
         //   {GL_SAMPLER_2D_RECT_SHADOW    sampler2DRectShadow},
 
@@ -757,6 +757,15 @@ void makeProgramBindings(ShaderObject& shaderObject) {
     }
 
     // now assign the ubo binding, then DON't relink!
+    makeLinkedProgramBindings(shaderObject);
+}
+
+void makeLinkedProgramBindings(ShaderObject& shaderObject) {
+    if (!shaderObject.glprogram) {
+        return;
+    }
+    GLuint glprogram = shaderObject.glprogram;
+    GLint loc = -1;
 
     //Check for gpu specific uniform slotBindings
 #ifdef GPU_SSBO_DRAW_CALL_INFO
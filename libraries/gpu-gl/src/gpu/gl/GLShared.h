@@ -47,6 +47,8 @@ int makeUniformBlockSlots(GLuint glprogram, const Shader::BindingSet& slotBindin
 int makeInputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& inputs);
 int makeOutputSlots(GLuint glprogram, const Shader::BindingSet& slotBindings, Shader::SlotSet& outputs);
 void makeProgramBindings(ShaderObject& shaderObject);
+// the bindings that are not kept in a linked program binary, set again when it is loaded
+void makeLinkedProgramBindings(ShaderObject& shaderObject);
 
 enum GLSyncState {
     // The object is currently undergoing no processing, although it's content
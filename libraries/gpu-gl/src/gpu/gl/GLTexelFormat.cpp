@@ -11,8 +11,48 @@
 using namespace gpu;
 using namespace gpu::gl;
 
+bool GLTexelFormat::isCompressed(GLenum internalFormat) {
+    switch (internalFormat) {
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+GLenum GLTexelFormat::evalGLTexelFormatBlockCompressed(const Element& format) {
+    switch (format.getSemantic()) {
+        case gpu::COMPRESSED_BC1_SRGB:
+            return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        case gpu::COMPRESSED_BC1_SRGBA:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case gpu::COMPRESSED_BC3_SRGBA:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        case gpu::COMPRESSED_BC4_RED:
+            return GL_COMPRESSED_RED_RGTC1;
+        case gpu::COMPRESSED_BC5_XY:
+            return GL_COMPRESSED_RG_RGTC2;
+        case gpu::COMPRESSED_BC7_SRGBA:
+            return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+        case gpu::COMPRESSED_ASTC_4x4_SRGBA:
+            return GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR;
+        default:
+            return 0;
+    }
+}
+
 
 GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
+    if (dstFormat.isBlockCompressed()) {
+        return evalGLTexelFormatBlockCompressed(dstFormat);
+    }
+
     GLenum result = GL_RGBA8;
     switch (dstFormat.getDimension()) {
         case gpu::SCALAR: {
@@ -224,22 +264,6 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
                     result = GL_COMPRESSED_SRGB_ALPHA;
                     break;
 
-                    // FIXME: WE will want to support this later
-                    /*
-                    case gpu::COMPRESSED_BC3_RGBA:
-                    result = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-                    break;
-                    case gpu::COMPRESSED_BC3_SRGBA:
-                    result = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-                    break;
-
-                    case gpu::COMPRESSED_BC7_RGBA:
-                    result = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
-                    break;
-                    case gpu::COMPRESSED_BC7_SRGBA:
-                    result = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
-                    break;
-                    */
 
                 default:
                     qCWarning(gpugllogging) << "Unknown combination of texel format";
@@ -254,6 +278,12 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
 }
 
 GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const Element& srcFormat) {
+    // The block compressed mips are uploaded as they are stored, the format and type are not used
+    if (dstFormat.isBlockCompressed()) {
+        GLenum internalFormat = evalGLTexelFormatBlockCompressed(dstFormat);
+        return { internalFormat, internalFormat, GL_UNSIGNED_BYTE };
+    }
+
     if (dstFormat != srcFormat) {
         GLTexelFormat texel = { GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE };
 
@@ -367,22 +397,6 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
 
                 break;
 
-                // FIXME: WE will want to support this later
-                /*
-                case gpu::COMPRESSED_BC3_RGBA:
-                texel.internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-                break;
-                case gpu::COMPRESSED_BC3_SRGBA:
-                texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-                break;
-
-                case gpu::COMPRESSED_BC7_RGBA:
-                texel.internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
-                break;
-                case gpu::COMPRESSED_BC7_SRGBA:
-                texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
-                break;
-                */
 
             default:
                 qCWarning(gpugllogging) << "Unknown combination of texel format";
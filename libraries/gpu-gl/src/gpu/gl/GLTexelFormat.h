@@ -24,6 +24,10 @@ public:
     static GLenum evalGLTexelFormatInternal(const Element& dstFormat);
 
     static GLTexelFormat evalGLTexelFormat(const Element& dstFormat, const Element& srcFormat);
+
+    // 0 if the format isn't block compressed
+    static GLenum evalGLTexelFormatBlockCompressed(const Element& format);
+    static bool isCompressed(GLenum internalFormat);
 };
 
 } }
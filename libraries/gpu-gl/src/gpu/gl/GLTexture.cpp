@@ -50,7 +50,8 @@ const GLFilterMode GLTexture::FILTER_MODES[Sampler::NUM_FILTERS] = {
 GLenum GLTexture::getGLTextureType(const Texture& texture) {
     switch (texture.getType()) {
     case Texture::TEX_2D:
-        return GL_TEXTURE_2D;
+        // Multisampled 2D textures are only render buffers, resolved by a blit
+        return (texture.getNumSamples() > 1) ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
         break;
 
     case Texture::TEX_CUBE:
@@ -68,6 +69,7 @@ GLenum GLTexture::getGLTextureType(const Texture& texture) {
 uint8_t GLTexture::getFaceCount(GLenum target) {
     switch (target) {
         case GL_TEXTURE_2D:
+        case GL_TEXTURE_2D_MULTISAMPLE:
             return TEXTURE_2D_NUM_FACES;
         case GL_TEXTURE_CUBE_MAP:
             return TEXTURE_CUBE_NUM_FACES;
@@ -85,9 +87,14 @@ const std::vector<GLenum>& GLTexture::getFaceTargets(GLenum target) {
     static std::vector<GLenum> faceTargets {
         GL_TEXTURE_2D
     };
+    static std::vector<GLenum> multisampleFaceTargets {
+        GL_TEXTURE_2D_MULTISAMPLE
+    };
     switch (target) {
     case GL_TEXTURE_2D:
         return faceTargets;
+    case GL_TEXTURE_2D_MULTISAMPLE:
+        return multisampleFaceTargets;
     case GL_TEXTURE_CUBE_MAP:
         return cubeFaceTargets;
     default:
@@ -186,3 +186,18 @@ void GL41Backend::do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOf
 #endif
     (void)CHECK_GL_ERROR();
 }
+
+void GL41Backend::do_dispatch(const Batch& batch, size_t paramOffset) {
+    // GL 4.1 has no compute shaders, the callers check Context::supportsComputeShaders() and use a CPU path instead
+    static std::once_flag once;
+    std::call_once(once, [] {
+        qCWarning(gpugl41logging) << "GL41Backend::do_dispatch: compute shaders are not supported";
+    });
+}
+
+void GL41Backend::do_setResourceBuffer(const Batch& batch, size_t paramOffset) {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        qCWarning(gpugl41logging) << "GL41Backend::do_setResourceBuffer: storage buffers are not supported";
+    });
+}
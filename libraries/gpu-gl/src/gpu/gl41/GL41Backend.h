@@ -85,6 +85,12 @@ protected:
     void do_multiDrawIndirect(const Batch& batch, size_t paramOffset) override;
     void do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) override;
 
+    // Compute Stage
+    void do_dispatch(const Batch& batch, size_t paramOffset) override;
+
+    // Resource Stage
+    void do_setResourceBuffer(const Batch& batch, size_t paramOffset) override;
+
     // Input Stage
     void resetInputStage() override;
     void updateInput() override;
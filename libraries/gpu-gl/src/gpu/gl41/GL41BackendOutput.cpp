@@ -64,7 +64,7 @@ public:
                     }
 
                     if (gltexture) {
-                        glFramebufferTexture2D(GL_FRAMEBUFFER, colorAttachments[unit], GL_TEXTURE_2D, gltexture->_texture, 0);
+                        glFramebufferTexture2D(GL_FRAMEBUFFER, colorAttachments[unit], gltexture->_target, gltexture->_texture, 0);
                         _colorBuffers.push_back(colorAttachments[unit]);
                     } else {
                         glFramebufferTexture2D(GL_FRAMEBUFFER, colorAttachments[unit], GL_TEXTURE_2D, 0, 0);
@@ -91,7 +91,7 @@ public:
             }
 
             if (gltexture) {
-                glFramebufferTexture2D(GL_FRAMEBUFFER, attachement, GL_TEXTURE_2D, gltexture->_texture, 0);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, attachement, gltexture->_target, gltexture->_texture, 0);
             } else {
                 glFramebufferTexture2D(GL_FRAMEBUFFER, attachement, GL_TEXTURE_2D, 0, 0);
             }
@@ -72,6 +72,12 @@ GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture&
     incrementTextureGPUCount();
     withPreservedTexture([&] {
         GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat(), _gpuObject.getStoredMipFormat());
+        if (GL_TEXTURE_2D_MULTISAMPLE == _target) {
+            Vec3u dimensions = _gpuObject.getDimensions();
+            glTexImage2DMultisample(_target, _gpuObject.getNumSamples(), texelFormat.internalFormat, dimensions.x, dimensions.y, GL_TRUE);
+            (void)CHECK_GL_ERROR();
+            return;
+        }
         auto numMips = _gpuObject.evalNumMips();
         for (uint16_t mipLevel = 0; mipLevel < numMips; ++mipLevel) {
             // Get the mip level dimensions, accounting for the downgrade level
@@ -83,7 +89,12 @@ GL41Texture::GL41Texture(const std::weak_ptr<GLBackend>& backend, const Texture&
                     auto mip = _gpuObject.accessStoredMipFace(mipLevel, face);
                     mipData = mip->readData();
                 }
-                glTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, texelFormat.format, texelFormat.type, mipData);
+                if (GLTexelFormat::isCompressed(texelFormat.internalFormat)) {
+                    auto mipSize = _gpuObject.evalMipFaceSize(mipLevel);
+                    glCompressedTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, mipSize, mipData);
+                } else {
+                    glTexImage2D(target, mipLevel, texelFormat.internalFormat, dimensions.x, dimensions.y, 0, texelFormat.format, texelFormat.type, mipData);
+                }
                 (void)CHECK_GL_ERROR();
                 ++face;
             }
@@ -116,6 +127,10 @@ void GL41Texture::withPreservedTexture(std::function<void()> f) const {
             glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &boundTex);
             break;
 
+        case GL_TEXTURE_2D_MULTISAMPLE:
+            glGetIntegerv(GL_TEXTURE_BINDING_2D_MULTISAMPLE, &boundTex);
+            break;
+
         default:
             qFatal("Unsupported texture type");
     }
@@ -140,6 +155,10 @@ void GL41Texture::syncContent() const {
 }
 
 void GL41Texture::syncSampler() const {
+    // Multisampled textures have no sampler state
+    if (GL_TEXTURE_2D_MULTISAMPLE == _target) {
+        return;
+    }
     const Sampler& sampler = _gpuObject.getSampler();
     const auto& fm = FILTER_MODES[sampler.getFilter()];
     glTexParameteri(_target, GL_TEXTURE_MIN_FILTER, fm.minFilter);
@@ -7,17 +7,50 @@
 //
 #include "GL45Backend.h"
 
+#include <cstring>
 #include <mutex>
 #include <queue>
 #include <list>
 #include <functional>
 #include <glm/gtc/type_ptr.hpp>
+#include <QtCore/QProcessEnvironment>
 
 Q_LOGGING_CATEGORY(gpugl45logging, "hifi.gpu.gl45")
 
+static const QString ENABLE_STEREO_VIEW_RENDERING_FLAG("HIFI_ENABLE_STEREO_VIEW_RENDERING");
+
 using namespace gpu;
 using namespace gpu::gl45;
 
+GL45Backend::~GL45Backend() {
+    // The transform buffers are the ring's, don't let the parent delete them again
+    _transformRing.release();
+    GL45VariableAllocationTexture::TransferJob::_stagingBuffer.destroy();
+    _transform._objectBuffer = 0;
+    _transform._cameraBuffer = 0;
+    _transform._drawCallInfoBuffer = 0;
+}
+
+static bool hasExtension(const char* name) {
+    GLint numExtensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+    for (GLint i = 0; i < numExtensions; i++) {
+        if (strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i)), name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GL45Backend::supportsStereoViewRendering() const {
+    // Opt in while the vertex shaders computing screen space outputs from the position only do so for the left eye,
+    // the one vertex being shared by both views. The pixel shaders find their eye from the viewport index.
+    static const bool supported = QProcessEnvironment::systemEnvironment().contains(ENABLE_STEREO_VIEW_RENDERING_FLAG) &&
+        hasExtension("GL_NV_stereo_view_rendering") && hasExtension("GL_NV_viewport_array2") &&
+        hasExtension("GL_ARB_fragment_layer_viewport");
+    return supported;
+}
+
 void GL45Backend::recycle() const {
     Parent::recycle();
     GL45VariableAllocationTexture::manageMemory();
@@ -32,7 +65,11 @@ void GL45Backend::do_draw(const Batch& batch, size_t paramOffset) {
 
     if (isStereo()) {
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-        glDrawArraysInstanced(mode, startVertex, numVertices, 2);
+        if (supportsStereoViewRendering()) {
+            glDrawArrays(mode, startVertex, numVertices);
+        } else {
+            glDrawArraysInstanced(mode, startVertex, numVertices, 2);
+        }
 #else
         setupStereoSide(0);
         glDrawArrays(mode, startVertex, numVertices);
@@ -66,7 +103,11 @@ void GL45Backend::do_drawIndexed(const Batch& batch, size_t paramOffset) {
 
     if (isStereo()) {
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-        glDrawElementsInstanced(mode, numIndices, glType, indexBufferByteOffset, 2);
+        if (supportsStereoViewRendering()) {
+            glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
+        } else {
+            glDrawElementsInstanced(mode, numIndices, glType, indexBufferByteOffset, 2);
+        }
 #else
         setupStereoSide(0);
         glDrawElements(mode, numIndices, glType, indexBufferByteOffset);
@@ -97,7 +138,7 @@ void GL45Backend::do_drawInstanced(const Batch& batch, size_t paramOffset) {
         GLint trueNumInstances = 2 * numInstances;
 
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-        glDrawArraysInstanced(mode, startVertex, numVertices, trueNumInstances);
+        glDrawArraysInstanced(mode, startVertex, numVertices, numInstances * getStereoInstanceFactor());
 #else
         setupStereoSide(0);
         glDrawArraysInstanced(mode, startVertex, numVertices, numInstances);
@@ -131,7 +172,8 @@ void GL45Backend::do_drawIndexedInstanced(const Batch& batch, size_t paramOffset
         GLint trueNumInstances = 2 * numInstances;
 
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-        glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, trueNumInstances, 0, startInstance);
+        glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset,
+                                                      numInstances * getStereoInstanceFactor(), 0, startInstance);
 #else
         setupStereoSide(0);
         glDrawElementsInstancedBaseVertexBaseInstance(mode, numIndices, glType, indexBufferByteOffset, numInstances, 0, startInstance);
@@ -169,3 +211,41 @@ void GL45Backend::do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOf
     _stats._DSNumAPIDrawcalls++;
     (void)CHECK_GL_ERROR();
 }
+
+void GL45Backend::do_dispatch(const Batch& batch, size_t paramOffset) {
+    GLuint numGroupsX = batch._params[paramOffset + 0]._uint;
+    GLuint numGroupsY = batch._params[paramOffset + 1]._uint;
+    GLuint numGroupsZ = batch._params[paramOffset + 2]._uint;
+    glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+    // The buffers written by the program are read back by the following shaders, as storage or uniform buffers,
+    // vertex fetches and indirect draws
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+                    GL_COMMAND_BARRIER_BIT);
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::do_setResourceBuffer(const Batch& batch, size_t paramOffset) {
+    GLuint slot = batch._params[paramOffset + 1]._uint;
+    if (slot >= (GLuint)MAX_NUM_RESOURCE_BUFFERS) {
+        return;
+    }
+
+    BufferPointer resourceBuffer = batch._buffers.get(batch._params[paramOffset + 0]._uint);
+    if (!resourceBuffer) {
+        releaseResourceBuffer(slot);
+        return;
+    }
+    // check cache before thinking
+    if (_resource._buffers[slot] == resourceBuffer) {
+        return;
+    }
+
+    auto* object = syncGPUObject(*resourceBuffer);
+    if (object) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, object->_buffer);
+        _resource._buffers[slot] = resourceBuffer;
+        (void)CHECK_GL_ERROR();
+    } else {
+        releaseResourceBuffer(slot);
+    }
+}
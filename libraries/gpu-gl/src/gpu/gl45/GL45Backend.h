@@ -14,7 +14,10 @@
 
 #include "../gl/GLBackend.h"
 #include "../gl/GLTexture.h"
+#include <condition_variable>
+#include <deque>
 #include <thread>
+#include <unordered_set>
 
 #define INCREMENTAL_TRANSFER 0
 #define THREADED_TEXTURE_BUFFERING 1
@@ -32,6 +35,11 @@ class GL45Backend : public GLBackend {
 public:
     explicit GL45Backend(bool syncCache) : Parent(syncCache) {}
     GL45Backend() : Parent() {}
+    ~GL45Backend();
+
+    bool supportsComputeShaders() const override { return true; }
+    bool supportsBindlessTextures() const override;
+    bool supportsStereoViewRendering() const override;
 
     class GL45Texture : public GLTexture {
         using Parent = GLTexture;
@@ -41,8 +49,43 @@ public:
         GL45Texture(const std::weak_ptr<GLBackend>& backend, const Texture& texture);
         void generateMips() const override;
         void copyMipFaceFromTexture(uint16_t sourceMip, uint16_t targetMip, uint8_t face) const;
-        void copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, const void* sourcePointer) const;
+        void copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, Size sourceSize, const void* sourcePointer) const;
         virtual void syncSampler() const;
+
+        // The resident handle of the texture for the texture tables. The handle freezes the sampler and the base mip
+        // of the texture, so the base mip is reset to 0 and the shaders clamp to the bindless min mip instead.
+        GLuint64 getBindlessHandle() const;
+        virtual float getBindlessMinMip() const { return 0.0f; }
+        bool isBindless() const { return _bindlessHandle != 0; }
+        // Before the storage of the texture is replaced
+        void releaseBindlessHandle() const;
+
+        mutable GLuint64 _bindlessHandle { 0 };
+    };
+
+    // The resident handles of a texture table, in a uniform buffer
+    class GL45TextureTable : public GLObject<TextureTable> {
+        using Parent = GLObject<TextureTable>;
+        friend class GL45Backend;
+        static GLuint allocate();
+    public:
+        // Matches GPUTextureTableEntry in TextureTable.slh, std140 pads every entry to a uvec4
+        struct Entry {
+            GLuint64 handle { 0 };
+            float minMip { 0.0f };
+            uint32_t isValid { 0 };
+        };
+        using Entries = std::array<Entry, TextureTable::COUNT>;
+
+        GL45TextureTable(const std::weak_ptr<GLBackend>& backend, const TextureTable& table);
+        ~GL45TextureTable();
+
+        // Uploads the entries if they changed since the last time
+        void update(const Entries& entries);
+
+    protected:
+        Entries _entries;
+        bool _uploaded { false };
     };
 
     //
@@ -61,6 +104,7 @@ public:
         uint32 size() const override { return _size; }
         void allocateStorage() const;
         void syncSampler() const override;
+        float getBindlessMinMip() const override;
         const uint32 _size { 0 };
     };
 
@@ -104,20 +148,56 @@ public:
         };
         using WorkQueue = std::priority_queue<QueuePair, std::vector<QueuePair>, QueuePairLess>;
 
+        // A persistently mapped pixel unpack buffer the buffering thread copies the mips into, so that the render
+        // thread uploads them without reading their bytes. The blocks are reused in the order they were taken,
+        // once the fence following their upload is signaled. Only used on the render thread, but for the copies.
+        class TransferStagingBuffer {
+        public:
+            static const size_t SIZE;
+
+            // False if there isn't room for the block until earlier uploads are done
+            bool allocate(size_t size, size_t& offset);
+            // After the upload reading the block is submitted, or when the block won't be uploaded
+            void release(size_t offset, bool uploaded);
+            void destroy();
+
+            GLuint getBuffer() const { return _buffer; }
+            uint8_t* getData() const { return _data; }
+
+        private:
+            struct Block {
+                size_t offset;
+                size_t size;
+                GLsync fence;
+                bool released;
+            };
+            void create();
+            void reclaim();
+
+            std::deque<Block> _blocks;
+            GLuint _buffer { 0 };
+            uint8_t* _data { nullptr };
+            size_t _head { 0 };
+        };
+
         class TransferJob {
             using VoidLambda = std::function<void()>;
             using VoidLambdaQueue = std::queue<VoidLambda>;
             using ThreadPointer = std::shared_ptr<std::thread>;
             const GL45VariableAllocationTexture& _parent;
-            // Holds the contents to transfer to the GPU in CPU memory
+            // Holds the contents to transfer to the GPU in CPU memory, when they don't go through the staging buffer
             std::vector<uint8_t> _buffer;
+            // Where the contents are staged, set before the buffering starts
+            uint8_t* _stagingData { nullptr };
+            size_t _stagingOffset { 0 };
             // Indicates if a transfer from backing storage to interal storage has started
             bool _bufferingStarted { false };
-            bool _bufferingCompleted { false };
+            std::atomic<bool> _bufferingCompleted { false };
             VoidLambda _transferLambda;
             VoidLambda _bufferingLambda;
 #if THREADED_TEXTURE_BUFFERING
             static Mutex _mutex;
+            static std::condition_variable _bufferCondition;
             static VoidLambdaQueue _bufferLambdaQueue;
             static ThreadPointer _bufferThread;
             static std::atomic<bool> _shutdownBufferingThread;
@@ -125,11 +205,14 @@ public:
 #endif
 
         public:
+            static TransferStagingBuffer _stagingBuffer;
+
             TransferJob(const TransferJob& other) = delete;
             TransferJob(const GL45VariableAllocationTexture& parent, std::function<void()> transferLambda);
             TransferJob(const GL45VariableAllocationTexture& parent, uint16_t sourceMip, uint16_t targetMip, uint8_t face, uint32_t lines = 0, uint32_t lineOffset = 0);
             ~TransferJob();
             bool tryTransfer();
+            size_t getTransferSize() const { return _transferSize; }
 
 #if THREADED_TEXTURE_BUFFERING
             static void startTransferLoop();
@@ -139,7 +222,8 @@ public:
         private:
             size_t _transferSize { 0 };
 #if THREADED_TEXTURE_BUFFERING
-            void startBuffering();
+            // False if the staging buffer has no room for it yet
+            bool startBuffering();
 #endif
             void transfer();
         };
@@ -153,7 +237,8 @@ public:
         static WorkQueue _transferQueue;
         static WorkQueue _promoteQueue;
         static WorkQueue _demoteQueue;
-        static TexturePointer _currentTransferTexture;
+        // The textures with a transfer under way, kept alive while their contents are being buffered
+        static std::unordered_set<TexturePointer> _transferringTextures;
         static const uvec3 INITIAL_MIP_TRANSFER_DIMENSIONS;
 
 
@@ -172,7 +257,8 @@ public:
         bool canPromote() const { return _allocatedMip > 0; }
         bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
         bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
-        void executeNextTransfer(const TexturePointer& currentTexture);
+        // Returns the number of bytes uploaded
+        size_t executeNextTransfer(const TexturePointer& currentTexture);
         uint32 size() const override { return _size; }
         virtual void populateTransferQueue() = 0;
         virtual void promote() = 0;
@@ -205,6 +291,7 @@ public:
         void promote() override;
         void demote() override;
         void populateTransferQueue() override;
+        float getBindlessMinMip() const override { return (float)(_populatedMip - _allocatedMip); }
 
         void allocateStorage(uint16 mip);
         void copyMipsFromTexture();
@@ -260,6 +347,9 @@ protected:
     GLuint getQueryID(const QueryPointer& query) override;
     GLQuery* syncGPUObject(const Query& query) override;
 
+    // The instances drawn for each one of a draw, one per eye in stereo unless the draw covers both
+    GLuint getStereoInstanceFactor() { return (isStereo() && !supportsStereoViewRendering()) ? 2 : 1; }
+
     // Draw Stage
     void do_draw(const Batch& batch, size_t paramOffset) override;
     void do_drawIndexed(const Batch& batch, size_t paramOffset) override;
@@ -268,6 +358,13 @@ protected:
     void do_multiDrawIndirect(const Batch& batch, size_t paramOffset) override;
     void do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOffset) override;
 
+    // Compute Stage
+    void do_dispatch(const Batch& batch, size_t paramOffset) override;
+
+    // Resource Stage
+    void do_setResourceBuffer(const Batch& batch, size_t paramOffset) override;
+    void do_setResourceTextureTable(const Batch& batch, size_t paramOffset) override;
+
     // Input Stage
     void resetInputStage() override;
     void updateInput() override;
@@ -277,6 +374,33 @@ protected:
     void initTransform() override;
     void updateTransform(const Batch& batch) override;
 
+    // A persistently mapped buffer the transform data of the batches is written straight into, instead of
+    // respecifying the transform buffers for every batch. It is split in segments, fenced once the batches
+    // reading them are submitted and waited on before being written again.
+    class TransformRing {
+    public:
+        static const int NUM_SEGMENTS = 3;
+
+        // Returns the offset of a block of size bytes, grows the ring if it doesn't fit in a segment
+        GLintptr allocate(size_t size, size_t alignment);
+        GLuint getBuffer() const { return _buffer; }
+        uint8_t* getData() const { return _data; }
+        void release();
+
+    private:
+        void create(size_t segmentSize);
+        void waitForSegment(int segment);
+
+        GLuint _buffer { 0 };
+        uint8_t* _data { nullptr };
+        size_t _segmentSize { 0 };
+        size_t _offset { 0 };
+        int _segment { 0 };
+        GLsync _fences[NUM_SEGMENTS] {};
+    };
+    mutable TransformRing _transformRing;
+    size_t _transformRingAlignment { 0 };
+
     // Output stage
     void do_blit(const Batch& batch, size_t paramOffset) override;
 
@@ -76,7 +76,7 @@ void GL45Backend::updateInput() {
                     (void)CHECK_GL_ERROR();
                 }
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-                glVertexBindingDivisor(bufferChannelNum, frequency * (isStereo() ? 2 : 1));
+                glVertexBindingDivisor(bufferChannelNum, frequency * getStereoInstanceFactor());
 #else
                 glVertexBindingDivisor(bufferChannelNum, frequency);
 #endif
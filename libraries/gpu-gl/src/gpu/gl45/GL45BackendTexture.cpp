@@ -18,6 +18,7 @@
 #include <glm/gtx/component_wise.hpp>
 
 #include <QtCore/QDebug>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <NumericalConstants.h>
@@ -118,8 +119,22 @@ void GL45Texture::generateMips() const {
     (void)CHECK_GL_ERROR();
 }
 
-void GL45Texture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, const void* sourcePointer) const {
-    if (GL_TEXTURE_2D == _target) {
+void GL45Texture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, Size sourceSize, const void* sourcePointer) const {
+    // The compressed formats are uploaded in whole blocks, the format is the internal format
+    if (GLTexelFormat::isCompressed(format)) {
+        if (GL_TEXTURE_2D == _target) {
+            glCompressedTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, format, (GLsizei)sourceSize, sourcePointer);
+        } else if (GL_TEXTURE_CUBE_MAP == _target) {
+            if (glCompressedTextureSubImage2DEXT) {
+                auto target = GLTexture::CUBE_FACE_LAYOUT[face];
+                glCompressedTextureSubImage2DEXT(_id, target, mip, 0, yOffset, size.x, size.y, format, (GLsizei)sourceSize, sourcePointer);
+            } else {
+                glCompressedTextureSubImage3D(_id, mip, 0, yOffset, face, size.x, size.y, 1, format, (GLsizei)sourceSize, sourcePointer);
+            }
+        } else {
+            Q_ASSERT(false);
+        }
+    } else if (GL_TEXTURE_2D == _target) {
         glTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, format, type, sourcePointer);
     } else if (GL_TEXTURE_CUBE_MAP == _target) {
         // DSA ARB does not work on AMD, so use EXT
@@ -144,13 +159,16 @@ void GL45Texture::copyMipFaceFromTexture(uint16_t sourceMip, uint16_t targetMip,
     auto mipData = _gpuObject.accessStoredMipFace(sourceMip, face);
     if (mipData) {
         GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat(), _gpuObject.getStoredMipFormat());
-        copyMipFaceLinesFromTexture(targetMip, face, size, 0, texelFormat.format, texelFormat.type, mipData->readData());
+        copyMipFaceLinesFromTexture(targetMip, face, size, 0, texelFormat.format, texelFormat.type, mipData->getSize(), mipData->readData());
     } else {
          qCDebug(gpugllogging) << "Missing mipData level=" << sourceMip << " face=" << (int)face << " for texture " << _gpuObject.source().c_str();
     }
 }
 
 void GL45Texture::syncSampler() const {
+    if (isBindless()) {
+        return;
+    }
     const Sampler& sampler = _gpuObject.getSampler();
 
     const auto& fm = FILTER_MODES[sampler.getFilter()];
@@ -173,6 +191,109 @@ void GL45Texture::syncSampler() const {
     glTextureParameterf(_id, GL_TEXTURE_MAX_LOD, (sampler.getMaxMip() == Sampler::MAX_MIP_LEVEL ? 1000.f : sampler.getMaxMip()));
 }
 
+GLuint64 GL45Texture::getBindlessHandle() const {
+    if (!_bindlessHandle) {
+        glTextureParameteri(_id, GL_TEXTURE_BASE_LEVEL, 0);
+        _bindlessHandle = glGetTextureHandleARB(_id);
+        glMakeTextureHandleResidentARB(_bindlessHandle);
+        (void)CHECK_GL_ERROR();
+    }
+    return _bindlessHandle;
+}
+
+void GL45Texture::releaseBindlessHandle() const {
+    if (_bindlessHandle) {
+        glMakeTextureHandleNonResidentARB(_bindlessHandle);
+        _bindlessHandle = 0;
+    }
+}
+
+using GL45TextureTable = GL45Backend::GL45TextureTable;
+
+GLuint GL45TextureTable::allocate() {
+    GLuint result;
+    glCreateBuffers(1, &result);
+    return result;
+}
+
+GL45TextureTable::GL45TextureTable(const std::weak_ptr<GLBackend>& backend, const TextureTable& table)
+    : Parent(backend, table, allocate()) {
+    glNamedBufferStorage(_id, sizeof(Entries), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    Backend::incrementBufferGPUCount();
+    Backend::updateBufferGPUMemoryUsage(0, sizeof(Entries));
+}
+
+GL45TextureTable::~GL45TextureTable() {
+    if (_id) {
+        auto backend = _backend.lock();
+        if (backend) {
+            backend->releaseBuffer(_id, sizeof(Entries));
+        }
+    }
+}
+
+void GL45TextureTable::update(const Entries& entries) {
+    if (_uploaded && memcmp(entries.data(), _entries.data(), sizeof(Entries)) == 0) {
+        return;
+    }
+    _entries = entries;
+    _uploaded = true;
+    glNamedBufferSubData(_id, 0, sizeof(Entries), _entries.data());
+}
+
+static const QString ENABLE_BINDLESS_TEXTURES_FLAG("HIFI_ENABLE_BINDLESS_TEXTURES");
+
+bool GL45Backend::supportsBindlessTextures() const {
+    // Opt in while the material shaders don't use the texture tables
+    static const bool supported = QProcessEnvironment::systemEnvironment().contains(ENABLE_BINDLESS_TEXTURES_FLAG) &&
+        GLEW_ARB_bindless_texture;
+    return supported;
+}
+
+void GL45Backend::do_setResourceTextureTable(const Batch& batch, size_t paramOffset) {
+    if (!supportsBindlessTextures()) {
+        Parent::do_setResourceTextureTable(batch, paramOffset);
+        return;
+    }
+
+    const auto& textureTablePointer = batch._textureTables.get(batch._params[paramOffset]._uint);
+    GLuint slot = batch._params[paramOffset + 1]._uint;
+    if (!textureTablePointer || slot >= (GLuint)MAX_NUM_UNIFORM_BUFFERS) {
+        return;
+    }
+
+    const auto& textureTable = *textureTablePointer;
+    GL45TextureTable* object = Backend::getGPUObject<GL45TextureTable>(textureTable);
+    if (!object) {
+        object = new GL45TextureTable(shared_from_this(), textureTable);
+        Backend::setGPUObject(textureTable, object);
+    }
+
+    // The handles follow the textures being promoted, demoted and populated
+    GL45TextureTable::Entries entries;
+    const auto& textures = textureTable.getTextures();
+    for (size_t index = 0; index < textures.size(); ++index) {
+        const auto& texture = textures[index];
+        if (!texture || TextureUsageType::EXTERNAL == texture->getUsageType()) {
+            continue;
+        }
+        auto textureObject = static_cast<GL45Texture*>(syncGPUObject(texture));
+        if (textureObject) {
+            auto& entry = entries[index];
+            entry.handle = textureObject->getBindlessHandle();
+            entry.minMip = textureObject->getBindlessMinMip();
+            entry.isValid = 1;
+            _stats._RSAmountTextureMemoryBounded += textureObject->size();
+        }
+    }
+    object->update(entries);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, slot, object->_id);
+    (void)CHECK_GL_ERROR();
+    // The uniform stage doesn't know of the table, the next uniform buffer set on the slot must be bound again
+    _uniform._buffers[slot].reset();
+}
+
 using GL45FixedAllocationTexture = GL45Backend::GL45FixedAllocationTexture;
 
 GL45FixedAllocationTexture::GL45FixedAllocationTexture(const std::weak_ptr<GLBackend>& backend, const Texture& texture) : GL45Texture(backend, texture), _size(texture.evalTotalSize()) {
@@ -186,12 +307,23 @@ GL45FixedAllocationTexture::~GL45FixedAllocationTexture() {
 void GL45FixedAllocationTexture::allocateStorage() const {
     const GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_gpuObject.getTexelFormat());
     const auto dimensions = _gpuObject.getDimensions();
+    if (GL_TEXTURE_2D_MULTISAMPLE == _target) {
+        glTextureStorage2DMultisample(_id, _gpuObject.getNumSamples(), texelFormat.internalFormat, dimensions.x, dimensions.y, GL_TRUE);
+        return;
+    }
     const auto mips = _gpuObject.evalNumMips();
     glTextureStorage2D(_id, mips, texelFormat.internalFormat, dimensions.x, dimensions.y);
 }
 
 void GL45FixedAllocationTexture::syncSampler() const {
+    // Multisampled textures have no sampler state
+    if (GL_TEXTURE_2D_MULTISAMPLE == _target) {
+        return;
+    }
     Parent::syncSampler();
+    if (isBindless()) {
+        return;
+    }
     const Sampler& sampler = _gpuObject.getSampler();
     auto baseMip = std::max<uint16_t>(sampler.getMipOffset(), sampler.getMinMip());
     glTextureParameteri(_id, GL_TEXTURE_BASE_LEVEL, baseMip);
@@ -199,6 +331,11 @@ void GL45FixedAllocationTexture::syncSampler() const {
     glTextureParameterf(_id, GL_TEXTURE_MAX_LOD, (sampler.getMaxMip() == Sampler::MAX_MIP_LEVEL ? 1000.f : sampler.getMaxMip()));
 }
 
+float GL45FixedAllocationTexture::getBindlessMinMip() const {
+    const Sampler& sampler = _gpuObject.getSampler();
+    return (float)std::max<uint16_t>(sampler.getMipOffset(), sampler.getMinMip());
+}
+
 // Renderbuffer attachment textures
 using GL45AttachmentTexture = GL45Backend::GL45AttachmentTexture;
 
@@ -13,52 +13,142 @@
 using namespace gpu;
 using namespace gpu::gl45;
 
+// Enough for the transforms of a few thousand objects per batch, the ring grows when a batch needs more
+static const size_t MIN_TRANSFORM_RING_SEGMENT_SIZE = 1024 * 1024;
+static const size_t TRANSFORM_RING_SEGMENT_GRANULARITY = 64 * 1024;
+static const GLuint64 TRANSFORM_RING_WAIT_TIMEOUT_NS = 1000 * 1000;
+
+static size_t alignOffset(size_t offset, size_t alignment) {
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+void GL45Backend::TransformRing::create(size_t segmentSize) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    _segmentSize = alignOffset(segmentSize, TRANSFORM_RING_SEGMENT_GRANULARITY);
+    GLsizeiptr size = NUM_SEGMENTS * _segmentSize;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, size, nullptr, flags);
+    _data = static_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, size, flags));
+    _segment = 0;
+    _offset = 0;
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::TransformRing::release() {
+    for (auto& fence : _fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if (_buffer) {
+        // The GPU keeps the storage alive until the commands reading it are done
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+        _data = nullptr;
+    }
+    _segmentSize = 0;
+}
+
+void GL45Backend::TransformRing::waitForSegment(int segment) {
+    GLsync& fence = _fences[segment];
+    if (!fence) {
+        return;
+    }
+    GLenum result;
+    do {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TRANSFORM_RING_WAIT_TIMEOUT_NS);
+    } while (result == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(fence);
+    fence = 0;
+}
+
+GLintptr GL45Backend::TransformRing::allocate(size_t size, size_t alignment) {
+    if (size > _segmentSize) {
+        size_t segmentSize = std::max(size, std::max(2 * _segmentSize, MIN_TRANSFORM_RING_SEGMENT_SIZE));
+        release();
+        create(segmentSize);
+    }
+
+    size_t offset = alignOffset(_offset, alignment);
+    if (offset + size > (_segment + 1) * _segmentSize) {
+        // The batches reading the segment are all submitted, the one asking for the block isn't yet
+        _fences[_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _segment = (_segment + 1) % NUM_SEGMENTS;
+        waitForSegment(_segment);
+        offset = _segment * _segmentSize;
+    }
+    _offset = offset + size;
+    return (GLintptr)offset;
+}
+
 void GL45Backend::initTransform() {
-    GLuint transformBuffers[3];
-    glCreateBuffers(3, transformBuffers);
-    _transform._objectBuffer = transformBuffers[0];
-    _transform._cameraBuffer = transformBuffers[1];
-    _transform._drawCallInfoBuffer = transformBuffers[2];
     glCreateTextures(GL_TEXTURE_BUFFER, 1, &_transform._objectBufferTexture);
     size_t cameraSize = sizeof(TransformStageState::CameraBufferElement);
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += _uboAlignment;
     }
+
+    // The cameras, objects and draw call infos of a batch share a block of the ring, each aligned for its binding
+    GLint objectAlignment = 0;
+#ifdef GPU_SSBO_DRAW_CALL_INFO
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#else
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#endif
+    _transformRingAlignment = std::max<size_t>(std::max(_uboAlignment, objectAlignment), sizeof(Vec4));
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
-    // FIXME not thread safe
-    static std::vector<uint8_t> bufferData;
-    if (!_transform._cameras.empty()) {
-        bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
-        for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
-        }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+    const size_t alignment = _transformRingAlignment;
+    const size_t camerasSize = _transform._cameraUboSize * _transform._cameras.size();
+    const size_t objectsSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    size_t drawCallInfosSize = 0;
+    for (auto& data : batch._namedData) {
+        drawCallInfosSize += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
     }
 
-    if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+    const size_t objectsOffset = alignOffset(camerasSize, alignment);
+    const size_t drawCallInfosOffset = alignOffset(objectsOffset + objectsSize, alignment);
+    const size_t blockSize = std::max(drawCallInfosOffset + drawCallInfosSize, alignment);
+
+    // One allocation per batch, so that a segment is never fenced before the draws of the batch reading it
+    const size_t blockOffset = _transformRing.allocate(blockSize, alignment);
+    uint8_t* block = _transformRing.getData() + blockOffset;
+    const GLuint buffer = _transformRing.getBuffer();
+    _transform._cameraBuffer = buffer;
+    _transform._objectBuffer = buffer;
+    _transform._drawCallInfoBuffer = buffer;
+
+    _transform._cameraBufferOffset = blockOffset;
+    for (size_t i = 0; i < _transform._cameras.size(); ++i) {
+        memcpy(block + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
     }
 
-    if (!batch._namedData.empty()) {
-        bufferData.clear();
-        for (auto& data : batch._namedData) {
-            auto currentSize = bufferData.size();
-            auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
-            bufferData.resize(currentSize + bytesToCopy);
-            memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
-            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
-        }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+    if (objectsSize) {
+        memcpy(block + objectsOffset, batch._objects.data(), objectsSize);
     }
 
+    size_t currentOffset = drawCallInfosOffset;
+    for (auto& data : batch._namedData) {
+        auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+        memcpy(block + currentOffset, data.second.drawCallInfos.data(), bytesToCopy);
+        _transform._drawCallInfoOffsets[data.first] = (GLvoid*)(blockOffset + currentOffset);
+        currentOffset += bytesToCopy;
+    }
+
+    // An empty range can't be bound, the batches without objects keep the previous one
 #ifdef GPU_SSBO_DRAW_CALL_INFO
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, _transform._objectBuffer);
+    if (objectsSize) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, TRANSFORM_OBJECT_SLOT, buffer, blockOffset + objectsOffset, objectsSize);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + TRANSFORM_OBJECT_SLOT);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (objectsSize) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, buffer, blockOffset + objectsOffset, objectsSize);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -85,7 +175,7 @@ void GL45Backend::updateTransform(const Batch& batch) {
             glVertexAttribIFormat(gpu::Stream::DRAW_CALL_INFO, 2, GL_UNSIGNED_SHORT, 0);
             glVertexAttribBinding(gpu::Stream::DRAW_CALL_INFO, gpu::Stream::DRAW_CALL_INFO);
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
-            glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, (isStereo() ? 2 : 1));
+            glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, getStereoInstanceFactor());
 #else
             glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, 1);
 #endif
@@ -18,7 +18,6 @@
 #include <glm/gtx/component_wise.hpp>
 
 #include <QtCore/QDebug>
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 #include "../gl/GLTexelFormat.h"
@@ -39,7 +38,7 @@ const uvec3 GL45VariableAllocationTexture::INITIAL_MIP_TRANSFER_DIMENSIONS { 64,
 WorkQueue GL45VariableAllocationTexture::_transferQueue;
 WorkQueue GL45VariableAllocationTexture::_promoteQueue;
 WorkQueue GL45VariableAllocationTexture::_demoteQueue;
-TexturePointer GL45VariableAllocationTexture::_currentTransferTexture;
+std::unordered_set<TexturePointer> GL45VariableAllocationTexture::_transferringTextures;
 
 #define OVERSUBSCRIBED_PRESSURE_VALUE 0.95f
 #define UNDERSUBSCRIBED_PRESSURE_VALUE 0.85f
@@ -52,10 +51,100 @@ using TransferJob = GL45VariableAllocationTexture::TransferJob;
 static const uvec3 MAX_TRANSFER_DIMENSIONS { 1024, 1024, 1 };
 static const size_t MAX_TRANSFER_SIZE = MAX_TRANSFER_DIMENSIONS.x * MAX_TRANSFER_DIMENSIONS.y * 4;
 
+// The uploads of a frame stop past that many bytes, a bigger burst makes the frame miss its vsync
+static const size_t MAX_TRANSFER_SIZE_PER_FRAME = 2 * MAX_TRANSFER_SIZE;
+static const size_t MAX_TRANSFER_TEXTURES_PER_FRAME = 8;
+
+using TransferStagingBuffer = GL45VariableAllocationTexture::TransferStagingBuffer;
+
+const size_t TransferStagingBuffer::SIZE = 8 * MAX_TRANSFER_SIZE;
+TransferStagingBuffer TransferJob::_stagingBuffer;
+
+void TransferStagingBuffer::create() {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, SIZE, nullptr, flags);
+    _data = static_cast<uint8_t*>(glMapNamedBufferRange(_buffer, 0, SIZE, flags));
+    _head = 0;
+    (void)CHECK_GL_ERROR();
+}
+
+void TransferStagingBuffer::destroy() {
+    for (auto& block : _blocks) {
+        if (block.fence) {
+            glDeleteSync(block.fence);
+        }
+    }
+    _blocks.clear();
+    if (_buffer) {
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+        _data = nullptr;
+    }
+}
+
+void TransferStagingBuffer::reclaim() {
+    while (!_blocks.empty() && _blocks.front().released) {
+        auto& block = _blocks.front();
+        if (block.fence) {
+            GLenum result = glClientWaitSync(block.fence, 0, 0);
+            if (GL_TIMEOUT_EXPIRED == result) {
+                break;
+            }
+            glDeleteSync(block.fence);
+        }
+        _blocks.pop_front();
+    }
+    if (_blocks.empty()) {
+        _head = 0;
+    }
+}
+
+bool TransferStagingBuffer::allocate(size_t size, size_t& offset) {
+    if (size > SIZE) {
+        return false;
+    }
+    if (!_buffer) {
+        create();
+    }
+    reclaim();
+
+    if (_blocks.empty() || _head > _blocks.front().offset) {
+        // The free space is past the head and before the first block, once wrapped
+        if (_head + size <= SIZE) {
+            offset = _head;
+        } else if (_blocks.empty() || size <= _blocks.front().offset) {
+            offset = 0;
+        } else {
+            return false;
+        }
+    } else if (_head + size <= _blocks.front().offset) {
+        offset = _head;
+    } else {
+        return false;
+    }
+
+    _blocks.push_back({ offset, size, 0, false });
+    _head = offset + size;
+    return true;
+}
+
+void TransferStagingBuffer::release(size_t offset, bool uploaded) {
+    for (auto& block : _blocks) {
+        if (block.offset == offset && !block.released) {
+            block.fence = (uploaded ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : 0);
+            block.released = true;
+            break;
+        }
+    }
+}
+
 #if THREADED_TEXTURE_BUFFERING
 std::shared_ptr<std::thread> TransferJob::_bufferThread { nullptr };
 std::atomic<bool> TransferJob::_shutdownBufferingThread { false };
 Mutex TransferJob::_mutex;
+std::condition_variable TransferJob::_bufferCondition;
 TransferJob::VoidLambdaQueue TransferJob::_bufferLambdaQueue;
 
 void TransferJob::startTransferLoop() {
@@ -72,10 +161,25 @@ void TransferJob::stopTransferLoop() {
     if (!_bufferThread) {
         return;
     }
-    _shutdownBufferingThread = true;
+    {
+        Lock lock(_mutex);
+        _shutdownBufferingThread = true;
+    }
+    _bufferCondition.notify_one();
     _bufferThread->join();
     _bufferThread.reset();
     _shutdownBufferingThread = false;
+
+    // Buffer what was left right away, the textures may drop their jobs before the loop starts again
+    VoidLambdaQueue workingQueue;
+    {
+        Lock lock(_mutex);
+        _bufferLambdaQueue.swap(workingQueue);
+    }
+    while (!workingQueue.empty()) {
+        workingQueue.front()();
+        workingQueue.pop();
+    }
 }
 #endif
 
@@ -85,39 +189,57 @@ TransferJob::TransferJob(const GL45VariableAllocationTexture& parent, uint16_t s
     auto transferDimensions = _parent._gpuObject.evalMipDimensions(sourceMip);
     GLenum format;
     GLenum type;
-    auto mipData = _parent._gpuObject.accessStoredMipFace(sourceMip, face);
+    auto mipSize = _parent._gpuObject.getStoredMipFaceSize(sourceMip, face);
     GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(_parent._gpuObject.getTexelFormat(), _parent._gpuObject.getStoredMipFormat());
     format = texelFormat.format;
     type = texelFormat.type;
 
+    size_t sourceOffset = 0;
     if (0 == lines) {
-        _transferSize = mipData->getSize();
-        _bufferingLambda = [=] {
-            _buffer.resize(_transferSize);
-            memcpy(&_buffer[0], mipData->readData(), _transferSize);
-            _bufferingCompleted = true;
-        };
-
+        _transferSize = mipSize;
     } else {
         transferDimensions.y = lines;
         auto dimensions = _parent._gpuObject.evalMipDimensions(sourceMip);
-        auto mipSize = mipData->getSize();
-        auto bytesPerLine = (uint32_t)mipSize / dimensions.y;
-        _transferSize = bytesPerLine * lines;
-        auto sourceOffset = bytesPerLine * lineOffset;
-        _bufferingLambda = [=] {
-            _buffer.resize(_transferSize);
-            memcpy(&_buffer[0], mipData->readData() + sourceOffset, _transferSize);
-            _bufferingCompleted = true;
-        };
+        // The compressed mips are stored in rows of blocks, the line offset is on a block boundary
+        const auto& texelFormat = _parent._gpuObject.getTexelFormat();
+        const uint32_t linesPerRow = texelFormat.isBlockCompressed() ? Element::BLOCK_SIZE : 1;
+        const uint32_t rows = (dimensions.y + linesPerRow - 1) / linesPerRow;
+        auto bytesPerRow = (uint32_t)mipSize / rows;
+        _transferSize = bytesPerRow * ((lines + linesPerRow - 1) / linesPerRow);
+        sourceOffset = bytesPerRow * (lineOffset / linesPerRow);
     }
 
+    _bufferingLambda = [=] {
+        uint8_t* target = _stagingData;
+        if (!target) {
+            _buffer.resize(_transferSize);
+            target = _buffer.data();
+        }
+        // The mip is only accessed while it is buffered, a mip paged from its file is unmapped right after
+        auto mipData = _parent._gpuObject.accessStoredMipFace(sourceMip, face);
+        if (mipData && mipData->getSize() >= sourceOffset + _transferSize) {
+            memcpy(target, mipData->readData() + sourceOffset, _transferSize);
+        } else {
+            memset(target, 0, _transferSize);
+        }
+        _bufferingCompleted = true;
+    };
+
     Backend::updateTextureTransferPendingSize(0, _transferSize);
 
     _transferLambda = [=] {
-        _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, _buffer.data());
-        std::vector<uint8_t> emptyVector;
-        _buffer.swap(emptyVector);
+        if (_stagingData) {
+            // The pointer is an offset in the unpack buffer, the GPU pulls the contents by itself
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _stagingBuffer.getBuffer());
+            _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, _transferSize, (const void*)_stagingOffset);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            _stagingBuffer.release(_stagingOffset, true);
+            _stagingData = nullptr;
+        } else {
+            _parent.copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, format, type, _transferSize, _buffer.data());
+            std::vector<uint8_t> emptyVector;
+            _buffer.swap(emptyVector);
+        }
     };
 }
 
@@ -126,6 +248,9 @@ TransferJob::TransferJob(const GL45VariableAllocationTexture& parent, std::funct
 }
 
 TransferJob::~TransferJob() {
+    if (_stagingData) {
+        _stagingBuffer.release(_stagingOffset, false);
+    }
     Backend::updateTextureTransferPendingSize(_transferSize, 0);
 }
 
@@ -139,8 +264,13 @@ bool TransferJob::tryTransfer() {
         return true;
     }
 
-    startBuffering();
-    return false;
+    if (startBuffering()) {
+        return false;
+    }
+    // No room to stage it, it goes through CPU memory
+    _bufferingLambda();
+    _transferLambda();
+    return true;
 #else
     if (!_bufferingCompleted) {
         _bufferingLambda();
@@ -153,15 +283,26 @@ bool TransferJob::tryTransfer() {
 
 #if THREADED_TEXTURE_BUFFERING
 
-void TransferJob::startBuffering() {
+bool TransferJob::startBuffering() {
     if (_bufferingStarted) {
-        return;
+        return true;
+    }
+    if (_transferSize) {
+        size_t offset;
+        if (!_stagingBuffer.allocate(_transferSize, offset)) {
+            // Wait for the uploads of the previous frames, unless it will never fit
+            return _transferSize <= TransferStagingBuffer::SIZE;
+        }
+        _stagingOffset = offset;
+        _stagingData = _stagingBuffer.getData() + offset;
     }
     _bufferingStarted = true;
     {
         Lock lock(_mutex);
         _bufferLambdaQueue.push(_bufferingLambda);
     }
+    _bufferCondition.notify_one();
+    return true;
 }
 
 void TransferJob::bufferLoop() {
@@ -169,14 +310,12 @@ void TransferJob::bufferLoop() {
         VoidLambdaQueue workingQueue;
         {
             Lock lock(_mutex);
+            _bufferCondition.wait(lock, [] {
+                return _shutdownBufferingThread || !_bufferLambdaQueue.empty();
+            });
             _bufferLambdaQueue.swap(workingQueue);
         }
 
-        if (workingQueue.empty()) {
-            QThread::msleep(5);
-            continue;
-        }
-
         while (!workingQueue.empty()) {
             workingQueue.front()();
             workingQueue.pop();
@@ -360,6 +499,10 @@ void GL45VariableAllocationTexture::processWorkQueues() {
 
     auto& workQueue = getActiveWorkQueue();
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
+    // The transfers go on with the next textures until the upload budget of the frame is spent,
+    // a texture is visited once per frame
+    size_t transferredSize = 0;
+    std::vector<TexturePointer> processedTextures;
     while (!workQueue.empty()) {
         auto workTarget = workQueue.top();
         workQueue.pop();
@@ -384,14 +527,21 @@ void GL45VariableAllocationTexture::processWorkQueues() {
             if (!object->hasPendingTransfers()) {
                 continue;
             }
-            object->executeNextTransfer(texture);
+            transferredSize += object->executeNextTransfer(texture);
         } else {
             Q_UNREACHABLE();
         }
 
-        // Reinject into the queue if more work to be done
+        processedTextures.push_back(texture);
+        if (MemoryPressureState::Transfer != _memoryPressureState || transferredSize >= MAX_TRANSFER_SIZE_PER_FRAME ||
+                processedTextures.size() >= MAX_TRANSFER_TEXTURES_PER_FRAME) {
+            break;
+        }
+    }
+
+    // Reinject into the queue if more work to be done
+    for (const auto& texture : processedTextures) {
         addToWorkQueue(texture);
-        break;
     }
 
     if (workQueue.empty()) {
@@ -416,23 +566,27 @@ GL45VariableAllocationTexture::~GL45VariableAllocationTexture() {
     Backend::updateTextureGPUMemoryUsage(_size, 0);
 }
 
-void GL45VariableAllocationTexture::executeNextTransfer(const TexturePointer& currentTexture) {
+size_t GL45VariableAllocationTexture::executeNextTransfer(const TexturePointer& currentTexture) {
     if (_populatedMip <= _allocatedMip) {
-        return;
+        return 0;
     }
 
     if (_pendingTransfers.empty()) {
         populateTransferQueue();
     }
 
+    size_t transferredSize = 0;
     if (!_pendingTransfers.empty()) {
         // Keeping hold of a strong pointer during the transfer ensures that the transfer thread cannot try to access a destroyed texture
-        _currentTransferTexture = currentTexture;
-        if (_pendingTransfers.front()->tryTransfer()) {
+        _transferringTextures.insert(currentTexture);
+        const auto& transfer = _pendingTransfers.front();
+        if (transfer->tryTransfer()) {
+            transferredSize = transfer->getTransferSize();
             _pendingTransfers.pop();
-            _currentTransferTexture.reset();
+            _transferringTextures.erase(currentTexture);
         }
     }
+    return transferredSize;
 }
 
 // Managed size resource textures
@@ -486,12 +640,16 @@ void GL45ResourceTexture::copyMipsFromTexture() {
 
 void GL45ResourceTexture::syncSampler() const {
     Parent::syncSampler();
-    glTextureParameteri(_id, GL_TEXTURE_BASE_LEVEL, _populatedMip - _allocatedMip);
+    if (!isBindless()) {
+        glTextureParameteri(_id, GL_TEXTURE_BASE_LEVEL, _populatedMip - _allocatedMip);
+    }
 }
 
 void GL45ResourceTexture::promote() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
     Q_ASSERT(_allocatedMip > 0);
+    // the tables get the handle of the new texture the next time they are bound
+    releaseBindlessHandle();
     GLuint oldId = _id;
     uint32_t oldSize = _size;
     // create new texture
@@ -527,6 +685,7 @@ void GL45ResourceTexture::promote() {
 void GL45ResourceTexture::demote() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
     Q_ASSERT(_allocatedMip < _maxAllocatedMip);
+    releaseBindlessHandle();
     auto oldId = _id;
     auto oldSize = _size;
     const_cast<GLuint&>(_id) = allocate(_gpuObject);
@@ -585,11 +744,14 @@ void GL45ResourceTexture::populateTransferQueue() {
 
             // break down the transfers into chunks so that no single transfer is 
             // consuming more than X bandwidth
-            auto mipData = _gpuObject.accessStoredMipFace(sourceMip, face);
+            // the compressed mips are broken down in whole rows of blocks
+            auto mipSize = _gpuObject.getStoredMipFaceSize(sourceMip, face);
             const auto lines = mipDimensions.y;
-            auto bytesPerLine = (uint32_t)mipData->getSize() / lines;
-            Q_ASSERT(0 == (mipData->getSize() % lines));
-            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine);
+            const uint32_t linesPerRow = _gpuObject.getTexelFormat().isBlockCompressed() ? Element::BLOCK_SIZE : 1;
+            const uint32_t rows = (lines + linesPerRow - 1) / linesPerRow;
+            auto bytesPerRow = (uint32_t)mipSize / rows;
+            Q_ASSERT(0 == (mipSize % rows));
+            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerRow) * linesPerRow;
             uint32_t lineOffset = 0;
             while (lineOffset < lines) {
                 uint32_t linesToCopy = std::min<uint32_t>(lines - lineOffset, linesPerTransfer);
@@ -693,8 +855,7 @@ GL45SparseResourceTexture::GL45SparseResourceTexture(const std::weak_ptr<GLBacke
     glTextureParameteri(_id, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, pageDimensionsIndex);
     glGetTextureParameterIuiv(_id, GL_NUM_SPARSE_LEVELS_ARB, &_maxSparseLevel);
 
-    _pageBytes = _gpuObject.getTexelFormat().getSize();
-    _pageBytes *= _pageDimensions.x * _pageDimensions.y * _pageDimensions.z;
+    _pageBytes = _gpuObject.getTexelFormat().evalSize(_pageDimensions.x, _pageDimensions.y, _pageDimensions.z);
     // Testing with a simple texture allocating app shows an estimated 20% GPU memory overhead for 
     // sparse textures as compared to non-sparse, so we acount for that here.
     _pageBytes = (uint32_t)(_pageBytes * SPARSE_PAGE_SIZE_OVERHEAD_ESTIMATE);
@@ -65,6 +65,7 @@ Batch::Batch(const Batch& batch_) {
     _framebuffers._items.swap(batch._framebuffers._items);
     _drawCallInfos.swap(batch._drawCallInfos);
     _queries._items.swap(batch._queries._items);
+    _textureTables._items.swap(batch._textureTables._items);
     _lambdas._items.swap(batch._lambdas._items);
     _profileRanges._items.swap(batch._profileRanges._items);
     _names._items.swap(batch._names._items);
@@ -100,6 +101,7 @@ void Batch::clear() {
     _transforms.clear();
     _pipelines.clear();
     _framebuffers.clear();
+    _textureTables.clear();
     _objects.clear();
     _drawCallInfos.clear();
 }
@@ -174,6 +176,13 @@ void Batch::multiDrawIndexedIndirect(uint32 nbCommands, Primitive primitiveType)
     captureDrawCallInfo();
 }
 
+void Batch::dispatch(uint32 numGroupsX, uint32 numGroupsY, uint32 numGroupsZ) {
+    ADD_COMMAND(dispatch);
+    _params.emplace_back(numGroupsX);
+    _params.emplace_back(numGroupsY);
+    _params.emplace_back(numGroupsZ);
+}
+
 void Batch::setInputFormat(const Stream::FormatPointer& format) {
     ADD_COMMAND(setInputFormat);
 
@@ -302,6 +311,24 @@ void Batch::setResourceTexture(uint32 slot, const TextureView& view) {
     setResourceTexture(slot, view._texture);
 }
 
+void Batch::setResourceBuffer(uint32 slot, const BufferPointer& buffer) {
+    ADD_COMMAND(setResourceBuffer);
+    _params.emplace_back(_buffers.cache(buffer));
+    _params.emplace_back(slot);
+}
+
+void Batch::setResourceTextureTable(const TextureTablePointer& table, uint32 slot) {
+    ADD_COMMAND(setResourceTextureTable);
+    _params.emplace_back(_textureTables.cache(table));
+    _params.emplace_back(slot);
+}
+
+void Batch::setResourceTextureBuffer(uint32 slot, const BufferPointer& buffer) {
+    ADD_COMMAND(setResourceTextureBuffer);
+    _params.emplace_back(_buffers.cache(buffer));
+    _params.emplace_back(slot);
+}
+
 void Batch::setFramebuffer(const FramebufferPointer& framebuffer) {
     ADD_COMMAND(setFramebuffer);
 
@@ -354,6 +381,10 @@ void Batch::blit(const FramebufferPointer& src, const Vec4i& srcViewport,
     _params.emplace_back(dstViewport.w);
 }
 
+void Batch::textureBarrier() {
+    ADD_COMMAND(textureBarrier);
+}
+
 void Batch::generateTextureMips(const TexturePointer& texture) {
     ADD_COMMAND(generateTextureMips);
 
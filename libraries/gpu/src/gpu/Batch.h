@@ -23,6 +23,7 @@
 #include "Query.h"
 #include "Stream.h"
 #include "Texture.h"
+#include "TextureTable.h"
 #include "Transform.h"
 
 class QDebug;
@@ -124,6 +125,12 @@ public:
     void multiDrawIndirect(uint32 numCommands, Primitive primitiveType);
     void multiDrawIndexedIndirect(uint32 numCommands, Primitive primitiveType);
 
+    // Compute
+    // Run the compute program of the current pipeline on numGroupsX x numGroupsY x numGroupsZ work groups.
+    // The resource buffers it writes can be read by the following commands, including as indirect buffer.
+    // Only does anything when Context::supportsComputeShaders() is true
+    void dispatch(uint32 numGroupsX, uint32 numGroupsY = 1, uint32 numGroupsZ = 1);
+
     void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function);
     BufferPointer getNamedBuffer(const std::string& instanceName, uint8_t index = 0);
 
@@ -192,6 +199,13 @@ public:
     void setResourceTexture(uint32 slot, const TexturePointer& view);
     void setResourceTexture(uint32 slot, const TextureView& view); // not a command, just a shortcut from a TextureView
 
+    // Resource buffers are the storage buffers read and written by the shaders, bound to the layout binding slot
+    void setResourceBuffer(uint32 slot, const BufferPointer& buffer);
+    // Binds the textures of the table at once, see TextureTable
+    void setResourceTextureTable(const TextureTablePointer& table, uint32 slot = 0);
+    // Binds the buffer as a texture buffer of RGBA32F texels on the texture slot, read with texelFetch from a samplerBuffer
+    void setResourceTextureBuffer(uint32 slot, const BufferPointer& buffer);
+
     // Ouput Stage
     void setFramebuffer(const FramebufferPointer& framebuffer);
  
@@ -209,6 +223,10 @@ public:
     // with xy and zw the bounding corners of the rect region.
     void blit(const FramebufferPointer& src, const Vec4i& srcRect, const FramebufferPointer& dst, const Vec4i& dstRect);
 
+    // Make the texels written by the previous draws readable by the following ones while the texture is still a render
+    // buffer of the bound Framebuffer, as long as a draw doesn't read the texels it writes
+    void textureBarrier();
+
     // Generate the mips for a texture
     void generateTextureMips(const TexturePointer& texture);
 
@@ -273,6 +291,7 @@ public:
         COMMAND_drawIndexedInstanced,
         COMMAND_multiDrawIndirect,
         COMMAND_multiDrawIndexedIndirect,
+        COMMAND_dispatch,
 
         COMMAND_setInputFormat,
         COMMAND_setInputBuffer,
@@ -291,10 +310,14 @@ public:
 
         COMMAND_setUniformBuffer,
         COMMAND_setResourceTexture,
+        COMMAND_setResourceBuffer,
+        COMMAND_setResourceTextureTable,
+        COMMAND_setResourceTextureBuffer,
 
         COMMAND_setFramebuffer,
         COMMAND_clearFramebuffer,
         COMMAND_blit,
+        COMMAND_textureBarrier,
         COMMAND_generateTextureMips,
 
         COMMAND_beginQuery,
@@ -408,6 +431,7 @@ public:
     typedef Cache<PipelinePointer>::Vector PipelineCaches;
     typedef Cache<FramebufferPointer>::Vector FramebufferCaches;
     typedef Cache<QueryPointer>::Vector QueryCaches;
+    typedef Cache<TextureTablePointer>::Vector TextureTableCaches;
     typedef Cache<std::string>::Vector StringCaches;
     typedef Cache<std::function<void()>>::Vector LambdaCache;
 
@@ -462,6 +486,7 @@ public:
     PipelineCaches _pipelines;
     FramebufferCaches _framebuffers;
     QueryCaches _queries;
+    TextureTableCaches _textureTables;
     LambdaCache _lambdas;
     StringCaches _profileRanges;
     StringCaches _names;
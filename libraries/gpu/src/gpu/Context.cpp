@@ -13,6 +13,7 @@
 #include <shared/GlobalAppProperties.h>
 
 #include "Frame.h"
+#include "FrameIO.h"
 #include "GPULogging.h"
 
 using namespace gpu;
@@ -77,9 +78,27 @@ FramePointer Context::endFrame() {
 
     result->stereoState = _stereo;
     result->finish();
+
+    std::string captureFilename;
+    {
+        std::lock_guard<std::mutex> lock(_captureMutex);
+        captureFilename.swap(_captureFilename);
+    }
+    if (!captureFilename.empty()) {
+        if (writeFrame(captureFilename, *result)) {
+            qCDebug(gpulogging) << "Captured the frame to" << captureFilename.c_str();
+        } else {
+            qCWarning(gpulogging) << "Failed to capture the frame to" << captureFilename.c_str();
+        }
+    }
     return result;
 }
 
+void Context::captureFrame(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(_captureMutex);
+    _captureFilename = filename;
+}
+
 void Context::executeBatch(Batch& batch) const {
     PROFILE_RANGE(render_gpu, __FUNCTION__);
     batch.flush();
@@ -104,6 +123,9 @@ void Context::executeFrame(const FramePointer& frame) const {
     // FIXME? probably not necessary, but safe
     consumeFrameUpdates(frame);
     _backend->setStereoState(frame->stereoState);
+    if (_poseLatch) {
+        _backend->setCameraCorrection(glm::inverse(frame->pose) * _poseLatch(*frame));
+    }
     {
         Batch beginBatch;
         _frameRangeTimer->begin(beginBatch);
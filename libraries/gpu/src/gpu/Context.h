@@ -12,6 +12,7 @@
 #define hifi_gpu_Context_h
 
 #include <assert.h>
+#include <functional>
 #include <mutex>
 
 #include <GLMHelpers.h>
@@ -60,6 +61,9 @@ public:
     virtual void recycle() const = 0;
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) = 0;
 
+    // Corrects the views of the batches that follow, recorded with one pose and executed with another
+    virtual void setCameraCorrection(const Mat4& correction) {}
+
     // UBO class... layout MUST match the layout in Transform.slh
     class TransformCamera {
     public:
@@ -89,6 +93,8 @@ public:
     void getStats(ContextStats& stats) const { stats = _stats; }
 
     virtual bool isTextureManagementSparseEnabled() const = 0;
+    virtual bool supportsComputeShaders() const { return false; }
+    virtual bool supportsBindlessTextures() const { return false; }
 
     // These should only be accessed by Backend implementation to repport the buffer and texture allocations,
     // they are NOT public calls
@@ -156,11 +162,20 @@ public:
     void appendFrameBatch(Batch& batch);
     FramePointer endFrame();
 
+    // Writes the next frame ended to the file, to be replayed offline by the gpu-frame-player tool
+    void captureFrame(const std::string& filename);
+
     // MUST only be called on the rendering thread
     // 
     // Handle any pending operations to clean up (recycle / deallocate) resources no longer in use
     void recycle() const;
 
+    // True if the batches can dispatch compute programs and bind resource buffers
+    bool supportsComputeShaders() const { return _backend && _backend->supportsComputeShaders(); }
+
+    // True if the texture tables are resident handles in a uniform buffer rather than consecutive texture units
+    bool supportsBindlessTextures() const { return _backend && _backend->supportsBindlessTextures(); }
+
     // MUST only be called on the rendering thread
     // 
     // Execute a batch immediately, rather than as part of a frame
@@ -191,6 +206,15 @@ public:
     // being disabled, or in the null display plugin where no rendering actually occurs
     void consumeFrameUpdates(const FramePointer& frame) const;
 
+    // Returns the latest sensor pose, sampled on the rendering thread
+    using PoseLatch = std::function<Mat4(const Frame& frame)>;
+
+    // MUST only be called on the rendering thread
+    //
+    // Late-latches the pose of the frames: right before the batches of a frame are submitted, executeFrame corrects
+    // their views from the pose they were recorded with to the pose returned by the latch
+    void setPoseLatch(const PoseLatch& poseLatch) { _poseLatch = poseLatch; }
+
     const BackendPointer& getBackend() const { return _backend; }
 
     void enableStereo(bool enable = true);
@@ -236,6 +260,10 @@ protected:
     FramePointer _currentFrame;
     RangeTimerPointer _frameRangeTimer;
     StereoState  _stereo;
+    PoseLatch _poseLatch;
+
+    std::mutex _captureMutex;
+    std::string _captureFilename;
 
     // Sampled at the end of every frame, the stats of all the counters
     mutable ContextStats _frameStats;
@@ -20,6 +20,13 @@ const Element Element::COLOR_BGRA_32{ VEC4, NUINT8, BGRA };
 const Element Element::COLOR_SBGRA_32{ VEC4, NUINT8, SBGRA };
 
 const Element Element::COLOR_R11G11B10{ SCALAR, FLOAT, R11G11B10 };
+const Element Element::COLOR_COMPRESSED_BC1_SRGB{ VEC3, NUINT8, COMPRESSED_BC1_SRGB };
+const Element Element::COLOR_COMPRESSED_BC1_SRGBA{ VEC4, NUINT8, COMPRESSED_BC1_SRGBA };
+const Element Element::COLOR_COMPRESSED_BC3_SRGBA{ VEC4, NUINT8, COMPRESSED_BC3_SRGBA };
+const Element Element::COLOR_COMPRESSED_BC4_RED{ SCALAR, NUINT8, COMPRESSED_BC4_RED };
+const Element Element::COLOR_COMPRESSED_BC5_XY{ VEC2, NUINT8, COMPRESSED_BC5_XY };
+const Element Element::COLOR_COMPRESSED_BC7_SRGBA{ VEC4, NUINT8, COMPRESSED_BC7_SRGBA };
+const Element Element::COLOR_COMPRESSED_ASTC_4x4_SRGBA{ VEC4, NUINT8, COMPRESSED_ASTC_4x4_SRGBA };
 const Element Element::VEC4F_COLOR_RGBA{ VEC4, FLOAT, RGBA };
 const Element Element::VEC2F_UV{ VEC2, FLOAT, UV };
 const Element Element::VEC2F_XY{ VEC2, FLOAT, XY };
@@ -29,3 +36,29 @@ const Element Element::INDEX_UINT16 { SCALAR, UINT16, INDEX };
 const Element Element::INDEX_INT32 { SCALAR, INT32, INDEX };
 const Element Element::PART_DRAWCALL{ VEC4, UINT32, PART };
 
+uint32 Element::getBlockSize() const {
+    switch (getSemantic()) {
+        case COMPRESSED_BC1_SRGB:
+        case COMPRESSED_BC1_SRGBA:
+        case COMPRESSED_BC4_RED:
+            return 8;
+        case COMPRESSED_BC3_SRGBA:
+        case COMPRESSED_BC5_XY:
+        case COMPRESSED_BC7_SRGBA:
+        case COMPRESSED_ASTC_4x4_SRGBA:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+uint32 Element::evalSize(uint32 width, uint32 height, uint32 depth) const {
+    uint32 blockSize = getBlockSize();
+    if (blockSize) {
+        uint32 numBlocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        uint32 numBlocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        return numBlocksX * numBlocksY * depth * blockSize;
+    }
+    return width * height * depth * getSize();
+}
+
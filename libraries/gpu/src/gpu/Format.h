@@ -165,12 +165,16 @@ enum Semantic {
     COMPRESSED_SRGB,
     COMPRESSED_SRGBA,
 
-    // FIXME: Will have to be supported later:
-    /*COMPRESSED_BC3_RGBA,  // RGBA_S3TC_DXT5_EXT,
+    // Stored in blocks of 4x4 texels, the stored mips are in the same format as the GPU texture
+    _FIRST_BLOCK_COMPRESSED,
+    COMPRESSED_BC1_SRGB, // SRGB_S3TC_DXT1_EXT
+    COMPRESSED_BC1_SRGBA, // SRGB_ALPHA_S3TC_DXT1_EXT
     COMPRESSED_BC3_SRGBA, // SRGB_ALPHA_S3TC_DXT5_EXT
-
-    COMPRESSED_BC7_RGBA,
-    COMPRESSED_BC7_SRGBA, */
+    COMPRESSED_BC4_RED, // RED_RGTC1
+    COMPRESSED_BC5_XY, // RG_RGTC2
+    COMPRESSED_BC7_SRGBA, // SRGB_ALPHA_BPTC_UNORM
+    COMPRESSED_ASTC_4x4_SRGBA, // SRGB8_ALPHA8_ASTC_4x4_KHR
+    _LAST_BLOCK_COMPRESSED,
 
     _LAST_COMPRESSED,
 
@@ -207,6 +211,13 @@ public:
     Dimension getDimension() const { return (Dimension)_dimension; }
     
     bool isCompressed() const { return uint8(getSemantic() - _FIRST_COMPRESSED) <= uint8(_LAST_COMPRESSED - _FIRST_COMPRESSED); }
+    bool isBlockCompressed() const { return uint8(getSemantic() - _FIRST_BLOCK_COMPRESSED) <= uint8(_LAST_BLOCK_COMPRESSED - _FIRST_BLOCK_COMPRESSED); }
+    // The size of a block of BLOCK_SIZE x BLOCK_SIZE texels, 0 if the format isn't block compressed
+    uint32 getBlockSize() const;
+    static const uint32 BLOCK_SIZE = 4;
+
+    // The size of an image in this format, the block compressed ones are stored in whole blocks
+    uint32 evalSize(uint32 width, uint32 height, uint32 depth = 1) const;
 
     Type getType() const { return (Type)_type; }
     bool isNormalized() const { return (getType() >= NORMALIZED_START); }
@@ -236,6 +247,13 @@ public:
     static const Element COLOR_BGRA_32;
     static const Element COLOR_SBGRA_32;
     static const Element COLOR_R11G11B10;
+    static const Element COLOR_COMPRESSED_BC1_SRGB;
+    static const Element COLOR_COMPRESSED_BC1_SRGBA;
+    static const Element COLOR_COMPRESSED_BC3_SRGBA;
+    static const Element COLOR_COMPRESSED_BC4_RED;
+    static const Element COLOR_COMPRESSED_BC5_XY;
+    static const Element COLOR_COMPRESSED_BC7_SRGBA;
+    static const Element COLOR_COMPRESSED_ASTC_4x4_SRGBA;
     static const Element VEC4F_COLOR_RGBA;
     static const Element VEC2F_UV;
     static const Element VEC2F_XY;
@@ -0,0 +1,776 @@
+//
+//  FrameIO.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "FrameIO.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include <ktx/KTX.h>
+
+#include "Frame.h"
+#include "Framebuffer.h"
+#include "GPULogging.h"
+#include "Pipeline.h"
+#include "Query.h"
+#include "Shader.h"
+#include "State.h"
+#include "Stream.h"
+#include "Texture.h"
+#include "TextureTable.h"
+
+using namespace gpu;
+
+static const quint32 FRAME_FILE_MAGIC = 0x46474648; // "HFGF"
+static const quint32 FRAME_FILE_VERSION = 1;
+
+// The params of the commands hold offsets as wide as a pointer
+static const quint32 FRAME_FILE_PARAM_SIZE = sizeof(Batch::Param);
+
+static const qint32 NULL_INDEX = -1;
+
+enum TextureRecord : qint8 {
+    TEXTURE_KTX = 0, // the texture and its stored mips, as a ktx
+    TEXTURE_LAYOUT, // the layout of a texture rendered into, or whose mips are not all stored
+};
+
+static_assert(sizeof(Element) == sizeof(uint16), "Element is read back from its raw value");
+
+namespace {
+
+template <typename T>
+void writeRaw(QDataStream& out, const T& value) {
+    out.writeRawData(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void readRaw(QDataStream& in, T& value) {
+    in.readRawData(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void writeRawVector(QDataStream& out, const std::vector<T>& values) {
+    out << (quint32)values.size();
+    out.writeRawData(reinterpret_cast<const char*>(values.data()), (int)(values.size() * sizeof(T)));
+}
+
+void writeString(QDataStream& out, const std::string& value) {
+    out << QByteArray(value.data(), (int)value.size());
+}
+
+std::string readString(QDataStream& in) {
+    QByteArray value;
+    in >> value;
+    return std::string(value.constData(), value.size());
+}
+
+// A count of the records that follow, each of at least a byte, so a corrupt file can not make us allocate much
+quint32 readCount(QDataStream& in, quint32 recordSize = 1) {
+    quint32 count = 0;
+    in >> count;
+    if (in.status() != QDataStream::Ok || (qint64)count * recordSize > in.device()->bytesAvailable()) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return 0;
+    }
+    return count;
+}
+
+// The vector grows with the filler before its values are read over it, for the types without a default constructor
+template <typename T>
+void readRawVector(QDataStream& in, std::vector<T>& values, const T& filler = T()) {
+    quint32 count = readCount(in, sizeof(T));
+    values.assign(count, filler);
+    in.readRawData(reinterpret_cast<char*>(values.data()), (int)(count * sizeof(T)));
+}
+
+void writeTransform(QDataStream& out, const Transform& transform) {
+    writeRaw(out, transform.getRotation());
+    writeRaw(out, transform.getScale());
+    writeRaw(out, transform.getTranslation());
+}
+
+Transform readTransform(QDataStream& in) {
+    Transform::Quat rotation;
+    Transform::Vec3 scale;
+    Transform::Vec3 translation;
+    readRaw(in, rotation);
+    readRaw(in, scale);
+    readRaw(in, translation);
+    return Transform(rotation, scale, translation);
+}
+
+Element readElement(QDataStream& in) {
+    uint16 raw = 0;
+    readRaw(in, raw);
+    Element element;
+    memcpy(&element, &raw, sizeof(raw));
+    return element;
+}
+
+// The objects of a type referenced by the frame, written once each and referenced by their index
+template <typename T>
+class ObjectTable {
+public:
+    bool add(const std::shared_ptr<T>& object) {
+        if (!object || _indices.count(object.get())) {
+            return false;
+        }
+        _indices[object.get()] = (qint32)_objects.size();
+        _objects.push_back(object);
+        return true;
+    }
+
+    qint32 indexOf(const std::shared_ptr<T>& object) const {
+        auto it = object ? _indices.find(object.get()) : _indices.end();
+        return it != _indices.end() ? it->second : NULL_INDEX;
+    }
+
+    const std::vector<std::shared_ptr<T>>& getObjects() const { return _objects; }
+
+private:
+    std::vector<std::shared_ptr<T>> _objects;
+    std::unordered_map<const T*, qint32> _indices;
+};
+
+template <typename T>
+std::shared_ptr<T> getObject(const std::vector<std::shared_ptr<T>>& objects, qint32 index) {
+    return (index >= 0 && index < (qint32)objects.size()) ? objects[index] : std::shared_ptr<T>();
+}
+
+}
+
+namespace gpu {
+
+class FrameWriter {
+public:
+    FrameWriter(QDataStream& out) : _out(out) {}
+
+    void write(const Frame& frame);
+
+private:
+    void gather(const Frame& frame);
+    void addShader(const ShaderPointer& shader);
+    void addPipeline(const PipelinePointer& pipeline);
+    void addTexture(const TexturePointer& texture);
+    void addTextureTable(const TextureTablePointer& table);
+    void addFramebuffer(const FramebufferPointer& framebuffer);
+
+    void writeShader(const Shader& shader);
+    void writeTexture(const Texture& texture);
+    void writeBatch(const Batch& batch);
+
+    template <typename T, typename U>
+    void writeIndices(const ObjectTable<T>& table, const U& cache) {
+        _out << (quint32)cache._items.size();
+        for (auto& item : cache._items) {
+            _out << table.indexOf(item._data);
+        }
+    }
+
+    QDataStream& _out;
+
+    ObjectTable<Shader> _shaders;
+    ObjectTable<State> _states;
+    ObjectTable<Pipeline> _pipelines;
+    ObjectTable<Stream::Format> _formats;
+    ObjectTable<Buffer> _buffers;
+    ObjectTable<Texture> _textures;
+    ObjectTable<TextureTable> _textureTables;
+    ObjectTable<Framebuffer> _framebuffers;
+    ObjectTable<Query> _queries;
+};
+
+class FrameReader {
+public:
+    FrameReader(QDataStream& in) : _in(in) {}
+
+    FramePointer read();
+
+private:
+    ShaderPointer readShader();
+    TexturePointer readTexture();
+    void readBatch(Batch& batch);
+
+    template <typename T, typename U>
+    void readIndices(const std::vector<std::shared_ptr<T>>& objects, U& cache) {
+        quint32 count = readCount(_in, sizeof(qint32));
+        for (quint32 i = 0; i < count; i++) {
+            qint32 index;
+            _in >> index;
+            cache.cache(getObject(objects, index));
+        }
+    }
+
+    QDataStream& _in;
+
+    Shaders _shaders;
+    States _states;
+    Pipelines _pipelines;
+    std::vector<Stream::FormatPointer> _formats;
+    Buffers _buffers;
+    Textures _textures;
+    std::vector<TextureTablePointer> _textureTables;
+    std::vector<FramebufferPointer> _framebuffers;
+    Queries _queries;
+};
+
+}
+
+void FrameWriter::addShader(const ShaderPointer& shader) {
+    if (!shader || _shaders.indexOf(shader) != NULL_INDEX) {
+        return;
+    }
+    // the sub shaders are read before the programs made of them
+    for (auto& subShader : shader->getShaders()) {
+        addShader(subShader);
+    }
+    _shaders.add(shader);
+}
+
+void FrameWriter::addPipeline(const PipelinePointer& pipeline) {
+    if (_pipelines.add(pipeline)) {
+        addShader(pipeline->getProgram());
+        _states.add(pipeline->getState());
+    }
+}
+
+void FrameWriter::addTexture(const TexturePointer& texture) {
+    // the external textures belong to another context, they are replayed as no texture
+    if (texture && texture->getUsageType() != TextureUsageType::EXTERNAL) {
+        _textures.add(texture);
+    }
+}
+
+void FrameWriter::addTextureTable(const TextureTablePointer& table) {
+    if (_textureTables.add(table)) {
+        for (auto& texture : table->getTextures()) {
+            addTexture(texture);
+        }
+    }
+}
+
+void FrameWriter::addFramebuffer(const FramebufferPointer& framebuffer) {
+    // the swapchains belong to the display, they are replayed as the default framebuffer
+    if (!framebuffer || framebuffer->isSwapchain() || !_framebuffers.add(framebuffer)) {
+        return;
+    }
+    for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; slot++) {
+        addTexture(framebuffer->getRenderBuffer(slot));
+    }
+    addTexture(framebuffer->getDepthStencilBuffer());
+}
+
+void FrameWriter::gather(const Frame& frame) {
+    for (auto& batch : frame.batches) {
+        for (auto& item : batch._buffers._items) {
+            _buffers.add(item._data);
+        }
+        for (auto& namedData : batch._namedData) {
+            for (auto& buffer : namedData.second.buffers) {
+                _buffers.add(buffer);
+            }
+        }
+        for (auto& item : batch._textures._items) {
+            addTexture(item._data);
+        }
+        for (auto& item : batch._streamFormats._items) {
+            _formats.add(item._data);
+        }
+        for (auto& item : batch._pipelines._items) {
+            addPipeline(item._data);
+        }
+        for (auto& item : batch._framebuffers._items) {
+            addFramebuffer(item._data);
+        }
+        for (auto& item : batch._queries._items) {
+            _queries.add(item._data);
+        }
+        for (auto& item : batch._textureTables._items) {
+            addTextureTable(item._data);
+        }
+    }
+    addFramebuffer(frame.framebuffer);
+}
+
+void FrameWriter::writeShader(const Shader& shader) {
+    _out << (qint32)shader.getType();
+    if (!shader.isProgram()) {
+        writeString(_out, shader.getSource().getCode());
+        return;
+    }
+
+    _out << (quint32)shader.getShaders().size();
+    for (auto& subShader : shader.getShaders()) {
+        _out << _shaders.indexOf(subShader);
+    }
+
+    // the units the program was linked with, the batches bind their resources to these
+    std::vector<const Shader::Slot*> bindings;
+    for (auto& slot : shader.getBuffers()) {
+        bindings.push_back(&slot);
+    }
+    for (auto& slot : shader.getTextures()) {
+        bindings.push_back(&slot);
+    }
+    _out << (quint32)bindings.size();
+    for (auto slot : bindings) {
+        writeString(_out, slot->_name);
+        _out << (qint32)slot->_location;
+    }
+}
+
+void FrameWriter::writeTexture(const Texture& texture) {
+    bool isStored = texture.getUsageType() == TextureUsageType::RESOURCE ||
+        texture.getUsageType() == TextureUsageType::STRICT_RESOURCE;
+    for (uint16 level = 0; isStored && level <= texture.maxMip(); level++) {
+        for (uint8 face = 0; face < texture.getNumFaces(); face++) {
+            isStored = isStored && texture.isStoredMipFaceAvailable(level, face);
+        }
+    }
+    ktx::KTXUniquePointer ktx;
+    if (isStored) {
+        ktx = Texture::serialize(texture);
+    }
+
+    if (ktx) {
+        _out << (qint8)TEXTURE_KTX;
+        auto& storage = ktx->getStorage();
+        _out << QByteArray(reinterpret_cast<const char*>(storage->data()), (int)storage->size());
+    } else {
+        _out << (qint8)TEXTURE_LAYOUT;
+        _out << (qint32)texture.getUsageType() << (qint32)texture.getType();
+        writeRaw(_out, texture.getTexelFormat().getRaw());
+        writeRaw(_out, texture.getStoredMipFormat().getRaw());
+        _out << (quint16)texture.getWidth() << (quint16)texture.getHeight() << (quint16)texture.getDepth();
+        _out << (quint16)texture.getNumSamples() << (quint16)(texture.isArray() ? texture.getNumSlices() : 0);
+        _out << (quint16)texture.maxMip() << texture.isAutogenerateMips();
+        _out << (quint32)texture.getUsage()._flags.to_ulong();
+        writeRaw(_out, texture.getSampler().getDesc());
+    }
+    writeString(_out, texture.source());
+}
+
+void FrameWriter::writeBatch(const Batch& batch) {
+    writeRawVector(_out, batch._commands);
+    writeRawVector(_out, batch._commandOffsets);
+    writeRawVector(_out, batch._params);
+    writeRawVector(_out, batch._data);
+    writeRawVector(_out, batch._objects);
+    writeRawVector(_out, batch._drawCallInfos);
+    _out << batch._enableStereo << batch._enableSkybox << batch._invalidModel;
+    writeTransform(_out, batch._currentModel);
+
+    writeIndices(_buffers, batch._buffers);
+    writeIndices(_textures, batch._textures);
+    writeIndices(_formats, batch._streamFormats);
+    writeIndices(_pipelines, batch._pipelines);
+    writeIndices(_framebuffers, batch._framebuffers);
+    writeIndices(_queries, batch._queries);
+    writeIndices(_textureTables, batch._textureTables);
+
+    _out << (quint32)batch._transforms._items.size();
+    for (auto& item : batch._transforms._items) {
+        writeTransform(_out, item._data);
+    }
+    _out << (quint32)batch._profileRanges._items.size();
+    for (auto& item : batch._profileRanges._items) {
+        writeString(_out, item._data);
+    }
+    _out << (quint32)batch._names._items.size();
+    for (auto& item : batch._names._items) {
+        writeString(_out, item._data);
+    }
+    _out << (quint32)batch._lambdas._items.size();
+
+    // the named calls already ran in Frame::finish, the backend only needs their draw call infos
+    _out << (quint32)batch._namedData.size();
+    for (auto& namedData : batch._namedData) {
+        writeString(_out, namedData.first);
+        writeRawVector(_out, namedData.second.drawCallInfos);
+        _out << (quint32)namedData.second.buffers.size();
+        for (auto& buffer : namedData.second.buffers) {
+            _out << _buffers.indexOf(buffer);
+        }
+    }
+}
+
+void FrameWriter::write(const Frame& frame) {
+    gather(frame);
+
+    _out << FRAME_FILE_MAGIC << FRAME_FILE_VERSION << FRAME_FILE_PARAM_SIZE << (quint32)Batch::NUM_COMMANDS;
+
+    _out << (quint32)_shaders.getObjects().size();
+    for (auto& shader : _shaders.getObjects()) {
+        writeShader(*shader);
+    }
+
+    _out << (quint32)_states.getObjects().size();
+    for (auto& state : _states.getObjects()) {
+        writeRaw(_out, state->getValues());
+    }
+
+    _out << (quint32)_pipelines.getObjects().size();
+    for (auto& pipeline : _pipelines.getObjects()) {
+        _out << _shaders.indexOf(pipeline->getProgram()) << _states.indexOf(pipeline->getState());
+    }
+
+    _out << (quint32)_formats.getObjects().size();
+    for (auto& format : _formats.getObjects()) {
+        _out << (quint32)format->getAttributes().size();
+        for (auto& entry : format->getAttributes()) {
+            auto& attribute = entry.second;
+            _out << (quint8)attribute._slot << (quint8)attribute._channel;
+            writeRaw(_out, attribute._element.getRaw());
+            _out << (quint64)attribute._offset << (quint32)attribute._frequency;
+        }
+    }
+
+    _out << (quint32)_buffers.getObjects().size();
+    for (auto& buffer : _buffers.getObjects()) {
+        _out << QByteArray(reinterpret_cast<const char*>(buffer->getData()), (int)buffer->getSize());
+    }
+
+    _out << (quint32)_textures.getObjects().size();
+    for (auto& texture : _textures.getObjects()) {
+        writeTexture(*texture);
+    }
+
+    _out << (quint32)_textureTables.getObjects().size();
+    for (auto& table : _textureTables.getObjects()) {
+        for (auto& texture : table->getTextures()) {
+            _out << _textures.indexOf(texture);
+        }
+    }
+
+    _out << (quint32)_framebuffers.getObjects().size();
+    for (auto& framebuffer : _framebuffers.getObjects()) {
+        writeString(_out, framebuffer->getName());
+        for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; slot++) {
+            _out << _textures.indexOf(framebuffer->getRenderBuffer(slot));
+            _out << (quint32)framebuffer->getRenderBufferSubresource(slot);
+        }
+        _out << _textures.indexOf(framebuffer->getDepthStencilBuffer());
+        writeRaw(_out, framebuffer->getDepthStencilBufferFormat().getRaw());
+        _out << (quint32)framebuffer->getDepthStencilBufferSubresource();
+    }
+
+    _out << (quint32)_queries.getObjects().size();
+    for (auto& query : _queries.getObjects()) {
+        writeString(_out, query->getName());
+    }
+
+    _out << (quint32)frame.frameIndex;
+    writeRaw(_out, frame.pose);
+    writeRaw(_out, frame.stereoState);
+    _out << _framebuffers.indexOf(frame.framebuffer);
+
+    _out << (quint32)frame.batches.size();
+    for (auto& batch : frame.batches) {
+        writeBatch(batch);
+    }
+}
+
+ShaderPointer FrameReader::readShader() {
+    qint32 type;
+    _in >> type;
+    if (type != Shader::PROGRAM) {
+        Shader::Source source(readString(_in));
+        switch (type) {
+            case Shader::VERTEX:
+                return Shader::createVertex(source);
+            case Shader::PIXEL:
+                return Shader::createPixel(source);
+            case Shader::GEOMETRY:
+                return Shader::createGeometry(source);
+            case Shader::COMPUTE:
+                return Shader::createCompute(source);
+            default:
+                _in.setStatus(QDataStream::ReadCorruptData);
+                return ShaderPointer();
+        }
+    }
+
+    Shaders subShaders;
+    quint32 numSubShaders = readCount(_in, sizeof(qint32));
+    for (quint32 i = 0; i < numSubShaders; i++) {
+        qint32 index;
+        _in >> index;
+        subShaders.push_back(getObject(_shaders, index));
+    }
+    Shader::BindingSet bindings;
+    quint32 numBindings = readCount(_in);
+    for (quint32 i = 0; i < numBindings; i++) {
+        std::string name = readString(_in);
+        qint32 location;
+        _in >> location;
+        bindings.insert(Shader::Binding(name, location));
+    }
+
+    ShaderPointer program;
+    if (subShaders.size() == 1 && subShaders[0] && subShaders[0]->getType() == Shader::COMPUTE) {
+        program = Shader::createProgram(subShaders[0]);
+    } else if (subShaders.size() == 2 && subShaders[0] && subShaders[1]) {
+        program = Shader::createProgram(subShaders[0], subShaders[1]);
+    } else if (subShaders.size() == 3 && subShaders[0] && subShaders[1] && subShaders[2]) {
+        program = Shader::createProgram(subShaders[0], subShaders[1], subShaders[2]);
+    }
+    if (program) {
+        Shader::makeProgram(*program, bindings);
+    }
+    return program;
+}
+
+TexturePointer FrameReader::readTexture() {
+    qint8 record;
+    _in >> record;
+
+    TexturePointer texture;
+    if (record == TEXTURE_KTX) {
+        QByteArray bytes;
+        _in >> bytes;
+        auto storage = std::make_shared<storage::MemoryStorage>(bytes.size(), reinterpret_cast<const uint8_t*>(bytes.constData()));
+        auto ktx = ktx::KTX::create(storage);
+        texture.reset(Texture::unserialize(ktx));
+    } else if (record == TEXTURE_LAYOUT) {
+        qint32 usageType, type;
+        _in >> usageType >> type;
+        Element texelFormat = readElement(_in);
+        Element mipFormat = readElement(_in);
+        quint16 width, height, depth, numSamples, numSlices, maxMip;
+        bool isAutogenerateMips;
+        quint32 usage;
+        Sampler::Desc samplerDesc;
+        _in >> width >> height >> depth >> numSamples >> numSlices >> maxMip >> isAutogenerateMips >> usage;
+        readRaw(_in, samplerDesc);
+
+        if (type >= Texture::TEX_1D && type < Texture::NUM_TYPES) {
+            texture.reset(Texture::create((TextureUsageType)usageType, (Texture::Type)type, texelFormat, width, height, depth,
+                                          numSamples, numSlices, Sampler(samplerDesc)));
+            texture->setStoredMipFormat(mipFormat);
+            texture->setUsage(Texture::Usage(Texture::Usage::Flags(usage)));
+            if (isAutogenerateMips) {
+                texture->autoGenerateMips(maxMip);
+            } else {
+                // the mips rendered into, there is no stored mip to evaluate them from
+                texture->_maxMip = maxMip;
+            }
+        }
+    } else {
+        _in.setStatus(QDataStream::ReadCorruptData);
+    }
+
+    std::string source = readString(_in);
+    if (texture) {
+        texture->setSource(source);
+    }
+    return texture;
+}
+
+void FrameReader::readBatch(Batch& batch) {
+    readRawVector(_in, batch._commands);
+    readRawVector(_in, batch._commandOffsets);
+    readRawVector(_in, batch._params, Batch::Param((uint32)0));
+    readRawVector(_in, batch._data);
+    readRawVector(_in, batch._objects);
+    readRawVector(_in, batch._drawCallInfos, Batch::DrawCallInfo(0));
+    _in >> batch._enableStereo >> batch._enableSkybox >> batch._invalidModel;
+    batch._currentModel = readTransform(_in);
+
+    readIndices(_buffers, batch._buffers);
+    readIndices(_textures, batch._textures);
+    readIndices(_formats, batch._streamFormats);
+    readIndices(_pipelines, batch._pipelines);
+    readIndices(_framebuffers, batch._framebuffers);
+    readIndices(_queries, batch._queries);
+    readIndices(_textureTables, batch._textureTables);
+
+    quint32 numTransforms = readCount(_in);
+    for (quint32 i = 0; i < numTransforms; i++) {
+        batch._transforms.cache(readTransform(_in));
+    }
+    quint32 numProfileRanges = readCount(_in);
+    for (quint32 i = 0; i < numProfileRanges; i++) {
+        batch._profileRanges.cache(readString(_in));
+    }
+    quint32 numNames = readCount(_in);
+    for (quint32 i = 0; i < numNames; i++) {
+        batch._names.cache(readString(_in));
+    }
+    quint32 numLambdas;
+    _in >> numLambdas;
+    for (quint32 i = 0; i < numLambdas && _in.status() == QDataStream::Ok; i++) {
+        batch._lambdas.cache([] {});
+    }
+
+    quint32 numNamedData = readCount(_in);
+    for (quint32 i = 0; i < numNamedData; i++) {
+        auto& namedData = batch._namedData[readString(_in)];
+        readRawVector(_in, namedData.drawCallInfos, Batch::DrawCallInfo(0));
+        quint32 numBuffers = readCount(_in, sizeof(qint32));
+        for (quint32 j = 0; j < numBuffers; j++) {
+            qint32 index;
+            _in >> index;
+            namedData.buffers.push_back(getObject(_buffers, index));
+        }
+    }
+}
+
+FramePointer FrameReader::read() {
+    quint32 magic, version, paramSize, numCommands;
+    _in >> magic >> version >> paramSize >> numCommands;
+    if (magic != FRAME_FILE_MAGIC || version != FRAME_FILE_VERSION || paramSize != FRAME_FILE_PARAM_SIZE ||
+        numCommands != Batch::NUM_COMMANDS) {
+        qCWarning(gpulogging) << "The frame was not written by this build";
+        return FramePointer();
+    }
+
+    quint32 numShaders = readCount(_in);
+    for (quint32 i = 0; i < numShaders; i++) {
+        _shaders.push_back(readShader());
+    }
+
+    quint32 numStates = readCount(_in, sizeof(State::Data));
+    for (quint32 i = 0; i < numStates; i++) {
+        State::Data data;
+        readRaw(_in, data);
+        _states.push_back(std::make_shared<State>(data));
+    }
+
+    quint32 numPipelines = readCount(_in, 2 * sizeof(qint32));
+    for (quint32 i = 0; i < numPipelines; i++) {
+        qint32 programIndex, stateIndex;
+        _in >> programIndex >> stateIndex;
+        auto program = getObject(_shaders, programIndex);
+        auto state = getObject(_states, stateIndex);
+        _pipelines.push_back(program && state ? Pipeline::create(program, state) : PipelinePointer());
+    }
+
+    quint32 numFormats = readCount(_in);
+    for (quint32 i = 0; i < numFormats; i++) {
+        auto format = std::make_shared<Stream::Format>();
+        quint32 numAttributes = readCount(_in);
+        for (quint32 j = 0; j < numAttributes; j++) {
+            quint8 slot, channel;
+            quint64 offset;
+            quint32 frequency;
+            _in >> slot >> channel;
+            Element element = readElement(_in);
+            _in >> offset >> frequency;
+            format->setAttribute(slot, channel, element, (Offset)offset, (Stream::Frequency)frequency);
+        }
+        _formats.push_back(format);
+    }
+
+    quint32 numBuffers = readCount(_in);
+    for (quint32 i = 0; i < numBuffers; i++) {
+        QByteArray bytes;
+        _in >> bytes;
+        _buffers.push_back(std::make_shared<Buffer>(bytes.size(), reinterpret_cast<const Byte*>(bytes.constData())));
+    }
+
+    quint32 numTextures = readCount(_in);
+    for (quint32 i = 0; i < numTextures; i++) {
+        _textures.push_back(readTexture());
+    }
+
+    quint32 numTextureTables = readCount(_in, TextureTable::COUNT * sizeof(qint32));
+    for (quint32 i = 0; i < numTextureTables; i++) {
+        TextureTable::Array textures;
+        for (auto& texture : textures) {
+            qint32 index;
+            _in >> index;
+            texture = getObject(_textures, index);
+        }
+        _textureTables.push_back(std::make_shared<TextureTable>(textures));
+    }
+
+    quint32 numFramebuffers = readCount(_in);
+    for (quint32 i = 0; i < numFramebuffers; i++) {
+        FramebufferPointer framebuffer(Framebuffer::create(readString(_in)));
+        for (uint32 slot = 0; slot < Framebuffer::MAX_NUM_RENDER_BUFFERS; slot++) {
+            qint32 index;
+            quint32 subresource;
+            _in >> index >> subresource;
+            auto texture = getObject(_textures, index);
+            if (texture) {
+                framebuffer->setRenderBuffer(slot, texture, subresource);
+            }
+        }
+        qint32 depthIndex;
+        quint32 depthSubresource;
+        _in >> depthIndex;
+        Element depthFormat = readElement(_in);
+        _in >> depthSubresource;
+        auto depthTexture = getObject(_textures, depthIndex);
+        if (depthTexture) {
+            framebuffer->setDepthStencilBuffer(depthTexture, depthFormat, depthSubresource);
+        }
+        _framebuffers.push_back(framebuffer);
+    }
+
+    // the queries of the frame are replayed for their timing, nobody waits on their results
+    quint32 numQueries = readCount(_in);
+    for (quint32 i = 0; i < numQueries; i++) {
+        _queries.push_back(std::make_shared<Query>(Query::Handler(), readString(_in)));
+    }
+
+    auto frame = std::make_shared<Frame>();
+    quint32 frameIndex;
+    qint32 framebufferIndex;
+    _in >> frameIndex;
+    frame->frameIndex = frameIndex;
+    readRaw(_in, frame->pose);
+    readRaw(_in, frame->stereoState);
+    _in >> framebufferIndex;
+    frame->framebuffer = getObject(_framebuffers, framebufferIndex);
+
+    quint32 numBatches = readCount(_in);
+    frame->batches.resize(numBatches);
+    for (auto& batch : frame->batches) {
+        readBatch(batch);
+    }
+
+    if (_in.status() != QDataStream::Ok) {
+        qCWarning(gpulogging) << "The frame file is truncated or corrupt";
+        return FramePointer();
+    }
+
+    // the buffers are uploaded by the first execution of the frame, the later ones reuse them
+    for (auto& buffer : _buffers) {
+        frame->bufferUpdates.emplace_back(buffer->getUpdate());
+    }
+    return frame;
+}
+
+bool gpu::writeFrame(const std::string& filename, const Frame& frame) {
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(gpulogging) << "Could not open" << file.fileName() << "to write a frame";
+        return false;
+    }
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    FrameWriter(out).write(frame);
+    return out.status() == QDataStream::Ok;
+}
+
+FramePointer gpu::readFrame(const std::string& filename) {
+    QFile file(QString::fromStdString(filename));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(gpulogging) << "Could not open" << file.fileName() << "to read a frame";
+        return FramePointer();
+    }
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    return FrameReader(in).read();
+}
@@ -0,0 +1,32 @@
+//
+//  FrameIO.h
+//  libraries/gpu/src/gpu
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_FrameIO_h
+#define hifi_gpu_FrameIO_h
+
+#include <string>
+
+#include "Forward.h"
+
+namespace gpu {
+
+    // Writes a finished frame to a binary file: its batches, and the buffers, textures, pipelines and shader sources
+    // they reference. The file holds the raw params of the commands, so it is only read back by the same build.
+    // MUST be called after Frame::finish, on the recording thread
+    bool writeFrame(const std::string& filename, const Frame& frame);
+
+    // Reads a frame written by writeFrame, with the buffer updates that upload its buffers on its first execution.
+    // The lambdas of the batches are replayed as nothing, and the external textures and swapchains are not captured.
+    // MUST be called with the rendering context current, the programs are linked as they are read
+    FramePointer readFrame(const std::string& filename);
+
+};
+
+#endif
@@ -33,6 +33,7 @@ public:
         TEXTURE_2D_ARRAY,
         TEXTURE_3D_ARRAY,
         TEXTURE_CUBE_ARRAY,
+        TEXTURE_BUFFER,
     };
 
 protected:
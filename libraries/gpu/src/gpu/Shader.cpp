@@ -39,6 +39,12 @@ _type(type) {
     _shaders[PIXEL] = pixel;
 }
 
+Shader::Shader(Type type, const Pointer& compute) :
+_type(type) {
+    _shaders.resize(1);
+    _shaders[0] = compute;
+}
+
 Shader::~Shader()
 {
 }
@@ -55,6 +61,10 @@ Shader::Pointer Shader::createGeometry(const Source& source) {
     return Pointer(new Shader(GEOMETRY, source));
 }
 
+Shader::Pointer Shader::createCompute(const Source& source) {
+    return Pointer(new Shader(COMPUTE, source));
+}
+
 Shader::Pointer Shader::createProgram(const Pointer& vertexShader, const Pointer& pixelShader) {
     if (vertexShader && vertexShader->getType() == VERTEX &&
         pixelShader && pixelShader->getType() == PIXEL) {
@@ -72,6 +82,13 @@ Shader::Pointer Shader::createProgram(const Pointer& vertexShader, const Pointer
     return Pointer();
 }
 
+Shader::Pointer Shader::createProgram(const Pointer& computeShader) {
+    if (computeShader && computeShader->getType() == COMPUTE) {
+        return Pointer(new Shader(PROGRAM, computeShader));
+    }
+    return Pointer();
+}
+
 void Shader::defineSlots(const SlotSet& uniforms, const SlotSet& buffers, const SlotSet& textures, const SlotSet& samplers, const SlotSet& inputs, const SlotSet& outputs) {
     _uniforms = uniforms;
     _buffers = buffers;
@@ -106,6 +106,7 @@ public:
         VERTEX = 0,
         PIXEL,
         GEOMETRY,
+        COMPUTE,
         NUM_DOMAINS,
 
         PROGRAM,
@@ -114,9 +115,13 @@ public:
     static Pointer createVertex(const Source& source);
     static Pointer createPixel(const Source& source);
     static Pointer createGeometry(const Source& source);
+    static Pointer createCompute(const Source& source);
 
     static Pointer createProgram(const Pointer& vertexShader, const Pointer& pixelShader);
     static Pointer createProgram(const Pointer& vertexShader, const Pointer& geometryShader, const Pointer& pixelShader);
+    // A compute program is dispatched with Batch::dispatch, only supported by the backends where
+    // Context::supportsComputeShaders() is true
+    static Pointer createProgram(const Pointer& computeShader);
 
 
     ~Shader();
@@ -169,6 +174,7 @@ protected:
     Shader(Type type, const Source& source);
     Shader(Type type, const Pointer& vertex, const Pointer& pixel);
     Shader(Type type, const Pointer& vertex, const Pointer& geometry, const Pointer& pixel);
+    Shader(Type type, const Pointer& compute);
 
     Shader(const Shader& shader); // deep copy of the sysmem shader
     Shader& operator=(const Shader& shader); // deep copy of the sysmem texture
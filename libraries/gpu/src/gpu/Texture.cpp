@@ -20,6 +20,7 @@
 #include <Trace.h>
 
 #include <ktx/KTX.h>
+#include <MemoryBudget.h>
 #include <NumericalConstants.h>
 
 #include "GPULogging.h"
@@ -34,6 +35,7 @@ int TexturePointerMetaTypeId = qRegisterMetaType<TexturePointer>();
 std::atomic<uint32_t> Texture::_textureCPUCount{ 0 };
 std::atomic<Texture::Size> Texture::_textureCPUMemoryUsage{ 0 };
 std::atomic<Texture::Size> Texture::_allowedCPUMemoryUsage { 0 };
+std::atomic<Texture::Size> Texture::_memoryBudgetGPUMemoryUsage { 0 };
 
 
 #define MIN_CORES_FOR_INCREMENTAL_TEXTURES 5
@@ -115,7 +117,12 @@ uint32_t Texture::getTextureGPUTransferCount() {
 }
 
 Texture::Size Texture::getAllowedGPUMemoryUsage() {
-    return _allowedCPUMemoryUsage;
+    Size allowedMemoryUsage = _allowedCPUMemoryUsage;
+    Size budgetMemoryUsage = _memoryBudgetGPUMemoryUsage;
+    if (budgetMemoryUsage > 0 && (allowedMemoryUsage == 0 || budgetMemoryUsage < allowedMemoryUsage)) {
+        return budgetMemoryUsage;
+    }
+    return allowedMemoryUsage;
 }
 
 void Texture::setAllowedGPUMemoryUsage(Size size) {
@@ -123,6 +130,46 @@ void Texture::setAllowedGPUMemoryUsage(Size size) {
     _allowedCPUMemoryUsage = size;
 }
 
+void Texture::setMemoryBudgetGPUMemoryUsage(Size size) {
+    _memoryBudgetGPUMemoryUsage = size;
+}
+
+// the memory below which the memory budget does not demote the textures
+static const Texture::Size MIN_BUDGET_TEXTURE_MEMORY = MB_TO_BYTES(64);
+
+class TextureMemoryBudgetClient : public MemoryBudgetClient {
+public:
+    virtual QString getMemoryBudgetName() const override { return "Textures"; }
+    virtual Pool getMemoryBudgetPool() const override { return GPU; }
+
+    virtual qint64 getMemoryUsage() const override { return (qint64)Texture::getTextureGPUMemoryUsage(); }
+
+    // the framebuffers are not managed, only the resource textures can be demoted
+    virtual qint64 getReleasableMemory() const override {
+        qint64 managedUsage = (qint64)Texture::getTextureGPUMemoryUsage() -
+            (qint64)Texture::getTextureGPUFramebufferMemoryUsage();
+        return std::max(managedUsage - (qint64)MIN_BUDGET_TEXTURE_MEMORY, (qint64)0);
+    }
+
+    // a demoted mip is loaded again from the KTX cache on disk
+    virtual float getRebuildCost() const override { return 0.5f; }
+
+    virtual qint64 releaseMemory(qint64 size) override {
+        qint64 usage = (qint64)Texture::getTextureGPUMemoryUsage();
+        qint64 budget = std::max(usage - size, (qint64)MIN_BUDGET_TEXTURE_MEMORY);
+        Texture::setMemoryBudgetGPUMemoryUsage((Texture::Size)budget);
+        // the variable textures demote to the lowered budget on the render thread
+        return std::max(usage - budget, (qint64)0);
+    }
+
+    virtual void relaxMemory() override { Texture::setMemoryBudgetGPUMemoryUsage(0); }
+};
+
+MemoryBudgetClient* Texture::getMemoryBudgetClient() {
+    static TextureMemoryBudgetClient client;
+    return &client;
+}
+
 uint8 Texture::NUM_FACES_PER_TYPE[NUM_TYPES] = { 1, 1, 1, 6 };
 
 using Storage = Texture::Storage;
@@ -136,6 +183,11 @@ void Storage::assignTexture(Texture* texture) {
     }
 }
 
+Texture::Size Storage::getMipFaceSize(uint16 level, uint8 face) const {
+    PixelsPointer mipFace = getMipFace(level, face);
+    return mipFace ? mipFace->getSize() : 0;
+}
+
 void MemoryStorage::reset() {
     _mips.clear();
     bumpStamp();
@@ -215,6 +267,10 @@ Texture* Texture::createRenderBuffer(const Element& texelFormat, uint16 width, u
     return create(TextureUsageType::RENDERBUFFER, TEX_2D, texelFormat, width, height, 1, 1, 0, sampler);
 }
 
+Texture* Texture::createRenderBufferMultisample(const Element& texelFormat, uint16 width, uint16 height, uint16 numSamples, const Sampler& sampler) {
+    return create(TextureUsageType::RENDERBUFFER, TEX_2D, texelFormat, width, height, 1, numSamples, 0, sampler);
+}
+
 Texture* Texture::create1D(const Element& texelFormat, uint16 width, const Sampler& sampler) { 
     return create(TextureUsageType::RESOURCE, TEX_1D, texelFormat, width, 1, 1, 1, 0, sampler);
 }
@@ -311,7 +367,7 @@ Texture::Size Texture::resize(Type type, const Element& texelFormat, uint16 widt
         }
         
         // Evaluate the new size with the new format
-        uint32_t size = NUM_FACES_PER_TYPE[_type] *_width * _height * _depth * _numSamples * texelFormat.getSize();
+        uint32_t size = NUM_FACES_PER_TYPE[_type] * texelFormat.evalSize(_width, _height, _depth) * _numSamples;
 
         // If size change then we need to reset 
         if (changed || (size != getSize())) {
@@ -478,41 +534,36 @@ uint16 Texture::autoGenerateMips(uint16 maxMip) {
 }
 
 uint16 Texture::getStoredMipWidth(uint16 level) const {
-    PixelsPointer mipFace = accessStoredMipFace(level);
-    if (mipFace && mipFace->getSize()) {
+    if (getStoredMipFaceSize(level)) {
         return evalMipWidth(level);
     }
     return 0;
 }
 
 uint16 Texture::getStoredMipHeight(uint16 level) const {
-    PixelsPointer mip = accessStoredMipFace(level);
-    if (mip && mip->getSize()) {
+    if (getStoredMipFaceSize(level)) {
         return evalMipHeight(level);
     }
     return 0;
 }
 
 uint16 Texture::getStoredMipDepth(uint16 level) const {
-    PixelsPointer mipFace = accessStoredMipFace(level);
-    if (mipFace && mipFace->getSize()) {
+    if (getStoredMipFaceSize(level)) {
         return evalMipDepth(level);
     }
     return 0;
 }
 
 uint32 Texture::getStoredMipNumTexels(uint16 level) const {
-    PixelsPointer mipFace = accessStoredMipFace(level);
-    if (mipFace && mipFace->getSize()) {
+    if (getStoredMipFaceSize(level)) {
         return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level);
     }
     return 0;
 }
 
 uint32 Texture::getStoredMipSize(uint16 level) const {
-    PixelsPointer mipFace = accessStoredMipFace(level);
-    if (mipFace && mipFace->getSize()) {
-        return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level) * getTexelFormat().getSize();
+    if (getStoredMipFaceSize(level)) {
+        return evalMipFaceSize(level);
     }
     return 0;
 }
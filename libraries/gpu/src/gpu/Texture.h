@@ -22,6 +22,8 @@
 #include "Forward.h"
 #include "Resource.h"
 
+class MemoryBudgetClient;
+
 namespace ktx {
     class KTX;
     using KTXUniquePointer = std::unique_ptr<KTX>;
@@ -159,6 +161,7 @@ class Texture : public Resource {
     static std::atomic<uint32_t> _textureCPUCount;
     static std::atomic<Size> _textureCPUMemoryUsage;
     static std::atomic<Size> _allowedCPUMemoryUsage;
+    static std::atomic<Size> _memoryBudgetGPUMemoryUsage;
     static std::atomic<bool> _enableSparseTextures;
     static void updateTextureCPUMemoryUsage(Size prevObjectSize, Size newObjectSize);
 
@@ -177,6 +180,11 @@ public:
     static Size getAllowedGPUMemoryUsage();
     static void setAllowedGPUMemoryUsage(Size size);
 
+    // lowers the allowed memory while the GPU is short of it, 0 when it is not
+    static void setMemoryBudgetGPUMemoryUsage(Size size);
+    // the resource textures as a client of the memory budget, given back by demoting them
+    static MemoryBudgetClient* getMemoryBudgetClient();
+
     static bool getEnableSparseTextures();
     static void setEnableSparseTextures(bool enabled);
 
@@ -261,6 +269,7 @@ public:
 
         virtual void reset() = 0;
         virtual PixelsPointer getMipFace(uint16 level, uint8 face = 0) const = 0;
+        virtual Size getMipFaceSize(uint16 level, uint8 face = 0) const;
         virtual void assignMipData(uint16 level, const storage::StoragePointer& storage) = 0;
         virtual void assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) = 0;
         virtual bool isMipAvailable(uint16 level, uint8 face = 0) const = 0;
@@ -298,9 +307,12 @@ public:
     class KtxStorage : public Storage {
     public:
         KtxStorage(ktx::KTXUniquePointer& ktxData);
+        // Backed by the ktx file rather than by memory, each mip face is mapped from the file only while it is accessed
+        KtxStorage(const std::string& filename, const ktx::KTX& ktxData);
         PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override;
+        Size getMipFaceSize(uint16 level, uint8 face = 0) const override;
         // By convention, all mip levels and faces MUST be populated when using KTX backing
-        bool isMipAvailable(uint16 level, uint8 face = 0) const override { return true; }
+        bool isMipAvailable(uint16 level, uint8 face = 0) const override;
 
         void assignMipData(uint16 level, const storage::StoragePointer& storage) override {
             throw std::runtime_error("Invalid call");
@@ -312,7 +324,14 @@ public:
         void reset() override { }
 
     protected:
+        struct MipFaceRange {
+            size_t offset;
+            size_t size;
+        };
+
         ktx::KTXUniquePointer _ktxData;
+        std::string _filename;
+        std::vector<std::vector<MipFaceRange>> _mipFaceRanges; // the faces of each mip, in the file
         friend class Texture;
     };
 
@@ -321,6 +340,8 @@ public:
     static Texture* create3D(const Element& texelFormat, uint16 width, uint16 height, uint16 depth, const Sampler& sampler = Sampler());
     static Texture* createCube(const Element& texelFormat, uint16 width, const Sampler& sampler = Sampler());
     static Texture* createRenderBuffer(const Element& texelFormat, uint16 width, uint16 height, const Sampler& sampler = Sampler());
+    // A multisampled render buffer can't be sampled, it is resolved by a blit or read with texelFetch
+    static Texture* createRenderBufferMultisample(const Element& texelFormat, uint16 width, uint16 height, uint16 numSamples, const Sampler& sampler = Sampler());
     static Texture* createStrict(const Element& texelFormat, uint16 width, uint16 height, const Sampler& sampler = Sampler());
     static Texture* createExternal(const ExternalRecycler& recycler, const Sampler& sampler = Sampler());
 
@@ -362,7 +383,7 @@ public:
     uint16 getHeight() const { return _height; }
     uint16 getDepth() const { return _depth; }
 
-    uint32 getRowPitch() const { return getWidth() * getTexelFormat().getSize(); }
+    uint32 getRowPitch() const { return getTexelFormat().evalSize(getWidth(), 1); }
  
     // The number of faces is mostly used for cube map, and maybe for stereo ? otherwise it's 1
     // For cube maps, this means the pixels of the different faces are supposed to be packed back to back in a mip
@@ -407,14 +428,14 @@ public:
 
     // Size for each face of a mip at a particular level
     uint32 evalMipFaceNumTexels(uint16 level) const { return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level); }
-    uint32 evalMipFaceSize(uint16 level) const { return evalMipFaceNumTexels(level) * getTexelFormat().getSize(); }
+    uint32 evalMipFaceSize(uint16 level) const { return evalStoredMipFaceSize(level, getTexelFormat()); }
     
     // Total size for the mip
     uint32 evalMipNumTexels(uint16 level) const { return evalMipFaceNumTexels(level) * getNumFaces(); }
-    uint32 evalMipSize(uint16 level) const { return evalMipNumTexels(level) * getTexelFormat().getSize(); }
+    uint32 evalMipSize(uint16 level) const { return evalMipFaceSize(level) * getNumFaces(); }
 
-    uint32 evalStoredMipFaceSize(uint16 level, const Element& format) const { return evalMipFaceNumTexels(level) * format.getSize(); }
-    uint32 evalStoredMipSize(uint16 level, const Element& format) const { return evalMipNumTexels(level) * format.getSize(); }
+    uint32 evalStoredMipFaceSize(uint16 level, const Element& format) const { return format.evalSize(evalMipWidth(level), evalMipHeight(level), evalMipDepth(level)); }
+    uint32 evalStoredMipSize(uint16 level, const Element& format) const { return evalStoredMipFaceSize(level, format) * getNumFaces(); }
 
     uint32 evalTotalSize(uint16 startingMip = 0) const {
         uint32 size = 0;
@@ -478,9 +499,12 @@ public:
     // Access the the sub mips
     bool isStoredMipFaceAvailable(uint16 level, uint8 face = 0) const { return _storage->isMipAvailable(level, face); }
     const PixelsPointer accessStoredMipFace(uint16 level, uint8 face = 0) const { return _storage->getMipFace(level, face); }
+    Size getStoredMipFaceSize(uint16 level, uint8 face = 0) const { return _storage->getMipFaceSize(level, face); }
 
     void setStorage(std::unique_ptr<Storage>& newStorage);
     void setKtxBacking(ktx::KTXUniquePointer& newBacking);
+    // Backs the texture by a KTX file its mips are paged from as they are accessed, rather than by the whole file
+    bool setKtxBacking(const std::string& ktxFile);
 
     // access sizes for the stored mips
     uint16 getStoredMipWidth(uint16 level) const;
@@ -519,10 +543,15 @@ public:
     // Textures can be serialized directly to  ktx data file, here is how
     static ktx::KTXUniquePointer serialize(const Texture& texture);
     static Texture* unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
+    // The mips stay in the ktx file, they are paged in as the backend uploads them rather than copied in memory
+    static Texture* unserialize(const std::string& ktxFile, TextureUsageType usageType = TextureUsageType::RESOURCE, Usage usage = Usage(), const Sampler::Desc& sampler = Sampler::Desc());
     static bool evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header);
     static bool evalTextureFormat(const ktx::Header& header, Element& mipFormat, Element& texelFormat);
 
 protected:
+    // Recreates the layout of the captured textures rendered into
+    friend class FrameReader;
+
     const TextureUsageType _usageType;
 
     // Should only be accessed internally or by the backend sync function
@@ -565,6 +594,9 @@ protected:
    
     static Texture* create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, const Sampler& sampler);
 
+    // Creates the texture described by the header of the ktx, without its mips
+    static Texture* unserializeLayout(const ktx::KTX& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler, Element& mipFormat);
+
     Size resize(Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices);
 };
 
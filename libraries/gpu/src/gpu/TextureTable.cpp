@@ -0,0 +1,54 @@
+//
+//  TextureTable.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureTable.h"
+
+#include <algorithm>
+
+#include "Texture.h"
+
+using namespace gpu;
+
+TextureTable::TextureTable() { }
+
+TextureTable::TextureTable(const std::initializer_list<TexturePointer>& textures) {
+    auto max = std::min<size_t>(COUNT, textures.size());
+    auto itr = textures.begin();
+    for (size_t index = 0; index < max; ++index, ++itr) {
+        _textures[index] = *itr;
+    }
+}
+
+TextureTable::TextureTable(const Array& textures) : _textures(textures) {
+}
+
+void TextureTable::setTexture(size_t index, const TexturePointer& texture) {
+    if (index >= COUNT) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _textures[index] = texture;
+}
+
+void TextureTable::setTexture(size_t index, const TextureView& textureView) {
+    setTexture(index, textureView._texture);
+}
+
+TextureTable::Array TextureTable::getTextures() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _textures;
+}
+
+void TextureTable::addSlotBindings(Shader::BindingSet& bindings, const std::string& name, uint32 slot) {
+    bindings.insert(Shader::Binding(name + "Buffer", slot));
+    for (uint32 index = 0; index < COUNT; ++index) {
+        bindings.insert(Shader::Binding(name + std::to_string(index), slot + index));
+    }
+}
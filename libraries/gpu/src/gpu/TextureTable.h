@@ -0,0 +1,53 @@
+//
+//  TextureTable.h
+//  libraries/gpu/src/gpu
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_TextureTable_h
+#define hifi_gpu_TextureTable_h
+
+#include <array>
+#include <mutex>
+
+#include "Forward.h"
+#include "Shader.h"
+
+namespace gpu {
+
+// The textures of a material, bound in one go with Batch::setResourceTextureTable.
+// With bindless textures, the backend keeps the resident handles of the table in a uniform buffer,
+// otherwise the textures are bound to the texture units following the slot of the table.
+// Shaders declare it with declareTextureTable from TextureTable.slh.
+class TextureTable {
+public:
+    static const size_t COUNT = 8;
+    using Array = std::array<TexturePointer, COUNT>;
+
+    TextureTable();
+    TextureTable(const std::initializer_list<TexturePointer>& textures);
+    TextureTable(const Array& textures);
+
+    void setTexture(size_t index, const TexturePointer& texture);
+    void setTexture(size_t index, const TextureView& textureView);
+
+    Array getTextures() const;
+
+    // Binds the uniform buffer of the table, or its samplers, declared as name in the shader
+    static void addSlotBindings(Shader::BindingSet& bindings, const std::string& name, uint32 slot);
+
+    // Only for gpu::Context
+    const GPUObjectPointer gpuObject {};
+
+private:
+    mutable std::mutex _mutex;
+    Array _textures;
+};
+
+}
+
+#endif
@@ -60,8 +60,57 @@ KtxStorage::KtxStorage(ktx::KTXUniquePointer& ktxData) {
     _ktxData.reset(ktxData.release());
 }
 
+KtxStorage::KtxStorage(const std::string& filename, const ktx::KTX& ktxData) : _filename(filename) {
+    Format mipFormat = Format::COLOR_BGRA_32;
+    Format texelFormat = Format::COLOR_SRGBA_32;
+    if (ktxData.getHeader() && Texture::evalTextureFormat(*ktxData.getHeader(), mipFormat, texelFormat)) {
+        _format = mipFormat;
+    }
+
+    // only where the mips are in the file is kept, the parsed ktx is unmapped once the texture is created
+    const uint8_t* fileData = ktxData.getStorage()->data();
+    for (auto& image : ktxData._images) {
+        std::vector<MipFaceRange> faces;
+        for (uint32_t face = 0; face < image._numFaces; face++) {
+            faces.push_back({ (size_t)(image._faceBytes[face] - fileData), image._faceSize });
+        }
+        _mipFaceRanges.push_back(faces);
+    }
+}
+
 PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
-    return _ktxData->getMipFaceTexelsData(level, face);
+    if (_ktxData) {
+        return _ktxData->getMipFaceTexelsData(level, face);
+    }
+    if (level >= _mipFaceRanges.size() || face >= _mipFaceRanges[level].size()) {
+        return PixelsPointer();
+    }
+
+    // the mapping is undone when the caller is done with the mip, so the mips already uploaded are not resident
+    const auto& range = _mipFaceRanges[level][face];
+    auto mipFace = std::make_shared<storage::FileStorage>(QString::fromStdString(_filename), range.offset, range.size);
+    if (!*mipFace) {
+        // the file is gone from the cache, the mip is uploaded black rather than not at all
+        return std::make_shared<storage::MemoryStorage>(range.size);
+    }
+    return mipFace;
+}
+
+Texture::Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
+    if (_ktxData) {
+        return Storage::getMipFaceSize(level, face);
+    }
+    if (level >= _mipFaceRanges.size() || face >= _mipFaceRanges[level].size()) {
+        return 0;
+    }
+    return _mipFaceRanges[level][face].size;
+}
+
+bool KtxStorage::isMipAvailable(uint16 level, uint8 face) const {
+    if (_ktxData) {
+        return true;
+    }
+    return level < _mipFaceRanges.size() && face < _mipFaceRanges[level].size();
 }
 
 void Texture::setKtxBacking(ktx::KTXUniquePointer& ktxBacking) {
@@ -69,6 +118,25 @@ void Texture::setKtxBacking(ktx::KTXUniquePointer& ktxBacking) {
     setStorage(newBacking);
 }
 
+// the whole file is mapped to parse it, only the pages of the header and the key values are read
+static ktx::KTXUniquePointer readKTXFile(const std::string& ktxFile) {
+    auto fileStorage = std::make_shared<storage::FileStorage>(QString::fromStdString(ktxFile));
+    if (!*fileStorage) {
+        return ktx::KTXUniquePointer();
+    }
+    return ktx::KTX::create(fileStorage);
+}
+
+bool Texture::setKtxBacking(const std::string& ktxFile) {
+    auto ktxData = readKTXFile(ktxFile);
+    if (!ktxData) {
+        return false;
+    }
+    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(ktxFile, *ktxData));
+    setStorage(newBacking);
+    return true;
+}
+
 ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     ktx::Header header;
 
@@ -177,13 +245,10 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     return ktxBuffer;
 }
 
-Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
-    if (!srcData) {
-        return nullptr;
-    }
-    const auto& header = *srcData->getHeader();
+Texture* Texture::unserializeLayout(const ktx::KTX& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler, Element& mipFormat) {
+    const auto& header = *srcData.getHeader();
 
-    Format mipFormat = Format::COLOR_BGRA_32;
+    mipFormat = Format::COLOR_BGRA_32;
     Format texelFormat = Format::COLOR_SRGBA_32;
 
     if (!Texture::evalTextureFormat(header, mipFormat, texelFormat)) {
@@ -209,7 +274,7 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     
     // If found, use the 
     GPUKTXPayload gpuktxKeyValue;
-    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(srcData->_keyValues, gpuktxKeyValue);
+    bool isGPUKTXPayload = GPUKTXPayload::findInKeyValues(srcData._keyValues, gpuktxKeyValue);
 
     auto tex = Texture::create( (isGPUKTXPayload ? gpuktxKeyValue._usageType : usageType),
                                 type,
@@ -223,6 +288,20 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
 
     tex->setUsage((isGPUKTXPayload ? gpuktxKeyValue._usage : usage));
 
+    return tex;
+}
+
+Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    if (!srcData) {
+        return nullptr;
+    }
+
+    Element mipFormat;
+    auto tex = unserializeLayout(*srcData, usageType, usage, sampler, mipFormat);
+    if (!tex) {
+        return nullptr;
+    }
+
     // Assing the mips availables
     tex->setStoredMipFormat(mipFormat);
     uint16_t level = 0;
@@ -236,7 +315,58 @@ Texture* Texture::unserialize(const ktx::KTXUniquePointer& srcData, TextureUsage
     return tex;
 }
 
+Texture* Texture::unserialize(const std::string& ktxFile, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
+    auto ktxData = readKTXFile(ktxFile);
+    if (!ktxData) {
+        return nullptr;
+    }
+
+    Element mipFormat;
+    auto tex = unserializeLayout(*ktxData, usageType, usage, sampler, mipFormat);
+    if (!tex) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Storage> storage(new KtxStorage(ktxFile, *ktxData));
+    tex->setStorage(storage);
+    tex->_storage->assignTexture(tex);
+    tex->setStoredMipFormat(mipFormat);
+    tex->_maxMip = std::max((uint16)ktxData->_images.size(), (uint16)1) - 1;
+    tex->_stamp++;
+
+    return tex;
+}
+
+// The block compressed formats, stored in the KTX as they are uploaded
+struct KTXCompressedFormat {
+    Element format;
+    ktx::GLInternalFormat_Compressed internalFormat;
+    ktx::GLBaseInternalFormat baseInternalFormat;
+};
+static const KTXCompressedFormat KTX_COMPRESSED_FORMATS[] = {
+    { Format::COLOR_COMPRESSED_BC1_SRGB, ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1, ktx::GLBaseInternalFormat::RGB },
+    { Format::COLOR_COMPRESSED_BC1_SRGBA, ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT1, ktx::GLBaseInternalFormat::RGBA },
+    { Format::COLOR_COMPRESSED_BC3_SRGBA, ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5, ktx::GLBaseInternalFormat::RGBA },
+    { Format::COLOR_COMPRESSED_BC4_RED, ktx::GLInternalFormat_Compressed::COMPRESSED_RED_RGTC1, ktx::GLBaseInternalFormat::RED },
+    { Format::COLOR_COMPRESSED_BC5_XY, ktx::GLInternalFormat_Compressed::COMPRESSED_RG_RGTC2, ktx::GLBaseInternalFormat::RG },
+    { Format::COLOR_COMPRESSED_BC7_SRGBA, ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_BPTC_UNORM, ktx::GLBaseInternalFormat::RGBA },
+    { Format::COLOR_COMPRESSED_ASTC_4x4_SRGBA, ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4, ktx::GLBaseInternalFormat::RGBA },
+};
+
 bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat, ktx::Header& header) {
+    if (texelFormat.isBlockCompressed()) {
+        if (mipFormat != texelFormat) {
+            return false;
+        }
+        for (const auto& compressedFormat : KTX_COMPRESSED_FORMATS) {
+            if (compressedFormat.format == texelFormat) {
+                header.setCompressed(compressedFormat.internalFormat, compressedFormat.baseInternalFormat);
+                return true;
+            }
+        }
+        return false;
+    }
+
     if (texelFormat == Format::COLOR_RGBA_32 && mipFormat == Format::COLOR_BGRA_32) {
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::BGRA, ktx::GLInternalFormat_Uncompressed::RGBA8, ktx::GLBaseInternalFormat::RGBA);
     } else if (texelFormat == Format::COLOR_RGBA_32 && mipFormat == Format::COLOR_RGBA_32) {
@@ -255,7 +385,16 @@ bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat
 }
 
 bool Texture::evalTextureFormat(const ktx::Header& header, Element& mipFormat, Element& texelFormat) {
-    if (header.getGLFormat() == ktx::GLFormat::BGRA && header.getGLType() == ktx::GLType::UNSIGNED_BYTE && header.getTypeSize() == 1) {
+    if (header.getGLFormat() == ktx::GLFormat::COMPRESSED_FORMAT && header.getGLType() == ktx::GLType::COMPRESSED_TYPE) {
+        for (const auto& compressedFormat : KTX_COMPRESSED_FORMATS) {
+            if (compressedFormat.internalFormat == header.getGLInternaFormat_Compressed()) {
+                mipFormat = compressedFormat.format;
+                texelFormat = compressedFormat.format;
+                return true;
+            }
+        }
+        return false;
+    } else if (header.getGLFormat() == ktx::GLFormat::BGRA && header.getGLType() == ktx::GLType::UNSIGNED_BYTE && header.getTypeSize() == 1) {
         if (header.getGLInternaFormat_Uncompressed() == ktx::GLInternalFormat_Uncompressed::RGBA8) {
             mipFormat = Format::COLOR_BGRA_32;
             texelFormat = Format::COLOR_RGBA_32;
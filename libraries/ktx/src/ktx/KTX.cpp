@@ -48,7 +48,55 @@ size_t Header::evalPixelSize() const {
     return glTypeSize; // Really we should generate the size from the FOrmat etc
 }
 
+size_t Header::evalBlockSize() const {
+    if (getGLFormat() != GLFormat::COMPRESSED_FORMAT) {
+        return 0;
+    }
+    switch (getGLInternaFormat_Compressed()) {
+        case GLInternalFormat_Compressed::COMPRESSED_RGB_S3TC_DXT1:
+        case GLInternalFormat_Compressed::COMPRESSED_RGBA_S3TC_DXT1:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT1:
+        case GLInternalFormat_Compressed::COMPRESSED_RED_RGTC1:
+        case GLInternalFormat_Compressed::COMPRESSED_SIGNED_RED_RGTC1:
+        case GLInternalFormat_Compressed::COMPRESSED_RGB8_ETC2:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB8_ETC2:
+        case GLInternalFormat_Compressed::COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GLInternalFormat_Compressed::COMPRESSED_R11_EAC:
+        case GLInternalFormat_Compressed::COMPRESSED_SIGNED_R11_EAC:
+            return 8;
+        case GLInternalFormat_Compressed::COMPRESSED_RGBA_S3TC_DXT5:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
+        case GLInternalFormat_Compressed::COMPRESSED_RG_RGTC2:
+        case GLInternalFormat_Compressed::COMPRESSED_SIGNED_RG_RGTC2:
+        case GLInternalFormat_Compressed::COMPRESSED_RGBA_BPTC_UNORM:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GLInternalFormat_Compressed::COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        case GLInternalFormat_Compressed::COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+        case GLInternalFormat_Compressed::COMPRESSED_RGBA8_ETC2_EAC:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        case GLInternalFormat_Compressed::COMPRESSED_RG11_EAC:
+        case GLInternalFormat_Compressed::COMPRESSED_SIGNED_RG11_EAC:
+        case GLInternalFormat_Compressed::COMPRESSED_RGBA_ASTC_4x4:
+        case GLInternalFormat_Compressed::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
+            return 16;
+        default:
+            // The generic compressed formats are chosen by the driver, they are never stored
+            return 0;
+    }
+}
+
+static const uint32_t COMPRESSED_BLOCK_DIMENSION = 4;
+
 size_t Header::evalRowSize(uint32_t level) const {
+    // A row of blocks for the compressed formats, they are not padded
+    auto blockSize = evalBlockSize();
+    if (blockSize) {
+        auto numBlocks = (evalPixelWidth(level) + COMPRESSED_BLOCK_DIMENSION - 1) / COMPRESSED_BLOCK_DIMENSION;
+        return numBlocks * blockSize;
+    }
+
     auto pixWidth = evalPixelWidth(level);
     auto pixSize = evalPixelSize();
     auto netSize = pixWidth * pixSize;
@@ -59,6 +107,10 @@ size_t Header::evalFaceSize(uint32_t level) const {
     auto pixHeight = evalPixelHeight(level);
     auto pixDepth = evalPixelDepth(level);
     auto rowSize = evalRowSize(level);
+    if (evalBlockSize()) {
+        auto numRows = (pixHeight + COMPRESSED_BLOCK_DIMENSION - 1) / COMPRESSED_BLOCK_DIMENSION;
+        return pixDepth * numRows * rowSize;
+    }
     return pixDepth * pixHeight * rowSize;
 }
 size_t Header::evalImageSize(uint32_t level) const {
@@ -246,6 +246,14 @@ namespace ktx {
         COMPRESSED_SRGB = 0x8C48,
         COMPRESSED_SRGB_ALPHA = 0x8C49,
 
+        // EXT_texture_compression_s3tc and EXT_texture_sRGB
+        COMPRESSED_RGB_S3TC_DXT1 = 0x83F0,
+        COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1,
+        COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3,
+        COMPRESSED_SRGB_S3TC_DXT1 = 0x8C4C,
+        COMPRESSED_SRGB_ALPHA_S3TC_DXT1 = 0x8C4D,
+        COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F,
+
         COMPRESSED_RED_RGTC1 = 0x8DBB,
         COMPRESSED_SIGNED_RED_RGTC1 = 0x8DBC,
         COMPRESSED_RG_RGTC2 = 0x8DBD,
@@ -268,7 +276,11 @@ namespace ktx {
         COMPRESSED_RG11_EAC = 0x9272,
         COMPRESSED_SIGNED_RG11_EAC = 0x9273,
 
-         NUM_COMPRESSED_GLINTERNALFORMATS = 24,
+        // KHR_texture_compression_astc_ldr
+        COMPRESSED_RGBA_ASTC_4x4 = 0x93B0,
+        COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 = 0x93D0,
+
+         NUM_COMPRESSED_GLINTERNALFORMATS = 32,
     };
  
     enum class GLBaseInternalFormat : uint32_t {
@@ -340,6 +352,8 @@ namespace ktx {
         uint32_t evalPixelDepth(uint32_t level) const;
 
         size_t evalPixelSize() const;
+        // The size of a 4x4 texel block of the compressed formats, 0 for the uncompressed ones
+        size_t evalBlockSize() const;
         size_t evalRowSize(uint32_t level) const;
         size_t evalFaceSize(uint32_t level) const;
         size_t evalImageSize(uint32_t level) const;
@@ -0,0 +1,51 @@
+//
+//  FBXCache.cpp
+//  libraries/model-networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXCache.h"
+
+#include <FBXSerializer.h>
+#include <shared/Storage.h>
+
+using File = cache::File;
+using FilePointer = cache::FilePointer;
+
+FBXCache::FBXCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    initializeAsync();
+}
+
+FBXCache::~FBXCache() {
+    stopWriting();
+}
+
+void FBXCache::writeFileAsync(const QByteArray& data, Metadata&& metadata) {
+    FileCache::writeFileAsync(data, std::move(metadata), [](const FilePointer& file) {});
+}
+
+FBXFilePointer FBXCache::getFile(const Key& key) {
+    return std::static_pointer_cast<FBXFile>(FileCache::getFile(key));
+}
+
+std::unique_ptr<File> FBXCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote FBX geometry" << metadata.key.c_str();
+    return std::unique_ptr<File>(new FBXFile(std::move(metadata), filepath));
+}
+
+FBXFile::FBXFile(Metadata&& metadata, const std::string& filepath) :
+    cache::File(std::move(metadata), filepath) {}
+
+FBXGeometry* FBXFile::getGeometry(const QString& url) const {
+    storage::FileStorage storage(getFilepath().c_str());
+    if (!storage) {
+        return nullptr;
+    }
+    return readSerializedFBXGeometry(storage.data(), storage.size(), url);
+}
@@ -0,0 +1,52 @@
+//
+//  FBXCache.h
+//  libraries/model-networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXCache_h
+#define hifi_FBXCache_h
+
+#include <QString>
+
+#include <FileCache.h>
+
+class FBXGeometry;
+
+class FBXFile;
+using FBXFilePointer = std::shared_ptr<FBXFile>;
+
+/// The geometries read from models, serialized by serializeFBXGeometry and keyed by the hash of the model and its mapping
+class FBXCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    FBXCache(const std::string& dir, const std::string& ext);
+    ~FBXCache();
+
+    void writeFileAsync(const QByteArray& data, Metadata&& metadata);
+    FBXFilePointer getFile(const Key& key);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+class FBXFile : public cache::File {
+    Q_OBJECT
+
+public:
+    /// reads the geometry from the mapped file, null if it can't be read
+    FBXGeometry* getGeometry(const QString& url) const;
+
+protected:
+    friend class FBXCache;
+
+    FBXFile(Metadata&& metadata, const std::string& filepath);
+};
+
+#endif // hifi_FBXCache_h
@@ -18,7 +18,11 @@ using FilePointer = cache::FilePointer;
 
 KTXCache::KTXCache(const std::string& dir, const std::string& ext) :
     FileCache(dir, ext) {
-    initialize();
+    initializeAsync();
+}
+
+KTXCache::~KTXCache() {
+    stopWriting();
 }
 
 KTXFilePointer KTXCache::writeFile(const char* data, Metadata&& metadata) {
@@ -26,6 +30,13 @@ KTXFilePointer KTXCache::writeFile(const char* data, Metadata&& metadata) {
     return std::static_pointer_cast<KTXFile>(file);
 }
 
+void KTXCache::writeFileAsync(const QByteArray& data, Metadata&& metadata,
+                              std::function<void(const KTXFilePointer&)> callback) {
+    FileCache::writeFileAsync(data, std::move(metadata), [callback](const FilePointer& file) {
+        callback(std::static_pointer_cast<KTXFile>(file));
+    });
+}
+
 KTXFilePointer KTXCache::getFile(const Key& key) {
     return std::static_pointer_cast<KTXFile>(FileCache::getFile(key));
 }
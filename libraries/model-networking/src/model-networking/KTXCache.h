@@ -12,6 +12,8 @@
 #ifndef hifi_KTXCache_h
 #define hifi_KTXCache_h
 
+#include <functional>
+
 #include <QUrl>
 
 #include <FileCache.h>
@@ -28,8 +30,10 @@ class KTXCache : public cache::FileCache {
 
 public:
     KTXCache(const std::string& dir, const std::string& ext);
+    ~KTXCache();
 
     KTXFilePointer writeFile(const char* data, Metadata&& metadata);
+    void writeFileAsync(const QByteArray& data, Metadata&& metadata, std::function<void(const KTXFilePointer&)> callback);
     KTXFilePointer getFile(const Key& key);
 
 protected:
@@ -10,14 +10,19 @@
 //
 
 #include "ModelCache.h"
+
+#include <algorithm>
+
 #include <Finally.h>
 #include <FSTReader.h>
 #include "FBXReader.h"
+#include "FBXSerializer.h"
 #include "OBJReader.h"
 
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QCryptographicHash>
 #include <QThreadPool>
 
 #include "ModelNetworkingLogging.h"
@@ -26,6 +31,9 @@
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
+const std::string ModelCache::FBX_DIRNAME { "fbx_cache" };
+const std::string ModelCache::FBX_EXT { "fbxgeom" };
+
 class GeometryReader;
 
 class GeometryExtra {
@@ -114,6 +122,7 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
         _fbxGeometry = _geometryResource->_fbxGeometry;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _blendshapeBuffers = _geometryResource->_blendshapeBuffers;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -126,6 +135,36 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
     finishedLoading(success);
 }
 
+// adds the mapping to the hash in the same order whatever the order of its hashes
+static void addMappingToHash(QCryptographicHash& hasher, const QVariant& value) {
+    if (value.type() == QVariant::Hash) {
+        auto hash = value.toHash();
+        auto keys = hash.uniqueKeys();
+        std::sort(keys.begin(), keys.end());
+        for (const auto& key : keys) {
+            hasher.addData(key.toUtf8());
+            for (const auto& keyValue : hash.values(key)) {
+                addMappingToHash(hasher, keyValue);
+            }
+        }
+    } else if (value.type() == QVariant::List) {
+        for (const auto& element : value.toList()) {
+            addMappingToHash(hasher, element);
+        }
+    } else {
+        hasher.addData(value.toString().toUtf8());
+    }
+}
+
+// the geometry read from a model depends on the model, its mapping, and its url through the texture paths
+static std::string getGeometryHash(const QByteArray& data, const QVariantHash& mapping, const QUrl& url) {
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    hasher.addData(data);
+    hasher.addData(url.path().toUtf8());
+    addMappingToHash(hasher, mapping);
+    return hasher.result().toHex().toStdString();
+}
+
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(QWeakPointer<Resource>& resource, const QUrl& url, const QVariantHash& mapping,
@@ -157,9 +196,13 @@ void GeometryReader::run() {
         QThread::currentThread()->setPriority(originalPriority);
     });
 
-    if (!_resource.data()) {
-        qCWarning(modelnetworking) << "Abandoning load of" << _url << "; resource was deleted";
-        return;
+    {
+        auto resource = _resource.toStrongRef();
+        if (!resource) {
+            qCWarning(modelnetworking) << "Abandoning load of" << _url << "; resource was deleted";
+            return;
+        }
+        resource->markTimeline(Resource::DecodeStarted);
     }
 
     try {
@@ -173,9 +216,24 @@ void GeometryReader::run() {
             FBXGeometry::Pointer fbxGeometry;
 
             if (_url.path().toLower().endsWith(".fbx")) {
-                fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
-                if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
-                    throw QString("empty geometry, possibly due to an unsupported FBX version");
+                // the geometry of a model read before is in the FBX cache, the OBJ models aren't cached as their
+                // materials are downloaded separately
+                auto modelCache = DependencyManager::get<ModelCache>();
+                auto hash = getGeometryHash(_data, _mapping, _url);
+                auto fbxFile = modelCache->_fbxCache.getFile(hash);
+                if (fbxFile) {
+                    fbxGeometry.reset(fbxFile->getGeometry(_url.path()));
+                }
+
+                if (!fbxGeometry) {
+                    fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
+                    if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
+                        throw QString("empty geometry, possibly due to an unsupported FBX version");
+                    }
+
+                    auto serializedGeometry = serializeFBXGeometry(*fbxGeometry);
+                    modelCache->_fbxCache.writeFileAsync(serializedGeometry,
+                        FBXCache::Metadata(hash, serializedGeometry.size()));
                 }
             } else if (_url.path().toLower().endsWith(".obj")) {
                 fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _url));
@@ -188,6 +246,7 @@ void GeometryReader::run() {
             if (!resource) {
                 qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
             } else {
+                resource->markTimeline(Resource::DecodeFinished);
                 QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                     Q_ARG(FBXGeometry::Pointer, fbxGeometry));
             }
@@ -227,6 +286,57 @@ void GeometryDefinitionResource::downloadFinished(const QByteArray& data) {
     QThreadPool::globalInstance()->start(new GeometryReader(_self, _url, _mapping, data));
 }
 
+static std::shared_ptr<const Geometry::BlendshapeBuffers> buildBlendshapeBuffers(const FBXMesh& mesh) {
+    const int numVertices = mesh.vertices.size();
+    if (mesh.blendshapes.isEmpty() || mesh.normals.size() != numVertices) {
+        return nullptr;
+    }
+
+    // The deltas are sorted by vertex, so each vertex only goes through its own
+    std::vector<glm::uvec2> offsets(numVertices + 1, glm::uvec2(0));
+    offsets[0].x = (uint32_t)numVertices;
+    for (const FBXBlendshape& blendshape : mesh.blendshapes) {
+        for (int index : blendshape.indices) {
+            if (index >= 0 && index < numVertices) {
+                offsets[index + 1].y++;
+            }
+        }
+    }
+    uint32_t numDeltas = 0;
+    for (int i = 0; i < numVertices; i++) {
+        offsets[i + 1].x = numDeltas;
+        numDeltas += offsets[i + 1].y;
+    }
+    if (numDeltas == 0) {
+        return nullptr;
+    }
+
+    std::vector<glm::vec4> deltas(2 * numDeltas);
+    std::vector<uint32_t> cursors(numVertices, 0);
+    for (int b = 0; b < mesh.blendshapes.size(); b++) {
+        const FBXBlendshape& blendshape = mesh.blendshapes.at(b);
+        for (int j = 0; j < blendshape.indices.size(); j++) {
+            int index = blendshape.indices.at(j);
+            if (index < 0 || index >= numVertices) {
+                continue;
+            }
+            uint32_t delta = offsets[index + 1].x + cursors[index]++;
+            deltas[2 * delta] = glm::vec4(blendshape.vertices.at(j), (float)b);
+            deltas[2 * delta + 1] = glm::vec4(j < blendshape.normals.size() ? blendshape.normals.at(j) : glm::vec3(0.0f), 0.0f);
+        }
+    }
+
+    auto buffers = std::make_shared<Geometry::BlendshapeBuffers>();
+    buffers->numVertices = (uint32_t)numVertices;
+    buffers->offsets = std::make_shared<gpu::Buffer>(offsets.size() * sizeof(glm::uvec2), (const gpu::Byte*)offsets.data());
+    buffers->deltas = std::make_shared<gpu::Buffer>(deltas.size() * sizeof(glm::vec4), (const gpu::Byte*)deltas.data());
+    buffers->vertices = std::make_shared<gpu::Buffer>();
+    buffers->vertices->resize(2 * numVertices * sizeof(glm::vec3));
+    buffers->vertices->setSubData(0, numVertices * sizeof(glm::vec3), (const gpu::Byte*)mesh.vertices.constData());
+    buffers->vertices->setSubData(numVertices * sizeof(glm::vec3), numVertices * sizeof(glm::vec3), (const gpu::Byte*)mesh.normals.constData());
+    return buffers;
+}
+
 void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxGeometry) {
     // Assume ownership of the geometry pointer
     _fbxGeometry = fbxGeometry;
@@ -240,10 +350,12 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
 
     std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
     std::shared_ptr<GeometryMeshParts> parts = std::make_shared<GeometryMeshParts>();
+    std::shared_ptr<GeometryBlendshapeBuffers> blendshapeBuffers = std::make_shared<GeometryBlendshapeBuffers>();
     int meshID = 0;
     for (const FBXMesh& mesh : _fbxGeometry->meshes) {
         // Copy mesh pointers
         meshes->emplace_back(mesh._mesh);
+        blendshapeBuffers->emplace_back(buildBlendshapeBuffers(mesh));
         int partID = 0;
         for (const FBXMeshPart& part : mesh.parts) {
             // Construct local parts
@@ -254,13 +366,18 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     }
     _meshes = meshes;
     _meshParts = parts;
+    _blendshapeBuffers = blendshapeBuffers;
 
     finishedLoading(true);
 }
 
-ModelCache::ModelCache() {
+ModelCache::ModelCache() :
+    _fbxCache(FBX_DIRNAME, FBX_EXT) {
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
+    // a geometry is parsed again from its file and uploaded again, the costliest cache to refill
+    const float GEOMETRY_REBUILD_COST = 4.0f;
+    setRebuildCost(GEOMETRY_REBUILD_COST);
     setObjectName("ModelCache");
 }
 
@@ -308,6 +425,7 @@ Geometry::Geometry(const Geometry& geometry) {
     _fbxGeometry = geometry._fbxGeometry;
     _meshes = geometry._meshes;
     _meshParts = geometry._meshParts;
+    _blendshapeBuffers = geometry._blendshapeBuffers;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -354,8 +472,9 @@ bool Geometry::areTexturesLoaded() const {
                     return false;
                 }
                 // Failed texture downloads need to be considered as 'loaded' 
-                // or the object will never fade in
-                bool finished = texture->isLoaded() || texture->isFailed();
+                // or the object will never fade in, nor does it wait for the rest of a texture that is shown at a low
+                // resolution while it downloads
+                bool finished = texture->isLoaded() || texture->isFailed() || texture->getGPUTexture();
                 if (!finished) {
                     return true;
                 }
@@ -18,6 +18,7 @@
 #include <model/Material.h>
 #include <model/Asset.h>
 
+#include "FBXCache.h"
 #include "FBXReader.h"
 #include "TextureCache.h"
 
@@ -41,6 +42,17 @@ public:
     using GeometryMeshes = std::vector<std::shared_ptr<const model::Mesh>>;
     using GeometryMeshParts = std::vector<std::shared_ptr<const MeshPart>>;
 
+    // The blendshapes of a mesh packed for the GPU blending, once per geometry
+    class BlendshapeBuffers {
+    public:
+        uint32_t numVertices { 0 };
+        gpu::BufferPointer offsets; // the number of vertices, then per vertex the first and the number of its deltas
+        gpu::BufferPointer deltas; // per delta, vec4(position delta, blendshape index) then vec4(normal delta, 0)
+        gpu::BufferPointer vertices; // the unblended positions then normals
+    };
+    // Null for the meshes without blendshapes, or without a normal per vertex
+    using GeometryBlendshapeBuffers = std::vector<std::shared_ptr<const BlendshapeBuffers>>;
+
     // Mutable, but must retain structure of vector
     using NetworkMaterials = std::vector<std::shared_ptr<NetworkMaterial>>;
 
@@ -48,6 +60,7 @@ public:
 
     const FBXGeometry& getFBXGeometry() const { return *_fbxGeometry; }
     const GeometryMeshes& getMeshes() const { return *_meshes; }
+    const GeometryBlendshapeBuffers& getBlendshapeBuffers() const { return *_blendshapeBuffers; }
     const std::shared_ptr<const NetworkMaterial> getShapeMaterial(int shapeID) const;
 
     const QVariantMap getTextures() const;
@@ -63,6 +76,7 @@ protected:
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
+    std::shared_ptr<const GeometryBlendshapeBuffers> _blendshapeBuffers;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
@@ -112,6 +126,7 @@ public:
     void setResource(GeometryResource::Pointer resource);
 
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
+    const GeometryResource::Pointer& getResource() const { return _resource; }
 
 private:
     void startWatching();
@@ -145,8 +160,14 @@ protected:
         const void* extra) override;
 
 private:
+    friend class GeometryReader;
+
     ModelCache();
     virtual ~ModelCache() = default;
+
+    static const std::string FBX_DIRNAME;
+    static const std::string FBX_EXT;
+    FBXCache _fbxCache; // the geometries read from FBX models, so a model is parsed once rather than every session
 };
 
 class NetworkMaterial : public model::Material {
@@ -13,6 +13,7 @@
 
 #include <mutex>
 
+#include <QBuffer>
 #include <QNetworkReply>
 #include <QPainter>
 #include <QRunnable>
@@ -34,7 +35,10 @@
 #include <NumericalConstants.h>
 #include <shared/NsightHelpers.h>
 
+#include <AssetUtils.h>
 #include <Finally.h>
+#include <ResourceManager.h>
+#include <ResourceRequest.h>
 
 #include "ModelNetworkingLogging.h"
 #include <Trace.h>
@@ -47,11 +51,17 @@ Q_LOGGING_CATEGORY(trace_resource_parse_image_ktx, "trace.resource.parse.image.k
 const std::string TextureCache::KTX_DIRNAME { "ktx_cache" };
 const std::string TextureCache::KTX_EXT { "ktx" };
 
+static const int MAX_IMAGE_READER_THREADS = 4;
+static const size_t IMAGE_READER_MEMORY_BUDGET = 256 * 1024 * 1024; // of the images decoded at once
+
 TextureCache::TextureCache() :
     _ktxCache(KTX_DIRNAME, KTX_EXT) {
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
 
+    // leave a core to the rest of the application
+    _imageReaderPool.setMaxThreadCount(std::max(std::min(QThread::idealThreadCount() - 1, MAX_IMAGE_READER_THREADS), 1));
+
     // Expose enum Type to JS/QML via properties
     // Despite being one-off, this should be fine, because TextureCache is a SINGLETON_DEPENDENCY
     QObject* type = new QObject(this);
@@ -64,6 +74,14 @@ TextureCache::TextureCache() :
 }
 
 TextureCache::~TextureCache() {
+    {
+        std::lock_guard<std::mutex> lock(_imageReadersMutex);
+        for (auto reader : _pendingImageReaders) {
+            delete reader;
+        }
+        _pendingImageReaders.clear();
+    }
+    _imageReaderPool.waitForDone();
 }
 
 // use fixed table of permutations. Could also make ordered list programmatically
@@ -255,8 +273,7 @@ gpu::TexturePointer getFallbackTextureForType(NetworkTexture::Type type) {
 }
 
 
-NetworkTexture::TextureLoaderFunc getTextureLoaderForType(NetworkTexture::Type type,
-                                                          const QVariantMap& options = QVariantMap()) {
+NetworkTexture::TextureLoaderFunc NetworkTexture::getTextureLoaderForType(Type type, const QVariantMap& options) {
     using Type = NetworkTexture;
 
     switch (type) {
@@ -318,10 +335,24 @@ NetworkTexture::TextureLoaderFunc getTextureLoaderForType(NetworkTexture::Type t
     }
 }
 
+QString NetworkTexture::getTextureUsage(Type type) {
+    return QMetaEnum::fromType<Type>().valueToKey(type);
+}
+
+bool NetworkTexture::getTextureTypeForUsage(const QString& usage, Type& type) {
+    bool isValid = false;
+    int value = QMetaEnum::fromType<Type>().keyToValue(usage.toLatin1().constData(), &isValid);
+    if (!isValid || value == CUSTOM_TEXTURE) {
+        return false;
+    }
+    type = (Type)value;
+    return true;
+}
+
 /// Returns a texture version of an image file
 gpu::TexturePointer TextureCache::getImageTexture(const QString& path, Type type, QVariantMap options) {
     QImage image = QImage(path);
-    auto loader = getTextureLoaderForType(type, options);
+    auto loader = NetworkTexture::getTextureLoaderForType(type, options);
     return gpu::TexturePointer(loader(image, QUrl::fromLocalFile(path).fileName().toStdString()));
 }
 
@@ -350,6 +381,10 @@ NetworkTexture::NetworkTexture(const QUrl& url, Type type, const QByteArray& con
     if (!content.isEmpty()) {
         _startedLoading = true;
         QMetaObject::invokeMethod(this, "loadContent", Qt::QueuedConnection, Q_ARG(const QByteArray&, content));
+    } else if (url.scheme() == URL_SCHEME_ATP && type != CUSTOM_TEXTURE && maxNumPixels == ABSOLUTE_MAX_TEXTURE_NUM_PIXELS) {
+        // request the variant the asset-server baked for this type first, the image itself is loaded if it has none
+        _activeUrl = getBakedAssetUrl(url, getTextureUsage(type));
+        connect(this, &Resource::loading, this, &NetworkTexture::startKTXPreviewRequests);
     }
 }
 
@@ -395,8 +430,13 @@ public:
     Reader(const QWeakPointer<Resource>& resource, const QUrl& url);
     void run() override final;
     virtual void read() = 0;
+    virtual void finished() {}
+
+    bool isAbandoned() const { return _resource.isNull(); }
 
 protected:
+    void markTimeline(Resource::TimelineEvent event);
+
     QWeakPointer<Resource> _resource;
     QUrl _url;
 };
@@ -406,6 +446,10 @@ public:
     ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url,
             const QByteArray& data, const std::string& hash, int maxNumPixels);
     void read() override final;
+    void finished() override final;
+
+    /// An estimate of the memory used while the image is processed, from the size in its header
+    size_t getMemoryCost() const { return _memoryCost; }
 
 private:
     static void listSupportedImageFormats();
@@ -413,10 +457,151 @@ private:
     QByteArray _content;
     std::string _hash;
     int _maxNumPixels;
+    size_t _memoryCost { 0 };
 };
 
+// the header and key values of the KTX fit in its first bytes, and the mips of up to 128x128 texels in its last bytes
+static const int64_t KTX_PREVIEW_HEADER_SIZE = 1024;
+static const int64_t KTX_PREVIEW_MIPS_SIZE = 128 * 1024;
+
+void NetworkTexture::startKTXPreviewRequests() {
+    if (_activeUrl == _url || _ktxPreviewRequested) {
+        return;
+    }
+    _ktxPreviewRequested = true;
+
+    _ktxHeaderRequest = ResourceManager::createResourceRequest(this, _activeUrl);
+    _ktxMipsRequest = ResourceManager::createResourceRequest(this, _activeUrl);
+    if (!_ktxHeaderRequest || !_ktxMipsRequest) {
+        cancelKTXPreviewRequests();
+        return;
+    }
+    _ktxHeaderRequest->setByteRange({ 0, KTX_PREVIEW_HEADER_SIZE });
+    _ktxMipsRequest->setByteRange({ -KTX_PREVIEW_MIPS_SIZE, 0 });
+
+    for (auto request : { _ktxHeaderRequest, _ktxMipsRequest }) {
+        connect(request, &ResourceRequest::finished, this, [this, request] {
+            handleKTXPreviewRequestFinished(request);
+        });
+        request->send();
+    }
+}
+
+void NetworkTexture::handleKTXPreviewRequestFinished(ResourceRequest* request) {
+    bool succeeded = request->getResult() == ResourceRequest::Success;
+    if (request == _ktxHeaderRequest) {
+        _ktxHeaderData = succeeded ? request->getData() : QByteArray();
+        _ktxHeaderRequest = nullptr;
+    } else if (request == _ktxMipsRequest) {
+        _ktxMipsData = succeeded ? request->getData() : QByteArray();
+        _ktxSize = request->getTotalSizeOfResource();
+        _ktxMipsRequest = nullptr;
+    }
+    request->disconnect(this);
+    request->deleteLater();
+
+    if (!_ktxHeaderData.isEmpty() && !_ktxMipsData.isEmpty()) {
+        loadKTXPreview();
+    }
+}
+
+void NetworkTexture::cancelKTXPreviewRequests() {
+    for (auto request : { _ktxHeaderRequest, _ktxMipsRequest }) {
+        if (request) {
+            request->disconnect(this);
+            request->deleteLater();
+        }
+    }
+    _ktxHeaderRequest = _ktxMipsRequest = nullptr;
+    _ktxHeaderData.clear();
+    _ktxMipsData.clear();
+}
+
+void NetworkTexture::loadKTXPreview() {
+    Finally clearData([this] {
+        _ktxHeaderData.clear();
+        _ktxMipsData.clear();
+    });
+
+    // the whole texture might have arrived first
+    if (_loaded || _textureSource->getGPUTexture()) {
+        return;
+    }
+
+    auto headerBytes = reinterpret_cast<const ktx::Byte*>(_ktxHeaderData.constData());
+    if (_ktxSize <= 0 || !ktx::KTX::checkHeaderFromStorage(_ktxHeaderData.size(), headerBytes)) {
+        return;
+    }
+
+    ktx::Header header;
+    memcpy(&header, headerBytes, sizeof(ktx::Header));
+
+    // only the mips of 2D textures are previewed
+    if (header.numberOfFaces != 1 || header.pixelDepth != 0 || header.numberOfArrayElements != 0) {
+        return;
+    }
+    auto keyValues = ktx::KTX::parseKeyValues(header.bytesOfKeyValueData, headerBytes + sizeof(ktx::Header));
+
+    // each mip is stored after its size, from the largest, so the offsets of the mips in the last bytes follow from the
+    // header - their stored sizes and the size of the KTX check that they do
+    auto mipsBytes = reinterpret_cast<const ktx::Byte*>(_ktxMipsData.constData());
+    int64_t mipsOffset = _ktxSize - _ktxMipsData.size();
+    int64_t offset = sizeof(ktx::Header) + header.bytesOfKeyValueData;
+    uint32_t numLevels = header.getNumberOfLevels();
+    uint32_t firstLevel = numLevels;
+    ktx::Images images;
+    for (uint32_t level = 0; level < numLevels; level++) {
+        auto imageSize = (uint32_t)header.evalImageSize(level);
+        auto padding = ktx::Header::evalPadding(imageSize);
+        if (offset >= mipsOffset) {
+            auto imageOffset = offset - mipsOffset;
+            uint32_t storedImageSize = 0;
+            if (imageOffset + (int64_t)sizeof(uint32_t) + imageSize > _ktxMipsData.size()) {
+                return;
+            }
+            memcpy(&storedImageSize, mipsBytes + imageOffset, sizeof(uint32_t));
+            if (storedImageSize != imageSize) {
+                return;
+            }
+
+            if (images.empty()) {
+                firstLevel = level;
+            }
+            images.emplace_back(ktx::Image(imageSize, padding, mipsBytes + imageOffset + sizeof(uint32_t)));
+        }
+        offset += sizeof(uint32_t) + imageSize + padding;
+    }
+    if (images.empty() || offset != _ktxSize) {
+        return;
+    }
+
+    ktx::Header previewHeader = header;
+    previewHeader.pixelWidth = header.evalPixelWidth(firstLevel);
+    previewHeader.pixelHeight = header.evalPixelHeight(firstLevel);
+    previewHeader.numberOfMipmapLevels = numLevels - firstLevel;
+    auto previewKtx = ktx::KTX::create(previewHeader, images, keyValues);
+
+    gpu::TexturePointer texture { gpu::Texture::unserialize(previewKtx) };
+    if (!texture) {
+        return;
+    }
+    texture->setKtxBacking(previewKtx);
+    texture->setSource(_url.toString().toStdString());
+    texture->setFallbackTexture(getFallbackTexture());
+
+    // shown until setImage replaces it with the whole texture
+    _textureSource->resetTexture(texture);
+    qCDebug(modelnetworking).nospace() << "Showing " << _url << " at " << previewHeader.pixelWidth << "x"
+        << previewHeader.pixelHeight << " until it is downloaded";
+}
+
 void NetworkTexture::downloadFinished(const QByteArray& data) {
-    loadContent(data);
+    cancelKTXPreviewRequests();
+    if (_activeUrl != _url) {
+        loadBakedContent(data);
+    } else {
+        loadContent(data);
+    }
 }
 
 void NetworkTexture::loadContent(const QByteArray& content) {
@@ -438,15 +623,12 @@ void NetworkTexture::loadContent(const QByteArray& content) {
         if (!texture) {
             KTXFilePointer ktxFile = textureCache->_ktxCache.getFile(hash);
             if (ktxFile) {
-                // Ensure that the KTX deserialization worked
-                auto ktx = ktxFile->getKTX();
-                if (ktx) {
-                    texture.reset(gpu::Texture::unserialize(ktx));
-                    // Ensure that the texture population worked
-                    if (texture) {
-                        texture->setKtxBacking(ktx);
-                        texture = textureCache->cacheTextureByHash(hash, texture);
-                    }
+                // The texture pages its mips from the file, that is kept in the cache as long as it is held
+                texture.reset(gpu::Texture::unserialize(ktxFile->getFilepath()));
+                // Ensure that the texture population worked
+                if (texture) {
+                    _file = ktxFile;
+                    texture = textureCache->cacheTextureByHash(hash, texture);
                 }
             }
         }
@@ -460,7 +642,75 @@ void NetworkTexture::loadContent(const QByteArray& content) {
     }
 
     // We failed to find an existing live or KTX texture, so trigger an image reader
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, hash, _maxNumPixels));
+    if (textureCache) {
+        textureCache->startImageReader(new ImageReader(_self, _url, content, hash, _maxNumPixels));
+    }
+}
+
+void NetworkTexture::loadBakedContent(const QByteArray& content) {
+    // The baked KTX is kept in the KTX cache by its own hash, that the texture is backed by
+    std::string hash;
+    {
+        QCryptographicHash hasher(QCryptographicHash::Md5);
+        hasher.addData(content);
+        hash = hasher.result().toHex().toStdString();
+    }
+
+    auto textureCache = static_cast<TextureCache*>(_cache.data());
+    if (textureCache != nullptr) {
+        auto texture = textureCache->getTextureByHash(hash);
+        if (texture) {
+            _file = textureCache->_ktxCache.getFile(hash);
+            setImage(texture, texture->getWidth(), texture->getHeight());
+            return;
+        }
+
+        KTXFilePointer ktxFile = textureCache->_ktxCache.getFile(hash);
+        if (ktxFile) {
+            loadBakedFile(ktxFile, hash);
+        } else {
+            // the KTX is written on the I/O thread of the cache, and the texture is loaded from the file once it is
+            QWeakPointer<Resource> self = _self;
+            textureCache->_ktxCache.writeFileAsync(content, KTXCache::Metadata(hash, content.size()),
+                [self, hash](const KTXFilePointer& file) {
+                auto resource = self.lock();
+                if (resource) {
+                    resource.staticCast<NetworkTexture>()->loadBakedFile(file, hash);
+                }
+            });
+        }
+        return;
+    }
+
+    loadSourceContent();
+}
+
+void NetworkTexture::loadBakedFile(const KTXFilePointer& file, const std::string& hash) {
+    gpu::TexturePointer texture;
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (file && textureCache) {
+        texture.reset(gpu::Texture::unserialize(file->getFilepath()));
+        if (texture) {
+            texture->setSource(_url.toString().toStdString());
+            texture->setFallbackTexture(getFallbackTexture());
+            texture = textureCache->cacheTextureByHash(hash, texture);
+        }
+    }
+
+    if (texture) {
+        _file = file;
+        QMetaObject::invokeMethod(this, "setImage", Q_ARG(gpu::TexturePointer, texture),
+            Q_ARG(int, texture->getWidth()), Q_ARG(int, texture->getHeight()));
+    } else {
+        QMetaObject::invokeMethod(this, "loadSourceContent");
+    }
+}
+
+void NetworkTexture::loadSourceContent() {
+    // the baked texture can't be used, load the image it was baked from instead
+    qCWarning(modelnetworking) << "Failed to load baked texture" << _activeUrl << "- loading" << _url;
+    _activeUrl = _url;
+    attemptRequest();
 }
 
 Reader::Reader(const QWeakPointer<Resource>& resource, const QUrl& url) :
@@ -469,6 +719,7 @@ Reader::Reader(const QWeakPointer<Resource>& resource, const QUrl& url) :
 }
 
 void Reader::run() {
+    Finally notifyFinished([this] { finished(); });
     PROFILE_RANGE_EX(resource_parse_image, __FUNCTION__, 0xffff0000, 0, { { "url", _url.toString() } });
     DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
     CounterStat counter("Processing");
@@ -485,7 +736,16 @@ void Reader::run() {
         return;
     }
 
+    markTimeline(Resource::DecodeStarted);
     read();
+    markTimeline(Resource::DecodeFinished);
+}
+
+void Reader::markTimeline(Resource::TimelineEvent event) {
+    auto resource = _resource.toStrongRef();
+    if (resource) {
+        resource->markTimeline(event);
+    }
 }
 
 ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url,
@@ -493,6 +753,14 @@ ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url
     Reader(resource, url), _content(data), _hash(hash), _maxNumPixels(maxNumPixels) {
     listSupportedImageFormats();
 
+    // the decoded image, and the image converted for the texture with its mips
+    static const size_t BYTES_PER_PIXEL = 4;
+    static const size_t NUM_IMAGE_COPIES = 2;
+    QBuffer buffer;
+    buffer.setData(_content);
+    QSize size = QImageReader(&buffer, _url.fileName().section('.', -1).toLatin1()).size();
+    _memoryCost = size.isValid() ? (size_t)size.width() * size.height() * BYTES_PER_PIXEL * NUM_IMAGE_COPIES : 0;
+
 #if DEBUG_DUMP_TEXTURE_LOADS
     static auto start = usecTimestampNow() / USECS_PER_MSEC;
     auto now = usecTimestampNow() / USECS_PER_MSEC - start;
@@ -513,6 +781,51 @@ ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url
 #endif
 }
 
+void ImageReader::finished() {
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (textureCache) {
+        textureCache->finishImageReader(_memoryCost);
+    }
+}
+
+void TextureCache::startImageReader(ImageReader* reader) {
+    std::lock_guard<std::mutex> lock(_imageReadersMutex);
+    _pendingImageReaders.push_back(reader);
+    startPendingImageReaders();
+}
+
+void TextureCache::finishImageReader(size_t memoryCost) {
+    std::lock_guard<std::mutex> lock(_imageReadersMutex);
+    _imageReaderMemoryInFlight -= std::min(memoryCost, _imageReaderMemoryInFlight);
+    --_numImageReadersInFlight;
+    startPendingImageReaders();
+}
+
+void TextureCache::startPendingImageReaders() {
+    while (!_pendingImageReaders.empty()) {
+        auto reader = _pendingImageReaders.front();
+        if (reader->isAbandoned()) {
+            // the texture was released before its image was decoded
+            _pendingImageReaders.pop_front();
+            DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
+            delete reader;
+            continue;
+        }
+
+        // a reader whose image is larger than the budget still runs, on its own
+        bool fitsBudget = _numImageReadersInFlight == 0 ||
+            _imageReaderMemoryInFlight + reader->getMemoryCost() <= IMAGE_READER_MEMORY_BUDGET;
+        if (_numImageReadersInFlight >= _imageReaderPool.maxThreadCount() || !fitsBudget) {
+            break;
+        }
+
+        _pendingImageReaders.pop_front();
+        _imageReaderMemoryInFlight += reader->getMemoryCost();
+        ++_numImageReadersInFlight;
+        _imageReaderPool.start(reader);
+    }
+}
+
 void ImageReader::listSupportedImageFormats() {
     static std::once_flag once;
     std::call_once(once, []{
@@ -521,6 +834,27 @@ void ImageReader::listSupportedImageFormats() {
     });
 }
 
+// hands the texture read from an image over to its resource
+static void setImageOfResource(const QWeakPointer<Resource>& weakResource, const QUrl& url, const std::string& hash,
+                               gpu::TexturePointer texture, int imageWidth, int imageHeight) {
+    // We replace the texture with the one stored in the cache.  This deals with the possible race condition of two different 
+    // images with the same hash being loaded concurrently.  Only one of them will make it into the cache by hash first and will
+    // be the winner
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (textureCache) {
+        texture = textureCache->cacheTextureByHash(hash, texture);
+    }
+
+    auto resource = weakResource.lock(); // to ensure the resource is still needed
+    if (resource) {
+        QMetaObject::invokeMethod(resource.data(), "setImage",
+            Q_ARG(gpu::TexturePointer, texture),
+            Q_ARG(int, imageWidth), Q_ARG(int, imageHeight));
+    } else {
+        qCDebug(modelnetworking) << url << "loading stopped; resource out of scope";
+    }
+}
+
 void ImageReader::read() {
     // Help the QImage loader by extracting the image file format from the url filename ext.
     // Some tga are not created properly without it.
@@ -578,35 +912,30 @@ void ImageReader::read() {
         }
 
         if (memKtx && textureCache) {
-            const char* data = reinterpret_cast<const char*>(memKtx->_storage->data());
-            size_t length = memKtx->_storage->size();
-            KTXFilePointer file;
-            auto& ktxCache = textureCache->_ktxCache;
-            if (!memKtx || !(file = ktxCache.writeFile(data, KTXCache::Metadata(_hash, length)))) {
-                qCWarning(modelnetworking) << _url << "file cache failed";
-            } else {
-                resource.staticCast<NetworkTexture>()->_file = file;
-                auto fileKtx = file->getKTX();
-                if (fileKtx) {
-                    texture->setKtxBacking(fileKtx);
+            // the texture is handed over once its KTX is written on the I/O thread of the cache, backed by the file
+            std::shared_ptr<ktx::KTX> ktx(memKtx.release());
+            size_t length = ktx->_storage->size();
+            QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(ktx->_storage->data()), (int)length);
+            QWeakPointer<Resource> weakResource = _resource;
+            QUrl sourceUrl = _url;
+            std::string hash = _hash;
+            // the lambda keeps the serialized KTX the data points to until it is written
+            textureCache->_ktxCache.writeFileAsync(data, KTXCache::Metadata(_hash, length),
+                [ktx, weakResource, sourceUrl, hash, texture, imageWidth, imageHeight](const KTXFilePointer& file) {
+                if (file) {
+                    auto resource = weakResource.lock();
+                    if (resource) {
+                        resource.staticCast<NetworkTexture>()->_file = file;
+                    }
+                    texture->setKtxBacking(file->getFilepath());
+                } else {
+                    qCWarning(modelnetworking) << sourceUrl << "file cache failed";
                 }
-            }
-        }
-
-        // We replace the texture with the one stored in the cache.  This deals with the possible race condition of two different 
-        // images with the same hash being loaded concurrently.  Only one of them will make it into the cache by hash first and will
-        // be the winner
-        if (textureCache) {
-            texture = textureCache->cacheTextureByHash(_hash, texture);
+                setImageOfResource(weakResource, sourceUrl, hash, texture, imageWidth, imageHeight);
+            });
+            return;
         }
     }
 
-    auto resource = _resource.lock(); // to ensure the resource is still needed
-    if (resource) {
-        QMetaObject::invokeMethod(resource.data(), "setImage",
-            Q_ARG(gpu::TexturePointer, texture),
-            Q_ARG(int, imageWidth), Q_ARG(int, imageHeight));
-    } else {
-        qCDebug(modelnetworking) << _url << "loading stopped; resource out of scope";
-    }
+    setImageOfResource(_resource, _url, _hash, texture, imageWidth, imageHeight);
 }
@@ -12,12 +12,16 @@
 #ifndef hifi_TextureCache_h
 #define hifi_TextureCache_h
 
+#include <deque>
+#include <mutex>
+
 #include <gpu/Texture.h>
 
 #include <QImage>
 #include <QMap>
 #include <QColor>
 #include <QMetaEnum>
+#include <QThreadPool>
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
@@ -31,6 +35,9 @@ namespace gpu {
 class Batch;
 }
 
+class ImageReader;
+class ResourceRequest;
+
 /// A simple object wrapper for an OpenGL texture.
 class Texture {
 public:
@@ -78,6 +85,13 @@ public:
     TextureLoaderFunc getTextureLoader() const;
     gpu::TexturePointer getFallbackTexture() const;
 
+    static TextureLoaderFunc getTextureLoaderForType(Type type, const QVariantMap& options = QVariantMap());
+
+    /// The usage a texture type is baked for by the asset-server: the name of the type
+    static QString getTextureUsage(Type type);
+    /// Returns false if usage isn't that of a texture type the asset-server can bake
+    static bool getTextureTypeForUsage(const QString& usage, Type& type);
+
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
@@ -87,12 +101,22 @@ protected:
     virtual void downloadFinished(const QByteArray& data) override;
 
     Q_INVOKABLE void loadContent(const QByteArray& content);
+    Q_INVOKABLE void loadBakedContent(const QByteArray& content);
     Q_INVOKABLE void setImage(gpu::TexturePointer texture, int originalWidth, int originalHeight);
 
 private:
     friend class KTXReader;
     friend class ImageReader;
 
+    // may be called on the I/O thread of the KTX cache, with the file written by loadBakedContent
+    void loadBakedFile(const KTXFilePointer& file, const std::string& hash);
+    Q_INVOKABLE void loadSourceContent();
+
+    void startKTXPreviewRequests();
+    void handleKTXPreviewRequestFinished(ResourceRequest* request);
+    void cancelKTXPreviewRequests();
+    void loadKTXPreview();
+
     Type _type;
     TextureLoaderFunc _textureLoader { [](const QImage&, const std::string&){ return nullptr; } };
     KTXFilePointer _file;
@@ -101,6 +125,15 @@ private:
     int _width { 0 };
     int _height { 0 };
     int _maxNumPixels { ABSOLUTE_MAX_TEXTURE_NUM_PIXELS };
+
+    // the first bytes of a baked KTX, with its header, and its last bytes, with its smallest mips, are requested along
+    // with the whole KTX, to show the texture at a low resolution until it is all downloaded
+    bool _ktxPreviewRequested { false };
+    ResourceRequest* _ktxHeaderRequest { nullptr };
+    ResourceRequest* _ktxMipsRequest { nullptr };
+    QByteArray _ktxHeaderData;
+    QByteArray _ktxMipsData;
+    int64_t _ktxSize { -1 };
 };
 
 using NetworkTexturePointer = QSharedPointer<NetworkTexture>;
@@ -156,6 +189,12 @@ private:
     TextureCache();
     virtual ~TextureCache();
 
+    /// Runs the reader on the texture processing pool once the images being processed leave room in the memory budget
+    /// for its own, the readers of the textures released while they wait are dropped
+    void startImageReader(ImageReader* reader);
+    void finishImageReader(size_t memoryCost);
+    void startPendingImageReaders(); // with _imageReadersMutex locked
+
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
     KTXCache _ktxCache;
@@ -163,6 +202,13 @@ private:
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    // its own threads, so the decoding of textures doesn't wait behind the rest of the work of the global pool
+    QThreadPool _imageReaderPool;
+    std::mutex _imageReadersMutex;
+    std::deque<ImageReader*> _pendingImageReaders;
+    size_t _imageReaderMemoryInFlight { 0 };
+    int _numImageReadersInFlight { 0 };
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
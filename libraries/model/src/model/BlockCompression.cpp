@@ -0,0 +1,301 @@
+//
+//  BlockCompression.cpp
+//  libraries/model/src/model
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <QProcessEnvironment>
+
+using namespace model;
+
+static const QString ENABLE_TEXTURE_COMPRESSION_FLAG("HIFI_ENABLE_TEXTURE_COMPRESSION");
+
+static const int BLOCK_DIMENSION = gpu::Element::BLOCK_SIZE;
+static const int BLOCK_TEXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+static const uint8_t PUNCH_THROUGH_ALPHA = 128;
+static const int NUM_AXIS_ITERATIONS = 4;
+
+bool model::isBlockCompressionEnabled() {
+    static const bool enabled = QProcessEnvironment::systemEnvironment().contains(ENABLE_TEXTURE_COMPRESSION_FLAG);
+    return enabled;
+}
+
+namespace {
+
+// The texels of a block as r, g, b, a
+using Block = uint8_t[BLOCK_TEXELS][4];
+
+void fetchBlock(const QImage& image, int blockX, int blockY, Block& block) {
+    const bool isGray = (image.format() == QImage::Format_Grayscale8);
+    for (int y = 0; y < BLOCK_DIMENSION; y++) {
+        int imageY = std::min(blockY * BLOCK_DIMENSION + y, image.height() - 1);
+        const uint8_t* line = image.constScanLine(imageY);
+        for (int x = 0; x < BLOCK_DIMENSION; x++) {
+            int imageX = std::min(blockX * BLOCK_DIMENSION + x, image.width() - 1);
+            uint8_t* texel = block[y * BLOCK_DIMENSION + x];
+            if (isGray) {
+                texel[0] = texel[1] = texel[2] = line[imageX];
+                texel[3] = 255;
+            } else {
+                QRgb rgb = reinterpret_cast<const QRgb*>(line)[imageX];
+                texel[0] = (uint8_t)qRed(rgb);
+                texel[1] = (uint8_t)qGreen(rgb);
+                texel[2] = (uint8_t)qBlue(rgb);
+                texel[3] = (uint8_t)qAlpha(rgb);
+            }
+        }
+    }
+}
+
+uint16_t packColor565(const float color[3]) {
+    int r = std::min(std::max((int)(color[0] * (31.0f / 255.0f) + 0.5f), 0), 31);
+    int g = std::min(std::max((int)(color[1] * (63.0f / 255.0f) + 0.5f), 0), 63);
+    int b = std::min(std::max((int)(color[2] * (31.0f / 255.0f) + 0.5f), 0), 31);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void unpackColor565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+void writeUint16(uint16_t value, uint8_t* dest) {
+    dest[0] = (uint8_t)(value & 0xFF);
+    dest[1] = (uint8_t)(value >> 8);
+}
+
+// The endpoints are the extremes of the texels along the principal axis of their colors. With punchThrough, the
+// texels with an alpha under half are transparent, and the block uses the 3 color mode if it has some.
+void compressColorBlock(const Block& block, bool punchThrough, uint8_t* dest) {
+    bool isTransparent[BLOCK_TEXELS];
+    bool hasTransparent = false;
+    int numOpaques = 0;
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < BLOCK_TEXELS; i++) {
+        isTransparent[i] = punchThrough && block[i][3] < PUNCH_THROUGH_ALPHA;
+        hasTransparent = hasTransparent || isTransparent[i];
+        if (!isTransparent[i]) {
+            for (int c = 0; c < 3; c++) {
+                mean[c] += block[i][c];
+            }
+            numOpaques++;
+        }
+    }
+
+    if (numOpaques == 0) {
+        // both endpoints black in the 3 color mode, all the texels on the transparent index
+        writeUint16(0, dest);
+        writeUint16(0, dest + 2);
+        dest[4] = dest[5] = dest[6] = dest[7] = 0xFF;
+        return;
+    }
+
+    for (int c = 0; c < 3; c++) {
+        mean[c] /= numOpaques;
+    }
+    float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < BLOCK_TEXELS; i++) {
+        if (isTransparent[i]) {
+            continue;
+        }
+        float r = block[i][0] - mean[0];
+        float g = block[i][1] - mean[1];
+        float b = block[i][2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < NUM_AXIS_ITERATIONS; iteration++) {
+        float next[3] = {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+        };
+        float length = std::max(std::max(std::abs(next[0]), std::abs(next[1])), std::abs(next[2]));
+        if (length <= 0.0f) {
+            break;
+        }
+        for (int c = 0; c < 3; c++) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    int minTexel = -1;
+    int maxTexel = -1;
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (int i = 0; i < BLOCK_TEXELS; i++) {
+        if (isTransparent[i]) {
+            continue;
+        }
+        float projection = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+        if (minTexel < 0 || projection < minProjection) {
+            minTexel = i;
+            minProjection = projection;
+        }
+        if (maxTexel < 0 || projection > maxProjection) {
+            maxTexel = i;
+            maxProjection = projection;
+        }
+    }
+
+    float maxColor[3] = { (float)block[maxTexel][0], (float)block[maxTexel][1], (float)block[maxTexel][2] };
+    float minColor[3] = { (float)block[minTexel][0], (float)block[minTexel][1], (float)block[minTexel][2] };
+    uint16_t color0 = packColor565(maxColor);
+    uint16_t color1 = packColor565(minColor);
+
+    // color0 > color1 selects the 4 color mode, color0 <= color1 the 3 color one with a transparent index
+    const bool threeColors = hasTransparent;
+    if (threeColors == (color0 > color1)) {
+        std::swap(color0, color1);
+    }
+
+    int endpoints[2][3];
+    unpackColor565(color0, endpoints[0]);
+    unpackColor565(color1, endpoints[1]);
+    int palette[4][3];
+    for (int c = 0; c < 3; c++) {
+        palette[0][c] = endpoints[0][c];
+        palette[1][c] = endpoints[1][c];
+        if (threeColors) {
+            palette[2][c] = (endpoints[0][c] + endpoints[1][c]) / 2;
+            palette[3][c] = 0;
+        } else {
+            palette[2][c] = (2 * endpoints[0][c] + endpoints[1][c]) / 3;
+            palette[3][c] = (endpoints[0][c] + 2 * endpoints[1][c]) / 3;
+        }
+    }
+    const int numColors = (threeColors ? 3 : 4);
+
+    uint32_t indices = 0;
+    for (int i = 0; i < BLOCK_TEXELS; i++) {
+        uint32_t index = 3;
+        if (!isTransparent[i]) {
+            int bestDistance = -1;
+            for (int p = 0; p < numColors; p++) {
+                int dr = block[i][0] - palette[p][0];
+                int dg = block[i][1] - palette[p][1];
+                int db = block[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (bestDistance < 0 || distance < bestDistance) {
+                    bestDistance = distance;
+                    index = (uint32_t)p;
+                }
+            }
+        }
+        indices |= index << (2 * i);
+    }
+
+    writeUint16(color0, dest);
+    writeUint16(color1, dest + 2);
+    for (int b = 0; b < 4; b++) {
+        dest[4 + b] = (uint8_t)(indices >> (8 * b));
+    }
+}
+
+// A single channel in the 8 value mode, between the extremes of the channel in the block
+void compressChannelBlock(const Block& block, int channel, uint8_t* dest) {
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+    for (int i = 0; i < BLOCK_TEXELS; i++) {
+        minValue = std::min(minValue, block[i][channel]);
+        maxValue = std::max(maxValue, block[i][channel]);
+    }
+
+    dest[0] = maxValue;
+    dest[1] = minValue;
+    uint64_t indices = 0;
+    if (maxValue > minValue) {
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int p = 1; p < 7; p++) {
+            palette[p + 1] = ((7 - p) * maxValue + p * minValue) / 7;
+        }
+        for (int i = 0; i < BLOCK_TEXELS; i++) {
+            uint64_t index = 0;
+            int bestDistance = 256;
+            for (int p = 0; p < 8; p++) {
+                int distance = std::abs(block[i][channel] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    index = (uint64_t)p;
+                }
+            }
+            indices |= index << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; b++) {
+        dest[2 + b] = (uint8_t)(indices >> (8 * b));
+    }
+}
+
+}
+
+std::vector<uint8_t> model::compressImageBlocks(const QImage& image, const gpu::Element& format) {
+    const uint32_t blockSize = format.getBlockSize();
+    const auto semantic = format.getSemantic();
+    if (image.isNull() || blockSize == 0 || semantic == gpu::COMPRESSED_BC7_SRGBA || semantic == gpu::COMPRESSED_ASTC_4x4_SRGBA) {
+        return std::vector<uint8_t>();
+    }
+
+    QImage source = image;
+    if (source.format() != QImage::Format_Grayscale8 && source.format() != QImage::Format_ARGB32) {
+        source = source.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    const int numBlocksX = (source.width() + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    const int numBlocksY = (source.height() + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    std::vector<uint8_t> result(numBlocksX * numBlocksY * blockSize);
+    uint8_t* dest = result.data();
+    Block block;
+    for (int blockY = 0; blockY < numBlocksY; blockY++) {
+        for (int blockX = 0; blockX < numBlocksX; blockX++) {
+            fetchBlock(source, blockX, blockY, block);
+            switch (semantic) {
+                case gpu::COMPRESSED_BC1_SRGB:
+                    compressColorBlock(block, false, dest);
+                    break;
+                case gpu::COMPRESSED_BC1_SRGBA:
+                    compressColorBlock(block, true, dest);
+                    break;
+                case gpu::COMPRESSED_BC3_SRGBA:
+                    compressChannelBlock(block, 3, dest);
+                    compressColorBlock(block, false, dest + 8);
+                    break;
+                case gpu::COMPRESSED_BC4_RED:
+                    compressChannelBlock(block, 0, dest);
+                    break;
+                case gpu::COMPRESSED_BC5_XY:
+                    compressChannelBlock(block, 0, dest);
+                    compressChannelBlock(block, 1, dest + 8);
+                    break;
+                default:
+                    break;
+            }
+            dest += blockSize;
+        }
+    }
+    return result;
+}
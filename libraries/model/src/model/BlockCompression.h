@@ -0,0 +1,33 @@
+//
+//  BlockCompression.h
+//  libraries/model/src/model
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_model_BlockCompression_h
+#define hifi_model_BlockCompression_h
+
+#include <vector>
+
+#include <QImage>
+
+#include <gpu/Format.h>
+
+namespace model {
+
+/// True if the textures are compressed in the BCn formats while they are processed, set HIFI_ENABLE_TEXTURE_COMPRESSION
+bool isBlockCompressionEnabled();
+
+/// Compresses the image in 4x4 texel blocks of the format, one of COMPRESSED_BC1_SRGB, COMPRESSED_BC1_SRGBA (alpha
+/// below half is transparent), COMPRESSED_BC3_SRGBA, COMPRESSED_BC4_RED (the red or gray channel) or COMPRESSED_BC5_XY
+/// (the red and green channels). The partial blocks at the edges repeat the last texels. Empty for the other formats.
+std::vector<uint8_t> compressImageBlocks(const QImage& image, const gpu::Element& format);
+
+}
+
+#endif // hifi_model_BlockCompression_h
@@ -92,6 +92,10 @@ void Mesh::setPartBuffer(const BufferView& buffer) {
     _partBuffer = buffer;
 }
 
+void Mesh::setLODPartBuffer(const BufferView& buffer) {
+    _lodPartBuffer = buffer;
+}
+
 Box Mesh::evalPartBound(int partNum) const {
     Box box;
     if (partNum < _partBuffer.getNum<Part>()) {
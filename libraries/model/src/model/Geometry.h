@@ -110,6 +110,12 @@ public:
     const BufferView& getPartBuffer() const { return _partBuffer; }
     size_t getNumParts() const { return _partBuffer.getNumElements(); }
 
+    // The parts of the simplified levels of detail drawing the same vertices, all the parts of the finest level first
+    void setLODPartBuffer(const BufferView& buffer);
+    const BufferView& getLODPartBuffer() const { return _lodPartBuffer; }
+    int getNumLODs() const { return getNumParts() ? (int)(_lodPartBuffer.getNumElements() / getNumParts()) : 0; }
+    const Part& getLODPart(int lod, int partNum) const { return _lodPartBuffer.get<Part>(lod * getNumParts() + partNum); }
+
     // evaluate the bounding box of A part
     Box evalPartBound(int partNum) const;
     // evaluate the bounding boxes of the parts in the range [start, end]
@@ -138,6 +144,7 @@ protected:
     BufferView _indexBuffer;
 
     BufferView _partBuffer;
+    BufferView _lodPartBuffer;
 
     void evalVertexFormat();
     void evalVertexStream();
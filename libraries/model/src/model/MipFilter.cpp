@@ -0,0 +1,197 @@
+//
+//  MipFilter.cpp
+//  libraries/model/src/model
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MipFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <NumericalConstants.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define MIP_FILTER_SSE2 1
+#endif
+
+using namespace model;
+
+static int channelsOfFormat(QImage::Format format) {
+    switch (format) {
+        case QImage::Format_Grayscale8:
+        case QImage::Format_Alpha8:
+            return 1;
+        case QImage::Format_RGB888:
+            return 3;
+        case QImage::Format_RGB32:
+        case QImage::Format_ARGB32:
+        case QImage::Format_ARGB32_Premultiplied:
+        case QImage::Format_RGBX8888:
+        case QImage::Format_RGBA8888:
+        case QImage::Format_RGBA8888_Premultiplied:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static QSize mipSizeOf(const QImage& image) {
+    return QSize(std::max(image.width() / 2, 1), std::max(image.height() / 2, 1));
+}
+
+static void boxFilterRow(const uint8_t* row0, const uint8_t* row1, uint8_t* mipRow, int width, int mipWidth, int channels) {
+    int x = 0;
+
+#if MIP_FILTER_SSE2
+    if (channels == 4) {
+        // 2 texels of the mip from the 4 texels above them on each of the 2 rows
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi16(2);
+        for (; x + 2 <= mipWidth && 2 * x + 4 <= width; x += 2) {
+            __m128i texels0 = _mm_loadu_si128((const __m128i*)(row0 + 8 * x));
+            __m128i texels1 = _mm_loadu_si128((const __m128i*)(row1 + 8 * x));
+
+            __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(texels0, zero), _mm_unpacklo_epi8(texels1, zero));
+            __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(texels0, zero), _mm_unpackhi_epi8(texels1, zero));
+            low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+            high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+
+            __m128i sums = _mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding);
+            __m128i mipTexels = _mm_packus_epi16(_mm_srli_epi16(sums, 2), zero);
+            _mm_storel_epi64((__m128i*)(mipRow + 4 * x), mipTexels);
+        }
+    }
+#endif
+
+    for (; x < mipWidth; ++x) {
+        int x0 = 2 * x * channels;
+        int x1 = std::min(2 * x + 1, width - 1) * channels;
+        for (int c = 0; c < channels; ++c) {
+            int sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+            mipRow[x * channels + c] = (uint8_t)((sum + 2) >> 2);
+        }
+    }
+}
+
+QImage model::boxFilterMip(const QImage& image) {
+    QSize mipSize = mipSizeOf(image);
+    int channels = channelsOfFormat(image.format());
+    if (channels == 0 || image.isNull()) {
+        return image.scaled(mipSize);
+    }
+
+    QImage mip(mipSize, image.format());
+    int height = image.height();
+    for (int y = 0; y < mipSize.height(); ++y) {
+        const uint8_t* row0 = image.constScanLine(2 * y);
+        const uint8_t* row1 = image.constScanLine(std::min(2 * y + 1, height - 1));
+        boxFilterRow(row0, row1, mip.scanLine(y), image.width(), mipSize.width(), channels);
+    }
+    return mip;
+}
+
+// a texel of the mip is centered between the texels 2x and 2x+1 of the image, its taps are the texels 2x-2 to 2x+3
+static const int KAISER_TAPS = 6;
+static const int KAISER_FIRST_TAP = -2;
+
+static const float* kaiserWeights() {
+    static float weights[KAISER_TAPS];
+    static std::once_flag once;
+    std::call_once(once, [] {
+        const double ALPHA = 4.0;
+        const double RADIUS = 3.0; // in texels of the image
+        auto besselI0 = [](double x) {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 20; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        };
+
+        double total = 0.0;
+        double values[KAISER_TAPS];
+        for (int i = 0; i < KAISER_TAPS; ++i) {
+            double distance = (i + KAISER_FIRST_TAP) - 0.5; // from the center of the mip texel
+            double x = distance / 2.0; // the sinc is stretched to the texels of the mip
+            double sinc = std::sin(PI * x) / (PI * x);
+            double t = distance / RADIUS;
+            double window = besselI0(ALPHA * std::sqrt(std::max(1.0 - t * t, 0.0))) / besselI0(ALPHA);
+            values[i] = sinc * window;
+            total += values[i];
+        }
+        for (int i = 0; i < KAISER_TAPS; ++i) {
+            weights[i] = (float)(values[i] / total);
+        }
+    });
+    return weights;
+}
+
+QImage model::kaiserFilterMip(const QImage& image) {
+    QSize mipSize = mipSizeOf(image);
+    int channels = channelsOfFormat(image.format());
+    if (channels == 0 || image.isNull()) {
+        return image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    const float* weights = kaiserWeights();
+    int width = image.width();
+    int height = image.height();
+    int mipRowSize = mipSize.width() * channels;
+
+    // horizontal pass, over every row of the image, clamped to its edges
+    std::vector<float> filtered((size_t)height * mipRowSize);
+    std::vector<int> tapOffsets((size_t)mipSize.width() * KAISER_TAPS);
+    for (int x = 0; x < mipSize.width(); ++x) {
+        for (int i = 0; i < KAISER_TAPS; ++i) {
+            tapOffsets[x * KAISER_TAPS + i] = std::min(std::max(2 * x + KAISER_FIRST_TAP + i, 0), width - 1) * channels;
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = image.constScanLine(y);
+        float* filteredRow = filtered.data() + (size_t)y * mipRowSize;
+        for (int x = 0; x < mipSize.width(); ++x) {
+            const int* offsets = tapOffsets.data() + x * KAISER_TAPS;
+            for (int c = 0; c < channels; ++c) {
+                float sum = 0.0f;
+                for (int i = 0; i < KAISER_TAPS; ++i) {
+                    sum += weights[i] * row[offsets[i] + c];
+                }
+                filteredRow[x * channels + c] = sum;
+            }
+        }
+    }
+
+    // vertical pass, a whole row at a time so the loop vectorizes
+    QImage mip(mipSize, image.format());
+    std::vector<float> sums(mipRowSize);
+    for (int y = 0; y < mipSize.height(); ++y) {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        for (int i = 0; i < KAISER_TAPS; ++i) {
+            int tapY = std::min(std::max(2 * y + KAISER_FIRST_TAP + i, 0), height - 1);
+            const float* filteredRow = filtered.data() + (size_t)tapY * mipRowSize;
+            float weight = weights[i];
+            for (int j = 0; j < mipRowSize; ++j) {
+                sums[j] += weight * filteredRow[j];
+            }
+        }
+
+        // the negative lobes of the filter can overshoot
+        uint8_t* mipRow = mip.scanLine(y);
+        for (int j = 0; j < mipRowSize; ++j) {
+            mipRow[j] = (uint8_t)std::min(std::max(sums[j] + 0.5f, 0.0f), 255.0f);
+        }
+    }
+    return mip;
+}
@@ -0,0 +1,31 @@
+//
+//  MipFilter.h
+//  libraries/model/src/model
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_model_MipFilter_h
+#define hifi_model_MipFilter_h
+
+#include <QImage>
+
+namespace model {
+
+// Both filters make the next mip of an image, half its size rounded down and at least 1, in the image's format. They
+// work on the 8 bit per channel formats, with 1, 3 or 4 channels, and fall back to QImage scaling for the others.
+
+/// Each texel of the mip is the average of the 2x2 texels of the image it covers
+QImage boxFilterMip(const QImage& image);
+
+/// Each texel of the mip is filtered from the 6x6 texels of the image around it with a Kaiser-windowed sinc, which
+/// keeps the mips sharper than the box filter without aliasing
+QImage kaiserFilterMip(const QImage& image);
+
+}
+
+#endif // hifi_model_MipFilter_h
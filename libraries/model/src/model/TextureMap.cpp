@@ -21,6 +21,8 @@
 #include <QCryptographicHash>
 #include <Profile.h>
 
+#include "BlockCompression.h"
+#include "MipFilter.h"
 #include "ModelLogging.h"
 using namespace model;
 using namespace gpu;
@@ -207,19 +209,27 @@ const QImage& image, bool isLinear, bool doCompress) {
 
 #define CPU_MIPMAPS 1
 
+// The block compressed mips are compressed from the filtered images
+void assignStoredMipImage(gpu::Texture* texture, uint16 level, const QImage& image) {
+    const auto& format = texture->getStoredMipFormat();
+    if (format.isBlockCompressed()) {
+        PROFILE_RANGE(resource_parse, "compressImageBlocks");
+        auto blocks = compressImageBlocks(image, format);
+        texture->assignStoredMip(level, blocks.size(), blocks.data());
+    } else {
+        texture->assignStoredMip(level, image.byteCount(), image.constBits());
+    }
+}
+
 void generateMips(gpu::Texture* texture, QImage& image, bool fastResize) {
 #if CPU_MIPMAPS
     PROFILE_RANGE(resource_parse, "generateMips");
+    // each mip is filtered from the one above it
     auto numMips = texture->evalNumMips();
+    QImage mipImage = image;
     for (uint16 level = 1; level < numMips; ++level) {
-        QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        if (fastResize) {
-            image = image.scaled(mipSize);
-            texture->assignStoredMip(level, image.byteCount(), image.constBits());
-        } else {
-            QImage mipImage = image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-            texture->assignStoredMip(level, mipImage.byteCount(), mipImage.constBits());
-        }
+        mipImage = fastResize ? boxFilterMip(mipImage) : kaiserFilterMip(mipImage);
+        assignStoredMipImage(texture, level, mipImage);
     }
 
 #else
@@ -231,9 +241,9 @@ void generateFaceMips(gpu::Texture* texture, QImage& image, uint8 face) {
 #if CPU_MIPMAPS
     PROFILE_RANGE(resource_parse, "generateFaceMips");
     auto numMips = texture->evalNumMips();
+    QImage mipImage = image;
     for (uint16 level = 1; level < numMips; ++level) {
-        QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        QImage mipImage = image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        mipImage = kaiserFilterMip(mipImage);
         texture->assignStoredMipFace(level, face, mipImage.byteCount(), mipImage.constBits());
     }
 #else
@@ -254,6 +264,18 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
         gpu::Element formatMip;
         defineColorTexelFormats(formatGPU, formatMip, image, isLinear, doCompress);
 
+        // The CPU compression stores the mips in the GPU format, the BC1 alpha is a mask
+        if (doCompress && !isLinear && isBlockCompressionEnabled()) {
+            if (!validAlpha) {
+                formatGPU = gpu::Element::COLOR_COMPRESSED_BC1_SRGB;
+            } else if (alphaAsMask) {
+                formatGPU = gpu::Element::COLOR_COMPRESSED_BC1_SRGBA;
+            } else {
+                formatGPU = gpu::Element::COLOR_COMPRESSED_BC3_SRGBA;
+            }
+            formatMip = formatGPU;
+        }
+
         if (isStrict) {
             theTexture = (gpu::Texture::createStrict(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         } else {
@@ -269,7 +291,7 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
         }
         theTexture->setUsage(usage.build());
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        assignStoredMipImage(theTexture, 0, image);
 
         if (generateMips) {
             ::generateMips(theTexture, image, false);
@@ -419,6 +441,20 @@ gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcIm
     return theTexture;
 }
 
+static void defineGrayTexelFormats(gpu::Element& formatGPU, gpu::Element& formatMip) {
+    if (isBlockCompressionEnabled()) {
+        formatGPU = gpu::Element::COLOR_COMPRESSED_BC4_RED;
+        formatMip = formatGPU;
+        return;
+    }
+#ifdef COMPRESS_TEXTURES
+    formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
+#else
+    formatGPU = gpu::Element::COLOR_R_8;
+#endif
+    formatMip = gpu::Element::COLOR_R_8;
+}
+
 gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcImage, const std::string& srcImageName) {
     PROFILE_RANGE(resource_parse, "createRoughnessTextureFromImage");
     QImage image = processSourceImage(srcImage, false);
@@ -436,17 +472,14 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcIma
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU;
+        gpu::Element formatMip;
+        defineGrayTexelFormats(formatGPU, formatMip);
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        assignStoredMipImage(theTexture, 0, image);
         generateMips(theTexture, image, true);
 
         theTexture->setSource(srcImageName);
@@ -476,17 +509,14 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& s
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
 
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU;
+        gpu::Element formatMip;
+        defineGrayTexelFormats(formatGPU, formatMip);
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        assignStoredMipImage(theTexture, 0, image);
         generateMips(theTexture, image, true);
 
         theTexture->setSource(srcImageName);
@@ -513,17 +543,14 @@ gpu::Texture* TextureUsage::createMetallicTextureFromImage(const QImage& srcImag
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
 
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU;
+        gpu::Element formatMip;
+        defineGrayTexelFormats(formatGPU, formatMip);
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        assignStoredMipImage(theTexture, 0, image);
         generateMips(theTexture, image, true);
 
         theTexture->setSource(srcImageName);
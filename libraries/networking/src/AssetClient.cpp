@@ -14,6 +14,7 @@
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
@@ -43,10 +44,16 @@ AssetClient::AssetClient() {
     packetReceiver.registerListener(PacketType::AssetGetInfoReply, this, "handleAssetGetInfoReply");
     packetReceiver.registerListener(PacketType::AssetGetReply, this, "handleAssetGetReply", true);
     packetReceiver.registerListener(PacketType::AssetUploadReply, this, "handleAssetUploadReply");
+    packetReceiver.registerListener(PacketType::AssetUploadStatusReply, this, "handleAssetUploadStatusReply");
+    packetReceiver.registerListener(PacketType::AssetUploadChunkReply, this, "handleAssetUploadChunkReply");
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
             this, &AssetClient::handleNodeClientConnectionReset);
+
+    auto& domainHandler = nodeList->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::settingsReceived, this, &AssetClient::handleDomainSettingsReceived);
+    connect(&domainHandler, &DomainHandler::disconnectedFromDomain, this, &AssetClient::handleDisconnectedFromDomain);
 }
 
 void AssetClient::init() {
@@ -183,7 +190,11 @@ RenameMappingRequest* AssetClient::createRenameMappingRequest(const AssetPath& o
 }
 
 AssetRequest* AssetClient::createRequest(const AssetHash& hash) {
-    auto request = new AssetRequest(hash);
+    return createRequest(hash, ByteRange());
+}
+
+AssetRequest* AssetClient::createRequest(const AssetHash& hash, const ByteRange& byteRange) {
+    auto request = new AssetRequest(hash, byteRange);
 
     // Move to the AssetClient thread in case we are not currently on that thread (which will usually be the case)
     request->moveToThread(thread());
@@ -699,6 +710,167 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     }
 }
 
+bool AssetClient::cancelUploadStatusRequest(MessageID id) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto& kv : _pendingUploadStatusRequests) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetClient::cancelUploadAssetChunkRequest(MessageID id) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    for (auto& kv : _pendingUploadChunks) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MessageID AssetClient::getUploadStatus(const QByteArray& hash, uint64_t size, UploadStatusCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto messageID = ++_currentID;
+
+        auto payloadSize = sizeof(messageID) + SHA256_HASH_LENGTH + sizeof(size);
+        auto packet = NLPacket::create(PacketType::AssetUploadStatus, payloadSize, true);
+
+        packet->writePrimitive(messageID);
+        packet->write(hash);
+        packet->writePrimitive(size);
+
+        if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
+            _pendingUploadStatusRequests[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetServerError::NoError, false, QVector<uint32_t>());
+    return INVALID_MESSAGE_ID;
+}
+
+MessageID AssetClient::uploadAssetChunk(const QByteArray& hash, uint64_t size, uint32_t index, const QByteArray& chunk,
+                                        UploadChunkCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        auto packetList = NLPacketList::create(PacketType::AssetUploadChunk, QByteArray(), true, true);
+
+        auto messageID = ++_currentID;
+        packetList->writePrimitive(messageID);
+
+        packetList->write(hash);
+        packetList->writePrimitive(size);
+        packetList->writePrimitive(index);
+
+        // the asset-server checks each chunk against its own hash, before it keeps it
+        packetList->write(hashData(chunk));
+        packetList->write(chunk.constData(), chunk.size());
+
+        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            _pendingUploadChunks[assetServer][messageID] = callback;
+
+            return messageID;
+        }
+    }
+
+    callback(false, AssetServerError::NoError, false);
+    return INVALID_MESSAGE_ID;
+}
+
+void AssetClient::handleAssetUploadStatusReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetServerError error;
+    message->readPrimitive(&error);
+
+    bool assetExists = false;
+    QVector<uint32_t> stagedChunks;
+
+    if (error) {
+        qCWarning(asset_client) << "Error getting the status of an upload to the asset server";
+    } else {
+        uint8_t exists;
+        message->readPrimitive(&exists);
+        assetExists = exists != 0;
+
+        uint32_t numStagedChunks;
+        message->readPrimitive(&numStagedChunks);
+        if (message->getBytesLeftToRead() >= qint64(numStagedChunks * sizeof(uint32_t))) {
+            stagedChunks.resize(numStagedChunks);
+            message->read(reinterpret_cast<char*>(stagedChunks.data()), numStagedChunks * sizeof(uint32_t));
+        }
+    }
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingUploadStatusRequests.find(senderNode);
+    if (messageMapIt != _pendingUploadStatusRequests.end()) {
+
+        // Found the node, get the MessageID -> Callback map
+        auto& messageCallbackMap = messageMapIt->second;
+
+        // Check if we have this pending request
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            messageCallbackMap.erase(requestIt);
+            callback(true, error, assetExists, stagedChunks);
+        }
+    }
+}
+
+void AssetClient::handleAssetUploadChunkReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetServerError error;
+    message->readPrimitive(&error);
+
+    bool uploadComplete = false;
+
+    if (error) {
+        qCWarning(asset_client) << "Error uploading a chunk of a file to the asset server";
+    } else {
+        uint8_t complete;
+        message->readPrimitive(&complete);
+        uploadComplete = complete != 0;
+    }
+
+    // Check if we have any pending requests for this node
+    auto messageMapIt = _pendingUploadChunks.find(senderNode);
+    if (messageMapIt != _pendingUploadChunks.end()) {
+
+        // Found the node, get the MessageID -> Callback map
+        auto& messageCallbackMap = messageMapIt->second;
+
+        // Check if we have this pending request
+        auto requestIt = messageCallbackMap.find(messageID);
+        if (requestIt != messageCallbackMap.end()) {
+            auto callback = requestIt->second;
+            messageCallbackMap.erase(requestIt);
+            callback(true, error, uploadComplete);
+        }
+    }
+}
+
 void AssetClient::handleNodeKilled(SharedNodePointer node) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -719,6 +891,32 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
     }
 }
 
+void AssetClient::handleDomainSettingsReceived(const QJsonObject& domainSettingsObject) {
+    static const QString ASSET_SERVER_SETTINGS_KEY = "asset_server";
+    static const QString CDN_URL_OPTION = "cdn_url";
+
+    auto cdnUrl = domainSettingsObject[ASSET_SERVER_SETTINGS_KEY].toObject()[CDN_URL_OPTION].toString().trimmed();
+    while (cdnUrl.endsWith('/')) {
+        cdnUrl.chop(1);
+    }
+
+    QUrl url { cdnUrl };
+    if (!cdnUrl.isEmpty() && (!url.isValid() || !url.scheme().startsWith("http"))) {
+        qCWarning(asset_client) << "Ignoring the asset-server CDN URL" << cdnUrl << "of the domain, it isn't an HTTP URL";
+        url = QUrl();
+    }
+    if (url != _cdnUrl) {
+        _cdnUrl = url;
+        if (!_cdnUrl.isEmpty()) {
+            qCDebug(asset_client) << "Downloading assets from" << _cdnUrl << "before the asset-server";
+        }
+    }
+}
+
+void AssetClient::handleDisconnectedFromDomain() {
+    _cdnUrl = QUrl();
+}
+
 void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
     // a client connection to a Node was reset
     // if it was an AssetServer we need to cause anything pending to fail so it is re-attempted
@@ -770,4 +968,27 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    // the chunked uploads resume from their failures, which sends new requests - their maps are emptied first
+    {
+        auto messageMapIt = _pendingUploadStatusRequests.find(node);
+        if (messageMapIt != _pendingUploadStatusRequests.end()) {
+            auto callbacks = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : callbacks) {
+                value.second(false, AssetServerError::NoError, false, QVector<uint32_t>());
+            }
+        }
+    }
+
+    {
+        auto messageMapIt = _pendingUploadChunks.find(node);
+        if (messageMapIt != _pendingUploadChunks.end()) {
+            auto callbacks = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : callbacks) {
+                value.second(false, AssetServerError::NoError, false);
+            }
+        }
+    }
 }
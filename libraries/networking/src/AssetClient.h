@@ -15,12 +15,15 @@
 #include <QStandardItemModel>
 #include <QtQml/QJSEngine>
 #include <QString>
+#include <QUrl>
+#include <QVector>
 
 #include <map>
 
 #include <DependencyManager.h>
 
 #include "AssetUtils.h"
+#include "ByteRange.h"
 #include "ClientServerUtils.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
@@ -44,6 +47,9 @@ using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetSer
 using GetInfoCallback = std::function<void(bool responseReceived, AssetServerError serverError, AssetInfo info)>;
 using UploadResultCallback = std::function<void(bool responseReceived, AssetServerError serverError, const QString& hash)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
+using UploadStatusCallback = std::function<void(bool responseReceived, AssetServerError serverError, bool assetExists,
+                                                const QVector<uint32_t>& stagedChunks)>;
+using UploadChunkCallback = std::function<void(bool responseReceived, AssetServerError serverError, bool uploadComplete)>;
 
 class AssetClient : public QObject, public Dependency {
     Q_OBJECT
@@ -56,9 +62,13 @@ public:
     Q_INVOKABLE SetMappingRequest* createSetMappingRequest(const AssetPath& path, const AssetHash& hash);
     Q_INVOKABLE RenameMappingRequest* createRenameMappingRequest(const AssetPath& oldPath, const AssetPath& newPath);
     Q_INVOKABLE AssetRequest* createRequest(const AssetHash& hash);
+    AssetRequest* createRequest(const AssetHash& hash, const ByteRange& byteRange);
     Q_INVOKABLE AssetUpload* createUpload(const QString& filename);
     Q_INVOKABLE AssetUpload* createUpload(const QByteArray& data);
 
+    /// The base URL of the CDN in front of the domain's asset-server, assets are at <CDN URL>/<hash> - empty without one
+    QUrl getCDNUrl() const { return _cdnUrl; }
+
 public slots:
     void init();
 
@@ -70,10 +80,15 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadStatusReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadChunkReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
 
+    void handleDomainSettingsReceived(const QJsonObject& domainSettingsObject);
+    void handleDisconnectedFromDomain();
+
 private:
     MessageID getAssetMapping(const AssetHash& hash, MappingOperationCallback callback);
     MessageID getAllAssetMappings(MappingOperationCallback callback);
@@ -86,10 +101,18 @@ private:
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
 
+    /// Asks whether the asset-server has the asset of the hash, or which of its chunks it already received
+    MessageID getUploadStatus(const QByteArray& hash, uint64_t size, UploadStatusCallback callback);
+    /// Sends the chunk at index of the asset of the hash, the asset-server stores the asset once it has all of them
+    MessageID uploadAssetChunk(const QByteArray& hash, uint64_t size, uint32_t index, const QByteArray& chunk,
+                               UploadChunkCallback callback);
+
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
     bool cancelGetAssetRequest(MessageID id);
     bool cancelUploadAssetRequest(MessageID id);
+    bool cancelUploadStatusRequest(MessageID id);
+    bool cancelUploadAssetChunkRequest(MessageID id);
 
     void handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID, qint64 size, DataOffset length);
     void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID);
@@ -107,6 +130,10 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadStatusCallback>> _pendingUploadStatusRequests;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadChunkCallback>> _pendingUploadChunks;
+
+    QUrl _cdnUrl;
 
     friend class AssetRequest;
     friend class AssetUpload;
@@ -14,8 +14,14 @@
 #include <algorithm>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <SharedUtil.h>
 
 #include "AssetClient.h"
+#include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "ResourceCache.h"
@@ -23,9 +29,15 @@
 
 static int requestID = 0;
 
-AssetRequest::AssetRequest(const QString& hash) :
+static const int MAX_CHUNK_REQUESTS_IN_FLIGHT = 4;
+
+// a CDN download that receives nothing for this long falls back to the asset-server
+static const int CDN_TIMEOUT_MS = 10000;
+
+AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
-    _hash(hash)
+    _hash(hash),
+    _byteRange(byteRange)
 {
 }
 
@@ -37,6 +49,14 @@ AssetRequest::~AssetRequest() {
     if (_assetInfoRequestID) {
         assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
     }
+    for (auto chunkRequestID : _chunkRequestIDs) {
+        assetClient->cancelGetAssetRequest(chunkRequestID);
+    }
+    if (_cdnReply) {
+        _cdnReply->disconnect(this);
+        _cdnReply->abort();
+        _cdnReply->deleteLater();
+    }
 }
 
 void AssetRequest::start() {
@@ -65,14 +85,129 @@ void AssetRequest::start() {
         _info.hash = _hash;
         _info.size = _data.size();
         _error = NoError;
+
+        if (_byteRange.isSet()) {
+            _byteRange.fixupRange(_info.size);
+            _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+        }
         
         _state = Finished;
         emit finished(this);
         return;
     }
-    
+
+    if (!DependencyManager::get<AssetClient>()->getCDNUrl().isEmpty()) {
+        requestFromCDN();
+    } else {
+        requestFromAssetServer();
+    }
+}
+
+void AssetRequest::requestFromCDN() {
+    _state = WaitingForData;
+
+    QUrl url { DependencyManager::get<AssetClient>()->getCDNUrl().toString() + "/" + _hash };
+    QNetworkRequest networkRequest(url);
+    networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    networkRequest.setHeader(QNetworkRequest::UserAgentHeader, HIGH_FIDELITY_USER_AGENT);
+
+    // the asset is cached by its ATP url once it is verified, not by the CDN url
+    networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    networkRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+
+    if (_byteRange.isSet()) {
+        QString byteRange;
+        if (_byteRange.fromInclusive < 0) {
+            byteRange = QString("bytes=%1").arg(_byteRange.fromInclusive);
+        } else {
+            // the end of an HTTP byte range is inclusive
+            byteRange = QString("bytes=%1-%2").arg(_byteRange.fromInclusive).arg(_byteRange.toExclusive - 1);
+        }
+        networkRequest.setRawHeader("Range", byteRange.toLatin1());
+    }
+
+    _cdnReply = NetworkAccessManager::getInstance().get(networkRequest);
+
+    _cdnTimer = new QTimer(this);
+    _cdnTimer->setSingleShot(true);
+    connect(_cdnTimer, &QTimer::timeout, this, [this] {
+        qCDebug(asset_client) << "Timed out downloading" << _hash << "from the CDN, requesting it from the asset-server";
+        _cdnReply->disconnect(this);
+        _cdnReply->abort();
+        _cdnReply->deleteLater();
+        _cdnReply = nullptr;
+        _cdnTimer->deleteLater();
+        _cdnTimer = nullptr;
+        requestFromAssetServer();
+    });
+    _cdnTimer->start(CDN_TIMEOUT_MS);
+
+    connect(_cdnReply, &QNetworkReply::finished, this, &AssetRequest::handleCDNReply);
+    connect(_cdnReply, &QNetworkReply::downloadProgress, this, [this](qint64 bytesReceived, qint64 bytesTotal) {
+        // We've received data, so reset the timer
+        _cdnTimer->start();
+        emit progress(bytesReceived, bytesTotal);
+    });
+}
+
+void AssetRequest::handleCDNReply() {
+    auto reply = _cdnReply.data();
+    _cdnReply = nullptr;
+    reply->disconnect(this);
+    reply->deleteLater();
+    _cdnTimer->deleteLater();
+    _cdnTimer = nullptr;
+
+    bool received = false;
+    if (reply->error() == QNetworkReply::NoError) {
+        auto data = reply->readAll();
+        const int PARTIAL_CONTENT_STATUS_CODE = 206;
+        auto statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (statusCode == PARTIAL_CONTENT_STATUS_CODE) {
+            // Content-Range: bytes <first>-<last>/<total size>
+            auto contentRange = QString(reply->rawHeader("Content-Range"));
+            auto totalSize = contentRange.mid(contentRange.lastIndexOf('/') + 1).toLongLong();
+            if (_byteRange.isSet() && totalSize > 0) {
+                _byteRange.fixupRange(totalSize);
+                if (data.size() == _byteRange.size()) {
+                    // only the whole asset can be checked against its hash
+                    _info.size = totalSize;
+                    _data = data;
+                    received = true;
+                }
+            }
+        } else if (hashData(data).toHex() == _hash) {
+            saveToCache(getUrl(), data);
+            _info.size = data.size();
+            if (_byteRange.isSet()) {
+                // the CDN doesn't do range requests and replied with the whole asset
+                _byteRange.fixupRange(_info.size);
+                data = data.mid(_byteRange.fromInclusive, _byteRange.size());
+            }
+            _data = data;
+            received = true;
+        }
+    }
+
+    if (!received) {
+        qCDebug(asset_client) << "Failed to download" << _hash << "from the CDN, requesting it from the asset-server -"
+            << reply->errorString();
+        requestFromAssetServer();
+        return;
+    }
+
+    _info.hash = _hash;
+    _totalReceived = _data.size();
+    _error = NoError;
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::requestFromAssetServer() {
     _state = WaitingForInfo;
-    
+    _data = QByteArray();
+
     auto assetClient = DependencyManager::get<AssetClient>();
     _assetInfoRequestID = assetClient->getAssetInfo(_hash,
             [this](bool responseReceived, AssetServerError serverError, AssetInfo info) {
@@ -103,11 +238,30 @@ void AssetRequest::start() {
         }
         
         _state = WaitingForData;
-        _data.resize(info.size);
         
         qCDebug(asset_client) << "Got size of " << _hash << " : " << info.size << " bytes";
         
-        int start = 0, end = _info.size;
+        int64_t start = 0, end = _info.size;
+        if (_byteRange.isSet()) {
+            _byteRange.fixupRange(_info.size);
+            start = _byteRange.fromInclusive;
+            end = _byteRange.toExclusive;
+        }
+        _data.resize(end - start);
+
+        if (end <= start) {
+            // an empty range of the asset
+            _state = Finished;
+            emit finished(this);
+            return;
+        }
+
+        if (end - start > (int64_t)ASSET_CHUNK_SIZE) {
+            _start = start;
+            _end = end;
+            startChunkedRequest();
+            return;
+        }
         
         auto assetClient = DependencyManager::get<AssetClient>();
         auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
@@ -138,9 +292,14 @@ void AssetRequest::start() {
             } else {
                 Q_ASSERT(data.size() == (end - start));
                 
-                // we need to check the hash of the received data to make sure it matches what we expect
-                if (hashData(data).toHex() == _hash) {
-                    memcpy(_data.data() + start, data.constData(), data.size());
+                if (start > 0 || end < (int64_t)_info.size) {
+                    // only the whole asset can be checked against its hash, nor cached as the asset
+                    memcpy(_data.data(), data.constData(), data.size());
+                    _totalReceived += data.size();
+                    emit progress(_totalReceived, end - start);
+                } else if (hashData(data).toHex() == _hash) {
+                    // we need to check the hash of the received data to make sure it matches what we expect
+                    memcpy(_data.data(), data.constData(), data.size());
                     _totalReceived += data.size();
                     emit progress(_totalReceived, _info.size);
                     
@@ -167,3 +326,147 @@ void AssetRequest::start() {
         });
     });
 }
+
+QUrl AssetRequest::getChunkUrl(uint32_t index) const {
+    QUrl url = getUrl();
+    url.setQuery("chunk=" + QString::number(index));
+    return url;
+}
+
+bool AssetRequest::isWholeChunk(uint32_t index, DataOffset& start, DataOffset& end) const {
+    DataOffset chunkStart = index * ASSET_CHUNK_SIZE;
+    DataOffset chunkEnd = std::min(chunkStart + (DataOffset)ASSET_CHUNK_SIZE, (DataOffset)_info.size);
+    start = std::max(chunkStart, _start);
+    end = std::min(chunkEnd, _end);
+    return start == chunkStart && end == chunkEnd;
+}
+
+void AssetRequest::startChunkedRequest() {
+    uint32_t firstChunk = (uint32_t)(_start / ASSET_CHUNK_SIZE);
+    uint32_t lastChunk = (uint32_t)((_end - 1) / ASSET_CHUNK_SIZE);
+    int numCachedChunks = 0;
+
+    for (uint32_t index = firstChunk; index <= lastChunk; ++index) {
+        DataOffset start, end;
+        if (isWholeChunk(index, start, end)) {
+            auto chunk = loadFromCache(getChunkUrl(index));
+            if (chunk.size() == end - start) {
+                memcpy(_data.data() + (start - _start), chunk.constData(), chunk.size());
+                _totalReceived += chunk.size();
+                ++numCachedChunks;
+                continue;
+            }
+        }
+        _pendingChunks.push_back(index);
+    }
+
+    qCDebug(asset_client) << "Requesting" << _pendingChunks.size() << "chunks of" << _hash << "from asset-server,"
+        << numCachedChunks << "were cached";
+    emit progress(_totalReceived, _end - _start);
+
+    if (_pendingChunks.empty()) {
+        finishChunkedRequest();
+    } else {
+        requestChunks();
+    }
+}
+
+void AssetRequest::requestChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    while (_chunkRequestIDs.size() < MAX_CHUNK_REQUESTS_IN_FLIGHT && !_pendingChunks.empty() && _state != Finished) {
+        auto index = _pendingChunks.front();
+        _pendingChunks.pop_front();
+
+        DataOffset start, end;
+        bool wholeChunk = isWholeChunk(index, start, end);
+        auto hash = _hash;
+
+        auto chunkRequestID = assetClient->getAsset(_hash, start, end,
+                [this, that, hash, index, start, end, wholeChunk](bool responseReceived, AssetServerError serverError,
+                                                                   const QByteArray& data) {
+            if (!that) {
+                qCWarning(asset_client) << "Got reply for dead asset request " << hash;
+                return;
+            }
+            _chunkRequestIDs.remove(index);
+            if (_state == Finished) {
+                return;
+            }
+
+            if (!responseReceived) {
+                _error = NetworkError;
+            } else if (serverError != AssetServerError::NoError) {
+                switch (serverError) {
+                    case AssetServerError::AssetNotFound:
+                        _error = NotFound;
+                        break;
+                    case AssetServerError::InvalidByteRange:
+                        _error = InvalidByteRange;
+                        break;
+                    default:
+                        _error = UnknownError;
+                        break;
+                }
+            } else if (data.size() != end - start) {
+                _error = UnknownError;
+            } else {
+                memcpy(_data.data() + (start - _start), data.constData(), data.size());
+                _totalReceived += data.size();
+                emit progress(_totalReceived, _end - _start);
+
+                if (wholeChunk) {
+                    saveToCache(getChunkUrl(index), data);
+                }
+            }
+
+            if (_error != NoError) {
+                // the chunks received so far stay cached for the next request of the asset
+                qCWarning(asset_client) << "Got error retrieving chunk" << index << "of asset" << _hash
+                    << "- error code" << _error;
+
+                auto assetClient = DependencyManager::get<AssetClient>();
+                for (auto chunkRequestID : _chunkRequestIDs) {
+                    assetClient->cancelGetAssetRequest(chunkRequestID);
+                }
+                _chunkRequestIDs.clear();
+                _pendingChunks.clear();
+
+                _state = Finished;
+                emit finished(this);
+            } else if (_pendingChunks.empty() && _chunkRequestIDs.empty()) {
+                finishChunkedRequest();
+            } else {
+                requestChunks();
+            }
+        }, [](qint64, qint64) {
+            // progress is reported as each chunk completes
+        });
+
+        // a request that failed to send has already called back
+        if (chunkRequestID != INVALID_MESSAGE_ID && _state != Finished) {
+            _chunkRequestIDs[index] = chunkRequestID;
+        }
+    }
+}
+
+void AssetRequest::finishChunkedRequest() {
+    if (_start == 0 && _end == _info.size) {
+        // the chunks can't be checked on their own, a bad one is dropped with the others
+        if (hashData(_data).toHex() == _hash) {
+            saveToCache(getUrl(), _data);
+        } else {
+            _error = HashVerificationFailed;
+            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        }
+
+        uint32_t numChunks = (uint32_t)((_info.size + ASSET_CHUNK_SIZE - 1) / ASSET_CHUNK_SIZE);
+        for (uint32_t index = 0; index < numChunks; ++index) {
+            removeFromCache(getChunkUrl(index));
+        }
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
@@ -12,13 +12,21 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <deque>
+
 #include <QByteArray>
+#include <QHash>
 #include <QObject>
+#include <QPointer>
 #include <QString>
 
 #include "AssetClient.h"
 
 #include "AssetUtils.h"
+#include "ByteRange.h"
+
+class QNetworkReply;
+class QTimer;
 
 class AssetRequest : public QObject {
    Q_OBJECT
@@ -40,7 +48,7 @@ public:
         UnknownError
     };
 
-    AssetRequest(const QString& hash);
+    AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
     Q_INVOKABLE void start();
@@ -50,12 +58,28 @@ public:
     const Error& getError() const { return _error; }
     QUrl getUrl() const { return ::getATPUrl(_hash); }
     QString getHash() const { return _hash; }
+    /// The size of the whole asset, known once the request finished
+    int64_t getTotalSize() const { return _info.size; }
 
 signals:
     void finished(AssetRequest* thisRequest);
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    void requestFromAssetServer();
+
+    // the asset is downloaded from the domain's CDN first, when it has one, and from the asset-server if that fails
+    void requestFromCDN();
+    void handleCDNReply();
+
+    // the ranges larger than a chunk are requested a chunk at a time, several at once, and the whole chunks are kept in
+    // the disk cache until the asset is complete, so a request that fails resumes from the chunks it already received
+    void startChunkedRequest();
+    void requestChunks();
+    void finishChunkedRequest();
+    QUrl getChunkUrl(uint32_t index) const;
+    bool isWholeChunk(uint32_t index, DataOffset& start, DataOffset& end) const;
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -63,9 +87,18 @@ private:
     uint64_t _totalReceived { 0 };
     QString _hash;
     QByteArray _data;
+    ByteRange _byteRange;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
     MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+
+    DataOffset _start { 0 };
+    DataOffset _end { 0 };
+    std::deque<uint32_t> _pendingChunks;
+    QHash<uint32_t, MessageID> _chunkRequestIDs;
+
+    QPointer<QNetworkReply> _cdnReply;
+    QTimer* _cdnTimer { nullptr };
 };
 
 #endif
@@ -114,7 +114,7 @@ void AssetResourceRequest::requestMappingForPath(const AssetPath& path) {
 void AssetResourceRequest::requestHash(const AssetHash& hash) {
     // Make request to atp
     auto assetClient = DependencyManager::get<AssetClient>();
-    _assetRequest = assetClient->createRequest(hash);
+    _assetRequest = assetClient->createRequest(hash, _byteRange);
 
     connect(_assetRequest, &AssetRequest::progress, this, &AssetResourceRequest::onDownloadProgress);
     connect(_assetRequest, &AssetRequest::finished, this, [this](AssetRequest* req) {
@@ -125,6 +125,7 @@ void AssetResourceRequest::requestHash(const AssetHash& hash) {
         switch (req->getError()) {
             case AssetRequest::Error::NoError:
                 _data = req->getData();
+                _totalSizeOfResource = req->getTotalSize();
                 _result = Success;
                 break;
             case AssetRequest::InvalidHash:
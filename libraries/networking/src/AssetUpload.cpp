@@ -11,14 +11,37 @@
 
 #include "AssetUpload.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include "AssetClient.h"
 #include "NetworkLogging.h"
 
 const QString AssetUpload::PERMISSION_DENIED_ERROR = "You do not have permission to upload content to this asset-server.";
 
+static const int MAX_CHUNKS_IN_FLIGHT = 4;
+static const int MAX_UPLOAD_RESUMES = 5;
+static const int UPLOAD_RESUME_DELAY_MS = 2000; // multiplied by the number of resumes so far
+
+static AssetUpload::Error uploadErrorForServerError(AssetServerError error) {
+    switch (error) {
+        case AssetServerError::NoError:
+            return AssetUpload::NoError;
+        case AssetServerError::AssetTooLarge:
+            return AssetUpload::TooLarge;
+        case AssetServerError::PermissionDenied:
+            return AssetUpload::PermissionDenied;
+        case AssetServerError::FileOperationFailed:
+            return AssetUpload::ServerFileError;
+        default:
+            return AssetUpload::FileOpenError;
+    }
+}
+
 AssetUpload::AssetUpload(const QByteArray& data) :
     _data(data)
 {
@@ -81,28 +104,14 @@ void AssetUpload::start() {
         qCDebug(asset_client) << "Attempting to upload" << _filename << "to asset-server.";
     }
     
+    if ((uint64_t)_data.size() > ASSET_CHUNK_SIZE) {
+        _hash = hashData(_data);
+        requestUploadStatus();
+        return;
+    }
+
     assetClient->uploadAsset(_data, [this](bool responseReceived, AssetServerError error, const QString& hash){
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else {
-            switch (error) {
-                case AssetServerError::NoError:
-                    _error = NoError;
-                    break;
-                case AssetServerError::AssetTooLarge:
-                    _error = TooLarge;
-                    break;
-                case AssetServerError::PermissionDenied:
-                    _error = PermissionDenied;
-                    break;
-                case AssetServerError::FileOperationFailed:
-                    _error = ServerFileError;
-                    break;
-                default:
-                    _error = FileOpenError;
-                    break;
-            }
-        }
+        _error = responseReceived ? uploadErrorForServerError(error) : NetworkError;
         
         if (_error == NoError && hash == hashData(_data).toHex()) {
             saveToCache(getATPUrl(hash), _data);
@@ -111,3 +120,120 @@ void AssetUpload::start() {
         emit finished(this, hash);
     });
 }
+
+void AssetUpload::requestUploadStatus() {
+    auto attempt = ++_attempt;
+    auto assetClient = DependencyManager::get<AssetClient>();
+    assetClient->getUploadStatus(_hash, _data.size(), [this, attempt](bool responseReceived, AssetServerError error,
+                                                                     bool assetExists, const QVector<uint32_t>& stagedChunks) {
+        if (attempt != _attempt || _finished) {
+            return;
+        }
+
+        if (!responseReceived) {
+            resumeAfterNetworkError();
+        } else if (error != AssetServerError::NoError || assetExists) {
+            finishChunkedUpload(uploadErrorForServerError(error));
+        } else {
+            // the chunks the asset-server kept from an earlier attempt are not sent again
+            uint32_t numChunks = (uint32_t)((_data.size() + ASSET_CHUNK_SIZE - 1) / ASSET_CHUNK_SIZE);
+            std::vector<bool> staged(numChunks, false);
+            for (auto index : stagedChunks) {
+                if (index < numChunks) {
+                    staged[index] = true;
+                }
+            }
+
+            _pendingChunks.clear();
+            _numBytesUploaded = 0;
+            for (uint32_t index = 0; index < numChunks; ++index) {
+                if (!staged[index]) {
+                    _pendingChunks.push_back(index);
+                } else {
+                    _numBytesUploaded += std::min(ASSET_CHUNK_SIZE, _data.size() - index * ASSET_CHUNK_SIZE);
+                }
+            }
+            _numChunksInFlight = 0;
+
+            if (!stagedChunks.isEmpty()) {
+                qCDebug(asset_client) << "Resuming the upload of" << _hash.toHex() << "with" << _pendingChunks.size()
+                    << "of its" << numChunks << "chunks left";
+            }
+            emit progress(_numBytesUploaded, _data.size());
+
+            if (_pendingChunks.empty()) {
+                // the asset-server has them all but didn't store the asset, the last chunk is sent again so it does
+                _pendingChunks.push_back(numChunks - 1);
+            }
+            sendChunks();
+        }
+    });
+}
+
+void AssetUpload::sendChunks() {
+    auto attempt = _attempt;
+    auto assetClient = DependencyManager::get<AssetClient>();
+
+    // a chunk that fails to send right away starts a new attempt, which stops this one from sending the others
+    while (_numChunksInFlight < MAX_CHUNKS_IN_FLIGHT && !_pendingChunks.empty() && attempt == _attempt && !_finished) {
+        auto index = _pendingChunks.front();
+        _pendingChunks.pop_front();
+        ++_numChunksInFlight;
+
+        auto offset = index * ASSET_CHUNK_SIZE;
+        auto chunkSize = std::min(ASSET_CHUNK_SIZE, _data.size() - offset);
+        auto chunk = QByteArray::fromRawData(_data.constData() + offset, (int)chunkSize);
+
+        assetClient->uploadAssetChunk(_hash, _data.size(), index, chunk,
+                                      [this, attempt, chunkSize](bool responseReceived, AssetServerError error,
+                                                                 bool uploadComplete) {
+            if (attempt != _attempt || _finished) {
+                return;
+            }
+            --_numChunksInFlight;
+
+            if (!responseReceived) {
+                resumeAfterNetworkError();
+            } else if (error != AssetServerError::NoError || uploadComplete) {
+                finishChunkedUpload(uploadErrorForServerError(error));
+            } else {
+                _numBytesUploaded += chunkSize;
+                emit progress(_numBytesUploaded, _data.size());
+
+                if (_pendingChunks.empty() && _numChunksInFlight == 0) {
+                    // every chunk was received without completing the asset, the asset-server must have dropped some
+                    resumeAfterNetworkError();
+                } else {
+                    sendChunks();
+                }
+            }
+        });
+    }
+}
+
+void AssetUpload::resumeAfterNetworkError() {
+    // the replies still pending belong to the failed attempt
+    ++_attempt;
+
+    if (_numResumes >= MAX_UPLOAD_RESUMES) {
+        finishChunkedUpload(NetworkError);
+        return;
+    }
+
+    ++_numResumes;
+    qCDebug(asset_client) << "Upload of" << _hash.toHex() << "interrupted, resuming - attempt" << _numResumes;
+    QTimer::singleShot(UPLOAD_RESUME_DELAY_MS * _numResumes, this, &AssetUpload::requestUploadStatus);
+}
+
+void AssetUpload::finishChunkedUpload(Error error) {
+    _finished = true;
+    _error = error;
+
+    QString hash;
+    if (_error == NoError) {
+        hash = _hash.toHex();
+        saveToCache(getATPUrl(hash), _data);
+    }
+
+    emit finished(this, hash);
+}
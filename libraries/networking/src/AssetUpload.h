@@ -17,6 +17,7 @@
 #include <QtCore/QObject>
 
 #include <cstdint>
+#include <deque>
 
 // You should be able to upload an asset from any thread, and handle the responses in a safe way
 // on your own thread. Everything should happen on AssetClient's thread, the caller should
@@ -52,9 +53,23 @@ signals:
     void progress(uint64_t totalReceived, uint64_t total);
     
 private:
+    // the assets larger than a chunk are uploaded a chunk at a time, after the asset-server said which ones it is missing
+    void requestUploadStatus();
+    void sendChunks();
+    void resumeAfterNetworkError();
+    void finishChunkedUpload(Error error);
+
     QString _filename;
     QByteArray _data;
     Error _error;
+
+    QByteArray _hash;
+    std::deque<uint32_t> _pendingChunks;
+    int _numChunksInFlight { 0 };
+    uint64_t _numBytesUploaded { 0 };
+    int _numResumes { 0 };
+    int _attempt { 0 }; // the replies to the requests of an earlier attempt are ignored
+    bool _finished { false };
 };
 
 #endif // hifi_AssetUpload_h
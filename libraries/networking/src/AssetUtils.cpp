@@ -25,6 +25,28 @@ QUrl getATPUrl(const QString& hash) {
     return QUrl(QString("%1:%2").arg(URL_SCHEME_ATP, hash));
 }
 
+QUrl getBakedAssetUrl(const QUrl& url, const QString& usage) {
+    // atp:<hash>.<ext> urls name their asset by its hash, the others by its path
+    auto path = url.path();
+    auto source = path.startsWith('/') ? path.mid(1) : path;
+    return QUrl(QString("%1:%2%3/%4").arg(URL_SCHEME_ATP, BAKED_ASSETS_FOLDER, usage, source));
+}
+
+bool parseBakedAssetPath(const AssetPath& path, QString& usage, QString& source) {
+    if (!path.startsWith(BAKED_ASSETS_FOLDER)) {
+        return false;
+    }
+
+    auto usageEnd = path.indexOf('/', BAKED_ASSETS_FOLDER.size());
+    if (usageEnd <= BAKED_ASSETS_FOLDER.size() || usageEnd == path.size() - 1) {
+        return false;
+    }
+
+    usage = path.mid(BAKED_ASSETS_FOLDER.size(), usageEnd - BAKED_ASSETS_FOLDER.size());
+    source = path.mid(usageEnd + 1);
+    return true;
+}
+
 QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
@@ -70,6 +92,12 @@ bool saveToCache(const QUrl& url, const QByteArray& file) {
     return false;
 }
 
+void removeFromCache(const QUrl& url) {
+    if (auto cache = NetworkAccessManager::getInstance().cache()) {
+        cache->remove(url);
+    }
+}
+
 bool isValidFilePath(const AssetPath& filePath) {
     QRegExp filePathRegex { ASSET_FILE_PATH_REGEX_STRING };
     return filePathRegex.exactMatch(filePath);
@@ -30,10 +30,18 @@ const size_t SHA256_HASH_LENGTH = 32;
 const size_t SHA256_HASH_HEX_LENGTH = 64;
 const uint64_t MAX_UPLOAD_SIZE = 1000 * 1000 * 1000; // 1GB
 
+// the assets larger than a chunk are uploaded and downloaded a chunk per request, several at a time, so a transfer that
+// fails only repeats the chunks it didn't finish
+const uint64_t ASSET_CHUNK_SIZE = 1024 * 1024; // 1MB
+
 const QString ASSET_FILE_PATH_REGEX_STRING = "^(\\/[^\\/\\0]+)+$";
 const QString ASSET_PATH_REGEX_STRING = "^\\/([^\\/\\0]+(\\/)?)+$";
 const QString ASSET_HASH_REGEX_STRING = QString("^[a-fA-F0-9]{%1}$").arg(SHA256_HASH_HEX_LENGTH);
 
+// assets baked by the asset-server are found at BAKED_ASSETS_FOLDER<usage>/<path or hash.ext of the source asset>,
+// these paths resolve to the baked variant when the asset-server has one and can't be mapped by clients
+const QString BAKED_ASSETS_FOLDER = "/.baked/";
+
 enum AssetServerError : uint8_t {
     NoError = 0,
     AssetNotFound,
@@ -54,10 +62,18 @@ enum AssetMappingOperationType : uint8_t {
 
 QUrl getATPUrl(const QString& hash);
 
+/// Returns the url of the variant of the asset at the atp url that is baked for usage
+QUrl getBakedAssetUrl(const QUrl& url, const QString& usage);
+
+/// Splits the path of a baked asset into the usage and the source path or hash it was baked for,
+/// returns false if it is not the path of a baked asset
+bool parseBakedAssetPath(const AssetPath& path, QString& usage, QString& source);
+
 QByteArray hashData(const QByteArray& data);
 
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
+void removeFromCache(const QUrl& url);
 
 bool isValidFilePath(const AssetPath& path);
 bool isValidPath(const AssetPath& path);
@@ -0,0 +1,39 @@
+//
+//  ByteRange.h
+//  libraries/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ByteRange_h
+#define hifi_ByteRange_h
+
+#include <algorithm>
+#include <cstdint>
+
+/// A range of the bytes of a resource - a negative fromInclusive is the number of bytes at the end of the resource to get
+struct ByteRange {
+    int64_t fromInclusive { 0 };
+    int64_t toExclusive { 0 };
+
+    bool isSet() const { return fromInclusive < 0 || fromInclusive < toExclusive; }
+    int64_t size() const { return toExclusive - fromInclusive; }
+
+    /// Makes the range a valid range of a resource of fileSize bytes
+    void fixupRange(int64_t fileSize) {
+        if (fromInclusive < 0) {
+            // the last bytes of the resource
+            fromInclusive = std::max(fileSize + fromInclusive, (int64_t)0);
+            toExclusive = fileSize;
+        } else {
+            toExclusive = std::min(toExclusive, fileSize);
+            fromInclusive = std::min(fromInclusive, toExclusive);
+        }
+    }
+};
+
+#endif // hifi_ByteRange_h
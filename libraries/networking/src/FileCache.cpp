@@ -17,14 +17,21 @@
 #include <unordered_set>
 
 #include <QDir>
+#include <QThread>
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
+#include <StartupTimeline.h>
 
 Q_LOGGING_CATEGORY(file_cache, "hifi.file_cache", QtWarningMsg)
 
 using namespace cache;
 
 static const std::string MANIFEST_NAME = "manifest";
+static const std::string PART_EXT = "part";
+
+// the weight of each write in the average write latency
+static const quint64 WRITE_LATENCY_SAMPLES = 16;
 
 static const size_t BYTES_PER_MEGABYTES = 1024 * 1024;
 static const size_t BYTES_PER_GIGABYTES = 1024 * BYTES_PER_MEGABYTES;
@@ -49,6 +56,7 @@ FileCache::FileCache(const std::string& dirname, const std::string& ext, QObject
     _dirpath(PathUtils::getAppLocalDataFilePath(dirname.c_str()).toStdString()) {}
 
 FileCache::~FileCache() {
+    stopWriting();
     clear();
 }
 
@@ -60,20 +68,13 @@ void FileCache::initialize() {
     QDir dir(_dirpath.c_str());
 
     if (dir.exists()) {
-        auto nameFilters = QStringList(("*." + _ext).c_str());
-        auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
-        auto sort = QDir::SortFlags(QDir::Time);
-        auto files = dir.entryList(nameFilters, filters, sort);
-
-        // load persisted files
-        foreach(QString filename, files) {
-            const Key key = filename.section('.', 0, 1).toStdString();
-            const std::string filepath = dir.filePath(filename).toStdString();
-            const size_t length = std::ifstream(filepath, std::ios::binary | std::ios::ate).tellg();
-            addFile(Metadata(key, length), filepath);
+        // the manifest the cache was persisted with saves walking the directory
+        if (loadManifest()) {
+            qCDebug(file_cache, "[%s] Initialized %s from its manifest", _dirname.c_str(), _dirpath.c_str());
+        } else {
+            loadDirectory();
+            qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
         }
-
-        qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
     } else {
         dir.mkpath(_dirpath.c_str());
         qCDebug(file_cache, "[%s] Created %s", _dirname.c_str(), _dirpath.c_str());
@@ -82,6 +83,93 @@ void FileCache::initialize() {
     _initialized = true;
 }
 
+void FileCache::initializeAsync() {
+    _initialization = std::async(std::launch::async, [this] {
+        StartupTimeline::Phase phase(QString("FileCache %1").arg(_dirname.c_str()));
+        initialize();
+    });
+}
+
+void FileCache::waitForInitialization() {
+    if (_initialized) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_initializationMutex);
+    if (_initialization.valid()) {
+        _initialization.wait();
+    }
+    assert(_initialized);
+}
+
+bool FileCache::loadManifest() {
+    const std::string manifestPath = getManifestPath();
+    std::vector<Metadata> persistedFiles;
+    {
+        std::ifstream manifest(manifestPath);
+        if (!manifest) {
+            return false;
+        }
+        Key key;
+        size_t length;
+        while (manifest >> key >> length) {
+            persistedFiles.emplace_back(key, length);
+        }
+        if (!manifest.eof()) {
+            qCWarning(file_cache, "[%s] Failed to read %s", _dirname.c_str(), manifestPath.c_str());
+            return false;
+        }
+    }
+
+    // the manifest is only valid until the cache changes, it is written again when the cache is persisted
+    QFile(manifestPath.c_str()).remove();
+
+    // load persisted files, the least recently used first
+    for (auto& metadata : persistedFiles) {
+        std::string filepath = getFilepath(metadata.key);
+        addFile(std::move(metadata), filepath);
+    }
+    return true;
+}
+
+void FileCache::loadDirectory() {
+    QDir dir(_dirpath.c_str());
+    auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
+
+    // remove the partial writes of a session that did not end
+    foreach(QString filename, dir.entryList(QStringList(("*." + PART_EXT).c_str()), filters)) {
+        dir.remove(filename);
+    }
+
+    auto nameFilters = QStringList(("*." + _ext).c_str());
+    auto sort = QDir::SortFlags(QDir::Time | QDir::Reversed);
+    auto files = dir.entryList(nameFilters, filters, sort);
+
+    // load persisted files, the least recently modified first
+    foreach(QString filename, files) {
+        const Key key = filename.left(filename.length() - (int)_ext.size() - 1).toStdString();
+        const std::string filepath = dir.filePath(filename).toStdString();
+        const size_t length = std::ifstream(filepath, std::ios::binary | std::ios::ate).tellg();
+        addFile(Metadata(key, length), filepath);
+    }
+}
+
+void FileCache::writeManifest(const std::vector<FilePointer>& files) {
+    const std::string manifestPath = getManifestPath();
+    const std::string partPath = manifestPath + '.' + PART_EXT;
+    {
+        std::ofstream manifest(partPath, std::ios::trunc);
+        for (const auto& file : files) {
+            manifest << file->getKey() << ' ' << file->getLength() << '\n';
+        }
+        if (!manifest) {
+            qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), manifestPath.c_str());
+            return;
+        }
+    }
+    QFile(manifestPath.c_str()).remove();
+    QFile::rename(partPath.c_str(), manifestPath.c_str());
+}
+
 FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath) {
     FilePointer file(createFile(std::move(metadata), filepath).release(), &fileDeleter);
     if (file) {
@@ -97,11 +185,7 @@ FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath)
 }
 
 FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata) {
-    assert(_initialized);
-
-    std::string filepath = getFilepath(metadata.key);
-
-    Lock lock(_filesMutex);
+    waitForInitialization();
 
     // if file already exists, return it
     FilePointer file = getFile(metadata.key);
@@ -110,20 +194,145 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata) {
         return file;
     }
 
-    // write the new file
-    FILE* saveFile = fopen(filepath.c_str(), "wb");
-    if (saveFile != nullptr && fwrite(data, metadata.length, 1, saveFile) && fclose(saveFile) == 0) {
-        file = addFile(std::move(metadata), filepath);
-    } else {
+    return writeAndAddFile(data, std::move(metadata));
+}
+
+FilePointer FileCache::writeAndAddFile(const char* data, Metadata&& metadata) {
+    std::string filepath = getFilepath(metadata.key);
+
+    // the file is written without the lock, a concurrent write of the same key writes the same content
+    if (!writeData(data, metadata.length, filepath)) {
         qCWarning(file_cache, "[%s] Failed to write %s (%s)", _dirname.c_str(), metadata.key.c_str(), strerror(errno));
         errno = 0;
+        return FilePointer();
     }
 
+    Lock lock(_filesMutex);
+    FilePointer file = getFile(metadata.key);
+    if (!file) {
+        file = addFile(std::move(metadata), filepath);
+    }
     return file;
 }
 
+bool FileCache::writeData(const char* data, size_t length, const std::string& filepath) {
+    static std::atomic<uint32_t> partCount { 0 };
+    std::string partPath = filepath + '.' + std::to_string(++partCount) + '.' + PART_EXT;
+
+    FILE* saveFile = fopen(partPath.c_str(), "wb");
+    if (saveFile == nullptr) {
+        return false;
+    }
+    bool written = fwrite(data, length, 1, saveFile) == 1;
+    if (fclose(saveFile) != 0 || !written || !QFile::rename(partPath.c_str(), filepath.c_str())) {
+        QFile(partPath.c_str()).remove();
+        // the files are named by their content, one that is already there was written by another write of the key
+        return written && QFile::exists(filepath.c_str());
+    }
+    return true;
+}
+
+void FileCache::writeFileAsync(const QByteArray& data, Metadata&& metadata, WriteCallback callback) {
+    waitForInitialization();
+
+    // if file already exists, hand it over
+    FilePointer file = getFile(metadata.key);
+    if (file) {
+        callback(file);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_writesMutex);
+
+        auto it = _pendingWrites.find(metadata.key);
+        if (it != _pendingWrites.end()) {
+            // the same file is already waiting to be written
+            it->second.callbacks.push_back(callback);
+            return;
+        }
+
+        if (!_writeThread) {
+            _writeThread = new QThread();
+            _writeThread->setObjectName(QString("FileCache %1 Write Thread").arg(_dirname.c_str()));
+            connect(_writeThread, &QThread::started, this, &FileCache::runWrites, Qt::DirectConnection);
+            _writeThread->start();
+        }
+
+        const Key key = metadata.key;
+        auto write = _pendingWrites.emplace(key, PendingWrite(data, std::move(metadata), usecTimestampNow())).first;
+        write->second.callbacks.push_back(callback);
+        _writeQueue.push_back(key);
+        _numPendingWrites += 1;
+    }
+    _writeReady.notify_one();
+
+    emit dirty();
+}
+
+void FileCache::runWrites() {
+    std::unique_lock<std::mutex> lock(_writesMutex);
+    while (!_stopWriting) {
+        if (_writeQueue.empty()) {
+            _writeReady.wait(lock);
+            continue;
+        }
+
+        auto it = _pendingWrites.find(_writeQueue.front());
+        PendingWrite write = std::move(it->second);
+        _pendingWrites.erase(it);
+        _writeQueue.pop_front();
+        lock.unlock();
+
+        FilePointer file = getFile(write.metadata.key);
+        if (!file) {
+            file = writeAndAddFile(write.data.constData(), std::move(write.metadata));
+        }
+
+        quint64 latency = usecTimestampNow() - write.queuedTime;
+        _writeLatency = (_writeLatency * (WRITE_LATENCY_SAMPLES - 1) + latency) / WRITE_LATENCY_SAMPLES;
+
+        for (const auto& callback : write.callbacks) {
+            callback(file);
+        }
+        _numPendingWrites -= 1;
+        emit dirty();
+
+        lock.lock();
+    }
+}
+
+void FileCache::stopWriting() {
+    // the initialization creates files through the derived class, which calls this as it is destroyed
+    if (_initialization.valid()) {
+        std::lock_guard<std::mutex> lock(_initializationMutex);
+        _initialization.wait();
+    }
+
+    if (!_writeThread) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_writesMutex);
+        _stopWriting = true;
+        if (!_writeQueue.empty()) {
+            qCDebug(file_cache, "[%s] Dropped %d queued writes", _dirname.c_str(), (int)_writeQueue.size());
+        }
+        _writeQueue.clear();
+        _pendingWrites.clear();
+    }
+    _writeReady.notify_one();
+
+    _writeThread->quit();
+    _writeThread->wait();
+    delete _writeThread;
+    _writeThread = nullptr;
+    _numPendingWrites = 0;
+}
+
 FilePointer FileCache::getFile(const Key& key) {
-    assert(_initialized);
+    waitForInitialization();
 
     FilePointer file;
 
@@ -151,6 +360,10 @@ std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + '/' + key + '.' + _ext;
 }
 
+std::string FileCache::getManifestPath() {
+    return _dirpath + '/' + MANIFEST_NAME;
+}
+
 void FileCache::addUnusedFile(const FilePointer file) {
     {
         Lock lock(_filesMutex);
@@ -201,11 +414,14 @@ void FileCache::reserve(size_t length) {
         _numUnusedFiles -= 1;
         _totalFilesSize -= length;
         _unusedFilesSize -= length;
+        _numEvictedFiles += 1;
+        _evictedFilesSize += length;
     }
 }
 
 void FileCache::clear() {
     Lock unusedFilesLock(_unusedFilesMutex);
+    std::vector<FilePointer> persistedFiles;
     for (const auto& pair : _unusedFiles) {
         auto& file = pair.second;
         file->_cache = nullptr;
@@ -214,10 +430,15 @@ void FileCache::clear() {
             _totalFilesSize -= file->getLength();
         } else {
             file->_shouldPersist = true;
+            persistedFiles.push_back(file);
             qCDebug(file_cache, "[%s] Persisting %s", _dirname.c_str(), file->getKey().c_str());
         }
     }
     _unusedFiles.clear();
+
+    if (_initialized) {
+        writeManifest(persistedFiles);
+    }
 }
 
 void File::deleter() {
@@ -11,16 +11,24 @@
 #define hifi_FileCache_h
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
 #include <map>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include <QByteArray>
 #include <QObject>
 #include <QLoggingCategory>
 
+class QThread;
+
 Q_DECLARE_LOGGING_CATEGORY(file_cache)
 
 namespace cache {
@@ -34,6 +42,10 @@ class FileCache : public QObject {
     Q_PROPERTY(size_t numCached READ getNumCachedFiles NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalFiles NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedFiles NOTIFY dirty)
+    Q_PROPERTY(size_t numPendingWrites READ getNumPendingWrites NOTIFY dirty)
+    Q_PROPERTY(quint64 writeLatency READ getWriteLatency NOTIFY dirty)
+    Q_PROPERTY(size_t numEvicted READ getNumEvictedFiles NOTIFY dirty)
+    Q_PROPERTY(size_t sizeEvicted READ getSizeEvictedFiles NOTIFY dirty)
 
     static const size_t DEFAULT_UNUSED_MAX_SIZE;
     static const size_t MAX_UNUSED_MAX_SIZE;
@@ -44,6 +56,11 @@ public:
     size_t getNumCachedFiles() const { return _numUnusedFiles; }
     size_t getSizeTotalFiles() const { return _totalFilesSize; }
     size_t getSizeCachedFiles() const { return _unusedFilesSize; }
+    size_t getNumPendingWrites() const { return _numPendingWrites; }
+    /// the average time a file waits for its queued write, and takes to write, in microseconds
+    quint64 getWriteLatency() const { return _writeLatency; }
+    size_t getNumEvictedFiles() const { return _numEvictedFiles; }
+    size_t getSizeEvictedFiles() const { return _evictedFilesSize; }
 
     void setUnusedFileCacheSize(size_t unusedFilesMaxSize);
     size_t getUnusedFileCacheSize() const { return _unusedFilesSize; }
@@ -79,20 +96,55 @@ signals:
 protected:
     /// must be called after construction to create the cache on the fs and restore persisted files
     void initialize();
+    /// initializes on a thread of its own, the methods of the cache wait for it where they need the files
+    void initializeAsync();
 
     FilePointer writeFile(const char* data, Metadata&& metadata);
     FilePointer getFile(const Key& key);
 
+    using WriteCallback = std::function<void(const FilePointer& file)>;
+    /// queues the file to be written on the I/O thread of the cache, and calls back on that thread with the file once it
+    /// is written (or null if it could not be) - right away if the file is already in the cache
+    /// the data must stay valid until the callback is called, the writes of a key that is already queued are merged
+    void writeFileAsync(const QByteArray& data, Metadata&& metadata, WriteCallback callback);
+
+    /// stops the I/O thread, dropping the queued writes - must be called by the destructor of derived classes, as the
+    /// writes create their files
+    void stopWriting();
+
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath) = 0;
 
+private slots:
+    void runWrites();
+
 private:
     using Mutex = std::recursive_mutex;
     using Lock = std::unique_lock<Mutex>;
 
     friend class File;
 
+    struct PendingWrite {
+        PendingWrite(const QByteArray& data, Metadata&& metadata, quint64 queuedTime) :
+            data(data), metadata(std::move(metadata)), queuedTime(queuedTime) {}
+        QByteArray data;
+        Metadata metadata;
+        quint64 queuedTime;
+        std::vector<WriteCallback> callbacks;
+    };
+
     std::string getFilepath(const Key& key);
+    std::string getManifestPath();
+
+    /// writes the data next to the file and moves it in place, a file that is already there has the same content
+    bool writeData(const char* data, size_t length, const std::string& filepath);
+    FilePointer writeAndAddFile(const char* data, Metadata&& metadata);
+
+    void waitForInitialization();
+
+    bool loadManifest();
+    void loadDirectory();
+    void writeManifest(const std::vector<FilePointer>& files);
 
     FilePointer addFile(Metadata&& metadata, const std::string& filepath);
     void addUnusedFile(const FilePointer file);
@@ -104,11 +156,17 @@ private:
     std::atomic<size_t> _numUnusedFiles { 0 };
     std::atomic<size_t> _totalFilesSize { 0 };
     std::atomic<size_t> _unusedFilesSize { 0 };
+    std::atomic<size_t> _numPendingWrites { 0 };
+    std::atomic<quint64> _writeLatency { 0 };
+    std::atomic<size_t> _numEvictedFiles { 0 };
+    std::atomic<size_t> _evictedFilesSize { 0 };
 
     std::string _ext;
     std::string _dirname;
     std::string _dirpath;
-    bool _initialized { false };
+    std::atomic<bool> _initialized { false };
+    std::future<void> _initialization;
+    std::mutex _initializationMutex;
 
     std::unordered_map<Key, std::weak_ptr<File>> _files;
     Mutex _filesMutex;
@@ -119,6 +177,14 @@ private:
     int _lastLRUKey { 0 };
 
     size_t _offlineFilesMaxSize { DEFAULT_OFFLINE_MAX_SIZE };
+
+    // the writes waiting for the I/O thread, in order
+    QThread* _writeThread { nullptr };
+    bool _stopWriting { false };
+    std::deque<Key> _writeQueue;
+    std::unordered_map<Key, PendingWrite> _pendingWrites;
+    std::mutex _writesMutex;
+    std::condition_variable _writeReady;
 };
 
 class File : public QObject {
@@ -25,7 +25,14 @@ void FileResourceRequest::doSend() {
     QFile file(filename);
     if (file.exists()) {
         if (file.open(QFile::ReadOnly)) {
-            _data = file.readAll();
+            _totalSizeOfResource = file.size();
+            if (_byteRange.isSet()) {
+                _byteRange.fixupRange(_totalSizeOfResource);
+                file.seek(_byteRange.fromInclusive);
+                _data = file.read(_byteRange.size());
+            } else {
+                _data = file.readAll();
+            }
             _result = ResourceRequest::Success;
         } else {
             _result = ResourceRequest::AccessDenied;
@@ -53,12 +53,26 @@ void HTTPResourceRequest::doSend() {
     networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, HIGH_FIDELITY_USER_AGENT);
 
-    if (_cacheEnabled) {
+    if (_cacheEnabled && !_byteRange.isSet()) {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
     } else {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
     }
 
+    if (_byteRange.isSet()) {
+        QString byteRange;
+        if (_byteRange.fromInclusive < 0) {
+            byteRange = QString("bytes=%1").arg(_byteRange.fromInclusive);
+        } else {
+            // the end of an HTTP byte range is inclusive
+            byteRange = QString("bytes=%1-%2").arg(_byteRange.fromInclusive).arg(_byteRange.toExclusive - 1);
+        }
+        networkRequest.setRawHeader("Range", byteRange.toLatin1());
+
+        // a partial reply must not be cached as the resource
+        networkRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    }
+
     _reply = NetworkAccessManager::getInstance().get(networkRequest);
     
     connect(_reply, &QNetworkReply::finished, this, &HTTPResourceRequest::onRequestFinished);
@@ -78,6 +92,24 @@ void HTTPResourceRequest::onRequestFinished() {
             _data = _reply->readAll();
             _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
+
+            if (_byteRange.isSet()) {
+                const int PARTIAL_CONTENT_STATUS_CODE = 206;
+                auto statusCode = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+                if (statusCode == PARTIAL_CONTENT_STATUS_CODE) {
+                    // Content-Range: bytes <first>-<last>/<total size>
+                    auto contentRange = QString(_reply->rawHeader("Content-Range"));
+                    auto totalSize = contentRange.mid(contentRange.lastIndexOf('/') + 1);
+                    _totalSizeOfResource = totalSize == "*" ? -1 : totalSize.toLongLong();
+                } else {
+                    // the server doesn't do range requests and replied with the whole resource
+                    _totalSizeOfResource = _data.size();
+                    _byteRange.fixupRange(_totalSizeOfResource);
+                    _data = _data.mid(_byteRange.fromInclusive, _byteRange.size());
+                }
+            } else {
+                _totalSizeOfResource = _data.size();
+            }
             break;
 
         case QNetworkReply::TimeoutError:
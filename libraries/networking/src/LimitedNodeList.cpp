@@ -18,6 +18,7 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtNetwork/QHostInfo>
@@ -36,6 +37,7 @@
 #include "Assignment.h"
 #include "HifiSockAddr.h"
 #include "NetworkLogging.h"
+#include "udt/BBRCC.h"
 #include "udt/Packet.h"
 #include <Trace.h>
 
@@ -70,6 +72,16 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     }
 
     qRegisterMetaType<ConnectionStep>("ConnectionStep");
+
+    // TCP Vegas is the default, BBR copes better with random loss (e.g. on wifi)
+    static const QString CONGESTION_CONTROL_ENV = "HIFI_UDT_CONGESTION_CONTROL";
+    QString congestionControl = QProcessEnvironment::systemEnvironment().value(CONGESTION_CONTROL_ENV).toLower();
+    if (congestionControl == "bbr") {
+        qCDebug(networking) << "Using BBR congestion control for the NodeList socket";
+        _nodeSocket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+    }
+
     auto port = (socketListenPort != INVALID_PORT) ? socketListenPort : LIMITED_NODELIST_LOCAL_PORT.get();
     _nodeSocket.bind(QHostAddress::AnyIPv4, port);
     qCDebug(networking) << "NodeList socket is listening on" << _nodeSocket.localPort();
@@ -354,7 +366,7 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiS
 }
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode) {
-    Q_ASSERT(!packet->isPartOfMessage());
+    Q_ASSERT(!packet->isPartOfMessage() || packet->isLatestOnly());
     auto activeSocket = destinationNode.getActiveSocket();
 
     if (activeSocket) {
@@ -370,8 +382,8 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                                    const QUuid& connectionSecret) {
-    Q_ASSERT(!packet->isPartOfMessage());
-    if (packet->isReliable()) {
+    Q_ASSERT(!packet->isPartOfMessage() || packet->isLatestOnly());
+    if (packet->isReliable() || packet->isLatestOnly()) {
         collectPacketStats(*packet);
         fillPacketHeader(*packet, connectionSecret);
 
@@ -422,7 +434,8 @@ qint64 LimitedNodeList::sendPacketList(NLPacketList& packetList, const HifiSockA
 }
 
 qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const HifiSockAddr& sockAddr) {
-    // close the last packet in the list
+    // close the last packet in the list, compressing the message first if it is worth it
+    packetList->compressIfLarge();
     packetList->closeCurrentPacket();
 
     for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
@@ -437,7 +450,8 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
 qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode) {
     auto activeSocket = destinationNode.getActiveSocket();
     if (activeSocket) {
-        // close the last packet in the list
+        // close the last packet in the list, compressing the message first if it is worth it
+        packetList->compressIfLarge();
         packetList->closeCurrentPacket();
 
         for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
@@ -517,11 +531,32 @@ void LimitedNodeList::eraseAllNodes() {
         }
     }
 
+    if (!killedNodes.isEmpty()) {
+        updateNodeSnapshot();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
 }
 
+void LimitedNodeList::updateNodeSnapshot() {
+    std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+
+    auto snapshot = std::make_shared<NodeSnapshot>();
+    {
+        QReadLocker readLocker(&_nodeMutex);
+        snapshot->nodes.reserve(_nodeHash.size());
+        std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(snapshot->nodes),
+                       [](const NodeHash::value_type& it) {
+            return it.second;
+        });
+    }
+    snapshot->epoch = std::atomic_load(&_nodeSnapshot)->epoch + 1;
+
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
+}
+
 void LimitedNodeList::reset() {
     eraseAllNodes();
 
@@ -542,6 +577,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID) {
             QWriteLocker writeLocker(&_nodeMutex);
             _nodeHash.unsafe_erase(it);
         }
+        updateNodeSnapshot();
 
         handleNodeKill(matchingNode);
         return true;
@@ -622,6 +658,9 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         _nodeHash.insert(UUIDNodePair(newNode->getUUID(), newNodePointer));
         readLocker.unlock();
 
+        // publish the new node (and the removal of a previous solo node) before anyone hears about it
+        updateNodeSnapshot();
+
         qCDebug(networking) << "Added" << *newNode;
 
         emit nodeAdded(newNodePointer);
@@ -731,6 +770,8 @@ void LimitedNodeList::resetPacketStats() {
     _numCollectedPackets = 0;
     _numCollectedBytes = 0;
 
+    udt::PacketBufferPool::resetStats();
+
     _packetStatTimer.restart();
 }
 
@@ -755,6 +796,10 @@ void LimitedNodeList::removeSilentNodes() {
         node->getMutex().unlock();
     });
 
+    if (!killedNodes.isEmpty()) {
+        updateNodeSnapshot();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
@@ -16,8 +16,10 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -43,6 +45,7 @@
 #include "PacketReceiver.h"
 #include "ReceivedMessage.h"
 #include "udt/ControlPacket.h"
+#include "udt/PacketBufferPool.h"
 #include "udt/PacketHeaders.h"
 #include "udt/Socket.h"
 #include "UUIDHasher.h"
@@ -66,6 +69,12 @@ const QHostAddress DEFAULT_ASSIGNMENT_CLIENT_MONITOR_HOSTNAME = QHostAddress::Lo
 
 const QString USERNAME_UUID_REPLACEMENT_STATS_KEY = "$username";
 
+// the segments of a DomainListDelta packet start with one of these
+enum class DomainListChange : quint8 {
+    AddedNode,
+    RemovedNode
+};
+
 using namespace tbb;
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
@@ -126,6 +135,7 @@ public:
     qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
                                 const QUuid& connectionSecret = QUuid());
 
+    // reliable and latest only packets are handed to the connection's send queue, others are sent right away
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
                       const QUuid& connectionSecret = QUuid());
@@ -138,7 +148,7 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeSnapshot()->nodes.size(); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
 
@@ -165,6 +175,8 @@ public:
     void getPacketStats(float& packetsInPerSecond, float& bytesInPerSecond, float& packetsOutPerSecond, float& bytesOutPerSecond);
     void resetPacketStats();
 
+    udt::PacketBufferPool::Stats getPacketBufferPoolStats() const { return udt::PacketBufferPool::getStats(); }
+
     std::unique_ptr<NLPacket> constructPingPacket(PingType_t pingType = PingType::Agnostic);
     std::unique_ptr<NLPacket> constructPingReplyPacket(ReceivedMessage& message);
 
@@ -178,66 +190,69 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // An immutable copy of the nodes, re-published (with a new epoch) whenever a node is added or killed
+    //   Iterating it takes no lock, and the nodes it holds stay alive for as long as it is held
+    struct NodeSnapshot {
+        uint64_t epoch { 0 };
+        std::vector<SharedNodePointer> nodes;
+    };
+    using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
+    // Cede control of iteration over a contiguous snapshot of the nodes (e.g. for use by thread pools)
+    // Use this for nested loops, and to partition the nodes by index!
+    //   No lock is held while the functor runs, so a thread pool can share the range
+    //   without blocking a dying node from being removed
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor, 
                     int* lockWaitOut = nullptr, 
                     int* nodeTransformOut = nullptr, 
                     int* functorOut = nullptr) {
         auto start = usecTimestampNow();
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            std::vector<SharedNodePointer> nodes(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), nodes.begin(), [](const NodeHash::value_type& it) {
-                return it.second;
-            });
-            auto endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        auto snapshot = getNodeSnapshot();
+        auto endSnapshot = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endSnapshot - start);
+        }
+        if (nodeTransformOut) {
+            // the snapshot is already a vector, there is nothing to transform
+            *nodeTransformOut = 0;
+        }
 
-            functor(nodes.cbegin(), nodes.cend());
-            auto endFunctor = usecTimestampNow();
-            if (functorOut) {
-                *functorOut = (endFunctor - endTransform);
-            }
+        functor(snapshot->nodes.cbegin(), snapshot->nodes.cend());
+        auto endFunctor = usecTimestampNow();
+        if (functorOut) {
+            *functorOut = (endFunctor - endSnapshot);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -245,11 +260,11 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const SharedNodePointer& node : snapshot->nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
@@ -349,6 +364,13 @@ protected:
     QUuid _sessionUUID;
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex;
+
+    // re-publishes _nodeSnapshot from _nodeHash, must be called after a node is added or removed
+    // and without holding _nodeMutex
+    void updateNodeSnapshot();
+
+    std::mutex _nodeSnapshotMutex; // Serializes the snapshot updates, so the last one published is current
+    std::shared_ptr<const NodeSnapshot> _nodeSnapshot { std::make_shared<NodeSnapshot>() }; // std::atomic_load/store only
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket;
     HifiSockAddr _localSockAddr;
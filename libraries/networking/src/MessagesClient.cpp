@@ -63,6 +63,12 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
     }
 }
 
+QString MessagesClient::decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage) {
+    quint16 channelLength;
+    receivedMessage->readPrimitive(&channelLength);
+    return QString::fromUtf8(receivedMessage->read(channelLength));
+}
+
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
     auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
 
@@ -39,6 +39,8 @@ public:
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
+    // reads only the channel, which a mixer needs to forward the message as it is
+    static QString decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage);
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
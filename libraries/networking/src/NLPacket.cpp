@@ -32,6 +32,14 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
+std::unique_ptr<NLPacket> NLPacket::createLatestOnly(PacketType type, StreamKey streamKey, qint64 size,
+                                                     PacketVersion version) {
+    auto packet = create(type, size, false, true, version);
+    packet->writeStreamKey(streamKey);
+    
+    return packet;
+}
+
 std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
                                                        const HifiSockAddr& senderSockAddr) {
     // Fail with null data
@@ -40,6 +40,10 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
+    // an unreliable packet of a state stream, that newer packets of the same stream supersede (see udt::Packet)
+    static std::unique_ptr<NLPacket> createLatestOnly(PacketType type, StreamKey streamKey, qint64 size = -1,
+                                                      PacketVersion version = 0);
+    
     static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
                                                         const HifiSockAddr& senderSockAddr);
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -19,6 +19,15 @@ std::unique_ptr<NLPacketList> NLPacketList::create(PacketType packetType, QByteA
     auto nlPacketList = std::unique_ptr<NLPacketList>(new NLPacketList(packetType, extendedHeader,
                                                                        isReliable, isOrdered));
     nlPacketList->open(WriteOnly);
+
+    // the extended header is repeated in every packet, which would get in the way of compressing the message
+    if (COMPRESSIBLE_MESSAGE_PACKETS.contains(packetType) && extendedHeader.isEmpty()) {
+        nlPacketList->_isCompressible = true;
+
+        // assume the message is small, compressIfLarge re-packs it otherwise
+        nlPacketList->writePrimitive(MessageCompression::None);
+    }
+
     return nlPacketList;
 }
 
@@ -41,6 +50,34 @@ NLPacketList::NLPacketList(PacketList&& other) : PacketList(std::move(other)) {
     }
 }
 
+void NLPacketList::compressIfLarge() {
+    if (!_isCompressible) {
+        return;
+    }
+
+    closeCurrentPacket();
+
+    auto message = getMessage();
+    if (message.size() < MIN_COMPRESSED_MESSAGE_BYTES || message.at(0) != (char)MessageCompression::None) {
+        // too small, or already compressed
+        return;
+    }
+
+    // skip our MessageCompression byte, and favour speed over ratio
+    static const int FAST_COMPRESSION_LEVEL = 1;
+    auto compressed = qCompress(reinterpret_cast<const uchar*>(message.constData()) + sizeof(MessageCompression),
+                                message.size() - (int)sizeof(MessageCompression), FAST_COMPRESSION_LEVEL);
+    if (compressed.size() >= message.size()) {
+        // doesn't compress, send it as is
+        return;
+    }
+
+    _packets.clear();
+    writePrimitive(MessageCompression::Zlib);
+    write(compressed);
+    closeCurrentPacket();
+}
+
 std::unique_ptr<udt::Packet> NLPacketList::createPacket() {
     return NLPacket::create(getType(), -1, isReliable(), isOrdered());
 }
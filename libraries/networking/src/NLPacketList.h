@@ -16,13 +16,28 @@
 
 #include "NLPacket.h"
 
+// The first byte of a message whose type is in COMPRESSIBLE_MESSAGE_PACKETS
+enum class MessageCompression : uint8_t {
+    None = 0,
+    Zlib // the rest of the message is qCompress'ed
+};
+
 class NLPacketList : public udt::PacketList {
 public:
+    // messages smaller than this aren't worth compressing
+    static const int MIN_COMPRESSED_MESSAGE_BYTES = 1024;
+
     static std::unique_ptr<NLPacketList> create(PacketType packetType, QByteArray extendedHeader = QByteArray(),
                                                 bool isReliable = false, bool isOrdered = false);
     
     PacketVersion getVersion() const { return _packetVersion; }
     const QUuid& getSourceID() const { return _sourceID; }
+
+    bool isCompressible() const { return _isCompressible; }
+
+    // Once the message is written, re-packs it compressed if it is compressible and large enough for that to pay off
+    // The LimitedNodeList calls this when sending the list
+    void compressIfLarge();
     
 private:
     NLPacketList(PacketType packetType, QByteArray extendedHeader = QByteArray(), bool isReliable = false,
@@ -36,6 +51,7 @@ private:
 
     PacketVersion _packetVersion;
     QUuid _sourceID;
+    bool _isCompressible { false };
 };
 
 Q_DECLARE_METATYPE(QSharedPointer<NLPacketList>)
@@ -76,6 +76,7 @@ public:
     void addIgnoredNode(const QUuid& otherNodeID);
     void removeIgnoredNode(const QUuid& otherNodeID);
     bool isIgnoringNodeWithID(const QUuid& nodeID) const { QReadLocker lock { &_ignoredNodeIDSetLock }; return _ignoredNodeIDSet.find(nodeID) != _ignoredNodeIDSet.cend(); }
+    bool hasIgnoredNodes() const { QReadLocker lock { &_ignoredNodeIDSetLock }; return !_ignoredNodeIDSet.empty(); }
     void parseIgnoreRadiusRequestMessage(QSharedPointer<ReceivedMessage> message);
 
     friend QDataStream& operator<<(QDataStream& out, const Node& node);
@@ -83,6 +84,10 @@ public:
 
     bool isIgnoreRadiusEnabled() const { return _ignoreRadiusEnabled; }
 
+    // the share of this node's downstream bandwidth the domain-server gives us to send in, 0 when it has given none
+    int getBandwidthBudgetKbps() const { return _bandwidthBudgetKbps; }
+    void setBandwidthBudgetKbps(int bandwidthBudgetKbps) { _bandwidthBudgetKbps = bandwidthBudgetKbps; }
+
 private:
     // privatize copy and assignment operator to disallow Node copying
     Node(const Node &otherNode);
@@ -102,6 +107,7 @@ private:
     mutable QReadWriteLock _ignoredNodeIDSetLock;
 
     std::atomic_bool _ignoreRadiusEnabled;
+    std::atomic_int _bandwidthBudgetKbps { 0 };
 };
 
 Q_DECLARE_METATYPE(Node*)
@@ -117,6 +117,8 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
 
     auto& packetReceiver = getPacketReceiver();
     packetReceiver.registerListener(PacketType::DomainList, this, "processDomainServerList");
+    packetReceiver.registerListener(PacketType::DomainListDelta, this, "processDomainListDelta");
+    packetReceiver.registerListener(PacketType::NodeBandwidthBudgets, this, "processNodeBandwidthBudgets");
     packetReceiver.registerListener(PacketType::Ping, this, "processPingPacket");
     packetReceiver.registerListener(PacketType::PingReply, this, "processPingReplyPacket");
     packetReceiver.registerListener(PacketType::ICEPing, this, "processICEPingPacket");
@@ -238,6 +240,7 @@ void NodeList::reset() {
     LimitedNodeList::reset();
 
     _numNoReplyDomainCheckIns = 0;
+    _domainListVersion = 0;
 
     // lock and clear our set of radius ignored IDs
     _radiusIgnoredSetLock.lockForWrite();
@@ -397,6 +400,14 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the domain-server replies with the changes since this version, or the full list if we missed some
+            packetStream << _domainListVersion;
+
+            // and splits what we measure we can receive between the mixers that send to us
+            packetStream << (quint32)_nodeSocket.getEstimatedReceiveKbps();
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -626,12 +637,88 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // the deltas that follow build on this version
+    packetStream >> _domainListVersion;
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
     }
 }
 
+void NodeList::processDomainListDelta(QSharedPointer<ReceivedMessage> message) {
+    if (_domainHandler.getSockAddr().isNull() || !_domainHandler.isConnected()) {
+        // deltas only make sense on top of a full list from the domain-server we're connected to
+        return;
+    }
+
+    // this is a reply to our check-in too, reset the count of un-replied check-ins
+    _numNoReplyDomainCheckIns = 0;
+
+    emit receivedDomainServerList();
+
+    QDataStream packetStream(message->getMessage());
+
+    QUuid domainUUID;
+    QUuid sessionUUID;
+    packetStream >> domainUUID >> sessionUUID;
+
+    if (domainUUID != _domainHandler.getUUID() || sessionUUID != getSessionUUID()) {
+        qWarning() << "IGNORING DomainListDelta packet from" << domainUUID << "for session" << sessionUUID;
+        return;
+    }
+
+    NodePermissions newPermissions;
+    packetStream >> newPermissions;
+    setPermissions(newPermissions);
+
+    quint32 baseVersion;
+    quint32 version;
+    packetStream >> baseVersion >> version;
+
+    // the later packets of a delta find it applied already
+    if (baseVersion != _domainListVersion && version != _domainListVersion) {
+        // we missed a delta, our next check-in carries our old version and gets the full list back
+        qCDebug(networking) << "Ignoring domain list delta" << baseVersion << "->" << version
+            << "on top of version" << _domainListVersion;
+        return;
+    }
+    _domainListVersion = version;
+
+    while (packetStream.device()->pos() < message->getSize()) {
+        quint8 change;
+        packetStream >> change;
+
+        if (change == (quint8)DomainListChange::AddedNode) {
+            parseNodeFromPacketStream(packetStream);
+        } else {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+        }
+    }
+}
+
+void NodeList::processNodeBandwidthBudgets(QSharedPointer<ReceivedMessage> message) {
+    if (message->getSenderSockAddr() != _domainHandler.getSockAddr()) {
+        // only the domain-server hands out the budgets
+        return;
+    }
+
+    QDataStream packetStream(message->getMessage());
+
+    while (packetStream.device()->pos() < message->getSize()) {
+        QUuid nodeUUID;
+        quint32 budgetKbps;
+        packetStream >> nodeUUID >> budgetKbps;
+
+        SharedNodePointer node = nodeWithUUID(nodeUUID);
+        if (node) {
+            node->setBandwidthBudgetKbps((int)budgetKbps);
+        }
+    }
+}
+
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
     // setup a QDataStream
     QDataStream packetStream(message->getMessage());
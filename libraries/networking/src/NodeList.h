@@ -99,6 +99,8 @@ public slots:
     void handleDSPathQuery(const QString& newPath);
 
     void processDomainServerList(QSharedPointer<ReceivedMessage> message);
+    void processDomainListDelta(QSharedPointer<ReceivedMessage> message);
+    void processNodeBandwidthBudgets(QSharedPointer<ReceivedMessage> message);
     void processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message);
     void processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message);
     void processDomainServerPathResponse(QSharedPointer<ReceivedMessage> message);
@@ -160,6 +162,7 @@ private:
     NodeSet _nodeTypesOfInterest;
     DomainHandler _domainHandler;
     int _numNoReplyDomainCheckIns;
+    quint32 _domainListVersion { 0 }; // of the last list or delta applied, sent back with each check-in
     HifiSockAddr _assignmentServerSocket;
     bool _isShuttingDown { false };
     QTimer _keepAlivePingTimer;
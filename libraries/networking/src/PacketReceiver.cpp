@@ -26,6 +26,15 @@ PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
 }
 
 bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
+    return registerListenerForTypes(std::move(types), listener, slot, false);
+}
+
+bool PacketReceiver::registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
+    return registerListenerForTypes(std::move(types), listener, slot, true);
+}
+
+bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot,
+                                              bool deliverDirectly) {
     Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No object to register");
     Q_ASSERT_X(slot, "PacketReceiver::registerListenerForTypes", "No slot to register");
@@ -54,43 +63,31 @@ bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* lis
     }
     
     // Register non sourced types
-    std::for_each(std::begin(types), middle, [this, &listener, &nonSourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, nonSourcedMethod);
+    std::for_each(std::begin(types), middle, [&](PacketType type) {
+        registerVerifiedListener(type, listener, nonSourcedMethod, false, deliverDirectly);
     });
     
     // Register sourced types
-    std::for_each(middle, std::end(types), [this, &listener, &sourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, sourcedMethod);
+    std::for_each(middle, std::end(types), [&](PacketType type) {
+        registerVerifiedListener(type, listener, sourcedMethod, false, deliverDirectly);
     });
     
     return true;
 }
 
-void PacketReceiver::registerDirectListener(PacketType type, QObject* listener, const char* slot) {
+bool PacketReceiver::registerDirectListener(PacketType type, QObject* listener, const char* slot) {
     Q_ASSERT_X(listener, "PacketReceiver::registerDirectListener", "No object to register");
     Q_ASSERT_X(slot, "PacketReceiver::registerDirectListener", "No slot to register");
-    
-    bool success = registerListener(type, listener, slot);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener);
-    }
-}
 
-void PacketReceiver::registerDirectListenerForTypes(PacketTypeList types,
-                                                    QObject* listener, const char* slot) {
-    Q_ASSERT_X(listener, "PacketReceiver::registerDirectListenerForTypes", "No object to register");
-    Q_ASSERT_X(slot, "PacketReceiver::registerDirectListenerForTypes", "No slot to register");
-    
-    // just call register listener for types to start
-    bool success = registerListenerForTypes(std::move(types), listener, slot);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener);
+    QMetaMethod matchingMethod = matchingMethodForListener(type, listener, slot);
+
+    if (matchingMethod.isValid()) {
+        qCDebug(networking) << "Registering a direct packet listener for packet list type" << type;
+        registerVerifiedListener(type, listener, matchingMethod, false, true);
+        return true;
+    } else {
+        qCWarning(networking) << "FAILED to Register a direct packet listener for packet list type" << type;
+        return false;
     }
 }
 
@@ -165,7 +162,8 @@ QMetaMethod PacketReceiver::matchingMethodForListener(PacketType type, QObject*
     }
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot,
+                                              bool deliverPending, bool deliverDirectly) {
     Q_ASSERT_X(object, "PacketReceiver::registerVerifiedListener", "No object to register");
     QMutexLocker locker(&_packetListenerLock);
 
@@ -175,7 +173,7 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     }
     
     // add the mapping
-    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
+    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending, deliverDirectly };
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
@@ -195,9 +193,6 @@ void PacketReceiver::unregisterListener(QObject* listener) {
             }
         }
     }
-    
-    QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
-    _directlyConnectedObjects.remove(listener);
 }
 
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
@@ -283,13 +278,7 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
             
             bool success = false;
 
-            Qt::ConnectionType connectionType;
-            // check if this is a directly connected listener
-            {
-                QMutexLocker directConnectLocker(&_directConnectSetMutex);
- 
-                connectionType = _directlyConnectedObjects.contains(listener.object) ? Qt::DirectConnection : Qt::AutoConnection;
-            }
+            Qt::ConnectionType connectionType = listener.deliverDirectly ? Qt::DirectConnection : Qt::AutoConnection;
             
             PacketType packetType = receivedMessage->getType();
             
@@ -347,17 +336,11 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
             qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
                 << " has been destroyed. Removing from listener map.";
             it = _messageListenerMap.erase(it);
-            
-            // if it exists, remove the listener from _directlyConnectedObjects
-            {
-                QMutexLocker directConnectLocker(&_directConnectSetMutex);
-                _directlyConnectedObjects.remove(listener.object);
-            }
         }
     } else if (it == _messageListenerMap.end()) {
         qCWarning(networking) << "No listener found for packet type" << receivedMessage->getType();
         
         // insert a dummy listener so we don't print this again
-        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false });
+        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false, false });
     }
 }
@@ -28,9 +28,6 @@
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
-class EntityEditPacketSender;
-class OctreePacketProcessor;
-
 namespace std {
     template <>
     struct hash<std::pair<HifiSockAddr, udt::Packet::MessageNumber>> {
@@ -62,6 +59,13 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
+    // Direct listeners are invoked on the NodeList thread as soon as a message is received, instead of being
+    // queued to the thread of the listener. Their slots must be thread-safe, e.g. only push the message onto
+    // a concurrent queue that the listener drains from its own threads.
+    bool registerDirectListener(PacketType type, QObject* listener, const char* slot);
+    bool registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -73,30 +77,24 @@ private:
         QPointer<QObject> object;
         QMetaMethod method;
         bool deliverPending;
+        bool deliverDirectly;
     };
 
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
-    // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
-    // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
-    void registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
-    void registerDirectListener(PacketType type, QObject* listener, const char* slot);
+    bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot, bool deliverDirectly);
 
     QMetaMethod matchingMethodForListener(PacketType type, QObject* object, const char* slot) const;
-    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot,
+                                  bool deliverPending = false, bool deliverDirectly = false);
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
     int _inPacketCount = 0;
     int _inByteCount = 0;
     bool _shouldDropPackets = false;
-    QMutex _directConnectSetMutex;
-    QSet<QObject*> _directlyConnectedObjects;
 
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
-    
-    friend class EntityEditPacketSender;
-    friend class OctreePacketProcessor;
 };
 
 #endif // hifi_PacketReceiver_h
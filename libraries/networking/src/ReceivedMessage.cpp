@@ -12,13 +12,20 @@
 
 #include "ReceivedMessage.h"
 
+#include <QtCore/QtEndian>
+
 #include "QSharedPointer"
 
+#include "NetworkLogging.h"
+
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
 int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<ReceivedMessage>>("QSharedPointer<ReceivedMessage>");
 
 static const int HEAD_DATA_SIZE = 512;
 
+// the uncompressed size is read off the wire, don't let a bad one allocate too much
+static const quint32 MAX_DECOMPRESSED_MESSAGE_BYTES = 64 * 1024 * 1024;
+
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
       _headData(_data.mid(0, HEAD_DATA_SIZE)),
@@ -27,8 +34,10 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr()),
+      _firstPacketReceiveTime(p_high_resolution_clock::now()),
       _isComplete(true)
 {
+    decodeCompressedMessage();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
@@ -39,8 +48,12 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
+      _firstPacketReceiveTime(packet.getReceiveTime()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    if (_isComplete) {
+        decodeCompressedMessage();
+    }
 }
 
 void ReceivedMessage::setFailed() {
@@ -65,11 +78,56 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 
     if (packet.getPacketPosition() == NLPacket::PacketPosition::LAST) {
+        decodeCompressedMessage();
+
         _isComplete = true;
         emit completed();
     }
 }
 
+void ReceivedMessage::decodeCompressedMessage() {
+    if (!COMPRESSIBLE_MESSAGE_PACKETS.contains(_packetType)) {
+        return;
+    }
+
+    if (_data.isEmpty()) {
+        qCWarning(networking) << "Received an empty compressible message of type" << _packetType;
+        _failed = true;
+        return;
+    }
+
+    auto compression = (MessageCompression)_data.at(0);
+    auto compressedSize = _data.size() - (int)sizeof(MessageCompression);
+
+    if (compression == MessageCompression::None) {
+        _data.remove(0, sizeof(MessageCompression));
+    } else if (compression == MessageCompression::Zlib && compressedSize >= (int)sizeof(quint32)) {
+        auto compressedData = reinterpret_cast<const uchar*>(_data.constData()) + sizeof(MessageCompression);
+
+        // qCompress prefixes the data with its uncompressed size
+        quint32 uncompressedSize = qFromBigEndian<quint32>(compressedData);
+        if (uncompressedSize > MAX_DECOMPRESSED_MESSAGE_BYTES) {
+            qCWarning(networking) << "Received a compressed message of type" << _packetType
+                << "claiming to be" << uncompressedSize << "bytes - dropping it";
+            _data.clear();
+            _failed = true;
+        } else {
+            _data = qUncompress(compressedData, compressedSize);
+            if ((quint32)_data.size() != uncompressedSize) {
+                qCWarning(networking) << "Could not decompress a message of type" << _packetType;
+                _data.clear();
+                _failed = true;
+            }
+        }
+    } else {
+        qCWarning(networking) << "Received a message of type" << _packetType << "with a bad compression byte";
+        _data.clear();
+        _failed = true;
+    }
+
+    _headData = _data.mid(0, HEAD_DATA_SIZE);
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
     memcpy(data, _data.constData() + _position, size);
     return size;
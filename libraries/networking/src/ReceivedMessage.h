@@ -48,6 +48,9 @@ public:
 
     qint64 getSize() const { return _data.size(); }
 
+    // when the socket read the first packet of this message
+    p_high_resolution_clock::time_point getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
+
     qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
 
     void seek(qint64 position) { _position = position; }
@@ -85,6 +88,9 @@ private slots:
     void onComplete();
 
 private:
+    // strips the MessageCompression byte of a complete compressible message, and decompresses it if needed
+    void decodeCompressedMessage();
+
     QByteArray _data;
     QByteArray _headData;
 
@@ -95,6 +101,7 @@ private:
     PacketType _packetType;
     PacketVersion _packetVersion;
     HifiSockAddr _senderSockAddr;
+    p_high_resolution_clock::time_point _firstPacketReceiveTime;
 
     std::atomic<bool> _isComplete { true };  
     std::atomic<bool> _failed { false };
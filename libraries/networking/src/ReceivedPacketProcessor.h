@@ -60,6 +60,10 @@ protected:
     /// \param QByteArray& the packet to be processed
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) = 0;
 
+    /// Processes the packets taken from the queue in one pass, in the order they were received. Default calls processPacket()
+    /// and midProcess() for each of them, override to process them together.
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets);
+
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
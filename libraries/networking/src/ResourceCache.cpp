@@ -9,12 +9,15 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
 
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -30,23 +33,192 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
-void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+const int DEFAULT_REQUEST_LIMIT = 10;
+
+// the limit of active requests an origin starts with, the measured throughput moves it from there
+const int DEFAULT_ORIGIN_REQUEST_LIMIT = 4;
+const int MIN_ORIGIN_REQUEST_LIMIT = 1;
+
+// the throughput of an origin is measured over the requests that complete in at least this long
+const quint64 THROUGHPUT_SAMPLE_USECS = USECS_PER_SECOND;
+
+void ResourceCacheSharedItems::Origin::push(const PendingRequest& request) {
+    auto it = indices.find(request.key);
+    if (it != indices.end()) {
+        // the request is already pending, or a freed resource still in the heap had the same address
+        pending[it.value()] = request;
+        update(it.value());
+        return;
+    }
+    indices.insert(request.key, pending.size());
+    pending.push_back(request);
+    siftUp(pending.size() - 1);
+}
+
+void ResourceCacheSharedItems::Origin::removeAt(size_t index) {
+    size_t last = pending.size() - 1;
+    indices.remove(pending[index].key);
+    if (index != last) {
+        pending[index] = pending[last];
+        indices[pending[index].key] = index;
+    }
+    pending.pop_back();
+    if (index < pending.size()) {
+        update(index);
+    }
+}
+
+void ResourceCacheSharedItems::Origin::update(size_t index) {
+    if (index > 0 && pending[index].priority > pending[(index - 1) / 2].priority) {
+        siftUp(index);
+    } else {
+        siftDown(index);
+    }
+}
+
+void ResourceCacheSharedItems::Origin::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (pending[index].priority <= pending[parent].priority) {
+            break;
+        }
+        swap(index, parent);
+        index = parent;
+    }
+}
+
+void ResourceCacheSharedItems::Origin::siftDown(size_t index) {
+    while (true) {
+        size_t highest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < pending.size() && pending[left].priority > pending[highest].priority) {
+            highest = left;
+        }
+        if (right < pending.size() && pending[right].priority > pending[highest].priority) {
+            highest = right;
+        }
+        if (highest == index) {
+            break;
+        }
+        swap(index, highest);
+        index = highest;
+    }
+}
+
+void ResourceCacheSharedItems::Origin::swap(size_t first, size_t second) {
+    std::swap(pending[first], pending[second]);
+    indices[pending[first].key] = first;
+    indices[pending[second].key] = second;
+}
+
+ResourceCacheSharedItems::ResourceCacheSharedItems() :
+    _maximumOriginLimit(DEFAULT_REQUEST_LIMIT) {
+}
+
+QString ResourceCacheSharedItems::getOrigin(const QSharedPointer<Resource>& resource) {
+    const QUrl& url = resource->_activeUrl;
+    return url.scheme() + "://" + url.host() + ":" + QString::number(url.port());
+}
+
+ResourceCacheSharedItems::Origin& ResourceCacheSharedItems::findOrigin(const QString& name) {
+    auto it = _origins.find(name);
+    if (it == _origins.end()) {
+        it = _origins.insert(name, Origin());
+        it->limit = std::min(DEFAULT_ORIGIN_REQUEST_LIMIT, _maximumOriginLimit);
+    }
+    return it.value();
+}
+
+void ResourceCacheSharedItems::setMaximumOriginRequestLimit(int limit) {
     Lock lock(_mutex);
-    _loadingRequests.append(resource);
+    _maximumOriginLimit = std::max(limit, MIN_ORIGIN_REQUEST_LIMIT);
+    for (auto& origin : _origins) {
+        origin.limit = std::min(origin.limit, _maximumOriginLimit);
+    }
 }
 
-void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+bool ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> request) {
+    auto resource = request.lock();
+    if (!resource) {
+        return false;
+    }
+    QString name = getOrigin(resource);
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+
+    Origin& origin = findOrigin(name);
+    if (origin.active >= origin.limit) {
+        return false;
+    }
+    origin.active++;
+    LoadingRequest loadingRequest { request, resource.data(), name, usecTimestampNow() };
+    _loadingRequests.append(loadingRequest);
+    return true;
+}
+
+void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> request) {
+    auto resource = request.lock();
+    if (!resource) {
+        return;
+    }
+    QString name = getOrigin(resource);
+    float priority = resource->getLoadPriority();
+    Lock lock(_mutex);
+
+    // a request that is pending again, from another url, leaves the heap of its previous origin
+    auto it = _pendingOrigins.find(resource.data());
+    if (it != _pendingOrigins.end() && it.value() != name) {
+        Origin& previous = _origins[it.value()];
+        previous.removeAt(previous.indices.value(resource.data()));
+    }
+    _pendingOrigins.insert(resource.data(), name);
+    findOrigin(name).push({ request, resource.data(), priority });
+}
+
+bool ResourceCacheSharedItems::removePendingRequest(QWeakPointer<Resource> request) {
+    auto resource = request.lock();
+    if (!resource) {
+        return false;
+    }
+    Lock lock(_mutex);
+
+    auto it = _pendingOrigins.find(resource.data());
+    if (it == _pendingOrigins.end()) {
+        return false;
+    }
+    Origin& origin = _origins[it.value()];
+    origin.removeAt(origin.indices.value(resource.data()));
+    _pendingOrigins.erase(it);
+    return true;
+}
+
+void ResourceCacheSharedItems::updatePendingRequest(QWeakPointer<Resource> request) {
+    auto resource = request.lock();
+    if (!resource) {
+        return;
+    }
+    float priority = resource->getLoadPriority();
+    Lock lock(_mutex);
+
+    auto it = _pendingOrigins.find(resource.data());
+    if (it != _pendingOrigins.end()) {
+        Origin& origin = _origins[it.value()];
+        size_t index = origin.indices.value(resource.data());
+        origin.pending[index].priority = priority;
+        origin.update(index);
+    }
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
-        if (resource) {
-            result.append(resource);
+    for (const auto& origin : _origins) {
+        for (const auto& request : origin.pending) {
+            auto resource = request.resource.lock();
+            if (resource) {
+                result.append(resource);
+            }
         }
     }
 
@@ -55,14 +227,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return _pendingOrigins.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
+    for (const auto& request : _loadingRequests) {
+        auto resource = request.resource.lock();
         if (resource) {
             result.append(resource);
         }
@@ -77,15 +250,24 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
 }
 
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
+    auto doneResource = resource.lock();
     Lock lock(_mutex);
 
     // resource can only be removed if it still has a ref-count, as
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        const auto& request = _loadingRequests.at(i);
+        auto loadingResource = request.resource.lock();
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        if (!loadingResource || loadingResource == doneResource) {
+            auto it = _origins.find(request.origin);
+            if (it != _origins.end()) {
+                it->active--;
+                if (loadingResource) {
+                    adaptLimit(it.value(), request.startTime, loadingResource->getBytesReceived());
+                }
+            }
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -93,33 +275,81 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
+void ResourceCacheSharedItems::adaptLimit(Origin& origin, quint64 startTime, qint64 bytes) {
+    if (origin.sampleStart == 0) {
+        origin.sampleStart = startTime;
+    }
+    origin.sampleBytes += bytes;
+
+    quint64 now = usecTimestampNow();
+    quint64 elapsed = now - origin.sampleStart;
+    if (elapsed >= THROUGHPUT_SAMPLE_USECS) {
+        float throughput = (float)origin.sampleBytes * USECS_PER_SECOND / elapsed;
+
+        // the limit only holds back an origin that has requests waiting, step it further the way that raised the
+        // throughput, and back the other way if the last step lowered it
+        if (!origin.pending.empty()) {
+            if (throughput < origin.lastThroughput) {
+                origin.limitStep = -origin.limitStep;
+            }
+            origin.limit = clamp(origin.limit + origin.limitStep, MIN_ORIGIN_REQUEST_LIMIT, _maximumOriginLimit);
+        }
+        origin.lastThroughput = throughput;
+        origin.sampleStart = now;
+        origin.sampleBytes = 0;
+    }
+
+    if (origin.active == 0) {
+        // the time the origin is idle is not part of its throughput
+        origin.sampleStart = 0;
+        origin.sampleBytes = 0;
+    }
+}
+
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
+    // look for the highest priority pending request of the origins that can take another request
+    Origin* highestOrigin = nullptr;
     float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
+    for (auto& origin : _origins) {
+        if (origin.active >= origin.limit) {
             continue;
         }
 
+        while (!origin.pending.empty()) {
+            // Clear any freed resources
+            const auto& top = origin.pending.front();
+            auto resource = top.resource.lock();
+            if (!resource) {
+                _pendingOrigins.remove(top.key);
+                origin.removeAt(0);
+                continue;
+            }
+
+            // the priority of a resource drops without an update when one of its owners is deleted
+            float priority = resource->getLoadPriority();
+            if (priority < top.priority) {
+                origin.pending.front().priority = priority;
+                origin.siftDown(0);
+                continue;
+            }
+            break;
+        }
+
         // Check load priority
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
+        if (!origin.pending.empty() && origin.pending.front().priority >= highestPriority) {
+            highestPriority = origin.pending.front().priority;
+            highestOrigin = &origin;
         }
-        i++;
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    QSharedPointer<Resource> highestResource;
+    if (highestOrigin) {
+        const auto& top = highestOrigin->pending.front();
+        highestResource = top.resource.lock();
+        _pendingOrigins.remove(top.key);
+        highestOrigin->removeAt(0);
     }
 
     return highestResource;
@@ -218,9 +448,16 @@ ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
         connect(&domainHandler, &DomainHandler::disconnectedFromDomain,
             this, &ResourceCache::clearATPAssets, Qt::DirectConnection);
     }
+
+    if (DependencyManager::isSet<MemoryBudget>()) {
+        DependencyManager::get<MemoryBudget>()->registerClient(this);
+    }
 }
 
 ResourceCache::~ResourceCache() {
+    if (DependencyManager::isSet<MemoryBudget>()) {
+        DependencyManager::get<MemoryBudget>()->unregisterClient(this);
+    }
     clearUnusedResources();
 }
 
@@ -297,12 +534,21 @@ void ResourceCache::refresh(const QUrl& url) {
     }
 }
 
-QVariantList ResourceCache::getResourceList() {
+QVariantList ResourceCache::getResourceList(bool withTimelines) {
     QVariantList list;
     if (QThread::currentThread() != thread()) {
         // NOTE: invokeMethod does not allow a const QObject*
         QMetaObject::invokeMethod(this, "getResourceList", Qt::BlockingQueuedConnection,
-            Q_RETURN_ARG(QVariantList, list));
+            Q_RETURN_ARG(QVariantList, list), Q_ARG(bool, withTimelines));
+    } else if (withTimelines) {
+        QReadLocker locker(&_resourcesLock);
+        list.reserve(_resources.size());
+        for (auto& weakResource : _resources) {
+            auto resource = weakResource.lock();
+            if (resource) {
+                list << resource->getTimeline();
+            }
+        }
     } else {
         auto resources = _resources.uniqueKeys();
         list.reserve(resources.size());
@@ -313,9 +559,73 @@ QVariantList ResourceCache::getResourceList() {
 
     return list;
 }
+
+QVariantMap ResourceCache::getLoadSummary() {
+    // the phases between consecutive events of the timelines
+    const size_t NUM_PHASES = Resource::NUM_TIMELINE_EVENTS - 1;
+    static const std::array<const char*, NUM_PHASES> PHASE_NAMES { {
+        "queued", "waitingForFirstByte", "downloading", "waitingForDecode", "decoding", "uploading"
+    } };
+    std::array<quint64, NUM_PHASES> totals {};
+    std::array<quint64, NUM_PHASES> maxima {};
+    int numLoaded = 0;
+    int numFailed = 0;
+    int numLoading = 0;
+    quint64 firstQueued = UINT64_MAX;
+    quint64 lastUploaded = 0;
+
+    {
+        QReadLocker locker(&_resourcesLock);
+        for (auto& weakResource : _resources) {
+            auto resource = weakResource.lock();
+            if (!resource) {
+                continue;
+            }
+            if (resource->isLoaded()) {
+                ++numLoaded;
+            } else if (resource->isFailed()) {
+                ++numFailed;
+            } else {
+                ++numLoading;
+            }
+
+            for (size_t i = 0; i < NUM_PHASES; ++i) {
+                auto start = resource->getTimelineTime((Resource::TimelineEvent)i);
+                auto end = resource->getTimelineTime((Resource::TimelineEvent)(i + 1));
+                if (start != 0 && end >= start) {
+                    totals[i] += end - start;
+                    maxima[i] = std::max(maxima[i], end - start);
+                }
+            }
+
+            auto queued = resource->getTimelineTime(Resource::Queued);
+            if (queued != 0) {
+                firstQueued = std::min(firstQueued, queued);
+            }
+            lastUploaded = std::max(lastUploaded, resource->getTimelineTime(Resource::Uploaded));
+        }
+    }
+
+    QVariantMap totalsMap;
+    QVariantMap maximaMap;
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        totalsMap[PHASE_NAMES[i]] = (double)totals[i] / USECS_PER_MSEC;
+        maximaMap[PHASE_NAMES[i]] = (double)maxima[i] / USECS_PER_MSEC;
+    }
+
+    QVariantMap summary;
+    summary["loaded"] = numLoaded;
+    summary["failed"] = numFailed;
+    summary["loading"] = numLoading;
+    summary["wallTime"] = lastUploaded > firstQueued ? (double)(lastUploaded - firstQueued) / USECS_PER_MSEC : 0.0;
+    summary["totals"] = totalsMap;
+    summary["maxima"] = maximaMap;
+    return summary;
+}
  
 void ResourceCache::setRequestLimit(int limit) {
     _requestLimit = limit;
+    DependencyManager::get<ResourceCacheSharedItems>()->setMaximumOriginRequestLimit(limit);
 
     // Now go fill any new request spots
     while (attemptHighestPriorityRequest()) {
@@ -400,9 +710,12 @@ void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resourc
 }
 
 void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
+    evictUnusedResources(_unusedResourcesMaxSize - resourceSize);
+}
+
+void ResourceCache::evictUnusedResources(qint64 unusedResourcesMaxSize) {
     QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
+    while (!_unusedResources.empty() && _unusedResourcesSize > unusedResourcesMaxSize) {
         // unload the oldest resource
         QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
         
@@ -418,6 +731,13 @@ void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
     }
 }
 
+qint64 ResourceCache::releaseMemory(qint64 size) {
+    qint64 previousSize = _unusedResourcesSize;
+    evictUnusedResources(std::max(previousSize - size, (qint64)0));
+    resetResourceCounters();
+    return previousSize - _unusedResourcesSize;
+}
+
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
@@ -476,14 +796,13 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
-        // wait until a slot becomes available
+    if (_requestsActive >= _requestLimit || !sharedItems->appendActiveRequest(resource)) {
+        // wait until a slot becomes available, in all and for the origin of the resource
         sharedItems->appendPendingRequest(resource);
         return false;
     }
     
     ++_requestsActive;
-    sharedItems->appendActiveRequest(resource);
     resource->makeRequest();
     return true;
 }
@@ -493,7 +812,9 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
     --_requestsActive;
 
-    attemptHighestPriorityRequest();
+    // the limit of the origin may have been raised, fill every slot that is free
+    while (attemptHighestPriorityRequest()) {
+    }
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
@@ -502,7 +823,6 @@ bool ResourceCache::attemptHighestPriorityRequest() {
     return (resource && attemptRequest(resource));
 }
 
-const int DEFAULT_REQUEST_LIMIT = 10;
 int ResourceCache::_requestLimit = DEFAULT_REQUEST_LIMIT;
 int ResourceCache::_requestsActive = 0;
 
@@ -533,6 +853,9 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.insert(owner, priority);
+        DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequest(_self);
+        // a cancelled resource loads again when it is wanted
+        ensureLoading();
     }
 }
 
@@ -544,11 +867,18 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequest(_self);
+    ensureLoading();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
-    if (!(_failedToLoad || _loaded)) {
-        _loadPriorities.remove(owner);
+    if (!(_failedToLoad || _loaded) && _loadPriorities.remove(owner) > 0) {
+        getLoadPriority(); // drops the owners that were deleted
+        if (_loadPriorities.isEmpty()) {
+            cancelLoading();
+        } else {
+            DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequest(_self);
+        }
     }
 }
 
@@ -581,6 +911,25 @@ void Resource::refresh() {
     emit onRefresh();
 }
 
+void Resource::cancelLoading() {
+    if (_loaded || _failedToLoad) {
+        return;
+    }
+    if (_request) {
+        PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID));
+        _request->disconnect(this);
+        _request->deleteLater();
+        _request = nullptr;
+        ResourceCache::requestCompleted(_self);
+    } else if (!DependencyManager::get<ResourceCacheSharedItems>()->removePendingRequest(_self)) {
+        return;
+    }
+
+    qCDebug(resourceLog).noquote() << "Cancelled request for:" << _url.toDisplayString();
+    _startedLoading = false;
+    resetTimeline();
+}
+
 void Resource::allReferencesCleared() {
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "allReferencesCleared");
@@ -612,6 +961,7 @@ void Resource::init() {
     _loaded = false;
     _attempts = 0;
     _activeUrl = _url;
+    resetTimeline();
     
     if (_url.isEmpty()) {
         _startedLoading = _loaded = true;
@@ -623,8 +973,45 @@ void Resource::init() {
 
 const int MAX_ATTEMPTS = 8;
 
+void Resource::resetTimeline() {
+    for (auto& time : _timeline) {
+        time = 0;
+    }
+}
+
+static const std::array<const char*, Resource::NUM_TIMELINE_EVENTS> TIMELINE_EVENT_NAMES { {
+    "queued", "requested", "firstByte", "lastByte", "decodeStarted", "decodeFinished", "uploaded"
+} };
+
+void Resource::markTimeline(TimelineEvent event) {
+    quint64 unset = 0;
+    if (_timeline[event].compare_exchange_strong(unset, usecTimestampNow())) {
+        PROFILE_INSTANT(resource, "Resource:" + getType() + ":" + TIMELINE_EVENT_NAMES[event], "t",
+                        { { "id", QString::number(_requestID) }, { "url", _url.toString() } });
+    }
+}
+
+QVariantMap Resource::getTimeline() const {
+    QVariantMap timeline;
+    timeline["url"] = _url.toString();
+    timeline["type"] = getType();
+    timeline["state"] = _loaded ? "loaded" : _failedToLoad ? "failed" : _startedLoading ? "loading" : "idle";
+
+    quint64 queued = _timeline[Queued];
+    if (queued != 0) {
+        for (int i = Requested; i < NUM_TIMELINE_EVENTS; ++i) {
+            quint64 time = _timeline[i];
+            if (time != 0) {
+                timeline[TIMELINE_EVENT_NAMES[i]] = (double)(time - queued) / USECS_PER_MSEC;
+            }
+        }
+    }
+    return timeline;
+}
+
 void Resource::attemptRequest() {
     _startedLoading = true;
+    markTimeline(Queued);
 
     if (_attempts > 0) {
         qCDebug(networking).noquote() << "Server unavailable for" << _url
@@ -638,6 +1025,11 @@ void Resource::finishedLoading(bool success) {
     if (success) {
         qCDebug(networking).noquote() << "Finished loading:" << _url.toDisplayString();
         _loaded = true;
+
+        // the resources that aren't decoded on their own are decoded as they finish loading
+        markTimeline(DecodeStarted);
+        markTimeline(DecodeFinished);
+        markTimeline(Uploaded);
     } else {
         qCDebug(networking).noquote() << "Failed to load:" << _url.toDisplayString();
         _failedToLoad = true;
@@ -665,6 +1057,7 @@ void Resource::makeRequest() {
     }
 
     PROFILE_ASYNC_BEGIN(resource, "Resource:" + getType(), QString::number(_requestID), { { "url", _url.toString() }, { "activeURL", _activeUrl.toString() } });
+    markTimeline(Requested);
 
     _request = ResourceManager::createResourceRequest(this, _activeUrl);
 
@@ -690,6 +1083,9 @@ void Resource::makeRequest() {
 }
 
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
+    if (bytesReceived > 0) {
+        markTimeline(FirstByte);
+    }
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
 }
@@ -718,6 +1114,10 @@ void Resource::handleReplyFinished() {
         auto extraInfo = _url == _activeUrl ? "" : QString(", %1").arg(_activeUrl.toDisplayString());
         qCDebug(networking).noquote() << QString("Request finished for %1%2").arg(_url.toDisplayString(), extraInfo);
         
+        // a resource read from a cache may arrive at once, without progress
+        markTimeline(FirstByte);
+        markTimeline(LastByte);
+
         auto data = _request->getData();
         emit loaded(data);
         downloadFinished(data);
@@ -741,6 +1141,17 @@ void Resource::handleReplyFinished() {
                 }
                 // fall through to final failure
             }
+            case ResourceRequest::Result::NotFound: {
+                if (result == ResourceRequest::Result::NotFound && _activeUrl != _url) {
+                    // there is no variant of the resource at its active url, load the resource itself
+                    qCDebug(networking).noquote() << "Did not find" << _activeUrl.toDisplayString() << "- loading"
+                        << _url.toDisplayString();
+                    _activeUrl = _url;
+                    QTimer::singleShot(0, this, &Resource::attemptRequest);
+                    break;
+                }
+                // fall through to final failure
+            }
             default: {
                 qCDebug(networking) << "Error loading " << _url;
                 auto error = (result == ResourceRequest::Timeout) ? QNetworkReply::TimeoutError
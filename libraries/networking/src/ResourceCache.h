@@ -12,8 +12,10 @@
 #ifndef hifi_ResourceCache_h
 #define hifi_ResourceCache_h
 
+#include <array>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -31,6 +33,7 @@
 #include <QScriptEngine>
 
 #include <DependencyManager.h>
+#include <MemoryBudget.h>
 
 #include "ResourceManager.h"
 
@@ -59,6 +62,11 @@ static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
 // object instead
+//
+// The pending requests are kept in a priority heap per origin (the scheme and host of the url they are requested from,
+// so the asset server and each HTTP host), and each origin has its own limit of active requests. The limit of an origin
+// that has requests waiting is raised or lowered from the throughput measured as its requests complete, keeping the
+// change while the throughput improves.
 class ResourceCacheSharedItems : public Dependency  {
     SINGLETON_DEPENDENCY
 
@@ -67,20 +75,68 @@ class ResourceCacheSharedItems : public Dependency  {
 
 public:
     void appendPendingRequest(QWeakPointer<Resource> newRequest);
-    void appendActiveRequest(QWeakPointer<Resource> newRequest);
+    /// adds the request to the active ones if its origin is below its limit, otherwise returns false
+    bool appendActiveRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    /// removes the request from the pending ones, returns false if it was not pending
+    bool removePendingRequest(QWeakPointer<Resource> request);
+    /// re-reads the load priority of the request if it is pending
+    void updatePendingRequest(QWeakPointer<Resource> request);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
+    /// takes the highest priority pending request of the origins that are below their limit
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    /// the largest number of active requests to one origin
+    void setMaximumOriginRequestLimit(int limit);
+
 private:
-    ResourceCacheSharedItems() = default;
+    ResourceCacheSharedItems();
+
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        float priority;
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        QString origin;
+        quint64 startTime;
+    };
+
+    struct Origin {
+        std::vector<PendingRequest> pending; // a max heap on the priority
+        QHash<Resource*, size_t> indices; // of the pending requests in the heap
+        int active { 0 };
+        int limit { 0 };
+
+        // throughput of the requests completed since the sample started
+        quint64 sampleStart { 0 };
+        qint64 sampleBytes { 0 };
+        float lastThroughput { 0.0f }; // bytes per second
+        int limitStep { 1 };
+
+        void push(const PendingRequest& request);
+        void removeAt(size_t index);
+        void update(size_t index);
+        void siftUp(size_t index);
+        void siftDown(size_t index);
+        void swap(size_t first, size_t second);
+    };
+
+    static QString getOrigin(const QSharedPointer<Resource>& resource);
+    Origin& findOrigin(const QString& name);
+    void adaptLimit(Origin& origin, quint64 startTime, qint64 bytes);
 
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    QHash<QString, Origin> _origins;
+    QHash<Resource*, QString> _pendingOrigins;
+    QList<LoadingRequest> _loadingRequests;
+    int _maximumOriginLimit { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -179,7 +235,7 @@ private:
 Q_DECLARE_METATYPE(ScriptableResource*);
 
 /// Base class for resource caches.
-class ResourceCache : public QObject {
+class ResourceCache : public QObject, public MemoryBudgetClient {
     Q_OBJECT
     Q_PROPERTY(size_t numTotal READ getNumTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
@@ -224,11 +280,23 @@ public:
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
 
     /**jsdoc
-     * Returns list of all resource urls
+     * Returns list of all resource urls, or of the timelines of the resources
      * @function ResourceCache.getResourceList
-     * @return {string[]}
+     * @param withTimelines {boolean} whether to return an object for each resource, with its url, type, state and the
+     *     times in ms since it was queued at which it was requested, received its first and last bytes, started and
+     *     finished decoding and was uploaded
+     * @return {string[]|object[]}
+     */
+    Q_INVOKABLE QVariantList getResourceList(bool withTimelines = false);
+
+    /**jsdoc
+     * Returns a summary of the loading of all resources: the number loaded, failed and loading, the wall time in ms from
+     * the first resource queued to the last one uploaded, and the total and longest time in ms the resources spent in
+     * each phase - queued, waitingForFirstByte, downloading, waitingForDecode, decoding and uploading
+     * @function ResourceCache.getLoadSummary
+     * @return {object}
      */
-    Q_INVOKABLE QVariantList getResourceList();
+    Q_INVOKABLE QVariantMap getLoadSummary();
 
     static void setRequestLimit(int limit);
     static int getRequestLimit() { return _requestLimit; }
@@ -251,6 +319,13 @@ public:
     void refresh(const QUrl& url);
     void clearUnusedResources();
 
+    // the unused resources are given back to the memory budget, oldest first
+    virtual QString getMemoryBudgetName() const override { return metaObject()->className(); }
+    virtual qint64 getMemoryUsage() const override { return _totalResourcesSize; }
+    virtual qint64 getReleasableMemory() const override { return _unusedResourcesSize; }
+    virtual float getRebuildCost() const override { return _rebuildCost; }
+    virtual qint64 releaseMemory(qint64 size) override;
+
 signals:
     void dirty();
 
@@ -306,10 +381,14 @@ protected:
     static void requestCompleted(QWeakPointer<Resource> resource);
     static bool attemptHighestPriorityRequest();
 
+    /// the cost of loading a byte of this cache again, relative to the other clients of the memory budget
+    void setRebuildCost(float rebuildCost) { _rebuildCost = rebuildCost; }
+
 private:
     friend class Resource;
 
     void reserveUnusedResource(qint64 resourceSize);
+    void evictUnusedResources(qint64 unusedResourcesMaxSize);
     void resetResourceCounters();
     void removeResource(const QUrl& url, qint64 size = 0);
 
@@ -332,6 +411,8 @@ private:
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
 
+    float _rebuildCost { 1.0f };
+
     // Pending resources
     QQueue<QUrl> _resourcesToBeGotten;
     QReadWriteLock _resourcesToBeGottenLock { QReadWriteLock::Recursive };
@@ -360,7 +441,7 @@ public:
     /// Sets a set of priorities at once.
     virtual void setLoadPriorities(const QHash<QPointer<QObject>, float>& priorities);
     
-    /// Clears the load priority for one owner.
+    /// Clears the load priority for one owner, the loading of a resource that no owner wants anymore is cancelled.
     virtual void clearLoadPriority(const QPointer<QObject>& owner);
     
     /// Returns the highest load priority across all owners.
@@ -387,6 +468,9 @@ public:
     /// Refreshes the resource.
     void refresh();
 
+    /// Stops the download of the resource if it is waiting for or in a request, it starts again on ensureLoading.
+    void cancelLoading();
+
     void setSelf(const QWeakPointer<Resource>& self) { _self = self; }
 
     void setCache(ResourceCache* cache) { _cache = cache; }
@@ -395,6 +479,28 @@ public:
     
     const QUrl& getURL() const { return _url; }
 
+    /// The phases of the loading of a resource, in order.
+    enum TimelineEvent {
+        Queued = 0,
+        Requested,
+        FirstByte,
+        LastByte,
+        DecodeStarted,
+        DecodeFinished,
+        Uploaded, // handed to the GPU, or simply loaded for the resources that aren't uploaded
+        NUM_TIMELINE_EVENTS
+    };
+
+    /// Records the time of the event, the first time it happens for the load, and emits it as a trace event.
+    /// Can be called from any thread, the readers of subclasses mark the decode phase from their worker threads.
+    void markTimeline(TimelineEvent event);
+
+    /// Returns the time of the event in usecs since the epoch, 0 if it didn't happen yet.
+    quint64 getTimelineTime(TimelineEvent event) const { return _timeline[event]; }
+
+    /// Returns the url, type and state of the resource, with the time in ms since it was queued of each event so far.
+    QVariantMap getTimeline() const;
+
 signals:
     /// Fired when the resource begins downloading.
     void loading();
@@ -441,7 +547,7 @@ protected:
     Q_INVOKABLE void allReferencesCleared();
 
     QUrl _url;
-    QUrl _activeUrl;
+    QUrl _activeUrl; // the url the resource is requested from, a variant of _url replaced by _url if it is not found
     bool _startedLoading = false;
     bool _failedToLoad = false;
     bool _loaded = false;
@@ -455,6 +561,7 @@ private slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
@@ -462,6 +569,7 @@ private:
     void makeRequest();
     void retry();
     void reinsert();
+    void resetTimeline();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
@@ -475,6 +583,8 @@ private:
     qint64 _bytes{ 0 };
     int _attempts{ 0 };
     bool _isInScript{ false };
+
+    std::array<std::atomic<quint64>, NUM_TIMELINE_EVENTS> _timeline;
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
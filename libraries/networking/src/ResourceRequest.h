@@ -17,6 +17,8 @@
 
 #include <cstdint>
 
+#include "ByteRange.h"
+
 class ResourceRequest : public QObject {
     Q_OBJECT
 public:
@@ -49,6 +51,11 @@ public:
 
     void setCacheEnabled(bool value) { _cacheEnabled = value; }
 
+    /// Requests only a range of the bytes of the resource, the data of a successful request is those bytes
+    void setByteRange(ByteRange byteRange) { _byteRange = byteRange; }
+    /// The size of the whole resource, known once a request finished, or -1
+    int64_t getTotalSizeOfResource() const { return _totalSizeOfResource; }
+
 public slots:
     void send();
 
@@ -65,6 +72,8 @@ protected:
     QByteArray _data;
     bool _cacheEnabled { true };
     bool _loadedFromCache { false };
+    ByteRange _byteRange;
+    int64_t _totalSizeOfResource { -1 };
 };
 
 #endif
@@ -15,6 +15,9 @@
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <Metrics.h>
+#include <SamplingProfiler.h>
+#include <SharedUtil.h>
 
 #include "ThreadedAssignment.h"
 
@@ -94,6 +97,7 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
 
     float packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond;
     nodeList->getPacketStats(packetsInPerSecond, bytesInPerSecond, packetsOutPerSecond, bytesOutPerSecond);
+    auto poolStats = nodeList->getPacketBufferPoolStats();
     nodeList->resetPacketStats();
 
     QJsonObject ioStats;
@@ -102,8 +106,40 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_bytes_per_s"] = bytesOutPerSecond;
     ioStats["outbound_packets_per_s"] = packetsOutPerSecond;
 
+    QJsonObject poolStatsObject;
+    poolStatsObject["hit_rate"] = poolStats.acquired > 0 ? (double)poolStats.hits / (double)poolStats.acquired : 0.0;
+    poolStatsObject["buffers_acquired"] = (double)poolStats.acquired;
+    poolStatsObject["buffers_outstanding"] = (double)poolStats.outstanding;
+    poolStatsObject["buffers_high_water_mark"] = (double)poolStats.highWaterMark;
+    ioStats["packet_buffer_pool"] = poolStatsObject;
+
     statsObject["io_stats"] = ioStats;
 
+    if (DependencyManager::isSet<MetricsRegistry>()) {
+        auto metrics = DependencyManager::get<MetricsRegistry>();
+        metrics->gauge("hifi_network_bytes_per_second", "The network throughput", "direction=\"in\"").set(bytesInPerSecond);
+        metrics->gauge("hifi_network_bytes_per_second", "The network throughput", "direction=\"out\"").set(bytesOutPerSecond);
+        metrics->gauge("hifi_network_packets_per_second", "The network packet rate", "direction=\"in\"").set(packetsInPerSecond);
+        metrics->gauge("hifi_network_packets_per_second", "The network packet rate", "direction=\"out\"").set(packetsOutPerSecond);
+        metrics->gauge("hifi_packet_buffers_outstanding", "The packet buffers in use").set((double)poolStats.outstanding);
+
+        uint64_t cpuUsecs;
+        if (getProcessCPUTime(cpuUsecs)) {
+            metrics->gauge("hifi_process_cpu_seconds", "The CPU time used by the process so far")
+                .set((double)cpuUsecs / USECS_PER_SECOND);
+        }
+        MemoryInfo memoryInfo;
+        if (getMemoryInfo(memoryInfo)) {
+            metrics->gauge("hifi_process_resident_bytes", "The memory used by the process")
+                .set((double)memoryInfo.processUsedMemoryBytes);
+        }
+        statsObject[METRICS_STATS_KEY] = QString::fromUtf8(metrics->toPrometheusText());
+    }
+
+    if (DependencyManager::isSet<SamplingProfiler>() && DependencyManager::get<SamplingProfiler>()->isSampling()) {
+        statsObject[SAMPLED_STACKS_STATS_KEY] = QString::fromUtf8(DependencyManager::get<SamplingProfiler>()->getFoldedStacks());
+    }
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
@@ -18,6 +18,12 @@
 
 #include "Assignment.h"
 
+// the key of the Prometheus text of the assignment's metrics in its stats, which the domain server serves apart
+const QString METRICS_STATS_KEY = "prometheus_metrics";
+
+// the key of the stacks sampled by the SamplingProfiler, when it samples, in the folded format
+const QString SAMPLED_STACKS_STATS_KEY = "sampled_stacks";
+
 class ThreadedAssignment : public Assignment {
     Q_OBJECT
 public:
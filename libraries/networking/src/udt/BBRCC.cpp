@@ -0,0 +1,220 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+static const double HIGH_GAIN = 2.885; // 2 / ln(2), doubles the delivery rate every round in startup
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double WINDOW_GAIN = 2.0;
+static const double PROBE_BANDWIDTH_GAINS[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int NUM_PROBE_BANDWIDTH_GAINS = sizeof(PROBE_BANDWIDTH_GAINS) / sizeof(PROBE_BANDWIDTH_GAINS[0]);
+
+static const int BANDWIDTH_FILTER_ROUNDS = 10;
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_MAX_ROUNDS = 3;
+
+static const int MIN_RTT_EXPIRY_USECS = 10 * 1000 * 1000;
+static const int PROBE_RTT_USECS = 200 * 1000;
+
+static const int INITIAL_WINDOW_PACKETS = 10;
+static const int MIN_WINDOW_PACKETS = 4;
+
+static const int FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+BBRCC::BBRCC() {
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    // we need every ACK to sample the delivery rate
+    setAckInterval(1);
+
+    _pacingGain = HIGH_GAIN;
+    _windowGain = HIGH_GAIN;
+
+    // until the first sample, send the initial window unpaced
+    _congestionWindowSize = INITIAL_WINDOW_PACKETS;
+    setPacketSendPeriod(0.0);
+}
+
+void BBRCC::setInitialSendSequenceNumber(SequenceNumber seqNum) {
+    _lastACK = seqNum - 1;
+    _highestSent = seqNum - 1;
+    _lastFastRetransmit = seqNum - 1;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPackets.empty() && !_hasDelivered) {
+        // nothing is in flight, so the delivery rate is measured from this send
+        _deliveredTime = timePoint;
+    }
+
+    // re-transmits keep the state of their first send
+    if (seqNum > _highestSent) {
+        _highestSent = seqNum;
+        _sentPackets[seqNum] = { timePoint, _delivered, _hasDelivered ? _deliveredTime : timePoint };
+    }
+
+    // if ACKs stop coming, don't let the map grow without bound
+    while ((int)_sentPackets.size() > udt::MAX_PACKETS_IN_FLIGHT) {
+        _sentPackets.erase(_sentPackets.begin());
+    }
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    if (ack == _lastACK) {
+        // a duplicate, the receiver is missing ack + 1 - re-send it once, as soon as it is clearly lost
+        if (++_duplicateACKCount >= FAST_RETRANSMIT_DUPLICATE_COUNT && _lastFastRetransmit != ack + 1) {
+            _lastFastRetransmit = ack + 1;
+            return true;
+        }
+        return false;
+    }
+
+    if (ack < _lastACK) {
+        // an old ACK arriving late
+        return false;
+    }
+
+    _duplicateACKCount = 0;
+    _delivered += seqlen(_lastACK, ack) - 1;
+    _deliveredTime = receiveTime;
+    _hasDelivered = true;
+    _lastACK = ack;
+
+    auto it = _sentPackets.find(ack);
+    if (it != _sentPackets.end()) {
+        const SentPacket& packet = it->second;
+
+        // a new round starts once the packets sent during the last one are delivered
+        _isRoundStart = false;
+        if (packet.delivered >= _nextRoundDelivered) {
+            _nextRoundDelivered = _delivered;
+            ++_round;
+            _isRoundStart = true;
+        }
+
+        // sample the delivery rate over the time this packet was in flight
+        auto interval = duration_cast<microseconds>(receiveTime - packet.deliveredTime).count();
+        if (interval > 0) {
+            updateBandwidth((double)(_delivered - packet.delivered) * USECS_PER_SECOND / (double)interval);
+        }
+
+        // sample the RTT, accepting any sample once the min has expired
+        int rtt = std::max(1, (int)duration_cast<microseconds>(receiveTime - packet.sendTime).count());
+        bool minRTTExpired = _minRTT > 0 && duration_cast<microseconds>(receiveTime - _minRTTStamp).count() > MIN_RTT_EXPIRY_USECS;
+        if (_minRTT < 0 || rtt <= _minRTT || minRTTExpired) {
+            _minRTT = rtt;
+            _minRTTStamp = receiveTime;
+        }
+
+        if (minRTTExpired && _mode != Mode::ProbeRTT) {
+            // drain the queue for a moment to see the propagation delay again
+            _mode = Mode::ProbeRTT;
+            _pacingGain = 1.0;
+            _windowGain = 1.0;
+            _probeRTTDoneTime = receiveTime + microseconds(std::max(PROBE_RTT_USECS, _minRTT));
+        }
+    }
+
+    // forget the packets this ACK covers
+    while (!_sentPackets.empty() && _sentPackets.begin()->first <= ack) {
+        _sentPackets.erase(_sentPackets.begin());
+    }
+
+    int packetsInFlight = ack < _highestSent ? seqlen(ack, _highestSent) - 1 : 0;
+    updateMode(receiveTime, packetsInFlight);
+    updateWindowAndPacing();
+
+    return false;
+}
+
+void BBRCC::updateBandwidth(double packetsPerSecond) {
+    // keep the max over the last rounds, as a decreasing queue of samples
+    while (!_bandwidthSamples.empty() && _bandwidthSamples.back().second <= packetsPerSecond) {
+        _bandwidthSamples.pop_back();
+    }
+    _bandwidthSamples.emplace_back(_round, packetsPerSecond);
+
+    while (_bandwidthSamples.front().first <= _round - BANDWIDTH_FILTER_ROUNDS) {
+        _bandwidthSamples.pop_front();
+    }
+
+    _bottleneckBandwidth = _bandwidthSamples.front().second;
+}
+
+double BBRCC::bandwidthDelayProduct() const {
+    return _bottleneckBandwidth * (double)_minRTT / USECS_PER_SECOND;
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, int packetsInFlight) {
+    if (!_isPipeFull && _isRoundStart) {
+        if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = _bottleneckBandwidth;
+            _fullBandwidthRounds = 0;
+        } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_MAX_ROUNDS) {
+            _isPipeFull = true;
+        }
+    }
+
+    switch (_mode) {
+        case Mode::Startup:
+            if (_isPipeFull) {
+                // we over-filled the pipe while finding it, empty the queue we built
+                _mode = Mode::Drain;
+                _pacingGain = DRAIN_GAIN;
+                _windowGain = HIGH_GAIN;
+            }
+            break;
+        case Mode::Drain:
+            if (packetsInFlight <= bandwidthDelayProduct()) {
+                _mode = Mode::ProbeBandwidth;
+                _cycleIndex = NUM_PROBE_BANDWIDTH_GAINS - 1; // the next phase probes for more
+                _cycleStamp = now;
+                _pacingGain = 1.0;
+                _windowGain = WINDOW_GAIN;
+            }
+            break;
+        case Mode::ProbeBandwidth:
+            if (duration_cast<microseconds>(now - _cycleStamp).count() > _minRTT) {
+                _cycleIndex = (_cycleIndex + 1) % NUM_PROBE_BANDWIDTH_GAINS;
+                _cycleStamp = now;
+                _pacingGain = PROBE_BANDWIDTH_GAINS[_cycleIndex];
+            }
+            break;
+        case Mode::ProbeRTT:
+            if (now >= _probeRTTDoneTime) {
+                _minRTTStamp = now;
+                _cycleStamp = now;
+                _mode = _isPipeFull ? Mode::ProbeBandwidth : Mode::Startup;
+                _pacingGain = _isPipeFull ? 1.0 : HIGH_GAIN;
+                _windowGain = _isPipeFull ? WINDOW_GAIN : HIGH_GAIN;
+            }
+            break;
+    }
+}
+
+void BBRCC::updateWindowAndPacing() {
+    if (_bottleneckBandwidth <= 0.0 || _minRTT <= 0) {
+        // no samples yet, keep sending the initial window
+        return;
+    }
+
+    int window = (_mode == Mode::ProbeRTT) ? MIN_WINDOW_PACKETS : (int)(_windowGain * bandwidthDelayProduct()) + 1;
+    _congestionWindowSize = std::max(MIN_WINDOW_PACKETS, std::min(window, udt::MAX_PACKETS_IN_FLIGHT));
+
+    setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+}
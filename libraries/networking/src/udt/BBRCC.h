@@ -0,0 +1,100 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <deque>
+#include <map>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Congestion control modeled on BBR (https://queue.acm.org/detail.cfm?id=3022184)
+//   Rather than reading loss (like DefaultCC) or delay growth (like TCPVegasCC) as congestion, it measures the
+//   bottleneck bandwidth (max delivery rate over the last rounds) and the propagation delay (min RTT over the last
+//   seconds), then paces at that bandwidth with about two bandwidth-delay products in flight.
+//   Random loss on wireless links therefore does not collapse the sending rate.
+//   Only the times passed in are used, never the clock, so that it can be driven by a simulated link.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override {}
+    virtual void onTimeout() override {}
+
+    // NAKs repair loss without touching the rate, and ACKs come for each packet to sample the delivery rate
+    virtual bool shouldNAK() override { return true; }
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override;
+
+private:
+    enum class Mode { Startup, Drain, ProbeBandwidth, ProbeRTT };
+
+    struct SentPacket {
+        p_high_resolution_clock::time_point sendTime;
+        int64_t delivered; // _delivered when this packet was sent
+        p_high_resolution_clock::time_point deliveredTime; // _deliveredTime when this packet was sent
+    };
+
+    void updateBandwidth(double packetsPerSecond);
+    void updateMode(p_high_resolution_clock::time_point now, int packetsInFlight);
+    void updateWindowAndPacing();
+    double bandwidthDelayProduct() const; // in packets
+
+    Mode _mode { Mode::Startup };
+
+    std::map<SequenceNumber, SentPacket> _sentPackets;
+    SequenceNumber _lastACK;
+    SequenceNumber _highestSent;
+    SequenceNumber _lastFastRetransmit;
+    int _duplicateACKCount { 0 };
+
+    int64_t _delivered { 0 }; // packets delivered so far
+    p_high_resolution_clock::time_point _deliveredTime; // when _delivered last grew
+    bool _hasDelivered { false };
+
+    // round trips are counted in delivered packets: a round ends once a packet sent after it started is ACKed
+    int _round { 0 };
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+
+    std::deque<std::pair<int, double>> _bandwidthSamples; // (round, packets per second), decreasing max filter
+    double _bottleneckBandwidth { 0.0 }; // packets per second
+
+    int _minRTT { -1 }; // microseconds
+    p_high_resolution_clock::time_point _minRTTStamp;
+
+    // startup ends once the bandwidth stops growing for a few rounds
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthRounds { 0 };
+    bool _isPipeFull { false };
+
+    double _pacingGain { 0.0 };
+    double _windowGain { 0.0 };
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleStamp;
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+};
+
+}
+
+#endif // hifi_BBRCC_h
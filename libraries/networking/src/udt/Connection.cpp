@@ -11,8 +11,6 @@
 
 #include "Connection.h"
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../HifiSockAddr.h"
@@ -22,6 +20,7 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 #include <Trace.h>
 
@@ -49,7 +48,8 @@ Connection::Connection(Socket* parentSocket, HifiSockAddr destination, std::uniq
 
     // Setup packets
     static const int ACK_PACKET_PAYLOAD_BYTES = sizeof(_lastSentACK) + sizeof(_currentACKSubSequenceNumber)
-                            + sizeof(_rtt) + sizeof(int32_t) + sizeof(int32_t) + sizeof(int32_t);
+                            + sizeof(_rtt) + sizeof(int32_t) + sizeof(uint16_t) + udt::MAX_SELECTIVE_ACK_BITMAP_BYTES
+                            + sizeof(int32_t) + sizeof(int32_t);
     static const int LIGHT_ACK_PACKET_PAYLOAD_BYTES = sizeof(SequenceNumber);
     static const int ACK2_PAYLOAD_BYTES = sizeof(SequenceNumber);
     static const int NAK_PACKET_PAYLOAD_BYTES = 2 * sizeof(SequenceNumber);
@@ -73,20 +73,15 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+        // tell the send queue to stop, and wait until the scheduler is done with it
         sendQueue->stop();
+        SendQueueScheduler::getInstance().remove(sendQueue);
+
+        // the scheduler never touches it again, so it can be deleted
         sendQueue->deleteLater();
         
         // since we're stopping the send queue we should consider our handshake ACK not receieved
         _hasReceivedHandshakeACK = false;
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -174,6 +169,11 @@ void Connection::sendReliablePacketList(std::unique_ptr<PacketList> packetList)
     getSendQueue().queuePacketList(std::move(packetList));
 }
 
+void Connection::sendLatestOnlyPacket(std::unique_ptr<Packet> packet) {
+    Q_ASSERT_X(packet->isLatestOnly(), "Connection::sendLatestOnlyPacket", "Trying to send a packet that is not part of a stream.");
+    getSendQueue().queueLatestOnlyPacket(std::move(packet));
+}
+
 void Connection::queueReceivedMessagePacket(std::unique_ptr<Packet> packet) {
     Q_ASSERT(packet->isPartOfMessage());
 
@@ -285,7 +285,10 @@ void Connection::sendACK(bool wasCausedBySyncTimeout) {
     SequenceNumber nextACKNumber = nextACK();
     Q_ASSERT_X(nextACKNumber >= _lastSentACK, "Connection::sendACK", "Sending lower ACK, something is wrong");
     
-    if (nextACKNumber == _lastSentACK) {
+    // with loss, the same ACK is still worth sending if its selective ACK covers packets the last one didn't
+    bool hasNewSelectiveACK = _lossList.getLength() > 0 && _lastReceivedSequenceNumber != _lastSelectiveACKEnd;
+    
+    if (nextACKNumber == _lastSentACK && !hasNewSelectiveACK) {
         // We already sent this ACK, but check if we should re-send it.
         if (nextACKNumber < _lastReceivedAcknowledgedACK) {
             // we already got an ACK2 for this ACK we would be sending, don't bother
@@ -319,6 +322,19 @@ void Connection::sendACK(bool wasCausedBySyncTimeout) {
     // pack the available buffer size, in packets
     // in our implementation we have no hard limit on receive buffer size, send the default value
     _ackPacket->writePrimitive((int32_t) udt::MAX_PACKETS_IN_FLIGHT);
+    
+    // pack in a bitmap of the packets received after the ACK (bit i for ACK + 1 + i),
+    // so the sender only re-sends the ones that are missing
+    uint8_t selectiveACK[udt::MAX_SELECTIVE_ACK_BITMAP_BYTES];
+    uint16_t selectiveACKBytes = 0;
+    if (_lossList.getLength() > 0) {
+        int numBits = _lossList.getReceivedBitmap(nextACKNumber + 1, _lastReceivedSequenceNumber,
+                                                  selectiveACK, udt::MAX_SELECTIVE_ACK_BITMAP_BYTES * 8);
+        selectiveACKBytes = (uint16_t)((numBits + 7) / 8);
+    }
+    _ackPacket->writePrimitive(selectiveACKBytes);
+    _ackPacket->write(reinterpret_cast<const char*>(selectiveACK), selectiveACKBytes);
+    _lastSelectiveACKEnd = _lastReceivedSequenceNumber;
 
     if (wasCausedBySyncTimeout) {
         // grab the up to date packet receive speed and estimated bandwidth
@@ -328,6 +344,7 @@ void Connection::sendACK(bool wasCausedBySyncTimeout) {
         // update those values in our connection stats
         _stats.recordReceiveRate(packetReceiveSpeed);
         _stats.recordEstimatedBandwidth(estimatedBandwidth);
+        _stats.recordEstimatedReceiveBandwidth(estimatedBandwidth);
         
         // pack in the receive speed and estimatedBandwidth
         _ackPacket->writePrimitive(packetReceiveSpeed);
@@ -409,14 +426,15 @@ void Connection::sendNAK(SequenceNumber sequenceNumberRecieved) {
 void Connection::sendTimeoutNAK() {
     if (_lossList.getLength() > 0) {
         
-        int timeoutPayloadSize = std::min((int) (_lossList.getLength() * 2 * sizeof(SequenceNumber)),
+        int timeoutPayloadSize = std::min((int) (sizeof(SequenceNumber)
+                                                 + _lossList.getNumRanges() * LossList::MAX_ENCODED_RANGE_BYTES),
                                           ControlPacket::maxPayloadSize());
         
-        // construct a NAK packet that will hold all of the lost sequence numbers
+        // construct a NAK packet that will hold as many of the lost ranges as fit
         auto lossListPacket = ControlPacket::create(ControlPacket::TimeoutNAK, timeoutPayloadSize);
         
         // Pack in the lost sequence numbers
-        _lossList.write(*lossListPacket, timeoutPayloadSize / (2 * sizeof(SequenceNumber)));
+        _lossList.write(*lossListPacket);
         
         // have our parent socket send off this control packet
         _parentSocket->writeBasePacket(*lossListPacket, _destination);
@@ -540,6 +558,32 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
     return !wasDuplicate;
 }
 
+bool Connection::processReceivedLatestOnlyPacket(const Packet& packet) {
+    if (!_hasReceivedHandshake) {
+        // the sender re-numbers its streams on a new handshake, so we need one first
+        sendHandshakeRequest();
+        return false;
+    }
+    
+    _isReceivingData = true;
+    _lastReceiveTime = p_high_resolution_clock::now();
+    
+    auto streamSequenceNumber = packet.getStreamSequenceNumber();
+    auto it = _newestStreamSequenceNumbers.find(packet.getStreamKey());
+    
+    if (it != _newestStreamSequenceNumbers.end()) {
+        // compare with wrap around, anything not newer than what we have is stale state
+        if ((int32_t)(streamSequenceNumber - it->second) <= 0) {
+            return false;
+        }
+        it->second = streamSequenceNumber;
+    } else {
+        _newestStreamSequenceNumbers[packet.getStreamKey()] = streamSequenceNumber;
+    }
+    
+    return true;
+}
+
 void Connection::processControl(ControlPacketPointer controlPacket) {
     
     // Simple dispatch to control packets processing methods based on their type.
@@ -649,6 +693,24 @@ void Connection::processACK(ControlPacketPointer controlPacket) {
     
     _flowWindowSize = packedFlowWindow;
     
+    // read the selective ACK of the packets received past the ACK
+    uint16_t selectiveACKBytes;
+    controlPacket->readPrimitive(&selectiveACKBytes);
+    
+    if (selectiveACKBytes > udt::MAX_SELECTIVE_ACK_BITMAP_BYTES
+        || controlPacket->bytesLeftToRead() < (qint64)selectiveACKBytes) {
+        qCDebug(networking) << "Connection::processACK - dropping ACK with an invalid selective ACK";
+        return;
+    }
+    
+    if (selectiveACKBytes > 0) {
+        uint8_t selectiveACK[udt::MAX_SELECTIVE_ACK_BITMAP_BYTES];
+        controlPacket->read(reinterpret_cast<char*>(selectiveACK), selectiveACKBytes);
+        
+        // the send queue won't re-send the packets the receiver already has
+        getSendQueue().selectiveAck(ack, selectiveACK, selectiveACKBytes);
+    }
+    
     if (ack == _lastReceivedACK) {
         // processing an already received ACK, bail
         return;
@@ -873,6 +935,7 @@ void Connection::resetReceiveState() {
     _currentACKSubSequenceNumber = defaultSequenceNumber;
     
     _lastSentACK = defaultSequenceNumber;
+    _lastSelectiveACKEnd = defaultSequenceNumber;
     
     // clear the sent ACKs
     _sentACKs.clear();
@@ -903,6 +966,8 @@ void Connection::resetReceiveState() {
         _parentSocket->messageFailed(this, pendingMessage.first);
     }
     _pendingReceivedMessages.clear();
+    
+    _newestStreamSequenceNumbers.clear();
 }
 
 void Connection::updateRTT(int rtt) {
@@ -14,6 +14,7 @@
 
 #include <list>
 #include <memory>
+#include <unordered_map>
 
 #include <QtCore/QObject>
 
@@ -62,16 +63,19 @@ public:
 
     void sendReliablePacket(std::unique_ptr<Packet> packet);
     void sendReliablePacketList(std::unique_ptr<PacketList> packet);
+    void sendLatestOnlyPacket(std::unique_ptr<Packet> packet);
 
     void sync(); // rate control method, fired by Socket for all connections on SYN interval
 
     // return indicates if this packet should be processed
     bool processReceivedSequenceNumber(SequenceNumber sequenceNumber, int packetSize, int payloadSize);
+    bool processReceivedLatestOnlyPacket(const Packet& packet); // false if it is older than its stream's newest
     void processControl(ControlPacketPointer controlPacket);
 
     void queueReceivedMessagePacket(std::unique_ptr<Packet> packet);
     
     ConnectionStats::Stats sampleStats() { return _stats.sample(); }
+    ConnectionStats::Stats getTotalStats() { return _stats.getTotalStats(); }
     
     bool isActive() const { return _isActive; }
 
@@ -149,6 +153,7 @@ private:
     SequenceNumber _currentACKSubSequenceNumber; // The current ACK sub-sequence number (used for Acknowledgment of ACKs)
     
     SequenceNumber _lastSentACK; // The last sent ACK
+    SequenceNumber _lastSelectiveACKEnd; // The largest sequence number covered by the last sent selective ACK
     SequenceNumber _lastSentACK2; // The last sent ACK sub-sequence number in an ACK2
 
     int _acksDuringSYN { 1 }; // The number of non-SYN ACKs sent during SYN
@@ -175,6 +180,9 @@ private:
     
     std::map<MessageNumber, PendingReceivedMessage> _pendingReceivedMessages;
     
+    // The newest sequence number received for each latest only stream
+    std::unordered_map<Packet::StreamKey, Packet::StreamSequenceNumber> _newestStreamSequenceNumbers;
+    
     int _packetsSinceACK { 0 }; // The number of packets that have been received during the current ACK interval
 
     // Re-used control packets
@@ -31,6 +31,12 @@ ConnectionStats::Stats ConnectionStats::sample() {
     return sample;
 }
 
+ConnectionStats::Stats ConnectionStats::getTotalStats() {
+    Stats total = _total;
+    total.endTime = duration_cast<microseconds>(system_clock::now().time_since_epoch());
+    return total;
+}
+
 void ConnectionStats::record(Stats::Event event) {
     ++_currentSample.events[(int) event];
     ++_total.events[(int) event];
@@ -98,6 +104,11 @@ void ConnectionStats::recordEstimatedBandwidth(int sample) {
     _total.estimatedBandwith = (int)((_total.estimatedBandwith * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
 }
 
+void ConnectionStats::recordEstimatedReceiveBandwidth(int sample) {
+    _currentSample.estimatedReceiveBandwidth = sample;
+    _total.estimatedReceiveBandwidth = (int)((_total.estimatedReceiveBandwidth * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
+}
+
 void ConnectionStats::recordRTT(int sample) {
     _currentSample.rtt = sample;
     _total.rtt = (int)((_total.rtt * EWMA_PREVIOUS_SAMPLES_WEIGHT) + (sample * EWMA_CURRENT_SAMPLE_WEIGHT));
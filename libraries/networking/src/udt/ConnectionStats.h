@@ -66,6 +66,7 @@ public:
         int sendRate { 0 };
         int receiveRate { 0 };
         int estimatedBandwith { 0 };
+        int estimatedReceiveBandwidth { 0 }; // packets per second, this end's own estimate of the link it receives on
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
@@ -90,6 +91,7 @@ public:
     void recordSendRate(int sample);
     void recordReceiveRate(int sample);
     void recordEstimatedBandwidth(int sample);
+    void recordEstimatedReceiveBandwidth(int sample);
     void recordRTT(int sample);
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
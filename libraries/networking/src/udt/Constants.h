@@ -27,6 +27,7 @@ namespace udt {
     static const int UDP_SEND_BUFFER_SIZE_BYTES = 1048576;
     static const int UDP_RECEIVE_BUFFER_SIZE_BYTES = 1048576;
     static const int DEFAULT_SYN_INTERVAL_USECS = 10 * 1000;
+    static const int MAX_SELECTIVE_ACK_BITMAP_BYTES = 128; // covers the 1024 packets after the ACK
 
     
     // Header constants
@@ -11,6 +11,9 @@
 
 #include "LossList.h"
 
+#include <cstring>
+
+#include "Constants.h"
 #include "ControlPacket.h"
 
 using namespace udt;
@@ -167,18 +170,117 @@ SequenceNumber LossList::popFirstSequenceNumber() {
     return front;
 }
 
-void LossList::write(ControlPacket& packet, int maxPairs) {
-    int writtenPairs = 0;
+int LossList::getReceivedBitmap(SequenceNumber first, SequenceNumber last, uint8_t* bitmap, int maxBits) const {
+    if (last < first) {
+        return 0;
+    }
+    
+    int numBits = std::min(seqlen(first, last), maxBits);
+    int numBytes = (numBits + 7) / 8;
+    memset(bitmap, 0xFF, numBytes);
+    if (numBits % 8 != 0) {
+        // the bits past last are not received packets
+        bitmap[numBytes - 1] = (uint8_t)((1 << (numBits % 8)) - 1);
+    }
+    
+    // clear the bits of the lost packets
+    for (const auto& pair : _lossList) {
+        if (pair.second < first) {
+            continue;
+        }
+        
+        int start = pair.first < first ? 0 : seqoff(first, pair.first);
+        if (start >= numBits) {
+            break;
+        }
+        
+        int end = std::min(seqoff(first, pair.second), numBits - 1);
+        for (int i = start; i <= end; ++i) {
+            bitmap[i / 8] &= ~(uint8_t)(1 << (i % 8));
+        }
+    }
+    
+    return numBits;
+}
+
+// sequence numbers are 27 bits, so a varint of one takes at most 4 bytes
+static const int MAX_VARINT_BYTES = 4;
+static_assert(LossList::MAX_ENCODED_RANGE_BYTES == 2 * MAX_VARINT_BYTES, "A range is two varints");
+
+static void writeVarint(ControlPacket& packet, uint32_t value) {
+    while (value >= 0x80) {
+        packet.writePrimitive((uint8_t)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    packet.writePrimitive((uint8_t)value);
+}
+
+static bool readVarint(ControlPacket& packet, uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < MAX_VARINT_BYTES; ++i) {
+        uint8_t byte;
+        if (packet.bytesLeftToRead() < (qint64)sizeof(byte)) {
+            return false;
+        }
+        packet.readPrimitive(&byte);
+        value |= (uint32_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int LossList::write(ControlPacket& packet) {
+    if (_lossList.empty() || packet.bytesAvailableForWrite() < (qint64)sizeof(SequenceNumber) + MAX_ENCODED_RANGE_BYTES) {
+        return 0;
+    }
+    
+    packet.writePrimitive(_lossList.front().first);
+    
+    int writtenRanges = 0;
+    SequenceNumber previousEnd;
     
     for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+        if (packet.bytesAvailableForWrite() < MAX_ENCODED_RANGE_BYTES) {
+            break;
+        }
+        
+        if (writtenRanges > 0) {
+            // ranges are never adjacent, so there is at least one received packet between them
+            writeVarint(packet, seqlen(previousEnd, pair.first) - 3);
+        }
+        writeVarint(packet, seqlen(pair.first, pair.second) - 1);
+        
+        previousEnd = pair.second;
+        ++writtenRanges;
+    }
+    
+    return writtenRanges;
+}
+
+void LossList::read(ControlPacket& packet) {
+    if (packet.bytesLeftToRead() < (qint64)sizeof(SequenceNumber)) {
+        return;
+    }
+    
+    SequenceNumber start;
+    packet.readPrimitive(&start);
+    
+    uint32_t length;
+    while (readVarint(packet, length)) {
+        if (length >= (uint32_t)udt::MAX_PACKETS_IN_FLIGHT) {
+            // a bogus range, ignore the rest of the list
+            break;
+        }
         
-        ++writtenPairs;
+        SequenceNumber end = start + (SequenceNumber::Type)length;
+        append(start, end);
         
-        // check if we've written the maximum number we were told to write
-        if (maxPairs != -1 && writtenPairs >= maxPairs) {
+        uint32_t gap;
+        if (!readVarint(packet, gap) || gap >= (uint32_t)udt::MAX_PACKETS_IN_FLIGHT) {
             break;
         }
+        start = end + (SequenceNumber::Type)(gap + 2);
     }
 }
@@ -37,11 +37,22 @@ public:
     void remove(SequenceNumber start, SequenceNumber end);
     
     int getLength() const { return _length; }
+    int getNumRanges() const { return (int)_lossList.size(); }
     bool isEmpty() const { return _length == 0; }
     SequenceNumber getFirstSequenceNumber() const;
     SequenceNumber popFirstSequenceNumber();
     
-    void write(ControlPacket& packet, int maxPairs = -1);
+    // sets bit i of bitmap if first + i is not in the list, for first to last (but at most maxBits)
+    // returns the number of bits used
+    int getReceivedBitmap(SequenceNumber first, SequenceNumber last, uint8_t* bitmap, int maxBits) const;
+    
+    // compact encoding: the first sequence number, then varint range lengths and the gaps between ranges
+    // writes as many ranges as fit in the packet, returns the number of ranges written
+    static const int MAX_ENCODED_RANGE_BYTES = 8;
+    int write(ControlPacket& packet);
+    
+    // appends the ranges encoded by write (they must all be greater than the last range in the list)
+    void read(ControlPacket& packet);
     
 private:
     std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
@@ -147,6 +147,16 @@ void Packet::writeMessageNumber(MessageNumber messageNumber, PacketPosition posi
     writeHeader();
 }
 
+void Packet::writeStreamKey(StreamKey streamKey) {
+    Q_ASSERT_X(isLatestOnly(), "Packet::writeStreamKey()", "Only unreliable message packets can be part of a stream");
+    writeMessageNumber(streamKey, PacketPosition::ONLY, _messagePartNumber);
+}
+
+void Packet::writeStreamSequenceNumber(StreamSequenceNumber streamSequenceNumber) {
+    Q_ASSERT_X(isLatestOnly(), "Packet::writeStreamSequenceNumber()", "Only unreliable message packets can be part of a stream");
+    writeMessageNumber(_messageNumber, PacketPosition::ONLY, streamSequenceNumber);
+}
+
 void Packet::writeSequenceNumber(SequenceNumber sequenceNumber) const {
     _sequenceNumber = sequenceNumber;
     writeHeader();
@@ -42,6 +42,10 @@ public:
     //    M: Message bit
     //    O: Obfuscation level
     //    P: Position bits
+    //
+    //    An unreliable packet with M = 1 is a "latest only" packet of a state stream: its Message Number is the
+    //    stream key and its Message Part Number the stream sequence number. The SendQueue replaces a queued packet
+    //    with the newer one of the same stream, and the receiver drops any packet older than the newest it has seen.
 
 
     // NOTE: The SequenceNumber is only actually 29 bits to leave room for a bit field
@@ -51,6 +55,8 @@ public:
     using MessageNumber = uint32_t;
     using MessageNumberAndBitField = uint32_t;
     using MessagePartNumber = uint32_t;
+    using StreamKey = MessageNumber;
+    using StreamSequenceNumber = MessagePartNumber;
 
     // Use same size as MessageNumberAndBitField so we can use the enum with bitwise operations
     enum PacketPosition : MessageNumberAndBitField {
@@ -83,14 +89,21 @@ public:
     
     bool isPartOfMessage() const { return _isPartOfMessage; }
     bool isReliable() const { return _isReliable; }
+    bool isLatestOnly() const { return _isPartOfMessage && !_isReliable; }
 
     ObfuscationLevel getObfuscationLevel() const { return _obfuscationLevel; }
     SequenceNumber getSequenceNumber() const { return _sequenceNumber; }
     MessageNumber getMessageNumber() const { return _messageNumber; }
     PacketPosition getPacketPosition() const { return _packetPosition; }
     MessagePartNumber getMessagePartNumber() const { return _messagePartNumber; }
+    StreamKey getStreamKey() const { return _messageNumber; }
+    StreamSequenceNumber getStreamSequenceNumber() const { return _messagePartNumber; }
     
     void writeMessageNumber(MessageNumber messageNumber, PacketPosition position, MessagePartNumber messagePartNumber);
+    
+    // the packet must be unreliable and created with isPartOfMessage, to have room for the stream header
+    void writeStreamKey(StreamKey streamKey);
+    void writeStreamSequenceNumber(StreamSequenceNumber streamSequenceNumber);
     void writeSequenceNumber(SequenceNumber sequenceNumber) const;
     void obfuscate(ObfuscationLevel level);
 
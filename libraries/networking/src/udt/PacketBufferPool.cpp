@@ -0,0 +1,164 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace udt;
+
+namespace {
+
+const size_t MAX_LOCAL_FREE_BUFFERS = 256;   // ~350KB per thread
+const size_t MAX_GLOBAL_FREE_BUFFERS = 4096; // ~5.6MB shared
+const size_t TRANSFER_BATCH_SIZE = MAX_LOCAL_FREE_BUFFERS / 2; // buffers moved between a thread and the shared list at once
+
+std::atomic<uint64_t> acquiredCount { 0 };
+std::atomic<uint64_t> hitCount { 0 };
+std::atomic<uint64_t> outstandingCount { 0 };
+std::atomic<uint64_t> highWaterMark { 0 };
+
+struct GlobalFreeList {
+    std::mutex mutex;
+    std::vector<char*> buffers;
+};
+
+GlobalFreeList& globalFreeList() {
+    // intentionally leaked, so that threads exiting during shutdown can still return their buffers
+    static GlobalFreeList* list = new GlobalFreeList();
+    return *list;
+}
+
+// set once this thread's list is destroyed, for packets that are freed later during thread exit
+thread_local bool localFreeListDestroyed { false };
+
+struct LocalFreeList {
+    ~LocalFreeList() {
+        localFreeListDestroyed = true;
+
+        // the thread is going away, give its buffers to the threads that remain
+        auto& global = globalFreeList();
+        std::lock_guard<std::mutex> lock(global.mutex);
+        for (auto buffer : buffers) {
+            if (global.buffers.size() < MAX_GLOBAL_FREE_BUFFERS) {
+                global.buffers.push_back(buffer);
+            } else {
+                delete[] buffer;
+            }
+        }
+    }
+
+    std::vector<char*> buffers;
+};
+
+thread_local LocalFreeList localFreeList;
+
+void moveBuffers(std::vector<char*>& from, std::vector<char*>& to, size_t count) {
+    count = std::min(count, from.size());
+    to.insert(to.end(), from.end() - count, from.end());
+    from.resize(from.size() - count);
+}
+
+}
+
+PacketBufferPool::Buffer PacketBufferPool::acquire(int64_t size, bool zeroFill) {
+    if (size > BUFFER_SIZE || localFreeListDestroyed) {
+        return Buffer(zeroFill ? new char[size]() : new char[size], Deleter());
+    }
+
+    auto& local = localFreeList.buffers;
+
+    if (local.empty()) {
+        // refill from the shared list, a batch at a time to keep the lock rare
+        auto& global = globalFreeList();
+        std::lock_guard<std::mutex> lock(global.mutex);
+        moveBuffers(global.buffers, local, TRANSFER_BATCH_SIZE);
+    }
+
+    char* buffer = nullptr;
+    if (!local.empty()) {
+        buffer = local.back();
+        local.pop_back();
+        ++hitCount;
+
+        if (zeroFill) {
+            memset(buffer, 0, BUFFER_SIZE);
+        }
+    } else {
+        buffer = zeroFill ? new char[BUFFER_SIZE]() : new char[BUFFER_SIZE];
+    }
+
+    ++acquiredCount;
+    auto outstanding = ++outstandingCount;
+    auto previousHigh = highWaterMark.load(std::memory_order_relaxed);
+    while (outstanding > previousHigh && !highWaterMark.compare_exchange_weak(previousHigh, outstanding)) {
+    }
+
+    Deleter deleter;
+    deleter.isPooled = true;
+    return Buffer(buffer, deleter);
+}
+
+void PacketBufferPool::Deleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+void PacketBufferPool::release(char* buffer) {
+    --outstandingCount;
+
+    if (localFreeListDestroyed) {
+        delete[] buffer;
+        return;
+    }
+
+    auto& local = localFreeList.buffers;
+    local.push_back(buffer);
+
+    if (local.size() > MAX_LOCAL_FREE_BUFFERS) {
+        // this thread frees more than it allocates, share the extras
+        std::vector<char*> overflow;
+        moveBuffers(local, overflow, TRANSFER_BATCH_SIZE);
+
+        auto& global = globalFreeList();
+        std::unique_lock<std::mutex> lock(global.mutex);
+        auto room = MAX_GLOBAL_FREE_BUFFERS - std::min(MAX_GLOBAL_FREE_BUFFERS, global.buffers.size());
+        moveBuffers(overflow, global.buffers, room);
+        lock.unlock();
+
+        // nobody needs these back
+        for (auto extra : overflow) {
+            delete[] extra;
+        }
+    }
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+    stats.acquired = acquiredCount;
+    stats.hits = hitCount;
+    stats.outstanding = outstandingCount;
+    stats.highWaterMark = highWaterMark;
+    return stats;
+}
+
+void PacketBufferPool::resetStats() {
+    acquiredCount = 0;
+    hitCount = 0;
+    highWaterMark = outstandingCount.load();
+}
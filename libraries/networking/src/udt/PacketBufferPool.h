@@ -0,0 +1,61 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <cstdint>
+#include <memory>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Recycles the MAX_PACKET_SIZE buffers behind BasePacket
+//   Each thread keeps a small free list of its own, so most acquire/release pairs take no lock.
+//   A thread that frees more buffers than it allocates (e.g. one that processes what another received)
+//   hands its extras to a shared list, where allocating threads pick them up again.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+
+    struct Deleter {
+        void operator()(char* buffer) const;
+        bool isPooled { false }; // false for buffers adopted from elsewhere, which are simply deleted
+    };
+    using Buffer = std::unique_ptr<char[], Deleter>;
+
+    struct Stats {
+        uint64_t acquired { 0 };      // buffers handed out by the pool
+        uint64_t hits { 0 };          // ... of which were recycled rather than allocated
+        uint64_t outstanding { 0 };   // pooled buffers currently owned by packets
+        uint64_t highWaterMark { 0 }; // most pooled buffers ever outstanding at once
+    };
+
+    // returns a buffer of at least size bytes, zero-filled if requested
+    // sizes over BUFFER_SIZE are allocated outside the pool
+    static Buffer acquire(int64_t size, bool zeroFill);
+
+    // takes ownership of a buffer that was allocated with new[]
+    static Buffer adopt(std::unique_ptr<char[]> buffer) { return Buffer(buffer.release(), Deleter()); }
+
+    static Stats getStats();
+    static void resetStats(); // resets the acquired and hit counts, and the high-water mark to what is outstanding now
+
+private:
+    static void release(char* buffer);
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
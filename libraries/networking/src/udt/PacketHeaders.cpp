@@ -32,7 +32,8 @@ const QSet<PacketType> NON_VERIFIED_PACKETS = QSet<PacketType>()
 const QSet<PacketType> NON_SOURCED_PACKETS = QSet<PacketType>()
     << PacketType::StunResponse << PacketType::CreateAssignment << PacketType::RequestAssignment
     << PacketType::DomainServerRequireDTLS << PacketType::DomainConnectRequest
-    << PacketType::DomainList << PacketType::DomainConnectionDenied
+    << PacketType::DomainList << PacketType::DomainListDelta << PacketType::NodeBandwidthBudgets
+    << PacketType::DomainConnectionDenied
     << PacketType::DomainServerPathQuery << PacketType::DomainServerPathResponse
     << PacketType::DomainServerAddedNode << PacketType::DomainServerConnectionToken
     << PacketType::DomainSettingsRequest << PacketType::DomainSettings
@@ -41,22 +42,29 @@ const QSet<PacketType> NON_SOURCED_PACKETS = QSet<PacketType>()
     << PacketType::ICEServerHeartbeatDenied << PacketType::AssignmentClientStatus << PacketType::StopNode
     << PacketType::DomainServerRemovedNode << PacketType::UsernameFromIDReply;
 
+const QSet<PacketType> COMPRESSIBLE_MESSAGE_PACKETS = QSet<PacketType>()
+    << PacketType::DomainSettings << PacketType::AssetMappingOperationReply;
+
 PacketVersion versionForPacketType(PacketType packetType) {
     switch (packetType) {
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::GetMachineFingerprintFromUUIDSupport);
+            return static_cast<PacketVersion>(DomainListVersion::IncludesListVersion);
+        case PacketType::DomainListRequest:
+            return static_cast<PacketVersion>(DomainListRequestVersion::IncludesReceiveBandwidth);
         case PacketType::EntityAdd:
         case PacketType::EntityEdit:
         case PacketType::EntityData:
         case PacketType::EntityPhysics:
-            return VERSION_ENTITIES_ZONE_FILTERS;
+        case PacketType::EntityPhysicsPacked:
+            return VERSION_ENTITIES_PARTICLES_GPU_SIMULATION;
         case PacketType::EntityQuery:
             return static_cast<PacketVersion>(EntityQueryPacketVersion::JSONFilterWithFamilyTree);
         case PacketType::AvatarIdentity:
         case PacketType::AvatarData:
         case PacketType::BulkAvatarData:
         case PacketType::KillAvatar:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarAsChildFixes);
+        case PacketType::HostedAvatarData:
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::HostedAvatars);
         case PacketType::MessagesData:
             return static_cast<PacketVersion>(MessageDataVersion::TextOrBinaryData);
         case PacketType::ICEServerHeartbeat:
@@ -64,9 +72,19 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::VegasCongestionControl);
+            return static_cast<PacketVersion>(AssetServerPacketVersion::SelectiveACKs);
+        case PacketType::AssetUploadStatus:
+        case PacketType::AssetUploadChunk:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::ChunkedUploads);
+        case PacketType::DomainSettings:
+        case PacketType::AssetMappingOperationReply:
+            return static_cast<PacketVersion>(CompressibleMessageVersion::CompressionFlag);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
+        case PacketType::Jurisdiction:
+            return 18; // the sizes of the octal codes are ints, and the node type is read back
+        case PacketType::AssignmentClientStatus:
+            return 18; // the process ID of the child follows its assignment type
 
         case PacketType::DomainConnectionDenied:
             return static_cast<PacketVersion>(DomainConnectionDeniedVersion::IncludesExtraInfo);
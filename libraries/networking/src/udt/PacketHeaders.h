@@ -113,7 +113,16 @@ public:
         EntityPhysics,
         EntityServerScriptLog,
         AdjustAvatarSorting,
-        LAST_PACKET_TYPE = AdjustAvatarSorting
+        EntityServerDirectory,
+        AssetUploadStatus,
+        AssetUploadStatusReply,
+        AssetUploadChunk,
+        AssetUploadChunkReply,
+        EntityPhysicsPacked,
+        HostedAvatarData,
+        DomainListDelta,
+        NodeBandwidthBudgets,
+        LAST_PACKET_TYPE = NodeBandwidthBudgets
     };
 };
 
@@ -125,6 +134,7 @@ typedef char PacketVersion;
 
 extern const QSet<PacketType> NON_VERIFIED_PACKETS;
 extern const QSet<PacketType> NON_SOURCED_PACKETS;
+extern const QSet<PacketType> COMPRESSIBLE_MESSAGE_PACKETS; // reliable messages that start with a MessageCompression byte
 
 PacketVersion versionForPacketType(PacketType packetType);
 QByteArray protocolVersionsSignature(); /// returns a unqiue signature for all the current protocols
@@ -206,6 +216,7 @@ const PacketVersion VERSION_ENTITIES_LAST_EDITED_BY = 65;
 const PacketVersion VERSION_ENTITIES_SERVER_SCRIPTS = 66;
 const PacketVersion VERSION_ENTITIES_PHYSICS_PACKET = 67;
 const PacketVersion VERSION_ENTITIES_ZONE_FILTERS = 68;
+const PacketVersion VERSION_ENTITIES_PARTICLES_GPU_SIMULATION = 69;
 
 enum class EntityQueryPacketVersion: PacketVersion {
     JSONFilter = 18,
@@ -213,7 +224,9 @@ enum class EntityQueryPacketVersion: PacketVersion {
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
-    VegasCongestionControl = 19
+    VegasCongestionControl = 19,
+    SelectiveACKs,
+    ChunkedUploads
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -228,7 +241,10 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     Unignore,
     ImmediateSessionDisplayNameUpdates,
     VariableAvatarData,
-    AvatarAsChildFixes
+    AvatarAsChildFixes,
+    CoarseJointRotations,
+    CoalescedIdentities,
+    HostedAvatars
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -254,7 +270,14 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    IncludesListVersion
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListVersion = 17,
+    IncludesListVersion,
+    IncludesReceiveBandwidth
 };
 
 enum class AudioVersion : PacketVersion {
@@ -271,4 +294,9 @@ enum class MessageDataVersion : PacketVersion {
     TextOrBinaryData = 18
 };
 
+enum class CompressibleMessageVersion : PacketVersion {
+    Uncompressed = 17,
+    CompressionFlag
+};
+
 #endif // hifi_PacketHeaders_h
@@ -68,6 +68,42 @@ void PacketQueue::queuePacket(PacketPointer packet) {
     _channels.front()->push_back(std::move(packet));
 }
 
+bool PacketQueue::queueLatestOnlyPacket(PacketPointer packet) {
+    Q_ASSERT(packet->isLatestOnly());
+    
+    LockGuard locker(_packetsLock);
+    auto streamKey = packet->getStreamKey();
+    packet->writeStreamSequenceNumber(++_streamSequenceNumbers[streamKey]);
+    
+    auto it = _queuedStreamPackets.find(streamKey);
+    if (it != _queuedStreamPackets.end()) {
+        // the queued state is stale now, send the newer state in its place
+        it->second->swap(packet);
+        return true;
+    }
+    
+    _latestOnlyPackets.push_back(std::move(packet));
+    _queuedStreamPackets[streamKey] = std::prev(_latestOnlyPackets.end());
+    return false;
+}
+
+bool PacketQueue::hasLatestOnlyPackets() const {
+    LockGuard locker(_packetsLock);
+    return !_latestOnlyPackets.empty();
+}
+
+PacketQueue::PacketPointer PacketQueue::takeLatestOnlyPacket() {
+    LockGuard locker(_packetsLock);
+    if (_latestOnlyPackets.empty()) {
+        return PacketPointer();
+    }
+    
+    auto packet = std::move(_latestOnlyPackets.front());
+    _latestOnlyPackets.pop_front();
+    _queuedStreamPackets.erase(packet->getStreamKey());
+    return packet;
+}
+
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
     if (packetList->isOrdered()) {
         packetList->preparePackets(getNextMessageNumber());
@@ -16,6 +16,7 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "Packet.h"
 
@@ -41,6 +42,12 @@ public:
     bool isEmpty() const;
     PacketPointer takePacket();
     
+    // latest only packets are numbered per stream key, and replace the queued packet of the same stream
+    // (which keeps its place in line) - returns true if a queued packet was replaced
+    bool queueLatestOnlyPacket(PacketPointer packet);
+    bool hasLatestOnlyPackets() const;
+    PacketPointer takeLatestOnlyPacket();
+    
     Mutex& getLock() { return _packetsLock; }
     
 private:
@@ -52,6 +59,11 @@ private:
     mutable Mutex _packetsLock; // Protects the packets to be sent.
     Channels _channels; // One channel per packet list + Main channel
     unsigned int _currentIndex { 0 };
+    
+    using LatestOnlyPackets = std::list<PacketPointer>;
+    LatestOnlyPackets _latestOnlyPackets;
+    std::unordered_map<Packet::StreamKey, LatestOnlyPackets::iterator> _queuedStreamPackets;
+    std::unordered_map<Packet::StreamKey, Packet::StreamSequenceNumber> _streamSequenceNumbers;
 };
 
 }
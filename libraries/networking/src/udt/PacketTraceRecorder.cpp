@@ -0,0 +1,168 @@
+//
+//  PacketTraceRecorder.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketTraceRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QProcessEnvironment>
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+#include "Packet.h"
+
+using namespace udt;
+
+static const quint32 TRACE_FILE_MAGIC = 0x48465054; // "HFPT"
+static const quint32 TRACE_FILE_VERSION = 1;
+
+PacketTraceRecord PacketTraceRecord::fromDatagram(const char* data, int size, Direction direction, uint64_t timestamp) {
+    PacketTraceRecord record;
+    record.timestamp = timestamp;
+    record.size = (uint16_t)std::min(size, (int)std::numeric_limits<uint16_t>::max());
+    record.direction = direction;
+
+    if (size < (int)sizeof(uint32_t)) {
+        return record;
+    }
+
+    uint32_t firstWord;
+    memcpy(&firstWord, data, sizeof(firstWord));
+
+    if (firstWord & CONTROL_BIT_MASK) {
+        record.flags |= Control;
+        // the control type sits right above the control bit, see ControlPacket::writeType
+        record.type = (uint16_t)((firstWord & ~CONTROL_BIT_MASK) >> (8 * sizeof(uint16_t)));
+    } else {
+        bool isPartOfMessage = firstWord & MESSAGE_BIT_MASK;
+        record.flags |= (firstWord & RELIABILITY_BIT_MASK) ? Reliable : 0;
+        record.flags |= isPartOfMessage ? Message : 0;
+
+        // the type is unreadable once a re-sent packet is obfuscated, leave it at zero (PacketType::Unknown)
+        int headerSize = Packet::localHeaderSize(isPartOfMessage);
+        if ((firstWord & OBFUSCATION_LEVEL_MASK) == 0 && size > headerSize) {
+            record.type = (uint8_t)data[headerSize];
+        }
+    }
+
+    return record;
+}
+
+std::shared_ptr<PacketTraceRecorder> PacketTraceRecorder::getEnvironmentRecorder() {
+    static const QString TRACE_FILE_ENV = "HIFI_UDT_TRACE_FILE";
+
+    static std::shared_ptr<PacketTraceRecorder> recorder = [] {
+        QString path = QProcessEnvironment::systemEnvironment().value(TRACE_FILE_ENV);
+        if (path.isEmpty()) {
+            return std::shared_ptr<PacketTraceRecorder>();
+        }
+
+        path.replace("%p", QString::number(QCoreApplication::applicationPid()));
+
+        auto recorder = std::make_shared<PacketTraceRecorder>(path);
+        if (!recorder->isOpen()) {
+            return std::shared_ptr<PacketTraceRecorder>();
+        }
+        return recorder;
+    }();
+
+    return recorder;
+}
+
+PacketTraceRecorder::PacketTraceRecorder(const QString& path) :
+    _startTime(p_high_resolution_clock::now()),
+    _file(path)
+{
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(networking) << "Could not open UDT packet trace" << path << "-" << _file.errorString();
+        return;
+    }
+
+    _stream.setDevice(&_file);
+    _stream << TRACE_FILE_MAGIC << TRACE_FILE_VERSION;
+
+    qCDebug(networking) << "Recording UDT packet trace to" << path;
+}
+
+PacketTraceRecorder::~PacketTraceRecorder() {
+    flush();
+}
+
+void PacketTraceRecorder::record(const char* data, int size, PacketTraceRecord::Direction direction) {
+    auto now = p_high_resolution_clock::now();
+    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(now - _startTime).count();
+    auto record = PacketTraceRecord::fromDatagram(data, size, direction, (uint64_t)std::max((int64_t)timestamp, (int64_t)0));
+
+    std::lock_guard<std::mutex> locker(_lock);
+    if (!_file.isOpen()) {
+        return;
+    }
+
+    _stream << (quint64)record.timestamp << (quint16)record.size << (quint8)record.direction
+        << (quint8)record.flags << (quint16)record.type;
+}
+
+void PacketTraceRecorder::flush() {
+    std::lock_guard<std::mutex> locker(_lock);
+    if (_file.isOpen()) {
+        _file.flush();
+    }
+}
+
+std::vector<PacketTraceRecord> PacketTraceRecorder::load(const QString& path, bool* ok) {
+    std::vector<PacketTraceRecord> records;
+    if (ok) {
+        *ok = false;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(networking) << "Could not open UDT packet trace" << path << "-" << file.errorString();
+        return records;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic, version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != TRACE_FILE_MAGIC || version != TRACE_FILE_VERSION) {
+        qCWarning(networking) << path << "is not a version" << TRACE_FILE_VERSION << "UDT packet trace";
+        return records;
+    }
+
+    while (!stream.atEnd()) {
+        quint64 timestamp;
+        quint16 size, type;
+        quint8 direction, flags;
+        stream >> timestamp >> size >> direction >> flags >> type;
+
+        if (stream.status() != QDataStream::Ok) {
+            // a trace cut short by a crash keeps all of its complete records
+            qCWarning(networking) << "UDT packet trace" << path << "is truncated after" << records.size() << "records";
+            break;
+        }
+
+        PacketTraceRecord record;
+        record.timestamp = timestamp;
+        record.size = size;
+        record.direction = direction;
+        record.flags = flags;
+        record.type = type;
+        records.push_back(record);
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+    return records;
+}
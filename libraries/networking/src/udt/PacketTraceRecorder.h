@@ -0,0 +1,87 @@
+//
+//  PacketTraceRecorder.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketTraceRecorder_h
+#define hifi_PacketTraceRecorder_h
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+// What a trace keeps of each datagram - no payloads, just enough to replay the traffic shape
+struct PacketTraceRecord {
+    enum Direction : uint8_t {
+        Sent = 0,
+        Received
+    };
+
+    enum Flag : uint8_t {
+        Control = 0x01,
+        Reliable = 0x02,
+        Message = 0x04
+    };
+
+    uint64_t timestamp { 0 }; // usecs since the trace was started
+    uint16_t size { 0 }; // datagram size, UDT header included
+    uint8_t direction { Sent };
+    uint8_t flags { 0 };
+    uint16_t type { 0 }; // ControlPacket::Type for control packets, first payload byte (the PacketType of an NLPacket) otherwise
+
+    bool isControl() const { return flags & Control; }
+    bool isReliable() const { return flags & Reliable; }
+    bool isPartOfMessage() const { return flags & Message; }
+
+    static PacketTraceRecord fromDatagram(const char* data, int size, Direction direction, uint64_t timestamp);
+};
+
+// Records the datagrams a Socket sends and receives to a binary trace file, for replay by tests/networking
+// Recording is turned on for a process by pointing HIFI_UDT_TRACE_FILE at the file to write,
+// where any %p in the path is replaced by the process ID, so that each mixer writes its own trace.
+class PacketTraceRecorder {
+public:
+    // the recorder for HIFI_UDT_TRACE_FILE, shared by all the sockets of the process - null when not recording
+    static std::shared_ptr<PacketTraceRecorder> getEnvironmentRecorder();
+
+    PacketTraceRecorder(const QString& path);
+    ~PacketTraceRecorder();
+
+    bool isOpen() const { return _file.isOpen(); }
+    QString getPath() const { return _file.fileName(); }
+
+    // safe to call from any thread - the send queues write from the scheduler threads
+    void record(const char* data, int size, PacketTraceRecord::Direction direction);
+    void flush();
+
+    static std::vector<PacketTraceRecord> load(const QString& path, bool* ok = nullptr);
+
+private:
+    PacketTraceRecorder(const PacketTraceRecorder& other) = delete;
+    PacketTraceRecorder& operator=(const PacketTraceRecorder& other) = delete;
+
+    p_high_resolution_clock::time_point _startTime;
+
+    std::mutex _lock; // Protects the file and stream
+    QFile _file;
+    QDataStream _stream;
+};
+
+}
+
+#endif // hifi_PacketTraceRecorder_h
@@ -13,12 +13,10 @@
 
 #include <algorithm>
 #include <random>
-#include <thread>
+#include <vector>
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -38,48 +36,13 @@
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
     
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
 
-    // Setup queue private thread
-    QThread* thread = new QThread;
-    thread->setObjectName("Networking: SendQueue " + destination.objectName()); // Name thread for easier debug
-    
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-    
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-    
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-    
-    thread->start();
+    // the shared scheduler paces the queue from here on, starting with the handshake
+    SendQueueScheduler::getInstance().add(queue.get());
     
     return queue;
 }
@@ -106,37 +69,37 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
 }
 
 SendQueue::~SendQueue() {
+    // in case the owner didn't remove us already - this blocks until we aren't being serviced
+    SendQueueScheduler::getInstance().remove(this);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake the queue in case it is idle, waiting for packets
+    wake();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the queue in case it is idle, waiting for packets
+    wake();
+}
+
+void SendQueue::queueLatestOnlyPacket(std::unique_ptr<Packet> packet) {
+    _packets.queueLatestOnlyPacket(std::move(packet));
     
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
-        this->thread()->start();
-    }
+    // wake the queue in case it is idle, waiting for packets
+    wake();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // wake the queue so the scheduler stops pacing it
+    wake();
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -169,8 +132,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is idle with a full congestion window
+    wake();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -182,8 +145,53 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is idle, waiting for losses to re-send
+    wake();
+}
+
+void SendQueue::selectiveAck(SequenceNumber ack, const uint8_t* bitmap, int numBytes) {
+    // this is a response from the client, re-set our timeout expiry
+    _lastReceiverResponse = QDateTime::currentMSecsSinceEpoch();
+    
+    // find the runs of packets the receiver has (bit i is for ack + 1 + i)
+    std::vector<std::pair<SequenceNumber, SequenceNumber>> receivedRanges;
+    int numBits = numBytes * 8;
+    int i = 0;
+    while (i < numBits) {
+        if ((bitmap[i / 8] & (1 << (i % 8))) == 0) {
+            ++i;
+            continue;
+        }
+        
+        int runStart = i;
+        while (i < numBits && (bitmap[i / 8] & (1 << (i % 8)))) {
+            ++i;
+        }
+        receivedRanges.emplace_back(ack + 1 + runStart, ack + i);
+    }
+    
+    if (receivedRanges.empty()) {
+        return;
+    }
+    
+    {
+        // there is no need to keep (or re-send) these anymore
+        QWriteLocker locker(&_sentLock);
+        for (const auto& range : receivedRanges) {
+            for (auto seq = range.first; seq <= range.second; ++seq) {
+                _sentPackets.erase(seq);
+            }
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> nakLocker(_naksLock);
+        if (!_naks.isEmpty()) {
+            for (const auto& range : receivedRanges) {
+                _naks.remove(range.first, range.second);
+            }
+        }
+    }
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -192,8 +200,8 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is idle, waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -203,49 +211,36 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
     {
         std::lock_guard<std::mutex> nakLocker(_naksLock);
         _naks.clear();
-        
-        SequenceNumber first, second;
-        while (packet.bytesLeftToRead() >= (qint64)(2 * sizeof(SequenceNumber))) {
-            packet.readPrimitive(&first);
-            packet.readPrimitive(&second);
-            
-            if (first == second) {
-                _naks.append(first);
-            } else {
-                _naks.append(first, second);
-            }
-        }
+        _naks.read(packet);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is idle, waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(_initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(_initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
-        {
-            std::lock_guard<std::mutex> locker { _handshakeMutex };
-            _hasReceivedHandshakeACK = true;
-        }
-        // Notify on the handshake ACK condition
-        _handshakeACKCondition.notify_one();
+        _hasReceivedHandshakeACK = true;
+
+        // wake the queue, it is waiting for the ACK to start sending
+        wake();
     }
 }
 
+void SendQueue::wake() {
+    // something happened, so restart the idle timeouts
+    _isIdle = false;
+
+    SendQueueScheduler::getInstance().wake(this);
+}
+
 SequenceNumber SendQueue::getNextSequenceNumber() {
     _atomicCurrentSequenceNumber = (SequenceNumber::Type)++_currentSequenceNumber;
     return _currentSequenceNumber;
@@ -289,113 +284,113 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueueScheduler::NextService SendQueue::service(p_high_resolution_clock::time_point now) {
+    static const SendQueueScheduler::NextService WAIT_FOR_WAKE { SendQueueScheduler::WAIT_FOR_WAKE, false };
+
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        // we've been asked to stop, possibly before we even got a chance to start
+        return WAIT_FOR_WAKE;
     }
     
-    _state = State::Running;
+    // only start running once, a concurrent stop wins
+    auto notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
     
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTime) {
+            sendHandshake();
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+            // we wait for the ACK (which wakes us up) or the re-send interval to expire
+            static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+            _nextHandshakeTime = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+
+        return { _nextHandshakeTime, false };
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    if (!_hasStartedPacing) {
+        // Keep an HRC to know when the next packet should have been, starting once the handshake completes
+        _nextPacketTimestamp = now;
+        _hasStartedPacing = true;
+    }
 
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
-        }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
-        }
+    bool attemptedToSendPacket = maybeResendPacket();
+    
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    auto newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
+    
+    // check now if we were just told to stop
+    // If the send queue has been inactive, stop pacing it
+    // Otherwise, if we didn't send anything, wait to be woken (or for the idle timeouts)
+    p_high_resolution_clock::time_point idleWakeTime;
+    if (_state != State::Running || isInactive(attemptedToSendPacket, now, idleWakeTime)) {
+        return WAIT_FOR_WAKE;
+    }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+    if (!attemptedToSendPacket) {
+        return { idleWakeTime, false };
+    }
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+    if (_packetSendPeriod <= 0) {
+        // no pacing, go again right away
+        return { now, true };
+    }
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+    // push the next packet timestamp forwards by the current packet send period
+    auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
+    _nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+    // wait as long as we need for next packet send, if we can
+    auto timeToSleep = duration_cast<microseconds>(_nextPacketTimestamp - now);
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
+    // we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+    // we'll never allow _nextPacketTimestamp to force us to wait for more than nextPacketDelta
+    // so cap it to that value
+    if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
+        // reset the _nextPacketTimestamp so that it is correct next time we come around
+        _nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-            }
-            
-            std::this_thread::sleep_for(timeToSleep);
-        }
+        timeToSleep = std::chrono::microseconds(nextPacketDelta);
     }
+
+    // we're seeing SendQueues sleep for a long period of time here,
+    // which can lock the NodeList if it's attempting to clear connections
+    // for now we guard this by capping the time this queue can wait for
+
+    const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
+    if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
+        qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+        qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
+        qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+        << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
+        << "NOW:" << now.time_since_epoch().count();
+
+        // alright, we're in a weird state
+        // we want to know why this is happening so we can implement a better fix than this guard
+        // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+        static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
+
+        // setup a json object with the details we want
+        QJsonObject longSleepObject;
+        longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+        longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
+        longSleepObject["nextPacketDelta"] = nextPacketDelta;
+        longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
+        longSleepObject["then"] = qint64(now.time_since_epoch().count());
+
+        // hopefully send this event using the user activity logger
+        UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
+        
+        timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+    }
+
+    return { now + timeToSleep, true };
 }
 
 void SendQueue::setProbePacketEnabled(bool enabled) {
@@ -403,6 +398,21 @@ void SendQueue::setProbePacketEnabled(bool enabled) {
 }
 
 int SendQueue::maybeSendNewPacket() {
+    // latest only packets are paced like the others, but they aren't held back by the flow window
+    // since they are never re-sent - they take turns with reliable packets so neither starves the other
+    bool canSendReliable = !isFlowWindowFull() && !_packets.isEmpty();
+    if ((_shouldSendLatestOnlyNext || !canSendReliable) && _packets.hasLatestOnlyPackets()) {
+        _shouldSendLatestOnlyNext = false;
+        
+        auto packet = _packets.takeLatestOnlyPacket();
+        if (packet) {
+            // unreliable packets get their sequence number from the socket
+            _socket->writePacket(*packet, _destination);
+            return 1;
+        }
+    }
+    _shouldSendLatestOnlyNext = true;
+    
     if (!isFlowWindowFull()) {
         // we didn't re-send a packet, so time to send a new one
         
@@ -534,7 +544,8 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
+bool SendQueue::isInactive(bool attemptedToSendPacket, p_high_resolution_clock::time_point now,
+                           p_high_resolution_clock::time_point& wakeTime) {
     // check for connection timeout first
 
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
@@ -559,65 +570,65 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
         return true;
     }
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    if (attemptedToSendPacket) {
+        _isIdle = false;
+        return false;
+    }
+
+    // During our processing above we didn't send any packets
+    // Anything that comes in from here on wakes us up, so locking the packets and losses together isn't needed
+    std::unique_lock<std::mutex> naksLocker(_naksLock);
+
+    if (!_naks.isEmpty() || hasNewPacketToSend()) {
+        // something came in since we looked, go again right away
+        wakeTime = now;
+        return false;
+    }
+
+    // The packets queue and loss list are both empty, the idle timeouts run from the first time we saw that
+    if (!_isIdle) {
+        _isIdle = true;
+        _idleSince = now;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+        wakeTime = _idleSince + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+
+        if (now >= wakeTime) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+            qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+                << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                << "seconds and receiver has ACKed all packets."
+                << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+            naksLocker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
+            // Deactivate queue
+            deactivate();
+            return true;
+        }
+    } else {
+        // We think the client is still waiting for data (based on the sequence number gap)
+        // Let's wait either for a response from the client or until the estimated timeout
+        // (plus the sync interval to allow the client to respond) has elapsed
+        wakeTime = _idleSince + std::chrono::microseconds(_estimatedTimeout + _syncInterval);
+
+        if (now >= wakeTime && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+            // after a timeout if we still have sent packets that the client hasn't ACKed we
+            // add them to the loss list
+            _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+            naksLocker.unlock();
+
+            // go re-send them right away, and restart the wait after that
+            _isIdle = false;
+            wakeTime = now;
+
+            emit timeout();
         }
     }
     
@@ -634,3 +645,7 @@ void SendQueue::deactivate() {
 bool SendQueue::isFlowWindowFull() const {
     return seqlen(SequenceNumber { (uint32_t) _lastACKSequenceNumber }, _currentSequenceNumber)  > _flowWindowSize;
 }
+
+bool SendQueue::hasNewPacketToSend() const {
+    return _packets.hasLatestOnlyPackets() || (!_packets.isEmpty() && !isFlowWindowFull());
+}
@@ -13,7 +13,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -30,6 +29,7 @@
 #include "Constants.h"
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
+#include "SendQueueScheduler.h"
 #include "LossList.h"
 
 namespace udt {
@@ -56,6 +56,7 @@ public:
     
     void queuePacket(std::unique_ptr<Packet> packet);
     void queuePacketList(std::unique_ptr<PacketList> packetList);
+    void queueLatestOnlyPacket(std::unique_ptr<Packet> packet);
 
     SequenceNumber getCurrentSequenceNumber() const { return SequenceNumber(_atomicCurrentSequenceNumber); }
     
@@ -68,12 +69,17 @@ public:
     void setSyncInterval(int syncInterval) { _syncInterval = syncInterval; }
 
     void setProbePacketEnabled(bool enabled);
+
+    // Sends what is due (a handshake, a re-send or a new packet) and returns when to be serviced next
+    // Only called by the SendQueueScheduler, from one of its threads
+    SendQueueScheduler::NextService service(p_high_resolution_clock::time_point now);
     
 public slots:
     void stop();
     
     void ack(SequenceNumber ack);
     void nak(SequenceNumber start, SequenceNumber end);
+    void selectiveAck(SequenceNumber ack, const uint8_t* bitmap, int numBytes);
     void fastRetransmit(SequenceNumber ack);
     void overrideNAKListFromPacket(ControlPacket& packet);
     void handshakeACK(SequenceNumber initialSequenceNumber);
@@ -87,9 +93,6 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
     SendQueue(Socket* socket, HifiSockAddr dest);
     SendQueue(SendQueue& other) = delete;
@@ -103,15 +106,21 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // also sets wakeTime to when an idle queue should check again
+    bool isInactive(bool attemptedToSendPacket, p_high_resolution_clock::time_point now,
+                    p_high_resolution_clock::time_point& wakeTime);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
+    bool hasNewPacketToSend() const; // a latest only packet, or a reliable one that fits in the flow window
     
     // Increments current sequence number and return it
     SequenceNumber getNextSequenceNumber();
+
+    void wake(); // has the scheduler service us as soon as possible, and restarts the idle timeouts
     
     PacketQueue _packets;
+    bool _shouldSendLatestOnlyNext { false }; // latest only and reliable packets take turns, send thread only
     
     Socket* _socket { nullptr }; // Socket to send packet on
     HifiSockAddr _destination; // Destination addr
@@ -139,12 +148,14 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    p_high_resolution_clock::time_point _nextHandshakeTime; // When to re-send the handshake, send thread only
+
+    bool _hasStartedPacing { false }; // send thread only
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // When the next packet should have been sent, send thread only
 
+    std::atomic<bool> _isIdle { false }; // Cleared whenever we are woken up
+    p_high_resolution_clock::time_point _idleSince; // When we last found nothing to send, send thread only
 
     std::atomic<bool> _shouldSendProbes { true };
 };
@@ -0,0 +1,225 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QProcessEnvironment>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+
+const SendQueueScheduler::TimePoint SendQueueScheduler::WAIT_FOR_WAKE = SendQueueScheduler::TimePoint::max();
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    // a couple of threads are plenty to pace all of the queues, since a queue only sends one packet (or pair) per service
+    static const int MAX_DEFAULT_THREADS = 4;
+    static const QString NUM_THREADS_ENV = "HIFI_UDT_SEND_THREADS";
+
+    static SendQueueScheduler instance([] {
+        bool ok = false;
+        int numThreads = QProcessEnvironment::systemEnvironment().value(NUM_THREADS_ENV).toInt(&ok);
+        if (!ok || numThreads <= 0) {
+            numThreads = std::min(std::max(QThread::idealThreadCount() / 2, 1), MAX_DEFAULT_THREADS);
+        }
+        return numThreads;
+    }());
+    return instance;
+}
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) {
+    qCDebug(networking) << "Pacing UDT send queues with" << numThreads << "threads";
+
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(new SchedulerThread(i));
+        _threads.back()->start();
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    for (auto& thread : _threads) {
+        thread->stop();
+        thread->wait();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    QWriteLocker locker(&_queuesLock);
+    if (_queueThreads.find(queue) != _queueThreads.end()) {
+        return;
+    }
+
+    auto it = std::min_element(_threads.begin(), _threads.end(), [](const std::unique_ptr<SchedulerThread>& a,
+                                                                    const std::unique_ptr<SchedulerThread>& b) {
+        return a->getNumQueues() < b->getNumQueues();
+    });
+    auto thread = it->get();
+    _queueThreads[queue] = thread;
+
+    // add under the lock, so a remove can't get ahead of this add
+    thread->add(queue);
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    SchedulerThread* thread;
+    {
+        QWriteLocker locker(&_queuesLock);
+        auto it = _queueThreads.find(queue);
+        if (it == _queueThreads.end()) {
+            return;
+        }
+        thread = it->second;
+        _queueThreads.erase(it);
+    }
+
+    // don't hold the assignments lock while the queue finishes its service
+    thread->remove(queue);
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    if (auto thread = findThread(queue)) {
+        thread->wake(queue);
+    }
+}
+
+SendQueueScheduler::SchedulerThread* SendQueueScheduler::findThread(SendQueue* queue) {
+    QReadLocker locker(&_queuesLock);
+    auto it = _queueThreads.find(queue);
+    return it != _queueThreads.end() ? it->second : nullptr;
+}
+
+SendQueueScheduler::SchedulerThread::SchedulerThread(int index) {
+    setObjectName("Networking: SendQueue Scheduler " + QString::number(index)); // Name thread for easier debug
+}
+
+void SendQueueScheduler::SchedulerThread::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> locker(_lock);
+
+    auto& scheduledQueue = _queues[queue];
+    ++_numQueues;
+
+    // service new queues right away, so they start their handshake
+    schedule(queue, scheduledQueue, { p_high_resolution_clock::now(), false });
+    _wakeCondition.notify_one();
+}
+
+void SendQueueScheduler::SchedulerThread::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> locker(_lock);
+
+    _servicedCondition.wait(locker, [&] {
+        auto it = _queues.find(queue);
+        return it == _queues.end() || !it->second.isBeingServiced;
+    });
+
+    // any entry left in the heap for this queue is stale now, and will be skipped
+    if (_queues.erase(queue) > 0) {
+        --_numQueues;
+    }
+}
+
+void SendQueueScheduler::SchedulerThread::wake(SendQueue* queue) {
+    std::lock_guard<std::mutex> locker(_lock);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    auto& scheduledQueue = it->second;
+    if (scheduledQueue.isBeingServiced) {
+        // the service might have looked before whatever woke us happened, have it go again when it's done
+        scheduledQueue.wasWoken = true;
+    } else if (!scheduledQueue.isPaced) {
+        schedule(queue, scheduledQueue, { p_high_resolution_clock::now(), false });
+        _wakeCondition.notify_one();
+    }
+}
+
+void SendQueueScheduler::SchedulerThread::stop() {
+    std::lock_guard<std::mutex> locker(_lock);
+    _isStopping = true;
+    _wakeCondition.notify_one();
+}
+
+void SendQueueScheduler::SchedulerThread::schedule(SendQueue* queue, ScheduledQueue& scheduledQueue,
+                                                   NextService nextService) {
+    // bumping the generation invalidates whatever entry the queue already had in the heap
+    scheduledQueue.generation = _nextGeneration++;
+    scheduledQueue.isPaced = nextService.isPaced;
+
+    if (nextService.time != WAIT_FOR_WAKE) {
+        _heap.push({ nextService.time, queue, scheduledQueue.generation });
+    }
+}
+
+void SendQueueScheduler::SchedulerThread::run() {
+    std::vector<SendQueue*> dueQueues;
+    std::vector<NextService> nextServices;
+
+    std::unique_lock<std::mutex> locker(_lock);
+    while (!_isStopping) {
+        if (_heap.empty()) {
+            _wakeCondition.wait(locker);
+            continue;
+        }
+
+        auto now = p_high_resolution_clock::now();
+        if (_heap.top().time > now) {
+            // sleep until the earliest send time, or until a wake schedules something earlier
+            _wakeCondition.wait_for(locker, _heap.top().time - now);
+            continue;
+        }
+
+        // take the whole batch of queues that are due
+        while (!_heap.empty() && _heap.top().time <= now) {
+            auto entry = _heap.top();
+            _heap.pop();
+
+            auto it = _queues.find(entry.queue);
+            if (it == _queues.end() || it->second.generation != entry.generation) {
+                // removed or re-scheduled since this entry was pushed
+                continue;
+            }
+
+            it->second.isBeingServiced = true;
+            it->second.wasWoken = false;
+            dueQueues.push_back(entry.queue);
+        }
+
+        // service them without the lock, so wakes from the other threads don't wait on the sends
+        locker.unlock();
+
+        nextServices.resize(dueQueues.size());
+        for (size_t i = 0; i < dueQueues.size(); ++i) {
+            nextServices[i] = dueQueues[i]->service(now);
+        }
+
+        locker.lock();
+
+        for (size_t i = 0; i < dueQueues.size(); ++i) {
+            // remove waits for the service to finish, so the queue is still here
+            auto& scheduledQueue = _queues[dueQueues[i]];
+            scheduledQueue.isBeingServiced = false;
+
+            auto nextService = nextServices[i];
+            if (scheduledQueue.wasWoken && !nextService.isPaced) {
+                nextService.time = now;
+            }
+            schedule(dueQueues[i], scheduledQueue, nextService);
+        }
+        dueQueues.clear();
+
+        _servicedCondition.notify_all();
+    }
+}
@@ -0,0 +1,128 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QThread>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Paces every SendQueue of the process from a small pool of threads, instead of a sleeping thread per queue.
+// Each thread keeps its queues ordered by the time they next want to send, and services all the due ones in a batch.
+// A queue returns its next send time from SendQueue::service, so the congestion control send period is still respected.
+class SendQueueScheduler {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    // the queue is only serviced again once woken
+    static const TimePoint WAIT_FOR_WAKE;
+
+    // when SendQueue::service wants to be called next
+    // a paced queue isn't woken early, so new packets don't make it send faster than its send period
+    struct NextService {
+        TimePoint time;
+        bool isPaced;
+    };
+
+    static SendQueueScheduler& getInstance();
+
+    ~SendQueueScheduler();
+
+    // starts servicing queue, on the least loaded thread
+    void add(SendQueue* queue);
+
+    // stops servicing queue, blocks until it is not being serviced - it is never touched again once this returns
+    // must not be called from a scheduler thread
+    void remove(SendQueue* queue);
+
+    // services queue as soon as possible, e.g. because it has a new packet, an ACK or a NAK
+    void wake(SendQueue* queue);
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+private:
+    class SchedulerThread;
+
+    SendQueueScheduler(int numThreads);
+    SendQueueScheduler(const SendQueueScheduler& other) = delete;
+    SendQueueScheduler& operator=(const SendQueueScheduler& other) = delete;
+
+    SchedulerThread* findThread(SendQueue* queue);
+
+    QReadWriteLock _queuesLock; // Protects the queue to thread assignments
+    std::unordered_map<SendQueue*, SchedulerThread*> _queueThreads;
+
+    std::vector<std::unique_ptr<SchedulerThread>> _threads;
+};
+
+class SendQueueScheduler::SchedulerThread : public QThread {
+public:
+    SchedulerThread(int index);
+
+    void add(SendQueue* queue);
+    void remove(SendQueue* queue);
+    void wake(SendQueue* queue);
+    void stop();
+
+    int getNumQueues() const { return _numQueues; }
+
+protected:
+    void run() override;
+
+private:
+    struct ScheduledQueue {
+        uint64_t generation { 0 }; // only the heap entry with the current generation is live
+        bool isPaced { false };
+        bool isBeingServiced { false };
+        bool wasWoken { false };
+    };
+
+    struct HeapEntry {
+        TimePoint time;
+        SendQueue* queue;
+        uint64_t generation;
+
+        // std::priority_queue is a max-heap, so order by latest time to service the earliest first
+        bool operator<(const HeapEntry& other) const { return time > other.time; }
+    };
+
+    void schedule(SendQueue* queue, ScheduledQueue& scheduledQueue, NextService nextService);
+
+    std::mutex _lock; // Protects everything below
+    std::condition_variable _wakeCondition; // new work, or an earlier send time
+    std::condition_variable _servicedCondition; // a batch of queues has been serviced
+
+    std::unordered_map<SendQueue*, ScheduledQueue> _queues;
+    std::priority_queue<HeapEntry> _heap; // stale entries are skipped when popped
+    uint64_t _nextGeneration { 1 }; // never reused, so a stale entry can't match a new queue at the same address
+    bool _isStopping { false };
+
+    std::atomic<int> _numQueues { 0 };
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
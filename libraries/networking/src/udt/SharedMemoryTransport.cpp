@@ -0,0 +1,383 @@
+//
+//  SharedMemoryTransport.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/15/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SharedMemoryTransport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <QtCore/QProcessEnvironment>
+#include <QtNetwork/QNetworkInterface>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+
+using namespace udt;
+
+namespace {
+
+const QString DISABLE_SHARED_MEMORY_ENV = "HIFI_UDT_DISABLE_SHARED_MEMORY";
+
+const quint32 RING_MAGIC = 0x48465352; // "HFSR"
+const quint32 RING_VERSION = 1;
+const quint64 RING_DATA_SIZE = 4 * 1024 * 1024; // a power of two, so the offsets can be masked
+
+// a peer that hasn't read its ring for this long is gone, or stuck - its datagrams go over UDP until it's back
+const quint64 PEER_TIMEOUT_USECS = 2 * USECS_PER_SECOND;
+const quint64 PEER_RETRY_USECS = 5 * USECS_PER_SECOND;
+
+// past this many datagrams waiting for the socket thread, the reader leaves them in the ring, which fills up and
+// pushes the peers back to UDP, where the overflow is dropped and UDT sees the loss
+const size_t MAX_PENDING_DATAGRAMS = 8192;
+const unsigned long BACKLOG_SLEEP_MSECS = 1;
+
+const quint32 WRAP_RECORD = 0xFFFFFFFF;
+const quint64 RECORD_ALIGNMENT = 16;
+
+QString ringKey(quint16 port) {
+    return "hifi-udt-ring-" + QString::number(port);
+}
+
+QString doorbellKey(quint16 port) {
+    return "hifi-udt-doorbell-" + QString::number(port);
+}
+
+quint64 alignRecord(quint64 size) {
+    return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+}
+
+namespace udt {
+
+// Lives at the start of each ring segment, followed by RING_DATA_SIZE bytes of records.
+// The writers of all processes take turns through the segment lock, the owner reads without it.
+struct SharedMemoryRing {
+    std::atomic<quint32> magic;
+    quint32 version;
+    std::atomic<quint64> writeIndex; // bytes ever written
+    std::atomic<quint64> readIndex; // bytes ever read
+    std::atomic<quint64> heartbeatUsecs;
+    std::atomic<quint32> readerWaiting; // set while the owner sleeps on its doorbell, the writer who clears it rings
+
+    char* data() { return reinterpret_cast<char*>(this) + sizeof(SharedMemoryRing); }
+    bool isAlive() const {
+        return magic.load() == RING_MAGIC && version == RING_VERSION &&
+            usecTimestampNow() - heartbeatUsecs.load() < PEER_TIMEOUT_USECS;
+    }
+};
+
+// Each record is 16 byte aligned, so a header always fits before the end of the ring
+struct SharedMemoryRecord {
+    quint32 size; // of the datagram, or WRAP_RECORD to continue at the start of the ring
+    quint32 senderAddress; // IPv4, the address the datagram was sent to, which is the one it would have come from
+    quint16 senderPort;
+    quint16 reserved;
+    quint32 reserved2;
+};
+static_assert(sizeof(SharedMemoryRecord) == RECORD_ALIGNMENT, "SharedMemoryRecord must be one alignment unit");
+
+}
+
+static const int RING_SEGMENT_SIZE = (int)(sizeof(SharedMemoryRing) + RING_DATA_SIZE);
+
+bool SharedMemoryTransport::isEnabledByEnvironment() {
+    return !QProcessEnvironment::systemEnvironment().contains(DISABLE_SHARED_MEMORY_ENV);
+}
+
+SharedMemoryTransport::SharedMemoryTransport(QObject* receiver, const char* processSlot) :
+    _receiver(receiver),
+    _processSlot(processSlot)
+{
+    // peers on this host are reached through loopback, or one of the addresses of its interfaces
+    for (const auto& address : QNetworkInterface::allAddresses()) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            _localAddresses.push_back(address);
+        }
+    }
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+    close();
+}
+
+bool SharedMemoryTransport::open(quint16 localPort) {
+    close();
+    if (localPort == 0) {
+        return false;
+    }
+
+    _ring.setKey(ringKey(localPort));
+    if (!_ring.create(RING_SEGMENT_SIZE)) {
+        // a process that crashed on this port leaves its ring behind, take it over once its heartbeat is stale
+        if (_ring.error() != QSharedMemory::AlreadyExists || !_ring.attach()) {
+            qCWarning(networking) << "Could not create the shared memory ring for port" << localPort << "-"
+                << _ring.errorString() << "- local peers will use UDP";
+            return false;
+        }
+        if (_ring.size() < RING_SEGMENT_SIZE || reinterpret_cast<SharedMemoryRing*>(_ring.data())->isAlive()) {
+            qCWarning(networking) << "The shared memory ring for port" << localPort << "is in use - local peers will use UDP";
+            _ring.detach();
+            return false;
+        }
+    }
+
+    // the magic goes last, peers don't write to a ring until it is set
+    auto ring = new (_ring.data()) SharedMemoryRing();
+    ring->version = RING_VERSION;
+    ring->writeIndex = 0;
+    ring->readIndex = 0;
+    ring->readerWaiting = 0;
+    ring->heartbeatUsecs = usecTimestampNow();
+
+    _doorbell.setKey(doorbellKey(localPort), 0, QSystemSemaphore::Create);
+
+    ring->magic = RING_MAGIC;
+    _localPort = localPort;
+
+    _readerThread.reset(new ReaderThread(*this));
+    _readerThread->setObjectName("Networking: Shared Memory Reader " + QString::number(localPort));
+    _readerThread->start();
+
+    qCDebug(networking) << "Receiving datagrams from local peers through shared memory on port" << localPort;
+    return true;
+}
+
+void SharedMemoryTransport::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+    // writers check the magic before each datagram, so they go back to UDP right away
+    reinterpret_cast<SharedMemoryRing*>(_ring.data())->magic = 0;
+    _localPort = 0;
+
+    _stopping = true;
+    _doorbell.release();
+    _readerThread->wait();
+    _readerThread.reset();
+    _stopping = false;
+
+    _ring.detach();
+    _doorbell.setKey(QString());
+
+    {
+        std::lock_guard<std::mutex> locker(_peersLock);
+        _peers.clear();
+    }
+    {
+        std::lock_guard<std::mutex> locker(_pendingLock);
+        _pendingDatagrams.clear();
+    }
+}
+
+bool SharedMemoryTransport::isLocalAddress(const QHostAddress& address) const {
+    if (address.protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
+    return address.isLoopback() || std::find(_localAddresses.begin(), _localAddresses.end(), address) != _localAddresses.end();
+}
+
+std::shared_ptr<SharedMemoryTransport::Peer> SharedMemoryTransport::findOrAttachPeer(const QHostAddress& address, quint16 port) {
+    if (!isLocalAddress(address)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> locker(_peersLock);
+    auto& peer = _peers[port];
+    if (!peer) {
+        peer = std::make_shared<Peer>();
+        peer->memory.setKey(ringKey(port));
+    }
+    return peer;
+}
+
+bool SharedMemoryTransport::writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+    quint16 localPort = _localPort;
+    if (localPort == 0 || size <= 0 || size > MAX_PACKET_SIZE) {
+        return false;
+    }
+
+    auto peer = findOrAttachPeer(sockAddr.getAddress(), sockAddr.getPort());
+    if (!peer) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> peerLocker(peer->lock);
+    auto now = usecTimestampNow();
+
+    if (!peer->memory.isAttached()) {
+        if (now < peer->retryUsecs) {
+            return false;
+        }
+        // most peers are other clients of the same domain that never opened a ring, don't ask them every packet
+        peer->retryUsecs = now + PEER_RETRY_USECS;
+        if (!peer->memory.attach()) {
+            return false;
+        }
+        if (peer->memory.size() < RING_SEGMENT_SIZE) {
+            peer->memory.detach();
+            return false;
+        }
+        peer->doorbell.setKey(doorbellKey(sockAddr.getPort()), 0, QSystemSemaphore::Open);
+    }
+
+    auto ring = reinterpret_cast<SharedMemoryRing*>(peer->memory.data());
+    if (!ring->isAlive()) {
+        // detach so a ring left behind by a crashed peer can go away, and look for the next one later
+        peer->memory.detach();
+        peer->retryUsecs = now + PEER_RETRY_USECS;
+        return false;
+    }
+
+    quint64 recordSize = alignRecord(sizeof(SharedMemoryRecord) + size);
+
+    if (!peer->memory.lock()) {
+        return false;
+    }
+
+    quint64 writeIndex = ring->writeIndex.load(std::memory_order_relaxed);
+    quint64 readIndex = ring->readIndex.load(std::memory_order_acquire);
+    quint64 offset = writeIndex & (RING_DATA_SIZE - 1);
+    quint64 untilEnd = RING_DATA_SIZE - offset;
+    quint64 wrapSize = (untilEnd < recordSize) ? untilEnd : 0;
+
+    if (writeIndex - readIndex + wrapSize + recordSize > RING_DATA_SIZE) {
+        // the peer is behind, this one goes over UDP
+        peer->memory.unlock();
+        return false;
+    }
+
+    if (wrapSize > 0) {
+        reinterpret_cast<SharedMemoryRecord*>(ring->data() + offset)->size = WRAP_RECORD;
+        writeIndex += wrapSize;
+        offset = 0;
+    }
+
+    auto record = reinterpret_cast<SharedMemoryRecord*>(ring->data() + offset);
+    record->size = (quint32)size;
+    record->senderAddress = sockAddr.getAddress().toIPv4Address();
+    record->senderPort = localPort;
+    record->reserved = 0;
+    record->reserved2 = 0;
+    memcpy(ring->data() + offset + sizeof(SharedMemoryRecord), data, size);
+
+    ring->writeIndex.store(writeIndex + recordSize);
+    peer->memory.unlock();
+
+    if (ring->readerWaiting.exchange(0) == 1) {
+        peer->doorbell.release();
+    }
+    return true;
+}
+
+void SharedMemoryTransport::heartbeat() {
+    if (isOpen()) {
+        reinterpret_cast<SharedMemoryRing*>(_ring.data())->heartbeatUsecs = usecTimestampNow();
+    }
+}
+
+void SharedMemoryTransport::ReaderThread::run() {
+    auto ring = reinterpret_cast<SharedMemoryRing*>(_transport._ring.data());
+
+    while (!_transport._stopping) {
+        _transport.readRing();
+
+        bool backlogged;
+        {
+            std::lock_guard<std::mutex> locker(_transport._pendingLock);
+            backlogged = _transport._pendingDatagrams.size() >= MAX_PENDING_DATAGRAMS;
+        }
+        if (backlogged) {
+            QThread::msleep(BACKLOG_SLEEP_MSECS);
+            continue;
+        }
+
+        // flag that we are about to sleep, then look once more so a datagram written in between isn't missed
+        ring->readerWaiting = 1;
+        if (ring->writeIndex.load() != ring->readIndex.load(std::memory_order_relaxed)) {
+            ring->readerWaiting = 0;
+            continue;
+        }
+        _transport._doorbell.acquire();
+    }
+}
+
+void SharedMemoryTransport::readRing() {
+    auto ring = reinterpret_cast<SharedMemoryRing*>(_ring.data());
+    quint64 readIndex = ring->readIndex.load(std::memory_order_relaxed);
+    quint64 writeIndex = ring->writeIndex.load(std::memory_order_acquire);
+    if (readIndex == writeIndex) {
+        return;
+    }
+
+    auto receiveTime = p_high_resolution_clock::now();
+    std::deque<PendingDatagram> datagrams;
+
+    while (readIndex != writeIndex) {
+        quint64 offset = readIndex & (RING_DATA_SIZE - 1);
+        const auto& record = *reinterpret_cast<const SharedMemoryRecord*>(ring->data() + offset);
+
+        if (record.size == WRAP_RECORD) {
+            readIndex += RING_DATA_SIZE - offset;
+            continue;
+        }
+
+        if (record.size == 0 || record.size > (quint32)MAX_PACKET_SIZE ||
+                offset + sizeof(SharedMemoryRecord) + record.size > RING_DATA_SIZE) {
+            qCWarning(networking) << "Dropping the corrupt contents of the shared memory ring for port" << _localPort;
+            readIndex = writeIndex;
+            break;
+        }
+
+        PendingDatagram datagram;
+        datagram.size = (int)record.size;
+        datagram.data = std::unique_ptr<char[]>(new char[datagram.size]);
+        memcpy(datagram.data.get(), ring->data() + offset + sizeof(SharedMemoryRecord), datagram.size);
+        datagram.sender = HifiSockAddr(QHostAddress(record.senderAddress), record.senderPort);
+        datagram.receiveTime = receiveTime;
+        datagrams.push_back(std::move(datagram));
+
+        readIndex += alignRecord(sizeof(SharedMemoryRecord) + record.size);
+    }
+
+    ring->readIndex.store(readIndex, std::memory_order_release);
+
+    if (!datagrams.empty()) {
+        {
+            std::lock_guard<std::mutex> locker(_pendingLock);
+            for (auto& datagram : datagrams) {
+                _pendingDatagrams.push_back(std::move(datagram));
+            }
+        }
+        // one queued call at a time is enough, it takes everything that is pending
+        if (!_processQueued.exchange(true)) {
+            QMetaObject::invokeMethod(_receiver, _processSlot, Qt::QueuedConnection);
+        }
+    }
+}
+
+void SharedMemoryTransport::processPendingDatagrams(const DatagramHandler& handler) {
+    std::deque<PendingDatagram> datagrams;
+    {
+        std::lock_guard<std::mutex> locker(_pendingLock);
+        _processQueued = false;
+        datagrams.swap(_pendingDatagrams);
+    }
+
+    for (auto& datagram : datagrams) {
+        handler(std::move(datagram.data), datagram.size, datagram.sender, datagram.receiveTime);
+    }
+}
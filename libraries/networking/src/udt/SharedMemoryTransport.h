@@ -0,0 +1,115 @@
+//
+//  SharedMemoryTransport.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 10/15/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SharedMemoryTransport_h
+#define hifi_SharedMemoryTransport_h
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QSharedMemory>
+#include <QtCore/QSystemSemaphore>
+#include <QtCore/QThread>
+#include <QtNetwork/QHostAddress>
+
+#include <PortableHighResolutionClock.h>
+
+#include "../HifiSockAddr.h"
+
+namespace udt {
+
+// Carries the datagrams of a Socket to the sockets of other processes on the same host through shared memory rings,
+// skipping the kernel socket stack. Each socket owns one inbound ring, named after its UDP port, that any local peer
+// writes into. The datagrams are delivered with the same sender address they would have had over UDP, so UDT and
+// the node lists above it can't tell the difference.
+// Turned on for every socket, unless HIFI_UDT_DISABLE_SHARED_MEMORY is set in the environment.
+class SharedMemoryTransport {
+public:
+    using DatagramHandler = std::function<void(std::unique_ptr<char[]>, int, const HifiSockAddr&,
+                                               p_high_resolution_clock::time_point)>;
+
+    static bool isEnabledByEnvironment();
+
+    // processSlot is invoked on the receiver's thread whenever datagrams arrive, and should call processPendingDatagrams()
+    SharedMemoryTransport(QObject* receiver, const char* processSlot);
+    ~SharedMemoryTransport();
+
+    bool open(quint16 localPort);
+    void close();
+    bool isOpen() const { return _localPort != 0; }
+
+    // true if the datagram was handed to the ring of a peer on this host, false if it must go over UDP:
+    // the destination isn't local, doesn't have a ring, or its ring is full
+    bool writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
+
+    // hands the datagrams the reader thread pulled from our ring to the handler
+    void processPendingDatagrams(const DatagramHandler& handler);
+
+    // lets the peers know we are still reading our ring, see PEER_TIMEOUT_USECS
+    void heartbeat();
+
+private:
+    struct PendingDatagram {
+        std::unique_ptr<char[]> data;
+        int size;
+        HifiSockAddr sender;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+
+    struct Peer {
+        QSharedMemory memory;
+        QSystemSemaphore doorbell { QString() };
+        std::mutex lock; // serializes the writers of this process, the memory lock serializes the processes
+        quint64 retryUsecs { 0 }; // when to try attaching again, if the last attempt failed
+    };
+
+    class ReaderThread : public QThread {
+    public:
+        ReaderThread(SharedMemoryTransport& transport) : _transport(transport) {}
+    protected:
+        void run() override;
+    private:
+        SharedMemoryTransport& _transport;
+    };
+
+    bool isLocalAddress(const QHostAddress& address) const;
+    std::shared_ptr<Peer> findOrAttachPeer(const QHostAddress& address, quint16 port);
+    void readRing();
+
+    QObject* _receiver;
+    const char* _processSlot;
+
+    std::atomic<quint16> _localPort { 0 };
+    QSharedMemory _ring;
+    QSystemSemaphore _doorbell { QString() };
+    std::unique_ptr<ReaderThread> _readerThread;
+    std::atomic<bool> _stopping { false };
+
+    std::vector<QHostAddress> _localAddresses;
+
+    std::mutex _peersLock; // Protects the peers
+    std::unordered_map<quint16, std::shared_ptr<Peer>> _peers;
+
+    std::mutex _pendingLock;
+    std::deque<PendingDatagram> _pendingDatagrams;
+    std::atomic<bool> _processQueued { false };
+};
+
+} // namespace udt
+
+#endif // hifi_SharedMemoryTransport_h
@@ -15,9 +15,11 @@
 #include <sys/socket.h>
 #endif
 
+#include <QtCore/QSocketNotifier>
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
+#include <NumericalConstants.h>
 
 #include "../NetworkLogging.h"
 #include "Connection.h"
@@ -34,7 +36,8 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _synTimer(new QTimer(this)),
     _readyReadBackupTimer(new QTimer(this)),
-    _shouldChangeSocketOptions(shouldChangeSocketOptions)
+    _shouldChangeSocketOptions(shouldChangeSocketOptions),
+    _traceRecorder(PacketTraceRecorder::getEnvironmentRecorder())
 {
     connect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams);
 
@@ -53,6 +56,10 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    if (SharedMemoryTransport::isEnabledByEnvironment()) {
+        _sharedMemoryTransport.reset(new SharedMemoryTransport(this, "readSharedMemoryDatagrams"));
+    }
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
@@ -71,6 +78,15 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
         setsockopt(sd, IPPROTO_IP, IP_DONTFRAGMENT, &val, sizeof(val));
 #endif
     }
+
+#if defined(Q_OS_LINUX)
+    setupBatchedReceive();
+#endif
+
+    if (_sharedMemoryTransport) {
+        // the ring is named after the port, so it follows every (re)bind
+        _sharedMemoryTransport->open(_udpSocket.localPort());
+    }
 }
 
 void Socket::rebind() {
@@ -158,6 +174,20 @@ qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const HifiSockAddr& s
         return 0;
     }
 
+    if (packet->isLatestOnly()) {
+        // latest only packets go through the connection's send queue, so that a newer one can replace them
+        auto size = packet->getDataSize();
+        if (QThread::currentThread() != thread()) {
+            QMetaObject::invokeMethod(this, "writeLatestOnlyPacket", Qt::QueuedConnection,
+                                      Q_ARG(Packet*, packet.release()),
+                                      Q_ARG(HifiSockAddr, sockAddr));
+        } else {
+            writeLatestOnlyPacket(packet.release(), sockAddr);
+        }
+
+        return size;
+    }
+
     return writePacket(*packet, sockAddr);
 }
 
@@ -218,13 +248,27 @@ void Socket::writeReliablePacketList(PacketList* packetList, const HifiSockAddr&
 #endif
 }
 
+void Socket::writeLatestOnlyPacket(Packet* packet, const HifiSockAddr& sockAddr) {
+    auto connection = findOrCreateConnection(sockAddr);
+    if (connection) {
+        connection->sendLatestOnlyPacket(std::unique_ptr<Packet>(packet));
+    } else {
+        delete packet;
+    }
+}
+
 qint64 Socket::writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
     return writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
 }
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
 
-    qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
+    qint64 bytesWritten;
+    if (_sharedMemoryTransport && _sharedMemoryTransport->writeDatagram(datagram.constData(), datagram.size(), sockAddr)) {
+        bytesWritten = datagram.size();
+    } else {
+        bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
+    }
 
     if (bytesWritten < 0) {
         // when saturating a link this isn't an uncommon message - suppress it so it doesn't bomb the debug
@@ -233,6 +277,8 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
             = LogHandler::getInstance().addRepeatedMessageRegex(WRITE_ERROR_REGEX);
 
         qCDebug(networking) << "Socket::writeDatagram" << _udpSocket.error() << "-" << qPrintable(_udpSocket.errorString());
+    } else if (_traceRecorder) {
+        _traceRecorder->record(datagram.constData(), datagram.size(), PacketTraceRecord::Sent);
     }
 
     return bytesWritten;
@@ -328,6 +374,13 @@ void Socket::checkForReadyReadBackup() {
 }
 
 void Socket::readPendingDatagrams() {
+#if defined(Q_OS_LINUX)
+    if (_readNotifier) {
+        readBatchedDatagrams();
+        return;
+    }
+#endif
+
     int packetSizeWithHeader = -1;
 
     while ((packetSizeWithHeader = _udpSocket.pendingDatagramSize()) != -1) {
@@ -358,65 +411,179 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+void Socket::readSharedMemoryDatagrams() {
+    _sharedMemoryTransport->processPendingDatagrams([this](std::unique_ptr<char[]> buffer, int packetSizeWithHeader,
+                                                           const HifiSockAddr& senderSockAddr,
+                                                           p_high_resolution_clock::time_point receiveTime) {
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    });
+}
 
-            continue;
+#if defined(Q_OS_LINUX)
+
+void Socket::setupBatchedReceive() {
+    // a rebind closes the old descriptor, so the notifier watching it has to go
+    // (deleteLater since we can be rebound from a packet handler called by that notifier)
+    if (_readNotifier) {
+        _readNotifier->setEnabled(false);
+        _readNotifier->deleteLater();
+        _readNotifier = nullptr;
+    }
+
+    auto sd = _udpSocket.socketDescriptor();
+    if (sd == -1) {
+        return;
+    }
+
+    if (_receiveHeaders.empty()) {
+        // the buffers are allocated once and re-used for every batch
+        _receiveBuffers.resize(RECEIVE_BATCH_SIZE * udt::MAX_PACKET_SIZE);
+        _receiveVectors.resize(RECEIVE_BATCH_SIZE);
+        _receiveAddresses.resize(RECEIVE_BATCH_SIZE);
+        _receiveHeaders.resize(RECEIVE_BATCH_SIZE);
+
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            _receiveVectors[i].iov_base = &_receiveBuffers[i * udt::MAX_PACKET_SIZE];
+            _receiveVectors[i].iov_len = udt::MAX_PACKET_SIZE;
+
+            memset(&_receiveHeaders[i], 0, sizeof(mmsghdr));
+            _receiveHeaders[i].msg_hdr.msg_iov = &_receiveVectors[i];
+            _receiveHeaders[i].msg_hdr.msg_iovlen = 1;
+            _receiveHeaders[i].msg_hdr.msg_name = &_receiveAddresses[i];
+        }
+    }
+
+    // QUdpSocket stops notifying us once we read around it, so we watch the descriptor ourselves
+    _readNotifier = new QSocketNotifier(sd, QSocketNotifier::Read, this);
+    connect(_readNotifier, &QSocketNotifier::activated, this, &Socket::readPendingDatagrams);
+}
+
+void Socket::readBatchedDatagrams() {
+    int numReceived = 0;
+
+    do {
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            // recvmmsg overwrites the address lengths and flags with what it read
+            _receiveHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            _receiveHeaders[i].msg_hdr.msg_flags = 0;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        numReceived = recvmmsg(_udpSocket.socketDescriptor(), _receiveHeaders.data(), RECEIVE_BATCH_SIZE,
+                               MSG_DONTWAIT, nullptr);
+
+        if (numReceived <= 0) {
+            // nothing left to read (EAGAIN) or the read failed, either way the notifier will let us know about more
+            break;
+        }
+
+        // we're reading packets so re-start the readyRead backup timer
+        _readyReadBackupTimer->start();
+
+        // the whole batch arrived by the time we woke up, give it one receive time
+        auto receiveTime = p_high_resolution_clock::now();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        for (int i = 0; i < numReceived; ++i) {
+            const auto& header = _receiveHeaders[i];
+            int packetSizeWithHeader = (int)header.msg_len;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr);
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&_receiveAddresses[i]));
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = packetSizeWithHeader;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (packetSizeWithHeader <= 0 || (header.msg_hdr.msg_flags & MSG_TRUNC)) {
+                // empty, or larger than any packet we send - drop it
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
-
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-                        continue;
-                    }
+            // the packet owns its buffer, so copy it out of the batch
+            auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+            memcpy(buffer.get(), _receiveVectors[i].iov_base, packetSizeWithHeader);
+
+            processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+        }
+
+        // a full batch means there may be more waiting
+    } while (numReceived == RECEIVE_BATCH_SIZE && _readNotifier);
+}
+
+#endif
+
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    if (_traceRecorder) {
+        _traceRecorder->record(buffer.get(), packetSizeWithHeader, PacketTraceRecord::Received);
+    }
+
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
+                    return;
                 }
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
+            if (packet->isLatestOnly()) {
+                // drop state older than what we already processed for this stream
+                auto connection = findOrCreateConnection(senderSockAddr);
+                if (connection && connection->processReceivedLatestOnlyPacket(*packet) && _packetHandler) {
                     _packetHandler(std::move(packet));
                 }
+            } else if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
+                }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -459,6 +626,10 @@ void Socket::rateControlSync() {
         }
     }
 
+    if (_sharedMemoryTransport) {
+        _sharedMemoryTransport->heartbeat();
+    }
+
     if (_synTimer->interval() != _synInterval) {
         // if the _synTimer interval doesn't match the current _synInterval (changes when the CC factory is changed)
         // then restart it now with the right interval
@@ -503,6 +674,13 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
     return result;
 }
 
+int Socket::getEstimatedReceiveKbps() {
+    int packetsPerSecond = 0;
+    for (const auto& connectionPair : _connectionsHash) {
+        packetsPerSecond = std::max(packetsPerSecond, connectionPair.second->getTotalStats().estimatedReceiveBandwidth);
+    }
+    return (int)((int64_t)packetsPerSecond * MAX_PACKET_SIZE / BYTES_PER_KILOBIT);
+}
 
 std::vector<HifiSockAddr> Socket::getConnectionSockAddrs() {
     std::vector<HifiSockAddr> addr;
@@ -22,13 +22,22 @@
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
 
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#endif
+
+#include <PortableHighResolutionClock.h>
+
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "PacketTraceRecorder.h"
+#include "SharedMemoryTransport.h"
 
 //#define UDT_CONNECTION_DEBUG
 
 class UDTTest;
+class QSocketNotifier;
 
 namespace udt {
 
@@ -80,6 +89,9 @@ public:
     void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // records every datagram sent and received, see PacketTraceRecorder - set before the socket is used
+    void setPacketTraceRecorder(std::shared_ptr<PacketTraceRecorder> recorder) { _traceRecorder = recorder; }
+
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -88,6 +100,10 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    // the best estimate of the capacity of the link this end receives on, in kilobits per second, 0 if none is known:
+    // the packet pair probes of the reliable traffic measure it for each connection, the best of them is the closest
+    int getEstimatedReceiveKbps();
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
@@ -101,6 +117,7 @@ public slots:
     
 private slots:
     void readPendingDatagrams();
+    void readSharedMemoryDatagrams();
     void checkForReadyReadBackup();
     void rateControlSync();
 
@@ -109,6 +126,12 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+#if defined(Q_OS_LINUX)
+    void setupBatchedReceive();
+    void readBatchedDatagrams();
+#endif
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -120,6 +143,7 @@ private:
     
     Q_INVOKABLE void writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr);
     Q_INVOKABLE void writeReliablePacketList(PacketList* packetList, const HifiSockAddr& sockAddr);
+    Q_INVOKABLE void writeLatestOnlyPacket(Packet* packet, const HifiSockAddr& sockAddr);
     
     QUdpSocket _udpSocket { this };
     PacketFilterOperator _packetFilterOperator;
@@ -145,9 +169,24 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    std::shared_ptr<PacketTraceRecorder> _traceRecorder;
+
+    // datagrams to and from processes on this host skip the socket, see SharedMemoryTransport
+    std::unique_ptr<SharedMemoryTransport> _sharedMemoryTransport;
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
+
+#if defined(Q_OS_LINUX)
+    // on linux we drain the socket with recvmmsg, up to a batch of datagrams per system call
+    static const int RECEIVE_BATCH_SIZE = 64;
+    QSocketNotifier* _readNotifier { nullptr };
+    std::vector<char> _receiveBuffers;
+    std::vector<iovec> _receiveVectors;
+    std::vector<sockaddr_storage> _receiveAddresses;
+    std::vector<mmsghdr> _receiveHeaders;
+#endif
     
     friend UDTTest;
 };
@@ -29,20 +29,19 @@ JurisdictionListener::JurisdictionListener(NodeType_t type) :
 }
 
 void JurisdictionListener::nodeKilled(SharedNodePointer node) {
-    if (_jurisdictions.find(node->getUUID()) != _jurisdictions.end()) {
-        _jurisdictions.erase(_jurisdictions.find(node->getUUID()));
-    }
+    _jurisdictions.withWriteLock([&] {
+        _jurisdictions.remove(node->getUUID());
+    });
 }
 
 bool JurisdictionListener::queueJurisdictionRequest() {
-    auto packet = NLPacket::create(PacketType::JurisdictionRequest, 0);
-    
     auto nodeList = DependencyManager::get<NodeList>();
 
     int nodeCount = 0;
 
     nodeList->eachNode([&](const SharedNodePointer& node) {
         if (node->getType() == getNodeType() && node->getActiveSocket()) {
+            auto packet = NLPacket::create(PacketType::JurisdictionRequest, 0);
             _packetSender.queuePacketForSending(node, std::move(packet));
             nodeCount++;
         }
@@ -62,7 +61,9 @@ void JurisdictionListener::processPacket(QSharedPointer<ReceivedMessage> message
     if (message->getType() == PacketType::Jurisdiction) {
         JurisdictionMap map;
         map.unpackFromPacket(*message);
-        _jurisdictions[message->getSourceID()] = map;
+        _jurisdictions.withWriteLock([&] {
+            _jurisdictions[message->getSourceID()] = map;
+        });
     }
 }
 
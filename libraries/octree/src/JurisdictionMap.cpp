@@ -18,6 +18,7 @@
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 
+#include "OctreeConstants.h"
 #include "OctreeLogging.h"
 #include "JurisdictionMap.h"
 
@@ -178,6 +179,29 @@ JurisdictionMap::Area JurisdictionMap::isMyJurisdiction(const unsigned char* nod
     return isInJurisdiction ? WITHIN : BELOW;
 }
 
+static bool isInOctalCodeCube(const unsigned char* octalCode, const glm::vec3& position) {
+    VoxelPositionSize details;
+    voxelDetailsForCode(octalCode, details);
+    glm::vec3 corner = glm::vec3(details.x, details.y, details.z) * (float)TREE_SCALE - glm::vec3((float)HALF_TREE_SCALE);
+    glm::vec3 offset = position - corner;
+    // half open, so that a point on a face shared by two cubes is in only one of them
+    float size = details.s * (float)TREE_SCALE;
+    return offset.x >= 0.0f && offset.y >= 0.0f && offset.z >= 0.0f && offset.x < size && offset.y < size && offset.z < size;
+}
+
+bool JurisdictionMap::isMyJurisdiction(const glm::vec3& position) const {
+    std::lock_guard<std::mutex> lock(_octalCodeMutex);
+
+    if (_rootOctalCode && !isInOctalCodeCube(_rootOctalCode.get(), position)) {
+        return false;
+    }
+    for (size_t i = 0; i < _endNodes.size(); i++) {
+        if (isInOctalCodeCube(_endNodes[i].get(), position)) {
+            return false;
+        }
+    }
+    return true;
+}
 
 bool JurisdictionMap::readFromFile(const char* filename) {
     QString settingsFile(filename);
@@ -262,8 +286,8 @@ std::unique_ptr<NLPacket> JurisdictionMap::packIntoPacket() {
     // add the root jurisdiction
     std::lock_guard<std::mutex> lock(_octalCodeMutex);
     if (_rootOctalCode) {
-        size_t bytes = bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(_rootOctalCode.get()));
-        // No root or end node details to pack!
+        // written as the int unpackFromPacket reads
+        int bytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(_rootOctalCode.get()));
         packet->writePrimitive(bytes);
         packet->write(reinterpret_cast<char*>(_rootOctalCode.get()), bytes);
 
@@ -273,9 +297,9 @@ std::unique_ptr<NLPacket> JurisdictionMap::packIntoPacket() {
 
         for (int i=0; i < endNodeCount; i++) {
             auto endNodeCode = _endNodes[i].get();
-            size_t bytes = 0;
+            int bytes = 0;
             if (endNodeCode) {
-                bytes = bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(endNodeCode));
+                bytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(endNodeCode));
             }
             packet->writePrimitive(bytes);
             packet->write(reinterpret_cast<char*>(endNodeCode), bytes);
@@ -289,6 +313,9 @@ std::unique_ptr<NLPacket> JurisdictionMap::packIntoPacket() {
 }
 
 int JurisdictionMap::unpackFromPacket(ReceivedMessage& message) {
+    // the node type is in the first byte
+    message.readPrimitive(&_nodeType);
+
     // read the root jurisdiction
     int bytes = 0;
     message.readPrimitive(&bytes);
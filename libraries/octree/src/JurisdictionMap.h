@@ -19,6 +19,8 @@
 #include <QtCore/QString>
 #include <QtCore/QUuid>
 
+#include <glm/glm.hpp>
+
 #include <shared/ReadWriteLockable.h>
 
 #include <NLPacket.h>
@@ -47,6 +49,8 @@ public:
     ~JurisdictionMap();
 
     Area isMyJurisdiction(const unsigned char* nodeOctalCode, int childIndex) const;
+    /// true when the point, in meters in the domain, is in the cube of the root and not in the cube of any end node
+    bool isMyJurisdiction(const glm::vec3& position) const;
 
     bool writeToFile(const char* filename);
     bool readFromFile(const char* filename);
@@ -18,6 +18,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -29,6 +30,7 @@
 #include <QVector>
 #include <QFile>
 #include <QJsonDocument>
+#include <QSaveFile>
 #include <QFileInfo>
 #include <QString>
 
@@ -50,7 +52,7 @@
 #include "OctreeLogging.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -496,6 +498,80 @@ void Octree::readBitstreamToTree(const unsigned char * bitstream, unsigned long
     }
 }
 
+OctreeDecodedBitstreamPointer Octree::decodeBitstream(const unsigned char* bitstream, unsigned long int bufferSizeBytes,
+                                                      ReadBitstreamToTreeParams& args) const {
+    OctreeDecodedBitstreamPointer decoded = createDecodedBitstream();
+    if (!decoded || args.destinationElement) {
+        // the octal codes are only decoded relative to the root
+        return nullptr;
+    }
+
+    // the same walk as readBitstreamToTree(), without the elements to read into
+    const unsigned char* bitstreamAt = bitstream;
+    while (bitstreamAt < bitstream + bufferSizeBytes) {
+        int bytesLeft = (int)(bitstream + bufferSizeBytes - bitstreamAt);
+        int numberOfThreeBitSectionsInStream = numberOfThreeBitSectionsInCode(bitstreamAt, bytesLeft);
+        if (numberOfThreeBitSectionsInStream > UNREASONABLY_DEEP_RECURSION ||
+            numberOfThreeBitSectionsInStream == OVERFLOWED_OCTCODE_BUFFER) {
+            // corrupt, readBitstreamToTree() will say so
+            return nullptr;
+        }
+
+        int octalCodeBytes = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInStream);
+        int lowerLevelBytes = decodeElementSubtree(numberOfThreeBitSectionsInStream, bitstreamAt + octalCodeBytes,
+                                                   bytesLeft - octalCodeBytes, args, *decoded);
+        bitstreamAt += octalCodeBytes + lowerLevelBytes;
+    }
+    return decoded;
+}
+
+int Octree::decodeElementSubtree(int level, const unsigned char* nodeData, int bytesAvailable, ReadBitstreamToTreeParams& args,
+                                 OctreeDecodedBitstream& decoded) const {
+    // mirrors readElementData(), the level is that of the element whose children are read
+    int bytesLeftToRead = bytesAvailable;
+    int bytesRead = 0;
+
+    if (bytesLeftToRead < (int)sizeof(unsigned char) || level > DANGEROUSLY_DEEP_RECURSION) {
+        return bytesAvailable;
+    }
+
+    unsigned char colorInPacketMask = *nodeData;
+    bytesRead += sizeof(colorInPacketMask);
+    bytesLeftToRead -= sizeof(colorInPacketMask);
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        if (oneAtBit(colorInPacketMask, i)) {
+            int childElementDataRead = decodeElementData(false, nodeData + bytesRead, bytesLeftToRead, args, decoded);
+            bytesRead += childElementDataRead;
+            bytesLeftToRead -= childElementDataRead;
+        }
+    }
+
+    int bytesForMasks = args.includeExistsBits ? 2 * sizeof(unsigned char) : sizeof(unsigned char);
+    if (bytesLeftToRead < bytesForMasks) {
+        return bytesAvailable;
+    }
+    unsigned char childInBufferMask = *(nodeData + bytesRead + (args.includeExistsBits ? sizeof(unsigned char) : 0));
+    bytesRead += bytesForMasks;
+    bytesLeftToRead -= bytesForMasks;
+
+    for (int childIndex = 0; bytesLeftToRead > 0 && childIndex < NUMBER_OF_CHILDREN; childIndex++) {
+        if (oneAtBit(childInBufferMask, childIndex)) {
+            int lowerLevelBytes = decodeElementSubtree(level + 1, nodeData + bytesRead, bytesLeftToRead, args, decoded);
+            bytesRead += lowerLevelBytes;
+            bytesLeftToRead -= lowerLevelBytes;
+        }
+    }
+
+    if (level == 0 && rootElementHasData() && bytesLeftToRead > 0) {
+        int rootDataSize = decodeElementData(true, nodeData + bytesRead, bytesLeftToRead, args, decoded);
+        bytesRead += rootDataSize;
+        bytesLeftToRead -= rootDataSize;
+    }
+
+    return bytesRead;
+}
+
 void Octree::deleteOctreeElementAt(float x, float y, float z, float s) {
     unsigned char* octalCode = pointToOctalCode(x,y,z,s);
     deleteOctalCodeFromTree(octalCode);
@@ -1627,6 +1703,9 @@ bool Octree::readFromFile(const char* fileName) {
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
+    if (qFileName.endsWith(".bin")) {
+        return readFromBinaryFile(qFileName);
+    }
 
     QFile file(qFileName);
 
@@ -1658,16 +1737,31 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
+
+    // inflate the file as it is read, so that only the json is held in memory
     QByteArray jsonData;
+    QBuffer jsonBuffer(&jsonData);
+    jsonBuffer.open(QIODevice::WriteOnly);
 
-    if (!gunzip(compressedJsonData, jsonData)) {
+    emit importSize(1.0f, 1.0f, 1.0f);
+    emit importProgress(0);
+    bool unzipped = gunzip(file, jsonBuffer, 0, [this](qint64 bytesRead, qint64 bytesTotal) {
+        if (bytesTotal > 0) {
+            emit importProgress((int)(bytesRead * 100 / bytesTotal));
+        }
+    });
+    jsonBuffer.close();
+    if (!unzipped) {
         qCritical() << "json File not in gzip format: " << qFileName;
         return false;
     }
 
-    QDataStream jsonStream(jsonData);
-    return readJSONFromStream(-1, jsonStream);
+    QJsonDocument asDocument = QJsonDocument::fromJson(jsonData);
+    jsonData.clear();
+    QVariantMap asMap = asDocument.toVariant().toMap();
+    bool success = readFromMap(asMap);
+    emit importProgress(100);
+    return success;
 }
 
 bool Octree::readFromURL(const QString& urlString) {
@@ -1882,6 +1976,8 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin" && !element) {
+        success = writeToBinaryFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1889,10 +1985,39 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
 }
 
 bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
-    QVariantMap entityDescription;
-
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
+    QByteArray jsonDataForFile;
+    if (!writeToJSON(jsonDataForFile, element, false)) {
+        return false;
+    }
+
+    // the file is replaced once complete, so that its readers never see it half written
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        if (doGzip) {
+            // deflate into the file as the json is read, rather than into a second buffer
+            QBuffer jsonBuffer(&jsonDataForFile);
+            jsonBuffer.open(QIODevice::ReadOnly);
+            success = gzip(jsonBuffer, persistFile);
+            if (!success) {
+                qCritical("unable to gzip data while saving to json.");
+            }
+        } else {
+            success = persistFile.write(jsonDataForFile) != -1;
+        }
+        success = success && persistFile.commit();
+    } else {
+        qCritical("Could not write to JSON description of entities.");
+    }
+
+    return success;
+}
+
+bool Octree::writeToJSON(QByteArray& data, OctreeElementPointer element, bool doGzip) {
+    QVariantMap entityDescription;
+
     OctreeElementPointer top;
     if (element) {
         top = element;
@@ -1914,26 +2039,17 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
 
     // convert the QVariantMap to JSON
     QByteArray jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
-    QByteArray jsonDataForFile;
 
     if (doGzip) {
-        if (!gzip(jsonData, jsonDataForFile, -1)) {
+        if (!gzip(jsonData, data, -1)) {
             qCritical("unable to gzip data while saving to json.");
             return false;
         }
     } else {
-        jsonDataForFile = jsonData;
-    }
-
-    QFile persistFile(fileName);
-    bool success = false;
-    if (persistFile.open(QIODevice::WriteOnly)) {
-        success = persistFile.write(jsonDataForFile) != -1;
-    } else {
-        qCritical("Could not write to JSON description of entities.");
+        data = jsonData;
     }
 
-    return success;
+    return true;
 }
 
 bool Octree::writeToSVOFile(const char* fileName, OctreeElementPointer element) {
@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 
@@ -179,6 +180,14 @@ public:
     bool pathChanged;
 };
 
+/// What Octree::decodeBitstream() could read of the elements of a bitstream without the tree, for readBitstreamToTree()
+/// to use instead of reading it again
+class OctreeDecodedBitstream {
+public:
+    virtual ~OctreeDecodedBitstream() { }
+};
+using OctreeDecodedBitstreamPointer = std::unique_ptr<OctreeDecodedBitstream>;
+
 class ReadBitstreamToTreeParams {
 public:
     bool includeExistsBits;
@@ -189,6 +198,7 @@ public:
     PacketVersion bitstreamVersion;
     int elementsPerPacket = 0;
     int entitiesPerPacket = 0;
+    OctreeDecodedBitstream* decodedBitstream = nullptr; // from Octree::decodeBitstream(), for the elements to use
 
     ReadBitstreamToTreeParams(
         bool includeExistsBits = WANT_EXISTS_BITS,
@@ -206,6 +216,13 @@ public:
     {}
 };
 
+/// An inbound edit decoded by Octree::decodeEditPacketData(), for the tree to apply later in processDecodedEdit()
+class OctreeDecodedEdit {
+public:
+    virtual ~OctreeDecodedEdit() { }
+};
+using OctreeDecodedEditPointer = std::unique_ptr<OctreeDecodedEdit>;
+
 class Octree : public QObject, public std::enable_shared_from_this<Octree>, public ReadWriteLockable {
     Q_OBJECT
 public:
@@ -225,7 +242,26 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
-                    
+
+    // Implement these to let the OctreeServer decode edits of a type on several threads without the tree lock, and then
+    // apply them in order under the write lock. processEditPacketData() must be the same as decoding and then applying.
+    virtual bool decodesEditPacketType(PacketType packetType) const { return false; }
+    /// must not touch the tree, returns the bytes the edit takes in the message like processEditPacketData()
+    virtual int decodeEditPacketData(PacketType packetType, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& sourceNode, OctreeDecodedEditPointer& decodedEdit) { return 0; }
+    /// the caller holds the write lock
+    virtual void processDecodedEdit(PacketType packetType, OctreeDecodedEdit& decodedEdit,
+                                    const SharedNodePointer& sourceNode) { }
+
+    // Implement these and decodeElementData() to let a client decode the data of the elements of a bitstream without the
+    // tree lock, before it is read into the tree under the write lock with the decoded data in
+    // ReadBitstreamToTreeParams::decodedBitstream.
+    virtual bool decodesBitstream() const { return false; }
+    virtual OctreeDecodedBitstreamPointer createDecodedBitstream() const { return nullptr; }
+    /// does not touch the tree, the bitstream must outlive the decoded data - null if the bitstream is corrupt
+    OctreeDecodedBitstreamPointer decodeBitstream(const unsigned char* bitstream, unsigned long int bufferSizeBytes,
+                                                  ReadBitstreamToTreeParams& args) const;
+
     virtual bool recurseChildrenWithData() const { return true; }
     virtual bool rootElementHasData() const { return false; }
     virtual int minimumRequiredRootDataBytes() const { return 0; }
@@ -309,6 +345,8 @@ public:
     bool writeToFile(const char* filename, OctreeElementPointer element = NULL, QString persistAsFileType = "svo");
     bool writeToJSONFile(const char* filename, OctreeElementPointer element = NULL, bool doGzip = false);
     bool writeToSVOFile(const char* filename, OctreeElementPointer element = NULL);
+    bool writeToJSON(QByteArray& data, OctreeElementPointer element = NULL, bool doGzip = false);
+    virtual bool writeToBinaryFile(const char* filename) { return false; } // the "bin" persist file type, if supported
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
 
@@ -319,6 +357,7 @@ public:
     bool readSVOFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
+    virtual bool readFromBinaryFile(const QString& fileName) { return false; }
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
 
     unsigned long getOctreeElementsCount();
@@ -358,6 +397,10 @@ public:
     virtual quint64 getAverageLoggingTime() const { return 0;  }
     virtual quint64 getAverageFilterTime() const { return 0; }
 
+    // the time saves held the tree's lock for, added by the writers and taken by the persist thread to report the stall
+    void addSaveLockUsecs(quint64 usecs) { _saveLockUsecs += usecs; }
+    quint64 takeSaveLockUsecs() { return _saveLockUsecs.exchange(0); }
+
 signals:
     void importSize(float x, float y, float z);
     void importProgress(int progress);
@@ -376,6 +419,12 @@ protected:
 
     static bool countOctreeElementsOperation(OctreeElementPointer element, void* extraData);
 
+    /// decodes the data of one element like OctreeElement::readElementDataFromBuffer() would read it, returning the bytes read
+    virtual int decodeElementData(bool isRoot, const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args,
+                                  OctreeDecodedBitstream& decoded) const { return 0; }
+    int decodeElementSubtree(int level, const unsigned char* nodeData, int bytesAvailable, ReadBitstreamToTreeParams& args,
+                             OctreeDecodedBitstream& decoded) const;
+
     OctreeElementPointer nodeForOctalCode(OctreeElementPointer ancestorElement, const unsigned char* needleCode, OctreeElementPointer* parentOfFoundElement) const;
     OctreeElementPointer createMissingElement(OctreeElementPointer lastParentElement, const unsigned char* codeToReach, int recursionCount = 0);
     int readElementData(OctreeElementPointer destinationElement, const unsigned char* nodeData,
@@ -389,6 +438,8 @@ protected:
 
     bool _isViewing;
     bool _isServer;
+
+    std::atomic<quint64> _saveLockUsecs { 0 };
 };
 
 #endif // hifi_Octree_h
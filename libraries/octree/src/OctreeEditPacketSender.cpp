@@ -231,8 +231,8 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
             QUuid nodeUUID = node->getUUID();
             bool isMyJurisdiction = true;
 
-            if (type == PacketType::EntityErase) {
-                isMyJurisdiction = true; // send erase messages to all servers
+            if (shouldSendToAllServers(type)) {
+                isMyJurisdiction = true;
             } else if (_serverJurisdictions) {
                 // we need to get the jurisdiction for this
                 // here we need to get the "pending packet" for this server
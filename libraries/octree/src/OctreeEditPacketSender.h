@@ -76,6 +76,8 @@ public:
     // you must override these...
     virtual char getMyNodeType() const = 0;
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) { }
+    /// true for the messages each server decides about itself, instead of being routed by their octal code
+    virtual bool shouldSendToAllServers(PacketType type) const { return type == PacketType::EntityErase; }
 
     void processNackPacket(ReceivedMessage& message, SharedNodePointer sendingNode);
 
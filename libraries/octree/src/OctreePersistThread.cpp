@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -20,10 +21,12 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QBuffer>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
@@ -33,6 +36,7 @@
 #include "OctreePersistThread.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const qint64 OctreePersistThread::BACKUP_BYTES_PER_STEP = 256 * 1024; // 25 MB per second at a step every 10 msecs
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -59,7 +63,8 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == "bin") {
+        // the binary file is only for the server itself, it is downloaded as json.gz
         return "application/zip";
     }
     return "";
@@ -140,27 +145,28 @@ bool OctreePersistThread::process() {
 
         bool persistantFileRead;
 
+        // First check to make sure "lock" file doesn't exist. If it does exist, then
+        // our last save crashed during the save, and we want to load our most recent backup.
+        // The backup is copied without the tree's lock, and only replaces the persist file once complete.
+        QString lockFileName = _filename + ".lock";
+        std::ifstream lockFile(qPrintable(lockFileName), std::ios::in | std::ios::binary | std::ios::ate);
+        if (lockFile.is_open()) {
+            qCDebug(octree) << "WARNING: Octree lock file detected at startup:" << lockFileName
+                << "-- Attempting to restore from previous backup file.";
+
+            // This is where we should attempt to find the most recent backup and restore from
+            // that file as our persist file.
+            restoreFromMostRecentBackup();
+
+            lockFile.close();
+            qCDebug(octree) << "Loading Octree... lock file closed:" << lockFileName;
+            remove(qPrintable(lockFileName));
+            qCDebug(octree) << "Loading Octree... lock file removed:" << lockFileName;
+        }
+
         _tree->withWriteLock([&] {
             PerformanceWarning warn(true, "Loading Octree File", true);
 
-            // First check to make sure "lock" file doesn't exist. If it does exist, then
-            // our last save crashed during the save, and we want to load our most recent backup.
-            QString lockFileName = _filename + ".lock";
-            std::ifstream lockFile(qPrintable(lockFileName), std::ios::in | std::ios::binary | std::ios::ate);
-            if (lockFile.is_open()) {
-                qCDebug(octree) << "WARNING: Octree lock file detected at startup:" << lockFileName
-                    << "-- Attempting to restore from previous backup file.";
-
-                // This is where we should attempt to find the most recent backup and restore from
-                // that file as our persist file.
-                restoreFromMostRecentBackup();
-
-                lockFile.close();
-                qCDebug(octree) << "Loading Octree... lock file closed:" << lockFileName;
-                remove(qPrintable(lockFileName));
-                qCDebug(octree) << "Loading Octree... lock file removed:" << lockFileName;
-            }
-
             persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
             _tree->pruneTree();
         });
@@ -207,9 +213,13 @@ bool OctreePersistThread::process() {
         quint64 USECS_TO_SLEEP = 10 * MSECS_TO_USECS; // every 10ms
         std::this_thread::sleep_for(std::chrono::microseconds(USECS_TO_SLEEP));
 
-        // do our updates then check to save...
+        // do our updates, copy a step of the backups, then check to save...
         _tree->update();
 
+        if (!_pendingBackups.isEmpty()) {
+            copyBackupStep(BACKUP_BYTES_PER_STEP);
+        }
+
         quint64 now = usecTimestampNow();
         quint64 sinceLastSave = now - _lastCheck;
         quint64 intervalToCheck = _persistInterval * MSECS_TO_USECS;
@@ -237,32 +247,55 @@ bool OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    finishBackups();
     persist();
+    finishBackups();
     qCDebug(octree) << "Persist thread done with about to finish...";
     _stopThread = true;
 }
 
-QByteArray OctreePersistThread::getPersistFileContents() const {
-    QByteArray fileContents;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
-        fileContents = file.readAll();
+std::unique_ptr<QIODevice> OctreePersistThread::openPersistFile() const {
+    if (_persistAsFileType == "bin") {
+        // the binary file is converted, in memory
+        std::unique_ptr<QBuffer> buffer(new QBuffer());
+        _tree->withReadLock([&] {
+            _tree->writeToJSON(buffer->buffer(), NULL, true);
+        });
+        buffer->open(QIODevice::ReadOnly);
+        return std::move(buffer);
+    }
+
+    // the persist file is replaced rather than rewritten when saved, so a download keeps reading the one it opened
+    std::unique_ptr<QFile> file(new QFile(_filename));
+    if (!file->open(QIODevice::ReadOnly)) {
+        return std::unique_ptr<QIODevice>();
+    }
+    return std::move(file);
+}
+
+float OctreePersistThread::getBackupProgress() const {
+    qint64 total = _backupBytesTotal;
+    if (total < 0) {
+        return -1.0f;
     }
-    return fileContents;
+    return total > 0 ? (float)_backupBytesCopied / total : 0.0f;
 }
 
 void OctreePersistThread::persist() {
+    if (!_pendingBackups.isEmpty()) {
+        // the backups read the persist file, it is saved once they are done
+        return;
+    }
+
     if (_tree->isDirty() && _initialLoadComplete) {
+        quint64 persistStart = usecTimestampNow();
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
             qCDebug(octree) << "DONE pruning Octree before saving...";
         });
-
-        qCDebug(octree) << "persist operation calling backup...";
-        backup(); // handle backup if requested        
-        qCDebug(octree) << "persist operation DONE with backup...";
+        quint64 pruneStall = usecTimestampNow() - persistStart;
 
 
         // create our "lock" file to indicate we're saving.
@@ -271,15 +304,26 @@ void OctreePersistThread::persist() {
         if(lockFile.is_open()) {
             qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
 
+            _tree->takeSaveLockUsecs(); // only count what this save holds the lock for
             _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
             time(&_lastPersistTime);
             _tree->clearDirtyBit(); // tree is clean after saving
-            qCDebug(octree) << "DONE saving Octree to file...";
+
+            // the writers snapshot the tree under its lock and serialize without it, so this is what edits waited on
+            quint64 stall = pruneStall + _tree->takeSaveLockUsecs();
+            _lastPersistStallUSecs = stall;
+            _maxPersistStallUSecs = std::max(_maxPersistStallUSecs.load(), stall);
+            _lastPersistUSecs = usecTimestampNow() - persistStart;
+            qCDebug(octree) << "DONE saving Octree to file... stalled edits for" << stall << "usecs of"
+                << _lastPersistUSecs << "usecs";
 
             lockFile.close();
             qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
             remove(qPrintable(lockFileName));
             qCDebug(octree) << "saving Octree lock file removed:" << lockFileName;
+
+            // back up the file just saved, if requested, a step at a time from now on
+            backup();
         }
     }
 }
@@ -296,11 +340,18 @@ void OctreePersistThread::restoreFromMostRecentBackup() {
     if (recentBackup) {
         qCDebug(octree) << "BEST backup file:" << mostRecentBackupFileName << " last modified:" << mostRecentBackupTime.toString();
 
-        qCDebug(octree) << "Removing old file:" << _filename;
-        remove(qPrintable(_filename));
-
         qCDebug(octree) << "Restoring backup file " << mostRecentBackupFileName << "...";
-        bool result = QFile::copy(mostRecentBackupFileName, _filename);
+
+        // the backup is streamed next to the persist file, which it replaces once complete
+        QFile backupFile(mostRecentBackupFileName);
+        QSaveFile persistFile(_filename);
+        bool result = backupFile.open(QIODevice::ReadOnly) && persistFile.open(QIODevice::WriteOnly);
+        QByteArray chunk(BACKUP_BYTES_PER_STEP, Qt::Uninitialized);
+        while (result && !backupFile.atEnd()) {
+            qint64 chunkSize = backupFile.read(chunk.data(), chunk.size());
+            result = chunkSize >= 0 && persistFile.write(chunk.constData(), chunkSize) == chunkSize;
+        }
+        result = result && persistFile.commit();
         if (result) {
             qCDebug(octree) << "DONE restoring backup file " << mostRecentBackupFileName << "to" << _filename << "...";
         } else {
@@ -455,14 +506,7 @@ void OctreePersistThread::backup() {
                     QFile persistFile(_filename);
                     if (persistFile.exists()) {
                         qCDebug(octree) << "backing up persist file " << _filename << "to" << backupFileName << "...";
-                        bool result = QFile::copy(_filename, backupFileName);
-                        if (result) {
-                            qCDebug(octree) << "DONE backing up persist file...";
-                            rule.lastBackup = now; // only record successful backup in this case.
-                        } else {
-                            qCDebug(octree) << "ERROR in backing up persist file...";
-                            perror("ERROR in backing up persist file");
-                        }
+                        _pendingBackups.push_back({ i, backupFileName });
                     } else {
                         qCDebug(octree) << "persist file " << _filename << " does not exist. " << 
                                     "nothing to backup for this rule ["<< rule.name << "]...";
@@ -478,3 +522,61 @@ void OctreePersistThread::backup() {
         }
     }
 }
+
+bool OctreePersistThread::copyBackupStep(qint64 maxBytes) {
+    const PendingBackup& pending = _pendingBackups.front();
+
+    if (!_backupSource) {
+        // the copy is written to a hidden file, which the backup filters don't match, and renamed once complete
+        QFileInfo backupInfo(pending.fileName);
+        _backupSource.reset(new QFile(_filename));
+        _backupDestination.reset(new QFile(backupInfo.absolutePath() + "/." + backupInfo.fileName() + ".part"));
+        if (!_backupSource->open(QIODevice::ReadOnly) ||
+            !_backupDestination->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCDebug(octree) << "ERROR in backing up persist file to" << pending.fileName << "...";
+            _backupSource.reset();
+            _backupDestination.reset();
+            _pendingBackups.pop_front();
+            _backupBytesTotal = _pendingBackups.isEmpty() ? -1 : 0;
+            return false;
+        }
+        _backupStarted = usecTimestampNow();
+        _backupBytesCopied = 0;
+        _backupBytesTotal = _backupSource->size();
+    }
+
+    QByteArray chunk = _backupSource->read(maxBytes);
+    bool success = _backupDestination->write(chunk) == chunk.size();
+    _backupBytesCopied += chunk.size();
+    if (success && !_backupSource->atEnd()) {
+        return true;
+    }
+
+    _backupSource.reset();
+    _backupDestination->close();
+    QString copyFileName = _backupDestination->fileName();
+    _backupDestination.reset();
+
+    if (success) {
+        QFile::remove(pending.fileName);
+        success = QFile::rename(copyFileName, pending.fileName);
+    }
+    if (success) {
+        qCDebug(octree) << "DONE backing up persist file to" << pending.fileName << "in"
+            << (usecTimestampNow() - _backupStarted) / USECS_PER_MSEC << "msecs...";
+        _backupRules[pending.ruleIndex].lastBackup = _backupStarted; // only record successful backup in this case.
+    } else {
+        qCDebug(octree) << "ERROR in backing up persist file to" << pending.fileName << "...";
+        QFile::remove(copyFileName);
+    }
+
+    _pendingBackups.pop_front();
+    _backupBytesTotal = _pendingBackups.isEmpty() ? -1 : 0;
+    return false;
+}
+
+void OctreePersistThread::finishBackups() {
+    while (!_pendingBackups.isEmpty()) {
+        copyBackupStep(BACKUP_BYTES_PER_STEP);
+    }
+}
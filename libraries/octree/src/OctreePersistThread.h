@@ -14,7 +14,13 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <atomic>
+
 #include <QString>
+#include <memory>
+
+#include <QFile>
+
 #include <GenericThread.h>
 #include "Octree.h"
 
@@ -32,6 +38,7 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const qint64 BACKUP_BYTES_PER_STEP;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, const QString& backupDirectory,
                         int persistInterval = DEFAULT_PERSIST_INTERVAL, bool wantBackup = false,
@@ -40,11 +47,21 @@ public:
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
 
+    // how long the last save stalled edits by holding the tree's lock, the most it ever did, and how long it took in all
+    quint64 getLastPersistStallTime() const { return _lastPersistStallUSecs; }
+    quint64 getMaxPersistStallTime() const { return _maxPersistStallUSecs; }
+    quint64 getLastPersistTime() const { return _lastPersistUSecs; }
+
+    // the part of the backup being copied that is done, from 0 to 1, or -1 when no backup is being copied
+    float getBackupProgress() const;
+
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
     QString getPersistFilename() const { return _filename; }
     QString getPersistFileMimeType() const;
-    QByteArray getPersistFileContents() const;
+
+    // the contents of the persist file for a download, read as it is sent
+    std::unique_ptr<QIODevice> openPersistFile() const;
 
 signals:
     void loadCompleted();
@@ -55,6 +72,8 @@ protected:
 
     void persist();
     void backup();
+    bool copyBackupStep(qint64 maxBytes);
+    void finishBackups();
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
     bool getMostRecentBackup(const QString& format, QString& mostRecentBackupFileName, QDateTime& mostRecentBackupTime);
@@ -70,11 +89,28 @@ private:
 
     quint64 _loadTimeUSecs;
 
+    std::atomic<quint64> _lastPersistStallUSecs { 0 };
+    std::atomic<quint64> _maxPersistStallUSecs { 0 };
+    std::atomic<quint64> _lastPersistUSecs { 0 };
+
     time_t _lastPersistTime;
     quint64 _lastCheck;
     bool _wantBackup;
     QVector<BackupRule> _backupRules;
 
+    // the backups of the persist file are copied a step at a time between the updates of the tree, and the file is not
+    // saved again until they are done
+    struct PendingBackup {
+        int ruleIndex;
+        QString fileName;
+    };
+    QVector<PendingBackup> _pendingBackups;
+    std::unique_ptr<QFile> _backupSource;
+    std::unique_ptr<QFile> _backupDestination;
+    quint64 _backupStarted { 0 };
+    std::atomic<qint64> _backupBytesCopied { 0 };
+    std::atomic<qint64> _backupBytesTotal { -1 };
+
     bool _debugTimestampNow;
     quint64 _lastTimeDebug;
 
@@ -102,6 +102,9 @@ void OctreeRenderer::processDatagram(ReceivedMessage& message, SharedNodePointer
         int subsection = 1;
         
         bool error = false;
+
+        bool decodesPacket = _appliesDecodedPackets && _tree->decodesBitstream();
+        DecodedPacket decodedPacket;
         
         while (message.getBytesLeftToRead() > 0 && !error) {
             if (packetIsCompressed) {
@@ -119,58 +122,81 @@ void OctreeRenderer::processDatagram(ReceivedMessage& message, SharedNodePointer
                 // ask the VoxelTree to read the bitstream into the tree
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
                                                 sourceUUID, sourceNode, false, message.getVersion());
-                quint64 startUncompress, startLock = usecTimestampNow();
+                quint64 startUncompress = usecTimestampNow();
+
+                // nothing but reading the bitstream into the tree needs the lock
+                OctreePacketData packetData(packetIsCompressed);
+                packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
+                    sectionLength);
+                if (extraDebugging) {
+                    qCDebug(octree) << "OctreeRenderer::processDatagram() ... "
+                        "Got Packet Section color:" << packetIsColored <<
+                        "compressed:" << packetIsCompressed <<
+                        "sequence: " << sequence <<
+                        "flight: " << flightTime << " usec" <<
+                        "size:" << message.getSize() <<
+                        "data:" << message.getBytesLeftToRead() <<
+                        "subsection:" << subsection <<
+                        "sectionLength:" << sectionLength <<
+                        "uncompressed:" << packetData.getUncompressedSize();
+                }
+
+                quint64 startLock = usecTimestampNow();
                 quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
-                _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
-                    }
-
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ******* START _tree->readBitstreamToTree()...";
-                    }
-                    startReadBitsteam = usecTimestampNow();
-                    _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
+                if (decodesPacket) {
+                    // decode what can be without the tree, applyDecodedPackets() reads the rest into it
+                    startReadBitsteam = startLock;
+                    DecodedSection section;
+                    section.bitstream = QByteArray(reinterpret_cast<const char*>(packetData.getUncompressedData()),
+                                                   packetData.getUncompressedSize());
+                    section.args = args;
+                    section.decoded = _tree->decodeBitstream(reinterpret_cast<const unsigned char*>(section.bitstream.constData()),
+                                                             section.bitstream.size(), args);
+                    decodedPacket.sections.push_back(std::move(section));
                     endReadBitsteam = usecTimestampNow();
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeRenderer::processDatagram() ******* END _tree->readBitstreamToTree()...";
-                    }
-                });
+                } else {
+                    // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
+                    // loop to reduce the amount of locking/unlocking we're doing
+                    _tree->withWriteLock([&] {
+                        if (extraDebugging) {
+                            qCDebug(octree) << "OctreeRenderer::processDatagram() ******* START _tree->readBitstreamToTree()...";
+                        }
+                        startReadBitsteam = usecTimestampNow();
+                        _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
+                        endReadBitsteam = usecTimestampNow();
+                        if (extraDebugging) {
+                            qCDebug(octree) << "OctreeRenderer::processDatagram() ******* END _tree->readBitstreamToTree()...";
+                        }
+                    });
+
+                    elementsPerPacket += args.elementsPerPacket;
+                    entitiesPerPacket += args.entitiesPerPacket;
+
+                    _elementsInLastWindow += args.elementsPerPacket;
+                    _entitiesInLastWindow += args.entitiesPerPacket;
+                }
                 
                 // seek forwards in packet
                 message.seek(message.getPosition() + sectionLength);
 
-                elementsPerPacket += args.elementsPerPacket;
-                entitiesPerPacket += args.entitiesPerPacket;
-
-                _elementsInLastWindow += args.elementsPerPacket;
-                _entitiesInLastWindow += args.entitiesPerPacket;
-
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
+                totalWaitingForLock += (startReadBitsteam - startLock);
+                totalUncompress += (startLock - startUncompress);
                 totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
 
             }
             subsection++;
         }
-        _elementsPerPacket.updateAverage(elementsPerPacket);
-        _entitiesPerPacket.updateAverage(entitiesPerPacket);
+
+        if (decodesPacket) {
+            // the elements and entities are counted as the packet is applied
+            if (!decodedPacket.sections.empty()) {
+                std::lock_guard<std::mutex> lock(_decodedPacketsMutex);
+                _decodedPackets.push_back(std::move(decodedPacket));
+            }
+        } else {
+            _elementsPerPacket.updateAverage(elementsPerPacket);
+            _entitiesPerPacket.updateAverage(entitiesPerPacket);
+        }
 
         _waitLockPerPacket.updateAverage(totalWaitingForLock);
         _uncompressPerPacket.updateAverage(totalUncompress);
@@ -198,6 +224,69 @@ void OctreeRenderer::processDatagram(ReceivedMessage& message, SharedNodePointer
     }
 }
 
+bool OctreeRenderer::hasDecodedPackets() const {
+    std::lock_guard<std::mutex> lock(_decodedPacketsMutex);
+    return !_decodedPackets.empty();
+}
+
+void OctreeRenderer::applyDecodedPackets(quint64 maxUsecs) {
+    if (!_tree || !hasDecodedPackets()) {
+        return;
+    }
+
+    // at least one packet is applied each time, so that the packets are applied as long as any come
+    quint64 start = usecTimestampNow();
+    _tree->withWriteLock([&] {
+        do {
+            DecodedPacket packet;
+            {
+                std::lock_guard<std::mutex> lock(_decodedPacketsMutex);
+                if (_decodedPackets.empty()) {
+                    break;
+                }
+                packet = std::move(_decodedPackets.front());
+                _decodedPackets.pop_front();
+            }
+            applyDecodedPacket(packet);
+        } while (usecTimestampNow() - start < maxUsecs);
+    });
+}
+
+void OctreeRenderer::applyDecodedPacket(DecodedPacket& packet) {
+    if (packet.update) {
+        packet.update();
+        return;
+    }
+
+    int elementsPerPacket = 0;
+    int entitiesPerPacket = 0;
+    for (auto& section : packet.sections) {
+        section.args.decodedBitstream = section.decoded.get();
+        _tree->readBitstreamToTree(reinterpret_cast<const unsigned char*>(section.bitstream.constData()),
+                                   section.bitstream.size(), section.args);
+        elementsPerPacket += section.args.elementsPerPacket;
+        entitiesPerPacket += section.args.entitiesPerPacket;
+    }
+    _elementsPerPacket.updateAverage(elementsPerPacket);
+    _entitiesPerPacket.updateAverage(entitiesPerPacket);
+    _elementsInLastWindow += elementsPerPacket;
+    _entitiesInLastWindow += entitiesPerPacket;
+}
+
+void OctreeRenderer::applyInOrder(std::function<void()> update) {
+    {
+        std::lock_guard<std::mutex> lock(_decodedPacketsMutex);
+        if (!_decodedPackets.empty()) {
+            DecodedPacket packet;
+            packet.update = std::move(update);
+            _decodedPackets.push_back(std::move(packet));
+            return;
+        }
+    }
+    // the packets are only queued on this thread, so none can have come since
+    _tree->withWriteLock(update);
+}
+
 bool OctreeRenderer::renderOperation(OctreeElementPointer element, void* extraData) {
     RenderArgs* args = static_cast<RenderArgs*>(extraData);
     if (element->isInView(args->getViewFrustum())) {
@@ -224,6 +313,10 @@ void OctreeRenderer::render(RenderArgs* renderArgs) {
 }
 
 void OctreeRenderer::clear() {
+    {
+        std::lock_guard<std::mutex> lock(_decodedPacketsMutex);
+        _decodedPackets.clear();
+    }
     if (_tree) {
         _tree->withWriteLock([&] {
             _tree->eraseAllOctreeElements();
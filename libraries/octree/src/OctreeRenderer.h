@@ -15,6 +15,12 @@
 #include <glm/glm.hpp>
 #include <stdint.h>
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include <QObject>
 
 #include <udt/PacketHeaders.h>
@@ -45,6 +51,13 @@ public:
     /// process incoming data
     virtual void processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode);
 
+    /// with trees that decode their bitstreams, processDatagram() decodes the packets without the tree lock and leaves them
+    /// for applyDecodedPackets() to read into the tree, instead of reading them into the tree itself
+    void setAppliesDecodedPackets(bool appliesDecodedPackets) { _appliesDecodedPackets = appliesDecodedPackets; }
+    /// reads the decoded packets into the tree in the order they came, under one write lock, until maxUsecs are spent
+    void applyDecodedPackets(quint64 maxUsecs);
+    bool hasDecodedPackets() const;
+
     /// initialize and GPU/rendering related resources
     virtual void init();
 
@@ -73,6 +86,9 @@ public:
 protected:
     virtual OctreePointer createTree() = 0;
 
+    /// runs the update under the write lock after the decoded packets that came before it, or at once if there are none
+    void applyInOrder(std::function<void()> update);
+
     OctreePointer _tree;
     bool _managedTree;
     ViewFrustum _viewFrustum;
@@ -90,9 +106,27 @@ protected:
 
     quint64 _lastWindowAt = 0;
     int _packetsInLastWindow = 0;
-    int _elementsInLastWindow = 0;
-    int _entitiesInLastWindow = 0;
-
+    std::atomic<int> _elementsInLastWindow { 0 }; // also counted by applyDecodedPackets()
+    std::atomic<int> _entitiesInLastWindow { 0 };
+
+private:
+    struct DecodedSection {
+        QByteArray bitstream; // uncompressed
+        ReadBitstreamToTreeParams args;
+        OctreeDecodedBitstreamPointer decoded;
+    };
+
+    struct DecodedPacket {
+        std::vector<DecodedSection> sections;
+        std::function<void()> update; // from applyInOrder(), in place of the sections
+    };
+
+    // the caller holds the write lock
+    void applyDecodedPacket(DecodedPacket& packet);
+
+    std::atomic<bool> _appliesDecodedPackets { false };
+    mutable std::mutex _decodedPacketsMutex;
+    std::deque<DecodedPacket> _decodedPackets;
 };
 
 #endif // hifi_OctreeRenderer_h
@@ -117,6 +117,7 @@ void CharacterController::setDynamicsWorld(btDynamicsWorld* world) {
         if (world && _rigidBody) {
             _dynamicsWorld = world;
             _pendingFlags &= ~PENDING_FLAG_JUMP;
+            _floorRayExpiry = 0;
             // Before adding the RigidBody to the world we must save its oldGravity to the side
             // because adding an object to the world will overwrite it with the default gravity.
             btVector3 oldGravity = _rigidBody->getGravity();
@@ -176,12 +177,24 @@ void CharacterController::preStep(btCollisionWorld* collisionWorld) {
     btScalar rayLength = _radius + FLOOR_PROXIMITY_THRESHOLD;
     btVector3 rayEnd = rayStart - rayLength * _currentUp;
 
-    // scan down for nearby floor
-    ClosestNotMe rayCallback(_rigidBody);
-    rayCallback.m_closestHitFraction = 1.0f;
-    collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
-    if (rayCallback.hasHit()) {
-        _floorDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
+    // scan down for nearby floor, which rarely moves under an avatar at rest, so the ray of the last substeps
+    // is reused until the body moves or it gets old
+    const btScalar FLOOR_RAY_CACHE_DISTANCE = 0.001f; // meters
+    const quint64 FLOOR_RAY_CACHE_PERIOD = 100 * USECS_PER_MSEC;
+    quint64 now = usecTimestampNow();
+    if (now > _floorRayExpiry || rayLength != _floorRayLength ||
+            rayStart.distance2(_floorRayStart) > FLOOR_RAY_CACHE_DISTANCE * FLOOR_RAY_CACHE_DISTANCE) {
+        ClosestNotMe rayCallback(_rigidBody);
+        rayCallback.m_closestHitFraction = 1.0f;
+        collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
+        _floorRayHasHit = rayCallback.hasHit();
+        _floorRayDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
+        _floorRayStart = rayStart;
+        _floorRayLength = rayLength;
+        _floorRayExpiry = now + FLOOR_RAY_CACHE_PERIOD;
+    }
+    if (_floorRayHasHit) {
+        _floorDistance = _floorRayDistance;
     }
 
     _hasSupport = checkForSupport(collisionWorld);
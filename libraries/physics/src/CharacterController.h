@@ -161,6 +161,13 @@ protected:
     btScalar _floorDistance;
     bool _hasSupport;
 
+    // the last floor ray of the substeps
+    btVector3 _floorRayStart { 0.0f, 0.0f, 0.0f };
+    btScalar _floorRayLength { 0.0f };
+    btScalar _floorRayDistance { 0.0f };
+    quint64 _floorRayExpiry { 0 };
+    bool _floorRayHasHit { false };
+
     btScalar _gravity;
 
     btScalar _jumpSpeed;
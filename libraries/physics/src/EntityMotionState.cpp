@@ -190,6 +190,9 @@ PhysicsMotionType EntityMotionState::computePhysicsMotionType() const {
             // if something would have been dynamic but is a child of something else, force it to be kinematic, instead.
             return MOTION_TYPE_KINEMATIC;
         }
+        if (_isOutOfPhysicsLOD) {
+            return MOTION_TYPE_KINEMATIC;
+        }
         return MOTION_TYPE_DYNAMIC;
     }
     if (_entity->isMovingRelativeToParent() ||
@@ -678,6 +681,9 @@ uint32_t EntityMotionState::getIncomingDirtyFlags() {
             ) {
             dirtyFlags |= Simulation::DIRTY_MOTION_TYPE;
         }
+        if (_physicsLODChanged) {
+            dirtyFlags |= Simulation::DIRTY_MOTION_TYPE;
+        }
     }
     return dirtyFlags;
 }
@@ -686,9 +692,24 @@ void EntityMotionState::clearIncomingDirtyFlags() {
     assert(entityTreeIsLocked());
     if (_body && _entity) {
         _entity->clearDirtyFlags();
+        _physicsLODChanged = false;
     }
 }
 
+bool EntityMotionState::wantsCollisionEvents() const {
+    // the collision events end up in the entity script, the collision sound or the handlers of other scripts
+    return !_entity->getScript().isEmpty() || !_entity->getCollisionSoundURL().isEmpty() || _entity->hasCollisionHandler();
+}
+
+bool EntityMotionState::setOutOfPhysicsLOD(bool outOfLOD) {
+    if (outOfLOD == _isOutOfPhysicsLOD) {
+        return false;
+    }
+    _isOutOfPhysicsLOD = outOfLOD;
+    _physicsLODChanged = true;
+    return true;
+}
+
 // virtual
 uint8_t EntityMotionState::getSimulationPriority() const {
     return _entity->getSimulationPriority();
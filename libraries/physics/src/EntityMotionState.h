@@ -80,6 +80,12 @@ public:
     virtual void computeCollisionGroupAndMask(int16_t& group, int16_t& mask) const override;
 
     bool shouldBeLocallyOwned() const override;
+    bool wantsCollisionEvents() const override;
+
+    // Out of the physics LOD a dynamic entity is kinematic, moved by the extrapolation of the server state
+    // \return true if it changed, the motion type is then updated with the next changes
+    bool setOutOfPhysicsLOD(bool outOfLOD);
+    bool isOutOfPhysicsLOD() const { return _isOutOfPhysicsLOD; }
 
     friend class PhysicalEntitySimulation;
 
@@ -126,6 +132,9 @@ protected:
     mutable uint8_t _accelerationNearlyGravityCount;
     uint8_t _numInactiveUpdates { 1 };
     uint8_t _outgoingPriority { 0 };
+
+    bool _isOutOfPhysicsLOD { false };
+    bool _physicsLODChanged { false };
 };
 
 #endif // hifi_EntityMotionState_h
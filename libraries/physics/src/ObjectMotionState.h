@@ -148,6 +148,9 @@ public:
 
     virtual bool shouldBeLocallyOwned() const { return false; }
 
+    // false when nothing would handle the collision events of this object
+    virtual bool wantsCollisionEvents() const { return true; }
+
     friend class PhysicsEngine;
 
 protected:
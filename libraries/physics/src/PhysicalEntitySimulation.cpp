@@ -9,7 +9,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <glm/gtx/norm.hpp>
 
+#include <SharedUtil.h>
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
@@ -17,6 +19,8 @@
 
 #include "PhysicalEntitySimulation.h"
 
+const float PhysicalEntitySimulation::DEFAULT_PHYSICS_LOD_DISTANCE = 50.0f; // meters
+
 PhysicalEntitySimulation::PhysicalEntitySimulation() {
 }
 
@@ -225,7 +229,8 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
                         << "at" << entity->getPosition() << " will be reduced";
                 }
             }
-            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+            // expensive shapes are built on a worker, the entity stays on the list until its shape is ready
+            btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
             if (shape) {
                 EntityMotionState* motionState = new EntityMotionState(shape, entity);
                 entity->setPhysicsInfo(static_cast<void*>(motionState));
@@ -233,7 +238,6 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
                 result.push_back(motionState);
                 entityItr = _entitiesToAddToPhysics.erase(entityItr);
             } else {
-                //qWarning() << "Failed to generate new shape for entity." << entity->getName();
                 ++entityItr;
             }
         } else {
@@ -242,6 +246,39 @@ void PhysicalEntitySimulation::getObjectsToAddToPhysics(VectorOfMotionStates& re
     }
 }
 
+void PhysicalEntitySimulation::updatePhysicsLOD() {
+    quint64 now = usecTimestampNow();
+    if (now < _nextPhysicsLODUpdate) {
+        return;
+    }
+    const quint64 PHYSICS_LOD_UPDATE_PERIOD = USECS_PER_SECOND / 4;
+    _nextPhysicsLODUpdate = now + PHYSICS_LOD_UPDATE_PERIOD;
+
+    // entities come back a bit closer than they leave so that those on the edge don't flip every update
+    const float PHYSICS_LOD_HYSTERESIS = 0.9f;
+    float outDistanceSquared = _physicsLODDistance * _physicsLODDistance;
+    float inDistanceSquared = PHYSICS_LOD_HYSTERESIS * PHYSICS_LOD_HYSTERESIS * outDistanceSquared;
+    QUuid sessionID = Physics::getSessionUUID();
+
+    QMutexLocker lock(&_mutex);
+    for (auto object : _physicalObjects) {
+        EntityMotionState* motionState = static_cast<EntityMotionState*>(object);
+        EntityItem* entity = motionState->_entity;
+        if (!entity || !entity->getDynamic()) {
+            continue;
+        }
+        bool outOfLOD = false;
+        // the entities we simulate stay dynamic wherever they go
+        if (_physicsLODDistance > 0.0f && entity->getSimulatorID() != sessionID) {
+            float distanceSquared = glm::distance2(entity->getPosition(), _physicsLODCenter);
+            outOfLOD = distanceSquared > (motionState->isOutOfPhysicsLOD() ? inDistanceSquared : outDistanceSquared);
+        }
+        if (motionState->setOutOfPhysicsLOD(outOfLOD)) {
+            _pendingChanges.insert(motionState);
+        }
+    }
+}
+
 void PhysicalEntitySimulation::setObjectsToChange(const VectorOfMotionStates& objectsToChange) {
     QMutexLocker lock(&_mutex);
     for (auto object : objectsToChange) {
@@ -62,6 +62,17 @@ public:
 
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
+    /// The dynamic entities that we don't simulate are moved kinematically beyond this distance from the center,
+    /// usually our avatar, so the cost of the physics follows the entities around us rather than those of the domain.
+    /// 0 keeps them all dynamic.
+    void setPhysicsLODCenter(const glm::vec3& center) { _physicsLODCenter = center; }
+    void setPhysicsLODDistance(float distance) { _physicsLODDistance = distance; }
+    float getPhysicsLODDistance() const { return _physicsLODDistance; }
+    static const float DEFAULT_PHYSICS_LOD_DISTANCE;
+
+    /// re-evaluates the LOD of the entities every so often, with the tree locked, before getObjectsToChange()
+    void updatePhysicsLOD();
+
 private:
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntities _entitiesToRelease;
@@ -76,6 +87,10 @@ private:
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     uint32_t _lastStepSendPackets { 0 };
+
+    glm::vec3 _physicsLODCenter;
+    float _physicsLODDistance { DEFAULT_PHYSICS_LOD_DISTANCE };
+    quint64 _nextPhysicsLODUpdate { 0 };
 };
 
 
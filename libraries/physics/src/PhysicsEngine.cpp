@@ -9,9 +9,14 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <mutex>
+
+#include <QThread>
+
 #include <PhysicsCollisionGroups.h>
 
 #include <PerfStat.h>
+#include <SettingHandle.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -20,6 +25,33 @@
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+#ifdef HIFI_BULLET_MULTITHREADED
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+
+// Off by default, the simulation then runs on the calling thread as with the single threaded world
+static Setting::Handle<bool> multithreadedPhysics { "multithreadedPhysics", false };
+
+// The task scheduler of Bullet is global, set once for all the engines
+static void setupTaskScheduler() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        btITaskScheduler* scheduler = nullptr;
+        if (multithreadedPhysics.get()) {
+            scheduler = btCreateDefaultTaskScheduler();
+        }
+        if (scheduler) {
+            // Leave the main and render threads to themselves
+            int numThreads = std::max(QThread::idealThreadCount() - 2, 1);
+            scheduler->setNumThreads(std::min(numThreads, scheduler->getMaxNumThreads()));
+            qCDebug(physics) << "Simulating physics on" << scheduler->getNumThreads() << "threads";
+        } else {
+            scheduler = btGetSequentialTaskScheduler();
+        }
+        btSetTaskScheduler(scheduler);
+    });
+}
+#endif
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -40,10 +72,19 @@ PhysicsEngine::~PhysicsEngine() {
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
+#ifdef HIFI_BULLET_MULTITHREADED
+        setupTaskScheduler();
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+        // a solver per thread for the islands solved in parallel
+        auto constraintSolverPool = new btConstraintSolverPoolMt(btGetTaskScheduler()->getNumThreads());
+        _constraintSolver = constraintSolverPool;
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, constraintSolverPool, _collisionConfig);
+#else
+        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#endif
 
         _ghostPairCallback = new btGhostPairCallback();
         _dynamicsWorld->getPairCache()->setInternalGhostPairCallback(_ghostPairCallback);
@@ -247,13 +288,14 @@ void PhysicsEngine::reinsertObject(ObjectMotionState* object) {
 }
 
 void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
-    // trigger events for new/existing/old contacts
-    ContactMap::iterator contactItr = _contactMap.begin();
-    while (contactItr != _contactMap.end()) {
-        if (contactItr->first._a == motionState || contactItr->first._b == motionState) {
-            contactItr = _contactMap.erase(contactItr);
+    // btHashMap::remove() moves the last contact into the removed one, so the same index is checked again
+    int i = 0;
+    while (i < _contactMap.size()) {
+        ContactKey key = _contactMap.getKeyAtIndex(i);
+        if (key._a == motionState || key._b == motionState) {
+            _contactMap.remove(key);
         } else {
-            ++contactItr;
+            ++i;
         }
     }
 }
@@ -405,7 +447,13 @@ void PhysicsEngine::updateContactMap() {
             ObjectMotionState* b = static_cast<ObjectMotionState*>(objectB->getUserPointer());
             if (a || b) {
                 // the manifold has up to 4 distinct points, but only extract info from the first
-                _contactMap[ContactKey(a, b)].update(_numContactFrames, contactManifold->getContactPoint(0));
+                ContactKey key(a, b);
+                ContactInfo* contact = _contactMap.find(key);
+                if (!contact) {
+                    _contactMap.insert(key, ContactInfo());
+                    contact = _contactMap.find(key);
+                }
+                contact->update(_numContactFrames, contactManifold->getContactPoint(0));
             }
 
             if (!Physics::getSessionUUID().isNull()) {
@@ -419,17 +467,20 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
     _collisionEvents.clear();
 
     // scan known contacts and trigger events
-    ContactMap::iterator contactItr = _contactMap.begin();
-
-    while (contactItr != _contactMap.end()) {
-        ContactInfo& contact = contactItr->second;
+    int i = 0;
+    while (i < _contactMap.size()) {
+        ContactKey key = _contactMap.getKeyAtIndex(i);
+        ContactInfo& contact = *_contactMap.getAtIndex(i);
         ContactEventType type = contact.computeType(_numContactFrames);
+        ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(key._a);
+        ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(key._b);
+        // contacts with MyAvatar (which has no MotionState) are always reported
+        bool wanted = !motionStateA || !motionStateB ||
+            motionStateA->wantsCollisionEvents() || motionStateB->wantsCollisionEvents();
         const btScalar SIGNIFICANT_DEPTH = -0.002f; // penetrations have negative distance
-        if (type != CONTACT_EVENT_TYPE_CONTINUE ||
+        if (wanted && (type != CONTACT_EVENT_TYPE_CONTINUE ||
                 (contact.distance < SIGNIFICANT_DEPTH &&
-                 contact.readyForContinue(_numContactFrames))) {
-            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(contactItr->first._a);
-            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(contactItr->first._b);
+                 contact.readyForContinue(_numContactFrames)))) {
 
             // NOTE: the MyAvatar RigidBody is the only object in the simulation that does NOT have a MotionState
             // which means should we ever want to report ALL collision events against the avatar we can
@@ -464,9 +515,10 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
         }
 
         if (type == CONTACT_EVENT_TYPE_END) {
-            contactItr = _contactMap.erase(contactItr);
+            // the last contact takes this index
+            _contactMap.remove(key);
         } else {
-            ++contactItr;
+            ++i;
         }
     }
     return _collisionEvents;
@@ -20,6 +20,8 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "BulletUtil.h"
+#include <LinearMath/btHashMap.h>
+
 #include "ContactInfo.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
@@ -29,18 +31,26 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 
 class CharacterController;
 
-// simple class for keeping track of contacts
+// simple class for keeping track of contacts, for use with btHashMap
 class ContactKey {
 public:
     ContactKey() = delete;
     ContactKey(void* a, void* b) : _a(a), _b(b) {}
     bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
     bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    bool equals(const ContactKey& other) const { return *this == other; }
+    unsigned int getHash() const {
+        // the low bits of the pointers are always zero
+        size_t a = (size_t)_a >> 4;
+        size_t b = (size_t)_b >> 4;
+        return (unsigned int)(a * 2654435761u) ^ (unsigned int)b;
+    }
     void* _a; // ObjectMotionState pointer
     void* _b; // ObjectMotionState pointer
 };
 
-typedef std::map<ContactKey, ContactInfo> ContactMap;
+// the contacts are kept in arrays which only grow, so the steps don't allocate once the map is warm
+typedef btHashMap<ContactKey, ContactInfo> ContactMap;
 typedef std::vector<Collision> CollisionEvents;
 
 class PhysicsEngine {
@@ -104,7 +114,7 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
 
@@ -0,0 +1,61 @@
+//
+//  PhysicsThread.cpp
+//  libraries/physics/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsThread.h"
+
+PhysicsThread::PhysicsThread() {
+    _thread = std::thread([this] { run(); });
+}
+
+PhysicsThread::~PhysicsThread() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stepDone.wait(lock, [this] { return !_step; });
+        _quit = true;
+    }
+    _stepReady.notify_one();
+    _thread.join();
+}
+
+void PhysicsThread::start(Step step) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stepDone.wait(lock, [this] { return !_step; });
+        _step = step;
+    }
+    _stepReady.notify_one();
+}
+
+void PhysicsThread::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stepDone.wait(lock, [this] { return !_step; });
+}
+
+bool PhysicsThread::isBusy() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return (bool)_step;
+}
+
+void PhysicsThread::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _stepReady.wait(lock, [this] { return _quit || _step; });
+        if (_quit) {
+            return;
+        }
+        Step step = _step;
+        lock.unlock();
+        step();
+        lock.lock();
+        _step = nullptr;
+        _stepDone.notify_all();
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  PhysicsThread.h
+//  libraries/physics/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsThread_h
+#define hifi_PhysicsThread_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Runs one simulation step at a time off the main thread so that it overlaps the rest of the frame.
+// The owner hands the step over with start() and must call wait() before it touches the PhysicsEngine again,
+// which makes the frame boundary the only point where changes and results are exchanged.
+class PhysicsThread {
+public:
+    using Step = std::function<void()>;
+
+    PhysicsThread();
+    ~PhysicsThread();
+
+    // waits for the previous step before handing over the next one
+    void start(Step step);
+    void wait();
+
+    bool isBusy() const;
+
+private:
+    void run();
+
+    std::thread _thread;
+    mutable std::mutex _mutex;
+    std::condition_variable _stepReady;
+    std::condition_variable _stepDone;
+    Step _step;
+    bool _quit { false };
+};
+
+#endif // hifi_PhysicsThread_h
@@ -0,0 +1,60 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeCache.h"
+
+#include <QFile>
+
+#include "PhysicsLogging.h"
+
+using File = cache::File;
+using FilePointer = cache::FilePointer;
+
+const std::string ShapeCache::DIRNAME { "shape_cache" };
+const std::string ShapeCache::EXT { "shape" };
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    initialize();
+}
+
+ShapeCache::~ShapeCache() {
+    stopWriting();
+}
+
+ShapeCache::Key ShapeCache::getKey(const DoubleHashKey& hash) {
+    return QString("%1%2").arg(hash.getHash(), 8, 16, QChar('0')).arg(hash.getHash2(), 8, 16, QChar('0')).toStdString();
+}
+
+QByteArray ShapeCache::readShape(const Key& key) {
+    FilePointer file = getFile(key);
+    if (!file) {
+        return QByteArray();
+    }
+    QFile shapeFile(file->getFilepath().c_str());
+    if (!shapeFile.open(QFile::ReadOnly)) {
+        qCWarning(physics) << "Cannot read the cached shape" << key.c_str();
+        return QByteArray();
+    }
+    return shapeFile.readAll();
+}
+
+void ShapeCache::writeShapeAsync(const Key& key, const QByteArray& data) {
+    writeFileAsync(data, Metadata(key, data.size()), [](const FilePointer& file) {});
+}
+
+std::unique_ptr<File> ShapeCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote shape" << metadata.key.c_str();
+    return std::unique_ptr<File>(new ShapeFile(std::move(metadata), filepath));
+}
+
+ShapeFile::ShapeFile(Metadata&& metadata, const std::string& filepath) :
+    cache::File(std::move(metadata), filepath) {}
@@ -0,0 +1,50 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <QByteArray>
+
+#include <DoubleHashKey.h>
+#include <FileCache.h>
+
+// Keeps the serialized hulls and BVHs of the expensive collision shapes across sessions, by ShapeInfo hash
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    ShapeCache(const std::string& dir, const std::string& ext);
+    ~ShapeCache();
+
+    static Key getKey(const DoubleHashKey& hash);
+
+    /// \return the data of the shape, or an empty array if it is not cached
+    QByteArray readShape(const Key& key);
+    void writeShapeAsync(const Key& key, const QByteArray& data);
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+};
+
+class ShapeFile : public cache::File {
+    Q_OBJECT
+
+protected:
+    friend class ShapeCache;
+
+    ShapeFile(Metadata&& metadata, const std::string& filepath);
+};
+
+#endif // hifi_ShapeCache_h
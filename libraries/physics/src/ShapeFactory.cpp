@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QDataStream>
+
 #include <glm/gtx/norm.hpp>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
@@ -70,7 +72,6 @@ static const btVector3 _unitSphereDirections[NUM_UNIT_SPHERE_DIRECTIONS] = {
 btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
     assert(points.size() > 0);
 
-    btConvexHullShape* hull = new btConvexHullShape();
     glm::vec3 center = points[0];
     glm::vec3 maxCorner = center;
     glm::vec3 minCorner = center;
@@ -81,7 +82,7 @@ btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
     }
     center /= (float)(points.size());
 
-    float margin = hull->getMargin();
+    float margin = CONVEX_DISTANCE_MARGIN;
 
     // Bullet puts "margins" around all the collision shapes.  This can cause objects that use ConvexHull shapes
     // to have visible gaps between them and the surface they touch.  One option is to reduce the size of the margin
@@ -104,34 +105,26 @@ btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
         smallestDimension = MIN_DIMENSION;
     }
     margin = glm::min(glm::max(0.5f * smallestDimension, MIN_MARGIN), margin);
-    hull->setMargin(margin);
 
-    // add the points, correcting for margin
+    // correct the points for margin
+    uint32_t numPoints = (uint32_t)points.size();
     glm::vec3 relativeScale = (diagonal - glm::vec3(2.0f * margin)) / diagonal;
-    glm::vec3 correctedPoint;
-    for (int i = 0; i < points.size(); ++i) {
-        correctedPoint = (points[i] - center) * relativeScale + center;
-        hull->addPoint(btVector3(correctedPoint[0], correctedPoint[1], correctedPoint[2]), false);
+    btAlignedObjectArray<btVector3> correctedPoints;
+    correctedPoints.resize(numPoints);
+    for (uint32_t i = 0; i < numPoints; ++i) {
+        correctedPoints[i] = glmToBullet((points[i] - center) * relativeScale + center);
     }
 
-    uint32_t numPoints = (uint32_t)hull->getNumPoints();
+    btConvexHullShape* hull = nullptr;
     if (numPoints > MAX_HULL_POINTS) {
         // we have too many points, so we compute point projections along canonical unit vectors
-        // and keep the those that project the farthest
-        btVector3 btCenter = glmToBullet(center);
-        btVector3* shapePoints = hull->getUnscaledPoints();
+        // and keep the those that project the farthest (the center doesn't change which one that is)
         std::vector<uint32_t> finalIndices;
         finalIndices.reserve(NUM_UNIT_SPHERE_DIRECTIONS);
         for (uint32_t i = 0; i < NUM_UNIT_SPHERE_DIRECTIONS; ++i) {
-            uint32_t bestIndex = 0;
-            btScalar maxDistance = _unitSphereDirections[i].dot(shapePoints[0] - btCenter);
-            for (uint32_t j = 1; j < numPoints; ++j) {
-                btScalar distance = _unitSphereDirections[i].dot(shapePoints[j] - btCenter);
-                if (distance > maxDistance) {
-                    maxDistance = distance;
-                    bestIndex = j;
-                }
-            }
+            // maxDot() scans the points with Bullet's SIMD code where it has some
+            btScalar maxDistance;
+            uint32_t bestIndex = (uint32_t)_unitSphereDirections[i].maxDot(&correctedPoints[0], numPoints, maxDistance);
             bool keep = true;
             for (uint32_t j = 0; j < finalIndices.size(); ++j) {
                 if (finalIndices[j] == bestIndex) {
@@ -144,15 +137,15 @@ btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
             }
         }
 
-        // we cannot copy Bullet shapes so we must create a new one...
-        btConvexHullShape* newHull = new btConvexHullShape();
+        hull = new btConvexHullShape();
         for (uint32_t i = 0; i < finalIndices.size(); ++i) {
-            newHull->addPoint(shapePoints[finalIndices[i]], false);
+            hull->addPoint(correctedPoints[finalIndices[i]], false);
         }
-        // ...and delete the old one
-        delete hull;
-        hull = newHull;
+    } else {
+        // copies all the points at once
+        hull = new btConvexHullShape(&correctedPoints[0].getX(), numPoints, sizeof(btVector3));
     }
+    hull->setMargin(margin);
 
     hull->recalcLocalAabb();
     return hull;
@@ -414,13 +407,177 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+// The serialized shapes are trees of hulls, compounds and static meshes, with the points and margins of the
+// hulls as they were built and the BVHs of the meshes (their triangles are cheap to copy again from the info)
+static const quint32 SERIALIZED_SHAPE_VERSION = 1;
+enum SerializedShapeType : quint32 {
+    SERIALIZED_HULL = 0,
+    SERIALIZED_COMPOUND,
+    SERIALIZED_STATIC_MESH
+};
+static const int BVH_ALIGNMENT = 16;
+
+static bool writeShape(QDataStream& stream, const btCollisionShape* shape) {
+    switch (shape->getShapeType()) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            auto hull = static_cast<const btConvexHullShape*>(shape);
+            stream << (quint32)SERIALIZED_HULL << (float)hull->getMargin() << (quint32)hull->getNumPoints();
+            const btVector3* points = hull->getUnscaledPoints();
+            for (int i = 0; i < hull->getNumPoints(); ++i) {
+                stream << (float)points[i].x() << (float)points[i].y() << (float)points[i].z();
+            }
+            return true;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            auto compound = static_cast<const btCompoundShape*>(shape);
+            stream << (quint32)SERIALIZED_COMPOUND << (quint32)compound->getNumChildShapes();
+            for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+                const btTransform& transform = compound->getChildTransform(i);
+                btVector3 origin = transform.getOrigin();
+                btQuaternion rotation = transform.getRotation();
+                stream << (float)origin.x() << (float)origin.y() << (float)origin.z();
+                stream << (float)rotation.x() << (float)rotation.y() << (float)rotation.z() << (float)rotation.w();
+                if (!writeShape(stream, compound->getChildShape(i))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            auto mesh = static_cast<const btBvhTriangleMeshShape*>(shape);
+            btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(mesh)->getOptimizedBvh();
+            if (!bvh) {
+                return false;
+            }
+            unsigned int size = bvh->calculateSerializeBufferSize();
+            void* buffer = btAlignedAlloc(size, BVH_ALIGNMENT);
+            bool serialized = bvh->serializeInPlace(buffer, size, false);
+            if (serialized) {
+                stream << (quint32)SERIALIZED_STATIC_MESH << (quint32)size;
+                stream.writeRawData(static_cast<const char*>(buffer), (int)size);
+            }
+            btAlignedFree(buffer);
+            return serialized;
+        }
+        default:
+            return false;
+    }
+}
+
+static btCollisionShape* readShape(QDataStream& stream, const ShapeInfo& info) {
+    quint32 type;
+    stream >> type;
+    switch (type) {
+        case SERIALIZED_HULL: {
+            float margin;
+            quint32 numPoints;
+            stream >> margin >> numPoints;
+            if (stream.status() != QDataStream::Ok || numPoints == 0 || numPoints > (quint32)MAX_HULL_POINTS) {
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(margin);
+            for (quint32 i = 0; i < numPoints; ++i) {
+                float x, y, z;
+                stream >> x >> y >> z;
+                hull->addPoint(btVector3(x, y, z), false);
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case SERIALIZED_COMPOUND: {
+            quint32 numChildren;
+            stream >> numChildren;
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            auto compound = new btCompoundShape();
+            for (quint32 i = 0; i < numChildren; ++i) {
+                float x, y, z, w;
+                btTransform transform;
+                stream >> x >> y >> z;
+                transform.setOrigin(btVector3(x, y, z));
+                stream >> x >> y >> z >> w;
+                transform.setRotation(btQuaternion(x, y, z, w));
+                btCollisionShape* child = readShape(stream, info);
+                if (!child) {
+                    ShapeFactory::deleteShape(compound);
+                    return nullptr;
+                }
+                compound->addChildShape(transform, child);
+            }
+            return compound;
+        }
+        case SERIALIZED_STATIC_MESH: {
+            quint32 size;
+            stream >> size;
+            if (stream.status() != QDataStream::Ok || info.getType() != SHAPE_TYPE_STATIC_MESH) {
+                return nullptr;
+            }
+            void* buffer = btAlignedAlloc(size, BVH_ALIGNMENT);
+            btOptimizedBvh* bvh = nullptr;
+            if (stream.readRawData(static_cast<char*>(buffer), (int)size) == (int)size) {
+                bvh = btOptimizedBvh::deSerializeInPlace(buffer, size, false);
+            }
+            btTriangleIndexVertexArray* dataArray = bvh ? createStaticMeshArray(info) : nullptr;
+            if (!dataArray) {
+                btAlignedFree(buffer);
+                return nullptr;
+            }
+            return new ShapeFactory::StaticMeshShape(dataArray, bvh, buffer);
+        }
+        default:
+            return nullptr;
+    }
+}
+
+QByteArray ShapeFactory::serializeShape(const btCollisionShape* shape) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << SERIALIZED_SHAPE_VERSION;
+    if (!writeShape(stream, shape)) {
+        return QByteArray();
+    }
+    return data;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromData(const ShapeInfo& info, const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 version;
+    stream >> version;
+    if (version != SERIALIZED_SHAPE_VERSION) {
+        return nullptr;
+    }
+    btCollisionShape* shape = readShape(stream, info);
+    if (shape && stream.status() != QDataStream::Ok) {
+        // truncated
+        deleteShape(shape);
+        return nullptr;
+    }
+    return shape;
+}
+
 // the dataArray must be created before we create the StaticMeshShape
 ShapeFactory::StaticMeshShape::StaticMeshShape(btTriangleIndexVertexArray* dataArray)
 :   btBvhTriangleMeshShape(dataArray, true), _dataArray(dataArray) {
     assert(dataArray);
 }
 
+ShapeFactory::StaticMeshShape::StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+:   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+    assert(dataArray);
+    setOptimizedBvh(bvh);
+}
+
 ShapeFactory::StaticMeshShape::~StaticMeshShape() {
     deleteStaticMeshArray(_dataArray);
     _dataArray = nullptr;
+    if (_bvhBuffer) {
+        // the BVH does not own it
+        getOptimizedBvh()->~btOptimizedBvh();
+        btAlignedFree(_bvhBuffer);
+        _bvhBuffer = nullptr;
+    }
 }
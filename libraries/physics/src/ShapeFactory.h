@@ -12,6 +12,8 @@
 #ifndef hifi_ShapeFactory_h
 #define hifi_ShapeFactory_h
 
+#include <QByteArray>
+
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 
@@ -23,6 +25,11 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // saves the built hulls and BVHs of a shape made from the info, empty for the shapes that cannot be saved
+    QByteArray serializeShape(const btCollisionShape* shape);
+    // \return the shape saved by serializeShape(), or nullptr when the data does not fit the info
+    const btCollisionShape* createShapeFromData(const ShapeInfo& info, const QByteArray& data);
+
     //btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info);
     //void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray);
 
@@ -30,11 +37,14 @@ namespace ShapeFactory {
     public:
         StaticMeshShape() = delete;
         StaticMeshShape(btTriangleIndexVertexArray* dataArray);
+        // uses the BVH deserialized in place in the buffer, which must be allocated with btAlignedAlloc
+        StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer);
         ~StaticMeshShape();
 
     private:
         // the StaticMeshShape owns its vertex/index data
         btTriangleIndexVertexArray* _dataArray;
+        void* _bvhBuffer { nullptr };
     };
 };
 
@@ -13,13 +13,64 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include "ShapeCache.h"
 #include "ShapeFactory.h"
 #include "ShapeManager.h"
 
+static bool canMakeShape(const ShapeInfo& info) {
+    if (info.getType() == SHAPE_TYPE_NONE) {
+        return false;
+    }
+    const float MIN_SHAPE_DIAGONAL_SQUARED = 3.0e-4f; // 1 cm cube
+    if (4.0f * glm::length2(info.getHalfExtents()) < MIN_SHAPE_DIAGONAL_SQUARED) {
+        // tiny shapes are not supported
+        // qCDebug(physics) << "ShapeManager::getShape -- not making shape due to size" << diagonal;
+        return false;
+    }
+    return true;
+}
+
+class ShapeManager::ShapeBuilder : public QRunnable {
+public:
+    ShapeBuilder(ShapeManager* manager, const DoubleHashKey& key, const ShapeInfo& info) :
+        _manager(manager), _key(key), _info(info), _cache(manager->_shapeCache) {}
+
+    void run() override {
+        const btCollisionShape* shape = nullptr;
+        ShapeCache::Key cacheKey;
+        if (_cache) {
+            cacheKey = ShapeCache::getKey(_key);
+            QByteArray data = _cache->readShape(cacheKey);
+            if (!data.isEmpty()) {
+                shape = ShapeFactory::createShapeFromData(_info, data);
+            }
+        }
+        if (!shape) {
+            shape = ShapeFactory::createShapeFromInfo(_info);
+            if (shape && _cache) {
+                QByteArray data = ShapeFactory::serializeShape(shape);
+                if (!data.isEmpty()) {
+                    _cache->writeShapeAsync(cacheKey, data);
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(_manager->_builtShapesMutex);
+        _manager->_builtShapes.push_back({ _key, shape });
+    }
+
+private:
+    ShapeManager* _manager;
+    DoubleHashKey _key;
+    ShapeInfo _info;
+    std::shared_ptr<ShapeCache> _cache;
+};
+
 ShapeManager::ShapeManager() {
 }
 
 ShapeManager::~ShapeManager() {
+    _shapeBuilders.waitForDone();
+    handleBuiltShapes();
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
@@ -29,13 +80,7 @@ ShapeManager::~ShapeManager() {
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
-    if (info.getType() == SHAPE_TYPE_NONE) {
-        return nullptr;
-    }
-    const float MIN_SHAPE_DIAGONAL_SQUARED = 3.0e-4f; // 1 cm cube
-    if (4.0f * glm::length2(info.getHalfExtents()) < MIN_SHAPE_DIAGONAL_SQUARED) {
-        // tiny shapes are not supported
-        // qCDebug(physics) << "ShapeManager::getShape -- not making shape due to size" << diagonal;
+    if (!canMakeShape(info)) {
         return nullptr;
     }
 
@@ -47,15 +92,68 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     }
     const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
     if (shape) {
-        ShapeReference newRef;
-        newRef.refCount = 1;
-        newRef.shape = shape;
-        newRef.key = key;
-        _shapeMap.insert(key, newRef);
+        addShapeRef(key, shape, 1);
     }
     return shape;
 }
 
+const btCollisionShape* ShapeManager::requestShape(const ShapeInfo& info) {
+    ShapeType type = info.getType();
+    if (type != SHAPE_TYPE_HULL && type != SHAPE_TYPE_COMPOUND && type != SHAPE_TYPE_SIMPLE_HULL &&
+            type != SHAPE_TYPE_SIMPLE_COMPOUND && type != SHAPE_TYPE_STATIC_MESH) {
+        // the primitives are cheap enough to build right away
+        return getShape(info);
+    }
+    if (!canMakeShape(info)) {
+        return nullptr;
+    }
+
+    handleBuiltShapes();
+    DoubleHashKey key = info.getHash();
+    ShapeReference* shapeRef = _shapeMap.find(key);
+    if (shapeRef) {
+        shapeRef->refCount++;
+        return shapeRef->shape;
+    }
+    if (!_pendingShapes.find(key)) {
+        _pendingShapes.insert(key, true);
+        _shapeBuilders.start(new ShapeBuilder(this, key, info));
+    }
+    return nullptr;
+}
+
+void ShapeManager::addShapeRef(const DoubleHashKey& key, const btCollisionShape* shape, int refCount) {
+    ShapeReference newRef;
+    newRef.refCount = refCount;
+    newRef.shape = shape;
+    newRef.key = key;
+    _shapeMap.insert(key, newRef);
+}
+
+void ShapeManager::handleBuiltShapes() {
+    std::vector<std::pair<DoubleHashKey, const btCollisionShape*>> builtShapes;
+    {
+        std::lock_guard<std::mutex> lock(_builtShapesMutex);
+        builtShapes.swap(_builtShapes);
+    }
+    for (auto& builtShape : builtShapes) {
+        const DoubleHashKey& key = builtShape.first;
+        const btCollisionShape* shape = builtShape.second;
+        _pendingShapes.remove(key);
+        if (!shape) {
+            continue;
+        }
+        if (_shapeMap.find(key)) {
+            // getShape() built it meanwhile
+            ShapeFactory::deleteShape(shape);
+            continue;
+        }
+        // unreferenced until requested again, which also lets an abandoned shape be collected
+        addShapeRef(key, shape, 0);
+        _pendingGarbage.push_back(key);
+    }
+}
+
 // private helper method
 bool ShapeManager::releaseShapeByKey(const DoubleHashKey& key) {
     ShapeReference* shapeRef = _shapeMap.find(key);
@@ -12,6 +12,11 @@
 #ifndef hifi_ShapeManager_h
 #define hifi_ShapeManager_h
 
+#include <mutex>
+#include <vector>
+
+#include <QThreadPool>
+
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
@@ -19,6 +24,8 @@
 
 #include "DoubleHashKey.h"
 
+class ShapeCache;
+
 class ShapeManager {
 public:
 
@@ -28,6 +35,13 @@ public:
     /// \return pointer to shape
     const btCollisionShape* getShape(const ShapeInfo& info);
 
+    /// Same as getShape() except that hulls and static meshes are built on a worker thread
+    /// \return pointer to shape, or nullptr while it is being built: request it again later to pick it up
+    const btCollisionShape* requestShape(const ShapeInfo& info);
+
+    /// the workers of requestShape() load the shapes from the cache, and save those they build
+    void setShapeCache(const std::shared_ptr<ShapeCache>& cache) { _shapeCache = cache; }
+
     /// \return true if shape was found and released
     bool releaseShape(const btCollisionShape* shape);
 
@@ -36,12 +50,17 @@ public:
 
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
+    int getNumPendingShapes() const { return _pendingShapes.size(); }
     int getNumReferences(const ShapeInfo& info) const;
     int getNumReferences(const btCollisionShape* shape) const;
     bool hasShape(const btCollisionShape* shape) const;
 
 private:
+    class ShapeBuilder;
+
     bool releaseShapeByKey(const DoubleHashKey& key);
+    void addShapeRef(const DoubleHashKey& key, const btCollisionShape* shape, int refCount);
+    void handleBuiltShapes();
 
     class ShapeReference {
     public:
@@ -53,6 +72,13 @@ private:
 
     btHashMap<DoubleHashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<DoubleHashKey> _pendingGarbage;
+
+    // the shapes handed to the workers, and those they finished but that were not added to the map yet
+    btHashMap<DoubleHashKey, bool> _pendingShapes;
+    std::mutex _builtShapesMutex;
+    std::vector<std::pair<DoubleHashKey, const btCollisionShape*>> _builtShapes;
+    QThreadPool _shapeBuilders;
+    std::shared_ptr<ShapeCache> _shapeCache;
 };
 
 #endif // hifi_ShapeManager_h
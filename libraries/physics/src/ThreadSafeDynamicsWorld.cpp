@@ -19,6 +19,15 @@
 
 #include "ThreadSafeDynamicsWorld.h"
 
+#ifdef HIFI_BULLET_MULTITHREADED
+ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
+        btDispatcher* dispatcher,
+        btBroadphaseInterface* pairCache,
+        btConstraintSolverPoolMt* constraintSolverPool,
+        btCollisionConfiguration* collisionConfiguration)
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, constraintSolverPool, nullptr, collisionConfiguration) {
+}
+#else
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -26,6 +35,7 @@ ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btCollisionConfiguration* collisionConfiguration)
     :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
 }
+#endif
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
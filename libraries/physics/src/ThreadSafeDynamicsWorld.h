@@ -18,24 +18,43 @@
 #ifndef hifi_ThreadSafeDynamicsWorld_h
 #define hifi_ThreadSafeDynamicsWorld_h
 
+#include <LinearMath/btScalar.h>
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 
+// With a Bullet built with BT_THREADSAFE (see BULLET_THREADSAFE in TargetBullet.cmake), the world runs the
+// narrowphase, island solving and integration in parallel on the Bullet task scheduler
+#if defined(BT_THREADSAFE) && BT_BULLET_VERSION >= 288
+#define HIFI_BULLET_MULTITHREADED
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+using DiscreteDynamicsWorld = btDiscreteDynamicsWorldMt;
+#else
+using DiscreteDynamicsWorld = btDiscreteDynamicsWorld;
+#endif
+
 #include "ObjectMotionState.h"
 
 #include <functional>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public DiscreteDynamicsWorld {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
+#ifdef HIFI_BULLET_MULTITHREADED
+    ThreadSafeDynamicsWorld(
+            btDispatcher* dispatcher,
+            btBroadphaseInterface* pairCache,
+            btConstraintSolverPoolMt* constraintSolverPool,
+            btCollisionConfiguration* collisionConfiguration);
+#else
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+#endif
 
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
                                           btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
@@ -10,12 +10,36 @@
 //
 #pragma once
 
+#include <string.h>
+
+#include <QByteArray>
+
 #include "Plugin.h"
 
 class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // encode into caller-owned memory, returning the encoded size (or -1 if it exceeds maxEncodedSize)
+    // the default goes through encode, above; codecs that can encode in place should override it to avoid allocating
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) {
+        QByteArray encoded;
+        encode(QByteArray::fromRawData(decodedBuffer, decodedSize), encoded);
+        if (encoded.size() > maxEncodedSize) {
+            return -1;
+        }
+        memcpy(encodedBuffer, encoded.constData(), encoded.size());
+        return encoded.size();
+    }
+
+    // true when the frame last encoded is one the decoder fills in by itself (discontinuous transmission),
+    // so that a silent packet can be sent in its place
+    virtual bool isDiscontinuous() const { return false; }
+
+    // cap the bitrate of the encoded stream, in bits per second, when the receiver can't take the codec's own;
+    // codecs of a fixed bitrate ignore it
+    virtual void setMaxBitrate(int bitsPerSecond) { }
 };
 
 class Decoder {
@@ -24,6 +48,9 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
     virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+
+    // the frame lost just before nextEncodedBuffer, recovered from the redundancy it carries for codecs that send some
+    virtual void recoverLostFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) { lostFrame(decodedBuffer); }
 };
 
 class CodecPlugin : public Plugin {
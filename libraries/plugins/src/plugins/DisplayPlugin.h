@@ -93,6 +93,10 @@ public:
         return glm::mat4();
     }
 
+    // The radius of the region around the gaze shaded at the full rate, in the clip space of the eye projections.
+    // Beyond it the lighting is shaded at a lower rate, 0 to shade the whole frame at the full rate
+    virtual float getFoveationRadius() const { return 0.0f; }
+
     virtual void abandonCalibration() {}
 
     virtual void resetSensors() {}
@@ -141,6 +145,8 @@ public:
     virtual bool isThrottled() const { return false; }
     virtual float getTargetFrameRate() const { return 1.0f; }
     virtual bool hasAsyncReprojection() const { return false; }
+    /// Tiled mobile GPUs, as in the standalone HMDs, can't afford the deferred G-buffer
+    virtual bool isForwardRendered() const { return false; }
 
     /// Returns a boolean value indicating whether the display is currently visible 
     /// to the user.  For monitor displays, false might indicate that a screensaver,
@@ -200,6 +206,14 @@ public:
     virtual float newFramePresentRate() const { return -1.0f; }
     // Rate at which rendered frames are being skipped
     virtual float droppedFrameRate() const { return -1.0f; }
+    // Average time from the sampling of the pose a new frame is rendered with to its present, in milliseconds
+    virtual float poseToPhotonLatency() const { return -1.0f; }
+    // Same as above for the pose latched right before the frame is executed, when the plugin late-latches it
+    virtual float latchedPoseToPhotonLatency() const { return -1.0f; }
+
+    // How long to wait after a present before starting the next frame, so that it starts as late as it can and still
+    // makes the next present
+    virtual int64_t getFrameStartDelayUsecs() const { return 0; }
     
     // Hardware specific stats
     virtual QJsonObject getHardwareStats() const { return QJsonObject(); }
@@ -7,11 +7,13 @@
 //
 #include "PluginManager.h"
 
+#include <map>
 #include <mutex>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
 #include <QtCore/QPluginLoader>
 
 #include <DependencyManager.h>
@@ -76,9 +78,10 @@ bool isDisabled(QJsonObject metaData) {
 using Loader = QSharedPointer<QPluginLoader>;
 using LoaderList = QList<Loader>;
 
-const LoaderList& getLoadedPlugins() {
+// the plugin libraries found, reading their metadata doesn't load them
+const LoaderList& getPluginLoaders() {
     static std::once_flag once;
-    static LoaderList loadedPlugins;
+    static LoaderList pluginLoaders;
     std::call_once(once, [&] {
 #ifdef Q_OS_MAC
         QString pluginPath = QCoreApplication::applicationDirPath() + "/../PlugIns/";
@@ -89,34 +92,74 @@ const LoaderList& getLoadedPlugins() {
         pluginDir.setSorting(QDir::Name);
         pluginDir.setFilter(QDir::Files);
         if (pluginDir.exists()) {
-            qInfo() << "Loading runtime plugins from " << pluginPath;
-            auto candidates = pluginDir.entryList();
-            for (auto plugin : candidates) {
-                qCDebug(plugins) << "Attempting plugin" << qPrintable(plugin);
-                QSharedPointer<QPluginLoader> loader(new QPluginLoader(pluginPath + plugin));
-
-                if (isDisabled(loader->metaData())) {
-                    qWarning() << "Plugin" << qPrintable(plugin) << "is disabled";
-                    // Skip this one, it's disabled
-                    continue;
-                }
-
-                if (loader->load()) {
-                    qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "loaded successfully";
-                    loadedPlugins.push_back(loader);
-                } else {
-                    qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "failed to load:";
-                    qCDebug(plugins) << " " << qPrintable(loader->errorString());
-                }
+            qInfo() << "Found runtime plugins in " << pluginPath;
+            for (auto plugin : pluginDir.entryList()) {
+                Loader loader(new QPluginLoader(pluginPath + plugin));
+                // read once here rather than from each thread loading a type of plugins
+                loader->metaData();
+                pluginLoaders.push_back(loader);
             }
         }
     });
-    return loadedPlugins;
+    return pluginLoaders;
+}
+
+static void loadPlugins(const QString& providerIID, LoaderList& providerPlugins) {
+    for (auto loader : getPluginLoaders()) {
+        if (getPluginIIDFromMetaData(loader->metaData()) != providerIID) {
+            continue;
+        }
+
+        QString plugin = QFileInfo(loader->fileName()).fileName();
+        qCDebug(plugins) << "Attempting plugin" << qPrintable(plugin);
+
+        if (isDisabled(loader->metaData())) {
+            qWarning() << "Plugin" << qPrintable(plugin) << "is disabled";
+            // Skip this one, it's disabled
+            continue;
+        }
+
+        if (loader->load()) {
+            qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "loaded successfully";
+            providerPlugins.push_back(loader);
+        } else {
+            qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "failed to load:";
+            qCDebug(plugins) << " " << qPrintable(loader->errorString());
+        }
+    }
+}
+
+// loads the plugins of one provider type the first time they are asked for, so that a process which only needs
+// codecs (like the assignment-client) doesn't load the display and input plugins and their SDKs
+// the types load independently, a thread asking for one type doesn't wait for another thread loading another type
+const LoaderList& getLoadedPlugins(const QString& providerIID) {
+    struct LoadedPlugins {
+        std::once_flag once;
+        LoaderList loaders;
+    };
+    static std::mutex mutex;
+    static std::map<QString, LoadedPlugins> loadedPlugins;
+
+    LoadedPlugins* providerLoadedPlugins;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        providerLoadedPlugins = &loadedPlugins[providerIID];
+    }
+    std::call_once(providerLoadedPlugins->once, [&] {
+        loadPlugins(providerIID, providerLoadedPlugins->loaders);
+    });
+    return providerLoadedPlugins->loaders;
 }
 
 PluginManager::PluginManager() {
 }
 
+void PluginManager::loadPluginLibraries() {
+    getLoadedPlugins(CodecProvider_iid);
+    getLoadedPlugins(InputProvider_iid);
+    getLoadedPlugins(DisplayProvider_iid);
+}
+
 extern CodecPluginList getCodecPlugins();
 
 const CodecPluginList& PluginManager::getCodecPlugins() {
@@ -124,7 +167,7 @@ const CodecPluginList& PluginManager::getCodecPlugins() {
     static std::once_flag once;
     std::call_once(once, [&] {
         // Now grab the dynamic plugins
-        for (auto loader : getLoadedPlugins()) {
+        for (auto loader : getLoadedPlugins(CodecProvider_iid)) {
             CodecProvider* codecProvider = qobject_cast<CodecProvider*>(loader->instance());
             if (codecProvider) {
                 for (auto codecPlugin : codecProvider->getCodecPlugins()) {
@@ -150,7 +193,7 @@ const SteamClientPluginPointer PluginManager::getSteamClientPlugin() {
     static std::once_flag once;
     std::call_once(once, [&] {
         // Now grab the dynamic plugins
-        for (auto loader : getLoadedPlugins()) {
+        for (auto loader : getLoadedPlugins(SteamClientProvider_iid)) {
             SteamClientProvider* steamClientProvider = qobject_cast<SteamClientProvider*>(loader->instance());
             if (steamClientProvider) {
                 steamClientPlugin = steamClientProvider->getSteamClientPlugin();
@@ -187,7 +230,7 @@ const DisplayPluginList& PluginManager::getDisplayPlugins() {
 
 
         // Now grab the dynamic plugins
-        for (auto loader : getLoadedPlugins()) {
+        for (auto loader : getLoadedPlugins(DisplayProvider_iid)) {
             DisplayProvider* displayProvider = qobject_cast<DisplayProvider*>(loader->instance());
             if (displayProvider) {
                 for (auto displayPlugin : displayProvider->getDisplayPlugins()) {
@@ -232,7 +275,7 @@ const InputPluginList& PluginManager::getInputPlugins() {
         inputPlugins = ::getInputPlugins();
 
         // Now grab the dynamic plugins
-        for (auto loader : getLoadedPlugins()) {
+        for (auto loader : getLoadedPlugins(InputProvider_iid)) {
             InputProvider* inputProvider = qobject_cast<InputProvider*>(loader->instance());
             if (inputProvider) {
                 for (auto inputPlugin : inputProvider->getInputPlugins()) {
@@ -304,13 +347,14 @@ void PluginManager::shutdown() {
         }
     }
 
-    auto loadedPlugins = getLoadedPlugins();
     // Now grab the dynamic plugins
-    for (auto loader : getLoadedPlugins()) {
+    for (auto loader : getLoadedPlugins(InputProvider_iid)) {
         InputProvider* inputProvider = qobject_cast<InputProvider*>(loader->instance());
         if (inputProvider) {
             inputProvider->destroyInputPlugins();
         }
+    }
+    for (auto loader : getLoadedPlugins(DisplayProvider_iid)) {
         DisplayProvider* displayProvider = qobject_cast<DisplayProvider*>(loader->instance());
         if (displayProvider) {
             displayProvider->destroyDisplayPlugins();
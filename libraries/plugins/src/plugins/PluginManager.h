@@ -16,6 +16,10 @@ public:
     static PluginManager* getInstance();
     PluginManager();
 
+    /// loads the libraries of the codec, input and display plugins without creating the plugins, which happens on
+    /// the thread that first asks for them, so that the libraries can load on another thread while the process starts
+    void loadPluginLibraries();
+
     const DisplayPluginList& getDisplayPlugins();
     const InputPluginList& getInputPlugins();
     const CodecPluginList& getCodecPlugins();
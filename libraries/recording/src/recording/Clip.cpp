@@ -19,6 +19,9 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
 
+#include <algorithm>
+#include <vector>
+
 using namespace recording;
 
 Clip::Pointer Clip::fromFile(const QString& filePath) {
@@ -54,8 +57,17 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
+static_assert(sizeof(Clip::IndexEntry) == 16, "the index entries are written as they are laid out");
+static_assert(sizeof(Clip::IndexFooter) == 16, "the index footer is written as it is laid out");
+
+// the most index entries a frame of the index holds
+static const size_t MAX_INDEX_FRAME_ENTRIES = std::numeric_limits<FrameSize>::max() / sizeof(Clip::IndexEntry);
+
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true, FrameSize* writtenSize = nullptr) {
+    if (writtenSize) {
+        *writtenSize = 0;
+    }
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
@@ -87,11 +99,15 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
             return false;
         }
     }
+    if (writtenSize) {
+        *writtenSize = dataSize;
+    }
     return true;
 }
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const quint32 Clip::INDEX_MAGIC = 0x58444948; // "HIDX"
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -106,16 +122,36 @@ bool Clip::write(QIODevice& output) {
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    FrameSize dataSize;
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false, &dataSize)) {
         return false;
     }
+    quint64 offset = PointerClip::MINIMUM_FRAME_SIZE + dataSize;
 
     seek(0);
 
+    std::vector<IndexEntry> index;
+    index.reserve(frameCount());
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (!writeFrame(output, *frame, true, &dataSize)) {
             return false;
         }
+        if (frame->type != Frame::TYPE_INVALID) {
+            offset += PointerClip::MINIMUM_FRAME_SIZE;
+            index.push_back({ frame->type, dataSize, frame->timeOffset, offset });
+            offset += dataSize;
+        }
     }
-    return true;
+
+    // Nor the index
+    IndexFooter footer { offset, (quint32)index.size(), INDEX_MAGIC };
+    for (size_t i = 0; i < index.size(); i += MAX_INDEX_FRAME_ENTRIES) {
+        size_t count = std::min(MAX_INDEX_FRAME_ENTRIES, index.size() - i);
+        QByteArray indexFrameData(reinterpret_cast<const char*>(&index[i]), (int)(count * sizeof(IndexEntry)));
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, indexFrameData }), false)) {
+            return false;
+        }
+    }
+    QByteArray footerFrameData(reinterpret_cast<const char*>(&footer), sizeof(IndexFooter));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, footerFrameData }), false);
 }
@@ -57,6 +57,24 @@ public:
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
 
+    // The frames of a clip file are followed by a seek index of their headers and data offsets, in TYPE_INDEX frames
+    // which the frame type map of the file never lists, so that older readers skip them. The last frame of the file
+    // holds the footer of the index, and a reader finds all the frames from it without scanning them.
+    struct IndexEntry {
+        FrameType type;
+        FrameSize size;
+        Frame::Time timeOffset;
+        quint64 fileOffset; // of the frame data
+    };
+
+    struct IndexFooter {
+        quint64 indexOffset; // of the first index frame
+        quint32 frameCount; // not counting the header frame
+        quint32 magic;
+    };
+
+    static const quint32 INDEX_MAGIC;
+
 protected:
     friend class WrapperClip;
     using Mutex = std::recursive_mutex;
@@ -8,8 +8,12 @@
 
 #include "Deck.h"
  
+#include <algorithm>
+#include <chrono>
+
 #include <QtCore/QThread>
 
+#include <GenericThread.h>
 #include <NumericalConstants.h>
 #include <SharedUtil.h>
 
@@ -20,9 +24,41 @@
 
 using namespace recording;
 
+namespace recording {
+
+class DeckPlaybackThread : public GenericThread {
+public:
+    DeckPlaybackThread(Deck& deck) : _deck(deck) {
+        setObjectName("Deck Playback");
+    }
+
+    bool process() override {
+        _deck.processFrames();
+        return isStillRunning();
+    }
+
+private:
+    Deck& _deck;
+};
+
+}
+
+const Frame::Time Deck::LATE_FRAME_THRESHOLD = Frame::secondsToFrameTime(0.015f);
+
 Deck::Deck(QObject* parent) 
     : QObject(parent) {}
 
+Deck::~Deck() {
+    if (_playbackThread) {
+        {
+            Locker lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        _playbackThread->terminate();
+    }
+}
+
 void Deck::queueClip(ClipPointer clip, float timeOffset) {
     Locker lock(_mutex);
 
@@ -41,6 +77,7 @@ void Deck::queueClip(ClipPointer clip, float timeOffset) {
     }
 
     _clips.push_back(clip);
+    _scheduleChanged = true;
 
     _length = std::max(_length, clip->duration());
 }
@@ -50,8 +87,14 @@ void Deck::play() {
     if (_pause) {
         _pause = false;
         _startEpoch = Frame::epochForFrameTime(_position);
+        _stats = PlaybackStats();
+        _totalLateness = 0;
+        if (!_playbackThread) {
+            _playbackThread.reset(new DeckPlaybackThread(*this));
+            _playbackThread->initialize(true, QThread::HighPriority);
+        }
         emit playbackStateChanged();
-        processFrames();
+        _wake.notify_all();
     }
 }
 
@@ -63,19 +106,6 @@ void Deck::pause() {
     }
 }
 
-Clip::Pointer Deck::getNextClip() {
-    Clip::Pointer result;
-    auto soonestFramePosition = Frame::INVALID_TIME;
-    for (const auto& clip : _clips) {
-        auto nextFramePosition = clip->positionFrameTime();
-        if (nextFramePosition < soonestFramePosition) {
-            result = clip;
-            soonestFramePosition = nextFramePosition;
-        }
-    }
-    return result;
-}
-
 void Deck::seek(float position) {
     Locker lock(_mutex);
     _position = Frame::secondsToFrameTime(position);
@@ -87,11 +117,16 @@ void Deck::seek(float position) {
     for (auto& clip : _clips) {
         clip->seekFrameTime(_position);
     }
+    _scheduleChanged = true;
+    _endOfClips = false;
+    _queuedFrames.clear();
 
-    if (!_pause) {
-        // FIXME what if the timer is already running?
-        processFrames();
-    }
+    _wake.notify_all();
+}
+
+Deck::PlaybackStats Deck::getPlaybackStats() const {
+    Locker lock(_mutex);
+    return _stats;
 }
 
 float Deck::position() const {
@@ -104,79 +139,127 @@ float Deck::position() const {
 }
 
 static const Frame::Time MIN_FRAME_WAIT_INTERVAL = Frame::secondsToFrameTime(0.001f);
-static const Frame::Time MAX_FRAME_PROCESSING_TIME = Frame::secondsToFrameTime(0.004f);
 
-void Deck::processFrames() {
-    if (qApp->thread() != QThread::currentThread()) {
-        qWarning() << "Processing frames must only happen on the main thread.";
-        return;
+void Deck::rebuildSchedule() {
+    _schedule.clear();
+    for (const auto& clip : _clips) {
+        auto frameTime = clip->positionFrameTime();
+        if (frameTime != Frame::INVALID_TIME) {
+            _schedule.push_back({ frameTime, clip });
+        }
     }
-    Locker lock(_mutex);
-    if (_pause) {
-        return;
+    std::make_heap(_schedule.begin(), _schedule.end(), isLaterFrame);
+    _scheduleChanged = false;
+}
+
+void Deck::recordLateness(Frame::Time position, Frame::Time frameTime) {
+    Frame::Time lateness = position > frameTime ? position - frameTime : 0;
+    _stats.framesPlayed++;
+    if (lateness > LATE_FRAME_THRESHOLD) {
+        _stats.lateFrames++;
     }
+    _stats.maxLateness = std::max(_stats.maxLateness, lateness);
+    _totalLateness += lateness;
+    _stats.averageLateness = (float)_totalLateness / (float)_stats.framesPlayed;
+}
 
-    auto startingPosition = Frame::frameTimeFromEpoch(_startEpoch);
-    auto triggerPosition = startingPosition + MIN_FRAME_WAIT_INTERVAL;
-    Clip::Pointer nextClip;
-    // FIXME add code to start dropping frames if we fall behind.
-    // Alternatively, add code to cache frames here and then process only the last frame of a given type
-    // ... the latter will work for Avatar, but not well for audio I suspect.
-    bool overLimit = false;
-    for (nextClip = getNextClip(); nextClip; nextClip = getNextClip()) {
-        auto currentPosition = Frame::frameTimeFromEpoch(_startEpoch);
-        if ((currentPosition - startingPosition) >= MAX_FRAME_PROCESSING_TIME) {
-            qCWarning(recordingLog) << "Exceeded maximum frame processing time, breaking early";
-#ifdef WANT_RECORDING_DEBUG            
-            qCDebug(recordingLog) << "Starting: " << currentPosition;
-            qCDebug(recordingLog) << "Current:  " << startingPosition;
-            qCDebug(recordingLog) << "Trigger:  " << triggerPosition;
-#endif
-            overLimit = true;
-            break;
+void Deck::processFrames() {
+    std::vector<FrameConstPointer> frames;
+    {
+        Locker lock(_mutex);
+        if (_stopping) {
+            return;
+        }
+        if (_pause || _endOfClips) {
+            _wake.wait(lock);
+            return;
+        }
+        if (_scheduleChanged) {
+            rebuildSchedule();
         }
 
-        // If the clip is too far in the future, just break out of the handling loop
-        Frame::Time framePosition = nextClip->positionFrameTime();
-        if (framePosition > triggerPosition) {
-            break;
+        // take the frames due, from all the clips in the order of their time
+        auto currentPosition = Frame::frameTimeFromEpoch(_startEpoch);
+        auto triggerPosition = currentPosition + MIN_FRAME_WAIT_INTERVAL;
+        bool wasQueueEmpty = _queuedFrames.empty();
+        while (!_schedule.empty() && _schedule.front().frameTime <= triggerPosition) {
+            std::pop_heap(_schedule.begin(), _schedule.end(), isLaterFrame);
+            auto& next = _schedule.back();
+            auto frame = next.clip->nextFrame();
+            if (frame) {
+                if (Frame::isThreadSafeFrameType(frame->type)) {
+                    recordLateness(currentPosition, frame->timeOffset);
+                    frames.push_back(frame);
+                } else {
+                    _queuedFrames.push_back(frame);
+                }
+            }
+            next.frameTime = next.clip->positionFrameTime();
+            if (next.frameTime != Frame::INVALID_TIME) {
+                std::push_heap(_schedule.begin(), _schedule.end(), isLaterFrame);
+            } else {
+                _schedule.pop_back();
+            }
         }
-        // Handle the frame and advance the clip
-        Frame::handleFrame(nextClip->nextFrame());
-    }
-
-    if (!nextClip) {
-        // No more frames available, so handle the end of playback
-        if (_loop) {
-            // If we have looping enabled, start the playback over
-            seek(0);
-            // FIXME configure the recording scripting interface to reset the avatar basis on a loop 
-            // if doing relative movement
-            emit looped();
-        } else {
-            // otherwise stop playback
-            stop();
+        if (wasQueueEmpty && !_queuedFrames.empty()) {
+            QMetaObject::invokeMethod(this, "deliverFrames", Qt::QueuedConnection);
         }
+        _position = currentPosition;
+
+        if (_schedule.empty()) {
+            // handle the end of playback, after the frames queued so far
+            _endOfClips = true;
+            QMetaObject::invokeMethod(this, "handleEndOfClips", Qt::QueuedConnection);
+        } else if (frames.empty()) {
+            // sleep until the next frame, or until the playback changes
+            quint64 nextFrameEpoch = _startEpoch + (quint64)_schedule.front().frameTime * USECS_PER_MSEC;
+            quint64 now = usecTimestampNow();
+            if (nextFrameEpoch > now) {
+                _wake.wait_for(lock, std::chrono::microseconds(nextFrameEpoch - now));
+            }
+            return;
+        }
+    }
+
+    for (const auto& frame : frames) {
+        Frame::handleFrame(frame);
+    }
+}
+
+void Deck::deliverFrames() {
+    std::vector<FrameConstPointer> frames;
+    {
+        Locker lock(_mutex);
+        frames.swap(_queuedFrames);
+        auto currentPosition = Frame::frameTimeFromEpoch(_startEpoch);
+        for (const auto& frame : frames) {
+            recordLateness(currentPosition, frame->timeOffset);
+        }
+    }
+
+    for (const auto& frame : frames) {
+        Frame::handleFrame(frame);
+    }
+}
+
+void Deck::handleEndOfClips() {
+    Locker lock(_mutex);
+    if (!_endOfClips) {
+        // the playback was changed since
         return;
-    } 
-
-    // If we have more clip frames available, set the timer for the next one
-    _position = Frame::frameTimeFromEpoch(_startEpoch);
-    int nextInterval = 1;
-    if (!overLimit) {
-        auto nextFrameTime = nextClip->positionFrameTime();
-        nextInterval = (int)Frame::frameTimeToMilliseconds(nextFrameTime - _position);
-#ifdef WANT_RECORDING_DEBUG
-        qCDebug(recordingLog) << "Now " << _position;
-        qCDebug(recordingLog) << "Next frame time " << nextInterval;
-#endif
-    }
-#ifdef WANT_RECORDING_DEBUG
-    qCDebug(recordingLog) << "Setting timer for next processing " << nextInterval;
-#endif
-    _timer.singleShot(nextInterval, [this] {
-        processFrames();
-    });
+    }
+    _endOfClips = false;
+
+    if (_loop) {
+        // If we have looping enabled, start the playback over
+        seek(0);
+        // FIXME configure the recording scripting interface to reset the avatar basis on a loop
+        // if doing relative movement
+        emit looped();
+    } else {
+        // otherwise stop playback
+        stop();
+    }
 }
 
 void Deck::removeClip(const ClipConstPointer& clip) {
@@ -184,6 +267,7 @@ void Deck::removeClip(const ClipConstPointer& clip) {
     std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& testClip)->bool {
         return (clip == testClip);
     });
+    _scheduleChanged = true;
 }
 
 void Deck::removeClip(const QString& clipName) {
@@ -191,11 +275,13 @@ void Deck::removeClip(const QString& clipName) {
     std::remove_if(_clips.begin(), _clips.end(), [&](const Clip::ConstPointer& clip)->bool {
         return (clip->getName() == clipName);
     });
+    _scheduleChanged = true;
 }
 
 void Deck::removeAllClips() {
     Locker lock(_mutex);
     _clips.clear();
+    _scheduleChanged = true;
 }
 
 Deck::ClipList Deck::getClips(const QString& clipName) const {
@@ -10,12 +10,14 @@
 #ifndef hifi_Recording_Deck_h
 #define hifi_Recording_Deck_h
 
+#include <condition_variable>
 #include <utility>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QObject>
-#include <QtCore/QTimer>
 #include <QtCore/QList>
 
 #include <DependencyManager.h>
@@ -26,13 +28,27 @@
 
 namespace recording {
 
+class DeckPlaybackThread;
+
+// Plays the queued clips on a high priority thread of its own, which wakes at the time of the next frame of the clips. The
+// frames with thread safe handlers are handled on that thread, and the others in batches on the thread owning the deck.
 class Deck : public QObject, public ::Dependency {
     Q_OBJECT
 public:
     using ClipList = std::list<ClipPointer>;
     using Pointer = std::shared_ptr<Deck>;
 
+    // how late the frames were handled, since playback started
+    struct PlaybackStats {
+        quint64 framesPlayed { 0 };
+        quint64 lateFrames { 0 }; // handled more than LATE_FRAME_THRESHOLD after their time
+        float averageLateness { 0.0f }; // msecs
+        Frame::Time maxLateness { 0 };
+    };
+    static const Frame::Time LATE_FRAME_THRESHOLD;
+
     Deck(QObject* parent = nullptr);
+    virtual ~Deck();
 
     // Place a clip on the deck for recording or playback
     void queueClip(ClipPointer clip, float timeOffset = 0.0f);
@@ -57,20 +73,42 @@ public:
     float position() const;
     void seek(float position);
 
+    PlaybackStats getPlaybackStats() const;
+
 signals:
     void playbackStateChanged();
     void looped();
 
 private:
+    friend class DeckPlaybackThread;
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
 
-    ClipPointer getNextClip();
-    void processFrames();
+    struct ScheduledClip {
+        Frame::Time frameTime;
+        ClipPointer clip;
+    };
+    static bool isLaterFrame(const ScheduledClip& a, const ScheduledClip& b) { return a.frameTime > b.frameTime; }
+
+    void processFrames(); // on the playback thread
+    void rebuildSchedule();
+    void recordLateness(Frame::Time position, Frame::Time frameTime);
+    Q_INVOKABLE void deliverFrames();
+    Q_INVOKABLE void handleEndOfClips();
 
     mutable Mutex _mutex;
-    QTimer _timer;
+    std::condition_variable_any _wake;
+    std::unique_ptr<DeckPlaybackThread> _playbackThread;
+    bool _stopping { false };
+
     ClipList _clips;
+    std::vector<ScheduledClip> _schedule; // a min-heap of the clips by the time of their next frame
+    bool _scheduleChanged { true };
+    std::vector<FrameConstPointer> _queuedFrames; // for the handlers which are not thread safe
+    bool _endOfClips { false };
+    PlaybackStats _stats;
+    quint64 _totalLateness { 0 };
+
     quint64 _startEpoch { 0 };
     Frame::Time _position { 0 };
     bool _pause { true };
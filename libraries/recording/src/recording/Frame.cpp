@@ -11,6 +11,7 @@
 #include <mutex>
 
 #include <QtCore/QMap>
+#include <QtCore/QSet>
 
 #include <NumericalConstants.h>
 #include <SharedUtil.h>
@@ -71,6 +72,7 @@ private:
 
 static Registry<FrameType, QString> frameTypes;
 static QMap<FrameType, Frame::Handler> handlerMap;
+static QSet<FrameType> threadSafeHandlers;
 using Mutex = std::mutex;
 using Locker = std::unique_lock<Mutex>;
 static Mutex mutex;
@@ -121,19 +123,29 @@ QMap<FrameType, QString> Frame::getFrameTypeNames() {
     return frameTypes.getValuesByKey();
 }
 
-Frame::Handler Frame::registerFrameHandler(FrameType type, Handler handler) {
+Frame::Handler Frame::registerFrameHandler(FrameType type, Handler handler, bool isThreadSafe) {
     Locker lock(mutex);
     Handler result;
     if (handlerMap.contains(type)) {
         result = handlerMap[type];
     }
     handlerMap[type] = handler;
+    if (isThreadSafe) {
+        threadSafeHandlers.insert(type);
+    } else {
+        threadSafeHandlers.remove(type);
+    }
     return result;
 }
 
-Frame::Handler Frame::registerFrameHandler(const QString& frameTypeName, Handler handler) {
+Frame::Handler Frame::registerFrameHandler(const QString& frameTypeName, Handler handler, bool isThreadSafe) {
     auto frameType = registerFrameType(frameTypeName);
-    return registerFrameHandler(frameType, handler);
+    return registerFrameHandler(frameType, handler, isThreadSafe);
+}
+
+bool Frame::isThreadSafeFrameType(FrameType type) {
+    Locker lock(mutex);
+    return threadSafeHandlers.contains(type);
 }
 
 void Frame::clearFrameHandler(FrameType type) {
@@ -142,6 +154,7 @@ void Frame::clearFrameHandler(FrameType type) {
     if (iterator != handlerMap.end()) {
         handlerMap.erase(iterator);
     }
+    threadSafeHandlers.remove(type);
 }
 
 void Frame::clearFrameHandler(const QString& frameTypeName) {
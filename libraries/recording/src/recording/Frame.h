@@ -36,6 +36,7 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    static const FrameType TYPE_INDEX = 0xFFFD; // the seek index at the end of a clip file, never registered
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
@@ -66,8 +67,10 @@ public:
         : FrameHeader(type, timeOffset), data(data) { }
 
     static FrameType registerFrameType(const QString& frameTypeName);
-    static Handler registerFrameHandler(FrameType type, Handler handler);
-    static Handler registerFrameHandler(const QString& frameTypeName, Handler handler);
+    // a thread safe handler is called on the playback thread of the deck, the others on the thread which owns the deck
+    static Handler registerFrameHandler(FrameType type, Handler handler, bool isThreadSafe = false);
+    static Handler registerFrameHandler(const QString& frameTypeName, Handler handler, bool isThreadSafe = false);
+    static bool isThreadSafeFrameType(FrameType type);
     static void clearFrameHandler(FrameType type);
     static void clearFrameHandler(const QString& frameTypeName);
     static QMap<QString, FrameType> getFrameTypes();
@@ -45,26 +45,34 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
+// Reads the header of the frame at current, and moves current to the next frame
+bool readFrameHeader(uchar* const start, uchar* const end, uchar*& current, PointerFrameHeader& header) {
+    if (end - current < PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    if (end - current < header.size) {
+        current = end;
+        return false;
+    }
+    current += header.size;
+    return true;
+}
+
 PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
     PointerFrameHeaderList results;
     auto current = start;
     auto end = current + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            current = end;
-            break;
-        }
-        current += header.size;
+    PointerFrameHeader header;
+    while (readFrameHeader(start, end, current, header)) {
         results.push_back(header);
     }
     qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
@@ -75,6 +83,74 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+// Reads the frame headers from the index at the end of the data, false for data without a valid index
+bool parseIndex(uchar* const start, const size_t& size, PointerFrameHeaderList& results) {
+    static const size_t FOOTER_FRAME_SIZE = PointerClip::MINIMUM_FRAME_SIZE + sizeof(Clip::IndexFooter);
+    if (size < FOOTER_FRAME_SIZE) {
+        return false;
+    }
+    auto end = start + size;
+    auto indexEnd = end - FOOTER_FRAME_SIZE;
+
+    Clip::IndexFooter footer;
+    {
+        auto current = indexEnd;
+        PointerFrameHeader footerHeader;
+        if (!readFrameHeader(start, end, current, footerHeader) || footerHeader.type != Frame::TYPE_INDEX ||
+                footerHeader.size != sizeof(Clip::IndexFooter)) {
+            return false;
+        }
+        memcpy(&footer, start + footerHeader.fileOffset, sizeof(Clip::IndexFooter));
+        if (footer.magic != Clip::INDEX_MAGIC || footer.indexOffset > (quint64)(indexEnd - start)) {
+            return false;
+        }
+    }
+
+    PointerFrameHeaderList headers;
+    auto fail = [&] {
+        qWarning(recordingLog) << "Invalid frame index, scanning the frames";
+        return false;
+    };
+
+    // The file header frame is not indexed
+    auto current = start;
+    PointerFrameHeader header;
+    if (!readFrameHeader(start, end, current, header)) {
+        return fail();
+    }
+    headers.push_back(header);
+
+    current = start + footer.indexOffset;
+    while (current < indexEnd) {
+        PointerFrameHeader indexHeader;
+        if (!readFrameHeader(start, indexEnd, current, indexHeader) || indexHeader.type != Frame::TYPE_INDEX ||
+                indexHeader.size % sizeof(Clip::IndexEntry) != 0) {
+            return fail();
+        }
+        auto entryData = start + indexHeader.fileOffset;
+        auto entriesEnd = entryData + indexHeader.size;
+        for (; entryData < entriesEnd; entryData += sizeof(Clip::IndexEntry)) {
+            Clip::IndexEntry entry;
+            memcpy(&entry, entryData, sizeof(Clip::IndexEntry));
+            if (entry.fileOffset + entry.size > footer.indexOffset) {
+                return fail();
+            }
+            header.type = entry.type;
+            header.timeOffset = entry.timeOffset;
+            header.size = entry.size;
+            header.fileOffset = entry.fileOffset;
+            headers.push_back(header);
+        }
+    }
+    if (headers.size() != (size_t)footer.frameCount + 1) {
+        return fail();
+    }
+
+    qDebug(recordingLog) << "Read the index of " << footer.frameCount << " frames";
+    results.swap(headers);
+    return true;
+}
+
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
@@ -88,7 +164,11 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    // Files written since the frame index was added open without scanning their frames
+    PointerFrameHeaderList parsedFrameHeaders;
+    if (!parseIndex(data, size, parsedFrameHeaders)) {
+        parsedFrameHeaders = parseFrameHeaders(data, size);
+    }
     // Verify that at least one frame exists and that the first frame is a header
     if (0 == parsedFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
@@ -16,6 +16,7 @@
 
 
 #include <PathUtils.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <gpu/Context.h>
 #include <gpu/StandardShaderLib.h>
@@ -33,6 +34,8 @@
 #include "ssao_debugOcclusion_frag.h"
 #include "ssao_makeHorizontalBlur_frag.h"
 #include "ssao_makeVerticalBlur_frag.h"
+#include "ssao_accumulateOcclusion_frag.h"
+#include "ssao_upsampleOcclusion_frag.h"
 
 
 AmbientOcclusionFramebuffer::AmbientOcclusionFramebuffer() {
@@ -58,11 +61,28 @@ void AmbientOcclusionFramebuffer::updateLinearDepth(const gpu::TexturePointer& l
     }
 }
 
+void AmbientOcclusionFramebuffer::updateUpsampleLinearDepth(const gpu::TexturePointer& fullLinearDepthBuffer) {
+    _upsampleLinearDepthTexture = fullLinearDepthBuffer;
+    if (_upsampleLinearDepthTexture) {
+        auto newFrameSize = glm::ivec2(_upsampleLinearDepthTexture->getDimensions());
+        if (_upsampleFrameSize != newFrameSize) {
+            _upsampleFrameSize = newFrameSize;
+            _occlusionUpsampledFramebuffer.reset();
+            _occlusionUpsampledTexture.reset();
+        }
+    }
+}
+
 void AmbientOcclusionFramebuffer::clear() {
     _occlusionFramebuffer.reset();
     _occlusionTexture.reset();
     _occlusionBlurredFramebuffer.reset();
     _occlusionBlurredTexture.reset();
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryFramebuffers[i].reset();
+        _occlusionHistoryTextures[i].reset();
+    }
+    _isHistoryValid = false;
 }
 
 gpu::TexturePointer AmbientOcclusionFramebuffer::getLinearDepthTexture() {
@@ -83,6 +103,27 @@ void AmbientOcclusionFramebuffer::allocate() {
     _occlusionBlurredFramebuffer->setRenderBuffer(0, _occlusionBlurredTexture);
 }
 
+void AmbientOcclusionFramebuffer::allocateHistory() {
+    auto width = _frameSize.x;
+    auto height = _frameSize.y;
+
+    // The packed depth of the history is fetched, never filtered
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryTextures[i] = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, width, height, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+        _occlusionHistoryFramebuffers[i] = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionHistory"));
+        _occlusionHistoryFramebuffers[i]->setRenderBuffer(0, _occlusionHistoryTextures[i]);
+    }
+}
+
+void AmbientOcclusionFramebuffer::allocateUpsampled() {
+    auto width = _upsampleFrameSize.x;
+    auto height = _upsampleFrameSize.y;
+
+    _occlusionUpsampledTexture = gpu::TexturePointer(gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, width, height, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_LINEAR_MIP_POINT)));
+    _occlusionUpsampledFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionUpsampled"));
+    _occlusionUpsampledFramebuffer->setRenderBuffer(0, _occlusionUpsampledTexture);
+}
+
 gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionFramebuffer() {
     if (!_occlusionFramebuffer) {
         allocate();
@@ -111,6 +152,41 @@ gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionBlurredTexture() {
     return _occlusionBlurredTexture;
 }
 
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionHistoryFramebuffer(int index) {
+    if (!_occlusionHistoryFramebuffers[index]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryFramebuffers[index];
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionHistoryTexture(int index) {
+    if (!_occlusionHistoryTextures[index]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryTextures[index];
+}
+
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionUpsampledFramebuffer() {
+    if (!_occlusionUpsampledFramebuffer) {
+        allocateUpsampled();
+    }
+    return _occlusionUpsampledFramebuffer;
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionUpsampledTexture() {
+    if (!_occlusionUpsampledTexture) {
+        allocateUpsampled();
+    }
+    return _occlusionUpsampledTexture;
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionOutputTexture() {
+    if (_upsampleLinearDepthTexture) {
+        return getOcclusionUpsampledTexture();
+    }
+    return getOcclusionTexture();
+}
+
 
 class GaussianDistribution {
 public:
@@ -172,6 +248,13 @@ const int AmbientOcclusionEffect_ParamsSlot = 1;
 const int AmbientOcclusionEffect_CameraCorrectionSlot = 2;
 const int AmbientOcclusionEffect_LinearDepthMapSlot = 0;
 const int AmbientOcclusionEffect_OcclusionMapSlot = 0;
+const int AmbientOcclusionEffect_HistoryParamsSlot = 3;
+const int AmbientOcclusionEffect_DepthPyramidMapSlot = 1;
+const int AmbientOcclusionEffect_HistoryMapSlot = 2;
+const int AmbientOcclusionEffect_UpsampleLinearDepthMapSlot = 2;
+
+// The taps are rotated by the golden angle every frame, for the accumulation to gather other samples
+const float FRAME_DITHERING_ANGLE = 2.39996f;
 
 AmbientOcclusionEffect::AmbientOcclusionEffect() {
 }
@@ -258,6 +341,20 @@ void AmbientOcclusionEffect::configure(const Config& config) {
     if (shouldUpdateGaussian) {
         updateGaussianDistribution();
     }
+
+    _isUpsampleEnabled = config.upsampleEnabled;
+
+    if (config.temporalEnabled != _isTemporalEnabled) {
+        _isTemporalEnabled = config.temporalEnabled;
+        _parametersBuffer.edit().ditheringInfo.y = 0.0f;
+        if (_framebuffer) {
+            _framebuffer->setHistoryValid(false);
+        }
+    }
+
+    if (config.temporalBlend != _historyParametersBuffer->historyInfo.x) {
+        _historyParametersBuffer.edit().historyInfo.x = config.temporalBlend;
+    }
 }
 
 const gpu::PipelinePointer& AmbientOcclusionEffect::getOcclusionPipeline() {
@@ -273,6 +370,7 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getOcclusionPipeline() {
         
         slotBindings.insert(gpu::Shader::Binding(std::string("pyramidMap"), AmbientOcclusionEffect_LinearDepthMapSlot));
         gpu::Shader::makeProgram(*program, slotBindings);
+        _occlusionFoveation.fetch(program);
 
         gpu::StatePointer state = gpu::StatePointer(new gpu::State());
 
@@ -285,6 +383,33 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getOcclusionPipeline() {
 }
 
 
+const gpu::PipelinePointer& AmbientOcclusionEffect::getAccumulatePipeline() {
+    if (!_accumulatePipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(ssao_accumulateOcclusion_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), AmbientOcclusionEffect_FrameTransformSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("ambientOcclusionParamsBuffer"), AmbientOcclusionEffect_ParamsSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("cameraCorrectionBuffer"), AmbientOcclusionEffect_CameraCorrectionSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("ambientOcclusionHistoryBuffer"), AmbientOcclusionEffect_HistoryParamsSlot));
+
+        slotBindings.insert(gpu::Shader::Binding(std::string("occlusionMap"), AmbientOcclusionEffect_OcclusionMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("pyramidMap"), AmbientOcclusionEffect_DepthPyramidMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("historyMap"), AmbientOcclusionEffect_HistoryMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        state->setColorWriteMask(true, true, true, false);
+
+        // Good to go add the brand new pipeline
+        _accumulatePipeline = gpu::Pipeline::create(program, state);
+    }
+    return _accumulatePipeline;
+}
+
 const gpu::PipelinePointer& AmbientOcclusionEffect::getHBlurPipeline() {
     if (!_hBlurPipeline) {
         auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
@@ -333,6 +458,32 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getVBlurPipeline() {
     return _vBlurPipeline;
 }
 
+const gpu::PipelinePointer& AmbientOcclusionEffect::getUpsamplePipeline() {
+    if (!_upsamplePipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawViewportQuadTransformTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(ssao_upsampleOcclusion_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("deferredFrameTransformBuffer"), AmbientOcclusionEffect_FrameTransformSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("ambientOcclusionParamsBuffer"), AmbientOcclusionEffect_ParamsSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("cameraCorrectionBuffer"), AmbientOcclusionEffect_CameraCorrectionSlot));
+
+        slotBindings.insert(gpu::Shader::Binding(std::string("occlusionMap"), AmbientOcclusionEffect_OcclusionMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("pyramidMap"), AmbientOcclusionEffect_DepthPyramidMapSlot));
+        slotBindings.insert(gpu::Shader::Binding(std::string("fullLinearDepthMap"), AmbientOcclusionEffect_UpsampleLinearDepthMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        state->setColorWriteMask(true, true, true, false);
+
+        // Good to go add the brand new pipeline
+        _upsamplePipeline = gpu::Pipeline::create(program, state);
+    }
+    return _upsamplePipeline;
+}
+
 void AmbientOcclusionEffect::updateGaussianDistribution() {
     auto coefs = _parametersBuffer.edit()._gaussianCoefs;
     GaussianDistribution::evalSampling(coefs, Parameters::GAUSSIAN_COEFS_LENGTH, _parametersBuffer->getBlurRadius(), _parametersBuffer->getBlurDeviation());
@@ -348,6 +499,7 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
     const auto& linearDepthFramebuffer = inputs.get2();
     
     auto linearDepthTexture = linearDepthFramebuffer->getLinearDepthTexture();
+    auto fullLinearDepthTexture = linearDepthTexture;
     auto sourceViewport = args->_viewport;
     auto occlusionViewport = sourceViewport;
 
@@ -365,10 +517,44 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
     }
 
     _framebuffer->updateLinearDepth(linearDepthTexture);
-  
+
+    // An occlusion of a lower resolution is upsampled to the full one, or read filtered by the lighting
+    bool isUpsampled = _isUpsampleEnabled && _parametersBuffer->getResolutionLevel() > 0;
+    _framebuffer->updateUpsampleLinearDepth(isUpsampled ? fullLinearDepthTexture : gpu::TexturePointer());
     
     auto occlusionFBO = _framebuffer->getOcclusionFramebuffer();
     auto occlusionBlurredFBO = _framebuffer->getOcclusionBlurredFramebuffer();
+
+    bool isTemporal = _isTemporalEnabled;
+    gpu::FramebufferPointer occlusionHistoryFBO;
+    gpu::TexturePointer previousHistoryTexture;
+    if (isTemporal) {
+        auto& dithering = _parametersBuffer.edit().ditheringInfo;
+        dithering.y = fmodf(dithering.y + FRAME_DITHERING_ANGLE, TWO_PI);
+
+        if (occlusionViewport != _historyViewport) {
+            _historyViewport = occlusionViewport;
+            _framebuffer->setHistoryValid(false);
+        }
+
+        // Reproject from the clip space of the previous frame, and keep this one for the next
+        auto& history = _historyParametersBuffer.edit();
+        history.historyInfo.y = (float)_framebuffer->isHistoryValid();
+        for (int side = 0; side < 2; side++) {
+            history.previousWorldToClip[side] = _previousWorldToClip[side];
+            _previousWorldToClip[side] = frameTransform->evalWorldToClip(side);
+        }
+
+        _historyIndex = 1 - _historyIndex;
+        occlusionHistoryFBO = _framebuffer->getOcclusionHistoryFramebuffer(_historyIndex);
+        previousHistoryTexture = _framebuffer->getOcclusionHistoryTexture(1 - _historyIndex);
+        _framebuffer->setHistoryValid(true);
+    }
+
+    gpu::FramebufferPointer occlusionUpsampledFBO;
+    if (isUpsampled) {
+        occlusionUpsampledFBO = _framebuffer->getOcclusionUpsampledFramebuffer();
+    }
     
     outputs.edit0() = _framebuffer;
     outputs.edit1() = _parametersBuffer;
@@ -380,10 +566,18 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
     float tMin = occlusionViewport.y / (float)framebufferSize.y;
     float tHeight = occlusionViewport.w / (float)framebufferSize.y;
 
+    auto fullFramebufferSize = glm::ivec2(fullLinearDepthTexture->getDimensions());
+    float fullSMin = sourceViewport.x / (float)fullFramebufferSize.x;
+    float fullSWidth = sourceViewport.z / (float)fullFramebufferSize.x;
+    float fullTMin = sourceViewport.y / (float)fullFramebufferSize.y;
+    float fullTHeight = sourceViewport.w / (float)fullFramebufferSize.y;
+
 
     auto occlusionPipeline = getOcclusionPipeline();
+    auto accumulatePipeline = isTemporal ? getAccumulatePipeline() : gpu::PipelinePointer();
     auto firstHBlurPipeline = getHBlurPipeline();
     auto lastVBlurPipeline = getVBlurPipeline();
+    auto upsamplePipeline = isUpsampled ? getUpsamplePipeline() : gpu::PipelinePointer();
     
     gpu::doInBatch(args->_context, [=](gpu::Batch& batch) {
         batch.enableStereo(false);
@@ -410,15 +604,28 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
         batch.setFramebuffer(occlusionFBO);
         batch.clearColorFramebuffer(gpu::Framebuffer::BUFFER_COLOR0, glm::vec4(1.0f));
         batch.setPipeline(occlusionPipeline);
+        _occlusionFoveation.apply(batch, args, occlusionViewport);
         batch.setResourceTexture(AmbientOcclusionEffect_LinearDepthMapSlot, _framebuffer->getLinearDepthTexture());
         batch.draw(gpu::TRIANGLE_STRIP, 4);
 
+        auto unblurredFBO = occlusionFBO;
+        if (isTemporal) {
+            // Accumulation pass, blending the occlusion of the frame in the reprojected history
+            batch.setFramebuffer(occlusionHistoryFBO);
+            batch.setPipeline(accumulatePipeline);
+            batch.setUniformBuffer(AmbientOcclusionEffect_HistoryParamsSlot, _historyParametersBuffer);
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(AmbientOcclusionEffect_DepthPyramidMapSlot, _framebuffer->getLinearDepthTexture());
+            batch.setResourceTexture(AmbientOcclusionEffect_HistoryMapSlot, previousHistoryTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+            unblurredFBO = occlusionHistoryFBO;
+        }
         
         if (_parametersBuffer->getBlurRadius() > 0) {
             // Blur 1st pass
             batch.setFramebuffer(occlusionBlurredFBO);
             batch.setPipeline(firstHBlurPipeline);
-            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, unblurredFBO->getRenderBuffer(0));
             batch.draw(gpu::TRIANGLE_STRIP, 4);
 
             // Blur 2nd pass
@@ -426,11 +633,31 @@ void AmbientOcclusionEffect::run(const render::SceneContextPointer& sceneContext
             batch.setPipeline(lastVBlurPipeline);
             batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionBlurredFBO->getRenderBuffer(0));
             batch.draw(gpu::TRIANGLE_STRIP, 4);
+        } else if (isTemporal) {
+            batch.blit(occlusionHistoryFBO, occlusionViewport, occlusionFBO, occlusionViewport);
+        }
+
+        if (isUpsampled) {
+            // Upsampling pass, weighting the occlusion of the lower resolution by how close its depth is
+            batch.setViewportTransform(sourceViewport);
+
+            Transform fullModel;
+            fullModel.setTranslation(glm::vec3(fullSMin, fullTMin, 0.0f));
+            fullModel.setScale(glm::vec3(fullSWidth, fullTHeight, 1.0f));
+            batch.setModelTransform(fullModel);
+
+            batch.setFramebuffer(occlusionUpsampledFBO);
+            batch.setPipeline(upsamplePipeline);
+            batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(AmbientOcclusionEffect_DepthPyramidMapSlot, _framebuffer->getLinearDepthTexture());
+            batch.setResourceTexture(AmbientOcclusionEffect_UpsampleLinearDepthMapSlot, fullLinearDepthTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
         }
-        
         
         batch.setResourceTexture(AmbientOcclusionEffect_LinearDepthMapSlot, nullptr);
         batch.setResourceTexture(AmbientOcclusionEffect_OcclusionMapSlot, nullptr);
+        batch.setResourceTexture(AmbientOcclusionEffect_DepthPyramidMapSlot, nullptr);
+        batch.setResourceTexture(AmbientOcclusionEffect_HistoryMapSlot, nullptr);
         
         _gpuTimer->end(batch);
     });
@@ -19,6 +19,7 @@
 
 #include "DeferredFrameTransform.h"
 #include "DeferredFramebuffer.h"
+#include "FoveatedRendering.h"
 #include "SurfaceGeometryPass.h"
 
 class AmbientOcclusionFramebuffer {
@@ -30,26 +31,53 @@ public:
     
     gpu::FramebufferPointer getOcclusionBlurredFramebuffer();
     gpu::TexturePointer getOcclusionBlurredTexture();
+
+    // The two occlusions accumulated over the frames, the one of the previous frame is read while the other is written
+    gpu::FramebufferPointer getOcclusionHistoryFramebuffer(int index);
+    gpu::TexturePointer getOcclusionHistoryTexture(int index);
+
+    gpu::FramebufferPointer getOcclusionUpsampledFramebuffer();
+    gpu::TexturePointer getOcclusionUpsampledTexture();
+
+    // The occlusion the lighting reads, the upsampled one when the occlusion is upsampled
+    gpu::TexturePointer getOcclusionOutputTexture();
+
+    // The history is lost with the resources, and is valid once accumulated
+    bool isHistoryValid() const { return _isHistoryValid; }
+    void setHistoryValid(bool valid) { _isHistoryValid = valid; }
     
     // Update the source framebuffer size which will drive the allocation of all the other resources.
     void updateLinearDepth(const gpu::TexturePointer& linearDepthBuffer);
+    // Update the full resolution depth the occlusion is upsampled to, none to keep the occlusion at its resolution
+    void updateUpsampleLinearDepth(const gpu::TexturePointer& fullLinearDepthBuffer);
     gpu::TexturePointer getLinearDepthTexture();
     const glm::ivec2& getSourceFrameSize() const { return _frameSize; }
         
 protected:
     void clear();
     void allocate();
+    void allocateHistory();
+    void allocateUpsampled();
     
     gpu::TexturePointer _linearDepthTexture;
+    gpu::TexturePointer _upsampleLinearDepthTexture;
     
     gpu::FramebufferPointer _occlusionFramebuffer;
     gpu::TexturePointer _occlusionTexture;
     
     gpu::FramebufferPointer _occlusionBlurredFramebuffer;
     gpu::TexturePointer _occlusionBlurredTexture;
+
+    gpu::FramebufferPointer _occlusionHistoryFramebuffers[2];
+    gpu::TexturePointer _occlusionHistoryTextures[2];
+
+    gpu::FramebufferPointer _occlusionUpsampledFramebuffer;
+    gpu::TexturePointer _occlusionUpsampledTexture;
     
+    bool _isHistoryValid { false };
     
     glm::ivec2 _frameSize;
+    glm::ivec2 _upsampleFrameSize;
 };
 
 using AmbientOcclusionFramebufferPointer = std::shared_ptr<AmbientOcclusionFramebuffer>;
@@ -60,6 +88,8 @@ class AmbientOcclusionEffectConfig : public render::GPUJobConfig::Persistent {
     Q_PROPERTY(bool ditheringEnabled MEMBER ditheringEnabled NOTIFY dirty)
     Q_PROPERTY(bool borderingEnabled MEMBER borderingEnabled NOTIFY dirty)
     Q_PROPERTY(bool fetchMipsEnabled MEMBER fetchMipsEnabled NOTIFY dirty)
+    Q_PROPERTY(bool upsampleEnabled MEMBER upsampleEnabled NOTIFY dirty)
+    Q_PROPERTY(bool temporalEnabled MEMBER temporalEnabled NOTIFY dirty)
     Q_PROPERTY(float radius MEMBER radius WRITE setRadius)
     Q_PROPERTY(float obscuranceLevel MEMBER obscuranceLevel WRITE setObscuranceLevel)
     Q_PROPERTY(float falloffBias MEMBER falloffBias WRITE setFalloffBias)
@@ -69,6 +99,7 @@ class AmbientOcclusionEffectConfig : public render::GPUJobConfig::Persistent {
     Q_PROPERTY(int numSamples MEMBER numSamples WRITE setNumSamples)
     Q_PROPERTY(int resolutionLevel MEMBER resolutionLevel WRITE setResolutionLevel)
     Q_PROPERTY(int blurRadius MEMBER blurRadius WRITE setBlurRadius)
+    Q_PROPERTY(float temporalBlend MEMBER temporalBlend WRITE setTemporalBlend)
 
 public:
     AmbientOcclusionEffectConfig() : render::GPUJobConfig::Persistent("Ambient Occlusion", false) {}
@@ -85,6 +116,7 @@ public:
     void setNumSamples(int samples) { numSamples = std::max(1.0f, (float)samples); emit dirty(); }
     void setResolutionLevel(int level) { resolutionLevel = std::max(0, std::min(level, MAX_RESOLUTION_LEVEL)); emit dirty(); }
     void setBlurRadius(int radius) { blurRadius = std::max(0, std::min(MAX_BLUR_RADIUS, radius)); emit dirty(); }
+    void setTemporalBlend(float blend) { temporalBlend = std::max(0.05f, std::min(blend, 1.0f)); emit dirty(); }
 
     float radius{ 0.5f };
     float perspectiveScale{ 1.0f };
@@ -96,9 +128,12 @@ public:
     int numSamples{ 16 };
     int resolutionLevel{ 1 };
     int blurRadius{ 4 }; // 0 means no blurring
+    float temporalBlend{ 0.25f }; // the weight of the occlusion of the frame in the accumulated occlusion
     bool ditheringEnabled{ true }; // randomize the distribution of taps per pixel, should always be true
     bool borderingEnabled{ true }; // avoid evaluating information from non existing pixels out of the frame, should always be true
     bool fetchMipsEnabled{ true }; // fetch taps in sub mips to otpimize cache, should always be true
+    bool upsampleEnabled{ false }; // upsample an occlusion of a lower resolution to the full one, along the depth edges
+    bool temporalEnabled{ false }; // rotate the taps every frame and accumulate the occlusion reprojected from the previous frames
 
 signals:
     void dirty();
@@ -154,20 +189,45 @@ public:
     };
     using ParametersBuffer = gpu::StructBuffer<Parameters>;
 
+    // Class describing the uniform buffer of the accumulation of the occlusion over the frames
+    class HistoryParameters {
+    public:
+        // From world space to the clip space of each side, in the previous frame
+        glm::mat4 previousWorldToClip[2];
+        // History info is { blend of the frame, isHistoryValid, depth rejection, 0 }
+        glm::vec4 historyInfo { 1.0f, 0.0f, 0.1f, 0.0f };
+
+        HistoryParameters() {}
+    };
+    using HistoryParametersBuffer = gpu::StructBuffer<HistoryParameters>;
+
 private:
     void updateGaussianDistribution();
    
     ParametersBuffer _parametersBuffer;
+    HistoryParametersBuffer _historyParametersBuffer;
 
     const gpu::PipelinePointer& getOcclusionPipeline();
+    const gpu::PipelinePointer& getAccumulatePipeline();
     const gpu::PipelinePointer& getHBlurPipeline(); // first
     const gpu::PipelinePointer& getVBlurPipeline(); // second
+    const gpu::PipelinePointer& getUpsamplePipeline();
 
     gpu::PipelinePointer _occlusionPipeline;
+    FoveationLocations _occlusionFoveation;
+    gpu::PipelinePointer _accumulatePipeline;
     gpu::PipelinePointer _hBlurPipeline;
     gpu::PipelinePointer _vBlurPipeline;
+    gpu::PipelinePointer _upsamplePipeline;
 
     AmbientOcclusionFramebufferPointer _framebuffer;
+
+    bool _isUpsampleEnabled { false };
+    bool _isTemporalEnabled { false };
+    // The history is reprojected while it is accumulated in the same viewport
+    glm::ivec4 _historyViewport;
+    glm::mat4 _previousWorldToClip[2];
+    int _historyIndex { 0 };
     
     gpu::RangeTimerPointer _gpuTimer;
 
@@ -63,6 +63,11 @@ void DeferredFrameTransform::update(RenderArgs* args) {
     }
 }
 
+glm::mat4 DeferredFrameTransform::evalWorldToClip(int side) const {
+    const auto& frameTransform = _frameTransformBuffer.get<FrameTransform>();
+    return frameTransform.projection[side] * frameTransform.view;
+}
+
 void GenerateDeferredFrameTransform::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, DeferredFrameTransformPointer& frameTransform) {
     if (!frameTransform) {
         frameTransform = std::make_shared<DeferredFrameTransform>();
@@ -29,6 +29,9 @@ public:
 
     UniformBufferView getFrameTransformBuffer() const { return _frameTransformBuffer; }
 
+    // From world space to the clip space of a side, without the camera correction
+    glm::mat4 evalWorldToClip(int side) const;
+
 protected:
 
 
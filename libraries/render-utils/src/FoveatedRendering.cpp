@@ -0,0 +1,121 @@
+//
+//  FoveatedRendering.cpp
+//  libraries/render-utils/src/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "FoveatedRendering.h"
+
+#include <gpu/Context.h>
+#include <gpu/StandardShaderLib.h>
+
+#include "foveation_makeStencil_frag.h"
+#include "foveation_fillLighting_frag.h"
+
+const int FillFoveatedLighting_LightingMapSlot = 0;
+
+// Over the opaque bit written by DrawStencilDeferred, the lighting passes only shade the pixels with the opaque bit alone
+static const gpu::int8 STENCIL_OPAQUE = 1;
+static const gpu::int8 STENCIL_FOVEATION_MASK = 2;
+
+void FoveationLocations::fetch(const gpu::ShaderPointer& program) {
+    _centersLoc = program->getUniforms().findLocation("foveationCenters");
+    _viewportLoc = program->getUniforms().findLocation("foveationViewport");
+    _paramsLoc = program->getUniforms().findLocation("foveationParams");
+}
+
+void FoveationLocations::apply(gpu::Batch& batch, const RenderArgs* args, const glm::ivec4& viewport) const {
+    const auto& centers = args->_foveationCenters;
+    batch._glUniform4f(_centersLoc, centers[0].x, centers[0].y, centers[1].x, centers[1].y);
+    batch._glUniform4f(_viewportLoc, (float)viewport.x, (float)viewport.y, (float)viewport.z, (float)viewport.w);
+    batch._glUniform2f(_paramsLoc, args->_foveationRadius, args->_context->isStereo() ? 1.0f : 0.0f);
+}
+
+void DrawFoveationStencil::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DeferredFramebufferPointer& deferredFramebuffer) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+    if (!FoveationLocations::isEnabled(args)) {
+        return;
+    }
+
+    auto pipeline = getPipeline();
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        batch.setFramebuffer(deferredFramebuffer->getDeferredFramebufferDepthColor());
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+
+        batch.setPipeline(pipeline);
+        _locations.apply(batch, args, args->_viewport);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+}
+
+const gpu::PipelinePointer& DrawFoveationStencil::getPipeline() {
+    if (!_pipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(foveation_makeStencil_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+        gpu::Shader::makeProgram(*program);
+        _locations.fetch(program);
+
+        // Only sets the mask bit of the opaque pixels
+        auto state = std::make_shared<gpu::State>();
+        state->setStencilTest(true, STENCIL_FOVEATION_MASK, gpu::State::StencilTest(STENCIL_OPAQUE | STENCIL_FOVEATION_MASK, STENCIL_OPAQUE,
+            gpu::EQUAL, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_REPLACE));
+        state->setColorWriteMask(0);
+
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+    return _pipeline;
+}
+
+void FillFoveatedLighting::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DeferredFramebufferPointer& deferredFramebuffer) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+    if (!FoveationLocations::isEnabled(args)) {
+        return;
+    }
+
+    auto pipeline = getPipeline();
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        batch.setFramebuffer(deferredFramebuffer->getLightingFramebuffer());
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+
+        // The masked pixels read their shaded neighbours in the framebuffer they are written to
+        batch.textureBarrier();
+        batch.setPipeline(pipeline);
+        batch.setResourceTexture(FillFoveatedLighting_LightingMapSlot, deferredFramebuffer->getLightingTexture());
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+
+        batch.setResourceTexture(FillFoveatedLighting_LightingMapSlot, nullptr);
+    });
+}
+
+const gpu::PipelinePointer& FillFoveatedLighting::getPipeline() {
+    if (!_pipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(foveation_fillLighting_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("lightingMap"), FillFoveatedLighting_LightingMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        auto state = std::make_shared<gpu::State>();
+        state->setStencilTest(true, 0x00, gpu::State::StencilTest(STENCIL_OPAQUE | STENCIL_FOVEATION_MASK, 0xFF,
+            gpu::EQUAL, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP));
+        state->setColorWriteMask(true, true, true, false);
+
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+    return _pipeline;
+}
@@ -0,0 +1,64 @@
+//
+//  FoveatedRendering.h
+//  libraries/render-utils/src/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FoveatedRendering_h
+#define hifi_FoveatedRendering_h
+
+#include <RenderArgs.h>
+#include <gpu/Pipeline.h>
+#include <render/DrawTask.h>
+
+#include "DeferredFramebuffer.h"
+
+// The locations of the uniforms declared by declareFoveation() in Foveation.slh
+class FoveationLocations {
+public:
+    void fetch(const gpu::ShaderPointer& program);
+
+    // Once the program pipeline is set, from the foveation of the args over their viewport
+    void apply(gpu::Batch& batch, const RenderArgs* args, const glm::ivec4& viewport) const;
+
+    static bool isEnabled(const RenderArgs* args) { return args->_foveationRadius > 0.0f; }
+
+private:
+    int _centersLoc { -1 };
+    int _viewportLoc { -1 };
+    int _paramsLoc { -1 };
+};
+
+// Masks a checkerboard of 2x2 quads in the stencil of the opaque pixels beyond the full rate region of the args
+// foveation, for the deferred lighting to skip them. Does nothing without foveation.
+class DrawFoveationStencil {
+public:
+    using JobModel = render::Job::ModelI<DrawFoveationStencil, DeferredFramebufferPointer>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DeferredFramebufferPointer& deferredFramebuffer);
+
+private:
+    const gpu::PipelinePointer& getPipeline();
+    gpu::PipelinePointer _pipeline;
+    FoveationLocations _locations;
+};
+
+// Fills the quads masked by DrawFoveationStencil in the lighting from their shaded neighbours, once the background
+// is drawn around the opaque pixels.
+class FillFoveatedLighting {
+public:
+    using JobModel = render::Job::ModelI<FillFoveatedLighting, DeferredFramebufferPointer>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const DeferredFramebufferPointer& deferredFramebuffer);
+
+private:
+    const gpu::PipelinePointer& getPipeline();
+    gpu::PipelinePointer _pipeline;
+};
+
+#endif // hifi_FoveatedRendering_h
@@ -26,6 +26,14 @@
 #include "lightClusters_drawClusterContent_vert.h"
 #include "lightClusters_drawClusterContent_frag.h"
 
+#include "lightClusters_buildClusters_comp.h"
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define LIGHT_CLUSTERS_SSE2 1
+#endif
+
 enum LightClusterGridShader_MapSlot {
     DEFERRED_BUFFER_LINEAR_DEPTH_UNIT = 0,
     DEFERRED_BUFFER_COLOR_UNIT = 1,
@@ -45,6 +53,18 @@ enum LightClusterGridShader_BufferSlot {
     LIGHT_CLUSTER_GRID_CLUSTER_CONTENT_SLOT = 7,
 };
 
+// The storage buffers of lightClusters_buildClusters.slc
+enum LightClusterBuildShader_ResourceBufferSlot {
+    LIGHT_CLUSTER_BUILD_LIGHT_ARRAY_SLOT = 0,
+    LIGHT_CLUSTER_BUILD_LIGHT_INDEX_SLOT = 1,
+    LIGHT_CLUSTER_BUILD_CLUSTER_GRID_SLOT = 2,
+    LIGHT_CLUSTER_BUILD_CLUSTER_CONTENT_SLOT = 3,
+    LIGHT_CLUSTER_BUILD_CONTENT_COUNTER_SLOT = 4,
+};
+
+// Must match the local_size_x of lightClusters_buildClusters.slc
+static const uint32_t LIGHT_CLUSTER_BUILD_GROUP_SIZE = 64;
+
 FrustumGrid::FrustumGrid(const FrustumGrid& source) :
     frustumNear(source.frustumNear),
     rangeNear(source.rangeNear),
@@ -337,6 +357,103 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
     return numClustersTouched;
 }
 
+void LightClusters::gatherClusteredLights(const FrustumGrid& grid) {
+    _clusteredLights.clear();
+    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
+        auto lightId = _visibleLightIndices[lightNum];
+        auto light = _lightStage->getLight(lightId);
+        if (light) {
+            _clusteredLights.push_back({ lightId, glm::vec4(light->getPosition(), light->getMaximumRadius()), light->isSpot() });
+        }
+    }
+
+    // A light is out when its sphere is before the range near or out of one of the side planes of the grid
+    const auto& leftPlane = _gridPlanes[0][0];
+    const auto& rightPlane = _gridPlanes[0].back();
+    const auto& bottomPlane = _gridPlanes[1][0];
+    const auto& topPlane = _gridPlanes[1].back();
+
+    size_t numLights = _clusteredLights.size();
+    size_t numKept = 0;
+    size_t i = 0;
+
+#if LIGHT_CLUSTERS_SSE2
+    // 4 lights at a time, brought from world to eye space and tested against the planes together
+    const glm::mat4& worldToEye = grid.worldToEyeMat;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 minusRangeNear = _mm_set1_ps(-grid.rangeNear);
+    auto evalPlane = [](const glm::vec4& plane, __m128 x, __m128 y, __m128 z) {
+        __m128 distance = _mm_set1_ps(plane.w);
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.x), x));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), y));
+        return _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+    };
+    for (; i + 4 <= numLights; i += 4) {
+        const glm::vec4& light0 = _clusteredLights[i].eyePosRadius;
+        const glm::vec4& light1 = _clusteredLights[i + 1].eyePosRadius;
+        const glm::vec4& light2 = _clusteredLights[i + 2].eyePosRadius;
+        const glm::vec4& light3 = _clusteredLights[i + 3].eyePosRadius;
+        __m128 worldX = _mm_set_ps(light3.x, light2.x, light1.x, light0.x);
+        __m128 worldY = _mm_set_ps(light3.y, light2.y, light1.y, light0.y);
+        __m128 worldZ = _mm_set_ps(light3.z, light2.z, light1.z, light0.z);
+        __m128 radius = _mm_set_ps(light3.w, light2.w, light1.w, light0.w);
+
+        __m128 eye[3];
+        for (int row = 0; row < 3; row++) {
+            eye[row] = _mm_set1_ps(worldToEye[3][row]);
+            eye[row] = _mm_add_ps(eye[row], _mm_mul_ps(_mm_set1_ps(worldToEye[0][row]), worldX));
+            eye[row] = _mm_add_ps(eye[row], _mm_mul_ps(_mm_set1_ps(worldToEye[1][row]), worldY));
+            eye[row] = _mm_add_ps(eye[row], _mm_mul_ps(_mm_set1_ps(worldToEye[2][row]), worldZ));
+        }
+
+        __m128 outside = _mm_cmpgt_ps(_mm_sub_ps(eye[2], radius), minusRangeNear);
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(radius, evalPlane(leftPlane, eye[0], eye[1], eye[2])));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(radius, evalPlane(rightPlane, eye[0], eye[1], eye[2])), zero));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(radius, evalPlane(bottomPlane, eye[0], eye[1], eye[2])));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(radius, evalPlane(topPlane, eye[0], eye[1], eye[2])), zero));
+
+        float eyeX[4], eyeY[4], eyeZ[4];
+        _mm_storeu_ps(eyeX, eye[0]);
+        _mm_storeu_ps(eyeY, eye[1]);
+        _mm_storeu_ps(eyeZ, eye[2]);
+        int outsideMask = _mm_movemask_ps(outside);
+        for (int j = 0; j < 4; j++) {
+            if (!(outsideMask & (1 << j))) {
+                ClusteredLight light = _clusteredLights[i + j];
+                light.eyePosRadius = glm::vec4(eyeX[j], eyeY[j], eyeZ[j], light.eyePosRadius.w);
+                _clusteredLights[numKept++] = light;
+            }
+        }
+    }
+#endif
+
+    for (; i < numLights; i++) {
+        ClusteredLight light = _clusteredLights[i];
+        float radius = light.eyePosRadius.w;
+        auto eyeOri = glm::vec3(grid.worldToEyeMat * glm::vec4(glm::vec3(light.eyePosRadius), 1.0f));
+
+        // Remove light that slipped through and is not in the z range
+        if (eyeOri.z - radius > -grid.rangeNear) {
+            continue;
+        }
+
+        auto xLeftDistance = radius - distanceToPlane(eyeOri, leftPlane);
+        auto xRightDistance = radius + distanceToPlane(eyeOri, rightPlane);
+
+        auto yBottomDistance = radius - distanceToPlane(eyeOri, bottomPlane);
+        auto yTopDistance = radius + distanceToPlane(eyeOri, topPlane);
+
+        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
+            continue;
+        }
+
+        light.eyePosRadius = glm::vec4(eyeOri, radius);
+        _clusteredLights[numKept++] = light;
+    }
+
+    _clusteredLights.resize(numKept);
+}
+
 glm::ivec3 LightClusters::updateClusters() {
     // Make sure resource are in good shape
     updateClusterResource();
@@ -344,8 +461,12 @@ glm::ivec3 LightClusters::updateClusters() {
     // Clean up last info
     uint32_t numClusters = (uint32_t)_clusterGrid.size();
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    _clusterGridPoint.resize(numClusters);
+    _clusterGridSpot.resize(numClusters);
+    for (uint32_t i = 0; i < numClusters; i++) {
+        _clusterGridPoint[i].clear();
+        _clusterGridSpot[i].clear();
+    }
 
     _clusterGrid.clear();
     _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
@@ -362,25 +483,16 @@ glm::ivec3 LightClusters::updateClusters() {
     uint32_t numClusterTouched = 0;
     uint32_t numLightsIn = _visibleLightIndices[0];
     uint32_t numClusteredLights = 0;
-    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
-        auto lightId = _visibleLightIndices[lightNum];
-        auto light = _lightStage->getLight(lightId);
-        if (!light) {
-            continue;
-        }
 
-        auto worldOri = light->getPosition();
-        auto radius = light->getMaximumRadius();
-        bool isSpot = light->isSpot();
+    gatherClusteredLights(theFrustumGrid);
 
-        // Bring into frustum eye space
-        auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
+    for (const auto& clusteredLight : _clusteredLights) {
+        auto lightId = clusteredLight.id;
+        auto eyeOri = glm::vec3(clusteredLight.eyePosRadius);
+        auto radius = clusteredLight.eyePosRadius.w;
+        bool isSpot = clusteredLight.isSpot;
 
-        // Remove light that slipped through and is not in the z range
         float eyeZMax = eyeOri.z - radius;
-        if (eyeZMax > -theFrustumGrid.rangeNear) {
-            continue;
-        }
         float eyeZMin = eyeOri.z + radius;
         bool beyondFar = false;
         if (eyeZMin < -theFrustumGrid.rangeFar) {
@@ -403,16 +515,6 @@ glm::ivec3 LightClusters::updateClusters() {
         // CLamp the z range 
         zMin = std::max(0, zMin);
 
-        auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
-        auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
-
-        auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
-        auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
-
-        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
-            continue;
-        }
-
         // find 2D corners of the sphere in grid
         int xMin { 0 };
         int xMax { theFrustumGrid.dims.x - 1 };
@@ -489,7 +591,7 @@ glm::ivec3 LightClusters::updateClusters() {
         }
 
         // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
+        auto& clusterGrid = (isSpot ? _clusterGridSpot : _clusterGridPoint);
         if (beyondFar) {
             numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
         } else {
@@ -506,9 +608,9 @@ glm::ivec3 LightClusters::updateClusters() {
         checkBudget = true;
     }
     uint16_t indexOffset = 0;
-    for (int i = 0; i < (int) clusterGridPoint.size(); i++) {
-        auto& clusterPoint = clusterGridPoint[i];
-        auto& clusterSpot = clusterGridSpot[i];
+    for (int i = 0; i < (int) _clusterGridPoint.size(); i++) {
+        auto& clusterPoint = _clusterGridPoint[i];
+        auto& clusterSpot = _clusterGridSpot[i];
 
         uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
         uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
@@ -543,6 +645,47 @@ glm::ivec3 LightClusters::updateClusters() {
     return glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched);
 }
 
+glm::ivec3 LightClusters::updateClustersOnGPU(gpu::Batch& batch) {
+    // Make sure resource are in good shape
+    updateClusterResource();
+
+    if (!_buildClustersPipeline) {
+        auto cs = gpu::Shader::createCompute(std::string(lightClusters_buildClusters_comp));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(cs);
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("frustumGridBuffer"), LIGHT_CLUSTER_GRID_FRUSTUM_GRID_SLOT));
+        gpu::Shader::makeProgram(*program, slotBindings);
+        _buildClustersPipeline = gpu::Pipeline::create(program, std::make_shared<gpu::State>());
+    }
+
+    // The clusters take their range of the content from this counter, restarted every frame
+    const uint32_t ZERO_COUNTER = 0;
+    if (!_clusterContentCounterBuffer) {
+        _clusterContentCounterBuffer = std::make_shared<gpu::Buffer>();
+    }
+    _clusterContentCounterBuffer->setData(sizeof(uint32_t), (const gpu::Byte*)&ZERO_COUNTER);
+
+    uint32_t numClusters = getNumClusters();
+
+    batch.setPipeline(_buildClustersPipeline);
+    batch.setUniformBuffer(LIGHT_CLUSTER_GRID_FRUSTUM_GRID_SLOT, _frustumGridBuffer);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_LIGHT_ARRAY_SLOT, _lightStage->_lightArrayBuffer);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_LIGHT_INDEX_SLOT, _lightIndicesBuffer._buffer);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CLUSTER_GRID_SLOT, _clusterGridBuffer._buffer);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CLUSTER_CONTENT_SLOT, _clusterContentBuffer._buffer);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CONTENT_COUNTER_SLOT, _clusterContentCounterBuffer);
+    batch.dispatch((numClusters + LIGHT_CLUSTER_BUILD_GROUP_SIZE - 1) / LIGHT_CLUSTER_BUILD_GROUP_SIZE);
+
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_LIGHT_ARRAY_SLOT, nullptr);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_LIGHT_INDEX_SLOT, nullptr);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CLUSTER_GRID_SLOT, nullptr);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CLUSTER_CONTENT_SLOT, nullptr);
+    batch.setResourceBuffer(LIGHT_CLUSTER_BUILD_CONTENT_COUNTER_SLOT, nullptr);
+
+    uint32_t numLightsIn = _visibleLightIndices[0];
+    return glm::ivec3(numLightsIn, 0, 0);
+}
+
 
 
 LightClusteringPass::LightClusteringPass() {
@@ -556,6 +699,7 @@ void LightClusteringPass::configure(const Config& config) {
     }
     
     _freeze = config.freeze;
+    _computeEnabled = config.computeEnabled;
 }
 
 void LightClusteringPass::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& output) {
@@ -581,7 +725,14 @@ void LightClusteringPass::run(const render::SceneContextPointer& sceneContext, c
     _lightClusters->updateLightStage(lightStage);
     _lightClusters->updateLightFrame(lightStage->_currentFrame, lightingModel->isPointLightEnabled(), lightingModel->isSpotLightEnabled());
     
-    auto clusteringStats = _lightClusters->updateClusters();
+    glm::ivec3 clusteringStats;
+    if (_computeEnabled && args->_context->supportsComputeShaders()) {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            clusteringStats = _lightClusters->updateClustersOnGPU(batch);
+        });
+    } else {
+        clusteringStats = _lightClusters->updateClusters();
+    }
 
     output = _lightClusters;
 
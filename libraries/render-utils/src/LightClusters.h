@@ -83,6 +83,10 @@ public:
 
     glm::ivec3  updateClusters();
 
+    // Build the cluster grid and content with a compute program, from the light array buffer of the stage.
+    // Only when the context supports compute shaders, the returned stats only count the input lights
+    glm::ivec3 updateClustersOnGPU(gpu::Batch& batch);
+
 
     ViewFrustum _frustum;
 
@@ -111,6 +115,22 @@ public:
 
     bool _clusterResourcesInvalid { true };
     void updateClusterResource();
+
+    // The lights of the frame touching the grid, in the eye space of the grid
+    struct ClusteredLight {
+        LightID id;
+        glm::vec4 eyePosRadius;
+        bool isSpot;
+    };
+    std::vector<ClusteredLight> _clusteredLights;
+    void gatherClusteredLights(const FrustumGrid& grid);
+
+    // The lists of lights of each cluster, kept from frame to frame to keep their allocations
+    std::vector<std::vector<LightIndex>> _clusterGridPoint;
+    std::vector<std::vector<LightIndex>> _clusterGridSpot;
+
+    gpu::PipelinePointer _buildClustersPipeline;
+    gpu::BufferPointer _clusterContentCounterBuffer;
 };
 
 using LightClustersPointer = std::shared_ptr<LightClusters>;
@@ -127,6 +147,7 @@ class LightClusteringPassConfig : public render::Job::Config {
     Q_PROPERTY(int dimZ MEMBER dimZ NOTIFY dirty)
     
     Q_PROPERTY(bool freeze MEMBER freeze NOTIFY dirty)
+    Q_PROPERTY(bool computeEnabled MEMBER computeEnabled NOTIFY dirty)
 
     Q_PROPERTY(int numClusteredLightReferences MEMBER numClusteredLightReferences NOTIFY dirty)
     Q_PROPERTY(int numInputLights MEMBER numInputLights NOTIFY dirty)
@@ -147,7 +168,9 @@ public:
 
 
     bool freeze{ false };
+    bool computeEnabled{ true }; // build the clusters on the GPU when it supports compute shaders
 
+    // The clustered lights and their references are only counted by the CPU clustering
     int numClusteredLightReferences { 0 };
     int numInputLights { 0 };
     int numClusteredLights { 0 };
@@ -181,6 +204,7 @@ public:
 protected:
     LightClustersPointer _lightClusters;
     bool _freeze;
+    bool _computeEnabled { true };
 };
 
 
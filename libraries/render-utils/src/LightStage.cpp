@@ -13,15 +13,35 @@
 
 #include "LightStage.h"
 
-LightStage::Shadow::Shadow(model::LightPointer light) : _light{ light}, _frustum{ std::make_shared<ViewFrustum>() } {
-    framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::createShadowmap(MAP_SIZE));
+// How much larger than the view frustum slice the keylight frustum is, so that it is not refit every frame
+static const float FRUSTUM_MARGIN = 0.25f;
+
+LightStage::Shadow::Cascade::Cascade() : _frustum{ std::make_shared<ViewFrustum>() } {
+}
+
+const glm::mat4& LightStage::Shadow::Cascade::getView() const {
+    return _frustum->getView();
+}
+
+const glm::mat4& LightStage::Shadow::Cascade::getProjection() const {
+    return _frustum->getProjection();
+}
+
+LightStage::Shadow::Shadow(model::LightPointer light) : _light{ light} {
+    framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::createShadowmap(ATLAS_SIZE));
     map = framebuffer->getDepthStencilBuffer();
     Schema schema;
     _schemaBuffer = std::make_shared<gpu::Buffer>(sizeof(Schema), (const gpu::Byte*) &schema);
 }
 
-void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, float nearDepth, float farDepth) {
+glm::ivec4 LightStage::Shadow::getCascadeViewport(int cascadeIndex) {
+    return glm::ivec4((cascadeIndex % 2) * MAP_SIZE, (cascadeIndex / 2) * MAP_SIZE, MAP_SIZE, MAP_SIZE);
+}
+
+void LightStage::Shadow::setKeylightFrustum(int cascadeIndex, const ViewFrustum& viewFrustum, float nearDepth, float farDepth) {
     assert(nearDepth < farDepth);
+    assert(cascadeIndex >= 0 && cascadeIndex < CASCADE_COUNT);
+    auto& cascade = _cascades[cascadeIndex];
 
     // Orient the keylight frustum
     const auto& direction = glm::normalize(_light->getDirection());
@@ -35,56 +55,61 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum, floa
         auto up = glm::normalize(glm::cross(side, direction));
         orientation = glm::quat_cast(glm::mat3(side, up, -direction));
     }
-    _frustum->setOrientation(orientation);
-
-    // Position the keylight frustum
-    _frustum->setPosition(viewFrustum.getPosition() - (nearDepth + farDepth)*direction);
-
-    const Transform view{ _frustum->getView()};
-    const Transform viewInverse{ view.getInverseMatrix() };
+    cascade._frustum->setOrientation(orientation);
 
+    // Bound the view frustum slice with a sphere, which does not change size as the view turns
     auto nearCorners = viewFrustum.getCorners(nearDepth);
     auto farCorners = viewFrustum.getCorners(farDepth);
-
-    vec3 min{ viewInverse.transform(nearCorners.bottomLeft) };
-    vec3 max{ min };
-    // Expand keylight frustum  to fit view frustum
-    auto fitFrustum = [&min, &max, &viewInverse](const vec3& viewCorner) {
-        const auto corner = viewInverse.transform(viewCorner);
-
-        min.x = glm::min(min.x, corner.x);
-        min.y = glm::min(min.y, corner.y);
-        min.z = glm::min(min.z, corner.z);
-
-        max.x = glm::max(max.x, corner.x);
-        max.y = glm::max(max.y, corner.y);
-        max.z = glm::max(max.z, corner.z);
+    const vec3 corners[] = {
+        nearCorners.bottomLeft, nearCorners.bottomRight, nearCorners.topLeft, nearCorners.topRight,
+        farCorners.bottomLeft, farCorners.bottomRight, farCorners.topLeft, farCorners.topRight
     };
-    fitFrustum(nearCorners.bottomRight);
-    fitFrustum(nearCorners.topLeft);
-    fitFrustum(nearCorners.topRight);
-    fitFrustum(farCorners.bottomLeft);
-    fitFrustum(farCorners.bottomRight);
-    fitFrustum(farCorners.topLeft);
-    fitFrustum(farCorners.topRight);
+    vec3 center { 0.0f };
+    for (const auto& corner : corners) {
+        center += corner;
+    }
+    center /= (float)(sizeof(corners) / sizeof(corners[0]));
+    float radius = 0.0f;
+    for (const auto& corner : corners) {
+        radius = glm::max(radius, glm::distance(center, corner));
+    }
 
-    glm::mat4 ortho = glm::ortho<float>(min.x, max.x, min.y, max.y, -max.z, -min.z);
-    _frustum->setProjection(ortho);
+    // Keep the previous frustum while it still covers the slice, so that the cached static shadows stay valid
+    const float neededRadius = radius * (1.0f + FRUSTUM_MARGIN);
+    bool isCovered = (direction == cascade._direction) &&
+        (glm::distance(center, cascade._center) + radius <= cascade._radius) &&
+        (cascade._radius <= neededRadius * (1.0f + FRUSTUM_MARGIN));
+    if (!isCovered) {
+        // Snap the center to the shadow map texels in light space so that the shadow edges do not crawl
+        const float texelSize = 2.0f * neededRadius / (float)MAP_SIZE;
+        vec3 lightCenter = glm::inverse(orientation) * center;
+        lightCenter.x = glm::floor(lightCenter.x / texelSize) * texelSize;
+        lightCenter.y = glm::floor(lightCenter.y / texelSize) * texelSize;
+        cascade._center = orientation * lightCenter;
+        cascade._radius = neededRadius;
+        cascade._direction = direction;
+    }
 
-    // Calculate the frustum's internal state
-    _frustum->calculate();
+    // Position the keylight frustum far enough to catch the casters between the light and the slice
+    const float distance = cascade._radius + farDepth;
+    cascade._frustum->setPosition(cascade._center - distance * direction);
 
-    // Update the buffer
-    _schemaBuffer.edit<Schema>().projection = ortho;
-    _schemaBuffer.edit<Schema>().viewInverse = viewInverse.getMatrix();
-}
+    const Transform view{ cascade._frustum->getView()};
+    const Transform viewInverse{ view.getInverseMatrix() };
 
-const glm::mat4& LightStage::Shadow::getView() const {
-    return _frustum->getView();
-}
+    glm::mat4 ortho = glm::ortho<float>(-cascade._radius, cascade._radius, -cascade._radius, cascade._radius, 0.0f, distance + cascade._radius);
+    cascade._frustum->setProjection(ortho);
 
-const glm::mat4& LightStage::Shadow::getProjection() const {
-    return _frustum->getProjection();
+    // Calculate the frustum's internal state
+    cascade._frustum->calculate();
+
+    // Update the buffer, the texture coordinates are in [0, 1] for the cascade
+    static const glm::mat4 TEXCOORD_MATRIX {
+        0.5f, 0.0f, 0.0f, 0.0f,
+        0.0f, 0.5f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.5f, 0.0f,
+        0.5f, 0.5f, 0.5f, 1.0f };
+    _schemaBuffer.edit<Schema>().reprojections[cascadeIndex] = TEXCOORD_MATRIX * ortho * viewInverse.getMatrix();
 }
 
 LightStage::Index LightStage::findLight(const LightPointer& light) const {
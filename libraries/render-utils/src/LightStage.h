@@ -38,16 +38,38 @@ public:
     class Shadow {
     public:
         using UniformBufferView = gpu::BufferView;
+        // The size of each cascade, they are laid out 2 by 2 in the shadow map
         static const int MAP_SIZE = 1024;
+        static const int CASCADE_COUNT = 4;
+        static const int ATLAS_SIZE = 2 * MAP_SIZE;
 
-        Shadow(model::LightPointer light);
+        class Cascade {
+        public:
+            Cascade();
+
+            const std::shared_ptr<ViewFrustum>& getFrustum() const { return _frustum; }
+
+            const glm::mat4& getView() const;
+            const glm::mat4& getProjection() const;
+
+        protected:
+            friend class Shadow;
 
-        void setKeylightFrustum(const ViewFrustum& viewFrustum, float nearDepth, float farDepth);
+            std::shared_ptr<ViewFrustum> _frustum;
+
+            // The covered sphere and light direction, the frustum only moves when the view leaves them
+            glm::vec3 _center;
+            float _radius { 0.0f };
+            glm::vec3 _direction;
+        };
+
+        Shadow(model::LightPointer light);
 
-        const std::shared_ptr<ViewFrustum> getFrustum() const { return _frustum; }
+        // Fits the cascade to the slice of the view frustum between the depths
+        void setKeylightFrustum(int cascadeIndex, const ViewFrustum& viewFrustum, float nearDepth, float farDepth);
 
-        const glm::mat4& getView() const;
-        const glm::mat4& getProjection() const;
+        const Cascade& getCascade(int cascadeIndex) const { return _cascades[cascadeIndex]; }
+        static glm::ivec4 getCascadeViewport(int cascadeIndex);
 
         const UniformBufferView& getBuffer() const { return _schemaBuffer; }
 
@@ -55,15 +77,17 @@ public:
         gpu::TexturePointer map;
     protected:
         model::LightPointer _light;
-        std::shared_ptr<ViewFrustum> _frustum;
+        Cascade _cascades[CASCADE_COUNT];
 
         class Schema {
         public:
-            glm::mat4 projection;
-            glm::mat4 viewInverse;
+            // From the world to the shadow texture coordinates of each cascade, before its placement in the map
+            glm::mat4 reprojections[CASCADE_COUNT];
 
             glm::float32 bias = 0.005f;
-            glm::float32 scale = 1 / MAP_SIZE;
+            glm::float32 scale = 1.0f / ATLAS_SIZE;
+            glm::int32 cascadeCount = CASCADE_COUNT;
+            glm::float32 spare = 0.0f;
         };
         UniformBufferView _schemaBuffer = nullptr;
         
@@ -11,6 +11,10 @@
 
 #include "MeshPartPayload.h"
 
+#include <functional>
+#include <limits>
+#include <string>
+
 #include <PerfStat.h>
 
 #include "DeferredLightingEffect.h"
@@ -58,6 +62,11 @@ void MeshPartPayload::updateMeshPart(const std::shared_ptr<const model::Mesh>& d
         _hasColorAttrib = vertexFormat->hasAttribute(gpu::Stream::COLOR);
         _drawPart = _drawMesh->getPartBuffer().get<model::Mesh::Part>(partIndex);
         _localBound = _drawMesh->evalPartBound(partIndex);
+
+        _lodParts.clear();
+        for (int lod = 0; lod < _drawMesh->getNumLODs(); lod++) {
+            _lodParts.push_back(_drawMesh->getLODPart(lod, partIndex));
+        }
     }
 }
 
@@ -114,8 +123,50 @@ ShapeKey MeshPartPayload::getShapeKey() const {
     return builder.build();
 }
 
-void MeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+// The level of detail after the part is drawn when the radius of the bound is under this fraction of the half height of
+// the view, each next level under half the size of the previous
+static const float LOD_SCREEN_SIZE = 0.125f;
+// A level is left when the size goes this fraction past its threshold
+static const float LOD_HYSTERESIS = 0.1f;
+static const int SHADOW_LOD_BIAS = 1;
+
+const model::Mesh::Part& MeshPartPayload::evalLODPart(RenderArgs* args) const {
+    if (_lodParts.empty() || !args || !args->hasViewFrustum()) {
+        return _drawPart;
+    }
+
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    const glm::mat4& projection = viewFrustum.getProjection();
+    float radius = 0.5f * glm::length(_worldBound.getDimensions());
+    float screenSize = radius * projection[1][1];
+    const bool isPerspective = projection[3][3] == 0.0f;
+    if (isPerspective) {
+        float distance = glm::distance(viewFrustum.getPosition(), _worldBound.calcCenter());
+        screenSize = (distance > radius ? screenSize / distance : std::numeric_limits<float>::max());
+    }
+
+    const bool isShadow = args->_renderMode == RenderArgs::SHADOW_RENDER_MODE;
+    int& lodLevel = _lodLevels[isShadow ? 1 : 0];
+    const int numLevels = (int)_lodParts.size() + 1;
+
+    // the threshold between the level and the next is LOD_SCREEN_SIZE / 2^level
+    int level = std::min(lodLevel, numLevels - 1);
+    while (level > 0 && screenSize > LOD_SCREEN_SIZE * (1.0f + LOD_HYSTERESIS) / (float)(1 << (level - 1))) {
+        level--;
+    }
+    while (level < numLevels - 1 && screenSize < LOD_SCREEN_SIZE * (1.0f - LOD_HYSTERESIS) / (float)(1 << level)) {
+        level++;
+    }
+    lodLevel = level;
+
+    if (isShadow) {
+        level = std::min(level + SHADOW_LOD_BIAS, numLevels - 1);
+    }
+    return (level == 0 ? _drawPart : _lodParts[level - 1]);
+}
+
+void MeshPartPayload::drawCall(gpu::Batch& batch, const model::Mesh::Part& drawPart) const {
+    batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
 }
 
 void MeshPartPayload::bindMesh(gpu::Batch& batch) const {
@@ -291,14 +342,15 @@ void MeshPartPayload::render(RenderArgs* args) const {
     }
 
     // Draw!
+    const model::Mesh::Part& drawPart = evalLODPart(args);
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, drawPart);
     }
 
     if (args) {
         const int INDICES_PER_TRIANGLE = 3;
-        args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+        args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
     }
 }
 
@@ -373,11 +425,13 @@ void ModelMeshPartPayload::notifyLocationChanged() {
 }
 
 void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& renderTransform, const Transform& boundTransform,
-        const gpu::BufferPointer& buffer) {
+        const gpu::BufferPointer& buffer, const gpu::BufferPointer& jointBuffer, const gpu::BufferPointer& clusterBindBuffer) {
     _transform = renderTransform;
     _worldBound = _adjustedLocalBound;
     _worldBound.transform(boundTransform);
     _clusterBuffer = buffer;
+    _jointBuffer = jointBuffer;
+    _clusterBindBuffer = clusterBindBuffer;
 }
 
 ItemKey ModelMeshPartPayload::getKey() const {
@@ -396,6 +450,11 @@ ItemKey ModelMeshPartPayload::getKey() const {
         builder.withDeformed();
     }
 
+    // The deformed and animated parts are not cached in the static shadow map
+    if (_isBlendShaped || _isSkinned || (_model->isLoaded() && _model->getFBXGeometry().joints.size() > 1)) {
+        builder.withDynamic();
+    }
+
     if (_drawMaterial) {
         auto matKey = _drawMaterial->getKey();
         if (matKey.isTranslucent()) {
@@ -525,12 +584,26 @@ void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) const {
 
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const {
     // Still relying on the raw data from the model
-    if (_clusterBuffer) {
-        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _clusterBuffer);
+    if (canSkinFromJoints(locations)) {
+        batch.setResourceTextureBuffer(ShapePipeline::Slot::MAP::SKIN_JOINTS, _jointBuffer);
+        batch.setResourceTextureBuffer(ShapePipeline::Slot::MAP::SKIN_CLUSTER_BINDS, _clusterBindBuffer);
+        batch._glUniform1i(locations->skinJointStrideLocation, (int)(_jointBuffer->getSize() / sizeof(glm::mat4)));
+    } else {
+        if (locations->skinJointStrideLocation >= 0) {
+            batch._glUniform1i(locations->skinJointStrideLocation, 0);
+        }
+        if (_clusterBuffer) {
+            batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::SKINNING, _clusterBuffer);
+        }
     }
     batch.setModelTransform(_transform);
 }
 
+bool ModelMeshPartPayload::canSkinFromJoints(const ShapePipeline::LocationsPointer& locations) const {
+    return _jointBuffer && _clusterBindBuffer && _jointBuffer->getSize() > 0 && locations->skinJointBufferUnit >= 0 &&
+        locations->skinClusterBindBufferUnit >= 0 && locations->skinJointStrideLocation >= 0;
+}
+
 float ModelMeshPartPayload::computeFadeAlpha() const {
     if (_fadeState == FADE_WAITING_TO_START) {
         return 0.0f;
@@ -582,6 +655,15 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     auto locations =  args->_pipeline->locations;
     assert(locations);
 
+    const model::Mesh::Part& drawPart = evalLODPart(args);
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
+
+    if (canRenderInstanced(locations)) {
+        renderInstanced(args, drawPart);
+        return;
+    }
+
     bindTransform(batch, locations, args->_renderMode);
 
     //Bind the index buffer and vertex buffer and Blend shapes if needed
@@ -595,11 +677,69 @@ void ModelMeshPartPayload::render(RenderArgs* args) const {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, drawPart);
     }
+}
 
-    const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+static const size_t INSTANCE_CLUSTER_BUFFER = 0;
+
+bool ModelMeshPartPayload::canRenderInstanced(const ShapePipeline::LocationsPointer& locations) const {
+    // the blended vertices and the fade color belong to the one model
+    return _clusterBuffer && !_isBlendShaped && _fadeState == FADE_COMPLETE &&
+        locations->skinClusterInstanceBufferUnit >= 0 && locations->skinClusterInstanceStrideLocation >= 0;
+}
+
+size_t ModelMeshPartPayload::evalMaterialHash() const {
+    // the models of a geometry have their own copies of its materials, sharing the texture maps
+    std::string signature;
+    if (_drawMaterial) {
+        for (const auto* bufferView : { &_drawMaterial->getSchemaBuffer(), &_drawMaterial->getTexMapArrayBuffer() }) {
+            if (bufferView->_buffer) {
+                signature.append(reinterpret_cast<const char*>(bufferView->_buffer->getData() + bufferView->_offset), bufferView->_size);
+            }
+        }
+        for (const auto& textureMap : _drawMaterial->getTextureMaps()) {
+            signature.append(std::to_string(textureMap.first) + "_" + std::to_string(reinterpret_cast<uintptr_t>(textureMap.second.get())));
+        }
+    }
+    return std::hash<std::string>()(signature);
+}
+
+void ModelMeshPartPayload::renderInstanced(RenderArgs* args, const model::Mesh::Part& drawPart) const {
+    gpu::Batch& batch = *(args->_batch);
+    const ShapePipelinePointer pipeline = args->_pipeline;
+
+    // The parts drawn the same way with the same level of detail of the same mesh are one instanced draw
+    std::string instanceName = "skinned_mesh_part_" + std::to_string(reinterpret_cast<uintptr_t>(_drawMesh.get())) + "_" +
+        std::to_string(drawPart._startIndex) + "_" + std::to_string(std::hash<ShapePipelinePointer>()(pipeline)) + "_" +
+        std::to_string(evalMaterialHash());
+
+    // the cluster matrices of the instance after the ones of the previous instances
+    batch.getNamedBuffer(instanceName, INSTANCE_CLUSTER_BUFFER)->append(_clusterBuffer->getSize(), _clusterBuffer->getData());
+
+    // the model transform is captured in the draw call info of the instance
+    batch.setModelTransform(_transform);
+
+    const int numClusters = (int)(_clusterBuffer->getSize() / sizeof(glm::mat4));
+    const bool enableTextures = args->_enableTexturing;
+
+    // The named calls run when the batch is appended to the frame, while the payloads being rendered are still alive
+    batch.setupNamedCalls(instanceName, [this, pipeline, drawPart, numClusters, enableTextures](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        const auto& locations = pipeline->locations;
+        batch.setPipeline(pipeline->pipeline);
+        pipeline->prepare(batch);
+
+        bindMesh(batch);
+        bindMaterial(batch, locations, enableTextures);
+
+        batch.setResourceTextureBuffer(ShapePipeline::Slot::MAP::SKIN_CLUSTER_INSTANCES, data.buffers[INSTANCE_CLUSTER_BUFFER]);
+        batch._glUniform1i(locations->skinClusterInstanceStrideLocation, numClusters);
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
+
+        // back to the cluster buffer of the model for the other draws of the pipeline
+        batch._glUniform1i(locations->skinClusterInstanceStrideLocation, 0);
+        batch.setResourceTextureBuffer(ShapePipeline::Slot::MAP::SKIN_CLUSTER_INSTANCES, nullptr);
+    });
 }
 
 void ModelMeshPartPayload::computeAdjustedLocalBound(const QVector<glm::mat4>& clusterMatrices) {
@@ -49,7 +49,7 @@ public:
     virtual void render(RenderArgs* args) const;
 
     // ModelMeshPartPayload functions to perform render
-    void drawCall(gpu::Batch& batch) const;
+    void drawCall(gpu::Batch& batch, const model::Mesh::Part& drawPart) const;
     virtual void bindMesh(gpu::Batch& batch) const;
     virtual void bindMaterial(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations, bool enableTextures) const;
     virtual void bindTransform(gpu::Batch& batch, const render::ShapePipeline::LocationsPointer locations, RenderArgs::RenderMode renderMode) const;
@@ -68,10 +68,21 @@ public:
     std::shared_ptr<const model::Material> _drawMaterial;
     model::Mesh::Part _drawPart;
 
+    // The part in the simplified levels of detail of the mesh, from the finest
+    std::vector<model::Mesh::Part> _lodParts;
+
+    // Picks the level of detail of the part from the size the bound covers in the view, with some hysteresis. The
+    // shadows draw a coarser level than the view does.
+    const model::Mesh::Part& evalLODPart(RenderArgs* args) const;
+
     size_t getVerticesCount() const { return _drawMesh ? _drawMesh->getNumVertices() : 0; }
     size_t getMaterialTextureSize() { return _drawMaterial ? _drawMaterial->getTextureSize() : 0; }
     int getMaterialTextureCount() { return _drawMaterial ? _drawMaterial->getTextureCount() : 0; }
     bool hasTextureInfo() const { return _drawMaterial ? _drawMaterial->hasTextureInfo() : false; }
+
+private:
+    // The level of detail last drawn in the view and in the shadow, 0 for the part itself
+    mutable int _lodLevels[2] { 0, 0 };
 };
 
 namespace render {
@@ -91,7 +102,9 @@ public:
     void notifyLocationChanged() override;
     void updateTransformForSkinnedMesh(const Transform& renderTransform,
             const Transform& boundTransform,
-            const gpu::BufferPointer& buffer);
+            const gpu::BufferPointer& buffer,
+            const gpu::BufferPointer& jointBuffer = gpu::BufferPointer(),
+            const gpu::BufferPointer& clusterBindBuffer = gpu::BufferPointer());
 
     float computeFadeAlpha() const;
 
@@ -107,9 +120,21 @@ public:
 
     void initCache();
 
+    // The skinned parts are drawn instanced with the same parts of the other models sharing their mesh, each instance
+    // reading its cluster matrices from a texture buffer of the batch
+    bool canRenderInstanced(const render::ShapePipeline::LocationsPointer& locations) const;
+    void renderInstanced(RenderArgs* args, const model::Mesh::Part& drawPart) const;
+    size_t evalMaterialHash() const;
+
     void computeAdjustedLocalBound(const QVector<glm::mat4>& clusterMatrices);
 
+    // The parts drawn one by one skin from the joint matrices of the model and the bind matrices of the clusters of
+    // their mesh when the model provides them, instead of uploading the cluster matrices of each mesh
+    bool canSkinFromJoints(const render::ShapePipeline::LocationsPointer& locations) const;
+
     gpu::BufferPointer _clusterBuffer;
+    gpu::BufferPointer _jointBuffer;
+    gpu::BufferPointer _clusterBindBuffer;
     Model* _model;
 
     int _meshIndex;
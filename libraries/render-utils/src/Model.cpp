@@ -21,6 +21,7 @@
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
+#include <gpu/Context.h>
 
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
@@ -29,6 +30,8 @@
 #include "RenderUtilsLogging.h"
 #include <Trace.h>
 
+#include "model_blendshapes_comp.h"
+
 using namespace std;
 
 int nakedModelPointerTypeId = qRegisterMetaType<ModelPointer>();
@@ -249,7 +252,8 @@ void Model::updateRenderItems() {
                         if (state.clusterMatrices.size() == 1) {
                             renderTransform = modelTransform.worldTransform(Transform(state.clusterMatrices[0]));
                         }
-                        data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer);
+                        data.updateTransformForSkinnedMesh(renderTransform, modelTransform, state.clusterBuffer,
+                                                           data._model->getJointBuffer(), state.clusterBindBuffer);
                     }
                 }
             });
@@ -304,6 +308,19 @@ bool Model::updateGeometry() {
         foreach (const FBXMesh& mesh, fbxGeometry.meshes) {
             MeshState state;
             state.clusterMatrices.resize(mesh.clusters.size());
+            if (mesh.clusters.size() > 1) {
+                // five texels per cluster, as read by Skinning.slh
+                QVector<glm::vec4> clusterBinds;
+                clusterBinds.reserve(mesh.clusters.size() * 5);
+                foreach (const FBXCluster& cluster, mesh.clusters) {
+                    for (int column = 0; column < 4; column++) {
+                        clusterBinds.push_back(cluster.inverseBindMatrix[column]);
+                    }
+                    clusterBinds.push_back(glm::vec4((float)cluster.jointIndex, 0.0f, 0.0f, 0.0f));
+                }
+                state.clusterBindBuffer = std::make_shared<gpu::Buffer>(clusterBinds.size() * sizeof(glm::vec4),
+                                                                        (const gpu::Byte*) clusterBinds.constData());
+            }
             _meshStates.append(state);
 
             // Note: we add empty buffers for meshes that lack blendshapes so we can access the buffers by index
@@ -531,6 +548,9 @@ void Model::calculateTriangleSets() {
                 }
             }
         }
+
+        // precision picks walk this tree instead of every triangle of the mesh
+        _modelSpaceMeshTriangleSets[i].buildTree();
     }
 }
 
@@ -817,6 +837,21 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    _loadingPriority = priority;
+    auto& resource = _renderWatcher.getResource();
+    if (resource) {
+        resource->setLoadPriority(this, _loadingPriority);
+    }
+}
+
+void Model::cancelLoading() {
+    auto& resource = _renderWatcher.getResource();
+    if (resource) {
+        resource->clearLoadPriority(this);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
@@ -1068,13 +1103,31 @@ void Model::updateClusterMatrices() {
     }
     _needsUpdateClusterMatrices = false;
     const FBXGeometry& geometry = getFBXGeometry();
+
+    // The skinned parts drawn one by one compute their cluster matrices from the joint matrices in the vertex shader,
+    // so only the joints are uploaded. The cluster matrices are still computed for the bounds of the parts and for the
+    // parts drawn instanced, which copy them in the batch.
+    _jointMatrices.resize(geometry.joints.size());
+    for (int i = 0; i < _jointMatrices.size(); i++) {
+        _jointMatrices[i] = _rig->getJointTransform(i);
+    }
+    if (!_jointBuffer) {
+        _jointBuffer = std::make_shared<gpu::Buffer>(_jointMatrices.size() * sizeof(glm::mat4),
+                                                     (const gpu::Byte*) _jointMatrices.constData());
+    } else {
+        _jointBuffer->setSubData(0, _jointMatrices.size() * sizeof(glm::mat4), (const gpu::Byte*) _jointMatrices.constData());
+    }
+
     for (int i = 0; i < _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
         const FBXMesh& mesh = geometry.meshes.at(i);
         for (int j = 0; j < mesh.clusters.size(); j++) {
             const FBXCluster& cluster = mesh.clusters.at(j);
-            auto jointMatrix = _rig->getJointTransform(cluster.jointIndex);
-            glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, state.clusterMatrices[j]);
+            if (cluster.jointIndex >= 0 && cluster.jointIndex < _jointMatrices.size()) {
+                glm_mat4u_mul(_jointMatrices[cluster.jointIndex], cluster.inverseBindMatrix, state.clusterMatrices[j]);
+            } else {
+                state.clusterMatrices[j] = cluster.inverseBindMatrix;
+            }
         }
 
         // Once computed the cluster matrices, update the buffer(s)
@@ -1127,6 +1180,62 @@ bool Model::maybeStartBlender() {
     return false;
 }
 
+bool Model::maybeStartGPUBlender() {
+    if (!isLoaded() || !getFBXGeometry().hasBlendedMeshes()) {
+        return false;
+    }
+    const FBXGeometry& fbxGeometry = getFBXGeometry();
+    const auto& blendshapeBuffers = _renderGeometry->getBlendshapeBuffers();
+    if (_blendedVertexBuffers.size() != (size_t)fbxGeometry.meshes.size()) {
+        return false;
+    }
+    for (int i = 0; i < fbxGeometry.meshes.size(); i++) {
+        if (!fbxGeometry.meshes.at(i).blendshapes.isEmpty() && !blendshapeBuffers[i]) {
+            return false;
+        }
+    }
+    // The results of the CPU blends still running are older
+    _appliedBlendNumber = ++_blendNumber;
+    return true;
+}
+
+static const uint32_t MODEL_BLENDSHAPES_GROUP_SIZE = 64;
+
+void Model::recordGPUBlend(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const QVector<float>& coefficients) {
+    if (!isLoaded()) {
+        return;
+    }
+    const auto& blendshapeBuffers = _renderGeometry->getBlendshapeBuffers();
+    if (_blendedVertexBuffers.size() != blendshapeBuffers.size()) {
+        return;
+    }
+
+    // Never empty, so it can always be bound
+    const float NO_COEFFICIENT = 0.0f;
+    if (!_blendshapeCoefficientsBuffer) {
+        _blendshapeCoefficientsBuffer = std::make_shared<gpu::Buffer>();
+    }
+    if (coefficients.isEmpty()) {
+        _blendshapeCoefficientsBuffer->setData(sizeof(float), (const gpu::Byte*)&NO_COEFFICIENT);
+    } else {
+        _blendshapeCoefficientsBuffer->setData(coefficients.size() * sizeof(float), (const gpu::Byte*)coefficients.constData());
+    }
+
+    batch.setPipeline(pipeline);
+    batch.setResourceBuffer(3, _blendshapeCoefficientsBuffer);
+    for (size_t i = 0; i < blendshapeBuffers.size(); i++) {
+        const auto& buffers = blendshapeBuffers[i];
+        if (!buffers) {
+            continue;
+        }
+        batch.setResourceBuffer(0, buffers->offsets);
+        batch.setResourceBuffer(1, buffers->deltas);
+        batch.setResourceBuffer(2, buffers->vertices);
+        batch.setResourceBuffer(4, _blendedVertexBuffers[i]);
+        batch.dispatch((buffers->numVertices + MODEL_BLENDSHAPES_GROUP_SIZE - 1) / MODEL_BLENDSHAPES_GROUP_SIZE);
+    }
+}
+
 void Model::setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
         const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
     auto geometryRef = geometry.lock();
@@ -1155,6 +1264,7 @@ void Model::deleteGeometry() {
     _deleteGeometryCounter++;
     _blendedVertexBuffers.clear();
     _meshStates.clear();
+    _jointBuffer.reset();
     _rig->destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
     _renderGeometry.reset();
@@ -1348,6 +1458,12 @@ ModelBlender::~ModelBlender() {
 }
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
+    if (_supportsGPUBlends && model->maybeStartGPUBlender()) {
+        Lock lock(_mutex);
+        _modelsRequiringGPUBlends[model] = model->getBlendshapeCoefficients();
+        return;
+    }
+
     if (_pendingBlenders < QThread::idealThreadCount()) {
         if (model->maybeStartBlender()) {
             _pendingBlenders++;
@@ -1381,3 +1497,42 @@ void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber,
     }
 }
 
+void ModelBlender::recordGPUBlends(gpu::Batch& batch, bool supportsComputeShaders) {
+    _supportsGPUBlends = supportsComputeShaders;
+    if (!supportsComputeShaders) {
+        return;
+    }
+
+    decltype(_modelsRequiringGPUBlends) modelsRequiringGPUBlends;
+    {
+        Lock lock(_mutex);
+        modelsRequiringGPUBlends.swap(_modelsRequiringGPUBlends);
+    }
+    if (modelsRequiringGPUBlends.empty()) {
+        return;
+    }
+
+    if (!_gpuBlendPipeline) {
+        auto cs = gpu::Shader::createCompute(std::string(model_blendshapes_comp));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(cs);
+        gpu::Shader::makeProgram(*program);
+        _gpuBlendPipeline = gpu::Pipeline::create(program, std::make_shared<gpu::State>());
+    }
+
+    for (const auto& blend : modelsRequiringGPUBlends) {
+        ModelPointer model = blend.first.lock();
+        if (model) {
+            model->recordGPUBlend(batch, _gpuBlendPipeline, blend.second);
+        }
+    }
+    for (int slot = 0; slot <= 4; slot++) {
+        batch.setResourceBuffer(slot, nullptr);
+    }
+}
+
+void BlendModelVertices::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext) {
+    RenderArgs* args = renderContext->args;
+    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+        DependencyManager::get<ModelBlender>()->recordGPUBlends(batch, args->_context->supportsComputeShaders());
+    });
+}
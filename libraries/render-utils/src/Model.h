@@ -25,6 +25,7 @@
 #include <DependencyManager.h>
 #include <GeometryUtil.h>
 #include <gpu/Batch.h>
+#include <render/Engine.h>
 #include <render/Scene.h>
 #include <Transform.h>
 #include <SpatiallyNestable.h>
@@ -110,6 +111,12 @@ public:
 
     bool maybeStartBlender();
 
+    /// Drops the pending CPU blends if the blendshapes can be blended on the GPU instead.
+    bool maybeStartGPUBlender();
+
+    /// Records the compute dispatches blending the vertices of the meshes with the coefficients.
+    void recordGPUBlend(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const QVector<float>& coefficients);
+
     /// Sets blended vertices computed in a separate thread.
     void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
         const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
@@ -231,7 +238,10 @@ public:
     virtual bool updateGeometry();
     void setCollisionMesh(model::MeshPointer mesh);
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    /// Sets the priority of loading the geometry, it follows the model while its geometry is loading
+    void setLoadingPriority(float priority);
+    /// Gives up the loading of the geometry, its download stops if no other model wants it
+    void cancelLoading();
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -243,9 +253,13 @@ public:
     public:
         QVector<glm::mat4> clusterMatrices;
         gpu::BufferPointer clusterBuffer;
+        // the inverse bind matrix and the joint index of each cluster, for the skinning from the joint matrices
+        gpu::BufferPointer clusterBindBuffer;
     };
 
     const MeshState& getMeshState(int index) { return _meshStates.at(index); }
+    // the joint matrices of the model, uploaded once for all its meshes
+    const gpu::BufferPointer& getJointBuffer() const { return _jointBuffer; }
 
     uint32_t getGeometryCounter() const { return _deleteGeometryCounter; }
     const QMap<render::ItemID, render::PayloadPointer>& getRenderItems() const { return _modelMeshRenderItems; }
@@ -307,6 +321,8 @@ protected:
     glm::vec3 _registrationPoint = glm::vec3(0.5f); /// the point in model space our center is snapped to
 
     QVector<MeshState> _meshStates;
+    QVector<glm::mat4> _jointMatrices;
+    gpu::BufferPointer _jointBuffer;
 
     virtual void initJointStates();
 
@@ -347,6 +363,7 @@ protected:
     bool _isVisible;
 
     gpu::Buffers _blendedVertexBuffers;
+    gpu::BufferPointer _blendshapeCoefficientsBuffer; // for the GPU blending
 
     QVector<QVector<QSharedPointer<Texture> > > _dilatedTextures;
 
@@ -425,6 +442,10 @@ public:
     /// Adds the specified model to the list requiring vertex blends.
     void noteRequiresBlend(ModelPointer model);
 
+    /// Records the GPU blends of the models noted since the last call, once the renderer supports compute shaders
+    /// the blends go there instead of the CPU Blender.
+    void recordGPUBlends(gpu::Batch& batch, bool supportsComputeShaders);
+
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
         const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
@@ -439,6 +460,19 @@ private:
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlends;
     int _pendingBlenders;
     Mutex _mutex;
+
+    // The coefficients are those of when the blend was noted
+    std::map<ModelWeakPointer, QVector<float>, std::owner_less<ModelWeakPointer>> _modelsRequiringGPUBlends;
+    std::atomic<bool> _supportsGPUBlends { false };
+    gpu::PipelinePointer _gpuBlendPipeline;
+};
+
+/// Blends the vertices of the models on the GPU, before anything is drawn
+class BlendModelVertices {
+public:
+    using JobModel = render::Job::Model<BlendModelVertices>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext);
 };
 
 
@@ -0,0 +1,126 @@
+//
+//  OcclusionDepthPass.cpp
+//  libraries/render-utils/src/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "OcclusionDepthPass.h"
+
+#include <QImage>
+
+#include <gpu/Context.h>
+#include <gpu/StandardShaderLib.h>
+
+#include "occlusionDepth_makeDepthMap_frag.h"
+
+const int OcclusionDepthPass_LinearDepthMapSlot = 0;
+
+// Small enough to read back without stalling and to test the items quickly, the item bounds cover a few texels
+static const int OCCLUSION_DEPTH_MAP_WIDTH = 128;
+static const int OCCLUSION_DEPTH_MAP_HEIGHT = 64;
+
+static const float MAX_PACKED_DEPTH = 16777215.0f;
+
+void OcclusionDepthPass::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    RenderArgs* args = renderContext->args;
+    const auto& linearDepthFramebuffer = inputs.get0();
+    const auto& occlusionDepthMap = inputs.get1();
+    if (!occlusionDepthMap) {
+        return;
+    }
+    if (!occlusionDepthMap->isRequested() || !linearDepthFramebuffer || args->_context->isStereo()) {
+        occlusionDepthMap->clear();
+        _hasDepthMap = false;
+        return;
+    }
+
+    if (!_depthMapFramebuffer) {
+        auto depthMapTexture = gpu::TexturePointer(gpu::Texture::createRenderBuffer(gpu::Element::COLOR_RGBA_32,
+            OCCLUSION_DEPTH_MAP_WIDTH, OCCLUSION_DEPTH_MAP_HEIGHT, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+        _depthMapFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionDepthMap"));
+        _depthMapFramebuffer->setRenderBuffer(0, depthMapTexture);
+    }
+
+    auto depthMapPipeline = getDepthMapPipeline();
+    auto linearDepthTexture = linearDepthFramebuffer->getLinearDepthTexture();
+    auto depthMapFramebuffer = _depthMapFramebuffer;
+    auto sourceRegion = glm::vec4(args->_viewport);
+    const glm::ivec2 depthMapSize(OCCLUSION_DEPTH_MAP_WIDTH, OCCLUSION_DEPTH_MAP_HEIGHT);
+
+    // The background is cleared to twice the far clip in the linear depth
+    const auto& viewFrustum = args->getViewFrustum();
+    const float maxDepth = viewFrustum.getFarClip() * 2.0f;
+
+    // The previous frame map, read back before being overwritten
+    bool hasDepthMap = _hasDepthMap;
+    glm::mat4 viewProjection = _depthMapViewProjection;
+    float depthScale = _depthMapMaxDepth / MAX_PACKED_DEPTH;
+    gpu::Context* context = args->_context.get();
+
+    gpu::doInBatch(args->_context, [=](gpu::Batch& batch) {
+        if (hasDepthMap) {
+            batch.runLambda([=] {
+                QImage image(depthMapSize.x, depthMapSize.y, QImage::Format_ARGB32);
+                context->downloadFramebuffer(depthMapFramebuffer, glm::ivec4(0, 0, depthMapSize.x, depthMapSize.y), image);
+
+                // The rows are as read from the framebuffer, the bottom one first
+                std::vector<float> depths(depthMapSize.x * depthMapSize.y);
+                for (int y = 0; y < depthMapSize.y; y++) {
+                    auto line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+                    for (int x = 0; x < depthMapSize.x; x++) {
+                        uint32_t packedDepth = qRed(line[x]) | (qGreen(line[x]) << 8) | (qBlue(line[x]) << 16);
+                        depths[y * depthMapSize.x + x] = packedDepth * depthScale;
+                    }
+                }
+                occlusionDepthMap->update(depthMapSize, std::move(depths), viewProjection);
+            });
+        }
+
+        batch.enableStereo(false);
+
+        batch.setViewportTransform(glm::ivec4(0, 0, depthMapSize.x, depthMapSize.y));
+        batch.setFramebuffer(depthMapFramebuffer);
+        batch.setPipeline(depthMapPipeline);
+        batch.setResourceTexture(OcclusionDepthPass_LinearDepthMapSlot, linearDepthTexture);
+        batch._glUniform4f(_sourceRegionLoc, sourceRegion.x, sourceRegion.y, sourceRegion.z, sourceRegion.w);
+        batch._glUniform2f(_depthMapSizeLoc, (float)depthMapSize.x, (float)depthMapSize.y);
+        batch._glUniform1f(_maxDepthLoc, maxDepth);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+
+        batch.setResourceTexture(OcclusionDepthPass_LinearDepthMapSlot, nullptr);
+    });
+
+    _hasDepthMap = true;
+    _depthMapViewProjection = viewFrustum.getProjection() * glm::inverse(viewFrustum.getView());
+    _depthMapMaxDepth = maxDepth;
+}
+
+const gpu::PipelinePointer& OcclusionDepthPass::getDepthMapPipeline() {
+    if (!_depthMapPipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(occlusionDepth_makeDepthMap_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("linearDepthMap"), OcclusionDepthPass_LinearDepthMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        _sourceRegionLoc = program->getUniforms().findLocation("sourceRegion");
+        _depthMapSizeLoc = program->getUniforms().findLocation("depthMapSize");
+        _maxDepthLoc = program->getUniforms().findLocation("maxDepth");
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+        state->setColorWriteMask(true, true, true, true);
+
+        _depthMapPipeline = gpu::Pipeline::create(program, state);
+    }
+
+    return _depthMapPipeline;
+}
@@ -0,0 +1,44 @@
+//
+//  OcclusionDepthPass.h
+//  libraries/render-utils/src/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OcclusionDepthPass_h
+#define hifi_OcclusionDepthPass_h
+
+#include <render/OcclusionCullTask.h>
+
+#include "SurfaceGeometryPass.h"
+
+// Reduces the linear depth of the frame to the farthest depth of a coarse grid, and reads it back into the occlusion
+// depth map of the cull task. The readback happens at the start of the next frame, once the GPU is done with it,
+// so the map lags a couple of frames behind. It is skipped in stereo.
+class OcclusionDepthPass {
+public:
+    using Inputs = render::VaryingSet2<LinearDepthFramebufferPointer, render::OcclusionDepthMapPointer>;
+    using JobModel = render::Job::ModelI<OcclusionDepthPass, Inputs>;
+
+    void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+private:
+    const gpu::PipelinePointer& getDepthMapPipeline();
+    gpu::PipelinePointer _depthMapPipeline;
+    int _sourceRegionLoc { -1 };
+    int _depthMapSizeLoc { -1 };
+    int _maxDepthLoc { -1 };
+
+    gpu::FramebufferPointer _depthMapFramebuffer;
+
+    // Of the frame in the depth map framebuffer, waiting to be read back
+    bool _hasDepthMap { false };
+    glm::mat4 _depthMapViewProjection;
+    float _depthMapMaxDepth { 1.0f };
+};
+
+#endif // hifi_OcclusionDepthPass_h
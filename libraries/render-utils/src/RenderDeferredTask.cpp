@@ -30,6 +30,8 @@
 #include "DeferredFramebuffer.h"
 #include "DeferredLightingEffect.h"
 #include "SurfaceGeometryPass.h"
+#include "OcclusionDepthPass.h"
+#include "FoveatedRendering.h"
 #include "FramebufferCache.h"
 #include "HitEffect.h"
 #include "TextureCache.h"
@@ -62,6 +64,7 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     const auto overlayTransparents = items[RenderFetchCullSortTask::OVERLAY_TRANSPARENT_SHAPE];
     const auto background = items[RenderFetchCullSortTask::BACKGROUND];
     const auto spatialSelection = items[RenderFetchCullSortTask::SPATIAL_SELECTION];
+    const auto occlusionDepthMap = items[RenderFetchCullSortTask::OCCLUSION_DEPTH_MAP];
 
     // Filter the non antialiaased overlays
     const int LAYER_NO_AA = 3;
@@ -89,6 +92,9 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     // Once opaque is all rendered create stencil background
     addJob<DrawStencilDeferred>("DrawOpaqueStencil", deferredFramebuffer);
 
+    // Out of the full rate region of an HMD, mask the opaque pixels the lighting can skip
+    addJob<DrawFoveationStencil>("DrawFoveationStencil", deferredFramebuffer);
+
     addJob<EndGPURangeTimer>("OpaqueRangeTimer", opaqueRangeTimer);
 
 
@@ -98,6 +104,10 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     const auto linearDepthPassInputs = LinearDepthPass::Inputs(deferredFrameTransform, deferredFramebuffer).hasVarying();
     const auto linearDepthPassOutputs = addJob<LinearDepthPass>("LinearDepth", linearDepthPassInputs);
     const auto linearDepthTarget = linearDepthPassOutputs.getN<LinearDepthPass::Outputs>(0);
+
+    // Occlusion depth map of the next frames culling
+    const auto occlusionDepthPassInputs = OcclusionDepthPass::Inputs(linearDepthTarget, occlusionDepthMap).hasVarying();
+    addJob<OcclusionDepthPass>("OcclusionDepth", occlusionDepthPassInputs);
     
     // Curvature pass
     const auto surfaceGeometryPassInputs = SurfaceGeometryPass::Inputs(deferredFrameTransform, deferredFramebuffer, linearDepthTarget).hasVarying();
@@ -135,6 +145,9 @@ RenderDeferredTask::RenderDeferredTask(RenderFetchCullSortTask::Output items) {
     // Use Stencil and draw background in Lighting buffer to complete filling in the opaque
     const auto backgroundInputs = DrawBackgroundDeferred::Inputs(background, lightingModel).hasVarying();
     addJob<DrawBackgroundDeferred>("DrawBackgroundDeferred", backgroundInputs);
+
+    // Rebuild the lighting of the masked pixels from their neighbours, background included
+    addJob<FillFoveatedLighting>("FillFoveatedLighting", deferredFramebuffer);
    
     
     // Render transparent objects forward in LightingBuffer
@@ -276,6 +289,13 @@ void DrawDeferred::run(const SceneContextPointer& sceneContext, const RenderCont
     config->setNumDrawn((int)inItems.size());
 }
 
+void DrawStateSortDeferred::configure(const Config& config) {
+    _maxDrawn = config.maxDrawn;
+    _stateSort = config.stateSort;
+    _parallelRecording = config.parallelRecording;
+    _itemsPerBatch = std::max(1, config.itemsPerBatch);
+}
+
 void DrawStateSortDeferred::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -287,40 +307,35 @@ void DrawStateSortDeferred::run(const SceneContextPointer& sceneContext, const R
 
     RenderArgs* args = renderContext->args;
 
-    gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
+    glm::mat4 projMat;
+    Transform viewMat;
+    args->getViewFrustum().evalProjectionMatrix(projMat);
+    args->getViewFrustum().evalViewTransform(viewMat);
 
+    // From the lighting model define a global shapKey ORED with individiual keys
+    ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
+    ShapeKey globalKey = keyBuilder.build();
+    args->_globalShapeKey = globalKey._flags.to_ulong();
+
+    // Called on every batch the items are recorded in
+    auto setupBatch = [&](gpu::Batch& batch) {
         // Setup camera, projection and viewport for all items
         batch.setViewportTransform(args->_viewport);
         batch.setStateScissorRect(args->_viewport);
 
-        glm::mat4 projMat;
-        Transform viewMat;
-        args->getViewFrustum().evalProjectionMatrix(projMat);
-        args->getViewFrustum().evalViewTransform(viewMat);
-
         batch.setProjectionTransform(projMat);
         batch.setViewTransform(viewMat);
 
         // Setup lighting model for all items;
         batch.setUniformBuffer(render::ShapePipeline::Slot::LIGHTING_MODEL, lightingModel->getParametersBuffer());
+    };
 
-        // From the lighting model define a global shapKey ORED with individiual keys
-        ShapeKey::Builder keyBuilder;
-        if (lightingModel->isWireframeEnabled()) {
-            keyBuilder.withWireframe();
-        }
-        ShapeKey globalKey = keyBuilder.build();
-        args->_globalShapeKey = globalKey._flags.to_ulong();
-
-        if (_stateSort) {
-            renderStateSortShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        } else {
-            renderShapes(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        }
-        args->_batch = nullptr;
-        args->_globalShapeKey = 0;
-    });
+    const size_t itemsPerBatch = _parallelRecording ? (size_t)_itemsPerBatch : inItems.size();
+    renderShapesInBatches(sceneContext, renderContext, _shapePlumber, inItems, _maxDrawn, _stateSort, itemsPerBatch, setupBatch, globalKey);
+    args->_globalShapeKey = 0;
 
     config->setNumDrawn((int)inItems.size());
 }
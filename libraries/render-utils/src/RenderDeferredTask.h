@@ -86,6 +86,8 @@ class DrawStateSortConfig : public render::Job::Config {
         Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
         Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
         Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+        Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
+        Q_PROPERTY(int itemsPerBatch MEMBER itemsPerBatch NOTIFY dirty)
 public:
 
     int getNumDrawn() { return numDrawn; }
@@ -94,6 +96,10 @@ public:
     int maxDrawn{ -1 };
     bool stateSort{ true };
 
+    // Record the items in batches on the concurrent job workers, the item payloads must be safe to render concurrently
+    bool parallelRecording{ false };
+    int itemsPerBatch{ 512 };
+
 signals:
     void numDrawnChanged();
     void dirty();
@@ -111,13 +117,15 @@ public:
 
     DrawStateSortDeferred(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
 
-    void configure(const Config& config) { _maxDrawn = config.maxDrawn; _stateSort = config.stateSort; }
+    void configure(const Config& config);
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn; // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
+    int _itemsPerBatch;
 };
 
 class DeferredFramebuffer;
@@ -192,11 +200,21 @@ public:
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& srcFramebuffer);
 };
 
+class RenderDeferredTaskConfig : public render::Task::Config {
+    Q_OBJECT
+public:
+    // Enabled unless the forward task renders the frame instead
+    RenderDeferredTaskConfig() : render::Task::Config(true) {}
+};
+
 class RenderDeferredTask : public render::Task {
 public:
-    using JobModel = Model<RenderDeferredTask>;
+    using Config = RenderDeferredTaskConfig;
+    using JobModel = Model<RenderDeferredTask, Config>;
 
     RenderDeferredTask(RenderFetchCullSortTask::Output items);
+
+    void configure(const Config& config) {}
 };
 
 #endif // hifi_RenderDeferredTask_h
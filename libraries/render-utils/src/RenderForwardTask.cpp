@@ -19,8 +19,11 @@
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
 
+#include "DeferredFrameTransform.h"
+#include "DeferredLightingEffect.h"
 #include "FramebufferCache.h"
 #include "TextureCache.h"
+#include "ToneMappingEffect.h"
 
 #include <gpu/StandardShaderLib.h>
 
@@ -44,17 +47,44 @@ RenderForwardTask::RenderForwardTask(RenderFetchCullSortTask::Output items) {
     const auto background = items[RenderFetchCullSortTask::BACKGROUND];
     const auto spatialSelection = items[RenderFetchCullSortTask::SPATIAL_SELECTION];
 
+    // Prepare the lighting model and cluster the local lights on the frustum, with no depth to refine the clusters
+    const auto deferredFrameTransform = addJob<GenerateDeferredFrameTransform>("DeferredFrameTransform");
+    const auto lightingModel = addJob<MakeLightingModel>("LightingModel");
+    addJob<DrawLight>("DrawLight", lights);
+    const auto lightClusteringPassInputs = LightClusteringPass::Inputs(deferredFrameTransform, lightingModel, LinearDepthFramebufferPointer()).hasVarying();
+    const auto lightClusters = addJob<LightClusteringPass>("LightClustering", lightClusteringPassInputs);
+
     const auto framebuffer = addJob<PrepareFramebuffer>("PrepareFramebuffer");
 
-    addJob<Draw>("DrawOpaques", opaques, shapePlumber);
+    const auto opaqueInputs = Draw::Inputs(opaques, lightingModel, lightClusters).hasVarying();
+    addJob<Draw>("DrawOpaques", opaqueInputs, shapePlumber);
     addJob<Stencil>("Stencil");
     addJob<DrawBackground>("DrawBackground", background);
 
+    // Transparents are lit the same way, on top of the background
+    const auto transparentInputs = Draw::Inputs(transparents, lightingModel, lightClusters).hasVarying();
+    addJob<Draw>("DrawTransparents", transparentInputs, shapePlumber);
+
     // Bounds do not draw on stencil buffer, so they must come last
     addJob<DrawBounds>("DrawBounds", opaques);
 
+    // Resolve the multisampled lighting as it is tone mapped in the primary framebuffer
+    const auto primaryFramebuffer = addJob<PreparePrimaryFramebuffer>("PreparePrimaryBuffer");
+    const auto toneMappingInputs = ToneMappingDeferred::Inputs(framebuffer, primaryFramebuffer).hasVarying();
+    addJob<ToneMappingDeferred>("ToneMapping", toneMappingInputs);
+
+    // Overlays
+    const auto overlayOpaquesInputs = DrawOverlay3D::Inputs(overlayOpaques, lightingModel).hasVarying();
+    const auto overlayTransparentsInputs = DrawOverlay3D::Inputs(overlayTransparents, lightingModel).hasVarying();
+    addJob<DrawOverlay3D>("DrawOverlay3DOpaque", overlayOpaquesInputs, true);
+    addJob<DrawOverlay3D>("DrawOverlay3DTransparent", overlayTransparentsInputs, false);
+
     // Blit!
-    addJob<Blit>("Blit", framebuffer);
+    addJob<Blit>("Blit", primaryFramebuffer);
+}
+
+void PrepareFramebuffer::configure(const Config& config) {
+    _numSamples = gpu::Texture::evalNumSamplesUsed(config.numSamples);
 }
 
 void PrepareFramebuffer::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
@@ -64,20 +94,21 @@ void PrepareFramebuffer::run(const SceneContextPointer& sceneContext, const Rend
     glm::uvec2 frameSize(framebufferSize.width(), framebufferSize.height());
 
     // Resizing framebuffers instead of re-building them seems to cause issues with threaded rendering
-    if (_framebuffer && _framebuffer->getSize() != frameSize) {
+    if (_framebuffer && (_framebuffer->getSize() != frameSize || (int)_framebuffer->getNumSamples() != _numSamples)) {
         _framebuffer.reset();
     }
 
     if (!_framebuffer) {
         _framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("forward"));
 
-        auto colorFormat = gpu::Element::COLOR_SRGBA_32;
+        // The lighting stays in HDR until the tone mapping resolves it, multisampled in place of the deferred AA
+        auto colorFormat = gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::R11G11B10);
         auto defaultSampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT);
-        auto colorTexture = gpu::TexturePointer(gpu::Texture::create2D(colorFormat, frameSize.x, frameSize.y, defaultSampler));
+        auto colorTexture = gpu::TexturePointer(gpu::Texture::createRenderBufferMultisample(colorFormat, frameSize.x, frameSize.y, _numSamples, defaultSampler));
         _framebuffer->setRenderBuffer(0, colorTexture);
 
         auto depthFormat = gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::DEPTH_STENCIL); // Depth24_Stencil8 texel format
-        auto depthTexture = gpu::TexturePointer(gpu::Texture::create2D(depthFormat, frameSize.x, frameSize.y, defaultSampler));
+        auto depthTexture = gpu::TexturePointer(gpu::Texture::createRenderBufferMultisample(depthFormat, frameSize.x, frameSize.y, _numSamples, defaultSampler));
         _framebuffer->setDepthStencilBuffer(depthTexture, depthFormat);
     }
 
@@ -99,9 +130,13 @@ void PrepareFramebuffer::run(const SceneContextPointer& sceneContext, const Rend
 }
 
 void Draw::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
-        const Inputs& items) {
+        const Inputs& inputs) {
     RenderArgs* args = renderContext->args;
 
+    const auto& items = inputs.get0();
+    const auto& lightingModel = inputs.get1();
+    const auto& lightClusters = inputs.get2();
+
     gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
 
@@ -114,8 +149,20 @@ void Draw::run(const SceneContextPointer& sceneContext, const RenderContextPoint
         batch.setViewTransform(viewMat);
         batch.setModelTransform(Transform());
 
+        // Setup lighting model and light clusters for all items
+        batch.setUniformBuffer(ShapePipeline::Slot::LIGHTING_MODEL, lightingModel->getParametersBuffer());
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LOCAL_LIGHTS, lightClusters->_lightStage->_lightArrayBuffer);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_FRUSTUM_GRID, lightClusters->_frustumGridBuffer);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_GRID, lightClusters->_clusterGridBuffer);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_CONTENT, lightClusters->_clusterContentBuffer);
+
         // Render items
         renderStateSortShapes(sceneContext, renderContext, _shapePlumber, items, -1);
+
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LOCAL_LIGHTS, nullptr);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_FRUSTUM_GRID, nullptr);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_GRID, nullptr);
+        batch.setUniformBuffer(ShapePipeline::Slot::BUFFER::LIGHT_CLUSTER_CONTENT, nullptr);
     });
     args->_batch = nullptr;
 }
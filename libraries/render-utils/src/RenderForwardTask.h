@@ -15,34 +15,64 @@
 #include <gpu/Pipeline.h>
 #include <render/RenderFetchCullSortTask.h>
 #include "LightingModel.h"
+#include "LightClusters.h"
 
+class RenderForwardTaskConfig : public render::Task::Config {
+    Q_OBJECT
+public:
+    // Disabled unless the display plugin asks for it, the deferred task renders the frame otherwise
+    RenderForwardTaskConfig() : render::Task::Config(false) {}
+};
+
+// Single pass forward renderer for the tiled GPUs of the mobile and standalone HMDs:
+// the shapes are lit as they are drawn with the clustered lights, in a multisampled target
+// resolved by the tone mapping, so no G-buffer is ever written or read back
 class RenderForwardTask : public render::Task {
 public:
-    using JobModel = Model<RenderForwardTask>;
+    using Config = RenderForwardTaskConfig;
+    using JobModel = Model<RenderForwardTask, Config>;
 
     RenderForwardTask(RenderFetchCullSortTask::Output items);
+
+    void configure(const Config& config) {}
+};
+
+class PrepareFramebufferConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(int numSamples MEMBER numSamples WRITE setNumSamples)
+public:
+    PrepareFramebufferConfig() : render::Job::Config(true) {}
+
+    void setNumSamples(int newNumSamples) { numSamples = std::max(1, std::min(8, newNumSamples)); emit dirty(); }
+
+    int numSamples{ 4 };
+signals:
+    void dirty();
 };
 
 class PrepareFramebuffer {
 public:
     using Inputs = gpu::FramebufferPointer;
-    using JobModel = render::Job::ModelO<PrepareFramebuffer, Inputs>;
+    using Config = PrepareFramebufferConfig;
+    using JobModel = render::Job::ModelO<PrepareFramebuffer, Inputs, Config>;
 
+    void configure(const Config& config);
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
             gpu::FramebufferPointer& framebuffer);
 
 private:
     gpu::FramebufferPointer _framebuffer;
+    int _numSamples{ 4 };
 };
 
 class Draw {
 public:
-    using Inputs = render::ItemBounds;
+    using Inputs = render::VaryingSet3<render::ItemBounds, LightingModelPointer, LightClustersPointer>;
     using JobModel = render::Job::ModelI<Draw, Inputs>;
 
     Draw(const render::ShapePlumberPointer& shapePlumber) : _shapePlumber(shapePlumber) {}
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
-            const Inputs& items);
+            const Inputs& inputs);
 
 private:
     render::ShapePlumberPointer _shapePlumber;
@@ -40,6 +40,7 @@
 #include "forward_model_normal_map_frag.h"
 #include "forward_model_normal_specular_map_frag.h"
 #include "forward_model_specular_map_frag.h"
+#include "forward_model_translucent_frag.h"
 
 #include "model_lightmap_frag.h"
 #include "model_lightmap_normal_map_frag.h"
@@ -67,7 +68,8 @@ void initDeferredPipelines(ShapePlumber& plumber);
 void initForwardPipelines(ShapePlumber& plumber);
 
 void addPlumberPipeline(ShapePlumber& plumber,
-        const ShapeKey& key, const gpu::ShaderPointer& vertex, const gpu::ShaderPointer& pixel);
+        const ShapeKey& key, const gpu::ShaderPointer& vertex, const gpu::ShaderPointer& pixel,
+        const ShapePipeline::BatchSetter& customBatchSetter);
 
 void batchSetter(const ShapePipeline& pipeline, gpu::Batch& batch);
 void lightBatchSetter(const ShapePipeline& pipeline, gpu::Batch& batch);
@@ -159,7 +161,7 @@ void initDeferredPipelines(render::ShapePlumber& plumber) {
     auto modelLightmapNormalSpecularMapPixel = gpu::Shader::createPixel(std::string(model_lightmap_normal_specular_map_frag));
 
     using Key = render::ShapeKey;
-    auto addPipeline = std::bind(&addPlumberPipeline, std::ref(plumber), _1, _2, _3);
+    auto addPipeline = std::bind(&addPlumberPipeline, std::ref(plumber), _1, _2, _3, nullptr);
     // TODO: Refactor this to use a filter
     // Opaques
     addPipeline(
@@ -270,9 +272,12 @@ void initForwardPipelines(render::ShapePlumber& plumber) {
     auto modelNormalMapPixel = gpu::Shader::createPixel(std::string(forward_model_normal_map_frag));
     auto modelSpecularMapPixel = gpu::Shader::createPixel(std::string(forward_model_specular_map_frag));
     auto modelNormalSpecularMapPixel = gpu::Shader::createPixel(std::string(forward_model_normal_specular_map_frag));
+    auto modelTranslucentPixel = gpu::Shader::createPixel(std::string(forward_model_translucent_frag));
+    auto modelTranslucentUnlitPixel = gpu::Shader::createPixel(std::string(model_translucent_unlit_frag));
 
     using Key = render::ShapeKey;
-    auto addPipeline = std::bind(&addPlumberPipeline, std::ref(plumber), _1, _2, _3);
+    // The forward shapes are lit as they are drawn, they all need the key light
+    auto addPipeline = std::bind(&addPlumberPipeline, std::ref(plumber), _1, _2, _3, &lightBatchSetter);
     // Opaques
     addPipeline(
         Key::Builder().withMaterial(),
@@ -302,10 +307,40 @@ void initForwardPipelines(render::ShapePlumber& plumber) {
     addPipeline(
         Key::Builder().withMaterial().withSkinned().withTangents().withSpecular(),
         skinModelNormalMapVertex, modelNormalSpecularMapPixel);
+    // Translucents
+    addPipeline(
+        Key::Builder().withMaterial().withTranslucent(),
+        modelVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withTranslucent().withUnlit(),
+        modelVertex, modelTranslucentUnlitPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withTranslucent().withTangents(),
+        modelNormalMapVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withTranslucent().withSpecular(),
+        modelVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withTranslucent().withTangents().withSpecular(),
+        modelNormalMapVertex, modelTranslucentPixel);
+    // Skinned and Translucent
+    addPipeline(
+        Key::Builder().withMaterial().withSkinned().withTranslucent(),
+        skinModelVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withSkinned().withTranslucent().withTangents(),
+        skinModelNormalMapVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withSkinned().withTranslucent().withSpecular(),
+        skinModelVertex, modelTranslucentPixel);
+    addPipeline(
+        Key::Builder().withMaterial().withSkinned().withTranslucent().withTangents().withSpecular(),
+        skinModelNormalMapVertex, modelTranslucentPixel);
 }
 
 void addPlumberPipeline(ShapePlumber& plumber,
-        const ShapeKey& key, const gpu::ShaderPointer& vertex, const gpu::ShaderPointer& pixel) {
+        const ShapeKey& key, const gpu::ShaderPointer& vertex, const gpu::ShaderPointer& pixel,
+        const ShapePipeline::BatchSetter& customBatchSetter) {
     // These key-values' pipelines are added by this functor in addition to the key passed
     assert(!key.isWireframe());
     assert(!key.isDepthBiased());
@@ -341,8 +376,12 @@ void addPlumberPipeline(ShapePlumber& plumber,
             state->setDepthBiasSlopeScale(1.0f);
         }
 
-        plumber.addPipeline(builder.build(), program, state,
-                key.isTranslucent() ? &lightBatchSetter : &batchSetter);
+        if (customBatchSetter) {
+            plumber.addPipeline(builder.build(), program, state, customBatchSetter);
+        } else {
+            plumber.addPipeline(builder.build(), program, state,
+                    key.isTranslucent() ? &lightBatchSetter : &batchSetter);
+        }
     }
 }
 
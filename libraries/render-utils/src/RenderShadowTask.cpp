@@ -11,7 +11,12 @@
 
 #include "RenderShadowTask.h"
 
+#include <algorithm>
+#include <functional>
+#include <string>
+
 #include <gpu/Context.h>
+#include <gpu/StandardShaderLib.h>
 
 #include <ViewFrustum.h>
 
@@ -28,11 +33,37 @@
 
 #include "model_shadow_frag.h"
 #include "skin_model_shadow_frag.h"
+#include "shadow_copyDepth_frag.h"
 
 using namespace render;
 
+const int RenderShadowMap_StaticDepthMapSlot = 0;
+
+// A signature of the static casters independent of their order, it changes when one is added, removed or moved
+static size_t evalShapesSignature(const render::ShapeBounds& inShapes) {
+    size_t signature = 0;
+    for (const auto& items : inShapes) {
+        for (const auto& item : items.second) {
+            size_t hash = std::hash<ItemID>()(item.id);
+            auto combine = [&hash](float value) {
+                hash ^= std::hash<float>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
+            const auto& corner = item.bound.getCorner();
+            const auto& scale = item.bound.getScale();
+            combine(corner.x);
+            combine(corner.y);
+            combine(corner.z);
+            combine(scale.x);
+            combine(scale.y);
+            combine(scale.z);
+            signature += hash;
+        }
+    }
+    return signature;
+}
+
 void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
-                          const render::ShapeBounds& inShapes) {
+                          const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
@@ -44,53 +75,169 @@ void RenderShadowMap::run(const render::SceneContextPointer& sceneContext, const
     const auto shadow = lightStage->getShadow(globalLightIndex);
     if (!shadow) return;
 
+    const auto& staticShapes = inputs.get0();
+    const auto& dynamicShapes = inputs.get1();
+
     const auto& fbo = shadow->framebuffer;
+    const auto& cascade = shadow->getCascade(_cascadeIndex);
+    if (!_staticFramebuffer) {
+        auto depthFormat = gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::DEPTH);
+        auto depthTexture = gpu::TexturePointer(gpu::Texture::createRenderBuffer(depthFormat,
+            LightStage::Shadow::MAP_SIZE, LightStage::Shadow::MAP_SIZE, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+        _staticFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("staticShadowmap"));
+        _staticFramebuffer->setDepthStencilBuffer(depthTexture, depthFormat);
+    }
+
+    // The static casters are only rendered again when they or the cascade frustum change
+    const auto& projection = cascade.getProjection();
+    const auto& view = cascade.getView();
+    size_t staticSignature = evalShapesSignature(staticShapes);
+    bool renderStatic = !_hasStaticDepth || staticSignature != _staticSignature ||
+        projection != _staticProjection || view != _staticView;
+    if (renderStatic) {
+        _hasStaticDepth = true;
+        _staticSignature = staticSignature;
+        _staticProjection = projection;
+        _staticView = view;
+    }
 
     RenderArgs* args = renderContext->args;
     gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
 
-        glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
+        batch.setProjectionTransform(projection);
+        batch.setViewTransform(view, false);
+
+        if (renderStatic) {
+            glm::ivec4 staticViewport{ 0, 0, LightStage::Shadow::MAP_SIZE, LightStage::Shadow::MAP_SIZE };
+            batch.setViewportTransform(staticViewport);
+            batch.setStateScissorRect(staticViewport);
+
+            batch.setFramebuffer(_staticFramebuffer);
+            batch.clearFramebuffer(gpu::Framebuffer::BUFFER_DEPTH, vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
+            renderShapes(sceneContext, renderContext, staticShapes);
+        }
+
+        // Start every frame from the cached static depth
+        glm::ivec4 viewport = LightStage::Shadow::getCascadeViewport(_cascadeIndex);
         batch.setViewportTransform(viewport);
         batch.setStateScissorRect(viewport);
 
         batch.setFramebuffer(fbo);
-        batch.clearFramebuffer(
-            gpu::Framebuffer::BUFFER_COLOR0 | gpu::Framebuffer::BUFFER_DEPTH,
-            vec4(vec3(1.0, 1.0, 1.0), 0.0), 1.0, 0, true);
-
-        batch.setProjectionTransform(shadow->getProjection());
-        batch.setViewTransform(shadow->getView(), false);
-
-        auto shadowPipeline = _shapePlumber->pickPipeline(args, ShapeKey());
-        auto shadowSkinnedPipeline = _shapePlumber->pickPipeline(args, ShapeKey::Builder().withSkinned());
-
-        std::vector<ShapeKey> skinnedShapeKeys{};
-
-        // Iterate through all inShapes and render the unskinned
-        args->_pipeline = shadowPipeline;
-        batch.setPipeline(shadowPipeline->pipeline);
-        for (auto items : inShapes) {
-            if (items.first.isSkinned()) {
-                skinnedShapeKeys.push_back(items.first);
-            } else {
-                renderItems(sceneContext, renderContext, items.second);
-            }
-        }
+        batch.setPipeline(getCopyDepthPipeline());
+        batch.setResourceTexture(RenderShadowMap_StaticDepthMapSlot, _staticFramebuffer->getDepthStencilBuffer());
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+        batch.setResourceTexture(RenderShadowMap_StaticDepthMapSlot, nullptr);
 
-        // Reiterate to render the skinned
-        args->_pipeline = shadowSkinnedPipeline;
-        batch.setPipeline(shadowSkinnedPipeline->pipeline);
-        for (const auto& key : skinnedShapeKeys) {
-            renderItems(sceneContext, renderContext, inShapes.at(key));
-        }
+        renderShapes(sceneContext, renderContext, dynamicShapes);
 
-        args->_pipeline = nullptr;
         args->_batch = nullptr;
     });
 }
 
-RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
+void RenderShadowMap::renderShapes(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
+                                   const render::ShapeBounds& inShapes) {
+    RenderArgs* args = renderContext->args;
+    auto& batch = *args->_batch;
+
+    auto shadowPipeline = _shapePlumber->pickPipeline(args, ShapeKey());
+    auto shadowSkinnedPipeline = _shapePlumber->pickPipeline(args, ShapeKey::Builder().withSkinned());
+
+    std::vector<ShapeKey> skinnedShapeKeys{};
+
+    // Iterate through all inShapes and render the unskinned
+    args->_pipeline = shadowPipeline;
+    batch.setPipeline(shadowPipeline->pipeline);
+    for (auto items : inShapes) {
+        if (items.first.isSkinned()) {
+            skinnedShapeKeys.push_back(items.first);
+        } else {
+            renderItems(sceneContext, renderContext, items.second);
+        }
+    }
+
+    // Reiterate to render the skinned
+    args->_pipeline = shadowSkinnedPipeline;
+    batch.setPipeline(shadowSkinnedPipeline->pipeline);
+    for (const auto& key : skinnedShapeKeys) {
+        renderItems(sceneContext, renderContext, inShapes.at(key));
+    }
+
+    args->_pipeline = nullptr;
+}
+
+const gpu::PipelinePointer& RenderShadowMap::getCopyDepthPipeline() {
+    if (!_copyDepthPipeline) {
+        auto vs = gpu::StandardShaderLib::getDrawUnitQuadTexcoordVS();
+        auto ps = gpu::Shader::createPixel(std::string(shadow_copyDepth_frag));
+        gpu::ShaderPointer program = gpu::Shader::createProgram(vs, ps);
+
+        gpu::Shader::BindingSet slotBindings;
+        slotBindings.insert(gpu::Shader::Binding(std::string("staticDepthMap"), RenderShadowMap_StaticDepthMapSlot));
+        gpu::Shader::makeProgram(*program, slotBindings);
+
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+        state->setDepthTest(true, true, gpu::ALWAYS);
+        state->setColorWriteMask(false, false, false, false);
+
+        _copyDepthPipeline = gpu::Pipeline::create(program, state);
+    }
+
+    return _copyDepthPipeline;
+}
+
+// The far depth of each cascade slice, from the near clip, the previous one is the near depth
+static const float SHADOW_CASCADE_FAR_DEPTHS[LightStage::Shadow::CASCADE_COUNT] = { 4.0f, 12.0f, 32.0f, 80.0f };
+// The cascades from this one on are updated every farCascadeUpdatePeriod frames
+static const int FIRST_FAR_CASCADE = 2;
+
+RenderShadowCascadeTask::RenderShadowCascadeTask(int cascadeIndex, CullFunctor cullFunctor, ShapePlumberPointer shapePlumber,
+                                                 std::shared_ptr<int> farCascadeUpdatePeriod) :
+    _cascadeIndex{ cascadeIndex }, _farCascadeUpdatePeriod{ farCascadeUpdatePeriod } {
+    const auto cachedMode = addJob<RenderShadowSetup>("Setup", cascadeIndex);
+
+    // CPU jobs:
+    // Fetch and cull the items from the scene
+    auto shadowFilter = ItemFilter::Builder::visibleWorldItems().withTypeShape().withOpaque().withoutLayered();
+    const auto shadowSelection = addJob<FetchSpatialTree>("FetchShadowSelection", shadowFilter);
+    const auto culledShadowSelection = addJob<CullSpatialSelection>("CullShadowSelection", shadowSelection, cullFunctor, RenderDetails::SHADOW, shadowFilter);
+
+    // Split the casters, the static ones are cached in their own depth map
+    const int NUM_CASTER_FILTERS = 2;
+    const int STATIC_CASTER_BUCKET = 0;
+    const int DYNAMIC_CASTER_BUCKET = 1;
+    MultiFilterItem<NUM_CASTER_FILTERS>::ItemFilterArray casterFilters = { {
+            ItemFilter::Builder().withStatic(),
+            ItemFilter::Builder().withDynamic()
+        } };
+    const auto casterBuckets =
+        addJob<MultiFilterItem<NUM_CASTER_FILTERS>>("FilterShadowCasters", culledShadowSelection, casterFilters)
+            .get<MultiFilterItem<NUM_CASTER_FILTERS>::ItemBoundsArray>();
+
+    // Sort
+    const auto sortedStaticShapes = addJob<PipelineDepthSortShapes>("PipelineDepthSortStaticShadow", casterBuckets[STATIC_CASTER_BUCKET]);
+    const auto sortedDynamicShapes = addJob<PipelineDepthSortShapes>("PipelineDepthSortDynamicShadow", casterBuckets[DYNAMIC_CASTER_BUCKET]);
+
+    // GPU jobs: Render to shadow map
+    const auto shadowMapInputs = RenderShadowMap::Inputs(sortedStaticShapes, sortedDynamicShapes).hasVarying();
+    addJob<RenderShadowMap>("RenderShadowMap", shadowMapInputs, shapePlumber, cascadeIndex);
+
+    addJob<RenderShadowTeardown>("Teardown", cachedMode);
+}
+
+void RenderShadowCascadeTask::runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    // Stagger the far cascades so that they are not all updated on the same frame
+    int period = std::max(*_farCascadeUpdatePeriod, 1);
+    bool isUpdated = !_hasRun || _cascadeIndex < FIRST_FAR_CASCADE || (_frameCount + _cascadeIndex) % period == 0;
+    _frameCount++;
+    if (isUpdated) {
+        _hasRun = true;
+        Task::runJobs(sceneContext, renderContext);
+    }
+}
+
+RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) :
+    _farCascadeUpdatePeriod{ std::make_shared<int>(RenderShadowTaskConfig().farCascadeUpdatePeriod) } {
     cullFunctor = cullFunctor ? cullFunctor : [](const RenderArgs*, const AABox&){ return true; };
 
     // Prepare the ShapePipeline
@@ -115,26 +262,15 @@ RenderShadowTask::RenderShadowTask(CullFunctor cullFunctor) {
             skinProgram, state);
     }
 
-    const auto cachedMode = addJob<RenderShadowSetup>("Setup");
-
-    // CPU jobs:
-    // Fetch and cull the items from the scene
-    auto shadowFilter = ItemFilter::Builder::visibleWorldItems().withTypeShape().withOpaque().withoutLayered();
-    const auto shadowSelection = addJob<FetchSpatialTree>("FetchShadowSelection", shadowFilter);
-    const auto culledShadowSelection = addJob<CullSpatialSelection>("CullShadowSelection", shadowSelection, cullFunctor, RenderDetails::SHADOW, shadowFilter);
-
-    // Sort
-    const auto sortedPipelines = addJob<PipelineSortShapes>("PipelineSortShadowSort", culledShadowSelection);
-    const auto sortedShapes = addJob<DepthSortShapes>("DepthSortShadowMap", sortedPipelines);
-
-    // GPU jobs: Render to shadow map
-    addJob<RenderShadowMap>("RenderShadowMap", sortedShapes, shapePlumber);
-
-    addJob<RenderShadowTeardown>("Teardown", cachedMode);
+    // Each cascade culls its own casters, the far ones with coarser levels of detail as they cover more
+    for (int i = 0; i < LightStage::Shadow::CASCADE_COUNT; i++) {
+        addJob<RenderShadowCascadeTask>("Cascade" + std::to_string(i), i, cullFunctor, shapePlumber, _farCascadeUpdatePeriod);
+    }
 }
 
 void RenderShadowTask::configure(const Config& configuration) {
     DependencyManager::get<DeferredLightingEffect>()->setShadowMapEnabled(configuration.enabled);
+    *_farCascadeUpdatePeriod = configuration.farCascadeUpdatePeriod;
     // This is a task, so must still propogate configure() to its Jobs
     Task::configure(configuration);
 }
@@ -148,12 +284,12 @@ void RenderShadowSetup::run(const SceneContextPointer& sceneContext, const rende
     output = args->_renderMode;
 
     auto nearClip = args->getViewFrustum().getNearClip();
-    float nearDepth = -args->_boomOffset.z;
-    const int SHADOW_FAR_DEPTH = 20;
-    globalShadow->setKeylightFrustum(args->getViewFrustum(), nearDepth, nearClip + SHADOW_FAR_DEPTH);
+    float nearDepth = (_cascadeIndex == 0 ? -args->_boomOffset.z : nearClip + SHADOW_CASCADE_FAR_DEPTHS[_cascadeIndex - 1]);
+    float farDepth = nearClip + SHADOW_CASCADE_FAR_DEPTHS[_cascadeIndex];
+    globalShadow->setKeylightFrustum(_cascadeIndex, args->getViewFrustum(), nearDepth, farDepth);
 
     // Set the keylight render args
-    args->pushViewFrustum(*(globalShadow->getFrustum()));
+    args->pushViewFrustum(*(globalShadow->getCascade(_cascadeIndex).getFrustum()));
     args->_renderMode = RenderArgs::SHADOW_RENDER_MODE;
 }
 
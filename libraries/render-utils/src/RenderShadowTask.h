@@ -19,28 +19,68 @@
 
 class ViewFrustum;
 
+// Renders the static casters of a cascade into a cached depth map, only when they or the cascade frustum change,
+// then copies it into the cascade in the shadow map and draws the dynamic casters over it
 class RenderShadowMap {
 public:
-    using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds>;
+    using Inputs = render::VaryingSet2<render::ShapeBounds, render::ShapeBounds>;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
 
-    RenderShadowMap(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
+    RenderShadowMap(render::ShapePlumberPointer shapePlumber, int cascadeIndex) :
+        _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
-             const render::ShapeBounds& inShapes);
+             const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
+    int _cascadeIndex;
+
+    void renderShapes(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext,
+                      const render::ShapeBounds& inShapes);
+    const gpu::PipelinePointer& getCopyDepthPipeline();
+
+    gpu::FramebufferPointer _staticFramebuffer;
+    gpu::PipelinePointer _copyDepthPipeline;
+
+    // What the cached static depth was rendered with
+    bool _hasStaticDepth { false };
+    size_t _staticSignature { 0 };
+    glm::mat4 _staticProjection;
+    glm::mat4 _staticView;
 };
 
 class RenderShadowTaskConfig : public render::Task::Config::Persistent {
     Q_OBJECT
     Q_PROPERTY(bool enabled MEMBER enabled NOTIFY dirty)
+    Q_PROPERTY(int farCascadeUpdatePeriod MEMBER farCascadeUpdatePeriod NOTIFY dirty)
 public:
     RenderShadowTaskConfig() : render::Task::Config::Persistent("Shadows", false) {}
 
+    // The far cascades are only rendered every that many frames
+    int farCascadeUpdatePeriod{ 2 };
+
 signals:
     void dirty();
 };
 
+// Culls and renders the casters of one cascade of the keylight shadow
+class RenderShadowCascadeTask : public render::Task {
+public:
+    using JobModel = Model<RenderShadowCascadeTask>;
+
+    RenderShadowCascadeTask(int cascadeIndex, render::CullFunctor cullFunctor, render::ShapePlumberPointer shapePlumber,
+                            std::shared_ptr<int> farCascadeUpdatePeriod);
+
+    // Hides Task::runJobs, which the task model calls, to skip the far cascades on the frames they are not updated
+    void runJobs(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext);
+
+protected:
+    int _cascadeIndex;
+    std::shared_ptr<int> _farCascadeUpdatePeriod;
+    uint32_t _frameCount{ 0 };
+    bool _hasRun{ false };
+};
+
 class RenderShadowTask : public render::Task {
 public:
     using Config = RenderShadowTaskConfig;
@@ -49,13 +89,21 @@ public:
     RenderShadowTask(render::CullFunctor shouldRender);
 
     void configure(const Config& configuration);
+
+protected:
+    std::shared_ptr<int> _farCascadeUpdatePeriod;
 };
 
 class RenderShadowSetup {
 public:
     using Output = RenderArgs::RenderMode;
     using JobModel = render::Job::ModelO<RenderShadowSetup, Output>;
+
+    RenderShadowSetup(int cascadeIndex) : _cascadeIndex{ cascadeIndex } {}
     void run(const render::SceneContextPointer& sceneContext, const render::RenderContextPointer& renderContext, Output& output);
+
+protected:
+    int _cascadeIndex;
 };
 
 class RenderShadowTeardown {
@@ -19,6 +19,7 @@
 #include "FramebufferCache.h"
 
 #include "toneMapping_frag.h"
+#include "toneMapping_resolve_frag.h"
 
 const int ToneMappingEffect_ParamsSlot = 0;
 const int ToneMappingEffect_LightingMapSlot = 0;
@@ -41,6 +42,12 @@ void ToneMappingEffect::init() {
     auto blitState = std::make_shared<gpu::State>();
     blitState->setColorWriteMask(true, true, true, true);
     _blitLightBuffer = gpu::PipelinePointer(gpu::Pipeline::create(blitProgram, blitState));
+
+    auto resolvePS = gpu::ShaderPointer(gpu::Shader::createPixel(std::string(toneMapping_resolve_frag)));
+    auto resolveProgram = gpu::ShaderPointer(gpu::Shader::createProgram(blitVS, resolvePS));
+    gpu::Shader::makeProgram(*resolveProgram, slotBindings);
+    _numSamplesLoc = resolveProgram->getUniforms().findLocation("numSamples");
+    _resolveLightBuffer = gpu::PipelinePointer(gpu::Pipeline::create(resolveProgram, blitState));
 }
 
 void ToneMappingEffect::setExposure(float exposure) {
@@ -74,7 +81,12 @@ void ToneMappingEffect::render(RenderArgs* args, const gpu::TexturePointer& ligh
         batch.setProjectionTransform(glm::mat4());
         batch.resetViewTransform();
         batch.setModelTransform(gpu::Framebuffer::evalSubregionTexcoordTransform(framebufferSize, args->_viewport));
-        batch.setPipeline(_blitLightBuffer);
+        if (lightingBuffer->getNumSamples() > 1) {
+            batch.setPipeline(_resolveLightBuffer);
+            batch._glUniform1i(_numSamplesLoc, lightingBuffer->getNumSamples());
+        } else {
+            batch.setPipeline(_blitLightBuffer);
+        }
 
         batch.setUniformBuffer(ToneMappingEffect_ParamsSlot, _parametersBuffer);
         batch.setResourceTexture(ToneMappingEffect_LightingMapSlot, lightingBuffer);
@@ -27,6 +27,7 @@ public:
     ToneMappingEffect();
     virtual ~ToneMappingEffect() {}
 
+    // A multisampled lighting buffer is resolved as it is tone mapped, the destination must be of its size
     void render(RenderArgs* args, const gpu::TexturePointer& lightingBuffer, const gpu::FramebufferPointer& destinationBuffer);
 
     void setExposure(float exposure);
@@ -45,6 +46,8 @@ public:
 private:
 
     gpu::PipelinePointer _blitLightBuffer;
+    gpu::PipelinePointer _resolveLightBuffer;
+    int _numSamplesLoc { -1 };
 
     // Class describing the uniform buffer with all the parameters common to the tone mapping shaders
     class Parameters {
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <limits>
 
 #include <OctreeUtils.h>
 #include <PerfStat.h>
@@ -112,6 +113,80 @@ void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
     _skipCulling = config.skipCulling;
+    _parallelCulling = config.parallelCulling;
+    _itemsPerCullJob = std::max(config.itemsPerCullJob, 1);
+}
+
+namespace {
+
+// The items of the selection handled by one cull job, and what it found
+struct CullBatch {
+    const ItemIDs* ids { nullptr };
+    size_t begin { 0 };
+    size_t end { 0 };
+    bool testFrustum { false };
+    bool testSolidAngle { false };
+
+    ItemBounds outItems;
+    ViewFrustum::Boxes bounds;
+    std::vector<uint32_t> inView;
+    int outOfView { 0 };
+    int tooSmall { 0 };
+};
+
+// Keeps the items whose bound intersects the frustum, in order, and returns how many are kept
+size_t cullOutOfView(const ViewFrustum& frustum, ItemBound* items, size_t numItems, CullBatch& batch) {
+    // the bounds are tested in one batch, as arrays of their components
+    auto& bounds = batch.bounds;
+    bounds.clear();
+    bounds.reserve(numItems);
+    for (size_t i = 0; i < numItems; i++) {
+        bounds.push_back(items[i].bound);
+    }
+    batch.inView.resize(ViewFrustum::getNumInViewWords((int)numItems));
+    frustum.boxesIntersectFrustum(bounds, batch.inView.data());
+
+    size_t numKept = 0;
+    for (size_t i = 0; i < numItems; i++) {
+        if (ViewFrustum::isInView(batch.inView.data(), (int)i)) {
+            items[numKept++] = items[i];
+        }
+    }
+    return numKept;
+}
+
+void cullBatch(const Scene& scene, const ItemFilter& filter, const CullFunctor& cullFunctor, const RenderArgs* args,
+        CullBatch& batch) {
+    auto& outItems = batch.outItems;
+    outItems.clear();
+    outItems.reserve(batch.end - batch.begin);
+
+    // filter individually against the filter
+    for (size_t i = batch.begin; i < batch.end; i++) {
+        auto id = (*batch.ids)[i];
+        auto& item = scene.getItem(id);
+        if (filter.test(item.getKey())) {
+            outItems.emplace_back(ItemBound(id, item.getBound()));
+        }
+    }
+
+    // visibility cull if partially selected ( octree cell contianing it was partial)
+    if (batch.testFrustum) {
+        size_t numInView = cullOutOfView(args->getViewFrustum(), outItems.data(), outItems.size(), batch);
+        batch.outOfView += (int)(outItems.size() - numInView);
+        outItems.erase(outItems.begin() + numInView, outItems.end());
+    }
+
+    // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
+    if (batch.testSolidAngle) {
+        auto last = std::remove_if(outItems.begin(), outItems.end(), [&](const ItemBound& itemBound) {
+            return !cullFunctor(args, itemBound.bound);
+        });
+        batch.tooSmall += (int)(outItems.end() - last);
+        outItems.erase(last, outItems.end());
+    }
+}
+
 }
 
 void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
@@ -124,187 +199,81 @@ void CullSpatialSelection::run(const SceneContextPointer& sceneContext, const Re
     auto& details = args->_details.edit(_detailType);
     details._considered += (int)inSelection.numItems();
 
-    // Eventually use a frozen frustum
+    // Eventually use a frozen frustum, on a copy of the args as concurrent jobs may read the true view frustum
+    std::unique_ptr<RenderArgs> frozenArgs;
     if (_freezeFrustum) {
         if (_justFrozeFrustum) {
             _justFrozeFrustum = false;
             _frozenFrutstum = args->getViewFrustum();
         }
-        args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
+        frozenArgs.reset(new RenderArgs(*args));
+        frozenArgs->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
+        args = frozenArgs.get();
     }
 
-    // Culling Frustum / solidAngle test helper class
-    struct Test {
-        CullFunctor _functor;
-        RenderArgs* _args;
-        RenderDetails::Item& _renderDetails;
-        glm::vec3 _eyePos;
-        float _squareTanAlpha;
-
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
-            _functor(functor),
-            _args(pargs),
-            _renderDetails(renderDetails)
-        {
-            // FIXME: Keep this code here even though we don't use it yet
-            /*_eyePos = _args->getViewFrustum().getPosition();
-            float a = glm::degrees(Octree::getAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
-            auto angle = std::min(glm::radians(45.0f), a); // no worse than 45 degrees
-            angle = std::max(glm::radians(1.0f / 60.0f), a); // no better than 1 minute of degree
-            auto tanAlpha = tan(angle);
-            _squareTanAlpha = (float)(tanAlpha * tanAlpha);
-            */
-        }
-
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
-        bool solidAngleTest(const AABox& bound) {
-            // FIXME: Keep this code here even though we don't use it yet
-            //auto eyeToPoint = bound.calcCenter() - _eyePos;
-            //auto boundSize = bound.getDimensions();
-            //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
-            //if (test < 0.0f) {
-            if (!_functor(_args, bound)) {
-                _renderDetails._tooSmall++;
-                return false;
-            }
-            return true;
-        }
-    };
-    Test test(_cullFunctor, args, details);
-
-    // Now we have a selection of items to render
-    outItems.clear();
-    outItems.reserve(inSelection.numItems());
-
     // Now get the bound, and
-    // filter individually against the _filter
-    // visibility cull if partially selected ( octree cell contianing it was partial)
-    // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-
-    if (_skipCulling) {
-        // inside & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
-
-        // inside & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
-
-        // partial & fit items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
+    // inside & fit items: easy, just filter
+    // inside & subcell items: filter & distance cull
+    // partial & fit items: filter & frustum cull
+    // partial & subcell items:: filter & frutum cull & solidangle cull
+    // unless culling is disabled, then all the items are only filtered
+    struct Part {
+        const ItemIDs& ids;
+        bool testFrustum;
+        bool testSolidAngle;
+    };
+    const Part parts[] = {
+        { inSelection.insideItems, false, false },
+        { inSelection.insideSubcellItems, false, !_skipCulling },
+        { inSelection.partialItems, !_skipCulling, false },
+        { inSelection.partialSubcellItems, !_skipCulling, !_skipCulling }
+    };
 
-        // partial & subcell items: filter only, culling is disabled
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
+    // Split the selection in batches, one per cull job, so they are culled concurrently when enabled
+    const size_t itemsPerBatch = _parallelCulling ? (size_t)_itemsPerCullJob : std::numeric_limits<size_t>::max();
+    std::vector<CullBatch> batches;
+    for (auto& part : parts) {
+        for (size_t begin = 0; begin < part.ids.size(); begin += std::min(itemsPerBatch, part.ids.size() - begin)) {
+            CullBatch batch;
+            batch.ids = &part.ids;
+            batch.begin = begin;
+            batch.end = begin + std::min(itemsPerBatch, part.ids.size() - begin);
+            batch.testFrustum = part.testFrustum;
+            batch.testSolidAngle = part.testSolidAngle;
+            batches.push_back(std::move(batch));
         }
+    }
 
+    if (batches.size() > 1 && _parallelCulling) {
+        PROFILE_RANGE(render, "parallelCulling");
+        // Each batch writes its own output, there is no lock
+        runConcurrentWork(batches.size(), [&](size_t index) {
+            cullBatch(*scene, _filter, _cullFunctor, args, batches[index]);
+        });
     } else {
-
-        // inside & fit items: easy, just filter
-        {
-            PerformanceTimer perfTimer("insideFitItems");
-            for (auto id : inSelection.insideItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    outItems.emplace_back(itemBound);
-                }
-            }
-        }
-
-        // inside & subcell items: filter & distance cull
-        {
-            PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.solidAngleTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
-        }
-
-        // partial & fit items: filter & frustum cull
-        {
-            PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
+        for (auto& batch : batches) {
+            cullBatch(*scene, _filter, _cullFunctor, args, batch);
         }
+    }
 
-        // partial & subcell items:: filter & frutum cull & solidangle cull
-        {
-            PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
-                }
-            }
-        }
+    // Now we have a selection of items to render, merged in the order of the selection
+    size_t numItems = 0;
+    for (auto& batch : batches) {
+        numItems += batch.outItems.size();
+    }
+    outItems.clear();
+    outItems.reserve(numItems);
+    for (auto& batch : batches) {
+        outItems.insert(outItems.end(), batch.outItems.begin(), batch.outItems.end());
+        details._outOfView += batch.outOfView;
+        details._tooSmall += batch.tooSmall;
     }
 
     details._rendered += (int)outItems.size();
 
-
-    // Restore frustum if using the frozen one:
-    if (_freezeFrustum) {
-        args->popViewFrustum();
-    }
-
-    std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->numItems = (int)outItems.size();
+    config->numCullJobs = _parallelCulling ? (int)batches.size() : 1;
 }
 
 
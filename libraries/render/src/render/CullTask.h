@@ -71,15 +71,27 @@ namespace render {
         Q_PROPERTY(int numItems READ getNumItems)
         Q_PROPERTY(bool freezeFrustum MEMBER freezeFrustum WRITE setFreezeFrustum)
         Q_PROPERTY(bool skipCulling MEMBER skipCulling WRITE setSkipCulling)
+        Q_PROPERTY(bool parallelCulling MEMBER parallelCulling WRITE setParallelCulling)
+        Q_PROPERTY(int itemsPerCullJob MEMBER itemsPerCullJob WRITE setItemsPerCullJob)
+        Q_PROPERTY(int numCullJobs READ getNumCullJobs)
     public:
         int numItems{ 0 };
         int getNumItems() { return numItems; }
 
+        int numCullJobs{ 0 };
+        int getNumCullJobs() { return numCullJobs; }
+
         bool freezeFrustum{ false };
         bool skipCulling{ false };
+
+        // Cull the selection in batches of items on the concurrent job workers, the cull functor must be thread safe
+        bool parallelCulling{ true };
+        int itemsPerCullJob{ 4096 };
     public slots:
         void setFreezeFrustum(bool enabled) { freezeFrustum = enabled; emit dirty(); }
         void setSkipCulling(bool enabled) { skipCulling = enabled; emit dirty(); }
+        void setParallelCulling(bool enabled) { parallelCulling = enabled; emit dirty(); }
+        void setItemsPerCullJob(int numItems) { itemsPerCullJob = numItems; emit dirty(); }
     signals:
         void dirty();
     };
@@ -88,6 +100,8 @@ namespace render {
         bool _freezeFrustum{ false }; // initialized by Config
         bool _justFrozeFrustum{ false };
         bool _skipCulling{ false };
+        bool _parallelCulling{ true };
+        int _itemsPerCullJob{ 4096 };
         ViewFrustum _frozenFrutstum;
     public:
         using Config = CullSpatialSelectionConfig;
@@ -123,6 +123,72 @@ void render::renderStateSortShapes(const SceneContextPointer& sceneContext, cons
     }
 }
 
+void render::renderShapesInBatches(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, bool stateSort, size_t itemsPerBatch,
+    const std::function<void(gpu::Batch& batch)>& setupBatch, const ShapeKey& globalKey) {
+    RenderArgs* args = renderContext->args;
+
+    size_t numItemsToDraw = inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = std::min(numItemsToDraw, (size_t)maxDrawnItems);
+    }
+    itemsPerBatch = std::max(itemsPerBatch, (size_t)1);
+    const size_t numBatches = (numItemsToDraw + itemsPerBatch - 1) / itemsPerBatch;
+
+    if (numBatches <= 1 || PerformanceTimer::isActive()) {
+        gpu::doInBatch(args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
+            if (stateSort) {
+                renderStateSortShapes(sceneContext, renderContext, shapeContext, inItems, maxDrawnItems, globalKey);
+            } else {
+                renderShapes(sceneContext, renderContext, shapeContext, inItems, maxDrawnItems, globalKey);
+            }
+            args->_batch = nullptr;
+        });
+        return;
+    }
+
+    // Each batch is recorded with its own copy of the render args
+    struct BatchRecording {
+        gpu::Batch batch;
+        RenderArgs args;
+        ItemBounds items;
+    };
+    std::vector<BatchRecording> recordings(numBatches);
+    {
+        PROFILE_RANGE(render, "recordBatches");
+        runConcurrentWork(numBatches, [&](size_t index) {
+            auto& recording = recordings[index];
+            const size_t begin = index * itemsPerBatch;
+            const size_t end = std::min(begin + itemsPerBatch, numItemsToDraw);
+            recording.items.assign(inItems.begin() + begin, inItems.begin() + end);
+            recording.args = *args;
+            recording.args._batch = &recording.batch;
+            recording.args._details = RenderDetails();
+
+            auto batchContext = std::make_shared<RenderContext>(*renderContext);
+            batchContext->args = &recording.args;
+
+            setupBatch(recording.batch);
+            if (stateSort) {
+                renderStateSortShapes(sceneContext, batchContext, shapeContext, recording.items, -1, globalKey);
+            } else {
+                renderShapes(sceneContext, batchContext, shapeContext, recording.items, -1, globalKey);
+            }
+            recording.args._batch = nullptr;
+        });
+    }
+
+    // The backend state carries from one batch to the next, so the frame draws as if from a single batch,
+    // but for the instanced named calls which are drawn at the end of each batch
+    for (auto& recording : recordings) {
+        args->_context->appendFrameBatch(recording.batch);
+        args->_details._materialSwitches += recording.args._details._materialSwitches;
+        args->_details._trianglesRendered += recording.args._details._trianglesRendered;
+    }
+}
+
 void DrawLight::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -20,6 +20,14 @@ void renderItems(const SceneContextPointer& sceneContext, const RenderContextPoi
 void renderShapes(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 void renderStateSortShapes(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 
+// Records the shapes in batches of consecutive items on this thread and the workers of the concurrent jobs, then appends
+// the batches to the frame in the order of the items. setupBatch is called first on each batch to set the state the
+// shapes expect, it and the item payloads must be safe to call concurrently. The shapes are recorded in a single batch
+// while the performance timers are active, as they are not thread safe.
+void renderShapesInBatches(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, int maxDrawnItems, bool stateSort, size_t itemsPerBatch,
+    const std::function<void(gpu::Batch& batch)>& setupBatch, const ShapeKey& globalKey = ShapeKey());
+
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
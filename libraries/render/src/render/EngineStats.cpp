@@ -10,6 +10,7 @@
 //
 #include "EngineStats.h"
 
+#include <NumericalConstants.h>
 #include <gpu/Texture.h>
 
 using namespace render;
@@ -51,5 +52,10 @@ void EngineStats::run(const SceneContextPointer& sceneContext, const RenderConte
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    auto& scene = sceneContext->_scene;
+    config->scenePendingChangeCount = (quint32)scene->getNumPendingChanges();
+    config->sceneProcessedChangeCount = (quint32)scene->getNumProcessedChanges();
+    config->sceneProcessingTime = (double)scene->getProcessingTime() / (double)USECS_PER_MSEC;
+
     config->emitDirty();
 }
@@ -50,6 +50,10 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY dirty)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY dirty)
 
+        Q_PROPERTY(quint32 scenePendingChangeCount MEMBER scenePendingChangeCount NOTIFY dirty)
+        Q_PROPERTY(quint32 sceneProcessedChangeCount MEMBER sceneProcessedChangeCount NOTIFY dirty)
+        Q_PROPERTY(double sceneProcessingTime MEMBER sceneProcessingTime NOTIFY dirty) //ms
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -81,6 +85,10 @@ namespace render {
 
         quint32 frameSetInputFormatCount{ 0 };
 
+        quint32 scenePendingChangeCount{ 0 };
+        quint32 sceneProcessedChangeCount{ 0 };
+        double sceneProcessingTime{ 0.0 };
+
 
 
         void emitDirty() { emit dirty(); }
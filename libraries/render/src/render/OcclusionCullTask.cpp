@@ -0,0 +1,139 @@
+//
+//  OcclusionCullTask.cpp
+//  render/src/render
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OcclusionCullTask.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace render;
+
+// The depths read back are quantized, an item must be that much behind them to be hidden
+static const float OCCLUSION_DEPTH_TOLERANCE = 1.01f;
+
+// Closer than that to the eye plane, a bound has no meaningful footprint on the map
+static const float MIN_OCCLUDEE_DEPTH = 0.01f;
+
+static const int NUM_BOX_VERTICES = 8;
+
+void OcclusionDepthMap::update(const glm::ivec2& size, std::vector<float>&& depths, const glm::mat4& viewProjection) {
+    auto data = std::make_shared<Data>();
+    data->viewProjection = viewProjection;
+    data->mipSizes.push_back(size);
+    data->mips.push_back(std::move(depths));
+
+    // Each texel of a mip holds the farthest of the up to 2x2 texels it covers in the finer mip
+    while (data->mipSizes.back().x > 1 || data->mipSizes.back().y > 1) {
+        const glm::ivec2 sourceSize = data->mipSizes.back();
+        const glm::ivec2 mipSize = glm::max((sourceSize + 1) / 2, glm::ivec2(1));
+        const auto& source = data->mips.back();
+        std::vector<float> mip(mipSize.x * mipSize.y);
+        for (int y = 0; y < mipSize.y; y++) {
+            int y0 = 2 * y;
+            int y1 = std::min(y0 + 1, sourceSize.y - 1);
+            for (int x = 0; x < mipSize.x; x++) {
+                int x0 = 2 * x;
+                int x1 = std::min(x0 + 1, sourceSize.x - 1);
+                mip[y * mipSize.x + x] = std::max(std::max(source[y0 * sourceSize.x + x0], source[y0 * sourceSize.x + x1]),
+                    std::max(source[y1 * sourceSize.x + x0], source[y1 * sourceSize.x + x1]));
+            }
+        }
+        data->mipSizes.push_back(mipSize);
+        data->mips.push_back(std::move(mip));
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _data = data;
+}
+
+void OcclusionDepthMap::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _data.reset();
+}
+
+OcclusionDepthMap::DataPointer OcclusionDepthMap::get() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _data;
+}
+
+bool render::isOccluded(const OcclusionDepthMap::Data& depthMap, const AABox& bound) {
+    glm::vec2 minCoord(std::numeric_limits<float>::max());
+    glm::vec2 maxCoord(-std::numeric_limits<float>::max());
+    float nearestDepth = std::numeric_limits<float>::max();
+    for (int i = 0; i < NUM_BOX_VERTICES; i++) {
+        glm::vec4 clipPos = depthMap.viewProjection * glm::vec4(bound.getVertex((BoxVertex)i), 1.0f);
+        // the perspective w is the eye depth
+        if (clipPos.w < MIN_OCCLUDEE_DEPTH) {
+            return false;
+        }
+        glm::vec2 coord = glm::vec2(clipPos) / clipPos.w;
+        minCoord = glm::min(minCoord, coord);
+        maxCoord = glm::max(maxCoord, coord);
+        nearestDepth = std::min(nearestDepth, clipPos.w);
+    }
+
+    // Nothing is known of what is outside of the view of the map
+    if (minCoord.x < -1.0f || minCoord.y < -1.0f || maxCoord.x > 1.0f || maxCoord.y > 1.0f) {
+        return false;
+    }
+
+    const glm::vec2 size(depthMap.mipSizes[0]);
+    glm::ivec2 minTexel = glm::ivec2((minCoord * 0.5f + 0.5f) * size);
+    glm::ivec2 maxTexel = glm::ivec2((maxCoord * 0.5f + 0.5f) * size);
+    minTexel = glm::min(minTexel, depthMap.mipSizes[0] - 1);
+    maxTexel = glm::min(maxTexel, depthMap.mipSizes[0] - 1);
+
+    // Test in the first mip where the bound covers at most 2x2 texels
+    size_t mip = 0;
+    while ((mip + 1) < depthMap.mips.size() && ((maxTexel.x - minTexel.x) > 1 || (maxTexel.y - minTexel.y) > 1)) {
+        minTexel = minTexel >> 1;
+        maxTexel = maxTexel >> 1;
+        mip++;
+    }
+
+    const auto& depths = depthMap.mips[mip];
+    const int width = depthMap.mipSizes[mip].x;
+    float farthestDepth = 0.0f;
+    for (int y = minTexel.y; y <= maxTexel.y; y++) {
+        for (int x = minTexel.x; x <= maxTexel.x; x++) {
+            farthestDepth = std::max(farthestDepth, depths[y * width + x]);
+        }
+    }
+    return nearestDepth > farthestDepth * OCCLUSION_DEPTH_TOLERANCE;
+}
+
+void OcclusionCullItems::configure(const Config& config) {
+    _occlusionCulling = config.occlusionCulling;
+}
+
+void OcclusionCullItems::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
+        const ItemBounds& inItems, Outputs& outputs) {
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    auto& outItems = outputs.edit0();
+    outputs.edit1() = _depthMap;
+
+    _depthMap->setRequested(_occlusionCulling);
+    auto depthMap = (_occlusionCulling ? _depthMap->get() : OcclusionDepthMap::DataPointer());
+    if (!depthMap) {
+        outItems = inItems;
+        config->numOccluded = 0;
+        return;
+    }
+
+    outItems.clear();
+    outItems.reserve(inItems.size());
+    for (const auto& item : inItems) {
+        if (!isOccluded(*depthMap, item.bound)) {
+            outItems.emplace_back(item);
+        }
+    }
+    config->numOccluded = (int)(inItems.size() - outItems.size());
+}
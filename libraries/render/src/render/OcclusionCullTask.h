@@ -0,0 +1,88 @@
+//
+//  OcclusionCullTask.h
+//  render/src/render
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_OcclusionCullTask_h
+#define hifi_render_OcclusionCullTask_h
+
+#include <atomic>
+#include <mutex>
+
+#include "Engine.h"
+
+namespace render {
+
+    // A coarse grid over the view of a previous frame holding the farthest eye depth seen in each of its texels,
+    // with its coarser mips. The renderer fills it from the frame depth, OcclusionCullItems tests the item bounds
+    // against it to drop the items hidden behind what was drawn.
+    class OcclusionDepthMap {
+    public:
+        class Data {
+        public:
+            glm::mat4 viewProjection; // of the frame the depths were read from
+            std::vector<glm::ivec2> mipSizes;
+            std::vector<std::vector<float>> mips; // the bottom row of the view first
+        };
+        using DataPointer = std::shared_ptr<const Data>;
+
+        // Only filled while a cull job asks for it
+        void setRequested(bool requested) { _requested = requested; }
+        bool isRequested() const { return _requested; }
+
+        // Thread safe, the depths are read back on the render backend thread
+        void update(const glm::ivec2& size, std::vector<float>&& depths, const glm::mat4& viewProjection);
+        void clear();
+        DataPointer get() const;
+
+    private:
+        mutable std::mutex _mutex;
+        DataPointer _data;
+        std::atomic<bool> _requested{ false };
+    };
+    using OcclusionDepthMapPointer = std::shared_ptr<OcclusionDepthMap>;
+
+    // True if the bound is entirely behind the depths of the map, as seen from the view of the map
+    bool isOccluded(const OcclusionDepthMap::Data& depthMap, const AABox& bound);
+
+    class OcclusionCullItemsConfig : public Job::Config {
+        Q_OBJECT
+        Q_PROPERTY(bool occlusionCulling MEMBER occlusionCulling WRITE setOcclusionCulling)
+        Q_PROPERTY(int numOccluded READ getNumOccluded)
+    public:
+        int numOccluded{ 0 };
+        int getNumOccluded() { return numOccluded; }
+
+        // The depths are a couple of frames old, items uncovered by a moving occluder or the camera appear late
+        bool occlusionCulling{ false };
+    public slots:
+        void setOcclusionCulling(bool enabled) { occlusionCulling = enabled; emit dirty(); }
+    signals:
+        void dirty();
+    };
+
+    // Drops the items hidden behind the depths of the previous frames, and outputs the depth map for the renderer to fill
+    class OcclusionCullItems {
+    public:
+        using Outputs = VaryingSet2<ItemBounds, OcclusionDepthMapPointer>;
+        using Config = OcclusionCullItemsConfig;
+        using JobModel = Job::ModelIO<OcclusionCullItems, ItemBounds, Outputs, Config>;
+
+        OcclusionCullItems() : _depthMap(std::make_shared<OcclusionDepthMap>()) {}
+
+        void configure(const Config& config);
+        void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, Outputs& outputs);
+
+    protected:
+        OcclusionDepthMapPointer _depthMap;
+        bool _occlusionCulling{ false };
+    };
+}
+
+#endif // hifi_render_OcclusionCullTask_h
@@ -12,6 +12,7 @@
 #include "RenderFetchCullSortTask.h"
 
 #include "CullTask.h"
+#include "OcclusionCullTask.h"
 #include "SortTask.h"
 
 using namespace render;
@@ -20,11 +21,19 @@ RenderFetchCullSortTask::RenderFetchCullSortTask(CullFunctor cullFunctor) {
     cullFunctor = cullFunctor ? cullFunctor : [](const RenderArgs*, const AABox&){ return true; };
 
     // CPU jobs:
+    // The spatial and the overlay branches run side by side
+    setConcurrentJobs(true);
+
     // Fetch and cull the items from the scene
     auto spatialFilter = ItemFilter::Builder::visibleWorldItems().withoutLayered();
     const auto spatialSelection = addJob<FetchSpatialTree>("FetchSceneSelection", spatialFilter);
     const auto culledSpatialSelection = addJob<CullSpatialSelection>("CullSceneSelection", spatialSelection, cullFunctor, RenderDetails::ITEM, spatialFilter);
 
+    // Drop the items hidden behind the depth of the previous frames, the renderer fills the depth map
+    const auto occlusionCullOutputs = addJob<OcclusionCullItems>("OcclusionCullSceneSelection", culledSpatialSelection);
+    const auto visibleSpatialSelection = occlusionCullOutputs.getN<OcclusionCullItems::Outputs>(0);
+    const auto occlusionDepthMap = occlusionCullOutputs.getN<OcclusionCullItems::Outputs>(1);
+
     // Overlays are not culled
     const auto nonspatialSelection = addJob<FetchNonspatialItems>("FetchOverlaySelection");
 
@@ -48,7 +57,7 @@ RenderFetchCullSortTask::RenderFetchCullSortTask(CullFunctor cullFunctor) {
             ItemFilter::Builder::background()
         } };
     const auto filteredSpatialBuckets = 
-        addJob<MultiFilterItem<NUM_SPATIAL_FILTERS>>("FilterSceneSelection", culledSpatialSelection, spatialFilters)
+        addJob<MultiFilterItem<NUM_SPATIAL_FILTERS>>("FilterSceneSelection", visibleSpatialSelection, spatialFilters)
             .get<MultiFilterItem<NUM_SPATIAL_FILTERS>::ItemBoundsArray>();
     const auto filteredNonspatialBuckets = 
         addJob<MultiFilterItem<NUM_NON_SPATIAL_FILTERS>>("FilterOverlaySelection", nonspatialSelection, nonspatialFilters)
@@ -65,5 +74,5 @@ RenderFetchCullSortTask::RenderFetchCullSortTask(CullFunctor cullFunctor) {
     const auto background = filteredNonspatialBuckets[BACKGROUND_BUCKET];
 
     setOutput(Output{{
-            opaques, transparents, lights, metas, overlayOpaques, overlayTransparents, background, spatialSelection }});
+            opaques, transparents, lights, metas, overlayOpaques, overlayTransparents, background, spatialSelection, occlusionDepthMap }});
 }
@@ -29,6 +29,7 @@ public:
         OVERLAY_TRANSPARENT_SHAPE,
         BACKGROUND,
         SPATIAL_SELECTION,
+        OCCLUSION_DEPTH_MAP,
 
         NUM_BUCKETS
     };
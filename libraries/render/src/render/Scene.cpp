@@ -12,6 +12,7 @@
 
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 
 using namespace render;
@@ -43,6 +44,21 @@ void PendingChanges::merge(const PendingChanges& changes) {
     _updateFunctors.insert(_updateFunctors.end(), changes._updateFunctors.begin(), changes._updateFunctors.end());
 }
 
+void PendingChanges::merge(PendingChanges&& changes) {
+    if (size() == 0) {
+        // Nothing to merge with, just take the changes
+        *this = std::move(changes);
+        return;
+    }
+    _resetItems.insert(_resetItems.end(), changes._resetItems.begin(), changes._resetItems.end());
+    _resetPayloads.insert(_resetPayloads.end(),
+        std::make_move_iterator(changes._resetPayloads.begin()), std::make_move_iterator(changes._resetPayloads.end()));
+    _removedItems.insert(_removedItems.end(), changes._removedItems.begin(), changes._removedItems.end());
+    _updatedItems.insert(_updatedItems.end(), changes._updatedItems.begin(), changes._updatedItems.end());
+    _updateFunctors.insert(_updateFunctors.end(),
+        std::make_move_iterator(changes._updateFunctors.begin()), std::make_move_iterator(changes._updateFunctors.end()));
+}
+
 Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
@@ -51,6 +67,12 @@ Scene::Scene(glm::vec3 origin, float size) :
 
 Scene::~Scene() {
     qCDebug(renderlogging) << "Scene::~Scene()";
+    auto node = _pendingChangesList.exchange(nullptr);
+    while (node) {
+        auto next = node->next;
+        delete node;
+        node = next;
+    }
 }
 
 ItemID Scene::allocateID() {
@@ -64,27 +86,60 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueuePendingChanges(const PendingChanges& pendingChanges) {
-    _changeQueueMutex.lock();
-    _changeQueue.push(pendingChanges);
-    _changeQueueMutex.unlock();
+    auto numChanges = pendingChanges.size();
+    if (numChanges == 0) {
+        return;
+    }
+    // Counted before being pushed, so the render thread never processes more than what is counted
+    _numPendingChanges.fetch_add(numChanges);
+
+    auto node = new PendingChangesNode(pendingChanges);
+    node->next = _pendingChangesList.load(std::memory_order_relaxed);
+    while (!_pendingChangesList.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void Scene::takePendingChangesList() {
+    // The list is in the reverse order of the enqueuing
+    PendingChangesNode* reversed = _pendingChangesList.exchange(nullptr, std::memory_order_acquire);
+    PendingChangesNode* node = nullptr;
+    while (reversed) {
+        auto next = reversed->next;
+        reversed->next = node;
+        node = reversed;
+        reversed = next;
+    }
+    while (node) {
+        auto next = node->next;
+        _changeQueue.push(std::move(node->changes));
+        delete node;
+        node = next;
+    }
 }
 
-void consolidateChangeQueue(PendingChangesQueue& queue, PendingChanges& singleBatch) {
+size_t consolidateChangeQueue(PendingChangesQueue& queue, PendingChanges& singleBatch, size_t maxChanges) {
+    size_t numChanges = 0;
     while (!queue.empty()) {
-        const auto& pendingChanges = queue.front();
-        singleBatch.merge(pendingChanges);
+        auto& pendingChanges = queue.front();
+        if (numChanges > 0 && maxChanges > 0 && numChanges + pendingChanges.size() > maxChanges) {
+            break;
+        }
+        numChanges += pendingChanges.size();
+        singleBatch.merge(std::move(pendingChanges));
         queue.pop();
     };
+    return numChanges;
 }
  
 void Scene::processPendingChangesQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
+    auto start = usecTimestampNow();
     PendingChanges consolidatedPendingChanges;
 
-    {
-        std::unique_lock<std::mutex> lock(_changeQueueMutex);
-        consolidateChangeQueue(_changeQueue, consolidatedPendingChanges);
-    }
+    takePendingChangesList();
+    _numProcessedChanges = consolidateChangeQueue(_changeQueue, consolidatedPendingChanges, _maxChangesPerFrame.load());
+    auto numPendingChanges = _numPendingChanges.fetch_sub(_numProcessedChanges) - _numProcessedChanges;
+    PROFILE_COUNTER(render, "pendingChanges", { { "pending", (int)numPendingChanges }, { "processed", (int)_numProcessedChanges } });
     
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
@@ -112,6 +167,8 @@ void Scene::processPendingChangesQueue() {
         // Update the numItemsAtomic counter AFTER the pending changes went through
         _numAllocatedItems.exchange(maxID);
     }
+
+    _processingTime = usecTimestampNow() - start;
 }
 
 void Scene::resetItems(const ItemIDs& ids, Payloads& payloads) {
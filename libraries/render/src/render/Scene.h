@@ -22,7 +22,6 @@ class Engine;
 class PendingChanges {
 public:
     PendingChanges() {}
-    ~PendingChanges() {}
 
     void resetItem(ItemID id, const PayloadPointer& payload);
     void removeItem(ItemID id);
@@ -35,6 +34,10 @@ public:
     void updateItem(ItemID id) { updateItem(id, nullptr); }
 
     void merge(const PendingChanges& changes);
+    void merge(PendingChanges&& changes);
+
+    // The number of item changes
+    size_t size() const { return _resetItems.size() + _removedItems.size() + _updatedItems.size(); }
 
     ItemIDs _resetItems; 
     Payloads _resetPayloads;
@@ -66,12 +69,24 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue change batch to the scene
+    // Enqueue change batch to the scene, this is lock free and can be called from any thread
     void enqueuePendingChanges(const PendingChanges& pendingChanges);
 
-    // Process the penging changes equeued
+    // Process the penging changes equeued, in order and up to the budget of changes per frame
     void processPendingChangesQueue();
 
+    // The number of item changes processed per frame, 0 to process all the changes enqueued every frame.
+    // The batches of changes are not split, a batch bigger than the budget is processed on its own.
+    void setMaxChangesPerFrame(size_t maxChanges) { _maxChangesPerFrame.store(maxChanges); }
+    size_t getMaxChangesPerFrame() const { return _maxChangesPerFrame.load(); }
+
+    // The number of item changes enqueued and not yet processed, this is a threadsafe call
+    size_t getNumPendingChanges() const { return _numPendingChanges.load(); }
+
+    // The number of item changes and the time in usec of the last processing of the pending changes, on the render thread
+    size_t getNumProcessedChanges() const { return _numProcessedChanges; }
+    quint64 getProcessingTime() const { return _processingTime; }
+
     // This next call are  NOT threadsafe, you have to call them from the correct thread to avoid any potential issues
 
     // Access a particular item form its ID
@@ -91,8 +106,22 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _changeQueueMutex;
+
+    // The change batches are pushed on a lock free list, which the render thread swaps out at once
+    struct PendingChangesNode {
+        PendingChangesNode(const PendingChanges& changes) : changes(changes) {}
+
+        PendingChanges changes;
+        PendingChangesNode* next { nullptr };
+    };
+    std::atomic<PendingChangesNode*> _pendingChangesList{ nullptr };
+    std::atomic<size_t> _numPendingChanges{ 0 };
+    std::atomic<size_t> _maxChangesPerFrame{ 0 };
+
+    // Render thread only: the batches taken from the list and waiting for their turn, and the last processing stats
     PendingChangesQueue _changeQueue;
+    size_t _numProcessedChanges{ 0 };
+    quint64 _processingTime{ 0 };
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -101,6 +130,9 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
+    // Move the batches enqueued since the last processing to the change queue, in order
+    void takePendingChangesList();
+
     void resetItems(const ItemIDs& ids, Payloads& payloads);
     void removeItems(const ItemIDs& ids);
     void updateItems(const ItemIDs& ids, UpdateFunctors& functors);
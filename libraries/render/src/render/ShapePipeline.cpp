@@ -68,7 +68,14 @@ void ShapePlumber::addPipeline(const Filter& filter, const gpu::ShaderPointer& p
     slotBindings.insert(gpu::Shader::Binding(std::string("scatteringMap"), Slot::MAP::SCATTERING));
     slotBindings.insert(gpu::Shader::Binding(std::string("lightBuffer"), Slot::BUFFER::LIGHT));
     slotBindings.insert(gpu::Shader::Binding(std::string("lightAmbientBuffer"), Slot::BUFFER::LIGHT_AMBIENT_BUFFER));
+    slotBindings.insert(gpu::Shader::Binding(std::string("localLightBuffer"), Slot::BUFFER::LOCAL_LIGHTS));
+    slotBindings.insert(gpu::Shader::Binding(std::string("frustumGridBuffer"), Slot::BUFFER::LIGHT_CLUSTER_FRUSTUM_GRID));
+    slotBindings.insert(gpu::Shader::Binding(std::string("clusterGridBuffer"), Slot::BUFFER::LIGHT_CLUSTER_GRID));
+    slotBindings.insert(gpu::Shader::Binding(std::string("clusterContentBuffer"), Slot::BUFFER::LIGHT_CLUSTER_CONTENT));
     slotBindings.insert(gpu::Shader::Binding(std::string("skyboxMap"), Slot::MAP::LIGHT_AMBIENT));
+    slotBindings.insert(gpu::Shader::Binding(std::string("skinClusterInstanceBuffer"), Slot::MAP::SKIN_CLUSTER_INSTANCES));
+    slotBindings.insert(gpu::Shader::Binding(std::string("skinJointBuffer"), Slot::MAP::SKIN_JOINTS));
+    slotBindings.insert(gpu::Shader::Binding(std::string("skinClusterBindBuffer"), Slot::MAP::SKIN_CLUSTER_BINDS));
 
     gpu::Shader::makeProgram(*program, slotBindings);
 
@@ -87,6 +94,11 @@ void ShapePlumber::addPipeline(const Filter& filter, const gpu::ShaderPointer& p
     locations->lightBufferUnit = program->getBuffers().findLocation("lightBuffer");
     locations->lightAmbientBufferUnit = program->getBuffers().findLocation("lightAmbientBuffer");
     locations->lightAmbientMapUnit = program->getTextures().findLocation("skyboxMap");
+    locations->skinClusterInstanceBufferUnit = program->getTextures().findLocation("skinClusterInstanceBuffer");
+    locations->skinClusterInstanceStrideLocation = program->getUniforms().findLocation("skinClusterInstanceStride");
+    locations->skinJointBufferUnit = program->getTextures().findLocation("skinJointBuffer");
+    locations->skinClusterBindBufferUnit = program->getTextures().findLocation("skinClusterBindBuffer");
+    locations->skinJointStrideLocation = program->getUniforms().findLocation("skinJointStride");
     
     ShapeKey key{filter._flags};
     auto gpuPipeline = gpu::Pipeline::create(program, state);
@@ -207,6 +207,10 @@ public:
             LIGHTING_MODEL,
             LIGHT,
             LIGHT_AMBIENT_BUFFER,
+            LOCAL_LIGHTS,
+            LIGHT_CLUSTER_FRUSTUM_GRID,
+            LIGHT_CLUSTER_GRID,
+            LIGHT_CLUSTER_CONTENT,
         };
 
         enum MAP {
@@ -218,6 +222,9 @@ public:
             OCCLUSION,
             SCATTERING,
             LIGHT_AMBIENT,
+            SKIN_CLUSTER_INSTANCES,
+            SKIN_JOINTS,
+            SKIN_CLUSTER_BINDS,
         };
     };
 
@@ -236,6 +243,11 @@ public:
         int lightBufferUnit;
         int lightAmbientBufferUnit;
         int lightAmbientMapUnit;
+        int skinClusterInstanceBufferUnit;
+        int skinClusterInstanceStrideLocation;
+        int skinJointBufferUnit;
+        int skinClusterBindBufferUnit;
+        int skinJointStrideLocation;
     };
     using LocationsPointer = std::shared_ptr<Locations>;
 
@@ -13,70 +13,80 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <cstring>
+
+#include <Radix2InplaceSort.h>
+#include <Radix2IntegerScanner.h>
 #include <ViewFrustum.h>
+#include <shared/WorkGroup.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
-
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
-};
+// below this many items a sort is not worth sharing between threads
+static const size_t MIN_PARALLEL_SORT_ITEMS = 4096;
+
+// The sort keys pack, from the highest bits, the depth of an item and its index in the input. The positive floats order
+// like their bits, the depth is inverted for back to front. The index keeps the order of the items at the same depth
+// and finds the item back once sorted.
+class DepthSortKeys {
+public:
+    DepthSortKeys(const RenderArgs* args, bool frontToBack, size_t numItems) :
+        _viewFrustum(args->getViewFrustum()),
+        _frontToBack(frontToBack)
+    {
+        while (((size_t)1 << _indexBits) < numItems) {
+            _indexBits++;
+        }
+        // the depth gives up its lowest bits to the index only past 4 billion items
+        _depthBits = std::min(32, 64 - _indexBits);
+        _indexMask = ((uint64_t)1 << _indexBits) - 1;
+    }
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    uint64_t getKey(const ItemBound& item, size_t index) const {
+        float distance = _viewFrustum.distanceToCamera(item.bound.calcCenter());
+        distance = distance > 0.0f ? distance : 0.0f;
+        uint32_t depth;
+        memcpy(&depth, &distance, sizeof(depth));
+        if (!_frontToBack) {
+            depth = ~depth;
+        }
+        return ((uint64_t)(depth >> (32 - _depthBits)) << _indexBits) | (uint64_t)index;
     }
-};
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    size_t getIndex(uint64_t key) const { return (size_t)(key & _indexMask); }
+
+    void sort(std::vector<uint64_t>::iterator begin, std::vector<uint64_t>::iterator end) const {
+        if (end - begin > 1) {
+            radix2InplaceSort(begin, end, Radix2IntegerScanner<uint64_t>(_depthBits + _indexBits));
+        }
     }
+
+private:
+    const ViewFrustum& _viewFrustum;
+    bool _frontToBack;
+    int _indexBits { 0 };
+    int _depthBits { 32 };
+    uint64_t _indexMask { 0 };
 };
 
 void render::depthSortItems(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = sceneContext->_scene;
     RenderArgs* args = renderContext->args;
 
-
-    // Allocate and simply copy
-    outItems.clear();
-    outItems.reserve(inItems.size());
-
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distance = args->getViewFrustum().distanceToCamera(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distance, distance, distance, itemDetails.id, bound));
+    const size_t numItems = inItems.size();
+    DepthSortKeys sortKeys(args, frontToBack, numItems);
+    std::vector<uint64_t> keys(numItems);
+    for (size_t i = 0; i < numItems; i++) {
+        keys[i] = sortKeys.getKey(inItems[i], i);
     }
+    sortKeys.sort(keys.begin(), keys.end());
 
-    // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
-
-    // Finally once sorted result to a list of itemID
-    for (auto& item : itemBoundSorts) {
-       outItems.emplace_back(ItemBound(item._id, item._bounds));
+    outItems.clear();
+    outItems.reserve(numItems);
+    for (auto key : keys) {
+        outItems.push_back(inItems[sortKeys.getIndex(key)]);
     }
 }
 
@@ -104,14 +114,92 @@ void DepthSortShapes::run(const SceneContextPointer& sceneContext, const RenderC
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // the outputs are all inserted first, the pipelines are then sorted independently
+    std::vector<std::pair<const ItemBounds*, ItemBounds*>> pipelines;
+    pipelines.reserve(inShapes.size());
+    size_t numItems = 0;
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
+        auto& outItems = outShapes[pipeline.first];
+        pipelines.emplace_back(&pipeline.second, &outItems);
+        numItems += pipeline.second.size();
+    }
+
+    auto sortPipeline = [&](int i) {
+        depthSortItems(sceneContext, renderContext, _frontToBack, *pipelines[i].first, *pipelines[i].second);
+    };
+    if (numItems >= MIN_PARALLEL_SORT_ITEMS && pipelines.size() > 1) {
+        WorkGroup::forEach((int)pipelines.size(), sortPipeline);
+    } else {
+        for (int i = 0; i < (int)pipelines.size(); i++) {
+            sortPipeline(i);
         }
+    }
+}
+
+void PipelineDepthSortShapes::run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+
+    auto& scene = sceneContext->_scene;
+    RenderArgs* args = renderContext->args;
+    outShapes.clear();
 
-        depthSortItems(sceneContext, renderContext, _frontToBack, inItems, outItems->second);
+    const size_t numItems = inItems.size();
+
+    // The pipeline is the first digit of the sort, counted: the pipelines are numbered as they are met
+    std::unordered_map<ShapeKey, uint32_t, ShapeKey::Hash, ShapeKey::KeyEqual> pipelineIndices;
+    std::vector<ShapeKey> pipelines;
+    std::vector<size_t> pipelineOffsets;
+    std::vector<uint32_t> itemPipelines(numItems);
+    for (size_t i = 0; i < numItems; i++) {
+        auto key = scene->getItem(inItems[i].id).getShapeKey();
+        auto pipelineIndex = pipelineIndices.find(key);
+        if (pipelineIndex == pipelineIndices.end()) {
+            pipelineIndex = pipelineIndices.emplace(key, (uint32_t)pipelines.size()).first;
+            pipelines.push_back(key);
+            pipelineOffsets.push_back(0);
+        }
+        itemPipelines[i] = pipelineIndex->second;
+        pipelineOffsets[pipelineIndex->second]++;
+    }
+
+    // the counts become the start of each pipeline in the keys
+    size_t offset = 0;
+    for (auto& pipelineOffset : pipelineOffsets) {
+        size_t count = pipelineOffset;
+        pipelineOffset = offset;
+        offset += count;
+    }
+    pipelineOffsets.push_back(offset);
+
+    DepthSortKeys sortKeys(args, _frontToBack, numItems);
+    std::vector<uint64_t> keys(numItems);
+    {
+        std::vector<size_t> pipelineEnds(pipelineOffsets.begin(), pipelineOffsets.end() - 1);
+        for (size_t i = 0; i < numItems; i++) {
+            keys[pipelineEnds[itemPipelines[i]]++] = sortKeys.getKey(inItems[i], i);
+        }
+    }
+
+    // then the depth of the items of each pipeline
+    auto sortPipeline = [&](int pipeline) {
+        sortKeys.sort(keys.begin() + pipelineOffsets[pipeline], keys.begin() + pipelineOffsets[pipeline + 1]);
+    };
+    if (numItems >= MIN_PARALLEL_SORT_ITEMS && pipelines.size() > 1) {
+        WorkGroup::forEach((int)pipelines.size(), sortPipeline);
+    } else {
+        for (int pipeline = 0; pipeline < (int)pipelines.size(); pipeline++) {
+            sortPipeline(pipeline);
+        }
+    }
+
+    outShapes.reserve(pipelines.size());
+    for (size_t pipeline = 0; pipeline < pipelines.size(); pipeline++) {
+        auto& outItems = outShapes[pipelines[pipeline]];
+        outItems.reserve(pipelineOffsets[pipeline + 1] - pipelineOffsets[pipeline]);
+        for (size_t i = pipelineOffsets[pipeline]; i < pipelineOffsets[pipeline + 1]; i++) {
+            outItems.push_back(inItems[sortKeys.getIndex(keys[i])]);
+        }
     }
 }
 
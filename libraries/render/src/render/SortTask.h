@@ -33,6 +33,17 @@ namespace render {
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes);
     };
 
+    // The two sorts above in one: the items are counted into their pipelines, then sorted by depth within each
+    class PipelineDepthSortShapes {
+    public:
+        using JobModel = Job::ModelIO<PipelineDepthSortShapes, ItemBounds, ShapeBounds>;
+
+        bool _frontToBack;
+        PipelineDepthSortShapes(bool frontToBack = true) : _frontToBack(frontToBack) {}
+
+        void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes);
+    };
+
     class DepthSortItems {
     public:
         using JobModel = Job::ModelIO<DepthSortItems, ItemBounds, ItemBounds>;
@@ -9,12 +9,43 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include <QtCore/QRunnable>
 #include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 
 #include "Task.h"
 
 using namespace render;
 
+void Varying::appendData(std::vector<const Concept*>& data) const {
+    if (!_concept) {
+        return;
+    }
+    data.push_back(_concept.get());
+
+    std::vector<Varying> subVaryings;
+    _concept->appendSubVaryings(subVaryings);
+    for (auto& subVarying : subVaryings) {
+        subVarying.appendData(data);
+    }
+}
+
+bool Varying::sharesDataWith(const Varying& other) const {
+    std::vector<const Concept*> data;
+    std::vector<const Concept*> otherData;
+    appendData(data);
+    other.appendData(otherData);
+    return std::any_of(data.cbegin(), data.cend(), [&](const Concept* concept) {
+        return std::find(otherData.cbegin(), otherData.cend(), concept) != otherData.cend();
+    });
+}
+
 void TaskConfig::refresh() {
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "refresh", Qt::BlockingQueuedConnection);
@@ -24,3 +55,177 @@ void TaskConfig::refresh() {
     _task->configure(*this);
 }
 
+namespace {
+
+class ConcurrentWork : public QRunnable {
+public:
+    ConcurrentWork(std::function<void()> work) : _work(work) {}
+    void run() override { _work(); }
+
+private:
+    std::function<void()> _work;
+};
+
+}
+
+void render::startConcurrentWork(std::function<void()> work) {
+    // The workers are shared by the concurrent jobs of all the tasks, leaving a core to the main and render threads
+    static QThreadPool* pool = [] {
+        auto pool = new QThreadPool();
+        pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 2));
+        return pool;
+    }();
+    pool->start(new ConcurrentWork(work));
+}
+
+void render::runConcurrentWork(size_t count, const std::function<void(size_t)>& work) {
+    if (count == 0) {
+        return;
+    }
+    // Every thread takes the next index until there is none left, then waits for the ones already taken.
+    // The workers only look at the shared state once they got an index, which they may not if they start late.
+    struct SharedState {
+        std::atomic<size_t> next { 0 };
+        std::atomic<size_t> numDone { 0 };
+        std::mutex mutex;
+        std::condition_variable allDone;
+    };
+    auto state = std::make_shared<SharedState>();
+    const auto* workPointer = &work;
+    std::function<void()> runWork = [state, count, workPointer] {
+        size_t index;
+        while ((index = state->next++) < count) {
+            (*workPointer)(index);
+            if (++state->numDone == count) {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->allDone.notify_all();
+            }
+        }
+    };
+
+    // The last share of the work is for this thread
+    const size_t numWorkers = std::min(count, (size_t)std::max(1, QThread::idealThreadCount() - 2)) - 1;
+    for (size_t i = 0; i < numWorkers; i++) {
+        startConcurrentWork(runWork);
+    }
+    runWork();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->allDone.wait(lock, [&] { return state->numDone == count; });
+}
+
+std::vector<size_t> Task::findConcurrentDependencies(const Varying& input) const {
+    std::vector<size_t> dependencies;
+    const size_t last = _jobs.size() - 1;
+    if (!_jobs[last].isConcurrent()) {
+        return dependencies;
+    }
+    // A job which is not concurrent is done before the concurrent jobs after it start
+    for (size_t i = last; i > 0 && _jobs[i - 1].isConcurrent(); i--) {
+        if (input.sharesDataWith(_jobs[i - 1].getOutput())) {
+            dependencies.push_back(i - 1);
+        }
+    }
+    return dependencies;
+}
+
+void Task::runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    const auto taskStart = usecTimestampNow();
+    size_t i = 0;
+    while (i < _jobs.size()) {
+        if (!_jobs[i].isConcurrent()) {
+            _jobs[i].run(sceneContext, renderContext, taskStart);
+            i++;
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < _jobs.size() && _jobs[end].isConcurrent()) {
+            end++;
+        }
+        runConcurrentJobs(sceneContext, renderContext, i, end, taskStart);
+        i = end;
+    }
+}
+
+void Task::runConcurrentJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
+        size_t begin, size_t end, quint64 taskStart) {
+    const size_t numJobs = end - begin;
+    std::mutex mutex;
+    std::condition_variable allDone;
+    size_t numDone = 0;
+    std::vector<size_t> numPendingDependencies(numJobs, 0);
+    std::vector<std::vector<size_t>> dependents(numJobs);
+    std::vector<quint64> starts(numJobs, 0);
+    std::vector<quint64> ends(numJobs, 0);
+
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < numJobs; i++) {
+        const auto& dependencies = _jobDependencies[begin + i];
+        numPendingDependencies[i] = dependencies.size();
+        for (auto dependency : dependencies) {
+            dependents[dependency - begin].push_back(i);
+        }
+        if (dependencies.empty()) {
+            ready.push_back(i);
+        }
+    }
+
+    // Runs a job, then the jobs it was the last dependency of: one on the same thread, the others on the pool
+    std::function<void(size_t)> runFrom = [&](size_t index) {
+        while (true) {
+            auto& job = _jobs[begin + index];
+            // Each job gets its own context, as the job config is set in it while running
+            auto jobContext = std::make_shared<RenderContext>(*renderContext);
+            auto start = usecTimestampNow();
+            {
+                PROFILE_RANGE(render, job._name.c_str());
+                job._concept->run(sceneContext, jobContext);
+            }
+            auto finish = usecTimestampNow();
+
+            std::vector<size_t> next;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                starts[index] = start;
+                ends[index] = finish;
+                for (auto dependent : dependents[index]) {
+                    if (--numPendingDependencies[dependent] == 0) {
+                        next.push_back(dependent);
+                    }
+                }
+                if (++numDone == numJobs) {
+                    allDone.notify_all();
+                }
+            }
+            if (next.empty()) {
+                return;
+            }
+            index = next.back();
+            next.pop_back();
+            for (auto other : next) {
+                startConcurrentWork([&runFrom, other] { runFrom(other); });
+            }
+        }
+    };
+
+    auto first = ready.back();
+    ready.pop_back();
+    for (auto other : ready) {
+        startConcurrentWork([&runFrom, other] { runFrom(other); });
+    }
+    runFrom(first);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone.wait(lock, [&] { return numDone == numJobs; });
+    }
+
+    // The stats are reported from the render thread, as for the jobs run in order
+    for (size_t i = 0; i < numJobs; i++) {
+        auto& job = _jobs[begin + i];
+        if (PerformanceTimer::isActive()) {
+            PerformanceTimer::addTimerRecord(PerformanceTimer::getContextName() + "/" + job._name.c_str(), ends[i] - starts[i]);
+        }
+        job._concept->setCPUStartTime((double)(starts[i] - taskStart) / 1000.0);
+        job._concept->setCPURunTime((double)(ends[i] - starts[i]) / 1000.0);
+    }
+}
@@ -11,7 +11,10 @@
 
 #ifndef hifi_render_Task_h
 #define hifi_render_Task_h
+#include <array>
+#include <functional>
 #include <tuple>
+#include <vector>
 
 #include <QtCore/qobject.h>
 
@@ -32,6 +35,11 @@ namespace render {
 
 class Varying;
 
+// Gather the varyings held by a set or an array of varyings; any other data holds none
+inline void appendSubVaryings(const void* data, std::vector<Varying>& subVaryings) {}
+inline void appendSubVaryings(const std::pair<Varying, Varying>* pair, std::vector<Varying>& subVaryings);
+template <class... T> void appendSubVaryings(const std::tuple<T...>* tuple, std::vector<Varying>& subVaryings);
+template <size_t N> void appendSubVaryings(const std::array<Varying, N>* array, std::vector<Varying>& subVaryings);
 
 // A varying piece of data, to be used as Job/Task I/O
 // TODO: Task IO
@@ -57,6 +65,10 @@ public:
     template <class T> Varying getN (uint8_t index) const { return get<T>()[index]; }
     template <class T> Varying editN (uint8_t index) { return edit<T>()[index]; }
 
+    // True if both varyings hold the same data, or hold sets / arrays with varyings in common:
+    // this is how a job input is found to be the output of another job
+    bool sharesDataWith(const Varying& other) const;
+
 protected:
     class Concept {
     public:
@@ -64,6 +76,8 @@ protected:
 
         virtual Varying operator[] (uint8_t index) const = 0;
         virtual uint8_t length() const = 0;
+
+        virtual void appendSubVaryings(std::vector<Varying>& subVaryings) const = 0;
     };
     template <class T> class Model : public Concept {
     public:
@@ -78,9 +92,15 @@ protected:
         }
         virtual uint8_t length() const override { return 0; }
 
+        virtual void appendSubVaryings(std::vector<Varying>& subVaryings) const override {
+            render::appendSubVaryings(&_data, subVaryings);
+        }
+
         Data _data;
     };
 
+    void appendData(std::vector<const Concept*>& data) const;
+
     std::shared_ptr<Concept> _concept;
 };
 
@@ -300,6 +320,28 @@ public:
     }
 };
 
+inline void appendSubVarying(const Varying& varying, std::vector<Varying>& subVaryings) { subVaryings.push_back(varying); }
+template <class T> void appendSubVarying(const T& data, std::vector<Varying>& subVaryings) {}
+
+template <size_t I, class... T> typename std::enable_if<(I == sizeof...(T))>::type
+appendTupleVaryings(const std::tuple<T...>& tuple, std::vector<Varying>& subVaryings) {}
+template <size_t I, class... T> typename std::enable_if<(I < sizeof...(T))>::type
+appendTupleVaryings(const std::tuple<T...>& tuple, std::vector<Varying>& subVaryings) {
+    appendSubVarying(std::get<I>(tuple), subVaryings);
+    appendTupleVaryings<I + 1>(tuple, subVaryings);
+}
+
+inline void appendSubVaryings(const std::pair<Varying, Varying>* pair, std::vector<Varying>& subVaryings) {
+    subVaryings.push_back(pair->first);
+    subVaryings.push_back(pair->second);
+}
+template <class... T> void appendSubVaryings(const std::tuple<T...>* tuple, std::vector<Varying>& subVaryings) {
+    appendTupleVaryings<0>(*tuple, subVaryings);
+}
+template <size_t N> void appendSubVaryings(const std::array<Varying, N>* array, std::vector<Varying>& subVaryings) {
+    subVaryings.insert(subVaryings.end(), array->begin(), array->end());
+}
+
 class Job;
 class Task;
 class JobNoIO {};
@@ -371,9 +413,11 @@ protected:
 class JobConfig : public QObject {
     Q_OBJECT
     Q_PROPERTY(double cpuRunTime READ getCPURunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double cpuStartTime READ getCPUStartTime NOTIFY newStats()) //ms
     Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled)
 
     double _msCPURunTime{ 0.0 };
+    double _msCPUStartTime{ 0.0 };
 public:
     using Persistent = PersistentConfig<JobConfig>;
 
@@ -404,6 +448,11 @@ public:
     void setCPURunTime(double mstime) { _msCPURunTime = mstime; emit newStats(); }
     double getCPURunTime() const { return _msCPURunTime; }
 
+    // Wall clock time from the start of the parent task to the start of the job, set before the cpu runtime:
+    // with concurrent jobs, the jobs ending with their task are on its critical path
+    void setCPUStartTime(double mstime) { _msCPUStartTime = mstime; }
+    double getCPUStartTime() const { return _msCPUStartTime; }
+
 public slots:
     void load(const QJsonObject& val) { qObjectFromJsonValue(val, *this); emit loaded(); }
 
@@ -520,10 +569,12 @@ public:
 
     protected:
         void setCPURunTime(double mstime) { std::static_pointer_cast<Config>(_config)->setCPURunTime(mstime); }
+        void setCPUStartTime(double mstime) { std::static_pointer_cast<Config>(_config)->setCPUStartTime(mstime); }
 
         QConfigPointer _config;
 
         friend class Job;
+        friend class Task;
     };
     using ConceptPointer = std::shared_ptr<Concept>;
 
@@ -564,6 +615,11 @@ public:
 
     Job(std::string name, ConceptPointer concept) : _concept(concept), _name(name) {}
 
+    // A concurrent job may run on a worker thread, at the same time as the other concurrent jobs of its task
+    // that it does not depend on
+    bool isConcurrent() const { return _concurrent; }
+    void setConcurrent(bool concurrent) { _concurrent = concurrent; }
+
     const Varying getInput() const { return _concept->getInput(); }
     const Varying getOutput() const { return _concept->getOutput(); }
     QConfigPointer& getConfiguration() const { return _concept->getConfiguration(); }
@@ -575,21 +631,33 @@ public:
         return concept->_data;
     }
 
-    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
+    void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext, quint64 taskStart) {
         PerformanceTimer perfTimer(_name.c_str());
         PROFILE_RANGE(render, _name.c_str());
         auto start = usecTimestampNow();
 
         _concept->run(sceneContext, renderContext);
 
+        _concept->setCPUStartTime((double)(start - taskStart) / 1000.0);
         _concept->setCPURunTime((double)(usecTimestampNow() - start) / 1000.0);
     }
 
     protected:
+    friend class Task;
+
     ConceptPointer _concept;
     std::string _name = "";
+    bool _concurrent { false };
 };
 
+// Start some work on the worker threads of the concurrent jobs, for a job splitting its own work:
+// the job should do its share of the work rather than just wait for the workers, which may all be busy
+void startConcurrentWork(std::function<void()> work);
+
+// Run work(0) to work(count - 1) on this thread and the workers of the concurrent jobs, in any order,
+// and return once they are all done
+void runConcurrentWork(size_t count, const std::function<void(size_t)>& work);
+
 // A task is a specialized job to run a collection of other jobs
 // It is defined with JobModel = Task::Model<T>
 class Task {
@@ -623,9 +691,7 @@ public:
         void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) override {
             auto config = std::static_pointer_cast<Config>(_config);
             if (config->alwaysEnabled || config->enabled) {
-                for (auto job : _data._jobs) {
-                    job.run(sceneContext, renderContext);
-                }
+                _data.runJobs(sceneContext, renderContext);
             }
         }
     };
@@ -636,6 +702,8 @@ public:
     // Create a new job in the container's queue; returns the job's output
     template <class T, class... A> const Varying addJob(std::string name, const Varying& input, A&&... args) {
         _jobs.emplace_back(name, std::make_shared<typename T::JobModel>(input, std::forward<A>(args)...));
+        _jobs.back().setConcurrent(_addConcurrentJobs);
+        _jobDependencies.push_back(findConcurrentDependencies(input));
         QConfigPointer config = _jobs.back().getConfiguration();
         config->setParent(getConfiguration().get());
         config->setObjectName(name.c_str());
@@ -659,6 +727,13 @@ public:
         _output = Varying(output);
     }
 
+    // The jobs added after enabling this run concurrently on a worker pool, each one as soon as the jobs producing
+    // its input are done. Only jobs which do not touch the gpu nor change state shared through the render args
+    // (other than through their own output and config) should be concurrent, and no tasks as their jobs are
+    // timed on the render thread; the other jobs run in order on the render thread, after the concurrent jobs
+    // before them.
+    void setConcurrentJobs(bool concurrent) { _addConcurrentJobs = concurrent; }
+
     template <class C> void createConfiguration() {
         auto config = std::make_shared<C>();
         if (_config) {
@@ -693,17 +768,24 @@ public:
     }
 
     void run(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext) {
-        for (auto job : _jobs) {
-            job.run(sceneContext, renderContext);
-        }
+        runJobs(sceneContext, renderContext);
     }
 
 protected:
     template <class T, class C> friend class Model;
 
+    void runJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext);
+    void runConcurrentJobs(const SceneContextPointer& sceneContext, const RenderContextPointer& renderContext,
+        size_t begin, size_t end, quint64 taskStart);
+
+    // The concurrent jobs added just before the last job, which produce some of its input
+    std::vector<size_t> findConcurrentDependencies(const Varying& input) const;
+
     QConfigPointer _config;
     Jobs _jobs;
+    std::vector<std::vector<size_t>> _jobDependencies;
     Varying _output;
+    bool _addConcurrentJobs { false };
 };
 
 }
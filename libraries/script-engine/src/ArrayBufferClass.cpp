@@ -19,6 +19,7 @@
 #include "ArrayBufferClass.h"
 
 static const QString CLASS_NAME = "ArrayBuffer";
+static const QString OWNER_PROPERTY_NAME = "__owner__";
 
 Q_DECLARE_METATYPE(QByteArray*)
 
@@ -32,6 +33,7 @@ _scriptEngine(scriptEngine) {
     // Save string handles for quick lookup
     _name = engine()->toStringHandle(CLASS_NAME.toLatin1());
     _byteLength = engine()->toStringHandle(BYTE_LENGTH_PROPERTY_NAME.toLatin1());
+    _owner = engine()->toStringHandle(OWNER_PROPERTY_NAME.toLatin1());
     
     // build prototype
     _proto = engine()->newQObject(new ArrayBufferPrototype(this),
@@ -84,6 +86,26 @@ QScriptValue ArrayBufferClass::newInstance(const QByteArray& ba) {
     return engine()->newObject(this, data);
 }
 
+QScriptValue ArrayBufferClass::newExternalInstance(const char* data, int size, const QScriptValue& owner) {
+    // a QByteArray of raw data references the memory, and detaches from it on the first write
+    QScriptValue object = newInstance(QByteArray::fromRawData(data, size));
+    object.setProperty(_owner, owner, QScriptValue::ReadOnly | QScriptValue::Undeletable | QScriptValue::SkipInEnumeration);
+    return object;
+}
+
+QScriptValue ArrayBufferClass::newExternalInstance(QScriptEngine* engine, const char* data, int size, const QScriptValue& owner) {
+    QScriptValue ctor = engine->globalObject().property(CLASS_NAME);
+    ArrayBufferClass* cls = qscriptvalue_cast<ArrayBufferClass*>(ctor.data());
+    if (!cls) {
+        return engine->newVariant(QVariant::fromValue(QByteArray(data, size)));
+    }
+    return cls->newExternalInstance(data, size, owner);
+}
+
+bool ArrayBufferClass::isExternal(const QScriptValue& object) {
+    return object.property(OWNER_PROPERTY_NAME).isValid();
+}
+
 QScriptValue ArrayBufferClass::construct(QScriptContext* context, QScriptEngine* engine) {
     ArrayBufferClass* cls = qscriptvalue_cast<ArrayBufferClass*>(context->callee().data());
     if (!cls) {
@@ -151,5 +173,9 @@ QScriptValue ArrayBufferClass::toScriptValue(QScriptEngine* engine, const QByteA
 
 void ArrayBufferClass::fromScriptValue(const QScriptValue& obj, QByteArray& ba) {
     ba = qvariant_cast<QByteArray>(obj.data().toVariant());
+    if (isExternal(obj)) {
+        // the memory of an external buffer only lives as long as its owner in the script
+        ba = QByteArray(ba.constData(), ba.size());
+    }
 }
 
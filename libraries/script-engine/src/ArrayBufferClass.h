@@ -29,6 +29,13 @@ public:
     QScriptValue newInstance(qint32 size);
     QScriptValue newInstance(const QByteArray& ba);
 
+    // an ArrayBuffer over native memory, without copying it. The owner is kept with the buffer, and so with its views,
+    // and must keep the memory unchanged for as long. A write from the script copies the memory first, and so does
+    // passing the buffer back to C++, which then has bytes of its own
+    QScriptValue newExternalInstance(const char* data, int size, const QScriptValue& owner);
+    static QScriptValue newExternalInstance(QScriptEngine* engine, const char* data, int size, const QScriptValue& owner);
+    static bool isExternal(const QScriptValue& object);
+
     QueryFlags queryProperty(const QScriptValue& object,
                              const QScriptString& name,
                              QueryFlags flags, uint* id) override;
@@ -54,6 +61,7 @@ private:
     // JS Object attributes
     QScriptString _name;
     QScriptString _byteLength;
+    QScriptString _owner;
 
     ScriptEngine* _scriptEngine;
 };
@@ -46,7 +46,8 @@ QByteArray ArrayBufferPrototype::slice(qint32 begin) const {
     // here we clamp the indices to fit the array
     begin = glm::clamp(begin, 0, (ba->size() - 1));
     
-    return ba->mid(begin, -1);
+    // not mid(), which returns the same bytes for the whole buffer, and those of an external buffer only live as long as it
+    return (begin >= 0) ? QByteArray(ba->constData() + begin, ba->size() - begin) : QByteArray();
 }
 
 QByteArray ArrayBufferPrototype::compress() const {
@@ -81,7 +82,7 @@ QByteArray ArrayBufferPrototype::recodeImage(const QString& sourceFormat, const
         return buffer.data();
     }
     
-    return *ba;
+    return ArrayBufferClass::isExternal(thisObject()) ? QByteArray(ba->constData(), ba->size()) : *ba;
 }
 
 QByteArray* ArrayBufferPrototype::thisArrayBuffer() const {
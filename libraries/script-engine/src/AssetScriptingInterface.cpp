@@ -54,6 +54,14 @@ void AssetScriptingInterface::setMapping(QString path, QString hash, QScriptValu
 
 
 void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callback) {
+    download(urlString, callback, false);
+}
+
+void AssetScriptingInterface::downloadArrayBuffer(QString urlString, QScriptValue callback) {
+    download(urlString, callback, true);
+}
+
+void AssetScriptingInterface::download(QString urlString, QScriptValue callback, bool asArrayBuffer) {
     const QString ATP_SCHEME { "atp:" };
 
     if (!urlString.startsWith(ATP_SCHEME)) {
@@ -70,12 +78,14 @@ void AssetScriptingInterface::downloadData(QString urlString, QScriptValue callb
 
     _pendingRequests << assetRequest;
 
-    connect(assetRequest, &AssetRequest::finished, this, [this, callback](AssetRequest* request) mutable {
+    connect(assetRequest, &AssetRequest::finished, this, [this, callback, asArrayBuffer](AssetRequest* request) mutable {
         Q_ASSERT(request->getState() == AssetRequest::Finished);
 
         if (request->getError() == AssetRequest::Error::NoError) {
             if (callback.isFunction()) {
-                QString data = QString::fromUtf8(request->getData());
+                // the ArrayBuffer shares the bytes of the request
+                QScriptValue data = asArrayBuffer ? _engine->toScriptValue(request->getData()) :
+                    QScriptValue(QString::fromUtf8(request->getData()));
                 QScriptValueList args { data };
                 callback.call(_engine->currentContext()->thisObject(), args);
             }
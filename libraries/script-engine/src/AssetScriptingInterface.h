@@ -60,6 +60,22 @@ public:
 
     Q_INVOKABLE void downloadData(QString url, QScriptValue downloadComplete);
 
+    /**jsdoc
+     * Download data from the connected domain's asset server, without decoding it as text.
+     * @function Assets.downloadArrayBuffer
+     * @static
+     * @param url {string} url of asset to download, must be atp scheme url.
+     * @param callback {Assets~downloadArrayBufferCallback}
+     */
+
+    /**jsdoc
+     * Called when downloadArrayBuffer is complete
+     * @callback Assets~downloadArrayBufferCallback
+     * @param data {ArrayBuffer} content that was downloaded, sharing the memory of the download until it is written to
+     */
+
+    Q_INVOKABLE void downloadArrayBuffer(QString url, QScriptValue downloadComplete);
+
     /**jsdoc
      * Sets up a path to hash mapping within the connected domain's asset server
      * @function Assets.setMapping
@@ -80,6 +96,8 @@ public:
 #endif
 
 protected:
+    void download(QString urlString, QScriptValue callback, bool asArrayBuffer);
+
     QSet<AssetRequest*> _pendingRequests;
     QScriptEngine* _engine;
 };
@@ -0,0 +1,40 @@
+//
+//  MeshProxy.cpp
+//  libraries/script-engine/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshProxy.h"
+
+#include <QtScript/QScriptEngine>
+
+#include "ArrayBufferClass.h"
+
+QScriptValue MeshProxy::getVertexBuffer() {
+    return newBufferViewInstance(_mesh->getVertexBuffer(), _mesh->getNumVertices());
+}
+
+QScriptValue MeshProxy::getIndexBuffer() {
+    return newBufferViewInstance(_mesh->getIndexBuffer(), _mesh->getNumIndices());
+}
+
+QScriptValue MeshProxy::newBufferViewInstance(const model::Mesh::BufferView& view, size_t numElements) {
+    QScriptEngine* scriptEngine = engine();
+    if (!scriptEngine) {
+        return QScriptValue();
+    }
+    if (!view._buffer || numElements == 0) {
+        return ArrayBufferClass::newExternalInstance(scriptEngine, nullptr, 0, QScriptValue());
+    }
+    const char* data = reinterpret_cast<const char*>(view._buffer->getData() + view._offset);
+    int size = (int)(numElements * view._stride);
+
+    // the buffer holds the mesh, and with it the memory of the view
+    QScriptValue owner = scriptEngine->newVariant(QVariant::fromValue(_mesh));
+    return ArrayBufferClass::newExternalInstance(scriptEngine, data, size, owner);
+}
@@ -12,11 +12,15 @@
 #ifndef hifi_MeshProxy_h
 #define hifi_MeshProxy_h
 
+#include <QtScript/QScriptable>
+#include <QtScript/QScriptValue>
+
 #include <model/Geometry.h>
 
 using MeshPointer = std::shared_ptr<model::Mesh>;
+Q_DECLARE_METATYPE(MeshPointer);
 
-class MeshProxy : public QObject {
+class MeshProxy : public QObject, protected QScriptable {
     Q_OBJECT
 
 public:
@@ -28,8 +32,17 @@ public:
     Q_INVOKABLE int getNumVertices() const { return (int)_mesh->getNumVertices(); }
     Q_INVOKABLE glm::vec3 getPos3(int index) const { return _mesh->getPos3(index); }
 
+    // the vertex and index buffers of the mesh as ArrayBuffers over its memory, which keep the mesh alive and are only
+    // copied when written to by the script, with getVertexStride() bytes per vertex
+    Q_INVOKABLE QScriptValue getVertexBuffer();
+    Q_INVOKABLE int getVertexStride() const { return (int)_mesh->getVertexBuffer()._stride; }
+    Q_INVOKABLE QScriptValue getIndexBuffer();
+    Q_INVOKABLE int getNumIndices() const { return (int)_mesh->getNumIndices(); }
+
 
 protected:
+    QScriptValue newBufferViewInstance(const model::Mesh::BufferView& view, size_t numElements);
+
     MeshPointer _mesh;
 };
 
@@ -0,0 +1,298 @@
+//
+//  NativeMathBindings.cpp
+//  libraries/script-engine/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NativeMathBindings.h"
+
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#include <QtScript/QScriptContext>
+#include <QtScript/QScriptEngine>
+
+#include <RegisteredMetaTypes.h>
+
+#include "Quat.h"
+#include "Vec3.h"
+
+using NativeFunction = QScriptValue (*)(QScriptContext*, QScriptEngine*);
+
+// true when the arguments are objects for each 'o' of types and numbers for each 'n'
+static bool hasArguments(QScriptContext* context, const char* types) {
+    int count = (int)strlen(types);
+    if (context->argumentCount() != count) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        QScriptValue argument = context->argument(i);
+        if (types[i] == 'o' ? !argument.isObject() : !argument.isNumber()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the slot of the library, which handles the overloads and the errors of any other arguments
+static QScriptValue callSlot(QScriptContext* context, const char* name) {
+    QScriptValue library = context->callee().data();
+    return library.property(name).call(library, context->argumentsObject());
+}
+
+static Vec3* getVec3(QScriptContext* context) {
+    return static_cast<Vec3*>(context->callee().data().toQObject());
+}
+
+static Quat* getQuat(QScriptContext* context) {
+    return static_cast<Quat*>(context->callee().data().toQObject());
+}
+
+static glm::vec3 toVec3(QScriptContext* context, int index) {
+    glm::vec3 result;
+    vec3FromScriptValue(context->argument(index), result);
+    return result;
+}
+
+static glm::quat toQuat(QScriptContext* context, int index) {
+    glm::quat result;
+    quatFromScriptValue(context->argument(index), result);
+    return result;
+}
+
+static float toFloat(QScriptContext* context, int index) {
+    return (float)context->argument(index).toNumber();
+}
+
+static QScriptValue vec3Sum(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "sum");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->sum(toVec3(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue vec3Subtract(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "subtract");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->subtract(toVec3(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue vec3Multiply(QScriptContext* context, QScriptEngine* engine) {
+    if (hasArguments(context, "on")) {
+        return vec3toScriptValue(engine, getVec3(context)->multiply(toVec3(context, 0), toFloat(context, 1)));
+    }
+    if (hasArguments(context, "no")) {
+        return vec3toScriptValue(engine, getVec3(context)->multiply(toFloat(context, 0), toVec3(context, 1)));
+    }
+    return callSlot(context, "multiply");
+}
+
+static QScriptValue vec3MultiplyVbyV(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "multiplyVbyV");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->multiplyVbyV(toVec3(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue vec3MultiplyQbyV(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "multiplyQbyV");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->multiplyQbyV(toQuat(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue vec3Dot(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "dot");
+    }
+    return getVec3(context)->dot(toVec3(context, 0), toVec3(context, 1));
+}
+
+static QScriptValue vec3Cross(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "cross");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->cross(toVec3(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue vec3Length(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "length");
+    }
+    return getVec3(context)->length(toVec3(context, 0));
+}
+
+static QScriptValue vec3Distance(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "distance");
+    }
+    return getVec3(context)->distance(toVec3(context, 0), toVec3(context, 1));
+}
+
+static QScriptValue vec3Normalize(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "normalize");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->normalize(toVec3(context, 0)));
+}
+
+static QScriptValue vec3Mix(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oon")) {
+        return callSlot(context, "mix");
+    }
+    return vec3toScriptValue(engine, getVec3(context)->mix(toVec3(context, 0), toVec3(context, 1), toFloat(context, 2)));
+}
+
+static QScriptValue quatMultiply(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "multiply");
+    }
+    return quatToScriptValue(engine, getQuat(context)->multiply(toQuat(context, 0), toQuat(context, 1)));
+}
+
+static QScriptValue quatNormalize(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "normalize");
+    }
+    return quatToScriptValue(engine, getQuat(context)->normalize(toQuat(context, 0)));
+}
+
+static QScriptValue quatInverse(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "inverse");
+    }
+    return quatToScriptValue(engine, getQuat(context)->inverse(toQuat(context, 0)));
+}
+
+static QScriptValue quatConjugate(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "conjugate");
+    }
+    return quatToScriptValue(engine, getQuat(context)->conjugate(toQuat(context, 0)));
+}
+
+static QScriptValue quatGetFront(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "getFront");
+    }
+    return vec3toScriptValue(engine, getQuat(context)->getFront(toQuat(context, 0)));
+}
+
+static QScriptValue quatGetRight(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "getRight");
+    }
+    return vec3toScriptValue(engine, getQuat(context)->getRight(toQuat(context, 0)));
+}
+
+static QScriptValue quatGetUp(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "getUp");
+    }
+    return vec3toScriptValue(engine, getQuat(context)->getUp(toQuat(context, 0)));
+}
+
+static QScriptValue quatAngleAxis(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "no")) {
+        return callSlot(context, "angleAxis");
+    }
+    return quatToScriptValue(engine, getQuat(context)->angleAxis(toFloat(context, 0), toVec3(context, 1)));
+}
+
+static QScriptValue quatFromPitchYawRollDegrees(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "nnn")) {
+        return callSlot(context, "fromPitchYawRollDegrees");
+    }
+    return quatToScriptValue(engine,
+        getQuat(context)->fromPitchYawRollDegrees(toFloat(context, 0), toFloat(context, 1), toFloat(context, 2)));
+}
+
+static QScriptValue quatFromVec3Degrees(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "fromVec3Degrees");
+    }
+    return quatToScriptValue(engine, getQuat(context)->fromVec3Degrees(toVec3(context, 0)));
+}
+
+static QScriptValue quatSafeEulerAngles(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "o")) {
+        return callSlot(context, "safeEulerAngles");
+    }
+    return vec3toScriptValue(engine, getQuat(context)->safeEulerAngles(toQuat(context, 0)));
+}
+
+static QScriptValue quatMix(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oon")) {
+        return callSlot(context, "mix");
+    }
+    return quatToScriptValue(engine, getQuat(context)->mix(toQuat(context, 0), toQuat(context, 1), toFloat(context, 2)));
+}
+
+static QScriptValue quatSlerp(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oon")) {
+        return callSlot(context, "slerp");
+    }
+    return quatToScriptValue(engine, getQuat(context)->slerp(toQuat(context, 0), toQuat(context, 1), toFloat(context, 2)));
+}
+
+static QScriptValue quatDot(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, "oo")) {
+        return callSlot(context, "dot");
+    }
+    return getQuat(context)->dot(toQuat(context, 0), toQuat(context, 1));
+}
+
+static void registerBindings(QScriptEngine* engine, const QString& name,
+                             std::initializer_list<std::pair<const char*, NativeFunction>> functions) {
+    QScriptValue library = engine->globalObject().property(name);
+    if (!library.isQObject()) {
+        return;
+    }
+    QScriptValue bindings = engine->newObject();
+    bindings.setPrototype(library);
+    for (const auto& function : functions) {
+        QScriptValue value = engine->newFunction(function.second);
+        value.setData(library);
+        bindings.setProperty(function.first, value, QScriptValue::SkipInEnumeration);
+    }
+    engine->globalObject().setProperty(name, bindings);
+}
+
+void registerNativeMathBindings(QScriptEngine* engine) {
+    registerBindings(engine, "Vec3", {
+        { "sum", vec3Sum },
+        { "subtract", vec3Subtract },
+        { "multiply", vec3Multiply },
+        { "multiplyVbyV", vec3MultiplyVbyV },
+        { "multiplyQbyV", vec3MultiplyQbyV },
+        { "dot", vec3Dot },
+        { "cross", vec3Cross },
+        { "length", vec3Length },
+        { "distance", vec3Distance },
+        { "normalize", vec3Normalize },
+        { "mix", vec3Mix }
+    });
+    registerBindings(engine, "Quat", {
+        { "multiply", quatMultiply },
+        { "normalize", quatNormalize },
+        { "inverse", quatInverse },
+        { "conjugate", quatConjugate },
+        { "getFront", quatGetFront },
+        { "getRight", quatGetRight },
+        { "getUp", quatGetUp },
+        { "angleAxis", quatAngleAxis },
+        { "fromPitchYawRollDegrees", quatFromPitchYawRollDegrees },
+        { "fromVec3Degrees", quatFromVec3Degrees },
+        { "safeEulerAngles", quatSafeEulerAngles },
+        { "mix", quatMix },
+        { "slerp", quatSlerp },
+        { "dot", quatDot }
+    });
+}
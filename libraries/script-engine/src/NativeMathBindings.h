@@ -0,0 +1,23 @@
+//
+//  NativeMathBindings.h
+//  libraries/script-engine/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NativeMathBindings_h
+#define hifi_NativeMathBindings_h
+
+class QScriptEngine;
+
+// Replaces the Vec3 and Quat globals of the engine by objects inheriting from them, with native functions for their
+// most used slots. These convert their arguments and results directly instead of going through the meta-object call
+// of the slot, and fall back to the slot for anything but the usual arguments. The other slots and the constants are
+// found on the prototype, which is the library itself.
+void registerNativeMathBindings(QScriptEngine* engine);
+
+#endif // hifi_NativeMathBindings_h
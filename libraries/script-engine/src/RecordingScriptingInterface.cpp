@@ -52,6 +52,16 @@ float RecordingScriptingInterface::playerLength() const {
     return _player->length();
 }
 
+QVariantMap RecordingScriptingInterface::playerStats() const {
+    auto stats = _player->getPlaybackStats();
+    QVariantMap result;
+    result["framesPlayed"] = stats.framesPlayed;
+    result["lateFrames"] = stats.lateFrames;
+    result["averageLateness"] = stats.averageLateness;
+    result["maxLateness"] = stats.maxLateness;
+    return result;
+}
+
 bool RecordingScriptingInterface::loadRecording(const QString& url) {
     using namespace recording;
 
@@ -13,6 +13,7 @@
 #include <mutex>
 
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
 
 #include <DependencyManager.h>
 #include <recording/Forward.h>
@@ -37,6 +38,9 @@ public slots:
 
     float playerElapsed() const;
     float playerLength() const;
+    // how late the frames were played since playback started: framesPlayed, lateFrames, averageLateness and maxLateness,
+    // in msecs
+    QVariantMap playerStats() const;
 
     void setPlayerVolume(float volume);
     void setPlayerAudioOffset(float audioOffset);
@@ -12,6 +12,7 @@
 #include "ScriptCache.h"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QEventLoop>
 #include <QNetworkAccessManager>
 #include <QNetworkConfiguration>
@@ -41,6 +42,7 @@ void ScriptCache::clearCache() {
         qCDebug(scriptengine) << "clearing cache: " << url;
     }
     _scriptCache.clear();
+    _verifiedPrograms.clear();
 }
 
 void ScriptCache::clearATPScriptsFromCache() {
@@ -65,6 +67,78 @@ void ScriptCache::deleteScript(const QUrl& unnormalizedURL) {
     }
 }
 
+QByteArray ScriptCache::getProgramKey(const QString& fileName, const QString& contents) {
+    return fileName.toUtf8() + '#' + QCryptographicHash::hash(contents.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+bool ScriptCache::isVerifiedProgram(const QByteArray& programKey) {
+    Lock lock(_containerLock);
+    return _verifiedPrograms.contains(programKey);
+}
+
+void ScriptCache::addVerifiedProgram(const QByteArray& programKey) {
+    Lock lock(_containerLock);
+    _verifiedPrograms.insert(programKey);
+}
+
+QStringList ScriptCache::getDependencyPaths(const QString& scriptContents) {
+    // a call, with an array of paths or a single one, and a path, alone or through Script.resolvePath, up to the next
+    // separator. A path built at run time ends the match and is left for the script engine to fetch
+    static const QRegularExpression DEPENDENCY_CALL { R"(\b(?:Script\.include|require)\s*\(\s*(\[)?)" };
+    static const QRegularExpression DEPENDENCY_PATH {
+        R"(\s*(?:Script\.resolvePath\s*\(\s*(["'])([^"'\\\r\n]+)\1\s*\)|(["'])([^"'\\\r\n]+)\3)\s*([,\])]))"
+    };
+
+    QStringList paths;
+    auto calls = DEPENDENCY_CALL.globalMatch(scriptContents);
+    while (calls.hasNext()) {
+        auto call = calls.next();
+        bool isArray = !call.captured(1).isEmpty();
+        int offset = call.capturedEnd();
+        forever {
+            auto match = DEPENDENCY_PATH.match(scriptContents, offset, QRegularExpression::NormalMatch,
+                QRegularExpression::AnchoredMatchOption);
+            if (!match.hasMatch()) {
+                break;
+            }
+            QString separator = match.captured(5);
+            if (separator == (isArray ? ")" : "]")) {
+                break;
+            }
+            paths << (match.captured(2).isEmpty() ? match.captured(4) : match.captured(2));
+            if (!isArray || separator != ",") {
+                break;
+            }
+            offset = match.capturedEnd();
+        }
+    }
+    return paths;
+}
+
+void ScriptCache::prefetchDependencies(const QUrl& url, const QString& scriptContents) {
+    if (url.isLocalFile()) {
+        return;
+    }
+    static const QRegularExpression RELATIVE_PATH { "^[.]{1,2}/" };
+    static const auto ignoreContents = [](const QString&, const QString&, bool, bool, const QString&) {};
+
+    foreach (const QString& path, getDependencyPaths(scriptContents)) {
+        QUrl dependencyURL(path);
+        if (dependencyURL.isRelative()) {
+            // local and standard library paths are read from disk, a bare require() id is a system module
+            if (path.startsWith("/") || (!path.endsWith(".js") && !RELATIVE_PATH.match(path).hasMatch())) {
+                continue;
+            }
+            dependencyURL = url.resolved(dependencyURL);
+        }
+        if (dependencyURL.isLocalFile() || dependencyURL.scheme().length() <= 1) {
+            continue;
+        }
+        // lands in the cache, or joins a request on its way, before the script engine asks for it
+        getScriptContents(dependencyURL.toString(), ignoreContents);
+    }
+}
+
 void ScriptCache::getScriptContents(const QString& scriptOrURL, contentAvailableCallback contentAvailable, bool forceDownload, int maxRetries) {
     #ifdef THREAD_DEBUGGING
     qCDebug(scriptengine) << "ScriptCache::getScriptContents() on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
@@ -129,6 +203,7 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
     std::vector<contentAvailableCallback> allCallbacks;
     QString status = QMetaEnum::fromType<ResourceRequest::Result>().valueToKey(req->getResult());
     bool success { false };
+    bool prefetch { false };
 
     {
         Q_ASSERT(req->getState() == ResourceRequest::Finished);
@@ -146,6 +221,7 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
 
                 _scriptCache[url] = scriptContent = req->getData();
                 qCDebug(scriptengine) << "Done downloading script at:" << url.toString();
+                prefetch = true;
             } else {
                 auto result = req->getResult();
                 bool irrecoverable =
@@ -195,6 +271,11 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
 
     req->deleteLater();
 
+    // the whole include tree is then fetched at once, rather than a level each time a script runs and includes the next
+    if (prefetch && !DependencyManager::get<ScriptEngines>()->isStopped()) {
+        prefetchDependencies(url, scriptContent);
+    }
+
     if (allCallbacks.size() > 0 && !DependencyManager::get<ScriptEngines>()->isStopped()) {
         foreach(contentAvailableCallback thisCallback, allCallbacks) {
             thisCallback(url.toString(), scriptContent, true, success, status);
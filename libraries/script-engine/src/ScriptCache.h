@@ -13,6 +13,10 @@
 #define hifi_ScriptCache_h
 
 #include <mutex>
+
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
 #include <ResourceCache.h>
 
 using contentAvailableCallback = std::function<void(const QString& scriptOrURL, const QString& contents, bool isURL, bool contentAvailable, const QString& status)>;
@@ -53,8 +57,20 @@ public:
 
     void deleteScript(const QUrl& unnormalizedURL);
 
+    /// the key of the compiled program of a script, the same for the same contents under the same file name
+    static QByteArray getProgramKey(const QString& fileName, const QString& contents);
+
+    /// the programs which passed the syntax and constructor checks of an entity script engine, which need not check
+    /// them again. The compiled programs themselves are bound to the engine which compiled them and are kept by each engine
+    bool isVerifiedProgram(const QByteArray& programKey);
+    void addVerifiedProgram(const QByteArray& programKey);
+
+    /// the paths given as string literals to the Script.include and require calls of a script, in the order they appear
+    static QStringList getDependencyPaths(const QString& scriptContents);
+
 private:
     void scriptContentAvailable(int maxRetries); // new version
+    void prefetchDependencies(const QUrl& url, const QString& scriptContents);
     ScriptCache(QObject* parent = NULL);
     
     Mutex _containerLock;
@@ -62,6 +78,7 @@ private:
     
     QHash<QUrl, QString> _scriptCache;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
+    QSet<QByteArray> _verifiedPrograms;
 };
 
 #endif // hifi_ScriptCache_h
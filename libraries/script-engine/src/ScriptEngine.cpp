@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -39,6 +40,7 @@
 #include <AvatarData.h>
 #include <DebugDraw.h>
 #include <EntityScriptingInterface.h>
+#include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
 #include <PathUtils.h>
@@ -58,6 +60,7 @@
 #include "EventTypes.h"
 #include "FileScriptingInterface.h" // unzip project
 #include "MenuItemProperties.h"
+#include "NativeMathBindings.h"
 #include "ScriptAudioInjector.h"
 #include "ScriptCache.h"
 #include "ScriptEngineLogging.h"
@@ -167,6 +170,14 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
 {
     DependencyManager::get<ScriptEngines>()->addScriptEngine(this);
 
+    _timerClock.start();
+    _timerWheelTimer.setSingleShot(true);
+    _timerWheelTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_timerWheelTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
+
+    // make sure the timers stop when the script does
+    connect(this, &ScriptEngine::scriptEnding, &_timerWheelTimer, &QTimer::stop);
+
     connect(this, &QScriptEngine::signalHandlerException, this, [this](const QScriptValue& exception) {
         if (hasUncaughtException()) {
             // the engine's uncaughtException() seems to produce much better stack traces here
@@ -563,6 +574,7 @@ void ScriptEngine::resetModuleCache(bool deleteScriptCache) {
         }
     }
     cache = newObject();
+    _programs.clear();
     if (!cacheMeta.isObject()) {
         cacheMeta = newObject();
         cacheMeta.setProperty("id", "Script.require.cacheMeta");
@@ -603,6 +615,7 @@ void ScriptEngine::init() {
     qScriptRegisterMetaType(this, AvatarEntityMapToScriptValue, AvatarEntityMapFromScriptValue);
     qScriptRegisterSequenceMetaType<QVector<QUuid>>(this);
     qScriptRegisterSequenceMetaType<QVector<EntityItemID>>(this);
+    qScriptRegisterSequenceMetaType<QVector<EntityItemProperties>>(this);
 
     qScriptRegisterSequenceMetaType<QVector<glm::vec2> >(this);
     qScriptRegisterSequenceMetaType<QVector<glm::quat> >(this);
@@ -646,6 +659,7 @@ void ScriptEngine::init() {
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
+    registerNativeMathBindings(this);
     registerGlobalObject("Mat4", &_mat4Library);
     registerGlobalObject("Uuid", &_uuidLibrary);
     registerGlobalObject("Messages", DependencyManager::get<MessagesClient>().data());
@@ -912,6 +926,10 @@ void ScriptEngine::addEventHandler(const EntityItemID& entityID, const QString&
     CallbackList& handlersForEvent = _registeredHandlers[entityID][eventName];
     CallbackData handlerData = { handler, currentEntityIdentifier, currentSandboxURL };
     handlersForEvent << handlerData; // Note that the same handler can be added many times. See removeEntityEventHandler().
+
+    if (eventName == "collisionWithEntity") {
+        DependencyManager::get<EntityScriptingInterface>()->addCollisionHandler(entityID);
+    }
 }
 
 // this is not redundant -- the version in BaseScriptEngine is specifically not Q_INVOKABLE
@@ -919,6 +937,15 @@ QScriptValue ScriptEngine::evaluateInClosure(const QScriptValue& closure, const
     return BaseScriptEngine::evaluateInClosure(closure, program);
 }
 
+QScriptProgram ScriptEngine::getProgram(const QString& sourceCode, const QString& fileName) {
+    auto key = ScriptCache::getProgramKey(fileName, sourceCode);
+    auto it = _programs.find(key);
+    if (it == _programs.end()) {
+        it = _programs.insert(key, QScriptProgram { sourceCode, fileName });
+    }
+    return it.value();
+}
+
 QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fileName, int lineNumber) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         return QScriptValue(); // bail early
@@ -1003,6 +1030,14 @@ void ScriptEngine::run() {
 
     std::chrono::microseconds totalUpdates(0);
 
+    // the watchdog of the entity script calls, it also fires while a long call processes events
+    QTimer timeSliceTimer;
+    if (_context == ENTITY_SERVER_SCRIPT || _context == ENTITY_CLIENT_SCRIPT) {
+        const int TIME_SLICE_CHECK_INTERVAL = 100; // msecs
+        connect(&timeSliceTimer, &QTimer::timeout, this, &ScriptEngine::checkEntityScriptTimeSlice);
+        timeSliceTimer.start(TIME_SLICE_CHECK_INTERVAL);
+    }
+
     // TODO: Integrate this with signals/slots instead of reimplementing throttling for ScriptEngine
     while (!_isFinished) {
         auto beforeSleep = clock::now();
@@ -1125,7 +1160,8 @@ void ScriptEngine::run() {
     emit scriptEnding();
 
     if (entityScriptingInterface->getEntityPacketSender()->serversExist()) {
-        // release the queue of edit entity messages.
+        // release the queue of edit entity messages, with the edits still being merged
+        entityScriptingInterface->getEntityPacketSender()->flushCoalescedEdits();
         entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
 
         // since we're in non-threaded mode, call process so that the packets are sent
@@ -1150,11 +1186,8 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : _timerFunctionMap.keys()) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
@@ -1162,14 +1195,14 @@ void ScriptEngine::stopAllTimers() {
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
      // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QVector<QObject*> toDelete;
+    QMutableHashIterator<QObject*, TimerData> i(_timerFunctionMap);
     while (i.hasNext()) {
         i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+        if (i.value().callback.definingEntityIdentifier != entityID) {
             continue;
         }
-        QTimer* timer = i.key();
+        QObject* timer = i.key();
         toDelete << timer; // don't delete while we're iterating. save it.
     }
     for (auto timer:toDelete) { // now reap 'em
@@ -1234,47 +1267,62 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    // the timers due on the same tick fire together, one of them may clear the next ones
+    std::vector<TimerWheel<QObject*>::DueTimer> dueTimers;
+    _timerWheel.advance(_timerClock.elapsed(), dueTimers);
+    _timerWheelTimerTick = TimerWheel<QObject*>::NO_TICK;
+    for (const auto& dueTimer : dueTimers) {
+        auto it = _timerFunctionMap.find(dueTimer.value);
+        if (it == _timerFunctionMap.end() || it->wheelID != dueTimer.id) {
+            continue;
+        }
+        CallbackData timerData = it->callback;
+        if (it->isSingleShot) {
+            // this timer is done, we can kill it
+            _timerFunctionMap.erase(it);
+            delete dueTimer.value;
+        } else {
+            it->wheelID = _timerWheel.add(dueTimer.value, it->interval);
+        }
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
+    scheduleTimerWheel();
+}
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+void ScriptEngine::scheduleTimerWheel() {
+    quint64 nextTick = _timerWheel.getNextTick();
+    if (nextTick == TimerWheel<QObject*>::NO_TICK) {
+        _timerWheelTimer.stop();
+        _timerWheelTimerTick = nextTick;
+    } else if (nextTick < _timerWheelTimerTick || !_timerWheelTimer.isActive()) {
+        quint64 now = _timerClock.elapsed();
+        _timerWheelTimer.start(nextTick > now ? (int)(nextTick - now) : 0);
+        _timerWheelTimerTick = nextTick;
     }
 }
 
 QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
-
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
-
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
+    // the handle of the timer, which lives in the wheel
+    QObject* newTimer = new QObject(this);
+
+    TimerData timerData = { { function, currentEntityIdentifier, currentSandboxURL }, std::max(intervalMS, 0), isSingleShot, 0 };
+    // the wheel only ticks when timers are due, add the time since its last tick
+    quint64 now = _timerClock.elapsed();
+    quint64 delay = now - std::min(now, _timerWheel.getTick()) + timerData.interval;
+    timerData.wheelID = _timerWheel.add(newTimer, delay);
     _timerFunctionMap.insert(newTimer, timerData);
 
-    newTimer->start(intervalMS);
+    scheduleTimerWheel();
     return newTimer;
 }
 
@@ -1296,10 +1344,11 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
+void ScriptEngine::stopTimer(QObject* timer) {
+    auto it = _timerFunctionMap.find(timer);
+    if (it != _timerFunctionMap.end()) {
+        _timerWheel.remove(it->wheelID);
+        _timerFunctionMap.erase(it);
         delete timer;
     } else {
         qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
@@ -1586,13 +1635,13 @@ QScriptValue ScriptEngine::instantiateModule(const QScriptValue& module, const Q
     if (module.property("content-type").toString() == "application/json") {
         qCDebug(scriptengine_module) << "... parsing as JSON";
         closure.setProperty("__json", sourceCode);
-        result = evaluateInClosure(closure, { "module.exports = JSON.parse(__json)", modulePath });
+        result = evaluateInClosure(closure, getProgram("module.exports = JSON.parse(__json)", modulePath));
     } else {
         // scoped vars for consistency with Node.js
         closure.setProperty("require", module.property("require"));
         closure.setProperty("__filename", modulePath, READONLY_HIDDEN_PROP_FLAGS);
         closure.setProperty("__dirname", QString(modulePath).replace(QRegExp("/[^/]*$"), ""), READONLY_HIDDEN_PROP_FLAGS);
-        result = evaluateInClosure(closure, { sourceCode, modulePath });
+        result = evaluateInClosure(closure, getProgram(sourceCode, modulePath));
     }
     maybeEmitUncaughtException(__FUNCTION__);
     return result;
@@ -1945,6 +1994,127 @@ bool ScriptEngine::getEntityScriptDetails(const EntityItemID& entityID, EntitySc
     return true;
 }
 
+static const quint64 ENTITY_SCRIPT_COST_INTERVAL = USECS_PER_SECOND;
+static const float ENTITY_SCRIPT_COST_SMOOTHING_RATE = 0.25f;
+
+void ScriptEngine::setEntityScriptTimeSlice(quint64 timeSlice, bool suspendRunaways) {
+    _entityScriptTimeSlice = timeSlice;
+    _suspendRunawayEntityScripts = suspendRunaways;
+}
+
+void ScriptEngine::addEntityScriptCall(const EntityItemID& entityID, quint64 startTime, quint64 endTime) {
+    quint64 elapsed = endTime - startTime;
+    quint64 timeSlice = _entityScriptTimeSlice;
+    bool overrun = timeSlice > 0 && elapsed > timeSlice;
+    {
+        std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+        rollEntityScriptCosts(endTime);
+        EntityScriptCost& cost = _entityScriptCosts[entityID];
+        cost.totalTime += elapsed;
+        cost.intervalTime += elapsed;
+        cost.longestCall = std::max(cost.longestCall, elapsed);
+        if (overrun) {
+            cost.numOverruns++;
+        }
+    }
+
+    if (overrun && _overrunEntityID != entityID) {
+        static QString repeatedMessage = LogHandler::getInstance().addRepeatedMessageRegex(
+            "^The entity script of .* took .* over its time slice.*");
+        qCWarning(scriptengine) << "The entity script of" << entityID << "took" << elapsed / USECS_PER_MSEC
+            << "ms, over its time slice of" << timeSlice / USECS_PER_MSEC << "ms";
+    }
+}
+
+void ScriptEngine::rollEntityScriptCosts(quint64 now) {
+    if (_lastCostRollTime == 0) {
+        _lastCostRollTime = now;
+        return;
+    }
+    if (now < _lastCostRollTime + ENTITY_SCRIPT_COST_INTERVAL) {
+        return;
+    }
+    float interval = (float)(now - _lastCostRollTime);
+    _lastCostRollTime = now;
+    for (auto& cost : _entityScriptCosts) {
+        float share = (float)cost.intervalTime / interval;
+        cost.cpuShare += ENTITY_SCRIPT_COST_SMOOTHING_RATE * (share - cost.cpuShare);
+        cost.intervalTime = 0;
+    }
+}
+
+QHash<EntityItemID, EntityScriptCost> ScriptEngine::getEntityScriptCosts() {
+    std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+    rollEntityScriptCosts(usecTimestampNow());
+    return _entityScriptCosts;
+}
+
+QVariantList ScriptEngine::getTopEntityScripts(int maxCount) {
+    return topEntityScriptsToVariant(getEntityScriptCosts(), maxCount);
+}
+
+QVariantList ScriptEngine::topEntityScriptsToVariant(const QHash<EntityItemID, EntityScriptCost>& costs, int maxCount) {
+    std::vector<std::pair<EntityItemID, EntityScriptCost>> sortedCosts;
+    for (auto it = costs.constBegin(); it != costs.constEnd(); ++it) {
+        sortedCosts.emplace_back(it.key(), it.value());
+    }
+    int count = std::max(std::min(maxCount, (int)sortedCosts.size()), 0);
+    std::partial_sort(sortedCosts.begin(), sortedCosts.begin() + count, sortedCosts.end(),
+        [](const std::pair<EntityItemID, EntityScriptCost>& a, const std::pair<EntityItemID, EntityScriptCost>& b) {
+            return a.second.cpuShare > b.second.cpuShare;
+        });
+
+    QVariantList list;
+    for (int i = 0; i < count; i++) {
+        const EntityScriptCost& cost = sortedCosts[i].second;
+        QVariantMap map;
+        map["entityID"] = sortedCosts[i].first.toString();
+        map["cpuShare"] = 100.0f * cost.cpuShare;
+        map["totalTime"] = (float)cost.totalTime / (float)USECS_PER_MSEC;
+        map["longestCall"] = (float)cost.longestCall / (float)USECS_PER_MSEC;
+        map["overruns"] = cost.numOverruns;
+        map["suspended"] = cost.suspended;
+        list.push_back(map);
+    }
+    return list;
+}
+
+void ScriptEngine::checkEntityScriptTimeSlice() {
+    quint64 timeSlice = _entityScriptTimeSlice;
+    if (timeSlice == 0 || _environmentDepth == 0 || _timedEntityID.isNull() || _overrunEntityID == _timedEntityID) {
+        return;
+    }
+    quint64 elapsed = usecTimestampNow() - _timedCallStartTime;
+    if (elapsed <= timeSlice) {
+        return;
+    }
+
+    // once per call
+    _overrunEntityID = _timedEntityID;
+    if (_suspendRunawayEntityScripts) {
+        qCWarning(scriptengine) << "Interrupting the entity script of" << _timedEntityID << "after" << elapsed / USECS_PER_MSEC
+            << "ms, its time slice is" << timeSlice / USECS_PER_MSEC << "ms";
+        raiseException(makeError(QString("Timed out (entity script calls are limited to %1ms)").arg(timeSlice / USECS_PER_MSEC)));
+    } else {
+        qCWarning(scriptengine) << "The entity script of" << _timedEntityID << "has been running for" << elapsed / USECS_PER_MSEC
+            << "ms, its time slice is" << timeSlice / USECS_PER_MSEC << "ms";
+    }
+}
+
+void ScriptEngine::suspendEntityScript(const EntityItemID& entityID, const QString& reason) {
+    qCWarning(scriptengine) << "Suspending the entity script of" << entityID << ":" << reason;
+    stopAllTimersForEntityScript(entityID);
+    _registeredHandlers.remove(entityID);
+    {
+        std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+        _entityScriptCosts[entityID].suspended = true;
+    }
+    // the script text is kept so the script only runs again once it is reloaded or changed
+    if (_entityScripts.contains(entityID)) {
+        updateEntityScriptStatus(entityID, EntityScriptStatus::ERROR_RUNNING_SCRIPT, "Suspended: " + reason);
+    }
+}
+
 const static EntityItemID BAD_SCRIPT_UUID_PLACEHOLDER { "{20170224-dead-face-0000-cee000021114}" };
 
 void ScriptEngine::processDeferredEntityLoads(const QString& entityScript, const EntityItemID& leaderID) {
@@ -2163,19 +2333,25 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         return;
     }
 
+    // the same contents already passed the checks below, in this engine or another one
+    auto programKey = ScriptCache::getProgramKey(fileName, contents);
+    bool isVerified = scriptCache->isVerifiedProgram(programKey);
+
     // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
-    if (syntaxError.isError()) {
-        auto message = syntaxError.property("formatted").toString();
-        if (message.isEmpty()) {
-            message = syntaxError.toString();
+    if (!isVerified) {
+        auto syntaxError = lintScript(contents, fileName);
+        if (syntaxError.isError()) {
+            auto message = syntaxError.property("formatted").toString();
+            if (message.isEmpty()) {
+                message = syntaxError.toString();
+            }
+            setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            syntaxError.setProperty("detail", entityID.toString());
+            emit unhandledException(syntaxError);
+            return;
         }
-        setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        syntaxError.setProperty("detail", entityID.toString());
-        emit unhandledException(syntaxError);
-        return;
     }
-    QScriptProgram program { contents, fileName };
+    QScriptProgram program = getProgram(contents, fileName);
     if (program.isNull()) {
         setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
         emit unhandledException(makeError("program.isNull"));
@@ -2186,62 +2362,65 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         setParentURL(scriptOrURL);
     }
 
-    // SANITY/PERFORMANCE CHECK USING SANDBOX
-    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
-    QScriptValue testConstructor, exception;
-    {
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT, scriptOrURL]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
-        });
+    if (!isVerified) {
+        // SANITY/PERFORMANCE CHECK USING SANDBOX
+        const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
+        BaseScriptEngine sandbox;
+        sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+        QScriptValue testConstructor, exception;
+        {
+            QTimer timeout;
+            timeout.setSingleShot(true);
+            timeout.start(SANDBOX_TIMEOUT);
+            connect(&timeout, &QTimer::timeout, [&sandbox, SANDBOX_TIMEOUT, scriptOrURL]{
+                    qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
+
+                    // Guard against infinite loops and non-performant code
+                    sandbox.raiseException(
+                        sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
+                    );
+            });
 
-        testConstructor = sandbox.evaluate(program);
+            testConstructor = sandbox.evaluate(QScriptProgram { contents, fileName });
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
-        } else if (testConstructor.isError()) {
-            exception = testConstructor;
+            if (sandbox.hasUncaughtException()) {
+                exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
+                sandbox.clearExceptions();
+            } else if (testConstructor.isError()) {
+                exception = testConstructor;
+            }
         }
-    }
 
-    if (exception.isError()) {
-        // create a local copy using makeError to decouple from the sandbox engine
-        exception = makeError(exception);
-        setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(exception);
-        return;
-    }
-
-    // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
-        QString testConstructorType = QString(testConstructor.toVariant().typeName());
-        if (testConstructorType == "") {
-            testConstructorType = "empty";
-        }
-        QString testConstructorValue = testConstructor.toString();
-        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
-            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+        if (exception.isError()) {
+            // create a local copy using makeError to decouple from the sandbox engine
+            exception = makeError(exception);
+            setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(exception);
+            return;
         }
-        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
-            .arg(testConstructorType).arg(testConstructorValue);
 
-        auto err = makeError(message);
-        err.setProperty("fileName", scriptOrURL);
-        err.setProperty("detail", "(constructor " + entityID.toString() + ")");
+        // CONSTRUCTOR VIABILITY
+        if (!testConstructor.isFunction()) {
+            QString testConstructorType = QString(testConstructor.toVariant().typeName());
+            if (testConstructorType == "") {
+                testConstructorType = "empty";
+            }
+            QString testConstructorValue = testConstructor.toString();
+            if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
+                testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+            }
+            auto message = QString("failed to load entity script -- expected a function, got %1, %2")
+                .arg(testConstructorType).arg(testConstructorValue);
+
+            auto err = makeError(message);
+            err.setProperty("fileName", scriptOrURL);
+            err.setProperty("detail", "(constructor " + entityID.toString() + ")");
 
-        setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(err);
-        return; // done processing script
+            setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(err);
+            return; // done processing script
+        }
+        scriptCache->addVerifiedProgram(programKey);
     }
 
     // (this feeds into refreshFileScript)
@@ -2255,7 +2434,9 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     QScriptValue entityScriptConstructor, entityScriptObject;
     QUrl sandboxURL = currentSandboxURL.isEmpty() ? scriptOrURL : currentSandboxURL;
     auto initialization = [&]{
-        entityScriptConstructor = evaluate(contents, fileName);
+        // a new constructor from the compiled program, each entity then constructs its own object
+        entityScriptConstructor = BaseScriptEngine::evaluate(program);
+        maybeEmitUncaughtException("evaluate");
         entityScriptObject = entityScriptConstructor.construct();
 
         if (hasUncaughtException()) {
@@ -2264,6 +2445,10 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         }
     };
 
+    {
+        std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+        _entityScriptCosts[entityID].suspended = false;
+    }
     doWithEnvironment(entityID, sandboxURL, initialization);
 
     if (entityScriptObject.isError()) {
@@ -2321,6 +2506,10 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
         if (shouldRemoveFromMap) {
             // this was a deleted entity, we've been asked to remove it from the map
             _entityScripts.remove(entityID);
+            {
+                std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+                _entityScriptCosts.remove(entityID);
+            }
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
             EntityScriptDetails newDetails;
@@ -2355,8 +2544,13 @@ void ScriptEngine::unloadAllEntityScripts() {
         unloadEntityScript(entityID);
     }
     _entityScripts.clear();
+    {
+        std::lock_guard<std::mutex> lock(_entityScriptCostsMutex);
+        _entityScriptCosts.clear();
+    }
     emit entityScriptDetailsUpdated();
     _occupiedScriptURLs.clear();
+    _programs.clear();
 
 #ifdef DEBUG_ENGINE_STATE
     _debugDump(
@@ -2400,6 +2594,12 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     QUrl oldSandboxURL = currentSandboxURL;
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
+    bool isOutermost = _environmentDepth++ == 0;
+    if (isOutermost) {
+        _timedEntityID = entityID;
+        _timedCallStartTime = usecTimestampNow();
+        _overrunEntityID = EntityItemID();
+    }
 
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
@@ -2412,6 +2612,16 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+    if (--_environmentDepth == 0) {
+        if (!entityID.isNull()) {
+            addEntityScriptCall(entityID, _timedCallStartTime, usecTimestampNow());
+            if (_overrunEntityID == entityID && _suspendRunawayEntityScripts) {
+                suspendEntityScript(entityID, QString("a call ran past its time slice of %1ms")
+                    .arg(_entityScriptTimeSlice / USECS_PER_MSEC));
+            }
+        }
+        _timedEntityID = EntityItemID();
+    }
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
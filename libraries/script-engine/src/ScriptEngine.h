@@ -12,21 +12,26 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <mutex>
 #include <vector>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
 #include <QtCore/QWaitCondition>
 #include <QtCore/QStringList>
 
 #include <QtScript/QScriptEngine>
+#include <QtScript/QScriptProgram>
 
 #include <AnimationCache.h>
 #include <AnimVariant.h>
 #include <AvatarData.h>
 #include <AvatarHashMap.h>
 #include <LimitedNodeList.h>
+#include <shared/TimerWheel.h>
 #include <EntityItemID.h>
 #include <EntitiesScriptEngineProvider.h>
 #include <EntityScriptUtils.h>
@@ -79,6 +84,17 @@ public:
     QUrl definingSandboxURL { QUrl("about:EntityScript") };
 };
 
+// The time spent running the code of an entity script, kept by its engine.
+class EntityScriptCost {
+public:
+    quint64 totalTime { 0 }; // usecs
+    quint64 intervalTime { 0 }; // usecs since the start of the current cost interval
+    float cpuShare { 0.0f }; // the smoothed fraction of the time spent running the script
+    quint64 longestCall { 0 }; // usecs
+    int numOverruns { 0 }; // the calls longer than the time slice
+    bool suspended { false };
+};
+
 class ScriptEngine : public BaseScriptEngine, public EntitiesScriptEngineProvider {
     Q_OBJECT
     Q_PROPERTY(QString context READ getContext)
@@ -172,8 +188,8 @@ public:
 
     Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
     Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(timer); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(timer); }
 
     Q_INVOKABLE void print(const QString& message);
     Q_INVOKABLE QUrl resolvePath(const QString& path) const;
@@ -225,6 +241,16 @@ public:
     int getNumRunningEntityScripts() const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
 
+    // a call of an entity script running longer than timeSlice usecs is reported, or interrupted and the script
+    // suspended when suspendRunaways, 0 for no limit. A running call is checked about once a second.
+    void setEntityScriptTimeSlice(quint64 timeSlice, bool suspendRunaways);
+    // safe from any thread
+    QHash<EntityItemID, EntityScriptCost> getEntityScriptCosts();
+    QVariantList getTopEntityScripts(int maxCount) override;
+    // the maxCount scripts with the largest cpu share as { entityID, cpuShare, totalTime, longestCall, overruns,
+    // suspended }, with the shares in percent and the times in msecs
+    static QVariantList topEntityScriptsToVariant(const QHash<EntityItemID, EntityScriptCost>& costs, int maxCount);
+
 public slots:
     void callAnimationStateHandler(QScriptValue callback, AnimVariantMap parameters, QStringList names, bool useNames, AnimVariantResultHandler resultHandler);
     void updateMemoryCost(const qint64&);
@@ -267,7 +293,10 @@ protected:
     void processDeferredEntityLoads(const QString& entityScript, const EntityItemID& leaderID);
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(QObject* timer);
+    void scheduleTimerWheel();
+
+    QScriptProgram getProgram(const QString& sourceCode, const QString& fileName);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -276,6 +305,10 @@ protected:
     EntityItemID currentEntityIdentifier {}; // Contains the defining entity script entity id during execution, if any. Empty for interface script execution.
     QUrl currentSandboxURL {}; // The toplevel url string for the entity script that loaded the code being executed, else empty.
     void doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation);
+    void addEntityScriptCall(const EntityItemID& entityID, quint64 startTime, quint64 endTime);
+    void rollEntityScriptCosts(quint64 now); // the caller holds _entityScriptCostsMutex
+    void checkEntityScriptTimeSlice();
+    void suspendEntityScript(const EntityItemID& entityID, const QString& reason);
     void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args);
 
     Context _context;
@@ -285,12 +318,30 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    class TimerData {
+    public:
+        CallbackData callback;
+        int interval; // msecs
+        bool isSingleShot;
+        TimerWheel<QObject*>::TimerID wheelID;
+    };
+
+    // the timers of the script are the entries of a wheel ticking in msecs of _timerClock, which are fired by one
+    // Qt timer set to the first of them, and the objects handed to the script are only their handles
+    QHash<QObject*, TimerData> _timerFunctionMap;
+    TimerWheel<QObject*> _timerWheel;
+    QElapsedTimer _timerClock;
+    QTimer _timerWheelTimer { this };
+    quint64 _timerWheelTimerTick { TimerWheel<QObject*>::NO_TICK }; // the tick the Qt timer is set to
     QSet<QUrl> _includedURLs;
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     QHash<QString, EntityItemID> _occupiedScriptURLs;
     QList<DeferredLoadEntity> _deferredEntityLoads;
 
+    // the programs of the entity scripts and modules, by ScriptCache::getProgramKey(). A QScriptProgram is compiled by
+    // the first engine evaluating it and is only reused by that one, so each engine keeps its own
+    QHash<QByteArray, QScriptProgram> _programs;
+
     bool _isThreaded { false };
     QScriptEngineDebugger* _debugger { nullptr };
     bool _debuggable { false };
@@ -314,6 +365,17 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    // nested environments are timed as part of the outermost one
+    int _environmentDepth { 0 };
+    EntityItemID _timedEntityID;
+    quint64 _timedCallStartTime { 0 };
+    EntityItemID _overrunEntityID; // already reported or interrupted in its current call
+    std::atomic<quint64> _entityScriptTimeSlice { 0 };
+    std::atomic<bool> _suspendRunawayEntityScripts { false };
+    std::mutex _entityScriptCostsMutex;
+    QHash<EntityItemID, EntityScriptCost> _entityScriptCosts;
+    quint64 _lastCostRollTime { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
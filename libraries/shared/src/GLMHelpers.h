@@ -107,6 +107,11 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// coarser variant of the above for rotations that can tolerate less precision (e.g. finger joints):
+// the smallest three components are packed into 10 bits each, for a maximum error of about +- 1.7e-3 per component.
+int packOrientationQuatToFourBytes(unsigned char* buffer, const glm::quat& quatInput);
+int unpackOrientationQuatFromFourBytes(const unsigned char* buffer, glm::quat& quatOutput);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -9,8 +9,16 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <chrono>
+#include <thread>
+
 #include <zlib.h>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QIODevice>
+
 #include "Gzip.h"
+#include "NumericalConstants.h"
 
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
@@ -151,3 +159,142 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+const int GZIP_STREAM_CHUNK_SIZE = 64 * 1024;
+
+// sleeps for as long as the bytes read so far are ahead of maxBytesPerSecond
+static void throttle(const QElapsedTimer& timer, qint64 bytesRead, qint64 maxBytesPerSecond) {
+    if (maxBytesPerSecond > 0) {
+        qint64 aheadMsecs = bytesRead * (qint64)MSECS_PER_SECOND / maxBytesPerSecond - timer.elapsed();
+        if (aheadMsecs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(aheadMsecs));
+        }
+    }
+}
+
+static bool writeAll(QIODevice& destination, const char* data, qint64 length) {
+    while (length > 0) {
+        qint64 written = destination.write(data, length);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel, qint64 maxBytesPerSecond,
+          const GzipProgress& progress) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+
+    int status = deflateInit2(&strm,
+                              qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)),
+                              Z_DEFLATED,
+                              GZIP_WINDOWS_BIT,
+                              DEFAULT_MEM_LEVEL,
+                              Z_DEFAULT_STRATEGY);
+    if (status != Z_OK) {
+        return false;
+    }
+
+    qint64 bytesTotal = source.isSequential() ? -1 : source.size();
+    qint64 bytesRead = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray in(GZIP_STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    QByteArray out(GZIP_STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    int flushOrFinish = Z_NO_FLUSH;
+    while (flushOrFinish != Z_FINISH) {
+        qint64 chunkSize = source.read(in.data(), in.size());
+        if (chunkSize < 0) {
+            deflateEnd(&strm);
+            return false;
+        }
+        bytesRead += chunkSize;
+        flushOrFinish = source.atEnd() || chunkSize == 0 ? Z_FINISH : Z_NO_FLUSH;
+
+        strm.next_in = (unsigned char*)in.data();
+        strm.avail_in = (uInt)chunkSize;
+        do {
+            strm.next_out = (unsigned char*)out.data();
+            strm.avail_out = (uInt)out.size();
+            status = deflate(&strm, flushOrFinish);
+            if (status == Z_STREAM_ERROR ||
+                !writeAll(destination, out.constData(), out.size() - strm.avail_out)) {
+                deflateEnd(&strm);
+                return false;
+            }
+        } while (strm.avail_out == 0);
+
+        if (progress) {
+            progress(bytesRead, bytesTotal);
+        }
+        throttle(timer, bytesRead, maxBytesPerSecond);
+    }
+
+    deflateEnd(&strm);
+    return status == Z_STREAM_END;
+}
+
+bool gunzip(QIODevice& source, QIODevice& destination, qint64 maxBytesPerSecond, const GzipProgress& progress) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+
+    int status = inflateInit2(&strm, GZIP_WINDOWS_BIT);
+    if (status != Z_OK) {
+        return false;
+    }
+
+    qint64 bytesTotal = source.isSequential() ? -1 : source.size();
+    qint64 bytesRead = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray in(GZIP_STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    QByteArray out(GZIP_STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    while (status != Z_STREAM_END) {
+        qint64 chunkSize = source.read(in.data(), in.size());
+        if (chunkSize <= 0) {
+            break; // the source ended before the gzip stream did
+        }
+        bytesRead += chunkSize;
+
+        strm.next_in = (unsigned char*)in.data();
+        strm.avail_in = (uInt)chunkSize;
+        do {
+            strm.next_out = (unsigned char*)out.data();
+            strm.avail_out = (uInt)out.size();
+            status = inflate(&strm, Z_NO_FLUSH);
+            if ((status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) ||
+                !writeAll(destination, out.constData(), out.size() - strm.avail_out)) {
+                inflateEnd(&strm);
+                return false;
+            }
+        } while (strm.avail_out == 0 && status != Z_STREAM_END);
+
+        if (progress) {
+            progress(bytesRead, bytesTotal);
+        }
+        throttle(timer, bytesRead, maxBytesPerSecond);
+    }
+
+    inflateEnd(&strm);
+    return status == Z_STREAM_END;
+}
+
+bool zlibInflate(const char* source, int sourceLength, char* destination, int destinationLength) {
+    uLongf length = destinationLength;
+    int status = uncompress((Bytef*)destination, &length, (const Bytef*)source, sourceLength);
+    return status == Z_OK && length == (uLongf)destinationLength;
+}
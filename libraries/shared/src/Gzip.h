@@ -12,8 +12,12 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <functional>
+
 #include <QByteArray>
 
+class QIODevice;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +28,21 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Inflates zlib data, as qCompress writes it without its length prefix, straight into a destination of exactly the
+// uncompressed length. Answers false if the data is corrupt or of another length.
+bool zlibInflate(const char* source, int sourceLength, char* destination, int destinationLength);
+
+// Called as a stream is read, with the bytes read so far and the size of the source, -1 when it is not known.
+using GzipProgress = std::function<void(qint64 bytesRead, qint64 bytesTotal)>;
+
+// The streaming versions read the source and write the destination a chunk at a time, so that neither is held in
+// memory. A positive maxBytesPerSecond limits how fast the source is read, to leave the disk and the CPU to a live
+// server.
+
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel = -1, qint64 maxBytesPerSecond = 0,
+          const GzipProgress& progress = GzipProgress());
+
+bool gunzip(QIODevice& source, QIODevice& destination, qint64 maxBytesPerSecond = 0,
+            const GzipProgress& progress = GzipProgress());
+
 #endif
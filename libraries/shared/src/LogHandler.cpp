@@ -12,18 +12,25 @@
 
 #include "LogHandler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <mutex>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
 #include <QtCore/QMutexLocker>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QRegExp>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 QMutex LogHandler::_mutex;
 
+// the writer also wakes this often to report the dropped messages
+static const int LOG_WRITER_WAIT_MSECS = 100;
+
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
     return staticInstance;
@@ -36,6 +43,9 @@ LogHandler::LogHandler() {
 }
 
 LogHandler::~LogHandler() {
+    if (_isAsynchronous) {
+        stopWriter();
+    }
     flushRepeatedMessages();
     printMessage(LogMsgType::LogDebug, QMessageLogContext(), "LogHandler shutdown.");
 }
@@ -97,7 +107,7 @@ void LogHandler::flushRepeatedMessages() {
 
             QMessageLogContext emptyContext;
             lock.unlock();
-            printMessage(LogSuppressed, emptyContext, repeatMessage);
+            logMessage(LogSuppressed, emptyContext, repeatMessage);
             lock.relock();
         }
 
@@ -107,6 +117,165 @@ void LogHandler::flushRepeatedMessages() {
 }
 
 QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (isMuted(type, context.category)) {
+        return QString();
+    }
+
+    LogRecord record;
+    record.type = type;
+    record.category = context.category;
+    record.message = message;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.threadID = (size_t)QThread::currentThreadId();
+    return printRecord(record);
+}
+
+void LogHandler::logMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (!_isAsynchronous || type == LogFatal) {
+        if (type == LogFatal) {
+            // the process aborts after a fatal message, the queued ones come first
+            flush();
+        }
+        printMessage(type, context, message);
+        return;
+    }
+
+    if (isMuted(type, context.category)) {
+        return;
+    }
+
+    LogRecord record;
+    record.type = type;
+    record.category = context.category;
+    record.message = message;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.threadID = (size_t)QThread::currentThreadId();
+    if (!_queue->push(std::move(record))) {
+        _droppedMessageCount++;
+        _unreportedDropCount++;
+        return;
+    }
+
+    _queuedMessageCount++;
+    if (_isWriterWaiting) {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _writerCondition.notify_one();
+    }
+}
+
+bool LogHandler::isMuted(LogMsgType type, const char* category) const {
+    if ((type != LogDebug && type != LogInfo) || !category) {
+        return false;
+    }
+    auto mutedCategories = std::atomic_load(&_mutedCategories);
+    return mutedCategories && mutedCategories->contains(QByteArray::fromRawData(category, (int)strlen(category)));
+}
+
+void LogHandler::setCategoryMuted(const QString& category, bool isMuted) {
+    QMutexLocker lock(&_mutex);
+    auto mutedCategories = std::atomic_load(&_mutedCategories);
+    QSet<QByteArray> categories = mutedCategories ? *mutedCategories : QSet<QByteArray>();
+    if (isMuted) {
+        categories.insert(category.toUtf8());
+    } else {
+        categories.remove(category.toUtf8());
+    }
+    std::atomic_store(&_mutedCategories, categories.isEmpty() ? std::shared_ptr<const QSet<QByteArray>>() :
+        std::make_shared<const QSet<QByteArray>>(categories));
+}
+
+void LogHandler::setAsynchronous(bool isAsynchronous, int maxQueuedMessages) {
+    if (isAsynchronous == _isAsynchronous) {
+        return;
+    }
+
+    if (isAsynchronous) {
+        if (!_queue) {
+            _queue.reset(new BoundedQueue<LogRecord>(std::max(maxQueuedMessages, 1)));
+        }
+        _isWriterQuitting = false;
+        _writerThread = std::thread([this] {
+            runWriter();
+        });
+        _isAsynchronous = true;
+    } else {
+        stopWriter();
+    }
+}
+
+void LogHandler::flush() {
+    while (_isAsynchronous && _printedMessageCount < _queuedMessageCount) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void LogHandler::setupFromEnvironment() {
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(MUTED_LOG_CATEGORIES_ENV)) {
+        for (auto& category : environment.value(MUTED_LOG_CATEGORIES_ENV).split(',', QString::SkipEmptyParts)) {
+            setCategoryMuted(category.trimmed(), true);
+        }
+    }
+    if (environment.contains(ASYNC_LOGGING_ENV)) {
+        bool ok;
+        int maxQueuedMessages = environment.value(ASYNC_LOGGING_ENV).toInt(&ok);
+        setAsynchronous(true, ok && maxQueuedMessages > 0 ? maxQueuedMessages : DEFAULT_MAX_QUEUED_LOG_MESSAGES);
+    }
+}
+
+void LogHandler::runWriter() {
+    LogRecord record;
+    while (true) {
+        while (_queue->pop(record)) {
+            printRecord(record);
+            _printedMessageCount++;
+        }
+
+        quint64 dropCount = _unreportedDropCount.exchange(0);
+        if (dropCount > 0) {
+            LogRecord report;
+            report.type = LogWarning;
+            report.message = QString("%1 log messages dropped, the log queue was full").arg(dropCount);
+            report.timestamp = QDateTime::currentMSecsSinceEpoch();
+            report.threadID = (size_t)QThread::currentThreadId();
+            printRecord(report);
+        }
+
+        if (_isWriterQuitting) {
+            break;
+        }
+
+        // a message queued after the wait starts notifies the writer, as it sees the writer waiting
+        std::unique_lock<std::mutex> lock(_writerMutex);
+        _isWriterWaiting = true;
+        _writerCondition.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_WAIT_MSECS), [this] {
+            return _isWriterQuitting || _queuedMessageCount > _printedMessageCount;
+        });
+        _isWriterWaiting = false;
+    }
+}
+
+void LogHandler::stopWriter() {
+    _isAsynchronous = false;
+    {
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        _isWriterQuitting = true;
+        _writerCondition.notify_one();
+    }
+    _writerThread.join();
+
+    // the messages queued as the writer quit
+    LogRecord record;
+    while (_queue->pop(record)) {
+        printRecord(record);
+        _printedMessageCount++;
+    }
+}
+
+QString LogHandler::printRecord(const LogRecord& record) {
+    LogMsgType type = record.type;
+    const QString& message = record.message;
+
     QMutexLocker lock(&_mutex);
     if (message.isEmpty()) {
         return QString();
@@ -161,16 +330,15 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr),
-        stringForLogType(type), context.category);
+    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::fromMSecsSinceEpoch(record.timestamp).toString(*dateFormatPtr),
+        stringForLogType(type), record.category);
 
     if (_shouldOutputProcessID) {
         prefixString.append(QString(" [%1]").arg(QCoreApplication::applicationPid()));
     }
 
     if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
-        prefixString.append(QString(" [%1]").arg(threadID));
+        prefixString.append(QString(" [%1]").arg(record.threadID));
     }
 
     if (!_targetName.isEmpty()) {
@@ -183,7 +351,7 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
 }
 
 void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    getInstance().printMessage((LogMsgType) type, context, message);
+    getInstance().logMessage((LogMsgType) type, context, message);
 }
 
 void LogHandler::setupRepeatedMessageFlusher() {
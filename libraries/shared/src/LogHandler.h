@@ -13,14 +13,29 @@
 #ifndef hifi_LogHandler_h
 #define hifi_LogHandler_h
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <QHash>
 #include <QObject>
 #include <QSet>
 #include <QString>
 #include <QMutex>
 
+#include "shared/BoundedQueue.h"
+
 const int VERBOSE_LOG_INTERVAL_SECONDS = 5;
 
+// set to output the log from a writer thread, to the maximum number of queued messages or to anything else for the default
+const QString ASYNC_LOGGING_ENV = "HIFI_ASYNC_LOGGING";
+const int DEFAULT_MAX_QUEUED_LOG_MESSAGES = 4096;
+
+// a comma-separated list of the categories whose debug and info messages are dropped
+const QString MUTED_LOG_CATEGORIES_ENV = "HIFI_MUTED_LOG_CATEGORIES";
+
 enum LogMsgType {
     LogInfo = QtInfoMsg,
     LogDebug = QtDebugMsg,
@@ -46,10 +61,28 @@ public:
 
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
 
+    /// prints the message, or queues it for the writer thread when asynchronous, without returning the output
+    void logMessage(LogMsgType type, const QMessageLogContext& context, const QString& message);
+
     /// a qtMessageHandler that can be hooked up to a target that links to Qt
     /// prints various process, message type, and time information
     static void verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString &message);
 
+    /// when asynchronous the messages of logMessage are formatted and printed by a writer thread, and those logged
+    /// while maxQueuedMessages are already waiting are dropped and counted
+    void setAsynchronous(bool isAsynchronous, int maxQueuedMessages = DEFAULT_MAX_QUEUED_LOG_MESSAGES);
+    bool isAsynchronous() const { return _isAsynchronous; }
+
+    /// waits for the writer thread to print the queued messages
+    void flush();
+    quint64 getDroppedMessageCount() const { return _droppedMessageCount; }
+
+    /// the debug and info messages of a muted category are dropped before any formatting or matching
+    void setCategoryMuted(const QString& category, bool isMuted);
+
+    /// applies ASYNC_LOGGING_ENV and MUTED_LOG_CATEGORIES_ENV
+    void setupFromEnvironment();
+
     const QString& addRepeatedMessageRegex(const QString& regexString);
     const QString& addOnlyOnceMessageRegex(const QString& regexString);
 
@@ -57,11 +90,25 @@ private slots:
     void setupRepeatedMessageFlusher();
 
 private:
+    // what the writer thread needs of a message, the category names are those of the static logging categories
+    struct LogRecord {
+        LogMsgType type { LogDebug };
+        const char* category { nullptr };
+        QString message;
+        qint64 timestamp { 0 }; // msecs since epoch
+        size_t threadID { 0 };
+    };
+
     LogHandler();
     ~LogHandler();
 
     void flushRepeatedMessages();
 
+    bool isMuted(LogMsgType type, const char* category) const;
+    QString printRecord(const LogRecord& record);
+    void runWriter();
+    void stopWriter();
+
     QString _targetName;
     bool _shouldOutputProcessID { false };
     bool _shouldOutputThreadID { false };
@@ -73,6 +120,20 @@ private:
     QSet<QString> _onlyOnceMessageRegexes;
     QHash<QString, int> _onlyOnceMessageCountHash;
 
+    std::shared_ptr<const QSet<QByteArray>> _mutedCategories; // replaced as a whole, read with std::atomic_load
+
+    std::atomic<bool> _isAsynchronous { false };
+    std::unique_ptr<BoundedQueue<LogRecord>> _queue; // kept once created, messages may still be pushed as it stops
+    std::thread _writerThread;
+    std::mutex _writerMutex;
+    std::condition_variable _writerCondition;
+    std::atomic<bool> _isWriterWaiting { false };
+    std::atomic<bool> _isWriterQuitting { false };
+    std::atomic<quint64> _queuedMessageCount { 0 };
+    std::atomic<quint64> _printedMessageCount { 0 };
+    std::atomic<quint64> _droppedMessageCount { 0 };
+    std::atomic<quint64> _unreportedDropCount { 0 };
+
     static QMutex _mutex;
 };
 
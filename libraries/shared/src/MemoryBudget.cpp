@@ -0,0 +1,219 @@
+//
+//  MemoryBudget.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryBudget.h"
+
+#include <algorithm>
+
+#include <QtCore/QTimer>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+#include "NumericalConstants.h"
+#include "SharedLogging.h"
+
+const int MemoryBudget::DEFAULT_CHECK_INTERVAL_MSECS = 1000;
+
+// the clients of the CPU pool together use at most this part of the physical memory, unless told another budget
+static const float DEFAULT_CPU_BUDGET_FRACTION = 0.25f;
+
+// the memory the system keeps available, below which the clients are asked for the difference
+static const float MIN_AVAILABLE_MEMORY_FRACTION = 0.1f;
+static const qint64 MIN_AVAILABLE_MEMORY = MB_TO_BYTES(512);
+static const qint64 MIN_FREE_GPU_MEMORY = MB_TO_BYTES(256);
+
+// what is asked for when the system signals it is low on memory without telling how low
+static const qint64 LOW_MEMORY_RELEASE_SIZE = MB_TO_BYTES(256);
+
+// asking for a little more than the shortfall keeps the clients from being asked again at every check
+static const qint64 RELEASE_MARGIN = MB_TO_BYTES(64);
+
+// the pressure is over after this many checks with this much more memory than the minimum
+static const int RELAX_CHECKS = 10;
+static const float RELAX_HEADROOM = 1.5f;
+
+MemoryBudget::MemoryBudget() {
+#ifdef Q_OS_WIN
+    _lowMemoryNotification = CreateMemoryResourceNotification(LowMemoryResourceNotification);
+#endif
+}
+
+MemoryBudget::~MemoryBudget() {
+#ifdef Q_OS_WIN
+    if (_lowMemoryNotification) {
+        CloseHandle(_lowMemoryNotification);
+    }
+#endif
+}
+
+void MemoryBudget::registerClient(MemoryBudgetClient* client) {
+    std::lock_guard<std::recursive_mutex> lock(_clientsMutex);
+    _clients.push_back({ client, false });
+}
+
+void MemoryBudget::unregisterClient(MemoryBudgetClient* client) {
+    std::lock_guard<std::recursive_mutex> lock(_clientsMutex);
+    _clients.erase(std::remove_if(_clients.begin(), _clients.end(), [&](const ClientEntry& entry) {
+        return entry.client == client;
+    }), _clients.end());
+}
+
+void MemoryBudget::start(int intervalMsecs) {
+    if (!_timer) {
+        _timer = new QTimer(this);
+        connect(_timer, &QTimer::timeout, this, &MemoryBudget::update);
+    }
+    _timer->start(intervalMsecs);
+}
+
+void MemoryBudget::stop() {
+    if (_timer) {
+        _timer->stop();
+    }
+}
+
+void MemoryBudget::update() {
+    MemoryInfo systemMemory;
+    bool hasSystemMemory = getMemoryInfo(systemMemory);
+
+    bool isSystemLowOnMemory = false;
+#ifdef Q_OS_WIN
+    BOOL isLow = FALSE;
+    if (_lowMemoryNotification && QueryMemoryResourceNotification(_lowMemoryNotification, &isLow)) {
+        isSystemLowOnMemory = isLow == TRUE;
+    }
+#endif
+
+    qint64 freeGPUMemory = _freeGPUMemoryQuery ? _freeGPUMemoryQuery() : 0;
+
+    check(systemMemory, hasSystemMemory, isSystemLowOnMemory, freeGPUMemory);
+}
+
+qint64 MemoryBudget::check(const MemoryInfo& systemMemory, bool hasSystemMemory, bool isSystemLowOnMemory,
+                           qint64 freeGPUMemory) {
+    std::lock_guard<std::recursive_mutex> lock(_clientsMutex);
+    qint64 released = 0;
+
+    qint64 cpuUsage = 0;
+    for (auto& entry : _clients) {
+        if (entry.client->getMemoryBudgetPool() == MemoryBudgetClient::CPU) {
+            cpuUsage += entry.client->getMemoryUsage();
+        }
+    }
+
+    qint64 cpuBudget = _cpuBudget;
+    if (cpuBudget <= 0 && hasSystemMemory) {
+        cpuBudget = (qint64)(systemMemory.totalMemoryBytes * DEFAULT_CPU_BUDGET_FRACTION);
+    }
+
+    qint64 cpuShortfall = 0;
+    bool isCPUComfortable = true;
+    if (cpuBudget > 0) {
+        cpuShortfall = std::max(cpuUsage - cpuBudget, (qint64)0);
+    }
+    if (hasSystemMemory) {
+        qint64 minAvailable = std::max((qint64)(systemMemory.totalMemoryBytes * MIN_AVAILABLE_MEMORY_FRACTION),
+                                       MIN_AVAILABLE_MEMORY);
+        qint64 available = (qint64)systemMemory.availMemoryBytes;
+        cpuShortfall = std::max(cpuShortfall, minAvailable - available);
+        isCPUComfortable = available > minAvailable * RELAX_HEADROOM;
+    }
+    if (isSystemLowOnMemory) {
+        cpuShortfall = std::max(cpuShortfall, LOW_MEMORY_RELEASE_SIZE);
+        isCPUComfortable = false;
+    }
+
+    if (cpuShortfall > 0) {
+        _isUnderCPUPressure = true;
+        _cpuRelaxedChecks = 0;
+        released += releaseFromPool(MemoryBudgetClient::CPU, cpuShortfall + RELEASE_MARGIN);
+    } else if (_isUnderCPUPressure) {
+        _cpuRelaxedChecks = isCPUComfortable ? _cpuRelaxedChecks + 1 : 0;
+        if (_cpuRelaxedChecks >= RELAX_CHECKS) {
+            _isUnderCPUPressure = false;
+            relaxPool(MemoryBudgetClient::CPU);
+        }
+    }
+
+    // a free memory of 0 is a GPU that does not tell
+    if (freeGPUMemory > 0) {
+        if (freeGPUMemory < MIN_FREE_GPU_MEMORY) {
+            _isUnderGPUPressure = true;
+            _gpuRelaxedChecks = 0;
+            released += releaseFromPool(MemoryBudgetClient::GPU, MIN_FREE_GPU_MEMORY - freeGPUMemory + RELEASE_MARGIN);
+        } else if (_isUnderGPUPressure) {
+            _gpuRelaxedChecks = freeGPUMemory > MIN_FREE_GPU_MEMORY * RELAX_HEADROOM ? _gpuRelaxedChecks + 1 : 0;
+            if (_gpuRelaxedChecks >= RELAX_CHECKS) {
+                _isUnderGPUPressure = false;
+                relaxPool(MemoryBudgetClient::GPU);
+            }
+        }
+    }
+
+    if (released > 0) {
+        qCDebug(shared) << "Memory budget released" << BYTES_TO_MB(released) << "MB";
+        emit memoryReleased(released);
+    }
+    return released;
+}
+
+qint64 MemoryBudget::releaseFromPool(MemoryBudgetClient::Pool pool, qint64 size) {
+    std::vector<ClientEntry*> entries;
+    for (auto& entry : _clients) {
+        if (entry.client->getMemoryBudgetPool() == pool && entry.client->getReleasableMemory() > 0) {
+            entries.push_back(&entry);
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const ClientEntry* a, const ClientEntry* b) {
+        return a->client->getRebuildCost() < b->client->getRebuildCost();
+    });
+
+    qint64 released = 0;
+    for (auto entry : entries) {
+        if (released >= size) {
+            break;
+        }
+        qint64 clientReleased = entry->client->releaseMemory(std::min(size - released,
+                                                                      entry->client->getReleasableMemory()));
+        if (clientReleased > 0) {
+            entry->isReleased = true;
+            released += clientReleased;
+        }
+    }
+    return released;
+}
+
+void MemoryBudget::relaxPool(MemoryBudgetClient::Pool pool) {
+    for (auto& entry : _clients) {
+        if (entry.client->getMemoryBudgetPool() == pool && entry.isReleased) {
+            entry.isReleased = false;
+            entry.client->relaxMemory();
+        }
+    }
+}
+
+QString MemoryBudget::getStatsText() const {
+    std::lock_guard<std::recursive_mutex> lock(_clientsMutex);
+    QString text;
+    for (auto& entry : _clients) {
+        if (!text.isEmpty()) {
+            text += "\n";
+        }
+        text += QString("  %1%2: %3 MB (%4 MB releasable)")
+            .arg(entry.client->getMemoryBudgetName())
+            .arg(entry.isReleased ? "*" : "")
+            .arg(BYTES_TO_MB(entry.client->getMemoryUsage()))
+            .arg(BYTES_TO_MB(entry.client->getReleasableMemory()));
+    }
+    return text;
+}
@@ -0,0 +1,119 @@
+//
+//  MemoryBudget.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_MemoryBudget_h
+#define hifi_MemoryBudget_h
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "DependencyManager.h"
+#include "SharedUtil.h"
+
+class QTimer;
+
+/// A cache whose memory the MemoryBudget may ask back. The client keeps its own limits while there is no pressure.
+class MemoryBudgetClient {
+public:
+    enum Pool { CPU, GPU };
+
+    virtual ~MemoryBudgetClient() {}
+
+    virtual QString getMemoryBudgetName() const = 0;
+    virtual Pool getMemoryBudgetPool() const { return CPU; }
+
+    /// the bytes in use, and the part of them that could be given back
+    virtual qint64 getMemoryUsage() const = 0;
+    virtual qint64 getReleasableMemory() const = 0;
+
+    /// the relative cost of rebuilding a byte given back, the memory cheapest to rebuild is asked for first
+    virtual float getRebuildCost() const { return 1.0f; }
+
+    /// gives back up to size bytes, by evicting or downscaling, and returns the bytes given back
+    virtual qint64 releaseMemory(qint64 size) = 0;
+
+    /// the pressure is over, limits lowered by releaseMemory may be restored
+    virtual void relaxMemory() {}
+};
+
+/// Watches the memory of the system and of the GPU, and the budget of the process, and asks the registered clients to
+/// give back memory when any of them runs short.
+class MemoryBudget : public QObject, public Dependency {
+    Q_OBJECT
+    SINGLETON_DEPENDENCY
+
+public:
+    static const int DEFAULT_CHECK_INTERVAL_MSECS;
+
+    MemoryBudget();
+    ~MemoryBudget();
+
+    void registerClient(MemoryBudgetClient* client);
+    void unregisterClient(MemoryBudgetClient* client);
+
+    /// checks the budget periodically, on the thread of the MemoryBudget
+    void start(int intervalMsecs = DEFAULT_CHECK_INTERVAL_MSECS);
+    void stop();
+
+    /// the bytes the clients of the CPU pool may use together, 0 for a part of the physical memory
+    void setCPUBudget(qint64 size) { _cpuBudget = size; }
+    qint64 getCPUBudget() const { return _cpuBudget; }
+
+    /// returns the free memory of the GPU in bytes, or 0 when it is not known
+    void setFreeGPUMemoryQuery(std::function<qint64()> query) { _freeGPUMemoryQuery = query; }
+
+    bool isUnderCPUPressure() const { return _isUnderCPUPressure; }
+    bool isUnderGPUPressure() const { return _isUnderGPUPressure; }
+
+    /// a line for each client with its usage in MB, the clients that gave back memory marked with a star
+    QString getStatsText() const;
+
+    /// gathers the memory of the system and of the GPU, and checks the budget against them
+    void update();
+
+    /// checks the budget against these memories, returns the bytes the clients gave back
+    qint64 check(const MemoryInfo& systemMemory, bool hasSystemMemory, bool isSystemLowOnMemory, qint64 freeGPUMemory);
+
+signals:
+    void memoryReleased(qint64 size);
+
+private:
+    struct ClientEntry {
+        MemoryBudgetClient* client;
+        bool isReleased;
+    };
+
+    qint64 releaseFromPool(MemoryBudgetClient::Pool pool, qint64 size);
+    void relaxPool(MemoryBudgetClient::Pool pool);
+
+    mutable std::recursive_mutex _clientsMutex;
+    std::vector<ClientEntry> _clients;
+
+    QTimer* _timer { nullptr };
+    qint64 _cpuBudget { 0 };
+    std::function<qint64()> _freeGPUMemoryQuery;
+
+    bool _isUnderCPUPressure { false };
+    bool _isUnderGPUPressure { false };
+    int _cpuRelaxedChecks { 0 };
+    int _gpuRelaxedChecks { 0 };
+
+#ifdef Q_OS_WIN
+    void* _lowMemoryNotification { nullptr };
+#endif
+};
+
+#endif // hifi_MemoryBudget_h
@@ -0,0 +1,267 @@
+//
+//  Metrics.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+#include "StatTracker.h"
+
+void MetricGauge::add(double delta) {
+    uint64_t bits = _bits.load(std::memory_order_relaxed);
+    while (!_bits.compare_exchange_weak(bits, toBits(fromBits(bits) + delta), std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t MetricGauge::toBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double MetricGauge::fromBits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+MetricHistogram::MetricHistogram(const std::vector<double>& bounds) :
+    _bounds(bounds),
+    _buckets(new std::atomic<uint64_t>[bounds.size() + 1])
+{
+    for (size_t i = 0; i <= _bounds.size(); i++) {
+        _buckets[i] = 0;
+    }
+}
+
+std::vector<double> MetricHistogram::exponentialBounds(double start, double factor, int count) {
+    std::vector<double> bounds;
+    double bound = start;
+    for (int i = 0; i < count; i++) {
+        bounds.push_back(bound);
+        bound *= factor;
+    }
+    return bounds;
+}
+
+void MetricHistogram::observe(double value) {
+    // a value on a bound belongs to the bucket of that bound
+    size_t bucket = std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin();
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.add(value);
+}
+
+MetricsRegistry::Family* MetricsRegistry::getFamily(const QString& name, const QString& help, Type type) {
+    auto it = _families.find(name);
+    if (it == _families.end()) {
+        it = _families.emplace(name, Family()).first;
+        it->second.type = type;
+        it->second.help = help;
+    } else if (it->second.type != type) {
+        qWarning() << "Metric" << name << "is already registered with another type";
+        return nullptr;
+    }
+    return &it->second;
+}
+
+MetricCounter& MetricsRegistry::counter(const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Family* family = getFamily(name, help, Type::Counter);
+    if (!family) {
+        return _unusedCounter;
+    }
+    auto& counter = family->counters[labels];
+    if (!counter) {
+        counter.reset(new MetricCounter());
+    }
+    return *counter;
+}
+
+MetricGauge& MetricsRegistry::gauge(const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Family* family = getFamily(name, help, Type::Gauge);
+    if (!family) {
+        return _unusedGauge;
+    }
+    auto& gauge = family->gauges[labels];
+    if (!gauge) {
+        gauge.reset(new MetricGauge());
+    }
+    return *gauge;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const QString& name, const QString& help, const std::vector<double>& bounds,
+                                            const QString& labels) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Family* family = getFamily(name, help, Type::Histogram);
+    if (!family) {
+        return _unusedHistogram;
+    }
+    auto& histogram = family->histograms[labels];
+    if (!histogram) {
+        histogram.reset(new MetricHistogram(bounds));
+    }
+    return *histogram;
+}
+
+void MetricsRegistry::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _families.clear();
+}
+
+QString MetricsRegistry::toMetricName(const QString& name) {
+    QString metricName = name;
+    for (int i = 0; i < metricName.size(); i++) {
+        QChar c = metricName[i];
+        if (!(c.isLetterOrNumber() && c.unicode() < 128) && c != '_') {
+            metricName[i] = '_';
+        }
+    }
+    if (metricName.isEmpty() || metricName[0].isDigit()) {
+        metricName.prepend('_');
+    }
+    return metricName;
+}
+
+static QByteArray sampleName(const QString& name, const QString& suffix, const QString& labels,
+                             const QString& extraLabel = QString()) {
+    QString allLabels = labels;
+    if (!extraLabel.isEmpty()) {
+        allLabels += (allLabels.isEmpty() ? "" : ",") + extraLabel;
+    }
+    QString sample = name + suffix;
+    if (!allLabels.isEmpty()) {
+        sample += "{" + allLabels + "}";
+    }
+    return sample.toUtf8();
+}
+
+static QByteArray formatValue(double value) {
+    return QByteArray::number(value, 'g', 17);
+}
+
+QByteArray MetricsRegistry::toPrometheusText() const {
+    QByteArray text;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& entry : _families) {
+            const QString& name = entry.first;
+            const Family& family = entry.second;
+
+            static const char* TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+            text += "# HELP " + name.toUtf8() + " " + family.help.toUtf8() + "\n";
+            text += "# TYPE " + name.toUtf8() + " " + TYPE_NAMES[(int)family.type] + "\n";
+
+            for (auto& counter : family.counters) {
+                text += sampleName(name, "", counter.first) + " " + QByteArray::number((qulonglong)counter.second->get()) + "\n";
+            }
+            for (auto& gauge : family.gauges) {
+                text += sampleName(name, "", gauge.first) + " " + formatValue(gauge.second->get()) + "\n";
+            }
+            for (auto& histogram : family.histograms) {
+                const MetricHistogram& metric = *histogram.second;
+                uint64_t cumulativeCount = 0;
+                for (size_t i = 0; i <= metric.getBounds().size(); i++) {
+                    cumulativeCount += metric.getBucketCount(i);
+                    QString bound = i < metric.getBounds().size() ? QString(formatValue(metric.getBounds()[i])) : "+Inf";
+                    text += sampleName(name, "_bucket", histogram.first, "le=\"" + bound + "\"") + " " +
+                        QByteArray::number((qulonglong)cumulativeCount) + "\n";
+                }
+                text += sampleName(name, "_sum", histogram.first) + " " + formatValue(metric.getSum()) + "\n";
+                text += sampleName(name, "_count", histogram.first) + " " +
+                    QByteArray::number((qulonglong)metric.getCount()) + "\n";
+            }
+        }
+    }
+
+    // the stats of the StatTracker are gauges
+    if (DependencyManager::isSet<StatTracker>()) {
+        auto stats = DependencyManager::get<StatTracker>()->getStats();
+        QStringList names = stats.keys();
+        names.sort();
+        for (auto& statName : names) {
+            QByteArray name = ("hifi_stat_" + toMetricName(statName)).toUtf8();
+            text += "# TYPE " + name + " gauge\n";
+            text += name + " " + QByteArray::number(stats[statName]) + "\n";
+        }
+    }
+
+    return text;
+}
+
+QByteArray MetricsRegistry::mergePrometheusText(const QVector<QPair<QByteArray, QString>>& textsAndLabels) {
+    // the samples of each family together, under the comments of the first text that has it
+    QVector<QByteArray> familyNames;
+    QHash<QByteArray, QByteArray> comments;
+    QHash<QByteArray, QByteArray> samples;
+
+    for (auto& textAndLabels : textsAndLabels) {
+        QByteArray labels = textAndLabels.second.toUtf8();
+        QByteArray familyName;
+        QSet<QByteArray> commentedFamilies;
+
+        for (auto& line : textAndLabels.first.split('\n')) {
+            if (line.isEmpty()) {
+                continue;
+            }
+            if (line.startsWith("# HELP ") || line.startsWith("# TYPE ")) {
+                familyName = line.mid(7, line.indexOf(' ', 7) - 7);
+                if (!comments.contains(familyName)) {
+                    familyNames.append(familyName);
+                    commentedFamilies.insert(familyName);
+                }
+                if (commentedFamilies.contains(familyName)) {
+                    comments[familyName] += line + "\n";
+                }
+                continue;
+            }
+            if (line.startsWith('#')) {
+                continue;
+            }
+
+            // add the labels of the text, before the value or in the existing labels
+            QByteArray sample = line;
+            if (!labels.isEmpty()) {
+                int labelsEnd = sample.indexOf('}');
+                if (labelsEnd >= 0) {
+                    sample.insert(labelsEnd, "," + labels);
+                } else {
+                    int nameEnd = sample.indexOf(' ');
+                    sample.insert(nameEnd >= 0 ? nameEnd : sample.size(), "{" + labels + "}");
+                }
+            }
+            if (familyName.isEmpty()) {
+                // a sample before any comment is a family of its own
+                int nameEnd = line.indexOf('{') >= 0 ? line.indexOf('{') : line.indexOf(' ');
+                familyName = line.left(nameEnd);
+                if (!comments.contains(familyName)) {
+                    familyNames.append(familyName);
+                    comments[familyName] = QByteArray();
+                }
+            }
+            samples[familyName] += sample + "\n";
+        }
+    }
+
+    QByteArray text;
+    for (auto& familyName : familyNames) {
+        text += comments[familyName] + samples[familyName];
+    }
+    return text;
+}
@@ -0,0 +1,117 @@
+//
+//  Metrics.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Metrics_h
+#define hifi_Metrics_h
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "DependencyManager.h"
+
+// The metrics are registered once and then updated with relaxed atomics, from any thread and without locks.
+
+class MetricCounter {
+public:
+    void increment(uint64_t count = 1) { _value.fetch_add(count, std::memory_order_relaxed); }
+    uint64_t get() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> _value { 0 };
+};
+
+class MetricGauge {
+public:
+    void set(double value) { _bits.store(toBits(value), std::memory_order_relaxed); }
+    void add(double delta);
+    double get() const { return fromBits(_bits.load(std::memory_order_relaxed)); }
+
+private:
+    static uint64_t toBits(double value);
+    static double fromBits(uint64_t bits);
+
+    std::atomic<uint64_t> _bits { 0 }; // the bits of 0.0
+};
+
+class MetricHistogram {
+public:
+    // the upper bounds of the buckets, in increasing order, the last bucket has no bound
+    MetricHistogram(const std::vector<double>& bounds);
+
+    // count bounds from start, each factor times the previous one
+    static std::vector<double> exponentialBounds(double start, double factor, int count);
+
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const { return _bounds; }
+    uint64_t getBucketCount(size_t bucket) const { return _buckets[bucket].load(std::memory_order_relaxed); }
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+    double getSum() const { return _sum.get(); }
+
+private:
+    std::vector<double> _bounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> _buckets; // one more than the bounds
+    std::atomic<uint64_t> _count { 0 };
+    MetricGauge _sum;
+};
+
+// The metrics of a process, exported in the Prometheus text format along with the stats of the StatTracker. A metric
+// is named by its name and its labels, in the Prometheus form of `type="audio",codec="opus"`.
+class MetricsRegistry : public Dependency {
+public:
+    MetricCounter& counter(const QString& name, const QString& help, const QString& labels = QString());
+    MetricGauge& gauge(const QString& name, const QString& help, const QString& labels = QString());
+    MetricHistogram& histogram(const QString& name, const QString& help, const std::vector<double>& bounds,
+                               const QString& labels = QString());
+
+    // removes all metrics, no reference to them may be used after
+    void clear();
+
+    QByteArray toPrometheusText() const;
+
+    // the texts of several processes in one, with the labels of each process added to its samples
+    static QByteArray mergePrometheusText(const QVector<QPair<QByteArray, QString>>& textsAndLabels);
+
+    // a name made of letters, digits and underscores, as Prometheus expects
+    static QString toMetricName(const QString& name);
+
+private:
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Family {
+        Type type;
+        QString help;
+        std::map<QString, std::unique_ptr<MetricCounter>> counters;
+        std::map<QString, std::unique_ptr<MetricGauge>> gauges;
+        std::map<QString, std::unique_ptr<MetricHistogram>> histograms;
+    };
+
+    Family* getFamily(const QString& name, const QString& help, Type type);
+
+    mutable std::mutex _mutex;
+    std::map<QString, Family> _families;
+
+    // handed out when a name is registered again with another type
+    MetricCounter _unusedCounter;
+    MetricGauge _unusedGauge;
+    MetricHistogram _unusedHistogram { {} };
+};
+
+#endif // hifi_Metrics_h
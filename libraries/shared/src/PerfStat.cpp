@@ -19,6 +19,7 @@
 #include "PerfStat.h"
 
 #include "NumericalConstants.h"
+#include "SamplingProfiler.h"
 #include "SharedLogging.h"
 
 // ----------------------------------------------------------------------------
@@ -85,6 +86,10 @@ QMap<QString, PerformanceTimerRecord> PerformanceTimer::_records;
 
 
 PerformanceTimer::PerformanceTimer(const QString& name) {
+    if (SamplingProfiler::isActive()) {
+        SamplingProfiler::enterScope(name);
+        _isSampled = true;
+    }
     if (_isActive) {
         _name = name;
         QString& fullName = _fullNames[QThread::currentThread()];
@@ -95,6 +100,9 @@ PerformanceTimer::PerformanceTimer(const QString& name) {
 }
 
 PerformanceTimer::~PerformanceTimer() {
+    if (_isSampled) {
+        SamplingProfiler::leaveScope();
+    }
     if (_isActive && _start != 0) {
         quint64 elapsedUsec = (usecTimestampNow() - _start);
         QString& fullName = _fullNames[QThread::currentThread()];
@@ -92,6 +92,7 @@ public:
 private:
     quint64 _start = 0;
     QString _name;
+    bool _isSampled = false;
     static std::atomic<bool> _isActive;
     static QHash<QThread*, QString> _fullNames;
     static QMap<QString, PerformanceTimerRecord> _records;
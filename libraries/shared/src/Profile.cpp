@@ -8,6 +8,8 @@
 
 #include "Profile.h"
 
+#include "SamplingProfiler.h"
+
 Q_LOGGING_CATEGORY(trace_app, "trace.app")
 Q_LOGGING_CATEGORY(trace_app_detail, "trace.app.detail")
 Q_LOGGING_CATEGORY(trace_metadata, "trace.metadata")
@@ -34,14 +36,24 @@ Q_LOGGING_CATEGORY(trace_simulation_physics_detail, "trace.simulation.physics.de
 #endif
 
 static bool tracingEnabled() {
-    return DependencyManager::get<tracing::Tracer>()->isEnabled();
+    return DependencyManager::get<tracing::Tracer>()->isRecording();
 }
 
 Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _name(name), _category(category) {
+    if (SamplingProfiler::isActive()) {
+        SamplingProfiler::enterScope(_name);
+        _isSampled = true;
+    }
+
     if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        if (payload == 0 && baseArgs.empty()) {
+            // without args the range is recorded by the binary backend
+            tracing::traceEvent(_category, _name, tracing::DurationBegin);
+        } else {
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib { 0 };
@@ -60,6 +72,10 @@ Duration::Duration(const QLoggingCategory& category, const QString& name, uint32
 }
 
 Duration::~Duration() {
+    if (_isSampled) {
+        SamplingProfiler::leaveScope();
+    }
+
     if (tracingEnabled() && _category.isDebugEnabled()) {
         tracing::traceEvent(_category, _name, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
@@ -44,6 +44,7 @@ public:
 private:
     QString _name;
     const QLoggingCategory& _category;
+    bool _isSampled { false };
 };
 
 inline void asyncBegin(const QLoggingCategory& category, const QString& name, const QString& id, const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap()) {
@@ -20,7 +20,11 @@
 #define hifi_PropertyFlags_h
 
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include <QBitArray>
 #include <QByteArray>
@@ -28,9 +32,124 @@
 #include "ByteCountCoding.h"
 #include "SharedLogging.h"
 
+const int BITS_PER_BYTE = 8;
+
+/// Specialized for an enum whose number of flags is known at compile time, so that its PropertyFlags keep their bits in a
+/// FixedBitArray instead of a QBitArray, and making, merging and testing them doesn't allocate.
+template<typename Enum> struct PropertyFlagsTraits {
+    static const int NUM_FLAGS = 0; // not known
+};
+
+/// The part of the QBitArray interface PropertyFlags use, over a fixed number of 64 bit words. Like a QBitArray it has a
+/// size, the bits at and above it are always 0, and the bits beyond its capacity are ignored when set and read as 0.
+template<int NUM_BITS> class FixedBitArray {
+public:
+    static const int BITS_PER_WORD = 64;
+    static const int NUM_WORDS = (NUM_BITS + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    static const int CAPACITY = NUM_WORDS * BITS_PER_WORD;
+
+    FixedBitArray() { _words.fill(0); }
+
+    int size() const { return _size; }
+    void clear() { _words.fill(0); _size = 0; }
+    void resize(int size);
+
+    bool testBit(int i) const { return i < CAPACITY && (_words[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1; }
+    void setBit(int i, bool value);
+    bool at(int i) const { return testBit(i); }
+    bool operator[](int i) const { return testBit(i); }
+
+    bool operator==(const FixedBitArray& other) const { return _size == other._size && _words == other._words; }
+    bool operator!=(const FixedBitArray& other) const { return !(*this == other); }
+
+    // as with a QBitArray the result has the size of the larger of the two
+    FixedBitArray& operator|=(const FixedBitArray& other);
+    FixedBitArray& operator&=(const FixedBitArray& other);
+    FixedBitArray& operator^=(const FixedBitArray& other);
+    FixedBitArray operator~() const;
+
+private:
+    void clearFrom(int i); // the bits at and above i
+
+    std::array<uint64_t, NUM_WORDS> _words;
+    int _size { 0 };
+};
+
+template<int NUM_BITS> inline void FixedBitArray<NUM_BITS>::resize(int size) {
+    if (size > CAPACITY) {
+        size = CAPACITY;
+    }
+    if (size < _size) {
+        clearFrom(size);
+    }
+    _size = size;
+}
+
+template<int NUM_BITS> inline void FixedBitArray<NUM_BITS>::setBit(int i, bool value) {
+    if (i >= CAPACITY) {
+        return;
+    }
+    uint64_t mask = (uint64_t)1 << (i % BITS_PER_WORD);
+    if (value) {
+        _words[i / BITS_PER_WORD] |= mask;
+    } else {
+        _words[i / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+template<int NUM_BITS> inline FixedBitArray<NUM_BITS>& FixedBitArray<NUM_BITS>::operator|=(const FixedBitArray& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] |= other._words[i];
+    }
+    _size = std::max(_size, other._size);
+    return *this;
+}
+
+template<int NUM_BITS> inline FixedBitArray<NUM_BITS>& FixedBitArray<NUM_BITS>::operator&=(const FixedBitArray& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] &= other._words[i];
+    }
+    _size = std::max(_size, other._size);
+    return *this;
+}
+
+template<int NUM_BITS> inline FixedBitArray<NUM_BITS>& FixedBitArray<NUM_BITS>::operator^=(const FixedBitArray& other) {
+    for (int i = 0; i < NUM_WORDS; i++) {
+        _words[i] ^= other._words[i];
+    }
+    _size = std::max(_size, other._size);
+    return *this;
+}
+
+template<int NUM_BITS> inline FixedBitArray<NUM_BITS> FixedBitArray<NUM_BITS>::operator~() const {
+    FixedBitArray result(*this);
+    for (int i = 0; i < NUM_WORDS; i++) {
+        result._words[i] = ~_words[i];
+    }
+    result.clearFrom(_size);
+    return result;
+}
+
+template<int NUM_BITS> inline void FixedBitArray<NUM_BITS>::clearFrom(int i) {
+    int word = i / BITS_PER_WORD;
+    if (word >= NUM_WORDS) {
+        return;
+    }
+    _words[word] &= ((uint64_t)1 << (i % BITS_PER_WORD)) - 1;
+    for (word++; word < NUM_WORDS; word++) {
+        _words[word] = 0;
+    }
+}
+
 template<typename Enum>class PropertyFlags {
 public:
     typedef Enum enum_type;
+    static const int NUM_FLAGS = PropertyFlagsTraits<Enum>::NUM_FLAGS;
+    typedef typename std::conditional<(NUM_FLAGS > 0), FixedBitArray<NUM_FLAGS>, QBitArray>::type BitArray;
+
+    /// the most bytes an encoding of the flags takes, when the number of flags is known
+    static const int MAX_ENCODED_LENGTH = (FixedBitArray<NUM_FLAGS>::CAPACITY - 1) / (BITS_PER_BYTE - 1) + 1;
+
     inline PropertyFlags() : 
             _maxFlag(INT_MIN), _minFlag(INT_MAX), _trailingFlipped(false), _encodedLength(0) { };
 
@@ -53,6 +172,8 @@ public:
     void setHasProperty(Enum flag, bool value = true);
     bool getHasProperty(Enum flag) const;
     QByteArray encode();
+    /// encodes into data without allocating, returns the encoded length or 0 if it is longer than length
+    int encode(uint8_t* data, int length);
     size_t decode(const uint8_t* data, size_t length);
     size_t decode(const QByteArray& fromEncoded);
 
@@ -111,7 +232,7 @@ public:
 private:
     void shrinkIfNeeded();
 
-    QBitArray _flags;
+    BitArray _flags;
     int _maxFlag;
     int _minFlag;
     bool _trailingFlipped; /// are the trailing properties flipping in their state (e.g. assumed true, instead of false)
@@ -156,44 +277,44 @@ template<typename Enum> inline bool PropertyFlags<Enum>::getHasProperty(Enum fla
     return _flags.testBit(flag);
 }
 
-const int BITS_PER_BYTE = 8;
-
 template<typename Enum> inline QByteArray PropertyFlags<Enum>::encode() {
     QByteArray output;
-    
+    output.resize(_maxFlag < _minFlag ? 1 : (_maxFlag / (BITS_PER_BYTE - 1)) + 1);
+    encode(reinterpret_cast<uint8_t*>(output.data()), output.size());
+    return output;
+}
+
+template<typename Enum> inline int PropertyFlags<Enum>::encode(uint8_t* data, int length) {
     if (_maxFlag < _minFlag) {
-        output.fill(0, 1);
-        return output; // no flags... nothing to encode
+        if (length < 1) {
+            return 0;
+        }
+        data[0] = 0;
+        return 1; // no flags... nothing to encode
     }
 
     // we should size the array to the correct size.
     int lengthInBytes = (_maxFlag / (BITS_PER_BYTE - 1)) + 1;
-
-    output.fill(0, lengthInBytes);
+    if (length < lengthInBytes) {
+        return 0;
+    }
+    memset(data, 0, lengthInBytes);
 
     // next pack the number of header bits in, the first N-1 to be set to 1, the last to be set to 0
-    for(int i = 0; i < lengthInBytes; i++) {
-        int outputIndex = i;
-        int bitValue = (i < (lengthInBytes - 1)  ? 1 : 0);
-        char original = output.at(outputIndex / BITS_PER_BYTE);
-        int shiftBy = BITS_PER_BYTE - ((outputIndex % BITS_PER_BYTE) + 1);
-        char thisBit = ( bitValue << shiftBy);
-        output[i / BITS_PER_BYTE] = (original | thisBit);
+    for (int i = 0; i < lengthInBytes - 1; i++) {
+        data[i / BITS_PER_BYTE] |= 0x80 >> (i % BITS_PER_BYTE);
     }
 
     // finally pack the the actual bits from the bit array
-    for(int i = lengthInBytes; i < (lengthInBytes + _maxFlag + 1); i++) {
-        int flagIndex = i - lengthInBytes;
-        int outputIndex = i;
-        int bitValue = ( _flags[flagIndex]  ? 1 : 0);
-        char original = output.at(outputIndex / BITS_PER_BYTE);
-        int shiftBy = BITS_PER_BYTE - ((outputIndex % BITS_PER_BYTE) + 1);
-        char thisBit = ( bitValue << shiftBy);
-        output[i / BITS_PER_BYTE] = (original | thisBit);
+    for (int flag = 0; flag <= _maxFlag; flag++) {
+        if (_flags.testBit(flag)) {
+            int outputIndex = lengthInBytes + flag;
+            data[outputIndex / BITS_PER_BYTE] |= 0x80 >> (outputIndex % BITS_PER_BYTE);
+        }
     }
-    
+
     _encodedLength = lengthInBytes;
-    return output;
+    return lengthInBytes;
 }
 
 template<typename Enum> 
@@ -35,6 +35,11 @@ int collisionMetaTypeId = qRegisterMetaType<Collision>();
 int qMapURLStringMetaTypeId = qRegisterMetaType<QMap<QUrl,QString>>();
 int socketErrorMetaTypeId = qRegisterMetaType<QAbstractSocket::SocketError>();
 
+// the same as value.toVariant().toFloat(), without the QVariant for the usual number
+static inline float scriptValueToFloat(const QScriptValue& value) {
+    return value.isNumber() ? (float)value.toNumber() : value.toVariant().toFloat();
+}
+
 void registerMetaTypes(QScriptEngine* engine) {
     qScriptRegisterMetaType(engine, mat4toScriptValue, mat4FromScriptValue);
     qScriptRegisterMetaType(engine, vec4toScriptValue, vec4FromScriptValue);
@@ -78,22 +83,22 @@ QScriptValue mat4toScriptValue(QScriptEngine* engine, const glm::mat4& mat4) {
 }
 
 void mat4FromScriptValue(const QScriptValue& object, glm::mat4& mat4) {
-    mat4[0][0] = object.property("r0c0").toVariant().toFloat();
-    mat4[0][1] = object.property("r1c0").toVariant().toFloat();
-    mat4[0][2] = object.property("r2c0").toVariant().toFloat();
-    mat4[0][3] = object.property("r3c0").toVariant().toFloat();
-    mat4[1][0] = object.property("r0c1").toVariant().toFloat();
-    mat4[1][1] = object.property("r1c1").toVariant().toFloat();
-    mat4[1][2] = object.property("r2c1").toVariant().toFloat();
-    mat4[1][3] = object.property("r3c1").toVariant().toFloat();
-    mat4[2][0] = object.property("r0c2").toVariant().toFloat();
-    mat4[2][1] = object.property("r1c2").toVariant().toFloat();
-    mat4[2][2] = object.property("r2c2").toVariant().toFloat();
-    mat4[2][3] = object.property("r3c2").toVariant().toFloat();
-    mat4[3][0] = object.property("r0c3").toVariant().toFloat();
-    mat4[3][1] = object.property("r1c3").toVariant().toFloat();
-    mat4[3][2] = object.property("r2c3").toVariant().toFloat();
-    mat4[3][3] = object.property("r3c3").toVariant().toFloat();
+    mat4[0][0] = scriptValueToFloat(object.property("r0c0"));
+    mat4[0][1] = scriptValueToFloat(object.property("r1c0"));
+    mat4[0][2] = scriptValueToFloat(object.property("r2c0"));
+    mat4[0][3] = scriptValueToFloat(object.property("r3c0"));
+    mat4[1][0] = scriptValueToFloat(object.property("r0c1"));
+    mat4[1][1] = scriptValueToFloat(object.property("r1c1"));
+    mat4[1][2] = scriptValueToFloat(object.property("r2c1"));
+    mat4[1][3] = scriptValueToFloat(object.property("r3c1"));
+    mat4[2][0] = scriptValueToFloat(object.property("r0c2"));
+    mat4[2][1] = scriptValueToFloat(object.property("r1c2"));
+    mat4[2][2] = scriptValueToFloat(object.property("r2c2"));
+    mat4[2][3] = scriptValueToFloat(object.property("r3c2"));
+    mat4[3][0] = scriptValueToFloat(object.property("r0c3"));
+    mat4[3][1] = scriptValueToFloat(object.property("r1c3"));
+    mat4[3][2] = scriptValueToFloat(object.property("r2c3"));
+    mat4[3][3] = scriptValueToFloat(object.property("r3c3"));
 }
 
 QScriptValue vec4toScriptValue(QScriptEngine* engine, const glm::vec4& vec4) {
@@ -106,10 +111,10 @@ QScriptValue vec4toScriptValue(QScriptEngine* engine, const glm::vec4& vec4) {
 }
 
 void vec4FromScriptValue(const QScriptValue& object, glm::vec4& vec4) {
-    vec4.x = object.property("x").toVariant().toFloat();
-    vec4.y = object.property("y").toVariant().toFloat();
-    vec4.z = object.property("z").toVariant().toFloat();
-    vec4.w = object.property("w").toVariant().toFloat();
+    vec4.x = scriptValueToFloat(object.property("x"));
+    vec4.y = scriptValueToFloat(object.property("y"));
+    vec4.z = scriptValueToFloat(object.property("z"));
+    vec4.w = scriptValueToFloat(object.property("w"));
 }
 
 QScriptValue vec3toScriptValue(QScriptEngine* engine, const glm::vec3 &vec3) {
@@ -125,9 +130,9 @@ QScriptValue vec3toScriptValue(QScriptEngine* engine, const glm::vec3 &vec3) {
 }
 
 void vec3FromScriptValue(const QScriptValue &object, glm::vec3 &vec3) {
-    vec3.x = object.property("x").toVariant().toFloat();
-    vec3.y = object.property("y").toVariant().toFloat();
-    vec3.z = object.property("z").toVariant().toFloat();
+    vec3.x = scriptValueToFloat(object.property("x"));
+    vec3.y = scriptValueToFloat(object.property("y"));
+    vec3.z = scriptValueToFloat(object.property("z"));
 }
 
 QVariant vec3toVariant(const glm::vec3& vec3) {
@@ -259,10 +264,10 @@ QScriptValue quatToScriptValue(QScriptEngine* engine, const glm::quat& quat) {
 }
 
 void quatFromScriptValue(const QScriptValue& object, glm::quat &quat) {
-    quat.x = object.property("x").toVariant().toFloat();
-    quat.y = object.property("y").toVariant().toFloat();
-    quat.z = object.property("z").toVariant().toFloat();
-    quat.w = object.property("w").toVariant().toFloat();
+    quat.x = scriptValueToFloat(object.property("x"));
+    quat.y = scriptValueToFloat(object.property("y"));
+    quat.z = scriptValueToFloat(object.property("z"));
+    quat.w = scriptValueToFloat(object.property("w"));
 
     // enforce normalized quaternion
     float length = glm::length(quat);
@@ -464,8 +469,8 @@ QScriptValue vec2toScriptValue(QScriptEngine* engine, const glm::vec2 &vec2) {
 }
 
 void vec2FromScriptValue(const QScriptValue &object, glm::vec2 &vec2) {
-    vec2.x = object.property("x").toVariant().toFloat();
-    vec2.y = object.property("y").toVariant().toFloat();
+    vec2.x = scriptValueToFloat(object.property("x"));
+    vec2.y = scriptValueToFloat(object.property("y"));
 }
 
 QVariant vec2toVariant(const glm::vec2 &vec2) {
@@ -125,6 +125,11 @@ public:
     uint32_t _globalShapeKey { 0 };
     bool _enableTexturing { true };
 
+    // The center of the region shaded at the full rate in each eye, in the clip space of the eye projection, and its
+    // radius. Beyond it the lighting is shaded at half the rate, everywhere at the full rate when the radius is 0
+    glm::vec2 _foveationCenters[2];
+    float _foveationRadius { 0.0f };
+
     RenderDetails _details;
 };
 
@@ -0,0 +1,222 @@
+//
+//  SamplingProfiler.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SamplingProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QProcessEnvironment>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+
+std::atomic<bool> SamplingProfiler::_isActive { false };
+
+const int SamplingProfiler::DEFAULT_SAMPLE_INTERVAL_MSECS;
+const uint32_t SamplingProfiler::MAX_SCOPE_DEPTH;
+
+namespace {
+
+// The scopes a thread is in, written by that thread only and read by the sampling thread without a lock. A sample
+// taken as a scope is entered or left may be off by that scope, which is fine for a sample.
+struct ScopeStack {
+    QString threadName;
+    std::atomic<uint32_t> depth { 0 };
+    std::atomic<uint32_t> nameIDs[SamplingProfiler::MAX_SCOPE_DEPTH];
+    QHash<QString, uint32_t> knownNameIDs; // of the thread only, so the names are interned without a lock
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ScopeStack>> stacks;
+    QHash<QString, uint32_t> nameIDs;
+    QVector<QString> names;
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+thread_local std::shared_ptr<ScopeStack> threadStack;
+
+ScopeStack& getThreadStack() {
+    if (!threadStack) {
+        threadStack = std::make_shared<ScopeStack>();
+        QThread* thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            threadStack->threadName = "main";
+        } else if (thread && !thread->objectName().isEmpty()) {
+            threadStack->threadName = thread->objectName();
+        } else {
+            threadStack->threadName = QString("thread %1").arg((quint64)QThread::currentThreadId());
+        }
+
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.stacks.push_back(threadStack);
+    }
+    return *threadStack;
+}
+
+uint32_t getNameID(ScopeStack& stack, const QString& name) {
+    auto it = stack.knownNameIDs.find(name);
+    if (it != stack.knownNameIDs.end()) {
+        return it.value();
+    }
+
+    Registry& shared = registry();
+    uint32_t nameID;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        auto sharedIt = shared.nameIDs.find(name);
+        if (sharedIt == shared.nameIDs.end()) {
+            sharedIt = shared.nameIDs.insert(name, (uint32_t)shared.names.size());
+            shared.names.push_back(name);
+        }
+        nameID = sharedIt.value();
+    }
+    stack.knownNameIDs.insert(name, nameID);
+    return nameID;
+}
+
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+}
+
+void SamplingProfiler::start(int sampleIntervalMsecs) {
+    if (isSampling()) {
+        return;
+    }
+
+    qDebug() << "Sampling the profiled scopes every" << sampleIntervalMsecs << "msecs";
+    _isQuitting = false;
+    _isActive = true;
+    _thread = std::thread([this, sampleIntervalMsecs] {
+        while (!_isQuitting) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(sampleIntervalMsecs));
+            sample();
+        }
+    });
+}
+
+void SamplingProfiler::stop() {
+    if (!isSampling()) {
+        return;
+    }
+
+    // the scopes entered while sampling still leave, as they know they were entered
+    _isActive = false;
+    _isQuitting = true;
+    _thread.join();
+}
+
+void SamplingProfiler::startFromEnvironment() {
+    auto environment = QProcessEnvironment::systemEnvironment();
+    if (environment.contains(SAMPLING_PROFILER_ENV)) {
+        bool ok;
+        int sampleIntervalMsecs = environment.value(SAMPLING_PROFILER_ENV).toInt(&ok);
+        start(ok && sampleIntervalMsecs > 0 ? sampleIntervalMsecs : DEFAULT_SAMPLE_INTERVAL_MSECS);
+    }
+}
+
+void SamplingProfiler::reset() {
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    _samples.clear();
+    _sampleCount = 0;
+}
+
+quint64 SamplingProfiler::getSampleCount() const {
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    return _sampleCount;
+}
+
+void SamplingProfiler::enterScope(const QString& name) {
+    ScopeStack& stack = getThreadStack();
+    uint32_t depth = stack.depth.load(std::memory_order_relaxed);
+    if (depth < MAX_SCOPE_DEPTH) {
+        stack.nameIDs[depth].store(getNameID(stack, name), std::memory_order_relaxed);
+    }
+    stack.depth.store(depth + 1, std::memory_order_release);
+}
+
+void SamplingProfiler::leaveScope() {
+    ScopeStack& stack = getThreadStack();
+    uint32_t depth = stack.depth.load(std::memory_order_relaxed);
+    if (depth > 0) {
+        stack.depth.store(depth - 1, std::memory_order_release);
+    }
+}
+
+void SamplingProfiler::sample() {
+    std::vector<std::shared_ptr<ScopeStack>> stacks;
+    {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+
+        // the stacks that only the registry still holds are those of threads that ended
+        shared.stacks.erase(std::remove_if(shared.stacks.begin(), shared.stacks.end(),
+            [](const std::shared_ptr<ScopeStack>& stack) {
+                return stack.use_count() == 1;
+            }), shared.stacks.end());
+        stacks = shared.stacks;
+    }
+
+    std::vector<Stack> samples;
+    for (auto& stack : stacks) {
+        uint32_t depth = std::min(stack->depth.load(std::memory_order_acquire), MAX_SCOPE_DEPTH);
+        if (depth == 0) {
+            continue; // not in a profiled scope, idle or in code that has none
+        }
+        Stack sample { stack->threadName, std::vector<uint32_t>(depth) };
+        for (uint32_t i = 0; i < depth; i++) {
+            sample.second[i] = stack->nameIDs[i].load(std::memory_order_relaxed);
+        }
+        samples.push_back(std::move(sample));
+    }
+
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    for (auto& sample : samples) {
+        _samples[sample]++;
+    }
+    _sampleCount++;
+}
+
+QByteArray SamplingProfiler::getFoldedStacks() const {
+    QVector<QString> names;
+    {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        names = shared.names;
+    }
+
+    // the separators of the format may not appear in the names
+    auto fold = [](QString name) {
+        return name.replace(';', ':').replace('\n', ' ').toUtf8();
+    };
+
+    QByteArray folded;
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    for (auto& entry : _samples) {
+        folded += fold(entry.first.first);
+        for (auto nameID : entry.first.second) {
+            folded += ";" + fold(names.value(nameID));
+        }
+        folded += " " + QByteArray::number(entry.second) + "\n";
+    }
+    return folded;
+}
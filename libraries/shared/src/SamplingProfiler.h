@@ -0,0 +1,72 @@
+//
+//  SamplingProfiler.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_SamplingProfiler_h
+#define hifi_SamplingProfiler_h
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "DependencyManager.h"
+
+// set to start sampling at launch, to the interval between samples in msecs or to anything else for the default
+const QString SAMPLING_PROFILER_ENV = "HIFI_SAMPLING_PROFILER";
+
+// Samples the scopes of PROFILE_RANGE and PerformanceTimer that each thread is in, as a cheap pseudo-stack, and counts
+// the stacks seen to give a hot-spot view without an external profiler. The stacks come out in the folded format of
+// flame graph tools, a line of "thread;outer scope;inner scope count" per stack.
+class SamplingProfiler : public Dependency {
+public:
+    static const int DEFAULT_SAMPLE_INTERVAL_MSECS = 10;
+    static const uint32_t MAX_SCOPE_DEPTH = 32; // deeper scopes count as the deepest one kept
+
+    ~SamplingProfiler();
+
+    void start(int sampleIntervalMsecs = DEFAULT_SAMPLE_INTERVAL_MSECS);
+    void stop();
+    bool isSampling() const { return _thread.joinable(); }
+
+    // starts if SAMPLING_PROFILER_ENV is set
+    void startFromEnvironment();
+
+    void reset();
+    quint64 getSampleCount() const;
+    QByteArray getFoldedStacks() const;
+
+    // entered and left by the scopes on their own thread, while sampling
+    static bool isActive() { return _isActive.load(std::memory_order_relaxed); }
+    static void enterScope(const QString& name);
+    static void leaveScope();
+
+    // takes one sample of every thread, as the sampling thread does at each interval
+    void sample();
+
+private:
+    static std::atomic<bool> _isActive;
+
+    std::thread _thread;
+    std::atomic<bool> _isQuitting { false };
+
+    using Stack = std::pair<QString, std::vector<uint32_t>>; // the thread and the IDs of the names of its scopes
+    mutable std::mutex _samplesMutex;
+    std::map<Stack, quint64> _samples;
+    quint64 _sampleCount { 0 };
+};
+
+#endif // hifi_SamplingProfiler_h
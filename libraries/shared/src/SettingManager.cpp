@@ -72,9 +72,17 @@ namespace Setting {
             handleValue = handle->getVariant();
         }
 
+        bool shouldScheduleSave = false;
         withWriteLock([&] {
             _pendingChanges[key] = handleValue;
+            shouldScheduleSave = !_isSaveScheduled;
+            _isSaveScheduled = true;
         });
+
+        // the first change after a save starts the timer, the others until it fires are saved with it
+        if (shouldScheduleSave) {
+            QMetaObject::invokeMethod(this, "startTimer");
+        }
     }
 
     static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
@@ -82,11 +90,18 @@ namespace Setting {
         if (!_saveTimer) {
             _saveTimer = new QTimer(this);
             Q_CHECK_PTR(_saveTimer);
-            _saveTimer->setSingleShot(true); // We will restart it once settings are saved.
+            _saveTimer->setSingleShot(true); // We will restart it once settings change again.
             _saveTimer->setInterval(SAVE_INTERVAL_MSEC); // 5s, Qt::CoarseTimer acceptable
             connect(_saveTimer, SIGNAL(timeout()), this, SLOT(saveAll()));
         }
-        _saveTimer->start();
+
+        bool hasPendingChanges = false;
+        withReadLock([&] {
+            hasPendingChanges = !_pendingChanges.isEmpty();
+        });
+        if (hasPendingChanges && !_saveTimer->isActive()) {
+            _saveTimer->start();
+        }
     }
 
     void Manager::stopTimer() {
@@ -96,32 +111,42 @@ namespace Setting {
     }
 
     void Manager::saveAll() {
+        // the handles keep changing while the changes are written, so the lock is only held to copy and clear them
+        QHash<QString, QVariant> changes;
+        withWriteLock([&] {
+            changes = _pendingChanges;
+            _isSaveScheduled = false;
+        });
+
         bool forceSync = false;
+        for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+            const auto& key = it.key();
+            const auto& newValue = it.value();
+            auto savedValue = value(key, UNSET_VALUE);
+            if (newValue == savedValue) {
+                continue;
+            }
+            if (newValue == UNSET_VALUE || !newValue.isValid()) {
+                forceSync = true;
+                remove(key);
+            } else {
+                forceSync = true;
+                setValue(key, newValue);
+            }
+        }
+
         withWriteLock([&] {
-            for (auto key : _pendingChanges.keys()) {
-                auto newValue = _pendingChanges[key];
-                auto savedValue = value(key, UNSET_VALUE);
-                if (newValue == savedValue) {
-                    continue;
-                }
-                if (newValue == UNSET_VALUE || !newValue.isValid()) {
-                    forceSync = true;
-                    remove(key);
-                } else {
-                    forceSync = true;
-                    setValue(key, newValue);
+            for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+                auto pending = _pendingChanges.find(it.key());
+                if (pending != _pendingChanges.end() && pending.value() == it.value()) {
+                    _pendingChanges.erase(pending);
                 }
             }
-            _pendingChanges.clear();
         });
 
+        // the file is written as a whole and replaced, through a QSaveFile
         if (forceSync) {
             sync();
         }
-
-        // Restart timer
-        if (_saveTimer) {
-            _saveTimer->start();
-        }
     }
 }
@@ -47,7 +47,8 @@ namespace Setting {
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
         const QVariant UNSET_VALUE { QUuid::createUuid() };
-        QHash<QString, QVariant> _pendingChanges;
+        QHash<QString, QVariant> _pendingChanges; // kept until saved, the loads see them while they are written
+        bool _isSaveScheduled { false };
 
         friend class Interface;
         friend void cleanupPrivateInstance();
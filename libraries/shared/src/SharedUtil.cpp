@@ -11,6 +11,7 @@
 
 #include "SharedUtil.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstdio>
@@ -44,6 +45,10 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include <CoreFoundation/CoreFoundation.h>
 #endif
 
+#ifndef Q_OS_WIN
+#include <sys/resource.h>
+#endif
+
 #include <QtCore/QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
@@ -880,12 +885,69 @@ bool getMemoryInfo(MemoryInfo& info) {
     info.processUsedMemoryBytes = pmc.PrivateUsage;
     info.processPeakUsedMemoryBytes = pmc.PeakPagefileUsage;
 
+    return true;
+#elif defined(Q_OS_LINUX)
+    // the sizes of /proc are in kB
+    auto readSizes = [](const char* path, const char* firstName, uint64_t& first,
+                        const char* secondName, uint64_t& second) {
+        FILE* file = fopen(path, "r");
+        if (!file) {
+            return false;
+        }
+        first = second = 0;
+        char line[256];
+        size_t firstLength = strlen(firstName);
+        size_t secondLength = strlen(secondName);
+        while (fgets(line, sizeof(line), file)) {
+            if (strncmp(line, firstName, firstLength) == 0) {
+                first = strtoull(line + firstLength, nullptr, 10) * 1024;
+            } else if (strncmp(line, secondName, secondLength) == 0) {
+                second = strtoull(line + secondLength, nullptr, 10) * 1024;
+            }
+        }
+        fclose(file);
+        return true;
+    };
+
+    if (!readSizes("/proc/meminfo", "MemTotal:", info.totalMemoryBytes, "MemAvailable:", info.availMemoryBytes) ||
+        info.totalMemoryBytes == 0) {
+        return false;
+    }
+    info.usedMemoryBytes = info.totalMemoryBytes - std::min(info.availMemoryBytes, info.totalMemoryBytes);
+
+    if (!readSizes("/proc/self/status", "VmRSS:", info.processUsedMemoryBytes, "VmHWM:", info.processPeakUsedMemoryBytes)) {
+        return false;
+    }
+
     return true;
 #endif
 
     return false;
 }
 
+bool getProcessCPUTime(uint64_t& usecs) {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return false;
+    }
+    // the times are in 100ns units
+    auto toUsecs = [](const FILETIME& time) {
+        return ((uint64_t)time.dwHighDateTime << 32 | time.dwLowDateTime) / 10;
+    };
+    usecs = toUsecs(kernelTime) + toUsecs(userTime);
+    return true;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return false;
+    }
+    usecs = (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * USECS_PER_SECOND +
+        usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    return true;
+#endif
+}
+
 // Largely taken from: https://msdn.microsoft.com/en-us/library/windows/desktop/ms683194(v=vs.85).aspx
 
 #ifdef Q_OS_WIN
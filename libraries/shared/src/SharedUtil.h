@@ -220,6 +220,9 @@ struct MemoryInfo {
 
 bool getMemoryInfo(MemoryInfo& info);
 
+// the user and kernel time this process has used so far, across all of its threads
+bool getProcessCPUTime(uint64_t& usecs);
+
 struct ProcessorInfo {
     int32_t numPhysicalProcessorPackages;
     int32_t numProcessorCores;
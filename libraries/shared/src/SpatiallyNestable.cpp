@@ -70,6 +70,7 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    invalidateWorldTransforms();
 
     bool success = false;
     getParentPointer(success);
@@ -150,6 +151,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateWorldTransforms();
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -406,6 +408,7 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success, bo
             myWorldTransform.setTranslation(position);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
             _translationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (success && changed) {
@@ -459,6 +462,7 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
             myWorldTransform.setRotation(orientation);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
             _rotationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (success && changed) {
@@ -596,14 +600,71 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    // the version is read before the transform is computed, so a change made while computing it outdates what is cached
+    quint32 version = _worldTransformVersion.load(std::memory_order_acquire);
+    if (readWorldTransformCache(version, result)) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success && _parentJointIndex == INVALID_JOINT_INDEX) {
+        SpatiallyNestablePointer parent = _parent.lock();
+        if (!parent || parent->hasCachedWorldTransform()) {
+            writeWorldTransformCache(version, result);
+        }
+    }
     return result;
 }
 
+bool SpatiallyNestable::readWorldTransformCache(quint32 version, Transform& result) const {
+    quint32 sequence = _worldTransformCacheSequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false; // being written
+    }
+    WorldTransformCache cache = _worldTransformCache;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_worldTransformCacheSequence.load(std::memory_order_relaxed) != sequence || cache.version != version) {
+        return false;
+    }
+    if (cache.hasParent && _parent.expired()) {
+        return false; // the parent was deleted, and its children weren't told to move
+    }
+    result = Transform(cache.rotation, cache.scale, cache.translation);
+    return true;
+}
+
+void SpatiallyNestable::writeWorldTransformCache(quint32 version, const Transform& transform) const {
+    quint32 sequence = _worldTransformCacheSequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) ||
+        !_worldTransformCacheSequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return; // another thread is writing it
+    }
+    _worldTransformCache.version = version;
+    _worldTransformCache.hasParent = !_parent.expired();
+    _worldTransformCache.rotation = transform.getRotation();
+    _worldTransformCache.scale = transform.getScale();
+    _worldTransformCache.translation = transform.getTranslation();
+    _worldTransformCacheSequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool SpatiallyNestable::hasCachedWorldTransform() const {
+    Transform transform;
+    return readWorldTransformCache(_worldTransformVersion.load(std::memory_order_acquire), transform);
+}
+
+void SpatiallyNestable::invalidateWorldTransforms() {
+    _worldTransformVersion++;
+    forEachDescendant([&](SpatiallyNestablePointer descendant) {
+        descendant->_worldTransformVersion++;
+    });
+}
+
 const Transform SpatiallyNestable::getTransform() const {
     bool success;
     Transform result = getTransform(success);
@@ -659,6 +720,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             changed = true;
             _translationChanged = usecTimestampNow();
             _rotationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (success && changed) {
@@ -700,6 +762,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
             _transform.setScale(scale);
             changed = true;
             _scaleChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (changed) {
@@ -722,6 +785,7 @@ void SpatiallyNestable::setScale(float value) {
         if (_transform.getScale() != beforeScale) {
             changed = true;
             _scaleChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
 
@@ -753,6 +817,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
             _rotationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
 
@@ -781,6 +846,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
             _transform.setTranslation(position);
             changed = true;
             _translationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (changed) {
@@ -808,6 +874,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
             _transform.setRotation(orientation);
             changed = true;
             _rotationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (changed) {
@@ -866,6 +933,7 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
             _transform.setScale(scale);
             changed = true;
             _scaleChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     if (changed) {
@@ -937,6 +1005,7 @@ void SpatiallyNestable::forEachDescendant(std::function<void(SpatiallyNestablePo
 }
 
 void SpatiallyNestable::locationChanged(bool tellPhysics) {
+    _worldTransformVersion++; // the world transform of this object and, below, of its descendants
     forEachChild([&](SpatiallyNestablePointer object) {
         object->locationChanged(tellPhysics);
     });
@@ -1111,6 +1180,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
             _rotationChanged = usecTimestampNow();
+            _worldTransformVersion++;
         }
     });
     // linear velocity
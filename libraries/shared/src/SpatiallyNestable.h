@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -220,6 +222,27 @@ private:
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
     bool _isDead { false };
+
+    // The world transform, as last computed by getTransform, so that reading it is lock free while neither this object
+    // nor an ancestor has moved. _worldTransformVersion is bumped by every change to the local transform, and by
+    // locationChanged and reparenting, which reach the descendants too, and a cached transform of an older version is
+    // ignored. The cache is written under a sequence lock that is odd while a write is in progress. Only transforms
+    // that don't depend on a joint are cached, as a parent's joints move without telling its children.
+    struct WorldTransformCache {
+        quint32 version { 0 }; // 0 when nothing is cached
+        bool hasParent { false };
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+    };
+    mutable std::atomic<quint32> _worldTransformVersion { 1 };
+    mutable std::atomic<quint32> _worldTransformCacheSequence { 0 };
+    mutable WorldTransformCache _worldTransformCache;
+
+    bool readWorldTransformCache(quint32 version, Transform& result) const;
+    void writeWorldTransformCache(quint32 version, const Transform& transform) const;
+    bool hasCachedWorldTransform() const;
+    void invalidateWorldTransforms(); // of this object and its descendants
 };
 
 
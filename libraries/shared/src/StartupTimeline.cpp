@@ -0,0 +1,146 @@
+//
+//  StartupTimeline.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupTimeline.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include "SharedLogging.h"
+
+namespace {
+
+class StartupTask : public QRunnable {
+public:
+    StartupTask(const QString& name, std::function<void()> task) : _name(name), _task(task) {}
+
+    void run() override {
+        StartupTimeline::Phase phase(_name);
+        _task();
+    }
+
+private:
+    QString _name;
+    std::function<void()> _task;
+};
+
+QString currentThreadName() {
+    QThread* thread = QThread::currentThread();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+        return "main";
+    }
+    return thread->objectName().isEmpty() ? QString("thread %1").arg((quint64)QThread::currentThreadId()) :
+        thread->objectName();
+}
+
+}
+
+StartupTimeline::Phase::Phase(const QString& name) : _name(name) {
+    if (DependencyManager::isSet<StartupTimeline>()) {
+        auto timeline = DependencyManager::get<StartupTimeline>();
+        if (!timeline->isFinished()) {
+            _start = timeline->elapsed();
+        }
+    }
+}
+
+StartupTimeline::Phase::~Phase() {
+    if (_start >= 0 && DependencyManager::isSet<StartupTimeline>()) {
+        auto timeline = DependencyManager::get<StartupTimeline>();
+        timeline->addPhase(_name, _start, timeline->elapsed());
+    }
+}
+
+void StartupTimeline::mark(const QString& milestone) {
+    qint64 now = elapsed();
+    addEntry(milestone, now, now, true);
+}
+
+void StartupTimeline::addPhase(const QString& name, qint64 start, qint64 end) {
+    addEntry(name, start, end, false);
+}
+
+void StartupTimeline::addEntry(const QString& name, qint64 start, qint64 end, bool isMilestone) {
+    if (_isFinished) {
+        return;
+    }
+    Entry entry { name, currentThreadName(), start, end, isMilestone };
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.push_back(entry);
+}
+
+void StartupTimeline::runTask(const QString& name, std::function<void()> task) {
+    QThreadPool::globalInstance()->start(new StartupTask(name, task));
+}
+
+bool StartupTimeline::finish(const QString& milestone) {
+    if (_isFinished) {
+        return false;
+    }
+    mark(milestone);
+    if (_isFinished.exchange(true)) {
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entries = _entries;
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.start < b.start;
+    });
+
+    qCInfo(shared) << "Startup timeline:";
+    for (auto& entry : entries) {
+        if (entry.isMilestone) {
+            qCInfo(shared, "%8lld ms  %s", entry.start, qPrintable(entry.name));
+        } else {
+            qCInfo(shared, "%8lld ms  %s took %lld ms on %s", entry.start, qPrintable(entry.name), entry.end - entry.start,
+                   qPrintable(entry.thread));
+        }
+    }
+    return true;
+}
+
+QJsonObject StartupTimeline::toJson() const {
+    QJsonArray milestones;
+    QJsonArray phases;
+    qint64 total = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& entry : _entries) {
+            QJsonObject object;
+            object["name"] = entry.name;
+            object["start_ms"] = (double)entry.start;
+            if (entry.isMilestone) {
+                milestones.append(object);
+            } else {
+                object["duration_ms"] = (double)(entry.end - entry.start);
+                object["thread"] = entry.thread;
+                phases.append(object);
+            }
+            total = std::max(total, entry.end);
+        }
+    }
+
+    QJsonObject timeline;
+    timeline["total_ms"] = (double)total;
+    timeline["milestones"] = milestones;
+    timeline["phases"] = phases;
+    return timeline;
+}
@@ -0,0 +1,77 @@
+//
+//  StartupTimeline.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_StartupTimeline_h
+#define hifi_StartupTimeline_h
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include "DependencyManager.h"
+
+// The milestones and the phases of the startup of a process, in msecs since it started, logged and reported once the
+// startup is done so that the time to the first frame can be followed from one release to the next. The independent
+// startup work runs as tasks on the global thread pool, and each subsystem waits for its own task where it needs the
+// result.
+class StartupTimeline : public Dependency {
+public:
+    // records the time spent in a scope, when there is a timeline and it isn't finished
+    class Phase {
+    public:
+        Phase(const QString& name);
+        ~Phase();
+
+    private:
+        QString _name;
+        qint64 _start { -1 };
+    };
+
+    StartupTimeline(const QElapsedTimer& startupTimer) : _startupTimer(startupTimer) {}
+
+    qint64 elapsed() const { return _startupTimer.elapsed(); }
+
+    void mark(const QString& milestone);
+    void addPhase(const QString& name, qint64 start, qint64 end);
+
+    // runs the task on the global thread pool as a phase of the timeline
+    void runTask(const QString& name, std::function<void()> task);
+
+    // the last milestone, returns true and logs the timeline the first time only
+    bool finish(const QString& milestone);
+    bool isFinished() const { return _isFinished; }
+
+    QJsonObject toJson() const;
+
+private:
+    struct Entry {
+        QString name;
+        QString thread;
+        qint64 start;
+        qint64 end; // the start for a milestone
+        bool isMilestone;
+    };
+
+    void addEntry(const QString& name, qint64 start, qint64 end, bool isMilestone);
+
+    const QElapsedTimer _startupTimer;
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;
+    std::atomic<bool> _isFinished { false };
+};
+
+#endif // hifi_StartupTimeline_h
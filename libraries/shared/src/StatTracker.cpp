@@ -17,6 +17,11 @@ QVariant StatTracker::getStat(const QString& name) {
     return _stats[name];
 }
 
+QHash<QString, int> StatTracker::getStats() {
+    Lock lock(_statsLock);
+    return _stats;
+}
+
 void StatTracker::setStat(const QString& name, int value) {
     Lock lock(_statsLock);
     _stats[name] = value;
@@ -24,6 +24,7 @@ class StatTracker : public Dependency {
 public:
     StatTracker();
     QVariant getStat(const QString& name);
+    QHash<QString, int> getStats();
     void setStat(const QString& name, int value);
     void updateStat(const QString& name, int mod);
     void incrementStat(const QString& name);
@@ -8,7 +8,10 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <limits>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -17,6 +20,8 @@
 #include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QDateTime>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -24,21 +29,97 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QTextStream>
 
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
 
 #include <BuildInfo.h>
 
 #include "Gzip.h"
+#include "NumericalConstants.h"
+#include "PathUtils.h"
 #include "PortableHighResolutionClock.h"
+#include "SharedUtil.h"
 #include "shared/GlobalAppProperties.h"
 
 using namespace tracing;
 
+static const uint64_t THREAD_BUFFER_RECORDS = 1 << 14; // a few seconds of a busy thread
+static const uint64_t THREAD_BUFFER_MASK = THREAD_BUFFER_RECORDS - 1;
+static const uint64_t ARCHIVE_SEGMENT_RECORDS = 1 << 10; // how often a thread moves its records out while tracing
+static const quint64 MIN_STALL_DUMP_INTERVAL_USECS = 60 * USECS_PER_SECOND;
+
+static std::atomic<uint64_t> nextTracerID { 1 };
+
+static TraceTimestamp traceTimestampNow() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// The ring buffer of a thread, written by that thread only. The other threads copy its records and then keep those
+// the thread did not overwrite while they were copied, which they tell by the head it reached.
+class tracing::TraceThreadBuffer {
+public:
+    TraceThreadBuffer(qint64 processID, qint64 threadID) :
+        processID(processID), threadID(threadID), records(new TraceRecord[THREAD_BUFFER_RECORDS]) {}
+
+    uint32_t getNameID(const QString& name, Tracer& tracer) {
+        auto it = nameIDs.find(name);
+        if (it == nameIDs.end()) {
+            it = nameIDs.insert(name, tracer.internName(name));
+        }
+        return it.value();
+    }
+
+    void copyRecords(uint64_t from, uint64_t to, std::vector<TraceRecord>& out) const {
+        from = std::max(from, to > THREAD_BUFFER_RECORDS ? to - THREAD_BUFFER_RECORDS : 0);
+        size_t first = out.size();
+        for (uint64_t i = from; i < to; i++) {
+            out.push_back(records[i & THREAD_BUFFER_MASK]);
+        }
+
+        // the record at head may be replacing the one a ringful before it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t head = this->head.load(std::memory_order_relaxed) + 1;
+        uint64_t firstIntact = head > THREAD_BUFFER_RECORDS ? head - THREAD_BUFFER_RECORDS : 0;
+        if (firstIntact > from) {
+            size_t numTorn = (size_t)(std::min(firstIntact, to) - from);
+            out.erase(out.begin() + first, out.begin() + first + numTorn);
+        }
+    }
+
+    // moves the records up to to into the archive, which keeps them for serialize() while tracing
+    void archiveUpTo(uint64_t to) {
+        std::lock_guard<std::mutex> guard(archiveMutex);
+        if (to > archivedHead) {
+            copyRecords(archivedHead, to, archive);
+            archivedHead = to;
+        }
+    }
+
+    const qint64 processID;
+    const qint64 threadID;
+    std::unique_ptr<TraceRecord[]> records;
+    std::atomic<uint64_t> head { 0 };
+    QHash<QString, uint32_t> nameIDs; // of the thread only, so the names are interned without a lock
+
+    std::mutex archiveMutex;
+    std::vector<TraceRecord> archive;
+    uint64_t archivedHead { 0 };
+};
+
+struct ThreadBufferHolder {
+    uint64_t tracerID { 0 };
+    std::shared_ptr<TraceThreadBuffer> buffer;
+};
+static thread_local ThreadBufferHolder threadBufferHolder;
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+Tracer::Tracer() : _id(nextTracerID++) {
+}
+
 void Tracer::startTracing() {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
@@ -47,6 +128,17 @@ void Tracer::startTracing() {
     }
 
     _events.clear();
+    {
+        // the records from before are not part of the trace
+        std::lock_guard<std::mutex> buffersGuard(_threadBuffersMutex);
+        for (auto& buffer : _threadBuffers) {
+            std::lock_guard<std::mutex> archiveGuard(buffer->archiveMutex);
+            buffer->archive.clear();
+            buffer->archivedHead = buffer->head.load(std::memory_order_acquire);
+        }
+    }
+    _tracingStarted = traceTimestampNow();
+    _tracingStopped = std::numeric_limits<TraceTimestamp>::max();
     _enabled = true;
 }
 
@@ -57,6 +149,150 @@ void Tracer::stopTracing() {
         return;
     }
     _enabled = false;
+    _tracingStopped = traceTimestampNow();
+
+    // keep what is left in the rings, before the threads overwrite it
+    std::lock_guard<std::mutex> buffersGuard(_threadBuffersMutex);
+    for (auto& buffer : _threadBuffers) {
+        buffer->archiveUpTo(buffer->head.load(std::memory_order_acquire));
+    }
+}
+
+uint32_t Tracer::internName(const QString& name) {
+    std::lock_guard<std::mutex> guard(_namesMutex);
+    auto it = _nameIDs.find(name);
+    if (it == _nameIDs.end()) {
+        it = _nameIDs.insert(name, (uint32_t)_names.size());
+        _names.push_back(name);
+    }
+    return it.value();
+}
+
+TraceThreadBuffer& Tracer::getThreadBuffer() {
+    if (threadBufferHolder.tracerID != _id) {
+        auto buffer = std::make_shared<TraceThreadBuffer>(QCoreApplication::applicationPid(),
+                                                          int64_t(QThread::currentThreadId()));
+        std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+        if (!_enabled) {
+            // the buffers that only we still hold are those of threads that ended
+            _threadBuffers.erase(std::remove_if(_threadBuffers.begin(), _threadBuffers.end(),
+                [](const std::shared_ptr<TraceThreadBuffer>& buffer) {
+                    return buffer.use_count() == 1;
+                }), _threadBuffers.end());
+        }
+        _threadBuffers.push_back(buffer);
+        threadBufferHolder.tracerID = _id;
+        threadBufferHolder.buffer = buffer;
+    }
+    return *threadBufferHolder.buffer;
+}
+
+void Tracer::recordEvent(const QLoggingCategory& category, const QString& name, EventType type) {
+    TraceThreadBuffer& buffer = getThreadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    TraceRecord& record = buffer.records[head & THREAD_BUFFER_MASK];
+    record.timestamp = traceTimestampNow();
+    record.category = &category;
+    record.nameID = buffer.getNameID(name, *this);
+    record.type = type;
+    buffer.head.store(head + 1, std::memory_order_release);
+
+    if (((head + 1) & (ARCHIVE_SEGMENT_RECORDS - 1)) == 0 && _enabled) {
+        buffer.archiveUpTo(head + 1);
+    }
+}
+
+std::vector<Tracer::ThreadRecords> Tracer::takeTracedRecords() {
+    TraceTimestamp started = _tracingStarted;
+    TraceTimestamp stopped = _tracingStopped;
+    bool enabled = _enabled;
+
+    std::vector<ThreadRecords> threads;
+    std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+    for (auto& buffer : _threadBuffers) {
+        if (enabled) {
+            buffer->archiveUpTo(buffer->head.load(std::memory_order_acquire));
+        }
+        ThreadRecords thread { buffer->processID, buffer->threadID, {} };
+        {
+            std::lock_guard<std::mutex> archiveGuard(buffer->archiveMutex);
+            thread.records.swap(buffer->archive);
+        }
+
+        // the archived segments start and end with some records from outside the trace
+        thread.records.erase(std::remove_if(thread.records.begin(), thread.records.end(),
+            [&](const TraceRecord& record) {
+                return record.timestamp < started || record.timestamp > stopped;
+            }), thread.records.end());
+        threads.push_back(std::move(thread));
+    }
+    return threads;
+}
+
+std::vector<Tracer::ThreadRecords> Tracer::copyRecentRecords() const {
+    std::vector<ThreadRecords> threads;
+    std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+    for (auto& buffer : _threadBuffers) {
+        ThreadRecords thread { buffer->processID, buffer->threadID, {} };
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        thread.records.reserve(std::min(head, THREAD_BUFFER_RECORDS));
+        buffer->copyRecords(0, head, thread.records);
+        threads.push_back(std::move(thread));
+    }
+    return threads;
+}
+
+class TraceWriter : public QRunnable {
+public:
+    TraceWriter(std::function<void()> write) : _write(write) {}
+    void run() override { _write(); }
+
+private:
+    std::function<void()> _write;
+};
+
+void Tracer::dumpFlightRecorder(const QString& file) {
+    std::list<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        events = _metadataEvents;
+    }
+    QVector<QString> names;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        names = _names;
+    }
+    writeTrace(file, events, copyRecentRecords(), names);
+}
+
+void Tracer::reportStall(const QString& what, quint64 stallUsecs) {
+    quint64 now = usecTimestampNow();
+    quint64 lastDump = _lastStallDump;
+    if (!_flightRecorderEnabled || (lastDump != 0 && now - lastDump < MIN_STALL_DUMP_INTERVAL_USECS) ||
+        !_lastStallDump.compare_exchange_strong(lastDump, now)) {
+        return;
+    }
+
+    QString directory = PathUtils::getAppDataPath() + "flight-recorder";
+    QDir().mkpath(directory);
+    QString path = directory + "/" + what + "-" + QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss") + ".json.gz";
+    qWarning() << what << "stalled for" << stallUsecs << "usecs, dumping the flight recorder to" << path;
+
+    // the records are copied now, before the threads move on, and written out from the pool
+    std::list<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        events = _metadataEvents;
+    }
+    QVector<QString> names;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        names = _names;
+    }
+    auto threads = std::make_shared<std::vector<ThreadRecords>>(copyRecentRecords());
+    QThreadPool::globalInstance()->start(new TraceWriter([path, events, threads, names] {
+        writeTrace(path, events, *threads, names);
+    }));
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -104,8 +340,7 @@ void TraceEvent::writeJson(QTextStream& out) const {
 #endif
 }
 
-void Tracer::serialize(const QString& originalPath) {
-
+static QString resolveTracePath(const QString& originalPath) {
     QString path = originalPath;
 
     // Filter for specific tokens potentially present in the path:
@@ -125,8 +360,11 @@ void Tracer::serialize(const QString& originalPath) {
             QDir(docsLocation).mkpath(originalRelativePath);
         }
     }
+    return path;
+}
 
-
+void Tracer::serialize(const QString& originalPath) {
+    QString path = resolveTracePath(originalPath);
 
     std::list<TraceEvent> currentEvents;
     {
@@ -136,19 +374,59 @@ void Tracer::serialize(const QString& originalPath) {
             currentEvents.push_back(event);
         }
     }
+    auto threads = takeTracedRecords();
+    QVector<QString> names;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        names = _names;
+    }
+
+    writeTrace(path, currentEvents, threads, names);
+
+#if 0
+    QByteArray data;
+    {
+
+        // "traceEvents":[
+        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processPendingChangesQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
+
+        QJsonArray traceEvents;
 
+        QJsonDocument document {
+            QJsonObject {
+                { "traceEvents", traceEvents },
+                { "otherData", QJsonObject {
+                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
+                } }
+            }
+        };
+        
+        data = document.toJson(QJsonDocument::Compact);
+    }
+#endif
+}
+
+void Tracer::writeTrace(const QString& path, const std::list<TraceEvent>& events,
+                        const std::vector<ThreadRecords>& threads, const QVector<QString>& names) {
     // If the file exists and we can't remove it, fail early
     if (QFileInfo(path).exists() && !QFile::remove(path)) {
         return;
     }
 
-    // If we can't open a temp file for writing, fail early
+    // the names of the records are escaped once each
+    QVector<QByteArray> jsonNames;
+    jsonNames.reserve(names.size());
+    for (auto& name : names) {
+        QByteArray jsonName = QJsonDocument(QJsonArray { name }).toJson(QJsonDocument::Compact);
+        jsonNames.push_back(jsonName.mid(1, jsonName.size() - 2));
+    }
+
     QByteArray data;
     {
         QTextStream out(&data);
         out << "[\n";
         bool first = true;
-        for (const auto& event : currentEvents) {
+        for (const auto& event : events) {
             if (first) {
                 first = false;
             } else {
@@ -156,6 +434,21 @@ void Tracer::serialize(const QString& originalPath) {
             }
             event.writeJson(out);
         }
+        for (const auto& thread : threads) {
+            for (const auto& record : thread.records) {
+                if (first) {
+                    first = false;
+                } else {
+                    out << ",\n";
+                }
+                out << "{\"name\":" << jsonNames[record.nameID]
+                    << ",\"cat\":\"" << record.category->categoryName()
+                    << "\",\"ph\":\"" << (char)record.type
+                    << "\",\"ts\":" << (qulonglong)record.timestamp
+                    << ",\"pid\":" << thread.processID
+                    << ",\"tid\":" << thread.threadID << "}";
+            }
+        }
         out << "\n]";
     }
 
@@ -173,28 +466,6 @@ void Tracer::serialize(const QString& originalPath) {
         file.write(data);
         file.close();
     }
-
-#if 0
-    QByteArray data;
-    {
-
-        // "traceEvents":[
-        // {"args":{"nv_payload":0},"cat":"hifi.render","name":"render::Scene::processPendingChangesQueue","ph":"B","pid":14796,"tid":21636,"ts":68795933487}
-
-        QJsonArray traceEvents;
-
-        QJsonDocument document {
-            QJsonObject {
-                { "traceEvents", traceEvents },
-                { "otherData", QJsonObject {
-                    { "version", QString { "High Fidelity Interface v1.0" } +BuildInfo::VERSION }
-                } }
-            }
-        };
-        
-        data = document.toJson(QJsonDocument::Compact);
-    }
-#endif
 }
 
 void Tracer::traceEvent(const QLoggingCategory& category,
@@ -243,11 +514,18 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
+    if (type != Metadata && id.isEmpty() && args.empty() && extra.empty()) {
+        if (isRecording()) {
+            recordEvent(category, name, type);
+        }
+        return;
+    }
+
     if (!_enabled && type != Metadata) {
         return;
     }
 
-    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+    auto timestamp = traceTimestampNow();
     auto processID = QCoreApplication::applicationPid();
     auto threadID = int64_t(QThread::currentThreadId());
 
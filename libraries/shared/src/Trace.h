@@ -10,13 +10,18 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
 #include <QtCore/QHash>
 #include <QtCore/QSet>
+#include <QtCore/QVector>
 #include <QtCore/QLoggingCategory>
 
 #include "DependencyManager.h"
@@ -76,8 +81,22 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// A fixed-size event of the binary backend, which records the events without an id, args or extras, most of them, in
+// a lock-free ring buffer per thread. The category is kept by its address, as the categories are static, and the name
+// by the ID it is interned with.
+struct TraceRecord {
+    TraceTimestamp timestamp;
+    const QLoggingCategory* category;
+    uint32_t nameID;
+    EventType type;
+};
+
+class TraceThreadBuffer;
+
 class Tracer : public Dependency {
 public:
+    Tracer();
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
@@ -88,17 +107,61 @@ public:
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // The flight recorder keeps the recent events of each thread in its ring buffer while not tracing, cheaply enough
+    // to stay on in the servers. Only the events of the binary backend are kept, those with args need tracing.
+    void setFlightRecorderEnabled(bool enabled) { _flightRecorderEnabled = enabled; }
+    bool isFlightRecorderEnabled() const { return _flightRecorderEnabled; }
+    bool isRecording() const { return _enabled || _flightRecorderEnabled; }
+
+    // writes the recent events of every thread to file, in the format of serialize()
+    void dumpFlightRecorder(const QString& file);
+
+    // dumps the flight recorder into the app data path from a pool thread, at most once a minute, when what took
+    // too long
+    void reportStall(const QString& what, quint64 stallUsecs);
+
 private:
+    struct ThreadRecords {
+        qint64 processID;
+        qint64 threadID;
+        std::vector<TraceRecord> records;
+    };
+
+    TraceThreadBuffer& getThreadBuffer();
+    void recordEvent(const QLoggingCategory& category, const QString& name, EventType type);
+    std::vector<ThreadRecords> takeTracedRecords();
+    std::vector<ThreadRecords> copyRecentRecords() const;
+    static void writeTrace(const QString& path, const std::list<TraceEvent>& events,
+                           const std::vector<ThreadRecords>& threads, const QVector<QString>& names);
+
+    friend class TraceThreadBuffer;
+    uint32_t internName(const QString& name);
+
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         qint64 timestamp, qint64 processID, qint64 threadID,
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    bool _enabled { false };
+    std::atomic<bool> _enabled { false };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    // the threads look their buffer up by the ID of the tracer, rather than by its address, which could be reused
+    const uint64_t _id;
+    std::atomic<bool> _flightRecorderEnabled { false };
+    std::atomic<TraceTimestamp> _tracingStarted { 0 };
+    std::atomic<TraceTimestamp> _tracingStopped { 0 };
+    std::atomic<quint64> _lastStallDump { 0 };
+
+    mutable std::mutex _threadBuffersMutex;
+    std::vector<std::shared_ptr<TraceThreadBuffer>> _threadBuffers;
+
+    mutable std::mutex _namesMutex;
+    QHash<QString, uint32_t> _nameIDs;
+    QVector<QString> _names;
 };
 
 inline void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
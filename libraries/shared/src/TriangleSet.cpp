@@ -9,11 +9,194 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+#include <float.h>
+
 #include "GLMHelpers.h"
 #include "TriangleSet.h"
 
+namespace {
+
+const int TREE_BIN_COUNT = 12;
+const uint32_t MAX_LEAF_TRIANGLES = 4;
+const int MAX_TREE_DEPTH = 48;
+const int TREE_STACK_SIZE = 64; // deep enough for the median splits of huge leaves below MAX_TREE_DEPTH
+const float TREE_TRAVERSAL_COST = 1.0f; // relative to the cost of testing one triangle
+
+// The planes of each triangle are kept one float array per component so a leaf can be tested 4 triangles at a time.
+// Each plane is (x, y, z, d): the face plane, then one inward facing plane per edge.
+const int TREE_PLANE_NORMAL = 0;
+const int TREE_PLANE_EDGE0 = 4;
+const int TREE_PLANE_EDGE1 = 8;
+const int TREE_PLANE_EDGE2 = 12;
+const int NUM_TREE_PLANE_COMPONENTS = 16;
+
+const float MIN_RAY_DIRECTION = 1.0e-12f; // keeps the slab test finite for axis aligned rays
+
+struct TreeRay {
+    float origin[4];
+    float direction[4];
+    float inverse[4];
+};
+
+inline float surfaceArea(const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 extent = maximum - minimum;
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+inline int binIndex(float centroid, float centroidMinimum, float binScale) {
+    return std::min((int)((centroid - centroidMinimum) * binScale), TREE_BIN_COUNT - 1);
+}
+
+inline glm::vec4 loadPlane(const float* planes, size_t stride, int plane, uint32_t t) {
+    return glm::vec4(planes[(plane + 0) * stride + t], planes[(plane + 1) * stride + t],
+        planes[(plane + 2) * stride + t], planes[(plane + 3) * stride + t]);
+}
+
+inline bool isInsidePlane(const glm::vec4& plane, const glm::vec3& point) {
+    return glm::dot(glm::vec3(plane), point) > plane.w;
+}
+
+}
+
+// same test as findRayTriangleIntersection(), rewritten against the precomputed planes
+static void intersectTriangles_ref(const float* planes, size_t stride, uint32_t first, uint32_t end,
+                                   const TreeRay& ray, float& bestDistance, uint32_t& bestTriangle) {
+    glm::vec3 origin(ray.origin[0], ray.origin[1], ray.origin[2]);
+    glm::vec3 direction(ray.direction[0], ray.direction[1], ray.direction[2]);
+
+    for (uint32_t t = first; t < end; t++) {
+        glm::vec4 normal = loadPlane(planes, stride, TREE_PLANE_NORMAL, t);
+        float dividend = normal.w - glm::dot(glm::vec3(normal), origin);
+        if (dividend > 0.0f) {
+            continue; // origin below plane
+        }
+        float divisor = glm::dot(glm::vec3(normal), direction);
+        if (divisor >= 0.0f) {
+            continue;
+        }
+        float distance = dividend / divisor;
+        if (distance >= bestDistance) {
+            continue;
+        }
+        glm::vec3 point = origin + direction * distance;
+        if (isInsidePlane(loadPlane(planes, stride, TREE_PLANE_EDGE0, t), point) &&
+                isInsidePlane(loadPlane(planes, stride, TREE_PLANE_EDGE1, t), point) &&
+                isInsidePlane(loadPlane(planes, stride, TREE_PLANE_EDGE2, t), point)) {
+            bestDistance = distance;
+            bestTriangle = t;
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>  // on x86 architecture, assume that SSE2 is present
+
+static bool rayHitsBox_SSE2(const float* minimum, const float* maximum, const TreeRay& ray, float bestDistance) {
+    // the fourth lane of a node holds its offset and count, mask it out rather than compute on denormals
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    __m128 origin = _mm_loadu_ps(ray.origin);
+    __m128 inverse = _mm_loadu_ps(ray.inverse);
+    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_and_ps(_mm_loadu_ps(minimum), xyzMask), origin), inverse);
+    __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_and_ps(_mm_loadu_ps(maximum), xyzMask), origin), inverse);
+    __m128 slabEntry = _mm_min_ps(t1, t2);
+    __m128 slabExit = _mm_max_ps(t1, t2);
+
+    __m128 entry = _mm_max_ss(slabEntry, _mm_shuffle_ps(slabEntry, slabEntry, _MM_SHUFFLE(1, 1, 1, 1)));
+    entry = _mm_max_ss(entry, _mm_shuffle_ps(slabEntry, slabEntry, _MM_SHUFFLE(2, 2, 2, 2)));
+    entry = _mm_max_ss(entry, _mm_setzero_ps());
+    __m128 exit = _mm_min_ss(slabExit, _mm_shuffle_ps(slabExit, slabExit, _MM_SHUFFLE(1, 1, 1, 1)));
+    exit = _mm_min_ss(exit, _mm_shuffle_ps(slabExit, slabExit, _MM_SHUFFLE(2, 2, 2, 2)));
+    exit = _mm_min_ss(exit, _mm_set_ss(bestDistance));
+    return _mm_comile_ss(entry, exit) != 0;
+}
+
+static inline __m128 dot_SSE2(__m128 x, __m128 y, __m128 z, const float* planes, size_t stride, int plane, uint32_t t) {
+    __m128 result = _mm_mul_ps(x, _mm_loadu_ps(planes + (plane + 0) * stride + t));
+    result = _mm_add_ps(result, _mm_mul_ps(y, _mm_loadu_ps(planes + (plane + 1) * stride + t)));
+    return _mm_add_ps(result, _mm_mul_ps(z, _mm_loadu_ps(planes + (plane + 2) * stride + t)));
+}
+
+static uint32_t intersectTriangles_SSE2(const float* planes, size_t stride, uint32_t first, uint32_t end,
+                                        const TreeRay& ray, float& bestDistance, uint32_t& bestTriangle) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 originX = _mm_set1_ps(ray.origin[0]);
+    const __m128 originY = _mm_set1_ps(ray.origin[1]);
+    const __m128 originZ = _mm_set1_ps(ray.origin[2]);
+    const __m128 directionX = _mm_set1_ps(ray.direction[0]);
+    const __m128 directionY = _mm_set1_ps(ray.direction[1]);
+    const __m128 directionZ = _mm_set1_ps(ray.direction[2]);
+
+    uint32_t t = first;
+    for (; t + 4 <= end; t += 4) {
+        __m128 planeDistance = _mm_loadu_ps(planes + (TREE_PLANE_NORMAL + 3) * stride + t);
+        __m128 dividend = _mm_sub_ps(planeDistance, dot_SSE2(originX, originY, originZ, planes, stride, TREE_PLANE_NORMAL, t));
+        __m128 divisor = dot_SSE2(directionX, directionY, directionZ, planes, stride, TREE_PLANE_NORMAL, t);
+        __m128 distance = _mm_div_ps(dividend, divisor);
+
+        // origin above the plane, ray facing it and nearer than the best hit so far
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(dividend, zero), _mm_cmplt_ps(divisor, zero));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(distance, _mm_set1_ps(bestDistance)));
+
+        __m128 pointX = _mm_add_ps(originX, _mm_mul_ps(directionX, distance));
+        __m128 pointY = _mm_add_ps(originY, _mm_mul_ps(directionY, distance));
+        __m128 pointZ = _mm_add_ps(originZ, _mm_mul_ps(directionZ, distance));
+        for (int edge = TREE_PLANE_EDGE0; edge <= TREE_PLANE_EDGE2; edge += 4) {
+            __m128 edgeDistance = _mm_loadu_ps(planes + (edge + 3) * stride + t);
+            hit = _mm_and_ps(hit, _mm_cmpgt_ps(dot_SSE2(pointX, pointY, pointZ, planes, stride, edge, t), edgeDistance));
+        }
+
+        int mask = _mm_movemask_ps(hit);
+        if (mask) {
+            float distances[4];
+            _mm_storeu_ps(distances, distance);
+            for (int lane = 0; lane < 4; lane++) {
+                if ((mask & (1 << lane)) && distances[lane] < bestDistance) {
+                    bestDistance = distances[lane];
+                    bestTriangle = t + lane;
+                }
+            }
+        }
+    }
+    return t;
+}
+
+static inline bool rayHitsBox(const float* minimum, const float* maximum, const TreeRay& ray, float bestDistance) {
+    return rayHitsBox_SSE2(minimum, maximum, ray, bestDistance);
+}
+
+static inline void intersectTriangles(const float* planes, size_t stride, uint32_t first, uint32_t count,
+                                      const TreeRay& ray, float& bestDistance, uint32_t& bestTriangle) {
+    uint32_t end = first + count;
+    uint32_t tail = intersectTriangles_SSE2(planes, stride, first, end, ray, bestDistance, bestTriangle);
+    intersectTriangles_ref(planes, stride, tail, end, ray, bestDistance, bestTriangle);
+}
+
+#else   // portable reference code
+
+static bool rayHitsBox(const float* minimum, const float* maximum, const TreeRay& ray, float bestDistance) {
+    float entry = 0.0f;
+    float exit = bestDistance;
+    for (int i = 0; i < 3; i++) {
+        float t1 = (minimum[i] - ray.origin[i]) * ray.inverse[i];
+        float t2 = (maximum[i] - ray.origin[i]) * ray.inverse[i];
+        entry = std::max(entry, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+    }
+    return entry <= exit;
+}
+
+static inline void intersectTriangles(const float* planes, size_t stride, uint32_t first, uint32_t count,
+                                      const TreeRay& ray, float& bestDistance, uint32_t& bestTriangle) {
+    intersectTriangles_ref(planes, stride, first, first + count, ray, bestDistance, bestTriangle);
+}
+
+#endif
+
 void TriangleSet::insert(const Triangle& t) {
     _triangles.push_back(t);
+    _treeNodes.clear();
 
     _bounds += t.v0;
     _bounds += t.v1;
@@ -23,6 +206,261 @@ void TriangleSet::insert(const Triangle& t) {
 void TriangleSet::clear() {
     _triangles.clear();
     _bounds.clear();
+
+    _treeNodes.clear();
+    _treeIndices.clear();
+    _treePlanes.clear();
+    _treeStride = 0;
+}
+
+void TriangleSet::buildTree() {
+    _treeNodes.clear();
+    _treeIndices.clear();
+
+    uint32_t numTriangles = (uint32_t)_triangles.size();
+    if (numTriangles == 0) {
+        return;
+    }
+
+    std::vector<glm::vec3> minimums(numTriangles);
+    std::vector<glm::vec3> maximums(numTriangles);
+    std::vector<glm::vec3> centroids(numTriangles);
+    _treeIndices.resize(numTriangles);
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        const Triangle& triangle = _triangles[t];
+        minimums[t] = glm::min(glm::min(triangle.v0, triangle.v1), triangle.v2);
+        maximums[t] = glm::max(glm::max(triangle.v0, triangle.v1), triangle.v2);
+        centroids[t] = 0.5f * (minimums[t] + maximums[t]);
+        _treeIndices[t] = t;
+    }
+
+    _treeNodes.reserve(2 * numTriangles / MAX_LEAF_TRIANGLES + 1);
+    buildTreeNode(minimums, maximums, centroids, 0, numTriangles, 0);
+    updateTreePlanes();
+}
+
+// Splits the triangles [first, first + count) of _treeIndices where the binned surface area heuristic says a ray
+// is cheapest to trace, and returns the index of the new node.
+uint32_t TriangleSet::buildTreeNode(const std::vector<glm::vec3>& minimums, const std::vector<glm::vec3>& maximums,
+        const std::vector<glm::vec3>& centroids, uint32_t first, uint32_t count, int depth) {
+    uint32_t nodeIndex = (uint32_t)_treeNodes.size();
+    _treeNodes.emplace_back();
+
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    glm::vec3 centroidMinimum(FLT_MAX);
+    glm::vec3 centroidMaximum(-FLT_MAX);
+    for (uint32_t i = first; i < first + count; i++) {
+        uint32_t t = _treeIndices[i];
+        minimum = glm::min(minimum, minimums[t]);
+        maximum = glm::max(maximum, maximums[t]);
+        centroidMinimum = glm::min(centroidMinimum, centroids[t]);
+        centroidMaximum = glm::max(centroidMaximum, centroids[t]);
+    }
+    _treeNodes[nodeIndex].minimum = minimum;
+    _treeNodes[nodeIndex].maximum = maximum;
+
+    int bestAxis = -1;
+    int bestBin = 0;
+    float bestCost = FLT_MAX;
+    if (count > 1 && depth < MAX_TREE_DEPTH) {
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = centroidMaximum[axis] - centroidMinimum[axis];
+            if (extent <= 0.0f) {
+                continue;
+            }
+            float binScale = (float)TREE_BIN_COUNT / extent;
+
+            uint32_t binCounts[TREE_BIN_COUNT] = { 0 };
+            glm::vec3 binMinimums[TREE_BIN_COUNT];
+            glm::vec3 binMaximums[TREE_BIN_COUNT];
+            std::fill_n(binMinimums, TREE_BIN_COUNT, glm::vec3(FLT_MAX));
+            std::fill_n(binMaximums, TREE_BIN_COUNT, glm::vec3(-FLT_MAX));
+            for (uint32_t i = first; i < first + count; i++) {
+                uint32_t t = _treeIndices[i];
+                int bin = binIndex(centroids[t][axis], centroidMinimum[axis], binScale);
+                binCounts[bin]++;
+                binMinimums[bin] = glm::min(binMinimums[bin], minimums[t]);
+                binMaximums[bin] = glm::max(binMaximums[bin], maximums[t]);
+            }
+
+            // rightAreas[b] and rightCounts[b] cover the bins from b up
+            float rightAreas[TREE_BIN_COUNT];
+            uint32_t rightCounts[TREE_BIN_COUNT];
+            glm::vec3 rightMinimum(FLT_MAX);
+            glm::vec3 rightMaximum(-FLT_MAX);
+            uint32_t rightCount = 0;
+            for (int bin = TREE_BIN_COUNT - 1; bin > 0; bin--) {
+                rightMinimum = glm::min(rightMinimum, binMinimums[bin]);
+                rightMaximum = glm::max(rightMaximum, binMaximums[bin]);
+                rightCount += binCounts[bin];
+                rightAreas[bin] = rightCount > 0 ? surfaceArea(rightMinimum, rightMaximum) : 0.0f;
+                rightCounts[bin] = rightCount;
+            }
+
+            glm::vec3 leftMinimum(FLT_MAX);
+            glm::vec3 leftMaximum(-FLT_MAX);
+            uint32_t leftCount = 0;
+            for (int bin = 1; bin < TREE_BIN_COUNT; bin++) {
+                leftMinimum = glm::min(leftMinimum, binMinimums[bin - 1]);
+                leftMaximum = glm::max(leftMaximum, binMaximums[bin - 1]);
+                leftCount += binCounts[bin - 1];
+                if (leftCount == 0 || rightCounts[bin] == 0) {
+                    continue;
+                }
+                float cost = surfaceArea(leftMinimum, leftMaximum) * leftCount + rightAreas[bin] * rightCounts[bin];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+    }
+
+    float splitCost = FLT_MAX;
+    if (bestAxis >= 0) {
+        splitCost = TREE_TRAVERSAL_COST + bestCost / std::max(surfaceArea(minimum, maximum), FLT_MIN);
+    }
+    bool fitsInLeaf = count <= UINT16_MAX;
+    if (fitsInLeaf && (count == 1 || depth >= MAX_TREE_DEPTH ||
+            (count <= MAX_LEAF_TRIANGLES && (float)count <= splitCost))) {
+        _treeNodes[nodeIndex].offset = first;
+        _treeNodes[nodeIndex].count = (uint16_t)count;
+        _treeNodes[nodeIndex].axis = 0;
+        return nodeIndex;
+    }
+
+    uint32_t middle = first + count / 2;
+    int axis = 0;
+    if (bestAxis >= 0) {
+        axis = bestAxis;
+        float binScale = (float)TREE_BIN_COUNT / (centroidMaximum[axis] - centroidMinimum[axis]);
+        auto begin = _treeIndices.begin() + first;
+        auto split = std::partition(begin, begin + count, [&](uint32_t t) {
+            return binIndex(centroids[t][axis], centroidMinimum[axis], binScale) < bestBin;
+        });
+        middle = first + (uint32_t)(split - begin);
+    }
+    if (middle == first || middle == first + count) {
+        // every centroid landed on the same side, any split is as good as another
+        middle = first + count / 2;
+    }
+
+    _treeNodes[nodeIndex].count = 0;
+    _treeNodes[nodeIndex].axis = (uint16_t)axis;
+    buildTreeNode(minimums, maximums, centroids, first, middle - first, depth + 1);
+    uint32_t farChild = buildTreeNode(minimums, maximums, centroids, middle, first + count - middle, depth + 1);
+    _treeNodes[nodeIndex].offset = farChild;
+    return nodeIndex;
+}
+
+void TriangleSet::updateTreePlanes() {
+    size_t numTriangles = _treeIndices.size();
+    _treeStride = numTriangles;
+    _treePlanes.assign(NUM_TREE_PLANE_COMPONENTS * _treeStride, 0.0f);
+
+    auto setPlane = [&](int plane, size_t t, const glm::vec3& normal, const glm::vec3& point) {
+        _treePlanes[(plane + 0) * _treeStride + t] = normal.x;
+        _treePlanes[(plane + 1) * _treeStride + t] = normal.y;
+        _treePlanes[(plane + 2) * _treeStride + t] = normal.z;
+        _treePlanes[(plane + 3) * _treeStride + t] = glm::dot(normal, point);
+    };
+
+    for (size_t t = 0; t < numTriangles; t++) {
+        const Triangle& triangle = _triangles[_treeIndices[t]];
+        glm::vec3 firstSide = triangle.v0 - triangle.v1;
+        glm::vec3 secondSide = triangle.v2 - triangle.v1;
+        glm::vec3 normal = glm::cross(secondSide, firstSide);
+        setPlane(TREE_PLANE_NORMAL, t, normal, triangle.v1);
+        setPlane(TREE_PLANE_EDGE0, t, glm::cross(firstSide, normal), triangle.v1);
+        setPlane(TREE_PLANE_EDGE1, t, glm::cross(normal, secondSide), triangle.v1);
+        setPlane(TREE_PLANE_EDGE2, t, glm::cross(triangle.v2 - triangle.v0, normal), triangle.v0);
+    }
+}
+
+void TriangleSet::refitTree() {
+    _bounds.clear();
+    for (const auto& triangle : _triangles) {
+        _bounds += triangle.v0;
+        _bounds += triangle.v1;
+        _bounds += triangle.v2;
+    }
+
+    if (_treeNodes.empty()) {
+        return;
+    }
+    updateTreePlanes();
+
+    // children always come after their parent, so walking backwards refits them first
+    for (size_t n = _treeNodes.size(); n-- > 0;) {
+        TreeNode& node = _treeNodes[n];
+        if (node.count > 0) {
+            node.minimum = glm::vec3(FLT_MAX);
+            node.maximum = glm::vec3(-FLT_MAX);
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& triangle = _triangles[_treeIndices[i]];
+                node.minimum = glm::min(node.minimum, glm::min(glm::min(triangle.v0, triangle.v1), triangle.v2));
+                node.maximum = glm::max(node.maximum, glm::max(glm::max(triangle.v0, triangle.v1), triangle.v2));
+            }
+        } else {
+            const TreeNode& nearChild = _treeNodes[n + 1];
+            const TreeNode& farChild = _treeNodes[node.offset];
+            node.minimum = glm::min(nearChild.minimum, farChild.minimum);
+            node.maximum = glm::max(nearChild.maximum, farChild.maximum);
+        }
+    }
+}
+
+bool TriangleSet::findRayIntersectionInTree(const glm::vec3& origin, const glm::vec3& direction,
+                                            float& distance, glm::vec3& surfaceNormal) const {
+    TreeRay ray;
+    for (int i = 0; i < 3; i++) {
+        float component = direction[i];
+        if (fabsf(component) < MIN_RAY_DIRECTION) {
+            component = (component < 0.0f) ? -MIN_RAY_DIRECTION : MIN_RAY_DIRECTION;
+        }
+        ray.origin[i] = origin[i];
+        ray.direction[i] = direction[i];
+        ray.inverse[i] = 1.0f / component;
+    }
+    ray.origin[3] = ray.direction[3] = ray.inverse[3] = 0.0f;
+
+    float bestDistance = FLT_MAX;
+    uint32_t bestTriangle = UINT32_MAX;
+
+    // visit the near child first so the far one is usually culled by the best hit so far
+    uint32_t stack[TREE_STACK_SIZE];
+    int stackSize = 0;
+    uint32_t nodeIndex = 0;
+    while (true) {
+        const TreeNode& node = _treeNodes[nodeIndex];
+        if (rayHitsBox(&node.minimum.x, &node.maximum.x, ray, bestDistance)) {
+            if (node.count > 0) {
+                intersectTriangles(_treePlanes.data(), _treeStride, node.offset, node.count, ray, bestDistance, bestTriangle);
+            } else {
+                uint32_t nearChild = nodeIndex + 1;
+                uint32_t farChild = node.offset;
+                if (direction[node.axis] < 0.0f) {
+                    std::swap(nearChild, farChild);
+                }
+                stack[stackSize++] = farChild;
+                nodeIndex = nearChild;
+                continue;
+            }
+        }
+        if (stackSize == 0) {
+            break;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+
+    if (bestTriangle == UINT32_MAX) {
+        return false;
+    }
+    distance = bestDistance;
+    surfaceNormal = _triangles[_treeIndices[bestTriangle]].getNormal();
+    return true;
 }
 
 // Determine of the given ray (origin/direction) in model space intersects with any triangles
@@ -35,7 +473,9 @@ bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3&
     float bestDistance = std::numeric_limits<float>::max();
 
     if (_bounds.findRayIntersection(origin, direction, boxDistance, face, surfaceNormal)) {
-        if (precision) {
+        if (precision && isTreeBuilt()) {
+            intersectedSomething = findRayIntersectionInTree(origin, direction, distance, surfaceNormal);
+        } else if (precision) {
             for (const auto& triangle : _triangles) {
                 float thisTriangleDistance;
                 if (findRayTriangleIntersection(origin, direction, triangle, thisTriangleDistance)) {
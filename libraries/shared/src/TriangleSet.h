@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <stdint.h>
 #include <vector>
 
 #include "AABox.h"
@@ -24,6 +25,16 @@ public:
     void insert(const Triangle& t);
     void clear();
 
+    // Build the bounding volume hierarchy used by precision ray picks. Inserting or clearing triangles drops the tree,
+    // and picks fall back to testing every triangle until it is built again.
+    void buildTree();
+    bool isTreeBuilt() const { return !_treeNodes.empty(); }
+
+    // Move a triangle in place (e.g. for a new skinned pose) and call refitTree() once all of them are updated; the
+    // tree keeps its topology and only its bounds are recomputed, which is much cheaper than a rebuild.
+    void updateTriangle(size_t t, const Triangle& triangle) { _triangles[t] = triangle; }
+    void refitTree();
+
     // Determine if the given ray (origin/direction) in model space intersects with any triangles in the set. If an 
     // intersection occurs, the distance and surface normal will be provided.
     bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, 
@@ -36,6 +47,27 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 private:
+    // nodes are stored depth first, so the near child of an interior node is always the next one
+    struct TreeNode {
+        glm::vec3 minimum;
+        uint32_t offset; // first entry of _treeIndices for a leaf, index of the far child for an interior node
+        glm::vec3 maximum;
+        uint16_t count; // number of triangles in a leaf, 0 for an interior node
+        uint16_t axis; // split axis of an interior node
+    };
+    static_assert(sizeof(TreeNode) == 32, "TreeNode bounds are loaded 4 floats at a time");
+
+    uint32_t buildTreeNode(const std::vector<glm::vec3>& minimums, const std::vector<glm::vec3>& maximums,
+        const std::vector<glm::vec3>& centroids, uint32_t first, uint32_t count, int depth);
+    void updateTreePlanes();
+    bool findRayIntersectionInTree(const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, glm::vec3& surfaceNormal) const;
+
     std::vector<Triangle> _triangles;
     AABox _bounds;
+
+    std::vector<TreeNode> _treeNodes;
+    std::vector<uint32_t> _treeIndices; // triangles in the order the leaves reference them
+    std::vector<float> _treePlanes; // per triangle edge and face planes in _treeIndices order, one array per component
+    size_t _treeStride { 0 };
 };
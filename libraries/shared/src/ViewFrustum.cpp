@@ -10,6 +10,7 @@
 //
 
 #include <algorithm>
+#include <string.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -324,6 +325,337 @@ bool ViewFrustum::boxIntersectsKeyhole(const AABox& box) const {
     return true;
 }
 
+void ViewFrustum::Boxes::clear() {
+    cornerX.clear();
+    cornerY.clear();
+    cornerZ.clear();
+    scaleX.clear();
+    scaleY.clear();
+    scaleZ.clear();
+}
+
+void ViewFrustum::Boxes::reserve(size_t size) {
+    cornerX.reserve(size);
+    cornerY.reserve(size);
+    cornerZ.reserve(size);
+    scaleX.reserve(size);
+    scaleY.reserve(size);
+    scaleZ.reserve(size);
+}
+
+void ViewFrustum::Boxes::push_back(const AABox& box) {
+    const glm::vec3& corner = box.getCorner();
+    const glm::vec3& scale = box.getScale();
+    cornerX.push_back(corner.x);
+    cornerY.push_back(corner.y);
+    cornerZ.push_back(corner.z);
+    scaleX.push_back(scale.x);
+    scaleY.push_back(scale.y);
+    scaleZ.push_back(scale.z);
+}
+
+void ViewFrustum::Boxes::push_back(const AACube& cube) {
+    const glm::vec3& corner = cube.getCorner();
+    float scale = cube.getScale();
+    cornerX.push_back(corner.x);
+    cornerY.push_back(corner.y);
+    cornerZ.push_back(corner.z);
+    scaleX.push_back(scale);
+    scaleY.push_back(scale);
+    scaleZ.push_back(scale);
+}
+
+void ViewFrustum::Spheres::clear() {
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    radius.clear();
+}
+
+void ViewFrustum::Spheres::reserve(size_t size) {
+    centerX.reserve(size);
+    centerY.reserve(size);
+    centerZ.reserve(size);
+    radius.reserve(size);
+}
+
+void ViewFrustum::Spheres::push_back(const glm::vec3& center, float sphereRadius) {
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    radius.push_back(sphereRadius);
+}
+
+//
+// Batch test kernels, on the planes and on the keyhole sphere as { x, y, z, w }, a keyhole radius < 0 testing the
+// frustum alone. The vectorized kernels test the first multiple of their width of the boxes, and return how many
+// they tested, the remaining ones being tested by the reference kernels.
+//
+static int boxesInView_ref(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                           int begin, int end, uint32_t* inView) {
+    for (int i = begin; i < end; i++) {
+        const float corner[3] = { box[0][i], box[1][i], box[2][i] };
+        const float scale[3] = { box[3][i], box[4][i], box[5][i] };
+
+        // as AABox::touchesSphere
+        bool isIn = false;
+        if (keyhole[3] >= 0.0f) {
+            float length2 = 0.0f;
+            for (int j = 0; j < 3; j++) {
+                float e = std::max(corner[j] - keyhole[j], 0.0f) + std::max(keyhole[j] - corner[j] - scale[j], 0.0f);
+                length2 += e * e;
+            }
+            isIn = length2 <= keyhole[3] * keyhole[3];
+        }
+
+        // as boxIntersectsFrustum
+        if (!isIn) {
+            isIn = true;
+            for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+                float distance = planes[p][3];
+                for (int j = 0; j < 3; j++) {
+                    distance += planes[p][j] * ((planes[p][j] > 0.0f) ? corner[j] + scale[j] : corner[j]);
+                }
+                if (distance < 0.0f) {
+                    isIn = false;
+                    break;
+                }
+            }
+        }
+
+        if (isIn) {
+            inView[i >> 5] |= 1U << (i & 31);
+        }
+    }
+    return end;
+}
+
+static int spheresInView_ref(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                             int begin, int end, uint32_t* inView) {
+    for (int i = begin; i < end; i++) {
+        const float center[3] = { sphere[0][i], sphere[1][i], sphere[2][i] };
+        const float radius = sphere[3][i];
+
+        // as sphereIntersectsKeyhole
+        bool isIn = false;
+        if (keyhole[3] >= 0.0f) {
+            float length2 = 0.0f;
+            for (int j = 0; j < 3; j++) {
+                float d = center[j] - keyhole[j];
+                length2 += d * d;
+            }
+            isIn = sqrtf(length2) <= radius + keyhole[3];
+        }
+
+        // as sphereIntersectsFrustum
+        if (!isIn) {
+            isIn = true;
+            for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+                float distance = planes[p][3] + planes[p][0] * center[0] + planes[p][1] * center[1] + planes[p][2] * center[2];
+                if (distance < -radius) {
+                    isIn = false;
+                    break;
+                }
+            }
+        }
+
+        if (isIn) {
+            inView[i >> 5] |= 1U << (i & 31);
+        }
+    }
+    return end;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>  // on x86 architecture, assume that SSE2 is present
+
+static int boxesInView_SSE2(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                            int numBoxes, uint32_t* inView) {
+    const __m128 zero = _mm_setzero_ps();
+    const bool testKeyhole = keyhole[3] >= 0.0f;
+    const __m128 keyholeX = _mm_set1_ps(keyhole[0]);
+    const __m128 keyholeY = _mm_set1_ps(keyhole[1]);
+    const __m128 keyholeZ = _mm_set1_ps(keyhole[2]);
+    const __m128 keyholeRadius2 = _mm_set1_ps(keyhole[3] * keyhole[3]);
+
+    int i = 0;
+    for (; i + 4 <= numBoxes; i += 4) {
+        __m128 minX = _mm_loadu_ps(box[0] + i);
+        __m128 minY = _mm_loadu_ps(box[1] + i);
+        __m128 minZ = _mm_loadu_ps(box[2] + i);
+        __m128 scaleX = _mm_loadu_ps(box[3] + i);
+        __m128 scaleY = _mm_loadu_ps(box[4] + i);
+        __m128 scaleZ = _mm_loadu_ps(box[5] + i);
+        __m128 maxX = _mm_add_ps(minX, scaleX);
+        __m128 maxY = _mm_add_ps(minY, scaleY);
+        __m128 maxZ = _mm_add_ps(minZ, scaleZ);
+
+        // a box is out as soon as its farthest vertex along the normal of a plane is behind it
+        __m128 outside = zero;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(planes[p][0]), (planes[p][0] > 0.0f) ? maxX : minX);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p][1]), (planes[p][1] > 0.0f) ? maxY : minY));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p][2]), (planes[p][2] > 0.0f) ? maxZ : minZ));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes[p][3]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+        int mask = ~_mm_movemask_ps(outside) & 0xf;
+
+        if (testKeyhole) {
+            __m128 ex = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minX, keyholeX), zero), _mm_max_ps(_mm_sub_ps(keyholeX, maxX), zero));
+            __m128 ey = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minY, keyholeY), zero), _mm_max_ps(_mm_sub_ps(keyholeY, maxY), zero));
+            __m128 ez = _mm_add_ps(_mm_max_ps(_mm_sub_ps(minZ, keyholeZ), zero), _mm_max_ps(_mm_sub_ps(keyholeZ, maxZ), zero));
+            __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), _mm_mul_ps(ez, ez));
+            mask |= _mm_movemask_ps(_mm_cmple_ps(length2, keyholeRadius2));
+        }
+
+        inView[i >> 5] |= (uint32_t)mask << (i & 31);
+    }
+    return i;
+}
+
+static int spheresInView_SSE2(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                              int numSpheres, uint32_t* inView) {
+    const __m128 zero = _mm_setzero_ps();
+    const bool testKeyhole = keyhole[3] >= 0.0f;
+    const __m128 keyholeX = _mm_set1_ps(keyhole[0]);
+    const __m128 keyholeY = _mm_set1_ps(keyhole[1]);
+    const __m128 keyholeZ = _mm_set1_ps(keyhole[2]);
+    const __m128 keyholeRadius = _mm_set1_ps(keyhole[3]);
+
+    int i = 0;
+    for (; i + 4 <= numSpheres; i += 4) {
+        __m128 centerX = _mm_loadu_ps(sphere[0] + i);
+        __m128 centerY = _mm_loadu_ps(sphere[1] + i);
+        __m128 centerZ = _mm_loadu_ps(sphere[2] + i);
+        __m128 radius = _mm_loadu_ps(sphere[3] + i);
+        __m128 minusRadius = _mm_sub_ps(zero, radius);
+
+        __m128 outside = zero;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(planes[p][0]), centerX);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p][1]), centerY));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p][2]), centerZ));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes[p][3]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, minusRadius));
+        }
+        int mask = ~_mm_movemask_ps(outside) & 0xf;
+
+        if (testKeyhole) {
+            __m128 dx = _mm_sub_ps(centerX, keyholeX);
+            __m128 dy = _mm_sub_ps(centerY, keyholeY);
+            __m128 dz = _mm_sub_ps(centerZ, keyholeZ);
+            __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 touchRadius = _mm_add_ps(radius, keyholeRadius);
+            mask |= _mm_movemask_ps(_mm_cmple_ps(length2, _mm_mul_ps(touchRadius, touchRadius)));
+        }
+
+        inView[i >> 5] |= (uint32_t)mask << (i & 31);
+    }
+    return i;
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+int boxesInView_AVX2(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                     int numBoxes, uint32_t* inView);
+int spheresInView_AVX2(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                       int numSpheres, uint32_t* inView);
+
+static void boxesInView(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                        int numBoxes, uint32_t* inView) {
+    static auto f = cpuSupportsAVX2() ? boxesInView_AVX2 : boxesInView_SSE2;
+    int numTested = (*f)(planes, keyhole, box, numBoxes, inView);  // dispatch
+    boxesInView_ref(planes, keyhole, box, numTested, numBoxes, inView);
+}
+
+static void spheresInView(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                          int numSpheres, uint32_t* inView) {
+    static auto f = cpuSupportsAVX2() ? spheresInView_AVX2 : spheresInView_SSE2;
+    int numTested = (*f)(planes, keyhole, sphere, numSpheres, inView);  // dispatch
+    spheresInView_ref(planes, keyhole, sphere, numTested, numSpheres, inView);
+}
+
+#else   // portable reference code
+
+static void boxesInView(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                        int numBoxes, uint32_t* inView) {
+    boxesInView_ref(planes, keyhole, box, 0, numBoxes, inView);
+}
+
+static void spheresInView(const float planes[NUM_FRUSTUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                          int numSpheres, uint32_t* inView) {
+    spheresInView_ref(planes, keyhole, sphere, 0, numSpheres, inView);
+}
+
+#endif
+
+void ViewFrustum::testBoxes(const Boxes& boxes, float keyholeRadius, uint32_t* inView) const {
+    int numBoxes = boxes.size();
+    memset(inView, 0, getNumInViewWords(numBoxes) * sizeof(uint32_t));
+    if (numBoxes == 0) {
+        return;
+    }
+
+    float planes[NUM_FRUSTUM_PLANES][4];
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        const glm::vec3& normal = _planes[p].getNormal();
+        planes[p][0] = normal.x;
+        planes[p][1] = normal.y;
+        planes[p][2] = normal.z;
+        planes[p][3] = _planes[p].getDCoefficient();
+    }
+    const float keyhole[4] = { _position.x, _position.y, _position.z, keyholeRadius };
+    const float* const box[6] = {
+        boxes.cornerX.data(), boxes.cornerY.data(), boxes.cornerZ.data(),
+        boxes.scaleX.data(), boxes.scaleY.data(), boxes.scaleZ.data()
+    };
+    boxesInView(planes, keyhole, box, numBoxes, inView);
+}
+
+void ViewFrustum::testSpheres(const Spheres& spheres, float keyholeRadius, uint32_t* inView) const {
+    int numSpheres = spheres.size();
+    memset(inView, 0, getNumInViewWords(numSpheres) * sizeof(uint32_t));
+    if (numSpheres == 0) {
+        return;
+    }
+
+    float planes[NUM_FRUSTUM_PLANES][4];
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        const glm::vec3& normal = _planes[p].getNormal();
+        planes[p][0] = normal.x;
+        planes[p][1] = normal.y;
+        planes[p][2] = normal.z;
+        planes[p][3] = _planes[p].getDCoefficient();
+    }
+    const float keyhole[4] = { _position.x, _position.y, _position.z, keyholeRadius };
+    const float* const sphere[4] = {
+        spheres.centerX.data(), spheres.centerY.data(), spheres.centerZ.data(), spheres.radius.data()
+    };
+    spheresInView(planes, keyhole, sphere, numSpheres, inView);
+}
+
+void ViewFrustum::boxesIntersectFrustum(const Boxes& boxes, uint32_t* inView) const {
+    testBoxes(boxes, -1.0f, inView);
+}
+
+void ViewFrustum::boxesIntersectKeyhole(const Boxes& boxes, uint32_t* inView) const {
+    testBoxes(boxes, _centerSphereRadius, inView);
+}
+
+void ViewFrustum::spheresIntersectFrustum(const Spheres& spheres, uint32_t* inView) const {
+    testSpheres(spheres, -1.0f, inView);
+}
+
+void ViewFrustum::spheresIntersectKeyhole(const Spheres& spheres, uint32_t* inView) const {
+    testSpheres(spheres, _centerSphereRadius, inView);
+}
+
 bool testMatches(glm::quat lhs, glm::quat rhs, float epsilon = EPSILON) {
     return (fabs(lhs.x - rhs.x) <= epsilon && fabs(lhs.y - rhs.y) <= epsilon && fabs(lhs.z - rhs.z) <= epsilon
             && fabs(lhs.w - rhs.w) <= epsilon);
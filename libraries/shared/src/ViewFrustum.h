@@ -14,6 +14,9 @@
 #ifndef hifi_ViewFrustum_h
 #define hifi_ViewFrustum_h
 
+#include <stdint.h>
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -107,6 +110,39 @@ public:
     bool cubeIntersectsKeyhole(const AACube& cube) const;
     bool boxIntersectsKeyhole(const AABox& box) const;
 
+    // Boxes and spheres laid out as arrays of their components, for the batch tests
+    class Boxes {
+    public:
+        void clear();
+        void reserve(size_t size);
+        void push_back(const AABox& box);
+        void push_back(const AACube& cube);
+        int size() const { return (int)cornerX.size(); }
+
+        std::vector<float> cornerX, cornerY, cornerZ;
+        std::vector<float> scaleX, scaleY, scaleZ;
+    };
+    class Spheres {
+    public:
+        void clear();
+        void reserve(size_t size);
+        void push_back(const glm::vec3& center, float radius);
+        int size() const { return (int)radius.size(); }
+
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> radius;
+    };
+
+    // The batch tests set the bit (i % 32) of inView[i / 32] when the box or sphere i intersects, as the tests above,
+    // and clear it otherwise. inView MUST hold getNumInViewWords(size) words
+    static int getNumInViewWords(int size) { return (size + 31) / 32; }
+    static bool isInView(const uint32_t* inView, int i) { return (inView[i >> 5] & (1U << (i & 31))) != 0; }
+
+    void boxesIntersectFrustum(const Boxes& boxes, uint32_t* inView) const;
+    void boxesIntersectKeyhole(const Boxes& boxes, uint32_t* inView) const;
+    void spheresIntersectFrustum(const Spheres& spheres, uint32_t* inView) const;
+    void spheresIntersectKeyhole(const Spheres& spheres, uint32_t* inView) const;
+
     // some frustum comparisons
     bool matches(const ViewFrustum& compareTo, bool debug = false) const;
     bool matches(const ViewFrustum* compareTo, bool debug = false) const { return matches(*compareTo, debug); }
@@ -172,6 +208,10 @@ private:
 
     const char* debugPlaneName (int plane) const;
 
+    // a keyhole radius < 0 tests the frustum alone
+    void testBoxes(const Boxes& boxes, float keyholeRadius, uint32_t* inView) const;
+    void testSpheres(const Spheres& spheres, float keyholeRadius, uint32_t* inView) const;
+
     // Used to project points
     glm::mat4 _ourModelViewProjectionMatrix;
 };
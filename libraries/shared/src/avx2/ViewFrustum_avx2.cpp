@@ -0,0 +1,116 @@
+//
+//  ViewFrustum_avx2.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <stdint.h>
+#include <immintrin.h>  // AVX2
+
+#ifndef __AVX2__
+#error Must be compiled with /arch:AVX2 or -mavx2 -mfma.
+#endif
+
+static const int NUM_PLANES = 6;
+
+//
+// Batch view tests of 8 boxes or spheres at a time, AVX2 versions of the kernels of ViewFrustum.cpp
+//
+int boxesInView_AVX2(const float planes[NUM_PLANES][4], const float keyhole[4], const float* const box[6],
+                     int numBoxes, uint32_t* inView) {
+    const __m256 zero = _mm256_setzero_ps();
+    const bool testKeyhole = keyhole[3] >= 0.0f;
+    const __m256 keyholeX = _mm256_set1_ps(keyhole[0]);
+    const __m256 keyholeY = _mm256_set1_ps(keyhole[1]);
+    const __m256 keyholeZ = _mm256_set1_ps(keyhole[2]);
+    const __m256 keyholeRadius2 = _mm256_set1_ps(keyhole[3] * keyhole[3]);
+
+    int i = 0;
+    for (; i + 8 <= numBoxes; i += 8) {
+        __m256 minX = _mm256_loadu_ps(box[0] + i);
+        __m256 minY = _mm256_loadu_ps(box[1] + i);
+        __m256 minZ = _mm256_loadu_ps(box[2] + i);
+        __m256 maxX = _mm256_add_ps(minX, _mm256_loadu_ps(box[3] + i));
+        __m256 maxY = _mm256_add_ps(minY, _mm256_loadu_ps(box[4] + i));
+        __m256 maxZ = _mm256_add_ps(minZ, _mm256_loadu_ps(box[5] + i));
+
+        // a box is out as soon as its farthest vertex along the normal of a plane is behind it
+        __m256 outside = zero;
+        for (int p = 0; p < NUM_PLANES; p++) {
+            __m256 distance = _mm256_set1_ps(planes[p][3]);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][0]), (planes[p][0] > 0.0f) ? maxX : minX, distance);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][1]), (planes[p][1] > 0.0f) ? maxY : minY, distance);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][2]), (planes[p][2] > 0.0f) ? maxZ : minZ, distance);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+        int mask = ~_mm256_movemask_ps(outside) & 0xff;
+
+        if (testKeyhole) {
+            __m256 ex = _mm256_add_ps(_mm256_max_ps(_mm256_sub_ps(minX, keyholeX), zero),
+                                      _mm256_max_ps(_mm256_sub_ps(keyholeX, maxX), zero));
+            __m256 ey = _mm256_add_ps(_mm256_max_ps(_mm256_sub_ps(minY, keyholeY), zero),
+                                      _mm256_max_ps(_mm256_sub_ps(keyholeY, maxY), zero));
+            __m256 ez = _mm256_add_ps(_mm256_max_ps(_mm256_sub_ps(minZ, keyholeZ), zero),
+                                      _mm256_max_ps(_mm256_sub_ps(keyholeZ, maxZ), zero));
+            __m256 length2 = _mm256_fmadd_ps(ez, ez, _mm256_fmadd_ps(ey, ey, _mm256_mul_ps(ex, ex)));
+            mask |= _mm256_movemask_ps(_mm256_cmp_ps(length2, keyholeRadius2, _CMP_LE_OQ));
+        }
+
+        inView[i >> 5] |= (uint32_t)mask << (i & 31);
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+int spheresInView_AVX2(const float planes[NUM_PLANES][4], const float keyhole[4], const float* const sphere[4],
+                       int numSpheres, uint32_t* inView) {
+    const __m256 zero = _mm256_setzero_ps();
+    const bool testKeyhole = keyhole[3] >= 0.0f;
+    const __m256 keyholeX = _mm256_set1_ps(keyhole[0]);
+    const __m256 keyholeY = _mm256_set1_ps(keyhole[1]);
+    const __m256 keyholeZ = _mm256_set1_ps(keyhole[2]);
+    const __m256 keyholeRadius = _mm256_set1_ps(keyhole[3]);
+
+    int i = 0;
+    for (; i + 8 <= numSpheres; i += 8) {
+        __m256 centerX = _mm256_loadu_ps(sphere[0] + i);
+        __m256 centerY = _mm256_loadu_ps(sphere[1] + i);
+        __m256 centerZ = _mm256_loadu_ps(sphere[2] + i);
+        __m256 radius = _mm256_loadu_ps(sphere[3] + i);
+        __m256 minusRadius = _mm256_sub_ps(zero, radius);
+
+        __m256 outside = zero;
+        for (int p = 0; p < NUM_PLANES; p++) {
+            __m256 distance = _mm256_set1_ps(planes[p][3]);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][0]), centerX, distance);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][1]), centerY, distance);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][2]), centerZ, distance);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, minusRadius, _CMP_LT_OQ));
+        }
+        int mask = ~_mm256_movemask_ps(outside) & 0xff;
+
+        if (testKeyhole) {
+            __m256 dx = _mm256_sub_ps(centerX, keyholeX);
+            __m256 dy = _mm256_sub_ps(centerY, keyholeY);
+            __m256 dz = _mm256_sub_ps(centerZ, keyholeZ);
+            __m256 length2 = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+            __m256 touchRadius = _mm256_add_ps(radius, keyholeRadius);
+            mask |= _mm256_movemask_ps(_mm256_cmp_ps(length2, _mm256_mul_ps(touchRadius, touchRadius), _CMP_LE_OQ));
+        }
+
+        inView[i >> 5] |= (uint32_t)mask << (i & 31);
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -0,0 +1,104 @@
+//
+//  BoundedQueue.h
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_BoundedQueue_h
+#define hifi_BoundedQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// A lock-free queue of at most a fixed number of values, pushed and popped from any threads. The cells are allocated
+/// once, a push into a full queue fails rather than waiting or growing. Each cell holds a sequence number telling
+/// whether it is free for the push of its position or holds the value for the pop of that position.
+template <typename T>
+class BoundedQueue {
+public:
+    /// the capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        _mask = size - 1;
+        _cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    bool push(T value) {
+        size_t position = _pushPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // the cell still holds the value pushed a lap ago
+            } else {
+                position = _pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        size_t position = _popPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+            if (difference == 0) {
+                if (_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // nothing pushed in the cell yet
+            } else {
+                position = _popPosition.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(position + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+    // the pushing and the popping threads each keep to the cache line of their position
+    char _pushPadding[CACHE_LINE_SIZE];
+    std::atomic<size_t> _pushPosition { 0 };
+    char _popPadding[CACHE_LINE_SIZE];
+    std::atomic<size_t> _popPosition { 0 };
+};
+
+#endif // hifi_BoundedQueue_h
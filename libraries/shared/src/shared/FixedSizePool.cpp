@@ -0,0 +1,90 @@
+//
+//  FixedSizePool.cpp
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FixedSizePool.h"
+
+#include <algorithm>
+#include <cassert>
+
+static std::mutex& getPoolsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<FixedSizePool*>& getPools() {
+    static std::vector<FixedSizePool*> pools;
+    return pools;
+}
+
+// blocks are rounded up to this, so that every block of a chunk is aligned like the chunk itself
+static size_t alignBlockSize(size_t size) {
+    const size_t ALIGNMENT = alignof(std::max_align_t);
+    size = std::max(size, sizeof(void*));
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+FixedSizePool::FixedSizePool(const char* name, size_t blockSize, size_t blocksPerChunk) :
+    _name(name),
+    _blockSize(alignBlockSize(blockSize)),
+    _blocksPerChunk(blocksPerChunk)
+{
+    std::lock_guard<std::mutex> lock(getPoolsMutex());
+    getPools().push_back(this);
+}
+
+void* FixedSizePool::allocate() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_freeList) {
+        allocateChunk();
+    }
+    FreeBlock* block = _freeList;
+    _freeList = block->next;
+    _used++;
+    return block;
+}
+
+void FixedSizePool::deallocate(void* block) {
+    if (!block) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    assert(_used > 0);
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = _freeList;
+    _freeList = freeBlock;
+    _used--;
+}
+
+FixedSizePool::Stats FixedSizePool::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return { _name, _blockSize, _chunks.size() * _blocksPerChunk, _used };
+}
+
+std::vector<FixedSizePool::Stats> FixedSizePool::getAllStats() {
+    std::vector<Stats> stats;
+    std::lock_guard<std::mutex> lock(getPoolsMutex());
+    for (auto pool : getPools()) {
+        stats.push_back(pool->getStats());
+    }
+    return stats;
+}
+
+void FixedSizePool::allocateChunk() {
+    char* chunk = static_cast<char*>(::operator new(_blockSize * _blocksPerChunk));
+    _chunks.push_back(chunk);
+
+    // the blocks are linked in address order, so that objects allocated one after the other are next to each other
+    for (size_t i = _blocksPerChunk; i > 0; i--) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * _blockSize);
+        block->next = _freeList;
+        _freeList = block;
+    }
+}
@@ -0,0 +1,104 @@
+//
+//  FixedSizePool.h
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_FixedSizePool_h
+#define hifi_FixedSizePool_h
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/// Blocks of one size carved out of large chunks, so that many objects of a type are allocated next to each other
+/// instead of being spread around the heap. Freed blocks are reused by the next allocations of the pool, the chunks
+/// are kept until the process exits, and so are the pools, as their blocks may be freed at any time.
+class FixedSizePool {
+public:
+    struct Stats {
+        const char* name;
+        size_t blockSize;
+        size_t capacity; // blocks in the chunks allocated so far
+        size_t used;
+    };
+
+    FixedSizePool(const char* name, size_t blockSize, size_t blocksPerChunk);
+
+    void* allocate();
+    void deallocate(void* block);
+
+    Stats getStats() const;
+
+    /// of every pool that was created
+    static std::vector<Stats> getAllStats();
+
+private:
+    FixedSizePool(const FixedSizePool&) = delete;
+    FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void allocateChunk();
+
+    const char* _name;
+    const size_t _blockSize;
+    const size_t _blocksPerChunk;
+
+    mutable std::mutex _mutex;
+    std::vector<void*> _chunks;
+    FreeBlock* _freeList { nullptr };
+    size_t _used { 0 };
+};
+
+/// An allocator that takes single objects from a FixedSizePool of their type, for std::allocate_shared and the
+/// containers, and arrays from the heap.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    // this many objects are allocated together when the pool runs out
+    static const size_t BLOCKS_PER_CHUNK = 256;
+
+    PoolAllocator() {}
+    template <typename U> PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(getPool().allocate());
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        if (n != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        getPool().deallocate(pointer);
+    }
+
+    template <typename U> bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const PoolAllocator<U>&) const { return false; }
+
+    static FixedSizePool& getPool() {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator doesn't support over-aligned types");
+        // never deleted, see FixedSizePool
+        static FixedSizePool* pool = new FixedSizePool(typeid(T).name(), sizeof(T), BLOCKS_PER_CHUNK);
+        return *pool;
+    }
+};
+
+#endif // hifi_FixedSizePool_h
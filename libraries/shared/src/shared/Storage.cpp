@@ -69,7 +69,8 @@ StoragePointer FileStorage::create(const QString& filename, size_t size, const u
 
 FileStorage::FileStorage(const QString& filename) : _file(filename) {
     if (_file.open(QFile::ReadOnly)) {
-        _mapped = _file.map(0, _file.size());
+        _size = _file.size();
+        _mapped = _file.map(0, _size);
         if (_mapped) {
             _valid = true;
         } else {
@@ -80,6 +81,22 @@ FileStorage::FileStorage(const QString& filename) : _file(filename) {
     }
 }
 
+FileStorage::FileStorage(const QString& filename, size_t offset, size_t size) : _file(filename) {
+    if (_file.open(QFile::ReadOnly)) {
+        if ((qint64)(offset + size) <= _file.size()) {
+            _mapped = _file.map(offset, size);
+        }
+        if (_mapped) {
+            _size = size;
+            _valid = true;
+        } else {
+            qCWarning(storagelogging) << "Failed to map" << size << "bytes at" << offset << "of file " << filename;
+        }
+    } else {
+        qCWarning(storagelogging) << "Failed to open file " << filename;
+    }
+}
+
 FileStorage::~FileStorage() {
     if (_mapped) {
         if (!_file.unmap(_mapped)) {
@@ -51,18 +51,21 @@ namespace storage {
     public:
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
         FileStorage(const QString& filename);
+        // Maps only the range of the file, the rest of it takes no address space or resident memory
+        FileStorage(const QString& filename, size_t offset, size_t size);
         ~FileStorage();
         // Prevent copying
         FileStorage(const FileStorage& other) = delete;
         FileStorage& operator=(const FileStorage& other) = delete;
 
         const uint8_t* data() const override { return _mapped; }
-        size_t size() const override { return _file.size(); }
+        size_t size() const override { return _size; }
         operator bool() const override { return _valid; }
     private:
         bool _valid { false };
         QFile _file;
         uint8_t* _mapped { nullptr };
+        size_t _size { 0 };
     };
 
     class ViewStorage : public Storage {
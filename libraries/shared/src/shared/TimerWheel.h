@@ -0,0 +1,171 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/// A hierarchical timer wheel of values due at a tick. The timers due within 256 ticks sit in the slots of the first
+/// level, one slot per tick, and the later ones in the coarser slots of the next levels, which are moved down a level
+/// each time the tick reaches their range. Adding and removing a timer take a constant time, and advancing the wheel
+/// only visits the ticks with due timers and the ticks at which a coarser slot moves down.
+template <typename T>
+class TimerWheel {
+public:
+    using TimerID = uint64_t;
+    static const TimerID INVALID_TIMER_ID = 0;
+    static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+    static const uint64_t MAX_DELAY = (1ULL << 32) - 1; // ticks, about 50 days of msecs
+
+    struct DueTimer {
+        TimerID id;
+        uint64_t tick;
+        T value;
+    };
+
+    explicit TimerWheel(uint64_t tick = 0) : _tick(tick) {}
+
+    uint64_t getTick() const { return _tick; }
+    size_t size() const { return _timers.size(); }
+    bool empty() const { return _timers.empty(); }
+    bool contains(TimerID id) const { return _timers.find(id) != _timers.end(); }
+
+    /// due delay ticks after the current one, at least one and at most MAX_DELAY
+    TimerID add(const T& value, uint64_t delay) {
+        TimerID id = _nextID++;
+        Timer& timer = _timers[id];
+        timer.due = _tick + std::min(std::max(delay, (uint64_t)1), MAX_DELAY);
+        timer.value = value;
+        link(id, timer);
+        return id;
+    }
+
+    bool remove(TimerID id) {
+        auto it = _timers.find(id);
+        if (it == _timers.end()) {
+            return false;
+        }
+        unlink(it->second);
+        _timers.erase(it);
+        return true;
+    }
+
+    /// removes the timers due up to tick and appends them to dueOut, by due tick and then in the order they were added
+    void advance(uint64_t tick, std::vector<DueTimer>& dueOut) {
+        size_t firstDue = dueOut.size();
+        for (uint64_t next = getNextTick(); next <= tick; next = getNextTick()) {
+            _tick = next;
+            cascade();
+            auto& slot = _slots[0][_tick & SLOT_MASK];
+            for (auto id : slot) {
+                auto it = _timers.find(id);
+                assert(it->second.due == _tick);
+                dueOut.push_back({ id, _tick, it->second.value });
+                _timers.erase(it);
+            }
+            _levelSizes[0] -= slot.size();
+            slot.clear();
+        }
+        _tick = std::max(_tick, tick);
+
+        // the ids grow with each timer added
+        std::sort(dueOut.begin() + firstDue, dueOut.end(), [](const DueTimer& a, const DueTimer& b) {
+            return a.tick < b.tick || (a.tick == b.tick && a.id < b.id);
+        });
+    }
+
+    /// the first tick at which advance() may find due timers, NO_TICK when there are none
+    uint64_t getNextTick() const {
+        if (_timers.empty()) {
+            return NO_TICK;
+        }
+        bool hasCoarseTimers = _levelSizes[0] < _timers.size();
+        for (uint64_t tick = _tick + 1; tick <= _tick + NUM_SLOTS; tick++) {
+            if (!_slots[0][tick & SLOT_MASK].empty() || (hasCoarseTimers && (tick & SLOT_MASK) == 0)) {
+                return tick;
+            }
+        }
+        assert(false); // a timer of the first level is due within NUM_SLOTS ticks, the next level moves by then
+        return NO_TICK;
+    }
+
+private:
+    static const int SLOT_BITS = 8;
+    static const uint64_t NUM_SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = NUM_SLOTS - 1;
+    static const int NUM_LEVELS = 4;
+
+    struct Timer {
+        uint64_t due;
+        T value;
+        int level;
+        size_t slot;
+        size_t index; // in the slot
+    };
+
+    void link(TimerID id, Timer& timer) {
+        uint64_t delay = timer.due - _tick;
+        int level = 0;
+        while (level < NUM_LEVELS - 1 && delay >= (1ULL << (SLOT_BITS * (level + 1)))) {
+            level++;
+        }
+        timer.level = level;
+        timer.slot = (timer.due >> (SLOT_BITS * level)) & SLOT_MASK;
+        auto& slot = _slots[level][timer.slot];
+        timer.index = slot.size();
+        slot.push_back(id);
+        _levelSizes[level]++;
+    }
+
+    void unlink(const Timer& timer) {
+        auto& slot = _slots[timer.level][timer.slot];
+        TimerID last = slot.back();
+        slot[timer.index] = last;
+        _timers[last].index = timer.index;
+        slot.pop_back();
+        _levelSizes[timer.level]--;
+    }
+
+    // moves down the coarser slots whose range starts at the current tick, from the coarsest one
+    void cascade() {
+        for (int level = NUM_LEVELS - 1; level > 0; level--) {
+            uint64_t levelMask = (1ULL << (SLOT_BITS * level)) - 1;
+            if ((_tick & levelMask) != 0 || _levelSizes[level] == 0) {
+                continue;
+            }
+            std::vector<TimerID> slot;
+            slot.swap(_slots[level][(_tick >> (SLOT_BITS * level)) & SLOT_MASK]);
+            _levelSizes[level] -= slot.size();
+            for (auto id : slot) {
+                link(id, _timers[id]);
+            }
+        }
+    }
+
+    uint64_t _tick;
+    TimerID _nextID { INVALID_TIMER_ID + 1 };
+    std::unordered_map<TimerID, Timer> _timers;
+    std::vector<TimerID> _slots[NUM_LEVELS][NUM_SLOTS];
+    size_t _levelSizes[NUM_LEVELS] { 0, 0, 0, 0 };
+};
+
+template <typename T> const typename TimerWheel<T>::TimerID TimerWheel<T>::INVALID_TIMER_ID;
+template <typename T> const uint64_t TimerWheel<T>::NO_TICK;
+template <typename T> const uint64_t TimerWheel<T>::MAX_DELAY;
+
+#endif // hifi_TimerWheel_h
@@ -0,0 +1,102 @@
+//
+//  WorkGroup.cpp
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkGroup.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+struct WorkGroup::State {
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::deque<Task> tasks;
+    int running { 0 };
+    int helpers { 0 };
+    int maxHelpers { std::max(QThread::idealThreadCount() - 1, 0) };
+
+    // runs the next task, with the mutex locked, answers false if there is none
+    bool runNext(std::unique_lock<std::mutex>& lock) {
+        if (tasks.empty()) {
+            return false;
+        }
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        running++;
+        lock.unlock();
+        task();
+        lock.lock();
+        running--;
+        finished.notify_all();
+        return true;
+    }
+};
+
+// Runs the tasks of a group until there are none left. The state is shared, as a helper may only start once the
+// group is gone.
+class WorkGroup::Helper : public QRunnable {
+public:
+    Helper(const std::shared_ptr<State>& state) : _state(state) {}
+
+    void run() override {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        while (_state->runNext(lock)) {
+        }
+        _state->helpers--;
+    }
+
+private:
+    std::shared_ptr<State> _state;
+};
+
+WorkGroup::WorkGroup() : _state(std::make_shared<State>()) {
+}
+
+WorkGroup::~WorkGroup() {
+    wait();
+}
+
+void WorkGroup::run(Task task) {
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    _state->tasks.push_back(std::move(task));
+    if (_state->helpers < _state->maxHelpers && _state->helpers < (int)_state->tasks.size() + _state->running) {
+        _state->helpers++;
+        lock.unlock();
+        QThreadPool::globalInstance()->start(new Helper(_state));
+    }
+}
+
+void WorkGroup::wait() {
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    while (true) {
+        if (!_state->runNext(lock)) {
+            if (_state->running == 0) {
+                return;
+            }
+            _state->finished.wait(lock);
+        }
+    }
+}
+
+void WorkGroup::forEach(int count, const std::function<void(int)>& task) {
+    WorkGroup group;
+    for (int i = 0; i < count; i++) {
+        group.run([&task, i] {
+            task(i);
+        });
+    }
+    group.wait();
+}
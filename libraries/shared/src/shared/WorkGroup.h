@@ -0,0 +1,41 @@
+//
+//  WorkGroup.h
+//  libraries/shared/src/shared
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_WorkGroup_h
+#define hifi_WorkGroup_h
+
+#include <functional>
+#include <memory>
+
+// A group of tasks run on the global thread pool. Waiting for them runs the tasks that no thread has started yet on
+// the waiting thread, so that a group can be waited for from a thread of the pool itself. The tasks must not throw.
+class WorkGroup {
+public:
+    using Task = std::function<void()>;
+
+    WorkGroup();
+    ~WorkGroup(); // waits for the tasks
+
+    void run(Task task);
+    void wait();
+
+    // runs task(i) for each i from 0 to count, returns once they are all done
+    static void forEach(int count, const std::function<void(int)>& task);
+
+private:
+    class Helper;
+    struct State;
+
+    std::shared_ptr<State> _state;
+};
+
+#endif // hifi_WorkGroup_h
@@ -50,6 +50,14 @@ public:
         encodedBuffer.resize(_encodedSize);
         AudioEncoder::process((const int16_t*)decodedBuffer.constData(), (int16_t*)encodedBuffer.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
     }
+
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
+        if (_encodedSize > maxEncodedSize) {
+            return -1;
+        }
+        AudioEncoder::process((const int16_t*)decodedBuffer, (int16_t*)encodedBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        return _encodedSize;
+    }
 private:
     int _encodedSize;
 };
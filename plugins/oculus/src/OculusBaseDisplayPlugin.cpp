@@ -101,6 +101,8 @@ bool OculusBaseDisplayPlugin::internalActivate() {
     auto combinedFov = _eyeFovs[0];
     combinedFov.LeftTan = combinedFov.RightTan = std::max(combinedFov.LeftTan, combinedFov.RightTan);
     _cullingProjection = toGlm(ovrMatrix4f_Projection(combinedFov, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP, ovrProjection_ClipRangeOpenGL));
+    // The Rift field of view is narrower, its lenses are sharp further out
+    _foveationRadius = 0.7f;
 
     _renderTargetSize = uvec2(
         eyeSizes[0].x + eyeSizes[1].x,
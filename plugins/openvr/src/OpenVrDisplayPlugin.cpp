@@ -427,6 +427,8 @@ bool OpenVrDisplayPlugin::internalActivate() {
         // FIXME Calculate the proper combined projection by using GetProjectionRaw values from both eyes
         _cullingProjection = _eyeProjections[0];
     });
+    // The sweet spot of the Vive lenses
+    _foveationRadius = 0.55f;
 
     // enable async time warp
     if (forceInterleavedReprojection) {
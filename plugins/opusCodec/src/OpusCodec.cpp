@@ -0,0 +1,206 @@
+//
+//  OpusCodec.cpp
+//  plugins/opusCodec/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDebug>
+
+#include <opus/opus.h>
+
+#include <AudioConstants.h>
+
+#include "OpusCodec.h"
+
+const char* OpusCodec::NAME { "opus" };
+
+// the microphone of a client is voice, the mix of the audio mixer is anything
+static const int VOICE_BITRATE = 24000; // bits per second, per channel
+static const int MIX_BITRATE = 32000;
+static const int MIX_COMPLEXITY = 5; // of 10, the mixer encodes a mix for every listener
+static const int MIN_BITRATE = 6000; // bits per second, per channel, the least Opus encodes at
+
+// the redundancy of the in-band forward error correction is sized for this loss
+static const int EXPECTED_PACKET_LOSS_PERCENT = 5;
+
+// the largest packet Opus makes of a frame
+static const int MAX_OPUS_PACKET_BYTES = 1275;
+
+// an encoded frame of this size or less is a frame of discontinuous transmission, that need not be sent
+static const int MAX_DTX_PACKET_BYTES = 2;
+
+void OpusCodec::init() {
+}
+
+void OpusCodec::deinit() {
+}
+
+bool OpusCodec::activate() {
+    CodecPlugin::activate();
+    return true;
+}
+
+void OpusCodec::deactivate() {
+    CodecPlugin::deactivate();
+}
+
+bool OpusCodec::isSupported() const {
+    return true;
+}
+
+class OpusCodecEncoder : public Encoder {
+public:
+    OpusCodecEncoder(int sampleRate, int numChannels) : _numChannels(numChannels) {
+        bool isVoice = numChannels == 1;
+        _bitrate = (isVoice ? VOICE_BITRATE : MIX_BITRATE) * numChannels;
+        _currentBitrate = _bitrate;
+        int error;
+        _encoder = opus_encoder_create(sampleRate, numChannels, isVoice ? OPUS_APPLICATION_VOIP : OPUS_APPLICATION_AUDIO,
+                                       &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Could not create an Opus encoder:" << opus_strerror(error);
+            _encoder = nullptr;
+            return;
+        }
+
+        opus_encoder_ctl(_encoder, OPUS_SET_VBR(1));
+        opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(_bitrate));
+        opus_encoder_ctl(_encoder, OPUS_SET_INBAND_FEC(1));
+        opus_encoder_ctl(_encoder, OPUS_SET_PACKET_LOSS_PERC(EXPECTED_PACKET_LOSS_PERCENT));
+        opus_encoder_ctl(_encoder, OPUS_SET_DTX(1));
+        if (isVoice) {
+            opus_encoder_ctl(_encoder, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE));
+        } else {
+            opus_encoder_ctl(_encoder, OPUS_SET_COMPLEXITY(MIX_COMPLEXITY));
+        }
+    }
+
+    virtual ~OpusCodecEncoder() {
+        if (_encoder) {
+            opus_encoder_destroy(_encoder);
+        }
+    }
+
+    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+        encodedBuffer.resize(MAX_OPUS_PACKET_BYTES);
+        int encodedSize = encodeInto(decodedBuffer.constData(), decodedBuffer.size(), encodedBuffer.data(),
+                                     encodedBuffer.size());
+        encodedBuffer.resize(std::max(encodedSize, 0));
+    }
+
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
+        if (!_encoder) {
+            return -1;
+        }
+        int numFrames = decodedSize / (int)(sizeof(int16_t) * _numChannels);
+        int encodedSize = opus_encode(_encoder, reinterpret_cast<const opus_int16*>(decodedBuffer), numFrames,
+                                      reinterpret_cast<unsigned char*>(encodedBuffer), maxEncodedSize);
+        if (encodedSize < 0) {
+            // OPUS_BUFFER_TOO_SMALL, or a frame size Opus does not take
+            _isDiscontinuous = false;
+            return -1;
+        }
+        _isDiscontinuous = encodedSize <= MAX_DTX_PACKET_BYTES;
+        return encodedSize;
+    }
+
+    virtual bool isDiscontinuous() const override { return _isDiscontinuous; }
+
+    virtual void setMaxBitrate(int bitsPerSecond) override {
+        int bitrate = std::max(MIN_BITRATE * _numChannels, std::min(bitsPerSecond, _bitrate));
+        if (_encoder && bitrate != _currentBitrate) {
+            opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(bitrate));
+            _currentBitrate = bitrate;
+        }
+    }
+
+private:
+    OpusEncoder* _encoder { nullptr };
+    int _numChannels;
+    int _bitrate; // the codec's own
+    int _currentBitrate { 0 };
+    bool _isDiscontinuous { false };
+};
+
+class OpusCodecDecoder : public Decoder {
+public:
+    OpusCodecDecoder(int sampleRate, int numChannels) : _numChannels(numChannels) {
+        _decodedSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * sizeof(int16_t) * numChannels;
+        int error;
+        _decoder = opus_decoder_create(sampleRate, numChannels, &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Could not create an Opus decoder:" << opus_strerror(error);
+            _decoder = nullptr;
+        }
+    }
+
+    virtual ~OpusCodecDecoder() {
+        if (_decoder) {
+            opus_decoder_destroy(_decoder);
+        }
+    }
+
+    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+        decodeFrame(reinterpret_cast<const unsigned char*>(encodedBuffer.constData()), encodedBuffer.size(), false,
+                    decodedBuffer);
+    }
+
+    virtual void lostFrame(QByteArray& decodedBuffer) override {
+        // this performs packet loss concealment
+        decodeFrame(nullptr, 0, false, decodedBuffer);
+    }
+
+    virtual void recoverLostFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) override {
+        // the redundancy of the next frame, or concealment where it has none
+        decodeFrame(reinterpret_cast<const unsigned char*>(nextEncodedBuffer.constData()), nextEncodedBuffer.size(), true,
+                    decodedBuffer);
+    }
+
+private:
+    void decodeFrame(const unsigned char* encodedBuffer, int encodedSize, bool useRedundancy, QByteArray& decodedBuffer) {
+        decodedBuffer.resize(_decodedSize);
+        opus_int16* samples = reinterpret_cast<opus_int16*>(decodedBuffer.data());
+        int numFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+        int decodedFrames = _decoder ?
+            opus_decode(_decoder, encodedBuffer, encodedSize, samples, numFrames, useRedundancy ? 1 : 0) : -1;
+        if (decodedFrames < 0 && encodedBuffer && _decoder) {
+            // a corrupt packet is concealed like a lost one
+            decodedFrames = opus_decode(_decoder, nullptr, 0, samples, numFrames, 0);
+        }
+        if (decodedFrames < 0) {
+            decodedFrames = 0;
+        }
+        if (decodedFrames < numFrames) {
+            memset(samples + decodedFrames * _numChannels, 0, (numFrames - decodedFrames) * _numChannels * sizeof(int16_t));
+        }
+    }
+
+    OpusDecoder* _decoder { nullptr };
+    int _numChannels;
+    int _decodedSize;
+};
+
+Encoder* OpusCodec::createEncoder(int sampleRate, int numChannels) {
+    return new OpusCodecEncoder(sampleRate, numChannels);
+}
+
+Decoder* OpusCodec::createDecoder(int sampleRate, int numChannels) {
+    return new OpusCodecDecoder(sampleRate, numChannels);
+}
+
+void OpusCodec::releaseEncoder(Encoder* encoder) {
+    delete encoder;
+}
+
+void OpusCodec::releaseDecoder(Decoder* decoder) {
+    delete decoder;
+}
@@ -39,6 +39,14 @@ public:
         encodedBuffer = decodedBuffer;
     }
 
+    virtual int encodeInto(const char* decodedBuffer, int decodedSize, char* encodedBuffer, int maxEncodedSize) override {
+        if (decodedSize > maxEncodedSize) {
+            return -1;
+        }
+        memcpy(encodedBuffer, decodedBuffer, decodedSize);
+        return decodedSize;
+    }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = encodedBuffer;
     }
@@ -0,0 +1,87 @@
+//
+//  avatarMixerLoadBot.js
+//  examples/acScripts
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  A synthetic avatar for load testing the avatar mixer. Each instance walks a circle around the domain center
+//  while swinging its arms, legs, head and fingers, and now and then disconnects for a few seconds and comes back.
+//  Deploy many instances at once with tools/avatar-mixer-soak.py.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+var CENTER = { x: 0, y: 1.0, z: 0 };
+var MIN_RADIUS = 2.0;   // m
+var MAX_RADIUS = 30.0;  // m
+var WALK_SPEED = 1.2;   // m/s
+var SWING_RATE = 1.5;   // swings per second
+var CHURN_PROBABILITY_PER_SECOND = 0.01; // about one disconnect every 100 seconds
+var MIN_OFFLINE_SECONDS = 2.0;
+var MAX_OFFLINE_SECONDS = 10.0;
+
+// joint, swing axis and amplitude (degrees) of the procedural motion
+var SWINGING_JOINTS = [
+    { name: "LeftUpLeg", axis: Vec3.UNIT_X, amplitude: 25 },
+    { name: "RightUpLeg", axis: Vec3.UNIT_X, amplitude: -25 },
+    { name: "LeftLeg", axis: Vec3.UNIT_X, amplitude: 15 },
+    { name: "RightLeg", axis: Vec3.UNIT_X, amplitude: -15 },
+    { name: "LeftArm", axis: Vec3.UNIT_X, amplitude: -20 },
+    { name: "RightArm", axis: Vec3.UNIT_X, amplitude: 20 },
+    { name: "LeftForeArm", axis: Vec3.UNIT_Y, amplitude: 10 },
+    { name: "RightForeArm", axis: Vec3.UNIT_Y, amplitude: -10 },
+    { name: "Spine", axis: Vec3.UNIT_Y, amplitude: 5 },
+    { name: "Head", axis: Vec3.UNIT_Y, amplitude: 20 }
+];
+var FINGERS = ["Thumb", "Index", "Middle", "Ring", "Pinky"];
+FINGERS.forEach(function (finger) {
+    for (var segment = 1; segment <= 3; segment++) {
+        SWINGING_JOINTS.push({ name: "LeftHand" + finger + segment, axis: Vec3.UNIT_Z, amplitude: 15 });
+        SWINGING_JOINTS.push({ name: "RightHand" + finger + segment, axis: Vec3.UNIT_Z, amplitude: -15 });
+    }
+});
+
+function randomBetween(min, max) {
+    return Math.random() * (max - min) + min;
+}
+
+var radius = randomBetween(MIN_RADIUS, MAX_RADIUS);
+var angle = randomBetween(0, 2 * Math.PI);
+var phase = randomBetween(0, 2 * Math.PI);
+var time = 0.0;
+var offlineSeconds = 0.0;
+
+Avatar.displayName = "load bot " + Math.floor(randomBetween(0, 100000));
+Agent.isAvatar = true;
+
+function update(deltaTime) {
+    time += deltaTime;
+
+    if (offlineSeconds > 0.0) {
+        offlineSeconds -= deltaTime;
+        if (offlineSeconds <= 0.0) {
+            Agent.isAvatar = true;
+        }
+        return;
+    }
+
+    if (Math.random() < CHURN_PROBABILITY_PER_SECOND * deltaTime) {
+        // disconnect: the mixer kills the avatar, and has to resend its identity to everyone when it comes back
+        offlineSeconds = randomBetween(MIN_OFFLINE_SECONDS, MAX_OFFLINE_SECONDS);
+        Agent.isAvatar = false;
+        return;
+    }
+
+    angle += (WALK_SPEED / radius) * deltaTime;
+    Avatar.position = Vec3.sum(CENTER, { x: radius * Math.cos(angle), y: 0, z: radius * Math.sin(angle) });
+    Avatar.orientation = Quat.fromPitchYawRollRadians(0, -angle, 0);
+
+    var swing = Math.sin(2 * Math.PI * SWING_RATE * time + phase);
+    SWINGING_JOINTS.forEach(function (joint) {
+        Avatar.setJointRotation(joint.name, Quat.angleAxis(joint.amplitude * swing, joint.axis));
+    });
+}
+
+Script.update.connect(update);
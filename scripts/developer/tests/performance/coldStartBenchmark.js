@@ -0,0 +1,97 @@
+"use strict";
+/*jslint vars: true, plusplus: true*/
+/*globals Script, Window, Menu, Stats, location, print, AnimationCache, ModelCache, SoundCache, TextureCache*/
+//
+//  coldStartBenchmark.js
+//  scripts/developer/tests/performance/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Clears the resource caches, enters a domain (ideally a local domain-server running a captured content set, so runs
+//  can be compared from release to release) and reports how long it took until everything has loaded, with the time
+//  the resources spent queued, downloading, decoding and uploading.
+//  The KTX and FBX geometry disk caches are kept, start interface with a clean data directory for a fully cold start.
+
+var CHECK_INTERVAL_MS = 500;
+var SETTLED_CHECKS = 6; // the number of checks in a row with nothing loading, before the domain counts as loaded
+var MAXIMUM_LOAD_TIME_MS = 5 * 60 * 1000;
+var NUM_SLOWEST_RESOURCES = 10;
+
+var CACHES = {
+    animations: AnimationCache,
+    models: ModelCache,
+    sounds: SoundCache,
+    textures: TextureCache
+};
+
+var place = Window.prompt("coldStartBenchmark.js\n\nWhat place should be loaded?", location.href);
+if (!place) {
+    Script.stop();
+}
+
+function isLoading() {
+    if (Stats.downloads || Stats.downloadsPending || !Window.isPhysicsEnabled()) {
+        return true;
+    }
+    return Object.keys(CACHES).some(function (name) {
+        return CACHES[name].getLoadSummary().loading > 0;
+    });
+}
+
+function report(loadTime) {
+    var results = { place: place, loadTime: loadTime, caches: {}, slowest: [] };
+    var timelines = [];
+    Object.keys(CACHES).forEach(function (name) {
+        results.caches[name] = CACHES[name].getLoadSummary();
+        timelines = timelines.concat(CACHES[name].getResourceList(true));
+    });
+
+    // the resources that took the longest from being queued to being uploaded
+    timelines.sort(function (a, b) {
+        return (b.uploaded || 0) - (a.uploaded || 0);
+    });
+    results.slowest = timelines.slice(0, NUM_SLOWEST_RESOURCES);
+
+    print("coldStartBenchmark.js results:", JSON.stringify(results, null, 2));
+
+    var message = "Loaded " + place + " in " + (loadTime / 1000).toFixed(1) + " s\n";
+    Object.keys(results.caches).forEach(function (name) {
+        var summary = results.caches[name];
+        message += "\n" + name + ": " + summary.loaded + " loaded, " + summary.failed + " failed, " +
+            (summary.wallTime / 1000).toFixed(1) + " s\n";
+        Object.keys(summary.totals).forEach(function (phase) {
+            message += "    " + phase + ": " + (summary.totals[phase] / 1000).toFixed(1) + " s total, " +
+                (summary.maxima[phase] / 1000).toFixed(1) + " s longest\n";
+        });
+    });
+    Window.alert(message + "\nThe details are in the log.");
+}
+
+function waitForLoad(start) {
+    var settledChecks = 0;
+    var interval = Script.setInterval(function () {
+        var elapsed = Date.now() - start;
+        settledChecks = isLoading() ? 0 : settledChecks + 1;
+        if (settledChecks < SETTLED_CHECKS && elapsed < MAXIMUM_LOAD_TIME_MS) {
+            return;
+        }
+        Script.clearInterval(interval);
+        if (settledChecks < SETTLED_CHECKS) {
+            print("coldStartBenchmark.js: still loading after", elapsed, "ms, reporting what has loaded");
+        }
+        report(elapsed - settledChecks * CHECK_INTERVAL_MS);
+        Script.stop();
+    }, CHECK_INTERVAL_MS);
+}
+
+if (place) {
+    // drops the resources in memory and the ATP cache, and reconnects to the domain
+    Menu.triggerOption("Reload Content (Clears all caches)");
+    var start = Date.now();
+    location.handleLookupString(place);
+    waitForLoad(start);
+}
@@ -0,0 +1,59 @@
+"use strict";
+/*jslint vars: true, plusplus: true*/
+/*global Agent, Script, Vec3, Quat, print*/
+//
+//  crowd-bots.js
+//  scripts/developer/tests/performance/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Run as an AC script. One agent hosts a crowd of bots walking in circles around CENTER, each an avatar of its own
+//  for the avatar mixer and the other clients, instead of one assignment client per avatar as with crowd-agent.js.
+
+var NUMBER_OF_BOTS = 100;
+var CENTER = {x: 0, y: 0, z: 0};
+var MIN_RADIUS = 2; // meters
+var MAX_RADIUS = 20;
+var SPEED = 1; // meters per second
+var ANIMATION_URL = "http://hifi-content.s3.amazonaws.com/ozan/dev/anim/hifi_default/walk_fwd.fbx";
+
+var bots = [];
+
+function createBot(index) {
+    var avatar = Agent.createAvatar();
+    if (!avatar) {
+        return;
+    }
+    avatar.displayName = "bot " + index;
+    avatar.startAnimation(ANIMATION_URL, 30, 1, true);
+    bots.push({
+        avatar: avatar,
+        radius: MIN_RADIUS + Math.random() * (MAX_RADIUS - MIN_RADIUS),
+        angle: Math.random() * 2 * Math.PI
+    });
+}
+
+for (var i = 0; i < NUMBER_OF_BOTS; i++) {
+    createBot(i);
+}
+print('crowd-bots created', bots.length, 'bots');
+
+Script.update.connect(function (deltaTime) {
+    bots.forEach(function (bot) {
+        bot.angle += SPEED * deltaTime / bot.radius;
+        bot.avatar.position = Vec3.sum(CENTER, {x: bot.radius * Math.cos(bot.angle), y: 0, z: bot.radius * Math.sin(bot.angle)});
+        // walking forward, along the circle
+        bot.avatar.orientation = Quat.fromPitchYawRollRadians(0, -bot.angle, 0);
+    });
+});
+
+Script.scriptEnding.connect(function () {
+    bots.forEach(function (bot) {
+        Agent.removeAvatar(bot.avatar);
+    });
+    bots = [];
+});
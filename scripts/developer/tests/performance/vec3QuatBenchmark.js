@@ -0,0 +1,55 @@
+"use strict";
+/*jslint vars: true, plusplus: true*/
+/*globals Script, Vec3, Quat, print*/
+//
+//  vec3QuatBenchmark.js
+//  scripts/developer/tests/performance/
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Times the native bindings of the most used Vec3 and Quat functions against the slots they stand for, which are
+//  found on the prototype of the Vec3 and Quat objects, and prints the calls per millisecond of each.
+
+var ITERATIONS = 100000;
+
+var VEC3_SLOTS = Object.getPrototypeOf(Vec3);
+var QUAT_SLOTS = Object.getPrototypeOf(Quat);
+
+var a = { x: 1.0, y: 2.0, z: 3.0 };
+var b = { x: -0.5, y: 0.25, z: 4.0 };
+var q = Quat.fromPitchYawRollDegrees(10, 20, 30);
+var r = Quat.fromPitchYawRollDegrees(-40, 5, 60);
+
+var CASES = [
+    { name: "Vec3.sum", library: Vec3, slots: VEC3_SLOTS, call: function (lib) { return lib.sum(a, b); } },
+    { name: "Vec3.multiply", library: Vec3, slots: VEC3_SLOTS, call: function (lib) { return lib.multiply(a, 0.5); } },
+    { name: "Vec3.dot", library: Vec3, slots: VEC3_SLOTS, call: function (lib) { return lib.dot(a, b); } },
+    { name: "Vec3.normalize", library: Vec3, slots: VEC3_SLOTS, call: function (lib) { return lib.normalize(a); } },
+    { name: "Vec3.multiplyQbyV", library: Vec3, slots: VEC3_SLOTS, call: function (lib) { return lib.multiplyQbyV(q, a); } },
+    { name: "Quat.multiply", library: Quat, slots: QUAT_SLOTS, call: function (lib) { return lib.multiply(q, r); } },
+    { name: "Quat.getFront", library: Quat, slots: QUAT_SLOTS, call: function (lib) { return lib.getFront(q); } },
+    { name: "Quat.slerp", library: Quat, slots: QUAT_SLOTS, call: function (lib) { return lib.slerp(q, r, 0.3); } }
+];
+
+function callsPerMsec(call, library) {
+    var start = Date.now();
+    for (var i = 0; i < ITERATIONS; i++) {
+        call(library);
+    }
+    var elapsed = Math.max(Date.now() - start, 1);
+    return ITERATIONS / elapsed;
+}
+
+print("vec3QuatBenchmark: " + ITERATIONS + " calls of each");
+CASES.forEach(function (test) {
+    var native = callsPerMsec(test.call, test.library);
+    var slot = callsPerMsec(test.call, test.slots);
+    print("vec3QuatBenchmark: " + test.name + " native " + native.toFixed(0) + " calls/ms, slot " + slot.toFixed(0) +
+          " calls/ms, " + (native / slot).toFixed(1) + "x");
+});
+
+Script.stop();
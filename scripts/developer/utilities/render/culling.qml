@@ -49,6 +49,11 @@ Column {
                         Render.getConfig("CullSceneSelection").freezeFrustum = checked;
                     }
                 }
+                CheckBox {
+                    text: "Occlusion Culling"
+                    checked: Render.getConfig("OcclusionCullSceneSelection").occlusionCulling
+                    onCheckedChanged: { Render.getConfig("OcclusionCullSceneSelection").occlusionCulling = checked }
+                }
                 Label {
                     text: "Octree"
                 }
@@ -134,6 +134,11 @@ Column {
                     checked: Render.getConfig("LightClustering")["freeze"]
                     onCheckedChanged: { Render.getConfig("LightClustering")["freeze"] = checked }
             }
+            CheckBox {
+                    text: "Cluster On GPU"
+                    checked: Render.getConfig("LightClustering")["computeEnabled"]
+                    onCheckedChanged: { Render.getConfig("LightClustering")["computeEnabled"] = checked }
+            }
             CheckBox {
                     text: "Draw Grid"
                     checked: Render.getConfig("DebugLightClusters")["doDrawGrid"]
@@ -213,6 +213,24 @@ Item {
             ]
         } 
 
+        PlotPerf {
+            title: "Scene Changes"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "scenePendingChangeCount",
+                    label: "Pending",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "sceneProcessedChangeCount",
+                    label: "Processed",
+                    color: "#1AC567"
+                }
+            ]
+        }
+
         PlotPerf {
            title: "Timing"
            height: parent.evalEvenHeight()
@@ -244,6 +262,12 @@ Item {
                    prop: "cpuRunTime",
                    label: "RenderFrame",
                    color: "#E2334D"
+               },
+               {
+                   object: Render.getConfig("Stats"),
+                   prop: "sceneProcessingTime",
+                   label: "SceneChanges",
+                   color: "#9495FF"
                }
            ]
         }
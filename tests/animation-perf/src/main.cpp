@@ -0,0 +1,278 @@
+//
+//  main.cpp
+//  tests/animation-perf/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Animates a population of Rigs of the default avatar with its anim graph, each walking, turning, looking and reaching
+//  with random inputs, and reports the avatars animated per millisecond on 1 up to N threads, with the time per avatar
+//  spent setting the inputs of the rig, evaluating the graph and building the poses, solving the IK and computing the
+//  cluster matrices the way Model::updateClusterMatrices() does.
+//
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtCore/QUrl>
+
+#include <AnimationCache.h>
+#include <DependencyManager.h>
+#include <FBXReader.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <PathUtils.h>
+#include <ResourceCache.h>
+#include <Rig.h>
+#include <SharedUtil.h>
+
+using Clock = std::chrono::steady_clock;
+
+static double toMsecs(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// the time spent in each part of the update, summed over the avatars of a thread
+struct Times {
+    Clock::duration inputs { 0 };
+    Clock::duration animation { 0 };
+    double ikMsecs { 0.0 };
+    Clock::duration clusters { 0 };
+
+    Times& operator+=(const Times& other) {
+        inputs += other.inputs;
+        animation += other.animation;
+        ikMsecs += other.ikMsecs;
+        clusters += other.clusters;
+        return *this;
+    }
+};
+
+class BenchmarkAvatar {
+public:
+    BenchmarkAvatar(const FBXGeometry& geometry, const QUrl& graphUrl, int seed) :
+            _geometry(geometry),
+            _rig(std::make_shared<Rig>()),
+            _random(seed) {
+        _rig->initJointStates(geometry, geometry.offset);
+        _rig->initAnimGraph(graphUrl);
+        _reachesWithHands = (seed % 2) == 0;
+
+        int numClusters = 0;
+        for (const auto& mesh : geometry.meshes) {
+            numClusters += mesh.clusters.size();
+        }
+        _clusterMatrices.resize(numClusters);
+    }
+
+    bool isLoaded() const { return (bool)_rig->getAnimNode(); }
+
+    void update(float deltaTime, Times& times) {
+        auto startTime = Clock::now();
+        _time += deltaTime;
+        if (_time >= _nextChangeTime) {
+            changeLocomotion();
+        }
+        _orientation = glm::angleAxis(_turnRate * deltaTime, Vectors::UNIT_Y) * _orientation;
+        glm::vec3 worldVelocity = _orientation * _velocity;
+        _position += worldVelocity * deltaTime;
+
+        Rig::HeadParameters headParams;
+        glm::quat look = glm::angleAxis(0.5f * sinf(_time), Vectors::UNIT_Y) * glm::angleAxis(0.2f * sinf(0.7f * _time), Vectors::UNIT_X);
+        headParams.rigHeadOrientation = Quaternions::Y_180 * look;
+        headParams.worldHeadOrientation = _orientation * look;
+        headParams.neckJointIndex = _geometry.neckJointIndex;
+        headParams.isTalking = fmodf(_time, 4.0f) < 1.5f;
+        _rig->updateFromHeadParameters(headParams, deltaTime);
+
+        Rig::HandParameters handParams;
+        handParams.isLeftEnabled = _reachesWithHands;
+        handParams.isRightEnabled = _reachesWithHands;
+        handParams.leftPosition = Quaternions::Y_180 * glm::vec3(0.3f + 0.1f * sinf(_time), 0.2f * cosf(_time), -0.3f);
+        handParams.leftOrientation = Quaternions::Y_180 * glm::angleAxis(0.5f * sinf(_time), Vectors::UNIT_Z);
+        handParams.rightPosition = Quaternions::Y_180 * glm::vec3(-0.3f - 0.1f * cosf(_time), 0.2f * sinf(_time), -0.3f);
+        handParams.rightOrientation = Quaternions::Y_180 * glm::angleAxis(0.5f * cosf(_time), Vectors::UNIT_Z);
+        handParams.bodyCapsuleRadius = 0.2f;
+        handParams.bodyCapsuleHalfHeight = 0.5f;
+        handParams.bodyCapsuleLocalOffset = glm::vec3(0.0f);
+        _rig->updateFromHandParameters(handParams, deltaTime);
+
+        _rig->computeMotionAnimationState(deltaTime, _position, worldVelocity, _orientation, Rig::CharacterControllerState::Ground);
+        auto inputsTime = Clock::now();
+
+        _rig->updateAnimations(deltaTime, _geometry.offset);
+        auto animationTime = Clock::now();
+
+        // as in Model::updateClusterMatrices()
+        int clusterIndex = 0;
+        for (const auto& mesh : _geometry.meshes) {
+            for (const auto& cluster : mesh.clusters) {
+                glm_mat4u_mul(_rig->getJointTransform(cluster.jointIndex), cluster.inverseBindMatrix, _clusterMatrices[clusterIndex++]);
+            }
+        }
+        auto clustersTime = Clock::now();
+
+        times.inputs += inputsTime - startTime;
+        times.animation += animationTime - inputsTime;
+        times.ikMsecs += _rig->getIKTimeOnLastSolve();
+        times.clusters += clustersTime - animationTime;
+    }
+
+private:
+    // stand, walk or run in any direction and turn, for a few seconds
+    void changeLocomotion() {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const float MAX_SPEED = 4.5f; // m/s
+        float speed = unit(_random) < 0.2f ? 0.0f : MAX_SPEED * unit(_random);
+        float heading = TWO_PI * unit(_random);
+        _velocity = speed * glm::vec3(sinf(heading), 0.0f, cosf(heading));
+        _turnRate = unit(_random) < 0.3f ? PI * (unit(_random) - 0.5f) : 0.0f;
+        _nextChangeTime = _time + 1.0f + 4.0f * unit(_random);
+    }
+
+    const FBXGeometry& _geometry;
+    RigPointer _rig;
+    std::mt19937 _random;
+    bool _reachesWithHands { false };
+
+    float _time { 0.0f };
+    float _nextChangeTime { 0.0f };
+    glm::vec3 _position;
+    glm::vec3 _velocity;
+    glm::quat _orientation;
+    float _turnRate { 0.0f };
+
+    std::vector<glm::mat4> _clusterMatrices;
+};
+
+// each thread updates its share of the avatars for all the frames
+static void runThreads(std::vector<std::unique_ptr<BenchmarkAvatar>>& avatars, int numThreads, int numFrames, bool report = true) {
+    const float DELTA_TIME = 1.0f / 60.0f;
+    std::vector<Times> threadTimes(numThreads);
+    std::vector<std::thread> threads;
+
+    auto startTime = Clock::now();
+    for (int i = 0; i < numThreads; i++) {
+        threads.emplace_back([&, i] {
+            size_t begin = avatars.size() * i / numThreads;
+            size_t end = avatars.size() * (i + 1) / numThreads;
+            for (int frame = 0; frame < numFrames; frame++) {
+                for (size_t j = begin; j < end; j++) {
+                    avatars[j]->update(DELTA_TIME, threadTimes[i]);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double wallMsecs = toMsecs(Clock::now() - startTime);
+    if (!report) {
+        return;
+    }
+
+    Times times;
+    for (const auto& threadTime : threadTimes) {
+        times += threadTime;
+    }
+    double numUpdates = (double)avatars.size() * numFrames;
+    double animationMsecs = toMsecs(times.animation);
+    qDebug().noquote() << QString("%1 threads: %2 avatars/ms, per avatar: %3 ms inputs, %4 ms graph and poses, "
+                                  "%5 ms IK, %6 ms cluster matrices")
+        .arg(numThreads, 2)
+        .arg(numUpdates / wallMsecs, 0, 'f', 2)
+        .arg(toMsecs(times.inputs) / numUpdates, 0, 'f', 4)
+        .arg((animationMsecs - times.ikMsecs) / numUpdates, 0, 'f', 4)
+        .arg(times.ikMsecs / numUpdates, 0, 'f', 4)
+        .arg(toMsecs(times.clusters) / numUpdates, 0, 'f', 4);
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the animation of a population of avatars on an increasing number of threads.");
+    parser.addHelpOption();
+    const QCommandLineOption resourcesOption("resources", "the resources directory of interface with the default avatar "
+                                             "and its anim graph", "path", PathUtils::resourcesPath());
+    const QCommandLineOption modelOption("model", "avatar model, instead of the default one", "fbx");
+    const QCommandLineOption graphOption("graph", "anim graph, instead of the default one", "json");
+    const QCommandLineOption avatarsOption("avatars", "number of avatars", "count", "200");
+    const QCommandLineOption framesOption("frames", "frames animated on each number of threads", "count", "300");
+    const QCommandLineOption threadsOption("threads", "largest number of threads", "count",
+                                           QString::number(std::max(QThread::idealThreadCount(), 1)));
+    parser.addOptions({ resourcesOption, modelOption, graphOption, avatarsOption, framesOption, threadsOption });
+    parser.process(app);
+
+    QString resources = parser.value(resourcesOption);
+    QString modelPath = parser.isSet(modelOption) ? parser.value(modelOption) : resources + "/meshes/being_of_light/being_of_light.fbx";
+    QString graphPath = parser.isSet(graphOption) ? parser.value(graphOption) : resources + "/avatar/avatar-animation.json";
+    int numAvatars = std::max(parser.value(avatarsOption).toInt(), 1);
+    int numFrames = std::max(parser.value(framesOption).toInt(), 1);
+    int maxThreads = std::max(parser.value(threadsOption).toInt(), 1);
+
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+
+    QFile modelFile(modelPath);
+    if (!modelFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot read the avatar model" << modelPath;
+        return 1;
+    }
+    std::unique_ptr<FBXGeometry> geometry(readFBX(modelFile.readAll(), QVariantHash(), modelPath));
+    if (!geometry || geometry->joints.isEmpty()) {
+        qWarning() << "The avatar model" << modelPath << "has no skeleton";
+        return 1;
+    }
+
+    QUrl graphUrl = QUrl::fromUserInput(graphPath);
+    std::vector<std::unique_ptr<BenchmarkAvatar>> avatars;
+    for (int i = 0; i < numAvatars; i++) {
+        avatars.emplace_back(new BenchmarkAvatar(*geometry, graphUrl, i));
+    }
+
+    // the graphs and their animations load on the event loop
+    const quint64 LOAD_TIMEOUT = 60 * USECS_PER_SECOND;
+    quint64 loadEndTime = usecTimestampNow() + LOAD_TIMEOUT;
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto isLoading = [&] {
+        for (const auto& avatar : avatars) {
+            if (!avatar->isLoaded()) {
+                return true;
+            }
+        }
+        return sharedItems->getPendingRequestsCount() + sharedItems->getLoadingRequestsCount() > 0;
+    };
+    while (isLoading()) {
+        if (usecTimestampNow() > loadEndTime) {
+            qWarning() << "The anim graph" << graphUrl.toDisplayString() << "did not load";
+            return 1;
+        }
+        app.processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    qDebug() << numAvatars << "avatars of" << geometry->joints.size() << "joints," << numFrames << "frames";
+
+    // the first frames on one thread set up the clips and the IK
+    const int WARM_UP_FRAMES = 10;
+    runThreads(avatars, 1, WARM_UP_FRAMES, false);
+
+    for (int numThreads = 1; numThreads < maxThreads; numThreads *= 2) {
+        runThreads(avatars, numThreads, numFrames);
+    }
+    runThreads(avatars, maxThreads, numFrames);
+
+    avatars.clear();
+    DependencyManager::destroy<AnimationCache>();
+    return 0;
+}
@@ -296,3 +296,60 @@ void AnimInverseKinematicsTests::testBar() {
     QCOMPARE_WITH_ABS_ERROR(expectedTransC, poseC.trans, EPSILON);
 }
 
+// the chain A------>B------>C------>D with a target on D that it can reach
+static AnimPoseVec makeChainPoses(AnimInverseKinematics& ikDoll, AnimVariantMap& varMap) {
+    FBXGeometry geometry;
+    makeTestFBXJoints(geometry);
+    ikDoll.setSkeleton(std::make_shared<AnimSkeleton>(geometry));
+
+    AnimPoseVec poses;
+    poses.push_back(AnimPose(glm::vec3(1.0f), identity, origin));
+    for (int i = 1; i < (int)geometry.joints.size(); ++i) {
+        poses.push_back(AnimPose(glm::vec3(1.0f), identity, xAxis));
+    }
+    ikDoll.loadPoses(poses);
+
+    varMap.set("positionD", glm::vec3(2.0f, 1.0f, 0.0f));
+    varMap.set("rotationD", glm::angleAxis(PI / 2.0f, zAxis));
+    varMap.set("targetType", (int)IKTarget::Type::RotationAndPosition);
+    ikDoll.setTargetVars(QString("D"), QString("positionD"), QString("rotationD"), QString("targetType"));
+    return poses;
+}
+
+void AnimInverseKinematicsTests::testSolveLoops() {
+    AnimInverseKinematics ikDoll("doll");
+    AnimVariantMap varMap;
+    AnimPoseVec poses = makeChainPoses(ikDoll, varMap);
+    AnimNode::Triggers triggers;
+    float dt = 1.0f;
+
+    // the budget bounds the loops of a solve
+    ikDoll.setMaxSolveLoops(1);
+    ikDoll.overlay(varMap, dt, triggers, poses);
+    QCOMPARE(ikDoll.getNumLoopsOnLastSolve(), 1);
+
+    // starting from the previous solution, later solves take fewer loops than the budget
+    ikDoll.setMaxSolveLoops(AnimInverseKinematics::DEFAULT_MAX_SOLVE_LOOPS);
+    for (int i = 0; i < 10; ++i) {
+        ikDoll.overlay(varMap, dt, triggers, poses);
+    }
+    QVERIFY(ikDoll.getNumLoopsOnLastSolve() < AnimInverseKinematics::DEFAULT_MAX_SOLVE_LOOPS);
+    QVERIFY(ikDoll.getMaxErrorOnLastSolve() < 0.1f);
+}
+
+void AnimInverseKinematicsTests::benchmarkSolve() {
+    AnimInverseKinematics ikDoll("doll");
+    AnimVariantMap varMap;
+    AnimPoseVec poses = makeChainPoses(ikDoll, varMap);
+    AnimNode::Triggers triggers;
+    float dt = 1.0f / 60.0f;
+
+    int numSolves = 0;
+    int numLoops = 0;
+    QBENCHMARK {
+        ikDoll.overlay(varMap, dt, triggers, poses);
+        numSolves++;
+        numLoops += ikDoll.getNumLoopsOnLastSolve();
+    }
+    qDebug() << "IK loops per solve" << (float)numLoops / (float)numSolves;
+}
@@ -22,6 +22,8 @@ class AnimInverseKinematicsTests : public QObject {
 private slots:
     void testSingleChain();
     void testBar();
+    void testSolveLoops();
+    void benchmarkSolve();
 };
 
 #endif // hifi_AnimInverseKinematicsTests_h
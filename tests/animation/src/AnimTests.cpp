@@ -10,6 +10,7 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimClipData.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -422,6 +423,79 @@ void AnimTests::testAnimPose() {
     }
 }
 
+void AnimTests::testBlend() {
+    const float PI = (float)M_PI;
+    const glm::vec3 X_AXIS(1.0f, 0.0f, 0.0f);
+
+    // more poses than the four blended at a time so the remainder is covered too,
+    // with some rotations on opposite hemispheres that need their signs adjusted
+    const size_t NUM_POSES = 7;
+    std::vector<AnimPose> aPoses;
+    std::vector<AnimPose> bPoses;
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        float angle = (float)i * PI / (float)NUM_POSES;
+        glm::quat aRot = glm::angleAxis(angle, X_AXIS);
+        glm::quat bRot = glm::angleAxis(2.0f * angle + 0.1f, glm::normalize(glm::vec3(1.0f, (float)i, 0.5f)));
+        if (i % 2) {
+            bRot = -bRot;
+        }
+        aPoses.push_back(AnimPose(glm::vec3(1.0f + (float)i), aRot, glm::vec3((float)i, 0.0f, -1.0f)));
+        bPoses.push_back(AnimPose(glm::vec3(0.5f), bRot, glm::vec3(0.0f, 2.0f * (float)i, 3.0f)));
+    }
+
+    const float EPSILON = 0.0001f;
+    std::vector<float> alphas = { 0.0f, 0.25f, 0.5f, 1.0f };
+    for (auto alpha : alphas) {
+        std::vector<AnimPose> result(NUM_POSES);
+        ::blend(NUM_POSES, aPoses.data(), bPoses.data(), alpha, result.data());
+        for (size_t i = 0; i < NUM_POSES; i++) {
+            glm::quat bRot = bPoses[i].rot();
+            if (glm::dot(aPoses[i].rot(), bRot) < 0.0f) {
+                bRot = -bRot;
+            }
+            glm::quat expectedRot = glm::normalize(glm::lerp(aPoses[i].rot(), bRot, alpha));
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale(), lerp(aPoses[i].scale(), bPoses[i].scale(), alpha), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].rot(), expectedRot, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans(), lerp(aPoses[i].trans(), bPoses[i].trans(), alpha), EPSILON);
+        }
+    }
+}
+
+void AnimTests::testClipData() {
+    const float PI = (float)M_PI;
+    const glm::vec3 X_AXIS(1.0f, 0.0f, 0.0f);
+    const glm::vec3 Y_AXIS(0.0f, 1.0f, 0.0f);
+
+    // the first joint doesn't move, the second one only rotates and the last one only translates
+    const int NUM_FRAMES = 5;
+    std::vector<AnimPoseVec> frames;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float angle = (float)i * PI / (float)NUM_FRAMES;
+        AnimPoseVec poses;
+        poses.push_back(AnimPose(glm::vec3(2.0f), glm::angleAxis(0.3f, Y_AXIS), glm::vec3(1.0f, 2.0f, 3.0f)));
+        poses.push_back(AnimPose(glm::vec3(1.0f), glm::angleAxis(angle, X_AXIS), glm::vec3(0.0f, 1.0f, 0.0f)));
+        poses.push_back(AnimPose(glm::vec3(1.0f), glm::quat(), glm::vec3(0.0f, (float)i, 0.5f * (float)i)));
+        frames.push_back(poses);
+    }
+
+    AnimClipData data(frames);
+    QCOMPARE(data.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(data.getNumJoints(), 3);
+
+    // the rotations are quantized
+    const float ROTATION_EPSILON = 0.0002f;
+    AnimPoseVec poses(data.getNumJoints());
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        data.getFrame(i, poses);
+        for (int j = 0; j < data.getNumJoints(); j++) {
+            QVERIFY(poses[j].scale() == frames[i][j].scale());
+            QVERIFY(poses[j].trans() == frames[i][j].trans());
+            QVERIFY(fabsf(glm::dot(poses[j].rot(), frames[i][j].rot())) > 1.0f - ROTATION_EPSILON);
+        }
+        QVERIFY(poses[0].rot() == frames[i][0].rot());
+    }
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,6 +27,8 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testBlend();
+    void testClipData();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
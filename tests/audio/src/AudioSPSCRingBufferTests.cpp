@@ -0,0 +1,127 @@
+//
+//  AudioSPSCRingBufferTests.cpp
+//  tests/audio/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSPSCRingBufferTests.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "AudioSPSCRingBuffer.h"
+
+QTEST_MAIN(AudioSPSCRingBufferTests)
+
+void AudioSPSCRingBufferTests::readWriteTest() {
+    int16_t writeData[1000];
+    for (int i = 0; i < 1000; i++) { writeData[i] = i; }
+    int16_t readData[1000];
+
+    AudioSPSCRingBuffer ringBuffer(100);
+    for (int T = 0; T < 300; T++) {
+        int writeIndexAt = 0;
+        int readIndexAt = 0;
+
+        // write 73 samples, 73 samples in buffer
+        writeIndexAt += ringBuffer.writeSamples(&writeData[writeIndexAt], 73);
+        QCOMPARE(ringBuffer.samplesAvailable(), 73);
+
+        // read 43 samples, 30 samples in buffer
+        readIndexAt += ringBuffer.readSamples(&readData[readIndexAt], 43);
+        QCOMPARE(ringBuffer.samplesAvailable(), 30);
+
+        // write 90 samples, only 70 are written (full), as unread samples are never overwritten
+        QCOMPARE(ringBuffer.writeSamples(&writeData[writeIndexAt], 90), 70);
+        writeIndexAt += 70;
+        QCOMPARE(ringBuffer.samplesAvailable(), 100);
+        QCOMPARE(ringBuffer.samplesFree(), 0);
+
+        // read 200 samples, only 100 are read (empty)
+        readIndexAt += ringBuffer.readSamples(&readData[readIndexAt], 200);
+        QCOMPARE(ringBuffer.samplesAvailable(), 0);
+
+        // verify 143 samples of read data, which wrapped around the buffer
+        QCOMPARE(readIndexAt, writeIndexAt);
+        for (int i = 0; i < readIndexAt; i++) {
+            QCOMPARE(readData[i], (int16_t)i);
+        }
+
+        // skip and silence
+        QCOMPARE(ringBuffer.addSilentSamples(150), 100);
+        QCOMPARE(ringBuffer.skipSamples(60), 60);
+        QCOMPARE(ringBuffer.readSamples(readData, 100), 40);
+        for (int i = 0; i < 40; i++) {
+            QCOMPARE(readData[i], (int16_t)0);
+        }
+    }
+}
+
+void AudioSPSCRingBufferTests::appendTest() {
+    float writeData[50];
+    for (int i = 0; i < 50; i++) { writeData[i] = (float)i; }
+    float mixData[50];
+    std::fill(mixData, mixData + 50, 1.0f);
+
+    AudioMixSPSCRingBuffer ringBuffer(30);
+
+    // offset the indices so that the append wraps around the buffer
+    ringBuffer.addSilentSamples(20);
+    ringBuffer.skipSamples(20);
+
+    QCOMPARE(ringBuffer.writeSamples(writeData, 25), 25);
+    QCOMPARE(ringBuffer.appendSamples(mixData, 50), 25);
+    for (int i = 0; i < 25; i++) {
+        QCOMPARE(mixData[i], (float)i + 1.0f);
+    }
+    for (int i = 25; i < 50; i++) {
+        QCOMPARE(mixData[i], 1.0f);
+    }
+}
+
+void AudioSPSCRingBufferTests::threadedTest() {
+    const int NUM_SAMPLES = 1000000;
+    AudioMixSPSCRingBuffer ringBuffer(97);
+
+    // write and read in sizes coprime to the capacity, so every wrap position is exercised
+    std::thread producer([&] {
+        float buffer[13];
+        int written = 0;
+        while (written < NUM_SAMPLES) {
+            int numSamples = std::min(13, NUM_SAMPLES - written);
+            for (int i = 0; i < numSamples; i++) {
+                buffer[i] = (float)(written + i);
+            }
+            int numWritten = ringBuffer.writeSamples(buffer, numSamples);
+            if (numWritten == 0) {
+                std::this_thread::yield();
+            }
+            written += numWritten;
+        }
+    });
+
+    int numMismatched = 0;
+    float buffer[17];
+    int read = 0;
+    while (read < NUM_SAMPLES) {
+        int numRead = ringBuffer.readSamples(buffer, 17);
+        for (int i = 0; i < numRead; i++) {
+            if (buffer[i] != (float)(read + i)) {
+                ++numMismatched;
+            }
+        }
+        if (numRead == 0) {
+            std::this_thread::yield();
+        }
+        read += numRead;
+    }
+    producer.join();
+
+    QCOMPARE(numMismatched, 0);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+}
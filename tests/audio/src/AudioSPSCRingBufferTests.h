@@ -0,0 +1,25 @@
+//
+//  AudioSPSCRingBufferTests.h
+//  tests/audio/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSPSCRingBufferTests_h
+#define hifi_AudioSPSCRingBufferTests_h
+
+#include <QtTest/QtTest>
+
+class AudioSPSCRingBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void readWriteTest();
+    void appendTest();
+    void threadedTest();
+};
+
+#endif // hifi_AudioSPSCRingBufferTests_h
@@ -0,0 +1,251 @@
+//
+//  AvatarDataTests.cpp
+//  tests/avatars/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonDocument>
+
+#include <AvatarData.h>
+#include <AvatarJointBuffer.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AvatarDataTests)
+
+static const int NUM_TEST_JOINTS = 40;
+static const float ROTATION_EPSILON = 0.005f;
+static const float EPSILON = 0.001f;
+
+// exposes the coarse rotation mask, which is normally set from the skeleton's joint names
+class TestAvatarData : public AvatarData {
+public:
+    void setCoarseJoints(int firstCoarseJoint) {
+        _coarseJointRotations.fill(false, NUM_TEST_JOINTS);
+        for (int i = firstCoarseJoint; i < NUM_TEST_JOINTS; i++) {
+            _coarseJointRotations[i] = true;
+        }
+    }
+};
+
+static void poseTestAvatar(TestAvatarData& avatar, int seed) {
+    avatar.setPosition(glm::vec3((float)seed, 0.0f, -(float)seed));
+    for (int i = 0; i < NUM_TEST_JOINTS; i++) {
+        float angle = 0.1f * (float)(i + seed);
+        glm::quat rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)i, 0.5f)));
+        avatar.setJointData(i, rotation, glm::vec3(0.01f * (float)i, 0.1f, 0.0f));
+    }
+}
+
+void AvatarDataTests::testJointDataRoundTrip() {
+    // the last quarter of the joints stand in for the fingers
+    const int FIRST_COARSE_JOINT = 3 * NUM_TEST_JOINTS / 4;
+
+    TestAvatarData fine;
+    poseTestAvatar(fine, 1);
+    TestAvatarData coarse;
+    poseTestAvatar(coarse, 1);
+    coarse.setCoarseJoints(FIRST_COARSE_JOINT);
+
+    AvatarDataPacket::HasFlags hasFlags;
+    // encoding compares against the last sent joints, which must cover every joint
+    QVector<JointData> noBaseline(NUM_TEST_JOINTS);
+    QByteArray fineBytes = fine.toByteArray(AvatarData::SendAllData, 0, noBaseline, hasFlags,
+        false, false, glm::vec3(0.0f), nullptr);
+    QByteArray coarseBytes = coarse.toByteArray(AvatarData::SendAllData, 0, noBaseline, hasFlags,
+        false, false, glm::vec3(0.0f), nullptr);
+
+    // coarse rotations save two bytes each, less the precision bits
+    QVERIFY(coarseBytes.size() < fineBytes.size());
+
+    TestAvatarData received;
+    QCOMPARE(received.parseDataFromBuffer(coarseBytes), coarseBytes.size());
+    QCOMPARE(received.getRawJointData().size(), NUM_TEST_JOINTS);
+
+    for (int i = 0; i < NUM_TEST_JOINTS; i++) {
+        glm::quat expected = coarse.getJointRotation(i);
+        glm::quat actual = received.getJointRotation(i);
+        // q and -q are the same rotation
+        float error = 1.0f - fabsf(glm::dot(expected, actual));
+        QVERIFY(error < ROTATION_EPSILON);
+    }
+}
+
+void AvatarDataTests::testTruncatedPackets() {
+    TestAvatarData sender;
+    poseTestAvatar(sender, 2);
+
+    AvatarDataPacket::HasFlags hasFlags;
+    QVector<JointData> noBaseline(NUM_TEST_JOINTS);
+    QByteArray bytes = sender.toByteArray(AvatarData::SendAllData, 0, noBaseline, hasFlags,
+        false, false, glm::vec3(0.0f), nullptr);
+
+    // every truncation must be caught by the read checks, which consume (discard) the whole buffer
+    for (int size = 0; size < bytes.size(); size++) {
+        TestAvatarData received;
+        QByteArray truncated = QByteArray::fromRawData(bytes.constData(), size);
+        QCOMPARE(received.parseDataFromBuffer(truncated), size);
+    }
+}
+
+void AvatarDataTests::testRecordingFrames() {
+    TestAvatarData recorded;
+    poseTestAvatar(recorded, 3);
+    recorded.setDisplayName("recorded");
+
+    QByteArray keyframe = AvatarData::toFrame(recorded, true);
+    QByteArray frame = AvatarData::toFrame(recorded, false);
+    QVERIFY(frame.size() < keyframe.size());
+
+    // the compact frame is a fraction of the JSON one
+    QByteArray jsonFrame = QJsonDocument(recorded.toJson()).toBinaryData();
+    QVERIFY(frame.size() < jsonFrame.size() / 2);
+
+    TestAvatarData played;
+    AvatarData::fromFrame(keyframe, played);
+    QCOMPARE(played.getDisplayName(), QString("recorded"));
+    QVERIFY(glm::distance(played.getPosition(), recorded.getPosition()) < EPSILON);
+    QCOMPARE(played.getRawJointData().size(), NUM_TEST_JOINTS);
+    for (int i = 0; i < NUM_TEST_JOINTS; i++) {
+        float error = 1.0f - fabsf(glm::dot(recorded.getJointRotation(i), played.getJointRotation(i)));
+        QVERIFY(error < ROTATION_EPSILON);
+    }
+
+    // the frames in between leave the display name to the keyframes
+    TestAvatarData playedFromFrame;
+    AvatarData::fromFrame(frame, playedFromFrame);
+    QVERIFY(playedFromFrame.getDisplayName().isEmpty());
+    QCOMPARE(playedFromFrame.getRawJointData().size(), NUM_TEST_JOINTS);
+
+    // a truncated frame changes nothing
+    TestAvatarData truncated;
+    AvatarData::fromFrame(frame.left(frame.size() - 1), truncated);
+    QCOMPARE(truncated.getRawJointData().size(), 0);
+
+    // the JSON frames of the older recordings still play
+    TestAvatarData playedFromJson;
+    AvatarData::fromFrame(jsonFrame, playedFromJson);
+    QCOMPARE(playedFromJson.getDisplayName(), QString("recorded"));
+    QCOMPARE(playedFromJson.getRawJointData().size(), NUM_TEST_JOINTS);
+}
+
+static QVector<JointData> makeJointFrame(float angle, float height) {
+    QVector<JointData> joints(1);
+    joints[0].rotation = glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f));
+    joints[0].rotationSet = true;
+    joints[0].translation = glm::vec3(0.0f, height, 0.0f);
+    joints[0].translationSet = true;
+    return joints;
+}
+
+void AvatarDataTests::testJointBufferInterpolation() {
+    const quint64 GAP = 20 * USECS_PER_MSEC;
+    const quint64 START = USECS_PER_SECOND;
+    AvatarJointBuffer buffer;
+    QVector<JointData> joints;
+    QVERIFY(!buffer.sample(START, joints));
+
+    buffer.push(START, makeJointFrame(0.0f, 0.0f));
+    buffer.push(START + GAP, makeJointFrame(0.2f, 1.0f));
+    QVERIFY(buffer.isPlaying(START + GAP));
+
+    // halfway between the two frames, the delay in the past
+    quint64 now = START + GAP / 2 + buffer.getDelay();
+    QVERIFY(buffer.sample(now, joints));
+    QCOMPARE(joints.size(), 1);
+    QVERIFY(fabsf(joints[0].translation.y - 0.5f) < EPSILON);
+    QVERIFY(fabsf(glm::angle(joints[0].rotation) - 0.1f) < ROTATION_EPSILON);
+
+    // past the last frame the motion continues, up to twice the last step
+    now = START + 2 * GAP + buffer.getDelay();
+    QVERIFY(buffer.sample(now, joints));
+    QVERIFY(fabsf(joints[0].translation.y - 2.0f) < EPSILON);
+    QVERIFY(fabsf(glm::angle(joints[0].rotation) - 0.4f) < ROTATION_EPSILON);
+
+    // then it holds
+    now = START + GAP + AvatarJointBuffer::MAX_EXTRAPOLATION + buffer.getTargetDelay() + GAP;
+    QVERIFY(!buffer.isPlaying(now));
+    QVERIFY(buffer.sample(now, joints));
+    QVERIFY(fabsf(joints[0].translation.y - 3.0f) < EPSILON);
+}
+
+void AvatarDataTests::testJointBufferDelay() {
+    const quint64 GAP = 20 * USECS_PER_MSEC;
+    const quint64 LATE_GAP = 120 * USECS_PER_MSEC;
+    AvatarJointBuffer buffer;
+    QVector<JointData> joints;
+
+    quint64 now = USECS_PER_SECOND;
+    buffer.push(now, makeJointFrame(0.0f, 0.0f));
+    now += GAP;
+    buffer.push(now, makeJointFrame(0.0f, 0.0f));
+    QCOMPARE(buffer.getTargetDelay(), AvatarJointBuffer::INITIAL_DELAY);
+
+    // a late frame raises the target at once, and the delay follows while sampling
+    now += LATE_GAP;
+    buffer.push(now, makeJointFrame(0.0f, 0.0f));
+    QCOMPARE(buffer.getTargetDelay(), LATE_GAP);
+    quint64 delay = buffer.getDelay();
+    for (int i = 0; i < 10; i++) {
+        now += GAP;
+        buffer.push(now, makeJointFrame(0.0f, 0.0f));
+        buffer.sample(now, joints);
+        QVERIFY(buffer.getDelay() >= delay);
+        QVERIFY(buffer.getDelay() <= LATE_GAP);
+        QVERIFY(buffer.getDelay() - delay <= GAP / 10 + 1);
+        delay = buffer.getDelay();
+    }
+    QVERIFY(delay > AvatarJointBuffer::INITIAL_DELAY);
+
+    // once a whole window of regular gaps has passed, the target shrinks back to them
+    for (int i = 0; i < 400; i++) {
+        now += GAP;
+        buffer.push(now, makeJointFrame(0.0f, 0.0f));
+        buffer.sample(now, joints);
+    }
+    QCOMPARE(buffer.getTargetDelay(), GAP);
+    QCOMPARE(buffer.getDelay(), GAP);
+}
+
+void AvatarDataTests::benchmarkEncoding_data() {
+    QTest::addColumn<int>("numAvatars");
+    QTest::newRow("10 avatars") << 10;
+    QTest::newRow("100 avatars") << 100;
+    QTest::newRow("500 avatars") << 500;
+}
+
+// the per-receiver work of the avatar mixer is dominated by encoding every other avatar for that receiver
+void AvatarDataTests::benchmarkEncoding() {
+    QFETCH(int, numAvatars);
+
+    std::vector<std::unique_ptr<TestAvatarData>> avatars;
+    for (int i = 0; i < numAvatars; i++) {
+        avatars.emplace_back(new TestAvatarData());
+        poseTestAvatar(*avatars.back(), i);
+    }
+
+    QVector<JointData> lastSentJointData(NUM_TEST_JOINTS);
+    QVector<JointData> sentJointData;
+    AvatarDataPacket::HasFlags hasFlags;
+    glm::vec3 viewerPosition(0.0f);
+    int totalBytes = 0;
+
+    QBENCHMARK {
+        for (auto& avatar : avatars) {
+            QByteArray bytes = avatar->toByteArray(AvatarData::CullSmallData, 0, lastSentJointData, hasFlags,
+                false, true, viewerPosition, &sentJointData);
+            totalBytes += bytes.size();
+        }
+    }
+
+    QVERIFY(totalBytes > 0);
+}
@@ -0,0 +1,29 @@
+//
+//  AvatarDataTests.h
+//  tests/avatars/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarDataTests_h
+#define hifi_AvatarDataTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarDataTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testJointDataRoundTrip();
+    void testTruncatedPackets();
+    void testRecordingFrames();
+    void testJointBufferInterpolation();
+    void testJointBufferDelay();
+    void benchmarkEncoding_data();
+    void benchmarkEncoding();
+};
+
+#endif // hifi_AvatarDataTests_h
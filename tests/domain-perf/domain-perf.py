@@ -0,0 +1,443 @@
+#!/usr/bin/env python3
+#
+# End-to-end performance suite for a domain.
+#
+# Starts a domain-server and its assignment-clients locally from a build, restores a reference entity content set,
+# then deploys N headless avatars (perfAgent.js, run by assignment-client Agents) that play back a recording, or
+# walk when none is given, and talk through a voice clip. After a warm-up it samples the /metrics of the domain-server
+# and writes a JSON report with each mixer's frame time percentiles, CPU, resident memory and bandwidth, checked
+# against the thresholds of thresholds.json. The exit code is 1 if a threshold is exceeded, so CI can gate on it.
+#
+# Usage: python3 domain-perf.py --bin-dir ../../build/bin --agents 20 --duration 120 --report perf.json
+#
+# The servers run with their settings and data in a scratch directory (--work-dir, kept with --keep-work-dir),
+# and take the default domain ports, so no other domain can be running on the host.
+#
+
+import argparse, gzip, json, math, os, random, re, shutil, struct, subprocess, sys, tempfile, time, uuid, wave
+import urllib.error, urllib.request
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_AGENT_SCRIPT = os.path.join(SCRIPT_DIR, "perfAgent.js")
+DEFAULT_THRESHOLDS = os.path.join(SCRIPT_DIR, "thresholds.json")
+DEFAULT_DOMAIN = "http://localhost:40100"
+
+# the number of assignment-clients forked for the mixers and servers of the domain
+MIXER_CLIENTS = 6
+AGENT_ASSIGNMENT_TYPE = "2"
+
+PERCENTILES = [50, 95, 99]
+
+
+class DomainServer:
+    def __init__(self, url):
+        self.url = url.rstrip("/")
+
+    def request(self, path, data=None, headers={}):
+        request = urllib.request.Request(self.url + path, data=data, headers=headers)
+        with urllib.request.urlopen(request, timeout=10) as response:
+            return response.read()
+
+    def getJSON(self, path):
+        return json.loads(self.request(path).decode("utf-8"))
+
+    def isUp(self):
+        try:
+            self.request("/nodes.json")
+            return True
+        except (urllib.error.URLError, OSError):
+            return False
+
+    def waitUntilUp(self, timeout):
+        deadline = time.time() + timeout
+        while not self.isUp():
+            if time.time() > deadline:
+                raise RuntimeError("the domain-server at %s did not come up" % self.url)
+            time.sleep(0.5)
+
+    def postSettings(self, settings):
+        self.request("/settings.json", json.dumps(settings).encode("utf-8"), {"Content-Type": "application/json"})
+
+    def deployScript(self, script, instances):
+        # the same multipart form as the domain-server's assignment page
+        boundary = "----68696768666964656c697479"
+        body = ("--" + boundary + "\r\n"
+                + "Content-Disposition:form-data; name=\"file\"; filename=\"script.js\"\r\n"
+                + "Content-type: application/javascript\r\n\r\n"
+                + script + "\r\n"
+                + "--" + boundary + "--\r\n").encode("utf-8")
+        self.request("/assignment", body, {
+            "Content-Type": "multipart/form-data; boundary=" + boundary,
+            "ASSIGNMENT-INSTANCES": str(instances)
+        })
+
+    def findNodes(self, nodeType):
+        return [node for node in self.getJSON("/nodes.json")["nodes"] if node.get("type") == nodeType]
+
+    def getMetrics(self):
+        return parseMetrics(self.request("/metrics").decode("utf-8"))
+
+
+class Processes:
+    def __init__(self, binDir, workDir):
+        self.binDir = binDir
+        self.logDir = os.path.join(workDir, "logs")
+        os.makedirs(self.logDir, exist_ok=True)
+        self.processes = []
+
+        # keep the settings and data of the servers out of the user's, and start from scratch every run
+        home = os.path.join(workDir, "home")
+        self.env = dict(os.environ)
+        self.env.update({
+            "HOME": home,
+            "XDG_CONFIG_HOME": os.path.join(home, "config"),
+            "XDG_DATA_HOME": os.path.join(home, "data"),
+            "XDG_CACHE_HOME": os.path.join(home, "cache"),
+            "APPDATA": os.path.join(home, "AppData", "Roaming"),
+            "LOCALAPPDATA": os.path.join(home, "AppData", "Local"),
+        })
+
+    def executable(self, name):
+        for candidate in [name, name + ".exe"]:
+            for directory in [self.binDir, os.path.join(self.binDir, name), os.path.join(self.binDir, name, "Release")]:
+                path = os.path.join(directory, candidate)
+                if os.path.isfile(path):
+                    return path
+        raise RuntimeError("no %s in %s" % (name, self.binDir))
+
+    def start(self, logName, name, arguments):
+        log = open(os.path.join(self.logDir, logName + ".log"), "w")
+        process = subprocess.Popen([self.executable(name)] + arguments, env=self.env,
+                                   stdout=log, stderr=subprocess.STDOUT, cwd=os.path.dirname(self.executable(name)))
+        self.processes.append((process, log))
+        return process
+
+    def checkAlive(self):
+        for process, log in self.processes:
+            if process.poll() is not None:
+                raise RuntimeError("%s exited with %d, see %s" % (process.args[0], process.returncode, log.name))
+
+    def stopAll(self):
+        # in reverse, so the assignment-clients don't try to find the domain-server again
+        for process, _ in reversed(self.processes):
+            if process.poll() is None:
+                process.terminate()
+        for process, log in reversed(self.processes):
+            try:
+                process.wait(timeout=10)
+            except subprocess.TimeoutExpired:
+                process.kill()
+                process.wait()
+            log.close()
+        self.processes = []
+
+
+def writeReferenceContent(path, seed=1):
+    # a fixed grid of boxes and spheres, some of them spinning, so that every run loads the same entities
+    random.seed(seed)
+    entities = []
+    for x in range(-10, 10):
+        for z in range(-10, 10):
+            spinning = (x + z) % 4 == 0
+            entities.append({
+                "id": "{%s}" % uuid.UUID(int=random.getrandbits(128)),
+                "type": "Box" if (x * z) % 2 == 0 else "Sphere",
+                "position": {"x": x * 2.5, "y": random.uniform(0.5, 3.0), "z": z * 2.5},
+                "dimensions": {"x": 0.5, "y": 0.5, "z": 0.5},
+                "color": {"red": random.randint(0, 255), "green": random.randint(0, 255), "blue": random.randint(0, 255)},
+                "angularVelocity": {"x": 0, "y": 1.0 if spinning else 0, "z": 0},
+                "angularDamping": 0,
+                "collisionless": True,
+                "dynamic": False
+            })
+    with gzip.open(path, "wt") as contentFile:
+        json.dump({"Entities": entities}, contentFile)
+
+
+def writeVoiceClip(path, seconds=10.0, sampleRate=24000):
+    # a speech-like signal: a few harmonics with a wandering pitch, in syllables separated by pauses
+    samples = bytearray()
+    for i in range(int(seconds * sampleRate)):
+        t = i / sampleRate
+        syllable = t % 0.4
+        envelope = math.sin(math.pi * syllable / 0.3) if syllable < 0.3 else 0.0
+        pitch = 140 + 30 * math.sin(2 * math.pi * 0.7 * t)
+        value = sum(math.sin(2 * math.pi * pitch * harmonic * t) / harmonic for harmonic in range(1, 5))
+        samples += struct.pack("<h", int(8000 * envelope * value / 2.1))
+    with wave.open(path, "wb") as waveFile:
+        waveFile.setnchannels(1)
+        waveFile.setsampwidth(2)
+        waveFile.setframerate(sampleRate)
+        waveFile.writeframes(bytes(samples))
+
+
+def toURL(path):
+    if re.match(r"^[a-z]+://", path):
+        return path
+    return "file:///" + os.path.abspath(path).replace("\\", "/").lstrip("/")
+
+
+LABEL_PATTERN = re.compile(r'(\w+)="((?:[^"\\]|\\.)*)"')
+
+
+def parseMetrics(text):
+    # the samples of the Prometheus text format, as (name, labels, value)
+    samples = []
+    for line in text.splitlines():
+        if not line or line.startswith("#"):
+            continue
+        if "{" in line:
+            name, rest = line.split("{", 1)
+            labelText, valueText = rest.rsplit("}", 1)
+            labels = dict(LABEL_PATTERN.findall(labelText))
+        else:
+            name, valueText = line.split(" ", 1)
+            labels = {}
+        try:
+            samples.append((name, labels, float(valueText.split()[0])))
+        except (ValueError, IndexError):
+            continue
+    return samples
+
+
+def seriesName(name, labels):
+    # the name of a series within its node, e.g. hifi_audio_mixer_stage_seconds{stage=mix}
+    own = sorted((key, value) for key, value in labels.items() if key not in ("node_type", "node_id", "le"))
+    if not own:
+        return name
+    return name + "{" + ",".join("%s=%s" % pair for pair in own) + "}"
+
+
+def histogramBuckets(samples):
+    # {(node_type, node_id, series): {le: cumulative count}}
+    buckets = {}
+    for name, labels, value in samples:
+        if name.endswith("_bucket") and "le" in labels:
+            key = (labels.get("node_type"), labels.get("node_id"), seriesName(name[:-len("_bucket")], labels))
+            bound = math.inf if labels["le"] == "+Inf" else float(labels["le"])
+            buckets.setdefault(key, {})[bound] = value
+    return buckets
+
+
+def gauges(samples, name):
+    # {(node_type, node_id, series): value}
+    return {(labels.get("node_type"), labels.get("node_id"), seriesName(name, labels)): value
+            for sampleName, labels, value in samples if sampleName == name}
+
+
+def percentile(buckets, q):
+    # interpolated within the bucket the rank falls in, as Prometheus' histogram_quantile does
+    bounds = sorted(buckets)
+    total = buckets[bounds[-1]] if bounds else 0
+    if total <= 0:
+        return None
+    rank = q * total
+    lowerBound, lowerCount = 0.0, 0.0
+    for bound in bounds:
+        count = buckets[bound]
+        if count >= rank:
+            if math.isinf(bound):
+                return lowerBound
+            if count == lowerCount:
+                return bound
+            return lowerBound + (bound - lowerBound) * (rank - lowerCount) / (count - lowerCount)
+        lowerBound, lowerCount = bound, count
+    return lowerBound
+
+
+def summarize(values):
+    if not values:
+        return None
+    return {"mean": sum(values) / len(values), "max": max(values), "min": min(values)}
+
+
+def analyze(baseline, snapshots, final):
+    # the metrics of each node type over the measured period: histogram percentiles from the growth of the buckets,
+    # rates from the growth of the CPU time, and the gauges over all the samples
+    report = {}
+
+    def nodeType(key):
+        return report.setdefault(key[0] or "unknown", {"nodes": set()})
+
+    startBuckets = histogramBuckets(baseline[1])
+    merged = {}
+    for key, buckets in histogramBuckets(final[1]).items():
+        start = startBuckets.get(key, {})
+        deltas = merged.setdefault((key[0], key[2]), {})
+        for bound, count in buckets.items():
+            # a node that restarted counts from zero again
+            delta = count - start.get(bound, 0)
+            deltas[bound] = deltas.get(bound, 0) + (delta if delta >= 0 else count)
+    for (typeName, series), buckets in merged.items():
+        metrics = nodeType((typeName,))
+        total = buckets.get(math.inf, 0)
+        metrics[series + ".count"] = total
+        for q in PERCENTILES:
+            metrics["%s.p%d" % (series, q)] = percentile(buckets, q / 100.0)
+
+    cpuPercent, residentMB, inboundKbps, outboundKbps = {}, {}, {}, {}
+    allSnapshots = [baseline] + snapshots + [final]
+    for (previousTime, previous), (currentTime, current) in zip(allSnapshots, allSnapshots[1:]):
+        previousCPU = gauges(previous, "hifi_process_cpu_seconds")
+        for key, seconds in gauges(current, "hifi_process_cpu_seconds").items():
+            if key in previousCPU and seconds >= previousCPU[key] and currentTime > previousTime:
+                usage = 100.0 * (seconds - previousCPU[key]) / (currentTime - previousTime)
+                cpuPercent.setdefault(key[0], []).append(usage)
+    for _, samples in snapshots + [final]:
+        for key, value in gauges(samples, "hifi_process_resident_bytes").items():
+            residentMB.setdefault(key[0], []).append(value / (1024 * 1024))
+            nodeType(key)["nodes"].add(key[1])
+        for key, value in gauges(samples, "hifi_network_bytes_per_second").items():
+            kbps = value * 8 / 1000
+            if "direction=in" in key[2]:
+                inboundKbps.setdefault(key[0], []).append(kbps)
+            else:
+                outboundKbps.setdefault(key[0], []).append(kbps)
+            nodeType(key)["nodes"].add(key[1])
+
+    for name, valuesByType in [("cpu_percent", cpuPercent), ("resident_mb", residentMB),
+                               ("inbound_kbps", inboundKbps), ("outbound_kbps", outboundKbps)]:
+        for typeName, values in valuesByType.items():
+            for statistic, value in (summarize(values) or {}).items():
+                nodeType((typeName,))["%s.%s" % (name, statistic)] = value
+
+    for metrics in report.values():
+        metrics["nodes"] = len(metrics["nodes"])
+    return report
+
+
+def checkThresholds(report, thresholds):
+    checks = []
+    for typeName, limits in sorted(thresholds.items()):
+        for metric, limit in sorted(limits.items()):
+            value = report.get(typeName, {}).get(metric)
+            passed = value is not None
+            if passed and "max" in limit:
+                passed = value <= limit["max"]
+            if passed and "min" in limit:
+                passed = value >= limit["min"]
+            checks.append({
+                "node_type": typeName,
+                "metric": metric,
+                "value": value,
+                "threshold": limit,
+                "passed": passed
+            })
+    return checks
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a local domain under load and check its performance.")
+    parser.add_argument("--bin-dir", required=True, help="directory with the domain-server and assignment-client builds")
+    parser.add_argument("--agents", type=int, default=20, help="number of headless avatars to deploy")
+    parser.add_argument("--warmup", type=float, default=30.0, help="seconds to let the agents connect before measuring")
+    parser.add_argument("--duration", type=float, default=120.0, help="seconds to measure for")
+    parser.add_argument("--interval", type=float, default=5.0, help="seconds between samples")
+    parser.add_argument("--content", help="entities file (.json.gz) to restore, instead of the generated reference set")
+    parser.add_argument("--recording", help="recording (.hfr) path or URL for the agents to play back")
+    parser.add_argument("--sound", help="voice clip (.wav) path or URL for the agents to inject, instead of a generated one")
+    parser.add_argument("--script", default=DEFAULT_AGENT_SCRIPT, help="AC script to deploy for each agent")
+    parser.add_argument("--thresholds", default=DEFAULT_THRESHOLDS, help="JSON file with the limits of each node type")
+    parser.add_argument("--report", default="domain-perf.json", help="write the report to this JSON file")
+    parser.add_argument("--work-dir", help="scratch directory for the servers' settings, data and logs")
+    parser.add_argument("--keep-work-dir", action="store_true", help="do not delete the scratch directory")
+    args = parser.parse_args()
+
+    workDir = os.path.abspath(args.work_dir) if args.work_dir else tempfile.mkdtemp(prefix="domain-perf-")
+    os.makedirs(workDir, exist_ok=True)
+    domain = DomainServer(DEFAULT_DOMAIN)
+    if domain.isUp():
+        print("a domain-server is already running at %s" % DEFAULT_DOMAIN)
+        return 2
+
+    processes = Processes(os.path.abspath(args.bin_dir), workDir)
+    try:
+        processes.start("domain-server", "domain-server", [])
+        domain.waitUntilUp(60)
+
+        # restore the content, the domain-server restarts to hand the new path to the entity server
+        contentPath = os.path.join(workDir, "models.json.gz")
+        if args.content:
+            shutil.copyfile(args.content, contentPath)
+        else:
+            writeReferenceContent(contentPath)
+        domain.postSettings({"entity_server_settings": {"persistFilePath": contentPath}})
+        time.sleep(3)
+        domain.waitUntilUp(60)
+
+        processes.start("assignment-client-mixers", "assignment-client", ["-n", str(MIXER_CLIENTS)])
+        processes.start("assignment-client-agents", "assignment-client",
+                        ["-t", AGENT_ASSIGNMENT_TYPE, "-n", str(args.agents)])
+
+        deadline = time.time() + 60
+        while not all(domain.findNodes(nodeType) for nodeType in ["audio-mixer", "avatar-mixer", "entity-server"]):
+            processes.checkAlive()
+            if time.time() > deadline:
+                raise RuntimeError("the mixers did not connect to the domain")
+            time.sleep(1)
+
+        soundPath = args.sound
+        if not soundPath:
+            soundPath = os.path.join(workDir, "voice.wav")
+            writeVoiceClip(soundPath)
+        config = {
+            "recording": toURL(args.recording) if args.recording else None,
+            "sound": toURL(soundPath)
+        }
+        with open(args.script, "r") as scriptFile:
+            script = "var PERF_CONFIG = %s;\n%s" % (json.dumps(config), scriptFile.read())
+        domain.deployScript(script, args.agents)
+        print("deployed %d agents, warming up for %.0f seconds" % (args.agents, args.warmup))
+
+        time.sleep(args.warmup)
+        processes.checkAlive()
+        baseline = (time.time(), domain.getMetrics())
+
+        snapshots = []
+        end = baseline[0] + args.duration
+        while time.time() + args.interval < end:
+            time.sleep(args.interval)
+            processes.checkAlive()
+            snapshots.append((time.time(), domain.getMetrics()))
+            print("%.0f s, %d agents" % (snapshots[-1][0] - baseline[0], len(domain.findNodes("agent"))))
+        time.sleep(max(0.0, end - time.time()))
+        final = (time.time(), domain.getMetrics())
+    finally:
+        processes.stopAll()
+
+    metrics = analyze(baseline, snapshots, final)
+    with open(args.thresholds, "r") as thresholdsFile:
+        thresholds = json.load(thresholdsFile)
+    # every agent must have stayed connected
+    thresholds.setdefault("agent", {}).setdefault("nodes", {"min": args.agents})
+    checks = checkThresholds(metrics, thresholds)
+    passed = all(check["passed"] for check in checks)
+
+    with open(args.report, "w") as reportFile:
+        json.dump({
+            "config": {
+                "agents": args.agents,
+                "warmup_seconds": args.warmup,
+                "duration_seconds": final[0] - baseline[0],
+                "content": args.content or "reference",
+                "recording": args.recording,
+                "sound": args.sound or "generated"
+            },
+            "metrics": metrics,
+            "checks": checks,
+            "passed": passed
+        }, reportFile, indent=2, sort_keys=True)
+
+    for check in checks:
+        if not check["passed"]:
+            print("FAILED %s %s = %s, threshold %s" % (check["node_type"], check["metric"], check["value"],
+                                                        json.dumps(check["threshold"])))
+    print("%s, report written to %s" % ("passed" if passed else "failed", args.report))
+
+    if not args.keep_work_dir and not args.work_dir:
+        shutil.rmtree(workDir, ignore_errors=True)
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
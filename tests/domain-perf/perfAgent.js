@@ -0,0 +1,82 @@
+//
+//  perfAgent.js
+//  tests/domain-perf
+//
+//  Created by High Fidelity on 10/15/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  A headless avatar for the domain performance suite. Each instance plays back a recorded clip (or walks a circle
+//  around the domain center swinging its joints, when no clip is given) and keeps a voice clip looping into the audio
+//  mixer. domain-perf.py prepends the PERF_CONFIG this script reads before deploying it.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+var config = (typeof PERF_CONFIG !== "undefined") ? PERF_CONFIG : {};
+
+var CENTER = { x: 0, y: 1.0, z: 0 };
+var MIN_RADIUS = 2.0;   // m
+var MAX_RADIUS = 20.0;  // m
+var WALK_SPEED = 1.2;   // m/s
+var SWING_RATE = 1.5;   // swings per second
+var SWINGING_JOINTS = [
+    { name: "LeftUpLeg", axis: Vec3.UNIT_X, amplitude: 25 },
+    { name: "RightUpLeg", axis: Vec3.UNIT_X, amplitude: -25 },
+    { name: "LeftArm", axis: Vec3.UNIT_X, amplitude: -20 },
+    { name: "RightArm", axis: Vec3.UNIT_X, amplitude: 20 },
+    { name: "Head", axis: Vec3.UNIT_Y, amplitude: 20 }
+];
+
+function randomBetween(min, max) {
+    return Math.random() * (max - min) + min;
+}
+
+var radius = randomBetween(MIN_RADIUS, MAX_RADIUS);
+var angle = randomBetween(0, 2 * Math.PI);
+var phase = randomBetween(0, 2 * Math.PI);
+var time = 0.0;
+
+Avatar.displayName = "perf agent " + Math.floor(randomBetween(0, 100000));
+Avatar.position = Vec3.sum(CENTER, { x: radius * Math.cos(angle), y: 0, z: radius * Math.sin(angle) });
+Agent.isAvatar = true;
+
+var isPlayingRecording = false;
+if (config.recording) {
+    // start each agent at a different point of the clip, so that they don't all move in lockstep
+    isPlayingRecording = Recording.loadRecording(config.recording);
+    if (isPlayingRecording) {
+        Recording.setPlayFromCurrentLocation(true);
+        Recording.setPlayerUseDisplayName(false);
+        Recording.setPlayerLoop(true);
+        Recording.setPlayerTime(randomBetween(0, Recording.playerLength()));
+        Recording.startPlaying();
+    } else {
+        print("perfAgent: could not load " + config.recording + ", walking instead");
+    }
+}
+
+var voice = config.sound ? SoundCache.getSound(config.sound) : null;
+
+function update(deltaTime) {
+    time += deltaTime;
+
+    if (voice && voice.downloaded && !Agent.isPlayingAvatarSound) {
+        Agent.playAvatarSound(voice);
+    }
+
+    if (isPlayingRecording) {
+        return;
+    }
+
+    angle += (WALK_SPEED / radius) * deltaTime;
+    Avatar.position = Vec3.sum(CENTER, { x: radius * Math.cos(angle), y: 0, z: radius * Math.sin(angle) });
+    Avatar.orientation = Quat.fromPitchYawRollRadians(0, -angle, 0);
+
+    var swing = Math.sin(2 * Math.PI * SWING_RATE * time + phase);
+    SWINGING_JOINTS.forEach(function (joint) {
+        Avatar.setJointRotation(joint.name, Quat.angleAxis(joint.amplitude * swing, joint.axis));
+    });
+}
+
+Script.update.connect(update);
@@ -0,0 +1,261 @@
+//
+//  main.cpp
+//  tests/entities-perf/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Measures how fast the entity server side serializes a domain: the scenes it encodes for clients with different views,
+//  and each entity's bitstream encoded and read back, in entities per second, bytes per entity and allocations per
+//  entity, so the serialization cost can be compared from release to release.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+#include <EntityItemProperties.h>
+#include <EntityNodeData.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <EntityTypes.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+// every allocation of the process is counted, the phases below read the counter before and after they run
+static std::atomic<uint64_t> allocationCount { 0 };
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* pointer = malloc(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+// entities are scattered over a region of this size, around the origin
+const float WORLD_SIZE = 1000.0f; // meters
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * ((float)qrand() / (float)RAND_MAX);
+}
+
+static glm::vec3 randomPosition() {
+    float halfSize = WORLD_SIZE / 2.0f;
+    return glm::vec3(randomFloat(-halfSize, halfSize), randomFloat(-halfSize, halfSize), randomFloat(-halfSize, halfSize));
+}
+
+static void addSyntheticEntities(EntityTreePointer tree, int numEntities) {
+    tree->withWriteLock([&] {
+        for (int i = 0; i < numEntities; i++) {
+            EntityItemProperties properties;
+            properties.setType(i % 2 ? EntityTypes::Box : EntityTypes::Sphere);
+            properties.setName("entity " + QString::number(i));
+            properties.setPosition(randomPosition());
+            properties.setRotation(glm::angleAxis(randomFloat(0.0f, TWO_PI), glm::vec3(0.0f, 1.0f, 0.0f)));
+            // mostly small entities, with a few large ones that the octree keeps near its root
+            float size = (qrand() % 20 == 0) ? randomFloat(20.0f, 200.0f) : randomFloat(0.1f, 5.0f);
+            properties.setDimensions(glm::vec3(size, randomFloat(0.1f, 5.0f), size));
+            properties.setColor({ (uint8_t)(qrand() % 256), (uint8_t)(qrand() % 256), (uint8_t)(qrand() % 256) });
+            properties.setUserData("{ \"grabbableKey\": { \"grabbable\": true } }");
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        }
+    });
+}
+
+class Measurement {
+public:
+    void start() {
+        _startAllocations = allocationCount;
+        _startTime = usecTimestampNow();
+    }
+
+    void stop(int numEntities, int numBytes) {
+        _usecs += usecTimestampNow() - _startTime;
+        _allocations += allocationCount - _startAllocations;
+        _entities += numEntities;
+        _bytes += numBytes;
+    }
+
+    void report(const char* name) const {
+        double seconds = (double)_usecs / USECS_PER_SECOND;
+        double entities = (double)std::max(_entities, (quint64)1);
+        qDebug().noquote() << QString("%1: %2 entities/sec, %3 bytes/entity, %4 allocations/entity (%5 entities in %6 s)")
+            .arg(name, -24)
+            .arg(seconds > 0.0 ? _entities / seconds : 0.0, 0, 'f', 0)
+            .arg(_bytes / entities, 0, 'f', 1)
+            .arg(_allocations / entities, 0, 'f', 2)
+            .arg(_entities)
+            .arg(seconds, 0, 'f', 3);
+    }
+
+private:
+    quint64 _startTime { 0 };
+    uint64_t _startAllocations { 0 };
+    quint64 _usecs { 0 };
+    uint64_t _allocations { 0 };
+    quint64 _entities { 0 };
+    quint64 _bytes { 0 };
+};
+
+// a client at a random point of the world, looking in a random direction
+static std::unique_ptr<EntityNodeData> createClient() {
+    std::unique_ptr<EntityNodeData> nodeData { new EntityNodeData() };
+    nodeData->init();
+    nodeData->setCameraPosition(randomPosition());
+    nodeData->setCameraOrientation(glm::angleAxis(randomFloat(0.0f, TWO_PI), glm::vec3(0.0f, 1.0f, 0.0f)) *
+        glm::angleAxis(randomFloat(-0.5f, 0.5f), glm::vec3(1.0f, 0.0f, 0.0f)));
+    nodeData->setCameraFov(DEFAULT_FIELD_OF_VIEW_DEGREES);
+    nodeData->setCameraAspectRatio(DEFAULT_ASPECT_RATIO);
+    nodeData->setCameraNearClip(DEFAULT_NEAR_CLIP);
+    nodeData->setCameraFarClip(DEFAULT_FAR_CLIP);
+    nodeData->setCameraCenterRadius(DEFAULT_CENTER_SPHERE_RADIUS);
+    nodeData->updateCurrentViewFrustum();
+    return nodeData;
+}
+
+// encodes the whole scene in the client's view into packets the way the octree send thread does, without sending them
+static void encodeScene(EntityTreePointer tree, EntityNodeData& nodeData, int& numEntities, int& numBytes) {
+    OctreePacketData packetData(true);
+    nodeData.elementBag.deleteAll();
+    nodeData.elementBag.insert(tree->getRoot());
+    tree->releaseSceneEncodeData(&nodeData.extraEncodeData);
+
+    tree->withReadLock([&] {
+        while (!nodeData.elementBag.isEmpty()) {
+            OctreeElementPointer subTree = nodeData.elementBag.extract();
+            if (!subTree) {
+                continue;
+            }
+
+            EncodeBitstreamParams params(INT_MAX, WANT_EXISTS_BITS, DONT_CHOP, false, NO_BOUNDARY_ADJUST,
+                                         nodeData.getOctreeSizeScale(), IGNORE_LAST_SENT, true, IGNORE_SCENE_STATS,
+                                         IGNORE_JURISDICTION_MAP, &nodeData.extraEncodeData, true, &nodeData);
+            nodeData.copyCurrentViewFrustum(params.viewFrustum);
+            params.trackSend = [&](const QUuid&, quint64) {
+                numEntities++;
+            };
+
+            tree->encodeTreeBitstream(subTree, &packetData, nodeData.elementBag, params);
+
+            if (params.stopReason == EncodeBitstreamParams::DIDNT_FIT || nodeData.elementBag.isEmpty()) {
+                if (packetData.hasContent()) {
+                    numBytes += packetData.getFinalizedSize();
+                }
+                packetData.reset();
+            }
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the entity server's encoding of entities for its clients.");
+    parser.addHelpOption();
+    const QCommandLineOption entitiesOption("entities", "number of synthetic entities", "count", "10000");
+    const QCommandLineOption clientsOption("clients", "number of clients, each with its own view", "count", "16");
+    const QCommandLineOption iterationsOption("iterations", "number of times each measurement is repeated", "count", "3");
+    const QCommandLineOption persistOption("persist", "an entities persist file to load instead of synthetic entities",
+        "path");
+    parser.addOptions({ entitiesOption, clientsOption, iterationsOption, persistOption });
+    parser.process(app);
+
+    int numClients = std::max(parser.value(clientsOption).toInt(), 1);
+    int numIterations = std::max(parser.value(iterationsOption).toInt(), 1);
+
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+    qsrand(1);
+
+    EntityTreePointer tree = std::make_shared<EntityTree>(true);
+    tree->createRootElement();
+    tree->setIsServer(true);
+    if (parser.isSet(persistOption)) {
+        QString path = parser.value(persistOption);
+        if (!tree->readFromFile(qPrintable(path))) {
+            qWarning() << "Failed to load" << path;
+            return 1;
+        }
+    } else {
+        addSyntheticEntities(tree, parser.value(entitiesOption).toInt());
+    }
+
+    QVector<EntityItemPointer> entities;
+    tree->withReadLock([&] {
+        for (const auto& entityID : tree->getEntityIDs()) {
+            EntityItemPointer entity = tree->findEntityByEntityItemID(entityID);
+            if (entity) {
+                entities.push_back(entity);
+            }
+        }
+    });
+    qDebug() << "Domain of" << entities.size() << "entities," << numClients << "clients," << numIterations << "iterations";
+
+    // the scenes of the clients, the first one encodes each entity and the others mostly re-send its cached encoding
+    std::vector<std::unique_ptr<EntityNodeData>> clients;
+    for (int i = 0; i < numClients; i++) {
+        clients.push_back(createClient());
+    }
+    Measurement firstScene;
+    Measurement otherScenes;
+    for (int iteration = 0; iteration < numIterations; iteration++) {
+        for (size_t i = 0; i < clients.size(); i++) {
+            Measurement& measurement = (iteration == 0 && i == 0) ? firstScene : otherScenes;
+            int numEntities = 0;
+            int numBytes = 0;
+            measurement.start();
+            encodeScene(tree, *clients[i], numEntities, numBytes);
+            measurement.stop(numEntities, numBytes);
+        }
+    }
+    firstScene.report("scene, first client");
+    otherScenes.report("scene, other clients");
+
+    // each entity encoded and read back into a new entity of its type, the way a client reads an entity it didn't have
+    ReadBitstreamToTreeParams readParams;
+    readParams.bitstreamVersion = versionForPacketType(PacketType::EntityData);
+    Measurement encode;
+    Measurement decode;
+    OctreePacketData packetData(false);
+    for (int iteration = 0; iteration < numIterations; iteration++) {
+        for (const auto& entity : entities) {
+            EncodeBitstreamParams params;
+            auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+            packetData.reset();
+
+            encode.start();
+            entity->appendEntityData(&packetData, params, extraEncodeData);
+            encode.stop(1, packetData.getUncompressedSize());
+
+            EntityItemPointer copy = EntityTypes::constructEntityItem(entity->getType(), entity->getEntityItemID(),
+                                                                      EntityItemProperties());
+            decode.start();
+            int bytesRead = copy->readEntityDataFromBuffer(packetData.getUncompressedData(),
+                                                           packetData.getUncompressedSize(), readParams);
+            decode.stop(1, bytesRead);
+        }
+    }
+    encode.report("appendEntityData");
+    decode.report("readEntityDataFromBuffer");
+
+    tree->withWriteLock([&] {
+        tree->eraseAllOctreeElements();
+    });
+    return 0;
+}
@@ -0,0 +1,73 @@
+//
+//  ByteRangeTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ByteRangeTests.h"
+
+#include <QtCore/QTemporaryFile>
+
+#include <ByteRange.h>
+#include <FileResourceRequest.h>
+
+QTEST_MAIN(ByteRangeTests)
+
+void ByteRangeTests::fixupRange() {
+    QVERIFY(!ByteRange().isSet());
+
+    ByteRange range { 10, 20 };
+    QVERIFY(range.isSet());
+    range.fixupRange(100);
+    QCOMPARE(range.fromInclusive, (int64_t)10);
+    QCOMPARE(range.toExclusive, (int64_t)20);
+
+    // past the end of the resource
+    range = { 90, 120 };
+    range.fixupRange(100);
+    QCOMPARE(range.fromInclusive, (int64_t)90);
+    QCOMPARE(range.size(), (int64_t)10);
+
+    range = { 150, 200 };
+    range.fixupRange(100);
+    QCOMPARE(range.size(), (int64_t)0);
+
+    // the last bytes of the resource
+    range = { -30, 0 };
+    QVERIFY(range.isSet());
+    range.fixupRange(100);
+    QCOMPARE(range.fromInclusive, (int64_t)70);
+    QCOMPARE(range.toExclusive, (int64_t)100);
+
+    range = { -300, 0 };
+    range.fixupRange(100);
+    QCOMPARE(range.fromInclusive, (int64_t)0);
+    QCOMPARE(range.size(), (int64_t)100);
+}
+
+void ByteRangeTests::fileRangeRequest() {
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray content { "0123456789abcdefghij" };
+    file.write(content);
+    file.close();
+
+    FileResourceRequest request { QUrl::fromLocalFile(file.fileName()) };
+    request.setByteRange({ -5, 0 });
+    request.send();
+
+    QCOMPARE(request.getResult(), ResourceRequest::Success);
+    QCOMPARE(request.getData(), content.right(5));
+    QCOMPARE(request.getTotalSizeOfResource(), (int64_t)content.size());
+
+    FileResourceRequest firstRequest { QUrl::fromLocalFile(file.fileName()) };
+    firstRequest.setByteRange({ 2, 6 });
+    firstRequest.send();
+
+    QCOMPARE(firstRequest.getData(), content.mid(2, 4));
+}
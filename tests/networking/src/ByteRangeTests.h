@@ -0,0 +1,24 @@
+//
+//  ByteRangeTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ByteRangeTests_h
+#define hifi_ByteRangeTests_h
+
+#include <QtTest/QtTest>
+
+class ByteRangeTests : public QObject {
+    Q_OBJECT
+private slots:
+    void fixupRange();
+    void fileRangeRequest();
+};
+
+#endif // hifi_ByteRangeTests_h
@@ -0,0 +1,234 @@
+//
+//  CongestionControlTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CongestionControlTests.h"
+
+#include <queue>
+#include <random>
+#include <set>
+
+#include <udt/BBRCC.h>
+
+QTEST_MAIN(CongestionControlTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+namespace {
+
+// exposes the window and pacing a congestion control decided on
+template <class T> class TestCC : public T {
+public:
+    void start(SequenceNumber seqNum) { this->setInitialSendSequenceNumber(seqNum); }
+    int window() const { return this->_congestionWindowSize; }
+    double sendPeriod() const { return this->_packetSendPeriod; }
+};
+
+const int64_t USECS_PER_SECOND = 1000 * 1000;
+
+p_high_resolution_clock::time_point timePoint(int64_t usecs) {
+    return p_high_resolution_clock::time_point(microseconds(usecs));
+}
+
+// A sender and receiver on either side of a bottleneck link, in simulated time
+//   Packets queue for the bottleneck (and are dropped when its queue is full), suffer random loss,
+//   and are ACKed cumulatively with the last in-order sequence number, like udt::Connection does.
+//   The receiver NAKs the gaps it sees, and the sender re-transmits them ahead of new data.
+struct LinkEmulator {
+    LinkEmulator(double bandwidth, int64_t oneWayDelay, double lossRate, int queueLimit) :
+        bandwidth(bandwidth), oneWayDelay(oneWayDelay), lossRate(lossRate), queueLimit(queueLimit) {}
+
+    double bandwidth; // packets per second
+    int64_t oneWayDelay; // usecs
+    double lossRate;
+    int queueLimit; // packets
+
+    // optionally, the bottleneck bandwidth changes part way through
+    int64_t bandwidthChangeTime { -1 };
+    double changedBandwidth { 0.0 };
+
+    int64_t delivered { 0 }; // in-order packets at the receiver, after measureFrom
+    int64_t maxQueueDelay { 0 }; // usecs, after measureFrom
+
+    template <class CC> void run(CC& cc, int64_t duration, int64_t measureFrom = 0) {
+        enum class Type { Data, ACK, NAK };
+        struct Event {
+            int64_t time;
+            Type type;
+            uint32_t seq;
+            uint32_t lastSeq; // a NAK covers seq to lastSeq
+            bool operator>(const Event& other) const { return time > other.time; }
+        };
+        std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<double> distribution;
+
+        const int64_t STEP = 50;
+        const int64_t RETRANSMIT_TIMEOUT = 8 * oneWayDelay + 200000;
+
+        SequenceNumber firstSeq { 1 };
+        cc.start(firstSeq);
+
+        uint32_t nextSeq = 1;
+        uint32_t lastACK = 0;
+        int64_t lastACKTime = 0;
+        int64_t nextSendTime = 0;
+        int64_t bottleneckFreeTime = 0;
+        std::deque<uint32_t> retransmits;
+
+        std::set<uint32_t> outOfOrder;
+        uint32_t receiverLastInOrder = 0;
+        uint32_t receiverHighest = 0;
+        int64_t deliveredAtMeasureStart = -1;
+
+        for (int64_t now = 0; now < duration; now += STEP) {
+            if (now >= measureFrom && deliveredAtMeasureStart < 0) {
+                deliveredAtMeasureStart = (int64_t)receiverLastInOrder;
+            }
+
+            while (!events.empty() && events.top().time <= now) {
+                Event event = events.top();
+                events.pop();
+
+                if (event.type == Type::ACK) {
+                    if (event.seq > lastACK) {
+                        lastACK = event.seq;
+                        lastACKTime = event.time;
+                    }
+                    if (cc.onACK(SequenceNumber { event.seq }, timePoint(event.time))) {
+                        retransmits.push_back(event.seq + 1);
+                    }
+                } else if (event.type == Type::NAK) {
+                    for (uint32_t seq = event.seq; seq <= event.lastSeq; ++seq) {
+                        retransmits.push_back(seq);
+                    }
+                } else {
+                    if (event.seq > receiverHighest + 1) {
+                        events.push({ event.time + oneWayDelay, Type::NAK, receiverHighest + 1, event.seq - 1 });
+                    }
+                    receiverHighest = std::max(receiverHighest, event.seq);
+
+                    if (event.seq == receiverLastInOrder + 1) {
+                        ++receiverLastInOrder;
+                        while (outOfOrder.erase(receiverLastInOrder + 1)) {
+                            ++receiverLastInOrder;
+                        }
+                    } else if (event.seq > receiverLastInOrder) {
+                        outOfOrder.insert(event.seq);
+                    }
+                    events.push({ event.time + oneWayDelay, Type::ACK, receiverLastInOrder, receiverLastInOrder });
+                }
+            }
+
+            if (lastACK + 1 < nextSeq && now - lastACKTime > RETRANSMIT_TIMEOUT) {
+                // nothing has moved for a while, re-send the oldest missing packet
+                retransmits.push_back(lastACK + 1);
+                lastACKTime = now;
+            }
+
+            while (now >= nextSendTime) {
+                uint32_t seq;
+                if (!retransmits.empty()) {
+                    seq = retransmits.front();
+                    retransmits.pop_front();
+                    if (seq <= lastACK) {
+                        continue;
+                    }
+                } else if ((int)(nextSeq - 1 - lastACK) < cc.window()) {
+                    seq = nextSeq++;
+                } else {
+                    break;
+                }
+
+                cc.onPacketSent(MAX_PACKET_SIZE_WITH_UDP_HEADER, SequenceNumber { seq }, timePoint(now));
+                nextSendTime = now + (int64_t)cc.sendPeriod();
+
+                // queue for the bottleneck
+                bool hasChanged = bandwidthChangeTime >= 0 && now >= bandwidthChangeTime;
+                const int64_t SERVICE_TIME = (int64_t)(USECS_PER_SECOND / (hasChanged ? changedBandwidth : bandwidth));
+                int64_t queueDelay = std::max<int64_t>(0, bottleneckFreeTime - now);
+                if (queueDelay / SERVICE_TIME >= queueLimit) {
+                    // tail drop
+                } else {
+                    bottleneckFreeTime = now + queueDelay + SERVICE_TIME;
+                    if (now >= measureFrom) {
+                        maxQueueDelay = std::max(maxQueueDelay, queueDelay);
+                    }
+                    if (distribution(generator) >= lossRate) {
+                        events.push({ bottleneckFreeTime + oneWayDelay, Type::Data, seq, seq });
+                    }
+                }
+
+                if (cc.sendPeriod() > 0.0) {
+                    break;
+                }
+            }
+        }
+
+        delivered = (int64_t)receiverLastInOrder - std::max<int64_t>(0, deliveredAtMeasureStart);
+    }
+};
+
+}
+
+void CongestionControlTests::bbrCleanLinkTest() {
+    // ~24 Mbps with a 50 ms RTT
+    LinkEmulator link { 2000.0, 25000, 0.0, 400 };
+    TestCC<BBRCC> cc;
+
+    const int64_t DURATION = 20 * USECS_PER_SECOND;
+    const int64_t MEASURE_FROM = 5 * USECS_PER_SECOND;
+    link.run(cc, DURATION, MEASURE_FROM);
+
+    double throughput = (double)link.delivered / ((double)(DURATION - MEASURE_FROM) / USECS_PER_SECOND);
+    qDebug() << "clean link throughput" << throughput << "packets/s, max queue delay" << link.maxQueueDelay << "us";
+
+    QVERIFY(throughput > 0.9 * link.bandwidth);
+
+    // should not sit on a full bottleneck queue (400 packets is 200 ms)
+    QVERIFY(link.maxQueueDelay < 100000);
+}
+
+void CongestionControlTests::bbrRandomLossTest() {
+    // the same link, losing 2% of packets at random
+    LinkEmulator link { 2000.0, 25000, 0.02, 400 };
+    TestCC<BBRCC> cc;
+
+    const int64_t DURATION = 20 * USECS_PER_SECOND;
+    const int64_t MEASURE_FROM = 5 * USECS_PER_SECOND;
+    link.run(cc, DURATION, MEASURE_FROM);
+
+    double throughput = (double)link.delivered / ((double)(DURATION - MEASURE_FROM) / USECS_PER_SECOND);
+    qDebug() << "lossy link throughput" << throughput << "packets/s";
+
+    // losing 2% (plus re-transmits) still leaves well over half the link for new data
+    QVERIFY(throughput > 0.6 * link.bandwidth);
+}
+
+void CongestionControlTests::bbrBandwidthDropTest() {
+    // the link drops to a quarter of its bandwidth after 10 seconds
+    LinkEmulator link { 2000.0, 25000, 0.0, 400 };
+    link.bandwidthChangeTime = 10 * USECS_PER_SECOND;
+    link.changedBandwidth = 500.0;
+    TestCC<BBRCC> cc;
+
+    const int64_t DURATION = 30 * USECS_PER_SECOND;
+    const int64_t MEASURE_FROM = 20 * USECS_PER_SECOND;
+    link.run(cc, DURATION, MEASURE_FROM);
+
+    double throughput = (double)link.delivered / ((double)(DURATION - MEASURE_FROM) / USECS_PER_SECOND);
+    qDebug() << "throughput after the drop" << throughput << "packets/s, max queue delay" << link.maxQueueDelay << "us";
+
+    // we should be pacing at the new bandwidth, without keeping the bottleneck queue full (400 packets is 800 ms now)
+    QVERIFY(throughput > 0.9 * link.changedBandwidth);
+    QVERIFY(cc.sendPeriod() > 0.5 * USECS_PER_SECOND / link.changedBandwidth);
+    QVERIFY(link.maxQueueDelay < 400000);
+}
@@ -0,0 +1,32 @@
+//
+//  CongestionControlTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CongestionControlTests_h
+#define hifi_CongestionControlTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class CongestionControlTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test BBR fills a clean link without building a large queue
+    void bbrCleanLinkTest();
+
+    // Test BBR keeps most of the link under random (non-congestion) loss
+    void bbrRandomLossTest();
+
+    // Test BBR backs off when the bottleneck bandwidth drops
+    void bbrBandwidthDropTest();
+};
+
+#endif // hifi_CongestionControlTests_h
@@ -0,0 +1,120 @@
+//
+//  FileCacheTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FileCacheTests.h"
+
+#include <future>
+
+#include <FileCache.h>
+#include <PathUtils.h>
+
+QTEST_MAIN(FileCacheTests)
+
+static const std::string TEST_DIRNAME = "file_cache_tests";
+static const std::string TEST_EXT = "test";
+
+class TestFile : public cache::File {
+public:
+    TestFile(Metadata&& metadata, const std::string& filepath) : cache::File(std::move(metadata), filepath) {}
+};
+
+class TestFileCache : public cache::FileCache {
+public:
+    TestFileCache() : FileCache(TEST_DIRNAME, TEST_EXT) { initialize(); }
+    ~TestFileCache() { stopWriting(); }
+
+    using FileCache::getFile;
+    using FileCache::writeFile;
+
+    cache::FilePointer writeFileAndWait(const QByteArray& data, const Key& key) {
+        std::promise<cache::FilePointer> written;
+        writeFileAsync(data, Metadata(key, data.size()), [&](const cache::FilePointer& file) {
+            written.set_value(file);
+        });
+        return written.get_future().get();
+    }
+
+    void writeFileAsync(const QByteArray& data, Metadata&& metadata, WriteCallback callback) {
+        FileCache::writeFileAsync(data, std::move(metadata), callback);
+    }
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override {
+        return std::unique_ptr<cache::File>(new TestFile(std::move(metadata), filepath));
+    }
+};
+
+static QByteArray readFile(const cache::FilePointer& file) {
+    QFile contents(file->getFilepath().c_str());
+    contents.open(QIODevice::ReadOnly);
+    return contents.readAll();
+}
+
+void FileCacheTests::init() {
+    QDir(PathUtils::getAppLocalDataFilePath(TEST_DIRNAME.c_str())).removeRecursively();
+}
+
+void FileCacheTests::cleanup() {
+    QDir(PathUtils::getAppLocalDataFilePath(TEST_DIRNAME.c_str())).removeRecursively();
+}
+
+void FileCacheTests::asyncWrite() {
+    TestFileCache cache;
+    QByteArray data { "some file content" };
+
+    auto file = cache.writeFileAndWait(data, "first");
+    QVERIFY(file);
+    QCOMPARE(file->getLength(), (size_t)data.size());
+    QCOMPARE(readFile(file), data);
+    QCOMPARE(cache.getFile("first"), file);
+
+    // a file that is already cached is handed over without a write
+    QCOMPARE(cache.writeFileAndWait(data, "first"), file);
+}
+
+void FileCacheTests::mergedAsyncWrites() {
+    TestFileCache cache;
+    QByteArray data { "the same content, written twice" };
+
+    std::promise<cache::FilePointer> first;
+    std::promise<cache::FilePointer> second;
+    cache.writeFileAsync(data, cache::FileCache::Metadata("merged", data.size()), [&](const cache::FilePointer& file) {
+        first.set_value(file);
+    });
+    cache.writeFileAsync(data, cache::FileCache::Metadata("merged", data.size()), [&](const cache::FilePointer& file) {
+        second.set_value(file);
+    });
+
+    auto firstFile = first.get_future().get();
+    auto secondFile = second.get_future().get();
+    QVERIFY(firstFile);
+    QCOMPARE(secondFile, firstFile);
+    QCOMPARE(cache.getNumTotalFiles(), (size_t)1);
+}
+
+void FileCacheTests::manifest() {
+    QByteArray data { "persisted content" };
+    {
+        TestFileCache cache;
+        QVERIFY(cache.writeFile(data.constData(), cache::FileCache::Metadata("persisted", data.size())));
+    }
+
+    // the cache is persisted with a manifest, read instead of the directory when the cache starts again
+    QString manifestPath = QDir(PathUtils::getAppLocalDataFilePath(TEST_DIRNAME.c_str())).filePath("manifest");
+    QVERIFY(QFile::exists(manifestPath));
+
+    TestFileCache cache;
+    QVERIFY(!QFile::exists(manifestPath));
+    auto file = cache.getFile("persisted");
+    QVERIFY(file);
+    QCOMPARE(file->getLength(), (size_t)data.size());
+    QCOMPARE(readFile(file), data);
+}
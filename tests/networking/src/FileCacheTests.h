@@ -0,0 +1,27 @@
+//
+//  FileCacheTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FileCacheTests_h
+#define hifi_FileCacheTests_h
+
+#include <QtTest/QtTest>
+
+class FileCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void asyncWrite();
+    void mergedAsyncWrites();
+    void manifest();
+};
+
+#endif // hifi_FileCacheTests_h
@@ -12,7 +12,15 @@
 #include "PacketTests.h"
 #include "../QTestExtensions.h"
 
+#include <thread>
+
 #include <NLPacket.h>
+#include <NLPacketList.h>
+#include <ReceivedMessage.h>
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+#include <udt/PacketBufferPool.h>
+#include <udt/PacketQueue.h>
 
 QTEST_MAIN(PacketTests)
 
@@ -180,3 +188,158 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::bufferPoolTest() {
+    using udt::PacketBufferPool;
+
+    // prime this thread's free list
+    PacketBufferPool::acquire(PacketBufferPool::BUFFER_SIZE, false);
+    PacketBufferPool::resetStats();
+
+    const char* firstBuffer = nullptr;
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        firstBuffer = packet->getData();
+        packet->write("somedata");
+        QCOMPARE(PacketBufferPool::getStats().outstanding, (uint64_t)1);
+    }
+
+    // the next packet on this thread gets the same buffer back, cleared
+    auto packet = NLPacket::create(PacketType::Unknown);
+    QCOMPARE(packet->getData(), firstBuffer);
+    QCOMPARE(packet->getPayload()[0], '\0');
+
+    auto stats = PacketBufferPool::getStats();
+    QCOMPARE(stats.acquired, (uint64_t)2);
+    QCOMPARE(stats.hits, (uint64_t)2);
+    QCOMPARE(stats.highWaterMark, (uint64_t)1);
+
+    // oversized buffers bypass the pool
+    QVERIFY(PacketBufferPool::acquire(PacketBufferPool::BUFFER_SIZE + 1, false));
+    QCOMPARE(PacketBufferPool::getStats().acquired, (uint64_t)2);
+
+    // other threads recycle through their own free list
+    std::thread([&] {
+        for (int i = 0; i < 1000; ++i) {
+            NLPacket::create(PacketType::Unknown);
+        }
+    }).join();
+    QVERIFY(PacketBufferPool::getStats().hits > stats.hits);
+    QCOMPARE(PacketBufferPool::getStats().outstanding, (uint64_t)1);
+}
+
+void PacketTests::lossListEncodingTest() {
+    using namespace udt;
+
+    // bursty loss, wrapping around the largest sequence number
+    LossList lossList;
+    SequenceNumber first { SequenceNumber::MAX - 5 };
+    lossList.append(first, first + 2);
+    lossList.append(first + 4);
+    lossList.append(first + 10, first + 300);
+    lossList.append(first + 20000, first + 20001);
+
+    auto packet = ControlPacket::create(ControlPacket::TimeoutNAK, ControlPacket::maxPayloadSize());
+    QCOMPARE(lossList.write(*packet), 4);
+
+    // a start/end pair per range would take 32 bytes
+    QCOMPARE(packet->getPayloadSize(), (qint64)14);
+
+    packet->seek(0);
+    LossList readList;
+    readList.read(*packet);
+    QCOMPARE(readList.getLength(), lossList.getLength());
+    QCOMPARE(readList.getNumRanges(), 4);
+    while (!lossList.isEmpty()) {
+        QCOMPARE(readList.popFirstSequenceNumber(), lossList.popFirstSequenceNumber());
+    }
+
+    // the selective ACK sets the bits of the packets that are not lost
+    LossList receiverList;
+    SequenceNumber ack { 100 };
+    receiverList.append(ack + 1, ack + 2);
+    receiverList.append(ack + 5);
+    receiverList.append(ack + 9, ack + 10);
+
+    uint8_t bitmap[2];
+    QCOMPARE(receiverList.getReceivedBitmap(ack + 1, ack + 12, bitmap, 16), 12);
+    QCOMPARE(bitmap[0], (uint8_t)0xEC); // ack + 3, 4, 6, 7, 8
+    QCOMPARE(bitmap[1], (uint8_t)0x0C); // ack + 11, 12
+
+    // and is capped by the bitmap size
+    QCOMPARE(receiverList.getReceivedBitmap(ack + 1, ack + 1000, bitmap, 16), 16);
+}
+
+void PacketTests::latestOnlyPacketTest() {
+    const udt::Packet::StreamKey FIRST_STREAM = 7;
+    const udt::Packet::StreamKey SECOND_STREAM = 8;
+
+    auto packet = NLPacket::createLatestOnly(PacketType::Unknown, FIRST_STREAM);
+    QVERIFY(packet->isLatestOnly());
+    QVERIFY(!packet->isReliable());
+    QCOMPARE(packet->getStreamKey(), FIRST_STREAM);
+
+    packet->writeStreamSequenceNumber(42);
+    packet->write("state");
+    auto readPacket = copyToReadPacket(packet);
+    QVERIFY(readPacket->isLatestOnly());
+    QCOMPARE(readPacket->getStreamKey(), FIRST_STREAM);
+    QCOMPARE(readPacket->getStreamSequenceNumber(), (udt::Packet::StreamSequenceNumber)42);
+    QCOMPARE(readPacket->getType(), PacketType::Unknown);
+
+    // a newer packet replaces the queued one of its stream, in the same place in line
+    udt::PacketQueue queue;
+    QVERIFY(!queue.queueLatestOnlyPacket(NLPacket::createLatestOnly(PacketType::Unknown, FIRST_STREAM)));
+    QVERIFY(!queue.queueLatestOnlyPacket(NLPacket::createLatestOnly(PacketType::Unknown, SECOND_STREAM)));
+    QVERIFY(queue.queueLatestOnlyPacket(NLPacket::createLatestOnly(PacketType::Unknown, FIRST_STREAM)));
+    QVERIFY(queue.isEmpty()); // no reliable packets
+
+    auto first = queue.takeLatestOnlyPacket();
+    QCOMPARE(first->getStreamKey(), FIRST_STREAM);
+    QCOMPARE(first->getStreamSequenceNumber(), (udt::Packet::StreamSequenceNumber)2);
+
+    auto second = queue.takeLatestOnlyPacket();
+    QCOMPARE(second->getStreamKey(), SECOND_STREAM);
+    QCOMPARE(second->getStreamSequenceNumber(), (udt::Packet::StreamSequenceNumber)1);
+
+    QVERIFY(!queue.hasLatestOnlyPackets());
+
+    // once sent, the next packet of a stream is queued again
+    QVERIFY(!queue.queueLatestOnlyPacket(NLPacket::createLatestOnly(PacketType::Unknown, FIRST_STREAM)));
+    QCOMPARE(queue.takeLatestOnlyPacket()->getStreamSequenceNumber(), (udt::Packet::StreamSequenceNumber)3);
+}
+
+void PacketTests::compressedMessageTest() {
+    QByteArray json;
+    while (json.size() < 16 * 1024) {
+        json.append("{\"name\":\"entity\",\"type\":\"Box\",\"visible\":true},");
+    }
+
+    // a large, repetitive message is re-packed compressed, into fewer packets
+    auto packetList = NLPacketList::create(PacketType::DomainSettings, QByteArray(), true, true);
+    QVERIFY(packetList->isCompressible());
+    packetList->write(json);
+    packetList->closeCurrentPacket();
+    auto numUncompressedPackets = packetList->getNumPackets();
+
+    packetList->compressIfLarge();
+    QVERIFY(packetList->getNumPackets() < numUncompressedPackets);
+    QCOMPARE(packetList->getMessage().at(0), (char)MessageCompression::Zlib);
+
+    // and the receiver hands the listeners the original message
+    ReceivedMessage message(*packetList);
+    QVERIFY(!message.failed());
+    QCOMPARE(message.getMessage(), json);
+
+    // a small message is sent as is, behind its compression byte
+    auto smallList = NLPacketList::create(PacketType::DomainSettings, QByteArray(), true, true);
+    smallList->write("{}");
+    smallList->compressIfLarge();
+    QCOMPARE(smallList->getMessage().at(0), (char)MessageCompression::None);
+
+    ReceivedMessage smallMessage(*smallList);
+    QCOMPARE(smallMessage.getMessage(), QByteArray("{}"));
+
+    // and the other types don't have one
+    QVERIFY(!NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true)->isCompressible());
+}
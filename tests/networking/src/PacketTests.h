@@ -36,6 +36,18 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test packet buffers are recycled and zeroed by the PacketBufferPool
+    void bufferPoolTest();
+
+    // Test the compact loss list encoding and the selective ACK bitmap round trip
+    void lossListEncodingTest();
+
+    // Test latest only packets round trip their stream header and supersede each other in the PacketQueue
+    void latestOnlyPacketTest();
+
+    // Test large compressible messages are compressed by the NLPacketList and decompressed by the ReceivedMessage
+    void compressedMessageTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -0,0 +1,546 @@
+//
+//  UDTReplayTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTReplayTests.h"
+
+#include <algorithm>
+#include <ctime>
+#include <queue>
+#include <random>
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QProcessEnvironment>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QUdpSocket>
+
+#include <udt/Packet.h>
+#include <udt/PacketTraceRecorder.h>
+#include <udt/Socket.h>
+
+QTEST_MAIN(UDTReplayTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+namespace {
+
+const int64_t USECS_PER_MSEC = 1000;
+const int64_t USECS_PER_SECOND = 1000 * USECS_PER_MSEC;
+
+// every replayed packet carries its index in the replay and the time it was sent
+const int REPLAY_HEADER_SIZE = sizeof(quint32) + sizeof(qint64);
+
+const unsigned int RANDOM_SEED = 7; // replays of the same trace are comparable across builds
+
+int64_t usecsNow() {
+    return duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+struct LinkConditions {
+    double lossRate { 0.0 };
+    int64_t delay { 0 }; // usecs, one way
+    int64_t jitter { 0 }; // usecs, at most this much is added to the delay at random
+    int64_t bandwidth { 0 }; // bits per second, 0 for no cap
+};
+
+LinkConditions linkConditionsFromEnvironment() {
+    auto environment = QProcessEnvironment::systemEnvironment();
+
+    LinkConditions conditions;
+    conditions.lossRate = environment.value("HIFI_UDT_REPLAY_LOSS", "0").toDouble();
+    conditions.delay = environment.value("HIFI_UDT_REPLAY_DELAY_MS", "0").toLongLong() * USECS_PER_MSEC;
+    conditions.jitter = environment.value("HIFI_UDT_REPLAY_JITTER_MS", "0").toLongLong() * USECS_PER_MSEC;
+    conditions.bandwidth = environment.value("HIFI_UDT_REPLAY_BANDWIDTH_KBPS", "0").toLongLong() * 1000;
+    return conditions;
+}
+
+// A UDP relay between the two sockets, dropping, delaying and rate limiting what it forwards each way
+//   The bandwidth cap is a bottleneck with a queue, datagrams that would queue too long are dropped.
+//   Jitter is random per datagram, so it re-orders them like a real path can.
+class ImpairedLink {
+public:
+    ImpairedLink(LinkConditions conditions) : _conditions(conditions), _random(RANDOM_SEED) {
+        _socket.bind(QHostAddress::LocalHost);
+        QObject::connect(&_socket, &QUdpSocket::readyRead, [this] { readPendingDatagrams(); });
+
+        _timer.setTimerType(Qt::PreciseTimer);
+        _timer.setInterval(1);
+        QObject::connect(&_timer, &QTimer::timeout, [this] { forwardDueDatagrams(); });
+        _timer.start();
+    }
+
+    HifiSockAddr getSockAddr() const { return HifiSockAddr(QHostAddress::LocalHost, _socket.localPort()); }
+
+    void setEndpoints(quint16 senderPort, quint16 receiverPort) {
+        _senderPort = senderPort;
+        _receiverPort = receiverPort;
+    }
+
+    int getNumDropped() const { return _numDropped; }
+
+private:
+    static const int64_t MAX_QUEUE_DELAY = 250 * USECS_PER_MSEC;
+
+    struct InFlight {
+        int64_t deliveryTime;
+        uint64_t order; // keeps datagrams due at the same time in order
+        QByteArray datagram;
+        quint16 port;
+
+        // std::priority_queue is a max-heap, so order by latest delivery to forward the earliest first
+        bool operator<(const InFlight& other) const {
+            return deliveryTime > other.deliveryTime || (deliveryTime == other.deliveryTime && order > other.order);
+        }
+    };
+
+    void readPendingDatagrams() {
+        while (_socket.hasPendingDatagrams()) {
+            QByteArray datagram;
+            datagram.resize(_socket.pendingDatagramSize());
+            quint16 port = 0;
+            _socket.readDatagram(datagram.data(), datagram.size(), nullptr, &port);
+
+            bool isFromSender = port == _senderPort;
+            auto& nextFree = isFromSender ? _nextFreeToReceiver : _nextFreeToSender;
+
+            if (_lossDistribution(_random) < _conditions.lossRate) {
+                ++_numDropped;
+                continue;
+            }
+
+            int64_t now = usecsNow();
+            int64_t departure = now;
+            if (_conditions.bandwidth > 0) {
+                departure = std::max(now, nextFree) + datagram.size() * 8 * USECS_PER_SECOND / _conditions.bandwidth;
+                if (departure - now > MAX_QUEUE_DELAY) {
+                    ++_numDropped;
+                    continue;
+                }
+                nextFree = departure;
+            }
+
+            int64_t jitter = 0;
+            if (_conditions.jitter > 0) {
+                jitter = std::uniform_int_distribution<int64_t>(0, _conditions.jitter)(_random);
+            }
+
+            _inFlight.push({ departure + _conditions.delay + jitter, _nextOrder++, datagram,
+                             isFromSender ? _receiverPort : _senderPort });
+        }
+
+        forwardDueDatagrams();
+    }
+
+    void forwardDueDatagrams() {
+        auto now = usecsNow();
+        while (!_inFlight.empty() && _inFlight.top().deliveryTime <= now) {
+            _socket.writeDatagram(_inFlight.top().datagram, QHostAddress::LocalHost, _inFlight.top().port);
+            _inFlight.pop();
+        }
+    }
+
+    LinkConditions _conditions;
+    std::mt19937 _random;
+    std::uniform_real_distribution<double> _lossDistribution { 0.0, 1.0 };
+
+    QUdpSocket _socket;
+    QTimer _timer;
+
+    quint16 _senderPort { 0 };
+    quint16 _receiverPort { 0 };
+
+    int64_t _nextFreeToReceiver { 0 };
+    int64_t _nextFreeToSender { 0 };
+
+    std::priority_queue<InFlight> _inFlight;
+    uint64_t _nextOrder { 0 };
+    int _numDropped { 0 };
+};
+
+struct ReplayPacket {
+    int64_t time; // usecs since the start of the replay
+    int payloadSize;
+    bool isReliable;
+};
+
+// What a mixer sends one listener: avatar data at 90Hz, small reliable updates and the odd multi-packet reliable burst
+std::vector<ReplayPacket> syntheticMixerTrace(int64_t duration) {
+    static const int64_t AVATAR_DATA_INTERVAL = USECS_PER_SECOND / 90;
+    static const int64_t RELIABLE_UPDATE_INTERVAL = 100 * USECS_PER_MSEC;
+    static const int64_t RELIABLE_BURST_INTERVAL = USECS_PER_SECOND;
+    static const int RELIABLE_BURST_PACKETS = 8;
+
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<int> avatarDataSize(900, 1300);
+    std::uniform_int_distribution<int> updateSize(60, 400);
+
+    std::vector<ReplayPacket> packets;
+    for (int64_t time = 0; time < duration; time += AVATAR_DATA_INTERVAL) {
+        packets.push_back({ time, avatarDataSize(random), false });
+    }
+    for (int64_t time = 0; time < duration; time += RELIABLE_UPDATE_INTERVAL) {
+        packets.push_back({ time, updateSize(random), true });
+    }
+    for (int64_t time = RELIABLE_BURST_INTERVAL / 2; time < duration; time += RELIABLE_BURST_INTERVAL) {
+        for (int i = 0; i < RELIABLE_BURST_PACKETS; ++i) {
+            packets.push_back({ time, (int)Packet::maxPayloadSize(), true });
+        }
+    }
+
+    std::stable_sort(packets.begin(), packets.end(), [](const ReplayPacket& a, const ReplayPacket& b) {
+        return a.time < b.time;
+    });
+    return packets;
+}
+
+// All of the data a recorded process sent, re-played over a single connection
+//   Message parts are replayed as single packets of the same size and reliability.
+std::vector<ReplayPacket> replayPacketsFromTrace(const std::vector<PacketTraceRecord>& records) {
+    std::vector<ReplayPacket> packets;
+    int64_t startTime = -1;
+
+    for (const auto& record : records) {
+        if (record.direction != PacketTraceRecord::Sent || record.isControl()) {
+            continue;
+        }
+        if (startTime < 0) {
+            startTime = record.timestamp;
+        }
+
+        int payloadSize = record.size - Packet::localHeaderSize(record.isPartOfMessage());
+        payloadSize = std::max(REPLAY_HEADER_SIZE, std::min(payloadSize, (int)Packet::maxPayloadSize()));
+        packets.push_back({ (int64_t)record.timestamp - startTime, payloadSize, record.isReliable() });
+    }
+
+    return packets;
+}
+
+struct ReplayResult {
+    int sent { 0 };
+    int received { 0 };
+    int reliableSent { 0 };
+    int reliableReceived { 0 };
+    int retransmissions { 0 };
+    int dropped { 0 };
+    int64_t payloadBytesReceived { 0 };
+    int64_t elapsed { 0 }; // usecs, from the first send to the last receive
+
+    double throughput { 0.0 }; // kbps
+    double retransmitRatio { 0.0 }; // re-transmissions per reliable packet
+    double p99Latency { 0.0 }; // msecs, one way
+    double cpuPerPacket { 0.0 }; // usecs of process CPU time per datagram sent or received, the emulated link's included
+};
+
+ReplayResult replay(const std::vector<ReplayPacket>& packets, LinkConditions conditions) {
+    // give up on the reliable packets this long after the last one was sent
+    static const int64_t DRAIN_TIMEOUT = 10 * USECS_PER_SECOND;
+
+    ReplayResult result;
+    if (packets.empty()) {
+        return result;
+    }
+
+    // unreliable packets still on the link arrive well within this
+    const int64_t unreliableGrace = conditions.delay + conditions.jitter + 500 * USECS_PER_MSEC;
+
+    int reliableCount = (int)std::count_if(packets.begin(), packets.end(), [](const ReplayPacket& packet) {
+        return packet.isReliable;
+    });
+
+    {
+        Socket sender;
+        Socket receiver;
+        sender.bind(QHostAddress::LocalHost);
+        receiver.bind(QHostAddress::LocalHost);
+
+        ImpairedLink link(conditions);
+        link.setEndpoints(sender.localPort(), receiver.localPort());
+        auto destination = link.getSockAddr();
+
+        std::vector<bool> arrived(packets.size(), false);
+        std::vector<int64_t> latencies;
+        latencies.reserve(packets.size());
+
+        int64_t startTime = usecsNow();
+        int64_t lastReceiveTime = startTime;
+
+        receiver.setPacketHandler([&](std::unique_ptr<Packet> packet) {
+            if (packet->getPayloadSize() < REPLAY_HEADER_SIZE) {
+                return;
+            }
+
+            quint32 index;
+            qint64 sendTime;
+            packet->readPrimitive(&index);
+            packet->readPrimitive(&sendTime);
+            if (index >= packets.size() || arrived[index]) {
+                return;
+            }
+
+            lastReceiveTime = usecsNow();
+            arrived[index] = true;
+            latencies.push_back(lastReceiveTime - sendTime);
+
+            ++result.received;
+            result.reliableReceived += packets[index].isReliable ? 1 : 0;
+            result.payloadBytesReceived += packet->getPayloadSize();
+        });
+
+        QEventLoop loop;
+        QTimer sendTimer;
+        sendTimer.setTimerType(Qt::PreciseTimer);
+        sendTimer.setInterval(1);
+
+        size_t next = 0;
+        int64_t lastSendTime = startTime;
+        std::clock_t cpuStartTime = std::clock();
+
+        QObject::connect(&sendTimer, &QTimer::timeout, [&] {
+            auto now = usecsNow();
+
+            while (next < packets.size() && startTime + packets[next].time <= now) {
+                const auto& replayPacket = packets[next];
+
+                auto packet = Packet::create(replayPacket.payloadSize, replayPacket.isReliable);
+                packet->writePrimitive((quint32)next);
+                packet->writePrimitive((qint64)usecsNow());
+                packet->setPayloadSize(replayPacket.payloadSize);
+
+                if (replayPacket.isReliable) {
+                    sender.writePacket(std::move(packet), destination);
+                    ++result.reliableSent;
+                } else {
+                    sender.writePacket(*packet, destination);
+                }
+
+                ++result.sent;
+                lastSendTime = now;
+                ++next;
+            }
+
+            if (next < packets.size()) {
+                return;
+            }
+
+            bool hasAllReliable = result.reliableReceived == reliableCount;
+            bool hasAll = result.received == (int)packets.size();
+            if ((hasAllReliable && (hasAll || now > lastSendTime + unreliableGrace)) || now > lastSendTime + DRAIN_TIMEOUT) {
+                loop.quit();
+            }
+        });
+
+        sendTimer.start();
+        loop.exec();
+        sendTimer.stop();
+
+        auto cpuTime = (double)(std::clock() - cpuStartTime) * USECS_PER_SECOND / CLOCKS_PER_SEC;
+
+        // the send queues report what they sent and re-sent through queued signals
+        QCoreApplication::processEvents();
+
+        for (auto& stats : sender.sampleStatsForAllConnections()) {
+            result.retransmissions += stats.second.events[ConnectionStats::Stats::Retransmission];
+        }
+        result.dropped = link.getNumDropped();
+        result.elapsed = std::max(lastReceiveTime - startTime, (int64_t)1);
+
+        result.throughput = (double)result.payloadBytesReceived * 8 * 1000 / result.elapsed;
+        result.retransmitRatio = (double)result.retransmissions / std::max(result.reliableSent, 1);
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            result.p99Latency = (double)latencies[(latencies.size() - 1) * 99 / 100] / USECS_PER_MSEC;
+        }
+        result.cpuPerPacket = cpuTime / std::max(result.sent + result.received, 1);
+    }
+
+    // the sockets hand their send queues to deleteLater
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    return result;
+}
+
+void report(const QString& name, const LinkConditions& conditions, const ReplayResult& result) {
+    qDebug().noquote() << QString("UDT replay %1: %2 kbps, %3 re-transmits per reliable packet, p99 one-way latency %4 ms, "
+                                  "%5 CPU usecs per packet (%6/%7 packets, %8/%9 reliable, %10 dropped by the link)")
+        .arg(name).arg(result.throughput, 0, 'f', 1).arg(result.retransmitRatio, 0, 'f', 3)
+        .arg(result.p99Latency, 0, 'f', 2).arg(result.cpuPerPacket, 0, 'f', 2)
+        .arg(result.received).arg(result.sent).arg(result.reliableReceived).arg(result.reliableSent).arg(result.dropped);
+
+    auto environment = QProcessEnvironment::systemEnvironment();
+    auto reportPath = environment.value("HIFI_UDT_REPLAY_REPORT");
+    if (reportPath.isEmpty()) {
+        return;
+    }
+
+    QJsonObject line;
+    line["build"] = environment.value("HIFI_UDT_REPLAY_BUILD", "unknown");
+    line["replay"] = name;
+    line["trace"] = environment.value("HIFI_UDT_REPLAY_TRACE", "synthetic");
+    line["loss_rate"] = conditions.lossRate;
+    line["delay_ms"] = (double)conditions.delay / USECS_PER_MSEC;
+    line["jitter_ms"] = (double)conditions.jitter / USECS_PER_MSEC;
+    line["bandwidth_kbps"] = (double)conditions.bandwidth / 1000;
+    line["sent"] = result.sent;
+    line["received"] = result.received;
+    line["reliable_sent"] = result.reliableSent;
+    line["reliable_received"] = result.reliableReceived;
+    line["throughput_kbps"] = result.throughput;
+    line["retransmit_ratio"] = result.retransmitRatio;
+    line["p99_latency_ms"] = result.p99Latency;
+    line["cpu_usecs_per_packet"] = result.cpuPerPacket;
+
+    QFile reportFile(reportPath);
+    if (reportFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        reportFile.write(QJsonDocument(line).toJson(QJsonDocument::Compact) + "\n");
+    } else {
+        qWarning() << "Could not append to the replay report" << reportPath;
+    }
+}
+
+std::vector<ReplayPacket> replayPackets() {
+    static const int64_t SYNTHETIC_TRACE_DURATION = 5 * USECS_PER_SECOND;
+
+    auto tracePath = QProcessEnvironment::systemEnvironment().value("HIFI_UDT_REPLAY_TRACE");
+    if (tracePath.isEmpty()) {
+        return syntheticMixerTrace(SYNTHETIC_TRACE_DURATION);
+    }
+
+    bool ok = false;
+    auto records = PacketTraceRecorder::load(tracePath, &ok);
+    if (!ok) {
+        qWarning() << "Could not load" << tracePath << "- replaying the synthetic mixer trace instead";
+        return syntheticMixerTrace(SYNTHETIC_TRACE_DURATION);
+    }
+    return replayPacketsFromTrace(records);
+}
+
+}
+
+void UDTReplayTests::traceRecordingTest() {
+    static const int NUM_UNRELIABLE_PACKETS = 10;
+    static const int PAYLOAD_SIZE = 100;
+    static const quint8 FAKE_PACKET_TYPE = 42;
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    auto path = directory.filePath("socket.trace");
+
+    {
+        auto recorder = std::make_shared<PacketTraceRecorder>(path);
+        QVERIFY(recorder->isOpen());
+
+        Socket sender;
+        Socket receiver;
+        sender.bind(QHostAddress::LocalHost);
+        receiver.bind(QHostAddress::LocalHost);
+        sender.setPacketTraceRecorder(recorder);
+        receiver.setPacketTraceRecorder(recorder);
+
+        int numReceived = 0;
+        receiver.setPacketHandler([&](std::unique_ptr<Packet> packet) { ++numReceived; });
+
+        HifiSockAddr destination(QHostAddress::LocalHost, receiver.localPort());
+        for (int i = 0; i < NUM_UNRELIABLE_PACKETS + 1; ++i) {
+            bool isReliable = i == NUM_UNRELIABLE_PACKETS;
+            auto packet = Packet::create(PAYLOAD_SIZE, isReliable);
+            packet->writePrimitive(FAKE_PACKET_TYPE);
+            packet->setPayloadSize(PAYLOAD_SIZE);
+
+            if (isReliable) {
+                sender.writePacket(std::move(packet), destination);
+            } else {
+                sender.writePacket(*packet, destination);
+            }
+        }
+
+        QTRY_COMPARE(numReceived, NUM_UNRELIABLE_PACKETS + 1);
+        recorder->flush();
+    }
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    bool ok = false;
+    auto records = PacketTraceRecorder::load(path, &ok);
+    QVERIFY(ok);
+
+    int numSentUnreliable = 0;
+    int numReceivedUnreliable = 0;
+    int numReliable = 0;
+    int numControl = 0;
+    uint64_t lastTimestamp = 0;
+
+    for (const auto& record : records) {
+        QVERIFY(record.timestamp >= lastTimestamp);
+        lastTimestamp = record.timestamp;
+
+        if (record.isControl()) {
+            ++numControl;
+            continue;
+        }
+
+        QCOMPARE((int)record.size, Packet::localHeaderSize() + PAYLOAD_SIZE);
+
+        if (record.isReliable()) {
+            // no type check, a re-sent reliable packet may be obfuscated
+            ++numReliable;
+            continue;
+        }
+
+        QCOMPARE((int)record.type, (int)FAKE_PACKET_TYPE);
+
+        if (record.direction == PacketTraceRecord::Sent) {
+            ++numSentUnreliable;
+        } else {
+            ++numReceivedUnreliable;
+        }
+    }
+
+    QCOMPARE(numSentUnreliable, NUM_UNRELIABLE_PACKETS);
+    QCOMPARE(numReceivedUnreliable, NUM_UNRELIABLE_PACKETS);
+    QVERIFY(numReliable >= 2); // sent and received, maybe re-sent
+    QVERIFY(numControl > 0); // the handshake and ACKs of the reliable packet
+}
+
+void UDTReplayTests::replayCleanLinkTest() {
+    LinkConditions conditions;
+
+    auto result = replay(replayPackets(), conditions);
+    report("clean link", conditions, result);
+
+    QVERIFY(result.sent > 0);
+    QCOMPARE(result.reliableReceived, result.reliableSent);
+}
+
+void UDTReplayTests::replayImpairedLinkTest() {
+    LinkConditions conditions;
+    conditions.lossRate = 0.05;
+    conditions.delay = 30 * USECS_PER_MSEC;
+    conditions.jitter = 10 * USECS_PER_MSEC;
+    conditions.bandwidth = 8 * 1000 * 1000;
+
+    auto result = replay(replayPackets(), conditions);
+    report("impaired link", conditions, result);
+
+    QCOMPARE(result.reliableReceived, result.reliableSent);
+    if (result.reliableSent > 0) {
+        QVERIFY(result.retransmissions > 0);
+    }
+    QVERIFY(result.p99Latency >= (double)conditions.delay / USECS_PER_MSEC);
+}
+
+void UDTReplayTests::replayConfiguredLinkTest() {
+    auto conditions = linkConditionsFromEnvironment();
+
+    auto result = replay(replayPackets(), conditions);
+    report("configured link", conditions, result);
+
+    QCOMPARE(result.reliableReceived, result.reliableSent);
+}
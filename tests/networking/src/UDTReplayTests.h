@@ -0,0 +1,45 @@
+//
+//  UDTReplayTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UDTReplayTests_h
+#define hifi_UDTReplayTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+// Replays packet traces over a loopback udt::Socket pair, through an emulated link, and reports
+// throughput, re-transmit ratio, p99 one-way latency and CPU time per packet for the build under test.
+//
+//   HIFI_UDT_REPLAY_TRACE         trace to replay (recorded with HIFI_UDT_TRACE_FILE), instead of a synthetic mixer trace
+//   HIFI_UDT_REPLAY_LOSS          loss rate of the configured link, e.g. 0.02
+//   HIFI_UDT_REPLAY_DELAY_MS      one-way delay of the configured link
+//   HIFI_UDT_REPLAY_JITTER_MS     extra random delay of the configured link
+//   HIFI_UDT_REPLAY_BANDWIDTH_KBPS  bandwidth cap of the configured link, 0 for none
+//   HIFI_UDT_REPLAY_REPORT        file to append a JSON line of results per replay to, for comparing builds
+//   HIFI_UDT_REPLAY_BUILD         build label for the report lines
+class UDTReplayTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a socket records the datagrams it sends and receives to a trace that loads back
+    void traceRecordingTest();
+
+    // Test a trace replays completely over a clean link
+    void replayCleanLinkTest();
+
+    // Test reliable traffic still all arrives over a lossy, jittery and capped link
+    void replayImpairedLinkTest();
+
+    // Replay over the link configured by the environment, for benchmarking
+    void replayConfiguredLinkTest();
+};
+
+#endif // hifi_UDTReplayTests_h
@@ -0,0 +1,179 @@
+//
+//  EntityKinematicStoreTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityKinematicStoreTests.h"
+
+#include <vector>
+
+#include <EntityItemProperties.h>
+#include <EntityKinematicStore.h>
+#include <EntityTree.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(EntityKinematicStoreTests)
+
+const quint64 START_TIME = USECS_PER_SECOND;
+const quint64 FRAME_TIME = USECS_PER_SECOND / 60;
+const float TOLERANCE = 1.0e-5f;
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * ((float)qrand() / (float)RAND_MAX);
+}
+
+static glm::vec3 randomVector(float size) {
+    return glm::vec3(randomFloat(-size, size), randomFloat(-size, size), randomFloat(-size, size));
+}
+
+static EntityItemProperties randomMovingProperties() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(randomVector(100.0f));
+    properties.setDimensions(glm::vec3(1.0f));
+    properties.setVelocity(randomVector(5.0f));
+    properties.setAngularVelocity(randomVector(2.0f));
+    properties.setAcceleration(qrand() % 2 ? randomVector(10.0f) : glm::vec3(0.0f));
+    properties.setDamping(randomFloat(0.0f, 0.5f));
+    properties.setAngularDamping(randomFloat(0.0f, 0.5f));
+    return properties;
+}
+
+// adds the same entities to both trees, simulated from the start time
+static void addEntities(EntityTreePointer treeA, EntityTreePointer treeB, int numEntities,
+                        std::vector<EntityItemPointer>& entitiesA, std::vector<EntityItemPointer>& entitiesB) {
+    for (int i = 0; i < numEntities; i++) {
+        EntityItemID entityID(QUuid::createUuid());
+        EntityItemProperties properties = randomMovingProperties();
+        treeA->withWriteLock([&] {
+            entitiesA.push_back(treeA->addEntity(entityID, properties));
+        });
+        treeB->withWriteLock([&] {
+            entitiesB.push_back(treeB->addEntity(entityID, properties));
+        });
+        entitiesA.back()->setLastSimulated(START_TIME);
+        entitiesB.back()->setLastSimulated(START_TIME);
+    }
+}
+
+static EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+static bool sameMotion(const EntityItemPointer& a, const EntityItemPointer& b) {
+    return glm::distance(a->getLocalPosition(), b->getLocalPosition()) < TOLERANCE &&
+        glm::abs(glm::dot(a->getLocalOrientation(), b->getLocalOrientation())) > 1.0f - TOLERANCE &&
+        glm::distance(a->getLocalVelocity(), b->getLocalVelocity()) < TOLERANCE &&
+        glm::distance(a->getLocalAngularVelocity(), b->getLocalAngularVelocity()) < TOLERANCE;
+}
+
+static void noCallback(const EntityItemPointer&) {
+}
+
+void EntityKinematicStoreTests::testStepMatchesSimulate() {
+    qsrand(1);
+    EntityTreePointer treeA = createTree();
+    EntityTreePointer treeB = createTree();
+    std::vector<EntityItemPointer> simulated;
+    std::vector<EntityItemPointer> stored;
+    // enough entities for the store to integrate them in parallel
+    const int NUM_ENTITIES = 2000;
+    addEntities(treeA, treeB, NUM_ENTITIES, simulated, stored);
+
+    EntityKinematicStore store;
+    for (auto& entity : stored) {
+        QVERIFY(EntityKinematicStore::canStore(entity));
+        store.update(entity);
+    }
+    QCOMPARE(store.size(), NUM_ENTITIES);
+
+    const int NUM_FRAMES = 30;
+    quint64 now = START_TIME;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        now += FRAME_TIME;
+        for (auto& entity : simulated) {
+            entity->simulate(now);
+        }
+        int numMoved = 0;
+        store.step(now, [&](const EntityItemPointer&) {
+            numMoved++;
+        }, noCallback);
+        QVERIFY(numMoved > 0);
+    }
+
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        QVERIFY(sameMotion(simulated[i], stored[i]));
+        QCOMPARE(stored[i]->getLastSimulated(), now);
+    }
+}
+
+void EntityKinematicStoreTests::testEditIsReadAgain() {
+    qsrand(2);
+    EntityTreePointer treeA = createTree();
+    EntityTreePointer treeB = createTree();
+    std::vector<EntityItemPointer> simulated;
+    std::vector<EntityItemPointer> stored;
+    addEntities(treeA, treeB, 1, simulated, stored);
+
+    EntityKinematicStore store;
+    store.update(stored[0]);
+    quint64 now = START_TIME + FRAME_TIME;
+    simulated[0]->simulate(now);
+    store.step(now, noCallback, noCallback);
+
+    // an edit from outside the simulation, that it isn't told about
+    glm::vec3 velocity(0.0f, 3.0f, 0.0f);
+    for (auto& entity : { simulated[0], stored[0] }) {
+        entity->setLocalVelocity(velocity);
+        entity->setLastEdited(now);
+    }
+
+    now += FRAME_TIME;
+    simulated[0]->simulate(now);
+    store.step(now, noCallback, noCallback);
+    QVERIFY(sameMotion(simulated[0], stored[0]));
+}
+
+void EntityKinematicStoreTests::testStoppedEntitiesAreRemoved() {
+    EntityTreePointer tree = createTree();
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setDimensions(glm::vec3(1.0f));
+    properties.setVelocity(glm::vec3(1.0f, 0.0f, 0.0f));
+    properties.setDamping(1.0f); // stops within a frame
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    });
+    entity->setLastSimulated(START_TIME);
+
+    EntityKinematicStore store;
+    store.update(entity);
+    QCOMPARE(store.size(), 1);
+    store.step(START_TIME + FRAME_TIME, noCallback, noCallback);
+    QCOMPARE(store.size(), 0);
+    QCOMPARE(entity->isMovingRelativeToParent(), false);
+
+    // an entity that gained a parent is handed back
+    properties.setDamping(0.0f);
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    });
+    store.update(entity);
+    entity->setParentID(QUuid::createUuid());
+    entity->setLastEdited(usecTimestampNow());
+    int numReleased = 0;
+    store.step(START_TIME + FRAME_TIME, noCallback, [&](const EntityItemPointer&) {
+        numReleased++;
+    });
+    QCOMPARE(numReleased, 1);
+    QCOMPARE(store.size(), 0);
+}
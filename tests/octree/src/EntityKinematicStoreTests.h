@@ -0,0 +1,25 @@
+//
+//  EntityKinematicStoreTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityKinematicStoreTests_h
+#define hifi_EntityKinematicStoreTests_h
+
+#include <QtTest/QtTest>
+
+class EntityKinematicStoreTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testStepMatchesSimulate();
+    void testEditIsReadAgain();
+    void testStoppedEntitiesAreRemoved();
+};
+
+#endif // hifi_EntityKinematicStoreTests_h
@@ -0,0 +1,100 @@
+//
+//  EntityPhysicsPackedTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsPackedTests.h"
+
+#include <EntityItemProperties.h>
+#include <udt/PacketHeaders.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(EntityPhysicsPackedTests)
+
+static EntityItemProperties makeMotion(const glm::vec3& velocity, const glm::vec3& angularVelocity) {
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(1234.5f, -12.25f, 0.125f));
+    properties.setRotation(glm::normalize(glm::quat(0.9f, 0.1f, -0.3f, 0.2f)));
+    properties.setVelocity(velocity);
+    properties.setAngularVelocity(angularVelocity);
+    properties.setAcceleration(glm::vec3(0.0f, -9.8f, 0.0f));
+    properties.setClientOnly(false);
+    properties.setLastEdited(123456789);
+    return properties;
+}
+
+void EntityPhysicsPackedTests::testMotionRoundTrip() {
+    EntityItemID id(QUuid::createUuid());
+    EntityItemProperties properties = makeMotion(glm::vec3(3.0f, -1.5f, 0.25f), glm::vec3(0.5f, 2.0f, -4.0f));
+
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityPhysicsPacked), 0);
+    QVERIFY(EntityItemProperties::encodeEntityPhysicsPackedPacket(id, properties, buffer));
+
+    EntityItemID decodedID;
+    EntityItemProperties decoded;
+    int processedBytes = 0;
+    QVERIFY(EntityItemProperties::decodeEntityPhysicsPackedPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                                  buffer.size(), processedBytes, decodedID, decoded));
+    QCOMPARE(processedBytes, buffer.size());
+    QCOMPARE(decodedID, id);
+    QCOMPARE(decoded.getLastEdited(), properties.getLastEdited());
+    QCOMPARE(decoded.getPosition(), properties.getPosition());
+
+    const float ROTATION_TOLERANCE = 1.0e-3f;
+    QVERIFY(fabsf(glm::dot(decoded.getRotation(), properties.getRotation())) > 1.0f - ROTATION_TOLERANCE);
+    const float VELOCITY_TOLERANCE = 1.0f / 128.0f;
+    QVERIFY(glm::distance(decoded.getVelocity(), properties.getVelocity()) < VELOCITY_TOLERANCE);
+    QVERIFY(glm::distance(decoded.getAngularVelocity(), properties.getAngularVelocity()) < VELOCITY_TOLERANCE);
+    QVERIFY(glm::distance(decoded.getAcceleration(), properties.getAcceleration()) < VELOCITY_TOLERANCE);
+    QVERIFY(decoded.positionChanged() && decoded.rotationChanged() && decoded.velocityChanged());
+}
+
+void EntityPhysicsPackedTests::testZeroDerivativesAreOmitted() {
+    EntityItemID id(QUuid::createUuid());
+    QByteArray moving(NLPacket::maxPayloadSize(PacketType::EntityPhysicsPacked), 0);
+    QVERIFY(EntityItemProperties::encodeEntityPhysicsPackedPacket(id, makeMotion(glm::vec3(1.0f), glm::vec3(1.0f)), moving));
+    QByteArray resting(NLPacket::maxPayloadSize(PacketType::EntityPhysicsPacked), 0);
+    QVERIFY(EntityItemProperties::encodeEntityPhysicsPackedPacket(id, makeMotion(glm::vec3(0.0f), glm::vec3(0.0f)), resting));
+    QCOMPARE(moving.size() - resting.size(), 2 * 3 * (int)sizeof(int16_t));
+
+    // an omitted derivative is zero, not unchanged
+    EntityItemID decodedID;
+    EntityItemProperties decoded;
+    int processedBytes = 0;
+    QVERIFY(EntityItemProperties::decodeEntityPhysicsPackedPacket(reinterpret_cast<const unsigned char*>(resting.constData()),
+                                                                  resting.size(), processedBytes, decodedID, decoded));
+    QVERIFY(decoded.velocityChanged());
+    QCOMPARE(decoded.getVelocity(), glm::vec3(0.0f));
+}
+
+void EntityPhysicsPackedTests::testOtherPropertiesAreNotPacked() {
+    EntityItemID id(QUuid::createUuid());
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityPhysicsPacked), 0);
+
+    EntityItemProperties bid = makeMotion(glm::vec3(1.0f), glm::vec3(0.0f));
+    bid.setSimulationOwner(QUuid::createUuid(), 128);
+    QVERIFY(!EntityItemProperties::encodeEntityPhysicsPackedPacket(id, bid, buffer));
+
+    // out of the quantized range
+    EntityItemProperties fast = makeMotion(glm::vec3(1000.0f, 0.0f, 0.0f), glm::vec3(0.0f));
+    QVERIFY(!EntityItemProperties::encodeEntityPhysicsPackedPacket(id, fast, buffer));
+}
+
+void EntityPhysicsPackedTests::testTruncatedMessageIsInvalid() {
+    EntityItemID id(QUuid::createUuid());
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityPhysicsPacked), 0);
+    QVERIFY(EntityItemProperties::encodeEntityPhysicsPackedPacket(id, makeMotion(glm::vec3(1.0f), glm::vec3(1.0f)), buffer));
+
+    EntityItemID decodedID;
+    EntityItemProperties decoded;
+    int processedBytes = 0;
+    QVERIFY(!EntityItemProperties::decodeEntityPhysicsPackedPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                                   buffer.size() - 1, processedBytes, decodedID, decoded));
+    QCOMPARE(processedBytes, buffer.size() - 1);
+}
@@ -0,0 +1,26 @@
+//
+//  EntityPhysicsPackedTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsPackedTests_h
+#define hifi_EntityPhysicsPackedTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPhysicsPackedTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMotionRoundTrip();
+    void testZeroDerivativesAreOmitted();
+    void testOtherPropertiesAreNotPacked();
+    void testTruncatedMessageIsInvalid();
+};
+
+#endif // hifi_EntityPhysicsPackedTests_h
@@ -0,0 +1,147 @@
+//
+//  EntityPropertyChangesTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertyChangesTests.h"
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityPropertyChangesTests)
+
+static EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+static EntityItemID addBox(EntityTreePointer tree, const glm::vec3& position) {
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    tree->withWriteLock([&] {
+        tree->addEntity(entityID, properties);
+    });
+    return entityID;
+}
+
+static void editEntity(EntityTreePointer tree, const EntityItemID& entityID, const EntityItemProperties& properties) {
+    tree->withWriteLock([&] {
+        tree->updateEntity(entityID, properties);
+    });
+}
+
+static EntityItemProperties colorEdit(uint8_t red) {
+    EntityItemProperties properties;
+    properties.setColor({ red, 0, 0 });
+    return properties;
+}
+
+static EntityItemProperties userDataEdit(const QString& userData) {
+    EntityItemProperties properties;
+    properties.setUserData(userData);
+    return properties;
+}
+
+void EntityPropertyChangesTests::initTestCase() {
+    // edits without a sender are checked against the permissions of this node
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityPropertyChangesTests::testChangesAreBatchedPerUpdate() {
+    EntityTreePointer tree = createTree();
+    EntityItemID first = addBox(tree, glm::vec3(1.0f));
+    EntityItemID second = addBox(tree, glm::vec3(-1.0f));
+
+    EntityPropertyFlags properties;
+    properties += PROP_COLOR;
+    properties += PROP_POSITION;
+    QVector<EntityPropertyChanges> dispatched;
+    tree->subscribeToPropertyChanges(properties, [&](const EntityPropertyChanges& changes) {
+        dispatched.push_back(changes);
+    });
+
+    // the edits of a frame are merged into one record per entity, given at the next update
+    editEntity(tree, first, colorEdit(10));
+    editEntity(tree, first, colorEdit(20));
+    EntityItemProperties positionEdit;
+    positionEdit.setPosition(glm::vec3(2.0f));
+    editEntity(tree, first, positionEdit);
+    editEntity(tree, second, colorEdit(30));
+    QCOMPARE(dispatched.size(), 0);
+
+    tree->update();
+    QCOMPARE(dispatched.size(), 1);
+    QCOMPARE(dispatched[0].size(), 2);
+    for (const auto& change : dispatched[0]) {
+        QVERIFY(change.entityID == first || change.entityID == second);
+        QVERIFY(change.changedProperties.getHasProperty(PROP_COLOR));
+        QCOMPARE(change.changedProperties.getHasProperty(PROP_POSITION), change.entityID == first);
+    }
+
+    // nothing was edited since
+    tree->update();
+    QCOMPARE(dispatched.size(), 1);
+}
+
+void EntityPropertyChangesTests::testSubscribedPropertiesOnly() {
+    EntityTreePointer tree = createTree();
+    EntityItemID entityID = addBox(tree, glm::vec3(0.0f));
+
+    int colorCalls = 0;
+    tree->subscribeToPropertyChanges(EntityPropertyFlags(PROP_COLOR), [&](const EntityPropertyChanges& changes) {
+        colorCalls++;
+    });
+    QVector<EntityPropertyChange> userDataChanges;
+    tree->subscribeToPropertyChanges(EntityPropertyFlags(PROP_USER_DATA), [&](const EntityPropertyChanges& changes) {
+        userDataChanges += changes;
+    });
+
+    // an edit of the user data only reaches the observer of the user data, with only that property in its record
+    EntityItemProperties properties = userDataEdit("{ \"grabbableKey\": { \"grabbable\": true } }");
+    properties.setName("box");
+    editEntity(tree, entityID, properties);
+    tree->update();
+    QCOMPARE(colorCalls, 0);
+    QCOMPARE(userDataChanges.size(), 1);
+    QCOMPARE(userDataChanges[0].entityID, entityID);
+    QVERIFY(userDataChanges[0].changedProperties.getHasProperty(PROP_USER_DATA));
+    QVERIFY(!userDataChanges[0].changedProperties.getHasProperty(PROP_NAME));
+
+    editEntity(tree, entityID, colorEdit(40));
+    tree->update();
+    QCOMPARE(colorCalls, 1);
+    QCOMPARE(userDataChanges.size(), 1);
+}
+
+void EntityPropertyChangesTests::testUnsubscribe() {
+    EntityTreePointer tree = createTree();
+    EntityItemID entityID = addBox(tree, glm::vec3(0.0f));
+
+    int calls = 0;
+    int subscriptionID = tree->subscribeToPropertyChanges(EntityPropertyFlags(PROP_COLOR),
+        [&](const EntityPropertyChanges& changes) {
+            calls++;
+        });
+    editEntity(tree, entityID, colorEdit(50));
+    tree->unsubscribeFromPropertyChanges(subscriptionID);
+    tree->update();
+    QCOMPARE(calls, 0);
+
+    // edits made while nothing is subscribed aren't kept for a later subscriber
+    editEntity(tree, entityID, colorEdit(60));
+    tree->subscribeToPropertyChanges(EntityPropertyFlags(PROP_COLOR), [&](const EntityPropertyChanges& changes) {
+        calls++;
+    });
+    tree->update();
+    QCOMPARE(calls, 0);
+}
@@ -0,0 +1,26 @@
+//
+//  EntityPropertyChangesTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertyChangesTests_h
+#define hifi_EntityPropertyChangesTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPropertyChangesTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testChangesAreBatchedPerUpdate();
+    void testSubscribedPropertiesOnly();
+    void testUnsubscribe();
+};
+
+#endif // hifi_EntityPropertyChangesTests_h
@@ -0,0 +1,230 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <vector>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+// entities are scattered over a region of this size, around the origin
+const float WORLD_SIZE = 1000.0f; // meters
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * ((float)qrand() / (float)RAND_MAX);
+}
+
+static glm::vec3 randomPosition() {
+    float halfSize = WORLD_SIZE / 2.0f;
+    return glm::vec3(randomFloat(-halfSize, halfSize), randomFloat(-halfSize, halfSize), randomFloat(-halfSize, halfSize));
+}
+
+static EntityItemProperties randomBoxProperties() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(randomPosition());
+    // mostly small entities, with a few large ones that the octree keeps near its root
+    float size = (qrand() % 20 == 0) ? randomFloat(20.0f, 200.0f) : randomFloat(0.1f, 5.0f);
+    properties.setDimensions(glm::vec3(size, randomFloat(0.1f, 5.0f), size));
+    return properties;
+}
+
+static EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+// adds the same entities to each of the trees
+static void addEntities(const std::vector<EntityTreePointer>& trees, int numEntities) {
+    for (int i = 0; i < numEntities; i++) {
+        EntityItemID entityID(QUuid::createUuid());
+        EntityItemProperties properties = randomBoxProperties();
+        for (auto& tree : trees) {
+            tree->withWriteLock([&] {
+                tree->addEntity(entityID, properties);
+            });
+        }
+    }
+}
+
+static QSet<EntityItemID> getIDs(const QVector<EntityItemPointer>& entities) {
+    QSet<EntityItemID> entityIDs;
+    for (auto& entity : entities) {
+        entityIDs.insert(entity->getEntityItemID());
+    }
+    return entityIDs;
+}
+
+// runs the same queries on a tree with the index and one without, which must agree
+static void compareQueries(EntityTreePointer indexedTree, EntityTreePointer octreeTree, int numQueries) {
+    EntityTreePointer trees[2] = { octreeTree, indexedTree };
+    for (int i = 0; i < numQueries; i++) {
+        glm::vec3 center = randomPosition();
+        float radius = randomFloat(1.0f, 50.0f);
+        AABox box(center, glm::vec3(randomFloat(1.0f, 50.0f)));
+        glm::vec3 direction = glm::normalize(glm::vec3(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), 1.0f));
+
+        QVector<EntityItemPointer> inSphere[2];
+        QVector<EntityItemPointer> inBox[2];
+        EntityItemPointer closest[2];
+        bool rayHit[2];
+        float rayDistance[2];
+        for (int j = 0; j < 2; j++) {
+            trees[j]->withReadLock([&] {
+                trees[j]->findEntities(center, radius, inSphere[j]);
+                trees[j]->findEntities(box, inBox[j]);
+            });
+            closest[j] = trees[j]->findClosestEntity(center, radius);
+
+            OctreeElementPointer element;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            rayHit[j] = trees[j]->findRayIntersection(center, direction, QVector<EntityItemID>(), QVector<EntityItemID>(),
+                false, false, false, element, rayDistance[j], face, surfaceNormal);
+        }
+
+        QCOMPARE(getIDs(inSphere[1]), getIDs(inSphere[0]));
+        QCOMPARE(getIDs(inBox[1]), getIDs(inBox[0]));
+        QCOMPARE(closest[1] ? closest[1]->getEntityItemID() : EntityItemID(),
+            closest[0] ? closest[0]->getEntityItemID() : EntityItemID());
+        QCOMPARE(rayHit[1], rayHit[0]);
+        if (rayHit[0]) {
+            QCOMPARE(rayDistance[1], rayDistance[0]);
+        }
+    }
+}
+
+void EntitySpatialIndexTests::testQueriesMatchOctree() {
+    qsrand(1);
+    EntityTreePointer indexedTree = createTree();
+    EntityTreePointer octreeTree = createTree();
+    addEntities({ indexedTree, octreeTree }, 1000);
+    // half indexed as they are added, half when the index is turned on
+    indexedTree->setWantSpatialIndex(true);
+    addEntities({ indexedTree, octreeTree }, 1000);
+    QCOMPARE(indexedTree->getWantSpatialIndex(), true);
+    QCOMPARE(octreeTree->getWantSpatialIndex(), false);
+
+    compareQueries(indexedTree, octreeTree, 200);
+}
+
+void EntitySpatialIndexTests::testMoveAndDelete() {
+    qsrand(2);
+    EntityTreePointer indexedTree = createTree();
+    indexedTree->setWantSpatialIndex(true);
+    EntityTreePointer octreeTree = createTree();
+    addEntities({ indexedTree, octreeTree }, 1000);
+
+    QVector<EntityItemPointer> allEntities;
+    octreeTree->withReadLock([&] {
+        octreeTree->findEntities(AABox(glm::vec3(-WORLD_SIZE), glm::vec3(2.0f * WORLD_SIZE)), allEntities);
+    });
+    QCOMPARE(allEntities.size(), 1000);
+
+    // move a third by edits, some a little, within their margin, and some across the world, and delete another third
+    for (int i = 0; i < allEntities.size(); i++) {
+        EntityItemID entityID = allEntities[i]->getEntityItemID();
+        EntityItemProperties properties;
+        if (i % 3 == 0) {
+            glm::vec3 position = allEntities[i]->getPosition();
+            properties.setPosition((i % 2) ? position + glm::vec3(0.01f) : randomPosition());
+        }
+        for (auto& tree : { indexedTree, octreeTree }) {
+            tree->withWriteLock([&] {
+                if (i % 3 == 0) {
+                    tree->updateEntity(entityID, properties);
+                } else if (i % 3 == 1) {
+                    tree->deleteEntity(entityID, true);
+                }
+            });
+        }
+    }
+
+    compareQueries(indexedTree, octreeTree, 200);
+}
+
+void EntitySpatialIndexTests::benchmarkFindEntities_data() {
+    QTest::addColumn<int>("numEntities");
+    QTest::addColumn<bool>("useIndex");
+    QTest::newRow("1000 entities, octree") << 1000 << false;
+    QTest::newRow("1000 entities, index") << 1000 << true;
+    QTest::newRow("20000 entities, octree") << 20000 << false;
+    QTest::newRow("20000 entities, index") << 20000 << true;
+}
+
+// the sphere queries scripts run, each over a small part of the world
+void EntitySpatialIndexTests::benchmarkFindEntities() {
+    QFETCH(int, numEntities);
+    QFETCH(bool, useIndex);
+
+    qsrand(3);
+    EntityTreePointer tree = createTree();
+    tree->setWantSpatialIndex(useIndex);
+    addEntities({ tree }, numEntities);
+
+    std::vector<glm::vec3> centers;
+    for (int i = 0; i < 100; i++) {
+        centers.push_back(randomPosition());
+    }
+
+    int numFound = 0;
+    QBENCHMARK {
+        tree->withReadLock([&] {
+            for (auto& center : centers) {
+                QVector<EntityItemPointer> foundEntities;
+                tree->findEntities(center, 10.0f, foundEntities);
+                numFound += foundEntities.size();
+            }
+        });
+    }
+    Q_UNUSED(numFound);
+}
+
+void EntitySpatialIndexTests::benchmarkFindRayIntersection_data() {
+    benchmarkFindEntities_data();
+}
+
+// the picks of the mouse and the controllers
+void EntitySpatialIndexTests::benchmarkFindRayIntersection() {
+    QFETCH(int, numEntities);
+    QFETCH(bool, useIndex);
+
+    qsrand(4);
+    EntityTreePointer tree = createTree();
+    tree->setWantSpatialIndex(useIndex);
+    addEntities({ tree }, numEntities);
+
+    std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+    for (int i = 0; i < 100; i++) {
+        glm::vec3 direction = glm::normalize(glm::vec3(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), 1.0f));
+        rays.emplace_back(randomPosition(), direction);
+    }
+
+    int numHits = 0;
+    QBENCHMARK {
+        for (auto& ray : rays) {
+            OctreeElementPointer element;
+            float distance;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            if (tree->findRayIntersection(ray.first, ray.second, QVector<EntityItemID>(), QVector<EntityItemID>(),
+                    false, false, false, element, distance, face, surfaceNormal)) {
+                numHits++;
+            }
+        }
+    }
+    Q_UNUSED(numHits);
+}
@@ -0,0 +1,28 @@
+//
+//  EntitySpatialIndexTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndexTests_h
+#define hifi_EntitySpatialIndexTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySpatialIndexTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testQueriesMatchOctree();
+    void testMoveAndDelete();
+    void benchmarkFindEntities_data();
+    void benchmarkFindEntities();
+    void benchmarkFindRayIntersection_data();
+    void benchmarkFindRayIntersection();
+};
+
+#endif // hifi_EntitySpatialIndexTests_h
@@ -0,0 +1,100 @@
+//
+//  EntityTimerQueueTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTimerQueueTests.h"
+
+#include <EntityItemProperties.h>
+#include <EntityTimerQueue.h>
+#include <EntityTypes.h>
+
+QTEST_MAIN(EntityTimerQueueTests)
+
+static EntityItemPointer createEntity() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    return EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()), properties);
+}
+
+void EntityTimerQueueTests::testTakeDueInOrder() {
+    EntityTimerQueue queue;
+    QVector<EntityItemPointer> entities;
+    const quint64 times[] = { 50, 10, 40, 20, 30 };
+    for (quint64 time : times) {
+        entities.push_back(createEntity());
+        queue.schedule(entities.back(), time);
+    }
+    QCOMPARE(queue.size(), 5);
+    QCOMPARE(queue.getNextTime(), (quint64)10);
+
+    QVector<EntityItemPointer> due;
+    queue.takeDue(5, due);
+    QVERIFY(due.isEmpty());
+
+    queue.takeDue(30, due);
+    QCOMPARE(due.size(), 3);
+    QCOMPARE(due[0], entities[1]);
+    QCOMPARE(due[1], entities[3]);
+    QCOMPARE(due[2], entities[4]);
+    QCOMPARE(queue.size(), 2);
+    QVERIFY(!queue.contains(entities[1]));
+    QCOMPARE(queue.getNextTime(), (quint64)40);
+}
+
+void EntityTimerQueueTests::testRescheduleAndRemove() {
+    EntityTimerQueue queue;
+    EntityItemPointer a = createEntity();
+    EntityItemPointer b = createEntity();
+    EntityItemPointer c = createEntity();
+    queue.schedule(a, 10);
+    queue.schedule(b, 20);
+    queue.schedule(c, 30);
+
+    // a moves after c, and b is gone, so their old entries are skipped
+    queue.schedule(a, 100);
+    queue.remove(b);
+    QCOMPARE(queue.getNextTime(), (quint64)30);
+
+    QVector<EntityItemPointer> due;
+    queue.takeDue(50, due);
+    QCOMPARE(due.size(), 1);
+    QCOMPARE(due[0], c);
+
+    // an entity that was deleted without being removed is dropped
+    a.reset();
+    due.clear();
+    queue.takeDue(1000, due);
+    QVERIFY(due.isEmpty());
+    QCOMPARE(queue.getNextTime(), quint64(-1));
+}
+
+void EntityTimerQueueTests::testManyReschedules() {
+    // the stale entries are compacted away without losing the live ones
+    EntityTimerQueue queue;
+    QVector<EntityItemPointer> entities;
+    const int NUM_ENTITIES = 10;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entities.push_back(createEntity());
+    }
+    const int NUM_RESCHEDULES = 1000;
+    for (int i = 0; i < NUM_RESCHEDULES; i++) {
+        queue.schedule(entities[i % NUM_ENTITIES], (quint64)(NUM_RESCHEDULES - i));
+    }
+    QCOMPARE(queue.size(), NUM_ENTITIES);
+
+    QVector<EntityItemPointer> due;
+    queue.takeDue(NUM_ENTITIES, due);
+    QCOMPARE(due.size(), NUM_ENTITIES);
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        // the last reschedules were the earliest, of the last entities first
+        QCOMPARE(due[i], entities[NUM_ENTITIES - 1 - i]);
+    }
+    QCOMPARE(queue.size(), 0);
+}
@@ -0,0 +1,25 @@
+//
+//  EntityTimerQueueTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTimerQueueTests_h
+#define hifi_EntityTimerQueueTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTimerQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testTakeDueInOrder();
+    void testRescheduleAndRemove();
+    void testManyReschedules();
+};
+
+#endif // hifi_EntityTimerQueueTests_h
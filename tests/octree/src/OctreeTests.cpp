@@ -51,6 +51,28 @@ enum ExamplePropertyList {
 
 typedef PropertyFlags<ExamplePropertyList> ExamplePropertyFlags;
 
+// the entity properties again, with no PropertyFlagsTraits so that their flags are kept in a QBitArray
+enum DynamicEntityPropertyList : int {};
+typedef PropertyFlags<DynamicEntityPropertyList> DynamicEntityPropertyFlags;
+
+static void setRandomFlags(EntityPropertyFlags& fixedFlags, DynamicEntityPropertyFlags& dynamicFlags) {
+    for (int flag = 0; flag < PROP_AFTER_LAST_ITEM; flag++) {
+        if (qrand() % 4 == 0) {
+            fixedFlags.setHasProperty((EntityPropertyList)flag);
+            dynamicFlags.setHasProperty((DynamicEntityPropertyList)flag);
+        }
+    }
+}
+
+static void compareFlags(EntityPropertyFlags& fixedFlags, DynamicEntityPropertyFlags& dynamicFlags) {
+    QCOMPARE(fixedFlags.encode(), dynamicFlags.encode());
+    QCOMPARE(fixedFlags.isEmpty(), dynamicFlags.isEmpty());
+    for (int flag = 0; flag < PROP_AFTER_LAST_ITEM; flag++) {
+        QCOMPARE(fixedFlags.getHasProperty((EntityPropertyList)flag),
+                 dynamicFlags.getHasProperty((DynamicEntityPropertyList)flag));
+    }
+}
+
 QTEST_MAIN(OctreeTests)
 
 void OctreeTests::propertyFlagsTests() {
@@ -480,6 +502,51 @@ typedef ByteCountCoded<quint64> ByteCountCodedQUINT64;
 
 typedef ByteCountCoded<int> ByteCountCodedINT;
 
+void OctreeTests::fixedPropertyFlagsTests() {
+    static_assert(EntityPropertyFlags::NUM_FLAGS == PROP_AFTER_LAST_ITEM, "entity property flags should be fixed");
+    qsrand(1);
+
+    const int NUM_TRIALS = 100;
+    for (int i = 0; i < NUM_TRIALS; i++) {
+        EntityPropertyFlags fixedA, fixedB;
+        DynamicEntityPropertyFlags dynamicA, dynamicB;
+        setRandomFlags(fixedA, dynamicA);
+        setRandomFlags(fixedB, dynamicB);
+        compareFlags(fixedA, dynamicA);
+
+        // the encoding into a buffer matches the one into a QByteArray, and reads back the same flags
+        uint8_t buffer[EntityPropertyFlags::MAX_ENCODED_LENGTH];
+        int length = fixedA.encode(buffer, EntityPropertyFlags::MAX_ENCODED_LENGTH);
+        QCOMPARE(QByteArray((const char*)buffer, length), dynamicA.encode());
+        QCOMPARE(fixedA.encode(buffer, length - 1), 0);
+        EntityPropertyFlags decoded;
+        QCOMPARE((int)decoded.decode(buffer, length), length);
+        QCOMPARE(decoded.encode(), fixedA.encode());
+
+        EntityPropertyFlags fixedUnion = fixedA | fixedB;
+        DynamicEntityPropertyFlags dynamicUnion = dynamicA | dynamicB;
+        compareFlags(fixedUnion, dynamicUnion);
+
+        EntityPropertyFlags fixedIntersection = fixedA & fixedB;
+        DynamicEntityPropertyFlags dynamicIntersection = dynamicA & dynamicB;
+        compareFlags(fixedIntersection, dynamicIntersection);
+
+        EntityPropertyFlags fixedDifference = fixedA - fixedB;
+        DynamicEntityPropertyFlags dynamicDifference = dynamicA - dynamicB;
+        compareFlags(fixedDifference, dynamicDifference);
+
+        QCOMPARE(fixedA == fixedB, dynamicA == dynamicB);
+        QCOMPARE(fixedUnion == (fixedB | fixedA), true);
+    }
+
+    // a flag beyond what the storage holds, as from a newer stream, is dropped
+    EntityPropertyFlags flags;
+    flags.setHasProperty((EntityPropertyList)(FixedBitArray<PROP_AFTER_LAST_ITEM>::CAPACITY + 1));
+    flags.setHasProperty(PROP_VISIBLE);
+    QCOMPARE(flags.getHasProperty(PROP_VISIBLE), true);
+    QCOMPARE(flags.getHasProperty((EntityPropertyList)(FixedBitArray<PROP_AFTER_LAST_ITEM>::CAPACITY + 1)), false);
+}
+
 void OctreeTests::byteCountCodingTests() {
     bool verbose = true;
     
@@ -21,6 +21,8 @@ private slots:
     // FIXME: These two tests are broken and need to be fixed / updated
     void propertyFlagsTests();
     void byteCountCodingTests();
+
+    void fixedPropertyFlagsTests();
     
     // This test is fine
     void modelItemTests();
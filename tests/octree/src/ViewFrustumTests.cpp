@@ -1345,3 +1345,69 @@ void ViewFrustumTests::testBoxIntersectsKeyhole() {
     box.setBox(boxCenter - halfScaleOffset, boxScale);
     QCOMPARE(view.boxIntersectsKeyhole(box), false); // outside back
 }
+
+void ViewFrustumTests::testBatchIntersections() {
+    float aspect = 1.0f;
+    float fovX = PI / 2.0f;
+    float nearClip = 1.0f;
+    float farClip = 100.0f;
+    float holeRadius = 10.0f;
+
+    glm::vec3 center = glm::vec3(12.3f, 4.56f, 89.7f);
+
+    float angle = PI / 7.0f;
+    glm::vec3 axis = glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f));
+    glm::quat rotation = glm::angleAxis(angle, axis);
+
+    ViewFrustum view;
+    view.setProjection(glm::perspective(fovX, aspect, nearClip, farClip));
+    view.setPosition(center);
+    view.setOrientation(rotation);
+    view.setCenterRadius(holeRadius);
+    view.calculate();
+
+    // a grid across the keyhole, of a size that is not a multiple of the width of the kernels
+    std::vector<AABox> boxes;
+    std::vector<AACube> cubes;
+    ViewFrustum::Boxes boxArrays;
+    ViewFrustum::Boxes cubeArrays;
+    ViewFrustum::Spheres sphereArrays;
+    const float step = 13.7f;
+    for (int i = -6; i <= 6; i++) {
+        for (int j = -6; j <= 6; j++) {
+            for (int k = -6; k <= 6; k++) {
+                glm::vec3 corner = center + step * glm::vec3((float)i, (float)j, (float)k);
+                float size = 1.0f + 0.37f * (float)((i + j + k + 18) % 11);
+                boxes.push_back(AABox(corner, glm::vec3(size, 0.5f * size, 2.0f * size)));
+                cubes.push_back(AACube(corner, size));
+                boxArrays.push_back(boxes.back());
+                cubeArrays.push_back(cubes.back());
+                sphereArrays.push_back(corner, size);
+            }
+        }
+    }
+    int numBoxes = boxArrays.size();
+    QCOMPARE(numBoxes, (int)boxes.size());
+
+    std::vector<uint32_t> inView(ViewFrustum::getNumInViewWords(numBoxes));
+    view.boxesIntersectFrustum(boxArrays, inView.data());
+    for (int i = 0; i < numBoxes; i++) {
+        QCOMPARE(ViewFrustum::isInView(inView.data(), i), view.boxIntersectsFrustum(boxes[i]));
+    }
+    view.boxesIntersectKeyhole(boxArrays, inView.data());
+    for (int i = 0; i < numBoxes; i++) {
+        QCOMPARE(ViewFrustum::isInView(inView.data(), i), view.boxIntersectsKeyhole(boxes[i]));
+    }
+    view.boxesIntersectKeyhole(cubeArrays, inView.data());
+    for (int i = 0; i < numBoxes; i++) {
+        QCOMPARE(ViewFrustum::isInView(inView.data(), i), view.cubeIntersectsKeyhole(cubes[i]));
+    }
+    view.spheresIntersectFrustum(sphereArrays, inView.data());
+    for (int i = 0; i < numBoxes; i++) {
+        QCOMPARE(ViewFrustum::isInView(inView.data(), i), view.sphereIntersectsFrustum(cubes[i].getCorner(), cubes[i].getScale()));
+    }
+    view.spheresIntersectKeyhole(sphereArrays, inView.data());
+    for (int i = 0; i < numBoxes; i++) {
+        QCOMPARE(ViewFrustum::isInView(inView.data(), i), view.sphereIntersectsKeyhole(cubes[i].getCorner(), cubes[i].getScale()));
+    }
+}
@@ -0,0 +1,402 @@
+//
+//  main.cpp
+//  tests/physics-perf/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Steps PhysicsEngine scenes for a fixed time and reports the milliseconds per substep, in total, in each of the Bullet
+//  profile buckets that PhysicsEngine::harvestPerformanceStats() reports, and in the harvest of the motion states and
+//  collision events, with the allocations per substep, so the changes to the engine can be compared scene by scene.
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+#include <LinearMath/btQuickprof.h>
+
+#include <BulletUtil.h>
+#include <EntityItemProperties.h>
+#include <EntityTypes.h>
+#include <NumericalConstants.h>
+#include <ObjectActionOffset.h>
+#include <ObjectActionSpring.h>
+#include <ObjectMotionState.h>
+#include <PhysicsCollisionGroups.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <QVariantGLM.h>
+#include <ShapeManager.h>
+#include <SharedUtil.h>
+
+// every allocation of the process is counted, the measurements read the counter before and after they run
+static std::atomic<uint64_t> allocationCount { 0 };
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* pointer = malloc(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+const glm::vec3 GRAVITY(0.0f, -9.8f, 0.0f);
+
+static float randomFloat(float minimum, float maximum) {
+    return minimum + (maximum - minimum) * ((float)qrand() / (float)RAND_MAX);
+}
+
+// a rigid body of the benchmark, with no entity or avatar behind it
+class BenchmarkMotionState : public ObjectMotionState {
+public:
+    BenchmarkMotionState(const btCollisionShape* shape, PhysicsMotionType motionType, const glm::vec3& position, float mass) :
+            ObjectMotionState(shape),
+            _benchmarkMotionType(motionType),
+            _id(QUuid::createUuid()) {
+        _transform.setIdentity();
+        _transform.setOrigin(glmToBullet(position));
+        setMass(mass);
+    }
+
+    uint32_t getIncomingDirtyFlags() override { return 0; }
+    void clearIncomingDirtyFlags() override { }
+    PhysicsMotionType computePhysicsMotionType() const override { return _benchmarkMotionType; }
+    bool isMoving() const override { return _benchmarkMotionType == MOTION_TYPE_DYNAMIC; }
+
+    void getWorldTransform(btTransform& worldTrans) const override { worldTrans = _transform; }
+    void setWorldTransform(const btTransform& worldTrans) override { _transform = worldTrans; }
+
+    float getObjectRestitution() const override { return 0.5f; }
+    float getObjectFriction() const override { return 0.5f; }
+    float getObjectLinearDamping() const override { return 0.0f; }
+    float getObjectAngularDamping() const override { return 0.1f; }
+
+    glm::vec3 getObjectPosition() const override { return bulletToGLM(_transform.getOrigin()); }
+    glm::quat getObjectRotation() const override { return bulletToGLM(_transform.getRotation()); }
+    glm::vec3 getObjectLinearVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectAngularVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectGravity() const override { return _benchmarkMotionType == MOTION_TYPE_DYNAMIC ? GRAVITY : glm::vec3(0.0f); }
+
+    const QUuid getObjectID() const override { return _id; }
+    QUuid getSimulatorID() const override { return QUuid(); }
+
+    void computeCollisionGroupAndMask(int16_t& group, int16_t& mask) const override {
+        group = _benchmarkMotionType == MOTION_TYPE_STATIC ? BULLET_COLLISION_GROUP_STATIC : BULLET_COLLISION_GROUP_DYNAMIC;
+        mask = Physics::getDefaultCollisionMask(group);
+    }
+
+protected:
+    bool isReadyToComputeShape() const override { return true; }
+    const btCollisionShape* computeNewShape() override { return _shape; }
+
+private:
+    PhysicsMotionType _benchmarkMotionType;
+    btTransform _transform;
+    QUuid _id;
+};
+
+class Scene {
+public:
+    Scene(ShapeManager& shapeManager) : _shapeManager(shapeManager) { }
+
+    BenchmarkMotionState* add(const ShapeInfo& info, PhysicsMotionType motionType, const glm::vec3& position, float mass) {
+        BenchmarkMotionState* motionState = new BenchmarkMotionState(_shapeManager.getShape(info), motionType, position, mass);
+        _motionStates.push_back(motionState);
+        return motionState;
+    }
+
+    void addGround(float halfSize) {
+        ShapeInfo info;
+        info.setBox(glm::vec3(halfSize, 0.5f, halfSize));
+        add(info, MOTION_TYPE_STATIC, glm::vec3(0.0f, -0.5f, 0.0f), 0.0f);
+    }
+
+    // the actions need an entity that points at the motion state of their body
+    EntityItemPointer addEntityFor(BenchmarkMotionState* motionState) {
+        EntityItemPointer entity = EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()),
+                                                                    EntityItemProperties());
+        entity->setPhysicsInfo(motionState);
+        _entities.push_back(entity);
+        return entity;
+    }
+
+    void addAction(EntityActionPointer action, QVariantMap arguments) {
+        _actions.push_back(action);
+        _actionArguments.push_back(arguments);
+    }
+
+    // the bodies must exist before the actions can be set up
+    void addToEngine(PhysicsEngine& engine) {
+        engine.addObjects(_motionStates);
+        for (int i = 0; i < _actions.size(); i++) {
+            _actions[i]->updateArguments(_actionArguments[i]);
+            engine.addAction(_actions[i]);
+        }
+    }
+
+    void removeFromEngine(PhysicsEngine& engine) {
+        for (auto& action : _actions) {
+            engine.removeAction(action->getID());
+        }
+        _actions.clear();
+        engine.removeObjects(_motionStates);
+        for (auto& entity : _entities) {
+            entity->setPhysicsInfo(nullptr);
+        }
+        _entities.clear();
+        for (auto motionState : _motionStates) {
+            delete motionState;
+        }
+        _motionStates.clear();
+    }
+
+    int getNumObjects() const { return _motionStates.size(); }
+
+private:
+    ShapeManager& _shapeManager;
+    VectorOfMotionStates _motionStates;
+    QVector<EntityItemPointer> _entities;
+    QVector<EntityActionPointer> _actions;
+    QVector<QVariantMap> _actionArguments;
+};
+
+// towers of ten boxes on a ground
+static void buildBoxStacks(Scene& scene, int numObjects) {
+    const int BOXES_PER_STACK = 10;
+    const float BOX_SIZE = 0.5f;
+    int numStacks = std::max(numObjects / BOXES_PER_STACK, 1);
+    int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+    scene.addGround(stacksPerRow * BOX_SIZE * 2.0f + 10.0f);
+
+    ShapeInfo info;
+    info.setBox(glm::vec3(0.5f * BOX_SIZE));
+    for (int i = 0; i < numStacks; i++) {
+        glm::vec3 base(2.0f * BOX_SIZE * (float)(i % stacksPerRow - stacksPerRow / 2), 0.0f,
+                       2.0f * BOX_SIZE * (float)(i / stacksPerRow - stacksPerRow / 2));
+        for (int j = 0; j < BOXES_PER_STACK; j++) {
+            scene.add(info, MOTION_TYPE_DYNAMIC, base + glm::vec3(0.0f, (j + 0.5f) * BOX_SIZE * 1.01f, 0.0f), 1.0f);
+        }
+    }
+}
+
+// random convex hulls dropped onto each other
+static void buildHullPile(Scene& scene, int numObjects) {
+    const int NUM_HULL_SHAPES = 16;
+    const int POINTS_PER_HULL = 12;
+    QVector<ShapeInfo> infos;
+    for (int i = 0; i < NUM_HULL_SHAPES; i++) {
+        ShapeInfo::PointList points;
+        for (int j = 0; j < POINTS_PER_HULL; j++) {
+            points.push_back(glm::vec3(randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f), randomFloat(-0.3f, 0.3f)));
+        }
+        ShapeInfo::PointCollection pointCollection;
+        pointCollection.push_back(points);
+        ShapeInfo info;
+        info.setParams(SHAPE_TYPE_HULL, glm::vec3(0.3f), "hull" + QString::number(i));
+        info.setPointCollection(pointCollection);
+        infos.push_back(info);
+    }
+
+    float halfSize = 0.25f * sqrtf((float)numObjects) + 1.0f;
+    scene.addGround(halfSize + 10.0f);
+    for (int i = 0; i < numObjects; i++) {
+        glm::vec3 position(randomFloat(-halfSize, halfSize), randomFloat(0.5f, 10.0f), randomFloat(-halfSize, halfSize));
+        scene.add(infos[i % NUM_HULL_SHAPES], MOTION_TYPE_DYNAMIC, position, 1.0f);
+    }
+}
+
+// spheres landing on a large bumpy static mesh
+static void buildStaticMesh(Scene& scene, int numObjects) {
+    const int GRID_SIZE = 200;
+    const float CELL_SIZE = 0.5f;
+    float halfSize = 0.5f * GRID_SIZE * CELL_SIZE;
+
+    ShapeInfo::PointList points;
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        for (int j = 0; j <= GRID_SIZE; j++) {
+            float x = i * CELL_SIZE - halfSize;
+            float z = j * CELL_SIZE - halfSize;
+            points.push_back(glm::vec3(x, 0.5f * sinf(0.3f * x) * cosf(0.2f * z), z));
+        }
+    }
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(points);
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(halfSize, 0.5f, halfSize), "terrain");
+    info.setPointCollection(pointCollection);
+    ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    for (int i = 0; i < GRID_SIZE; i++) {
+        for (int j = 0; j < GRID_SIZE; j++) {
+            int32_t corner = i * (GRID_SIZE + 1) + j;
+            indices << corner << corner + 1 << corner + GRID_SIZE + 1;
+            indices << corner + 1 << corner + GRID_SIZE + 2 << corner + GRID_SIZE + 1;
+        }
+    }
+    scene.add(info, MOTION_TYPE_STATIC, glm::vec3(0.0f), 0.0f);
+
+    ShapeInfo sphereInfo;
+    sphereInfo.setSphere(0.25f);
+    for (int i = 0; i < numObjects; i++) {
+        glm::vec3 position(randomFloat(-halfSize, halfSize), randomFloat(1.0f, 10.0f), randomFloat(-halfSize, halfSize));
+        scene.add(sphereInfo, MOTION_TYPE_DYNAMIC, position, 1.0f);
+    }
+}
+
+// floating boxes held by springs and offsets, the way grabbed and tethered entities are
+static void buildActions(Scene& scene, int numObjects) {
+    float halfSize = 0.5f * sqrtf((float)numObjects) + 1.0f;
+    scene.addGround(halfSize + 10.0f);
+
+    ShapeInfo info;
+    info.setBox(glm::vec3(0.2f));
+    for (int i = 0; i < numObjects; i++) {
+        glm::vec3 position(randomFloat(-halfSize, halfSize), randomFloat(1.0f, 3.0f), randomFloat(-halfSize, halfSize));
+        BenchmarkMotionState* motionState = scene.add(info, MOTION_TYPE_DYNAMIC, position, 1.0f);
+        EntityItemPointer entity = scene.addEntityFor(motionState);
+
+        QVariantMap arguments;
+        if (i % 2) {
+            arguments["targetPosition"] = glmToQMap(position + glm::vec3(randomFloat(-1.0f, 1.0f), 0.5f, randomFloat(-1.0f, 1.0f)));
+            arguments["linearTimeScale"] = 0.2f;
+            arguments["targetRotation"] = glmToQMap(glm::angleAxis(randomFloat(0.0f, TWO_PI), glm::vec3(0.0f, 1.0f, 0.0f)));
+            arguments["angularTimeScale"] = 0.2f;
+            scene.addAction(EntityActionPointer(new ObjectActionSpring(QUuid::createUuid(), entity)), arguments);
+        } else {
+            arguments["pointToOffsetFrom"] = glmToQMap(position + glm::vec3(0.0f, 2.0f, 0.0f));
+            arguments["linearTimeScale"] = 0.5f;
+            arguments["linearDistance"] = 1.0f;
+            scene.addAction(EntityActionPointer(new ObjectActionOffset(QUuid::createUuid(), entity)), arguments);
+        }
+    }
+}
+
+// adds the times of the Bullet profile of the last stepSimulation(), by the same names as harvestPerformanceStats()
+static void accumulateProfile(CProfileIterator* profileIterator, const QString& parentName, QMap<QString, double>& times) {
+    int numChildren = 0;
+    profileIterator->First();
+    while (!profileIterator->Is_Done()) {
+        QString name = parentName + "/" + profileIterator->Get_Current_Name();
+        times[name] += profileIterator->Get_Current_Total_Time();
+        profileIterator->Next();
+        ++numChildren;
+    }
+    for (int i = 0; i < numChildren; ++i) {
+        profileIterator->Enter_Child(i);
+        accumulateProfile(profileIterator, parentName + "/" + profileIterator->Get_Current_Parent_Name(), times);
+        profileIterator->Enter_Parent();
+    }
+}
+
+static void runScene(const char* name, void (*build)(Scene&, int), ShapeManager& shapeManager, int numObjects, float seconds) {
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+    Scene scene(shapeManager);
+    build(scene, numObjects);
+    scene.addToEngine(engine);
+
+    QMap<QString, double> profileTimes; // milliseconds
+    quint64 stepUsecs = 0;
+    quint64 harvestUsecs = 0;
+    uint64_t allocations = 0;
+    uint32_t startSubsteps = engine.getNumSubsteps();
+    size_t numCollisionEvents = 0;
+
+    quint64 endTime = usecTimestampNow() + (quint64)(seconds * USECS_PER_SECOND);
+    while (usecTimestampNow() < endTime) {
+        uint32_t numSubsteps = engine.getNumSubsteps();
+        uint64_t startAllocations = allocationCount;
+        quint64 startTime = usecTimestampNow();
+        engine.stepSimulation();
+        quint64 stepTime = usecTimestampNow();
+        if (engine.getNumSubsteps() == numSubsteps) {
+            // faster than the fixed substep, wait for the clock of the engine to catch up
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (engine.hasOutgoingChanges()) {
+            numCollisionEvents += engine.getCollisionEvents().size();
+            engine.getChangedMotionStates();
+        }
+        quint64 harvestTime = usecTimestampNow();
+        allocations += allocationCount - startAllocations;
+        stepUsecs += stepTime - startTime;
+        harvestUsecs += harvestTime - stepTime;
+
+        CProfileIterator* profileIterator = CProfileManager::Get_Iterator();
+        if (profileIterator) {
+            accumulateProfile(profileIterator, "", profileTimes);
+            CProfileManager::Release_Iterator(profileIterator);
+        }
+    }
+
+    double numSubsteps = (double)std::max(engine.getNumSubsteps() - startSubsteps, (uint32_t)1);
+    qDebug().noquote() << QString("%1: %2 objects, %3 substeps, %4 ms/substep, %5 ms/substep harvest, "
+                                  "%6 allocations/substep, %7 collision events/substep")
+        .arg(name)
+        .arg(scene.getNumObjects())
+        .arg(numSubsteps, 0, 'f', 0)
+        .arg((double)stepUsecs / USECS_PER_MSEC / numSubsteps, 0, 'f', 3)
+        .arg((double)harvestUsecs / USECS_PER_MSEC / numSubsteps, 0, 'f', 3)
+        .arg((double)allocations / numSubsteps, 0, 'f', 1)
+        .arg((double)numCollisionEvents / numSubsteps, 0, 'f', 1);
+    for (auto itr = profileTimes.constBegin(); itr != profileTimes.constEnd(); ++itr) {
+        qDebug().noquote() << QString("    %1 %2 ms/substep").arg(itr.key(), -72).arg(itr.value() / numSubsteps, 0, 'f', 3);
+    }
+
+    scene.removeFromEngine(engine);
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the PhysicsEngine stepping stacks of boxes, piles of hulls, "
+                                     "a large static mesh and many actions.");
+    parser.addHelpOption();
+    const QCommandLineOption objectsOption("objects", "number of bodies in each scene", "count", "1000");
+    const QCommandLineOption secondsOption("seconds", "time each scene is stepped for", "seconds", "10");
+    const QCommandLineOption sceneOption("scene", "only run this scene: boxes, hulls, mesh or actions", "name");
+    parser.addOptions({ objectsOption, secondsOption, sceneOption });
+    parser.process(app);
+
+    int numObjects = std::max(parser.value(objectsOption).toInt(), 1);
+    float seconds = std::max(parser.value(secondsOption).toFloat(), 0.1f);
+    QString onlyScene = parser.value(sceneOption);
+
+    ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+    ObjectMotionState::setWorldOffset(glm::vec3(0.0f));
+    qsrand(1);
+
+    struct SceneBuilder {
+        const char* name;
+        void (*build)(Scene&, int);
+    };
+    const SceneBuilder SCENES[] = {
+        { "boxes", buildBoxStacks },
+        { "hulls", buildHullPile },
+        { "mesh", buildStaticMesh },
+        { "actions", buildActions }
+    };
+    for (const auto& scene : SCENES) {
+        if (onlyScene.isEmpty() || onlyScene == scene.name) {
+            runScene(scene.name, scene.build, shapeManager, numObjects, seconds);
+        }
+    }
+    return 0;
+}
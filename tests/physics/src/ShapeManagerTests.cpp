@@ -10,6 +10,7 @@
 //
 
 #include <iostream>
+#include <ShapeFactory.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -243,3 +244,85 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::requestHullShape() {
+    ShapeInfo::PointList pointList;
+    pointList.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    pointList.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    pointList.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    pointList.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(pointList);
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_HULL, glm::vec3(1.0f));
+    info.setPointCollection(pointCollection);
+
+    // the hull is built on a worker, keep asking until it is ready
+    ShapeManager shapeManager;
+    const btCollisionShape* shape = nullptr;
+    const int MAX_NUM_REQUESTS = 1000;
+    for (int i = 0; i < MAX_NUM_REQUESTS && !shape; ++i) {
+        shape = shapeManager.requestShape(info);
+        if (!shape) {
+            QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+            QTest::qWait(1);
+        }
+    }
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+
+    // a synchronous request shares the same shape
+    const btCollisionShape* otherShape = shapeManager.getShape(info);
+    QCOMPARE(shape, otherShape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(otherShape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+}
+
+void ShapeManagerTests::serializeCompoundShape() {
+    ShapeInfo::PointCollection pointCollection;
+    for (int i = 0; i < 3; ++i) {
+        glm::vec3 offset((float)i, 0.0f, 0.0f);
+        ShapeInfo::PointList pointList;
+        pointList.push_back(glm::vec3(1.0f, 1.0f, 1.0f) + offset);
+        pointList.push_back(glm::vec3(1.0f, -1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, 1.0f, -1.0f) + offset);
+        pointList.push_back(glm::vec3(-1.0f, -1.0f, 1.0f) + offset);
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f, 1.0f, 1.0f));
+    info.setPointCollection(pointCollection);
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    QVERIFY(!data.isEmpty());
+
+    // the loaded shape has the same hulls
+    const btCollisionShape* loadedShape = ShapeFactory::createShapeFromData(info, data);
+    QVERIFY(loadedShape != nullptr);
+    QCOMPARE(loadedShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    auto compound = static_cast<const btCompoundShape*>(shape);
+    auto loadedCompound = static_cast<const btCompoundShape*>(loadedShape);
+    QCOMPARE(loadedCompound->getNumChildShapes(), compound->getNumChildShapes());
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        auto hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        auto loadedHull = static_cast<const btConvexHullShape*>(loadedCompound->getChildShape(i));
+        QCOMPARE(loadedHull->getShapeType(), (int)CONVEX_HULL_SHAPE_PROXYTYPE);
+        QCOMPARE(loadedHull->getNumPoints(), hull->getNumPoints());
+        QCOMPARE(loadedHull->getMargin(), hull->getMargin());
+    }
+
+    // truncated data is rejected
+    QVERIFY(ShapeFactory::createShapeFromData(info, data.left(data.size() / 2)) == nullptr);
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(loadedShape);
+}
@@ -79,6 +79,44 @@ void testFilePersist() {
     QVERIFY(readClip->duration() == 5.0f);
 }
 
+void testFileIndex() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // more frames than a single index frame holds
+    const int FRAME_COUNT = 10000;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray::number(i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == (size_t)FRAME_COUNT);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    Frame::Time seekTime = FRAME_COUNT / 2;
+    readClip->seekFrameTime(seekTime);
+    writeClip->seekFrameTime(seekTime);
+    auto readFrame = readClip->nextFrame();
+    auto writeFrame = writeClip->nextFrame();
+    QVERIFY(readFrame && writeFrame);
+    QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+    QVERIFY(readFrame->data == writeFrame->data);
+
+    // a file cut short loses its index, and is still read by scanning its frames
+    QFile truncatedFile(fileName);
+    QVERIFY(truncatedFile.resize(truncatedFile.size() - 1));
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == (size_t)FRAME_COUNT);
+}
+
 void testClipOrdering() {
     auto writeClip = Clip::newClip();
     // simulate our of order addition of frames
@@ -110,5 +148,6 @@ int main(int, const char**) {
 #endif
     testFrameTypeRegistration();
     testFilePersist();
+    testFileIndex();
     testClipOrdering();
 }
\ No newline at end of file
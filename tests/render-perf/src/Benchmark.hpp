@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <gpu/Context.h>
+#include <gpu/Texture.h>
+#include <render/Engine.h>
+
+// Writes a CSV row per frame with the CPU time of every job of the engine, the GPU and batch times of the GPU jobs
+// (averaged by their timers over the last frames), the draw calls and triangles of the last executed frame and the
+// texture memory. The columns are fixed when recording starts.
+class Benchmark {
+public:
+    bool isRecording() const { return _file.isOpen(); }
+
+    bool start(const QString& fileName, const render::EnginePointer& engine) {
+        stop();
+        _file.setFileName(fileName);
+        if (!_file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+            qWarning() << "Cannot write the benchmark results to" << fileName;
+            return false;
+        }
+        _stream.setDevice(&_file);
+
+        QStringList columns { "frame", "time_ms" };
+        _jobs.clear();
+        auto rootConfig = engine->getConfiguration();
+        for (auto job : rootConfig->findChildren<render::JobConfig*>()) {
+            // The nested jobs by their path in the tasks, their names alone are not unique
+            QString path = job->objectName();
+            for (auto parent = job->parent(); parent && parent != rootConfig.get(); parent = parent->parent()) {
+                path = parent->objectName() + "/" + path;
+            }
+            auto gpuJob = qobject_cast<render::GPUJobConfig*>(job);
+            columns << path + " cpu_ms";
+            if (gpuJob) {
+                columns << path + " gpu_ms" << path + " batch_ms";
+            }
+            _jobs.push_back({ job, gpuJob });
+        }
+        columns << "draw_calls" << "api_draw_calls" << "triangles" << "texture_gpu_bytes" << "texture_cpu_bytes";
+        _stream << columns.join(',') << '\n';
+
+        _numFrames = 0;
+        _startTime = usecTimestampNow();
+        return true;
+    }
+
+    void recordFrame(const gpu::ContextStats& frameStats) {
+        if (!isRecording()) {
+            return;
+        }
+        _stream << _numFrames++ << ',' << (double)(usecTimestampNow() - _startTime) / USECS_PER_MSEC;
+        for (const auto& job : _jobs) {
+            _stream << ',' << job.config->getCPURunTime();
+            if (job.gpuConfig) {
+                _stream << ',' << job.gpuConfig->getGPURunTime() << ',' << job.gpuConfig->getBatchRunTime();
+            }
+        }
+        _stream << ',' << frameStats._DSNumDrawcalls << ',' << frameStats._DSNumAPIDrawcalls << ',' << frameStats._DSNumTriangles;
+        _stream << ',' << gpu::Context::getTextureGPUMemoryUsage() << ',' << gpu::Texture::getTextureCPUMemoryUsage() << '\n';
+    }
+
+    void stop() {
+        if (!isRecording()) {
+            return;
+        }
+        _stream.flush();
+        qDebug() << "Recorded" << _numFrames << "frames to" << _file.fileName();
+        _file.close();
+        _jobs.clear();
+    }
+
+private:
+    struct Job {
+        render::JobConfig* config;
+        render::GPUJobConfig* gpuConfig;
+    };
+    std::vector<Job> _jobs;
+
+    QFile _file;
+    QTextStream _stream;
+    size_t _numFrames { 0 };
+    quint64 _startTime { 0 };
+};
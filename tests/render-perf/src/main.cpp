@@ -16,6 +16,7 @@
 
 #include <QProcessEnvironment>
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
@@ -72,12 +73,15 @@
 #include <SceneScriptingInterface.h>
 
 #include "Camera.hpp"
+#include "Benchmark.hpp"
 
 Q_DECLARE_LOGGING_CATEGORY(renderperflogging)
 Q_LOGGING_CATEGORY(renderperflogging, "hifi.render_perf")
 
 static const QString LAST_SCENE_KEY = "lastSceneFile";
 static const QString LAST_LOCATION_KEY = "lastLocation";
+// The flights advance by a fixed step per frame, for the benchmarks to render the same views on every hardware
+static const float FLIGHT_FRAMES_PER_SECOND = 60.0f;
 
 class ParentFinder : public SpatialParentFinder {
 public:
@@ -206,6 +210,13 @@ public:
     gpu::FramePointer _activeFrame;
     QSize _size;
     static const size_t FRAME_TIME_BUFFER_SIZE { 8192 };
+    std::mutex _statsMutex;
+    gpu::ContextStats _frameStats;
+
+    gpu::ContextStats getFrameStats() {
+        std::unique_lock<std::mutex> lock(_statsMutex);
+        return _frameStats;
+    }
 
     void submitFrame(const gpu::FramePointer& frame) {
         std::unique_lock<std::mutex> lock(_frameLock);
@@ -279,6 +290,10 @@ public:
         _backend->syncCache();
         if (frame && !frame->batches.empty()) {
             _gpuContext->executeFrame(frame);
+            {
+                std::unique_lock<std::mutex> lock(_statsMutex);
+                _gpuContext->getFrameStats(_frameStats);
+            }
 
             {
 
@@ -724,6 +739,7 @@ private:
 
         // Final framebuffer that will be handled to the display-plugin
         render(&renderArgs);
+        _benchmark.recordFrame(_renderThread.getFrameStats());
 
         if (_fps != _renderThread._fps) {
             _fps = _renderThread._fps;
@@ -820,6 +836,35 @@ private:
             return;
         }
         parsePath(commandParams[1]);
+    } else if (verb == "fly") {
+        if (commandParams.length() < 3) {
+            qDebug() << "No duration or destination specified for fly command";
+            return;
+        }
+        _flightFromPosition = _camera.position;
+        _flightFromOrientation = _camera.getOrientation();
+        parsePath(commandParams[2]);
+        _flightToPosition = _camera.position;
+        _flightToOrientation = _camera.getOrientation();
+        _camera.setPosition(_flightFromPosition);
+        _camera.setRotation(_flightFromOrientation);
+        _flightFrames = std::max((int)(commandParams[1].toFloat() * FLIGHT_FRAMES_PER_SECOND), 1);
+        _flightFrame = 0;
+    } else if (verb == "record") {
+        if (commandParams.length() < 2) {
+            qDebug() << "No results file specified for record command";
+            return;
+        }
+        QString file = commandParams[1];
+        if (QFileInfo(file).isRelative()) {
+            file = _commandPath + "/" + file;
+        }
+        _benchmark.start(file, _renderEngine);
+    } else if (verb == "stop") {
+        _benchmark.stop();
+    } else if (verb == "quit") {
+        _benchmark.stop();
+        QCoreApplication::quit();
     } else {
         qDebug() << "Unknown command " << command;
     }
@@ -839,6 +884,11 @@ private:
             return;
         }
 
+        // The next command waits for the flight to land
+        if (_flightFrame < _flightFrames) {
+            return;
+        }
+
         _nextCommandTime = 0;
         QString command = _commands[_commandIndex++];
         runCommand(command);
@@ -852,6 +902,11 @@ private:
 
         float delta = now - last;
         // Update the camera
+        if (_flightFrame < _flightFrames) {
+            float t = (float)(++_flightFrame) / (float)_flightFrames;
+            _camera.setPosition(glm::mix(_flightFromPosition, _flightToPosition, t));
+            _camera.setRotation(glm::slerp(_flightFromOrientation, _flightToOrientation, t));
+        }
         _camera.update(delta / USECS_PER_SECOND);
         {
             _viewFrustum = ViewFrustum();
@@ -1115,6 +1170,14 @@ private:
     int _commandIndex { -1 };
     uint64_t _nextCommandTime { 0 };
 
+    vec3 _flightFromPosition;
+    quat _flightFromOrientation;
+    vec3 _flightToPosition;
+    quat _flightToOrientation;
+    int _flightFrames { 0 };
+    int _flightFrame { 0 };
+    Benchmark _benchmark;
+
     //TextOverlay* _textOverlay;
     static bool _cullingEnabled;
 
@@ -1156,9 +1219,27 @@ int main(int argc, char** argv) {
 
     qInstallMessageHandler(messageHandler);
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
+
+    // The commands script runs the benchmarks, for instance:
+    //   load scene.json
+    //   wait 20
+    //   go /-17.2049,-8.08629,-19.4153/0,0.881994,0,-0.47126
+    //   record results.csv
+    //   fly 10 /10,-8,-19/0,0.5,0,0.866025
+    //   stop
+    //   quit
+    // The models and textures of the scene load from the .atp directory next to it when there is one
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption commandsOption("commands", "Runs the commands of the file, load, wait, go, fly, record, stop, loop and quit", "file");
+    parser.addOption(commandsOption);
+    parser.process(app);
+
     QTestWindow::setup();
     QTestWindow window;
-    //window.loadCommands("C:/Users/bdavis/Git/dreaming/exports2/commands.txt");
+    if (parser.isSet(commandsOption)) {
+        window.loadCommands(parser.value(commandsOption));
+    }
     app.exec();
     return 0;
 }
@@ -0,0 +1,94 @@
+//
+//  BoundedQueueTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BoundedQueueTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <shared/BoundedQueue.h>
+
+QTEST_MAIN(BoundedQueueTests)
+
+void BoundedQueueTests::testOrder() {
+    BoundedQueue<QString> queue(4);
+    QString value;
+    QVERIFY(!queue.pop(value));
+
+    // more values than the capacity go through, as long as they're popped
+    for (int i = 0; i < 10; i++) {
+        QVERIFY(queue.push(QString::number(i)));
+        QVERIFY(queue.push(QString::number(i) + "b"));
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, QString::number(i));
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, QString::number(i) + "b");
+    }
+    QVERIFY(!queue.pop(value));
+}
+
+void BoundedQueueTests::testFull() {
+    BoundedQueue<int> queue(5);
+    QCOMPARE(queue.capacity(), (size_t)8);
+    for (int i = 0; i < 8; i++) {
+        QVERIFY(queue.push(i));
+    }
+    QVERIFY(!queue.push(8));
+
+    int value;
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, 0);
+    QVERIFY(queue.push(8));
+    for (int i = 1; i <= 8; i++) {
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.pop(value));
+}
+
+void BoundedQueueTests::testProducers() {
+    const int NUM_PRODUCERS = 4;
+    const int VALUES_PER_PRODUCER = 10000;
+    BoundedQueue<int> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; producer++) {
+        producers.emplace_back([&queue, producer] {
+            for (int i = 0; i < VALUES_PER_PRODUCER; i++) {
+                while (!queue.push(producer * VALUES_PER_PRODUCER + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // each value once, and those of a producer in the order it pushed them
+    std::vector<int> nextValues(NUM_PRODUCERS, 0);
+    bool isInOrder = true;
+    int count = 0;
+    while (count < NUM_PRODUCERS * VALUES_PER_PRODUCER) {
+        int value;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / VALUES_PER_PRODUCER;
+        isInOrder = isInOrder && value % VALUES_PER_PRODUCER == nextValues[producer];
+        nextValues[producer]++;
+        count++;
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+    QVERIFY(isInOrder);
+    int value;
+    QVERIFY(!queue.pop(value));
+}
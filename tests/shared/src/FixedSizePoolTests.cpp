@@ -0,0 +1,78 @@
+//
+//  FixedSizePoolTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FixedSizePoolTests.h"
+
+#include <memory>
+#include <set>
+
+#include <shared/FixedSizePool.h>
+
+QTEST_MAIN(FixedSizePoolTests)
+
+struct PooledObject {
+    PooledObject(int value) : value(value) {}
+    int value;
+    double padding[5];
+};
+
+void FixedSizePoolTests::testBlocksAreReused() {
+    const size_t BLOCKS_PER_CHUNK = 4;
+    FixedSizePool* pool = new FixedSizePool("test", sizeof(PooledObject), BLOCKS_PER_CHUNK); // pools are never deleted
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < BLOCKS_PER_CHUNK + 1; i++) {
+        blocks.push_back(pool->allocate());
+    }
+    QCOMPARE(pool->getStats().used, BLOCKS_PER_CHUNK + 1);
+    QCOMPARE(pool->getStats().capacity, 2 * BLOCKS_PER_CHUNK);
+    QVERIFY(pool->getStats().blockSize >= sizeof(PooledObject));
+    QCOMPARE(std::set<void*>(blocks.begin(), blocks.end()).size(), blocks.size());
+
+    // the blocks of a chunk are handed out one after the other
+    QCOMPARE((char*)blocks[1] - (char*)blocks[0], (ptrdiff_t)pool->getStats().blockSize);
+
+    void* freed = blocks.back();
+    pool->deallocate(freed);
+    blocks.pop_back();
+    QCOMPARE(pool->getStats().used, BLOCKS_PER_CHUNK);
+    QCOMPARE(pool->allocate(), freed);
+
+    bool found = false;
+    for (const auto& stats : FixedSizePool::getAllStats()) {
+        found = found || QString(stats.name) == "test";
+    }
+    QVERIFY(found);
+}
+
+void FixedSizePoolTests::testAllocateShared() {
+    std::vector<std::shared_ptr<PooledObject>> objects;
+    for (int i = 0; i < 1000; i++) {
+        objects.push_back(std::allocate_shared<PooledObject>(PoolAllocator<PooledObject>(), i));
+    }
+    for (int i = 0; i < 1000; i++) {
+        QCOMPARE(objects[i]->value, i);
+    }
+
+    // the objects and their counts share a block of the pool of the rebound type
+    size_t used = 0;
+    for (const auto& stats : FixedSizePool::getAllStats()) {
+        used += stats.used;
+    }
+    QVERIFY(used >= 1000);
+    objects.clear();
+
+    size_t usedAfter = 0;
+    for (const auto& stats : FixedSizePool::getAllStats()) {
+        usedAfter += stats.used;
+    }
+    QCOMPARE(usedAfter, used - 1000);
+}
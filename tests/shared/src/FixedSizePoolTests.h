@@ -0,0 +1,24 @@
+//
+//  FixedSizePoolTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FixedSizePoolTests_h
+#define hifi_FixedSizePoolTests_h
+
+#include <QtTest/QtTest>
+
+class FixedSizePoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBlocksAreReused();
+    void testAllocateShared();
+};
+
+#endif // hifi_FixedSizePoolTests_h
@@ -105,6 +105,41 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
 
+static void testCoarseQuatCompression(glm::quat testQuat) {
+
+    float MAX_COMPONENT_ERROR = 1.7e-3f;
+
+    glm::quat q;
+    uint8_t bytes[4];
+    QCOMPARE(packOrientationQuatToFourBytes(bytes, testQuat), 4);
+    QCOMPARE(unpackOrientationQuatFromFourBytes(bytes, q), 4);
+    if (glm::dot(q, testQuat) < 0.0f) {
+        q = -q;
+    }
+    QCOMPARE_WITH_ABS_ERROR(q.x, testQuat.x, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.y, testQuat.y, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.z, testQuat.z, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
+}
+
+void GLMHelpersTests::testFourByteOrientationCompression() {
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    testCoarseQuatCompression(glm::quat());
+    testCoarseQuatCompression(ROT_X_90);
+    testCoarseQuatCompression(ROT_Y_180);
+    testCoarseQuatCompression(ROT_Z_30);
+    testCoarseQuatCompression(ROT_X_90 * ROT_Y_180 * ROT_Z_30);
+    testCoarseQuatCompression(-(ROT_Y_180 * ROT_Z_30 * ROT_X_90));
+
+    // the component boundaries: two (and four) equal largest components
+    testCoarseQuatCompression(glm::normalize(glm::quat(1.0f, 1.0f, 0.0f, 0.0f)));
+    testCoarseQuatCompression(glm::quat(0.5f, 0.5f, 0.5f, 0.5f));
+    testCoarseQuatCompression(glm::quat(-0.5f, 0.5f, -0.5f, 0.5f));
+}
+
 #define LOOPS 500000
 
 void GLMHelpersTests::testSimd() {
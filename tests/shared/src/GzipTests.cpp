@@ -0,0 +1,88 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+// more than a few chunks of the streams, in a form that compresses
+static QByteArray makeData() {
+    QByteArray data;
+    for (int i = 0; i < 100000; i++) {
+        data += QByteArray::number(i * 7919 % 1000) + ",";
+    }
+    return data;
+}
+
+static bool gzipStream(const QByteArray& source, QByteArray& destination, qint64& lastBytesRead) {
+    QBuffer sourceBuffer(const_cast<QByteArray*>(&source));
+    sourceBuffer.open(QIODevice::ReadOnly);
+    QBuffer destinationBuffer(&destination);
+    destinationBuffer.open(QIODevice::WriteOnly);
+    return gzip(sourceBuffer, destinationBuffer, -1, 0, [&](qint64 bytesRead, qint64 bytesTotal) {
+        QCOMPARE(bytesTotal, (qint64)source.size());
+        QVERIFY(bytesRead >= lastBytesRead);
+        lastBytesRead = bytesRead;
+    });
+}
+
+static bool gunzipStream(const QByteArray& source, QByteArray& destination) {
+    QBuffer sourceBuffer(const_cast<QByteArray*>(&source));
+    sourceBuffer.open(QIODevice::ReadOnly);
+    QBuffer destinationBuffer(&destination);
+    destinationBuffer.open(QIODevice::WriteOnly);
+    return gunzip(sourceBuffer, destinationBuffer);
+}
+
+void GzipTests::testStreamRoundTrip() {
+    QByteArray data = makeData();
+    QByteArray compressed;
+    qint64 lastBytesRead = 0;
+    QVERIFY(gzipStream(data, compressed, lastBytesRead));
+    QCOMPARE(lastBytesRead, (qint64)data.size());
+    QVERIFY(compressed.size() < data.size());
+
+    QByteArray uncompressed;
+    QVERIFY(gunzipStream(compressed, uncompressed));
+    QCOMPARE(uncompressed, data);
+}
+
+void GzipTests::testStreamMatchesBuffers() {
+    QByteArray data = makeData();
+
+    // what the streams write, the buffers read, and the other way around
+    QByteArray streamCompressed;
+    qint64 lastBytesRead = 0;
+    QVERIFY(gzipStream(data, streamCompressed, lastBytesRead));
+    QByteArray bufferUncompressed;
+    QVERIFY(gunzip(streamCompressed, bufferUncompressed));
+    QCOMPARE(bufferUncompressed, data);
+
+    QByteArray bufferCompressed;
+    QVERIFY(gzip(data, bufferCompressed));
+    QByteArray streamUncompressed;
+    QVERIFY(gunzipStream(bufferCompressed, streamUncompressed));
+    QCOMPARE(streamUncompressed, data);
+}
+
+void GzipTests::testTruncatedStream() {
+    QByteArray compressed;
+    QVERIFY(gzip(makeData(), compressed));
+    compressed.truncate(compressed.size() / 2);
+
+    QByteArray uncompressed;
+    QVERIFY(!gunzipStream(compressed, uncompressed));
+    QVERIFY(!gunzipStream("not gzip", uncompressed));
+}
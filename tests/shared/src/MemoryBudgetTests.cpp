@@ -0,0 +1,131 @@
+//
+//  MemoryBudgetTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryBudgetTests.h"
+
+#include <MemoryBudget.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(MemoryBudgetTests)
+
+class TestClient : public MemoryBudgetClient {
+public:
+    TestClient(Pool pool, qint64 usage, float rebuildCost) : pool(pool), usage(usage), rebuildCost(rebuildCost) {}
+
+    virtual QString getMemoryBudgetName() const override { return "Test"; }
+    virtual Pool getMemoryBudgetPool() const override { return pool; }
+    virtual qint64 getMemoryUsage() const override { return usage; }
+    virtual qint64 getReleasableMemory() const override { return usage; }
+    virtual float getRebuildCost() const override { return rebuildCost; }
+    virtual qint64 releaseMemory(qint64 size) override {
+        released += size;
+        usage -= size;
+        return size;
+    }
+    virtual void relaxMemory() override { relaxed++; }
+
+    Pool pool;
+    qint64 usage;
+    float rebuildCost;
+    qint64 released { 0 };
+    int relaxed { 0 };
+};
+
+static const qint64 RELEASE_MARGIN = MB_TO_BYTES(64);
+
+void MemoryBudgetTests::testCPUBudget() {
+    MemoryBudget budget;
+    TestClient costly(MemoryBudgetClient::CPU, MB_TO_BYTES(150), 2.0f);
+    TestClient cheap(MemoryBudgetClient::CPU, MB_TO_BYTES(50), 1.0f);
+    budget.registerClient(&costly);
+    budget.registerClient(&cheap);
+    budget.setCPUBudget(MB_TO_BYTES(100));
+
+    // the cheapest to rebuild gives back all it has before the other is asked
+    MemoryInfo noMemory {};
+    qint64 released = budget.check(noMemory, false, false, 0);
+    QCOMPARE(released, (qint64)MB_TO_BYTES(100) + RELEASE_MARGIN);
+    QCOMPARE(cheap.released, (qint64)MB_TO_BYTES(50));
+    QCOMPARE(costly.released, (qint64)MB_TO_BYTES(50) + RELEASE_MARGIN);
+    QVERIFY(budget.isUnderCPUPressure());
+
+    // within the budget nothing more is asked
+    QCOMPARE(budget.check(noMemory, false, false, 0), (qint64)0);
+
+    budget.unregisterClient(&costly);
+    budget.unregisterClient(&cheap);
+}
+
+void MemoryBudgetTests::testRelax() {
+    MemoryBudget budget;
+    TestClient client(MemoryBudgetClient::CPU, MB_TO_BYTES(200), 1.0f);
+    budget.registerClient(&client);
+    budget.setCPUBudget(MB_TO_BYTES(100));
+
+    MemoryInfo noMemory {};
+    budget.check(noMemory, false, false, 0);
+    QVERIFY(budget.isUnderCPUPressure());
+
+    // the pressure lasts a few checks after the shortfall is over
+    budget.check(noMemory, false, false, 0);
+    QVERIFY(budget.isUnderCPUPressure());
+    QCOMPARE(client.relaxed, 0);
+
+    for (int i = 0; i < 20; i++) {
+        budget.check(noMemory, false, false, 0);
+    }
+    QVERIFY(!budget.isUnderCPUPressure());
+    QCOMPARE(client.relaxed, 1);
+
+    budget.unregisterClient(&client);
+}
+
+void MemoryBudgetTests::testGPUPool() {
+    MemoryBudget budget;
+    TestClient cpuClient(MemoryBudgetClient::CPU, MB_TO_BYTES(500), 0.1f);
+    TestClient gpuClient(MemoryBudgetClient::GPU, MB_TO_BYTES(500), 1.0f);
+    budget.registerClient(&cpuClient);
+    budget.registerClient(&gpuClient);
+    budget.setCPUBudget(MB_TO_BYTES(1000));
+
+    // a GPU short of memory asks only the clients of the GPU
+    MemoryInfo noMemory {};
+    budget.check(noMemory, false, false, (qint64)MB_TO_BYTES(100));
+    QVERIFY(budget.isUnderGPUPressure());
+    QVERIFY(!budget.isUnderCPUPressure());
+    QCOMPARE(cpuClient.released, (qint64)0);
+    QCOMPARE(gpuClient.released, (qint64)MB_TO_BYTES(256 - 100) + RELEASE_MARGIN);
+
+    budget.unregisterClient(&cpuClient);
+    budget.unregisterClient(&gpuClient);
+}
+
+void MemoryBudgetTests::testLowSystemMemory() {
+    MemoryBudget budget;
+    TestClient client(MemoryBudgetClient::CPU, MB_TO_BYTES(1000), 1.0f);
+    budget.registerClient(&client);
+    budget.setCPUBudget(MB_TO_BYTES(4000));
+
+    // 8 GB with 600 MB available is 200 MB short of a tenth of the memory
+    MemoryInfo systemMemory {};
+    systemMemory.totalMemoryBytes = MB_TO_BYTES(8000);
+    systemMemory.availMemoryBytes = MB_TO_BYTES(600);
+    budget.check(systemMemory, true, false, 0);
+    QVERIFY(qAbs(client.released - ((qint64)MB_TO_BYTES(200) + RELEASE_MARGIN)) < (qint64)MB_TO_BYTES(1));
+
+    // the low memory signal of the system asks for memory even when enough looks available
+    client.released = 0;
+    systemMemory.availMemoryBytes = MB_TO_BYTES(4000);
+    budget.check(systemMemory, true, true, 0);
+    QVERIFY(client.released > 0);
+
+    budget.unregisterClient(&client);
+}
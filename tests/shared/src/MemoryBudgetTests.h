@@ -0,0 +1,26 @@
+//
+//  MemoryBudgetTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MemoryBudgetTests_h
+#define hifi_MemoryBudgetTests_h
+
+#include <QtTest/QtTest>
+
+class MemoryBudgetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCPUBudget();
+    void testRelax();
+    void testGPUPool();
+    void testLowSystemMemory();
+};
+
+#endif // hifi_MemoryBudgetTests_h
@@ -0,0 +1,110 @@
+//
+//  MetricsTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsTests.h"
+
+#include <Metrics.h>
+
+QTEST_MAIN(MetricsTests)
+
+void MetricsTests::testCounterAndGauge() {
+    MetricsRegistry registry;
+    auto& counter = registry.counter("test_total", "A counter");
+    counter.increment();
+    counter.increment(4);
+    QCOMPARE(counter.get(), (uint64_t)5);
+
+    // the same metric for the same name
+    QCOMPARE(&registry.counter("test_total", "A counter"), &counter);
+
+    auto& gauge = registry.gauge("test_value", "A gauge");
+    gauge.set(2.5);
+    gauge.add(-1.0);
+    QCOMPARE(gauge.get(), 1.5);
+
+    QByteArray text = registry.toPrometheusText();
+    QVERIFY(text.contains("# HELP test_total A counter\n# TYPE test_total counter\ntest_total 5\n"));
+    QVERIFY(text.contains("# TYPE test_value gauge\ntest_value 1.5\n"));
+}
+
+void MetricsTests::testHistogram() {
+    QCOMPARE(MetricHistogram::exponentialBounds(1.0, 2.0, 3), std::vector<double>({ 1.0, 2.0, 4.0 }));
+
+    MetricsRegistry registry;
+    auto& histogram = registry.histogram("test_seconds", "A histogram", { 1.0, 2.0 });
+    histogram.observe(0.5);
+    histogram.observe(1.0); // on the bound, in its bucket
+    histogram.observe(1.5);
+    histogram.observe(3.0);
+    QCOMPARE(histogram.getBucketCount(0), (uint64_t)2);
+    QCOMPARE(histogram.getBucketCount(1), (uint64_t)1);
+    QCOMPARE(histogram.getBucketCount(2), (uint64_t)1);
+    QCOMPARE(histogram.getCount(), (uint64_t)4);
+    QCOMPARE(histogram.getSum(), 6.0);
+
+    // the buckets are cumulative in the text
+    QByteArray text = registry.toPrometheusText();
+    QVERIFY(text.contains("test_seconds_bucket{le=\"1\"} 2\n"));
+    QVERIFY(text.contains("test_seconds_bucket{le=\"2\"} 3\n"));
+    QVERIFY(text.contains("test_seconds_bucket{le=\"+Inf\"} 4\n"));
+    QVERIFY(text.contains("test_seconds_sum 6\n"));
+    QVERIFY(text.contains("test_seconds_count 4\n"));
+}
+
+void MetricsTests::testLabels() {
+    MetricsRegistry registry;
+    registry.counter("test_total", "A counter", "type=\"a\"").increment(1);
+    registry.counter("test_total", "A counter", "type=\"b\"").increment(2);
+    registry.histogram("test_seconds", "A histogram", { 1.0 }, "stage=\"mix\"").observe(0.5);
+
+    QByteArray text = registry.toPrometheusText();
+    QCOMPARE(text.count("# TYPE test_total counter"), 1);
+    QVERIFY(text.contains("test_total{type=\"a\"} 1\n"));
+    QVERIFY(text.contains("test_total{type=\"b\"} 2\n"));
+    QVERIFY(text.contains("test_seconds_bucket{stage=\"mix\",le=\"1\"} 1\n"));
+    QVERIFY(text.contains("test_seconds_count{stage=\"mix\"} 1\n"));
+
+    QCOMPARE(MetricsRegistry::toMetricName("audio mixer.frames"), QString("audio_mixer_frames"));
+    QCOMPARE(MetricsRegistry::toMetricName("1st"), QString("_1st"));
+}
+
+void MetricsTests::testTypeMismatch() {
+    MetricsRegistry registry;
+    registry.counter("test_metric", "A counter").increment(3);
+
+    // a gauge of the name of a counter is not exported
+    registry.gauge("test_metric", "A gauge").set(7.0);
+
+    QByteArray text = registry.toPrometheusText();
+    QVERIFY(text.contains("# TYPE test_metric counter\ntest_metric 3\n"));
+    QVERIFY(!text.contains("gauge"));
+    QVERIFY(!text.contains(" 7"));
+}
+
+void MetricsTests::testMerge() {
+    MetricsRegistry first;
+    first.counter("test_total", "A counter").increment(1);
+    first.counter("test_labelled_total", "A labelled counter", "type=\"a\"").increment(2);
+
+    MetricsRegistry second;
+    second.counter("test_total", "A counter").increment(3);
+
+    QByteArray text = MetricsRegistry::mergePrometheusText({
+        { first.toPrometheusText(), "node=\"1\"" },
+        { second.toPrometheusText(), "node=\"2\"" }
+    });
+
+    // the samples of a family together, under one HELP and TYPE
+    QCOMPARE(text.count("# HELP test_total "), 1);
+    QCOMPARE(text.count("# TYPE test_total "), 1);
+    QVERIFY(text.contains("# TYPE test_total counter\ntest_total{node=\"1\"} 1\ntest_total{node=\"2\"} 3\n"));
+    QVERIFY(text.contains("test_labelled_total{type=\"a\",node=\"1\"} 2\n"));
+}
@@ -0,0 +1,27 @@
+//
+//  MetricsTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsTests_h
+#define hifi_MetricsTests_h
+
+#include <QtTest/QtTest>
+
+class MetricsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCounterAndGauge();
+    void testHistogram();
+    void testLabels();
+    void testTypeMismatch();
+    void testMerge();
+};
+
+#endif // hifi_MetricsTests_h
@@ -0,0 +1,88 @@
+//
+//  SamplingProfilerTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SamplingProfilerTests.h"
+
+#include <chrono>
+#include <thread>
+
+#include <PerfStat.h>
+#include <SamplingProfiler.h>
+
+QTEST_MAIN(SamplingProfilerTests)
+
+void SamplingProfilerTests::testFoldedStacks() {
+    SamplingProfiler profiler;
+    QCOMPARE(profiler.getFoldedStacks(), QByteArray());
+
+    // no stack out of the scopes
+    profiler.sample();
+    QCOMPARE(profiler.getSampleCount(), (quint64)1);
+    QCOMPARE(profiler.getFoldedStacks(), QByteArray());
+
+    SamplingProfiler::enterScope("simulate");
+    SamplingProfiler::enterScope("physics;step");
+    profiler.sample();
+    profiler.sample();
+    SamplingProfiler::leaveScope();
+    profiler.sample();
+    SamplingProfiler::leaveScope();
+
+    QCOMPARE(profiler.getSampleCount(), (quint64)4);
+    QByteArray folded = profiler.getFoldedStacks();
+    QVERIFY(folded.contains("main;simulate 1\n"));
+    QVERIFY(folded.contains("main;simulate;physics:step 2\n"));
+    QCOMPARE(folded.count('\n'), 2);
+
+    profiler.reset();
+    QCOMPARE(profiler.getSampleCount(), (quint64)0);
+    QCOMPARE(profiler.getFoldedStacks(), QByteArray());
+}
+
+void SamplingProfilerTests::testDeepScopes() {
+    SamplingProfiler profiler;
+    const uint32_t DEPTH = SamplingProfiler::MAX_SCOPE_DEPTH + 4;
+    for (uint32_t i = 0; i < DEPTH; i++) {
+        SamplingProfiler::enterScope(QString("scope%1").arg(i));
+    }
+    profiler.sample();
+    for (uint32_t i = 0; i < DEPTH; i++) {
+        SamplingProfiler::leaveScope();
+    }
+
+    // the stack is cut to the deepest scope kept, and leaving more scopes than entered does not underflow
+    QByteArray folded = profiler.getFoldedStacks();
+    QCOMPARE(folded.count(';'), (int)SamplingProfiler::MAX_SCOPE_DEPTH);
+    QVERIFY(folded.contains(QString(";scope%1 1\n").arg(SamplingProfiler::MAX_SCOPE_DEPTH - 1).toUtf8()));
+    SamplingProfiler::leaveScope();
+    profiler.reset();
+    profiler.sample();
+    QCOMPARE(profiler.getFoldedStacks(), QByteArray());
+}
+
+void SamplingProfilerTests::testSamplingThread() {
+    SamplingProfiler profiler;
+    QVERIFY(!SamplingProfiler::isActive());
+    profiler.start(1);
+    QVERIFY(profiler.isSampling());
+    QVERIFY(SamplingProfiler::isActive());
+
+    {
+        PerformanceTimer timer("busy");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    profiler.stop();
+    QVERIFY(!profiler.isSampling());
+    QVERIFY(!SamplingProfiler::isActive());
+
+    QVERIFY(profiler.getSampleCount() > 0);
+    QVERIFY(profiler.getFoldedStacks().contains("main;busy "));
+}
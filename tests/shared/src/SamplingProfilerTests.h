@@ -0,0 +1,25 @@
+//
+//  SamplingProfilerTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SamplingProfilerTests_h
+#define hifi_SamplingProfilerTests_h
+
+#include <QtTest/QtTest>
+
+class SamplingProfilerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testFoldedStacks();
+    void testDeepScopes();
+    void testSamplingThread();
+};
+
+#endif // hifi_SamplingProfilerTests_h
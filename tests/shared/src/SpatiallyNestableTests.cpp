@@ -0,0 +1,136 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <DependencyManager.h>
+#include <SpatialParentFinder.h>
+#include <SpatiallyNestable.h>
+
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.001f;
+
+// deep, but within the parenting chain SpatiallyNestable allows
+const int CHAIN_DEPTH = 25;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        success = true;
+        return _nestables.value(parentID);
+    }
+
+    QHash<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+static SpatiallyNestablePointer createNestable(const SpatiallyNestablePointer& parent) {
+    auto nestable = std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid());
+    DependencyManager::get<TestParentFinder>()->_nestables[nestable->getID()] = nestable;
+    if (parent) {
+        nestable->setParentID(parent->getID());
+    }
+    return nestable;
+}
+
+// a chain of nestables, each one moved and turned relative to the one before it
+static QVector<SpatiallyNestablePointer> createChain(int depth) {
+    QVector<SpatiallyNestablePointer> chain;
+    SpatiallyNestablePointer parent;
+    for (int i = 0; i < depth; i++) {
+        SpatiallyNestablePointer nestable = createNestable(parent);
+        nestable->setLocalPosition(glm::vec3(1.0f, 0.5f, 0.0f));
+        nestable->setLocalOrientation(glm::angleAxis(0.1f, glm::vec3(0.0f, 1.0f, 0.0f)));
+        chain.push_back(nestable);
+        parent = nestable;
+    }
+    return chain;
+}
+
+// the world position of the last nestable of the chain, from the local transforms alone
+static glm::vec3 computePosition(const QVector<SpatiallyNestablePointer>& chain) {
+    Transform world;
+    for (const auto& nestable : chain) {
+        Transform child;
+        Transform::mult(child, world, nestable->getLocalTransform());
+        world = child;
+    }
+    return world.getTranslation();
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::set<TestParentFinder>();
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+}
+
+void SpatiallyNestableTests::testCachedTransformFollowsAncestors() {
+    auto chain = createChain(CHAIN_DEPTH);
+    SpatiallyNestablePointer leaf = chain.last();
+
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+    // read again, from the cache
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+
+    chain.first()->setLocalPosition(glm::vec3(10.0f, 0.0f, -3.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+
+    chain[CHAIN_DEPTH / 2]->setLocalOrientation(glm::angleAxis(1.0f, glm::vec3(1.0f, 0.0f, 0.0f)));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+
+    chain.first()->setPosition(glm::vec3(-5.0f, 2.0f, 1.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+}
+
+void SpatiallyNestableTests::testCachedTransformFollowsReparenting() {
+    auto chain = createChain(CHAIN_DEPTH);
+    SpatiallyNestablePointer leaf = chain.last();
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain), EPSILON);
+
+    // move the lower half of the chain under a new root
+    SpatiallyNestablePointer root = createNestable(nullptr);
+    root->setLocalPosition(glm::vec3(0.0f, 100.0f, 0.0f));
+    chain[CHAIN_DEPTH / 2]->setParentID(root->getID());
+    QVector<SpatiallyNestablePointer> newChain { root };
+    newChain += chain.mid(CHAIN_DEPTH / 2);
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(newChain), EPSILON);
+
+    // and back to no parent, where the local transform is the world one
+    chain[CHAIN_DEPTH / 2]->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), computePosition(chain.mid(CHAIN_DEPTH / 2)), EPSILON);
+}
+
+void SpatiallyNestableTests::benchmarkDeepHierarchyCached() {
+    auto chain = createChain(CHAIN_DEPTH);
+    SpatiallyNestablePointer leaf = chain.last();
+    glm::vec3 position;
+    QBENCHMARK {
+        position = leaf->getPosition();
+    }
+    QCOMPARE_WITH_ABS_ERROR(position, computePosition(chain), EPSILON);
+}
+
+void SpatiallyNestableTests::benchmarkDeepHierarchyMoving() {
+    // the root moves before every read, so the whole chain is computed again each time
+    auto chain = createChain(CHAIN_DEPTH);
+    SpatiallyNestablePointer leaf = chain.last();
+    glm::vec3 position;
+    float offset = 0.0f;
+    QBENCHMARK {
+        offset += 0.001f;
+        chain.first()->setLocalPosition(glm::vec3(offset, 0.0f, 0.0f));
+        position = leaf->getPosition();
+    }
+    QCOMPARE_WITH_ABS_ERROR(position, computePosition(chain), EPSILON);
+}
@@ -0,0 +1,66 @@
+//
+//  StartupTimelineTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupTimelineTests.h"
+
+#include <atomic>
+
+#include <QtCore/QJsonArray>
+
+#include <StartupTimeline.h>
+
+QTEST_MAIN(StartupTimelineTests)
+
+void StartupTimelineTests::testTimeline() {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    auto timeline = DependencyManager::set<StartupTimeline>(startupTimer);
+
+    timeline->mark("started");
+    {
+        StartupTimeline::Phase phase("setup");
+        QTest::qSleep(10);
+    }
+    std::atomic<bool> hasRun { false };
+    timeline->runTask("task", [&] {
+        hasRun = true;
+    });
+    QThreadPool::globalInstance()->waitForDone();
+    QVERIFY(hasRun);
+
+    QVERIFY(!timeline->isFinished());
+    QVERIFY(timeline->finish("done"));
+    QVERIFY(timeline->isFinished());
+    QVERIFY(!timeline->finish("done again"));
+
+    // nothing more once finished
+    timeline->mark("late");
+    {
+        StartupTimeline::Phase phase("late phase");
+    }
+
+    QJsonObject json = timeline->toJson();
+    QJsonArray milestones = json["milestones"].toArray();
+    QCOMPARE(milestones.size(), 2);
+    QCOMPARE(milestones[0].toObject()["name"].toString(), QString("started"));
+    QCOMPARE(milestones[1].toObject()["name"].toString(), QString("done"));
+
+    QJsonArray phases = json["phases"].toArray();
+    QCOMPARE(phases.size(), 2);
+    QCOMPARE(phases[0].toObject()["name"].toString(), QString("setup"));
+    QVERIFY(phases[0].toObject()["duration_ms"].toDouble() >= 10.0);
+    QCOMPARE(phases[0].toObject()["thread"].toString(), QString("main"));
+    QCOMPARE(phases[1].toObject()["name"].toString(), QString("task"));
+    QVERIFY(phases[1].toObject()["thread"].toString() != QString("main"));
+    QVERIFY(json["total_ms"].toDouble() >= phases[0].toObject()["duration_ms"].toDouble());
+
+    DependencyManager::destroy<StartupTimeline>();
+}
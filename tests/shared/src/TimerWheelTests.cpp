@@ -0,0 +1,123 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <map>
+#include <random>
+
+#include <shared/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using Wheel = TimerWheel<int>;
+
+void TimerWheelTests::testDueOrder() {
+    Wheel wheel(1000);
+    wheel.add(0, 20);
+    wheel.add(1, 10);
+    wheel.add(2, 10);
+    wheel.add(3, 0); // due on the next tick
+    QCOMPARE(wheel.getNextTick(), (uint64_t)1001);
+
+    std::vector<Wheel::DueTimer> due;
+    wheel.advance(1005, due);
+    QCOMPARE(due.size(), (size_t)1);
+    QCOMPARE(due[0].value, 3);
+    QCOMPARE(wheel.getNextTick(), (uint64_t)1010);
+
+    // the timers of a tick in the order they were added
+    due.clear();
+    wheel.advance(1100, due);
+    QCOMPARE(due.size(), (size_t)3);
+    QCOMPARE(due[0].value, 1);
+    QCOMPARE(due[1].value, 2);
+    QCOMPARE(due[2].value, 0);
+    QCOMPARE(due[2].tick, (uint64_t)1020);
+    QCOMPARE(wheel.getTick(), (uint64_t)1100);
+    QVERIFY(wheel.empty());
+    QCOMPARE(wheel.getNextTick(), Wheel::NO_TICK);
+}
+
+void TimerWheelTests::testRemove() {
+    Wheel wheel;
+    auto first = wheel.add(0, 5);
+    auto second = wheel.add(1, 5);
+    auto third = wheel.add(2, 5);
+    QVERIFY(wheel.remove(first));
+    QVERIFY(!wheel.remove(first));
+    QVERIFY(!wheel.contains(first));
+    QVERIFY(wheel.contains(second));
+    QCOMPARE(wheel.size(), (size_t)2);
+
+    std::vector<Wheel::DueTimer> due;
+    wheel.advance(5, due);
+    QCOMPARE(due.size(), (size_t)2);
+    QCOMPARE(due[0].id, second);
+    QCOMPARE(due[1].id, third);
+    QVERIFY(!wheel.remove(third));
+}
+
+void TimerWheelTests::testLongDelays() {
+    // delays in each level of the wheel and across their boundaries
+    const std::vector<uint64_t> DELAYS { 255, 256, 257, 65535, 65536, 65537, 16777216, 20000000 };
+    Wheel wheel(200);
+    for (size_t i = 0; i < DELAYS.size(); i++) {
+        wheel.add((int)i, DELAYS[i]);
+    }
+
+    std::vector<Wheel::DueTimer> due;
+    for (size_t i = 0; i < DELAYS.size(); i++) {
+        due.clear();
+        wheel.advance(200 + DELAYS[i] - 1, due);
+        QVERIFY(due.empty());
+        wheel.advance(200 + DELAYS[i], due);
+        QCOMPARE(due.size(), (size_t)1);
+        QCOMPARE(due[0].value, (int)i);
+        QCOMPARE(due[0].tick, 200 + DELAYS[i]);
+    }
+    QVERIFY(wheel.empty());
+}
+
+void TimerWheelTests::testRandomTimers() {
+    std::mt19937 random(7);
+    Wheel wheel;
+    std::map<Wheel::TimerID, uint64_t> dueTicks;
+    std::vector<Wheel::DueTimer> due;
+
+    for (int step = 0; step < 10000; step++) {
+        int operation = random() % 10;
+        if (operation < 5) {
+            uint64_t delay = (random() % 4 == 0) ? random() % 200000 : random() % 600;
+            auto id = wheel.add(step, delay);
+            dueTicks[id] = wheel.getTick() + std::max(delay, (uint64_t)1);
+        } else if (operation < 6 && !dueTicks.empty()) {
+            auto it = dueTicks.begin();
+            std::advance(it, random() % dueTicks.size());
+            QVERIFY(wheel.remove(it->first));
+            dueTicks.erase(it);
+        } else {
+            uint64_t tick = wheel.getTick() + random() % 1000;
+            due.clear();
+            wheel.advance(tick, due);
+            for (const auto& timer : due) {
+                auto it = dueTicks.find(timer.id);
+                QVERIFY(it != dueTicks.end());
+                QCOMPARE(timer.tick, it->second);
+                dueTicks.erase(it);
+            }
+            for (const auto& dueTick : dueTicks) {
+                QVERIFY(dueTick.second > tick);
+            }
+        }
+        QCOMPARE(wheel.size(), dueTicks.size());
+    }
+}
@@ -9,6 +9,10 @@
 #include "TraceTests.h"
 
 #include <QtTest/QtTest>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 #include <QtGui/QDesktopServices>
 
 #include <Profile.h>
@@ -45,3 +49,66 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+// the events of a trace file by name and phase
+static QHash<QString, int> countEvents(const QString& path) {
+    QFile file(path);
+    file.open(QIODevice::ReadOnly);
+    QHash<QString, int> counts;
+    for (auto value : QJsonDocument::fromJson(file.readAll()).array()) {
+        QJsonObject event = value.toObject();
+        counts[event["name"].toString() + ":" + event["ph"].toString()]++;
+    }
+    return counts;
+}
+
+void TraceTests::testBinaryRecords() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    {
+        PROFILE_RANGE(test, "BeforeTracing")
+    }
+    tracer->startTracing();
+    // over several of the segments a thread archives while tracing
+    for (int i = 0; i < 3000; ++i) {
+        PROFILE_RANGE(test, "BinaryEvent")
+    }
+    PROFILE_RANGE_EX(test, "EventWithArgs", 0xff0000ff, 42)
+    tracer->stopTracing();
+    {
+        PROFILE_RANGE(test, "AfterTracing")
+    }
+
+    QTemporaryDir directory;
+    QString path = directory.path() + "/trace.json";
+    tracer->serialize(path);
+
+    auto counts = countEvents(path);
+    QCOMPARE(counts["BinaryEvent:B"], 3000);
+    QCOMPARE(counts["BinaryEvent:E"], 3000);
+    QCOMPARE(counts["EventWithArgs:B"], 1);
+    QVERIFY(!counts.contains("BeforeTracing:B"));
+    QVERIFY(!counts.contains("AfterTracing:B"));
+}
+
+void TraceTests::testFlightRecorder() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->setFlightRecorderEnabled(true);
+    for (int i = 0; i < 100; ++i) {
+        PROFILE_RANGE(test, "OldEvent")
+    }
+    // more than the ring of the thread holds
+    for (int i = 0; i < 10000; ++i) {
+        PROFILE_RANGE(test, "NewEvent")
+    }
+
+    QTemporaryDir directory;
+    QString path = directory.path() + "/flight.json";
+    tracer->dumpFlightRecorder(path);
+
+    // only the most recent records of the ring are left
+    const int RECORDS_PER_THREAD = 1 << 14;
+    auto counts = countEvents(path);
+    QCOMPARE(counts["NewEvent:B"], RECORDS_PER_THREAD / 2);
+    QCOMPARE(counts["NewEvent:E"], RECORDS_PER_THREAD / 2);
+    QVERIFY(!counts.contains("OldEvent:B"));
+}
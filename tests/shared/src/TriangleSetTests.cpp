@@ -0,0 +1,117 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/15/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <TriangleSet.h>
+
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+static const float DISTANCE_TOLERANCE = 1.0e-3f;
+
+static void fillRandomTriangles(TriangleSet& linear, TriangleSet& tree, int numTriangles, std::mt19937& random) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    for (int i = 0; i < numTriangles; i++) {
+        glm::vec3 center(position(random), position(random), position(random));
+        Triangle triangle = {
+            center + glm::vec3(offset(random), offset(random), offset(random)),
+            center + glm::vec3(offset(random), offset(random), offset(random)),
+            center + glm::vec3(offset(random), offset(random), offset(random))
+        };
+        linear.insert(triangle);
+        tree.insert(triangle);
+    }
+    tree.buildTree();
+}
+
+static void comparePicks(const TriangleSet& linear, const TriangleSet& tree, int numRays, std::mt19937& random) {
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    for (int i = 0; i < numRays; i++) {
+        glm::vec3 origin(position(random), position(random), position(random));
+        glm::vec3 target(position(random) * 0.5f, position(random) * 0.5f, position(random) * 0.5f);
+        // every few rays run along an axis, where the slab test divides by zero
+        glm::vec3 direction = (i % 8 == 0) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::normalize(target - origin);
+
+        float linearDistance = 0.0f;
+        float treeDistance = 0.0f;
+        BoxFace face;
+        glm::vec3 linearNormal;
+        glm::vec3 treeNormal;
+        bool linearHit = linear.findRayIntersection(origin, direction, linearDistance, face, linearNormal, true);
+        bool treeHit = tree.findRayIntersection(origin, direction, treeDistance, face, treeNormal, true);
+        QCOMPARE(treeHit, linearHit);
+        if (linearHit) {
+            QCOMPARE_WITH_ABS_ERROR(treeDistance, linearDistance, DISTANCE_TOLERANCE);
+        }
+    }
+}
+
+void TriangleSetTests::testTreeMatchesLinearPick() {
+    std::mt19937 random(1);
+    TriangleSet linear;
+    TriangleSet tree;
+    fillRandomTriangles(linear, tree, 5000, random);
+    QCOMPARE(linear.isTreeBuilt(), false);
+    QCOMPARE(tree.isTreeBuilt(), true);
+    comparePicks(linear, tree, 1000, random);
+
+    // inserting drops the tree until it is built again
+    tree.insert(tree.getTriangle(0));
+    QCOMPARE(tree.isTreeBuilt(), false);
+}
+
+void TriangleSetTests::testRefitAfterMove() {
+    std::mt19937 random(2);
+    TriangleSet linear;
+    TriangleSet tree;
+    fillRandomTriangles(linear, tree, 2000, random);
+
+    const glm::vec3 shift(1.0f, 2.0f, -0.5f);
+    for (size_t t = 0; t < tree.size(); t++) {
+        Triangle triangle = tree.getTriangle(t);
+        triangle.v0 += shift;
+        triangle.v1 += shift * 1.5f;
+        triangle.v2 += shift;
+        tree.updateTriangle(t, triangle);
+        linear.updateTriangle(t, triangle);
+    }
+    tree.refitTree();
+    linear.refitTree();
+    QCOMPARE(tree.isTreeBuilt(), true);
+    comparePicks(linear, tree, 1000, random);
+}
+
+void TriangleSetTests::testDegenerateTriangles() {
+    // many coincident triangles leave the builder nothing to split on
+    TriangleSet linear;
+    TriangleSet tree;
+    Triangle triangle = { glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    for (int i = 0; i < 100; i++) {
+        linear.insert(triangle);
+        tree.insert(triangle);
+    }
+    tree.buildTree();
+
+    float distance = 0.0f;
+    BoxFace face;
+    glm::vec3 normal;
+    QCOMPARE(tree.findRayIntersection(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), distance, face, normal, true), true);
+    QCOMPARE_WITH_ABS_ERROR(distance, 5.0f, DISTANCE_TOLERANCE);
+    QCOMPARE(tree.findRayIntersection(glm::vec3(3.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), distance, face, normal, true), false);
+
+    std::mt19937 random(3);
+    comparePicks(linear, tree, 200, random);
+}
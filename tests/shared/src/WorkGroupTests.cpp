@@ -0,0 +1,52 @@
+//
+//  WorkGroupTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkGroupTests.h"
+
+#include <atomic>
+#include <vector>
+
+#include <QtCore/QThreadPool>
+
+#include <shared/WorkGroup.h>
+
+QTEST_MAIN(WorkGroupTests)
+
+void WorkGroupTests::testForEach() {
+    const int COUNT = 1000;
+    std::vector<int> values(COUNT, 0);
+    WorkGroup::forEach(COUNT, [&](int i) {
+        values[i] = i * 2;
+    });
+    for (int i = 0; i < COUNT; i++) {
+        QCOMPARE(values[i], i * 2);
+    }
+}
+
+void WorkGroupTests::testWaitFromPool() {
+    // every thread of the pool waits for a group of its own, which they can only finish by running the tasks themselves
+    const int GROUP_TASKS = 10;
+    int groups = QThreadPool::globalInstance()->maxThreadCount();
+    std::atomic<int> count { 0 };
+    WorkGroup outer;
+    for (int i = 0; i < groups; i++) {
+        outer.run([&] {
+            WorkGroup inner;
+            for (int j = 0; j < GROUP_TASKS; j++) {
+                inner.run([&] {
+                    count++;
+                });
+            }
+        });
+    }
+    outer.wait();
+    QCOMPARE(count.load(), groups * GROUP_TASKS);
+}
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# Soak test for the avatar mixer.
+#
+# Deploys N synthetic avatars (script-archive/acScripts/avatarMixerLoadBot.js, run by assignment-client Agents)
+# to a domain, then samples the avatar mixer's stats from the domain-server every few seconds and writes them
+# to a CSV and/or JSON report, so that runs of different builds or instance sizes can be compared.
+#
+# The domain needs enough assignment-clients to run the bots, e.g. for 100 bots:
+#   assignment-client -t 2 -n 100
+#
+# Usage: python3 avatar-mixer-soak.py --bots 100 --duration 600 --csv soak.csv --json soak.json
+#
+# Bots are ephemeral assignments: they stay until the domain-server restarts.
+# Use --no-deploy to sample an already loaded domain.
+#
+
+import argparse, base64, csv, json, os, sys, time
+import urllib.request
+
+DEFAULT_BOT_SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                  "..", "script-archive", "acScripts", "avatarMixerLoadBot.js")
+
+# report columns, and where to find them in the avatar mixer stats
+COLUMNS = [
+    ("listeners", ["average_listeners_last_second"]),
+    ("broadcast_loop_rate", ["broadcast_loop_rate"]),
+    ("throttling_ratio", ["throttling_ratio"]),
+    ("usecs_broadcast_per_frame", ["parallelTasks", "broadcastAvatarData", "1_total"]),
+    ("usecs_slave_jobs_per_frame", ["slaves_aggregate", "timing_6_jobElapsedTime"]),
+    ("usecs_to_byte_array_per_frame", ["slaves_aggregate", "timing_3_toByteArray"]),
+    ("bytes_sent_per_frame", ["slaves_aggregate", "sent_2_numBytesSent"]),
+    ("kbps_per_node", ["slaves_aggregate", "sent_5_averageOutboundAvatarKbps"]),
+    ("others_included_per_node", ["slaves_aggregate", "sent_6_averageOthersIncluded"]),
+    ("over_budget_avatars_per_node", ["slaves_aggregate", "sent_7_averageOverBudgetAvatars"]),
+    ("identities_sent_per_frame", ["slaves_aggregate", "sent_10_numIdentitiesSent"]),
+    ("identities_deferred_per_frame", ["slaves_aggregate", "sent_11_numIdentitiesDeferred"]),
+]
+
+
+class DomainServer:
+    def __init__(self, url, username, password):
+        self.url = url.rstrip("/")
+        self.headers = {}
+        if username:
+            credentials = base64.b64encode(("%s:%s" % (username, password)).encode("utf-8")).decode("ascii")
+            self.headers["Authorization"] = "Basic " + credentials
+
+    def request(self, path, data=None, headers={}):
+        allHeaders = dict(self.headers)
+        allHeaders.update(headers)
+        request = urllib.request.Request(self.url + path, data=data, headers=allHeaders)
+        with urllib.request.urlopen(request, timeout=10) as response:
+            return response.read()
+
+    def getJSON(self, path):
+        return json.loads(self.request(path).decode("utf-8"))
+
+    def deployScript(self, script, instances):
+        # the same multipart form as the domain-server's assignment page
+        boundary = "----68696768666964656c697479"
+        body = ("--" + boundary + "\r\n"
+                + "Content-Disposition:form-data; name=\"file\"; filename=\"script.js\"\r\n"
+                + "Content-type: application/javascript\r\n\r\n"
+                + script + "\r\n"
+                + "--" + boundary + "--\r\n").encode("utf-8")
+        self.request("/assignment", body, {
+            "Content-Type": "multipart/form-data; boundary=" + boundary,
+            "ASSIGNMENT-INSTANCES": str(instances)
+        })
+
+    def findNodes(self, nodeType):
+        return [node for node in self.getJSON("/nodes.json")["nodes"] if node.get("type") == nodeType]
+
+
+def lookup(stats, path):
+    for key in path:
+        if not isinstance(stats, dict) or key not in stats:
+            return None
+        stats = stats[key]
+    return stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load and sample the avatar mixer of a domain.")
+    parser.add_argument("--domain", default="http://localhost:40100", help="domain-server HTTP address")
+    parser.add_argument("--username", help="domain-server HTTP username, if required")
+    parser.add_argument("--password", default="", help="domain-server HTTP password")
+    parser.add_argument("--bots", type=int, default=50, help="number of synthetic avatars to deploy")
+    parser.add_argument("--script", default=DEFAULT_BOT_SCRIPT, help="AC script to deploy for each bot")
+    parser.add_argument("--no-deploy", action="store_true", help="only sample, do not deploy bots")
+    parser.add_argument("--duration", type=float, default=300.0, help="seconds to sample for")
+    parser.add_argument("--interval", type=float, default=5.0, help="seconds between samples")
+    parser.add_argument("--csv", help="write samples to this CSV file")
+    parser.add_argument("--json", help="write samples (and the raw mixer stats) to this JSON file")
+    args = parser.parse_args()
+
+    domain = DomainServer(args.domain, args.username, args.password)
+
+    if not args.no_deploy:
+        with open(args.script, "r") as scriptFile:
+            domain.deployScript(scriptFile.read(), args.bots)
+        print("deployed %d bots" % args.bots)
+
+    samples = []
+    start = time.time()
+    while time.time() - start < args.duration:
+        time.sleep(args.interval)
+
+        mixers = domain.findNodes("avatar-mixer")
+        if not mixers:
+            print("no avatar mixer in the domain, waiting")
+            continue
+        mixer = mixers[0]
+        stats = domain.getJSON("/nodes/%s.json" % mixer["uuid"])
+
+        sample = { "seconds": round(time.time() - start, 1), "agents": len(domain.findNodes("agent")) }
+        for column, path in COLUMNS:
+            sample[column] = lookup(stats, path)
+        print(", ".join("%s=%s" % (key, sample[key]) for key in ["seconds", "agents"] + [c for c, _ in COLUMNS[:5]]))
+        samples.append((sample, stats))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as csvFile:
+            writer = csv.DictWriter(csvFile, fieldnames=["seconds", "agents"] + [column for column, _ in COLUMNS])
+            writer.writeheader()
+            for sample, _ in samples:
+                writer.writerow(sample)
+
+    if args.json:
+        with open(args.json, "w") as jsonFile:
+            json.dump({
+                "domain": args.domain,
+                "bots": 0 if args.no_deploy else args.bots,
+                "samples": [sample for sample, _ in samples],
+                "raw": [stats for _, stats in samples]
+            }, jsonFile, indent=2)
+
+    if not samples:
+        print("no samples collected")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,262 @@
+//
+//  GPUFramePlayerApp.cpp
+//  tools/gpu-frame-player/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GPUFramePlayerApp.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QProcess>
+#include <QtCore/QProcessEnvironment>
+
+#include <gl/Config.h>
+#include <gl/Context.h>
+#include <gl/QOpenGLContextWrapper.h>
+#include <gpu/Context.h>
+#include <gpu/FrameIO.h>
+#include <gpu/gl/GLBackend.h>
+
+static const char* DISABLE_OPENGL_45_FLAG = "HIFI_DISABLE_OPENGL_45";
+
+static const int DEFAULT_NUM_LOOPS = 200;
+static const int DEFAULT_NUM_WARMUP_LOOPS = 20;
+
+// In the order of gpu::Batch::Command
+static const char* COMMAND_NAMES[] = {
+    "draw",
+    "drawIndexed",
+    "drawInstanced",
+    "drawIndexedInstanced",
+    "multiDrawIndirect",
+    "multiDrawIndexedIndirect",
+    "dispatch",
+
+    "setInputFormat",
+    "setInputBuffer",
+    "setIndexBuffer",
+    "setIndirectBuffer",
+
+    "setModelTransform",
+    "setViewTransform",
+    "setProjectionTransform",
+    "setViewportTransform",
+    "setDepthRangeTransform",
+
+    "setPipeline",
+    "setStateBlendFactor",
+    "setStateScissorRect",
+
+    "setUniformBuffer",
+    "setResourceTexture",
+    "setResourceBuffer",
+    "setResourceTextureTable",
+    "setResourceTextureBuffer",
+
+    "setFramebuffer",
+    "clearFramebuffer",
+    "blit",
+    "textureBarrier",
+    "generateTextureMips",
+
+    "beginQuery",
+    "endQuery",
+    "getQuery",
+
+    "resetStages",
+
+    "runLambda",
+
+    "startNamedCall",
+    "stopNamedCall",
+
+    "glUniform1i",
+    "glUniform1f",
+    "glUniform2f",
+    "glUniform3f",
+    "glUniform4f",
+    "glUniform3fv",
+    "glUniform4fv",
+    "glUniform4iv",
+    "glUniformMatrix3fv",
+    "glUniformMatrix4fv",
+
+    "glColor4f",
+
+    "pushProfileRange",
+    "popProfileRange",
+};
+static_assert(sizeof(COMMAND_NAMES) / sizeof(COMMAND_NAMES[0]) == gpu::Batch::NUM_COMMANDS,
+              "A command of gpu::Batch has no name");
+
+GPUFramePlayerApp::GPUFramePlayerApp(int argc, char* argv[]) : QGuiApplication(argc, argv) {
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity GPU Frame Player");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption loopsOption("loops", "number of times the frames are replayed",
+                                         "count", QString::number(DEFAULT_NUM_LOOPS));
+    parser.addOption(loopsOption);
+
+    const QCommandLineOption warmupOption("warmup", "number of replays before the measures, that upload the resources",
+                                          "count", QString::number(DEFAULT_NUM_WARMUP_LOOPS));
+    parser.addOption(warmupOption);
+
+    const QCommandLineOption bothOption("both", "replay with the OpenGL 4.1 backend too, in another process");
+    parser.addOption(bothOption);
+
+    parser.addPositionalArgument("frames", "the files written by Capture GPU Frame, replayed in their order");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QStringList filenames = parser.positionalArguments();
+    if (filenames.empty()) {
+        qCritical() << "No frame to replay";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    int numLoops = std::max(parser.value(loopsOption).toInt(), 1);
+    int numWarmupLoops = std::max(parser.value(warmupOption).toInt(), 0);
+
+    if (parser.isSet(bothOption) && !QProcessEnvironment::systemEnvironment().contains(DISABLE_OPENGL_45_FLAG)) {
+        QStringList arguments = QCoreApplication::arguments().mid(1);
+        arguments.removeAll("--both");
+        _returnCode = playOpenGL41(arguments);
+        if (_returnCode != 0) {
+            return;
+        }
+    }
+
+    _returnCode = play(filenames, numLoops, numWarmupLoops);
+}
+
+GPUFramePlayerApp::~GPUFramePlayerApp() {
+}
+
+int GPUFramePlayerApp::playOpenGL41(const QStringList& arguments) {
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.insert(DISABLE_OPENGL_45_FLAG, "1");
+
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.setProcessChannelMode(QProcess::ForwardedChannels);
+    process.start(QCoreApplication::applicationFilePath(), arguments);
+    if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit) {
+        qCritical() << "The replay with the OpenGL 4.1 backend failed";
+        return 3;
+    }
+    return process.exitCode();
+}
+
+int GPUFramePlayerApp::play(const QStringList& filenames, int numLoops, int numWarmupLoops) {
+    gl::OffscreenContext glContext;
+    glContext.create();
+    if (!glContext.makeCurrent()) {
+        qCritical() << "Could not make an OpenGL context current";
+        return 2;
+    }
+
+    gpu::Context::init<gpu::gl::GLBackend>();
+    auto gpuContext = std::make_shared<gpu::Context>();
+    auto backend = std::dynamic_pointer_cast<gpu::gl::GLBackend>(gpuContext->getBackend());
+    if (!backend) {
+        qCritical() << "Could not create the OpenGL backend";
+        return 2;
+    }
+
+    // the frames are read with the context current, their programs are linked as they are read
+    std::vector<gpu::FramePointer> frames;
+    for (auto& filename : filenames) {
+        auto frame = gpu::readFrame(filename.toStdString());
+        if (!frame) {
+            qCritical() << "Could not read the frame" << filename;
+            return 2;
+        }
+        frames.push_back(frame);
+    }
+
+    // the timer of the frames is made by the first frame recorded
+    gpuContext->beginFrame();
+    gpuContext->consumeFrameUpdates(gpuContext->endFrame());
+
+    bool isOpenGL45 = !QProcessEnvironment::systemEnvironment().contains(DISABLE_OPENGL_45_FLAG) &&
+        QOpenGLContextWrapper::currentContextVersion() >= 0x0405;
+
+    QElapsedTimer timer;
+    qint64 frameNsecs = 0;
+    for (int loop = 0; loop < numWarmupLoops + numLoops; loop++) {
+        if (loop == numWarmupLoops) {
+            backend->resetCommandTimings();
+            backend->setCommandTimingEnabled(true);
+            frameNsecs = 0;
+        }
+        timer.start();
+        for (auto& frame : frames) {
+            gpuContext->executeFrame(frame);
+        }
+        // the frames are measured as they complete on the GPU, not as they are queued
+        glFinish();
+        frameNsecs += timer.nsecsElapsed();
+        gpuContext->recycle();
+    }
+    backend->setCommandTimingEnabled(false);
+
+    const auto& timings = backend->getCommandTimings();
+    std::vector<int> commands;
+    uint64_t commandsNsecs = 0;
+    for (int command = 0; command < gpu::Batch::NUM_COMMANDS; command++) {
+        if (timings[command].count > 0) {
+            commands.push_back(command);
+            commandsNsecs += timings[command].nsecs;
+        }
+    }
+    std::sort(commands.begin(), commands.end(), [&](int a, int b) {
+        return timings[a].nsecs > timings[b].nsecs;
+    });
+
+    const double NSECS_PER_USEC = 1000.0;
+    const double NSECS_PER_MSEC = 1000000.0;
+    double loops = (double)numLoops;
+
+    printf("\n%s backend, %d frames replayed %d times\n", isOpenGL45 ? "OpenGL 4.5" : "OpenGL 4.1",
+           (int)frames.size(), numLoops);
+    printf("  frame: %.3f ms, GPU %.3f ms\n", frameNsecs / NSECS_PER_MSEC / loops,
+           gpuContext->getFrameTimerGPUAverage());
+    printf("  backend CPU: %.3f ms in the commands, %.3f ms in the transfer passes\n",
+           commandsNsecs / NSECS_PER_MSEC / loops, backend->getTransferTiming().nsecs / NSECS_PER_MSEC / loops);
+    printf("\n  %-28s %10s %12s %12s %8s\n", "command", "calls", "usecs", "nsecs/call", "share");
+    for (auto command : commands) {
+        const auto& timing = timings[command];
+        printf("  %-28s %10.1f %12.2f %12.1f %7.1f%%\n", COMMAND_NAMES[command], timing.count / loops,
+               timing.nsecs / NSECS_PER_USEC / loops, (double)timing.nsecs / (double)timing.count,
+               100.0 * timing.nsecs / (double)std::max(commandsNsecs, (uint64_t)1));
+    }
+    fflush(stdout);
+
+    // the frames release their resources with the context current
+    frames.clear();
+    gpuContext->recycle();
+    return 0;
+}
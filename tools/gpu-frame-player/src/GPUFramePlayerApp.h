@@ -0,0 +1,39 @@
+//
+//  GPUFramePlayerApp.h
+//  tools/gpu-frame-player/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GPUFramePlayerApp_h
+#define hifi_GPUFramePlayerApp_h
+
+#include <QtGui/QGuiApplication>
+
+#include <gpu/Forward.h>
+
+// Replays the frames captured with gpu::Context::captureFrame in a loop, and reports the CPU time of the backend for
+// each type of command and the GPU time of the frames
+class GPUFramePlayerApp : public QGuiApplication {
+    Q_OBJECT
+public:
+    GPUFramePlayerApp(int argc, char* argv[]);
+    ~GPUFramePlayerApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    // replays the frames with the backend of this process, HIFI_DISABLE_OPENGL_45 selecting the one of OpenGL 4.1
+    int play(const QStringList& filenames, int numLoops, int numWarmupLoops);
+
+    // replays the frames with the backend of OpenGL 4.1 in another process, the backend being picked at its start
+    int playOpenGL41(const QStringList& arguments);
+
+    int _returnCode { 0 };
+};
+
+#endif // hifi_GPUFramePlayerApp_h
@@ -0,0 +1,17 @@
+//
+//  main.cpp
+//  tools/gpu-frame-player/src
+//
+//  Created by High Fidelity on 10/14/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GPUFramePlayerApp.h"
+
+int main(int argc, char* argv[]) {
+    GPUFramePlayerApp app(argc, argv);
+    return app.getReturnCode();
+}